@@ -24,6 +24,8 @@ function(add_engine_dependencies2 target_name all_render_api)
 			add_dependencies(${target_name} bsfD3D11RenderAPI)
 		elseif(RENDER_API_MODULE MATCHES "Vulkan")
 			add_dependencies(${target_name} bsfVulkanRenderAPI)
+		elseif(RENDER_API_MODULE MATCHES "Null")
+			add_dependencies(${target_name} bsfNullRenderAPI)
 		else()
 			add_dependencies(${target_name} bsfGLRenderAPI)
 		endif()
@@ -36,6 +38,10 @@ function(add_engine_dependencies2 target_name all_render_api)
 	endif()
 	
 	add_dependencies(${target_name} bsfSL bsfPhysX bsfRenderBeast)
+
+	if(RENDERER_MODULE MATCHES "Null")
+		add_dependencies(${target_name} bsfNullRenderer)
+	endif()
 endfunction()
 
 function(add_importer_dependencies target_name)
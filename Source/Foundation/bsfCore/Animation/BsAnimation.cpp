@@ -438,12 +438,14 @@ namespace bs
 					if (isClipValid)
 					{
 						state.curves = clipInfo.clip->getCurves();
+						state.compressedCurves = clipInfo.clip->getCompressedCurves();
 						state.disabled = clipInfo.playbackType == AnimPlaybackType::None;
 					}
 					else
 					{
 						static SPtr<AnimationCurves> zeroCurves = bs_shared_ptr_new<AnimationCurves>();
 						state.curves = zeroCurves;
+						state.compressedCurves = nullptr;
 						state.disabled = true;
 					}
 
@@ -690,7 +692,7 @@ namespace bs
 	void Animation::setMask(const SkeletonMask& mask)
 	{
 		mSkeletonMask = mask;
-		mDirty |= AnimDirtyStateFlag::All;
+		mDirty |= AnimDirtyStateFlag::All | AnimDirtyStateFlag::LOD;
 	}
 
 	void Animation::setWrapMode(AnimWrapMode wrapMode)
@@ -731,6 +733,17 @@ namespace bs
 		mDirty |= AnimDirtyStateFlag::Culling;
 	}
 
+	void Animation::setLODLevels(const Vector<AnimationLODLevel>& levels)
+	{
+		mLODLevels = levels;
+
+		// Keep the levels ordered from highest to lowest detail
+		std::sort(mLODLevels.begin(), mLODLevels.end(), 
+			[](const AnimationLODLevel& a, const AnimationLODLevel& b) { return a.screenSize > b.screenSize; });
+
+		mDirty |= AnimDirtyStateFlag::LOD;
+	}
+
 	void Animation::play(const HAnimationClip& clip)
 	{
 		AnimationClipInfo* clipInfo = addClip(clip, (UINT32)-1);
@@ -1310,6 +1323,15 @@ namespace bs
 			mDirty.unset(AnimDirtyStateFlag::Culling);
 		}
 
+		if (mDirty.isSet(AnimDirtyStateFlag::LOD))
+		{
+			mAnimProxy->lodLevels = mLODLevels;
+			for (auto& level : mAnimProxy->lodLevels)
+				level.mask = level.mask.intersect(mSkeletonMask);
+
+			mDirty.unset(AnimDirtyStateFlag::LOD);
+		}
+
 		auto getAnimatedSOList = [&]()
 		{
 			Vector<AnimatedSceneObject> animatedSO(mSceneObjects.size());
@@ -43,6 +43,34 @@ namespace bs
 		bool stopped = false;
 	};
 
+	/** 
+	 * Determines how an animation is evaluated once it covers only a small portion of the screen. Lower levels of detail
+	 * trade animation quality for reduced evaluation cost.
+	 */
+	struct BS_CORE_EXPORT AnimationLODLevel
+	{
+		/** 
+		 * Size of the animation bounds on screen, as a fraction of the viewport height, at or below which this level
+		 * becomes active. When multiple cameras are present the largest size is used.
+		 */
+		float screenSize = 1.0f;
+
+		/** 
+		 * Number of animation updates between two consecutive evaluations of the animation. Poses for the updates in
+		 * between are interpolated from the last two evaluated poses.
+		 */
+		UINT32 updateInterval = 1;
+
+		/** 
+		 * Mask that determines which bones to evaluate while this level is active. Disabled bones keep their bind pose.
+		 * Applied on top of the mask set through Animation::setMask().
+		 */
+		SkeletonMask mask;
+
+		/** Determines should morph shapes be evaluated while this level is active. */
+		bool morphShapes = true;
+	};
+
 	/** @} */
 
 	/** @addtogroup Animation-Internal
@@ -57,7 +85,8 @@ namespace bs
 		Layout = 1 << 1,
 		All = 1 << 2,
 		Culling = 1 << 3,
-		MorphWeights = 1 << 4
+		MorphWeights = 1 << 4,
+		LOD = 1 << 5
 	};
 
 	typedef Flags<AnimDirtyStateFlag> AnimDirtyState;
@@ -268,6 +297,13 @@ namespace bs
 		AABox mBounds;
 		bool mCullEnabled;
 
+		// Level of detail
+		Vector<AnimationLODLevel> lodLevels;
+		Vector<Matrix4> lodPoses[2]; /**< Two most recently evaluated poses, used for interpolating skipped updates. */
+		UINT32 numLODPoses = 0;
+		UINT32 lastLODEvaluation = 0;
+		UINT32 lastLODUpdate = (UINT32)-1;
+
 		// Single frame sample
 		AnimSampleStep sampleStep = AnimSampleStep::None;
 
@@ -340,6 +376,17 @@ namespace bs
 		/** @copydoc setCulling */
 		bool getCulling() const { return mCull; }
 
+		/** 
+		 * Sets levels of detail used for reducing the evaluation cost of the animation as its bounds (as provided through
+		 * setBounds()) get smaller on screen. The level with the smallest screen size that's still larger than the size of
+		 * the bounds is used. If the bounds are larger than all the levels, or no levels are set (default), the animation
+		 * is fully evaluated every update.
+		 */
+		void setLODLevels(const Vector<AnimationLODLevel>& levels);
+
+		/** @copydoc setLODLevels */
+		const Vector<AnimationLODLevel>& getLODLevels() const { return mLODLevels; }
+
 		/** 
 		 * Plays the specified animation clip. 
 		 *
@@ -537,6 +584,7 @@ namespace bs
 		float mDefaultSpeed;
 		AABox mBounds;
 		bool mCull;
+		Vector<AnimationLODLevel> mLODLevels;
 		AnimDirtyState mDirty;
 
 		SPtr<Skeleton> mSkeleton;
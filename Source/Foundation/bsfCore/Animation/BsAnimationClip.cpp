@@ -139,12 +139,37 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = nullptr;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	void AnimationClip::compress(const AnimationCompressionSettings& settings)
+	{
+		if (mCompressedCurves != nullptr)
+			return;
+
+		mCompressedCurves = CompressedAnimationCurves::create(*mCurves, mSampleRate, settings);
+
+		// Only names and flags of the compressed curves are kept, used for mapping the compressed tracks
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>(*mCurves);
+		for (auto& entry : curves->position)
+			entry.curve = TAnimationCurve<Vector3>();
+
+		for (auto& entry : curves->rotation)
+			entry.curve = TAnimationCurve<Quaternion>();
+
+		for (auto& entry : curves->scale)
+			entry.curve = TAnimationCurve<Vector3>();
+
+		mCurves = curves;
+
+		calculateLength();
+		mVersion++;
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr && 
@@ -166,6 +191,9 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		if (mCompressedCurves != nullptr)
+			mLength = std::max(mLength, mCompressedCurves->getEnd());
 	}
 
 	void AnimationClip::buildNameMapping()
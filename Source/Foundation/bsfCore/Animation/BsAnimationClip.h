@@ -7,6 +7,7 @@
 #include "Math/BsVector3.h"
 #include "Math/BsQuaternion.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsAnimationCompression.h"
 
 namespace bs
 {
@@ -162,6 +163,20 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Curves,pr:setter)
 		void setCurves(const AnimationCurves& curves);
 
+		/**
+		 * Compresses the position, rotation and scale curves of the clip, reducing the memory they use and evaluating
+		 * all of them at once during animation. Curves are resampled at the clip's sample rate, so make sure it is set
+		 * to the rate the curves were sampled at before calling this. After compression the curves returned by
+		 * getCurves() keep their names, but no longer contain any keyframes. Assigning new curves through setCurves()
+		 * discards the compressed curves. Does nothing if the clip is already compressed.
+		 *
+		 * @param[in]	settings	Determines how much error is allowed in the compressed curves.
+		 */
+		void compress(const AnimationCompressionSettings& settings = AnimationCompressionSettings());
+
+		/** Returns the compressed position, rotation and scale curves, or null if the clip isn't compressed. */
+		SPtr<CompressedAnimationCurves> getCompressedCurves() const { return mCompressedCurves; }
+
 		/** @copydoc setEvents() */
 		BS_SCRIPT_EXPORT(n:Events,pr:getter)
 		const Vector<AnimationEvent>& getEvents() const { return mEvents; }
@@ -298,6 +313,9 @@ namespace bs
 		 */
 		SPtr<AnimationCurves> mCurves;
 
+		/** Compressed position, rotation and scale curves, if the clip was compressed. Immutable, same as mCurves. */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+
 		/**
 		 * A set of curves containing motion of the root bone. If this is non-empty it should be true that mCurves does not
 		 * contain animation curves for the root bone. Root motion will not be evaluated through normal animation process
@@ -0,0 +1,406 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Animation/BsAnimationCompression.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationUtility.h"
+#include "Private/RTTI/BsAnimationCompressionRTTI.h"
+
+namespace bs
+{
+	/** Largest value of a quantized position or scale component. */
+	static constexpr float QUANTIZED_MAX = 65535.0f;
+
+	/** Number of bits used for each of the three smallest quaternion components. */
+	static constexpr UINT32 QUAT_COMPONENT_BITS = 20;
+
+	/** Largest value of a quantized quaternion component. */
+	static constexpr UINT32 QUAT_COMPONENT_MAX = (1 << QUAT_COMPONENT_BITS) - 1;
+
+	/** Components other than the largest one of a normalized quaternion are in range [-1/sqrt(2), 1/sqrt(2)]. */
+	static constexpr float QUAT_COMPONENT_RANGE = 0.70710678f;
+
+	/** Encodes a normalized quaternion using its smallest three components. */
+	static UINT64 packQuaternion(const Quaternion& quat)
+	{
+		const float components[4] = { quat.x, quat.y, quat.z, quat.w };
+
+		UINT32 largest = 0;
+		for (UINT32 i = 1; i < 4; i++)
+		{
+			if (Math::abs(components[i]) > Math::abs(components[largest]))
+				largest = i;
+		}
+
+		// The largest component is reconstructed as positive, flip the quaternion if it isn't
+		const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+		UINT64 packed = largest;
+		UINT32 shift = 2;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			const float normalized = Math::clamp(components[i] * sign / QUAT_COMPONENT_RANGE, -1.0f, 1.0f);
+			const UINT64 quantized = Math::roundToPosInt((normalized * 0.5f + 0.5f) * QUAT_COMPONENT_MAX);
+
+			packed |= quantized << shift;
+			shift += QUAT_COMPONENT_BITS;
+		}
+
+		return packed;
+	}
+
+	/** Decodes a quaternion encoded with packQuaternion(). */
+	static Quaternion unpackQuaternion(UINT64 packed)
+	{
+		const UINT32 largest = (UINT32)(packed & 0x3);
+
+		float components[4];
+		float sumSquares = 0.0f;
+		UINT32 shift = 2;
+		for (UINT32 i = 0; i < 4; i++)
+		{
+			if (i == largest)
+				continue;
+
+			const UINT32 quantized = (UINT32)(packed >> shift) & QUAT_COMPONENT_MAX;
+			components[i] = (quantized / (float)QUAT_COMPONENT_MAX * 2.0f - 1.0f) * QUAT_COMPONENT_RANGE;
+
+			sumSquares += components[i] * components[i];
+			shift += QUAT_COMPONENT_BITS;
+		}
+
+		components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+		return Quaternion(components[3], components[0], components[1], components[2]);
+	}
+
+	/** Samples a curve at every frame. */
+	template<class T>
+	static Vector<T> sampleCurve(const TAnimationCurve<T>& curve, UINT32 numFrames, float start, float end,
+		UINT32 sampleRate)
+	{
+		Vector<T> samples(numFrames);
+
+		TCurveCache<T> cache;
+		for (UINT32 i = 0; i < numFrames; i++)
+		{
+			const float time = std::min(start + i / (float)sampleRate, end);
+			samples[i] = curve.evaluate(time, cache, false);
+		}
+
+		return samples;
+	}
+
+	/** Picks the format of a position or scale track from its samples, and assigns it space within a frame. */
+	static CompressedTrack createTrack(const Vector<Vector3>& samples, float maxError, UINT32& frameSize)
+	{
+		Vector3 min = samples[0];
+		Vector3 max = samples[0];
+		for (auto& sample : samples)
+		{
+			min = Vector3::min(min, sample);
+			max = Vector3::max(max, sample);
+		}
+
+		const Vector3 range = max - min;
+		const float maxRange = std::max(range.x, std::max(range.y, range.z));
+
+		CompressedTrack track;
+		if (maxRange <= maxError * 2.0f)
+		{
+			const Vector3 center = min + range * 0.5f;
+
+			track.format = CompressedTrackFormat::Constant;
+			track.base = Vector4(center.x, center.y, center.z, 0.0f);
+			return track;
+		}
+
+		track.offset = frameSize;
+
+		// Quantizing to the nearest step results in at most half a step of error
+		if (maxRange / QUANTIZED_MAX * 0.5f <= maxError)
+		{
+			track.format = CompressedTrackFormat::Quantized;
+			track.base = Vector4(min.x, min.y, min.z, 0.0f);
+			track.range = range;
+
+			frameSize += sizeof(UINT16) * 3;
+		}
+		else
+		{
+			track.format = CompressedTrackFormat::Raw;
+			frameSize += sizeof(Vector3);
+		}
+
+		return track;
+	}
+
+	/** Picks the format of a rotation track from its samples, and assigns it space within a frame. */
+	static CompressedTrack createTrack(const Vector<Quaternion>& samples, float maxError, UINT32& frameSize)
+	{
+		const Quaternion& first = samples[0];
+
+		bool isConstant = true;
+		for (auto& sample : samples)
+		{
+			// Quaternions q and -q represent the same rotation
+			const Quaternion aligned = sample.dot(first) < 0.0f ? -sample : sample;
+
+			if (Math::abs(aligned.x - first.x) > maxError || Math::abs(aligned.y - first.y) > maxError ||
+				Math::abs(aligned.z - first.z) > maxError || Math::abs(aligned.w - first.w) > maxError)
+			{
+				isConstant = false;
+				break;
+			}
+		}
+
+		CompressedTrack track;
+		if (isConstant)
+		{
+			track.format = CompressedTrackFormat::Constant;
+			track.base = Vector4(first.x, first.y, first.z, first.w);
+			return track;
+		}
+
+		track.format = CompressedTrackFormat::SmallestThree;
+		track.offset = frameSize;
+
+		frameSize += sizeof(UINT64);
+		return track;
+	}
+
+	/** Writes a single sample of a position or scale track into a frame. */
+	static void writeSample(const CompressedTrack& track, const Vector3& sample, UINT8* frame)
+	{
+		if (track.format == CompressedTrackFormat::Quantized)
+		{
+			UINT16 quantized[3];
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				const float normalized = track.range[i] > 0.0f ? (sample[i] - track.base[i]) / track.range[i] : 0.0f;
+				quantized[i] = (UINT16)Math::roundToPosInt(Math::clamp01(normalized) * QUANTIZED_MAX);
+			}
+
+			memcpy(frame + track.offset, quantized, sizeof(quantized));
+		}
+		else if (track.format == CompressedTrackFormat::Raw)
+			memcpy(frame + track.offset, &sample, sizeof(sample));
+	}
+
+	/** Writes a single sample of a rotation track into a frame. */
+	static void writeSample(const CompressedTrack& track, const Quaternion& sample, UINT8* frame)
+	{
+		if (track.format != CompressedTrackFormat::SmallestThree)
+			return;
+
+		Quaternion normalized = sample;
+		normalized.normalize();
+
+		const UINT64 packed = packQuaternion(normalized);
+		memcpy(frame + track.offset, &packed, sizeof(packed));
+	}
+
+	/** Samples a set of curves and creates a track for each one. */
+	template<class T>
+	static void createTracks(const Vector<TNamedAnimationCurve<T>>& curves, float maxError, UINT32 numFrames,
+		float start, float end, UINT32 sampleRate, Vector<CompressedTrack>& tracks, Vector<Vector<T>>& samples,
+		UINT32& frameSize)
+	{
+		for (auto& entry : curves)
+		{
+			samples.push_back(sampleCurve(entry.curve, numFrames, start, end, sampleRate));
+			tracks.push_back(createTrack(samples.back(), maxError, frameSize));
+		}
+	}
+
+	/** Writes samples of all tracks of a single frame. */
+	template<class T>
+	static void writeSamples(const Vector<CompressedTrack>& tracks, const Vector<Vector<T>>& samples, UINT32 frameIdx,
+		UINT8* frame)
+	{
+		for (UINT32 i = 0; i < (UINT32)tracks.size(); i++)
+			writeSample(tracks[i], samples[i][frameIdx], frame);
+	}
+
+	SPtr<CompressedAnimationCurves> CompressedAnimationCurves::create(const AnimationCurves& curves, UINT32 sampleRate,
+		const AnimationCompressionSettings& settings)
+	{
+		SPtr<CompressedAnimationCurves> output = bs_shared_ptr_new<CompressedAnimationCurves>();
+
+		// Find the range covered by all the curves
+		float start = std::numeric_limits<float>::max();
+		float end = 0.0f;
+
+		const auto includeRange = [&start, &end](const auto& namedCurves)
+		{
+			for (auto& entry : namedCurves)
+			{
+				if (entry.curve.getNumKeyFrames() == 0)
+					continue;
+
+				const std::pair<float, float> range = entry.curve.getTimeRange();
+				start = std::min(start, range.first);
+				end = std::max(end, range.second);
+			}
+		};
+
+		includeRange(curves.position);
+		includeRange(curves.rotation);
+		includeRange(curves.scale);
+
+		if (start > end)
+			start = end;
+
+		sampleRate = std::max(sampleRate, 1U);
+
+		// Last frame is always placed at the end, even if the range isn't a multiple of the sample interval
+		UINT32 numFrames = Math::floorToPosInt((end - start) * sampleRate) + 1;
+		if (start + (numFrames - 1) / (float)sampleRate < end)
+			numFrames++;
+
+		Vector<Vector<Vector3>> positionSamples;
+		Vector<Vector<Quaternion>> rotationSamples;
+		Vector<Vector<Vector3>> scaleSamples;
+
+		UINT32 frameSize = 0;
+		createTracks(curves.position, settings.maxPositionError, numFrames, start, end, sampleRate,
+			output->mPositionTracks, positionSamples, frameSize);
+		createTracks(curves.rotation, settings.maxRotationError, numFrames, start, end, sampleRate,
+			output->mRotationTracks, rotationSamples, frameSize);
+		createTracks(curves.scale, settings.maxScaleError, numFrames, start, end, sampleRate,
+			output->mScaleTracks, scaleSamples, frameSize);
+
+		output->mFrameData.resize(frameSize * numFrames);
+		for (UINT32 i = 0; i < numFrames; i++)
+		{
+			UINT8* frame = output->mFrameData.data() + i * frameSize;
+
+			writeSamples(output->mPositionTracks, positionSamples, i, frame);
+			writeSamples(output->mRotationTracks, rotationSamples, i, frame);
+			writeSamples(output->mScaleTracks, scaleSamples, i, frame);
+		}
+
+		output->mFrameSize = frameSize;
+		output->mNumFrames = numFrames;
+		output->mSampleRate = sampleRate;
+		output->mStart = start;
+		output->mEnd = end;
+
+		return output;
+	}
+
+	CompressedAnimationCurves::FrameRange CompressedAnimationCurves::getFrameRange(float time, bool loop) const
+	{
+		AnimationUtility::wrapTime(time, mStart, mEnd, loop);
+
+		const float frame = std::max(0.0f, (time - mStart) * mSampleRate);
+		const UINT32 first = std::min(Math::floorToPosInt(frame), mNumFrames - 1);
+		const UINT32 second = std::min(first + 1, mNumFrames - 1);
+
+		const float firstTime = mStart + first / (float)mSampleRate;
+		const float secondTime = std::min(mStart + second / (float)mSampleRate, mEnd);
+
+		FrameRange range;
+		range.first = mFrameData.data() + first * mFrameSize;
+		range.second = mFrameData.data() + second * mFrameSize;
+		range.t = secondTime > firstTime ? Math::clamp01((time - firstTime) / (secondTime - firstTime)) : 0.0f;
+
+		return range;
+	}
+
+	Vector3 CompressedAnimationCurves::evaluate(const CompressedTrack& track, const FrameRange& range)
+	{
+		switch (track.format)
+		{
+		default:
+		case CompressedTrackFormat::Constant:
+			return Vector3(track.base.x, track.base.y, track.base.z);
+		case CompressedTrackFormat::Quantized:
+		{
+			UINT16 first[3];
+			UINT16 second[3];
+			memcpy(first, range.first + track.offset, sizeof(first));
+			memcpy(second, range.second + track.offset, sizeof(second));
+
+			const Vector3 firstValue(first[0], first[1], first[2]);
+			const Vector3 secondValue(second[0], second[1], second[2]);
+			const Vector3 normalized = (firstValue + (secondValue - firstValue) * range.t) / QUANTIZED_MAX;
+
+			return Vector3(track.base.x, track.base.y, track.base.z) + track.range * normalized;
+		}
+		case CompressedTrackFormat::Raw:
+		{
+			Vector3 first;
+			Vector3 second;
+			memcpy(&first, range.first + track.offset, sizeof(first));
+			memcpy(&second, range.second + track.offset, sizeof(second));
+
+			return first + (second - first) * range.t;
+		}
+		}
+	}
+
+	Quaternion CompressedAnimationCurves::evaluateRotation(const CompressedTrack& track, const FrameRange& range)
+	{
+		if (track.format != CompressedTrackFormat::SmallestThree)
+			return Quaternion(track.base.w, track.base.x, track.base.y, track.base.z);
+
+		UINT64 first;
+		UINT64 second;
+		memcpy(&first, range.first + track.offset, sizeof(first));
+		memcpy(&second, range.second + track.offset, sizeof(second));
+
+		const Quaternion firstValue = unpackQuaternion(first);
+		Quaternion secondValue = unpackQuaternion(second);
+
+		// Encoding doesn't preserve the sign, interpolate along the shorter path
+		if (firstValue.dot(secondValue) < 0.0f)
+			secondValue = -secondValue;
+
+		Quaternion output = firstValue * (1.0f - range.t) + secondValue * range.t;
+		output.normalize();
+
+		return output;
+	}
+
+	void CompressedAnimationCurves::evaluate(float time, bool loop, Vector3* positions, Quaternion* rotations,
+		Vector3* scales) const
+	{
+		const FrameRange range = getFrameRange(time, loop);
+
+		for (UINT32 i = 0; i < (UINT32)mPositionTracks.size(); i++)
+			positions[i] = evaluate(mPositionTracks[i], range);
+
+		for (UINT32 i = 0; i < (UINT32)mRotationTracks.size(); i++)
+			rotations[i] = evaluateRotation(mRotationTracks[i], range);
+
+		for (UINT32 i = 0; i < (UINT32)mScaleTracks.size(); i++)
+			scales[i] = evaluate(mScaleTracks[i], range);
+	}
+
+	Vector3 CompressedAnimationCurves::evaluatePosition(UINT32 track, float time, bool loop) const
+	{
+		return evaluate(mPositionTracks[track], getFrameRange(time, loop));
+	}
+
+	Quaternion CompressedAnimationCurves::evaluateRotation(UINT32 track, float time, bool loop) const
+	{
+		return evaluateRotation(mRotationTracks[track], getFrameRange(time, loop));
+	}
+
+	Vector3 CompressedAnimationCurves::evaluateScale(UINT32 track, float time, bool loop) const
+	{
+		return evaluate(mScaleTracks[track], getFrameRange(time, loop));
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTIStatic()
+	{
+		return CompressedAnimationCurvesRTTI::instance();
+	}
+
+	RTTITypeBase* CompressedAnimationCurves::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+}
@@ -0,0 +1,159 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsIReflectable.h"
+#include "Math/BsVector3.h"
+#include "Math/BsVector4.h"
+#include "Math/BsQuaternion.h"
+
+namespace bs
+{
+	/** @addtogroup Animation-Internal
+	 *  @{
+	 */
+
+	/** Determines how much error is allowed when compressing animation curves using CompressedAnimationCurves. */
+	struct BS_CORE_EXPORT AnimationCompressionSettings
+	{
+		/** Maximum error allowed in position curve values, in units of the curve. */
+		float maxPositionError = 0.0001f;
+
+		/** Maximum error allowed in individual components of a rotation quaternion. */
+		float maxRotationError = 0.0001f;
+
+		/** Maximum error allowed in scale curve values. */
+		float maxScaleError = 0.0001f;
+	};
+
+	/** Determines how is a single track of CompressedAnimationCurves stored. */
+	enum class CompressedTrackFormat : UINT32
+	{
+		/** Track doesn't change over the clip within the allowed error, and is stored as a single value. */
+		Constant,
+		/** Each frame stores a 16-bit value per component, within the track's range. Position and scale only. */
+		Quantized,
+		/** Each frame stores a full precision value. Position and scale only. */
+		Raw,
+		/** Each frame stores the three smallest components of the quaternion in 64 bits. Rotation only. */
+		SmallestThree
+	};
+
+	/** Information about a single track of CompressedAnimationCurves. */
+	struct CompressedTrack
+	{
+		CompressedTrackFormat format = CompressedTrackFormat::Constant;
+
+		/** Offset of the track's value within a frame, in bytes. Not used by constant tracks. */
+		UINT32 offset = 0;
+
+		/** Value of a constant track, or the minimum value of a quantized track. */
+		Vector4 base = Vector4::ZERO;
+
+		/** Difference between the maximum and the minimum value of a quantized track. */
+		Vector3 range = Vector3::ZERO;
+	};
+
+	BS_ALLOW_MEMCPY_SERIALIZATION(CompressedTrack);
+
+	/**
+	 * Compressed version of the position, rotation and scale curves of an AnimationClip. Curves are resampled at the
+	 * clip's sample rate, and the samples of all the curves are stored interleaved, frame by frame, so all the curves
+	 * can be evaluated at once while only touching two consecutive frames of memory. Curves that don't change by more
+	 * than the allowed error are stored as a single value. Rotations are quantized into 64 bits using their smallest
+	 * three components, and positions and scales into 16-bit values within their range over the clip.
+	 *
+	 * Tracks are stored in the same order as the curves in AnimationCurves they were created from, the track indices
+	 * match the indices in AnimationCurveMapping.
+	 *
+	 * @note	Immutable after creation, and as such safe to evaluate from multiple threads.
+	 */
+	class BS_CORE_EXPORT CompressedAnimationCurves : public IReflectable
+	{
+	public:
+		/**
+		 * Compresses the position, rotation and scale curves. Generic curves are not compressed.
+		 *
+		 * @param[in]	curves		Curves to compress.
+		 * @param[in]	sampleRate	Number of frames per second to resample the curves at.
+		 * @param[in]	settings	Determines how much error is allowed in the compressed values.
+		 */
+		static SPtr<CompressedAnimationCurves> create(const AnimationCurves& curves, UINT32 sampleRate,
+			const AnimationCompressionSettings& settings = AnimationCompressionSettings());
+
+		/**
+		 * Evaluates all the tracks at the specified time.
+		 *
+		 * @param[in]	time		Time to evaluate the tracks at.
+		 * @param[in]	loop		If true the time will wrap around the clip's range, otherwise it will be clamped.
+		 * @param[out]	positions	Pre-allocated array that receives a value for every position track.
+		 * @param[out]	rotations	Pre-allocated array that receives a value for every rotation track.
+		 * @param[out]	scales		Pre-allocated array that receives a value for every scale track.
+		 */
+		void evaluate(float time, bool loop, Vector3* positions, Quaternion* rotations, Vector3* scales) const;
+
+		/** Evaluates a single position track at the specified time. */
+		Vector3 evaluatePosition(UINT32 track, float time, bool loop) const;
+
+		/** Evaluates a single rotation track at the specified time. */
+		Quaternion evaluateRotation(UINT32 track, float time, bool loop) const;
+
+		/** Evaluates a single scale track at the specified time. */
+		Vector3 evaluateScale(UINT32 track, float time, bool loop) const;
+
+		/** Returns the number of position tracks. */
+		UINT32 getNumPositionTracks() const { return (UINT32)mPositionTracks.size(); }
+
+		/** Returns the number of rotation tracks. */
+		UINT32 getNumRotationTracks() const { return (UINT32)mRotationTracks.size(); }
+
+		/** Returns the number of scale tracks. */
+		UINT32 getNumScaleTracks() const { return (UINT32)mScaleTracks.size(); }
+
+		/** Returns the time of the last frame, in seconds. */
+		float getEnd() const { return mEnd; }
+
+		/** Returns the number of bytes used for storing the frames. */
+		UINT32 getDataSize() const { return (UINT32)mFrameData.size(); }
+
+	private:
+		/** Frames to interpolate between when evaluating at a specific time. */
+		struct FrameRange
+		{
+			const UINT8* first;
+			const UINT8* second;
+			float t;
+		};
+
+		/** Finds the frames to interpolate between at the specified time. */
+		FrameRange getFrameRange(float time, bool loop) const;
+
+		/** Evaluates a single position or scale track in the provided frame range. */
+		static Vector3 evaluate(const CompressedTrack& track, const FrameRange& range);
+
+		/** Evaluates a single rotation track in the provided frame range. */
+		static Quaternion evaluateRotation(const CompressedTrack& track, const FrameRange& range);
+
+		Vector<CompressedTrack> mPositionTracks;
+		Vector<CompressedTrack> mRotationTracks;
+		Vector<CompressedTrack> mScaleTracks;
+
+		Vector<UINT8> mFrameData;
+		UINT32 mFrameSize = 0;
+		UINT32 mNumFrames = 0;
+		UINT32 mSampleRate = 1;
+		float mStart = 0.0f;
+		float mEnd = 0.0f;
+
+		/************************************************************************/
+		/* 								SERIALIZATION                      		*/
+		/************************************************************************/
+	public:
+		friend class CompressedAnimationCurvesRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** @} */
+}
@@ -10,18 +10,38 @@
 #include "Animation/BsMorphShapes.h"
 #include "Mesh/BsMeshData.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Utility/BsTimer.h"
+#include "Math/BsSIMD.h"
+#include "Renderer/BsRenderer.h"
 
 namespace bs
 {
+	/** 
+	 * Number of bones to evaluate in a single chunk of work. This ensures a chunk's output transforms (64 bytes per bone)
+	 * fit in the L1 cache, while keeping the number of chunks low enough that scheduling overhead is negligible.
+	 */
+	static constexpr UINT32 BONES_PER_CHUNK = 512;
+
+	/** Maximum number of animation proxies to evaluate in a single chunk of work. */
+	static constexpr UINT32 MAX_PROXIES_PER_CHUNK = 64;
+
 	AnimationManager::AnimationManager()
 		: mNextId(1), mUpdateRate(1.0f / 60.0f), mAnimationTime(0.0f), mLastAnimationUpdateTime(0.0f)
-		, mNextAnimationUpdateTime(0.0f), mPaused(false), mPoseReadBufferIdx(2), mPoseWriteBufferIdx(0)
+		, mNextAnimationUpdateTime(0.0f), mPaused(false), mPoseReadBufferIdx(CoreThread::NUM_SYNC_BUFFERS)
+		, mPoseWriteBufferIdx(0)
 	{
 		mBlendShapeVertexDesc = VertexDataDesc::create();
 		mBlendShapeVertexDesc->addVertElem(VET_FLOAT3, VES_POSITION, 1, 1);
 		mBlendShapeVertexDesc->addVertElem(VET_UBYTE4_NORM, VES_NORMAL, 1, 1);
 	}
 
+	AnimationManager::~AnimationManager()
+	{
+		// Evaluation tasks reference the manager's data, make sure they're done before it's destroyed
+		if(mEvaluationTask != nullptr)
+			mEvaluationTask->wait();
+	}
+
 	void AnimationManager::setPaused(bool paused)
 	{
 		mPaused = paused;
@@ -38,20 +58,21 @@ namespace bs
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
+		if(mEvaluationTask != nullptr)
 		{
-			Lock lock(mMutex);
+			mEvaluationTask->wait();
+			mEvaluationTask = nullptr;
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
+			finalizeEvaluation();
+		}
 
-			// Advance the buffers (last write buffer becomes read buffer)
-			if(mSwapBuffers)
-			{
-				mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
-				mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+		// Advance the buffers (last write buffer becomes read buffer)
+		if(mSwapBuffers)
+		{
+			mPoseReadBufferIdx = (mPoseReadBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
+			mPoseWriteBufferIdx = (mPoseWriteBufferIdx + 1) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 
-				mSwapBuffers = false;
-			}
+			mSwapBuffers = false;
 		}
 
 		if(mPaused)
@@ -66,6 +87,10 @@ namespace bs
 		float timeDelta = mAnimationTime - mLastAnimationUpdateTime;
 		mLastAnimationUpdateTime = mAnimationTime;
 
+		// If the renderer can blend morph shapes itself, only the weights need to be evaluated
+		SPtr<ct::Renderer> renderer = ct::gRenderer();
+		mGpuMorphShapes = renderer != nullptr && renderer->supportsGpuMorphShapes();
+
 		// Trigger events and update attachments (for the data from the last frame)
 		if(async)
 		{
@@ -84,8 +109,9 @@ namespace bs
 			mProxies.push_back(anim.second->mAnimProxy);
 		}
 
-		// Build frustums for culling
+		// Build frustums for culling, and views for level of detail selection
 		mCullFrustums.clear();
+		mLODViews.clear();
 
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
@@ -96,61 +122,92 @@ namespace bs
 
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
-			mCullFrustums.push_back(entry.second->getWorldFrustum());
+			mCullFrustums.push_back(ConvexVolumeCuller(entry.second->getWorldFrustum()));
+
+			LODViewInfo viewInfo;
+			viewInfo.position = entry.second->getTransform().getPosition();
+			viewInfo.ortho = entry.second->getProjectionType() == PT_ORTHOGRAPHIC;
+
+			if (viewInfo.ortho)
+				viewInfo.projScale = entry.second->getOrthoWindowHeight();
+			else
+			{
+				float tanHalfFOV = Math::tan(entry.second->getHorzFOV() * 0.5f) / entry.second->getAspectRatio();
+				viewInfo.projScale = 1.0f / tanHalfFOV;
+			}
+
+			mLODViews.push_back(viewInfo);
 		}
 
-		// Prepare the write buffer
+		mUpdateIdx++;
+
+		// Calculate output locations for all proxies, and split them into chunks of roughly equal cost
+		const UINT32 numProxies = (UINT32)mProxies.size();
+		mProxyBoneOffsets.resize(numProxies);
+		mProxyResults.clear();
+		mProxyResults.resize(numProxies);
+		mChunks.clear();
+
 		UINT32 totalNumBones = 0;
-		for (auto& anim : mProxies)
+		UINT32 chunkStart = 0;
+		UINT32 chunkCost = 0;
+		for (UINT32 i = 0; i < numProxies; i++)
 		{
-			if (anim->skeleton != nullptr)
-				totalNumBones += anim->skeleton->getNumBones();
+			const SPtr<AnimationProxy>& anim = mProxies[i];
+			const UINT32 numBones = anim->skeleton != nullptr ? anim->skeleton->getNumBones() : 0;
+
+			mProxyBoneOffsets[i] = totalNumBones;
+			totalNumBones += numBones;
+
+			// Even animations without bones have some cost (e.g. scene object and morph shape animation)
+			chunkCost += std::max(numBones, 1U);
+			if (chunkCost >= BONES_PER_CHUNK || (i + 1 - chunkStart) >= MAX_PROXIES_PER_CHUNK)
+			{
+				mChunks.push_back({ chunkStart, i + 1 });
+				chunkStart = i + 1;
+				chunkCost = 0;
+			}
 		}
 
+		if (chunkStart < numProxies)
+			mChunks.push_back({ chunkStart, numProxies });
+
+		// Cull all the proxies at once, before they are split between the workers
+		mCullBounds.resize(numProxies);
+		for (UINT32 i = 0; i < numProxies; i++)
+			mCullBounds[i] = mProxies[i]->mBounds;
+
+		mProxyVisibility.assign(Math::divideAndRoundUp(numProxies, 32U), 0);
+		for (auto& frustum : mCullFrustums)
+			frustum.intersects(mCullBounds.data(), numProxies, mProxyVisibility.data());
+
 		// Prepare the write buffer
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
+		mTotalChunkTimeUs = 0;
+		mMaxChunkTimeUs = 0;
+
 		// Queue animation evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
-		}
+		const auto evaluateWorker = [this](UINT32 chunkIdx) { evaluateChunk(chunkIdx); };
 
-		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
+		if(async)
 		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
-			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
-
-				Lock lock(mMutex);
-				{
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
-				}
-
-				mWorkerDoneSignal.notify_one();
-			};
-
-			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
-			TaskScheduler::instance().addTask(task);
-
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
+			mEvaluationTask = TaskGroup::create("AnimWorker", evaluateWorker, (UINT32)mChunks.size());
+			TaskScheduler::instance().addTaskGroup(mEvaluationTask);
 		}
-
-		// Wait for tasks to complete
-		if(!async)
+		else
 		{
+			// Evaluate the chunks and wait for them to complete, with this thread helping out
+			TaskScheduler::instance().parallelFor((UINT32)mChunks.size(), 1, 
+				[&evaluateWorker](UINT32 start, UINT32 end)
 			{
-				Lock lock(mMutex);
+				for (UINT32 i = start; i < end; i++)
+					evaluateWorker(i);
+			});
 
-				while (mNumActiveWorkers > 0)
-					mWorkerDoneSignal.wait(lock);
-			}
+			finalizeEvaluation();
 
 			// Trigger events and update attachments (for the data we just evaluated)
 			for (auto& anim : mAnimations)
@@ -168,63 +225,181 @@ namespace bs
 			return &mAnimData[mPoseReadBufferIdx];
 	}
 
-	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+	float AnimationManager::calculateScreenSize(const AABox& bounds) const
 	{
-		if (anim->mCullEnabled)
+		const Vector3 center = bounds.getCenter();
+		const float radius = bounds.getRadius();
+
+		float screenSize = 0.0f;
+		for (auto& view : mLODViews)
 		{
-			bool isVisible = false;
-			for (auto& frustum : mCullFrustums)
+			float viewScreenSize;
+			if (view.ortho)
+				viewScreenSize = (radius * 2.0f) / view.projScale;
+			else
 			{
-				if (frustum.intersects(anim->mBounds))
-				{
-					isVisible = true;
-					break;
-				}
+				const float distance = center.distance(view.position);
+				if (distance <= radius)
+					return std::numeric_limits<float>::max();
+
+				viewScreenSize = (radius * view.projScale) / distance;
 			}
 
-			if (!isVisible)
-				return;
+			screenSize = std::max(screenSize, viewScreenSize);
+		}
+
+		return screenSize;
+	}
+
+	const AnimationLODLevel* AnimationManager::findLODLevel(const AnimationProxy& anim) const
+	{
+		if (anim.lodLevels.empty() || mLODViews.empty())
+			return nullptr;
+
+		// Levels are sorted from highest to lowest detail, find the last one that still covers the animation's size
+		const float screenSize = calculateScreenSize(anim.mBounds);
+
+		const AnimationLODLevel* output = nullptr;
+		for (auto& level : anim.lodLevels)
+		{
+			if (screenSize > level.screenSize)
+				break;
+
+			output = &level;
+		}
+
+		return output;
+	}
+
+	void AnimationManager::evaluateChunk(UINT32 chunkIdx)
+	{
+		Timer timer;
+
+		const EvaluationChunk& chunk = mChunks[chunkIdx];
+		for (UINT32 i = chunk.start; i < chunk.end; i++)
+		{
+			AnimationProxy* anim = mProxies[i].get();
+
+			const bool isVisible = (mProxyVisibility[i / 32] & (1U << (i % 32))) != 0;
+			if (anim->mCullEnabled && !isVisible)
+				continue;
+
+			ProxyEvaluationResult& result = mProxyResults[i];
+			result.hasAnimInfo = evaluateAnimation(anim, mProxyBoneOffsets[i], result.animInfo);
+		}
+
+		const UINT64 elapsedUs = timer.getMicroseconds();
+		mTotalChunkTimeUs += elapsedUs;
+
+		UINT64 maxTimeUs = mMaxChunkTimeUs.load();
+		while (elapsedUs > maxTimeUs && !mMaxChunkTimeUs.compare_exchange_weak(maxTimeUs, elapsedUs))
+		{ }
+	}
+
+	void AnimationManager::finalizeEvaluation()
+	{
+		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
+
+		const UINT32 numProxies = (UINT32)mProxies.size();
+		for (UINT32 i = 0; i < numProxies; i++)
+		{
+			const ProxyEvaluationResult& result = mProxyResults[i];
+			if (result.hasAnimInfo)
+				renderData.infos[mProxies[i]->id] = result.animInfo;
 		}
 
+		mEvaluationStats.numProxies = numProxies;
+		mEvaluationStats.numChunks = (UINT32)mChunks.size();
+		mEvaluationStats.totalChunkTimeUs = mTotalChunkTimeUs;
+		mEvaluationStats.maxChunkTimeUs = mMaxChunkTimeUs;
+	}
+
+	bool AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32 curBoneIdx, 
+		EvaluatedAnimationData::AnimInfo& animInfo)
+	{
+		// Determine if the animation needs to be evaluated this update, or if it can be interpolated from previous updates
+		const AnimationLODLevel* lod = findLODLevel(*anim);
+		const UINT32 updateInterval = lod != nullptr ? std::max(lod->updateInterval, 1U) : 1;
+		const UINT32 numBones = anim->skeleton != nullptr ? anim->skeleton->getNumBones() : 0;
+
+		// If the animation wasn't evaluated last update (e.g. it was culled) or its skeleton changed, older outputs are stale
+		const bool isHistoryValid = anim->lastLODUpdate == mUpdateIdx - 1 && 
+			(anim->numLODPoses == 0 || (UINT32)anim->lodPoses[1].size() == numBones);
+
+		if (!isHistoryValid)
+			anim->numLODPoses = 0;
+
+		anim->lastLODUpdate = mUpdateIdx;
+
+		const bool evaluate = updateInterval == 1 || !isHistoryValid || (numBones > 0 && anim->numLODPoses == 0) ||
+			(mUpdateIdx - anim->lastLODEvaluation) >= updateInterval;
+
+		if (evaluate)
+			anim->lastLODEvaluation = mUpdateIdx;
+
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
 		
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 		EvaluatedAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 
-		EvaluatedAnimationData::AnimInfo animInfo;
 		bool hasAnimInfo = false;
 
 		// Evaluate skeletal animation
 		if (anim->skeleton != nullptr)
 		{
-			UINT32 numBones = anim->skeleton->getNumBones();
-
 			EvaluatedAnimationData::PoseInfo& poseInfo = animInfo.poseInfo;
 			poseInfo.animId = anim->id;
 			poseInfo.startIdx = curBoneIdx;
 			poseInfo.numBones = numBones;
 
-			memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
 			Matrix4* boneDst = renderData.transforms.data() + curBoneIdx;
 
-			// Copy transforms from mapped scene objects
-			UINT32 boneTfrmIdx = 0;
-			for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+			if (evaluate)
 			{
-				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+				memset(anim->skeletonPose.hasOverride, 0, sizeof(bool) * anim->skeletonPose.numBones);
 
-				if (soInfo.boneIdx == -1)
-					continue;
+				// Copy transforms from mapped scene objects
+				UINT32 boneTfrmIdx = 0;
+				for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+				{
+					const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
 
-				boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
-				anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
-				boneTfrmIdx++;
+					if (soInfo.boneIdx == -1)
+						continue;
+
+					boneDst[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx];
+					anim->skeletonPose.hasOverride[soInfo.boneIdx] = true;
+					boneTfrmIdx++;
+				}
+
+				// Animate bones
+				const SkeletonMask& mask = lod != nullptr ? lod->mask : anim->skeletonMask;
+				anim->skeleton->getPose(boneDst, anim->skeletonPose, mask, anim->layers, anim->numLayers);
 			}
 
-			// Animate bones
-			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+			if (updateInterval > 1)
+			{
+				// Keep track of the two most recent poses, and interpolate between them on the updates in between
+				if (evaluate)
+				{
+					std::swap(anim->lodPoses[0], anim->lodPoses[1]);
+					anim->lodPoses[1].assign(boneDst, boneDst + numBones);
+					anim->numLODPoses = std::min(anim->numLODPoses + 1, 2U);
+				}
+
+				if (anim->numLODPoses > 1)
+				{
+					const UINT32 numUpdatesSinceEval = mUpdateIdx - anim->lastLODEvaluation + 1;
+					const float t = std::min(numUpdatesSinceEval / (float)updateInterval, 1.0f);
+
+					simd::lerp(anim->lodPoses[0].data(), anim->lodPoses[1].data(), boneDst, numBones, t);
+				}
+				else if (!evaluate)
+					memcpy(boneDst, anim->lodPoses[1].data(), sizeof(Matrix4) * numBones);
+			}
+			else
+				anim->numLODPoses = 0;
 
-			curBoneIdx += numBones;
 			hasAnimInfo = true;
 		}
 		else
@@ -235,77 +410,111 @@ namespace bs
 			poseInfo.numBones = 0;
 		}
 
-		// Reset mapped SO transform
-		for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+		// Skipped updates keep the scene object and generic curve outputs from the last evaluation
+		if (evaluate)
 		{
-			anim->sceneObjectPose.positions[i] = Vector3::ZERO;
-			anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
-			anim->sceneObjectPose.scales[i] = Vector3::ONE;
-		}
+			// Reset mapped SO transform
+			for (UINT32 i = 0; i < anim->sceneObjectPose.numBones; i++)
+			{
+				anim->sceneObjectPose.positions[i] = Vector3::ZERO;
+				anim->sceneObjectPose.rotations[i] = Quaternion::IDENTITY;
+				anim->sceneObjectPose.scales[i] = Vector3::ONE;
+			}
 
-		// Update mapped scene objects
-		memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * 3 * anim->numSceneObjects);
+			// Update mapped scene objects
+			memset(anim->sceneObjectPose.hasOverride, 1, sizeof(bool) * 3 * anim->numSceneObjects);
 
-		// Update scene object transforms
-		for (UINT32 i = 0; i < anim->numSceneObjects; i++)
-		{
-			const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+			// Update scene object transforms
+			for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+			{
+				const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
 
-			// We already evaluated bones
-			if (soInfo.boneIdx != -1)
-				continue;
+				// We already evaluated bones
+				if (soInfo.boneIdx != -1)
+					continue;
 
-			if (soInfo.layerIdx == -1 || soInfo.stateIdx == -1)
-				continue;
+				if (soInfo.layerIdx == -1 || soInfo.stateIdx == -1)
+					continue;
 
-			const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
-			if (state.disabled)
-				continue;
+				const AnimationState& state = anim->layers[soInfo.layerIdx].states[soInfo.stateIdx];
+				if (state.disabled)
+					continue;
 
-			{
-				UINT32 curveIdx = soInfo.curveIndices.position;
-				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-					anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.hasOverride[i * 3 + 0] = false;
+					UINT32 curveIdx = soInfo.curveIndices.position;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (state.compressedCurves != nullptr)
+						{
+							anim->sceneObjectPose.positions[curveIdx] =
+								state.compressedCurves->evaluatePosition(curveIdx, state.time, state.loop);
+						}
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							anim->sceneObjectPose.positions[curveIdx] =
+								curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
+
+						anim->sceneObjectPose.hasOverride[i * 3 + 0] = false;
+					}
 				}
-			}
 
-			{
-				UINT32 curveIdx = soInfo.curveIndices.rotation;
-				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-					anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.rotations[curveIdx].normalize();
-					anim->sceneObjectPose.hasOverride[i * 3 + 1] = false;
+					UINT32 curveIdx = soInfo.curveIndices.rotation;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (state.compressedCurves != nullptr)
+						{
+							anim->sceneObjectPose.rotations[curveIdx] =
+								state.compressedCurves->evaluateRotation(curveIdx, state.time, state.loop);
+						}
+						else
+						{
+							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+							anim->sceneObjectPose.rotations[curveIdx] =
+								curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+							anim->sceneObjectPose.rotations[curveIdx].normalize();
+						}
+
+						anim->sceneObjectPose.hasOverride[i * 3 + 1] = false;
+					}
 				}
-			}
 
-			{
-				UINT32 curveIdx = soInfo.curveIndices.scale;
-				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-					anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
-					anim->sceneObjectPose.hasOverride[i * 3 + 2] = false;
+					UINT32 curveIdx = soInfo.curveIndices.scale;
+					if (curveIdx != (UINT32)-1)
+					{
+						if (state.compressedCurves != nullptr)
+						{
+							anim->sceneObjectPose.scales[curveIdx] =
+								state.compressedCurves->evaluateScale(curveIdx, state.time, state.loop);
+						}
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							anim->sceneObjectPose.scales[curveIdx] =
+								curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
+
+						anim->sceneObjectPose.hasOverride[i * 3 + 2] = false;
+					}
 				}
 			}
-		}
 
-		// Update generic curves
-		// Note: No blending for generic animations, just use first animation
-		if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
-		{
-			const AnimationState& state = anim->layers[0].states[0];
-			if (!state.disabled)
+			// Update generic curves
+			// Note: No blending for generic animations, just use first animation
+			if (anim->numLayers > 0 && anim->layers[0].numStates > 0)
 			{
-				UINT32 numCurves = (UINT32)state.curves->generic.size();
-				for (UINT32 i = 0; i < numCurves; i++)
+				const AnimationState& state = anim->layers[0].states[0];
+				if (!state.disabled)
 				{
-					const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
-					anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
+					UINT32 numCurves = (UINT32)state.curves->generic.size();
+					for (UINT32 i = 0; i < numCurves; i++)
+					{
+						const TAnimationCurve<float>& curve = state.curves->generic[i].curve;
+						anim->genericCurveOutputs[i] = curve.evaluate(state.time, state.genericCaches[i], state.loop);
+					}
 				}
 			}
 		}
@@ -319,35 +528,76 @@ namespace bs
 			else
 				animInfo.morphShapeInfo.version = 1; // 0 is considered invalid version
 
-			// Recalculate weights if curves are present
-			bool hasMorphCurves = false;
-			for (UINT32 i = 0; i < anim->numMorphChannels; i++)
+			if (evaluate && (lod == nullptr || lod->morphShapes))
+				evaluateMorphShapes(anim, animInfo);
+
+			hasAnimInfo = true;
+		}
+		else
+			animInfo.morphShapeInfo.version = 1;
+
+		return hasAnimInfo;
+	}
+
+	void AnimationManager::evaluateMorphShapes(AnimationProxy* anim, EvaluatedAnimationData::AnimInfo& animInfo)
+	{
+		// Recalculate weights if curves are present
+		bool hasMorphCurves = false;
+		for (UINT32 i = 0; i < anim->numMorphChannels; i++)
+		{
+			MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
+			if (channelInfo.weightCurveIdx != (UINT32)-1)
 			{
-				MorphChannelInfo& channelInfo = anim->morphChannelInfos[i];
-				if (channelInfo.weightCurveIdx != (UINT32)-1)
-				{
-					channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
-					hasMorphCurves = true;
-				}
+				channelInfo.weight = Math::clamp01(anim->genericCurveOutputs[channelInfo.weightCurveIdx]);
+				hasMorphCurves = true;
+			}
 
-				float frameWeight;
-				if (channelInfo.frameCurveIdx != (UINT32)-1)
+			float frameWeight;
+			if (channelInfo.frameCurveIdx != (UINT32)-1)
+			{
+				frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
+				hasMorphCurves = true;
+			}
+			else
+				frameWeight = 0.0f;
+
+			if (channelInfo.shapeCount == 1)
+			{
+				MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
+
+				// Blend between base shape and the only available frame
+				float relative = frameWeight - shapeInfo.frameWeight;
+				if (relative <= 0.0f)
 				{
-					frameWeight = Math::clamp01(anim->genericCurveOutputs[channelInfo.frameCurveIdx]);
-					hasMorphCurves = true;
+					float diff = shapeInfo.frameWeight;
+					if (diff > 0.0f)
+					{
+						float t = -relative / diff;
+						shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
+					}
+					else
+						shapeInfo.finalWeight = 1.0f;
 				}
-				else
-					frameWeight = 0.0f;
-
-				if (channelInfo.shapeCount == 1)
+				else // If past the final frame we clamp
+					shapeInfo.finalWeight = 1.0f;
+			}
+			else if (channelInfo.shapeCount > 1)
+			{
+				for (UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
 				{
-					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart];
+					float prevShapeWeight;
+					if (j > 0)
+						prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
+					else
+						prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
+
+					float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
 
-					// Blend between base shape and the only available frame
 					float relative = frameWeight - shapeInfo.frameWeight;
 					if (relative <= 0.0f)
 					{
-						float diff = shapeInfo.frameWeight;
+						float diff = shapeInfo.frameWeight - prevShapeWeight;
 						if (diff > 0.0f)
 						{
 							float t = -relative / diff;
@@ -356,155 +606,133 @@ namespace bs
 						else
 							shapeInfo.finalWeight = 1.0f;
 					}
-					else // If past the final frame we clamp
-						shapeInfo.finalWeight = 1.0f;
-				}
-				else if (channelInfo.shapeCount > 1)
-				{
-					for (UINT32 j = 0; j < channelInfo.shapeCount - 1; j++)
+					else
 					{
-						float prevShapeWeight;
-						if (j > 0)
-							prevShapeWeight = anim->morphShapeInfos[j - 1].frameWeight;
-						else
-							prevShapeWeight = 0.0f; // Base shape, blend between it and the first frame
-
-						float nextShapeWeight = anim->morphShapeInfos[j + 1].frameWeight;
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[j];
-
-						float relative = frameWeight - shapeInfo.frameWeight;
-						if (relative <= 0.0f)
+						float diff = nextShapeWeight - shapeInfo.frameWeight;
+						if (diff > 0.0f)
 						{
-							float diff = shapeInfo.frameWeight - prevShapeWeight;
-							if (diff > 0.0f)
-							{
-								float t = -relative / diff;
-								shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-							}
-							else
-								shapeInfo.finalWeight = 1.0f;
+							float t = relative / diff;
+							shapeInfo.finalWeight = std::min(t, 1.0f);
 						}
 						else
-						{
-							float diff = nextShapeWeight - shapeInfo.frameWeight;
-							if (diff > 0.0f)
-							{
-								float t = relative / diff;
-								shapeInfo.finalWeight = std::min(t, 1.0f);
-							}
-							else
-								shapeInfo.finalWeight = 0.0f;
-						}
+							shapeInfo.finalWeight = 0.0f;
 					}
+				}
 
-					// Last frame
-					{
-						UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
-						MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
-						MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
+				// Last frame
+				{
+					UINT32 lastFrame = channelInfo.shapeStart + channelInfo.shapeCount - 1;
+					MorphShapeInfo& prevShapeInfo = anim->morphShapeInfos[lastFrame - 1];
+					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[lastFrame];
 
-						float relative = frameWeight - shapeInfo.frameWeight;
-						if (relative <= 0.0f)
+					float relative = frameWeight - shapeInfo.frameWeight;
+					if (relative <= 0.0f)
+					{
+						float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
+						if (diff > 0.0f)
 						{
-							float diff = shapeInfo.frameWeight - prevShapeInfo.frameWeight;
-							if (diff > 0.0f)
-							{
-								float t = -relative / diff;
-								shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
-							}
-							else
-								shapeInfo.finalWeight = 1.0f;
+							float t = -relative / diff;
+							shapeInfo.finalWeight = 1.0f - std::min(t, 1.0f);
 						}
-						else // If past the final frame we clamp
+						else
 							shapeInfo.finalWeight = 1.0f;
 					}
-				}
-
-				for (UINT32 j = 0; j < channelInfo.shapeCount; j++)
-				{
-					MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
-					shapeInfo.finalWeight *= channelInfo.weight;
+					else // If past the final frame we clamp
+						shapeInfo.finalWeight = 1.0f;
 				}
 			}
 
-			// Generate morph shape vertices
-			if (anim->morphChannelWeightsDirty || hasMorphCurves)
+			for (UINT32 j = 0; j < channelInfo.shapeCount; j++)
 			{
-				SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
+				MorphShapeInfo& shapeInfo = anim->morphShapeInfos[channelInfo.shapeStart + j];
+				shapeInfo.finalWeight *= channelInfo.weight;
+			}
+		}
 
-				UINT8* bufferData = meshData->getData();
-				memset(bufferData, 0, meshData->getSize());
+		if (!anim->morphChannelWeightsDirty && !hasMorphCurves)
+			return;
 
-				UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
-				UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
-				memset(tempData, 0, tempDataSize);
+		if (mGpuMorphShapes)
+		{
+			Vector<float>& weights = animInfo.morphShapeInfo.weights;
+			weights.resize(anim->numMorphShapes);
 
-				Vector3* tempNormals = (Vector3*)tempData;
-				float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
+			for (UINT32 i = 0; i < anim->numMorphShapes; i++)
+				weights[i] = anim->morphShapeInfos[i].finalWeight;
 
-				UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
-				UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
+			animInfo.morphShapeInfo.meshData = nullptr;
+			animInfo.morphShapeInfo.version++;
+			anim->morphChannelWeightsDirty = false;
 
-				UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
+			return;
+		}
 
-				for (UINT32 i = 0; i < anim->numMorphShapes; i++)
-				{
-					const MorphShapeInfo& info = anim->morphShapeInfos[i];
-					float absWeight = Math::abs(info.finalWeight);
+		// Generate morph shape vertices
+		animInfo.morphShapeInfo.weights.clear();
 
-					if (absWeight < 0.0001f)
-						continue;
+		SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
 
-					const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
-					UINT32 numVertices = (UINT32)morphVertices.size();
-					for (UINT32 j = 0; j < numVertices; j++)
-					{
-						const MorphVertex& vertex = morphVertices[j];
+		UINT8* bufferData = meshData->getData();
+		memset(bufferData, 0, meshData->getSize());
 
-						Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
-						*destPos += vertex.deltaPosition * info.finalWeight;
+		UINT32 tempDataSize = (sizeof(Vector3) + sizeof(float)) * anim->numMorphVertices;
+		UINT8* tempData = (UINT8*)bs_stack_alloc(tempDataSize);
+		memset(tempData, 0, tempDataSize);
 
-						tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
-						accumulatedWeight[vertex.sourceIdx] += absWeight;
-					}
-				}
+		Vector3* tempNormals = (Vector3*)tempData;
+		float* accumulatedWeight = (float*)(tempData + sizeof(Vector3) * anim->numMorphVertices);
 
-				for (UINT32 i = 0; i < anim->numMorphVertices; i++)
-				{
-					PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
+		UINT8* positions = meshData->getElementData(VES_POSITION, 1, 1);
+		UINT8* normals = meshData->getElementData(VES_NORMAL, 1, 1);
 
-					if (accumulatedWeight[i] > 0.0001f)
-					{
-						Vector3 normal = tempNormals[i] / accumulatedWeight[i];
-						normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
+		UINT32 stride = mBlendShapeVertexDesc->getVertexStride(1);
 
-						MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
-						destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
-					}
-					else
-					{
-						*destNrm = { { 127, 127, 127, 0 } };
-					}
-				}
+		for (UINT32 i = 0; i < anim->numMorphShapes; i++)
+		{
+			const MorphShapeInfo& info = anim->morphShapeInfos[i];
+			float absWeight = Math::abs(info.finalWeight);
 
-				bs_stack_free(tempData);
+			if (absWeight < 0.0001f)
+				continue;
 
-				animInfo.morphShapeInfo.meshData = meshData;
+			const Vector<MorphVertex>& morphVertices = info.shape->getVertices();
+			UINT32 numVertices = (UINT32)morphVertices.size();
+			for (UINT32 j = 0; j < numVertices; j++)
+			{
+				const MorphVertex& vertex = morphVertices[j];
 
-				animInfo.morphShapeInfo.version++;
-				anim->morphChannelWeightsDirty = false;
-			}
+				Vector3* destPos = (Vector3*)(positions + vertex.sourceIdx * stride);
+				*destPos += vertex.deltaPosition * info.finalWeight;
 
-			hasAnimInfo = true;
+				tempNormals[vertex.sourceIdx] += vertex.deltaNormal * info.finalWeight;
+				accumulatedWeight[vertex.sourceIdx] += absWeight;
+			}
 		}
-		else
-			animInfo.morphShapeInfo.version = 1;
 
-		if (hasAnimInfo)
+		for (UINT32 i = 0; i < anim->numMorphVertices; i++)
 		{
-			Lock lock(mMutex);
-			renderData.infos[anim->id] = animInfo;
+			PackedNormal* destNrm = (PackedNormal*)(normals + i * stride);
+
+			if (accumulatedWeight[i] > 0.0001f)
+			{
+				Vector3 normal = tempNormals[i] / accumulatedWeight[i];
+				normal /= 2.0f; // Accumulated normal is in range [-2, 2] but our normal packing method assumes [-1, 1] range
+
+				MeshUtility::packNormals(&normal, (UINT8*)destNrm, 1, sizeof(Vector3), stride);
+				destNrm->w = (UINT8)(std::min(1.0f, accumulatedWeight[i]) * 255.999f);
+			}
+			else
+			{
+				*destNrm = { { 127, 127, 127, 0 } };
+			}
 		}
+
+		bs_stack_free(tempData);
+
+		animInfo.morphShapeInfo.meshData = meshData;
+
+		animInfo.morphShapeInfo.version++;
+		anim->morphChannelWeightsDirty = false;
 	}
 
 	UINT64 AnimationManager::registerAnimation(Animation* anim)
@@ -11,6 +11,8 @@
 namespace bs
 {
 	struct AnimationProxy;
+	struct AnimationLODLevel;
+	class TaskGroup;
 
 	/** @addtogroup Animation-Internal
 	 *  @{
@@ -27,10 +29,18 @@ namespace bs
 			UINT32 numBones;
 		};
 
-		/** Contains data about a calculated morph shape. */
+		/** 
+		 * Contains data about a calculated morph shape. Depending on the renderer either the blended vertices or only
+		 * the shape weights are provided.
+		 */
 		struct MorphShapeInfo
 		{
+			/** Blended morph shape vertices. Null if the renderer blends morph shapes on the GPU. */
 			SPtr<MeshData> meshData;
+
+			/** Weight of every morph shape, across all channels. Only provided if the renderer blends on the GPU. */
+			Vector<float> weights;
+
 			UINT32 version;
 		};
 
@@ -50,6 +60,22 @@ namespace bs
 		Vector<Matrix4> transforms;
 	};
 
+	/** Contains statistics about the most recent animation evaluation. */
+	struct AnimationEvaluationStats
+	{
+		/** Number of animation proxies that were evaluated. */
+		UINT32 numProxies = 0;
+
+		/** Number of chunks the proxies were split into, each evaluated as a single unit of work on a worker thread. */
+		UINT32 numChunks = 0;
+
+		/** Total time spent evaluating all chunks, across all threads, in microseconds. */
+		UINT64 totalChunkTimeUs = 0;
+
+		/** Time spent evaluating the slowest chunk, in microseconds. */
+		UINT64 maxChunkTimeUs = 0;
+	};
+
 	/** 
 	 * Keeps track of all active animations, queues animation thread tasks and synchronizes data between simulation, core
 	 * and animation threads.
@@ -58,6 +84,7 @@ namespace bs
 	{
 	public:
 		AnimationManager();
+		~AnimationManager();
 
 		/** Pauses or resumes the animation evaluation. */
 		void setPaused(bool paused);
@@ -86,6 +113,12 @@ namespace bs
 		 */
 		const EvaluatedAnimationData* update(bool async = true);
 
+		/** 
+		 * Returns statistics about the most recently completed animation evaluation. Statistics are only available once
+		 * evaluation completes, meaning when evaluating asynchronously they will be one frame behind.
+		 */
+		const AnimationEvaluationStats& getEvaluationStats() const { return mEvaluationStats; }
+
 	private:
 		friend class Animation;
 
@@ -106,13 +139,64 @@ namespace bs
 		void unregisterAnimation(UINT64 id);
 
 		/** 
-		 * Evaluates animation for a single object and writes the result in the currently active write buffer. 
+		 * Evaluates animation for a single object and writes the resulting bone transforms in the currently active write
+		 * buffer. 
 		 *
 		 * @param[in]	anim		Proxy representing the animation to evaluate.
-		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
-		 *							automatically advanced by the number of written bone transforms.
+		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information.
+		 * @param[out]	animInfo	Information about where the evaluated data is stored.
+		 * @return					True if @p animInfo was populated and should be registered with the write buffer.
+		 */
+		bool evaluateAnimation(AnimationProxy* anim, UINT32 boneIdx, EvaluatedAnimationData::AnimInfo& animInfo);
+
+		/** 
+		 * Evaluates morph shape weights for the provided animation and generates new morph shape vertices if the weights
+		 * changed. @p animInfo is expected to contain the morph shape information from the previous evaluation.
+		 */
+		void evaluateMorphShapes(AnimationProxy* anim, EvaluatedAnimationData::AnimInfo& animInfo);
+
+		/** Evaluates all animation proxies in the specified chunk. */
+		void evaluateChunk(UINT32 chunkIdx);
+
+		/** 
+		 * Registers all animation infos output by the last evaluation with the write buffer and records evaluation
+		 * statistics. Must be called after all evaluation tasks complete.
+		 */
+		void finalizeEvaluation();
+
+		/** Range of animation proxies evaluated as a single unit of work. */
+		struct EvaluationChunk
+		{
+			UINT32 start;
+			UINT32 end;
+		};
+
+		/** 
+		 * Returns the size of the provided bounds on screen, as a fraction of the viewport height. Largest size among
+		 * all cameras is returned.
+		 */
+		float calculateScreenSize(const AABox& bounds) const;
+
+		/** 
+		 * Chooses a level of detail for the provided animation, based on its on-screen size. Returns null if the
+		 * animation should be evaluated at full detail.
 		 */
-		void evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+		const AnimationLODLevel* findLODLevel(const AnimationProxy& anim) const;
+
+		/** Information about a camera used for determining animation level of detail. */
+		struct LODViewInfo
+		{
+			Vector3 position;
+			float projScale; /**< Reciprocal of the tangent of the half of vertical field of view, or ortho height. */
+			bool ortho;
+		};
+
+		/** Output of evaluateAnimation() for a single proxy. */
+		struct ProxyEvaluationResult
+		{
+			EvaluatedAnimationData::AnimInfo animInfo;
+			bool hasAnimInfo = false;
+		};
 
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
@@ -124,19 +208,29 @@ namespace bs
 		bool mPaused;
 
 		SPtr<VertexDataDesc> mBlendShapeVertexDesc;
+		bool mGpuMorphShapes = false;
 
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
-		Vector<ConvexVolume> mCullFrustums;
+		Vector<ConvexVolumeCuller> mCullFrustums;
+		Vector<AABox> mCullBounds;
+		Vector<UINT32> mProxyVisibility; // One bit per proxy, set if visible from any of the cull frustums
+		Vector<LODViewInfo> mLODViews;
+		UINT32 mUpdateIdx = 0;
 		EvaluatedAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS + 1];
 
 		UINT32 mPoseReadBufferIdx;
 		UINT32 mPoseWriteBufferIdx;
-		
-		Signal mWorkerDoneSignal;
-		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
+		Vector<UINT32> mProxyBoneOffsets;
+		Vector<ProxyEvaluationResult> mProxyResults;
+		Vector<EvaluationChunk> mChunks;
+		SPtr<TaskGroup> mEvaluationTask;
+
+		std::atomic<UINT64> mTotalChunkTimeUs{0};
+		std::atomic<UINT64> mMaxChunkTimeUs{0};
+		AnimationEvaluationStats mEvaluationStats;
+
 		bool mSwapBuffers = false;
 	};
 
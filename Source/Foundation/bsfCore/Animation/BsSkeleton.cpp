@@ -4,6 +4,7 @@
 #include "Animation/BsAnimationClip.h"
 #include "Animation/BsSkeletonMask.h"
 #include "Private/RTTI/BsSkeletonRTTI.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -113,6 +114,7 @@ namespace bs
 
 			AnimationState state;
 			state.curves = clip.getCurves();
+			state.compressedCurves = clip.getCompressedCurves();
 			state.boneToCurveMapping = boneToCurveMapping.data();
 			state.loop = loop;
 			state.weight = 1.0f;
@@ -144,8 +146,6 @@ namespace bs
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
-
 		assert(localPose.numBones == mNumBones);
 
 		for(UINT32 i = 0; i < mNumBones; i++)
@@ -189,6 +189,29 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
+				// Compressed clips evaluate all of their tracks at once, instead of evaluating each curve on demand
+				UINT8* sampledData = nullptr;
+				Vector3* sampledPositions = nullptr;
+				Quaternion* sampledRotations = nullptr;
+				Vector3* sampledScales = nullptr;
+
+				const CompressedAnimationCurves* compressed = state.compressedCurves.get();
+				if (compressed != nullptr)
+				{
+					const UINT32 numPositions = compressed->getNumPositionTracks();
+					const UINT32 numRotations = compressed->getNumRotationTracks();
+					const UINT32 numScales = compressed->getNumScaleTracks();
+
+					sampledData = (UINT8*)bs_stack_alloc(
+						sizeof(Vector3) * (numPositions + numScales) + sizeof(Quaternion) * numRotations);
+
+					sampledPositions = (Vector3*)sampledData;
+					sampledRotations = (Quaternion*)(sampledPositions + numPositions);
+					sampledScales = (Vector3*)(sampledRotations + numRotations);
+
+					compressed->evaluate(state.time, state.loop, sampledPositions, sampledRotations, sampledScales);
+				}
+
 				for (UINT32 k = 0; k < mNumBones; k++)
 				{
 					if (!mask.isEnabled(k))
@@ -198,8 +221,16 @@ namespace bs
 					UINT32 curveIdx = mapping.position;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressed != nullptr)
+							value = sampledPositions[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
+							value = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+						}
+
+						localPose.positions[k] += value * normWeight;
 
 						localPose.hasOverride[k] = false;
 						hasAnimCurve[k] = true;
@@ -208,8 +239,16 @@ namespace bs
 					curveIdx = mapping.scale;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
+						Vector3 value;
+						if (compressed != nullptr)
+							value = sampledScales[curveIdx];
+						else
+						{
+							const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
+							value = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+						}
+
+						localPose.scales[k] *= value * normWeight;
 
 						localPose.hasOverride[k] = false;
 						hasAnimCurve[k] = true;
@@ -224,9 +263,15 @@ namespace bs
 							if (!isAssigned)
 								localPose.rotations[k] = Quaternion::IDENTITY;
 
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+							Quaternion value;
+							if (compressed != nullptr)
+								value = sampledRotations[curveIdx];
+							else
+							{
+								const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+								value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+							}
 
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
 							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
 
 							localPose.rotations[k] *= value;
@@ -239,8 +284,16 @@ namespace bs
 						curveIdx = mapping.rotation;
 						if (curveIdx != (UINT32)-1)
 						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
+							Quaternion value;
+							if (compressed != nullptr)
+								value = sampledRotations[curveIdx];
+							else
+							{
+								const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
+								value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+							}
+
+							value = value * normWeight;
 
 							if (value.dot(localPose.rotations[k]) < 0.0f)
 								value = -value;
@@ -251,6 +304,9 @@ namespace bs
 						}
 					}
 				}
+
+				if (sampledData != nullptr)
+					bs_stack_free(sampledData);
 			}
 		}
 
@@ -275,14 +331,42 @@ namespace bs
 			bool isAssigned = localPose.rotations[i].w != 0.0f;
 			if (!isAssigned)
 				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
 
 			if (localPose.hasOverride[i])
-			{
 				isGlobal[i] = true;
-				continue;
+		}
+
+		// Normalize rotations and build the matrices four bones at a time
+		const UINT32 numSIMDBones = (mNumBones / 4) * 4;
+		for(UINT32 i = 0; i < numSIMDBones; i += 4)
+		{
+			const bool* hasOverride = &localPose.hasOverride[i];
+			if(!hasOverride[0] && !hasOverride[1] && !hasOverride[2] && !hasOverride[3])
+			{
+				simd::normalizeAndComposeTRS4(&localPose.positions[i], &localPose.rotations[i], &localPose.scales[i],
+					&pose[i]);
+			}
+			else
+			{
+				// Overriden bones already have their final transform in the output, write to a temporary instead
+				Matrix4 localMatrices[4];
+				simd::normalizeAndComposeTRS4(&localPose.positions[i], &localPose.rotations[i], &localPose.scales[i],
+					localMatrices);
+
+				for(UINT32 j = 0; j < 4; j++)
+				{
+					if(!hasOverride[j])
+						pose[i + j] = localMatrices[j];
+				}
 			}
+		}
+
+		for(UINT32 i = numSIMDBones; i < mNumBones; i++)
+		{
+			localPose.rotations[i].normalize();
+
+			if (localPose.hasOverride[i])
+				continue;
 
 			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
 		}
@@ -302,7 +386,7 @@ namespace bs
 			if (!isGlobal[parentBoneIdx])
 				calcGlobal(parentBoneIdx);
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
+			simd::multiplyAffine(pose[parentBoneIdx], pose[boneIdx], pose[boneIdx]);
 			isGlobal[boneIdx] = true;
 		};
 
@@ -312,8 +396,7 @@ namespace bs
 				calcGlobal(i);
 		}
 
-		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+		simd::multiplyAffine(pose, mInvBindPoses, pose, mNumBones);
 
 		bs_stack_free(isGlobal);
 		bs_stack_free(hasAnimCurve);
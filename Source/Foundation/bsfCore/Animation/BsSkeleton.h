@@ -43,6 +43,7 @@ namespace bs
 	struct AnimationState
 	{
 		SPtr<AnimationCurves> curves; /**< All curves in the animation clip. */
+		SPtr<CompressedAnimationCurves> compressedCurves; /**< Compressed curves of the clip, if any. */
 		AnimationCurveMapping* boneToCurveMapping; /**< Mapping of bone indices to curve indices for quick lookup .*/
 		AnimationCurveMapping* soToCurveMapping; /**< Mapping of scene object indices to curve indices for quick lookup. */
 
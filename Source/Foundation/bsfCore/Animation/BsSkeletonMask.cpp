@@ -17,6 +17,17 @@ namespace bs
 		return !mIsDisabled[boneIdx];
 	}
 
+	SkeletonMask SkeletonMask::intersect(const SkeletonMask& other) const
+	{
+		const UINT32 numBones = (UINT32)std::max(mIsDisabled.size(), other.mIsDisabled.size());
+
+		SkeletonMask output(numBones);
+		for (UINT32 i = 0; i < numBones; i++)
+			output.mIsDisabled[i] = !isEnabled(i) || !other.isEnabled(i);
+
+		return output;
+	}
+
 	SkeletonMaskBuilder::SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton)
 		:mSkeleton(skeleton), mMask(skeleton->getNumBones())
 	{ }
@@ -26,6 +26,9 @@ namespace bs
 		 */
 		bool isEnabled(UINT32 boneIdx) const;
 
+		/** Returns a mask that has only the bones enabled in both this and the provided mask enabled. */
+		SkeletonMask intersect(const SkeletonMask& other) const;
+
 	private:
 		friend class SkeletonMaskBuilder;
 
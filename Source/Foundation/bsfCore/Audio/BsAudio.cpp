@@ -27,6 +27,12 @@ namespace bs
 		mManualSources.clear();
 	}
 
+	void Audio::setDSPGraph(const SPtr<AudioDSPGraph>& graph)
+	{
+		if (graph != nullptr)
+			LOGWRN("DSP graphs are not supported by the active audio backend.");
+	}
+
 	void Audio::_update()
 	{
 		UINT32 numSources = (UINT32)mManualSources.size();
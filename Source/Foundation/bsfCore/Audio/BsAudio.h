@@ -8,6 +8,8 @@
 
 namespace bs
 {
+	class AudioDSPGraph;
+
 	/** @addtogroup Audio
 	 *  @{
 	 */
@@ -66,6 +68,13 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:AllDevices,pr:getter)
 		virtual const Vector<AudioDevice>& getAllDevices() const = 0;
 
+		/**
+		 * Starts rendering the provided graph on a dedicated DSP thread, and playing its output on the active device,
+		 * mixed with the audio sources. Only one graph can be played at a time. Pass null to stop playing the current
+		 * graph. By default DSP graphs are not supported, and the call is ignored.
+		 */
+		virtual void setDSPGraph(const SPtr<AudioDSPGraph>& graph);
+
 		/** @name Internal
 		 *  @{
 		 */
@@ -15,7 +15,12 @@ namespace bs
 	enum class BS_SCRIPT_EXPORT(m:Audio) AudioFormat
 	{
 		PCM, /**< Pulse code modulation audio ("raw" uncompressed audio). */
-		VORBIS /**< Vorbis compressed audio. */
+		VORBIS, /**< Vorbis compressed audio. */
+		/**
+		 * IMA ADPCM compressed audio, at a quarter of the size of 16-bit PCM. Cheaper to decode than Vorbis and can be
+		 * decoded from any position, which makes it a good fit for short, frequently played clips kept in memory.
+		 */
+		ADPCM
 	};
 
 	/** Modes that determine how and when is audio data read. */
@@ -0,0 +1,476 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Audio/BsAudioDSP.h"
+#include "Audio/BsAudioUtility.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	constexpr UINT32 AudioDSPInputNode::CHUNK_FRAMES;
+	constexpr UINT32 AudioReverbNode::CHUNK_FRAMES;
+	constexpr UINT32 AudioCompressorNode::GAIN_BLOCK_FRAMES;
+
+	/** Converts a value in decibels into a linear gain. */
+	static float dbToGain(float db)
+	{
+		return Math::pow(10.0f, db / 20.0f);
+	}
+
+	/** Returns the coefficient of an exponential smoother reaching ~63% of its target within @p ms milliseconds. */
+	static float getSmoothingCoefficient(float ms, float sampleRate)
+	{
+		return Math::exp(-1.0f / std::max(ms * 0.001f * sampleRate, 1.0f));
+	}
+
+	AudioDSPInputNode::AudioDSPInputNode(UINT32 capacity)
+		:mCapacity(capacity)
+	{ }
+
+	UINT32 AudioDSPInputNode::write(const float* samples, UINT32 numFrames)
+	{
+		if (mRing == nullptr)
+		{
+			LOGWRN("Writing samples to a DSP input that is not a part of a graph.");
+			return 0;
+		}
+
+		return mRing->write(samples, numFrames);
+	}
+
+	UINT32 AudioDSPInputNode::getNumFree() const
+	{
+		if (mRing == nullptr)
+			return 0;
+
+		return mRing->getNumFree();
+	}
+
+	void AudioDSPInputNode::initialize(UINT32 numChannels, UINT32 sampleRate)
+	{
+		mRing = bs_shared_ptr_new<AudioSampleRing>(numChannels, mCapacity);
+		mScratch.resize(CHUNK_FRAMES * numChannels);
+	}
+
+	void AudioDSPInputNode::process(float* const* channels, UINT32 numChannels, UINT32 numFrames)
+	{
+		UINT32 numProcessed = 0;
+		while (numProcessed < numFrames)
+		{
+			const UINT32 numRead = mRing->read(mScratch.data(), std::min(numFrames - numProcessed, CHUNK_FRAMES));
+			if (numRead == 0)
+				break;
+
+			for (UINT32 i = 0; i < numChannels; i++)
+			{
+				float* output = channels[i] + numProcessed;
+				for (UINT32 j = 0; j < numRead; j++)
+					output[j] += mScratch[j * numChannels + i];
+			}
+
+			numProcessed += numRead;
+		}
+
+		float prevGain;
+		const float gainValue = gain._advance(prevGain);
+		for (UINT32 i = 0; i < numChannels; i++)
+			AudioUtility::applyGain(channels[i], numFrames, prevGain, gainValue);
+	}
+
+	void AudioMixBusNode::process(float* const* channels, UINT32 numChannels, UINT32 numFrames)
+	{
+		float prevGain;
+		const float gainValue = gain._advance(prevGain);
+		if (prevGain == 1.0f && gainValue == 1.0f)
+			return;
+
+		for (UINT32 i = 0; i < numChannels; i++)
+			AudioUtility::applyGain(channels[i], numFrames, prevGain, gainValue);
+	}
+
+	void AudioLowPassNode::initialize(UINT32 numChannels, UINT32 sampleRate)
+	{
+		mChannels.resize(numChannels);
+		mSampleRate = (float)sampleRate;
+	}
+
+	void AudioLowPassNode::process(float* const* channels, UINT32 numChannels, UINT32 numFrames)
+	{
+		const float frequency = Math::clamp(cutoff.get(), 10.0f, mSampleRate * 0.49f);
+		const float coeff = 1.0f - Math::exp(-Math::TWO_PI * frequency / mSampleRate);
+
+		// Two one-pole filters in series. Each output depends on the previous one, so the filter runs one sample at a
+		// time, per channel.
+		for (UINT32 i = 0; i < numChannels; i++)
+		{
+			float* samples = channels[i];
+			float value0 = mChannels[i].values[0];
+			float value1 = mChannels[i].values[1];
+
+			for (UINT32 j = 0; j < numFrames; j++)
+			{
+				value0 += coeff * (samples[j] - value0);
+				value1 += coeff * (value0 - value1);
+
+				samples[j] = value1;
+			}
+
+			mChannels[i].values[0] = value0;
+			mChannels[i].values[1] = value1;
+		}
+	}
+
+	void AudioReverbNode::initialize(UINT32 numChannels, UINT32 sampleRate)
+	{
+		// Delay lengths of the Freeverb algorithm, tuned for 44.1kHz. Odd channels use slightly longer delays, so the
+		// channels decorrelate.
+		static const UINT32 COMB_LENGTHS[NUM_COMBS] = { 1116, 1188, 1277, 1356 };
+		static const UINT32 ALLPASS_LENGTHS[NUM_ALLPASSES] = { 556, 441 };
+		static const UINT32 STEREO_SPREAD = 23;
+
+		const float scale = sampleRate / 44100.0f;
+
+		mChannels.resize(numChannels);
+		for (UINT32 i = 0; i < numChannels; i++)
+		{
+			const UINT32 spread = (i % 2) * STEREO_SPREAD;
+
+			for (UINT32 j = 0; j < NUM_COMBS; j++)
+				mChannels[i].combs[j].samples.resize(std::max(1U, (UINT32)((COMB_LENGTHS[j] + spread) * scale)), 0.0f);
+
+			for (UINT32 j = 0; j < NUM_ALLPASSES; j++)
+			{
+				const UINT32 length = std::max(1U, (UINT32)((ALLPASS_LENGTHS[j] + spread) * scale));
+				mChannels[i].allpasses[j].samples.resize(length, 0.0f);
+			}
+		}
+
+		mWetSamples.resize(CHUNK_FRAMES);
+	}
+
+	void AudioReverbNode::process(float* const* channels, UINT32 numChannels, UINT32 numFrames)
+	{
+		static const float INPUT_GAIN = 0.015f;
+		static const float WET_SCALE = 3.0f;
+		static const float ALLPASS_FEEDBACK = 0.5f;
+
+		const float feedback = 0.7f + Math::clamp01(roomSize.get()) * 0.28f;
+		const float damp = Math::clamp01(damping.get()) * 0.4f;
+
+		float prevWet, prevDry;
+		const float wetGain = wet._advance(prevWet) * WET_SCALE;
+		const float dryGain = dry._advance(prevDry);
+		prevWet *= WET_SCALE;
+
+		for (UINT32 i = 0; i < numChannels; i++)
+		{
+			ChannelState& state = mChannels[i];
+
+			for (UINT32 start = 0; start < numFrames; start += CHUNK_FRAMES)
+			{
+				const UINT32 count = std::min(numFrames - start, CHUNK_FRAMES);
+				float* samples = channels[i] + start;
+
+				// Parallel comb filters, with a low-pass in their feedback path
+				memset(mWetSamples.data(), 0, count * sizeof(float));
+				for (auto& comb : state.combs)
+				{
+					const UINT32 length = (UINT32)comb.samples.size();
+					for (UINT32 j = 0; j < count; j++)
+					{
+						const float output = comb.samples[comb.position];
+						comb.filtered = output * (1.0f - damp) + comb.filtered * damp;
+						comb.samples[comb.position] = samples[j] * INPUT_GAIN + comb.filtered * feedback;
+
+						if (++comb.position == length)
+							comb.position = 0;
+
+						mWetSamples[j] += output;
+					}
+				}
+
+				// All-pass filters in series, diffusing the echoes
+				for (auto& allpass : state.allpasses)
+				{
+					const UINT32 length = (UINT32)allpass.samples.size();
+					for (UINT32 j = 0; j < count; j++)
+					{
+						const float delayed = allpass.samples[allpass.position];
+						allpass.samples[allpass.position] = mWetSamples[j] + delayed * ALLPASS_FEEDBACK;
+						mWetSamples[j] = delayed - mWetSamples[j];
+
+						if (++allpass.position == length)
+							allpass.position = 0;
+					}
+				}
+
+				const float t0 = start / (float)numFrames;
+				const float t1 = (start + count) / (float)numFrames;
+
+				AudioUtility::applyGain(mWetSamples.data(), count, Math::lerp(t0, prevWet, wetGain),
+					Math::lerp(t1, prevWet, wetGain));
+				AudioUtility::applyGain(samples, count, Math::lerp(t0, prevDry, dryGain),
+					Math::lerp(t1, prevDry, dryGain));
+				AudioUtility::mixSamples(mWetSamples.data(), samples, count);
+			}
+		}
+	}
+
+	void AudioCompressorNode::initialize(UINT32 numChannels, UINT32 sampleRate)
+	{
+		mSampleRate = (float)sampleRate;
+	}
+
+	void AudioCompressorNode::process(float* const* channels, UINT32 numChannels, UINT32 numFrames)
+	{
+		const float thresholdDb = threshold.get();
+		const float slope = 1.0f - 1.0f / std::max(ratio.get(), 1.0f);
+		const float attackCoeff = getSmoothingCoefficient(attack.get(), mSampleRate);
+		const float releaseCoeff = getSmoothingCoefficient(release.get(), mSampleRate);
+		const float makeup = makeupGain.get();
+
+		for (UINT32 start = 0; start < numFrames; start += GAIN_BLOCK_FRAMES)
+		{
+			const UINT32 count = std::min(numFrames - start, GAIN_BLOCK_FRAMES);
+
+			// Follow the peak level of all channels, so the stereo image doesn't shift when one channel gets loud
+			for (UINT32 i = 0; i < count; i++)
+			{
+				float peak = 0.0f;
+				for (UINT32 j = 0; j < numChannels; j++)
+					peak = std::max(peak, Math::abs(channels[j][start + i]));
+
+				const float coeff = peak > mEnvelope ? attackCoeff : releaseCoeff;
+				mEnvelope = peak + coeff * (mEnvelope - peak);
+			}
+
+			float gainDb = makeup;
+			const float envelopeDb = 20.0f * std::log10(std::max(mEnvelope, 1e-6f));
+			if (envelopeDb > thresholdDb)
+				gainDb -= (envelopeDb - thresholdDb) * slope;
+
+			const float gain = dbToGain(gainDb);
+			for (UINT32 j = 0; j < numChannels; j++)
+				AudioUtility::applyGain(channels[j] + start, count, mGain, gain);
+
+			mGain = gain;
+		}
+	}
+
+	AudioDSPGraph::AudioDSPGraph(UINT32 numChannels, UINT32 sampleRate, UINT32 maxBlockFrames)
+		:mNumChannels(numChannels), mSampleRate(sampleRate), mMaxBlockFrames(maxBlockFrames)
+	{
+		mChannelPtrs.resize(numChannels);
+	}
+
+	void AudioDSPGraph::addNode(const SPtr<AudioDSPNode>& node)
+	{
+		Lock lock(mMutex);
+
+		if (node->mGraph != nullptr && node->mGraph != this)
+		{
+			LOGERR("Cannot add a DSP node to a graph, the node is already a part of another graph.");
+			return;
+		}
+
+		if (std::find(mNodes.begin(), mNodes.end(), node) != mNodes.end())
+			return;
+
+		// Nodes re-added to the same graph keep their state, as the DSP thread might still be processing them
+		if (node->mGraph == nullptr)
+		{
+			node->mGraph = this;
+			node->mBuffer.resize(mNumChannels * mMaxBlockFrames, 0.0f);
+			node->initialize(mNumChannels, mSampleRate);
+		}
+
+		mNodes.push_back(node);
+	}
+
+	void AudioDSPGraph::removeNode(const SPtr<AudioDSPNode>& node)
+	{
+		Lock lock(mMutex);
+
+		auto iterFind = std::find(mNodes.begin(), mNodes.end(), node);
+		if (iterFind == mNodes.end())
+			return;
+
+		mNodes.erase(iterFind);
+		mConnections.erase(std::remove_if(mConnections.begin(), mConnections.end(),
+			[&node](const Connection& entry) { return entry.from == node.get() || entry.to == node.get(); }),
+			mConnections.end());
+
+		if (mOutput == node)
+			mOutput = nullptr;
+
+		rebuildSchedule();
+	}
+
+	void AudioDSPGraph::connect(const SPtr<AudioDSPNode>& from, const SPtr<AudioDSPNode>& to)
+	{
+		Lock lock(mMutex);
+
+		if (std::find(mNodes.begin(), mNodes.end(), from) == mNodes.end() ||
+			std::find(mNodes.begin(), mNodes.end(), to) == mNodes.end())
+		{
+			LOGERR("Cannot connect DSP nodes that are not a part of the graph.");
+			return;
+		}
+
+		for (auto& entry : mConnections)
+		{
+			if (entry.from == from.get() && entry.to == to.get())
+				return;
+		}
+
+		mConnections.push_back({ from.get(), to.get() });
+		rebuildSchedule();
+	}
+
+	void AudioDSPGraph::disconnect(const SPtr<AudioDSPNode>& from, const SPtr<AudioDSPNode>& to)
+	{
+		Lock lock(mMutex);
+
+		mConnections.erase(std::remove_if(mConnections.begin(), mConnections.end(),
+			[&](const Connection& entry) { return entry.from == from.get() && entry.to == to.get(); }),
+			mConnections.end());
+
+		rebuildSchedule();
+	}
+
+	void AudioDSPGraph::setOutput(const SPtr<AudioDSPNode>& node)
+	{
+		Lock lock(mMutex);
+
+		if (node != nullptr && std::find(mNodes.begin(), mNodes.end(), node) == mNodes.end())
+		{
+			LOGERR("Cannot use a DSP node that is not a part of the graph as the graph output.");
+			return;
+		}
+
+		mOutput = node;
+		rebuildSchedule();
+	}
+
+	void AudioDSPGraph::rebuildSchedule()
+	{
+		// Not visited nodes are missing from the map, nodes in the process of being visited map to -1, and visited
+		// nodes map to their index in the schedule
+		static constexpr UINT32 VISITING = (UINT32)-1;
+
+		Schedule schedule;
+		UnorderedMap<AudioDSPNode*, UINT32> visited;
+
+		// Depth first traversal from the output, towards the inputs, so every node is scheduled after its inputs
+		std::function<void(const SPtr<AudioDSPNode>&)> visit = [&](const SPtr<AudioDSPNode>& node)
+		{
+			visited[node.get()] = VISITING;
+
+			for (auto& entry : mConnections)
+			{
+				if (entry.to != node.get())
+					continue;
+
+				auto iterFind = visited.find(entry.from);
+				if (iterFind == visited.end())
+				{
+					for (auto& input : mNodes)
+					{
+						if (input.get() == entry.from)
+						{
+							visit(input);
+							break;
+						}
+					}
+				}
+				else if (iterFind->second == VISITING)
+					LOGWRN("DSP graph contains a cycle. Connection closing the cycle will be ignored.");
+			}
+
+			visited[node.get()] = (UINT32)schedule.nodes.size();
+			schedule.nodes.push_back(node);
+		};
+
+		if (mOutput != nullptr)
+			visit(mOutput);
+
+		// Only inputs scheduled before the node are mixed in, which leaves out the connections closing a cycle
+		for (UINT32 i = 0; i < (UINT32)schedule.nodes.size(); i++)
+		{
+			schedule.inputOffsets.push_back((UINT32)schedule.inputs.size());
+
+			for (auto& entry : mConnections)
+			{
+				if (entry.to != schedule.nodes[i].get())
+					continue;
+
+				auto iterFind = visited.find(entry.from);
+				if (iterFind != visited.end() && iterFind->second < i)
+					schedule.inputs.push_back(iterFind->second);
+			}
+		}
+
+		schedule.inputOffsets.push_back((UINT32)schedule.inputs.size());
+
+		// Also frees the schedule the DSP thread swapped out, if any
+		mPendingSchedule = std::move(schedule);
+		mIsScheduleDirty.store(true, std::memory_order_release);
+	}
+
+	void AudioDSPGraph::_render(float* output, UINT32 numFrames)
+	{
+		assert(numFrames <= mMaxBlockFrames);
+
+		// Never wait on the thread editing the graph, keep rendering the old topology until the lock is free instead
+		if (mIsScheduleDirty.load(std::memory_order_acquire) && mMutex.try_lock())
+		{
+			std::swap(mSchedule, mPendingSchedule);
+			mIsScheduleDirty.store(false, std::memory_order_relaxed);
+
+			mMutex.unlock();
+		}
+
+		const UINT32 numNodes = (UINT32)mSchedule.nodes.size();
+		if (numNodes == 0)
+		{
+			memset(output, 0, numFrames * mNumChannels * sizeof(float));
+			return;
+		}
+
+		for (UINT32 i = 0; i < numNodes; i++)
+		{
+			AudioDSPNode* node = mSchedule.nodes[i].get();
+			for (UINT32 j = 0; j < mNumChannels; j++)
+				mChannelPtrs[j] = node->mBuffer.data() + j * mMaxBlockFrames;
+
+			const UINT32 inputStart = mSchedule.inputOffsets[i];
+			const UINT32 inputEnd = mSchedule.inputOffsets[i + 1];
+
+			for (UINT32 j = 0; j < mNumChannels; j++)
+			{
+				if (inputStart == inputEnd)
+					memset(mChannelPtrs[j], 0, numFrames * sizeof(float));
+				else
+				{
+					const float* firstInput = mSchedule.nodes[mSchedule.inputs[inputStart]]->mBuffer.data();
+					memcpy(mChannelPtrs[j], firstInput + j * mMaxBlockFrames, numFrames * sizeof(float));
+
+					for (UINT32 k = inputStart + 1; k < inputEnd; k++)
+					{
+						const float* input = mSchedule.nodes[mSchedule.inputs[k]]->mBuffer.data();
+						AudioUtility::mixSamples(input + j * mMaxBlockFrames, mChannelPtrs[j], numFrames);
+					}
+				}
+			}
+
+			node->process(mChannelPtrs.data(), mNumChannels, numFrames);
+		}
+
+		// Output node is always scheduled last
+		const float* outputData = mSchedule.nodes.back()->mBuffer.data();
+		for (UINT32 i = 0; i < numFrames; i++)
+		{
+			for (UINT32 j = 0; j < mNumChannels; j++)
+				*output++ = outputData[j * mMaxBlockFrames + i];
+		}
+	}
+}
@@ -0,0 +1,430 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsBitwise.h"
+#include <atomic>
+
+namespace bs
+{
+	class AudioDSPGraph;
+
+	/** @addtogroup Audio
+	 *  @{
+	 */
+
+	/**
+	 * Fixed size lock-free queue of interleaved floating point samples, meant to be used by exactly one producer and
+	 * one consumer thread. No allocations are performed after construction.
+	 *
+	 * @note	write() must only be called from the producer thread, and read() only from the consumer thread.
+	 */
+	class AudioSampleRing
+	{
+	public:
+		/**
+		 * @param[in]	numChannels		Number of channels in a single frame.
+		 * @param[in]	capacity		Maximum number of frames in the queue. Rounded up to a power of two.
+		 */
+		AudioSampleRing(UINT32 numChannels, UINT32 capacity)
+			: mSamples(Bitwise::nextPow2(capacity) * numChannels), mNumChannels(numChannels)
+			, mMask(Bitwise::nextPow2(capacity) - 1)
+		{ }
+
+		AudioSampleRing(const AudioSampleRing&) = delete;
+		AudioSampleRing& operator=(const AudioSampleRing&) = delete;
+
+		/**
+		 * Appends up to @p numFrames interleaved frames to the queue. Producer thread only.
+		 *
+		 * @return	Number of frames written, less than @p numFrames if the queue is full.
+		 */
+		UINT32 write(const float* samples, UINT32 numFrames)
+		{
+			const UINT32 writeIdx = mWriteIdx.load(std::memory_order_relaxed);
+			const UINT32 numFree = (mMask + 1) - (writeIdx - mReadIdx.load(std::memory_order_acquire));
+			numFrames = std::min(numFrames, numFree);
+
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				float* dst = &mSamples[((writeIdx + i) & mMask) * mNumChannels];
+				for (UINT32 j = 0; j < mNumChannels; j++)
+					dst[j] = *samples++;
+			}
+
+			mWriteIdx.store(writeIdx + numFrames, std::memory_order_release);
+			return numFrames;
+		}
+
+		/**
+		 * Removes up to @p numFrames interleaved frames from the queue. Consumer thread only.
+		 *
+		 * @return	Number of frames read, less than @p numFrames if the queue ran out of samples.
+		 */
+		UINT32 read(float* samples, UINT32 numFrames)
+		{
+			const UINT32 readIdx = mReadIdx.load(std::memory_order_relaxed);
+			numFrames = std::min(numFrames, mWriteIdx.load(std::memory_order_acquire) - readIdx);
+
+			for (UINT32 i = 0; i < numFrames; i++)
+			{
+				const float* src = &mSamples[((readIdx + i) & mMask) * mNumChannels];
+				for (UINT32 j = 0; j < mNumChannels; j++)
+					*samples++ = src[j];
+			}
+
+			mReadIdx.store(readIdx + numFrames, std::memory_order_release);
+			return numFrames;
+		}
+
+		/** Returns the number of frames that can currently be read. */
+		UINT32 getNumQueued() const
+		{
+			return mWriteIdx.load(std::memory_order_acquire) - mReadIdx.load(std::memory_order_acquire);
+		}
+
+		/** Returns the number of frames that can currently be written. */
+		UINT32 getNumFree() const { return (mMask + 1) - getNumQueued(); }
+
+		/** Returns the number of channels in a single frame. */
+		UINT32 getNumChannels() const { return mNumChannels; }
+
+	private:
+		Vector<float> mSamples;
+		const UINT32 mNumChannels;
+		const UINT32 mMask;
+
+		std::atomic<UINT32> mWriteIdx{0};
+		std::atomic<UINT32> mReadIdx{0};
+	};
+
+	/**
+	 * Parameter of an AudioDSPNode. Can be changed from any thread without locking, and the new value is picked up by
+	 * the DSP thread on the next rendered block.
+	 */
+	class AudioDSPParam
+	{
+	public:
+		AudioDSPParam(float value)
+			:mValue(value), mCurrent(value)
+		{ }
+
+		/** Changes the value of the parameter. */
+		void set(float value) { mValue.store(value, std::memory_order_relaxed); }
+
+		/** Returns the value of the parameter, as last set by set(). */
+		float get() const { return mValue.load(std::memory_order_relaxed); }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Returns the latest value of the parameter, and outputs the value returned by the previous call. Lets the
+		 * nodes ramp towards a new value over a block, instead of jumping to it. DSP thread only.
+		 */
+		float _advance(float& previous)
+		{
+			previous = mCurrent;
+			mCurrent = mValue.load(std::memory_order_relaxed);
+
+			return mCurrent;
+		}
+
+		/** @} */
+	private:
+		std::atomic<float> mValue;
+		float mCurrent;
+	};
+
+	/**
+	 * Single processing step in an AudioDSPGraph. The graph mixes the output of all nodes connected to the node's
+	 * input, and passes the result to process(), to be modified in-place.
+	 */
+	class BS_CORE_EXPORT AudioDSPNode
+	{
+	public:
+		virtual ~AudioDSPNode() = default;
+
+	protected:
+		friend class AudioDSPGraph;
+
+		/**
+		 * Called when the node is added to a graph, before it is processed for the first time. Allocates any state the
+		 * node needs, as no allocations should be done during processing. Called on the thread adding the node.
+		 */
+		virtual void initialize(UINT32 numChannels, UINT32 sampleRate) { }
+
+		/**
+		 * Processes a block of samples. Called on the DSP thread. Must not block or allocate memory.
+		 *
+		 * @param[in, out]	channels		Samples of each channel, containing the mixed input on entry, and the output
+		 *									of the node on exit.
+		 * @param[in]		numChannels		Number of entries in @p channels.
+		 * @param[in]		numFrames		Number of samples in each channel.
+		 */
+		virtual void process(float* const* channels, UINT32 numChannels, UINT32 numFrames) = 0;
+
+	private:
+		AudioDSPGraph* mGraph = nullptr;
+		Vector<float> mBuffer;
+	};
+
+	/**
+	 * Input into a DSP graph, fed with samples by user code, for example samples decoded from an audio clip. Outputs
+	 * silence when it runs out of samples.
+	 */
+	class BS_CORE_EXPORT AudioDSPInputNode : public AudioDSPNode
+	{
+	public:
+		/** @param[in]	capacity	Maximum number of frames queued on the input, ahead of the DSP thread. */
+		AudioDSPInputNode(UINT32 capacity = 8192);
+
+		/**
+		 * Queues samples to be read by the DSP thread. Must be called from a single thread at a time.
+		 *
+		 * @param[in]	samples		Interleaved samples, with the same number of channels as the graph.
+		 * @param[in]	numFrames	Number of frames in @p samples.
+		 * @return					Number of frames queued, less than @p numFrames if the input is full.
+		 */
+		UINT32 write(const float* samples, UINT32 numFrames);
+
+		/** Returns the number of frames that can be queued without overflowing the input. */
+		UINT32 getNumFree() const;
+
+		/** Gain applied to the input samples. */
+		AudioDSPParam gain{1.0f};
+
+	protected:
+		/** @copydoc AudioDSPNode::initialize */
+		void initialize(UINT32 numChannels, UINT32 sampleRate) override;
+
+		/** @copydoc AudioDSPNode::process */
+		void process(float* const* channels, UINT32 numChannels, UINT32 numFrames) override;
+
+	private:
+		static constexpr UINT32 CHUNK_FRAMES = 256;
+
+		UINT32 mCapacity;
+		SPtr<AudioSampleRing> mRing;
+		Vector<float> mScratch;
+	};
+
+	/** Mixes the nodes connected to its input, and applies a gain to the mix. */
+	class BS_CORE_EXPORT AudioMixBusNode : public AudioDSPNode
+	{
+	public:
+		/** Gain applied to the mixed samples. */
+		AudioDSPParam gain{1.0f};
+
+	protected:
+		/** @copydoc AudioDSPNode::process */
+		void process(float* const* channels, UINT32 numChannels, UINT32 numFrames) override;
+	};
+
+	/** Attenuates the frequencies above the cutoff frequency, at 12dB per octave. Useful for occlusion filtering. */
+	class BS_CORE_EXPORT AudioLowPassNode : public AudioDSPNode
+	{
+	public:
+		/** Frequency above which the samples are attenuated, in Hz. */
+		AudioDSPParam cutoff{22000.0f};
+
+	protected:
+		/** @copydoc AudioDSPNode::initialize */
+		void initialize(UINT32 numChannels, UINT32 sampleRate) override;
+
+		/** @copydoc AudioDSPNode::process */
+		void process(float* const* channels, UINT32 numChannels, UINT32 numFrames) override;
+
+	private:
+		/** State of the two one-pole filters of a single channel. */
+		struct ChannelState
+		{
+			float values[2] = { 0.0f, 0.0f };
+		};
+
+		Vector<ChannelState> mChannels;
+		float mSampleRate = 48000.0f;
+	};
+
+	/** Simulates a room reverberation, using a network of comb and all-pass filters for each channel. */
+	class BS_CORE_EXPORT AudioReverbNode : public AudioDSPNode
+	{
+	public:
+		/** Size of the simulated room, in range [0, 1]. Larger rooms decay slower. */
+		AudioDSPParam roomSize{0.5f};
+
+		/** Determines how fast the high frequencies decay compared to the low frequencies, in range [0, 1]. */
+		AudioDSPParam damping{0.5f};
+
+		/** Gain of the reverberated samples. */
+		AudioDSPParam wet{0.33f};
+
+		/** Gain of the unprocessed samples. */
+		AudioDSPParam dry{1.0f};
+
+	protected:
+		/** @copydoc AudioDSPNode::initialize */
+		void initialize(UINT32 numChannels, UINT32 sampleRate) override;
+
+		/** @copydoc AudioDSPNode::process */
+		void process(float* const* channels, UINT32 numChannels, UINT32 numFrames) override;
+
+	private:
+		static constexpr UINT32 NUM_COMBS = 4;
+		static constexpr UINT32 NUM_ALLPASSES = 2;
+
+		/** Delay line of a single comb or all-pass filter. */
+		struct DelayLine
+		{
+			Vector<float> samples;
+			UINT32 position = 0;
+			float filtered = 0.0f;
+		};
+
+		/** Filters of a single channel. */
+		struct ChannelState
+		{
+			DelayLine combs[NUM_COMBS];
+			DelayLine allpasses[NUM_ALLPASSES];
+		};
+
+		static constexpr UINT32 CHUNK_FRAMES = 256;
+
+		Vector<ChannelState> mChannels;
+		Vector<float> mWetSamples;
+	};
+
+	/** Reduces the dynamic range of the samples, by attenuating the parts louder than the threshold. */
+	class BS_CORE_EXPORT AudioCompressorNode : public AudioDSPNode
+	{
+	public:
+		/** Level above which the samples are attenuated, in dB. */
+		AudioDSPParam threshold{-12.0f};
+
+		/** Ratio of the input level above the threshold to the output level above the threshold. */
+		AudioDSPParam ratio{4.0f};
+
+		/** Time it takes for the attenuation to kick in once the level rises above the threshold, in milliseconds. */
+		AudioDSPParam attack{10.0f};
+
+		/** Time it takes for the attenuation to stop once the level falls below the threshold, in milliseconds. */
+		AudioDSPParam release{100.0f};
+
+		/** Gain applied after compression, in dB. */
+		AudioDSPParam makeupGain{0.0f};
+
+	protected:
+		/** @copydoc AudioDSPNode::initialize */
+		void initialize(UINT32 numChannels, UINT32 sampleRate) override;
+
+		/** @copydoc AudioDSPNode::process */
+		void process(float* const* channels, UINT32 numChannels, UINT32 numFrames) override;
+
+	private:
+		/** Number of frames sharing the same gain. The envelope is smooth, so the gain needn't change per sample. */
+		static constexpr UINT32 GAIN_BLOCK_FRAMES = 16;
+
+		float mSampleRate = 48000.0f;
+		float mEnvelope = 0.0f;
+		float mGain = 1.0f;
+	};
+
+	/**
+	 * Graph of DSP nodes producing audio samples. Nodes are processed in dependency order, starting from the nodes the
+	 * output node depends on, and the output node's samples are the output of the graph. Nodes that the output doesn't
+	 * depend on are not processed.
+	 *
+	 * The graph is rendered on the DSP thread through render(), while nodes can be added and connected from another
+	 * thread. Topology changes are picked up by the DSP thread without blocking, on the next rendered block, and node
+	 * parameters can be changed at any time through AudioDSPParam.
+	 */
+	class BS_CORE_EXPORT AudioDSPGraph
+	{
+	public:
+		/**
+		 * @param[in]	numChannels		Number of channels of every node in the graph.
+		 * @param[in]	sampleRate		Number of frames per second.
+		 * @param[in]	maxBlockFrames	Maximum number of frames that can be rendered by a single render() call.
+		 */
+		AudioDSPGraph(UINT32 numChannels = 2, UINT32 sampleRate = 48000, UINT32 maxBlockFrames = 512);
+
+		/** Adds a node to the graph. A node can only be a part of a single graph. */
+		void addNode(const SPtr<AudioDSPNode>& node);
+
+		/** Removes a node from the graph, along with all the connections to and from the node. */
+		void removeNode(const SPtr<AudioDSPNode>& node);
+
+		/** Mixes the output of node @p from into the input of node @p to. Both nodes must be part of the graph. */
+		void connect(const SPtr<AudioDSPNode>& from, const SPtr<AudioDSPNode>& to);
+
+		/** Removes a connection previously made with connect(). */
+		void disconnect(const SPtr<AudioDSPNode>& from, const SPtr<AudioDSPNode>& to);
+
+		/** Determines the node whose samples are the output of the graph. */
+		void setOutput(const SPtr<AudioDSPNode>& node);
+
+		/** Returns the number of channels of every node in the graph. */
+		UINT32 getNumChannels() const { return mNumChannels; }
+
+		/** Returns the number of frames per second. */
+		UINT32 getSampleRate() const { return mSampleRate; }
+
+		/** Returns the maximum number of frames that can be rendered by a single render() call. */
+		UINT32 getMaxBlockFrames() const { return mMaxBlockFrames; }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Processes all the nodes the output depends on, and writes the interleaved samples of the output node in
+		 * @p output. Outputs silence if the graph has no output. Must only be called from a single thread at a time.
+		 *
+		 * @param[out]	output		Pre-allocated buffer of @p numFrames * getNumChannels() samples.
+		 * @param[in]	numFrames	Number of frames to render, at most getMaxBlockFrames().
+		 */
+		void _render(float* output, UINT32 numFrames);
+
+		/** @} */
+	private:
+		/** Connection between two nodes. */
+		struct Connection
+		{
+			AudioDSPNode* from;
+			AudioDSPNode* to;
+		};
+
+		/** Nodes in the order they are processed, as built from the current topology. */
+		struct Schedule
+		{
+			Vector<SPtr<AudioDSPNode>> nodes;
+			Vector<UINT32> inputOffsets; // Start of each node's inputs in inputs, with one extra entry at the end
+			Vector<UINT32> inputs; // Indices of the nodes to mix into each node's input
+		};
+
+		/** Rebuilds the schedule from the current topology, to be picked up by the DSP thread. */
+		void rebuildSchedule();
+
+		const UINT32 mNumChannels;
+		const UINT32 mSampleRate;
+		const UINT32 mMaxBlockFrames;
+
+		Mutex mMutex;
+		Vector<SPtr<AudioDSPNode>> mNodes;
+		Vector<Connection> mConnections;
+		SPtr<AudioDSPNode> mOutput;
+
+		// The DSP thread swaps in the pending schedule, so the schedule it replaces is freed on the thread that edits
+		// the graph, instead of the DSP thread
+		Schedule mPendingSchedule;
+		std::atomic<bool> mIsScheduleDirty{false};
+
+		// Only accessed by the DSP thread
+		Schedule mSchedule;
+		Vector<float*> mChannelPtrs;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,58 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Audio/BsAudioDSPThread.h"
+
+namespace bs
+{
+	AudioDSPThread::AudioDSPThread(const SPtr<AudioDSPGraph>& graph, UINT32 latency)
+		: mGraph(graph), mRing(graph->getNumChannels(), std::max(latency, graph->getMaxBlockFrames()))
+	{
+		mBlock.resize(mGraph->getMaxBlockFrames() * mGraph->getNumChannels());
+		mThread = ThreadPool::instance().run("AudioDSP", std::bind(&AudioDSPThread::run, this));
+	}
+
+	AudioDSPThread::~AudioDSPThread()
+	{
+		{
+			Lock lock(mMutex);
+			mShutdown = true;
+		}
+
+		mSignal.notify_one();
+		mThread.blockUntilComplete();
+	}
+
+	UINT32 AudioDSPThread::read(float* samples, UINT32 numFrames)
+	{
+		const UINT32 numRead = mRing.read(samples, numFrames);
+		if (numRead < numFrames)
+			mNumUnderruns.fetch_add(1, std::memory_order_relaxed);
+
+		// Not locking, a missed notification only delays rendering until the wait times out
+		mSignal.notify_one();
+		return numRead;
+	}
+
+	void AudioDSPThread::run()
+	{
+		const UINT32 blockFrames = mGraph->getMaxBlockFrames();
+
+		// Wake up at least twice per block, in case a notification from read() was missed
+		const auto waitTime = std::chrono::microseconds((UINT64)blockFrames * 500000 / mGraph->getSampleRate());
+
+		while (true)
+		{
+			while (mRing.getNumFree() >= blockFrames)
+			{
+				mGraph->_render(mBlock.data(), blockFrames);
+				mRing.write(mBlock.data(), blockFrames);
+			}
+
+			Lock lock(mMutex);
+			if (mShutdown)
+				break;
+
+			mSignal.wait_for(lock, waitTime);
+		}
+	}
+}
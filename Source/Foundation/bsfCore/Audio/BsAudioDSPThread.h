@@ -0,0 +1,70 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Audio/BsAudioDSP.h"
+#include "Threading/BsThreadPool.h"
+
+namespace bs
+{
+	/** @addtogroup Audio-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Renders an AudioDSPGraph on a dedicated thread, ahead of playback. The thread keeps a queue of rendered samples
+	 * filled, to be read by the audio backend through read(). The size of the queue is the latency between a change in
+	 * the graph and the change being heard, on top of the backend's own buffering.
+	 *
+	 * @note	read() must only be called from a single thread at a time.
+	 */
+	class BS_CORE_EXPORT AudioDSPThread
+	{
+	public:
+		/**
+		 * Creates a thread and starts rendering the graph.
+		 *
+		 * @param[in]	graph		Graph to render.
+		 * @param[in]	latency		Number of frames rendered ahead of playback. Rounded up to a power of two, and to at
+		 *							least the graph's maximum block size.
+		 */
+		AudioDSPThread(const SPtr<AudioDSPGraph>& graph, UINT32 latency);
+		~AudioDSPThread();
+
+		/**
+		 * Reads rendered samples, and wakes up the thread to render more.
+		 *
+		 * @param[out]	samples		Pre-allocated buffer of @p numFrames * getGraph()->getNumChannels() samples.
+		 * @param[in]	numFrames	Number of frames to read.
+		 * @return					Number of frames read. Less than @p numFrames if rendering fell behind playback.
+		 */
+		UINT32 read(float* samples, UINT32 numFrames);
+
+		/** Returns the number of rendered frames that can be read. */
+		UINT32 getNumAvailable() const { return mRing.getNumQueued(); }
+
+		/** Returns the number of times read() ran out of rendered samples. */
+		UINT64 getNumUnderruns() const { return mNumUnderruns.load(std::memory_order_relaxed); }
+
+		/** Returns the graph rendered by the thread. */
+		const SPtr<AudioDSPGraph>& getGraph() const { return mGraph; }
+
+	private:
+		/** Renders blocks until the queue is full, then waits for samples to be read. */
+		void run();
+
+		SPtr<AudioDSPGraph> mGraph;
+		AudioSampleRing mRing;
+		Vector<float> mBlock;
+
+		HThread mThread;
+		Mutex mMutex;
+		Signal mSignal;
+		bool mShutdown = false;
+
+		std::atomic<UINT64> mNumUnderruns{0};
+	};
+
+	/** @} */
+}
@@ -74,7 +74,7 @@ namespace bs
 		virtual void setPriority(INT32 priority);
 
 		/** @copydoc setPriority() */
-		UINT32 getPriority() const { return mPriority; }
+		INT32 getPriority() const { return mPriority; }
 
 		/** 
 		 * Minimum distance at which audio attenuation starts. When the listener is closer to the source
@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Audio/BsAudioUtility.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -248,6 +249,85 @@ namespace bs
 			assert(false);
 	}
 
+	void AudioUtility::convertFromFloat(const float* input, UINT32 outBitDepth, UINT8* output, UINT32 numSamples)
+	{
+		if (outBitDepth == 8)
+		{
+			for (UINT32 i = 0; i < numSamples; i++)
+			{
+				*(INT8*)output = (INT8)(Math::clamp(input[i], -1.0f, 1.0f) * 127.0f);
+				output++;
+			}
+		}
+		else if (outBitDepth == 16)
+		{
+			for (UINT32 i = 0; i < numSamples; i++)
+			{
+				*(INT16*)output = (INT16)(Math::clamp(input[i], -1.0f, 1.0f) * 32767.0f);
+				output += 2;
+			}
+		}
+		else if (outBitDepth == 24)
+		{
+			for (UINT32 i = 0; i < numSamples; i++)
+			{
+				convert32To24Bits((INT32)(Math::clamp(input[i], -1.0f, 1.0f) * 2147483647.0), output);
+				output += 3;
+			}
+		}
+		else if (outBitDepth == 32)
+		{
+			for (UINT32 i = 0; i < numSamples; i++)
+			{
+				*(INT32*)output = (INT32)(Math::clamp(input[i], -1.0f, 1.0f) * 2147483647.0);
+				output += 4;
+			}
+		}
+		else
+			assert(false);
+	}
+
+	void AudioUtility::mixSamples(const float* input, float* output, UINT32 numSamples, float gain)
+	{
+		const simd::float32x4 gainVec = simd::splat<simd::float32x4>(gain);
+
+		UINT32 i = 0;
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			simd::float32x4 value = simd::load_u<simd::float32x4>(output + i);
+			value = simd::add(value, simd::mul(simd::load_u<simd::float32x4>(input + i), gainVec));
+
+			simd::store_u(output + i, value);
+		}
+
+		for (; i < numSamples; i++)
+			output[i] += input[i] * gain;
+	}
+
+	void AudioUtility::applyGain(float* samples, UINT32 numSamples, float startGain, float endGain)
+	{
+		if (numSamples == 0)
+			return;
+
+		const float step = (endGain - startGain) / numSamples;
+
+		// Gain of four consecutive samples, advanced by four steps per iteration
+		SIMDPP_ALIGN(16) const float offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+		simd::float32x4 gainVec = simd::add(simd::splat<simd::float32x4>(startGain),
+			simd::mul(simd::load<simd::float32x4>(offsets), simd::splat<simd::float32x4>(step)));
+		const simd::float32x4 stepVec = simd::splat<simd::float32x4>(step * 4.0f);
+
+		UINT32 i = 0;
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			simd::store_u(samples + i, simd::mul(simd::load_u<simd::float32x4>(samples + i), gainVec));
+			gainVec = simd::add(gainVec, stepVec);
+		}
+
+		for (; i < numSamples; i++)
+			samples[i] *= startGain + step * i;
+	}
+
 	INT32 AudioUtility::convert24To32Bits(const UINT8* input)
 	{
 		return (input[2] << 24) | (input[1] << 16) | (input[0] << 8);
@@ -53,6 +53,41 @@ namespace bs
 		 */
 		static void convertToFloat(const UINT8* input, UINT32 inBitDepth, float* output, UINT32 numSamples);
 
+		/**
+		 * Converts a set of floating point samples in range [-1, 1] to a set of signed integer samples of a certain bit
+		 * depth. Samples outside of the range are clipped.
+		 *
+		 * @param[in]	input		A set of input samples. Total size of the buffer should be @p numSamples *
+		 *							sizeof(float).
+		 * @param[in]	outBitDepth	Size of a single sample in the @p output array, in bits.
+		 * @param[out]	output		Pre-allocated buffer to store the output samples in. Total size of the buffer
+		 *							should be @p numSamples * @p outBitDepth / 8.
+		 * @param[in]	numSamples	Total number of samples to process.
+		 */
+		static void convertFromFloat(const float* input, UINT32 outBitDepth, UINT8* output, UINT32 numSamples);
+
+		/**
+		 * Scales a set of floating point samples and adds them to another set of samples (@p output += @p input *
+		 * @p gain).
+		 *
+		 * @param[in]		input		Samples to add.
+		 * @param[in, out]	output		Samples to add to.
+		 * @param[in]		numSamples	Number of samples in each of the buffers.
+		 * @param[in]		gain		Value to scale the input samples with.
+		 */
+		static void mixSamples(const float* input, float* output, UINT32 numSamples, float gain = 1.0f);
+
+		/**
+		 * Scales a set of floating point samples by a gain linearly interpolated from @p startGain to @p endGain over
+		 * the length of the buffer. Used for changing the gain without audible clicks.
+		 *
+		 * @param[in, out]	samples		Samples to scale.
+		 * @param[in]		numSamples	Number of samples in the buffer.
+		 * @param[in]		startGain	Gain to apply to the first sample.
+		 * @param[in]		endGain		Gain reached after the last sample.
+		 */
+		static void applyGain(float* samples, UINT32 numSamples, float startGain, float endGain);
+
 		/** 
 		 * Converts a 24-bit signed integer into a 32-bit signed integer. 
 		 *
@@ -14,6 +14,7 @@
 #include "Utility/BsDynLibManager.h"
 #include "Scene/BsSceneManager.h"
 #include "Importer/BsImporter.h"
+#include "Text/BsFontManager.h"
 #include "Resources/BsResources.h"
 #include "Scene/BsSceneObject.h"
 #include "Utility/BsTime.h"
@@ -29,12 +30,16 @@
 #include "Profiling/BsProfilingManager.h"
 #include "Profiling/BsProfilerCPU.h"
 #include "Profiling/BsProfilerGPU.h"
+#include "Profiling/BsProfilerTimeline.h"
+#include "Profiling/BsFrameTelemetry.h"
 #include "Managers/BsQueryManager.h"
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
+#include "FileSystem/BsAsyncFileIO.h"
 #include "Profiling/BsRenderStats.h"
 #include "Utility/BsMessageHandler.h"
 #include "Managers/BsResourceListenerManager.h"
+#include "Managers/BsTextureStreamingManager.h"
 #include "Managers/BsRenderStateManager.h"
 #include "Material/BsShaderManager.h"
 #include "Physics/BsPhysicsManager.h"
@@ -48,10 +53,29 @@
 
 namespace bs
 {
+	/** Fraction of the slack between the sim and core threads to delay sim frames by, with adaptive frame start. */
+	static constexpr float FRAME_START_DELAY_MARGIN = 0.9f;
+
+	/** Number of frames over which to average the frame start delay, with adaptive frame start. */
+	static constexpr UINT64 FRAME_START_DELAY_SMOOTHING = 8;
+
+	/** Minimum time to spin for before the next frame, in microseconds, when using timer frame pacing. */
+	static constexpr UINT64 MIN_SPIN_TAIL = 100;
+
+	/** Maximum time to spin for before the next frame, in microseconds, when using timer frame pacing. */
+	static constexpr UINT64 MAX_SPIN_TAIL = 2000;
+
+	/** Number of frames over which to average the timer overshoot, when using timer frame pacing. */
+	static constexpr UINT64 TIMER_OVERSHOOT_SMOOTHING = 8;
+
 	CoreApplication::CoreApplication(START_UP_DESC desc)
-		: mPrimaryWindow(nullptr), mStartUpDesc(desc), mRendererPlugin(nullptr), mIsFrameRenderingFinished(true)
-		, mSimThreadId(BS_THREAD_CURRENT_ID), mRunMainLoop(false)
+		: mPrimaryWindow(nullptr), mStartUpDesc(desc), mRendererPlugin(nullptr), mSimThreadId(BS_THREAD_CURRENT_ID)
+		, mRunMainLoop(false)
 	{
+		setFramesInFlight(desc.framesInFlight);
+		setAdaptiveFrameStart(desc.adaptiveFrameStart);
+		setFramePacingMode(desc.framePacing);
+
 		// Ensure all errors are reported properly
 		CrashHandler::startUp();
 	}
@@ -72,6 +96,8 @@ namespace bs
 		ct::ParamBlockManager::shutDown();
 		StringTableManager::shutDown();
 		Resources::shutDown();
+		FontManager::shutDown();
+		TextureStreamingManager::shutDown();
 		GameObjectManager::shutDown();
 
 		// Audio manager must be released before the ResourceListenerManager, as any one-shot audio sources need to be
@@ -107,9 +133,13 @@ namespace bs
 
 		CoreThread::shutDown();
 		RenderStats::shutDown();
+		AsyncFileIO::shutDown();
 		TaskScheduler::shutDown();
+		gDebug()._stopWriterThread();
 		ThreadPool::shutDown();
+		FrameTelemetry::shutDown();
 		ProfilingManager::shutDown();
+		ProfilerTimeline::shutDown();
 		ProfilerCPU::shutDown();
 		MessageHandler::shutDown();
 		ShaderManager::shutDown();
@@ -122,6 +152,8 @@ namespace bs
 
 	void CoreApplication::onStartUp()
 	{
+		mStartUpTimer.reset();
+
 		UINT32 numWorkerThreads = BS_THREAD_HARDWARE_CONCURRENCY - 1; // Number of cores while excluding current thread.
 
 		Platform::_startUp();
@@ -130,10 +162,17 @@ namespace bs
 		ShaderManager::startUp(getShaderIncludeHandler());
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
+		ProfilerTimeline::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
+		FrameTelemetry::startUp();
+		// Leave enough room for task scheduler workers, which can temporarily outnumber the cores while threads are
+		// waiting, and for the asynchronous file I/O threads
+		const UINT32 maxNumThreads = std::max(16U, numWorkerThreads * 2 + 8);
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numWorkerThreads, maxNumThreads);
+		gDebug()._startWriterThread();
 		TaskScheduler::startUp();
 		TaskScheduler::instance().removeWorker();
+		AsyncFileIO::startUp();
 		RenderStats::startUp();
 		CoreThread::startUp();
 		StringTableManager::startUp();
@@ -142,24 +181,48 @@ namespace bs
 		DynLibManager::startUp();
 		CoreObjectManager::startUp();
 		GameObjectManager::startUp();
+		TextureStreamingManager::startUp();
+		FontManager::startUp();
 		Resources::startUp();
 		ResourceListenerManager::startUp();
 		GpuProgramManager::startUp();
 		RenderStateManager::startUp();
 		ct::GpuProgramManager::startUp();
 		RenderAPIManager::startUp();
+		recordStartUpStage("Core modules");
+
+		// Open the libraries of the remaining plugins on a worker while the render API and the primary window are being
+		// initialized. Only the libraries are opened, the plugins themselves are still initialized below, in order.
+		Vector<String> pluginLibraries = { mStartUpDesc.renderer, mStartUpDesc.audio, mStartUpDesc.physics };
+		pluginLibraries.insert(pluginLibraries.end(), mStartUpDesc.importers.begin(), mStartUpDesc.importers.end());
+
+		SPtr<Task> pluginLoadTask = Task::create("LoadPluginLibraries", [pluginLibraries]()
+		{
+			for(auto& entry : pluginLibraries)
+			{
+				if(!entry.empty())
+					gDynLibManager().load(entry);
+			}
+		});
+
+		TaskScheduler::instance().addTask(pluginLoadTask);
 
 		mPrimaryWindow = RenderAPIManager::instance().initialize(mStartUpDesc.renderAPI, mStartUpDesc.primaryWindowDesc);
+		recordStartUpStage("Render API");
 
 		ct::ParamBlockManager::startUp();
 		Input::startUp();
 		RendererManager::startUp();
 
+		pluginLoadTask->wait();
+		recordStartUpStage("Plugin libraries");
+
 		loadPlugin(mStartUpDesc.renderer, &mRendererPlugin);
 
 		SceneManager::startUp();
 		RendererManager::instance().setActive(mStartUpDesc.renderer);
 		startUpRenderer();
+		recordStartUpStage("Renderer");
 
 		ProfilerGPU::startUp();
 		MeshManager::startUp();
@@ -168,6 +231,7 @@ namespace bs
 		PhysicsManager::startUp(mStartUpDesc.physics, isEditor());
 		AnimationManager::startUp();
 		ParticleManager::startUp();
+		recordStartUpStage("Audio, physics and animation");
 
 		for (auto& importerName : mStartUpDesc.importers)
 			loadPlugin(importerName);
@@ -175,6 +239,7 @@ namespace bs
 		// Built-in importers
 		FGAImporter* fgaImporter = bs_new<FGAImporter>();
 		Importer::instance()._registerAssetImporter(fgaImporter);
+		recordStartUpStage("Importers");
 	}
 
 	void CoreApplication::runMainLoop()
@@ -185,33 +250,20 @@ namespace bs
 		{
 			// Limit FPS if needed
 			if (mFrameStep > 0)
-			{
-				UINT64 currentTime = gTime().getTimePrecise();
-				UINT64 nextFrameTime = mLastFrameTime + mFrameStep;
-				while (nextFrameTime > currentTime)
-				{
-					UINT32 waitTime = (UINT32)(nextFrameTime - currentTime);
-
-					// If waiting for longer, sleep
-					if (waitTime >= 2000)
-					{
-						Platform::sleep(waitTime / 1000);
-						currentTime = gTime().getTimePrecise();
-					}
-					else
-					{
-						// Otherwise we just spin, sleep timer granularity is too low and we might end up wasting a 
-						// millisecond otherwise. 
-						// Note: For mobiles where power might be more important than input latency, consider using sleep.
-						while(nextFrameTime > currentTime)
-							currentTime = gTime().getTimePrecise();
-					}
-				}
+				mLastFrameTime = waitUntil(mLastFrameTime + mFrameStep);
 
-				mLastFrameTime = currentTime;
+			// Delay the frame so it finishes right as the core thread is ready to accept it, sampling input as late
+			// as possible (see setAdaptiveFrameStart())
+			UINT64 delayTime = 0;
+			if (mFrameStartDelay >= 1000)
+			{
+				const UINT64 delayStart = gTime().getTimePrecise();
+				Platform::sleep((UINT32)(mFrameStartDelay / 1000));
+				delayTime = gTime().getTimePrecise() - delayStart;
 			}
 
 			gProfilerCPU().beginThread("Sim");
+			gFrameTelemetry()._beginSimFrame();
 
 			Platform::_update();
 			DeferredCallManager::instance()._update();
@@ -237,7 +289,11 @@ namespace bs
 				{
 					fixedUpdate();
 					PROFILE_CALL(gSceneManager()._fixedUpdate(), "Scene fixed update");
-					PROFILE_CALL(gPhysics().fixedUpdate(stepSeconds), "Physics simulation");
+
+					{
+						MemoryTagScope memoryTagScope(MemoryTag::Physics);
+						PROFILE_CALL(gPhysics().fixedUpdate(stepSeconds), "Physics simulation");
+					}
 
 					gTime()._advanceFixedUpdate(step);
 				}
@@ -245,7 +301,11 @@ namespace bs
 
 			PROFILE_CALL(gSceneManager()._update(), "Scene update");
 			gAudio()._update();
-			gPhysics().update();
+
+			{
+				MemoryTagScope memoryTagScope(MemoryTag::Physics);
+				gPhysics().update();
+			}
 
 			// Update plugins
 			for (auto& pluginUpdateFunc : mPluginUpdateFunctions)
@@ -257,8 +317,23 @@ namespace bs
 
 			// Evaluate animation after scene and plugin updates because the renderer will just now be displaying the
 			// animation we sent on the previous frame, and we want the scene information to match to what is displayed.
-			perFrameData.animation = AnimationManager::instance().update();
-			perFrameData.particles = ParticleManager::instance().update(*perFrameData.animation);
+			{
+				MemoryTagScope memoryTagScope(MemoryTag::Animation);
+				perFrameData.animation = AnimationManager::instance().update();
+			}
+
+			// Particle systems are evaluated on worker threads while this thread performs work that doesn't touch
+			// scene objects or run user code. Everything that follows may modify particle systems or their transforms,
+			// and must wait until the evaluation ends.
+			ParticleManager::instance().beginUpdate(*perFrameData.animation);
+
+			// Must happen before the core sync, so materials pick up any textures whose resident mip levels changed
+			PROFILE_CALL(TextureStreamingManager::instance()._update(), "Texture streaming");
+
+			// Upload characters of dynamic fonts rasterized by the GUI and other text built during the frame
+			FontManager::instance()._update();
+
+			perFrameData.particles = ParticleManager::instance().endUpdate();
 
 			// Send out resource events in case any were loaded/destroyed/modified
 			ResourceListenerManager::instance().update();
@@ -268,23 +343,42 @@ namespace bs
 			RendererManager::instance().getActive()->update();
 
 			gSceneManager()._updateCoreObjectTransforms();
-			PROFILE_CALL(RendererManager::instance().getActive()->renderAll(perFrameData), "Render");
 
-			// Core and sim thread run in lockstep. This will result in a larger input latency than if I was 
-			// running just a single thread. Latency becomes worse if the core thread takes longer than sim 
-			// thread, in which case sim thread needs to wait. Optimal solution would be to get an average 
-			// difference between sim/core thread and start the sim thread a bit later so they finish at nearly the same time.
 			{
+				MemoryTagScope memoryTagScope(MemoryTag::Rendering);
+				PROFILE_CALL(RendererManager::instance().getActive()->renderAll(perFrameData), "Render");
+			}
+
+			// The sim thread can run up to mMaxFramesInFlight frames ahead of the core thread. If the core thread takes
+			// longer than the sim thread the sim thread needs to wait, increasing latency. With adaptive frame start
+			// enabled, the start of the next frame is delayed by the measured slack instead, so both threads finish at
+			// nearly the same time.
+			{
+				const UINT64 waitStart = gTime().getTimePrecise();
 				Lock lock(mFrameRenderingFinishedMutex);
 
-				while(!mIsFrameRenderingFinished)
+				while(mNumFramesInFlight >= mMaxFramesInFlight)
 				{
 					TaskScheduler::instance().addWorker();
 					mFrameRenderingFinishedCondition.wait(lock);
 					TaskScheduler::instance().removeWorker();
 				}
 
-				mIsFrameRenderingFinished = false;
+				mNumFramesInFlight++;
+
+				const UINT64 waitTime = gTime().getTimePrecise() - waitStart;
+				gFrameTelemetry()._addSimWaitTime(waitTime);
+
+				if (mAdaptiveFrameStart)
+				{
+					// Aim for slightly less than the measured slack, so frame time variance doesn't turn into waiting.
+					// Averaged over multiple frames, so a single long core frame doesn't delay the following ones.
+					const UINT64 slack = delayTime + waitTime;
+					const UINT64 targetDelay = (UINT64)(slack * FRAME_START_DELAY_MARGIN);
+
+					mFrameStartDelay = (mFrameStartDelay * (FRAME_START_DELAY_SMOOTHING - 1) + targetDelay) /
+						FRAME_START_DELAY_SMOOTHING;
+				}
 			}
 
 			gCoreThread().queueCommand(std::bind(&CoreApplication::beginCoreProfiling, this), CTQF_InternalQueue);
@@ -294,11 +388,16 @@ namespace bs
 			gCoreThread().update(); 
 			gCoreThread().submitAll(); 
 
+			// Executes once everything queued for the frame has been rendered and presented
+			gCoreThread().queueCommand(std::bind(&Input::_notifyFramePresented, Input::instancePtr(),
+				gInput()._getFrameInputTimestamp()), CTQF_InternalQueue);
+
 			gCoreThread().queueCommand(std::bind(&CoreApplication::frameRenderingFinishedCallback, this), CTQF_InternalQueue);
 
 			gCoreThread().queueCommand(std::bind(&ct::QueryManager::_update, ct::QueryManager::instancePtr()), CTQF_InternalQueue);
 			gCoreThread().queueCommand(std::bind(&CoreApplication::endCoreProfiling, this), CTQF_InternalQueue);
 
+			gFrameTelemetry()._endSimFrame();
 			gProfilerCPU().endThread();
 			gProfiler()._update();
 		}
@@ -307,7 +406,7 @@ namespace bs
 		{
 			Lock lock(mFrameRenderingFinishedMutex);
 
-			while (!mIsFrameRenderingFinished)
+			while (mNumFramesInFlight > 0)
 			{
 				TaskScheduler::instance().addWorker();
 				mFrameRenderingFinishedCondition.wait(lock);
@@ -350,11 +449,63 @@ namespace bs
 			mFrameStep = 0;
 	}
 
+	UINT64 CoreApplication::waitUntil(UINT64 time)
+	{
+		UINT64 currentTime = gTime().getTimePrecise();
+		if (mFramePacing == FramePacingMode::Timer)
+		{
+			// Sleep until shortly before the target time, leaving enough time to absorb a late wake-up
+			const UINT64 spinTail = Math::clamp(mTimerOvershoot * 2, MIN_SPIN_TAIL, MAX_SPIN_TAIL);
+			if (time > currentTime + spinTail)
+			{
+				const UINT64 sleepTime = time - currentTime - spinTail;
+				Platform::sleepPrecise(sleepTime);
+
+				const UINT64 wakeTime = gTime().getTimePrecise();
+				const UINT64 sleptTime = wakeTime - currentTime;
+				const UINT64 overshoot = sleptTime > sleepTime ? sleptTime - sleepTime : 0;
+
+				mTimerOvershoot = (mTimerOvershoot * (TIMER_OVERSHOOT_SMOOTHING - 1) + overshoot) /
+					TIMER_OVERSHOOT_SMOOTHING;
+				currentTime = wakeTime;
+			}
+		}
+		else
+		{
+			// If waiting for longer, sleep. Otherwise spin, as sleep timer granularity is too low and we might end up
+			// wasting a millisecond.
+			while (time > currentTime + 2000)
+			{
+				Platform::sleep((UINT32)((time - currentTime) / 1000));
+				currentTime = gTime().getTimePrecise();
+			}
+		}
+
+		while (time > currentTime)
+			currentTime = gTime().getTimePrecise();
+
+		return currentTime;
+	}
+
+	void CoreApplication::setFramesInFlight(UINT32 count)
+	{
+		mMaxFramesInFlight = Math::clamp(count, 1U, (UINT32)CoreThread::MAX_FRAMES_IN_FLIGHT);
+	}
+
+	void CoreApplication::setAdaptiveFrameStart(bool enabled)
+	{
+		mAdaptiveFrameStart = enabled;
+
+		if (!enabled)
+			mFrameStartDelay = 0;
+	}
+
 	void CoreApplication::frameRenderingFinishedCallback()
 	{
 		Lock lock(mFrameRenderingFinishedMutex);
 
-		mIsFrameRenderingFinished = true;
+		assert(mNumFramesInFlight > 0);
+		mNumFramesInFlight--;
 		mFrameRenderingFinishedCondition.notify_one();
 	}
 
@@ -366,12 +517,14 @@ namespace bs
 	void CoreApplication::beginCoreProfiling()
 	{
 		gProfilerCPU().beginThread("Core");
+		gFrameTelemetry()._beginCoreFrame();
 	}
 
 	void CoreApplication::endCoreProfiling()
 	{
 		ProfilerGPU::instance()._update();
 
+		gFrameTelemetry()._endCoreFrame();
 		gProfilerCPU().endThread();
 		gProfiler()._updateCore();
 	}
@@ -431,6 +584,26 @@ namespace bs
 		return bs_shared_ptr_new<DefaultShaderIncludeHandler>();
 	}
 
+	void CoreApplication::recordStartUpStage(const String& name)
+	{
+		const UINT64 time = mStartUpTimer.getMicroseconds();
+
+		mStartUpStages.push_back(std::make_pair(name, time - mLastStartUpStageTime));
+		mLastStartUpStageTime = time;
+	}
+
+	void CoreApplication::logStartUpTimings() const
+	{
+		StringStream output;
+		output << std::fixed << std::setprecision(2);
+		output << "Start-up completed in " << mLastStartUpStageTime / 1000.0f << " ms:";
+
+		for(auto& entry : mStartUpStages)
+			output << "\n\t" << entry.first << ": " << entry.second / 1000.0f << " ms";
+
+		LOGDBG(output.str());
+	}
+
 	CoreApplication& gCoreApplication()
 	{
 		return CoreApplication::instance();
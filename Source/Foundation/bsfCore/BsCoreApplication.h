@@ -6,6 +6,7 @@
 #include "Utility/BsModule.h"
 #include "RenderAPI/BsRenderWindow.h"
 #include "Utility/BsEvent.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
@@ -13,6 +14,21 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Determines how the application waits for the next frame when the frame rate is limited. */
+	enum class FramePacingMode
+	{
+		/**
+		 * Sleeps using the regular system sleep, with millisecond granularity, and spins for the last two
+		 * milliseconds before the frame.
+		 */
+		Spin,
+		/**
+		 * Sleeps using a high resolution timer, and only spins for a short tail before the frame. The length of the
+		 * tail is calibrated from how late the timer wakes up. Similar accuracy as Spin, at a fraction of the CPU time.
+		 */
+		Timer
+	};
+
 	/**	Structure containing parameters for starting the application. */
 	struct START_UP_DESC
 	{
@@ -26,6 +42,15 @@ namespace bs
 		RENDER_WINDOW_DESC primaryWindowDesc; /**< Describes the window to create during start-up. */
 
 		Vector<String> importers; /**< A list of importer plugins to load. */
+
+		/** Maximum number of frames the sim thread can run ahead of the core thread. See CoreApplication. */
+		UINT32 framesInFlight = 1;
+
+		/** True to adaptively delay the start of sim thread frames. See CoreApplication::setAdaptiveFrameStart. */
+		bool adaptiveFrameStart = false;
+
+		/** Determines how the application waits for the next frame when the frame rate is limited. */
+		FramePacingMode framePacing = FramePacingMode::Timer;
 	};
 
 	/**
@@ -54,6 +79,34 @@ namespace bs
 		/** Changes the maximum FPS the application is allowed to run in. Zero means unlimited. */
 		void setFPSLimit(UINT32 limit);
 
+		/** Determines how the application waits for the next frame when the frame rate is limited. */
+		void setFramePacingMode(FramePacingMode mode) { mFramePacing = mode; }
+
+		/** Returns how the application waits for the next frame when the frame rate is limited. */
+		FramePacingMode getFramePacingMode() const { return mFramePacing; }
+
+		/**
+		 * Sets the maximum number of frames the core thread is allowed to lag behind the sim thread, in range
+		 * [1, CoreThread::MAX_FRAMES_IN_FLIGHT]. With one frame in flight the sim thread waits for the core thread to
+		 * finish the previous frame before submitting a new one. More frames in flight improve throughput when the
+		 * application is bound by the core thread or the GPU, at the cost of input latency.
+		 */
+		void setFramesInFlight(UINT32 count);
+
+		/** Returns the maximum number of frames the core thread is allowed to lag behind the sim thread. */
+		UINT32 getFramesInFlight() const { return mMaxFramesInFlight; }
+
+		/**
+		 * Enables or disables adaptive frame start. When enabled and the sim thread ends up waiting on the core thread,
+		 * the start of the next sim thread frame is delayed by slightly less than the measured wait time. This way
+		 * input and simulation are sampled as late as possible, reducing latency without reducing throughput. Has no
+		 * effect when the sim thread is the bottleneck.
+		 */
+		void setAdaptiveFrameStart(bool enabled);
+
+		/** Checks is adaptive frame start enabled. See setAdaptiveFrameStart(). */
+		bool getAdaptiveFrameStart() const { return mAdaptiveFrameStart; }
+
 		/**
 		 * Issues a request for the application to close. Application may choose to ignore the request depending on the
 		 * circumstances and the implementation.
@@ -105,7 +158,19 @@ namespace bs
 		/**	Returns a handler that is used for resolving shader include file paths. */
 		virtual SPtr<IShaderIncludeHandler> getShaderIncludeHandler() const;
 
+		/**
+		 * Records the time spent in a start-up stage, measured from the end of the previously recorded stage (or the
+		 * start of onStartUp()) until now.
+		 */
+		void recordStartUpStage(const String& name);
+
+		/** Logs the times of all the start-up stages recorded through recordStartUpStage(). */
+		void logStartUpTimings() const;
+
 	private:
+		/** Blocks the calling thread until the specified time in microseconds. Returns the time it woke up at. */
+		UINT64 waitUntil(UINT64 time);
+
 		/**	Called when the frame finishes rendering. */
 		void frameRenderingFinishedCallback();
 
@@ -124,12 +189,24 @@ namespace bs
 		// Frame limiting
 		UINT64 mFrameStep = 16666; // 60 times a second in microseconds
 		UINT64 mLastFrameTime = 0; // Microseconds
+		FramePacingMode mFramePacing = FramePacingMode::Timer;
+		UINT64 mTimerOvershoot = 0; // Microseconds, average time the timer wakes up late by
 
 		DynLib* mRendererPlugin;
 
+		// Start-up timing
+		Timer mStartUpTimer;
+		UINT64 mLastStartUpStageTime = 0; // Microseconds
+		Vector<std::pair<String, UINT64>> mStartUpStages; // Stage name, duration in microseconds
+
 		Map<DynLib*, UpdatePluginFunc> mPluginUpdateFunctions;
 
-		bool mIsFrameRenderingFinished;
+		// Frame pipelining
+		UINT32 mMaxFramesInFlight = 1;
+		bool mAdaptiveFrameStart = false;
+		UINT64 mFrameStartDelay = 0; // Microseconds
+
+		UINT32 mNumFramesInFlight = 0;
 		Mutex mFrameRenderingFinishedMutex;
 		Signal mFrameRenderingFinishedCondition;
 		ThreadId mSimThreadId;
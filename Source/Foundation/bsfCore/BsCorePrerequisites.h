@@ -273,6 +273,7 @@ namespace bs
 	class PlaneCollider;
 	class CapsuleCollider;
 	class MeshCollider;
+	class HeightFieldCollider;
 	class Joint;
 	class FixedJoint;
 	class DistanceJoint;
@@ -303,6 +304,7 @@ namespace bs
 	COMPONENT_FORWARD_DECLARE(PlaneCollider)
 	COMPONENT_FORWARD_DECLARE(CapsuleCollider)
 	COMPONENT_FORWARD_DECLARE(MeshCollider)
+	COMPONENT_FORWARD_DECLARE(HeightFieldCollider)
 	COMPONENT_FORWARD_DECLARE(Joint)
 	COMPONENT_FORWARD_DECLARE(HingeJoint)
 	COMPONENT_FORWARD_DECLARE(DistanceJoint)
@@ -332,12 +334,17 @@ namespace bs
 	class RenderAPICapabilities;
 	class RenderTargetProperties;
 	class TextureManager;
+	class TextureStreamingManager;
+	struct TextureStreamingData;
 	class Input;
 	struct PointerEvent;
 	class RendererFactory;
 	class AsyncOp;
 	class HardwareBufferManager;
 	class FontManager;
+	class FontFace;
+	class FontRasterizer;
+	class DynamicFontAtlas;
 	class RenderStateManager;
 	class GpuParamBlock;
 	struct GpuParamDesc;
@@ -383,6 +390,7 @@ namespace bs
 	class GpuPipelineParamInfo;
 	template <class T> class TAnimationCurve;
 	struct AnimationCurves;
+	class CompressedAnimationCurves;
 	class Skeleton;
 	class MorphShapes;
 	class MorphShape;
@@ -394,10 +402,13 @@ namespace bs
 	// Asset import
 	class SpecificImporter;
 	class Importer;
+	class ImportCache;
 	// Resources
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class ResourcePackage;
+	class SavedResourceData;
 	class MeshBase;
 	class TransientMesh;
 	class MeshHeap;
@@ -637,6 +648,11 @@ namespace bs
 		TID_ParticleRotation = 1190,
 		TID_Decal = 1191,
 		TID_CDecal = 1192,
+		TID_ParticleSDFCollisionSettings = 1193,
+		TID_ParticleLODSettings = 1194,
+		TID_ImportCacheEntry = 1195,
+		TID_CompressedAnimationCurves = 1196,
+		TID_CHeightFieldCollider = 1197,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
@@ -688,6 +704,7 @@ namespace bs
 	/** @} */
 }
 
+#include "Allocators/BsPoolAlloc.h"
 #include "Scene/BsGameObjectHandle.h"
 
 namespace bs
@@ -711,6 +728,7 @@ namespace bs
 	typedef GameObjectHandle<CSphereCollider> HSphereCollider;
 	typedef GameObjectHandle<CCapsuleCollider> HCapsuleCollider;
 	typedef GameObjectHandle<CPlaneCollider> HPlaneCollider;
+	typedef GameObjectHandle<CHeightFieldCollider> HHeightFieldCollider;
 	typedef GameObjectHandle<CJoint> HJoint;
 	typedef GameObjectHandle<CHingeJoint> HHingeJoint;
 	typedef GameObjectHandle<CSliderJoint> HSliderJoint;
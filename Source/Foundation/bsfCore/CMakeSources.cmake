@@ -6,6 +6,7 @@ set(BS_CORE_INC_COMPONENTS
 	"bsfCore/Components/BsCCapsuleCollider.h"
 	"bsfCore/Components/BsCPlaneCollider.h"
 	"bsfCore/Components/BsCMeshCollider.h"
+	"bsfCore/Components/BsCHeightFieldCollider.h"
 	"bsfCore/Components/BsCJoint.h"
 	"bsfCore/Components/BsCFixedJoint.h"
 	"bsfCore/Components/BsCHingeJoint.h"
@@ -40,6 +41,7 @@ set(BS_CORE_INC_PHYSICS
 	"bsfCore/Physics/BsFCollider.h"
 	"bsfCore/Physics/BsPhysicsMesh.h"
 	"bsfCore/Physics/BsMeshCollider.h"
+	"bsfCore/Physics/BsHeightFieldCollider.h"
 	"bsfCore/Physics/BsFJoint.h"
 	"bsfCore/Physics/BsJoint.h"
 	"bsfCore/Physics/BsFixedJoint.h"
@@ -59,6 +61,7 @@ set(BS_CORE_INC_CORETHREAD
 	"bsfCore/CoreThread/BsCoreObjectManager.h"
 	"bsfCore/CoreThread/BsCoreObject.h"
 	"bsfCore/CoreThread/BsCommandQueue.h"
+	"bsfCore/CoreThread/BsCommandRingBuffer.h"
 	"bsfCore/CoreThread/BsCoreObjectCore.h"
 	"bsfCore/CoreThread/BsCoreObjectSync.h"
 )
@@ -67,6 +70,7 @@ set(BS_CORE_INC_IMPORTER
 	"bsfCore/Importer/BsSpecificImporter.h"
 	"bsfCore/Importer/BsImportOptions.h"
 	"bsfCore/Importer/BsImporter.h"
+	"bsfCore/Importer/BsImportCache.h"
 	"bsfCore/Importer/BsTextureImportOptions.h"
 	"bsfCore/Importer/BsShaderIncludeImporter.h"
 	"bsfCore/Importer/BsMeshImportOptions.h"
@@ -85,6 +89,9 @@ set(BS_CORE_INC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.h"
 	"bsfCore/Scene/BsTransform.h"
 	"bsfCore/Scene/BsSceneActor.h"
+	"bsfCore/Scene/BsSceneObjectPool.h"
+	"bsfCore/Scene/BsWorldPartition.h"
+	"bsfCore/Scene/BsReplicatedState.h"
 )
 
 set(BS_CORE_INC_INPUT
@@ -93,6 +100,7 @@ set(BS_CORE_INC_INPUT
 	"bsfCore/Input/BsMouse.h"
 	"bsfCore/Input/BsKeyboard.h"
 	"bsfCore/Input/BsGamepad.h"
+	"bsfCore/Input/BsInputSampleBuffer.h"
 )
 
 set(BS_CORE_INC_RENDERER
@@ -111,7 +119,11 @@ set(BS_CORE_INC_RENDERER
 	"bsfCore/Renderer/BsLightProbeVolume.h"
 	"bsfCore/Renderer/BsIBLUtility.h"
 	"bsfCore/Renderer/BsGpuResourcePool.h"
+	"bsfCore/Renderer/BsTextureTable.h"
 	"bsfCore/Renderer/BsDecal.h"
+	"bsfCore/Renderer/BsHLODBuilder.h"
+	"bsfCore/Renderer/BsTerrainBuilder.h"
+	"bsfCore/Renderer/BsTerrainClipmap.h"
 )
 
 set(BS_CORE_SRC_LOCALIZATION
@@ -128,7 +140,10 @@ set(BS_CORE_INC_PROFILING
 	"bsfCore/Profiling/BsProfilerCPU.h"
 	"bsfCore/Profiling/BsProfilerGPU.h"
 	"bsfCore/Profiling/BsProfilingManager.h"
+	"bsfCore/Profiling/BsProfilerTimeline.h"
+	"bsfCore/Profiling/BsFrameTelemetry.h"
 	"bsfCore/Profiling/BsRenderStats.h"
+	"bsfCore/Profiling/BsScriptGCProfiler.h"
 )
 
 set(BS_CORE_INC_RENDERAPI
@@ -177,10 +192,12 @@ set(BS_CORE_INC_RENDERAPI_MANAGERS
 	"bsfCore/Managers/BsCommandBufferManager.h"
 	"bsfCore/Managers/BsTextureManager.h"
 	"bsfCore/Managers/BsResourceListenerManager.h"
+	"bsfCore/Managers/BsTextureStreamingManager.h"
 )
 
 set(BS_CORE_SRC_CORETHREAD
 	"bsfCore/CoreThread/BsCommandQueue.cpp"
+	"bsfCore/CoreThread/BsCommandRingBuffer.cpp"
 	"bsfCore/CoreThread/BsCoreObject.cpp"
 	"bsfCore/CoreThread/BsCoreObjectManager.cpp"
 	"bsfCore/CoreThread/BsCoreThread.cpp"
@@ -209,6 +226,7 @@ set(BS_CORE_INC_MATERIAL
 set(BS_CORE_INC_RESOURCES
 	"bsfCore/Resources/BsResources.h"
 	"bsfCore/Resources/BsResourceManifest.h"
+	"bsfCore/Resources/BsResourcePackage.h"
 	"bsfCore/Resources/BsResourceHandle.h"
 	"bsfCore/Resources/BsResource.h"
 	"bsfCore/Resources/BsGpuResourceData.h"
@@ -224,6 +242,8 @@ set(BS_CORE_INC_MESH
 	"bsfCore/Mesh/BsMeshBase.h"
 	"bsfCore/Mesh/BsMesh.h"
 	"bsfCore/Mesh/BsMeshUtility.h"
+	"bsfCore/Mesh/BsMeshBuilder.h"
+	"bsfCore/Mesh/BsMeshBVH.h"
 )
 
 set(BS_CORE_INC_IMAGE
@@ -232,6 +252,7 @@ set(BS_CORE_INC_IMAGE
 	"bsfCore/Image/BsPixelUtil.h"
 	"bsfCore/Image/BsPixelVolume.h"
 	"bsfCore/Image/BsSpriteTexture.h"
+	"bsfCore/Image/BsTextureReadbackQueue.h"
 )
 
 set(BS_CORE_SRC_UTILITY
@@ -245,12 +266,17 @@ set(BS_CORE_INC_TEXT
 	"bsfCore/Text/BsFontImportOptions.h"
 	"bsfCore/Text/BsFontDesc.h"
 	"bsfCore/Text/BsFont.h"
+	"bsfCore/Text/BsFontManager.h"
+	"bsfCore/Text/BsDynamicFontAtlas.h"
 )
 
 set(BS_CORE_SRC_PROFILING
 	"bsfCore/Profiling/BsProfilerCPU.cpp"
 	"bsfCore/Profiling/BsProfilerGPU.cpp"
 	"bsfCore/Profiling/BsProfilingManager.cpp"
+	"bsfCore/Profiling/BsProfilerTimeline.cpp"
+	"bsfCore/Profiling/BsFrameTelemetry.cpp"
+	"bsfCore/Profiling/BsScriptGCProfiler.cpp"
 )
 
 set(BS_CORE_SRC_COMPONENTS
@@ -261,6 +287,7 @@ set(BS_CORE_SRC_COMPONENTS
 	"bsfCore/Components/BsCPlaneCollider.cpp"
 	"bsfCore/Components/BsCCapsuleCollider.cpp"
 	"bsfCore/Components/BsCMeshCollider.cpp"
+	"bsfCore/Components/BsCHeightFieldCollider.cpp"
 	"bsfCore/Components/BsCJoint.cpp"
 	"bsfCore/Components/BsCFixedJoint.cpp"
 	"bsfCore/Components/BsCHingeJoint.cpp"
@@ -285,6 +312,7 @@ set(BS_CORE_SRC_COMPONENTS
 
 set(BS_CORE_SRC_IMPORTER
 	"bsfCore/Importer/BsImporter.cpp"
+	"bsfCore/Importer/BsImportCache.cpp"
 	"bsfCore/Importer/BsImportOptions.cpp"
 	"bsfCore/Importer/BsSpecificImporter.cpp"
 	"bsfCore/Importer/BsTextureImportOptions.cpp"
@@ -331,6 +359,7 @@ set(BS_CORE_INC_RTTI
 	"bsfCore/Private/RTTI/BsResourceMetaDataRTTI.h"
 	"bsfCore/Private/RTTI/BsViewportRTTI.h"
 	"bsfCore/Private/RTTI/BsSavedResourceDataRTTI.h"
+	"bsfCore/Private/RTTI/BsImportCacheRTTI.h"
 	"bsfCore/Private/RTTI/BsShaderIncludeRTTI.h"
 	"bsfCore/Private/RTTI/BsMeshImportOptionsRTTI.h"
 	"bsfCore/Private/RTTI/BsPrefabRTTI.h"
@@ -346,6 +375,7 @@ set(BS_CORE_INC_RTTI
 	"bsfCore/Private/RTTI/BsCPlaneColliderRTTI.h"
 	"bsfCore/Private/RTTI/BsCCapsuleColliderRTTI.h"
 	"bsfCore/Private/RTTI/BsCMeshColliderRTTI.h"
+	"bsfCore/Private/RTTI/BsCHeightFieldColliderRTTI.h"
 	"bsfCore/Private/RTTI/BsCJointRTTI.h"
 	"bsfCore/Private/RTTI/BsCFixedJointRTTI.h"
 	"bsfCore/Private/RTTI/BsCHingeJointRTTI.h"
@@ -361,6 +391,7 @@ set(BS_CORE_INC_RTTI
 	"bsfCore/Private/RTTI/BsCAudioListenerRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationClipRTTI.h"
 	"bsfCore/Private/RTTI/BsAnimationCurveRTTI.h"
+	"bsfCore/Private/RTTI/BsAnimationCompressionRTTI.h"
 	"bsfCore/Private/RTTI/BsSkeletonRTTI.h"
 	"bsfCore/Private/RTTI/BsCCameraRTTI.h"
 	"bsfCore/Private/RTTI/BsCameraRTTI.h"
@@ -406,7 +437,11 @@ set(BS_CORE_SRC_RENDERER
 	"bsfCore/Renderer/BsLightProbeVolume.cpp"
 	"bsfCore/Renderer/BsIBLUtility.cpp"
 	"bsfCore/Renderer/BsGpuResourcePool.cpp"
+	"bsfCore/Renderer/BsTextureTable.cpp"
 	"bsfCore/Renderer/BsDecal.cpp"
+	"bsfCore/Renderer/BsHLODBuilder.cpp"
+	"bsfCore/Renderer/BsTerrainBuilder.cpp"
+	"bsfCore/Renderer/BsTerrainClipmap.cpp"
 )
 
 set(BS_CORE_SRC_RESOURCES
@@ -414,6 +449,7 @@ set(BS_CORE_SRC_RESOURCES
 	"bsfCore/Resources/BsResource.cpp"
 	"bsfCore/Resources/BsResourceHandle.cpp"
 	"bsfCore/Resources/BsResourceManifest.cpp"
+	"bsfCore/Resources/BsResourcePackage.cpp"
 	"bsfCore/Resources/BsResources.cpp"
 	"bsfCore/Resources/BsResourceMetaData.cpp"
 	"bsfCore/Resources/BsSavedResourceData.cpp"
@@ -427,6 +463,8 @@ set(BS_CORE_SRC_MESH
 	"bsfCore/Mesh/BsMeshHeap.cpp"
 	"bsfCore/Mesh/BsTransientMesh.cpp"
 	"bsfCore/Mesh/BsMeshUtility.cpp"
+	"bsfCore/Mesh/BsMeshBuilder.cpp"
+	"bsfCore/Mesh/BsMeshBVH.cpp"
 )
 
 set(BS_CORE_SRC_IMAGE
@@ -434,6 +472,7 @@ set(BS_CORE_SRC_IMAGE
 	"bsfCore/Image/BsTexture.cpp"
 	"bsfCore/Image/BsPixelUtil.cpp"
 	"bsfCore/Image/BsSpriteTexture.cpp"
+	"bsfCore/Image/BsTextureReadbackQueue.cpp"
 )
 
 set(BS_CORE_SRC_MATERIAL
@@ -461,6 +500,8 @@ set(BS_CORE_INC_LOCALIZATION
 
 set(BS_CORE_SRC_TEXT
 	"bsfCore/Text/BsFont.cpp"
+	"bsfCore/Text/BsFontManager.cpp"
+	"bsfCore/Text/BsDynamicFontAtlas.cpp"
 	"bsfCore/Text/BsFontImportOptions.cpp"
 	"bsfCore/Text/BsTextData.cpp"
 )
@@ -508,6 +549,7 @@ set(BS_CORE_SRC_RENDERAPI_MANAGERS
 	"bsfCore/Managers/BsCommandBufferManager.cpp"
 	"bsfCore/Managers/BsTextureManager.cpp"
 	"bsfCore/Managers/BsResourceListenerManager.cpp"
+	"bsfCore/Managers/BsTextureStreamingManager.cpp"
 )
 
 set(BS_CORE_SRC_NOFILTER
@@ -527,6 +569,7 @@ set(BS_CORE_SRC_PHYSICS
 	"bsfCore/Physics/BsFCollider.cpp"
 	"bsfCore/Physics/BsPhysicsMesh.cpp"
 	"bsfCore/Physics/BsMeshCollider.cpp"
+	"bsfCore/Physics/BsHeightFieldCollider.cpp"
 	"bsfCore/Physics/BsFJoint.cpp"
 	"bsfCore/Physics/BsJoint.cpp"
 	"bsfCore/Physics/BsFixedJoint.cpp"
@@ -550,6 +593,9 @@ set(BS_CORE_SRC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.cpp"
 	"bsfCore/Scene/BsTransform.cpp"
 	"bsfCore/Scene/BsSceneActor.cpp"
+	"bsfCore/Scene/BsSceneObjectPool.cpp"
+	"bsfCore/Scene/BsWorldPartition.cpp"
+	"bsfCore/Scene/BsReplicatedState.cpp"
 )
 
 set(BS_CORE_INC_AUDIO
@@ -560,6 +606,8 @@ set(BS_CORE_INC_AUDIO
 	"bsfCore/Audio/BsAudioClipImportOptions.h"
 	"bsfCore/Audio/BsAudioUtility.h"
 	"bsfCore/Audio/BsAudioManager.h"
+	"bsfCore/Audio/BsAudioDSP.h"
+	"bsfCore/Audio/BsAudioDSPThread.h"
 )
 
 set(BS_CORE_SRC_AUDIO
@@ -570,6 +618,8 @@ set(BS_CORE_SRC_AUDIO
 	"bsfCore/Audio/BsAudioClipImportOptions.cpp"
 	"bsfCore/Audio/BsAudioUtility.cpp"
 	"bsfCore/Audio/BsAudioManager.cpp"
+	"bsfCore/Audio/BsAudioDSP.cpp"
+	"bsfCore/Audio/BsAudioDSPThread.cpp"
 )
 
 set(BS_CORE_INC_ANIMATION
@@ -582,6 +632,7 @@ set(BS_CORE_INC_ANIMATION
 	"bsfCore/Animation/BsAnimationUtility.h"
 	"bsfCore/Animation/BsSkeletonMask.h"
 	"bsfCore/Animation/BsMorphShapes.h"
+	"bsfCore/Animation/BsAnimationCompression.h"
 )
 
 set(BS_CORE_SRC_ANIMATION
@@ -593,6 +644,7 @@ set(BS_CORE_SRC_ANIMATION
 	"bsfCore/Animation/BsAnimationUtility.cpp"
 	"bsfCore/Animation/BsSkeletonMask.cpp"
 	"bsfCore/Animation/BsMorphShapes.cpp"
+	"bsfCore/Animation/BsAnimationCompression.cpp"
 )
 
 set(BS_CORE_INC_PARTICLES
@@ -613,6 +665,7 @@ set(BS_CORE_SRC_PARTICLES
 	"bsfCore/Particles/BsParticleManager.cpp"
 	"bsfCore/Particles/BsParticleDistribution.cpp"
 	"bsfCore/Particles/BsVectorField.cpp"
+	"bsfCore/Private/Particles/BsParticleSet.cpp"
 )
 
 set(BS_CORE_INC_PLATFORM
@@ -623,6 +676,7 @@ set(BS_CORE_INC_PLATFORM
 
 set(BS_CORE_SRC_PLATFORM
 	"bsfCore/Platform/BsDropTarget.cpp"
+	"bsfCore/Platform/BsFolderMonitor.cpp"
 )
 
 set(BS_CORE_INC_PLATFORM_WIN32
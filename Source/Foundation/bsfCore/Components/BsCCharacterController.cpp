@@ -3,6 +3,7 @@
 #include "Components/BsCCharacterController.h"
 #include "Scene/BsSceneObject.h"
 #include "Physics/BsCollider.h"
+#include "Physics/BsPhysics.h"
 #include "Private/RTTI/BsCCharacterControllerRTTI.h"
 #include "BsCCollider.h"
 
@@ -38,6 +39,48 @@ namespace bs
 		return output;
 	}
 
+	void CCharacterController::moveBatch(const HCharacterController* controllers, const Vector3* displacements,
+		UINT32 count, CharacterCollisionFlags* flags)
+	{
+		Vector<CharacterController*> internals;
+		Vector<Vector3> validDisplacements;
+		Vector<UINT32> indices;
+
+		internals.reserve(count);
+		validDisplacements.reserve(count);
+		indices.reserve(count);
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			if (flags != nullptr)
+				flags[i] = CharacterCollisionFlags();
+
+			if (controllers[i].isDestroyed() || controllers[i]->mInternal == nullptr)
+				continue;
+
+			internals.push_back(controllers[i]->_getInternal());
+			validDisplacements.push_back(displacements[i]);
+			indices.push_back(i);
+		}
+
+		if (internals.empty())
+			return;
+
+		const UINT32 numValid = (UINT32)internals.size();
+		Vector<CharacterCollisionFlags> validFlags(numValid);
+		gPhysics().moveCharacterControllers(internals.data(), validDisplacements.data(), numValid,
+			validFlags.data());
+
+		for (UINT32 i = 0; i < numValid; i++)
+		{
+			const UINT32 idx = indices[i];
+			controllers[idx]->updatePositionFromController();
+
+			if (flags != nullptr)
+				flags[idx] = validFlags[i];
+		}
+	}
+
 	Vector3 CCharacterController::getFootPosition() const
 	{
 		if (mInternal == nullptr)
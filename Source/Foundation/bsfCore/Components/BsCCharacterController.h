@@ -26,6 +26,19 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Move)
 		CharacterCollisionFlags move(const Vector3& displacement);
 
+		/**
+		 * Moves multiple controllers and updates their scene object positions. Same as calling move() for each
+		 * controller, but processes the moves as a batch. See Physics::moveCharacterControllers().
+		 *
+		 * @param[in]	controllers		Array of controllers to move. Each controller must be present only once.
+		 * @param[in]	displacements	Array of displacements to move each of the controllers by.
+		 * @param[in]	count			Number of entries in the @p controllers, @p displacements and @p flags arrays.
+		 * @param[out]	flags			Optional pre-allocated array that receives the collision flags for each
+		 *								controller.
+		 */
+		static void moveBatch(const HCharacterController* controllers, const Vector3* displacements, UINT32 count,
+			CharacterCollisionFlags* flags = nullptr);
+
 		/** @copydoc CharacterController::getFootPosition */
 		BS_SCRIPT_EXPORT(n:FootPosition,pr:getter)
 		Vector3 getFootPosition() const;
@@ -0,0 +1,75 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Components/BsCHeightFieldCollider.h"
+#include "Scene/BsSceneObject.h"
+#include "Components/BsCRigidbody.h"
+#include "Private/RTTI/BsCHeightFieldColliderRTTI.h"
+
+namespace bs
+{
+	CHeightFieldCollider::CHeightFieldCollider()
+	{
+		setName("HeightFieldCollider");
+	}
+
+	CHeightFieldCollider::CHeightFieldCollider(const HSceneObject& parent)
+		: CCollider(parent)
+	{
+		setName("HeightFieldCollider");
+	}
+
+	void CHeightFieldCollider::setHeights(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows)
+	{
+		if (!heights.empty() && (numColumns < 2 || numRows < 2 || (UINT32)heights.size() != numColumns * numRows))
+		{
+			LOGERR("Invalid height field. Height field must have at least two rows and columns, and one height per "
+				"sample.");
+			return;
+		}
+
+		mHeights = heights;
+		mNumColumns = heights.empty() ? 0 : numColumns;
+		mNumRows = heights.empty() ? 0 : numRows;
+
+		if (mInternal != nullptr)
+			_getInternal()->setHeights(mHeights, mNumColumns, mNumRows);
+	}
+
+	void CHeightFieldCollider::setSpacing(const Vector2& spacing)
+	{
+		if (mSpacing == spacing)
+			return;
+
+		mSpacing = spacing;
+
+		if (mInternal != nullptr)
+			_getInternal()->setSpacing(spacing);
+	}
+
+	SPtr<Collider> CHeightFieldCollider::createInternal()
+	{
+		const Transform& tfrm = SO()->getTransform();
+		SPtr<HeightFieldCollider> collider = HeightFieldCollider::create(tfrm.getPosition(), tfrm.getRotation());
+		collider->setSpacing(mSpacing);
+		collider->setHeights(mHeights, mNumColumns, mNumRows);
+		collider->_setOwner(PhysicsOwnerType::Component, this);
+
+		return collider;
+	}
+
+	bool CHeightFieldCollider::isValidParent(const HRigidbody& parent) const
+	{
+		// Height fields cannot be used for non-kinematic rigidbodies
+		return parent->getIsKinematic();
+	}
+
+	RTTITypeBase* CHeightFieldCollider::getRTTIStatic()
+	{
+		return CHeightFieldColliderRTTI::instance();
+	}
+
+	RTTITypeBase* CHeightFieldCollider::getRTTI() const
+	{
+		return CHeightFieldCollider::getRTTIStatic();
+	}
+}
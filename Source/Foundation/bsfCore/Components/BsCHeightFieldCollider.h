@@ -0,0 +1,89 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Physics/BsHeightFieldCollider.h"
+#include "Components/BsCCollider.h"
+
+namespace bs 
+{
+	/** @addtogroup Components-Core
+	 *  @{
+	 */
+
+	/**
+	 * @copydoc	HeightFieldCollider
+	 *
+	 * @note Wraps HeightFieldCollider as a Component.
+	 */
+	class BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:Physics,n:HeightFieldCollider) CHeightFieldCollider : public CCollider
+	{
+	public:
+		CHeightFieldCollider(const HSceneObject& parent);
+
+		/** @copydoc HeightFieldCollider::setHeights */
+		BS_SCRIPT_EXPORT(n:SetHeights)
+		void setHeights(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows);
+
+		/** @copydoc HeightFieldCollider::getHeights */
+		BS_SCRIPT_EXPORT(n:Heights,pr:getter)
+		const Vector<float>& getHeights() const { return mHeights; }
+
+		/** @copydoc HeightFieldCollider::getNumColumns */
+		BS_SCRIPT_EXPORT(n:NumColumns,pr:getter)
+		UINT32 getNumColumns() const { return mNumColumns; }
+
+		/** @copydoc HeightFieldCollider::getNumRows */
+		BS_SCRIPT_EXPORT(n:NumRows,pr:getter)
+		UINT32 getNumRows() const { return mNumRows; }
+
+		/** @copydoc HeightFieldCollider::setSpacing */
+		BS_SCRIPT_EXPORT(n:Spacing,pr:setter)
+		void setSpacing(const Vector2& spacing);
+
+		/** @copydoc HeightFieldCollider::getSpacing */
+		BS_SCRIPT_EXPORT(n:Spacing,pr:getter)
+		Vector2 getSpacing() const { return mSpacing; }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**	Returns the height field collider that this component wraps. */
+		HeightFieldCollider* _getInternal() const { return static_cast<HeightFieldCollider*>(mInternal.get()); }
+
+		/** @} */
+
+		/************************************************************************/
+		/* 						COMPONENT OVERRIDES                      		*/
+		/************************************************************************/
+	protected:
+		friend class SceneObject;
+
+		/** @copydoc CCollider::createInternal */
+		SPtr<Collider> createInternal() override;
+
+		/** @copydoc CCollider::isValidParent */
+		bool isValidParent(const HRigidbody& parent) const override;
+
+	protected:
+		Vector<float> mHeights;
+		UINT32 mNumColumns = 0;
+		UINT32 mNumRows = 0;
+		Vector2 mSpacing = Vector2::ONE;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+	public:
+		friend class CHeightFieldColliderRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+
+	protected:
+		CHeightFieldCollider(); // Serialization only
+	};
+
+	 /** @} */
+}
@@ -57,6 +57,46 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Layers,pr:getter)
 		UINT64 getLayer() const { return mInternal->getLayer(); }
 
+		/** @copydoc Renderable::setLODScreenSizes */
+		BS_SCRIPT_EXPORT(n:LODScreenSizes,pr:setter)
+		void setLODScreenSizes(const Vector<float>& sizes) { mInternal->setLODScreenSizes(sizes); }
+
+		/** @copydoc Renderable::getLODScreenSizes */
+		BS_SCRIPT_EXPORT(n:LODScreenSizes,pr:getter)
+		const Vector<float>& getLODScreenSizes() const { return mInternal->getLODScreenSizes(); }
+
+		/** @copydoc Renderable::setDrawDistance */
+		BS_SCRIPT_EXPORT(n:SetDrawDistance)
+		void setDrawDistance(const Vector3& origin, float minDistance, float maxDistance)
+		{
+			mInternal->setDrawDistance(origin, minDistance, maxDistance);
+		}
+
+		/** @copydoc Renderable::getMinDrawDistance */
+		BS_SCRIPT_EXPORT(n:MinDrawDistance,pr:getter)
+		float getMinDrawDistance() const { return mInternal->getMinDrawDistance(); }
+
+		/** @copydoc Renderable::getMaxDrawDistance */
+		BS_SCRIPT_EXPORT(n:MaxDrawDistance,pr:getter)
+		float getMaxDrawDistance() const { return mInternal->getMaxDrawDistance(); }
+
+		/** @copydoc Renderable::setCastsShadows */
+		BS_SCRIPT_EXPORT(n:CastsShadows,pr:setter)
+		void setCastsShadows(bool enable) { mInternal->setCastsShadows(enable); }
+
+		/** @copydoc Renderable::getCastsShadows */
+		BS_SCRIPT_EXPORT(n:CastsShadows,pr:getter)
+		bool getCastsShadows() const { return mInternal->getCastsShadows(); }
+
+		/** @copydoc Renderable::setTextureOverride */
+		void setTextureOverride(RenderableTexture slot, const HTexture& texture)
+		{
+			mInternal->setTextureOverride(slot, texture);
+		}
+
+		/** @copydoc Renderable::getTextureOverride */
+		const HTexture& getTextureOverride(RenderableTexture slot) const { return mInternal->getTextureOverride(slot); }
+
 		/**	Gets world bounds of the mesh rendered by this object. */
 		BS_SCRIPT_EXPORT(n:Bounds,pr:getter)
 		Bounds getBounds() const;
@@ -39,6 +39,14 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Brightness,pr:getter)
 		float getBrightness() const { return mInternal->getBrightness(); }
 
+		/** @copydoc Skybox::setAtmosphere */
+		BS_SCRIPT_EXPORT(n:Atmosphere,pr:setter)
+		void setAtmosphere(bool enabled) { mInternal->setAtmosphere(enabled); }
+
+		/** @copydoc Skybox::getAtmosphere */
+		BS_SCRIPT_EXPORT(n:Atmosphere,pr:getter)
+		bool getAtmosphere() const { return mInternal->getAtmosphere(); }
+
 		/** @name Internal
 		 *  @{
 		 */
@@ -38,9 +38,6 @@ namespace bs
 	class CommandQueueSync
 	{
 	public:
-		CommandQueueSync()
-			:mLock(mCommandQueueMutex, std::defer_lock)
-		{ }
 		virtual ~CommandQueueSync() {}
 
 		bool isValidThread(ThreadId ownerThread) const
@@ -50,17 +47,16 @@ namespace bs
 
 		void lock() 
 		{
-			mLock.lock();
+			mCommandQueueMutex.lock();
 		};
 
 		void unlock()
 		{
-			mLock.unlock();
+			mCommandQueueMutex.unlock();
 		}
 
 	private:
 		Mutex mCommandQueueMutex;
-		Lock mLock;
 	};
 
 	/**
@@ -0,0 +1,167 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "CoreThread/BsCommandRingBuffer.h"
+
+namespace bs
+{
+	CommandRingBuffer::CommandRingBuffer(UINT32 blockSize)
+		: mBlockSize(std::max(blockSize, HEADER_SIZE * 2))
+	{
+		mWriteBlock = acquireBlock(mBlockSize);
+		mReadBlock = mWriteBlock;
+	}
+
+	CommandRingBuffer::~CommandRingBuffer()
+	{
+		// Release any commands that were never executed
+		Block* block = mReadBlock;
+		UINT32 offset = mReadOffset;
+		while (block != nullptr)
+		{
+			const UINT32 end = block->end.load(std::memory_order_acquire);
+			while (offset < end)
+			{
+				CommandHeader* header = (CommandHeader*)(block->data + offset);
+				header->destroy(block->data + offset + HEADER_SIZE);
+
+				offset += header->size;
+			}
+
+			Block* next = block->next.load(std::memory_order_acquire);
+			destroyBlock(block);
+
+			block = next;
+			offset = 0;
+		}
+
+		auto destroyList = [](Block* block)
+		{
+			while (block != nullptr)
+			{
+				Block* next = block->nextFree;
+				destroyBlock(block);
+				block = next;
+			}
+		};
+
+		destroyList(mFreeBlocks);
+		destroyList(mRecycledBlocks.load(std::memory_order_acquire));
+	}
+
+	UINT32 CommandRingBuffer::playback()
+	{
+		UINT32 numExecuted = 0;
+		while (findNext() != nullptr)
+		{
+			executeNext();
+			numExecuted++;
+		}
+
+		return numExecuted;
+	}
+
+	bool CommandRingBuffer::peek(UINT64& tag)
+	{
+		CommandHeader* header = findNext();
+		if (header == nullptr)
+			return false;
+
+		tag = header->tag;
+		return true;
+	}
+
+	void CommandRingBuffer::executeNext()
+	{
+		CommandHeader* header = (CommandHeader*)(mReadBlock->data + mReadOffset);
+		void* command = mReadBlock->data + mReadOffset + HEADER_SIZE;
+
+		header->execute(command);
+		header->destroy(command);
+
+		mReadOffset += header->size;
+	}
+
+	CommandRingBuffer::CommandHeader* CommandRingBuffer::findNext()
+	{
+		while (true)
+		{
+			if (mReadOffset < mReadBlock->end.load(std::memory_order_acquire))
+				return (CommandHeader*)(mReadBlock->data + mReadOffset);
+
+			// The producer always writes the final end offset before linking the next block, so once the link is visible
+			// the end of this block needs to be checked one more time
+			Block* next = mReadBlock->next.load(std::memory_order_acquire);
+			if (next == nullptr)
+				return nullptr;
+
+			if (mReadOffset < mReadBlock->end.load(std::memory_order_acquire))
+				return (CommandHeader*)(mReadBlock->data + mReadOffset);
+
+			// All the commands in the block were executed, hand it back to the producer
+			Block* finishedBlock = mReadBlock;
+			mReadBlock = next;
+			mReadOffset = 0;
+
+			finishedBlock->nextFree = mRecycledBlocks.load(std::memory_order_relaxed);
+			while (!mRecycledBlocks.compare_exchange_weak(finishedBlock->nextFree, finishedBlock,
+				std::memory_order_release, std::memory_order_relaxed))
+			{ }
+		}
+	}
+
+	UINT8* CommandRingBuffer::allocate(UINT32 size)
+	{
+		if (mWriteOffset + size > mWriteBlock->size)
+		{
+			// Start a new block, the consumer will follow the link once it finishes executing this one
+			Block* newBlock = acquireBlock(size);
+			mWriteBlock->next.store(newBlock, std::memory_order_release);
+
+			mWriteBlock = newBlock;
+			mWriteOffset = 0;
+		}
+
+		return mWriteBlock->data + mWriteOffset;
+	}
+
+	void CommandRingBuffer::commit(UINT32 size)
+	{
+		mWriteOffset += size;
+		mWriteBlock->end.store(mWriteOffset, std::memory_order_release);
+	}
+
+	CommandRingBuffer::Block* CommandRingBuffer::acquireBlock(UINT32 size)
+	{
+		if (size <= mBlockSize)
+		{
+			if (mFreeBlocks == nullptr)
+				mFreeBlocks = mRecycledBlocks.exchange(nullptr, std::memory_order_acquire);
+
+			if (mFreeBlocks != nullptr)
+			{
+				Block* block = mFreeBlocks;
+				mFreeBlocks = block->nextFree;
+
+				block->end.store(0, std::memory_order_relaxed);
+				block->next.store(nullptr, std::memory_order_relaxed);
+				block->nextFree = nullptr;
+
+				return block;
+			}
+
+			size = mBlockSize;
+		}
+
+		Block* block = bs_new<Block>();
+		block->data = (UINT8*)bs_alloc(size);
+		block->size = size;
+
+		return block;
+	}
+
+	void CommandRingBuffer::destroyBlock(Block* block)
+	{
+		bs_free(block->data);
+		bs_delete(block);
+	}
+}
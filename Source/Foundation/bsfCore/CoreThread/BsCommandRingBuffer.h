@@ -0,0 +1,169 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup CoreThread-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Lock-free queue of commands, meant to be used by exactly one producer and one consumer thread. Commands are stored
+	 * inline in fixed-size blocks of memory, and blocks are recycled once the consumer has executed all of their commands.
+	 * This means that after a short warm-up queuing a command performs no allocations or locking, regardless of the size
+	 * of the callable.
+	 *
+	 * Each command can be tagged with a user-provided value, which the consumer can inspect before executing the command.
+	 * This allows the consumer to merge commands from multiple buffers in a specific order.
+	 *
+	 * @note	queue() must only be called from the producer thread, and the remaining methods only from the consumer
+	 *			thread. The threads don't need to be the same for the entire lifetime of the buffer, as long as the caller
+	 *			ensures there is only one of each at a time (e.g. multiple producers can share the buffer if they queue
+	 *			under a lock).
+	 */
+	class BS_CORE_EXPORT CommandRingBuffer
+	{
+		/** Block of memory holding one or multiple commands. */
+		struct Block
+		{
+			UINT8* data = nullptr;
+			UINT32 size = 0;
+
+			/** Offset up to which the producer has written fully constructed commands. */
+			std::atomic<UINT32> end{0};
+
+			/** Block to continue reading from once all commands in this block are executed. Set by the producer. */
+			std::atomic<Block*> next{nullptr};
+
+			/** Next block in the list of blocks available for reuse. */
+			Block* nextFree = nullptr;
+		};
+
+		/** Header preceding every command in a block. */
+		struct CommandHeader
+		{
+			/** Executes the command stored after the header. */
+			void(*execute)(void* command);
+
+			/** Destroys the command stored after the header. */
+			void(*destroy)(void* command);
+
+			/** User-provided value, as provided to queue(). */
+			UINT64 tag;
+
+			/** Total size of the command including the header, in bytes. */
+			UINT32 size;
+		};
+
+		/** Alignment of all commands within a block. */
+		static constexpr UINT32 COMMAND_ALIGNMENT = 16;
+
+		/** Size of the command header, rounded up to the command alignment. */
+		static constexpr UINT32 HEADER_SIZE =
+			(sizeof(CommandHeader) + COMMAND_ALIGNMENT - 1) / COMMAND_ALIGNMENT * COMMAND_ALIGNMENT;
+
+	public:
+		/**
+		 * @param[in]	blockSize	Size of a single block of command storage, in bytes. Commands larger than the block
+		 *							size are supported, but require a dedicated allocation.
+		 */
+		CommandRingBuffer(UINT32 blockSize = 64 * 1024);
+		~CommandRingBuffer();
+
+		CommandRingBuffer(const CommandRingBuffer&) = delete;
+		CommandRingBuffer& operator=(const CommandRingBuffer&) = delete;
+
+		/**
+		 * Queues a new command for execution. The command must be a callable object taking no parameters. It is moved
+		 * into the buffer's storage, and destroyed right after it is executed. Producer thread only.
+		 *
+		 * @param[in]	command		Command to queue.
+		 * @param[in]	tag			Optional value that can be retrieved through peek() before the command is executed.
+		 */
+		template<class T>
+		void queue(T&& command, UINT64 tag = 0)
+		{
+			typedef typename std::decay<T>::type CommandType;
+			static_assert(alignof(CommandType) <= COMMAND_ALIGNMENT, "Command alignment not supported.");
+
+			const UINT32 commandSize = HEADER_SIZE +
+				((UINT32)sizeof(CommandType) + COMMAND_ALIGNMENT - 1) / COMMAND_ALIGNMENT * COMMAND_ALIGNMENT;
+
+			UINT8* dst = allocate(commandSize);
+
+			CommandHeader* header = (CommandHeader*)dst;
+			header->execute = [](void* data) { (*(CommandType*)data)(); };
+			header->destroy = [](void* data) { ((CommandType*)data)->~CommandType(); };
+			header->size = commandSize;
+			header->tag = tag;
+
+			new (dst + HEADER_SIZE) CommandType(std::forward<T>(command));
+
+			commit(commandSize);
+		}
+
+		/**
+		 * Executes queued commands in the order they were queued, until no more commands are available. Consumer thread
+		 * only.
+		 *
+		 * @return	Number of executed commands.
+		 */
+		UINT32 playback();
+
+		/** 
+		 * Checks if there is a command waiting for execution, and returns its tag if there is. Consumer thread only.
+		 *
+		 * @param[out]	tag		Tag of the next command, as provided to queue(). Only valid if the method returns true.
+		 * @return				True if a command is available.
+		 */
+		bool peek(UINT64& tag);
+
+		/** 
+		 * Executes the next command. Must only be called after peek() returned true. Commands must not call into the
+		 * buffer they are being executed from. Consumer thread only.
+		 */
+		void executeNext();
+
+		/** Checks are there any commands waiting for execution. Consumer thread only. */
+		bool isEmpty() { UINT64 tag; return !peek(tag); }
+
+	private:
+		/** Reserves space for a command of the specified size, returning a pointer to it. Producer thread only. */
+		UINT8* allocate(UINT32 size);
+
+		/** 
+		 * Returns the header of the next command to execute, or null if no commands are available. Moves to the next 
+		 * block if the current one has been fully executed. Consumer thread only.
+		 */
+		CommandHeader* findNext();
+
+		/** Makes a command previously reserved with allocate() visible to the consumer. Producer thread only. */
+		void commit(UINT32 size);
+
+		/** Retrieves a block with at least the specified size, either one that was recycled or a new one. */
+		Block* acquireBlock(UINT32 size);
+
+		/** Frees the block's memory. */
+		static void destroyBlock(Block* block);
+
+		const UINT32 mBlockSize;
+
+		// Producer thread only
+		Block* mWriteBlock;
+		UINT32 mWriteOffset = 0;
+		Block* mFreeBlocks = nullptr;
+
+		// Consumer thread only
+		Block* mReadBlock;
+		UINT32 mReadOffset = 0;
+
+		/** Blocks returned by the consumer, waiting to be picked up by the producer for reuse. */
+		std::atomic<Block*> mRecycledBlocks{nullptr};
+	};
+
+	/** @} */
+}
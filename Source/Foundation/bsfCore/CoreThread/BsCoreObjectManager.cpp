@@ -6,6 +6,7 @@
 #include "Error/BsException.h"
 #include "Math/BsMath.h"
 #include "CoreThread/BsCoreThread.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -17,6 +18,15 @@ namespace bs
 
 	CoreObjectManager::~CoreObjectManager()
 	{
+		for (auto& syncData : mCoreSyncData)
+		{
+			for (auto& workerAlloc : syncData.workerAllocs)
+				bs_delete(workerAlloc);
+		}
+
+		for (auto& workerAlloc : mFreeWorkerAllocs)
+			bs_delete(workerAlloc);
+
 #if BS_DEBUG_MODE
 		Lock lock(mObjectsMutex);
 
@@ -45,7 +55,10 @@ namespace bs
 
 		UINT64 objId = object->getInternalID();
 		mObjects[objId] = object;
-		mDirtyObjects[objId] = { object, -1 };
+
+		DirtyObjectData& dirtyObjData = getDirtyEntry(objId);
+		dirtyObjData.object = object;
+		dirtyObjData.syncDataId = -1;
 	}
 
 	void CoreObjectManager::unregisterObject(CoreObject* object)
@@ -57,24 +70,25 @@ namespace bs
 		// If dirty, we generate sync data before it is destroyed
 		{
 			Lock lock(mObjectsMutex);
-			bool isDirty = object->isCoreDirty() || (mDirtyObjects.find(internalId) != mDirtyObjects.end());
+			bool isDirty = object->isCoreDirty() || (mDirtyObjectLookup.find(internalId) != mDirtyObjectLookup.end());
 
 			if (isDirty)
 			{
 				SPtr<ct::CoreObject> coreObject = object->getCore();
 				if (coreObject != nullptr)
 				{
-					CoreSyncData objSyncData = object->syncToCore(gCoreThread().getFrameAlloc());
+					FrameAlloc* allocator = gCoreThread().getFrameAlloc();
+					CoreSyncData objSyncData = object->syncToCore(allocator);
 				
-					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData));
+					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData, allocator));
 
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
+					DirtyObjectData& dirtyObjData = getDirtyEntry(internalId);
 					dirtyObjData.syncDataId = (INT32)mDestroyedSyncData.size() - 1;
 					dirtyObjData.object = nullptr;
 				}
 				else
 				{
-					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
+					DirtyObjectData& dirtyObjData = getDirtyEntry(internalId);
 					dirtyObjData.syncDataId = -1;
 					dirtyObjData.object = nullptr;
 				}
@@ -122,7 +136,40 @@ namespace bs
 
 		Lock lock(mObjectsMutex);
 
-		mDirtyObjects[id] = { object, -1 };
+		DirtyObjectData& dirtyObjData = getDirtyEntry(id);
+		dirtyObjData.object = object;
+		dirtyObjData.syncDataId = -1;
+	}
+
+	CoreObjectManager::DirtyObjectData& CoreObjectManager::getDirtyEntry(UINT64 internalId)
+	{
+		auto iterFind = mDirtyObjectLookup.find(internalId);
+		if (iterFind != mDirtyObjectLookup.end())
+			return mDirtyObjects[iterFind->second];
+
+		mDirtyObjectLookup[internalId] = (UINT32)mDirtyObjects.size();
+		mDirtyObjects.push_back({ internalId, nullptr, -1 });
+
+		return mDirtyObjects.back();
+	}
+
+	void CoreObjectManager::removeDirtyEntry(UINT64 internalId)
+	{
+		auto iterFind = mDirtyObjectLookup.find(internalId);
+		if (iterFind == mDirtyObjectLookup.end())
+			return;
+
+		// Order doesn't matter until sync, so just move the last entry in place of the removed one
+		const UINT32 idx = iterFind->second;
+		mDirtyObjectLookup.erase(iterFind);
+
+		if (idx != (UINT32)mDirtyObjects.size() - 1)
+		{
+			mDirtyObjects[idx] = mDirtyObjects.back();
+			mDirtyObjectLookup[mDirtyObjects[idx].internalId] = idx;
+		}
+
+		mDirtyObjects.pop_back();
 	}
 
 	void CoreObjectManager::notifyDependenciesDirty(CoreObject* object)
@@ -216,8 +263,8 @@ namespace bs
 
 	void CoreObjectManager::syncToCore()
 	{
-		syncDownload(gCoreThread().getFrameAlloc());
-		gCoreThread().queueCommand(std::bind(&CoreObjectManager::syncUpload, this));
+		if (syncDownload(gCoreThread().getFrameAlloc()))
+			gCoreThread().queueCommand(std::bind(&CoreObjectManager::syncUpload, this));
 	}
 
 	void CoreObjectManager::syncToCore(CoreObject* object)
@@ -257,7 +304,7 @@ namespace bs
 			if (objectCore == nullptr)
 			{
 				curObj->markCoreClean();
-				mDirtyObjects.erase(id);
+				removeDirtyEntry(id);
 				return;
 			}
 
@@ -268,7 +315,7 @@ namespace bs
 			data.syncData = curObj->syncToCore(allocator);
 
 			curObj->markCoreClean();
-			mDirtyObjects.erase(id);
+			removeDirtyEntry(id);
 		};
 
 		syncObject(object);
@@ -293,14 +340,15 @@ namespace bs
 			gCoreThread().queueCommand(std::bind(callback, syncData));
 	}
 
-	void CoreObjectManager::syncDownload(FrameAlloc* allocator)
+	bool CoreObjectManager::syncDownload(FrameAlloc* allocator)
 	{
 		Lock lock(mObjectsMutex);
 
-		mCoreSyncData.push_back(CoreStoredSyncData());
-		CoreStoredSyncData& syncData = mCoreSyncData.back();
+		if (mDirtyObjects.empty())
+			return false;
 
-		syncData.alloc = allocator;
+		mCoreSyncData.emplace_back(allocator);
+		CoreStoredSyncData& syncData = mCoreSyncData.back();
 		
 		// Add all objects dependant on the dirty objects
 		bs_frame_mark();
@@ -308,7 +356,7 @@ namespace bs
 			FrameSet<CoreObject*> dirtyDependants;
 			for (auto& objectData : mDirtyObjects)
 			{
-				auto iterFind = mDependants.find(objectData.first);
+				auto iterFind = mDependants.find(objectData.internalId);
 				if (iterFind != mDependants.end())
 				{
 					const Vector<CoreObject*>& dependants = iterFind->second;
@@ -317,7 +365,7 @@ namespace bs
 						const bool wasDirty = dependant->isCoreDirty();
 
 						// Let the dependant objects know their dependency changed
-						CoreObject* dependency = objectData.second.object;
+						CoreObject* dependency = objectData.object;
 						dependant->onDependencyDirty(dependency, dependency->getCoreDirtyFlags());
 
 						if (!wasDirty && dependant->isCoreDirty())
@@ -330,7 +378,9 @@ namespace bs
 			{
 				UINT64 id = dirtyDependant->getInternalID();
 
-				mDirtyObjects[id] = { dirtyDependant, -1 };
+				DirtyObjectData& dirtyObjData = getDirtyEntry(id);
+				dirtyObjData.object = dirtyDependant;
+				dirtyObjData.syncDataId = -1;
 			}
 		}
 
@@ -338,54 +388,128 @@ namespace bs
 		
 		// Order in which objects are recursed in matters, ones with lower ID will have been created before
 		// ones with higher ones and should be updated first.
-		for (auto& objectData : mDirtyObjects)
+		std::sort(mDirtyObjects.begin(), mDirtyObjects.end(), 
+			[](const DirtyObjectData& a, const DirtyObjectData& b) { return a.internalId < b.internalId; });
+
+		// Every dirty object produces at most one entry, so this is normally the only allocation
+		syncData.entries.reserve(mDirtyObjects.size());
+
+		bs_frame_mark();
 		{
-			std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+			// Determine the order in which the objects need to be synced first, and then pack their data in a separate
+			// pass. This way objects can be packed in parallel, while entries remain in deterministic order.
+			FrameVector<CoreObject*> syncObjects;
+			FrameUnorderedSet<CoreObject*> visited;
+
+			syncObjects.reserve(mDirtyObjects.size());
+
+			for (auto& objectData : mDirtyObjects)
 			{
-				if (!curObj->isCoreDirty())
-					return; // We already processed it as some other object's dependency
+				std::function<void(CoreObject*)> addObject = [&](CoreObject* curObj)
+				{
+					if (!curObj->isCoreDirty() || !visited.insert(curObj).second)
+						return; // We already processed it as some other object's dependency
 
-				// Sync dependencies before dependants
-				// Note: I don't check for recursion. Possible infinite loop if two objects
-				// are dependent on one another.
-				
-				UINT64 id = curObj->getInternalID();
-				auto iterFind = mDependencies.find(id);
+					// Sync dependencies before dependants
+					// Note: I don't check for recursion. Possible infinite loop if two objects
+					// are dependent on one another.
+					
+					UINT64 id = curObj->getInternalID();
+					auto iterFind = mDependencies.find(id);
 
-				if (iterFind != mDependencies.end())
+					if (iterFind != mDependencies.end())
+					{
+						const Vector<CoreObject*>& dependencies = iterFind->second;
+						for (auto& dependency : dependencies)
+							addObject(dependency);
+					}
+
+					SPtr<ct::CoreObject> objectCore = curObj->getCore();
+					if (objectCore == nullptr)
+					{
+						curObj->markCoreClean();
+						return;
+					}
+
+					syncData.entries.push_back(CoreStoredSyncObjData(objectCore, id, CoreSyncData(), nullptr));
+					syncObjects.push_back(curObj);
+				};
+
+				CoreObject* object = objectData.object;
+				if (object != nullptr)
+					addObject(object);
+				else
 				{
-					const Vector<CoreObject*>& dependencies = iterFind->second;
-					for (auto& dependency : dependencies)
-						syncObject(dependency);
+					// Object was destroyed but we still need to sync its modifications before it was destroyed
+					if (objectData.syncDataId != -1)
+					{
+						syncData.entries.push_back(mDestroyedSyncData[objectData.syncDataId]);
+						syncObjects.push_back(nullptr);
+					}
 				}
+			}
+
+			// Split the objects into chunks large enough to be worth distributing to workers. Each chunk gets its own
+			// allocator as frame allocators cannot be allocated from concurrently.
+			const UINT32 numObjects = (UINT32)syncObjects.size();
+
+			UINT32 numChunks = 1;
+			if (TaskScheduler::isStarted())
+			{
+				numChunks = std::min(TaskScheduler::instance().getNumWorkers() + 1, 
+					numObjects / MIN_OBJECTS_PER_SYNC_CHUNK);
+				numChunks = std::max(numChunks, 1U);
+			}
+
+			const UINT32 grainSize = std::max((numObjects + numChunks - 1) / numChunks, 1U);
+			numChunks = (numObjects + grainSize - 1) / grainSize;
 
-				SPtr<ct::CoreObject> objectCore = curObj->getCore();
-				if (objectCore == nullptr)
+			for (UINT32 i = 1; i < numChunks; i++)
+			{
+				FrameAlloc* workerAlloc;
+				if (!mFreeWorkerAllocs.empty())
 				{
-					curObj->markCoreClean();
-					return;
+					workerAlloc = mFreeWorkerAllocs.back();
+					mFreeWorkerAllocs.pop_back();
 				}
+				else
+					workerAlloc = bs_new<FrameAlloc>();
 
-				CoreSyncData objSyncData = curObj->syncToCore(allocator);
-				curObj->markCoreClean();
+				syncData.workerAllocs.push_back(workerAlloc);
+			}
+
+			const auto packObjects = [&](UINT32 start, UINT32 end)
+			{
+				const UINT32 chunkIdx = start / grainSize;
+				FrameAlloc* chunkAlloc = chunkIdx == 0 ? allocator : syncData.workerAllocs[chunkIdx - 1];
 
-				syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
-					curObj->getInternalID(), objSyncData));
+				for (UINT32 i = start; i < end; i++)
+				{
+					CoreObject* object = syncObjects[i];
+					if (object == nullptr)
+						continue;
+
+					CoreStoredSyncObjData& entry = syncData.entries[i];
+					entry.syncData = object->syncToCore(chunkAlloc);
+					entry.alloc = chunkAlloc;
+
+					object->markCoreClean();
+				}
 			};
 
-			CoreObject* object = objectData.second.object;
-			if (object != nullptr)
-				syncObject(object);
+			// Note: Not helping with other tasks while waiting, as they could end up trying to acquire the objects mutex
+			if (numChunks > 1)
+				TaskScheduler::instance().parallelFor(numObjects, grainSize, packObjects, false);
 			else
-			{
-				// Object was destroyed but we still need to sync its modifications before it was destroyed
-				if (objectData.second.syncDataId != -1)
-					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
-			}
+				packObjects(0, numObjects);
 		}
+		bs_frame_clear();
 
 		mDirtyObjects.clear();
+		mDirtyObjectLookup.clear();
 		mDestroyedSyncData.clear();
+
+		return true;
 	}
 
 	void CoreObjectManager::syncUpload()
@@ -406,10 +530,18 @@ namespace bs
 			UINT8* data = objSyncData.syncData.getBuffer();
 
 			if (data != nullptr)
-				syncData.alloc->free(data);
+				objSyncData.alloc->free(data);
 		}
 
 		syncData.entries.clear();
+
+		// All data from worker allocators has been consumed, they can be reused for the next sync
+		for (auto& workerAlloc : syncData.workerAllocs)
+		{
+			workerAlloc->clear();
+			mFreeWorkerAllocs.push_back(workerAlloc);
+		}
+
 		mCoreSyncData.pop_front();
 	}
 }
\ No newline at end of file
@@ -23,6 +23,9 @@ namespace bs
 	 */
 	class BS_CORE_EXPORT CoreObjectManager : public Module<CoreObjectManager>
 	{
+		/** Minimum number of objects to pack on a single worker thread during sync. */
+		static constexpr UINT32 MIN_OBJECTS_PER_SYNC_CHUNK = 256;
+
 		/**
 		 * Stores dirty data that is to be transferred from sim  thread to core thread part of a CoreObject, for a single 
 		 * object.
@@ -30,31 +33,41 @@ namespace bs
 		struct CoreStoredSyncObjData
 		{
 			CoreStoredSyncObjData()
-				:internalId(0)
+				:internalId(0), alloc(nullptr)
 			{ }
 
-			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData)
-				:destinationObj(destObj), syncData(syncData), internalId(internalId)
+			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData,
+				FrameAlloc* alloc)
+				:destinationObj(destObj), syncData(syncData), internalId(internalId), alloc(alloc)
 			{ }
 
 			SPtr<ct::CoreObject> destinationObj;
 			CoreSyncData syncData;
 			UINT64 internalId;
+			FrameAlloc* alloc; /**< Allocator the sync data buffer was allocated with. */
 		};
 
 		/**
 		 * Stores dirty data that is to be transferred from sim thread to core thread part of a CoreObject, for all dirty
-		 * objects in one frame.
+		 * objects in one frame. Entries are stored contiguously in memory allocated from the frame allocator.
 		 */
 		struct CoreStoredSyncData
 		{
-			FrameAlloc* alloc = nullptr;
-			Vector<CoreStoredSyncObjData> entries;
+			CoreStoredSyncData(FrameAlloc* alloc)
+				:alloc(alloc), entries(StdFrameAlloc<CoreStoredSyncObjData>(alloc))
+			{ }
+
+			FrameAlloc* alloc;
+			std::vector<CoreStoredSyncObjData, StdFrameAlloc<CoreStoredSyncObjData>> entries;
+
+			/** Additional allocators used for packing data on worker threads. Released once the data is uploaded. */
+			Vector<FrameAlloc*> workerAllocs;
 		};
 
 		/** Contains information about a dirty CoreObject that requires syncing to the core thread. */	
 		struct DirtyObjectData
 		{
+			UINT64 internalId;
 			CoreObject* object;
 			INT32 syncDataId;
 		};
@@ -81,6 +94,9 @@ namespace bs
 		/**
 		 * Synchronizes all dirty CoreObjects with the core thread. Their dirty data will be allocated using the global 
 		 * frame allocator and then queued for update using the core thread queue for the calling thread.
+		 * 
+		 * When there are many dirty objects their data is packed in parallel on the task scheduler's worker threads.
+		 * CoreObject::syncToCore() implementations must therefore only access the state of the object being synced.
 		 *
 		 * @note	Sim thread only.
 		 * @note	This is an @ref asyncMethod "asynchronous method".
@@ -102,11 +118,12 @@ namespace bs
 		 * meta-data is stored internally to be used by call to syncUpload().
 		 *
 		 * @param[in]	allocator Allocator to use for allocating memory for stored data.
+		 * @return				True if any objects were dirty, in which case the call must be followed by syncUpload().
 		 *
 		 * @note	Sim thread only.
 		 * @note	Must be followed by a call to syncUpload() with the same type.
 		 */
-		void syncDownload(FrameAlloc* allocator);
+		bool syncDownload(FrameAlloc* allocator);
 
 		/**
 		 * Copies all the data stored by previous call to syncDownload() into core thread versions of CoreObjects.
@@ -124,14 +141,30 @@ namespace bs
 		 */
 		void updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies);
 
+		/** 
+		 * Returns the dirty list entry for the object with the specified ID, adding a new entry if the object isn't 
+		 * already in the list. Caller must hold the objects mutex.
+		 */
+		DirtyObjectData& getDirtyEntry(UINT64 internalId);
+
+		/** Removes the object with the specified ID from the dirty list, if present. Caller must hold the objects mutex. */
+		void removeDirtyEntry(UINT64 internalId);
+
 		UINT64 mNextAvailableID;
-		Map<UINT64, CoreObject*> mObjects;
-		Map<UINT64, DirtyObjectData> mDirtyObjects;
-		Map<UINT64, Vector<CoreObject*>> mDependencies;
-		Map<UINT64, Vector<CoreObject*>> mDependants;
+		UnorderedMap<UINT64, CoreObject*> mObjects;
+		UnorderedMap<UINT64, Vector<CoreObject*>> mDependencies;
+		UnorderedMap<UINT64, Vector<CoreObject*>> mDependants;
+
+		/** 
+		 * Objects that were modified since the last sync, in no particular order. Kept separate from the list of all 
+		 * objects so the cost of a sync is proportional to the number of modified objects.
+		 */
+		Vector<DirtyObjectData> mDirtyObjects;
+		UnorderedMap<UINT64, UINT32> mDirtyObjectLookup; /**< Maps object IDs to their index in mDirtyObjects. */
 
 		Vector<CoreStoredSyncObjData> mDestroyedSyncData;
 		List<CoreStoredSyncData> mCoreSyncData;
+		Vector<FrameAlloc*> mFreeWorkerAllocs;
 
 		Mutex mObjectsMutex;
 	};
@@ -4,6 +4,8 @@
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
 #include "BsCoreApplication.h"
+#include "Debug/BsDebug.h"
+#include "Allocators/BsFrameArena.h"
 
 using namespace std::placeholders;
 
@@ -16,7 +18,6 @@ namespace bs
 		: mActiveFrameAlloc(0)
 		, mCoreThreadShutdown(false)
 		, mCoreThreadStarted(false)
-		, mCommandQueue(nullptr)
 		, mMaxCommandNotifyId(0)
 	{
 		for (UINT32 i = 0; i < NUM_SYNC_BUFFERS; i++)
@@ -27,7 +28,7 @@ namespace bs
 
 		mSimThreadId = BS_THREAD_CURRENT_ID;
 		mCoreThreadId = mSimThreadId; // For now
-		mCommandQueue = bs_new<CommandQueue<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
+		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
 
 		initCoreThread();
 	}
@@ -37,19 +38,13 @@ namespace bs
 		// TODO - What if something gets queued between the queued call to destroy_internal and this!?
 		shutdownCoreThread();
 
+		ThreadQueueContainer* queue = mAllQueues.exchange(nullptr);
+		while(queue != nullptr)
 		{
-			Lock lock(mCoreQueueMutex);
+			ThreadQueueContainer* next = queue->next;
+			bs_delete(queue);
 
-			for(auto& queue : mAllQueues)
-				bs_delete(queue);
-
-			mAllQueues.clear();
-		}
-
-		if(mCommandQueue != nullptr)
-		{
-			bs_delete(mCommandQueue);
-			mCommandQueue = nullptr;
+			queue = next;
 		}
 
 		for (UINT32 i = 0; i < NUM_SYNC_BUFFERS; i++)
@@ -93,14 +88,19 @@ namespace bs
 		while(true)
 		{
 			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
 			{
-				Lock lock(mCommandQueueMutex);
+				ProfiledLock lock(mCommandQueueMutex);
 
-				while(mCommandQueue->isEmpty())
+				// Commands are queued without the lock. Producers check this flag after queuing, and we check the queues
+				// after setting it, so at least one of us is guaranteed to notice the other.
+				mCoreThreadWaiting.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				while(!hasInternalCommands())
 				{
 					if(mCoreThreadShutdown)
 					{
+						mCoreThreadWaiting.store(false, std::memory_order_relaxed);
 						TaskScheduler::instance().addWorker();
 						return;
 					}
@@ -110,11 +110,11 @@ namespace bs
 					TaskScheduler::instance().removeWorker();
 				}
 
-				commands = mCommandQueue->flush();
+				mCoreThreadWaiting.store(false, std::memory_order_relaxed);
 			}
 
 			// Play commands
-			mCommandQueue->playbackWithNotify(commands, std::bind(&CoreThread::commandCompletedNotify, this, _1)); 
+			playbackInternalCommands();
 		}
 #endif
 	}
@@ -124,7 +124,7 @@ namespace bs
 #if !BS_FORCE_SINGLETHREADED_RENDERING
 
 		{
-			Lock lock(mCommandQueueMutex);
+			ProfiledLock lock(mCommandQueueMutex);
 			mCoreThreadShutdown = true;
 		}
 
@@ -137,40 +137,64 @@ namespace bs
 #endif
 	}
 
-	SPtr<TCoreThreadQueue<CommandQueueNoSync>> CoreThread::getQueue()
+	CoreThread::ThreadQueueContainer* CoreThread::getQueue()
 	{
 		if(mPerThreadQueue.current == nullptr)
 		{
-			SPtr<TCoreThreadQueue<CommandQueueNoSync>> newQueue = bs_shared_ptr_new<TCoreThreadQueue<CommandQueueNoSync>>(BS_THREAD_CURRENT_ID);
-			mPerThreadQueue.current = bs_new<ThreadQueueContainer>();
-			mPerThreadQueue.current->queue = newQueue;
-			mPerThreadQueue.current->isMain = BS_THREAD_CURRENT_ID == mSimThreadId;
+			ThreadQueueContainer* container = bs_new<ThreadQueueContainer>();
+			container->queue = bs_shared_ptr_new<TCoreThreadQueue<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
+			container->threadId = BS_THREAD_CURRENT_ID;
+			container->isMain = BS_THREAD_CURRENT_ID == mSimThreadId;
+
+			container->next = mAllQueues.load(std::memory_order_relaxed);
+			while(!mAllQueues.compare_exchange_weak(container->next, container, std::memory_order_release, 
+				std::memory_order_relaxed))
+			{ }
 
-			Lock lock(mCoreQueueMutex);
-			mAllQueues.push_back(mPerThreadQueue.current);
+			mPerThreadQueue.current = container;
 		}
 
-		return mPerThreadQueue.current->queue;
+		return mPerThreadQueue.current;
 	}
 
-	void CoreThread::submitAll(bool blockUntilComplete)
+	UINT64 CoreThread::getLastQueuedToken()
 	{
-		Vector<ThreadQueueContainer*> queueCopies;
+		return getQueue()->lastToken;
+	}
 
-		{
-			Lock lock(mCoreQueueMutex);
+	Vector<CoreThreadQueueStats> CoreThread::getQueueStats() const
+	{
+		Vector<CoreThreadQueueStats> output;
 
-			queueCopies = mAllQueues;
+		ThreadQueueContainer* queue = mAllQueues.load(std::memory_order_acquire);
+		while(queue != nullptr)
+		{
+			CoreThreadQueueStats stats;
+			stats.threadId = queue->threadId;
+			stats.isMain = queue->isMain;
+			stats.numQueued = queue->numQueued.load(std::memory_order_relaxed);
+			stats.numPlayed = queue->numPlayed.load(std::memory_order_relaxed);
+
+			output.push_back(stats);
+			queue = queue->next;
 		}
 
+		return output;
+	}
+
+	void CoreThread::submitAll(bool blockUntilComplete)
+	{
 		// Submit workers first
 		ThreadQueueContainer* mainQueue = nullptr;
-		for (auto& queue : queueCopies)
+		ThreadQueueContainer* queue = mAllQueues.load(std::memory_order_acquire);
+		while(queue != nullptr)
 		{
 			if (!queue->isMain)
 				queue->queue->submitToCoreThread(blockUntilComplete);
 			else
 				mainQueue = queue;
+
+			queue = queue->next;
 		}
 
 		// Then main
@@ -180,7 +204,42 @@ namespace bs
 
 	void CoreThread::submit(bool blockUntilComplete)
 	{
-		getQueue()->submitToCoreThread(blockUntilComplete);
+		getQueue()->queue->submitToCoreThread(blockUntilComplete);
+	}
+
+	template<class T>
+	void CoreThread::queueInternalCommand(T&& commandCallback, bool blockUntilComplete)
+	{
+#if BS_FORCE_SINGLETHREADED_RENDERING
+		commandCallback();
+#else
+		ThreadQueueContainer* container = getQueue();
+
+		// Tokens are taken before queuing, so if one command was queued before another was started, it will always have
+		// a lower token, regardless of which threads (and therefore queues) the two were queued from
+		const UINT64 token = mNextCommandToken.fetch_add(1, std::memory_order_relaxed);
+
+		UINT32 commandId = -1;
+		if (blockUntilComplete)
+		{
+			commandId = mMaxCommandNotifyId++;
+			container->internalQueue.queue([this, callback = std::forward<T>(commandCallback), commandId]() mutable
+			{
+				callback();
+				commandCompletedNotify(commandId);
+			}, token);
+		}
+		else
+			container->internalQueue.queue(std::forward<T>(commandCallback), token);
+
+		container->lastToken = token;
+		container->numQueued.fetch_add(1, std::memory_order_relaxed);
+
+		notifyCommandsReady();
+
+		if (blockUntilComplete)
+			blockUntilCommandCompleted(commandId);
+#endif
 	}
 
 	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags)
@@ -188,29 +247,21 @@ namespace bs
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
 
 		if (!flags.isSet(CTQF_InternalQueue))
-			return getQueue()->queueReturnCommand(commandCallback);
+			return getQueue()->queue->queueReturnCommand(commandCallback);
 		else
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
-
-			AsyncOp op;
-			UINT32 commandId = -1;
+			AsyncOp op(mAsyncOpSyncData);
+			queueInternalCommand([callback = std::move(commandCallback), op]() mutable
 			{
-				Lock lock(mCommandQueueMutex);
+				callback(op);
 
-				if (blockUntilComplete)
+				if (!op.hasCompleted())
 				{
-					commandId = mMaxCommandNotifyId++;
-					op = mCommandQueue->queueReturn(commandCallback, true, commandId);
+					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+						"Make sure to complete the operation before returning from the command callback method.");
+					op._completeOperation(nullptr);
 				}
-				else
-					op = mCommandQueue->queueReturn(commandCallback);
-			}
-
-			mCommandReadyCondition.notify_all();
-
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
+			}, flags.isSet(CTQF_BlockUntilComplete));
 
 			return op;
 		}
@@ -221,28 +272,66 @@ namespace bs
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
 
 		if (!flags.isSet(CTQF_InternalQueue))
-			getQueue()->queueCommand(commandCallback);
+			getQueue()->queue->queueCommand(commandCallback);
 		else
+			queueInternalCommand(std::move(commandCallback), flags.isSet(CTQF_BlockUntilComplete));
+	}
+
+	bool CoreThread::hasInternalCommands()
+	{
+		ThreadQueueContainer* queue = mAllQueues.load(std::memory_order_acquire);
+		while (queue != nullptr)
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+			if (!queue->internalQueue.isEmpty())
+				return true;
 
-			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
+			queue = queue->next;
+		}
 
-				if (blockUntilComplete)
+		return false;
+	}
+
+	void CoreThread::playbackInternalCommands()
+	{
+		while (true)
+		{
+			// Find the command with the lowest token among all queues
+			ThreadQueueContainer* nextQueue = nullptr;
+			UINT64 nextToken = std::numeric_limits<UINT64>::max();
+
+			ThreadQueueContainer* queue = mAllQueues.load(std::memory_order_acquire);
+			while (queue != nullptr)
+			{
+				UINT64 token;
+				if (queue->internalQueue.peek(token) && token < nextToken)
 				{
-					commandId = mMaxCommandNotifyId++;
-					mCommandQueue->queue(commandCallback, true, commandId);
+					nextQueue = queue;
+					nextToken = token;
 				}
-				else
-					mCommandQueue->queue(commandCallback);
+
+				queue = queue->next;
 			}
 
-			mCommandReadyCondition.notify_all();
+			if (nextQueue == nullptr)
+				break;
+
+			nextQueue->internalQueue.executeNext();
+			nextQueue->numPlayed.fetch_add(1, std::memory_order_relaxed);
+
+			if (nextToken > mLastExecutedToken.load(std::memory_order_relaxed))
+				mLastExecutedToken.store(nextToken, std::memory_order_release);
+		}
+	}
+
+	void CoreThread::notifyCommandsReady()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
 
-			if (blockUntilComplete)
-				blockUntilCommandCompleted(commandId);
+		if (mCoreThreadWaiting.load(std::memory_order_relaxed))
+		{
+			// Lock ensures the core thread is either already waiting, or is yet to check the queues
+			ProfiledLock lock(mCommandQueueMutex);
+			mCommandReadyCondition.notify_all();
 		}
 	}
 
@@ -251,9 +340,12 @@ namespace bs
 		for (UINT32 i = 0; i < NUM_SYNC_BUFFERS; i++)
 			mFrameAllocs[i]->setOwnerThread(mCoreThreadId);
 
-		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % 2;
+		mActiveFrameAlloc = (mActiveFrameAlloc + 1) % NUM_SYNC_BUFFERS;
 		mFrameAllocs[mActiveFrameAlloc]->setOwnerThread(BS_THREAD_CURRENT_ID); // Sim thread
 		mFrameAllocs[mActiveFrameAlloc]->clear();
+
+		// Frame arena memory follows the same lifetime as the sync buffers
+		FrameArena::advanceFrame(NUM_SYNC_BUFFERS);
 	}
 
 	FrameAlloc* CoreThread::getFrameAlloc() const
@@ -264,7 +356,7 @@ namespace bs
 	void CoreThread::blockUntilCommandCompleted(UINT32 commandId)
 	{
 #if !BS_FORCE_SINGLETHREADED_RENDERING
-		Lock lock(mCommandNotifyMutex);
+		ProfiledLock lock(mCommandNotifyMutex);
 
 		while(true)
 		{
@@ -290,7 +382,7 @@ namespace bs
 	void CoreThread::commandCompletedNotify(UINT32 commandId)
 	{
 		{
-			Lock lock(mCommandNotifyMutex);
+			ProfiledLock lock(mCommandNotifyMutex);
 
 			mCommandsCompleted.push_back(commandId);
 		}
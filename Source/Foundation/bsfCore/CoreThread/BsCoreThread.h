@@ -6,7 +6,9 @@
 #include "Utility/BsModule.h"
 #include "CoreThread/BsCommandQueue.h"
 #include "CoreThread/BsCoreThreadQueue.h"
+#include "CoreThread/BsCommandRingBuffer.h"
 #include "Threading/BsThreadPool.h"
+#include "Threading/BsProfiledMutex.h"
 
 namespace bs
 {
@@ -39,6 +41,19 @@ namespace bs
 	typedef Flags<CoreThreadQueueFlag> CoreThreadQueueFlags;
 	BS_FLAGS_OPERATORS(CoreThreadQueueFlag)
 
+	/** Statistics about commands queued on the core thread from a single thread. */
+	struct CoreThreadQueueStats
+	{
+		ThreadId threadId; /**< Thread the commands were queued from. */
+		bool isMain = false; /**< True if the thread is the sim thread. */
+		/** 
+		 * Total number of commands queued on the thread's internal queue. Includes submitted batches of per-thread 
+		 * commands, each counted as a single command.
+		 */
+		UINT64 numQueued = 0;
+		UINT64 numPlayed = 0; /**< Total number of commands from the thread's internal queue executed by the core thread. */
+	};
+
 	/**
 	 * Manager for the core thread. Takes care of starting, running, queuing commands and shutting down the core thread.
 	 * 				
@@ -54,14 +69,34 @@ namespace bs
 	 *      which point they are made visible to the core thread, and will begin executing.
 	 * 	  - Commands can also be submitted directly to the internal command queue (via a special flag), but with a 
 	 * 	    performance cost due to extra synchronization required.
+	 *    - The internal command queue is split into a lock-free queue per thread, meaning threads never contend with
+	 *      each other when queuing. Each command receives an ordering token when queued, and the core thread executes
+	 *      commands from all queues in token order. This ensures that if a command was queued after a command on another
+	 *      thread finished queuing, it will also execute after it.
 	 */
 	class BS_CORE_EXPORT CoreThread : public Module<CoreThread>
 	{
 		/** Contains data about an queue for a specific thread. */
 		struct ThreadQueueContainer
 		{
-			SPtr<TCoreThreadQueue<CommandQueueNoSync>> queue;
+			/** 
+			 * Queue holding commands until submit() is called. Synchronized since submitAll() can submit the queue from 
+			 * another thread, but it's otherwise only accessed by its owner and the lock is uncontended.
+			 */
+			SPtr<TCoreThreadQueue<CommandQueueSync>> queue;
+
+			/** Internal queue commands submitted by the thread, read by the core thread. */
+			CommandRingBuffer internalQueue;
+
+			ThreadId threadId;
 			bool isMain;
+
+			UINT64 lastToken = 0;
+			std::atomic<UINT64> numQueued{0};
+			std::atomic<UINT64> numPlayed{0};
+
+			/** Next container in the list of all containers. Never changes once the container is registered. */
+			ThreadQueueContainer* next = nullptr;
 		};
 
 		/** Wrapper for the thread-local variable because MSVC can't deal with a thread-local variable marked with dllimport or dllexport,  
@@ -79,6 +114,24 @@ namespace bs
 		/** Returns the id of the core thread.  */
 		ThreadId getCoreThreadId() { return mCoreThreadId; }
 
+		/** 
+		 * Returns the ordering token of the last internal queue command queued from the calling thread (including 
+		 * commands queued by submit()). The core thread executes commands in token order, meaning any command queued
+		 * by another thread after it receives this token (e.g. from a task dependent on this thread's work) will execute
+		 * after all the commands preceding it.
+		 */
+		UINT64 getLastQueuedToken();
+
+		/** 
+		 * Returns the largest token of a command that has been executed on the core thread. Since commands that were
+		 * queued concurrently can execute out of token order, this doesn't guarantee commands with a lower token have
+		 * executed, unless it is known they were queued before the command with this token.
+		 */
+		UINT64 getLastExecutedToken() const { return mLastExecutedToken.load(std::memory_order_acquire); }
+
+		/** Returns statistics about the commands queued from every thread that has queued a command so far. */
+		Vector<CoreThreadQueueStats> getQueueStats() const;
+
 		/** Submits the commands from all queues and starts executing them on the core thread. */
 		void submitAll(bool blockUntilComplete = false);
 
@@ -124,9 +177,12 @@ namespace bs
 		 */
 		FrameAlloc* getFrameAlloc() const;
 
+		/** Maximum number of frames the sim thread is allowed to run ahead of the core thread. */
+		static const int MAX_FRAMES_IN_FLIGHT = 3;
+
 		/** 
-		 * Returns number of buffers needed to sync data between core and sim thread. Currently the sim thread can be one frame
-		 * ahead of the core thread, meaning we need two buffers. If this situation changes increase this number.
+		 * Returns number of buffers needed to sync data between core and sim thread. The sim thread can be up to
+		 * MAX_FRAMES_IN_FLIGHT frames ahead of the core thread, meaning we need one more buffer than that.
 		 *
 		 * For example:
 		 *  - Sim thread frame starts, it writes some data to buffer 0.
@@ -139,18 +195,20 @@ namespace bs
 		 *  - Core thread frame finishes.
 		 *  - New core thread frame starts, it reads some data from buffer 1.
 		 *  - ...
+		 *
+		 * Buffers are always cycled through in full, regardless of how many frames in flight the application actually
+		 * allows (see CoreApplication::setFramesInFlight()), so the number of frames in flight can change at any time.
 		 */
-		static const int NUM_SYNC_BUFFERS = 2;
+		static const int NUM_SYNC_BUFFERS = MAX_FRAMES_IN_FLIGHT + 1;
 	private:
-		/**
-		 * Double buffered frame allocators. Means sim thread cannot be more than 1 frame ahead of core thread (If that changes
-		 * you should be able to easily add more).
-		 */
+		/** Frame allocators, one per frame the core thread might still be reading from, plus one for the sim thread. */
 		FrameAlloc* mFrameAllocs[NUM_SYNC_BUFFERS];
 		UINT32 mActiveFrameAlloc;
 
 		static QueueData mPerThreadQueue;
-		Vector<ThreadQueueContainer*> mAllQueues;
+
+		/** Singly linked list of all per-thread queues. Containers are only ever added to the front. */
+		std::atomic<ThreadQueueContainer*> mAllQueues{nullptr};
 
 		volatile bool mCoreThreadShutdown;
 
@@ -158,17 +216,19 @@ namespace bs
 		bool mCoreThreadStarted;
 		ThreadId mSimThreadId;
 		ThreadId mCoreThreadId;
-		Mutex mCommandQueueMutex;
-		Mutex mCoreQueueMutex;
-		Signal mCommandReadyCondition;
-		Mutex mCommandNotifyMutex;
-		Signal mCommandCompleteCondition;
+		ProfiledMutex mCommandQueueMutex{"CoreThread queue"};
+		ProfiledSignal mCommandReadyCondition;
+		ProfiledMutex mCommandNotifyMutex{"CoreThread command completion"};
+		ProfiledSignal mCommandCompleteCondition;
 		Mutex mThreadStartedMutex;
 		Signal mCoreThreadStartedCondition;
 
-		CommandQueue<CommandQueueSync>* mCommandQueue;
+		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
+		std::atomic<UINT64> mNextCommandToken{1}; /**< Determines the execution order of internal queue commands. */
+		std::atomic<UINT64> mLastExecutedToken{0};
+		std::atomic<bool> mCoreThreadWaiting{false};
 
-		UINT32 mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
+		std::atomic<UINT32> mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
 		Vector<UINT32> mCommandsCompleted; /**< Completed commands that have notifier callbacks set up */
 
 		/** Starts the core thread worker method. Should only be called once. */
@@ -180,8 +240,25 @@ namespace bs
 		/** Shutdowns the core thread. It will complete all ready commands before shutdown. */
 		void shutdownCoreThread();
 
-		/** Creates or retrieves a queue for the calling thread. */
-		SPtr<TCoreThreadQueue<CommandQueueNoSync>> getQueue();
+		/** 
+		 * Queues a command on the internal command queue, making it immediately visible to the core thread. If 
+		 * @p blockUntilComplete is true the method waits until the command executes. The callable is moved directly
+		 * into the queue's storage, without any type erasure or allocations.
+		 */
+		template<class T>
+		void queueInternalCommand(T&& commandCallback, bool blockUntilComplete);
+
+		/** Checks are there any commands in the internal command queues. Core thread only. */
+		bool hasInternalCommands();
+
+		/** Executes all commands from the internal command queues. Core thread only. */
+		void playbackInternalCommands();
+
+		/** Wakes up the core thread if it's waiting for commands. */
+		void notifyCommandsReady();
+
+		/** Creates or retrieves queues for the calling thread. */
+		ThreadQueueContainer* getQueue();
 
 		/**
 		 * Blocks the calling thread until the command with the specified ID completes. Make sure that the specified ID 
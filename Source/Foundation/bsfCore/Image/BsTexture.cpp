@@ -9,6 +9,8 @@
 #include "Threading/BsAsyncOp.h"
 #include "Resources/BsResources.h"
 #include "Image/BsPixelUtil.h"
+#include "Managers/BsTextureStreamingManager.h"
+#include "RenderAPI/BsCommandBuffer.h"
 
 namespace bs 
 {
@@ -99,12 +101,39 @@ namespace bs
 		}
 
 		Resource::initialize();
+
+		if (mStreamingData != nullptr)
+			TextureStreamingManager::instance()._registerTexture(this);
+	}
+
+	void Texture::destroy()
+	{
+		if (mStreamingData != nullptr && TextureStreamingManager::isStarted())
+			TextureStreamingManager::instance()._unregisterTexture(this);
+
+		Resource::destroy();
 	}
 
 	SPtr<ct::CoreObject> Texture::createCore() const
 	{
 		const TextureProperties& props = getProperties();
 
+		if (mStreamingData != nullptr)
+		{
+			// Core texture only contains the resident mip levels
+			const UINT32 residentMip = mStreamingData->residentMip;
+
+			TEXTURE_DESC desc = props.mDesc;
+			PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), props.getDepth(), residentMip,
+				desc.width, desc.height, desc.depth);
+			desc.numMips = props.getNumMipmaps() - residentMip;
+
+			SPtr<ct::Texture> coreObj = ct::TextureManager::instance().createTextureInternal(desc, nullptr);
+			coreObj->mStreamingData = mStreamingData;
+
+			return coreObj;
+		}
+
 		SPtr<ct::CoreObject> coreObj = ct::TextureManager::instance().createTextureInternal(props.mDesc, mInitData);
 
 		if ((mProperties.getUsage() & TU_CPUCACHED) == 0)
@@ -113,6 +142,67 @@ namespace bs
 		return coreObj;
 	}
 
+	void Texture::_setResidentMip(UINT32 mip, const Vector<SPtr<PixelData>>& surfaces)
+	{
+		const UINT32 oldMip = mStreamingData->residentMip;
+		if (mip == oldMip)
+			return;
+
+		const UINT32 numFaces = mProperties.getNumFaces();
+		const UINT32 numMips = mProperties.getNumMipmaps() + 1;
+		const UINT32 numNewMips = mip < oldMip ? oldMip - mip : 0;
+
+		if ((UINT32)surfaces.size() != numFaces * numNewMips)
+		{
+			LOGERR("Data for the new resident mip levels doesn't match the number of mip levels being made resident.");
+			return;
+		}
+
+		SPtr<ct::Texture> oldCore = getCore();
+
+		mStreamingData->residentMip = mip;
+		SPtr<ct::Texture> newCore = std::static_pointer_cast<ct::Texture>(createCore());
+		mCoreSpecific = newCore;
+
+		for (auto& entry : surfaces)
+			entry->_lock();
+
+		const auto swapCore = [numFaces, numMips, numNewMips, oldMip, mip](const SPtr<ct::Texture>& newCore,
+			const SPtr<ct::Texture>& oldCore, const Vector<SPtr<PixelData>>& surfaces)
+		{
+			newCore->initialize();
+
+			const UINT32 uploadQueueIdx = ct::CommandSyncMask::getGlobalQueueIdx(GQT_UPLOAD, 0);
+			for (UINT32 face = 0; face < numFaces; face++)
+			{
+				for (UINT32 i = 0; i < numNewMips; i++)
+				{
+					const SPtr<PixelData>& data = surfaces[face * numNewMips + i];
+
+					newCore->writeData(*data, i, face, false, uploadQueueIdx);
+					data->_unlock();
+				}
+
+				// Mip levels resident both before and after are copied on the GPU
+				for (UINT32 i = std::max(mip, oldMip); i < numMips; i++)
+				{
+					TEXTURE_COPY_DESC copyDesc;
+					copyDesc.srcFace = face;
+					copyDesc.srcMip = i - oldMip;
+					copyDesc.dstFace = face;
+					copyDesc.dstMip = i - mip;
+
+					oldCore->copy(newCore, copyDesc);
+				}
+			}
+		};
+
+		queueGpuCommand(newCore, std::bind(swapCore, newCore, oldCore, surfaces));
+
+		// Lets dependants (e.g. materials) know they need to reference the new core object
+		markCoreDirty();
+	}
+
 	AsyncOp Texture::writeData(const SPtr<PixelData>& data, UINT32 face, UINT32 mipLevel, bool discardEntireBuffer)
 	{
 		UINT32 subresourceIdx = mProperties.mapToSubresourceIdx(face, mipLevel);
@@ -333,7 +423,9 @@ namespace bs
 	{
 		if (mInitData != nullptr)
 		{
-			writeData(*mInitData, 0, 0, true);
+			// Initial data is uploaded on the upload queue (if the render API has one) so it can proceed in parallel
+			// with rendering. Render API transfers ownership of the texture when it first gets used on another queue.
+			writeData(*mInitData, 0, 0, true, CommandSyncMask::getGlobalQueueIdx(GQT_UPLOAD, 0));
 			mInitData->_unlock();
 			mInitData = nullptr;
 		}
@@ -408,13 +500,28 @@ namespace bs
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
-		if (target->mProperties.getTextureType() != mProperties.getTextureType())
+		// Cubemap faces are regular 2D surfaces, so copies between them and 2D textures are allowed
+		const TextureType srcType = mProperties.getTextureType();
+		const TextureType dstType = target->mProperties.getTextureType();
+		const bool srcIs2D = srcType == TEX_TYPE_2D || srcType == TEX_TYPE_CUBE_MAP;
+		const bool dstIs2D = dstType == TEX_TYPE_2D || dstType == TEX_TYPE_CUBE_MAP;
+
+		if (srcType != dstType && !(srcIs2D && dstIs2D))
 		{
 			LOGERR("Source and destination textures must be of same type.");
 			return;
 		}
 
-		if (mProperties.getFormat() != target->mProperties.getFormat()) // Note: It might be okay to use different formats of the same size
+		// Uncompressed data can be copied into a compressed texture as long as the size of a single texel matches the
+		// size of a compressed block. Each source texel then represents a single block of the destination.
+		const PixelFormat srcFormat = mProperties.getFormat();
+		const PixelFormat dstFormat = target->mProperties.getFormat();
+
+		bool formatsCompatible = srcFormat == dstFormat;
+		if (!formatsCompatible && PixelUtil::isCompressed(dstFormat) && !PixelUtil::isCompressed(srcFormat))
+			formatsCompatible = PixelUtil::getNumElemBytes(srcFormat) == PixelUtil::getMemorySize(4, 4, 1, dstFormat);
+
+		if (!formatsCompatible)
 		{
 			LOGERR("Source and destination texture formats must match.");
 			return;
@@ -255,6 +255,19 @@ namespace bs
 		/**	Retrieves a core implementation of a texture usable only from the core thread. */
 		SPtr<ct::Texture> getCore() const;
 
+		/**
+		 * Determines should the texture stream its mip levels. Streamed textures only keep their least detailed mip
+		 * levels resident when loaded, and load the more detailed ones as required by the renderer. Mip levels that are
+		 * no longer used are evicted when the memory budget of the TextureStreamingManager is exceeded.
+		 *
+		 * @note	Only takes effect once the texture is saved and loaded again. Ignored for textures using TU_CPUCACHED,
+		 *			TU_RENDERTARGET, TU_DEPTHSTENCIL or TU_LOADSTORE usage.
+		 */
+		void setStreaming(bool streaming) { mStreaming = streaming; }
+
+		/** @copydoc setStreaming */
+		bool getStreaming() const { return mStreaming; }
+
 		/************************************************************************/
 		/* 								STATICS		                     		*/
 		/************************************************************************/
@@ -287,6 +300,20 @@ namespace bs
 		static SPtr<Texture> _createPtr(const SPtr<PixelData>& pixelData, int usage = TU_DEFAULT, 
 			bool hwGammaCorrection = false);
 
+		/** Returns information about the streamed mip levels of the texture, or null if the texture isn't streamed. */
+		const SPtr<TextureStreamingData>& _getStreamingData() const { return mStreamingData; }
+
+		/**
+		 * Changes which mip levels of a streamed texture are resident on the GPU. Creates a new core texture containing
+		 * only the resident mip levels, copies over the mip levels that remain resident and writes the newly loaded ones.
+		 *
+		 * @param[in]	mip			Most detailed mip level that should be resident.
+		 * @param[in]	surfaces	Data for the mip levels becoming resident, if @p mip is more detailed than the current
+		 *							most detailed resident mip level. For each face contains the new mip levels in order,
+		 *							starting with @p mip.
+		 */
+		void _setResidentMip(UINT32 mip, const Vector<SPtr<PixelData>>& surfaces);
+
 		/** @} */
 
 	protected:
@@ -298,6 +325,9 @@ namespace bs
 		/** @copydoc Resource::initialize */
 		void initialize() override;
 
+		/** @copydoc CoreObject::destroy */
+		void destroy() override;
+
 		/** @copydoc CoreObject::createCore */
 		SPtr<ct::CoreObject> createCore() const override;
 
@@ -318,6 +348,8 @@ namespace bs
 		Vector<SPtr<PixelData>> mCPUSubresourceData;
 		TextureProperties mProperties;
 		mutable SPtr<PixelData> mInitData;
+		bool mStreaming = false;
+		SPtr<TextureStreamingData> mStreamingData;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -431,6 +463,12 @@ namespace bs
 		/**	Returns properties that contain information about the texture. */
 		const TextureProperties& getProperties() const { return mProperties; }
 
+		/**
+		 * Returns information about the streamed mip levels of the texture, or null if the texture isn't streamed. Note
+		 * that properties of a streamed texture only describe the mip levels currently resident.
+		 */
+		const SPtr<TextureStreamingData>& getStreamingData() const { return mStreamingData; }
+
 		/************************************************************************/
 		/* 								STATICS		                     		*/
 		/************************************************************************/
@@ -470,6 +508,8 @@ namespace bs
 		/** Returns a plain normal map texture with normal pointing up (in Y direction). */
 		static SPtr<Texture> NORMAL;
 	protected:
+		friend class bs::Texture;
+
 		/** @copydoc lock */
 		virtual PixelData lockImpl(GpuLockOptions options, UINT32 mipLevel = 0, UINT32 face = 0, UINT32 deviceIdx = 0,
 			UINT32 queueIdx = 0) = 0;
@@ -505,6 +545,7 @@ namespace bs
 		UnorderedMap<TEXTURE_VIEW_DESC, SPtr<TextureView>, TextureView::HashFunction, TextureView::EqualFunction> mTextureViews;
 		TextureProperties mProperties;
 		SPtr<PixelData> mInitData;
+		SPtr<TextureStreamingData> mStreamingData;
 	};
 
 	/** @} */
@@ -0,0 +1,111 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Image/BsTextureReadbackQueue.h"
+#include "Image/BsPixelUtil.h"
+#include "RenderAPI/BsEventQuery.h"
+
+namespace bs { namespace ct
+{
+	TextureReadbackQueue::TextureReadbackQueue(UINT32 numBuffers)
+		:mNumBuffers(std::max(numBuffers, 1U))
+	{ }
+
+	TextureReadbackQueue::~TextureReadbackQueue()
+	{
+		clear();
+	}
+
+	bool TextureReadbackQueue::queue(const SPtr<Texture>& texture, Callback callback, UINT32 mipLevel, UINT32 face,
+		UINT32 deviceIdx, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		const TextureProperties& props = texture->getProperties();
+		if (mipLevel > props.getNumMipmaps() || face >= props.getNumFaces())
+		{
+			LOGERR("Cannot queue texture readback, invalid mip level or face index.");
+			return false;
+		}
+
+		TEXTURE_DESC desc;
+		desc.type = props.getTextureType() == TEX_TYPE_CUBE_MAP ? TEX_TYPE_2D : props.getTextureType();
+		desc.format = props.getFormat();
+		desc.hwGamma = props.isHardwareGammaEnabled();
+		desc.usage = TU_CPUREADABLE;
+		PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), props.getDepth(), mipLevel,
+			desc.width, desc.height, desc.depth);
+
+		StagingBuffer* buffer = acquireBuffer(desc);
+		if (buffer == nullptr)
+			return false;
+
+		TEXTURE_COPY_DESC copyDesc;
+		copyDesc.srcFace = face;
+		copyDesc.srcMip = mipLevel;
+
+		texture->copy(buffer->texture, copyDesc, commandBuffer);
+
+		buffer->callback = std::move(callback);
+		buffer->deviceIdx = deviceIdx;
+		buffer->inUse = true;
+
+		// The query is triggered once the GPU executes all the commands queued before it, including the copy
+		buffer->query = EventQuery::create(deviceIdx);
+		buffer->onTriggeredConn = buffer->query->onTriggered.connect(std::bind(&TextureReadbackQueue::onCopyComplete,
+			this, buffer));
+		buffer->query->begin(commandBuffer);
+
+		mNumPending++;
+		return true;
+	}
+
+	void TextureReadbackQueue::clear()
+	{
+		for (auto& entry : mBuffers)
+			entry->onTriggeredConn.disconnect();
+
+		mBuffers.clear();
+		mNumPending = 0;
+	}
+
+	void TextureReadbackQueue::onCopyComplete(StagingBuffer* buffer)
+	{
+		buffer->onTriggeredConn.disconnect();
+		buffer->query = nullptr;
+
+		const PixelData data = buffer->texture->lock(GBL_READ_ONLY, 0, 0, buffer->deviceIdx);
+		buffer->callback(data);
+		buffer->texture->unlock();
+
+		buffer->callback = nullptr;
+		buffer->inUse = false;
+		mNumPending--;
+	}
+
+	TextureReadbackQueue::StagingBuffer* TextureReadbackQueue::acquireBuffer(const TEXTURE_DESC& desc)
+	{
+		UINT32 numCompatible = 0;
+		for (auto& entry : mBuffers)
+		{
+			const TextureProperties& props = entry->texture->getProperties();
+			if (props.getTextureType() != desc.type || props.getFormat() != desc.format ||
+				props.getWidth() != desc.width || props.getHeight() != desc.height || props.getDepth() != desc.depth ||
+				props.isHardwareGammaEnabled() != desc.hwGamma)
+			{
+				continue;
+			}
+
+			if (!entry->inUse)
+				return entry.get();
+
+			numCompatible++;
+		}
+
+		if (numCompatible >= mNumBuffers)
+			return nullptr;
+
+		SPtr<StagingBuffer> buffer = bs_shared_ptr_new<StagingBuffer>();
+		buffer->texture = Texture::create(desc);
+
+		mBuffers.push_back(buffer);
+		return buffer.get();
+	}
+}}
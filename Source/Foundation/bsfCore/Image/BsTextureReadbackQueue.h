@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsTexture.h"
+#include "Utility/BsEvent.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Reads texture contents back to the CPU without stalling the GPU. Each request copies a surface of the texture
+	 * into a CPU readable staging texture and reports the contents once the GPU has finished the copy, normally a few
+	 * frames later. Staging textures are kept in a ring per surface format and size, and are reused once their contents
+	 * have been reported, so continuous readbacks (e.g. of a render target every frame) don't allocate.
+	 *
+	 * @note	Core thread only.
+	 */
+	class BS_CORE_EXPORT TextureReadbackQueue
+	{
+	public:
+		/**
+		 * Callback triggered with the surface contents once they are available. The pixel data is only valid for the
+		 * duration of the callback, and must be copied if required for longer.
+		 */
+		typedef std::function<void(const PixelData&)> Callback;
+
+		/**
+		 * Constructs a new queue.
+		 *
+		 * @param[in]	numBuffers	Maximum number of staging textures to create for surfaces of the same format and
+		 *							size. This is the maximum number of readbacks of such surfaces that can be in flight
+		 *							at once.
+		 */
+		TextureReadbackQueue(UINT32 numBuffers = 3);
+		~TextureReadbackQueue();
+
+		/**
+		 * Queues a read of a single surface of a texture.
+		 *
+		 * @param[in]	texture			Texture to read from. Multisampled textures are resolved before reading.
+		 * @param[in]	callback		Callback to trigger once the contents have been read.
+		 * @param[in]	mipLevel		Mip level to read.
+		 * @param[in]	face			Face (array index or cubemap face) to read.
+		 * @param[in]	deviceIdx		Index of the device whose memory to read from.
+		 * @param[in]	commandBuffer	Command buffer to queue the copy on. If null, main command buffer is used.
+		 * @return						False if all the staging textures for the surface's format and size are in use,
+		 *								in which case the read is not queued and should be retried later.
+		 */
+		bool queue(const SPtr<Texture>& texture, Callback callback, UINT32 mipLevel = 0, UINT32 face = 0,
+			UINT32 deviceIdx = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr);
+
+		/** Cancels all pending reads without triggering their callbacks, and releases all staging textures. */
+		void clear();
+
+		/** Returns the number of reads that have been queued, but whose callbacks haven't been triggered yet. */
+		UINT32 getNumPending() const { return mNumPending; }
+
+	private:
+		/** Texture the surface contents are copied to, before being read on the CPU. */
+		struct StagingBuffer
+		{
+			SPtr<Texture> texture;
+			SPtr<EventQuery> query;
+			HEvent onTriggeredConn;
+			Callback callback;
+			UINT32 deviceIdx = 0;
+			bool inUse = false;
+		};
+
+		/** Reads the contents of a staging texture whose copy has completed, and makes it available for reuse. */
+		void onCopyComplete(StagingBuffer* buffer);
+
+		/** Returns a staging texture compatible with the provided description, or null if all are in use. */
+		StagingBuffer* acquireBuffer(const TEXTURE_DESC& desc);
+
+		UINT32 mNumBuffers;
+		UINT32 mNumPending = 0;
+		Vector<SPtr<StagingBuffer>> mBuffers;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,143 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Importer/BsImportCache.h"
+#include "Importer/BsImportOptions.h"
+#include "Private/RTTI/BsImportCacheRTTI.h"
+#include "Resources/BsResource.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Utility/BsUtility.h"
+#include "Utility/BsUUID.h"
+
+namespace bs
+{
+	ImportCache::ImportCache(const Path& directory)
+		:mDirectory(directory)
+	{
+		if (!FileSystem::exists(mDirectory))
+			FileSystem::createDir(mDirectory);
+	}
+
+	String ImportCache::getKey(const SpecificImporter& importer, const Path& filePath,
+		const SPtr<const ImportOptions>& importOptions, bool importAll) const
+	{
+		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
+		if (stream == nullptr)
+			return StringUtil::BLANK;
+
+		const String sourceHash = md5(*stream);
+		stream->close();
+
+		String optionsHash;
+		if (importOptions != nullptr)
+		{
+			MemorySerializer ms;
+			UINT64 numBytes = 0;
+			UINT8* bytes = ms.encode(const_cast<ImportOptions*>(importOptions.get()), numBytes);
+
+			optionsHash = md5(String((const char*)bytes, (size_t)numBytes));
+			bs_free(bytes);
+		}
+
+		// Extension is included since it determines which importer is used, and how the importer parses the source
+		const String key = sourceHash + optionsHash + filePath.getExtension() + "_" + toString(VERSION) + "_" +
+			toString(importer.getVersion()) + (importAll ? "_all" : "");
+
+		return md5(key);
+	}
+
+	bool ImportCache::load(const String& key, Vector<SubResourceRaw>& output) const
+	{
+		const Path entryPath = getEntryPath(key);
+		if (!FileSystem::isFile(entryPath))
+			return false;
+
+		CoreSerializationContext serzContext;
+		serzContext.flags = SF_KeepResourceSourceData;
+
+		FileDecoder fs(entryPath);
+		SPtr<IReflectable> object = fs.decode(&serzContext);
+		if (object == nullptr || !object->isDerivedFrom(ImportCacheEntry::getRTTIStatic()))
+		{
+			LOGWRN("Ignoring a corrupt import cache entry: \"" + entryPath.toString() + "\".");
+			return false;
+		}
+
+		output = std::static_pointer_cast<ImportCacheEntry>(object)->getResources();
+		return !output.empty();
+	}
+
+	void ImportCache::save(const String& key, const Vector<SubResourceRaw>& resources) const
+	{
+		if (resources.empty())
+			return;
+
+		for (auto& entry : resources)
+		{
+			if (entry.value == nullptr)
+				return;
+		}
+
+		// Write to a temporary file first, so other threads never see a partially written entry
+		Path tempPath = mDirectory;
+		tempPath.append(UUIDGenerator::generateRandom().toString() + ".tmp");
+
+		{
+			ImportCacheEntry cacheEntry(resources);
+
+			FileEncoder fs(tempPath);
+			fs.encode(&cacheEntry);
+		}
+
+		FileSystem::move(tempPath, getEntryPath(key), true);
+	}
+
+	Path ImportCache::getEntryPath(const String& key) const
+	{
+		Path path = mDirectory;
+		path.append(key + ".asset");
+
+		return path;
+	}
+
+	ImportCacheEntry::ImportCacheEntry(const Vector<SubResourceRaw>& resources)
+	{
+		mNames.reserve(resources.size());
+		mResources.reserve(resources.size());
+
+		for (auto& entry : resources)
+		{
+			mNames.push_back(entry.name);
+			mResources.push_back(entry.value);
+		}
+	}
+
+	Vector<SubResourceRaw> ImportCacheEntry::getResources() const
+	{
+		Vector<SubResourceRaw> output;
+		if (mNames.size() != mResources.size())
+			return output;
+
+		for (UINT32 i = 0; i < (UINT32)mResources.size(); i++)
+		{
+			if (mResources[i] == nullptr)
+				return Vector<SubResourceRaw>();
+
+			output.push_back({ mNames[i], mResources[i] });
+		}
+
+		return output;
+	}
+
+	RTTITypeBase* ImportCacheEntry::getRTTIStatic()
+	{
+		return ImportCacheEntryRTTI::instance();
+	}
+
+	RTTITypeBase* ImportCacheEntry::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+}
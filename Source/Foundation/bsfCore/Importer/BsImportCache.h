@@ -0,0 +1,88 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Importer/BsSpecificImporter.h"
+#include "Reflection/BsIReflectable.h"
+
+namespace bs
+{
+	/** @addtogroup Importer-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Stores results of previous imports on disk, allowing an unchanged file to be loaded from the cache instead of being
+	 * imported again. Entries are keyed by the contents of the source file, the import options and the version of the
+	 * importer, so a cached entry is never used for a source that changed since.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ImportCache
+	{
+	public:
+		/** Version of the cache entry format. Entries using a different version are never matched. */
+		static constexpr UINT32 VERSION = 1;
+
+		/** @param[in]	directory	Folder to store the cache entries in. Created if it doesn't exist. */
+		ImportCache(const Path& directory);
+
+		/** Returns the folder the cache entries are stored in. */
+		const Path& getDirectory() const { return mDirectory; }
+
+		/**
+		 * Generates a key that uniquely identifies the results of importing the specified file. Returns an empty string
+		 * if the file cannot be read.
+		 *
+		 * @param[in]	importer		Importer that will be used for importing the file.
+		 * @param[in]	filePath		Path to the file being imported.
+		 * @param[in]	importOptions	Options the file is being imported with.
+		 * @param[in]	importAll		True if all resources in the file are being imported, or false if only the primary
+		 *								resource is.
+		 * @return						Key to provide to load() and save().
+		 */
+		String getKey(const SpecificImporter& importer, const Path& filePath,
+			const SPtr<const ImportOptions>& importOptions, bool importAll) const;
+
+		/**
+		 * Loads the resources of a cached import with the specified key. Returns false if there is no such entry, or if it
+		 * couldn't be read.
+		 */
+		bool load(const String& key, Vector<SubResourceRaw>& output) const;
+
+		/** Saves the resources resulting from an import under the specified key, replacing any existing entry. */
+		void save(const String& key, const Vector<SubResourceRaw>& resources) const;
+
+	private:
+		/** Returns the path to the file the entry with the specified key is stored in. */
+		Path getEntryPath(const String& key) const;
+
+		Path mDirectory;
+	};
+
+	/** Contents of a single import cache entry, as stored on disk. */
+	class BS_CORE_EXPORT ImportCacheEntry : public IReflectable
+	{
+	public:
+		ImportCacheEntry() = default;
+		ImportCacheEntry(const Vector<SubResourceRaw>& resources);
+
+		/** Returns the cached resources. */
+		Vector<SubResourceRaw> getResources() const;
+
+	private:
+		Vector<String> mNames;
+		Vector<SPtr<Resource>> mResources;
+
+	/************************************************************************/
+	/* 								SERIALIZATION                      		*/
+	/************************************************************************/
+	public:
+		friend class ImportCacheEntryRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** @} */
+}
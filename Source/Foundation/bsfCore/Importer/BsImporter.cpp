@@ -6,6 +6,7 @@
 #include "Importer/BsSpecificImporter.h"
 #include "Importer/BsShaderIncludeImporter.h"
 #include "Importer/BsImportOptions.h"
+#include "Importer/BsImportCache.h"
 #include "Debug/BsDebug.h"
 #include "FileSystem/BsDataStream.h"
 #include "Error/BsException.h"
@@ -16,6 +17,9 @@
 
 namespace bs
 {
+	/** Async operation of the import currently executing on this thread, if any. */
+	static BS_THREADLOCAL AsyncOp* sActiveOperation = nullptr;
+
 	Importer::Importer()
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
@@ -118,7 +122,7 @@ namespace bs
 			return nullptr;
 
 		const UINT64 taskId = waitForAsync(importer);
-		SPtr<Resource> output = importer->import(inputFilePath, importOptions);
+		SPtr<Resource> output = importWithCache(importer, inputFilePath, importOptions);
 		
 		if(importer->getAsyncMode() == ImporterAsyncMode::Single)
 		{
@@ -143,7 +147,7 @@ namespace bs
 			return Vector<SubResourceRaw>();
 
 		const UINT64 taskId = waitForAsync(importer);
-		Vector<SubResourceRaw> output = importer->importAll(inputFilePath, importOptions);
+		Vector<SubResourceRaw> output = importAllWithCache(importer, inputFilePath, importOptions);
 
 		if(importer->getAsyncMode() == ImporterAsyncMode::Single)
 		{
@@ -214,6 +218,14 @@ namespace bs
 		return taskId;
 	}
 
+	AsyncOp Importer::_getActiveOperation()
+	{
+		if (sActiveOperation == nullptr)
+			return AsyncOp(AsyncOpEmpty());
+
+		return *sActiveOperation;
+	}
+
 	void Importer::queueForImport(SpecificImporter* importer, const Path& inputFilePath, 
 		SPtr<const ImportOptions> importOptions, bool importAll, const UUID& uuid, bool handle, AsyncOp& op)
 	{
@@ -238,9 +250,11 @@ namespace bs
 		[this, taskId, queuedOp] 
 		{ 
 			AsyncOp op = queuedOp.op;
+			sActiveOperation = &op;
+
 			if (queuedOp.importAll)
 			{
-				Vector<SubResourceRaw> rawSubresources = queuedOp.importer->importAll(queuedOp.filePath,
+				Vector<SubResourceRaw> rawSubresources = importAllWithCache(queuedOp.importer, queuedOp.filePath,
 					queuedOp.importOptions);
 
 				if(queuedOp.handle)
@@ -259,7 +273,8 @@ namespace bs
 			}
 			else
 			{
-				SPtr<Resource> resourcePtr = queuedOp.importer->import(queuedOp.filePath, queuedOp.importOptions);
+				SPtr<Resource> resourcePtr = importWithCache(queuedOp.importer, queuedOp.filePath, 
+					queuedOp.importOptions);
 
 				if(queuedOp.handle)
 				{
@@ -275,6 +290,8 @@ namespace bs
 					op._completeOperation(resourcePtr);
 			}
 
+			sActiveOperation = nullptr;
+
 			// Clear itself from the task list so we don't unnecessarily keep a reference. But first make sure we are the
 			// last task by comparing the ids.
 			Lock lock(mLastTaskMutex);
@@ -298,6 +315,75 @@ namespace bs
 		TaskScheduler::instance().addTask(task);
 	}
 
+	SPtr<Resource> Importer::importWithCache(SpecificImporter* importer, const Path& filePath, 
+		const SPtr<const ImportOptions>& importOptions)
+	{
+		SPtr<ImportCache> cache = getCache(importer);
+		if (cache == nullptr)
+			return importer->import(filePath, importOptions);
+
+		const String key = cache->getKey(*importer, filePath, importOptions, false);
+
+		Vector<SubResourceRaw> cached;
+		if (!key.empty() && cache->load(key, cached))
+			return cached[0].value;
+
+		SPtr<Resource> output = importer->import(filePath, importOptions);
+		if (output != nullptr && !key.empty())
+			cache->save(key, { { u8"primary", output } });
+
+		return output;
+	}
+
+	Vector<SubResourceRaw> Importer::importAllWithCache(SpecificImporter* importer, const Path& filePath, 
+		const SPtr<const ImportOptions>& importOptions)
+	{
+		SPtr<ImportCache> cache = getCache(importer);
+		if (cache == nullptr)
+			return importer->importAll(filePath, importOptions);
+
+		const String key = cache->getKey(*importer, filePath, importOptions, true);
+
+		Vector<SubResourceRaw> output;
+		if (!key.empty() && cache->load(key, output))
+			return output;
+
+		output = importer->importAll(filePath, importOptions);
+		if (!key.empty())
+			cache->save(key, output);
+
+		return output;
+	}
+
+	void Importer::setCacheDirectory(const Path& path)
+	{
+		Lock lock(mCacheMutex);
+
+		if (path.isEmpty())
+			mCache = nullptr;
+		else
+			mCache = bs_shared_ptr_new<ImportCache>(path);
+	}
+
+	Path Importer::getCacheDirectory() const
+	{
+		Lock lock(mCacheMutex);
+
+		if (mCache == nullptr)
+			return Path::BLANK;
+
+		return mCache->getDirectory();
+	}
+
+	SPtr<ImportCache> Importer::getCache(SpecificImporter* importer) const
+	{
+		if (!importer->isCacheable())
+			return nullptr;
+
+		Lock lock(mCacheMutex);
+		return mCache;
+	}
+
 	SPtr<ImportOptions> Importer::createImportOptions(const Path& inputFilePath)
 	{
 		if(!FileSystem::isFile(inputFilePath))
@@ -126,6 +126,17 @@ namespace bs
 		 */
 		bool supportsFileType(const UINT8* magicNumber, UINT32 magicNumSize) const;
 
+		/**
+		 * Sets a folder in which to store the results of imports. Subsequent imports of a file whose contents haven't 
+		 * changed, using the same import options, are then loaded from the cache instead of being imported again. Only
+		 * used by importers that support it (see SpecificImporter::isCacheable()). Provide an empty path to disable the
+		 * cache, which is the default.
+		 */
+		void setCacheDirectory(const Path& path);
+
+		/** Returns the folder import results are cached in, or an empty path if caching is disabled. */
+		Path getCacheDirectory() const;
+
 		/** @name Internal
 		 *  @{
 		 */
@@ -149,6 +160,12 @@ namespace bs
 		Vector<SubResourceRaw> _importAll(const Path& inputFilePath, 
 			SPtr<const ImportOptions> importOptions = nullptr);
 
+		/** 
+		 * Returns the async operation of the asynchronous import executing on the calling thread, or a null operation if
+		 * the calling thread isn't executing one. Specific importers can use this to report their progress.
+		 */
+		static AsyncOp _getActiveOperation();
+
 		/** @} */
 	private:
 		/** Information about a single queued import operation. */
@@ -200,6 +217,23 @@ namespace bs
 		 */
 		UINT64 waitForAsync(SpecificImporter* importer);
 
+		/** 
+		 * Imports the primary resource from the provided file using the specified importer, or loads it from the import
+		 * cache if available.
+		 */
+		SPtr<Resource> importWithCache(SpecificImporter* importer, const Path& filePath, 
+			const SPtr<const ImportOptions>& importOptions);
+
+		/** 
+		 * Imports all resources from the provided file using the specified importer, or loads them from the import cache
+		 * if available.
+		 */
+		Vector<SubResourceRaw> importAllWithCache(SpecificImporter* importer, const Path& filePath, 
+			const SPtr<const ImportOptions>& importOptions);
+
+		/** Returns the import cache to use with the specified importer, or null if the results shouldn't be cached. */
+		SPtr<ImportCache> getCache(SpecificImporter* importer) const;
+
 		Vector<SpecificImporter*> mAssetImporters;
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
@@ -222,6 +256,9 @@ namespace bs
 		};
 
 		UnorderedMap<SpecificImporter*, QueuedTask> mLastQueuedTask;
+
+		SPtr<ImportCache> mCache;
+		mutable Mutex mCacheMutex;
 	};
 
 	/** Provides easier access to Importer. */
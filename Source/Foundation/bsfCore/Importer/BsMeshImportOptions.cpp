@@ -28,7 +28,8 @@ namespace bs
 	MeshImportOptions::MeshImportOptions()
 		: mCPUCached(false), mImportNormals(true), mImportTangents(true), mImportBlendShapes(false), mImportSkin(false)
 		, mImportAnimation(false), mReduceKeyFrames(true), mImportRootMotion(false), mImportScale(1.0f)
-		, mCollisionMeshType(CollisionMeshType::None)
+		, mLODCount(0), mLODReduction(0.5f), mOptimize(false), mQuantizeVertices(false)
+		, mGenerateMeshlets(false), mCollisionMeshType(CollisionMeshType::None)
 	{ }
 
 	SPtr<MeshImportOptions> MeshImportOptions::create()
@@ -165,6 +165,54 @@ namespace bs
 		 */
 		bool getImportRootMotion() const { return mImportRootMotion; }
 
+		/**
+		 * Determines the number of additional levels of detail to generate for the mesh, by simplifying the full detail
+		 * geometry. Zero by default, in which case only the full detail level is imported.
+		 */
+		void setLODCount(UINT32 count) { mLODCount = count; }
+
+		/** @copydoc setLODCount */
+		UINT32 getLODCount() const { return mLODCount; }
+
+		/**
+		 * Determines the fraction of triangles each generated level of detail keeps, relative to the previous level. 
+		 * Only relevant if setLODCount() is larger than zero. Must be in (0, 1) range.
+		 */
+		void setLODReduction(float reduction) { mLODReduction = reduction; }
+
+		/** @copydoc setLODReduction */
+		float getLODReduction() const { return mLODReduction; }
+
+		/**
+		 * Determines should the triangles and vertices of the mesh be reordered for more efficient rendering. Improves
+		 * the vertex cache hit rate, reduces overdraw and improves the locality of vertex fetches, at the cost of a
+		 * longer import. Applies to all levels of detail.
+		 */
+		void setOptimize(bool enabled) { mOptimize = enabled; }
+
+		/** @copydoc setOptimize */
+		bool getOptimize() const { return mOptimize; }
+
+		/**
+		 * Determines should vertex attributes be stored in a more compact format, reducing the memory and bandwidth
+		 * used by the mesh. Texture coordinates are stored as 16-bit floating point values and bone weights as 8-bit
+		 * normalized values. Positions remain at full precision.
+		 */
+		void setQuantizeVertices(bool enabled) { mQuantizeVertices = enabled; }
+
+		/** @copydoc setQuantizeVertices */
+		bool getQuantizeVertices() const { return mQuantizeVertices; }
+
+		/**
+		 * Determines should the full detail sub-meshes be split into meshlets, small clusters of triangles that the
+		 * renderer can cull individually against the view frustum and by facing direction. Benefits dense static meshes
+		 * (e.g. scans or CAD models) that are often only partially visible. Reorders the triangles of each sub-mesh.
+		 */
+		void setGenerateMeshlets(bool enabled) { mGenerateMeshlets = enabled; }
+
+		/** @copydoc setGenerateMeshlets */
+		bool getGenerateMeshlets() const { return mGenerateMeshlets; }
+
 		/** Creates a new import options object that allows you to customize how are meshes imported. */
 		static SPtr<MeshImportOptions> create();
 
@@ -178,6 +226,11 @@ namespace bs
 		bool mReduceKeyFrames;
 		bool mImportRootMotion;
 		float mImportScale;
+		UINT32 mLODCount;
+		float mLODReduction;
+		bool mOptimize;
+		bool mQuantizeVertices;
+		bool mGenerateMeshlets;
 		CollisionMeshType mCollisionMeshType;
 		Vector<AnimationSplitInfo> mAnimationSplits;
 		Vector<ImportedAnimationEvents> mAnimationEvents;
@@ -24,7 +24,7 @@ namespace bs
 	{
 		String includeString;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 			includeString = stream->getAsString();
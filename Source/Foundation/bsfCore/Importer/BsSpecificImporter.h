@@ -55,6 +55,19 @@ namespace bs
 		/** Returns the level of asynchronous import supported by this importer. */
 		virtual ImporterAsyncMode getAsyncMode() const { return ImporterAsyncMode::Multi; }
 
+		/**
+		 * Determines can the results of this importer be stored in the import cache (see Importer::setCacheDirectory()).
+		 * Only importers whose output depends solely on the contents of the source file and the import options, and whose
+		 * output doesn't reference resources created during import, should enable this.
+		 */
+		virtual bool isCacheable() const { return false; }
+
+		/**
+		 * Returns the version of the importer's output. Must be incremented whenever a change to the importer makes it 
+		 * produce different resources from the same source, so the results cached by older versions are not used.
+		 */
+		virtual UINT32 getVersion() const { return 0; }
+
 		/**
 		 * Imports the given file. If file contains more than one resource only the primary resource is imported (for 
 		 * example for an FBX a mesh would be imported, but animations ignored).
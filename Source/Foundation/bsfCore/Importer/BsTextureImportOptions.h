@@ -69,6 +69,15 @@ namespace bs
 		/** Checks if the texture will be imported as a cubemap. */
 		bool getIsCubemap() const { return mCubemap; }
 
+		/**
+		 * Determines should the imported texture stream its mip levels, loading the more detailed ones only when the
+		 * renderer needs them. Ignored for CPU cached textures. See Texture::setStreaming.
+		 */
+		void setStreaming(bool streaming) { mStreaming = streaming; }
+
+		/** Checks if the imported texture will stream its mip levels. */
+		bool getStreaming() const { return mStreaming; }
+
 		/** 
 		 * Sets a value that determines how should the source texture be interpreted when generating a cubemap. Only
 		 * relevant when setIsCubemap() is set to true.
@@ -100,6 +109,7 @@ namespace bs
 		bool mSRGB;
 		bool mCubemap;
 		CubemapSourceType mCubemapSourceType;
+		bool mStreaming;
 	};
 
 	/** @} */
@@ -19,6 +19,16 @@ namespace bs
 	const int Input::HISTORY_BUFFER_SIZE = 10; // Size of buffer used for input smoothing
 	const float Input::WEIGHT_MODIFIER = 0.5f;
 
+	/** True on the thread started by Input::setRawInputPollingRate(). */
+	static BS_THREADLOCAL bool sIsRawInputThread = false;
+
+	/** Converts a raw gamepad axis value into [-1.0f, 1.0f] range. */
+	static float toAxisValue(INT32 value)
+	{
+		float axisRange = Math::abs((float)Gamepad::MAX_AXIS) + Math::abs((float)Gamepad::MIN_AXIS);
+		return ((value + Math::abs((float)Gamepad::MIN_AXIS)) / axisRange) * 2.0f - 1.0f;
+	}
+
 	Input::DeviceData::DeviceData()
 	{
 		for (UINT32 i = 0; i < BC_Count; i++)
@@ -60,12 +70,16 @@ namespace bs
 		mMouseZeroTime[0] = 0.0f;
 		mMouseZeroTime[1] = 0.0f;
 
+		mUnprocessedMouseAxes[0] = 0;
+		mUnprocessedMouseAxes[1] = 0;
+
 		// Raw input
 		initRawInput();
 	}
 
 	Input::~Input()
 	{
+		stopRawInputThread();
 		cleanUpRawInput();
 
 		mCharInputConn.disconnect();
@@ -107,17 +121,24 @@ namespace bs
 
 		mPointerDelta = Vector2I::ZERO; // Reset delta in case we don't receive any mouse input this frame
 		mPointerDoubleClicked = false;
+		mFrameInputTimestamp = 0;
 
-		// Capture raw input
-		if (mMouse != nullptr)
-			mMouse->capture();
+		// Capture raw input. If the raw input thread is running it captures mouse and gamepad input instead, and we
+		// only need to process the samples it queued.
+		if (mRawInputPollingRate == 0)
+		{
+			if (mMouse != nullptr)
+				mMouse->capture();
+
+			for (auto& gamepad : mGamepads)
+				gamepad->capture();
+		}
+		else
+			processRawInputSamples();
 
 		if (mKeyboard != nullptr)
 			mKeyboard->capture();
 
-		for (auto& gamepad : mGamepads)
-			gamepad->capture();
-
 		float rawXValue = 0.0f;
 		float rawYValue = 0.0f;
 
@@ -204,6 +225,10 @@ namespace bs
 			{
 				const ButtonEvent& eventData = mButtonDownEvents[1][event.idx];
 
+				// Devices are only added here, as buttons can be pressed on the raw input thread
+				while (eventData.deviceIdx >= (UINT32)mDevices.size())
+					mDevices.push_back(DeviceData());
+
 				mDevices[eventData.deviceIdx].keyStates[eventData.buttonCode & 0x0000FFFF] = ButtonState::ToggledOn;
 				onButtonDown(mButtonDownEvents[1][event.idx]);
 			}
@@ -273,6 +298,8 @@ namespace bs
 		UINT64 hWnd = 0;
 		win.getCustomAttribute("WINDOW", &hWnd);
 
+		Lock lock(mCaptureMutex);
+
 		mKeyboard->changeCaptureContext(hWnd);
 		mMouse->changeCaptureContext(hWnd);
 
@@ -282,6 +309,8 @@ namespace bs
 
 	void Input::inputFocusLost()
 	{
+		Lock lock(mCaptureMutex);
+
 		mKeyboard->changeCaptureContext((UINT64)-1);
 		mMouse->changeCaptureContext((UINT64)-1);
 
@@ -290,6 +319,33 @@ namespace bs
 	}
 
 	void Input::_notifyMouseMoved(INT32 relX, INT32 relY, INT32 relZ)
+	{
+		if (isRawInputThread())
+		{
+			InputSample sample;
+			sample.timestamp = gTime().getTimePrecise();
+			sample.type = InputSampleType::MouseMoved;
+			sample.deviceIdx = 0;
+			sample.axisIdx = 0;
+			sample.values[0] = relX;
+			sample.values[1] = relY;
+			sample.values[2] = relZ;
+
+			// Movement is only dropped if the main thread stalls long enough for the buffer to fill up
+			if (mRawInputSamples.push(sample))
+			{
+				mUnprocessedMouseAxes[0].fetch_add(relX, std::memory_order_relaxed);
+				mUnprocessedMouseAxes[1].fetch_add(relY, std::memory_order_relaxed);
+			}
+
+			return;
+		}
+
+		mFrameInputTimestamp = gTime().getTimePrecise();
+		mouseMoved(relX, relY, relZ);
+	}
+
+	void Input::mouseMoved(INT32 relX, INT32 relY, INT32 relZ)
 	{
 		mMouseSampleAccumulator[0] += relX;
 		mMouseSampleAccumulator[1] += relY;
@@ -315,11 +371,23 @@ namespace bs
 
 	void Input::_notifyAxisMoved(UINT32 gamepadIdx, UINT32 axisIdx, INT32 value)
 	{
-		// Move axis values into [-1.0f, 1.0f] range
-		float axisRange = Math::abs((float)Gamepad::MAX_AXIS) + Math::abs((float)Gamepad::MIN_AXIS);
+		if (isRawInputThread())
+		{
+			InputSample sample;
+			sample.timestamp = gTime().getTimePrecise();
+			sample.type = InputSampleType::AxisMoved;
+			sample.deviceIdx = gamepadIdx;
+			sample.axisIdx = axisIdx;
+			sample.values[0] = value;
+			sample.values[1] = 0;
+			sample.values[2] = 0;
+
+			mRawInputSamples.push(sample);
+			return;
+		}
 
-		float axisValue = ((value + Math::abs((float)Gamepad::MIN_AXIS)) / axisRange) * 2.0f - 1.0f;
-		axisMoved(gamepadIdx, axisValue, axisIdx);
+		mFrameInputTimestamp = gTime().getTimePrecise();
+		axisMoved(gamepadIdx, toAxisValue(value), axisIdx);
 	}
 
 	void Input::_notifyButtonPressed(UINT32 deviceIdx, ButtonCode code, UINT64 timestamp)
@@ -336,9 +404,6 @@ namespace bs
 	{
 		Lock lock(mMutex);
 
-		while (deviceIdx >= (UINT32)mDevices.size())
-			mDevices.push_back(DeviceData());
-
 		ButtonEvent btnEvent;
 		btnEvent.buttonCode = code;
 		btnEvent.timestamp = timestamp;
@@ -588,6 +653,113 @@ namespace bs
 		}
 	}
 
+	void Input::setRawInputPollingRate(UINT32 rate)
+	{
+		if (rate == mRawInputPollingRate)
+			return;
+
+		stopRawInputThread();
+
+		// Process anything captured by the previous thread, so no samples are lost
+		processRawInputSamples();
+
+		mRawInputPollingRate = rate;
+		if (rate == 0)
+			return;
+
+		mRawInputThreadStop = false;
+		mRawInputThread = ThreadPool::instance().run("RawInput", std::bind(&Input::runRawInputThread, this));
+	}
+
+	void Input::stopRawInputThread()
+	{
+		if (mRawInputPollingRate == 0)
+			return;
+
+		mRawInputThreadStop = true;
+		mRawInputThread.blockUntilComplete();
+	}
+
+	bool Input::isRawInputThread() const
+	{
+		return sIsRawInputThread;
+	}
+
+	void Input::runRawInputThread()
+	{
+		sIsRawInputThread = true;
+
+		const UINT64 interval = 1000000 / mRawInputPollingRate;
+		UINT64 nextCaptureTime = gTime().getTimePrecise();
+
+		while (!mRawInputThreadStop.load(std::memory_order_relaxed))
+		{
+			{
+				Lock lock(mCaptureMutex);
+
+				if (mMouse != nullptr)
+					mMouse->capture();
+
+				for (auto& gamepad : mGamepads)
+					gamepad->capture();
+			}
+
+			nextCaptureTime += interval;
+
+			const UINT64 currentTime = gTime().getTimePrecise();
+			if (nextCaptureTime > currentTime)
+				std::this_thread::sleep_for(std::chrono::microseconds(nextCaptureTime - currentTime));
+			else
+				nextCaptureTime = currentTime; // Fell behind, don't try to catch up with a burst of captures
+		}
+
+		// Threads are pooled, so the thread can be re-used for something else
+		sIsRawInputThread = false;
+	}
+
+	void Input::processRawInputSamples()
+	{
+		INT32 processedMouseAxes[2] = { 0, 0 };
+
+		InputSample sample;
+		while (mRawInputSamples.pop(sample))
+		{
+			mFrameInputTimestamp = std::max(mFrameInputTimestamp, sample.timestamp);
+
+			if (sample.type == InputSampleType::MouseMoved)
+			{
+				mouseMoved(sample.values[0], sample.values[1], sample.values[2]);
+
+				processedMouseAxes[0] += sample.values[0];
+				processedMouseAxes[1] += sample.values[1];
+			}
+			else
+				axisMoved(sample.deviceIdx, toAxisValue(sample.values[0]), sample.axisIdx);
+		}
+
+		mUnprocessedMouseAxes[0].fetch_sub(processedMouseAxes[0], std::memory_order_relaxed);
+		mUnprocessedMouseAxes[1].fetch_sub(processedMouseAxes[1], std::memory_order_relaxed);
+	}
+
+	Vector2 Input::getUnprocessedMouseAxes() const
+	{
+		// Same conversion as performed during the update, see _update()
+		const INT32 x = mUnprocessedMouseAxes[0].load(std::memory_order_relaxed);
+		const INT32 y = mUnprocessedMouseAxes[1].load(std::memory_order_relaxed);
+
+		return Vector2(-x * 0.1f, -y * 0.1f);
+	}
+
+	void Input::_notifyFramePresented(UINT64 inputTimestamp)
+	{
+		if (inputTimestamp == 0)
+			return;
+
+		const UINT64 currentTime = gTime().getTimePrecise();
+		if (currentTime > inputTimestamp)
+			mInputLatency.store(currentTime - inputTimestamp, std::memory_order_relaxed);
+	}
+
 	void Input::setMouseSmoothing(bool enable)
 	{
 		mMouseSmoothingEnabled = enable;
@@ -6,6 +6,10 @@
 #include "Utility/BsModule.h"
 #include "Platform/BsPlatform.h"
 #include "Input/BsInputFwd.h"
+#include "Input/BsInputSampleBuffer.h"
+#include "Math/BsVector2.h"
+#include "Threading/BsThreadPool.h"
+#include <atomic>
 
 namespace bs
 {
@@ -136,30 +140,71 @@ namespace bs
 		/** Returns the name of a specific input device. Returns empty string if the device doesn't exist. */
 		String getDeviceName(InputDevice type, UINT32 idx);
 
+		/**
+		 * Enables or disables a dedicated thread that captures raw mouse and gamepad input at the specified rate,
+		 * independently of the frame rate. Captured samples are timestamped and queued, and are processed in order
+		 * during the next update. This allows input to be sampled more often than once per frame, and allows the most
+		 * recent input to be retrieved closer to presentation, through getUnprocessedMouseAxes().
+		 *
+		 * @param[in]	rate	Number of times per second to capture raw input. Zero disables the raw input thread, in
+		 *						which case input is captured once per frame during the update. The rate is limited by
+		 *						the sleep granularity of the platform.
+		 *
+		 * @note	Some platforms only deliver raw input to the thread that owns the window, in which case mouse input
+		 *			is still captured only once per frame.
+		 */
+		void setRawInputPollingRate(UINT32 rate);
+
+		/** @copydoc setRawInputPollingRate */
+		UINT32 getRawInputPollingRate() const { return mRawInputPollingRate; }
+
+		/**
+		 * Returns the movement along the MouseX and MouseY axes that was captured by the raw input thread, but not yet
+		 * processed by an update. Values are in the same units as returned by getAxisValue(), without smoothing. Always
+		 * zero if the raw input thread is disabled.
+		 *
+		 * Meant for late latching, where the camera transform is adjusted using the most recent input just before the
+		 * frame is rendered (see ct::Renderer::setLateLatchCallback()).
+		 *
+		 * @note	Thread safe.
+		 */
+		Vector2 getUnprocessedMouseAxes() const;
+
+		/**
+		 * Returns the time elapsed between capturing the most recent mouse or axis input used by a frame, and that
+		 * frame being presented, in microseconds. Measured for the last presented frame that received input. Doesn't
+		 * include the time the display takes to show the presented frame.
+		 *
+		 * @note	Thread safe.
+		 */
+		UINT64 getInputLatency() const { return mInputLatency.load(std::memory_order_relaxed); }
+
+		// Input events are only connected to and triggered from the sim thread, and skip locking
+
 		/** Triggered whenever a button is first pressed. */
-		Event<void(const ButtonEvent&)> onButtonDown;
+		Event<void(const ButtonEvent&), false> onButtonDown;
 
 		/**	Triggered whenever a button is first released. */
-		Event<void(const ButtonEvent&)> onButtonUp;
+		Event<void(const ButtonEvent&), false> onButtonUp;
 
 		/**	Triggered whenever user inputs a text character. */
-		Event<void(const TextInputEvent&)> onCharInput;
+		Event<void(const TextInputEvent&), false> onCharInput;
 
 		/**	Triggers when some pointing device (mouse cursor, touch) moves. */
-		Event<void(const PointerEvent&)> onPointerMoved;
+		Event<void(const PointerEvent&), false> onPointerMoved;
 
 		/**	Triggers when some pointing device (mouse cursor, touch) button is pressed. */
-		Event<void(const PointerEvent&)> onPointerPressed;
+		Event<void(const PointerEvent&), false> onPointerPressed;
 
 		/**	Triggers when some pointing device (mouse cursor, touch) button is released. */
-		Event<void(const PointerEvent&)> onPointerReleased;
+		Event<void(const PointerEvent&), false> onPointerReleased;
 
 		/**	Triggers when some pointing device (mouse cursor, touch) button is double clicked. */
-		Event<void(const PointerEvent&)> onPointerDoubleClick;
+		Event<void(const PointerEvent&), false> onPointerDoubleClick;
 
 		// TODO Low priority: Remove this, I can emulate it using virtual input
 		/**	Triggers on special input commands. */
-		Event<void(InputCommandType)> onInputCommand;
+		Event<void(InputCommandType), false> onInputCommand;
 
 	public: // ***** INTERNAL ******
 		/** @name Internal
@@ -193,6 +238,19 @@ namespace bs
 		/** Called by any of the raw input devices when a button is released. */
 		void _notifyButtonReleased(UINT32 deviceIdx, ButtonCode code, UINT64 timestamp);
 
+		/**
+		 * Returns the capture time of the most recent mouse or axis input processed during the last update, as reported
+		 * by Time::getTimePrecise(). Zero if no such input was processed.
+		 */
+		UINT64 _getFrameInputTimestamp() const { return mFrameInputTimestamp; }
+
+		/**
+		 * Called on the core thread once a frame has been presented, in order to measure input latency.
+		 *
+		 * @param[in]	inputTimestamp	Value returned by _getFrameInputTimestamp() after the update of the frame.
+		 */
+		void _notifyFramePresented(UINT64 inputTimestamp);
+
 		/** @} */
 
 	private:
@@ -201,6 +259,21 @@ namespace bs
 
 		/** Performs platform specific raw input system cleanup. */
 		void cleanUpRawInput();
+
+		/** Captures mouse and gamepad input at the requested rate, until stopped. Runs on the raw input thread. */
+		void runRawInputThread();
+
+		/** Stops the raw input thread and blocks until it finishes, if it's running. */
+		void stopRawInputThread();
+
+		/** Returns true if called from the raw input thread. */
+		bool isRawInputThread() const;
+
+		/** Processes relative mouse movement. Main thread only. */
+		void mouseMoved(INT32 relX, INT32 relY, INT32 relZ);
+
+		/** Processes any samples queued by the raw input thread, in the order they were captured. Main thread only. */
+		void processRawInputSamples();
 		
 		/**
 		 * Smooths the input mouse axis value. Smoothing makes the changes to the axis more gradual depending on previous
@@ -331,6 +404,18 @@ namespace bs
 
 		UINT64 mTimestampClockOffset;
 
+		// Raw input thread
+		HThread mRawInputThread;
+		UINT32 mRawInputPollingRate = 0;
+		std::atomic<bool> mRawInputThreadStop{false};
+		Mutex mCaptureMutex;
+
+		InputSampleBuffer mRawInputSamples;
+		std::atomic<INT32> mUnprocessedMouseAxes[2];
+
+		UINT64 mFrameInputTimestamp = 0;
+		std::atomic<UINT64> mInputLatency{0};
+
 		InputPrivateData* mPlatformData;
 
 		/************************************************************************/
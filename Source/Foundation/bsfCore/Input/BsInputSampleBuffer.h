@@ -0,0 +1,95 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsBitwise.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Input-Internal
+	 *  @{
+	 */
+
+	/** Types of raw input samples. */
+	enum class InputSampleType
+	{
+		/** Relative mouse movement, along the X, Y and Z (wheel) axes. */
+		MouseMoved,
+		/** Absolute position of a gamepad or joystick axis. */
+		AxisMoved
+	};
+
+	/** Single timestamped sample of raw input, captured by Input on the raw input thread. */
+	struct InputSample
+	{
+		/** Time at which the sample was captured, as reported by Time::getTimePrecise(). */
+		UINT64 timestamp;
+
+		InputSampleType type;
+		UINT32 deviceIdx;
+
+		/** Index of the axis that moved. Only relevant for InputSampleType::AxisMoved. */
+		UINT32 axisIdx;
+
+		/**
+		 * Relative mouse movement in X, Y and Z for InputSampleType::MouseMoved, or the raw axis value in the first
+		 * entry for InputSampleType::AxisMoved.
+		 */
+		INT32 values[3];
+	};
+
+	/**
+	 * Fixed size lock-free queue of raw input samples, meant to be used by exactly one producer and one consumer
+	 * thread. Samples are stored inline and no allocations are performed after construction.
+	 *
+	 * @note	push() must only be called from the producer thread, and pop() only from the consumer thread.
+	 */
+	class InputSampleBuffer
+	{
+	public:
+		/** @param[in]	capacity	Maximum number of samples in the buffer. Rounded up to a power of two. */
+		InputSampleBuffer(UINT32 capacity = 4096)
+			: mSamples(Bitwise::nextPow2(capacity)), mMask(Bitwise::nextPow2(capacity) - 1)
+		{ }
+
+		InputSampleBuffer(const InputSampleBuffer&) = delete;
+		InputSampleBuffer& operator=(const InputSampleBuffer&) = delete;
+
+		/** Appends a sample to the buffer. Returns false if the buffer is full. Producer thread only. */
+		bool push(const InputSample& sample)
+		{
+			const UINT32 writeIdx = mWriteIdx.load(std::memory_order_relaxed);
+			if (writeIdx - mReadIdx.load(std::memory_order_acquire) > mMask)
+				return false;
+
+			mSamples[writeIdx & mMask] = sample;
+			mWriteIdx.store(writeIdx + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/** Removes the oldest sample from the buffer. Returns false if the buffer is empty. Consumer thread only. */
+		bool pop(InputSample& sample)
+		{
+			const UINT32 readIdx = mReadIdx.load(std::memory_order_relaxed);
+			if (readIdx == mWriteIdx.load(std::memory_order_acquire))
+				return false;
+
+			sample = mSamples[readIdx & mMask];
+			mReadIdx.store(readIdx + 1, std::memory_order_release);
+
+			return true;
+		}
+
+	private:
+		Vector<InputSample> mSamples;
+		const UINT32 mMask;
+
+		std::atomic<UINT32> mWriteIdx{0};
+		std::atomic<UINT32> mReadIdx{0};
+	};
+
+	/** @} */
+}
\ No newline at end of file
@@ -8,26 +8,17 @@ namespace bs
 {
 	HString::HString()
 	{
-		mStringData = StringTableManager::instance().getTable(0)->getStringData(u8"");
-
-		if (mStringData->numParameters > 0)
-			mParameters = bs_newN<String>(mStringData->numParameters);
+		initialize(StringTableManager::instance().getTable(0).getInternalPtr(), u8"");
 	}
 
 	HString::HString(UINT32 stringTableId)
 	{
-		mStringData = StringTableManager::instance().getTable(stringTableId)->getStringData(u8"");
-
-		if (mStringData->numParameters > 0)
-			mParameters = bs_newN<String>(mStringData->numParameters);
+		initialize(StringTableManager::instance().getTable(stringTableId).getInternalPtr(), u8"");
 	}
 
 	HString::HString(const String& identifierString, UINT32 stringTableId)
 	{
-		mStringData = StringTableManager::instance().getTable(stringTableId)->getStringData(identifierString);
-
-		if (mStringData->numParameters > 0)
-			mParameters = bs_newN<String>(mStringData->numParameters);
+		initialize(StringTableManager::instance().getTable(stringTableId).getInternalPtr(), identifierString);
 	}
 
 	HString::HString(const String& identifierString, const String& defaultString, UINT32 stringTableId)
@@ -35,40 +26,49 @@ namespace bs
 		HStringTable table = StringTableManager::instance().getTable(stringTableId);
 		table->setString(identifierString, StringTable::DEFAULT_LANGUAGE, defaultString);
 
-		mStringData = table->getStringData(identifierString);
-
-		if (mStringData->numParameters > 0)
-			mParameters = bs_newN<String>(mStringData->numParameters);
+		initialize(table.getInternalPtr(), identifierString);
 	}
 
 	HString::HString(const HString& copy)
 	{
-		mStringData = copy.mStringData;
-		mIsDirty = copy.mIsDirty;
-		mCachedString = copy.mCachedString;
-
-		if (copy.mStringData->numParameters > 0)
-		{
-			mParameters = bs_newN<String>(mStringData->numParameters);
-			if (copy.mParameters != nullptr)
-			{
-				for (UINT32 i = 0; i < mStringData->numParameters; i++)
-					mParameters[i] = copy.mParameters[i];
-			}
-
-			mStringPtr = &mCachedString;
-		}
-		else
-		{
-			mParameters = nullptr;
-			mStringPtr = &mStringData->string;
-		}
+		this->copy(copy);
 	}
 
 	HString::~HString()
 	{
 		if (mParameters != nullptr)
-			bs_deleteN(mParameters, mStringData->numParameters);
+			bs_deleteN(mParameters, mNumParameters);
+	}
+
+	void HString::initialize(const SPtr<StringTable>& table, const String& identifier)
+	{
+		mTable = table;
+		mStringData = table->getStringData(identifier);
+		mIdentifierIdx = table->findIdentifier(identifier);
+		mTableVersion = table->getVersion();
+		mNumParameters = mStringData->numParameters;
+
+		if (mNumParameters > 0)
+			mParameters = bs_newN<String>(mNumParameters);
+	}
+
+	void HString::copy(const HString& other)
+	{
+		mTable = other.mTable;
+		mIdentifierIdx = other.mIdentifierIdx;
+		mNumParameters = other.mNumParameters;
+		mStringData = other.mStringData;
+		mTableVersion = other.mTableVersion;
+		mIsDirty = true;
+
+		if (mNumParameters > 0)
+		{
+			mParameters = bs_newN<String>(mNumParameters);
+			for (UINT32 i = 0; i < mNumParameters; i++)
+				mParameters[i] = other.mParameters[i];
+		}
+		else
+			mParameters = nullptr;
 	}
 
 	HString::operator const String& () const
@@ -78,43 +78,42 @@ namespace bs
 
 	HString& HString::operator=(const HString& rhs)
 	{
+		if (this == &rhs)
+			return *this;
+
 		if (mParameters != nullptr)
-		{
-			bs_deleteN(mParameters, mStringData->numParameters);
-			mParameters = nullptr;
-		}
+			bs_deleteN(mParameters, mNumParameters);
 
-		mStringData = rhs.mStringData;
-		mIsDirty = rhs.mIsDirty;
-		mCachedString = rhs.mCachedString;
+		copy(rhs);
+		return *this;
+	}
 
-		if (rhs.mStringData->numParameters > 0)
-		{
-			mParameters = bs_newN<String>(mStringData->numParameters);
-			if (rhs.mParameters != nullptr)
-			{
-				for (UINT32 i = 0; i < mStringData->numParameters; i++)
-					mParameters[i] = rhs.mParameters[i];
-			}
+	void HString::refreshStringData() const
+	{
+		const UINT32 version = mTable->getVersion();
+		if (version == mTableVersion)
+			return;
 
-			mStringPtr = &mCachedString;
-		}
-		else
+		mTableVersion = version;
+
+		// Keep the current data if the string was removed from the table
+		SPtr<LocalizedStringData> stringData = mTable->getStringData(mIdentifierIdx, mTable->getActiveLanguage());
+		if (stringData != nullptr && stringData != mStringData)
 		{
-			mParameters = nullptr;
-			mStringPtr = &mStringData->string;
+			mStringData = stringData;
+			mIsDirty = true;
 		}
-
-		return *this;
 	}
 
 	const String& HString::getValue() const
 	{
+		refreshStringData();
+
 		if (mIsDirty)
 		{
 			if (mParameters != nullptr)
 			{
-				mStringData->concatenateString(mCachedString, mParameters, mStringData->numParameters);
+				mStringData->concatenateString(mCachedString, mParameters, mNumParameters);
 				mStringPtr = &mCachedString;
 			}
 			else
@@ -130,7 +129,7 @@ namespace bs
 
 	void HString::setParameter(UINT32 idx, const String& value)
 	{
-		if (idx >= mStringData->numParameters)
+		if (idx >= mNumParameters)
 			return;
 
 		mParameters[idx] = value;
@@ -12,7 +12,9 @@ namespace bs
 	 * String handle. Provides a wrapper around an Unicode string, primarily for localization purposes.
 	 * 			
 	 * Actual value for this string is looked up in a global string table based on the provided identifier string and 
-	 * currently active language. If such value doesn't exist then the identifier is used as is.
+	 * currently active language. If such value doesn't exist then the identifier is used as is. The identifier is only
+	 * looked up on creation, after which the string is referenced by its index in the string table. This allows the
+	 * value to be cheaply refreshed the next time it is accessed after the active language changes.
 	 *			
 	 * Use {0}, {1}, etc. in the string value for values that might change dynamically.
 	 */
@@ -75,9 +77,23 @@ namespace bs
 		/** Returns an empty string. */
 		static const HString& dummy();
 	private:
-		SPtr<LocalizedStringData> mStringData;
+		/** Looks up the identifier in the provided table, and allocates the string parameters. */
+		void initialize(const SPtr<StringTable>& table, const String& identifier);
+
+		/** Copies the contents of another string, without releasing the existing parameters. */
+		void copy(const HString& other);
+
+		/** Finds the string data for the currently active language, if it might have changed since last access. */
+		void refreshStringData() const;
+
+		SPtr<StringTable> mTable;
+		UINT32 mIdentifierIdx = 0;
+		UINT32 mNumParameters = 0;
 		String* mParameters = nullptr;
 
+		mutable SPtr<LocalizedStringData> mStringData;
+		mutable UINT32 mTableVersion = 0;
+
 		mutable bool mIsDirty = true;
 		mutable String mCachedString;
 		mutable String* mStringPtr = nullptr;
@@ -163,14 +163,27 @@ namespace bs
 			parameterOffsets[i] = paramOffsets[i];
 	}
 
-	StringTable::StringTable()
-		:Resource(false), mActiveLanguageData(nullptr), mDefaultLanguageData(nullptr), mAllLanguages(nullptr)
+	/** Initial number of slots in the identifier lookup table. Must be a power of two. */
+	static constexpr UINT32 INITIAL_LOOKUP_SIZE = 64;
+
+	/** Calculates the hash used for looking up identifiers in the string table. */
+	static UINT32 hashIdentifier(const String& identifier)
 	{
-		mAllLanguages = bs_newN<LanguageData>((UINT32)Language::Count);
+		// FNV-1a
+		UINT32 hash = 2166136261u;
+		for (char ch : identifier)
+		{
+			hash ^= (UINT8)ch;
+			hash *= 16777619u;
+		}
 
-		mDefaultLanguageData = &(mAllLanguages[(UINT32)DEFAULT_LANGUAGE]);
-		mActiveLanguageData = mDefaultLanguageData;
-		mActiveLanguage = DEFAULT_LANGUAGE;
+		return hash;
+	}
+
+	StringTable::StringTable()
+		:Resource(false), mActiveLanguage(DEFAULT_LANGUAGE), mAllLanguages(nullptr)
+	{
+		mAllLanguages = bs_newN<LanguageStrings>((UINT32)Language::Count);
 	}
 	
 	StringTable::~StringTable()
@@ -183,64 +196,146 @@ namespace bs
 		if(language == mActiveLanguage)
 			return;
 
-		mActiveLanguageData = &(mAllLanguages[(UINT32)language]);
 		mActiveLanguage = language;
+		mVersion++;
+	}
+
+	UINT32 StringTable::findIdentifier(const String& identifier) const
+	{
+		if(mIdentifierLookup.empty())
+			return INVALID_IDENTIFIER;
+
+		const UINT32 hash = hashIdentifier(identifier);
+		const UINT32 mask = (UINT32)mIdentifierLookup.size() - 1;
+		for(UINT32 i = hash & mask; ; i = (i + 1) & mask)
+		{
+			const UINT32 slot = mIdentifierLookup[i];
+			if(slot == 0)
+				return INVALID_IDENTIFIER;
+
+			const IdentifierEntry& entry = mIdentifiers[slot - 1];
+			if(entry.hash == hash && entry.name == identifier)
+				return slot - 1;
+		}
+	}
+
+	UINT32 StringTable::addIdentifier(const String& identifier)
+	{
+		UINT32 idx = findIdentifier(identifier);
+		if(idx == INVALID_IDENTIFIER)
+		{
+			// Keep the load factor under one half, so probe sequences stay short
+			if((mIdentifiers.size() + 1) * 2 > mIdentifierLookup.size())
+				growLookup();
+
+			idx = (UINT32)mIdentifiers.size();
+			mIdentifiers.push_back({ identifier, hashIdentifier(identifier), false });
+
+			const UINT32 mask = (UINT32)mIdentifierLookup.size() - 1;
+			UINT32 slot = mIdentifiers[idx].hash & mask;
+			while(mIdentifierLookup[slot] != 0)
+				slot = (slot + 1) & mask;
+
+			mIdentifierLookup[slot] = idx + 1;
+		}
+
+		IdentifierEntry& entry = mIdentifiers[idx];
+		if(!entry.active)
+		{
+			entry.active = true;
+			mNumStrings++;
+		}
+
+		return idx;
+	}
+
+	void StringTable::growLookup()
+	{
+		const UINT32 newSize = mIdentifierLookup.empty() ? INITIAL_LOOKUP_SIZE : (UINT32)mIdentifierLookup.size() * 2;
+		const UINT32 mask = newSize - 1;
+
+		mIdentifierLookup.clear();
+		mIdentifierLookup.resize(newSize, 0);
+
+		for(UINT32 i = 0; i < (UINT32)mIdentifiers.size(); i++)
+		{
+			UINT32 slot = mIdentifiers[i].hash & mask;
+			while(mIdentifierLookup[slot] != 0)
+				slot = (slot + 1) & mask;
+
+			mIdentifierLookup[slot] = i + 1;
+		}
 	}
 
 	bool StringTable::contains(const String& identifier)
 	{
-		return mIdentifiers.find(identifier) == mIdentifiers.end();
+		const UINT32 idx = findIdentifier(identifier);
+		return idx != INVALID_IDENTIFIER && mIdentifiers[idx].active;
 	}
 
 	Vector<String> StringTable::getIdentifiers() const
 	{
 		Vector<String> output;
+		output.reserve(mNumStrings);
+
 		for (auto& entry : mIdentifiers)
-			output.push_back(entry);
+		{
+			if(entry.active)
+				output.push_back(entry.name);
+		}
 
 		return output;
 	}
 
 	void StringTable::setString(const String& identifier, Language language, const String& value)
 	{
-		LanguageData* curLanguage = &(mAllLanguages[(UINT32)language]);
+		const UINT32 idx = addIdentifier(identifier);
 
-		auto iterFind = curLanguage->strings.find(identifier);
+		Vector<SPtr<LocalizedStringData>>& strings = mAllLanguages[(UINT32)language].strings;
+		if(idx >= (UINT32)strings.size())
+			strings.resize(idx + 1);
 
-		SPtr<LocalizedStringData> stringData;
-		if(iterFind == curLanguage->strings.end())
+		SPtr<LocalizedStringData>& stringData = strings[idx];
+		if(stringData == nullptr)
 		{
 			stringData = bs_shared_ptr_new<LocalizedStringData>();
-			curLanguage->strings[identifier] = stringData;
-		}
-		else
-		{
-			stringData = iterFind->second;
+
+			// Existing strings with this identifier might be referencing data from a different language
+			mVersion++;
 		}
 
-		mIdentifiers.insert(identifier);
 		stringData->updateString(value);
 	}
 
 	String StringTable::getString(const String& identifier, Language language)
 	{
-		LanguageData* curLanguage = &(mAllLanguages[(UINT32)language]);
-
-		auto iterFind = curLanguage->strings.find(identifier);
-		if (iterFind != curLanguage->strings.end())
-			return iterFind->second->string;
+		const UINT32 idx = findIdentifier(identifier);
+		if(idx != INVALID_IDENTIFIER)
+		{
+			const Vector<SPtr<LocalizedStringData>>& strings = mAllLanguages[(UINT32)language].strings;
+			if(idx < (UINT32)strings.size() && strings[idx] != nullptr)
+				return strings[idx]->string;
+		}
 			
 		return identifier;
 	}
 
 	void StringTable::removeString(const String& identifier)
 	{
+		const UINT32 idx = findIdentifier(identifier);
+		if(idx == INVALID_IDENTIFIER || !mIdentifiers[idx].active)
+			return;
+
 		for(UINT32 i = 0; i < (UINT32)Language::Count; i++)
 		{
-			mAllLanguages[i].strings.erase(identifier);
+			Vector<SPtr<LocalizedStringData>>& strings = mAllLanguages[i].strings;
+			if(idx < (UINT32)strings.size())
+				strings[idx] = nullptr;
 		}
 
-		mIdentifiers.erase(identifier);
+		mIdentifiers[idx].active = false;
+		mNumStrings--;
+		mVersion++;
 	}
 
 	SPtr<LocalizedStringData> StringTable::getStringData(const String& identifier, bool insertIfNonExisting)
@@ -250,29 +345,37 @@ namespace bs
 
 	SPtr<LocalizedStringData> StringTable::getStringData(const String& identifier, Language language, bool insertIfNonExisting)
 	{
-		LanguageData* curLanguage = &(mAllLanguages[(UINT32)language]);
-
-		auto iterFind = curLanguage->strings.find(identifier);
-		if(iterFind != curLanguage->strings.end())
-			return iterFind->second;
-
-		auto defaultIterFind = mDefaultLanguageData->strings.find(identifier);
-		if(defaultIterFind != mDefaultLanguageData->strings.end())
-			return defaultIterFind->second;
+		const UINT32 idx = findIdentifier(identifier);
+		if(idx != INVALID_IDENTIFIER)
+		{
+			SPtr<LocalizedStringData> stringData = getStringData(idx, language);
+			if(stringData != nullptr)
+				return stringData;
+		}
 
 		if(insertIfNonExisting)
 		{
 			setString(identifier, DEFAULT_LANGUAGE, identifier);
-
-			auto defaultIterFind = mDefaultLanguageData->strings.find(identifier);
-			if(defaultIterFind != mDefaultLanguageData->strings.end())
-				return defaultIterFind->second;
+			return getStringData(findIdentifier(identifier), DEFAULT_LANGUAGE);
 		}
 
 		BS_EXCEPT(InvalidParametersException, "There is no string data for the provided identifier.");
 		return nullptr;
 	}
 
+	SPtr<LocalizedStringData> StringTable::getStringData(UINT32 identifierIdx, Language language) const
+	{
+		const Vector<SPtr<LocalizedStringData>>& strings = mAllLanguages[(UINT32)language].strings;
+		if(identifierIdx < (UINT32)strings.size() && strings[identifierIdx] != nullptr)
+			return strings[identifierIdx];
+
+		const Vector<SPtr<LocalizedStringData>>& defaultStrings = mAllLanguages[(UINT32)DEFAULT_LANGUAGE].strings;
+		if(identifierIdx < (UINT32)defaultStrings.size())
+			return defaultStrings[identifierIdx];
+
+		return nullptr;
+	}
+
 	HStringTable StringTable::create()
 	{
 		return static_resource_cast<StringTable>(gResources()._createResourceHandle(_createPtr()));
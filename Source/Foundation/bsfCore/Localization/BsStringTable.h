@@ -241,12 +241,21 @@ namespace bs
 		void updateString(const String& string);
 	};
 
-	/** Data for a single language in the string table. */
+	/** Data for a single language in the string table, in the form it is serialized in. */
 	struct LanguageData
 	{
 		UnorderedMap<String, SPtr<LocalizedStringData>> strings;
 	};
 
+	/** 
+	 * Strings for a single language in the string table, indexed by the identifier index. Entries for identifiers
+	 * without a translation in the language are null. Empty until the first string for the language is added.
+	 */
+	struct LanguageStrings
+	{
+		Vector<SPtr<LocalizedStringData>> strings;
+	};
+
 	/** @} */
 	/** @addtogroup Localization
 	 *  @{
@@ -272,7 +281,7 @@ namespace bs
 
 		/** Returns a total number of strings in the table. */
 		BS_SCRIPT_EXPORT(n:NumStrings,pr:getter)
-		UINT32 getNumStrings() const { return (UINT32)mIdentifiers.size(); }
+		UINT32 getNumStrings() const { return mNumStrings; }
 
 		/** Returns all identifiers that the string table contains localized strings for. */
 		BS_SCRIPT_EXPORT(n:Identifiers,pr:getter)
@@ -335,19 +344,57 @@ namespace bs
 		friend class HString;
 		friend class StringTableManager;
 
+		/** Information about a single identifier in the string table. */
+		struct IdentifierEntry
+		{
+			String name;
+			UINT32 hash;
+			bool active;
+		};
+
+		/** Value returned by findIdentifier() when the identifier isn't in the table. */
+		static constexpr UINT32 INVALID_IDENTIFIER = (UINT32)-1;
+
 		/** Gets the currently active language. */
 		Language getActiveLanguage() const { return mActiveLanguage; }
 
 		/** Changes the currently active language. Any newly created strings will use this value. */
 		void setActiveLanguage(Language language);
 
-		Language mActiveLanguage;
-		LanguageData* mActiveLanguageData;
-		LanguageData* mDefaultLanguageData;
+		/** 
+		 * Returns the index of the provided identifier, or INVALID_IDENTIFIER if the identifier was never added to the
+		 * table. Removed identifiers keep their index, so it can be re-used if they are added again.
+		 */
+		UINT32 findIdentifier(const String& identifier) const;
+
+		/** Returns the index of the provided identifier, adding it to the table if it doesn't exist. */
+		UINT32 addIdentifier(const String& identifier);
+
+		/** Doubles the size of the identifier lookup table, and re-inserts all the identifiers. */
+		void growLookup();
+
+		/** 
+		 * Returns the string data for the identifier with the specified index in the provided language. Falls back to
+		 * the default language if no translation exists. Returns null if there is no data for the identifier.
+		 */
+		SPtr<LocalizedStringData> getStringData(UINT32 identifierIdx, Language language) const;
 
-		LanguageData* mAllLanguages;
+		/**
+		 * Returns a counter that increments whenever the string data returned by getStringData() might change for an
+		 * identifier, due to language change or added or removed translations. Allows HString to only look up its
+		 * string data again when required.
+		 */
+		UINT32 getVersion() const { return mVersion; }
 
-		UnorderedSet<String> mIdentifiers;
+		Language mActiveLanguage;
+		LanguageStrings* mAllLanguages;
+
+		// Identifiers, indexed by identifier index, and an open addressing hash table mapping identifier names to their
+		// indices (offset by one, zero marks an empty slot)
+		Vector<IdentifierEntry> mIdentifiers;
+		Vector<UINT32> mIdentifierLookup;
+		UINT32 mNumStrings = 0;
+		UINT32 mVersion = 0;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
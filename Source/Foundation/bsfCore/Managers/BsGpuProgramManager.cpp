@@ -2,6 +2,9 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Managers/BsGpuProgramManager.h"
 #include "RenderAPI/BsRenderAPI.h"
+#include "FileSystem/BsFileSystem.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Utility/BsUUID.h"
 
 namespace bs
 {
@@ -145,8 +148,71 @@ namespace bs
 
 	SPtr<GpuProgramBytecode> GpuProgramManager::compileBytecode(const GPU_PROGRAM_DESC& desc)
 	{
-		GpuProgramFactory* factory = getFactory(desc.language);
-		return factory->compileBytecode(desc);
+		GpuProgramFactory* factory;
+		Path cacheDir;
+		{
+			Lock lock(mMutex);
+
+			factory = getFactory(desc.language);
+			cacheDir = mBytecodeCacheDir;
+		}
+
+		const String compilerSignature = factory->getCompilerSignature();
+		if (cacheDir.isEmpty() || compilerSignature.empty())
+			return factory->compileBytecode(desc);
+
+		Path entryPath = cacheDir;
+		entryPath.append(getBytecodeKey(desc, compilerSignature) + ".bytecode");
+
+		if (FileSystem::isFile(entryPath))
+		{
+			FileDecoder fs(entryPath);
+			SPtr<IReflectable> object = fs.decode();
+			if (object != nullptr && object->isDerivedFrom(GpuProgramBytecode::getRTTIStatic()))
+				return std::static_pointer_cast<GpuProgramBytecode>(object);
+
+			LOGWRN("Ignoring a corrupt bytecode cache entry: \"" + entryPath.toString() + "\".");
+		}
+
+		SPtr<GpuProgramBytecode> bytecode = factory->compileBytecode(desc);
+
+		// Failed compilations aren't cached, as they need to output relevant error messages on every attempt
+		if (bytecode == nullptr || bytecode->instructions.size == 0)
+			return bytecode;
+
+		if (!FileSystem::exists(cacheDir))
+			FileSystem::createDir(cacheDir);
+
+		// Write to a temporary file first, so other threads or machines never see a partially written entry
+		Path tempPath = cacheDir;
+		tempPath.append(UUIDGenerator::generateRandom().toString() + ".tmp");
+
+		{
+			FileEncoder fs(tempPath);
+			fs.encode(bytecode.get());
+		}
+
+		FileSystem::move(tempPath, entryPath, true);
+		return bytecode;
+	}
+
+	void GpuProgramManager::setBytecodeCacheDirectory(const Path& path)
+	{
+		Lock lock(mMutex);
+		mBytecodeCacheDir = path;
+	}
+
+	Path GpuProgramManager::getBytecodeCacheDirectory() const
+	{
+		Lock lock(mMutex);
+		return mBytecodeCacheDir;
+	}
+
+	String GpuProgramManager::getBytecodeKey(const GPU_PROGRAM_DESC& desc, const String& compilerSignature)
+	{
+		// Source is hashed separately so the key parts can't run into each other
+		return md5(md5(desc.source) + "_" + desc.language + "_" + desc.entryPoint + "_" + toString((UINT32)desc.type) + 
+			"_" + toString(desc.requiresAdjacency) + "_" + compilerSignature);
 	}
 	}
 }
@@ -49,6 +49,13 @@ namespace bs
 
 		/** @copydoc GpuProgram::compileBytecode */
 		virtual SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc) = 0;
+
+		/** 
+		 * Returns a string identifying the compiler used by compileBytecode(), including its version and any settings that
+		 * affect its output. Used as a part of the key for caching compiled bytecode. Returns an empty string if the 
+		 * bytecode shouldn't be cached (for example if compilation is cheaper than reading the cache).
+		 */
+		virtual String getCompilerSignature() const { return StringUtil::BLANK; }
 	};
 
 	/**
@@ -81,9 +88,30 @@ namespace bs
 		/** @copydoc GpuProgram::create */
 		SPtr<GpuProgram> create(const GPU_PROGRAM_DESC& desc, GpuDeviceFlags deviceMask = GDF_DEFAULT);
 
-		/** @copydoc GpuProgram::compileBytecode */
+		/** 
+		 * @copydoc GpuProgram::compileBytecode 
+		 *
+		 * @note	Thread safe.
+		 */
 		SPtr<GpuProgramBytecode> compileBytecode(const GPU_PROGRAM_DESC& desc);
 
+		/**
+		 * Sets a folder in which compiled bytecode is cached. When set, compileBytecode() will first look for bytecode
+		 * compiled from the same source, using the same compiler, and only compile the program if one isn't found. Entries
+		 * are keyed purely by contents so the folder can be shared between machines. Set an empty path to disable the
+		 * cache (default).
+		 *
+		 * @note	Thread safe.
+		 */
+		void setBytecodeCacheDirectory(const Path& path);
+
+		/** 
+		 * Returns the folder in which compiled bytecode is cached, or an empty path if caching is disabled. 
+		 *
+		 * @note	Thread safe.
+		 */
+		Path getBytecodeCacheDirectory() const;
+
 	protected:
 		friend class bs::GpuProgram;
 
@@ -97,8 +125,15 @@ namespace bs
 		/** Attempts to find a factory for the specified language. Returns null if it cannot find one. */
 		GpuProgramFactory* getFactory(const String& language);
 
+		/** 
+		 * Generates a key uniquely identifying the bytecode that would be output by compiling the program described by
+		 * @p desc, with a compiler with the provided signature.
+		 */
+		static String getBytecodeKey(const GPU_PROGRAM_DESC& desc, const String& compilerSignature);
+
 	protected:
-		Mutex mMutex;
+		mutable Mutex mMutex;
+		Path mBytecodeCacheDir;
 
 		UnorderedMap<String, GpuProgramFactory*> mFactories;
 		GpuProgramFactory* mNullFactory; /**< Factory for dealing with GPU programs that can't be created. */
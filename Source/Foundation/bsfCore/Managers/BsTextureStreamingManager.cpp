@@ -0,0 +1,290 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Managers/BsTextureStreamingManager.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTime.h"
+
+namespace bs
+{
+	TextureStreamingData::TextureStreamingData(const TEXTURE_DESC& desc, const SPtr<DataStream>& source,
+		size_t sourceOffset, PixelFormat sourceFormat)
+		: desc(desc), mSource(source), mSourceOffset(sourceOffset), mSourceFormat(sourceFormat)
+	{
+		baseMip = desc.numMips;
+		for (UINT32 i = 0; i <= desc.numMips; i++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, i, width, height, depth);
+
+			if (width <= MIN_RESIDENT_SIZE && height <= MIN_RESIDENT_SIZE)
+			{
+				baseMip = i;
+				break;
+			}
+		}
+
+		residentMip = baseMip;
+	}
+
+	SPtr<PixelData> TextureStreamingData::readSurface(UINT32 face, UINT32 mip) const
+	{
+		UINT32 width, height, depth;
+		PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, mip, width, height, depth);
+
+		SPtr<PixelData> data = PixelData::create(width, height, depth, mSourceFormat);
+		{
+			Lock lock(mSourceMutex);
+
+			mSource->seek(mSourceOffset + getSurfaceOffset(face, mip));
+			mSource->read(data->getData(), data->getConsecutiveSize());
+		}
+
+		if (mSourceFormat == desc.format)
+			return data;
+
+		SPtr<PixelData> convertedData = PixelData::create(width, height, depth, desc.format);
+		PixelUtil::bulkPixelConversion(*data, *convertedData);
+
+		return convertedData;
+	}
+
+	UINT32 TextureStreamingData::getMipForScreenSize(float screenSize) const
+	{
+		if (screenSize <= 0.0f)
+			return baseMip;
+
+		const float size = (float)std::max(desc.width, desc.height);
+		const float mip = std::log2(size / screenSize);
+		if (mip <= 0.0f)
+			return 0;
+
+		return std::min((UINT32)mip, baseMip);
+	}
+
+	void TextureStreamingData::requestMip(UINT32 mip)
+	{
+		UINT32 current = requestedMip.load(std::memory_order_relaxed);
+		while (mip < current && !requestedMip.compare_exchange_weak(current, mip, std::memory_order_relaxed))
+		{ }
+	}
+
+	UINT64 TextureStreamingData::getMemorySize(UINT32 firstMip, UINT32 lastMip) const
+	{
+		UINT64 size = 0;
+		for (UINT32 i = firstMip; i < lastMip; i++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, i, width, height, depth);
+
+			size += PixelUtil::getMemorySize(width, height, depth, desc.format);
+		}
+
+		const TextureProperties props(desc);
+		return size * props.getNumFaces();
+	}
+
+	size_t TextureStreamingData::getSurfaceOffset(UINT32 face, UINT32 mip) const
+	{
+		size_t offset = 0;
+		size_t faceSize = 0;
+		for (UINT32 i = 0; i <= desc.numMips; i++)
+		{
+			UINT32 width, height, depth;
+			PixelUtil::getSizeForMipLevel(desc.width, desc.height, desc.depth, i, width, height, depth);
+
+			const UINT32 mipSize = PixelUtil::getMemorySize(width, height, depth, mSourceFormat);
+			if (i < mip)
+				offset += mipSize;
+
+			faceSize += mipSize;
+		}
+
+		return face * faceSize + offset;
+	}
+
+	TextureStreamingManager::~TextureStreamingManager()
+	{
+		for (auto& entry : mTextures)
+		{
+			if (entry.second.load != nullptr)
+				entry.second.load->task->wait();
+		}
+	}
+
+	void TextureStreamingManager::_registerTexture(Texture* texture)
+	{
+		const TextureStreamingData& data = *texture->_getStreamingData();
+
+		StreamedTexture& entry = mTextures[texture];
+		entry.texture = texture;
+		entry.desiredMip = data.residentMip;
+		entry.lastUsedFrame = gTime().getFrameIdx();
+
+		mMemoryUsage += data.getMemorySize(data.residentMip, data.desc.numMips + 1);
+	}
+
+	void TextureStreamingManager::_unregisterTexture(Texture* texture)
+	{
+		auto iterFind = mTextures.find(texture);
+		if (iterFind == mTextures.end())
+			return;
+
+		StreamedTexture& entry = iterFind->second;
+		if (entry.load != nullptr)
+		{
+			entry.load->task->wait();
+
+			mMemoryUsage -= entry.load->reservedMemory;
+			mNumActiveLoads--;
+		}
+
+		const TextureStreamingData& data = *texture->_getStreamingData();
+		mMemoryUsage -= data.getMemorySize(data.residentMip, data.desc.numMips + 1);
+
+		mTextures.erase(iterFind);
+	}
+
+	void TextureStreamingManager::_update()
+	{
+		const UINT64 frameIdx = gTime().getFrameIdx();
+
+		bs_frame_mark();
+		{
+			// Apply finished loads and gather the requests the renderer made since the last update
+			FrameVector<StreamedTexture*> toLoad;
+			for (auto& entry : mTextures)
+			{
+				StreamedTexture& streamed = entry.second;
+				TextureStreamingData& data = *streamed.texture->_getStreamingData();
+
+				if (streamed.load != nullptr && streamed.load->task->isComplete())
+				{
+					mMemoryUsage -= streamed.load->reservedMemory;
+					mNumActiveLoads--;
+
+					setResidentMip(streamed, streamed.load->mip, streamed.load->surfaces);
+					streamed.load = nullptr;
+				}
+
+				const UINT32 requestedMip = data.requestedMip.exchange(TextureStreamingData::NO_REQUEST);
+				if (requestedMip != TextureStreamingData::NO_REQUEST)
+				{
+					streamed.desiredMip = requestedMip;
+					streamed.lastUsedFrame = frameIdx;
+				}
+
+				const bool recentlyUsed = frameIdx - streamed.lastUsedFrame <= EVICTION_DELAY;
+				if (streamed.load == nullptr && recentlyUsed && streamed.desiredMip < data.residentMip)
+					toLoad.push_back(&streamed);
+			}
+
+			// Load textures used most recently first, and among those the ones missing the most detail
+			std::sort(toLoad.begin(), toLoad.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+			{
+				if (a->lastUsedFrame != b->lastUsedFrame)
+					return a->lastUsedFrame > b->lastUsedFrame;
+
+				const UINT32 missingA = a->texture->_getStreamingData()->residentMip - a->desiredMip;
+				const UINT32 missingB = b->texture->_getStreamingData()->residentMip - b->desiredMip;
+				return missingA > missingB;
+			});
+
+			for (auto& streamed : toLoad)
+			{
+				if (mNumActiveLoads >= MAX_CONCURRENT_LOADS)
+					break;
+
+				const SPtr<TextureStreamingData>& data = streamed->texture->_getStreamingData();
+				const UINT64 requiredMemory = data->getMemorySize(streamed->desiredMip, data->residentMip);
+
+				if (mMemoryUsage + requiredMemory > mMemoryBudget)
+				{
+					evict(mMemoryUsage + requiredMemory - mMemoryBudget, frameIdx);
+
+					// Smaller textures might still fit
+					if (mMemoryUsage + requiredMemory > mMemoryBudget)
+						continue;
+				}
+
+				const UINT32 numFaces = streamed->texture->getProperties().getNumFaces();
+				const UINT32 lastMip = data->residentMip;
+
+				SPtr<MipLoad> load = bs_shared_ptr_new<MipLoad>();
+				load->mip = streamed->desiredMip;
+				load->reservedMemory = requiredMemory;
+				load->surfaces.resize(numFaces * (lastMip - load->mip));
+
+				// Entry waits on the task before the load is released, so it's safe to reference it directly
+				MipLoad* loadPtr = load.get();
+				SPtr<TextureStreamingData> dataPtr = data;
+				load->task = Task::create("TextureStreaming", [loadPtr, dataPtr, numFaces, lastMip]()
+				{
+					UINT32 idx = 0;
+					for (UINT32 face = 0; face < numFaces; face++)
+					{
+						for (UINT32 mip = loadPtr->mip; mip < lastMip; mip++)
+							loadPtr->surfaces[idx++] = dataPtr->readSurface(face, mip);
+					}
+				});
+
+				TaskScheduler::instance().addTask(load->task);
+
+				streamed->load = load;
+				mMemoryUsage += requiredMemory;
+				mNumActiveLoads++;
+			}
+		}
+		bs_frame_clear();
+	}
+
+	void TextureStreamingManager::setResidentMip(StreamedTexture& entry, UINT32 mip,
+		const Vector<SPtr<PixelData>>& surfaces)
+	{
+		const TextureStreamingData& data = *entry.texture->_getStreamingData();
+		const UINT32 numMips = data.desc.numMips + 1;
+
+		mMemoryUsage -= data.getMemorySize(data.residentMip, numMips);
+		entry.texture->_setResidentMip(mip, surfaces);
+		mMemoryUsage += data.getMemorySize(data.residentMip, numMips);
+	}
+
+	void TextureStreamingManager::evict(UINT64 requiredMemory, UINT64 frameIdx)
+	{
+		bs_frame_mark();
+		{
+			FrameVector<StreamedTexture*> candidates;
+			for (auto& entry : mTextures)
+			{
+				StreamedTexture& streamed = entry.second;
+				if (streamed.load != nullptr)
+					continue;
+
+				// Textures that weren't used recently can drop all their streamed mip levels, while others can only
+				// drop the mip levels more detailed than they currently need
+				if (frameIdx - streamed.lastUsedFrame > EVICTION_DELAY)
+					streamed.desiredMip = streamed.texture->_getStreamingData()->baseMip;
+
+				if (streamed.desiredMip > streamed.texture->_getStreamingData()->residentMip)
+					candidates.push_back(&streamed);
+			}
+
+			std::sort(candidates.begin(), candidates.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+			{
+				return a->lastUsedFrame < b->lastUsedFrame;
+			});
+
+			const UINT64 targetUsage = mMemoryUsage > requiredMemory ? mMemoryUsage - requiredMemory : 0;
+			for (auto& streamed : candidates)
+			{
+				if (mMemoryUsage <= targetUsage)
+					break;
+
+				setResidentMip(*streamed, streamed->desiredMip, Vector<SPtr<PixelData>>());
+			}
+		}
+		bs_frame_clear();
+	}
+}
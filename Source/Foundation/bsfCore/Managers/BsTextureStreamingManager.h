@@ -0,0 +1,171 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Image/BsTexture.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Information about a texture whose mip levels are streamed in on demand. Shared between the sim and core thread
+	 * versions of the texture.
+	 */
+	struct BS_CORE_EXPORT TextureStreamingData
+	{
+		/** Value of @p requestedMip when no mip level was requested since the last update. */
+		static constexpr UINT32 NO_REQUEST = (UINT32)-1;
+
+		/** Mip levels with both dimensions equal or smaller than this are always resident. */
+		static constexpr UINT32 MIN_RESIDENT_SIZE = 64;
+
+		/**
+		 * @param[in]	desc			Descriptor of the complete texture, including all of its mip levels.
+		 * @param[in]	source			Stream containing the data of all the texture surfaces, one after another. Faces
+		 *								are stored in order, and each face stores its mip levels in order starting with
+		 *								the most detailed one.
+		 * @param[in]	sourceOffset	Offset in the stream at which the data of the first surface starts.
+		 * @param[in]	sourceFormat	Format the surfaces are stored in. If not equal to the format in @p desc the
+		 *								surfaces are converted when read.
+		 */
+		TextureStreamingData(const TEXTURE_DESC& desc, const SPtr<DataStream>& source, size_t sourceOffset,
+			PixelFormat sourceFormat);
+
+		/**
+		 * Reads the data of a single surface from the source stream.
+		 *
+		 * @note	Thread safe.
+		 */
+		SPtr<PixelData> readSurface(UINT32 face, UINT32 mip) const;
+
+		/**
+		 * Returns the most detailed mip level needed to display the texture without undersampling, when covering the
+		 * specified number of pixels on screen. Assumes the texture spans the object once.
+		 */
+		UINT32 getMipForScreenSize(float screenSize) const;
+
+		/**
+		 * Registers a request from the renderer to make the specified mip level resident. If multiple requests are made
+		 * the most detailed mip level is kept.
+		 *
+		 * @note	Thread safe.
+		 */
+		void requestMip(UINT32 mip);
+
+		/** Returns the number of bytes used by mip levels in range [@p firstMip, @p lastMip), for all faces. */
+		UINT64 getMemorySize(UINT32 firstMip, UINT32 lastMip) const;
+
+		/** Descriptor of the complete texture, including mip levels that aren't resident. */
+		TEXTURE_DESC desc;
+
+		/** Most detailed of the always resident mip levels. Only mip levels more detailed than this are streamed. */
+		UINT32 baseMip = 0;
+
+		/** Most detailed mip level currently resident on the GPU. Sim thread only. */
+		UINT32 residentMip = 0;
+
+		/**
+		 * Most detailed mip level requested by the renderer since the last streaming manager update, or NO_REQUEST
+		 * if the texture wasn't used.
+		 */
+		std::atomic<UINT32> requestedMip { NO_REQUEST };
+
+	private:
+		/** Returns the offset of the specified surface, relative to the start of the surface data in the source. */
+		size_t getSurfaceOffset(UINT32 face, UINT32 mip) const;
+
+		SPtr<DataStream> mSource;
+		size_t mSourceOffset;
+		PixelFormat mSourceFormat;
+		mutable Mutex mSourceMutex;
+	};
+
+	/**
+	 * Keeps track of textures with streaming enabled, and manages which of their mip levels are resident on the GPU.
+	 * Higher mip levels are loaded on worker threads as the renderer requests them, and mip levels that are no longer
+	 * being used are evicted when the memory budget is exceeded.
+	 */
+	class BS_CORE_EXPORT TextureStreamingManager : public Module<TextureStreamingManager>
+	{
+	public:
+		/** Default amount of memory streamed textures are allowed to use, on each GPU device. */
+		static constexpr UINT64 DEFAULT_MEMORY_BUDGET = 1024 * 1024 * 1024;
+
+		/** Number of frames a texture needs to go unused before its mip levels can be evicted. */
+		static constexpr UINT32 EVICTION_DELAY = 60;
+
+		/** Maximum number of textures that can be loading their mip levels at once. */
+		static constexpr UINT32 MAX_CONCURRENT_LOADS = 4;
+
+		~TextureStreamingManager();
+
+		/**
+		 * Determines how much memory can streamed textures use, in bytes. The budget applies to each GPU device
+		 * separately, since textures are created on every device.
+		 */
+		void setMemoryBudget(UINT64 budget) { mMemoryBudget = budget; }
+
+		/** @copydoc setMemoryBudget */
+		UINT64 getMemoryBudget() const { return mMemoryBudget; }
+
+		/** Returns the amount of memory currently used by resident mip levels of streamed textures, in bytes. */
+		UINT64 getMemoryUsage() const { return mMemoryUsage; }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Starts managing the mip levels of the provided texture. Texture must have streaming data. */
+		void _registerTexture(Texture* texture);
+
+		/** Stops managing the mip levels of the provided texture. Waits for any in-progress loads to finish. */
+		void _unregisterTexture(Texture* texture);
+
+		/**
+		 * Processes mip requests made by the renderer, starting new loads and evicting mip levels as needed, and applies
+		 * the results of finished loads. Must be called once per frame, before the core objects are synced.
+		 */
+		void _update();
+
+		/** @} */
+	private:
+		/** Mip levels of a texture being loaded on a worker thread. */
+		struct MipLoad
+		{
+			UINT32 mip = 0;
+			UINT64 reservedMemory = 0;
+			Vector<SPtr<PixelData>> surfaces;
+			SPtr<Task> task;
+		};
+
+		/** Information about a texture managed by the streaming manager. */
+		struct StreamedTexture
+		{
+			Texture* texture = nullptr;
+			UINT32 desiredMip = 0;
+			UINT64 lastUsedFrame = 0;
+			SPtr<MipLoad> load;
+		};
+
+		/** Changes the resident mip levels of the texture, and updates the memory usage. */
+		void setResidentMip(StreamedTexture& entry, UINT32 mip, const Vector<SPtr<PixelData>>& surfaces);
+
+		/**
+		 * Evicts mip levels of textures that are not needed, starting with the ones unused the longest, until the
+		 * requested amount of memory is available or nothing else can be evicted.
+		 */
+		void evict(UINT64 requiredMemory, UINT64 frameIdx);
+
+		UnorderedMap<Texture*, StreamedTexture> mTextures;
+		UINT32 mNumActiveLoads = 0;
+		UINT64 mMemoryBudget = DEFAULT_MEMORY_BUDGET;
+		UINT64 mMemoryUsage = 0;
+	};
+
+	/** @} */
+}
@@ -600,6 +600,7 @@ namespace bs
 						paramInfo.paramIdx = paramIdx;
 						paramInfo.blockIdx = globalBlockIdx;
 						paramInfo.offset = dataParam.second.cpuMemOffset;
+						paramInfo.isAnimated = false;
 					}
 				}
 			}
@@ -701,6 +702,7 @@ namespace bs
 
 			ObjectParamInfo* objInfos = (ObjectParamInfo*)(mPassParamInfos + numPasses);
 			memcpy(objInfos, objParamInfos.data(), totalNumObjects * sizeof(ObjectParamInfo));
+			mObjectParamInfos = objInfos;
 
 			UINT32 objInfoOffset = 0;
 
@@ -755,6 +757,49 @@ namespace bs
 				}
 			}
 
+			// Map each material parameter to all the GPU parameters it is used by, so the update only needs to visit
+			// the dirty parameters
+			FrameVector<std::pair<UINT32, ParamRef>> paramRefs;
+			for (UINT32 i = 0; i < (UINT32)mDataParamInfos.size(); i++)
+				paramRefs.push_back(std::make_pair(mDataParamInfos[i].paramIdx, ParamRef{ ParamRefType::Data, 0, i }));
+
+			for (UINT32 i = 0; i < numPasses; i++)
+			{
+				for (UINT32 j = 0; j < NUM_STAGES; j++)
+				{
+					const StageParamInfo& stage = stageInfos[i * NUM_STAGES + j];
+
+					auto addRefs = [&](ObjectParamInfo* entries, UINT32 numEntries, ParamRefType type)
+					{
+						for (UINT32 k = 0; k < numEntries; k++)
+						{
+							const auto idx = (UINT32)(entries + k - objInfos);
+							paramRefs.push_back(std::make_pair(entries[k].paramIdx, ParamRef{ type, i, idx }));
+						}
+					};
+
+					addRefs(stage.textures, stage.numTextures, ParamRefType::Texture);
+					addRefs(stage.loadStoreTextures, stage.numLoadStoreTextures, ParamRefType::LoadStoreTexture);
+					addRefs(stage.buffers, stage.numBuffers, ParamRefType::Buffer);
+					addRefs(stage.samplerStates, stage.numSamplerStates, ParamRefType::SamplerState);
+				}
+			}
+
+			std::stable_sort(paramRefs.begin(), paramRefs.end(),
+				[](const auto& a, const auto& b) { return a.first < b.first; });
+
+			const UINT32 numMaterialParams = params->getNumParams();
+			mParamRefOffsets.resize(numMaterialParams + 1, 0);
+			mParamRefs.reserve(paramRefs.size());
+			for (auto& entry : paramRefs)
+			{
+				mParamRefOffsets[entry.first + 1]++;
+				mParamRefs.push_back(entry.second);
+			}
+
+			for (UINT32 i = 0; i < numMaterialParams; i++)
+				mParamRefOffsets[i + 1] += mParamRefOffsets[i];
+
 			// Determine on which passes & stages are buffers used on
 			for (auto& block : mBlocks)
 			{
@@ -884,263 +929,323 @@ namespace bs
 	template<bool Core>
 	void TGpuParamsSet<Core>::update(const SPtr<MaterialParamsType>& params, float t, bool updateAll)
 	{
-		// Note: Instead of iterating over every single parameter, it might be more efficient for @p params to keep
-		// a ring buffer and a version number. Then we could just iterate over the ring buffer and only access dirty
-		// parameters. If the version number is too high (larger than ring buffer can store), then we force update for all.
+		const UINT64 paramVersion = params->getParamVersion();
 
-		// Update data params
-		for(auto& paramInfo : mDataParamInfos)
+		// Parameters changed since the last update are normally found through the dirty parameter ring. If too many
+		// changes were made since then (or the parameters object changed), fall back to checking every parameter.
+		const bool fullUpdate = updateAll || params.get() != mLastParams || !params->isInDirtyRing(mParamVersion);
+		if(fullUpdate)
 		{
-			ParamBlockPtrType paramBlock = mBlocks[paramInfo.blockIdx].buffer;
-			if (paramBlock == nullptr || !mBlocks[paramInfo.blockIdx].allowUpdate)
-				continue;
-
-			const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-			UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
-			
-			bool isAnimated = false;
-			for(UINT32 i = 0; i < arraySize; i++)
+			for(UINT32 i = 0; i < (UINT32)mDataParamInfos.size(); i++)
 			{
-				isAnimated = params->isAnimated(*materialParamInfo, i);
-				if(isAnimated)
-					break;
+				const DataParamInfo& paramInfo = mDataParamInfos[i];
+				const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+				if (materialParamInfo->version <= mParamVersion && !updateAll && params.get() == mLastParams)
+					continue;
+
+				updateAnimatedState(*params, i);
+				if(!paramInfo.isAnimated)
+					updateDataParam(*params, paramInfo, t);
 			}
 
-			if (materialParamInfo->version <= mParamVersion && !updateAll && !isAnimated)
-				continue;
+			for(auto& ref : mParamRefs)
+			{
+				if(ref.type == ParamRefType::Data)
+					continue;
 
-			const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[(int)materialParamInfo->dataType];
-			UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
+				const ObjectParamInfo& paramInfo = mObjectParamInfos[ref.idx];
+				const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
+				if (materialParamInfo->version <= mParamVersion && !updateAll && params.get() == mLastParams)
+					continue;
 
-			UINT8* data = params->getData(materialParamInfo->index);
-			if(!isAnimated)
+				updateObjectParam(*params, ref);
+			}
+		}
+		else
+		{
+			for(UINT64 version = mParamVersion + 1; version <= paramVersion; version++)
 			{
-				const bool transposeMatrices = ct::RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ColumnMajorMatrices);
-				if (transposeMatrices)
-				{
-					auto writeTransposed = [&](auto& temp)
-					{
-						for (UINT32 i = 0; i < arraySize; i++)
-						{
-							UINT32 arrayOffset = i * paramSize;
-							memcpy(&temp, data + arrayOffset, paramSize);
-							auto transposed = temp.transpose();
+				const UINT32 paramIdx = params->getDirtyParamIndex(version);
 
-							paramBlock->write(paramInfo.offset * sizeof(UINT32) + arrayOffset, &transposed, paramSize);
-						}
-					};
+				// Parameter was modified again later, handle it once at its latest version
+				const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramIdx);
+				if(materialParamInfo->version != version)
+					continue;
 
-					switch (materialParamInfo->dataType)
-					{
-					case GPDT_MATRIX_2X2:
-					{
-						MatrixNxM<2, 2> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_2X3:
-					{
-						MatrixNxM<2, 3> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_2X4:
-					{
-						MatrixNxM<2, 4> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_3X2:
-					{
-						MatrixNxM<3, 2> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_3X3:
-					{
-						Matrix3 matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_3X4:
-					{
-						MatrixNxM<3, 4> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_4X2:
-					{
-						MatrixNxM<4, 2> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_4X3:
-					{
-						MatrixNxM<4, 3> matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					case GPDT_MATRIX_4X4:
-					{
-						Matrix4 matrix;
-						writeTransposed(matrix);
-					}
-					break;
-					default:
+				for(UINT32 i = mParamRefOffsets[paramIdx]; i < mParamRefOffsets[paramIdx + 1]; i++)
+				{
+					const ParamRef& ref = mParamRefs[i];
+					if(ref.type == ParamRefType::Data)
 					{
-						paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
-						break;
-					}
+						updateAnimatedState(*params, ref.idx);
+
+						const DataParamInfo& paramInfo = mDataParamInfos[ref.idx];
+						if(!paramInfo.isAnimated)
+							updateDataParam(*params, paramInfo, t);
 					}
+					else
+						updateObjectParam(*params, ref);
 				}
-				else
-					paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
 			}
-			else // Animated
-			{
-				if(materialParamInfo->dataType == GPDT_FLOAT1)
-				{
-					assert(paramSize == sizeof(float));
+		}
 
-					for (UINT32 i = 0; i < arraySize; i++)
-					{
-						UINT32 arrayOffset = i * paramSize;
-						UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
+		// Animated parameters change with time and are written every update, regardless of their version
+		for(auto& entry : mAnimatedDataParams)
+			updateDataParam(*params, mDataParamInfos[entry], t);
 
-						float value;
-						if(params->isAnimated(*materialParamInfo, i))
-						{
-							const TAnimationCurve<float>& curve = params->template getCurveParam<float>(*materialParamInfo, i);
+		for(auto& entry : mPassParams)
+			entry->_markCoreDirty();
 
-							value = curve.evaluate(t, true);
-						}
-						else
-							memcpy(&value, data + arrayOffset, paramSize);
+		mParamVersion = paramVersion;
+		mLastParams = params.get();
+	}
 
-						paramBlock->write(writeOffset, &value, paramSize);
-					}
-				}
-				else if(materialParamInfo->dataType == GPDT_FLOAT4)
-				{
-					assert(paramSize == sizeof(Rect2));
-					
-					CoreVariantHandleType<SpriteTexture, Core> spriteTexture =
-						params->getOwningSpriteTexture(*materialParamInfo);
+	template<bool Core>
+	void TGpuParamsSet<Core>::updateAnimatedState(const MaterialParamsType& params, UINT32 dataParamIdx)
+	{
+		DataParamInfo& paramInfo = mDataParamInfos[dataParamIdx];
+		const MaterialParams::ParamData* materialParamInfo = params.getParamData(paramInfo.paramIdx);
+		const UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
 
-					UINT32 writeOffset = paramInfo.offset * sizeof(UINT32);
-					Rect2 uv = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
-					if(spriteTexture != nullptr)
-						uv = spriteTexture->evaluate(t);
+		bool isAnimated = false;
+		for(UINT32 i = 0; i < arraySize; i++)
+		{
+			isAnimated = params.isAnimated(*materialParamInfo, i);
+			if(isAnimated)
+				break;
+		}
 
-					paramBlock->write(writeOffset, &uv, paramSize);
+		if(isAnimated == paramInfo.isAnimated)
+			return;
 
-					// Only the first array element receives sprite UVs, the rest are treated as normal
-					if(arraySize > 1)
-					{
-						writeOffset = paramInfo.offset * sizeof(UINT32) + paramSize;
-						paramBlock->write(writeOffset, data + paramSize, paramSize * (arraySize - 1));
-					}
-				}
-				else if(materialParamInfo->dataType == GPDT_COLOR)
+		paramInfo.isAnimated = isAnimated;
+		if(isAnimated)
+			mAnimatedDataParams.push_back(dataParamIdx);
+		else
+		{
+			auto iterFind = std::find(mAnimatedDataParams.begin(), mAnimatedDataParams.end(), dataParamIdx);
+			if(iterFind != mAnimatedDataParams.end())
+			{
+				std::swap(*iterFind, mAnimatedDataParams.back());
+				mAnimatedDataParams.pop_back();
+			}
+		}
+	}
+
+	template<bool Core>
+	void TGpuParamsSet<Core>::updateDataParam(const MaterialParamsType& params, const DataParamInfo& paramInfo, float t)
+	{
+		ParamBlockPtrType paramBlock = mBlocks[paramInfo.blockIdx].buffer;
+		if (paramBlock == nullptr || !mBlocks[paramInfo.blockIdx].allowUpdate)
+			return;
+
+		const MaterialParams::ParamData* materialParamInfo = params.getParamData(paramInfo.paramIdx);
+		UINT32 arraySize = materialParamInfo->arraySize == 0 ? 1 : materialParamInfo->arraySize;
+
+		const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[(int)materialParamInfo->dataType];
+		UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
+
+		UINT8* data = params.getData(materialParamInfo->index);
+		if(!paramInfo.isAnimated)
+		{
+			const bool transposeMatrices = ct::RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ColumnMajorMatrices);
+			if (transposeMatrices)
+			{
+				auto writeTransposed = [&](auto& temp)
 				{
 					for (UINT32 i = 0; i < arraySize; i++)
 					{
-						assert(paramSize == sizeof(Color));
-
 						UINT32 arrayOffset = i * paramSize;
-						UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
-
-						Color value;
-						if(params->isAnimated(*materialParamInfo, i))
-						{
-							const ColorGradient& gradient = params->getColorGradientParam(*materialParamInfo, i);
-
-							const float wrappedT = Math::repeat(t, gradient.getDuration());
-							value = Color::fromRGBA(gradient.evaluate(wrappedT));
-						}
-						else
-							memcpy(&value, data + arrayOffset, paramSize);
+						memcpy(&temp, data + arrayOffset, paramSize);
+						auto transposed = temp.transpose();
 
-						paramBlock->write(writeOffset, &value, paramSize);
+						paramBlock->write(paramInfo.offset * sizeof(UINT32) + arrayOffset, &transposed, paramSize);
 					}
+				};
+
+				switch (materialParamInfo->dataType)
+				{
+				case GPDT_MATRIX_2X2:
+				{
+					MatrixNxM<2, 2> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_2X3:
+				{
+					MatrixNxM<2, 3> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_2X4:
+				{
+					MatrixNxM<2, 4> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_3X2:
+				{
+					MatrixNxM<3, 2> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_3X3:
+				{
+					Matrix3 matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_3X4:
+				{
+					MatrixNxM<3, 4> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_4X2:
+				{
+					MatrixNxM<4, 2> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_4X3:
+				{
+					MatrixNxM<4, 3> matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				case GPDT_MATRIX_4X4:
+				{
+					Matrix4 matrix;
+					writeTransposed(matrix);
+				}
+				break;
+				default:
+				{
+					paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
+					break;
+				}
 				}
 			}
+			else
+				paramBlock->write(paramInfo.offset * sizeof(UINT32), data, paramSize * arraySize);
 		}
-
-		// Update object params
-		const auto numPasses = (UINT32)mPassParams.size();
-
-		for(UINT32 i = 0; i < numPasses; i++)
+		else // Animated
 		{
-			SPtr<GpuParamsType> paramPtr = mPassParams[i];
-
-			for(UINT32 j = 0; j < NUM_STAGES; j++)
+			if(materialParamInfo->dataType == GPDT_FLOAT1)
 			{
-				const StageParamInfo& stageInfo = mPassParamInfos[i].stages[j];
+				assert(paramSize == sizeof(float));
 
-				for(UINT32 k = 0; k < stageInfo.numTextures; k++)
+				for (UINT32 i = 0; i < arraySize; i++)
 				{
-					const ObjectParamInfo& paramInfo = stageInfo.textures[k];
+					UINT32 arrayOffset = i * paramSize;
+					UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+					float value;
+					if(params.isAnimated(*materialParamInfo, i))
+					{
+						const TAnimationCurve<float>& curve = params.template getCurveParam<float>(*materialParamInfo, i);
 
-					TextureSurface surface;
-					TextureType texture;
-					params->getTexture(*materialParamInfo, texture, surface);
+						value = curve.evaluate(t, true);
+					}
+					else
+						memcpy(&value, data + arrayOffset, paramSize);
 
-					paramPtr->setTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
+					paramBlock->write(writeOffset, &value, paramSize);
 				}
+			}
+			else if(materialParamInfo->dataType == GPDT_FLOAT4)
+			{
+				assert(paramSize == sizeof(Rect2));
+				
+				CoreVariantHandleType<SpriteTexture, Core> spriteTexture =
+					params.getOwningSpriteTexture(*materialParamInfo);
 
-				for (UINT32 k = 0; k < stageInfo.numLoadStoreTextures; k++)
-				{
-					const ObjectParamInfo& paramInfo = stageInfo.loadStoreTextures[k];
-
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+				UINT32 writeOffset = paramInfo.offset * sizeof(UINT32);
+				Rect2 uv = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+				if(spriteTexture != nullptr)
+					uv = spriteTexture->evaluate(t);
 
-					TextureSurface surface;
-					TextureType texture;
-					params->getLoadStoreTexture(*materialParamInfo, texture, surface);
+				paramBlock->write(writeOffset, &uv, paramSize);
 
-					paramPtr->setLoadStoreTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
+				// Only the first array element receives sprite UVs, the rest are treated as normal
+				if(arraySize > 1)
+				{
+					writeOffset = paramInfo.offset * sizeof(UINT32) + paramSize;
+					paramBlock->write(writeOffset, data + paramSize, paramSize * (arraySize - 1));
 				}
-
-				for (UINT32 k = 0; k < stageInfo.numBuffers; k++)
+			}
+			else if(materialParamInfo->dataType == GPDT_COLOR)
+			{
+				for (UINT32 i = 0; i < arraySize; i++)
 				{
-					const ObjectParamInfo& paramInfo = stageInfo.buffers[k];
+					assert(paramSize == sizeof(Color));
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+					UINT32 arrayOffset = i * paramSize;
+					UINT32 writeOffset = paramInfo.offset * sizeof(UINT32) + arrayOffset;
 
-					BufferType buffer;
-					params->getBuffer(*materialParamInfo, buffer);
+					Color value;
+					if(params.isAnimated(*materialParamInfo, i))
+					{
+						const ColorGradient& gradient = params.getColorGradientParam(*materialParamInfo, i);
+
+						const float wrappedT = Math::repeat(t, gradient.getDuration());
+						value = Color::fromRGBA(gradient.evaluate(wrappedT));
+					}
+					else
+						memcpy(&value, data + arrayOffset, paramSize);
 
-					paramPtr->setBuffer(paramInfo.setIdx, paramInfo.slotIdx, buffer);
+					paramBlock->write(writeOffset, &value, paramSize);
 				}
+			}
+		}
+	}
 
-				for (UINT32 k = 0; k < stageInfo.numSamplerStates; k++)
-				{
-					const ObjectParamInfo& paramInfo = stageInfo.samplerStates[k];
+	template<bool Core>
+	void TGpuParamsSet<Core>::updateObjectParam(const MaterialParamsType& params, const ParamRef& ref)
+	{
+		const ObjectParamInfo& paramInfo = mObjectParamInfos[ref.idx];
+		const MaterialParams::ParamData* materialParamInfo = params.getParamData(paramInfo.paramIdx);
+		const SPtr<GpuParamsType>& paramPtr = mPassParams[ref.passIdx];
 
-					const MaterialParams::ParamData* materialParamInfo = params->getParamData(paramInfo.paramIdx);
-					if (materialParamInfo->version <= mParamVersion && !updateAll)
-						continue;
+		switch(ref.type)
+		{
+		case ParamRefType::Texture:
+		{
+			TextureSurface surface;
+			TextureType texture;
+			params.getTexture(*materialParamInfo, texture, surface);
 
-					SamplerStateType samplerState;
-					params->getSamplerState(*materialParamInfo, samplerState);
+			paramPtr->setTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
+		}
+			break;
+		case ParamRefType::LoadStoreTexture:
+		{
+			TextureSurface surface;
+			TextureType texture;
+			params.getLoadStoreTexture(*materialParamInfo, texture, surface);
 
-					paramPtr->setSamplerState(paramInfo.setIdx, paramInfo.slotIdx, samplerState);
-				}
-			}
+			paramPtr->setLoadStoreTexture(paramInfo.setIdx, paramInfo.slotIdx, texture, surface);
+		}
+			break;
+		case ParamRefType::Buffer:
+		{
+			BufferType buffer;
+			params.getBuffer(*materialParamInfo, buffer);
 
-			paramPtr->_markCoreDirty();
+			paramPtr->setBuffer(paramInfo.setIdx, paramInfo.slotIdx, buffer);
 		}
+			break;
+		case ParamRefType::SamplerState:
+		{
+			SamplerStateType samplerState;
+			params.getSamplerState(*materialParamInfo, samplerState);
 
-		mParamVersion = params->getParamVersion();
+			paramPtr->setSamplerState(paramInfo.setIdx, paramInfo.slotIdx, samplerState);
+		}
+			break;
+		default:
+			break;
+		}
 	}
 
 	template class TGpuParamsSet <false>;
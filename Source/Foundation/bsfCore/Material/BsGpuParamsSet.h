@@ -69,6 +69,7 @@ namespace bs
 			UINT32 paramIdx;
 			UINT32 blockIdx;
 			UINT32 offset;
+			bool isAnimated;
 		};
 
 		/** Information about how an object parameter maps from a material parameter to a GPU stage slot. */
@@ -98,6 +99,20 @@ namespace bs
 			StageParamInfo stages[GPT_COUNT];
 		};
 
+		/** Types of GPU parameters a material parameter can map to. */
+		enum class ParamRefType
+		{
+			Data, Texture, LoadStoreTexture, Buffer, SamplerState
+		};
+
+		/** Reference to a single GPU parameter a material parameter maps to. */
+		struct ParamRef
+		{
+			ParamRefType type;
+			UINT32 passIdx;
+			UINT32 idx; /**< Index into mDataParamInfos for data parameters, or into mObjectParamInfos otherwise. */
+		};
+
 	public:
 		TGpuParamsSet() {}
 		TGpuParamsSet(const SPtr<TechniqueType>& technique, const ShaderType& shader,
@@ -170,10 +185,31 @@ namespace bs
 	private:
 		template<bool Core2> friend class TMaterial;
 
+		/** Writes a data parameter into its parameter block. Animated parameters are evaluated at time @p t. */
+		void updateDataParam(const MaterialParamsType& params, const DataParamInfo& paramInfo, float t);
+
+		/** Assigns the object parameter referenced by @p ref to its GpuParams. */
+		void updateObjectParam(const MaterialParamsType& params, const ParamRef& ref);
+
+		/**
+		 * Updates the animated state of the data parameter at the provided index, adding or removing it from the list
+		 * of animated parameters if it changed.
+		 */
+		void updateAnimatedState(const MaterialParamsType& params, UINT32 dataParamIdx);
+
 		Vector<SPtr<GpuParamsType>> mPassParams;
 		Vector<BlockInfo> mBlocks;
 		Vector<DataParamInfo> mDataParamInfos;
 		PassParamInfo* mPassParamInfos;
+		ObjectParamInfo* mObjectParamInfos;
+
+		// All GPU parameters each material parameter maps to. References of material parameter i are in range
+		// [mParamRefOffsets[i], mParamRefOffsets[i + 1]).
+		Vector<ParamRef> mParamRefs;
+		Vector<UINT32> mParamRefOffsets;
+
+		Vector<UINT32> mAnimatedDataParams;
+		const MaterialParamsType* mLastParams = nullptr;
 
 		UINT64 mParamVersion;
 		UINT8* mData;
@@ -710,6 +710,16 @@ namespace bs
 			mParams->getCoreObjectDependencies(dependencies);
 	}
 
+	void Material::onDependencyDirty(CoreObject* dependency, UINT32 dirtyFlags)
+	{
+		// Textures can change their core objects (e.g. when streaming mip levels), so parameters referencing them
+		// need to be synced again
+		if (mParams != nullptr)
+			mParams->markCoreObjectDirty(dependency);
+
+		CoreObject::onDependencyDirty(dependency, dirtyFlags);
+	}
+
 	void Material::getListenerResources(Vector<HResource>& resources)
 	{
 		if (mShader != nullptr)
@@ -780,7 +790,7 @@ namespace bs
 
 	HMaterial Material::clone()
 	{
-		UINT32 bufferSize = 0;
+		UINT64 bufferSize = 0;
 
 		MemorySerializer serializer;
 		UINT8* buffer = serializer.encode(this, bufferSize, (void*(*)(size_t))&bs_alloc);
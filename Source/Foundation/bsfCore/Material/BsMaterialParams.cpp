@@ -195,7 +195,7 @@ namespace bs
 
 		paramInfo.colorGradient = bs_pool_new<ColorGradient>(input);
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	UINT32 MaterialParamsBase::getParamIndex(const String& name) const
@@ -584,7 +584,7 @@ namespace bs
 		}
 
 		memcpy(structParam.data, value, structParam.dataSize);
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -616,7 +616,7 @@ namespace bs
 		textureParam.isLoadStore = false;
 		textureParam.surface = surface;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -635,7 +635,7 @@ namespace bs
 		textureParam.isLoadStore = false;
 		textureParam.surface = TextureSurface::COMPLETE;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -649,7 +649,7 @@ namespace bs
 	{
 		mBufferParams[param.index].value = value;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -669,7 +669,7 @@ namespace bs
 		textureParam.isLoadStore = true;
 		textureParam.surface = surface;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -683,7 +683,7 @@ namespace bs
 	{
 		mSamplerStateParams[param.index].value = value;
 
-		param.version = ++mParamVersion;
+		markParamDirty(param);
 	}
 
 	template<bool Core>
@@ -980,6 +980,19 @@ namespace bs
 		}
 	}
 
+	void MaterialParams::markCoreObjectDirty(const CoreObject* object)
+	{
+		for (auto& param : mParams)
+		{
+			if (param.type != ParamType::Texture)
+				continue;
+
+			const MaterialParamTextureData& textureData = mTextureParams[param.index];
+			if (textureData.texture.isLoaded() && textureData.texture.get() == object)
+				markParamDirty(param);
+		}
+	}
+
 	void MaterialParams::getCoreObjectDependencies(Vector<CoreObject*>& coreObjects)
 	{
 		for (UINT32 i = 0; i < (UINT32)mParams.size(); i++)
@@ -1123,8 +1136,6 @@ namespace bs
 		sourceData = rttiReadElem(numDirtyBufferParams, sourceData);
 		sourceData = rttiReadElem(numDirtySamplerParams, sourceData);
 
-		mParamVersion++;
-
 		for(UINT32 i = 0; i < numDirtyDataParams; i++)
 		{
 			// Param index
@@ -1132,7 +1143,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			const UINT32 arraySize = param.arraySize > 1 ? param.arraySize : 1;
 			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[(int)param.dataType];
@@ -1181,7 +1192,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			MaterialParamTextureDataCore* sourceTexData = (MaterialParamTextureDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamTextureDataCore);
@@ -1196,7 +1207,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			MaterialParamBufferDataCore* sourceBufferData = (MaterialParamBufferDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamBufferDataCore);
@@ -1211,7 +1222,7 @@ namespace bs
 			sourceData = rttiReadElem(paramIdx, sourceData);
 
 			ParamData& param = mParams[paramIdx];
-			param.version = mParamVersion;
+			markParamDirty(param);
 
 			MaterialParamSamplerStateDataCore* sourceSamplerStateData = (MaterialParamSamplerStateDataCore*)sourceData;
 			sourceData += sizeof(MaterialParamSamplerStateDataCore);
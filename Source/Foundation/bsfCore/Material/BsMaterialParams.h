@@ -320,7 +320,7 @@ namespace bs
 			assert(sizeof(input) == paramTypeSize);
 			memcpy(&mDataParamsBuffer[paramInfo.offset], &input, paramTypeSize);
 
-			param.version = ++mParamVersion;
+			markParamDirty(param);
 		}
 
 		/**
@@ -364,7 +364,7 @@ namespace bs
 
 				paramInfo.floatCurve = bs_pool_new<TAnimationCurve<T>>(std::move(input));
 
-				param.version = ++mParamVersion;
+				markParamDirty(param);
 			}
 		}
 
@@ -391,9 +391,35 @@ namespace bs
 		/** Returns a counter that gets incremented whenever a parameter gets updated. */
 		UINT64 getParamVersion() const { return mParamVersion; }
 
+		/**
+		 * Checks if every parameter change made after @p version is still recorded in the dirty parameter ring. If not,
+		 * the caller needs to check the version of every parameter instead.
+		 */
+		bool isInDirtyRing(UINT64 version) const
+		{
+			return version > 0 && version <= mParamVersion && mParamVersion - version <= DIRTY_RING_SIZE;
+		}
+
+		/**
+		 * Returns the index of the parameter whose change incremented the parameter version to @p version. Only valid
+		 * if isInDirtyRing() returns true for a version preceding @p version. The same parameter can be recorded under
+		 * multiple versions, only the one equal to ParamData::version is its latest change.
+		 */
+		UINT32 getDirtyParamIndex(UINT64 version) const { return mDirtyRing[version % DIRTY_RING_SIZE]; }
+
+		/** Maximum number of parameter changes recorded by the dirty parameter ring. */
+		static constexpr UINT32 DIRTY_RING_SIZE = 64;
+
 	protected:
 		const static UINT32 STATIC_BUFFER_SIZE = 256;
 
+		/** Assigns a new version to the parameter and records the change in the dirty parameter ring. */
+		void markParamDirty(const ParamData& param) const
+		{
+			param.version = ++mParamVersion;
+			mDirtyRing[mParamVersion % DIRTY_RING_SIZE] = (UINT32)(&param - mParams.data());
+		}
+
 		UnorderedMap<String, UINT32> mParamLookup;
 		Vector<ParamData> mParams;
 
@@ -408,6 +434,7 @@ namespace bs
 		UINT32 mNumSamplerParams = 0;
 
 		mutable UINT64 mParamVersion = 1;
+		mutable UINT32 mDirtyRing[DIRTY_RING_SIZE];
 		mutable StaticAlloc<STATIC_BUFFER_SIZE> mAlloc;
 	};
 
@@ -769,6 +796,15 @@ namespace bs
 		 */
 		void getDefaultSamplerState(const ParamData& param, SamplerType& value) const;
 
+		/** Returns the number of texture parameters stored by this object. */
+		UINT32 getNumTextureParams() const { return mNumTextureParams; }
+
+		/**
+		 * Returns the texture assigned to the texture parameter with the specified index, in range
+		 * [0, getNumTextureParams()). Returns null if no texture is assigned.
+		 */
+		const TextureType& getTextureByIndex(UINT32 idx) const { return mTextureParams[idx].texture; }
+
 	protected:
 		ParamStructDataType* mStructParams = nullptr;
 		ParamTextureDataType* mTextureParams = nullptr;
@@ -818,6 +854,9 @@ namespace bs
 		/** Appends any core objects stored by this object to the provided vector. */
 		void getCoreObjectDependencies(Vector<CoreObject*>& coreObjects);
 
+		/** Marks all texture parameters referencing the provided core object as dirty, so they are synced again. */
+		void markCoreObjectDirty(const CoreObject* object);
+
 	private:
 		friend class ct::MaterialParams;
 
@@ -10,21 +10,157 @@
 #include "RenderAPI/BsGpuProgram.h"
 #include "RenderAPI/BsGpuPipelineState.h"
 #include "CoreThread/BsCoreObjectSync.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsCompression.h"
 
 namespace bs
 {
+	/** Removes the program descriptors from the pass descriptor, as they are stored separately. */
+	static PASS_DESC stripPrograms(const PASS_DESC& desc)
+	{
+		PASS_DESC output;
+		output.blendStateDesc = desc.blendStateDesc;
+		output.rasterizerStateDesc = desc.rasterizerStateDesc;
+		output.depthStencilStateDesc = desc.depthStencilStateDesc;
+		output.stencilRefValue = desc.stencilRefValue;
+
+		return output;
+	}
+
+	PassProgramData::PassProgramData(const PASS_DESC& desc)
+		: mIsLoaded(true), mIsCompute(!desc.computeProgramDesc.source.empty())
+	{
+		mPrograms[GPT_VERTEX_PROGRAM] = desc.vertexProgramDesc;
+		mPrograms[GPT_FRAGMENT_PROGRAM] = desc.fragmentProgramDesc;
+		mPrograms[GPT_GEOMETRY_PROGRAM] = desc.geometryProgramDesc;
+		mPrograms[GPT_HULL_PROGRAM] = desc.hullProgramDesc;
+		mPrograms[GPT_DOMAIN_PROGRAM] = desc.domainProgramDesc;
+		mPrograms[GPT_COMPUTE_PROGRAM] = desc.computeProgramDesc;
+	}
+
+	PassProgramData::PassProgramData(const SPtr<MemoryDataStream>& encoded, bool isCompute)
+		: mEncoded(encoded), mIsLoaded(false), mIsCompute(isCompute)
+	{ }
+
+	bool PassProgramData::isLoaded() const
+	{
+		return mIsLoaded.load(std::memory_order_acquire);
+	}
+
+	void PassProgramData::load()
+	{
+		if (isLoaded())
+			return;
+
+		Lock lock(mMutex);
+		decode();
+	}
+
+	const GPU_PROGRAM_DESC& PassProgramData::getProgramDesc(GpuProgramType type)
+	{
+		load();
+		return mPrograms[type];
+	}
+
+	SPtr<MemoryDataStream> PassProgramData::getEncoded() const
+	{
+		Lock lock(mMutex);
+		return mEncoded;
+	}
+
+	SPtr<MemoryDataStream> PassProgramData::encode(const PASS_DESC& desc)
+	{
+		const GPU_PROGRAM_DESC* programs[GPT_COUNT];
+		programs[GPT_VERTEX_PROGRAM] = &desc.vertexProgramDesc;
+		programs[GPT_FRAGMENT_PROGRAM] = &desc.fragmentProgramDesc;
+		programs[GPT_GEOMETRY_PROGRAM] = &desc.geometryProgramDesc;
+		programs[GPT_HULL_PROGRAM] = &desc.hullProgramDesc;
+		programs[GPT_DOMAIN_PROGRAM] = &desc.domainProgramDesc;
+		programs[GPT_COMPUTE_PROGRAM] = &desc.computeProgramDesc;
+
+		MemorySerializer ms;
+		UINT8* encoded[GPT_COUNT];
+		UINT32 encodedSizes[GPT_COUNT];
+
+		size_t totalSize = 0;
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			SerializedGpuProgramData programData;
+			programData = *programs[i];
+
+			UINT64 numBytes = 0;
+			encoded[i] = ms.encode(&programData, numBytes);
+			encodedSizes[i] = (UINT32)numBytes;
+
+			totalSize += sizeof(UINT32) + encodedSizes[i];
+		}
+
+		// Each program is stored as its size, followed by its serialized data
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(totalSize);
+		for (UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			stream->write(&encodedSizes[i], sizeof(UINT32));
+			stream->write(encoded[i], encodedSizes[i]);
+
+			bs_free(encoded[i]);
+		}
+
+		stream->seek(0);
+		return Compression::compressBlocks(stream);
+	}
+
+	void PassProgramData::decode()
+	{
+		if (mIsLoaded.load(std::memory_order_relaxed))
+			return;
+
+		SPtr<MemoryDataStream> decompressed = mEncoded ? Compression::decompressBlocks(mEncoded) : nullptr;
+		if (decompressed)
+		{
+			MemorySerializer ms;
+			for (UINT32 i = 0; i < GPT_COUNT; i++)
+			{
+				UINT32 size = 0;
+				if (decompressed->read(&size, sizeof(size)) != sizeof(size) || 
+					(decompressed->tell() + size) > decompressed->size())
+				{
+					LOGERR("Corrupt pass program data.");
+					break;
+				}
+
+				SPtr<IReflectable> object = ms.decode(decompressed->getCurrentPtr(), size);
+				decompressed->skip(size);
+
+				if (object != nullptr && object->getTypeId() == TID_SerializedGpuProgramData)
+					mPrograms[i] = *std::static_pointer_cast<SerializedGpuProgramData>(object);
+			}
+		}
+		else
+			LOGERR("Corrupt pass program data.");
+
+		// Decoded data is kept instead, and re-encoded if the pass ever needs to be serialized again
+		mEncoded = nullptr;
+		mIsLoaded.store(true, std::memory_order_release);
+	}
+
 	template<bool Core>
 	TPass<Core>::TPass()
+		:mPrograms(bs_shared_ptr_new<PassProgramData>(PASS_DESC()))
 	{
 		mData.stencilRefValue = 0;
 	}
 
 	template<bool Core>
 	TPass<Core>::TPass(const PASS_DESC& data)
-		:mData(data)
-	{
+		:mData(stripPrograms(data)), mPrograms(bs_shared_ptr_new<PassProgramData>(data))
+	{ }
 
-	}
+	template<bool Core>
+	TPass<Core>::TPass(const PASS_DESC& data, const SPtr<PassProgramData>& programs)
+		:mData(stripPrograms(data)), mPrograms(programs)
+	{ }
 
 	template<bool Core>
 	bool TPass<Core>::hasBlending() const 
@@ -50,22 +186,7 @@ namespace bs
 	template<bool Core>
 	const GPU_PROGRAM_DESC& TPass<Core>::getProgramDesc(bs::GpuProgramType type) const
 	{
-		switch(type)
-		{
-		default:
-		case GPT_VERTEX_PROGRAM:
-			return mData.vertexProgramDesc;
-		case GPT_FRAGMENT_PROGRAM:
-			return mData.fragmentProgramDesc;
-		case GPT_GEOMETRY_PROGRAM:
-			return mData.geometryProgramDesc;
-		case GPT_HULL_PROGRAM:
-			return mData.hullProgramDesc;
-		case GPT_DOMAIN_PROGRAM:
-			return mData.domainProgramDesc;
-		case GPT_COMPUTE_PROGRAM:
-			return mData.computeProgramDesc;
-		}
+		return mPrograms->getProgramDesc(type);
 	}
 
 	template<bool Core>
@@ -73,27 +194,32 @@ namespace bs
 	{
 		if (isCompute())
 		{
-			SPtr<GpuProgramType> program = GpuProgramType::create(mData.computeProgramDesc);
+			SPtr<GpuProgramType> program = GpuProgramType::create(getProgramDesc(GPT_COMPUTE_PROGRAM));
 			mComputePipelineState = ComputePipelineStateType::create(program);
 		}
 		else
 		{
 			PipelineStateDescType desc;
 
-			if(!mData.vertexProgramDesc.source.empty())
-				desc.vertexProgram = GpuProgramType::create(mData.vertexProgramDesc);
+			const GPU_PROGRAM_DESC& vertexProgramDesc = getProgramDesc(GPT_VERTEX_PROGRAM);
+			if(!vertexProgramDesc.source.empty())
+				desc.vertexProgram = GpuProgramType::create(vertexProgramDesc);
 
-			if(!mData.fragmentProgramDesc.source.empty())
-				desc.fragmentProgram = GpuProgramType::create(mData.fragmentProgramDesc);
+			const GPU_PROGRAM_DESC& fragmentProgramDesc = getProgramDesc(GPT_FRAGMENT_PROGRAM);
+			if(!fragmentProgramDesc.source.empty())
+				desc.fragmentProgram = GpuProgramType::create(fragmentProgramDesc);
 
-			if(!mData.geometryProgramDesc.source.empty())
-				desc.geometryProgram = GpuProgramType::create(mData.geometryProgramDesc);
+			const GPU_PROGRAM_DESC& geometryProgramDesc = getProgramDesc(GPT_GEOMETRY_PROGRAM);
+			if(!geometryProgramDesc.source.empty())
+				desc.geometryProgram = GpuProgramType::create(geometryProgramDesc);
 
-			if(!mData.hullProgramDesc.source.empty())
-				desc.hullProgram = GpuProgramType::create(mData.hullProgramDesc);
+			const GPU_PROGRAM_DESC& hullProgramDesc = getProgramDesc(GPT_HULL_PROGRAM);
+			if(!hullProgramDesc.source.empty())
+				desc.hullProgram = GpuProgramType::create(hullProgramDesc);
 
-			if(!mData.domainProgramDesc.source.empty())
-				desc.domainProgram = GpuProgramType::create(mData.domainProgramDesc);
+			const GPU_PROGRAM_DESC& domainProgramDesc = getProgramDesc(GPT_DOMAIN_PROGRAM);
+			if(!domainProgramDesc.source.empty())
+				desc.domainProgram = GpuProgramType::create(domainProgramDesc);
 
 			desc.blendState = BlendStateType::create(mData.blendStateDesc);
 			desc.rasterizerState = RasterizerStateType::create(mData.rasterizerStateDesc);
@@ -125,7 +251,7 @@ namespace bs
 
 	SPtr<ct::CoreObject> Pass::createCore() const
 	{
-		ct::Pass* pass = new (bs_alloc<ct::Pass>()) ct::Pass(mData);
+		ct::Pass* pass = new (bs_alloc<ct::Pass>()) ct::Pass(mData, mPrograms);
 
 		SPtr<ct::Pass> passPtr = bs_shared_ptr(pass);
 		passPtr->_setThisPtr(passPtr);
@@ -147,6 +273,16 @@ namespace bs
 		CoreObject::syncToCore();
 	}
 
+	void Pass::loadProgramsAsync()
+	{
+		if (mPrograms->isLoaded())
+			return;
+
+		SPtr<PassProgramData> programs = mPrograms;
+		SPtr<Task> task = Task::create("LoadPassPrograms", [programs]() { programs->load(); });
+		TaskScheduler::instance().addTask(task);
+	}
+
 	CoreSyncData Pass::syncToCore(FrameAlloc* allocator)
 	{
 		UINT32 size = coreSyncGetElemSize(*this);
@@ -194,6 +330,10 @@ namespace bs
 		:TPass(desc)
 	{ }
 
+	Pass::Pass(const PASS_DESC& desc, const SPtr<PassProgramData>& programs)
+		:TPass(desc, programs)
+	{ }
+
 	void Pass::compile()
 	{
 		if(mComputePipelineState || mGraphicsPipelineState)
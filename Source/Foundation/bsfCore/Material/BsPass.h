@@ -36,6 +36,64 @@ namespace bs
 
 	/** @} */
 
+	/** @addtogroup Material-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Holds the GPU program descriptors of a pass. When loaded from a serialized shader the descriptors are kept in
+	 * compressed serialized form until they are first requested. Shaders can contain a large number of techniques (one
+	 * per variation and language) of which only a few end up being used, so this avoids decoding, and keeping resident,
+	 * program data of techniques that are never used. Shared between sim and core thread versions of a pass.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT PassProgramData
+	{
+	public:
+		/** Creates the object from decoded program descriptors. Only the program descriptors of @p desc are used. */
+		PassProgramData(const PASS_DESC& desc);
+
+		/** 
+		 * Creates the object from program descriptors in serialized form, as output by encode(). Descriptors will be
+		 * decoded when first requested.
+		 */
+		PassProgramData(const SPtr<MemoryDataStream>& encoded, bool isCompute);
+
+		/** Returns true if the pass executes a compute program. Doesn't require the descriptors to be decoded. */
+		bool isCompute() const { return mIsCompute; }
+
+		/** Checks are the program descriptors decoded. */
+		bool isLoaded() const;
+
+		/** Decodes the program descriptors, unless already decoded. */
+		void load();
+
+		/** Returns the descriptor for a GPU program of the specified type. Decodes the descriptors if required. */
+		const GPU_PROGRAM_DESC& getProgramDesc(GpuProgramType type);
+
+		/** Returns the descriptors in serialized form, or null if they have already been decoded. */
+		SPtr<MemoryDataStream> getEncoded() const;
+
+		/** 
+		 * Encodes the program descriptors into a compressed serialized form that can be provided to the PassProgramData
+		 * constructor. Only the program descriptors of @p desc are used. 
+		 */
+		static SPtr<MemoryDataStream> encode(const PASS_DESC& desc);
+
+	private:
+		/** Decodes the serialized descriptors. Caller must hold the mutex. */
+		void decode();
+
+		mutable Mutex mMutex;
+		SPtr<MemoryDataStream> mEncoded;
+		GPU_PROGRAM_DESC mPrograms[GPT_COUNT];
+		std::atomic<bool> mIsLoaded;
+		bool mIsCompute;
+	};
+
+	/** @} */
+
 	/** @addtogroup Implementation
 	 *  @{
 	 */
@@ -59,12 +117,15 @@ namespace bs
 		bool hasBlending() const;
 
 		/** Returns true if the pass executes a compute program. */
-		bool isCompute() const { return !mData.computeProgramDesc.source.empty(); }
+		bool isCompute() const { return mPrograms->isCompute(); }
 
 		/** Gets the stencil reference value that is used when performing operations using the stencil buffer. */
 		UINT32 getStencilRefValue() const { return mData.stencilRefValue; }
 
-		/** Returns the GPU program descriptor for the specified GPU program type. */
+		/** 
+		 * Returns the GPU program descriptor for the specified GPU program type. Program descriptors of passes loaded
+		 * from a serialized shader are decoded on first access.
+		 */
 		const GPU_PROGRAM_DESC& getProgramDesc(bs::GpuProgramType type) const;
 
 		/** 
@@ -92,11 +153,13 @@ namespace bs
 	protected:
 		TPass();
 		TPass(const PASS_DESC& desc);
+		TPass(const PASS_DESC& desc, const SPtr<PassProgramData>& programs);
 
 		/** Creates either the graphics or the compute pipeline state from the stored pass data. */
 		void createPipelineState();
 
-		PASS_DESC mData;
+		PASS_DESC mData; /**< Pass states. Program descriptors are stored in mPrograms instead. */
+		SPtr<PassProgramData> mPrograms;
 		SPtr<GraphicsPipelineStateType> mGraphicsPipelineState;
 		SPtr<ComputePipelineStateType> mComputePipelineState;
 	};
@@ -129,6 +192,12 @@ namespace bs
 		 */
 		void compile();
 
+		/** 
+		 * Queues decoding of the pass GPU program descriptors on a worker thread, so a later call to compile() doesn't
+		 * need to wait for the decode. Does nothing if the descriptors are already decoded.
+		 */
+		void loadProgramsAsync();
+
 		/**	Creates a new empty pass. */
 		static SPtr<Pass> create(const PASS_DESC& desc);
 
@@ -186,6 +255,7 @@ namespace bs
 
 		Pass() = default;
 		Pass(const PASS_DESC& desc);
+		Pass(const PASS_DESC& desc, const SPtr<PassProgramData>& programs);
 
 		/** @copydoc CoreObject::syncToCore */
 		void syncToCore(const CoreSyncData& data) override;
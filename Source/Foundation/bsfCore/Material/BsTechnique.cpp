@@ -79,6 +79,12 @@ namespace bs
 		return std::static_pointer_cast<ct::Technique>(mCoreSpecific);
 	}
 
+	void Technique::loadProgramsAsync()
+	{
+		for (auto& pass : mPasses)
+			pass->loadProgramsAsync();
+	}
+
 	SPtr<ct::CoreObject> Technique::createCore() const
 	{
 		Vector<SPtr<ct::Pass>> passes;
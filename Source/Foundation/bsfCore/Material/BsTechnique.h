@@ -89,6 +89,9 @@ namespace bs
 		/** Retrieves an implementation of a technique usable only from the core thread. */
 		SPtr<ct::Technique> getCore() const;
 
+		/** Queues decoding of GPU program descriptors of all passes in the technique. @see Pass::loadProgramsAsync. */
+		void loadProgramsAsync();
+
 		/** 
 		 * Creates a new technique. 
 		 *
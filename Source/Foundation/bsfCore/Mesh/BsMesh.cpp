@@ -11,6 +11,7 @@
 #include "RenderAPI/BsVertexDataDesc.h"
 #include "Resources/BsResources.h"
 #include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsCommandBuffer.h"
 
 namespace bs
 {
@@ -20,7 +21,8 @@ namespace bs
 		:MeshBase(desc.numVertices, desc.numIndices, desc.subMeshes), mVertexDesc(desc.vertexDesc), mUsage(desc.usage),
 		mIndexType(desc.indexType), mSkeleton(desc.skeleton), mMorphShapes(desc.morphShapes)
 	{
-
+		mProperties.mLODSubMeshes = desc.lodSubMeshes;
+		mProperties.mMeshlets = desc.meshlets;
 	}
 
 	Mesh::Mesh(const SPtr<MeshData>& initialMeshData, const MESH_DESC& desc)
@@ -28,7 +30,10 @@ namespace bs
 		mCPUData(initialMeshData), mVertexDesc(initialMeshData->getVertexDesc()),
 		mUsage(desc.usage), mIndexType(initialMeshData->getIndexType()), mSkeleton(desc.skeleton),
 		mMorphShapes(desc.morphShapes)
-	{ }
+	{
+		mProperties.mLODSubMeshes = desc.lodSubMeshes;
+		mProperties.mMeshlets = desc.meshlets;
+	}
 
 	Mesh::Mesh()
 		:MeshBase(0, 0, DOT_TRIANGLE_LIST)
@@ -111,6 +116,8 @@ namespace bs
 		desc.numIndices = mProperties.mNumIndices;
 		desc.vertexDesc = mVertexDesc;
 		desc.subMeshes = mProperties.mSubMeshes;
+		desc.lodSubMeshes = mProperties.mLODSubMeshes;
+		desc.meshlets = mProperties.mMeshlets;
 		desc.usage = mUsage;
 		desc.indexType = mIndexType;
 		desc.skeleton = mSkeleton;
@@ -262,8 +269,10 @@ namespace bs
 		: MeshBase(desc.numVertices, desc.numIndices, desc.subMeshes), mVertexData(nullptr), mIndexBuffer(nullptr)
 		, mVertexDesc(desc.vertexDesc), mUsage(desc.usage), mIndexType(desc.indexType), mDeviceMask(deviceMask)
 		, mTempInitialMeshData(initialMeshData), mSkeleton(desc.skeleton), mMorphShapes(desc.morphShapes)
-
-	{ }
+	{
+		mProperties.mLODSubMeshes = desc.lodSubMeshes;
+		mProperties.mMeshlets = desc.meshlets;
+	}
 
 	Mesh::~Mesh()
 	{
@@ -311,7 +320,8 @@ namespace bs
 		// buffer data upon buffer construction, instead of setting it in a second step like I do here
 		if (mTempInitialMeshData != nullptr)
 		{
-			writeData(*mTempInitialMeshData, isDynamic);
+			// Uploaded on the upload queue (if the render API has one) so it can proceed in parallel with rendering
+			writeData(*mTempInitialMeshData, isDynamic, true, CommandSyncMask::getGlobalQueueIdx(GQT_UPLOAD, 0));
 			mTempInitialMeshData = nullptr;
 		}
 
@@ -39,6 +39,20 @@ namespace bs
 		 */
 		Vector<SubMesh> subMeshes;
 
+		/**
+		 * Optional sub-meshes used for rendering lower levels of detail of the mesh. Must contain the same number of
+		 * sub-meshes as @p subMeshes for each level, starting with LOD 1 and stored one level after another. Usually
+		 * reference a coarser set of indices stored after the full detail indices in the same index buffer.
+		 */
+		Vector<SubMesh> lodSubMeshes;
+
+		/**
+		 * Optional clusters of triangles the full detail sub-meshes are split into, allowing the renderer to cull parts
+		 * of a sub-mesh. Must be sorted by index offset and must not cross sub-mesh boundaries. See
+		 * MeshUtility::generateMeshlets().
+		 */
+		Vector<Meshlet> meshlets;
+
 		/** Optimizes performance depending on planned usage of the mesh. */
 		INT32 usage = MU_STATIC; 
 
@@ -0,0 +1,146 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Mesh/BsMeshBVH.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+
+namespace bs
+{
+	MeshBVH::MeshBVH(const SPtr<MeshData>& meshData)
+	{
+		const UINT32 numIndices = meshData->getNumIndices();
+		const UINT32 numTriangles = numIndices / 3;
+
+		mIndices.resize(numTriangles * 3);
+		if (meshData->getIndexType() == IT_16BIT)
+		{
+			const UINT16* indices = meshData->getIndices16();
+			for (UINT32 i = 0; i < (UINT32)mIndices.size(); i++)
+				mIndices[i] = indices[i];
+		}
+		else
+		{
+			const UINT32* indices = meshData->getIndices32();
+			memcpy(mIndices.data(), indices, mIndices.size() * sizeof(UINT32));
+		}
+
+		Vector<AABox> bounds;
+		readPositions(meshData, bounds);
+
+		mBVH.build(bounds.data(), (UINT32)bounds.size());
+	}
+
+	void MeshBVH::refit(const SPtr<MeshData>& meshData)
+	{
+		if (meshData->getNumVertices() != (UINT32)mPositions.size())
+		{
+			LOGERR("Cannot refit the mesh BVH, the number of vertices doesn't match.");
+			return;
+		}
+
+		Vector<AABox> bounds;
+		readPositions(meshData, bounds);
+
+		mBVH.refit(bounds.data());
+	}
+
+	void MeshBVH::readPositions(const SPtr<MeshData>& meshData, Vector<AABox>& bounds)
+	{
+		const UINT32 numVertices = meshData->getNumVertices();
+		mPositions.resize(numVertices);
+
+		if (meshData->getVertexDesc()->hasElement(VES_POSITION))
+		{
+			auto posIter = meshData->getVec3DataIter(VES_POSITION);
+			for (UINT32 i = 0; i < numVertices; i++)
+			{
+				mPositions[i] = posIter.getValue();
+				posIter.moveNext();
+			}
+		}
+		else
+		{
+			for (auto& entry : mPositions)
+				entry = Vector3::ZERO;
+		}
+
+		const UINT32 numTriangles = getNumTriangles();
+		bounds.resize(numTriangles);
+		for (UINT32 i = 0; i < numTriangles; i++)
+		{
+			const Vector3& a = mPositions[mIndices[i * 3 + 0]];
+			const Vector3& b = mPositions[mIndices[i * 3 + 1]];
+			const Vector3& c = mPositions[mIndices[i * 3 + 2]];
+
+			bounds[i] = AABox(Vector3::min(Vector3::min(a, b), c), Vector3::max(Vector3::max(a, b), c));
+		}
+	}
+
+	std::pair<bool, float> MeshBVH::intersect(const Ray& ray, UINT32 triangleIdx, bool backfaces) const
+	{
+		const Vector3& a = mPositions[mIndices[triangleIdx * 3 + 0]];
+		const Vector3& b = mPositions[mIndices[triangleIdx * 3 + 1]];
+		const Vector3& c = mPositions[mIndices[triangleIdx * 3 + 2]];
+
+		// Front faces are the ones whose normal (from counter-clockwise winding) points towards the ray origin
+		const Vector3 normal = (b - a).cross(c - a);
+		return ray.intersects(a, b, c, normal, true, backfaces);
+	}
+
+	bool MeshBVH::raycast(const Ray& ray, MeshRayHit& hit, float maxDistance, bool backfaces) const
+	{
+		bool found = false;
+		mBVH.raycast(ray, maxDistance, [&](UINT32 triangleIdx, float& distance)
+		{
+			const std::pair<bool, float> result = intersect(ray, triangleIdx, backfaces);
+			if (result.first && result.second <= distance)
+			{
+				distance = result.second;
+
+				hit.triangleIdx = triangleIdx;
+				hit.distance = result.second;
+				found = true;
+			}
+
+			return true;
+		});
+
+		if (found)
+		{
+			const Vector3& a = mPositions[mIndices[hit.triangleIdx * 3 + 0]];
+			const Vector3& b = mPositions[mIndices[hit.triangleIdx * 3 + 1]];
+			const Vector3& c = mPositions[mIndices[hit.triangleIdx * 3 + 2]];
+
+			hit.point = ray.getPoint(hit.distance);
+			hit.normal = (b - a).cross(c - a);
+		}
+
+		return found;
+	}
+
+	bool MeshBVH::raycastAny(const Ray& ray, float maxDistance, bool backfaces) const
+	{
+		bool found = false;
+		mBVH.raycast(ray, maxDistance, [&](UINT32 triangleIdx, float& distance)
+		{
+			const std::pair<bool, float> result = intersect(ray, triangleIdx, backfaces);
+			if (result.first && result.second <= distance)
+			{
+				found = true;
+				return false;
+			}
+
+			return true;
+		});
+
+		return found;
+	}
+
+	void MeshBVH::query(const ConvexVolume& volume, Vector<UINT32>& triangles) const
+	{
+		mBVH.query(volume, [&triangles](UINT32 triangleIdx)
+		{
+			triangles.push_back(triangleIdx);
+		});
+	}
+}
@@ -0,0 +1,106 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsBVH.h"
+
+namespace bs
+{
+	/** @addtogroup Resources
+	 *  @{
+	 */
+
+	/** Information about an intersection between a ray and a triangle of a mesh. */
+	struct MeshRayHit
+	{
+		/** Index of the intersected triangle. First index of the triangle is at triangleIdx * 3. */
+		UINT32 triangleIdx = 0;
+
+		/** Distance along the ray at which the intersection occurred. */
+		float distance = 0.0f;
+
+		/** Position of the intersection, in mesh space. */
+		Vector3 point = Vector3::ZERO;
+
+		/** Normal of the intersected triangle, in mesh space. Not normalized. */
+		Vector3 normal = Vector3::ZERO;
+	};
+
+	/**
+	 * Bounding volume hierarchy over the triangles of a mesh, for fast ray and volume queries on the CPU (e.g. picking or
+	 * line-of-sight tests against render geometry). Keeps a copy of the vertex positions and indices, so the source
+	 * mesh data doesn't need to be kept around. All queries are performed in mesh space, meaning world space queries
+	 * need to be transformed by the inverse of the mesh's world transform first.
+	 *
+	 * @note	Queries are thread safe, as long as the hierarchy isn't being refit at the same time.
+	 */
+	class BS_CORE_EXPORT MeshBVH
+	{
+	public:
+		/**
+		 * Builds the hierarchy from the provided mesh data, treating all the indices as a triangle list.
+		 *
+		 * @param[in]	meshData	Mesh data containing vertex positions and indices.
+		 */
+		MeshBVH(const SPtr<MeshData>& meshData);
+
+		/**
+		 * Updates the vertex positions of the triangles (e.g. after skinning on the CPU) and refits the hierarchy to
+		 * them. Indices and the number of vertices must match the data the hierarchy was built with.
+		 */
+		void refit(const SPtr<MeshData>& meshData);
+
+		/**
+		 * Finds the closest intersection between the ray and the triangles.
+		 *
+		 * @param[in]	ray				Ray to test, in mesh space.
+		 * @param[out]	hit				Information about the closest intersection, if one was found.
+		 * @param[in]	maxDistance		Maximum distance along the ray to look for intersections.
+		 * @param[in]	backfaces		True if triangles facing away from the ray should be intersected as well.
+		 * @return						True if an intersection was found.
+		 */
+		bool raycast(const Ray& ray, MeshRayHit& hit, float maxDistance = std::numeric_limits<float>::max(),
+			bool backfaces = false) const;
+
+		/**
+		 * Checks does the ray intersect any of the triangles, stopping at the first found intersection. Faster than
+		 * raycast() when only visibility matters, i.e. for line-of-sight tests.
+		 *
+		 * @param[in]	ray				Ray to test, in mesh space.
+		 * @param[in]	maxDistance		Maximum distance along the ray to look for intersections.
+		 * @param[in]	backfaces		True if triangles facing away from the ray should be intersected as well.
+		 * @return						True if an intersection was found.
+		 */
+		bool raycastAny(const Ray& ray, float maxDistance = std::numeric_limits<float>::max(),
+			bool backfaces = true) const;
+
+		/**
+		 * Finds all the triangles whose bounds intersect a convex volume, like a selection frustum.
+		 *
+		 * @param[in]	volume		Volume to test, in mesh space.
+		 * @param[out]	triangles	Indices of the triangles whose bounds intersect the volume. Appended to any
+		 *							existing entries.
+		 */
+		void query(const ConvexVolume& volume, Vector<UINT32>& triangles) const;
+
+		/** Returns the number of triangles in the hierarchy. */
+		UINT32 getNumTriangles() const { return (UINT32)mIndices.size() / 3; }
+
+		/** Returns the bounds of all the triangles, in mesh space. */
+		AABox getBounds() const { return mBVH.getBounds(); }
+
+	private:
+		/** Reads the vertex positions from the mesh data and calculates the bounds of all the triangles. */
+		void readPositions(const SPtr<MeshData>& meshData, Vector<AABox>& bounds);
+
+		/** Tests the ray against a single triangle. Returns the distance to the intersection, if any. */
+		std::pair<bool, float> intersect(const Ray& ray, UINT32 triangleIdx, bool backfaces) const;
+
+		BVH mBVH;
+		Vector<Vector3> mPositions;
+		Vector<UINT32> mIndices;
+	};
+
+	/** @} */
+}
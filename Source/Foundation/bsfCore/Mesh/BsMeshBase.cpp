@@ -40,6 +40,50 @@ namespace bs
 		return (UINT32)mSubMeshes.size();
 	}
 
+	const SubMesh& MeshProperties::getSubMesh(UINT32 subMeshIdx, UINT32 lod) const
+	{
+		if (lod == 0)
+			return getSubMesh(subMeshIdx);
+
+		const UINT32 numLODs = getNumLODs();
+		if (lod >= numLODs)
+			lod = numLODs - 1;
+
+		if (lod == 0 || subMeshIdx >= mSubMeshes.size())
+			return getSubMesh(subMeshIdx);
+
+		return mLODSubMeshes[(lod - 1) * mSubMeshes.size() + subMeshIdx];
+	}
+
+	UINT32 MeshProperties::getNumLODs() const
+	{
+		if (mSubMeshes.empty())
+			return 1;
+
+		return 1 + (UINT32)(mLODSubMeshes.size() / mSubMeshes.size());
+	}
+
+	bool MeshProperties::getMeshletRange(UINT32 subMeshIdx, UINT32& first, UINT32& count) const
+	{
+		first = 0;
+		count = 0;
+
+		if (mMeshlets.empty() || subMeshIdx >= getNumSubMeshes())
+			return false;
+
+		const SubMesh& subMesh = getSubMesh(subMeshIdx);
+		const UINT32 rangeEnd = subMesh.indexOffset + subMesh.indexCount;
+
+		const auto lessThan = [](const Meshlet& meshlet, UINT32 offset) { return meshlet.indexOffset < offset; };
+		const auto start = std::lower_bound(mMeshlets.begin(), mMeshlets.end(), subMesh.indexOffset, lessThan);
+		const auto end = std::lower_bound(start, mMeshlets.end(), rangeEnd, lessThan);
+
+		first = (UINT32)(start - mMeshlets.begin());
+		count = (UINT32)(end - start);
+
+		return count > 0;
+	}
+
 	MeshBase::MeshBase(UINT32 numVertices, UINT32 numIndices, DrawOperationType drawOp)
 		:mProperties(numVertices, numIndices, drawOp)
 	{ }
@@ -48,6 +48,35 @@ namespace bs
 		/** Retrieves a total number of sub-meshes in this mesh. */
 		UINT32 getNumSubMeshes() const;
 
+		/**
+		 * Retrieves a sub-mesh used for rendering a certain portion of this mesh at the specified level of detail. LOD 0
+		 * is the full detail mesh, equivalent to getSubMesh(UINT32). If the requested LOD is not available the closest
+		 * available one is returned instead.
+		 */
+		const SubMesh& getSubMesh(UINT32 subMeshIdx, UINT32 lod) const;
+
+		/**
+		 * Returns the number of levels of detail available in the mesh. Always at least one, the full detail level. 
+		 * Each level contains the same number of sub-meshes as the full detail level.
+		 */
+		UINT32 getNumLODs() const;
+
+		/**
+		 * Returns the range of meshlets covering the full detail version of the specified sub-mesh. Returns false if
+		 * the sub-mesh has no meshlets.
+		 *
+		 * @param[in]	subMeshIdx	Index of the sub-mesh to find the meshlets for.
+		 * @param[out]	first		Index of the first meshlet of the sub-mesh, as returned by getMeshlets().
+		 * @param[out]	count		Number of meshlets belonging to the sub-mesh.
+		 */
+		bool getMeshletRange(UINT32 subMeshIdx, UINT32& first, UINT32& count) const;
+
+		/**
+		 * Returns the meshlets of all sub-meshes, sorted by their index offset. Only full detail sub-meshes have
+		 * meshlets.
+		 */
+		const Vector<Meshlet>& getMeshlets() const { return mMeshlets; }
+
 		/**	Returns maximum number of vertices the mesh may store. */
 		UINT32 getNumVertices() const { return mNumVertices; }
 
@@ -67,6 +96,8 @@ namespace bs
 		friend class MeshBaseRTTI;
 
 		Vector<SubMesh> mSubMeshes;
+		Vector<SubMesh> mLODSubMeshes;
+		Vector<Meshlet> mMeshlets;
 		UINT32 mNumVertices;
 		UINT32 mNumIndices;
 		Bounds mBounds;
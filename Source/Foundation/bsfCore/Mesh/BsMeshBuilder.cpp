@@ -0,0 +1,171 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Mesh/BsMeshBuilder.h"
+#include "Mesh/BsMeshHeap.h"
+#include "Mesh/BsTransientMesh.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+
+namespace bs
+{
+	VertexElemIter<Vector2> MeshBuilder::Chunk::getVec2DataIter(VertexElementSemantic semantic, UINT32 semanticIdx,
+		UINT32 streamIdx) const
+	{
+		UINT8* data;
+		UINT32 vertexStride;
+		getDataForIterator(semantic, semanticIdx, streamIdx, data, vertexStride);
+
+		return VertexElemIter<Vector2>(data, vertexStride, mNumVertices);
+	}
+
+	VertexElemIter<Vector3> MeshBuilder::Chunk::getVec3DataIter(VertexElementSemantic semantic, UINT32 semanticIdx,
+		UINT32 streamIdx) const
+	{
+		UINT8* data;
+		UINT32 vertexStride;
+		getDataForIterator(semantic, semanticIdx, streamIdx, data, vertexStride);
+
+		return VertexElemIter<Vector3>(data, vertexStride, mNumVertices);
+	}
+
+	VertexElemIter<Vector4> MeshBuilder::Chunk::getVec4DataIter(VertexElementSemantic semantic, UINT32 semanticIdx,
+		UINT32 streamIdx) const
+	{
+		UINT8* data;
+		UINT32 vertexStride;
+		getDataForIterator(semantic, semanticIdx, streamIdx, data, vertexStride);
+
+		return VertexElemIter<Vector4>(data, vertexStride, mNumVertices);
+	}
+
+	VertexElemIter<UINT32> MeshBuilder::Chunk::getDWORDDataIter(VertexElementSemantic semantic, UINT32 semanticIdx,
+		UINT32 streamIdx) const
+	{
+		UINT8* data;
+		UINT32 vertexStride;
+		getDataForIterator(semantic, semanticIdx, streamIdx, data, vertexStride);
+
+		return VertexElemIter<UINT32>(data, vertexStride, mNumVertices);
+	}
+
+	UINT8* MeshBuilder::Chunk::getElementData(VertexElementSemantic semantic, UINT32 semanticIdx,
+		UINT32 streamIdx) const
+	{
+		UINT8* data;
+		UINT32 vertexStride;
+		getDataForIterator(semantic, semanticIdx, streamIdx, data, vertexStride);
+
+		return data;
+	}
+
+	UINT16* MeshBuilder::Chunk::getIndices16() const
+	{
+		return mData->getIndices16() + mIndexOffset;
+	}
+
+	UINT32* MeshBuilder::Chunk::getIndices32() const
+	{
+		return mData->getIndices32() + mIndexOffset;
+	}
+
+	void MeshBuilder::Chunk::setIndex(UINT32 idx, UINT32 vertexIdx) const
+	{
+		assert(idx < mNumIndices && vertexIdx < mNumVertices);
+
+		if (mData->getIndexType() == IT_32BIT)
+			getIndices32()[idx] = mVertexOffset + vertexIdx;
+		else
+			getIndices16()[idx] = (UINT16)(mVertexOffset + vertexIdx);
+	}
+
+	void MeshBuilder::Chunk::getDataForIterator(VertexElementSemantic semantic, UINT32 semanticIdx, UINT32 streamIdx,
+		UINT8*& data, UINT32& stride) const
+	{
+		mData->getDataForIterator(semantic, semanticIdx, streamIdx, data, stride);
+		data += mVertexOffset * stride;
+	}
+
+	MeshBuilder::MeshBuilder(UINT32 maxVertices, UINT32 maxIndices, const SPtr<VertexDataDesc>& vertexDesc,
+		IndexType indexType)
+		: mData(bs_shared_ptr_new<MeshData>(maxVertices, maxIndices, vertexDesc, indexType))
+		, mMaxVertices(maxVertices), mMaxIndices(maxIndices)
+	{ }
+
+	MeshBuilder::Chunk MeshBuilder::reserve(UINT32 numVertices, UINT32 numIndices)
+	{
+		assert(mData != nullptr && "Cannot reserve a chunk after the build was completed.");
+
+		UINT64 used = mUsed.load(std::memory_order_relaxed);
+		UINT64 newUsed;
+		do
+		{
+			const auto usedVertices = (UINT32)(used >> 32);
+			const auto usedIndices = (UINT32)used;
+			if (numVertices > mMaxVertices - usedVertices || numIndices > mMaxIndices - usedIndices)
+				return Chunk();
+
+			newUsed = ((UINT64)(usedVertices + numVertices) << 32) | (usedIndices + numIndices);
+		} while (!mUsed.compare_exchange_weak(used, newUsed, std::memory_order_relaxed));
+
+		Chunk chunk;
+		chunk.mData = mData.get();
+		chunk.mVertexOffset = (UINT32)(used >> 32);
+		chunk.mNumVertices = numVertices;
+		chunk.mIndexOffset = (UINT32)used;
+		chunk.mNumIndices = numIndices;
+
+		return chunk;
+	}
+
+	SPtr<MeshData> MeshBuilder::finalize()
+	{
+		assert(mData != nullptr && "The build was already completed.");
+
+		const UINT32 numVertices = getNumVertices();
+		const UINT32 numIndices = getNumIndices();
+
+		if (numVertices != mMaxVertices || numIndices != mMaxIndices)
+		{
+			// Indices are stored first, followed by vertex streams one after another. Each part can only move
+			// towards the start of the buffer, and parts are moved in order, so a part never overwrites data that
+			// wasn't moved yet.
+			UINT8* data = mData->getData();
+			const SPtr<VertexDataDesc>& vertexDesc = mData->getVertexDesc();
+			const UINT32 indexSize = mData->getIndexElementSize();
+
+			for (UINT32 i = 0; i <= vertexDesc->getMaxStreamIdx(); i++)
+			{
+				if (!vertexDesc->hasStream(i))
+					continue;
+
+				const UINT32 streamOffset = vertexDesc->getStreamOffset(i);
+				const UINT32 srcOffset = mMaxIndices * indexSize + streamOffset * mMaxVertices;
+				const UINT32 dstOffset = numIndices * indexSize + streamOffset * numVertices;
+
+				memmove(data + dstOffset, data + srcOffset, vertexDesc->getVertexStride(i) * numVertices);
+			}
+
+			mData->mNumVertices = numVertices;
+			mData->mNumIndices = numIndices;
+		}
+
+		SPtr<MeshData> output = mData;
+		mData = nullptr;
+
+		return output;
+	}
+
+	HMesh MeshBuilder::createMesh(MESH_DESC desc)
+	{
+		SPtr<MeshData> meshData = finalize();
+
+		if (desc.subMeshes.empty())
+			desc.subMeshes.push_back(SubMesh(0, meshData->getNumIndices(), DOT_TRIANGLE_LIST));
+
+		return Mesh::create(meshData, desc);
+	}
+
+	SPtr<TransientMesh> MeshBuilder::createTransientMesh(const SPtr<MeshHeap>& heap, DrawOperationType drawOp)
+	{
+		return heap->alloc(finalize(), drawOp);
+	}
+}
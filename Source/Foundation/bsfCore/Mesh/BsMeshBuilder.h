@@ -0,0 +1,158 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Mesh/BsMeshData.h"
+#include "Mesh/BsMesh.h"
+
+namespace bs
+{
+	/** @addtogroup Resources
+	 *  @{
+	 */
+
+	/**
+	 * Builds vertex and index data of a single mesh from multiple threads at once. Each thread reserves a chunk of
+	 * vertices and indices and writes its geometry directly into the memory that is uploaded to the GPU, so the data
+	 * doesn't need to be gathered into a MeshData after it has been generated.
+	 *
+	 * The builder is created with the maximum number of vertices and indices the mesh can have. Once all the chunks
+	 * were written, createMesh(), createTransientMesh() or finalize() complete the build, after which the builder can
+	 * no longer be used.
+	 *
+	 * @note	reserve() and writes to different chunks are thread safe. Other methods must not be called while chunks
+	 *			are being reserved or written to.
+	 */
+	class BS_CORE_EXPORT MeshBuilder
+	{
+	public:
+		/** Range of vertices and indices reserved for a single writer. */
+		class BS_CORE_EXPORT Chunk
+		{
+		public:
+			Chunk() = default;
+
+			/** Checks was the chunk successfully reserved. */
+			bool isValid() const { return mData != nullptr; }
+
+			/** Returns the index of the first vertex of the chunk, within the mesh. */
+			UINT32 getVertexOffset() const { return mVertexOffset; }
+
+			/** Returns the number of vertices in the chunk. */
+			UINT32 getNumVertices() const { return mNumVertices; }
+
+			/** Returns the index of the first index of the chunk, within the mesh. */
+			UINT32 getIndexOffset() const { return mIndexOffset; }
+
+			/** Returns the number of indices in the chunk. */
+			UINT32 getNumIndices() const { return mNumIndices; }
+
+			/** Returns an iterator over Vector2 vertex elements of the chunk. @see MeshData::getVec2DataIter. */
+			VertexElemIter<Vector2> getVec2DataIter(VertexElementSemantic semantic, UINT32 semanticIdx = 0,
+				UINT32 streamIdx = 0) const;
+
+			/** Returns an iterator over Vector3 vertex elements of the chunk. @see MeshData::getVec3DataIter. */
+			VertexElemIter<Vector3> getVec3DataIter(VertexElementSemantic semantic, UINT32 semanticIdx = 0,
+				UINT32 streamIdx = 0) const;
+
+			/** Returns an iterator over Vector4 vertex elements of the chunk. @see MeshData::getVec4DataIter. */
+			VertexElemIter<Vector4> getVec4DataIter(VertexElementSemantic semantic, UINT32 semanticIdx = 0,
+				UINT32 streamIdx = 0) const;
+
+			/** Returns an iterator over 32-bit vertex elements of the chunk. @see MeshData::getDWORDDataIter. */
+			VertexElemIter<UINT32> getDWORDDataIter(VertexElementSemantic semantic, UINT32 semanticIdx = 0,
+				UINT32 streamIdx = 0) const;
+
+			/**
+			 * Returns a pointer to the element with the provided semantic, for the first vertex of the chunk. Elements
+			 * of subsequent vertices are separated by the vertex stride of the stream.
+			 */
+			UINT8* getElementData(VertexElementSemantic semantic, UINT32 semanticIdx = 0, UINT32 streamIdx = 0) const;
+
+			/**
+			 * Returns a pointer to the first 16-bit index of the chunk. Indices reference vertices of the entire mesh,
+			 * so indices of vertices in the chunk must be offset by getVertexOffset(). Use setIndex() to do so
+			 * automatically.
+			 */
+			UINT16* getIndices16() const;
+
+			/** @copydoc getIndices16 */
+			UINT32* getIndices32() const;
+
+			/**
+			 * Sets an index of the chunk, to reference a vertex of the chunk.
+			 *
+			 * @param[in]	idx			Index of the index to set, in range [0, getNumIndices()).
+			 * @param[in]	vertexIdx	Index of the vertex to reference, relative to the first vertex of the chunk.
+			 */
+			void setIndex(UINT32 idx, UINT32 vertexIdx) const;
+
+		private:
+			friend class MeshBuilder;
+
+			/** Returns the pointer to and the stride of an element, for the first vertex of the chunk. */
+			void getDataForIterator(VertexElementSemantic semantic, UINT32 semanticIdx, UINT32 streamIdx, UINT8*& data,
+				UINT32& stride) const;
+
+			MeshData* mData = nullptr;
+			UINT32 mVertexOffset = 0;
+			UINT32 mNumVertices = 0;
+			UINT32 mIndexOffset = 0;
+			UINT32 mNumIndices = 0;
+		};
+
+		/**
+		 * Creates a new builder.
+		 *
+		 * @param[in]	maxVertices		Maximum number of vertices the mesh can contain.
+		 * @param[in]	maxIndices		Maximum number of indices the mesh can contain.
+		 * @param[in]	vertexDesc		Layout of the vertices.
+		 * @param[in]	indexType		Size of the indices.
+		 */
+		MeshBuilder(UINT32 maxVertices, UINT32 maxIndices, const SPtr<VertexDataDesc>& vertexDesc,
+			IndexType indexType = IT_32BIT);
+
+		/**
+		 * Reserves room for a number of vertices and indices. Returns an invalid chunk if the builder doesn't have
+		 * enough room left.
+		 */
+		Chunk reserve(UINT32 numVertices, UINT32 numIndices);
+
+		/** Returns the number of vertices reserved so far. */
+		UINT32 getNumVertices() const { return (UINT32)(mUsed.load(std::memory_order_relaxed) >> 32); }
+
+		/** Returns the number of indices reserved so far. */
+		UINT32 getNumIndices() const { return (UINT32)mUsed.load(std::memory_order_relaxed); }
+
+		/**
+		 * Completes the build and returns the data containing all the reserved vertices and indices. If less than the
+		 * maximum number of vertices or indices were reserved, the data is compacted in place.
+		 */
+		SPtr<MeshData> finalize();
+
+		/**
+		 * Completes the build and creates a mesh from the data. The builder doesn't keep a reference to the data, so
+		 * unless the mesh is created with MU_CPUCACHED usage the data is freed as soon as it is uploaded to the GPU.
+		 *
+		 * @param[in]	desc	Properties of the mesh. The number of vertices and indices, the vertex layout and the
+		 *						index type are taken from the builder. If no sub-meshes are provided, a single triangle
+		 *						list sub-mesh spanning all the indices is used.
+		 */
+		HMesh createMesh(MESH_DESC desc = MESH_DESC::DEFAULT);
+
+		/** Completes the build and allocates a mesh from the provided mesh heap, initialized with the built data. */
+		SPtr<TransientMesh> createTransientMesh(const SPtr<MeshHeap>& heap,
+			DrawOperationType drawOp = DOT_TRIANGLE_LIST);
+
+	private:
+		SPtr<MeshData> mData;
+		UINT32 mMaxVertices;
+		UINT32 mMaxIndices;
+
+		// Number of reserved vertices in the high 32 bits, and indices in the low 32 bits
+		std::atomic<UINT64> mUsed{0};
+	};
+
+	/** @} */
+}
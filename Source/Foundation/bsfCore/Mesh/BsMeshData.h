@@ -285,6 +285,7 @@ namespace bs
 		friend class ct::Mesh;
 		friend class MeshHeap;
 		friend class ct::MeshHeap;
+		friend class MeshBuilder;
 
 		UINT32 mDescBuilding;
 
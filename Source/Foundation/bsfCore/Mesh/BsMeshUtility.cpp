@@ -5,78 +5,339 @@
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
 #include "Math/BsPlane.h"
+#include "Utility/BsBitwise.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
-	struct VertexFaces
+	/** Number of faces or vertices processed by a single task when calculating the tangent space in parallel. */
+	static constexpr UINT32 PARALLEL_GRAIN_SIZE = 4096;
+
+	/** Reads a single index from an index buffer. */
+	static UINT32 readIndex(const UINT8* indices, UINT32 idx, UINT32 indexSize)
 	{
-		UINT32* faces;
-		UINT32 numFaces = 0;
-	};
+		if (indexSize == 4)
+			return ((const UINT32*)indices)[idx];
+
+		UINT32 value = 0;
+		memcpy(&value, indices + idx * indexSize, indexSize);
+		return value;
+	}
 
-	struct VertexConnectivity
+	/**
+	 * Reads vertex indices of up to four consecutive faces, with one array per triangle corner. If less than four faces
+	 * are read, the remaining entries repeat the first face.
+	 */
+	static void readFaces(const UINT8* indices, UINT32 firstFace, UINT32 count, UINT32 indexSize,
+		UINT32 (&corners)[3][4])
 	{
-		VertexConnectivity(UINT8* indices, UINT32 numVertices, UINT32 numFaces, UINT32 indexSize)
-			:vertexFaces(nullptr), mMaxFacesPerVertex(0), mNumVertices(numVertices), mFaces(nullptr)
+		for (UINT32 i = 0; i < 4; i++)
 		{
-			vertexFaces = bs_newN<VertexFaces>(numVertices);
+			const UINT32 faceIdx = firstFace + std::min(i, count - 1);
+			for (UINT32 j = 0; j < 3; j++)
+				corners[j][i] = readIndex(indices, faceIdx * 3 + j, indexSize);
+		}
+	}
 
-			resizeFaceArray(10);
+	/** Executes @p worker over the range [0, @p count), using the task scheduler if the range is large enough. */
+	static void parallelFor(UINT32 count, const std::function<void(UINT32, UINT32)>& worker)
+	{
+		if (count > PARALLEL_GRAIN_SIZE && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor(count, PARALLEL_GRAIN_SIZE, worker);
+		else
+			worker(0, count);
+	}
 
-			for (UINT32 i = 0; i < numFaces; i++)
+	/**
+	 * Lists the faces referencing each vertex. Faces of all vertices are stored in a single array, in order of
+	 * vertices, and the faces of a single vertex in order they appear in the index buffer.
+	 */
+	struct VertexFaces
+	{
+		VertexFaces(const UINT8* indices, UINT32 numVertices, UINT32 numFaces, UINT32 indexSize)
+			:offsets(numVertices + 1, 0), faces(numFaces * 3)
+		{
+			const UINT32 numIndices = numFaces * 3;
+			for (UINT32 i = 0; i < numIndices; i++)
 			{
-				for (UINT32 j = 0; j < 3; j++)
-				{
-					UINT32 idx = i * 3 + j;
-					UINT32 vertexIdx = 0;
-					memcpy(&vertexIdx, indices + idx * indexSize, indexSize);
+				const UINT32 vertexIdx = readIndex(indices, i, indexSize);
+				assert(vertexIdx < numVertices);
 
-					assert(vertexIdx < mNumVertices);
-					VertexFaces& faces = vertexFaces[vertexIdx];
-					if (faces.numFaces >= mMaxFacesPerVertex)
-						resizeFaceArray(mMaxFacesPerVertex * 2);
+				offsets[vertexIdx + 1]++;
+			}
 
-					faces.faces[faces.numFaces] = i;
-					faces.numFaces++;
-				}
+			for (UINT32 i = 0; i < numVertices; i++)
+				offsets[i + 1] += offsets[i];
+
+			Vector<UINT32> cursors(offsets.begin(), offsets.end() - 1);
+			for (UINT32 i = 0; i < numIndices; i++)
+			{
+				const UINT32 vertexIdx = readIndex(indices, i, indexSize);
+				faces[cursors[vertexIdx]++] = i / 3;
 			}
 		}
 
-		~VertexConnectivity()
+		/** Index of the first face of each vertex in the @p faces array, followed by the total number of entries. */
+		Vector<UINT32> offsets;
+		Vector<UINT32> faces;
+	};
+
+	/** Four three-component vectors, with one SIMD register per component. */
+	struct Vector3x4
+	{
+		Vector3x4 operator+ (const Vector3x4& rhs) const
 		{
-			if (vertexFaces != nullptr)
-				bs_deleteN(vertexFaces, mNumVertices);
+			return { simd::add(x, rhs.x), simd::add(y, rhs.y), simd::add(z, rhs.z) };
+		}
 
-			if (mFaces != nullptr)
-				bs_free(mFaces);
+		Vector3x4 operator- (const Vector3x4& rhs) const
+		{
+			return { simd::sub(x, rhs.x), simd::sub(y, rhs.y), simd::sub(z, rhs.z) };
 		}
 
-		VertexFaces* vertexFaces;
+		Vector3x4 operator* (const simd::float32x4& rhs) const
+		{
+			return { simd::mul(x, rhs), simd::mul(y, rhs), simd::mul(z, rhs) };
+		}
 
-	private:
-		void resizeFaceArray(UINT32 numFaces)
+		simd::float32x4 x, y, z;
+	};
+
+	/** Calculates the dot product of each of the four vector pairs. */
+	static simd::float32x4 dot(const Vector3x4& a, const Vector3x4& b)
+	{
+		return simd::add(simd::add(simd::mul(a.x, b.x), simd::mul(a.y, b.y)), simd::mul(a.z, b.z));
+	}
+
+	/** Calculates the cross product of each of the four vector pairs. */
+	static Vector3x4 cross(const Vector3x4& a, const Vector3x4& b)
+	{
+		return {
+			simd::sub(simd::mul(a.y, b.z), simd::mul(a.z, b.y)),
+			simd::sub(simd::mul(a.z, b.x), simd::mul(a.x, b.z)),
+			simd::sub(simd::mul(a.x, b.y), simd::mul(a.y, b.x)) };
+	}
+
+	/** Normalizes the four vectors. Same as Vector3::normalize(), vectors too short to normalize are left unchanged. */
+	static Vector3x4 normalize(const Vector3x4& v)
+	{
+		const simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
+		const simd::float32x4 length = simd::sqrt(dot(v, v));
+		const simd::float32x4 invLength = simd::blend(simd::div(one, length), one,
+			simd::cmp_gt(length, simd::splat<simd::float32x4>(1e-08f)));
+
+		return v * invLength;
+	}
+
+	/** Loads four three-component vectors from a strided buffer. */
+	static Vector3x4 gatherVector3(const UINT8* data, UINT32 stride, const UINT32 (&idx)[4])
+	{
+		const Vector3& a = *(const Vector3*)(data + (size_t)idx[0] * stride);
+		const Vector3& b = *(const Vector3*)(data + (size_t)idx[1] * stride);
+		const Vector3& c = *(const Vector3*)(data + (size_t)idx[2] * stride);
+		const Vector3& d = *(const Vector3*)(data + (size_t)idx[3] * stride);
+
+		return {
+			simd::make_float(a.x, b.x, c.x, d.x),
+			simd::make_float(a.y, b.y, c.y, d.y),
+			simd::make_float(a.z, b.z, c.z, d.z) };
+	}
+
+	/** Loads four two-component vectors from a strided buffer, with one register per component. */
+	static void gatherVector2(const UINT8* data, UINT32 stride, const UINT32 (&idx)[4], simd::float32x4& x,
+		simd::float32x4& y)
+	{
+		const Vector2& a = *(const Vector2*)(data + (size_t)idx[0] * stride);
+		const Vector2& b = *(const Vector2*)(data + (size_t)idx[1] * stride);
+		const Vector2& c = *(const Vector2*)(data + (size_t)idx[2] * stride);
+		const Vector2& d = *(const Vector2*)(data + (size_t)idx[3] * stride);
+
+		x = simd::make_float(a.x, b.x, c.x, d.x);
+		y = simd::make_float(a.y, b.y, c.y, d.y);
+	}
+
+	/** Stores the first @p count of the four vectors as consecutive Vector4 entries, with a zero W component. */
+	static void storeVector4(const Vector3x4& v, UINT32 count, Vector4* output)
+	{
+		simd::float32x4 rows[4] = { v.x, v.y, v.z, simd::make_zero() };
+		simd::transpose4(rows[0], rows[1], rows[2], rows[3]);
+
+		for (UINT32 i = 0; i < count; i++)
+			simd::store_u(&output[i], rows[i]);
+	}
+
+	/** Stores the first @p count of the four vectors as consecutive Vector3 entries. */
+	static void storeVector3(const Vector3x4& v, UINT32 count, Vector3* output)
+	{
+		SIMDPP_ALIGN(16) float x[4];
+		SIMDPP_ALIGN(16) float y[4];
+		SIMDPP_ALIGN(16) float z[4];
+		simd::store(x, v.x);
+		simd::store(y, v.y);
+		simd::store(z, v.z);
+
+		for (UINT32 i = 0; i < count; i++)
+			output[i] = Vector3(x[i], y[i], z[i]);
+	}
+
+	/** Sums the per-face values of all faces referencing each of up to four consecutive vertices. */
+	static Vector3x4 sumFaceValues(const VertexFaces& vertexFaces, const Vector4* faceValues, UINT32 firstVertex,
+		UINT32 count)
+	{
+		simd::float32x4 rows[4];
+		for (UINT32 i = 0; i < 4; i++)
 		{
-			UINT32* newFaces = (UINT32*)bs_alloc(numFaces * mNumVertices * sizeof(UINT32));
+			rows[i] = simd::make_zero();
+			if (i >= count)
+				continue;
+
+			const UINT32 end = vertexFaces.offsets[firstVertex + i + 1];
+			for (UINT32 j = vertexFaces.offsets[firstVertex + i]; j < end; j++)
+				rows[i] = simd::add(rows[i], simd::load_u<simd::float32x4>(&faceValues[vertexFaces.faces[j]]));
+		}
 
-			if (mFaces != nullptr)
+		simd::transpose4(rows[0], rows[1], rows[2], rows[3]);
+		return { rows[0], rows[1], rows[2] };
+	}
+
+	/** 
+	 * Calculates per-vertex normals by averaging the normals of the faces referencing each vertex, as described by
+	 * MeshUtility::calculateNormals(). Faces and vertices are processed four at a time, split between worker threads if
+	 * there are many of them. Each thread writes to its own range of the output, so no synchronization is needed.
+	 */
+	static void calculateNormals(const Vector3* vertices, const UINT8* indices, UINT32 numVertices, UINT32 numFaces,
+		UINT32 indexSize, const VertexFaces& vertexFaces, Vector3* normals)
+	{
+		// Note: Potentially don't normalize the face normals in order to weigh them by triangle size
+		Vector<Vector4> faceNormals(numFaces);
+		parallelFor(numFaces, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i += 4)
 			{
-				for (UINT32 i = 0; i < mNumVertices; i++)
-					memcpy(newFaces + (i * numFaces), mFaces + (i * mMaxFacesPerVertex), mMaxFacesPerVertex * sizeof(UINT32));
+				const UINT32 count = std::min(end - i, 4U);
 
-				bs_free(mFaces);
+				UINT32 corners[3][4];
+				readFaces(indices, i, count, indexSize, corners);
+
+				const Vector3x4 p0 = gatherVector3((const UINT8*)vertices, sizeof(Vector3), corners[0]);
+				const Vector3x4 p1 = gatherVector3((const UINT8*)vertices, sizeof(Vector3), corners[1]);
+				const Vector3x4 p2 = gatherVector3((const UINT8*)vertices, sizeof(Vector3), corners[2]);
+
+				storeVector4(normalize(cross(p1 - p0, p2 - p0)), count, &faceNormals[i]);
 			}
+		});
 
-			for (UINT32 i = 0; i < mNumVertices; i++)
-				vertexFaces[i].faces = newFaces + (i * numFaces);
+		parallelFor(numVertices, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i += 4)
+			{
+				const UINT32 count = std::min(end - i, 4U);
+				storeVector3(normalize(sumFaceValues(vertexFaces, faceNormals.data(), i, count)), count, &normals[i]);
+			}
+		});
+	}
 
-			mFaces = newFaces;
-			mMaxFacesPerVertex = numFaces;
-		}
+	/** 
+	 * Calculates per-vertex tangents and bitangents, as described by MeshUtility::calculateTangents(). Processed in the
+	 * same way as calculateNormals().
+	 */
+	static void calculateTangents(const UINT8* positions, const UINT8* normals, const UINT8* uvs, UINT32 vec3Stride,
+		UINT32 vec2Stride, const UINT8* indices, UINT32 numVertices, UINT32 numFaces, UINT32 indexSize,
+		const VertexFaces& vertexFaces, Vector3* tangents, Vector3* bitangents)
+	{
+		// Note: Potentially don't normalize the face tangents in order to weigh them by triangle size
+		Vector<Vector4> faceTangents(numFaces);
+		Vector<Vector4> faceBitangents(numFaces);
+		parallelFor(numFaces, [&](UINT32 start, UINT32 end)
+		{
+			const simd::float32x4 zero = simd::make_zero();
+			const simd::float32x4 one = simd::splat<simd::float32x4>(1.0f);
 
-		UINT32 mMaxFacesPerVertex;
-		UINT32 mNumVertices;
-		UINT32* mFaces;
-	};
+			for (UINT32 i = start; i < end; i += 4)
+			{
+				const UINT32 count = std::min(end - i, 4U);
+
+				UINT32 corners[3][4];
+				readFaces(indices, i, count, indexSize, corners);
+
+				const Vector3x4 p0 = gatherVector3(positions, vec3Stride, corners[0]);
+				const Vector3x4 q0 = gatherVector3(positions, vec3Stride, corners[1]) - p0;
+				const Vector3x4 q1 = gatherVector3(positions, vec3Stride, corners[2]) - p0;
+
+				simd::float32x4 u0, v0, u1, v1, u2, v2;
+				gatherVector2(uvs, vec2Stride, corners[0], u0, v0);
+				gatherVector2(uvs, vec2Stride, corners[1], u1, v1);
+				gatherVector2(uvs, vec2Stride, corners[2], u2, v2);
+
+				const simd::float32x4 s1 = simd::sub(u1, u0);
+				const simd::float32x4 t1 = simd::sub(v1, v0);
+				const simd::float32x4 s2 = simd::sub(u2, u0);
+				const simd::float32x4 t2 = simd::sub(v2, v0);
+
+				const simd::float32x4 denom = simd::sub(simd::mul(s1, t2), simd::mul(s2, t1));
+				const simd::float32x4 r = simd::div(one, denom);
+
+				Vector3x4 tangent = normalize((q0 * t2 - q1 * t1) * r);
+				Vector3x4 bitangent = normalize((q1 * s1 - q0 * s2) * r);
+
+				// Faces with degenerate UV coordinates don't contribute to the tangents
+				const auto valid = simd::cmp_neq(denom, zero);
+				tangent = { simd::blend(tangent.x, zero, valid), simd::blend(tangent.y, zero, valid),
+					simd::blend(tangent.z, zero, valid) };
+				bitangent = { simd::blend(bitangent.x, zero, valid), simd::blend(bitangent.y, zero, valid),
+					simd::blend(bitangent.z, zero, valid) };
+
+				storeVector4(tangent, count, &faceTangents[i]);
+				storeVector4(bitangent, count, &faceBitangents[i]);
+			}
+		});
+
+		parallelFor(numVertices, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i += 4)
+			{
+				const UINT32 count = std::min(end - i, 4U);
+
+				UINT32 vertexIndices[4];
+				for (UINT32 j = 0; j < 4; j++)
+					vertexIndices[j] = i + std::min(j, count - 1);
+
+				Vector3x4 tangent = normalize(sumFaceValues(vertexFaces, faceTangents.data(), i, count));
+				Vector3x4 bitangent = normalize(sumFaceValues(vertexFaces, faceBitangents.data(), i, count));
+				const Vector3x4 normal = gatherVector3(normals, vec3Stride, vertexIndices);
+
+				// Orthonormalize
+				tangent = normalize(tangent - normal * dot(normal, tangent));
+
+				const simd::float32x4 dot0 = dot(normal, bitangent);
+				const simd::float32x4 dot1 = dot(tangent, bitangent);
+				bitangent = normalize(bitangent - (normal * dot0 + tangent * dot1));
+
+				storeVector3(tangent, count, &tangents[i]);
+				storeVector3(bitangent, count, &bitangents[i]);
+			}
+		});
+
+		// TODO - Consider weighing tangents by triangle size and/or edge angles
+	}
+
+	/** Converts four values in [-1, 1] range into 8-bit unsigned normalized values. */
+	static simd::int32x4 packUNorm8(const simd::float32x4& value)
+	{
+		const simd::float32x4 half = simd::splat<simd::float32x4>(127.5f);
+		const simd::int32x4 output = simd::to_int32(simd::add(simd::mul(value, half), half));
+
+		return simd::min(simd::max(output, simd::splat<simd::int32x4>(0)), simd::splat<simd::int32x4>(255));
+	}
+
+	/** Converts four 8-bit unsigned normalized values, from the lowest byte of each input, into [-1, 1] range. */
+	static simd::float32x4 unpackUNorm8(const simd::int32x4& value)
+	{
+		const simd::float32x4 unorm = simd::to_float32(simd::bit_and(value, simd::splat<simd::int32x4>(0xFF)));
+		return simd::sub(simd::mul(unorm, simd::splat<simd::float32x4>((1.0f / 255.0f) * 2.0f)),
+			simd::splat<simd::float32x4>(1.0f));
+	}
 
 	/** Provides base methods required for clipping of arbitrary triangles. */
 	class TriangleClipperBase // Implementation from: http://www.geometrictools.com/Documentation/ClipMesh.pdf
@@ -724,136 +985,844 @@ namespace bs
 		bs_frame_clear();
 	}
 
-	void MeshUtility::calculateNormals(Vector3* vertices, UINT8* indices, UINT32 numVertices,
-		UINT32 numIndices, Vector3* normals, UINT32 indexSize)
+	/** Symmetric 4x4 matrix representing the sum of squared distances to a set of planes. */
+	struct SimplifyQuadric
 	{
-		UINT32 numFaces = numIndices / 3;
+		SimplifyQuadric() = default;
 
-		Vector3* faceNormals = bs_newN<Vector3>(numFaces);
-		for (UINT32 i = 0; i < numFaces; i++)
+		/** Constructs a quadric from a plane, weighted by the provided value. */
+		SimplifyQuadric(const Vector3& normal, float d, float weight)
 		{
-			UINT32 triangle[3];
-			memcpy(&triangle[0], indices + (i * 3 + 0) * indexSize, indexSize);
-			memcpy(&triangle[1], indices + (i * 3 + 1) * indexSize, indexSize);
-			memcpy(&triangle[2], indices + (i * 3 + 2) * indexSize, indexSize);
+			a2 = normal.x * normal.x * weight;
+			ab = normal.x * normal.y * weight;
+			ac = normal.x * normal.z * weight;
+			ad = normal.x * d * weight;
+			b2 = normal.y * normal.y * weight;
+			bc = normal.y * normal.z * weight;
+			bd = normal.y * d * weight;
+			c2 = normal.z * normal.z * weight;
+			cd = normal.z * d * weight;
+			d2 = d * d * weight;
+		}
 
-			Vector3 edgeA = vertices[triangle[1]] - vertices[triangle[0]];
-			Vector3 edgeB = vertices[triangle[2]] - vertices[triangle[0]];
-			faceNormals[i] = Vector3::normalize(Vector3::cross(edgeA, edgeB));
+		SimplifyQuadric& operator+=(const SimplifyQuadric& rhs)
+		{
+			a2 += rhs.a2; ab += rhs.ab; ac += rhs.ac; ad += rhs.ad;
+			b2 += rhs.b2; bc += rhs.bc; bd += rhs.bd;
+			c2 += rhs.c2; cd += rhs.cd;
+			d2 += rhs.d2;
 
-			// Note: Potentially don't normalize here in order to weigh the normals
-			// by triangle size
+			return *this;
 		}
 
-		VertexConnectivity connectivity(indices, numVertices, numFaces, indexSize);
-		for (UINT32 i = 0; i < numVertices; i++)
+		/** Returns the error of placing a vertex at the provided position. */
+		float evaluate(const Vector3& p) const
 		{
-			VertexFaces& faces = connectivity.vertexFaces[i];
+			const float rx = a2 * p.x + ab * p.y + ac * p.z + ad;
+			const float ry = ab * p.x + b2 * p.y + bc * p.z + bd;
+			const float rz = ac * p.x + bc * p.y + c2 * p.z + cd;
+			const float rw = ad * p.x + bd * p.y + cd * p.z + d2;
+
+			return std::abs(rx * p.x + ry * p.y + rz * p.z + rw);
+		}
+
+		float a2 = 0.0f, ab = 0.0f, ac = 0.0f, ad = 0.0f;
+		float b2 = 0.0f, bc = 0.0f, bd = 0.0f;
+		float c2 = 0.0f, cd = 0.0f;
+		float d2 = 0.0f;
+	};
+
+	/** Potential collapse of vertex @p from onto vertex @p to. */
+	struct SimplifyCollapse
+	{
+		UINT32 from;
+		UINT32 to;
+		float cost;
+	};
+
+	/** Reads indices of the provided size into an array of 32-bit indices. */
+	static void readIndices(const UINT8* indices, UINT32 numIndices, UINT32 indexSize, Vector<UINT32>& output)
+	{
+		output.resize(numIndices);
+		for (UINT32 i = 0; i < numIndices; i++)
+		{
+			UINT32 index = 0;
+			memcpy(&index, indices + i * indexSize, indexSize);
+			output[i] = index;
+		}
+	}
+
+	/** Writes an array of 32-bit indices into a buffer of indices of the provided size. */
+	static void writeIndices(const Vector<UINT32>& indices, UINT32 indexSize, UINT8* output)
+	{
+		for (UINT32 i = 0; i < (UINT32)indices.size(); i++)
+			memcpy(output + i * indexSize, &indices[i], indexSize);
+	}
+
+	/** Number of entries in the vertex cache modeled when reordering triangles for vertex cache efficiency. */
+	static constexpr UINT32 VERTEX_CACHE_SIZE = 32;
+
+	/** Number of entries in the FIFO vertex cache used for estimating cache misses when splitting triangle clusters. */
+	static constexpr UINT32 FIFO_CACHE_SIZE = 16;
+
+	/**
+	 * Calculates the score of a vertex used for picking the next triangle to emit, based on its position in the vertex
+	 * cache and the number of triangles still using it. Position is negative if the vertex isn't in the cache.
+	 */
+	static float getVertexCacheScore(INT32 cachePosition, UINT32 numRemainingTriangles)
+	{
+		if (numRemainingTriangles == 0)
+			return -1.0f;
 
-			normals[i] = Vector3::ZERO;
-			for (UINT32 j = 0; j < faces.numFaces; j++)
+		float score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			// Vertices of the last triangle get a fixed score, so that none of them is preferred over the others
+			if (cachePosition < 3)
+				score = 0.75f;
+			else
 			{
-				UINT32 faceIdx = faces.faces[j];
-				normals[i] += faceNormals[faceIdx];
+				const float scale = 1.0f / (VERTEX_CACHE_SIZE - 3);
+				score = std::pow(1.0f - (cachePosition - 3) * scale, 1.5f);
 			}
-
-			normals[i].normalize();
 		}
 
-		bs_deleteN(faceNormals, numFaces);
+		// Favor vertices with few remaining triangles, so they can be removed from the cache
+		score += 2.0f / std::sqrt((float)numRemainingTriangles);
+		return score;
+	}
+
+	void MeshUtility::calculateNormals(Vector3* vertices, UINT8* indices, UINT32 numVertices,
+		UINT32 numIndices, Vector3* normals, UINT32 indexSize)
+	{
+		const UINT32 numFaces = numIndices / 3;
+
+		VertexFaces vertexFaces(indices, numVertices, numFaces, indexSize);
+		bs::calculateNormals(vertices, indices, numVertices, numFaces, indexSize, vertexFaces, normals);
 	}
 
 	void MeshUtility::calculateTangents(Vector3* vertices, Vector3* normals, Vector2* uv, UINT8* indices, UINT32 numVertices,
 		UINT32 numIndices, Vector3* tangents, Vector3* bitangents, UINT32 indexSize, UINT32 vertexStride)
 	{
-		UINT32 numFaces = numIndices / 3;
-		UINT32 vec2Stride = vertexStride == 0 ? sizeof(Vector2) : vertexStride;
-		UINT32 vec3Stride = vertexStride == 0 ? sizeof(Vector3) : vertexStride;
+		const UINT32 numFaces = numIndices / 3;
+		const UINT32 vec2Stride = vertexStride == 0 ? sizeof(Vector2) : vertexStride;
+		const UINT32 vec3Stride = vertexStride == 0 ? sizeof(Vector3) : vertexStride;
 
-		UINT8* positionBytes = (UINT8*)vertices;
-		UINT8* normalBytes = (UINT8*)normals;
-		UINT8* uvBytes = (UINT8*)uv;
+		VertexFaces vertexFaces(indices, numVertices, numFaces, indexSize);
+		bs::calculateTangents((UINT8*)vertices, (UINT8*)normals, (UINT8*)uv, vec3Stride, vec2Stride, indices,
+			numVertices, numFaces, indexSize, vertexFaces, tangents, bitangents);
+	}
 
-		Vector3* faceTangents = bs_newN<Vector3>(numFaces);
-		Vector3* faceBitangents = bs_newN<Vector3>(numFaces);
-		for (UINT32 i = 0; i < numFaces; i++)
+	void MeshUtility::calculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
+		UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize)
+	{
+		const UINT32 numFaces = numIndices / 3;
+
+		// Both passes need the same connectivity information, so only build it once
+		VertexFaces vertexFaces(indices, numVertices, numFaces, indexSize);
+		bs::calculateNormals(vertices, indices, numVertices, numFaces, indexSize, vertexFaces, normals);
+		bs::calculateTangents((UINT8*)vertices, (UINT8*)normals, (UINT8*)uv, sizeof(Vector3), sizeof(Vector2), indices,
+			numVertices, numFaces, indexSize, vertexFaces, tangents, bitangents);
+	}
+
+	UINT32 MeshUtility::simplify(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices, 
+		UINT32 targetNumIndices, UINT8* output, UINT32 indexSize)
+	{
+		// Limits the number of passes for meshes that cannot be reduced to the target
+		static constexpr UINT32 MAX_PASSES = 64;
+
+		Vector<UINT32> triangles(numIndices);
+		for (UINT32 i = 0; i < numIndices; i++)
 		{
-			UINT32 triangle[3];
-			memcpy(&triangle[0], indices + (i * 3 + 0) * indexSize, indexSize);
-			memcpy(&triangle[1], indices + (i * 3 + 1) * indexSize, indexSize);
-			memcpy(&triangle[2], indices + (i * 3 + 2) * indexSize, indexSize);
+			UINT32 index = 0;
+			memcpy(&index, indices + i * indexSize, indexSize);
+			triangles[i] = index;
+		}
 
-			Vector3 p0 = *(Vector3*)&positionBytes[triangle[0] * vec3Stride];
-			Vector3 p1 = *(Vector3*)&positionBytes[triangle[1] * vec3Stride];
-			Vector3 p2 = *(Vector3*)&positionBytes[triangle[2] * vec3Stride];
+		// Accumulate plane quadrics of the surrounding triangles, weighted by triangle area
+		Vector<SimplifyQuadric> quadrics(numVertices);
+		for (UINT32 i = 0; i < numIndices; i += 3)
+		{
+			const Vector3& p0 = vertices[triangles[i + 0]];
+			const Vector3& p1 = vertices[triangles[i + 1]];
+			const Vector3& p2 = vertices[triangles[i + 2]];
 
-			Vector2 uv0 = *(Vector2*)&uvBytes[triangle[0] * vec2Stride];
-			Vector2 uv1 = *(Vector2*)&uvBytes[triangle[1] * vec2Stride];
-			Vector2 uv2 = *(Vector2*)&uvBytes[triangle[2] * vec2Stride];
+			Vector3 normal = Vector3::cross(p1 - p0, p2 - p0);
+			const float area = normal.length();
+			if (area <= 0.0f)
+				continue;
 
-			Vector3 q0 = p1 - p0;
-			Vector3 q1 = p2 - p0;
+			normal /= area;
+			const SimplifyQuadric quadric(normal, -normal.dot(p0), area * 0.5f);
 
-			Vector2 st1 = uv1 - uv0;
-			Vector2 st2 = uv2 - uv0;
+			for (UINT32 j = 0; j < 3; j++)
+				quadrics[triangles[i + j]] += quadric;
+		}
 
-			float denom = st1.x * st2.y - st2.x * st1.y;
-			if (fabs(denom) >= 0e-8f)
+		// Lock vertices on open edges, so that the mesh silhouette and attribute seams are preserved
+		Vector<bool> locked(numVertices, false);
+		{
+			UnorderedMap<UINT64, UINT32> edgeCounts;
+			for (UINT32 i = 0; i < numIndices; i += 3)
+			{
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					const UINT32 a = triangles[i + j];
+					const UINT32 b = triangles[i + (j + 1) % 3];
+					const UINT64 key = ((UINT64)std::min(a, b) << 32) | std::max(a, b);
+
+					edgeCounts[key]++;
+				}
+			}
+
+			for (auto& entry : edgeCounts)
+			{
+				if (entry.second == 2)
+					continue;
+
+				locked[(UINT32)(entry.first >> 32)] = true;
+				locked[(UINT32)(entry.first & 0xFFFFFFFF)] = true;
+			}
+		}
+
+		Vector<UINT32> remap(numVertices);
+		Vector<bool> touched(numVertices);
+		Vector<UINT32> vertexTriangleOffsets(numVertices + 1);
+		Vector<UINT32> vertexTriangles;
+		Vector<SimplifyCollapse> collapses;
+
+		auto numTriangleIndices = (UINT32)triangles.size();
+		for (UINT32 pass = 0; pass < MAX_PASSES && numTriangleIndices > targetNumIndices; pass++)
+		{
+			// Build the list of triangles referencing each vertex
+			vertexTriangleOffsets.assign(numVertices + 1, 0);
+			for (UINT32 i = 0; i < numTriangleIndices; i++)
+				vertexTriangleOffsets[triangles[i] + 1]++;
+
+			for (UINT32 i = 0; i < numVertices; i++)
+				vertexTriangleOffsets[i + 1] += vertexTriangleOffsets[i];
+
+			vertexTriangles.resize(numTriangleIndices);
 			{
-				float r = 1.0f / denom;
+				Vector<UINT32> writeOffsets(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end() - 1);
+				for (UINT32 i = 0; i < numTriangleIndices; i++)
+					vertexTriangles[writeOffsets[triangles[i]]++] = i / 3;
+			}
 
-				faceTangents[i] = (st2.y * q0 - st1.y * q1) * r;
-				faceBitangents[i] = (st1.x * q1 - st2.x * q0) * r;
+			// Evaluate the cost of collapsing each edge, in both directions
+			collapses.clear();
+			for (UINT32 i = 0; i < numTriangleIndices; i += 3)
+			{
+				for (UINT32 j = 0; j < 3; j++)
+				{
+					const UINT32 a = triangles[i + j];
+					const UINT32 b = triangles[i + (j + 1) % 3];
 
-				faceTangents[i].normalize();
-				faceBitangents[i].normalize();
+					SimplifyQuadric quadric = quadrics[a];
+					quadric += quadrics[b];
+
+					if (!locked[a])
+						collapses.push_back({ a, b, quadric.evaluate(vertices[b]) });
+
+					if (!locked[b])
+						collapses.push_back({ b, a, quadric.evaluate(vertices[a]) });
+				}
 			}
 
-			// Note: Potentially don't normalize here in order to weight the normals by triangle size
+			std::sort(collapses.begin(), collapses.end(), 
+				[](const SimplifyCollapse& lhs, const SimplifyCollapse& rhs) { return lhs.cost < rhs.cost; });
+
+			// Perform the cheapest collapses. Vertices in the neighborhood of a collapse cannot participate in another
+			// collapse during the same pass, so the flip test below stays valid.
+			for (UINT32 i = 0; i < numVertices; i++)
+				remap[i] = i;
+
+			touched.assign(numVertices, false);
+
+			UINT32 numRemainingIndices = numTriangleIndices;
+			UINT32 numCollapsed = 0;
+			for (auto& collapse : collapses)
+			{
+				if (numRemainingIndices <= targetNumIndices)
+					break;
+
+				if (touched[collapse.from] || touched[collapse.to])
+					continue;
+
+				// Reject collapses that flip or degenerate any of the triangles that remain after the collapse
+				const Vector3& target = vertices[collapse.to];
+				UINT32 numRemoved = 0;
+				bool valid = true;
+				for (UINT32 j = vertexTriangleOffsets[collapse.from]; j < vertexTriangleOffsets[collapse.from + 1]; j++)
+				{
+					const UINT32* triangle = &triangles[vertexTriangles[j] * 3];
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					{
+						numRemoved++;
+						continue;
+					}
+
+					Vector3 positions[3] = { vertices[triangle[0]], vertices[triangle[1]], vertices[triangle[2]] };
+					const Vector3 oldNormal = Vector3::cross(positions[1] - positions[0], positions[2] - positions[0]);
+
+					for (UINT32 k = 0; k < 3; k++)
+					{
+						if (triangle[k] == collapse.from)
+							positions[k] = target;
+					}
+
+					const Vector3 newNormal = Vector3::cross(positions[1] - positions[0], positions[2] - positions[0]);
+					if (oldNormal.dot(newNormal) <= 0.0f)
+					{
+						valid = false;
+						break;
+					}
+				}
+
+				if (!valid || numRemoved == 0)
+					continue;
+
+				for (UINT32 j = vertexTriangleOffsets[collapse.from]; j < vertexTriangleOffsets[collapse.from + 1]; j++)
+				{
+					const UINT32* triangle = &triangles[vertexTriangles[j] * 3];
+					for (UINT32 k = 0; k < 3; k++)
+						touched[triangle[k]] = true;
+				}
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to] += quadrics[collapse.from];
+
+				numRemainingIndices -= numRemoved * 3;
+				numCollapsed++;
+			}
+
+			if (numCollapsed == 0)
+				break;
+
+			// Apply the collapses and remove the degenerate triangles
+			UINT32 numWritten = 0;
+			for (UINT32 i = 0; i < numTriangleIndices; i += 3)
+			{
+				const UINT32 a = remap[triangles[i + 0]];
+				const UINT32 b = remap[triangles[i + 1]];
+				const UINT32 c = remap[triangles[i + 2]];
+
+				if (a == b || b == c || a == c)
+					continue;
+
+				triangles[numWritten + 0] = a;
+				triangles[numWritten + 1] = b;
+				triangles[numWritten + 2] = c;
+				numWritten += 3;
+			}
+
+			numTriangleIndices = numWritten;
+		}
+
+		for (UINT32 i = 0; i < numTriangleIndices; i++)
+			memcpy(output + i * indexSize, &triangles[i], indexSize);
+
+		return numTriangleIndices;
+	}
+
+	void MeshUtility::optimizeVertexCache(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT8* output, 
+		UINT32 indexSize)
+	{
+		const UINT32 numTriangles = numIndices / 3;
+
+		Vector<UINT32> triangles;
+		readIndices(indices, numTriangles * 3, indexSize, triangles);
+
+		// Build the list of triangles referencing each vertex. Triangles are removed from the list as they are emitted,
+		// by swapping them past the end of the active range.
+		Vector<UINT32> vertexTriangleOffsets(numVertices + 1, 0);
+		for (auto& index : triangles)
+			vertexTriangleOffsets[index + 1]++;
+
+		for (UINT32 i = 0; i < numVertices; i++)
+			vertexTriangleOffsets[i + 1] += vertexTriangleOffsets[i];
+
+		Vector<UINT32> numRemaining(numVertices);
+		Vector<UINT32> vertexTriangles(triangles.size());
+		for (UINT32 i = 0; i < numVertices; i++)
+			numRemaining[i] = vertexTriangleOffsets[i + 1] - vertexTriangleOffsets[i];
+
+		{
+			Vector<UINT32> writeOffsets(vertexTriangleOffsets.begin(), vertexTriangleOffsets.end() - 1);
+			for (UINT32 i = 0; i < (UINT32)triangles.size(); i++)
+				vertexTriangles[writeOffsets[triangles[i]]++] = i / 3;
 		}
 
-		VertexConnectivity connectivity(indices, numVertices, numFaces, indexSize);
+		Vector<INT32> cachePositions(numVertices, -1);
+		Vector<float> vertexScores(numVertices);
 		for (UINT32 i = 0; i < numVertices; i++)
+			vertexScores[i] = getVertexCacheScore(-1, numRemaining[i]);
+
+		Vector<float> triangleScores(numTriangles);
+		for (UINT32 i = 0; i < numTriangles; i++)
+		{
+			const UINT32* triangle = &triangles[i * 3];
+			triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+		}
+
+		Vector<bool> emitted(numTriangles, false);
+		Vector<UINT32> outputTriangles;
+		outputTriangles.reserve(triangles.size());
+
+		// Cache temporarily holds the vertices of the emitted triangle in addition to its regular entries
+		UINT32 cache[VERTEX_CACHE_SIZE + 3];
+		UINT32 newCache[VERTEX_CACHE_SIZE + 3];
+		UINT32 cacheSize = 0;
+
+		UINT32 nextUnemitted = 0;
+		INT32 bestTriangle = -1;
+		float bestScore = -1.0f;
+		for (UINT32 i = 0; i < numTriangles; i++)
+		{
+			if (triangleScores[i] > bestScore)
+			{
+				bestScore = triangleScores[i];
+				bestTriangle = (INT32)i;
+			}
+		}
+
+		for (UINT32 i = 0; i < numTriangles; i++)
+		{
+			// No triangles adjacent to the cached vertices remain, continue with the next triangle in input order
+			if (bestTriangle < 0)
+			{
+				while (emitted[nextUnemitted])
+					nextUnemitted++;
+
+				bestTriangle = (INT32)nextUnemitted;
+			}
+
+			const UINT32* triangle = &triangles[bestTriangle * 3];
+			emitted[bestTriangle] = true;
+
+			UINT32 newCacheSize = 0;
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				const UINT32 vertex = triangle[j];
+				outputTriangles.push_back(vertex);
+
+				// Remove the triangle from the vertex's list of remaining triangles
+				const UINT32 start = vertexTriangleOffsets[vertex];
+				const UINT32 end = start + numRemaining[vertex];
+				for (UINT32 k = start; k < end; k++)
+				{
+					if (vertexTriangles[k] == (UINT32)bestTriangle)
+					{
+						std::swap(vertexTriangles[k], vertexTriangles[end - 1]);
+						break;
+					}
+				}
+
+				numRemaining[vertex]--;
+				newCache[newCacheSize++] = vertex;
+			}
+
+			// Move the vertices of the emitted triangle to the front of the cache
+			for (UINT32 j = 0; j < cacheSize; j++)
+			{
+				const UINT32 vertex = cache[j];
+				if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+					newCache[newCacheSize++] = vertex;
+			}
+
+			// Update scores of the vertices whose cache position changed, including the ones pushed out of the cache
+			for (UINT32 j = 0; j < newCacheSize; j++)
+			{
+				const UINT32 vertex = newCache[j];
+				cachePositions[vertex] = j < VERTEX_CACHE_SIZE ? (INT32)j : -1;
+				vertexScores[vertex] = getVertexCacheScore(cachePositions[vertex], numRemaining[vertex]);
+			}
+
+			cacheSize = std::min(newCacheSize, VERTEX_CACHE_SIZE);
+			memcpy(cache, newCache, cacheSize * sizeof(UINT32));
+
+			// Update scores of the triangles using the affected vertices, and find the best one to emit next
+			bestTriangle = -1;
+			bestScore = -1.0f;
+			for (UINT32 j = 0; j < newCacheSize; j++)
+			{
+				const UINT32 vertex = newCache[j];
+				const UINT32 start = vertexTriangleOffsets[vertex];
+				const UINT32 end = start + numRemaining[vertex];
+				for (UINT32 k = start; k < end; k++)
+				{
+					const UINT32 triangleIdx = vertexTriangles[k];
+					const UINT32* adjacent = &triangles[triangleIdx * 3];
+
+					const float score = 
+						vertexScores[adjacent[0]] + vertexScores[adjacent[1]] + vertexScores[adjacent[2]];
+					triangleScores[triangleIdx] = score;
+
+					if (score > bestScore)
+					{
+						bestScore = score;
+						bestTriangle = (INT32)triangleIdx;
+					}
+				}
+			}
+		}
+
+		writeIndices(outputTriangles, indexSize, output);
+	}
+
+	void MeshUtility::optimizeOverdraw(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices, 
+		UINT8* output, float threshold, UINT32 indexSize)
+	{
+		const UINT32 numTriangles = numIndices / 3;
+
+		Vector<UINT32> triangles;
+		readIndices(indices, numTriangles * 3, indexSize, triangles);
+
+		// Simulates a FIFO vertex cache and returns the number of misses for the next triangle
+		Vector<UINT32> cacheTimestamps(numVertices, 0);
+		UINT32 timestamp = FIFO_CACHE_SIZE + 1;
+		auto simulateTriangle = [&](UINT32 triangleIdx)
+		{
+			UINT32 misses = 0;
+			for (UINT32 i = 0; i < 3; i++)
+			{
+				const UINT32 vertex = triangles[triangleIdx * 3 + i];
+				if (timestamp - cacheTimestamps[vertex] > FIFO_CACHE_SIZE)
+				{
+					cacheTimestamps[vertex] = timestamp++;
+					misses++;
+				}
+			}
+
+			return misses;
+		};
+
+		auto resetCache = [&]()
+		{
+			timestamp += FIFO_CACHE_SIZE + 1;
+		};
+
+		// Hard boundaries are placed where the vertex cache is flushed (all the vertices of a triangle miss), meaning
+		// triangles on either side can be reordered without affecting the cache efficiency
+		Vector<UINT32> hardBoundaries;
+		Vector<UINT32> triangleMisses(numTriangles);
+		for (UINT32 i = 0; i < numTriangles; i++)
+		{
+			triangleMisses[i] = simulateTriangle(i);
+			if (i == 0 || triangleMisses[i] == 3)
+				hardBoundaries.push_back(i);
+		}
+
+		hardBoundaries.push_back(numTriangles);
+
+		// Split the clusters between the hard boundaries further, as long as the cache efficiency of the split clusters
+		// stays within the threshold of the original cluster
+		Vector<UINT32> clusters;
+		for (UINT32 i = 0; i + 1 < (UINT32)hardBoundaries.size(); i++)
 		{
-			VertexFaces& faces = connectivity.vertexFaces[i];
+			const UINT32 start = hardBoundaries[i];
+			const UINT32 end = hardBoundaries[i + 1];
+
+			UINT32 clusterMisses = 0;
+			for (UINT32 j = start; j < end; j++)
+				clusterMisses += triangleMisses[j];
 
-			tangents[i] = Vector3::ZERO;
-			bitangents[i] = Vector3::ZERO;
+			const float clusterThreshold = threshold * clusterMisses / (float)(end - start);
 
-			for (UINT32 j = 0; j < faces.numFaces; j++)
+			resetCache();
+			clusters.push_back(start);
+
+			UINT32 clusterStart = start;
+			UINT32 misses = 0;
+			for (UINT32 j = start; j < end; j++)
 			{
-				UINT32 faceIdx = faces.faces[j];
-				tangents[i] += faceTangents[faceIdx];
-				bitangents[i] += faceBitangents[faceIdx];
+				misses += simulateTriangle(j);
+
+				if (j + 1 < end && misses / (float)(j - clusterStart + 1) <= clusterThreshold)
+				{
+					resetCache();
+					clusters.push_back(j + 1);
+
+					clusterStart = j + 1;
+					misses = 0;
+				}
 			}
+		}
 
-			tangents[i].normalize();
-			bitangents[i].normalize();
+		clusters.push_back(numTriangles);
+		const auto numClusters = (UINT32)clusters.size() - 1;
 
-			Vector3 normal = *(Vector3*)&normalBytes[i * vec3Stride];
+		// Calculate the area weighted centroid and normal of each cluster, and the centroid of the entire mesh
+		Vector<Vector3> clusterCentroids(numClusters, Vector3::ZERO);
+		Vector<Vector3> clusterNormals(numClusters, Vector3::ZERO);
+		Vector3 meshCentroid = Vector3::ZERO;
+		float meshArea = 0.0f;
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			float clusterArea = 0.0f;
+			for (UINT32 j = clusters[i]; j < clusters[i + 1]; j++)
+			{
+				const Vector3& p0 = vertices[triangles[j * 3 + 0]];
+				const Vector3& p1 = vertices[triangles[j * 3 + 1]];
+				const Vector3& p2 = vertices[triangles[j * 3 + 2]];
 
-			// Orthonormalize
-			float dot0 = normal.dot(tangents[i]);
-			tangents[i] -= dot0*normal;
-			tangents[i].normalize();
+				const Vector3 normal = Vector3::cross(p1 - p0, p2 - p0);
+				const float area = normal.length();
 
-			float dot1 = tangents[i].dot(bitangents[i]);
-			dot0 = normal.dot(bitangents[i]);
-			bitangents[i] -= dot0*normal + dot1*tangents[i];
-			bitangents[i].normalize();
+				clusterCentroids[i] += (p0 + p1 + p2) * (area / 3.0f);
+				clusterNormals[i] += normal;
+				clusterArea += area;
+			}
+
+			meshCentroid += clusterCentroids[i];
+			meshArea += clusterArea;
+
+			if (clusterArea > 0.0f)
+				clusterCentroids[i] /= clusterArea;
+
+			clusterNormals[i] = Vector3::normalize(clusterNormals[i]);
 		}
 
-		bs_deleteN(faceTangents, numFaces);
-		bs_deleteN(faceBitangents, numFaces);
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
 
-		// TODO - Consider weighing tangents by triangle size and/or edge angles
+		// Render clusters facing away from the center first, since they are more likely to occlude other clusters
+		Vector<UINT32> clusterOrder(numClusters);
+		Vector<float> clusterSortKeys(numClusters);
+		for (UINT32 i = 0; i < numClusters; i++)
+		{
+			clusterOrder[i] = i;
+			clusterSortKeys[i] = (clusterCentroids[i] - meshCentroid).dot(clusterNormals[i]);
+		}
+
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(), 
+			[&](UINT32 lhs, UINT32 rhs) { return clusterSortKeys[lhs] > clusterSortKeys[rhs]; });
+
+		Vector<UINT32> outputTriangles;
+		outputTriangles.reserve(triangles.size());
+		for (auto& cluster : clusterOrder)
+		{
+			outputTriangles.insert(outputTriangles.end(), 
+				triangles.begin() + clusters[cluster] * 3, triangles.begin() + clusters[cluster + 1] * 3);
+		}
+
+		writeIndices(outputTriangles, indexSize, output);
 	}
 
-	void MeshUtility::calculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices,
-		UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize)
+	void MeshUtility::optimizeVertexFetch(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT32* remap, 
+		UINT32 indexSize)
+	{
+		static constexpr UINT32 UNASSIGNED = (UINT32)-1;
+
+		for (UINT32 i = 0; i < numVertices; i++)
+			remap[i] = UNASSIGNED;
+
+		Vector<UINT32> triangles;
+		readIndices(indices, numIndices, indexSize, triangles);
+
+		UINT32 nextVertex = 0;
+		for (auto& index : triangles)
+		{
+			if (remap[index] == UNASSIGNED)
+				remap[index] = nextVertex++;
+
+			index = remap[index];
+		}
+
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			if (remap[i] == UNASSIGNED)
+				remap[i] = nextVertex++;
+		}
+
+		writeIndices(triangles, indexSize, indices);
+	}
+
+	/** Calculates the bounding sphere and the normal cone of a meshlet, from the triangles it references. */
+	static void calculateMeshletBounds(const Vector3* vertices, const UINT32* indices, Meshlet& meshlet)
+	{
+		const UINT32 numFaces = meshlet.indexCount / 3;
+
+		Vector3 min = vertices[indices[0]];
+		Vector3 max = min;
+		for (UINT32 i = 1; i < meshlet.indexCount; i++)
+		{
+			min = Vector3::min(min, vertices[indices[i]]);
+			max = Vector3::max(max, vertices[indices[i]]);
+		}
+
+		// Box center isn't the tightest bound, but it is close enough for the small number of vertices in a meshlet
+		const Vector3 center = (min + max) * 0.5f;
+
+		float radiusSqrd = 0.0f;
+		for (UINT32 i = 0; i < meshlet.indexCount; i++)
+			radiusSqrd = std::max(radiusSqrd, center.squaredDistance(vertices[indices[i]]));
+
+		meshlet.boundsCenter = center;
+		meshlet.boundsRadius = std::sqrt(radiusSqrd);
+
+		// Degenerate triangles are never rasterized and therefore ignored when determining the cone
+		Vector3 normalSum = Vector3::ZERO;
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			const Vector3& v0 = vertices[indices[i * 3 + 0]];
+			const Vector3& v1 = vertices[indices[i * 3 + 1]];
+			const Vector3& v2 = vertices[indices[i * 3 + 2]];
+
+			const Vector3 normal = (v1 - v0).cross(v2 - v0);
+			const float length = normal.length();
+			if (length > 1e-20f)
+				normalSum += normal / length;
+		}
+
+		meshlet.coneAxis = Vector3::ZERO;
+		meshlet.coneCutoff = 1.0f;
+
+		const float sumLength = normalSum.length();
+		if (sumLength < 1e-6f)
+			return;
+
+		const Vector3 axis = normalSum / sumLength;
+
+		float minDot = 1.0f;
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			const Vector3& v0 = vertices[indices[i * 3 + 0]];
+			const Vector3& v1 = vertices[indices[i * 3 + 1]];
+			const Vector3& v2 = vertices[indices[i * 3 + 2]];
+
+			const Vector3 normal = (v1 - v0).cross(v2 - v0);
+			const float length = normal.length();
+			if (length > 1e-20f)
+				minDot = std::min(minDot, axis.dot(normal) / length);
+		}
+
+		// Normals spread over more than a hemisphere, some triangle always faces the viewer
+		meshlet.coneAxis = axis;
+		if (minDot <= 0.0f)
+			return;
+
+		// Back-facing region of all normals is the inverted normal cone, widened by 90 degrees on each side
+		meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+
+	void MeshUtility::generateMeshlets(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices,
+		Vector<Meshlet>& meshlets, UINT32 maxVertices, UINT32 maxTriangles, UINT32 indexSize)
 	{
-		calculateNormals(vertices, indices, numVertices, numIndices, normals, indexSize);
-		calculateTangents(vertices, normals, uv, indices, numVertices, numIndices, tangents, bitangents, indexSize);
+		static constexpr UINT32 UNASSIGNED = (UINT32)-1;
+
+		assert(maxVertices >= 3 && maxTriangles > 0);
+
+		const UINT32 numFaces = numIndices / 3;
+		if (numFaces == 0)
+			return;
+
+		Vector<UINT32> triangles;
+		readIndices(indices, numFaces * 3, indexSize, triangles);
+
+		const VertexFaces vertexFaces(indices, numVertices, numFaces, indexSize);
+
+		// Last meshlet each vertex was added to, and last meshlet each face was a candidate for
+		Vector<UINT32> vertexMeshlet(numVertices, UNASSIGNED);
+		Vector<UINT32> faceCandidate(numFaces, UNASSIGNED);
+		Vector<bool> faceEmitted(numFaces, false);
+
+		Vector<UINT32> output;
+		output.reserve(numFaces * 3);
+
+		Vector<UINT32> candidates;
+		UINT32 meshletIdx = 0;
+		UINT32 nextSeed = 0;
+		while (output.size() < numFaces * 3)
+		{
+			const auto meshletStart = (UINT32)output.size();
+			UINT32 numMeshletVertices = 0;
+			UINT32 numMeshletFaces = 0;
+			candidates.clear();
+
+			// New meshlets start from the first remaining face, following the input order
+			while (faceEmitted[nextSeed])
+				nextSeed++;
+
+			UINT32 face = nextSeed;
+			while (true)
+			{
+				faceEmitted[face] = true;
+				numMeshletFaces++;
+
+				for (UINT32 i = 0; i < 3; i++)
+				{
+					const UINT32 vertexIdx = triangles[face * 3 + i];
+					output.push_back(vertexIdx);
+
+					if (vertexMeshlet[vertexIdx] == meshletIdx)
+						continue;
+
+					vertexMeshlet[vertexIdx] = meshletIdx;
+					numMeshletVertices++;
+
+					for (UINT32 j = vertexFaces.offsets[vertexIdx]; j < vertexFaces.offsets[vertexIdx + 1]; j++)
+					{
+						const UINT32 neighbor = vertexFaces.faces[j];
+						if (faceEmitted[neighbor] || faceCandidate[neighbor] == meshletIdx)
+							continue;
+
+						faceCandidate[neighbor] = meshletIdx;
+						candidates.push_back(neighbor);
+					}
+				}
+
+				if (numMeshletFaces == maxTriangles)
+					break;
+
+				// Pick the neighbor that adds the fewest new vertices to the meshlet
+				UINT32 bestFace = UNASSIGNED;
+				UINT32 bestNumNew = 4;
+				for (UINT32 i = 0; i < (UINT32)candidates.size();)
+				{
+					const UINT32 candidate = candidates[i];
+					if (faceEmitted[candidate])
+					{
+						candidates[i] = candidates.back();
+						candidates.pop_back();
+						continue;
+					}
+
+					UINT32 numNew = 0;
+					for (UINT32 j = 0; j < 3; j++)
+					{
+						if (vertexMeshlet[triangles[candidate * 3 + j]] != meshletIdx)
+							numNew++;
+					}
+
+					if (numNew < bestNumNew)
+					{
+						bestFace = candidate;
+						bestNumNew = numNew;
+
+						if (numNew == 0)
+							break;
+					}
+
+					i++;
+				}
+
+				if (bestFace == UNASSIGNED || numMeshletVertices + bestNumNew > maxVertices)
+					break;
+
+				face = bestFace;
+			}
+
+			Meshlet meshlet;
+			meshlet.indexOffset = meshletStart;
+			meshlet.indexCount = numMeshletFaces * 3;
+			calculateMeshletBounds(vertices, output.data() + meshletStart, meshlet);
+
+			meshlets.push_back(meshlet);
+			meshletIdx++;
+		}
+
+		writeIndices(output, indexSize, indices);
 	}
 
 	void MeshUtility::clip2D(UINT8* vertices, UINT8* uvs, UINT32 numTris, UINT32 vertexStride, const Vector<Plane>& clipPlanes,
@@ -872,9 +1841,34 @@ namespace bs
 
 	void MeshUtility::packNormals(Vector3* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride)
 	{
+		const UINT32 indices[4] = { 0, 1, 2, 3 };
+		const simd::int32x4 packedW = simd::splat<simd::int32x4>(128 << 24);
+
 		UINT8* srcPtr = (UINT8*)source;
 		UINT8* dstPtr = destination;
-		for (UINT32 i = 0; i < count; i++)
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const Vector3x4 src = gatherVector3(srcPtr, inStride, indices);
+
+			const simd::int32x4 packed = simd::bit_or(
+				simd::bit_or(packUNorm8(src.x), simd::shift_l<8>(packUNorm8(src.y))),
+				simd::bit_or(simd::shift_l<16>(packUNorm8(src.z)), packedW));
+
+			SIMDPP_ALIGN(16) UINT32 output[4];
+			simd::store(output, packed);
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				*(UINT32*)dstPtr = output[j];
+				dstPtr += outStride;
+			}
+
+			srcPtr += inStride * 4;
+		}
+
+		for (; i < count; i++)
 		{
 			Vector3 src = *(Vector3*)srcPtr;
 
@@ -893,7 +1887,34 @@ namespace bs
 	{
 		UINT8* srcPtr = (UINT8*)source;
 		UINT8* dstPtr = destination;
-		for (UINT32 i = 0; i < count; i++)
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			simd::float32x4 src[4];
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				src[j] = simd::load_u<simd::float32x4>(srcPtr);
+				srcPtr += inStride;
+			}
+
+			simd::transpose4(src[0], src[1], src[2], src[3]);
+
+			const simd::int32x4 packed = simd::bit_or(
+				simd::bit_or(packUNorm8(src[0]), simd::shift_l<8>(packUNorm8(src[1]))),
+				simd::bit_or(simd::shift_l<16>(packUNorm8(src[2])), simd::shift_l<24>(packUNorm8(src[3]))));
+
+			SIMDPP_ALIGN(16) UINT32 output[4];
+			simd::store(output, packed);
+
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				*(UINT32*)dstPtr = output[j];
+				dstPtr += outStride;
+			}
+		}
+
+		for (; i < count; i++)
 		{
 			Vector4 src = *(Vector4*)srcPtr;
 			PackedNormal& packed = *(PackedNormal*)dstPtr;
@@ -911,7 +1932,23 @@ namespace bs
 	void MeshUtility::unpackNormals(UINT8* source, Vector3* destination, UINT32 count, UINT32 stride)
 	{
 		UINT8* ptr = source;
-		for (UINT32 i = 0; i < count; i++)
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const simd::int32x4 packed = simd::make_int(*(INT32*)ptr, *(INT32*)(ptr + stride),
+				*(INT32*)(ptr + stride * 2), *(INT32*)(ptr + stride * 3));
+
+			const Vector3x4 output = {
+				unpackUNorm8(packed),
+				unpackUNorm8(simd::shift_r<8>(packed)),
+				unpackUNorm8(simd::shift_r<16>(packed)) };
+
+			storeVector3(output, 4, &destination[i]);
+			ptr += stride * 4;
+		}
+
+		for (; i < count; i++)
 		{
 			destination[i] = unpackNormal(ptr);
 
@@ -922,7 +1959,28 @@ namespace bs
 	void MeshUtility::unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride)
 	{
 		UINT8* ptr = source;
-		for (UINT32 i = 0; i < count; i++)
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const simd::int32x4 packed = simd::make_int(*(INT32*)ptr, *(INT32*)(ptr + stride),
+				*(INT32*)(ptr + stride * 2), *(INT32*)(ptr + stride * 3));
+
+			simd::float32x4 output[4] = {
+				unpackUNorm8(packed),
+				unpackUNorm8(simd::shift_r<8>(packed)),
+				unpackUNorm8(simd::shift_r<16>(packed)),
+				unpackUNorm8(simd::shift_r<24>(packed)) };
+
+			simd::transpose4(output[0], output[1], output[2], output[3]);
+
+			for (UINT32 j = 0; j < 4; j++)
+				simd::store_u(&destination[i + j], output[j]);
+
+			ptr += stride * 4;
+		}
+
+		for (; i < count; i++)
 		{
 			PackedNormal& packed = *(PackedNormal*)ptr;
 
@@ -935,4 +1993,78 @@ namespace bs
 			ptr += stride;
 		}
 	}
+
+	void MeshUtility::packUVs(Vector2* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride)
+	{
+		UINT8* srcPtr = (UINT8*)source;
+		UINT8* dstPtr = destination;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const Vector2& src = *(Vector2*)srcPtr;
+
+			UINT16* packed = (UINT16*)dstPtr;
+			packed[0] = Bitwise::floatToHalf(src.x);
+			packed[1] = Bitwise::floatToHalf(src.y);
+
+			srcPtr += inStride;
+			dstPtr += outStride;
+		}
+	}
+
+	void MeshUtility::unpackUVs(UINT8* source, Vector2* destination, UINT32 count, UINT32 stride)
+	{
+		UINT8* ptr = source;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const UINT16* packed = (UINT16*)ptr;
+			destination[i].x = Bitwise::halfToFloat(packed[0]);
+			destination[i].y = Bitwise::halfToFloat(packed[1]);
+
+			ptr += stride;
+		}
+	}
+
+	void MeshUtility::packBoneWeights(Vector4* source, UINT8* destination, UINT32 count, UINT32 inStride, 
+		UINT32 outStride)
+	{
+		UINT8* srcPtr = (UINT8*)source;
+		UINT8* dstPtr = destination;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const Vector4& src = *(Vector4*)srcPtr;
+
+			INT32 packed[4];
+			INT32 sum = 0;
+			UINT32 largest = 0;
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				packed[j] = Math::clamp((INT32)(src[j] * 255.0f + 0.5f), 0, 255);
+				sum += packed[j];
+
+				if (packed[j] > packed[largest])
+					largest = j;
+			}
+
+			// Assign the rounding error to the most influential bone, so the weights still sum up to one
+			if (sum > 0)
+				packed[largest] = Math::clamp(packed[largest] + 255 - sum, 0, 255);
+
+			for (UINT32 j = 0; j < 4; j++)
+				dstPtr[j] = (UINT8)packed[j];
+
+			srcPtr += inStride;
+			dstPtr += outStride;
+		}
+	}
+
+	void MeshUtility::unpackBoneWeights(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride)
+	{
+		UINT8* ptr = source;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			destination[i] = unpackBoneWeight(ptr);
+
+			ptr += stride;
+		}
+	}
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include "BsCorePrerequisites.h"
 #include "Math/BsVector3.h"
+#include "Math/BsVector4.h"
+#include "RenderAPI/BsSubMesh.h"
 
 namespace bs
 {
@@ -25,7 +27,10 @@ namespace bs
 		UINT32 packed;
 	};
 
-	/** Performs various operations on mesh geometry. */
+	/** 
+	 * Performs various operations on mesh geometry. Normal and tangent generation of large meshes is split between the
+	 * task scheduler's worker threads, if the task scheduler is running.
+	 */
 	class BS_CORE_EXPORT MeshUtility
 	{
 	public:
@@ -100,6 +105,102 @@ namespace bs
 		static void calculateTangentSpace(Vector3* vertices, Vector2* uv, UINT8* indices, UINT32 numVertices, 
 			UINT32 numIndices, Vector3* normals, Vector3* tangents, Vector3* bitangents, UINT32 indexSize = 4);
 
+		/**
+		 * Generates a simplified version of a triangle list by repeatedly collapsing the edges that introduce the lowest
+		 * quadric error. Vertices are never moved or created, instead edges are collapsed onto one of their end points,
+		 * meaning the output indices reference the original vertex array and can share the same vertex buffer. Vertices
+		 * on open edges (including seams where vertices were split due to attribute discontinuities) are never removed.
+		 *
+		 * @param[in]	vertices			Set of vertices containing vertex positions.
+		 * @param[in]	indices				Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]	numVertices			Number of vertices in the @p vertices array.
+		 * @param[in]	numIndices			Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[in]	targetNumIndices	Number of indices to reduce the mesh to. The result can contain more indices
+		 *									if the mesh cannot be reduced further without removing open edges or flipping
+		 *									triangles.
+		 * @param[out]	output				Pre-allocated buffer that will contain the simplified indices. Must be the
+		 *									same size as the @p indices array.
+		 * @param[in]	indexSize			Size of a single index in the @p indices and @p output arrays, in bytes.
+		 * @return							Number of indices written to @p output.
+		 */
+		static UINT32 simplify(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices, 
+			UINT32 targetNumIndices, UINT8* output, UINT32 indexSize = 4);
+
+		/**
+		 * Reorders the triangles of a triangle list so that triangles sharing vertices are rendered close to each
+		 * other, improving the hit rate of the post-transform vertex cache. Uses the linear-speed algorithm by Tom
+		 * Forsyth, which doesn't depend on the exact cache size of the hardware.
+		 *
+		 * @param[in]	indices			Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]	numVertices		Number of vertices referenced by the @p indices array.
+		 * @param[in]	numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[out]	output			Pre-allocated buffer that will contain the reordered indices. Must be the same
+		 *								size as the @p indices array, and must not overlap it.
+		 * @param[in]	indexSize		Size of a single index in the @p indices and @p output arrays, in bytes.
+		 */
+		static void optimizeVertexCache(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT8* output, 
+			UINT32 indexSize = 4);
+
+		/**
+		 * Reorders the triangles of a triangle list so that triangles facing outwards from the center of the mesh are
+		 * rendered first, reducing overdraw. Triangles are split into clusters which are then sorted, so that most of
+		 * the vertex cache efficiency of the input order is retained. Input should be optimized using
+		 * optimizeVertexCache() first.
+		 *
+		 * @param[in]	vertices		Set of vertices containing vertex positions.
+		 * @param[in]	indices			Set of indices containing indexes into vertex array for each triangle.
+		 * @param[in]	numVertices		Number of vertices in the @p vertices array.
+		 * @param[in]	numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[out]	output			Pre-allocated buffer that will contain the reordered indices. Must be the same
+		 *								size as the @p indices array, and must not overlap it.
+		 * @param[in]	threshold		Determines how much can the vertex cache efficiency degrade in exchange for
+		 *								smaller clusters, which can be sorted more accurately. Value of 1.05 allows the
+		 *								cache miss ratio to increase by up to 5%.
+		 * @param[in]	indexSize		Size of a single index in the @p indices and @p output arrays, in bytes.
+		 */
+		static void optimizeOverdraw(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices, 
+			UINT8* output, float threshold = 1.05f, UINT32 indexSize = 4);
+
+		/**
+		 * Determines a new order of vertices in which they are laid out in the same order as they are first referenced
+		 * by the triangle list, improving the locality of vertex fetches. Indices are updated to reference the new 
+		 * vertex locations, while the vertex data itself needs to be reordered by the caller using the output remap
+		 * table. Vertices not referenced by any triangle are moved to the end.
+		 *
+		 * @param[in, out]	indices		Set of indices containing indexes into vertex array for each triangle. Indices 
+		 *								will be updated to reference the reordered vertices.
+		 * @param[in]		numVertices	Number of vertices referenced by the @p indices array.
+		 * @param[in]		numIndices	Number of indices in the @p indices array.
+		 * @param[out]		remap		Pre-allocated buffer of @p numVertices entries, that will contain the new
+		 *								location of each vertex, indexed by its current location.
+		 * @param[in]		indexSize	Size of a single index in the @p indices array, in bytes.
+		 */
+		static void optimizeVertexFetch(UINT8* indices, UINT32 numVertices, UINT32 numIndices, UINT32* remap, 
+			UINT32 indexSize = 4);
+
+		/**
+		 * Splits a triangle list into meshlets, small clusters of connected triangles that can be culled individually.
+		 * Meshlets are grown from a seed triangle by repeatedly adding the neighboring triangle that references the
+		 * fewest new vertices. Triangles are reordered so the triangles of each meshlet are stored one after another,
+		 * otherwise keeping the input order as much as possible. For each meshlet a bounding sphere and a cone
+		 * containing the normals of its triangles are calculated, used for frustum and back-face culling.
+		 *
+		 * @param[in]		vertices		Set of vertices containing vertex positions.
+		 * @param[in, out]	indices			Set of indices containing indexes into vertex array for each triangle. 
+		 *									Indices are reordered in-place.
+		 * @param[in]		numVertices		Number of vertices in the @p vertices array.
+		 * @param[in]		numIndices		Number of indices in the @p indices array. Must be a multiple of three.
+		 * @param[out]		meshlets		Array the generated meshlets are appended to. Index offsets of the meshlets
+		 *									are relative to the start of the @p indices array.
+		 * @param[in]		maxVertices		Maximum number of unique vertices referenced by a single meshlet. Must be at
+		 *									least three.
+		 * @param[in]		maxTriangles	Maximum number of triangles in a single meshlet.
+		 * @param[in]		indexSize		Size of a single index in the @p indices array, in bytes.
+		 */
+		static void generateMeshlets(Vector3* vertices, UINT8* indices, UINT32 numVertices, UINT32 numIndices,
+			Vector<Meshlet>& meshlets, UINT32 maxVertices = 64, UINT32 maxTriangles = 124,
+			UINT32 indexSize = 4);
+
 		/**
 		 * Clips a set of two-dimensional vertices and uv coordinates against a set of arbitrary planes.
 		 *
@@ -179,6 +280,50 @@ namespace bs
 		 */
 		static void unpackNormals(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride);
 
+		/** 
+		 * Encodes texture coordinates from 32-bit float format into 2D 16-bit floating point format.
+		 *
+		 * @param[in]	source			Buffer containing data to encode. Must have @p count entries.
+		 * @param[out]	destination		Buffer to output the data to. Must have @p count entries, each 32-bits.
+		 * @param[in]	count			Number of entries in the @p source and @p destination arrays.
+		 * @param[in]	inStride		Distance between two entries in the @p source buffer, in bytes.
+		 * @param[in]	outStride		Distance between two entries in the @p destination buffer, in bytes.
+		 */
+		static void packUVs(Vector2* source, UINT8* destination, UINT32 count, UINT32 inStride, UINT32 outStride);
+
+		/** 
+		 * Decodes texture coordinates from 2D 16-bit floating point format into a 32-bit float format.
+		 *
+		 * @param[in]	source			Buffer containing data to decode. Must have @p count entries, each 32-bits.
+		 * @param[out]	destination		Buffer to output the data to. Must have @p count entries.
+		 * @param[in]	count			Number of entries in the @p source and @p destination arrays.
+		 * @param[in]	stride			Distance between two entries in the @p source buffer, in bytes.
+		 */
+		static void unpackUVs(UINT8* source, Vector2* destination, UINT32 count, UINT32 stride);
+
+		/** 
+		 * Encodes bone weights from 32-bit float format into 4D 8-bit normalized format. Weights are rounded so that
+		 * the encoded weights of each entry still sum up to one.
+		 *
+		 * @param[in]	source			Buffer containing data to encode. Must have @p count entries.
+		 * @param[out]	destination		Buffer to output the data to. Must have @p count entries, each 32-bits.
+		 * @param[in]	count			Number of entries in the @p source and @p destination arrays.
+		 * @param[in]	inStride		Distance between two entries in the @p source buffer, in bytes.
+		 * @param[in]	outStride		Distance between two entries in the @p destination buffer, in bytes.
+		 */
+		static void packBoneWeights(Vector4* source, UINT8* destination, UINT32 count, UINT32 inStride, 
+			UINT32 outStride);
+
+		/** 
+		 * Decodes bone weights from 4D 8-bit normalized format into a 32-bit float format.
+		 *
+		 * @param[in]	source			Buffer containing data to decode. Must have @p count entries, each 32-bits.
+		 * @param[out]	destination		Buffer to output the data to. Must have @p count entries.
+		 * @param[in]	count			Number of entries in the @p source and @p destination arrays.
+		 * @param[in]	stride			Distance between two entries in the @p source buffer, in bytes.
+		 */
+		static void unpackBoneWeights(UINT8* source, Vector4* destination, UINT32 count, UINT32 stride);
+
 		/** Decodes a normal from 4D 8-bit packed format into a 32-bit float format. */
 		static Vector3 unpackNormal(const UINT8* source)
 		{
@@ -192,6 +337,13 @@ namespace bs
 
 			return output;
 		}
+
+		/** Decodes a set of bone weights from 4D 8-bit normalized format into a 32-bit float format. */
+		static Vector4 unpackBoneWeight(const UINT8* source)
+		{
+			const float inv = 1.0f / 255.0f;
+			return Vector4(source[0] * inv, source[1] * inv, source[2] * inv, source[3] * inv);
+		}
 	};
 
 	/** @} */
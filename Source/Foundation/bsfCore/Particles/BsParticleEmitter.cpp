@@ -11,6 +11,7 @@
 #include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationManager.h"
 #include "Mesh/BsMesh.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -814,7 +815,7 @@ namespace bs
 				return false;
 			}
 
-			if (blendWeightElement->getType() != VET_FLOAT4)
+			if (blendWeightElement->getType() != VET_FLOAT4 && blendWeightElement->getType() != VET_UBYTE4_NORM)
 			{
 				LOGERR("Skinned mesh particle emitter requires blend weights to be a 4D vector format.");
 				return false;
@@ -847,51 +848,64 @@ namespace bs
 		{
 			mBoneIndices = mMeshData->getElementData(VES_BLEND_INDICES);
 			mBoneWeights = mMeshData->getElementData(VES_BLEND_WEIGHTS);
+			mPackedBoneWeights = vertexDesc->getElement(VES_BLEND_WEIGHTS)->getType() == VET_UBYTE4_NORM;
 		}
 
-		if(!perVertex)
+		// Triangle weights only depend on the bind pose, so they can be kept as long as the mesh data doesn't change
+		if(!perVertex && mWeightedTrianglesSource != mMeshData.get())
+		{
 			mWeightedTriangles.calculate(*mMeshData);
+			mWeightedTrianglesSource = mMeshData.get();
+		}
 
 		return true;
 	}
 
 	void MeshEmissionHelper::getSequentialVertex(class Vector3& position, class Vector3& normal, UINT32& idx) const
 	{
-		idx = mNextSequentialIdx;
-		position = *(Vector3*)(mVertices + mVertexStride * idx);
-
-		if (mNormals)
-		{
-			if (m32BitNormals)
-				normal = MeshUtility::unpackNormal(mNormals + mVertexStride * idx);
-			else
-				normal = *(Vector3*)(mNormals + mVertexStride * idx);
-		}
-		else
-			normal = Vector3::UNIT_Z;
-
-		mNextSequentialIdx = (mNextSequentialIdx + 1) % mNumVertices;
+		idx = getSequentialVertexIdx();
+		getVertex(idx, position, normal);
 	}
 
 	void MeshEmissionHelper::getRandomVertex(const Random& random, Vector3& position, Vector3& normal, 
 		UINT32& idx) const
 	{
-		idx = random.get() % mNumVertices;
-		position = *(Vector3*)(mVertices + mVertexStride * idx);
-
-		if (mNormals)
-		{
-			if (m32BitNormals)
-				normal = MeshUtility::unpackNormal(mNormals + mVertexStride * idx);
-			else
-				normal = *(Vector3*)(mNormals + mVertexStride * idx);
-		}
-		else
-			normal = Vector3::UNIT_Z;
+		idx = getRandomVertexIdx(random);
+		getVertex(idx, position, normal);
 	}
 
 	void MeshEmissionHelper::getRandomEdge(const Random& random, std::array<Vector3, 2>& position, 
 		std::array<Vector3, 2>& normal, std::array<UINT32, 2>& idx) const
+	{
+		getRandomEdgeIdx(random, idx);
+
+		for (uint32_t i = 0; i < 2; i++)
+			getVertex(idx[i], position[i], normal[i]);
+	}
+
+	void MeshEmissionHelper::getRandomTriangle(const Random& random, std::array<Vector3, 3>& position, 
+		std::array<Vector3, 3>& normal, std::array<UINT32, 3>& idx) const
+	{
+		getRandomTriangleIdx(random, idx);
+
+		for (uint32_t i = 0; i < 3; i++)
+			getVertex(idx[i], position[i], normal[i]);
+	}
+
+	UINT32 MeshEmissionHelper::getSequentialVertexIdx() const
+	{
+		const UINT32 idx = mNextSequentialIdx;
+		mNextSequentialIdx = (mNextSequentialIdx + 1) % mNumVertices;
+
+		return idx;
+	}
+
+	UINT32 MeshEmissionHelper::getRandomVertexIdx(const Random& random) const
+	{
+		return random.get() % mNumVertices;
+	}
+
+	void MeshEmissionHelper::getRandomEdgeIdx(const Random& random, std::array<UINT32, 2>& idx) const
 	{
 		std::array<UINT32, 3> triIndices;
 		mWeightedTriangles.getTriangle(random, triIndices);
@@ -915,66 +929,78 @@ namespace bs
 			idx[1] = triIndices[0];
 			break;
 		}
+	}
 
-		position[0] = *(Vector3*)(mVertices + mVertexStride * idx[0]);
-		position[1] = *(Vector3*)(mVertices + mVertexStride * idx[1]);
+	void MeshEmissionHelper::getRandomTriangleIdx(const Random& random, std::array<UINT32, 3>& idx) const
+	{
+		mWeightedTriangles.getTriangle(random, idx);
+	}
+
+	void MeshEmissionHelper::getVertex(UINT32 idx, Vector3& position, Vector3& normal) const
+	{
+		position = *(Vector3*)(mVertices + mVertexStride * idx);
 
 		if (mNormals)
 		{
 			if (m32BitNormals)
-			{
-				normal[0] = MeshUtility::unpackNormal(mNormals + mVertexStride * idx[0]);
-				normal[1] = MeshUtility::unpackNormal(mNormals + mVertexStride * idx[1]);
-			}
+				normal = MeshUtility::unpackNormal(mNormals + mVertexStride * idx);
 			else
-			{
-				normal[0] = *(Vector3*)(mNormals + mVertexStride * idx[0]);
-				normal[1] = *(Vector3*)(mNormals + mVertexStride * idx[1]);
-			}
+				normal = *(Vector3*)(mNormals + mVertexStride * idx);
 		}
 		else
-		{
-			normal[0] = Vector3::UNIT_Z;
-			normal[1] = Vector3::UNIT_Z;
-		}
+			normal = Vector3::UNIT_Z;
 	}
 
-	void MeshEmissionHelper::getRandomTriangle(const Random& random, std::array<Vector3, 3>& position, 
-		std::array<Vector3, 3>& normal, std::array<UINT32, 3>& idx) const
+	void MeshEmissionHelper::skinVertices(const Matrix4* bones, const UINT32* indices, UINT32 count, 
+		Vector3* positions, Vector3* normals) const
 	{
-		mWeightedTriangles.getTriangle(random, idx);
+		for(UINT32 i = 0; i < count; i++)
+			getVertex(indices[i], positions[i], normals[i]);
 
-		for (uint32_t i = 0; i < 3; i++)
+		if(!bones)
+			return;
+
+		for(UINT32 i = 0; i < count; i++)
 		{
-			position[i] = *(Vector3*)(mVertices + mVertexStride * idx[i]);
+			const UINT32 vertexIdx = indices[i];
+			const UINT32 boneIndices = *(UINT32*)(mBoneIndices + vertexIdx * mVertexStride);
+			const UINT8* boneWeightData = mBoneWeights + vertexIdx * mVertexStride;
 
-			if (mNormals)
+			Vector4 unpackedBoneWeights;
+			const float* boneWeights = (const float*)boneWeightData;
+			if (mPackedBoneWeights)
 			{
-				if (m32BitNormals)
-					normal[i] = MeshUtility::unpackNormal(mNormals + mVertexStride * idx[i]);
-				else
-					normal[i] = *(Vector3*)(mNormals + mVertexStride * idx[i]);
+				unpackedBoneWeights = MeshUtility::unpackBoneWeight(boneWeightData);
+				boneWeights = &unpackedBoneWeights.x;
 			}
-			else
-				normal[i] = Vector3::UNIT_Z;
-		}
-	}
 
-	Matrix4 MeshEmissionHelper::getBlendMatrix(const Matrix4* bones, UINT32 vertexIdx) const
-	{
-		if(bones)
-		{
-			const UINT32 boneIndices = *(UINT32*)(mBoneIndices + vertexIdx * mVertexStride);
-			const Vector4& boneWeights = *(Vector4*)(mBoneWeights + vertexIdx * mVertexStride);
+			// Blend only the top three (affine) rows of the bone matrices, one row per SIMD register
+			simd::float32x4 rows[3];
+			for(UINT32 j = 0; j < 4; j++)
+			{
+				const float* bone = &bones[(boneIndices >> (j * 8)) & 0xFF][0].x;
+				const simd::float32x4 weight = simd::load_splat<simd::float32x4>(boneWeights + j);
+
+				for(UINT32 k = 0; k < 3; k++)
+				{
+					const simd::float32x4 row = simd::mul(simd::load_u<simd::float32x4>(bone + k * 4), weight);
+					rows[k] = j == 0 ? row : simd::add(rows[k], row);
+				}
+			}
+
+			float blended[3][4];
+			for(UINT32 k = 0; k < 3; k++)
+				simd::store_u(blended[k], rows[k]);
 
-			return
-				bones[boneIndices & 0xFF] * boneWeights[0] +
-				bones[(boneIndices >> 8) & 0xFF] * boneWeights[1] +
-				bones[(boneIndices >> 16) & 0xFF] * boneWeights[2] +
-				bones[(boneIndices >> 24) & 0xFF] * boneWeights[3];
+			const Vector3 position = positions[i];
+			const Vector3 normal = normals[i];
+			for(UINT32 k = 0; k < 3; k++)
+			{
+				positions[i][k] = blended[k][0] * position.x + blended[k][1] * position.y + blended[k][2] * position.z + 
+					blended[k][3];
+				normals[i][k] = blended[k][0] * normal.x + blended[k][1] * normal.y + blended[k][2] * normal.z;
+			}
 		}
-		else
-			return Matrix4::IDENTITY;
 	}
 
 	ParticleEmitterStaticMeshShape::ParticleEmitterStaticMeshShape(const PARTICLE_STATIC_MESH_SHAPE_DESC& desc)
@@ -1096,7 +1122,7 @@ namespace bs
 		if(!desc.renderable.empty())
 			mesh = desc.renderable.getActor()->getMesh();
 
-		mIsValid = mMeshEmissionHelper.initialize(mesh, desc.type == ParticleEmitterMeshType::Vertex, false);
+		mIsValid = mMeshEmissionHelper.initialize(mesh, desc.type == ParticleEmitterMeshType::Vertex, true);
 	}
 
 	void ParticleEmitterSkinnedMeshShape::setOptions(const PARTICLE_SKINNED_MESH_SHAPE_DESC& options)
@@ -1107,7 +1133,7 @@ namespace bs
 		if(!options.renderable.empty())
 			mesh = options.renderable.getActor()->getMesh();
 
-		mIsValid = mMeshEmissionHelper.initialize(mesh, options.type == ParticleEmitterMeshType::Vertex, false);
+		mIsValid = mMeshEmissionHelper.initialize(mesh, options.type == ParticleEmitterMeshType::Vertex, true);
 	}
 
 	UINT32 ParticleEmitterSkinnedMeshShape::_spawn(const Random& random, ParticleSet& particles, UINT32 count,
@@ -1135,83 +1161,87 @@ namespace bs
 			}
 		}
 
+		// Pick all the vertices up front, so they can be skinned in a single batch
+		UINT32 numVerticesPerParticle;
 		switch(mInfo.type)
 		{
-		case ParticleEmitterMeshType::Vertex: 
-			if(mInfo.sequential)
-			{
-				return spawnMultiple(particles, count, [this, bones]
-				(UINT32 idx, Vector3& position, Vector3& normal)
-				{
-					UINT32 vertexIdx;
-					mMeshEmissionHelper.getSequentialVertex(position, normal, vertexIdx);
+		case ParticleEmitterMeshType::Vertex: numVerticesPerParticle = 1; break;
+		case ParticleEmitterMeshType::Edge: numVerticesPerParticle = 2; break;
+		default:
+		case ParticleEmitterMeshType::Triangle: numVerticesPerParticle = 3; break;
+		}
 
-					Matrix4 blendMatrix = mMeshEmissionHelper.getBlendMatrix(bones, vertexIdx);
-					position = blendMatrix.multiplyAffine(position);
-					normal = blendMatrix.multiplyDirection(normal);
-				});
-			}
-			else
+		const UINT32 numVertices = count * numVerticesPerParticle;
+		UINT32* indices = bs_stack_alloc<UINT32>(numVertices);
+		Vector3* positions = bs_stack_alloc<Vector3>(numVertices);
+		Vector3* normals = bs_stack_alloc<Vector3>(numVertices);
+		float* weights = bs_stack_alloc<float>(numVertices);
+
+		switch(mInfo.type)
+		{
+		case ParticleEmitterMeshType::Vertex:
+			for(UINT32 i = 0; i < count; i++)
 			{
-				return spawnMultiple(particles, count, [this, &random, bones]
-				(UINT32 idx, Vector3& position, Vector3& normal)
-				{
-					UINT32 vertexIdx;
-					mMeshEmissionHelper.getRandomVertex(random, position, normal, vertexIdx);
+				if(mInfo.sequential)
+					indices[i] = mMeshEmissionHelper.getSequentialVertexIdx();
+				else
+					indices[i] = mMeshEmissionHelper.getRandomVertexIdx(random);
 
-					Matrix4 blendMatrix = mMeshEmissionHelper.getBlendMatrix(bones, vertexIdx);
-					position = blendMatrix.multiplyAffine(position);
-					normal = blendMatrix.multiplyDirection(normal);
-				});
+				weights[i] = 1.0f;
 			}
+			break;
 		case ParticleEmitterMeshType::Edge:
-			return spawnMultiple(particles, count, [this, &random, bones]
-			(UINT32 idx, Vector3& position, Vector3& normal)
+			for(UINT32 i = 0; i < count; i++)
 			{
-				std::array<Vector3, 2> edgePositions, edgeNormals;
 				std::array<UINT32, 2> edgeIndices;
-
-				mMeshEmissionHelper.getRandomEdge(random, edgePositions, edgeNormals, edgeIndices);
-
-				for(uint32_t i = 0; i < 2; i++)
-				{
-					Matrix4 blendMatrix = mMeshEmissionHelper.getBlendMatrix(bones, edgeIndices[i]);
-					edgePositions[i] = blendMatrix.multiplyAffine(edgePositions[i]);
-					edgeNormals[i] = blendMatrix.multiplyAffine(edgeNormals[i]);
-				}
+				mMeshEmissionHelper.getRandomEdgeIdx(random, edgeIndices);
 
 				const float rnd = random.getUNorm();
-				position = Math::lerp(rnd, edgePositions[0], edgePositions[1]);
-				normal = Math::lerp(rnd, edgeNormals[0], edgeNormals[1]);
-			});
+				indices[i * 2 + 0] = edgeIndices[0];
+				indices[i * 2 + 1] = edgeIndices[1];
+				weights[i * 2 + 0] = 1.0f - rnd;
+				weights[i * 2 + 1] = rnd;
+			}
+			break;
 		default:
 		case ParticleEmitterMeshType::Triangle:
-			return spawnMultiple(particles, count, [this, &random, bones]
-			(UINT32 idx, Vector3& position, Vector3& normal)
+			for(UINT32 i = 0; i < count; i++)
 			{
-				std::array<Vector3, 3> triPositions, triNormals;
 				std::array<UINT32, 3> triIndices;
+				mMeshEmissionHelper.getRandomTriangleIdx(random, triIndices);
 
-				mMeshEmissionHelper.getRandomTriangle(random, triPositions, triNormals, triIndices);
-
-				position = Vector3::ZERO;
-				normal = Vector3::ZERO;
-				Vector3 barycenter = random.getBarycentric();
-
-				for(uint32_t i = 0; i < 3; i++)
+				const Vector3 barycenter = random.getBarycentric();
+				for(UINT32 j = 0; j < 3; j++)
 				{
-					Matrix4 blendMatrix = mMeshEmissionHelper.getBlendMatrix(bones, triIndices[i]);
-					triPositions[i] = blendMatrix.multiplyAffine(triPositions[i]);
-					triNormals[i] = blendMatrix.multiplyAffine(triNormals[i]);
+					indices[i * 3 + j] = triIndices[j];
+					weights[i * 3 + j] = barycenter[j];
 				}
-
-				for (uint32_t i = 0; i < 3; i++)
-				{
-					position += triPositions[i] * barycenter[i];
-					normal += triNormals[i] * barycenter[i];
-				}
-			});
+			}
+			break;
 		};
+
+		mMeshEmissionHelper.skinVertices(bones, indices, numVertices, positions, normals);
+
+		const UINT32 index = spawnMultiple(particles, count, [numVerticesPerParticle, positions, normals, weights]
+		(UINT32 idx, Vector3& position, Vector3& normal)
+		{
+			const UINT32 start = idx * numVerticesPerParticle;
+
+			position = Vector3::ZERO;
+			normal = Vector3::ZERO;
+			for(UINT32 i = start; i < start + numVerticesPerParticle; i++)
+			{
+				position += positions[i] * weights[i];
+				normal += normals[i] * weights[i];
+			}
+		});
+
+		bs_stack_free(weights);
+		bs_stack_free(normals);
+		bs_stack_free(positions);
+		bs_stack_free(indices);
+
+		return index;
 	}
 
 	void ParticleEmitterSkinnedMeshShape::calcBounds(AABox& shape, AABox& velocity) const
@@ -1281,7 +1311,7 @@ namespace bs
 		const float emitterT = state.nrmTimeEnd;
 
 		// Continous emission rate
-		const float rate = mEmissionRate.evaluate(emitterT, random);
+		const float rate = mEmissionRate.evaluate(emitterT, random) * state.emissionScale;
 
 		mEmitAccumulator += rate * state.timeStep;
 		const auto numContinous = (UINT32)mEmitAccumulator;
@@ -1289,7 +1319,7 @@ namespace bs
 
 		// Bursts
 		UINT32 numBurst = 0;
-		const auto emitBursts = [this, &emitterT, &random](float start, float end)
+		const auto emitBursts = [this, &emitterT, &random, &state](float start, float end)
 		{
 			constexpr float MIN_BURST_INTERVAL = 0.01f;
 
@@ -1305,7 +1335,7 @@ namespace bs
 
 				// Handle initial burst cycle
 				if (relT0 == 0.0f)
-					numBurst += (UINT32)burst.count.evaluate(emitterT, random);
+					numBurst += (UINT32)(burst.count.evaluate(emitterT, random) * state.emissionScale);
 
 				// Handle remaining cycles
 				const float dt = relT1 - relT0;
@@ -1316,7 +1346,7 @@ namespace bs
 				mBurstAccumulator[i] = emitDuration - emitCycles * interval;
 
 				for (UINT32 j = 0; j < emitCycles; j++)
-					numBurst += (UINT32)burst.count.evaluate(emitterT, random);
+					numBurst += (UINT32)(burst.count.evaluate(emitterT, random) * state.emissionScale);
 			}
 
 			return numBurst;
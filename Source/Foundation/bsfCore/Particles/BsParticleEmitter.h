@@ -712,11 +712,38 @@ namespace bs
 		void getRandomTriangle(const Random& random, std::array<Vector3, 3>& position, std::array<Vector3, 3>& normal, 
 			std::array<UINT32, 3>& idx) const;
 
-		/** Evaluates a blend matrix for a vertex at the specified index. */
-		Matrix4 getBlendMatrix(const Matrix4* bones, UINT32 vertexIdx) const;
+		/** Returns the index of the next sequential vertex and increments the internal counter. */
+		UINT32 getSequentialVertexIdx() const;
+
+		/** Returns the index of a randomly picked vertex on the mesh. */
+		UINT32 getRandomVertexIdx(const Random& random) const;
+
+		/** Returns the vertex indices of a randomly picked edge on the mesh. */
+		void getRandomEdgeIdx(const Random& random, std::array<UINT32, 2>& idx) const;
+
+		/** Returns the vertex indices of a randomly picked triangle on the mesh, weighted by triangle area. */
+		void getRandomTriangleIdx(const Random& random, std::array<UINT32, 3>& idx) const;
+
+		/** 
+		 * Reads the positions and normals of the vertices at the provided indices, and transforms them using the 
+		 * provided bone matrices. Only the requested vertices are skinned, allowing the caller to batch all vertices
+		 * needed for a set of particles into a single call.
+		 * 
+		 * @param[in]	bones		Bone matrices to use for skinning. If null the vertices are output in bind pose.
+		 * @param[in]	indices		Indices of the vertices to skin.
+		 * @param[in]	count		Number of entries in the @p indices array.
+		 * @param[out]	positions	Pre-allocated array of @p count entries that receives the skinned positions.
+		 * @param[out]	normals		Pre-allocated array of @p count entries that receives the skinned normals.
+		 */
+		void skinVertices(const Matrix4* bones, const UINT32* indices, UINT32 count, Vector3* positions, 
+			Vector3* normals) const;
 
 	private:
+		/** Reads the bind pose position and normal of the vertex at the specified index. */
+		void getVertex(UINT32 idx, Vector3& position, Vector3& normal) const;
+
 		MeshWeightedTriangles mWeightedTriangles;
+		const MeshData* mWeightedTrianglesSource = nullptr;
 
 		UINT8* mVertices = nullptr;
 		UINT8* mNormals = nullptr;
@@ -726,6 +753,7 @@ namespace bs
 
 		UINT8* mBoneIndices = nullptr;
 		UINT8* mBoneWeights = nullptr;
+		bool mPackedBoneWeights = false;
 
 		SPtr<MeshData> mMeshData;
 
@@ -13,6 +13,7 @@
 #include "Math/BsLineSegment3.h"
 #include "Material/BsShader.h"
 #include "Scene/BsSceneObject.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -27,6 +28,77 @@ namespace bs
 	static constexpr UINT32 PARTICLE_SIZE = 0x91088409;
 	static constexpr UINT32 PARTICLE_ROTATION = 0x4680eaa4;
 
+	/** Maximum number of particles whose normalized lifetime is evaluated at once by forEachParticle(). */
+	static constexpr UINT32 PARTICLE_BATCH_SIZE = 256;
+
+	/** 
+	 * Calculates the normalized lifetime ([0, 1] range) of @p count particles starting at @p startIdx, and writes them
+	 * to @p output. Processes ParticleSetData::SIMD_WIDTH particles at a time.
+	 */
+	static void evaluateNormalizedLifetimes(const ParticleSetData& particles, UINT32 startIdx, UINT32 count, float* output)
+	{
+		const float* initialLifetime = particles.initialLifetime + startIdx;
+		const float* lifetime = particles.lifetime + startIdx;
+
+		UINT32 i = 0;
+		for (; i + ParticleSetData::SIMD_WIDTH <= count; i += ParticleSetData::SIMD_WIDTH)
+		{
+			const simd::float32x4 initial = simd::load_u<simd::float32x4>(initialLifetime + i);
+			const simd::float32x4 current = simd::load_u<simd::float32x4>(lifetime + i);
+
+			simd::store_u(output + i, simd::div(simd::sub(initial, current), initial));
+		}
+
+		for (; i < count; i++)
+			output[i] = (initialLifetime[i] - lifetime[i]) / initialLifetime[i];
+	}
+
+	/** 
+	 * Calls @p func for each particle in the provided range, passing it the particle index and its normalized lifetime. 
+	 * Lifetimes are evaluated in vectorized batches before the callback is executed.
+	 */
+	template<class F>
+	void forEachParticle(const ParticleSetData& particles, UINT32 startIdx, UINT32 count, F func)
+	{
+		float particleT[PARTICLE_BATCH_SIZE];
+
+		const UINT32 endIdx = startIdx + count;
+		for (UINT32 batchStart = startIdx; batchStart < endIdx; batchStart += PARTICLE_BATCH_SIZE)
+		{
+			const UINT32 batchCount = std::min(PARTICLE_BATCH_SIZE, endIdx - batchStart);
+			evaluateNormalizedLifetimes(particles, batchStart, batchCount, particleT);
+
+			for (UINT32 i = 0; i < batchCount; i++)
+				func(batchStart + i, particleT[i]);
+		}
+	}
+
+	/** 
+	 * Adds @p delta to @p count vectors starting at @p values. Vectors are processed ParticleSetData::SIMD_WIDTH at a time
+	 * by treating them as a flat array of floats, in which case the delta components repeat every three registers.
+	 */
+	static void addToAll(Vector3* values, UINT32 count, const Vector3& delta)
+	{
+		const simd::float32x4 delta0 = simd::make_float(delta.x, delta.y, delta.z, delta.x);
+		const simd::float32x4 delta1 = simd::make_float(delta.y, delta.z, delta.x, delta.y);
+		const simd::float32x4 delta2 = simd::make_float(delta.z, delta.x, delta.y, delta.z);
+
+		static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 is expected to contain three tightly packed floats.");
+
+		UINT32 i = 0;
+		for (; i + ParticleSetData::SIMD_WIDTH <= count; i += ParticleSetData::SIMD_WIDTH)
+		{
+			float* data = &values[i].x;
+
+			simd::store_u(data + 0, simd::add(simd::load_u<simd::float32x4>(data + 0), delta0));
+			simd::store_u(data + 4, simd::add(simd::load_u<simd::float32x4>(data + 4), delta1));
+			simd::store_u(data + 8, simd::add(simd::load_u<simd::float32x4>(data + 8), delta2));
+		}
+
+		for (; i < count; i++)
+			values[i] += delta;
+	}
+
 	/** Helper method that applies a transform to either a point or a direction. */
 	template<bool dir>
 	Vector3 applyTransform(const Matrix4& tfrm, const Vector3& input)
@@ -161,16 +233,13 @@ namespace bs
 	void ParticleOrbit::evolve(Random& random, const ParticleSystemState& state, ParticleSet& set, 
 		UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset) const
 	{
-		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
 		const Vector3 center = evaluateTransformed(mDesc.center, state, state.nrmTimeEnd, random, mDesc.worldSpace);
 		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
 
-		for (UINT32 i = startIdx; i < endIdx; i++)
+		forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
 		{
-			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
-
 			float timeStep = state.timeStep;
 			if(spacing)
 			{
@@ -200,7 +269,7 @@ namespace bs
 				velocity += Vector3::normalize(point) * radial * timeStep;
 
 			particles.position[i] += velocity;
-		}
+		});
 	}
 
 	SPtr<ParticleOrbit> ParticleOrbit::create(const PARTICLE_ORBIT_DESC& desc)
@@ -230,14 +299,21 @@ namespace bs
 	void ParticleVelocity::evolve(Random& random, const ParticleSystemState& state, ParticleSet& set, 
 		UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset) const
 	{
-		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
-		for (UINT32 i = startIdx; i < endIdx; i++)
+		// Same velocity for all particles, apply it directly
+		if(mDesc.velocity.getType() == PDT_Constant && !spacing)
 		{
-			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+			const Vector3 velocity = evaluateTransformed<true>(mDesc.velocity, state, 0.0f, random, 
+				mDesc.worldSpace) * state.timeStep;
+
+			addToAll(particles.position + startIdx, count, velocity);
+			return;
+		}
 
+		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+		forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
+		{
 			float timeStep = state.timeStep;
 			if(spacing)
 			{
@@ -251,7 +327,7 @@ namespace bs
 				mDesc.worldSpace) * timeStep;
 
 			particles.position[i] += velocity;
-		}
+		});
 	}
 
 	SPtr<ParticleVelocity> ParticleVelocity::create(const PARTICLE_VELOCITY_DESC& desc)
@@ -281,14 +357,21 @@ namespace bs
 	void ParticleForce::evolve(Random& random, const ParticleSystemState& state, ParticleSet& set, 
 		UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset) const
 	{
-		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
-		for (UINT32 i = startIdx; i < endIdx; i++)
+		// Same force for all particles, apply it directly
+		if(mDesc.force.getType() == PDT_Constant && !spacing)
 		{
-			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+			const Vector3 force = evaluateTransformed<true>(mDesc.force, state, 0.0f, random, 
+				mDesc.worldSpace) * state.timeStep;
 
+			addToAll(particles.velocity + startIdx, count, force * state.timeStep);
+			return;
+		}
+
+		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+		forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
+		{
 			float timeStep = state.timeStep;
 			if(spacing)
 			{
@@ -302,7 +385,7 @@ namespace bs
 				mDesc.worldSpace) * timeStep;
 
 			particles.velocity[i] += force * timeStep;
-		}
+		});
 	}
 
 	SPtr<ParticleForce> ParticleForce::create(const PARTICLE_FORCE_DESC& desc)
@@ -340,7 +423,13 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+		if(!spacing)
+		{
+			addToAll(particles.velocity + startIdx, count, gravity * state.timeStep);
+			return;
+		}
+
+		const float subFrameSpacing = count > 0 ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
 			float timeStep = state.timeStep;
@@ -382,16 +471,20 @@ namespace bs
 	void ParticleColor::evolve(Random& random, const ParticleSystemState& state, ParticleSet& set, 
 		UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset) const
 	{
-		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
-		for (UINT32 i = startIdx; i < endIdx; i++)
+		if(mDesc.color.getType() == PDT_Constant)
 		{
-			const UINT32 colorSeed = particles.seed[i] + PARTICLE_COLOR;
-			const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+			const RGBA color = mDesc.color.evaluate(0.0f, random);
+			std::fill(particles.color + startIdx, particles.color + startIdx + count, color);
+			return;
+		}
 
+		forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
+		{
+			const UINT32 colorSeed = particles.seed[i] + PARTICLE_COLOR;
 			particles.color[i] = mDesc.color.evaluate(particleT, Random(colorSeed));
-		}
+		});
 	}
 
 	SPtr<ParticleColor> ParticleColor::create(const PARTICLE_COLOR_DESC& desc)
@@ -421,29 +514,40 @@ namespace bs
 	void ParticleSize::evolve(Random& random, const ParticleSystemState& state, ParticleSet& set, 
 		UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset) const
 	{
-		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
+		Vector3* sizes = particles.size;
 
 		if(!mDesc.use3DSize)
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			if(mDesc.size.getType() == PDT_Constant)
+			{
+				const float size = mDesc.size.evaluate(0.0f, random);
+				std::fill(sizes + startIdx, sizes + startIdx + count, Vector3(size, size, size));
+				return;
+			}
+
+			forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
 			{
 				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
 
 				const float size = mDesc.size.evaluate(particleT, Random(sizeSeed));
-				particles.size[i] = Vector3(size, size, size);
-			}
+				sizes[i] = Vector3(size, size, size);
+			});
 		}
 		else
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			if(mDesc.size3D.getType() == PDT_Constant)
 			{
-				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
-
-				particles.size[i] = mDesc.size3D.evaluate(particleT, Random(sizeSeed));
+				const Vector3 size = mDesc.size3D.evaluate(0.0f, random);
+				std::fill(sizes + startIdx, sizes + startIdx + count, size);
+				return;
 			}
+
+			forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
+			{
+				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
+				sizes[i] = mDesc.size3D.evaluate(particleT, Random(sizeSeed));
+			});
 		}
 	}
 
@@ -474,29 +578,40 @@ namespace bs
 	void ParticleRotation::evolve(Random& random, const ParticleSystemState& state, ParticleSet& set, 
 		UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset) const
 	{
-		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
+		Vector3* rotations = particles.rotation;
 
 		if(!mDesc.use3DRotation)
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			if(mDesc.rotation.getType() == PDT_Constant)
+			{
+				const float rotation = mDesc.rotation.evaluate(0.0f, random);
+				std::fill(rotations + startIdx, rotations + startIdx + count, Vector3(rotation, 0.0f, 0.0f));
+				return;
+			}
+
+			forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
 			{
 				const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
 
 				const float rotation = mDesc.rotation.evaluate(particleT, Random(rotationSeed));
-				particles.rotation[i] = Vector3(rotation, 0.0f, 0.0f);
-			}
+				rotations[i] = Vector3(rotation, 0.0f, 0.0f);
+			});
 		}
 		else
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			if(mDesc.rotation3D.getType() == PDT_Constant)
 			{
-				const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
-
-				particles.rotation[i] = mDesc.rotation3D.evaluate(particleT, Random(rotationSeed));
+				const Vector3 rotation = mDesc.rotation3D.evaluate(0.0f, random);
+				std::fill(rotations + startIdx, rotations + startIdx + count, rotation);
+				return;
 			}
+
+			forEachParticle(particles, startIdx, count, [&](UINT32 i, float particleT)
+			{
+				const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
+				rotations[i] = mDesc.rotation3D.evaluate(particleT, Random(rotationSeed));
+			});
 		}
 	}
 
@@ -555,54 +670,52 @@ namespace bs
 		if(numRays == 0)
 			return 0;
 
-		// Calculate bounds of all rays
-		AABox groupBounds = AABox::INF_BOX;
-		for(UINT32 i = 0; i < numRays; i++)
-		{
-			groupBounds.merge(segments[i].start);
-			groupBounds.merge(segments[i].end);
-		}
-
-		Vector<Collider*> hitColliders = gPhysics()._boxOverlap(groupBounds, Quaternion::IDENTITY, layer);
-		if(hitColliders.empty())
-			return 0;
+		const auto rays = bs_stack_alloc<Ray>(numRays);
+		const auto lengths = bs_stack_alloc<float>(numRays);
+		const auto rayIndices = bs_stack_alloc<UINT32>(numRays);
 
-		UINT32 numHits = 0;
+		// Skip particles that didn't move, and submit the rest to the physics scene as a single batch
+		UINT32 numQueries = 0;
 		for(UINT32 i = 0; i < numRays; i++)
 		{
-			float nearestHit = std::numeric_limits<float>::max();
-			ParticleHitInfo hitInfo;
-			hitInfo.idx = i;
-
 			Vector3 diff = segments[i].end - segments[i].start;
 			const float length = diff.length();
 
 			if(Math::approxEquals(length, 0.0f))
 				continue;
 
-			Ray ray;
-			ray.setOrigin(segments[i].start);
-			ray.setDirection(diff / length);
+			rays[numQueries].setOrigin(segments[i].start);
+			rays[numQueries].setDirection(diff / length);
+			lengths[numQueries] = length;
+			rayIndices[numQueries] = i;
+			numQueries++;
+		}
 
-			for(auto& collider : hitColliders)
-			{
-				PhysicsQueryHit queryHit;
-				if(collider->rayCast(ray, queryHit, length))
-				{
-					if(queryHit.distance < nearestHit)
-					{
-						nearestHit = queryHit.distance;
+		UINT32 numHits = 0;
+		if(numQueries > 0)
+		{
+			const auto queryHits = bs_stack_new<PhysicsQueryHit>(numQueries);
+			gPhysics().rayCastBatch(rays, lengths, numQueries, queryHits, layer);
 
-						hitInfo.position = queryHit.point;
-						hitInfo.normal = queryHit.normal;
-					}
-				}
+			for(UINT32 i = 0; i < numQueries; i++)
+			{
+				const PhysicsQueryHit& queryHit = queryHits[i];
+				if(queryHit.colliderRaw == nullptr)
+					continue;
+
+				ParticleHitInfo& hitInfo = hits[numHits++];
+				hitInfo.idx = rayIndices[i];
+				hitInfo.position = queryHit.point;
+				hitInfo.normal = queryHit.normal;
 			}
 
-			if(nearestHit != std::numeric_limits<float>::max())
-				hits[numHits++] = hitInfo;
+			bs_stack_delete(queryHits, numQueries);
 		}
 
+		bs_stack_free(rayIndices);
+		bs_stack_free(lengths);
+		bs_stack_free(rays);
+
 		return numHits;
 	}
 
@@ -8,9 +8,17 @@
 #include "Private/Particles/BsParticleSet.h"
 #include "Animation/BsAnimationManager.h"
 #include "Image/BsPixelUtil.h"
+#include "Scene/BsSceneManager.h"
+#include "Renderer/BsCamera.h"
 
 namespace bs
 {
+	/** Minimum number of particles in a system before they get sorted using multiple threads. */
+	static constexpr UINT32 PARALLEL_SORT_THRESHOLD = 16384;
+
+	/** Number of particles in a single chunk when sorting particles using multiple threads. */
+	static constexpr UINT32 PARALLEL_SORT_CHUNK_SIZE = 4096;
+
 	/** Helper method used for writing particle data into the @p pixels buffer. */
 	template<class T, class PR>
 	void iterateOverPixels(PixelData& pixels, UINT32 count, UINT32 stride, PR predicate)
@@ -56,7 +64,7 @@ namespace bs
 	public:
 		~ParticleSimulationDataPool()
 		{
-			Lock lock(mMutex);
+			ProfiledLock lock(mMutex);
 
 			for (auto& sizeEntry : mBillboardBufferList)
 			{
@@ -64,11 +72,8 @@ namespace bs
 					mBillboardAlloc.destruct(static_cast<ParticleBillboardRenderData*>(entry));
 			}
 
-			for (auto& sizeEntry : mMeshBufferList)
-			{
-				for (auto& entry : sizeEntry.second.buffers)
-					mMeshAlloc.destruct(static_cast<ParticleMeshRenderData*>(entry));
-			}
+			for (auto& entry : mMeshBufferList)
+				mMeshAlloc.destruct(entry);
 
 			for (auto& entry : mGPUBufferList)
 				mGPUAlloc.destruct(entry);
@@ -85,7 +90,7 @@ namespace bs
 			ParticleBillboardRenderData* output = nullptr;
 
 			{
-				Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
 				BuffersPerSize& buffers = mBillboardBufferList[size];
 				if (buffers.nextFreeIdx < (UINT32)buffers.buffers.size())
@@ -99,7 +104,7 @@ namespace bs
 			{
 				output = createNewBillboardBuffersCPU(size);
 
-				Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
 				BuffersPerSize& buffers = mBillboardBufferList[size];
 				buffers.buffers.push_back(output);
@@ -145,69 +150,70 @@ namespace bs
 		 * Returns a set of buffers containing particle data from the provided particle set. Usable for rendering the
 		 * results of the CPU particle simulation as 3D meshes.
 		 */
-		ParticleMeshRenderData* allocCPUMesh(const ParticleSet& particleSet)
+		ParticleMeshRenderData* allocCPUMesh(const ParticleSet& particleSet, const Transform& localToWorld)
 		{
-			const UINT32 size = particleSet.determineTextureSize();
-
 			ParticleMeshRenderData* output = nullptr;
 
 			{
-				Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
-				BuffersPerSize& buffers = mMeshBufferList[size];
-				if (buffers.nextFreeIdx < (UINT32)buffers.buffers.size())
+				if (mNextFreeMeshBuffer < (UINT32)mMeshBufferList.size())
 				{
-					output = static_cast<ParticleMeshRenderData*>(buffers.buffers[buffers.nextFreeIdx]);
-					buffers.nextFreeIdx++;
+					output = mMeshBufferList[mNextFreeMeshBuffer];
+					mNextFreeMeshBuffer++;
 				}
 			}
 
 			if (!output)
 			{
-				output = createNewMeshBuffersCPU(size);
+				output = mMeshAlloc.construct<ParticleMeshRenderData>();
 
-				Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
-				BuffersPerSize& buffers = mMeshBufferList[size];
-				buffers.buffers.push_back(output);
-				buffers.nextFreeIdx++;
+				mMeshBufferList.push_back(output);
+				mNextFreeMeshBuffer++;
 			}
 
 			// Populate buffer contents
 			const UINT32 count = particleSet.getParticleCount();
 			const ParticleSetData& particles = particleSet.getParticles();
 
-			// TODO: Use non-temporal writes?
-			iterateOverPixels<Vector4>(output->position, count,
-				[&particles](Vector4* dst, UINT32 idx)
-			{
-				dst->x = particles.position[idx].x;
-				dst->y = particles.position[idx].y;
-				dst->z = particles.position[idx].z;
-
-			});
+			const Matrix4 localToWorldMat = localToWorld.getMatrix();
+			const Quaternion& systemRotation = localToWorld.getRotation();
+			const Vector3& systemScale = localToWorld.getScale();
 
-			iterateOverPixels<RGBA>(output->color, count,
-				[&particles](RGBA* dst, UINT32 idx)
-			{
-				*dst = particles.color[idx];
-			});
+			output->instances.resize(count);
 
-			iterateOverPixels<UINT16>(output->rotation, count, sizeof(UINT16) * 4,
-				[&particles](UINT16* dst, UINT32 idx)
-			{
-				dst[0] = Bitwise::floatToHalf(particles.rotation[idx].x * Math::DEG2RAD);
-				dst[1] = Bitwise::floatToHalf(particles.rotation[idx].y * Math::DEG2RAD);
-				dst[2] = Bitwise::floatToHalf(particles.rotation[idx].z * Math::DEG2RAD);
-			});
-
-			iterateOverPixels<UINT16>(output->size, count, sizeof(UINT16) * 4,
-				[&particles](UINT16* dst, UINT32 idx)
+			// Note: Non-uniform system scale is applied along the particle's local axes, which is only exact if the
+			// particle is not rotated relative to the system
+			// TODO: Use non-temporal writes?
+			for (UINT32 i = 0; i < count; i++)
 			{
-				dst[0] = Bitwise::floatToHalf(particles.size[idx].x);
-				dst[1] = Bitwise::floatToHalf(particles.size[idx].y);
-				dst[2] = Bitwise::floatToHalf(particles.size[idx].z);
-			});
+				const Vector3 angles = particles.rotation[i] * Math::DEG2RAD;
+
+				// Matches the YXZ rotation order used for billboard and GPU particles
+				const Quaternion particleRotation = 
+					Quaternion(Vector3::UNIT_Y, Radian(angles.y)) *
+					Quaternion(Vector3::UNIT_X, Radian(angles.x)) *
+					Quaternion(Vector3::UNIT_Z, Radian(angles.z));
+
+				const Quaternion rotation = systemRotation * particleRotation;
+				const Vector3 scale = particles.size[i] * systemScale;
+
+				ParticleMeshInstance& instance = output->instances[i];
+				instance.position = localToWorldMat.multiplyAffine(particles.position[i]);
+				instance.color = particles.color[i];
+
+				instance.rotation[0] = Bitwise::floatToHalf(rotation.x);
+				instance.rotation[1] = Bitwise::floatToHalf(rotation.y);
+				instance.rotation[2] = Bitwise::floatToHalf(rotation.z);
+				instance.rotation[3] = Bitwise::floatToHalf(rotation.w);
+
+				instance.scale[0] = Bitwise::floatToHalf(scale.x);
+				instance.scale[1] = Bitwise::floatToHalf(scale.y);
+				instance.scale[2] = Bitwise::floatToHalf(scale.z);
+				instance.scale[3] = 0;
+			}
 
 			output->indices.clear();
 			output->indices.resize(count);
@@ -224,7 +230,7 @@ namespace bs
 			ParticleGPUSimulationData* output = nullptr;
 
 			{
-				Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
 				if (mNextFreeGPUBuffer < (UINT32)mGPUBufferList.size())
 				{
@@ -237,7 +243,7 @@ namespace bs
 			{
 				output = createNewBuffersGPU();
 
-				Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
 				mGPUBufferList.push_back(output);
 				mNextFreeGPUBuffer++;
@@ -270,14 +276,12 @@ namespace bs
 		/** Makes all the buffers available for allocations. Does not free internal buffer memory. */
 		void clear()
 		{
-			Lock lock(mMutex);
+			ProfiledLock lock(mMutex);
 
 			for(auto& buffers : mBillboardBufferList)
 				buffers.second.nextFreeIdx = 0;
 
-			for(auto& buffers : mMeshBufferList)
-				buffers.second.nextFreeIdx = 0;
-
+			mNextFreeMeshBuffer = 0;
 			mNextFreeGPUBuffer = 0;
 		}
 
@@ -299,25 +303,6 @@ namespace bs
 			return output;
 		}
 
-		/** Allocates a new set of CPU buffers used for mesh rendering of the provided @p size width and height. */
-		ParticleMeshRenderData* createNewMeshBuffersCPU(UINT32 size)
-		{
-			auto output = mMeshAlloc.construct<ParticleMeshRenderData>();
-
-			output->position = PixelData(size, size, 1, PF_RGBA32F);
-			output->color = PixelData(size, size, 1, PF_RGBA8);
-			output->size = PixelData(size, size, 1, PF_RGBA16F);
-			output->rotation = PixelData(size, size, 1, PF_RGBA16F);
-
-			// Note: Potentially allocate them all in one large block
-			output->position.allocateInternalBuffer();
-			output->color.allocateInternalBuffer();
-			output->size.allocateInternalBuffer();
-			output->rotation.allocateInternalBuffer();
-
-			return output;
-		}
-
 		/** Allocates a new set of GPU buffers of the provided @p size width and height. */
 		ParticleGPUSimulationData* createNewBuffersGPU()
 		{
@@ -325,14 +310,15 @@ namespace bs
 		}
 
 		UnorderedMap<UINT32, BuffersPerSize> mBillboardBufferList;
-		UnorderedMap<UINT32, BuffersPerSize> mMeshBufferList;
+		Vector<ParticleMeshRenderData*> mMeshBufferList;
+		UINT32 mNextFreeMeshBuffer = 0;
 		Vector<ParticleGPUSimulationData*> mGPUBufferList;
 		UINT32 mNextFreeGPUBuffer = 0;
 
-		PoolAlloc<sizeof(ParticleBillboardRenderData), 32, 4, true> mBillboardAlloc;
-		PoolAlloc<sizeof(ParticleMeshRenderData), 32, 4, true> mMeshAlloc;
-		PoolAlloc<sizeof(ParticleGPUSimulationData), 32, 4, true> mGPUAlloc;
-		Mutex mMutex;
+		LockFreePoolAlloc<sizeof(ParticleBillboardRenderData), 32> mBillboardAlloc;
+		LockFreePoolAlloc<sizeof(ParticleMeshRenderData), 32> mMeshAlloc;
+		LockFreePoolAlloc<sizeof(ParticleGPUSimulationData), 32> mGPUAlloc;
+		ProfiledMutex mMutex{"Particle buffer pool"};
 	};
 
 	struct ParticleManager::Members
@@ -347,13 +333,58 @@ namespace bs
 
 	ParticleManager::~ParticleManager()
 	{
+		if(mEvaluationTask != nullptr)
+			mEvaluationTask->wait();
+
 		bs_delete(m);
+
+		ParticleBufferPool::trim();
+	}
+
+	ParticleMemoryStats ParticleManager::getMemoryStats() const
+	{
+		ParticleMemoryStats output;
+
+		{
+			ProfiledLock lock(mMutex);
+			output.systems = mMemoryStats;
+		}
+
+		const ParticleBufferPoolStats poolStats = ParticleBufferPool::getStats();
+		output.numCachedBlocks = poolStats.numCachedBlocks;
+		output.cachedBytes = poolStats.cachedBytes;
+		output.allocatedBytes = poolStats.allocatedBytes;
+
+		return output;
+	}
+
+	ParticleUpdateTimings ParticleManager::getUpdateTimings() const
+	{
+		ProfiledLock lock(mMutex);
+		return mUpdateTimings;
 	}
 
 	ParticlePerFrameData* ParticleManager::update(const EvaluatedAnimationData& animData)
 	{
-		// Note: Allow the worker threads to work alongside the main thread? Would require extra synchronization but
-		// potentially no benefit?
+		return update(animData, gTime().getFrameDelta());
+	}
+
+	ParticlePerFrameData* ParticleManager::update(const EvaluatedAnimationData& animData, float timeDelta)
+	{
+		beginUpdate(animData, timeDelta);
+		return endUpdate();
+	}
+
+	void ParticleManager::beginUpdate(const EvaluatedAnimationData& animData)
+	{
+		beginUpdate(animData, gTime().getFrameDelta());
+	}
+
+	void ParticleManager::beginUpdate(const EvaluatedAnimationData& animData, float timeDelta)
+	{
+		assert(!mUpdateInProgress && "endUpdate() must be called before starting a new update.");
+
+		mUpdateStart = gTime().getTimePrecise();
 
 		// Advance the buffers (last write buffer becomes read buffer)
 		if (mSwapBuffers)
@@ -365,33 +396,49 @@ namespace bs
 		}
 
 		if(mPaused)
-			return &mSimulationData[mReadBufferIdx];
+			return;
 
-		// TODO - Perform culling (but only on deterministic particle systems). In which case cache the bounds so we don't
-		// need to recalculate them below
+		mUpdateInProgress = true;
+
+		// Gather views used for particle system LOD and culling
+		mLODViews.clear();
+		for(auto& entry : gSceneManager().getAllCameras())
+		{
+			const SPtr<Camera>& camera = entry.second;
+			mLODViews.push_back({ camera->getWorldFrustum(), camera->getTransform().getPosition(), camera->getLayers() });
+		}
+
+		const UINT64 frameIdx = gTime().getFrameIdx();
 
 		// Prepare the write buffer
 		ParticlePerFrameData& simulationData = mSimulationData[mWriteBufferIdx];
 		simulationData.cpuData.clear();
 		simulationData.gpuData.clear();
 
-		// Queue evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mSystems.size();
-		}
-
-		float timeDelta = gTime().getFrameDelta();
-
 		ParticleSimulationDataPool& simDataPool = m->simDataPool[mWriteBufferIdx];
 		simDataPool.clear();
 
-		for (auto& system : mSystems)
+		mSystemsToUpdate.clear();
+		mSystemsToUpdate.insert(mSystemsToUpdate.end(), mSystems.begin(), mSystems.end());
+
+		mPendingTimings = ParticleUpdateTimings();
+
+		// Animation data and the write buffers remain valid until endUpdate(), as the buffers only advance on the
+		// next update
+		const auto evaluateWorker = [this, timeDelta, frameIdx, &animData, &simDataPool, &simulationData]
+			(UINT32 systemIdx)
 		{
-			const auto evaluateWorker = [this, timeDelta, system, &animData, &simDataPool, &simulationData]()
+			ParticleUpdateTimings localTimings;
 			{
+				ParticleSystem* system = mSystemsToUpdate[systemIdx];
+
 				// Advance the simulation
-				system->_simulate(timeDelta, &animData);
+				UINT64 stageStart = gTime().getTimePrecise();
+				const bool simulated = system->_simulateLOD(timeDelta, &animData, mLODViews, frameIdx);
+
+				UINT64 stageEnd = gTime().getTimePrecise();
+				localTimings.simulation += stageEnd - stageStart;
+				stageStart = stageEnd;
 
 				ParticleRenderData* simulationDataCPU = nullptr;
 				ParticleGPUSimulationData* simulationDataGPU = nullptr;
@@ -402,20 +449,42 @@ namespace bs
 					const ParticleSystemSettings& settings = system->getSettings();
 
 					if(settings.gpuSimulation)
+					{
 						simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
+						system->mBounds = settings.useAutomaticBounds ? AABox::INF_BOX : settings.customBounds;
+
+						localTimings.renderData += gTime().getTimePrecise() - stageStart;
+					}
 					else
 					{
 						if(settings.renderMode == ParticleRenderMode::Billboard)
 							simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
 						else
-							simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
+						{
+							// Particles simulated in world space need no extra transform
+							const Transform& localToWorld = settings.simulationSpace == ParticleSimulationSpace::Local
+								? system->getTransform() : Transform::IDENTITY;
+
+							simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet, localToWorld);
+						}
 
 						simulationDataCPU->numParticles = numParticles;
 
-						if(settings.useAutomaticBounds)
-							simulationDataCPU->bounds = system->_calculateBounds();
-						else
-							simulationDataCPU->bounds = settings.customBounds;
+						stageEnd = gTime().getTimePrecise();
+						localTimings.renderData += stageEnd - stageStart;
+						stageStart = stageEnd;
+
+						// Particles don't change if the simulation was skipped, so neither do the bounds
+						if(!settings.useAutomaticBounds)
+							system->mBounds = settings.customBounds;
+						else if(simulated || system->mBounds == AABox::INF_BOX)
+							system->mBounds = system->_calculateBounds();
+
+						simulationDataCPU->bounds = system->mBounds;
+
+						stageEnd = gTime().getTimePrecise();
+						localTimings.bounds += stageEnd - stageStart;
+						stageStart = stageEnd;
 
 						// If using a camera-independant sorting mode, sort the particles right away
 						switch (settings.sortMode)
@@ -431,38 +500,78 @@ namespace bs
 							break;
 						case ParticleSortMode::Distance: break;
 						}
+
+						localTimings.sorting += gTime().getTimePrecise() - stageStart;
 					}
+
+					localTimings.numParticles += numParticles;
 				}
 
-				{
-					Lock lock(mMutex);
+				ProfiledLock lock(mMutex);
 
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
+				if(simulationDataCPU)
+					simulationData.cpuData[system->mId] = simulationDataCPU;
+				else if(simulationDataGPU)
+					simulationData.gpuData[system->mId] = simulationDataGPU;
 
-					if(simulationDataCPU)
-						simulationData.cpuData[system->mId] = simulationDataCPU;
-					else if(simulationDataGPU)
-						simulationData.gpuData[system->mId] = simulationDataGPU;
-				}
+				mPendingTimings.simulation += localTimings.simulation;
+				mPendingTimings.renderData += localTimings.renderData;
+				mPendingTimings.bounds += localTimings.bounds;
+				mPendingTimings.sorting += localTimings.sorting;
+				mPendingTimings.numParticles += localTimings.numParticles;
+			}
+		};
 
-				mWorkerDoneSignal.notify_one();
-			};
+		// Evaluate systems in parallel on worker threads, while the caller continues until endUpdate()
+		if(!mSystemsToUpdate.empty())
+		{
+			mEvaluationTask = TaskGroup::create("ParticleWorker", evaluateWorker, (UINT32)mSystemsToUpdate.size());
+			TaskScheduler::instance().addTaskGroup(mEvaluationTask);
+		}
+	}
 
-			SPtr<Task> task = Task::create("ParticleWorker", evaluateWorker);
-			TaskScheduler::instance().addTask(task);
+	ParticlePerFrameData* ParticleManager::endUpdate()
+	{
+		if(!mUpdateInProgress)
+			return &mSimulationData[mReadBufferIdx];
+
+		// Wait for the workers, with this thread helping out
+		if(mEvaluationTask != nullptr)
+		{
+			mEvaluationTask->wait(true);
+			mEvaluationTask = nullptr;
 		}
 
-		// Wait for tasks to complete
-		TaskScheduler::instance().addWorker(); // Make the current core available for work (since this thread waits)
+		// Record particle buffer memory use for profiling
+		Vector<ParticleSystemMemoryStats> memoryStats;
+		memoryStats.reserve(mSystemsToUpdate.size());
+
+		for(auto& system : mSystemsToUpdate)
 		{
-			Lock lock(mMutex);
+			if(!system->mParticleSet)
+				continue;
+
+			const ParticleSetData& particles = system->mParticleSet->getParticles();
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
+			ParticleSystemMemoryStats stats;
+			stats.systemId = system->mId;
+			stats.numParticles = system->mParticleSet->getParticleCount();
+			stats.capacity = particles.capacity;
+			stats.numBytes = particles.getAllocatedBytes();
+
+			memoryStats.push_back(stats);
+		}
+
+		{
+			ProfiledLock lock(mMutex);
+			std::swap(mMemoryStats, memoryStats);
+
+			mUpdateTimings = mPendingTimings;
+			mUpdateTimings.numSystems = (UINT32)mSystemsToUpdate.size();
+			mUpdateTimings.total = gTime().getTimePrecise() - mUpdateStart;
 		}
-		TaskScheduler::instance().removeWorker();
 
+		mUpdateInProgress = false;
 		mSwapBuffers = true;
 
 		return &mSimulationData[mWriteBufferIdx];
@@ -517,11 +626,50 @@ namespace bs
 				break;
 			}
 
-			std::sort(sortData.begin(), sortData.end(), 
-				[](const ParticleSortData& lhs, const ParticleSortData& rhs)
+			const auto compare = [](const ParticleSortData& lhs, const ParticleSortData& rhs)
 			{
 				return rhs.key < lhs.key;
-			});
+			};
+
+			if(count < PARALLEL_SORT_THRESHOLD)
+				std::sort(sortData.begin(), sortData.end(), compare);
+			else
+			{
+				// Sort chunks in parallel, then keep merging neighboring sorted ranges in parallel until only one remains
+				ParticleSortData* data = sortData.data();
+				const UINT32 numChunks = Math::divideAndRoundUp(count, PARALLEL_SORT_CHUNK_SIZE);
+
+				const auto sortWorker = [data, count, &compare](UINT32 start, UINT32 end)
+				{
+					for (UINT32 i = start; i < end; i++)
+					{
+						const UINT32 first = i * PARALLEL_SORT_CHUNK_SIZE;
+						const UINT32 last = std::min(first + PARALLEL_SORT_CHUNK_SIZE, count);
+
+						std::sort(data + first, data + last, compare);
+					}
+				};
+
+				TaskScheduler::instance().parallelFor(numChunks, 1, sortWorker);
+
+				for (UINT32 width = PARALLEL_SORT_CHUNK_SIZE; width < count; width *= 2)
+				{
+					const auto mergeWorker = [data, count, width, &compare](UINT32 start, UINT32 end)
+					{
+						for (UINT32 i = start; i < end; i++)
+						{
+							const UINT32 first = i * width * 2;
+							const UINT32 middle = std::min(first + width, count);
+							const UINT32 last = std::min(first + width * 2, count);
+
+							if (middle < last)
+								std::inplace_merge(data + first, data + middle, data + last, compare);
+						}
+					};
+
+					TaskScheduler::instance().parallelFor(Math::divideAndRoundUp(count, width * 2), 1, mergeWorker);
+				}
+			}
 
 			for (UINT32 i = 0; i < count; i++)
 				indices[i] = sortData[i].idx;
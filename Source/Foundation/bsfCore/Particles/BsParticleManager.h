@@ -51,22 +51,25 @@ namespace bs
 	};
 
 	/** 
-	 * Contains data used for rendering particles as meshes. Per-particle data is stored in a 2D square layout so it
-	 * can be used for quickly initializing a texture.
+	 * Contains data about a single particle rendered as a mesh. Matches the structure of the instance buffer used by
+	 * the particle mesh shader. Transform is in world space so instances from different particle systems can be stored
+	 * in the same buffer. Rotation and scale are stored at half precision to reduce upload bandwidth.
 	 */
-	struct BS_CORE_EXPORT ParticleMeshRenderData : ParticleRenderData
+	struct ParticleMeshInstance
 	{
-		/** Contains particle positions in .xyz with .w unused. */
-		PixelData position;
-
-		/** Contains particle color in .xyz and transparency in .a. */
-		PixelData color;
+		Vector3 position;
+		RGBA color;
+		UINT16 rotation[4]; /**< Quaternion in x, y, z, w order. */
+		UINT16 scale[4]; /**< Scale along the x, y and z axes, last component unused. */
+	};
 
-		/** Contains particle size in .xyz with .w unused. */
-		PixelData size;
+	static_assert(sizeof(ParticleMeshInstance) == 32, "Particle mesh instance size must match the GPU structure.");
 
-		/** Contains particle rotation in radians in .xyz with .w unused. */
-		PixelData rotation;
+	/** Contains data used for rendering particles as meshes, using instanced drawing. */
+	struct BS_CORE_EXPORT ParticleMeshRenderData : ParticleRenderData
+	{
+		/** Per-instance data for every particle, in world space. */
+		Vector<ParticleMeshInstance> instances;
 	};
 	/** 
 	 * Contains information about a single particle about to be inserted into the GPU simulation. Matches the structure
@@ -118,6 +121,44 @@ namespace bs
 		UnorderedMap<UINT32, ParticleGPUSimulationData*> gpuData;
 	};
 
+	/** Information about memory used by particle buffers of a single particle system. */
+	struct ParticleSystemMemoryStats
+	{
+		UINT32 systemId = 0; /**< Unique identifier of the particle system. */
+		UINT32 numParticles = 0; /**< Number of particles currently alive in the system. */
+		UINT32 capacity = 0; /**< Number of particles the system can hold before its buffers need to grow. */
+		UINT64 numBytes = 0; /**< Size of all the particle buffers used by the system, in bytes. */
+	};
+
+	/** Information about memory used by the particle buffers of all particle systems. */
+	struct ParticleMemoryStats
+	{
+		/** Memory used by each individual particle system, as of the last particle update. */
+		Vector<ParticleSystemMemoryStats> systems;
+
+		UINT64 allocatedBytes = 0; /**< Total size of particle buffers currently in use, in bytes. */
+		UINT64 cachedBytes = 0; /**< Size of unused particle buffers kept around for reuse, in bytes. */
+		UINT32 numCachedBlocks = 0; /**< Number of unused particle buffers kept around for reuse. */
+	};
+
+	/** 
+	 * Time spent in individual stages of a particle update, in microseconds. Stages executing on worker threads report
+	 * the sum of time spent on all threads.
+	 */
+	struct ParticleUpdateTimings
+	{
+		UINT64 total = 0; /**< Time taken by the entire update, from start to finish. */
+		UINT64 simulation = 0; /**< Time spent spawning and evolving particles. */
+		UINT64 renderData = 0; /**< Time spent generating data to transfer to the core thread. */
+		UINT64 bounds = 0; /**< Time spent calculating particle system bounds. */
+		UINT64 sorting = 0; /**< Time spent sorting particles using camera-independent sort modes. */
+
+		UINT32 numSystems = 0; /**< Number of particle systems updated. */
+		UINT32 numParticles = 0; /**< Number of particles alive across all systems after the update. */
+	};
+
+	class TaskGroup;
+
 	/** Keeps track of all active ParticleSystem%s and performs per-frame updates. */
 	class BS_CORE_EXPORT ParticleManager final : public Module<ParticleManager>
 	{
@@ -132,6 +173,41 @@ namespace bs
 		 */
 		ParticlePerFrameData* update(const EvaluatedAnimationData& animData);
 
+		/** 
+		 * Same as update(), except the simulation is advanced by the provided time step instead of the current frame
+		 * time delta. Useful when the simulation needs to be deterministic.
+		 */
+		ParticlePerFrameData* update(const EvaluatedAnimationData& animData, float timeDelta);
+
+		/**
+		 * Starts advancing the simulation for all particle systems using the current frame time delta, same as
+		 * update(). The systems are evaluated on worker threads and the method returns immediately, allowing the
+		 * caller to perform other work in the meantime. Must be followed by a call to endUpdate() before particle
+		 * systems are modified, or their transforms are changed.
+		 *
+		 * @param[in]	animData	Evaluated animation data used by emitters attached to skinned meshes. Must remain
+		 *							valid and unchanged until endUpdate() returns.
+		 */
+		void beginUpdate(const EvaluatedAnimationData& animData);
+
+		/** Same as beginUpdate(const EvaluatedAnimationData&), except the simulation is advanced by @p timeDelta. */
+		void beginUpdate(const EvaluatedAnimationData& animData, float timeDelta);
+
+		/** 
+		 * Waits until the update started by beginUpdate() completes, with the calling thread helping out with the
+		 * evaluation. Outputs a set of data that can be used for rendering & updating every active particle system.
+		 */
+		ParticlePerFrameData* endUpdate();
+
+		/** 
+		 * Returns information about memory used by particle buffers. Per-system information is updated on every call
+		 * to update(). Can be called from any thread.
+		 */
+		ParticleMemoryStats getMemoryStats() const;
+
+		/** Returns the time spent in individual stages of the last call to update(). Can be called from any thread. */
+		ParticleUpdateTimings getUpdateTimings() const;
+
 	private:
 		friend class ParticleSystem;
 
@@ -152,19 +228,27 @@ namespace bs
 
 		UINT32 mNextId = 1;
 		UnorderedSet<ParticleSystem*> mSystems;
+		Vector<ParticleSystem*> mSystemsToUpdate;
+		Vector<ParticleLODView> mLODViews;
 
 		bool mPaused = false;
 
+		// Update in progress, as started by beginUpdate()
+		SPtr<TaskGroup> mEvaluationTask;
+		ParticleUpdateTimings mPendingTimings;
+		UINT64 mUpdateStart = 0;
+		bool mUpdateInProgress = false;
+
 		// Worker threads
 		ParticlePerFrameData mSimulationData[CoreThread::NUM_SYNC_BUFFERS];
 
-		UINT32 mReadBufferIdx = 1;
+		UINT32 mReadBufferIdx = CoreThread::NUM_SYNC_BUFFERS - 1;
 		UINT32 mWriteBufferIdx = 0;
-		
-		Signal mWorkerDoneSignal;
-		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
+		Vector<ParticleSystemMemoryStats> mMemoryStats;
+		ParticleUpdateTimings mUpdateTimings;
+
+		mutable ProfiledMutex mMutex{"ParticleManager"};
 		bool mSwapBuffers = false;
 	};
 
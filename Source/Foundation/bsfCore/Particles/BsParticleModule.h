@@ -29,6 +29,7 @@ namespace bs
 		Matrix4 worldToLocal;
 		ParticleSystem* system;
 		const EvaluatedAnimationData* animData;
+		float emissionScale;
 	};
 
 	/** Module that in some way modified or effects a ParticleSystem. */
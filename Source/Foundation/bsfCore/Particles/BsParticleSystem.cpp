@@ -12,13 +12,41 @@
 #include "Renderer/BsRenderer.h"
 #include "Physics/BsPhysics.h"
 #include "Particles/BsVectorField.h"
+#include "Image/BsTexture.h"
 #include "Mesh/BsMesh.h"
 #include "CoreThread/BsCoreObjectSync.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
 	static constexpr UINT32 INITIAL_PARTICLE_CAPACITY = 1000;
 
+	/** 
+	 * Maximum number of particles to allocate up-front for CPU simulated systems, based on their maximum particle count.
+	 * Systems with larger limits grow their buffers on demand past this point.
+	 */
+	static constexpr UINT32 MAX_PREALLOCATED_PARTICLES = 65536;
+
+	/** Returns the number of particles to allocate up-front for a particle system using the provided settings. */
+	static UINT32 getInitialParticleCapacity(const ParticleSystemSettings& settings)
+	{
+		// GPU simulated systems only keep newly spawned particles on the CPU, so use the maximum particle count only as
+		// an upper bound. CPU simulated systems pre-allocate for their maximum so bursts don't need to grow the buffers.
+		if(settings.gpuSimulation)
+			return std::min(settings.maxParticles, INITIAL_PARTICLE_CAPACITY);
+
+		return std::min(settings.maxParticles, MAX_PREALLOCATED_PARTICLES);
+	}
+
+	/** Minimum number of particles in a CPU simulated system before its simulation is split between multiple threads. */
+	static constexpr UINT32 PARALLEL_SIMULATION_THRESHOLD = 16384;
+
+	/** Number of particles evaluated by a single task, when simulating a particle system on multiple threads. */
+	static constexpr UINT32 PARALLEL_SIMULATION_GRAIN_SIZE = 4096;
+
+	/** Maximum time step at which to advance the simulation when stepping over time accumulated due to LOD. */
+	static constexpr float MAX_LOD_TIME_STEP = 1.0f / 20.0f;
+
 	RTTITypeBase* ParticleSystemSettings::getRTTIStatic()
 	{
 		return ParticleSystemSettingsRTTI::instance();
@@ -46,6 +74,7 @@ namespace bs
 		p(customBounds);
 		p(renderMode);
 		p(mesh);
+		p(lod);
 	}
 
 	template<bool Core>
@@ -74,6 +103,29 @@ namespace bs
 		return getRTTIStatic();
 	}
 
+	template<bool Core>
+	template<class P>
+	void TParticleSDFCollisionSettings<Core>::rttiEnumFields(P p)
+	{
+		p(position);
+		p(rotation);
+		p(size);
+		p(restitution);
+		p(dampening);
+		p(radiusScale);
+		p(sdf);
+	}
+
+	RTTITypeBase* ParticleSDFCollisionSettings::getRTTIStatic()
+	{
+		return ParticleSDFCollisionSettingsRTTI::instance();
+	}
+
+	RTTITypeBase* ParticleSDFCollisionSettings::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
 	template<class P>
 	void ParticleDepthCollisionSettings::rttiEnumFields(P p)
 	{
@@ -93,6 +145,28 @@ namespace bs
 		return getRTTIStatic();
 	}
 
+	template<class P>
+	void ParticleLODSettings::rttiEnumFields(P p)
+	{
+		p(enabled);
+		p(startDistance);
+		p(endDistance);
+		p(minEmissionScale);
+		p(maxUpdateInterval);
+		p(cullOffscreen);
+		p(maxCatchUpTime);
+	}
+
+	RTTITypeBase* ParticleLODSettings::getRTTIStatic()
+	{
+		return ParticleLODSettingsRTTI::instance();
+	}
+
+	RTTITypeBase* ParticleLODSettings::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
 	template<bool Core>
 	template<class P>
 	void TParticleGpuSimulationSettings<Core>::rttiEnumFields(P p)
@@ -103,6 +177,7 @@ namespace bs
 		p(drag);
 		p(depthCollision);
 		p(vectorField);
+		p(sdfCollision);
 	};
 
 	RTTITypeBase* ParticleGpuSimulationSettings::getRTTIStatic()
@@ -158,8 +233,13 @@ namespace bs
 			}
 		}
 
-		if(settings.maxParticles < mSettings.maxParticles)
-			mParticleSet->clear(settings.maxParticles);
+		if(mParticleSet)
+		{
+			if(settings.maxParticles < mSettings.maxParticles)
+				mParticleSet->clear(settings.maxParticles);
+			else
+				mParticleSet->reserve(getInitialParticleCapacity(settings));
+		}
 
 		mSettings = settings; 
 		_markCoreDirty();
@@ -214,8 +294,7 @@ namespace bs
 
 		if(mState == State::Uninitialized)
 		{
-			UINT32 particleCapacity = std::min(mSettings.maxParticles, INITIAL_PARTICLE_CAPACITY);
-			mParticleSet = bs_new<ParticleSet>(particleCapacity);
+			mParticleSet = bs_new<ParticleSet>(getInitialParticleCapacity(mSettings));
 		}
 
 		mState = State::Playing;
@@ -264,6 +343,7 @@ namespace bs
 		state.worldToLocal = state.localToWorld.inverseAffine();
 		state.system = this;
 		state.animData = animData;
+		state.emissionScale = mEmissionScale;
 
 		// For GPU simulation we only care about newly spawned particles, so clear old ones
 		if(mSettings.gpuSimulation)
@@ -278,9 +358,176 @@ namespace bs
 		{
 			const UINT32 numParticles = mParticleSet->getParticleCount();
 
-			preSimulate(state, 0, numParticles, false, 0.0f);
-			simulate(state, 0, numParticles, false, 0.0f);
-			postSimulate(state, 0, numParticles, false, 0.0f);
+			if(numParticles < PARALLEL_SIMULATION_THRESHOLD)
+			{
+				preSimulate(state, 0, numParticles, false, 0.0f);
+				simulate(state, 0, numParticles, false, 0.0f);
+				postSimulate(mRandom, state, 0, numParticles, false, 0.0f);
+			}
+			else
+			{
+				// Killing particles re-orders the set, so it must be done before the remaining particles are split
+				updateLifetimes(state, 0, numParticles, false, 0.0f);
+
+				// Each range gets its own copy of the same random stream, so values evolvers evaluate once per frame are 
+				// consistent between ranges, and the results don't depend on how the work was scheduled
+				const Random frameRandom(mRandom.get());
+
+				const auto simulateWorker = [this, &state, &frameRandom](UINT32 start, UINT32 end)
+				{
+					Random random = frameRandom;
+
+					const UINT32 count = end - start;
+					preEvolve(random, state, start, count, false, 0.0f);
+					simulate(state, start, count, false, 0.0f);
+					postSimulate(random, state, start, count, false, 0.0f);
+				};
+
+				TaskScheduler::instance().parallelFor(mParticleSet->getParticleCount(), PARALLEL_SIMULATION_GRAIN_SIZE,
+					simulateWorker);
+			}
+		}
+
+		mTime = newTime;
+	}
+
+	bool ParticleSystem::_simulateLOD(float timeDelta, const EvaluatedAnimationData* animData, 
+		const Vector<ParticleLODView>& views, UINT64 frameIdx)
+	{
+		const ParticleLODSettings& lod = mSettings.lod;
+		if(!lod.enabled || mState != State::Playing || views.empty())
+		{
+			// Apply any time left over from before LOD was disabled
+			mEmissionScale = 1.0f;
+			_simulate(mPendingTime + timeDelta, animData);
+
+			mPendingTime = 0.0f;
+			mSuspended = false;
+			return true;
+		}
+
+		mPendingTime += timeDelta;
+
+		// Find the nearest view the particle system is visible from, using the bounds from the last update
+		bool visible = false;
+		float nearestDistance = std::numeric_limits<float>::max();
+
+		if(mBounds == AABox::INF_BOX)
+		{
+			visible = true;
+			nearestDistance = 0.0f;
+		}
+		else
+		{
+			AABox worldBounds = mBounds;
+			if(mSettings.simulationSpace == ParticleSimulationSpace::Local)
+				worldBounds.transformAffine(mTransform.getMatrix());
+
+			const Sphere worldSphere(worldBounds.getCenter(), worldBounds.getRadius());
+			for(auto& view : views)
+			{
+				if((view.layers & mLayer) == 0)
+					continue;
+
+				if(!view.frustum.intersects(worldSphere))
+					continue;
+
+				const float distance = view.position.distance(worldSphere.getCenter()) - worldSphere.getRadius();
+
+				visible = true;
+				nearestDistance = std::min(nearestDistance, std::max(distance, 0.0f));
+			}
+		}
+
+		// Nothing emitted by the GPU simulation should be injected more than once
+		const auto skipUpdate = [this]()
+		{
+			if(mSettings.gpuSimulation && mParticleSet)
+				mParticleSet->clear();
+		};
+
+		if(!visible)
+		{
+			if(lod.cullOffscreen)
+			{
+				mSuspended = true;
+
+				skipUpdate();
+				return false;
+			}
+
+			nearestDistance = lod.endDistance;
+		}
+
+		// Scale down emission and update rate with distance
+		const float lodT = Math::invLerp(nearestDistance, lod.startDistance, lod.endDistance);
+		const UINT32 maxUpdateInterval = std::max(lod.maxUpdateInterval, 1U);
+		const UINT32 updateInterval = 1 + (UINT32)Math::roundToInt(lodT * (maxUpdateInterval - 1));
+
+		mEmissionScale = Math::lerp(lodT, 1.0f, Math::clamp01(lod.minEmissionScale));
+
+		// Offset by ID so systems with the same interval don't all update on the same frame
+		if(!mSuspended && ((frameIdx + mId) % updateInterval) != 0)
+		{
+			skipUpdate();
+			return false;
+		}
+
+		float simulationTime = mPendingTime;
+		mPendingTime = 0.0f;
+
+		// Only re-simulate a bounded amount of the time the system was suspended for, and skip the rest
+		if(mSuspended)
+		{
+			mSuspended = false;
+
+			const float maxCatchUpTime = std::max(lod.maxCatchUpTime, 0.0f);
+			if(simulationTime > maxCatchUpTime)
+			{
+				fastForward(simulationTime - maxCatchUpTime);
+				simulationTime = maxCatchUpTime;
+			}
+		}
+
+		// Split large time steps into multiple fixed size ones, to keep the simulation stable. GPU simulated systems
+		// only emit on the simulation thread and expect a single step per frame.
+		UINT32 numSteps = 1;
+		if(!mSettings.gpuSimulation)
+			numSteps = std::max(1, Math::ceilToInt(simulationTime / MAX_LOD_TIME_STEP));
+
+		const float stepTime = simulationTime / numSteps;
+		for(UINT32 i = 0; i < numSteps; i++)
+			_simulate(stepTime, animData);
+
+		return true;
+	}
+
+	void ParticleSystem::fastForward(float timeDelta)
+	{
+		float timeStep;
+		const float newTime = _advanceTime(mTime, timeDelta, mSettings.duration, mSettings.isLooping, timeStep);
+
+		// GPU simulated particles keep being evolved on the GPU, so only the time needs to advance
+		if(!mSettings.gpuSimulation)
+		{
+			const ParticleSetData& particles = mParticleSet->getParticles();
+
+			UINT32 numParticles = mParticleSet->getParticleCount();
+			for(UINT32 i = 0; i < numParticles;)
+			{
+				particles.lifetime[i] -= timeStep;
+				if(particles.lifetime[i] <= 0.0f)
+				{
+					mParticleSet->freeParticle(i);
+					numParticles--;
+				}
+				else
+				{
+					particles.position[i] += particles.velocity[i] * timeStep;
+					particles.prevPosition[i] = particles.position[i];
+					i++;
+				}
+			}
 		}
 
 		mTime = newTime;
@@ -288,6 +535,13 @@ namespace bs
 
 	void ParticleSystem::preSimulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
 		float spacingOffset)
+	{
+		updateLifetimes(state, startIdx, count, spacing, spacingOffset);
+		preEvolve(mRandom, state, startIdx, count, spacing, spacingOffset);
+	}
+
+	void ParticleSystem::updateLifetimes(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
+		float spacingOffset)
 	{
 		const ParticleSetData& particles = mParticleSet->getParticles();
 		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
@@ -321,6 +575,13 @@ namespace bs
 			else
 				i++;
 		}
+	}
+
+	void ParticleSystem::preEvolve(Random& random, const ParticleSystemState& state, UINT32 startIdx, UINT32 count, 
+		bool spacing, float spacingOffset)
+	{
+		const ParticleSetData& particles = mParticleSet->getParticles();
+		const UINT32 endIdx = startIdx + count;
 
 		// Remember old positions
 		for (UINT32 i = startIdx; i < endIdx; i++)
@@ -333,7 +594,7 @@ namespace bs
 			if (props.priority < 0)
 				break;
 
-			evolver->evolve(mRandom, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
+			evolver->evolve(random, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
 		}
 	}
 
@@ -358,8 +619,8 @@ namespace bs
 		}
 	}
 
-	void ParticleSystem::postSimulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
-		float spacingOffset)
+	void ParticleSystem::postSimulate(Random& random, const ParticleSystemState& state, UINT32 startIdx, UINT32 count, 
+		bool spacing, float spacingOffset)
 	{
 		// Evolve post-simulation
 		for(auto& evolver : mEvolvers)
@@ -368,7 +629,7 @@ namespace bs
 			if(props.priority >= 0)
 				continue;
 
-			evolver->evolve(mRandom, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
+			evolver->evolve(random, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
 		}
 	}
 
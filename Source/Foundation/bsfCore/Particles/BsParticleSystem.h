@@ -10,6 +10,7 @@
 #include "CoreThread/BsCoreObject.h"
 #include "Image/BsPixelData.h"
 #include "Math/BsAABox.h"
+#include "Math/BsConvexVolume.h"
 #include "Particles/BsParticleDistribution.h"
 #include "Particles/BsParticleEvolver.h"
 #include "Particles/BsParticleEmitter.h"
@@ -29,6 +30,14 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Information about a view used for determining the level of detail of particle systems. */
+	struct ParticleLODView
+	{
+		ConvexVolume frustum;
+		Vector3 position;
+		UINT64 layers;
+	};
+
 	/** @} */
 
 	/** @addtogroup Particles
@@ -131,6 +140,73 @@ namespace bs
 		RTTITypeBase* getRTTI() const override;
 	};
 
+	/** 
+	 * Controls how is the particle system simulation scaled down as it gets further away from the viewer, or when it is
+	 * not visible at all. 
+	 */
+	struct BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:Particles) ParticleLODSettings : IReflectable
+	{
+		BS_SCRIPT_EXPORT()
+		ParticleLODSettings() = default;
+
+		/** Determines if LOD is enabled. If disabled the particle system is always fully simulated. */
+		BS_SCRIPT_EXPORT()
+		bool enabled = false;
+
+		/** Distance from the nearest camera at which the particle system starts getting scaled down, in world units. */
+		BS_SCRIPT_EXPORT()
+		float startDistance = 20.0f;
+
+		/** 
+		 * Distance from the nearest camera at which the particle system reaches the lowest level of detail, as 
+		 * determined by @p minEmissionScale and @p maxUpdateInterval, in world units.
+		 */
+		BS_SCRIPT_EXPORT()
+		float endDistance = 100.0f;
+
+		/** 
+		 * Scale to apply to the number of emitted particles at @p endDistance. Emission is scaled linearly between
+		 * 1 at @p startDistance and this value at @p endDistance. In range [0, 1].
+		 */
+		BS_SCRIPT_EXPORT()
+		float minEmissionScale = 0.25f;
+
+		/** 
+		 * Number of frames between simulation updates at @p endDistance. Time from skipped frames accumulates and is
+		 * applied on the next update. Interval increases linearly from 1 at @p startDistance.
+		 */
+		BS_SCRIPT_EXPORT()
+		UINT32 maxUpdateInterval = 4;
+
+		/** 
+		 * If true the simulation will be suspended while the particle system bounds aren't visible from any camera. Once
+		 * it becomes visible again the simulation catches up on the time it missed, as determined by 
+		 * @p maxCatchUpTime. 
+		 */
+		BS_SCRIPT_EXPORT()
+		bool cullOffscreen = true;
+
+		/** 
+		 * Maximum amount of time, in seconds, to re-simulate when a suspended particle system becomes visible again. 
+		 * Any time missed beyond this amount is skipped by aging and moving existing particles without emitting new ones
+		 * or running the evolvers. 
+		 */
+		BS_SCRIPT_EXPORT()
+		float maxCatchUpTime = 1.0f;
+
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+
+		/** Enumerates all the fields in the type and executes the specified processor action for each field. */
+		template<class P>
+		void rttiEnumFields(P p);
+	public:
+		friend class ParticleLODSettingsRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
 	/** @} */
 	/** @addtogroup Implementation
 	 *  @{
@@ -227,6 +303,10 @@ namespace bs
 		/** Determines how is each particle represented on the screen. */
 		BS_SCRIPT_EXPORT()
 		ParticleRenderMode renderMode = ParticleRenderMode::Billboard;
+
+		/** Settings controlling how is the simulation scaled down with distance, or when not visible. */
+		BS_SCRIPT_EXPORT()
+		ParticleLODSettings lod;
 	};
 
 	/** Templated common base for both sim and core thread variants of ParticleSystemSettings. */
@@ -354,6 +434,91 @@ namespace bs
 
 	template<> struct CoreThreadType<ParticleVectorFieldSettings> { typedef ct::ParticleVectorFieldSettings Type; };
 
+	/** Common base for both sim and core thread variants of ParticleSDFCollisionSettings. */
+	struct ParticleSDFCollisionSettingsBase
+	{
+		/** Position of the center of the signed distance field volume, in world space. */
+		BS_SCRIPT_EXPORT()
+		Vector3 position = Vector3::ZERO;
+
+		/** Orientation of the signed distance field volume, in world space. */
+		BS_SCRIPT_EXPORT()
+		Quaternion rotation = Quaternion::IDENTITY;
+
+		/** Size of the signed distance field volume along each of its axes, in world units. */
+		BS_SCRIPT_EXPORT()
+		Vector3 size = Vector3::ONE;
+
+		/** 
+		 * Determines the elasticity (bounciness) of the particle collision. Lower values make the collision less bouncy
+		 * and higher values more. 
+		 */
+		BS_SCRIPT_EXPORT()
+		float restitution = 1.0f;
+
+		/**
+		 * Determines how much velocity should a particle lose after a collision, in percent of its current velocity. In
+		 * range [0, 1].
+		 */
+		BS_SCRIPT_EXPORT()
+		float dampening = 0.5f;
+
+		/** Scale which to apply to particle size in order to determine the collision radius. */
+		BS_SCRIPT_EXPORT()
+		float radiusScale = 1.0f;
+	};
+
+	/** Templated common base for both sim and core thread variants of ParticleSDFCollisionSettings. */
+	template<bool Core>
+	struct TParticleSDFCollisionSettings : ParticleSDFCollisionSettingsBase
+	{
+		/** 
+		 * Single channel 3D texture containing a baked signed distance field to collide the particles against. Each texel
+		 * contains the distance to the nearest surface in world units, negative inside the geometry. The texture is mapped
+		 * over the volume determined by @p position, @p rotation and @p size. Collisions are disabled if no texture is
+		 * provided.
+		 */
+		BS_SCRIPT_EXPORT()
+		CoreVariantHandleType<Texture, Core> sdf;
+
+		/** Enumerates all the fields in the type and executes the specified processor action for each field. */
+		template<class P>
+		void rttiEnumFields(P processor);
+	};
+
+	/** @} */
+	/** @addtogroup Particles
+	 *  @{
+	 */
+
+	/** Settings used for controlling collisions against a signed distance field for GPU simulated particles. */
+	struct BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:Particles) 
+	ParticleSDFCollisionSettings : TParticleSDFCollisionSettings<false>, IReflectable
+	{
+		/************************************************************************/
+		/* 								RTTI		                     		*/
+		/************************************************************************/
+
+	public:
+		friend class ParticleSDFCollisionSettingsRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	namespace ct
+	{
+		/** Core thread counterpart of bs::ParticleSDFCollisionSettings. */
+		struct ParticleSDFCollisionSettings : TParticleSDFCollisionSettings<true>
+		{ };
+	}
+
+	/** @} */
+	/** @addtogroup Implementation
+	 *  @{
+	 */
+
+	template<> struct CoreThreadType<ParticleSDFCollisionSettings> { typedef ct::ParticleSDFCollisionSettings Type; };
+
 	/** Common base for both sim and core threat variants of ParticleGpuSimulationSettings. */
 	struct ParticleGpuSimulationSettingsBase
 	{
@@ -385,6 +550,10 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		CoreVariantType<ParticleVectorFieldSettings, Core> vectorField;
 
+		/** Settings controlling particle collisions against a baked signed distance field. */
+		BS_SCRIPT_EXPORT()
+		CoreVariantType<ParticleSDFCollisionSettings, Core> sdfCollision;
+
 		/** Enumerates all the fields in the type and executes the specified processor action for each field. */
 		template<class P>
 		void rttiEnumFields(P processor);
@@ -522,6 +691,21 @@ namespace bs
 		 */
 		void _simulate(float timeDelta, const EvaluatedAnimationData* animData);
 
+		/** 
+		 * Updates the particle simulation similar to _simulate(), except the simulation is scaled down or suspended 
+		 * according to the LOD settings, based on the distance and visibility of the particle system with respect to the
+		 * provided views.
+		 *
+		 * @param[in]	timeDelta	Time elapsed since the last call.
+		 * @param[in]	animData	Animation data used by emitters that depend on skinned meshes.
+		 * @param[in]	views		Views with respect to which to evaluate visibility and distance.
+		 * @param[in]	frameIdx	Index of the current frame. Used for distributing reduced rate updates of different
+		 *							systems over different frames.
+		 * @return					True if the simulation was advanced, false if it was skipped this frame.
+		 */
+		bool _simulateLOD(float timeDelta, const EvaluatedAnimationData* animData, const Vector<ParticleLODView>& views, 
+			UINT64 frameIdx);
+
 		/** 
 		 * Calculates the bounds of all the particles in the system. Should be called after a call to _simulate() to get
 		 * up-to-date bounds. The bounds are in the simulation space of the particle system.
@@ -560,7 +744,7 @@ namespace bs
 
 		/**
 		 * Decrements particle lifetime, kills expired particles and executes evolvers that need to run before
-		 * the simulation.
+		 * the simulation. Same as calling updateLifetimes() followed by preEvolve().
 		 *
 		 * @param[in]	state			State describing the current state of the simulation.
 		 * @param[in]	startIdx		Index of the first particle to update.
@@ -574,6 +758,41 @@ namespace bs
 		 */
 		void preSimulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset);
 
+		/** 
+		 * Decrements particle lifetime and kills expired particles. Killing particles changes the order of particles in 
+		 * the set, therefore this must not run in parallel with any other updates of the same set.
+		 *
+		 * @param[in]	state			State describing the current state of the simulation.
+		 * @param[in]	startIdx		Index of the first particle to update.
+		 * @param[in]	count			Number of particles to update, starting from @p startIdx.
+		 * @param[in]	spacing			When false all particles will use the same time-step. If true the time-step will
+		 *								be divided by @p count so particles are uniformly distributed over the 
+		 *								time-step.
+		 * @param[in]	spacingOffset	Extra offset that controls the starting position of the first particle when
+		 *								calculating spacing. Should be in range [0, 1). 0 = beginning of the current
+		 *								time step, 1 = start of next particle.
+		 */
+		void updateLifetimes(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
+			float spacingOffset);
+
+		/** 
+		 * Stores the current particle positions and executes evolvers that need to run before the simulation. Distinct
+		 * ranges of the same set can be evolved in parallel, as long as each uses its own @p random.
+		 *
+		 * @param[in]	random			Random number generator passed to the evolvers.
+		 * @param[in]	state			State describing the current state of the simulation.
+		 * @param[in]	startIdx		Index of the first particle to update.
+		 * @param[in]	count			Number of particles to update, starting from @p startIdx.
+		 * @param[in]	spacing			When false all particles will use the same time-step. If true the time-step will
+		 *								be divided by @p count so particles are uniformly distributed over the 
+		 *								time-step.
+		 * @param[in]	spacingOffset	Extra offset that controls the starting position of the first particle when
+		 *								calculating spacing. Should be in range [0, 1). 0 = beginning of the current
+		 *								time step, 1 = start of next particle.
+		 */
+		void preEvolve(Random& random, const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
+			float spacingOffset);
+
 		/** 
 		 * Integrates particle properties, advancing the simulation. 
 		 * 
@@ -592,6 +811,7 @@ namespace bs
 		/** 
 		 * Executes evolvers that need to run after the simulation. 
 		 * 
+		 * @param[in]	random			Random number generator passed to the evolvers.
 		 * @param[in]	state			State describing the current state of the simulation.
 		 * @param[in]	startIdx		Index of the first particle to update.
 		 * @param[in]	count			Number of particles to update, starting from @p startIdx.
@@ -602,7 +822,15 @@ namespace bs
 		 *								calculating spacing. Should be in range [0, 1). 0 = beginning of the current
 		 *								time step, 1 = start of next particle.
 		 */
-		void postSimulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset);
+		void postSimulate(Random& random, const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing,
+			float spacingOffset);
+
+		/** 
+		 * Advances the particle system time without running the full simulation. Existing particles are aged and moved
+		 * along their current velocity, but no new particles are emitted and evolvers are not executed. Used for cheaply
+		 * skipping over time during which the system was suspended.
+		 */
+		void fastForward(float timeDelta);
 
 		/** @copydoc CoreObject::createCore */
 		SPtr<ct::CoreObject> createCore() const override;
@@ -631,6 +859,12 @@ namespace bs
 		Random mRandom;
 		ParticleSet* mParticleSet = nullptr;
 
+		// LOD state
+		AABox mBounds = AABox::INF_BOX;
+		float mEmissionScale = 1.0f;
+		float mPendingTime = 0.0f;
+		bool mSuspended = false;
+
 		/************************************************************************/
 		/* 								RTTI		                     		*/
 		/************************************************************************/
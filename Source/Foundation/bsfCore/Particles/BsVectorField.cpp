@@ -149,7 +149,7 @@ namespace bs
 	{
 		String data;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 			data = stream->getAsString();
@@ -0,0 +1,41 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Physics/BsHeightFieldCollider.h"
+#include "Physics/BsPhysics.h"
+
+namespace bs
+{
+	HeightFieldCollider::HeightFieldCollider()
+	{ }
+
+	void HeightFieldCollider::setHeights(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows)
+	{
+		if (heights.empty())
+		{
+			mHeights.clear();
+			mNumColumns = 0;
+			mNumRows = 0;
+
+			onHeightsChanged();
+			return;
+		}
+
+		if (numColumns < 2 || numRows < 2 || (UINT32)heights.size() != numColumns * numRows)
+		{
+			LOGERR("Invalid height field. Height field must have at least two rows and columns, and one height per "
+				"sample.");
+			return;
+		}
+
+		mHeights = heights;
+		mNumColumns = numColumns;
+		mNumRows = numRows;
+
+		onHeightsChanged();
+	}
+
+	SPtr<HeightFieldCollider> HeightFieldCollider::create(const Vector3& position, const Quaternion& rotation)
+	{
+		return Physics::instance().createHeightFieldCollider(position, rotation);
+	}
+}
@@ -0,0 +1,71 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Physics/BsCollider.h"
+#include "Math/BsVector2.h"
+
+namespace bs
+{
+	/** @addtogroup Physics
+	 *  @{
+	 */
+
+	/**
+	 * A collider represented by a regular grid of height samples, used for terrain. Uses much less memory than an
+	 * equivalent triangle mesh. Height field colliders cannot be triggers, nor can they be a part of non-kinematic
+	 * rigidbodies.
+	 */
+	class BS_CORE_EXPORT HeightFieldCollider : public Collider
+	{
+	public:
+		HeightFieldCollider();
+
+		/**
+		 * Sets the height samples that represent the collider geometry. Samples are laid out on the local XZ plane,
+		 * starting at the local origin and extending towards positive X and Z, with the heights along the local Y axis.
+		 *
+		 * @param[in]	heights		Height of each sample. Samples are stored row by row, where each row contains
+		 *							@p numColumns samples along the X axis, and rows follow each other along the Z axis.
+		 * @param[in]	numColumns	Number of samples along the X axis. Must be at least two.
+		 * @param[in]	numRows		Number of samples along the Z axis. Must be at least two.
+		 */
+		void setHeights(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows);
+
+		/** Returns the height samples. See setHeights(). */
+		const Vector<float>& getHeights() const { return mHeights; }
+
+		/** Returns the number of height samples along the X axis. */
+		UINT32 getNumColumns() const { return mNumColumns; }
+
+		/** Returns the number of height samples along the Z axis. */
+		UINT32 getNumRows() const { return mNumRows; }
+
+		/** Determines the distance between neighbouring height samples, along the X and Z axes. */
+		virtual void setSpacing(const Vector2& spacing) { mSpacing = spacing; }
+
+		/** @copydoc setSpacing() */
+		Vector2 getSpacing() const { return mSpacing; }
+
+		/** 
+		 * Creates a new height field collider. 
+		 *
+		 * @param[in]	position	Position of the collider.
+		 * @param[in]	rotation	Rotation of the collider.
+		 */
+		static SPtr<HeightFieldCollider> create(const Vector3& position = Vector3::ZERO,
+			const Quaternion& rotation = Quaternion::IDENTITY);
+
+	protected:
+		/** Triggered whenever the height samples change. */
+		virtual void onHeightsChanged() { }
+
+		Vector<float> mHeights;
+		UINT32 mNumColumns = 0;
+		UINT32 mNumRows = 0;
+		Vector2 mSpacing = Vector2::ONE;
+	};
+
+	/** @} */
+}
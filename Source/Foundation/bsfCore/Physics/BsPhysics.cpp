@@ -3,11 +3,15 @@
 #include "Physics/BsPhysics.h"
 #include "Physics/BsRigidbody.h"
 #include "Math/BsRay.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
+#include "Math/BsCapsule.h"
 #include "Components/BsCCollider.h"
 
 namespace bs
 {
 	Physics::Physics(const PHYSICS_INIT_DESC& init)
+		:mFlags(init.flags)
 	{
 		memset(mCollisionMap, 1, CollisionMapSize * CollisionMapSize * sizeof(bool));
 	}
@@ -40,6 +44,135 @@ namespace bs
 		return rayCast(ray.getOrigin(), ray.getDirection(), hit, layer, max);
 	}
 
+	UINT32 Physics::rayCastBatch(const Ray* rays, const float* maxDistances, UINT32 count, PhysicsQueryHit* hits,
+		UINT64 layer) const
+	{
+		UINT32 numHits = 0;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			hits[i] = PhysicsQueryHit();
+
+			if (rayCast(rays[i], hits[i], layer, maxDistances[i]))
+				numHits++;
+		}
+
+		return numHits;
+	}
+
+	void Physics::moveCharacterControllers(CharacterController* const* controllers, const Vector3* displacements,
+		UINT32 count, CharacterCollisionFlags* flags, Vector3* positions)
+	{
+		for (UINT32 i = 0; i < count; i++)
+		{
+			flags[i] = controllers[i]->move(displacements[i]);
+
+			if (positions != nullptr)
+				positions[i] = controllers[i]->getPosition();
+		}
+	}
+
+	/** Converts batched query geometry into a capsule. */
+	static Capsule toCapsule(const PhysicsQueryShape& shape)
+	{
+		const Vector3 axis = shape.rotation.rotate(Vector3(shape.halfHeight, 0.0f, 0.0f));
+		return Capsule(LineSegment3(shape.center - axis, shape.center + axis), shape.radius);
+	}
+
+	UINT32 Physics::shapeCastBatch(const PhysicsQueryShape* shapes, const Vector3* unitDirs, const float* maxDistances,
+		UINT32 count, PhysicsQueryHit* hits, UINT64 layer) const
+	{
+		UINT32 numHits = 0;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const PhysicsQueryShape& shape = shapes[i];
+			hits[i] = PhysicsQueryHit();
+
+			bool wasHit = false;
+			switch (shape.type)
+			{
+			case PhysicsQueryShapeType::Box:
+				wasHit = boxCast(AABox(shape.center - shape.halfExtents, shape.center + shape.halfExtents),
+					shape.rotation, unitDirs[i], hits[i], layer, maxDistances[i]);
+				break;
+			case PhysicsQueryShapeType::Sphere:
+				wasHit = sphereCast(Sphere(shape.center, shape.radius), unitDirs[i], hits[i], layer, maxDistances[i]);
+				break;
+			case PhysicsQueryShapeType::Capsule:
+				wasHit = capsuleCast(toCapsule(shape), shape.rotation, unitDirs[i], hits[i], layer, maxDistances[i]);
+				break;
+			}
+
+			if (wasHit)
+				numHits++;
+		}
+
+		return numHits;
+	}
+
+	UINT32 Physics::shapeOverlapBatch(const PhysicsQueryShape* shapes, UINT32 count, Collider** colliders,
+		UINT32 maxColliders, UINT32* numOverlaps, UINT64 layer) const
+	{
+		UINT32 numColliders = 0;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const PhysicsQueryShape& shape = shapes[i];
+
+			Vector<Collider*> overlaps;
+			switch (shape.type)
+			{
+			case PhysicsQueryShapeType::Box:
+				overlaps = _boxOverlap(AABox(shape.center - shape.halfExtents, shape.center + shape.halfExtents),
+					shape.rotation, layer);
+				break;
+			case PhysicsQueryShapeType::Sphere:
+				overlaps = _sphereOverlap(Sphere(shape.center, shape.radius), layer);
+				break;
+			case PhysicsQueryShapeType::Capsule:
+				overlaps = _capsuleOverlap(toCapsule(shape), shape.rotation, layer);
+				break;
+			}
+
+			const UINT32 numToWrite = std::min((UINT32)overlaps.size(), maxColliders - numColliders);
+			for (UINT32 j = 0; j < numToWrite; j++)
+				colliders[numColliders + j] = overlaps[j];
+
+			numOverlaps[i] = numToWrite;
+			numColliders += numToWrite;
+		}
+
+		return numColliders;
+	}
+
+	UINT32 Physics::shapeOverlapAnyBatch(const PhysicsQueryShape* shapes, UINT32 count, bool* overlaps,
+		UINT64 layer) const
+	{
+		UINT32 numOverlapping = 0;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const PhysicsQueryShape& shape = shapes[i];
+
+			overlaps[i] = false;
+			switch (shape.type)
+			{
+			case PhysicsQueryShapeType::Box:
+				overlaps[i] = boxOverlapAny(AABox(shape.center - shape.halfExtents, shape.center + shape.halfExtents),
+					shape.rotation, layer);
+				break;
+			case PhysicsQueryShapeType::Sphere:
+				overlaps[i] = sphereOverlapAny(Sphere(shape.center, shape.radius), layer);
+				break;
+			case PhysicsQueryShapeType::Capsule:
+				overlaps[i] = capsuleOverlapAny(toCapsule(shape), shape.rotation, layer);
+				break;
+			}
+
+			if (overlaps[i])
+				numOverlapping++;
+		}
+
+		return numOverlapping;
+	}
+
 	Vector<PhysicsQueryHit> Physics::rayCastAll(const Ray& ray, UINT64 layer, float max) const
 	{
 		return rayCastAll(ray.getOrigin(), ray.getDirection(), layer, max);
@@ -6,6 +6,7 @@
 
 #include "BsCorePrerequisites.h"
 #include "Physics/BsPhysicsCommon.h"
+#include "Physics/BsCharacterController.h"
 #include "Utility/BsModule.h"
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
@@ -92,6 +93,45 @@ namespace bs
 		virtual bool rayCast(const Vector3& origin, const Vector3& unitDir, PhysicsQueryHit& hit,
 			UINT64 layer = BS_ALL_LAYERS, float max = FLT_MAX) const = 0;
 
+		/**
+		 * Casts multiple rays into the scene and returns the closest found hit for each, if any. Same as calling rayCast()
+		 * for each ray individually, but allows the implementation to process the queries as a batch which is
+		 * significantly more efficient for large numbers of rays. Safe to call from multiple threads, as long as the
+		 * simulation isn't running.
+		 * 
+		 * @param[in]	rays			Array of rays to cast into the scene. Ray directions must be normalized.
+		 * @param[in]	maxDistances	Array of maximum distances along each ray at which to perform the query. Each 
+		 *								distance must be larger than zero.
+		 * @param[in]	count			Number of entries in the @p rays, @p maxDistances and @p hits arrays.
+		 * @param[out]	hits			Pre-allocated array that receives the closest hit for each ray. Entries for rays
+		 *								that haven't hit anything will have a null PhysicsQueryHit::colliderRaw.
+		 * @param[in]	layer			Layers to consider for the query. This allows you to ignore certain groups of 
+		 *								objects.
+		 * @return						Number of rays that have hit something.
+		 */
+		virtual UINT32 rayCastBatch(const Ray* rays, const float* maxDistances, UINT32 count, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS) const;
+
+		/**
+		 * Sweeps multiple shapes through the scene and returns the closest found hit for each, if any. Same as calling
+		 * boxCast(), sphereCast() or capsuleCast() for each shape individually, but allows the implementation to
+		 * process the queries as a batch. Safe to call from multiple threads, as long as the simulation isn't running.
+		 *
+		 * @param[in]	shapes			Array of shapes to sweep through the scene.
+		 * @param[in]	unitDirs		Array of unit directions towards which to sweep each of the shapes.
+		 * @param[in]	maxDistances	Array of maximum distances at which to perform each sweep. Each distance must be
+		 *								larger than zero.
+		 * @param[in]	count			Number of entries in the @p shapes, @p unitDirs, @p maxDistances and @p hits
+		 *								arrays.
+		 * @param[out]	hits			Pre-allocated array that receives the closest hit for each shape. Entries for
+		 *								shapes that haven't hit anything will have a null PhysicsQueryHit::colliderRaw.
+		 * @param[in]	layer			Layers to consider for the query. This allows you to ignore certain groups of
+		 *								objects.
+		 * @return						Number of shapes that have hit something.
+		 */
+		virtual UINT32 shapeCastBatch(const PhysicsQueryShape* shapes, const Vector3* unitDirs,
+			const float* maxDistances, UINT32 count, PhysicsQueryHit* hits, UINT64 layer = BS_ALL_LAYERS) const;
+
 		/**
 		 * Performs a sweep into the scene using a box and returns the closest found hit, if any.
 		 * 
@@ -427,6 +467,41 @@ namespace bs
 		virtual bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const = 0;
 
+		/**
+		 * Finds all colliders overlapping each of the provided shapes. Same as calling _boxOverlap(), _sphereOverlap()
+		 * or _capsuleOverlap() for each shape individually, but writes the results into a caller provided buffer and
+		 * allows the implementation to process the queries as a batch. Safe to call from multiple threads, as long as
+		 * the simulation isn't running.
+		 *
+		 * @param[in]	shapes			Array of shapes to check for overlap.
+		 * @param[in]	count			Number of entries in the @p shapes and @p numOverlaps arrays.
+		 * @param[out]	colliders		Pre-allocated array that receives the overlapping colliders. Colliders of each
+		 *								shape are written one after another, in the order of the shapes.
+		 * @param[in]	maxColliders	Number of entries in the @p colliders array. Once the array is full the
+		 *								remaining overlaps are not reported.
+		 * @param[out]	numOverlaps		Pre-allocated array that receives the number of colliders written for each
+		 *								shape.
+		 * @param[in]	layer			Layers to consider for the query. This allows you to ignore certain groups of
+		 *								objects.
+		 * @return						Total number of colliders written to @p colliders.
+		 */
+		virtual UINT32 shapeOverlapBatch(const PhysicsQueryShape* shapes, UINT32 count, Collider** colliders,
+			UINT32 maxColliders, UINT32* numOverlaps, UINT64 layer = BS_ALL_LAYERS) const;
+
+		/**
+		 * Checks if each of the provided shapes overlaps any collider in the scene. Same as calling boxOverlapAny(),
+		 * sphereOverlapAny() or capsuleOverlapAny() for each shape individually, but allows the implementation to
+		 * process the queries as a batch. Safe to call from multiple threads, as long as the simulation isn't running.
+		 *
+		 * @param[in]	shapes		Array of shapes to check for overlap.
+		 * @param[in]	count		Number of entries in the @p shapes and @p overlaps arrays.
+		 * @param[out]	overlaps	Pre-allocated array that receives true for each shape overlapping a collider.
+		 * @param[in]	layer		Layers to consider for the query. This allows you to ignore certain groups of objects.
+		 * @return					Number of shapes that overlap something.
+		 */
+		virtual UINT32 shapeOverlapAnyBatch(const PhysicsQueryShape* shapes, UINT32 count, bool* overlaps,
+			UINT64 layer = BS_ALL_LAYERS) const;
+
 		/******************************************************************************************************************/
 		/************************************************* OPTIONS ********************************************************/
 		/******************************************************************************************************************/
@@ -451,7 +526,8 @@ namespace bs
 		/** 
 		 * Adds a new physics region. Certain physics options require you to set up regions in which physics objects are
 		 * allowed to be in, and objects outside of these regions will not be handled by physics. You do not need to set
-		 * up these regions by default.
+		 * up these regions by default. Regions only have an effect when PHYSICS_INIT_DESC::regionBroadPhase is enabled,
+		 * in which case they should be added and removed as areas of the world are loaded and unloaded.
 		 */
 		BS_SCRIPT_EXPORT(n:AddPhysicsRegion)
 		virtual UINT32 addBroadPhaseRegion(const AABox& region) = 0;
@@ -464,6 +540,31 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:ClearPhysicsRegions)
 		virtual void clearBroadPhaseRegions() = 0;
 
+		/**
+		 * Creates a new physics scene. Objects in different scenes never interact and the scenes are simulated in
+		 * parallel, which makes them useful for independent areas of a world, or independent worlds hosted by the same
+		 * application. A default scene with ID 0 always exists. Returns the ID of the new scene.
+		 *
+		 * @note	Implementations that don't support multiple scenes return the ID of the default scene.
+		 */
+		virtual UINT32 addScene() { return 0; }
+
+		/**
+		 * Destroys a scene previously created with addScene(). All physics objects in the scene must be destroyed
+		 * beforehand. The default scene cannot be destroyed.
+		 */
+		virtual void removeScene(UINT32 sceneId) { }
+
+		/**
+		 * Makes the scene with the provided ID active. Physics objects created afterwards are placed in the active
+		 * scene, while queries, gravity and broadphase regions apply to the active scene. Objects created in a scene
+		 * remain in it regardless of which scene is active.
+		 */
+		virtual void setActiveScene(UINT32 sceneId) { }
+
+		/** Returns the ID of the scene set by setActiveScene(). */
+		virtual UINT32 getActiveScene() const { return 0; }
+
 		/** 
 		 * Returns a maximum edge length before a triangle is tesselated. 
 		 *
@@ -524,6 +625,10 @@ namespace bs
 		/** @copydoc MeshCollider::create */
 		virtual SPtr<MeshCollider> createMeshCollider(const Vector3& position, const Quaternion& rotation) = 0;
 
+		/** @copydoc HeightFieldCollider::create */
+		virtual SPtr<HeightFieldCollider> createHeightFieldCollider(const Vector3& position,
+			const Quaternion& rotation) = 0;
+
 		/** @copydoc FixedJoint::create */
 		virtual SPtr<FixedJoint> createFixedJoint(const FIXED_JOINT_DESC& desc) = 0;
 
@@ -545,6 +650,22 @@ namespace bs
 		/** @copydoc CharacterController::create */
 		virtual SPtr<CharacterController> createCharacterController(const CHAR_CONTROLLER_DESC& desc) = 0;
 
+		/**
+		 * Moves multiple character controllers. Same as calling CharacterController::move() for each controller
+		 * individually, but allows the implementation to process the moves as a batch, potentially in parallel. Hit
+		 * events triggered by the moves are delivered on the calling thread, once all the moves complete.
+		 *
+		 * @param[in]	controllers		Array of controllers to move. Each controller must be present only once.
+		 * @param[in]	displacements	Array of displacements to move each of the controllers by.
+		 * @param[in]	count			Number of entries in the @p controllers, @p displacements, @p flags and
+		 *								@p positions arrays.
+		 * @param[out]	flags			Pre-allocated array that receives the collision flags for each controller.
+		 * @param[out]	positions		Optional pre-allocated array that receives the position of each controller
+		 *								after the move.
+		 */
+		virtual void moveCharacterControllers(CharacterController* const* controllers, const Vector3* displacements,
+			UINT32 count, CharacterCollisionFlags* flags, Vector3* positions = nullptr);
+
 		/** 
 		 * Updates the physics simulation. In order to maintain stability of the physics calculations this method should
 		 * be called at fixed intervals (e.g. 60 times a second). 
@@ -615,6 +736,19 @@ namespace bs
 		bool initCooking = true; /**< Determines should the cooking library be initialized. */
 		/** Flags that control global physics option. */
 		PhysicsFlags flags = PhysicsFlag::CCT_OverlapRecovery | PhysicsFlag::CCT_PreciseSweeps | PhysicsFlag::CCD_Enable;
+		/**
+		 * If true the simulation of a fixed step runs in the background while the rest of the frame is processed, and
+		 * its results are only applied on the next fixed update. Rigidbody transforms are interpolated between the two
+		 * latest simulation results every frame, hiding the mismatch between fixed and frame rates. This improves
+		 * performance at the cost of rigidbodies lagging behind their physical state by up to two fixed steps.
+		 */
+		bool asyncSimulation = false;
+		/**
+		 * If true the broadphase only handles physics objects inside the regions registered with
+		 * Physics::addBroadPhaseRegion(), and each region is processed separately. This scales better for large worlds
+		 * where objects are spread over many independent areas, but objects that leave all regions stop colliding.
+		 */
+		bool regionBroadPhase = false;
 	};
 
 	/** @} */
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
+#include "Math/BsQuaternion.h"
 
 namespace bs
 {
@@ -87,5 +88,28 @@ namespace bs
 		Collider* colliderRaw = nullptr; /**< Collider that was hit. */
 	};
 
+	/** Types of geometry that can be used for batched physics queries. */
+	enum class PhysicsQueryShapeType
+	{
+		Box, /**< Box determined by PhysicsQueryShape::halfExtents. */
+		Sphere, /**< Sphere determined by PhysicsQueryShape::radius. */
+		/**
+		 * Capsule determined by PhysicsQueryShape::radius and PhysicsQueryShape::halfHeight, with its segment running
+		 * along the local X axis.
+		 */
+		Capsule
+	};
+
+	/** Geometry of a single query issued as a part of a batched physics query. */
+	struct PhysicsQueryShape
+	{
+		PhysicsQueryShapeType type = PhysicsQueryShapeType::Sphere; /**< Type of geometry to query with. */
+		Vector3 center = Vector3::ZERO; /**< Position of the geometry's center, in world space. */
+		Quaternion rotation = Quaternion::IDENTITY; /**< Orientation of the geometry. Ignored for spheres. */
+		Vector3 halfExtents = Vector3::ZERO; /**< Half of the size of the box along each of its axes. */
+		float radius = 0.0f; /**< Radius of the sphere, or of the capsule caps. */
+		float halfHeight = 0.0f; /**< Half of the length of the capsule segment, excluding the caps. */
+	};
+
 	/** @} */
 }
\ No newline at end of file
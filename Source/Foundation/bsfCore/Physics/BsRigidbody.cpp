@@ -19,8 +19,23 @@ namespace bs
 
 	void Rigidbody::_setTransform(const Vector3& position, const Quaternion& rotation)
 	{
-		mLinkedSO->setWorldPosition(position);
-		mLinkedSO->setWorldRotation(rotation);
+		mLinkedSO->setWorldPositionAndRotation(position, rotation);
+	}
+
+	void Rigidbody::_setTransforms(Rigidbody* const* rigidbodies, const Vector3* positions, const Quaternion* rotations,
+		UINT32 count)
+	{
+		// Resolve all the scene objects first, so their memory accesses aren't serialized with the transform updates
+		bs_frame_mark();
+		{
+			FrameVector<SceneObject*> sceneObjects(count);
+			for (UINT32 i = 0; i < count; i++)
+				sceneObjects[i] = rigidbodies[i]->mLinkedSO.get();
+
+			for (UINT32 i = 0; i < count; i++)
+				sceneObjects[i]->setWorldPositionAndRotation(positions[i], rotations[i]);
+		}
+		bs_frame_clear();
 	}
 
 	SPtr<Rigidbody> Rigidbody::create(const HSceneObject& linkedSO)
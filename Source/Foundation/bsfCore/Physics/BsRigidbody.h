@@ -305,6 +305,18 @@ namespace bs
 		 */
 		void _setTransform(const Vector3& position, const Quaternion& rotation);
 
+		/**
+		 * Applies new transform values retrieved from the most recent physics update to multiple rigidbodies at once.
+		 * Preferred over calling _setTransform() for each body when writing back the results of a simulation step.
+		 *
+		 * @param[in]	rigidbodies		Rigidbodies to update, @p count entries.
+		 * @param[in]	positions		New world positions, one for each rigidbody.
+		 * @param[in]	rotations		New world rotations, one for each rigidbody.
+		 * @param[in]	count			Number of rigidbodies to update.
+		 */
+		static void _setTransforms(Rigidbody* const* rigidbodies, const Vector3* positions, const Quaternion* rotations,
+			UINT32 count);
+
 		/** 
 		 * Sets the object that owns this physics object, if any. Used for high level systems so they can easily map their
 		 * high level physics objects from the low level ones returned by various queries and events.
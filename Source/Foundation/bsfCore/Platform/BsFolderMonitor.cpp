@@ -0,0 +1,178 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Platform/BsFolderMonitor.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	/** Changes are reported once they're pending for this many batch delays, even if new ones keep coming in. */
+	static constexpr UINT64 MAX_BATCH_DELAY_MULTIPLIER = 10;
+
+	void FolderChangeBatch::add(FolderChangeType type, const Path& path, const Path& oldPath)
+	{
+		if(type == FolderChangeType::Renamed)
+		{
+			// If the old path already changed in this batch there's no single state to rename from, so report the
+			// rename as a removal of the old path, and an addition of the new one
+			if(mLookup.find(oldPath) != mLookup.end())
+			{
+				add(FolderChangeType::Removed, oldPath);
+				add(FolderChangeType::Added, path);
+				return;
+			}
+		}
+
+		auto iterFind = mLookup.find(path);
+		if(iterFind == mLookup.end())
+		{
+			Entry entry;
+			entry.path = path;
+			entry.existed = type == FolderChangeType::Removed || type == FolderChangeType::Modified;
+			entry.exists = type != FolderChangeType::Removed;
+
+			if(type == FolderChangeType::Renamed)
+				entry.renamedFrom = oldPath;
+
+			mLookup[path] = (UINT32)mEntries.size();
+			mEntries.push_back(entry);
+			return;
+		}
+
+		Entry& entry = mEntries[iterFind->second];
+		switch(type)
+		{
+		case FolderChangeType::Added:
+		case FolderChangeType::Modified:
+			entry.exists = true;
+			break;
+		case FolderChangeType::Removed:
+			entry.exists = false;
+
+			// Renamed and then removed, which means the original file is the one that's gone
+			if(!entry.renamedFrom.isEmpty())
+			{
+				const Path renamedFrom = entry.renamedFrom;
+				entry.renamedFrom = Path::BLANK;
+
+				// Original path might have been reused since the rename, in which case its contents got replaced
+				auto iterFindOld = mLookup.find(renamedFrom);
+				if(iterFindOld != mLookup.end())
+					mEntries[iterFindOld->second].existed = true;
+				else
+					add(FolderChangeType::Removed, renamedFrom);
+			}
+			break;
+		case FolderChangeType::Renamed:
+			// Moved over an already changed path, replacing its contents. Note add() invalidates the entry reference.
+			entry.exists = true;
+			add(FolderChangeType::Removed, oldPath);
+			break;
+		}
+	}
+
+	void FolderChangeBatch::flush(Vector<FolderChange>& changes)
+	{
+		for(auto& entry : mEntries)
+		{
+			FolderChange change;
+			change.path = entry.path;
+
+			if(entry.existed && entry.exists)
+				change.type = FolderChangeType::Modified;
+			else if(entry.existed)
+				change.type = FolderChangeType::Removed;
+			else if(entry.exists)
+			{
+				if(!entry.renamedFrom.isEmpty())
+				{
+					change.type = FolderChangeType::Renamed;
+					change.oldPath = entry.renamedFrom;
+				}
+				else
+					change.type = FolderChangeType::Added;
+			}
+			else // Added and then removed
+				continue;
+
+			changes.push_back(change);
+		}
+
+		mEntries.clear();
+		mLookup.clear();
+	}
+
+	void FolderMonitor::queueChange(FolderChangeType type, const Path& path, const Path& oldPath)
+	{
+		const UINT64 time = mBatchTimer.getMilliseconds();
+		if(mPendingChanges.empty())
+			mFirstChangeTime = time;
+
+		mLastChangeTime = time;
+		mPendingChanges.add(type, path, oldPath);
+	}
+
+	void FolderMonitor::dispatchChanges()
+	{
+		if(mPendingChanges.empty())
+			return;
+
+		const UINT64 time = mBatchTimer.getMilliseconds();
+		const auto delay = (UINT64)(mBatchDelay * 1000.0f);
+		if((time - mLastChangeTime) < delay && (time - mFirstChangeTime) < delay * MAX_BATCH_DELAY_MULTIPLIER)
+			return;
+
+		// Keep collecting until the listeners are done with the previous batch, so batches are reported in order
+		if(mBatchTask != nullptr && !mBatchTask->isComplete())
+			return;
+
+		Vector<FolderChange> changes;
+		mPendingChanges.flush(changes);
+
+		for(auto& change : changes)
+		{
+			switch (change.type)
+			{
+			case FolderChangeType::Added:
+				if (!onAdded.empty())
+					onAdded(change.path);
+				break;
+			case FolderChangeType::Removed:
+				if (!onRemoved.empty())
+					onRemoved(change.path);
+				break;
+			case FolderChangeType::Modified:
+				if (!onModified.empty())
+					onModified(change.path);
+				break;
+			case FolderChangeType::Renamed:
+				if (!onRenamed.empty())
+					onRenamed(change.oldPath, change.path);
+				break;
+			}
+		}
+
+		if(changes.empty() || onBatch.empty())
+			return;
+
+		if(TaskScheduler::isStarted())
+		{
+			mBatchTask = Task::create("FolderMonitorBatch", [this, batch = std::move(changes)]()
+			{
+				onBatch(batch);
+			});
+
+			TaskScheduler::instance().addTask(mBatchTask);
+		}
+		else
+			onBatch(changes);
+	}
+
+	void FolderMonitor::waitForBatch()
+	{
+		if(mBatchTask != nullptr)
+		{
+			mBatchTask->wait();
+			mBatchTask = nullptr;
+		}
+	}
+}
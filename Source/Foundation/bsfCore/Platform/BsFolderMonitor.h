@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BsCorePrerequisites.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
@@ -21,6 +22,69 @@ namespace bs
 	typedef Flags<FolderChangeBit> FolderChangeBits;
 	BS_FLAGS_OPERATORS(FolderChangeBit)
 
+	/** Types of changes reported by FolderMonitor. */
+	enum class FolderChangeType
+	{
+		Added, /**< File/folder was created or moved into the monitored folder. */
+		Removed, /**< File/folder was deleted or moved out of the monitored folder. */
+		Modified, /**< File was written to, or replaced by a different file. */
+		Renamed /**< File/folder was renamed. */
+	};
+
+	/** Single change of a file or a folder, as reported in a batch by FolderMonitor::onBatch. */
+	struct FolderChange
+	{
+		FolderChangeType type;
+
+		/** Absolute path to the changed file/folder. For renames this is the new path. */
+		Path path;
+
+		/** Absolute path to the file/folder before it was renamed. Only set for renames. */
+		Path oldPath;
+	};
+
+	/**
+	 * Collects changes to files and folders, and coalesces them so each path is reported at most once, with the change
+	 * being the difference between the state before the first and after the last collected change. For example a file
+	 * that was added and then removed is not reported, a file that was removed and added again is reported as modified,
+	 * and any number of writes to a file are reported as a single modification.
+	 */
+	class BS_CORE_EXPORT FolderChangeBatch
+	{
+	public:
+		/**
+		 * Registers a new change.
+		 *
+		 * @param[in]	type		Type of the change.
+		 * @param[in]	path		Absolute path to the changed file/folder. For renames this is the new path.
+		 * @param[in]	oldPath		Absolute path to the file/folder before it was renamed. Only relevant for renames.
+		 */
+		void add(FolderChangeType type, const Path& path, const Path& oldPath = Path::BLANK);
+
+		/**
+		 * Outputs the coalesced changes in the order the paths were first changed in, and clears the batch.
+		 *
+		 * @param[out]	changes		Coalesced changes. Appended to any existing entries.
+		 */
+		void flush(Vector<FolderChange>& changes);
+
+		/** Checks are there any changes in the batch. */
+		bool empty() const { return mEntries.empty(); }
+
+	private:
+		/** Accumulated state of a single path. */
+		struct Entry
+		{
+			Path path;
+			Path renamedFrom;
+			bool existed;
+			bool exists;
+		};
+
+		Vector<Entry> mEntries;
+		UnorderedMap<Path, UINT32> mLookup;
+	};
+
 	/**
 	 * Allows monitoring a file system folder for changes. Depending on the flags set this monitor can notify you when file
 	 * is changed/moved/renamed and similar.
@@ -52,6 +116,17 @@ namespace bs
 		/**	Stops monitoring all folders that are currently being monitored. */
 		void stopMonitorAll();
 
+		/**
+		 * Determines how long to wait after a change before the changes are reported. Changes reported during the wait
+		 * restart it, so bulk operations (e.g. a version control checkout) that change many files in a quick succession
+		 * are reported together, with each path reported once. Changes are reported once the wait reaches ten times the
+		 * delay, even if they are still ongoing. Zero by default, meaning changes are reported on the first _update().
+		 */
+		void setBatchDelay(float seconds) { mBatchDelay = seconds; }
+
+		/** @copydoc setBatchDelay */
+		float getBatchDelay() const { return mBatchDelay; }
+
 		/** Triggers callbacks depending on events that ocurred. Expected to be called once per frame. */
 		void _update();
 
@@ -67,6 +142,16 @@ namespace bs
 		/**	Triggers when a file/folder is renamed in the monitored folder. Provides absolute path with old and new names. */
 		Event<void(const Path&, const Path&)> onRenamed;
 
+		/**
+		 * Triggers once for every batch of changes, after the batch delay elapses. Each path is present in the batch
+		 * at most once. Triggered from a worker thread if the task scheduler is running, so listeners can perform
+		 * expensive work (e.g. hashing the changed files before checking them against the import cache) without
+		 * blocking the main thread. Batches are triggered one at a time, with the next batch collected until the
+		 * listeners are done with the previous one. Per-path events above are triggered for the same coalesced
+		 * changes, on the main thread.
+		 */
+		Event<void(const Vector<FolderChange>&)> onBatch;
+
 		/**
 		 * @name Internal
 		 * @{
@@ -83,7 +168,23 @@ namespace bs
 		/**	Called by the worker thread whenever a modification notification is received. */
 		void handleNotifications(FileNotifyInfo& notifyInfo, FolderWatchInfo& watchInfo);
 
+		/** Adds a change reported by the platform to the batch of changes waiting to be reported. */
+		void queueChange(FolderChangeType type, const Path& path, const Path& oldPath = Path::BLANK);
+
+		/** Reports the batch of changes, if the batch delay has elapsed since the last change. */
+		void dispatchChanges();
+
+		/** Blocks until the listeners of the last reported batch are done with it. */
+		void waitForBatch();
+
 		Pimpl* m;
+
+		FolderChangeBatch mPendingChanges;
+		Timer mBatchTimer;
+		float mBatchDelay = 0.0f;
+		UINT64 mFirstChangeTime = 0;
+		UINT64 mLastChangeTime = 0;
+		SPtr<Task> mBatchTask;
 	};
 
 	/** @} */
@@ -230,6 +230,15 @@ namespace bs
 		 */
 		static void sleep(UINT32 duration);
 
+		/**
+		 * Causes the current thread to pause execution for the specified amount of time, using the highest resolution
+		 * timer available on the platform. Unlike sleep() this doesn't depend on the system timer granularity, although
+		 * the thread may still wake up slightly late, depending on the scheduler.
+		 *
+		 * @param[in]	duration	Duration in microseconds.
+		 */
+		static void sleepPrecise(UINT64 duration);
+
 		/**
 		 * Opens the provided folder using the default application, as specified by the operating system.
 		 *
@@ -16,6 +16,8 @@
 #include <X11/XKBlib.h>
 #include <X11/extensions/XInput2.h>
 #include <pwd.h>
+#include <time.h>
+#include <errno.h>
 
 namespace bs
 {
@@ -447,6 +449,17 @@ namespace bs
 		usleep(duration * 1000);
 	}
 
+	void Platform::sleepPrecise(UINT64 duration)
+	{
+		timespec remaining;
+		remaining.tv_sec = (time_t)(duration / 1000000);
+		remaining.tv_nsec = (long)((duration % 1000000) * 1000);
+
+		// Keep sleeping for the remaining time if interrupted by a signal
+		while(clock_nanosleep(CLOCK_MONOTONIC, 0, &remaining, &remaining) == EINTR)
+			;
+	}
+
 	void Platform::copyToClipboard(const String& string)
 	{
 		Lock lock(mData->lock);
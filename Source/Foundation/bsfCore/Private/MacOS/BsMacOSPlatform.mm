@@ -792,6 +792,17 @@ namespace bs
 		usleep(duration * 1000);
 	}
 
+	void Platform::sleepPrecise(UINT64 duration)
+	{
+		timespec remaining;
+		remaining.tv_sec = (time_t)(duration / 1000000);
+		remaining.tv_nsec = (long)((duration % 1000000) * 1000);
+
+		// Keep sleeping for the remaining time if interrupted by a signal
+		while(nanosleep(&remaining, &remaining) == -1 && errno == EINTR)
+			;
+	}
+
 	void Platform::copyToClipboard(const String& string)
 	{ @autoreleasepool {
 		NSString* text = [NSString stringWithUTF8String:string.c_str()];
@@ -0,0 +1,115 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Particles/BsParticleSet.h"
+
+namespace bs
+{
+	/** Free blocks cached by the ParticleBufferPool, grouped by block size. */
+	struct ParticleBufferPoolData
+	{
+		~ParticleBufferPoolData()
+		{
+			clear();
+		}
+
+		/** Releases all cached blocks. Caller must hold the mutex. */
+		void clear()
+		{
+			for(auto& entry : freeBlocks)
+			{
+				for(auto& block : entry.second)
+					bs_free(block);
+			}
+
+			freeBlocks.clear();
+			stats.numCachedBlocks = 0;
+			stats.cachedBytes = 0;
+		}
+
+		UnorderedMap<UINT64, Vector<UINT8*>> freeBlocks;
+		ParticleBufferPoolStats stats;
+		Mutex mutex;
+	};
+
+	/** Returns the global pool data, created on first use. */
+	static ParticleBufferPoolData& getPoolData()
+	{
+		static ParticleBufferPoolData data;
+		return data;
+	}
+
+	UINT32 ParticleBufferPool::getClassCapacity(UINT32 capacity)
+	{
+		if(capacity <= MIN_CAPACITY)
+			return MIN_CAPACITY;
+
+		return Bitwise::nextPow2(capacity);
+	}
+
+	UINT8* ParticleBufferPool::alloc(UINT32 capacity, UINT32 bytesPerParticle)
+	{
+		assert(capacity == getClassCapacity(capacity));
+
+		const UINT64 numBytes = (UINT64)capacity * bytesPerParticle;
+		ParticleBufferPoolData& pool = getPoolData();
+
+		{
+			Lock lock(pool.mutex);
+			pool.stats.allocatedBytes += numBytes;
+
+			auto iterFind = pool.freeBlocks.find(numBytes);
+			if(iterFind != pool.freeBlocks.end() && !iterFind->second.empty())
+			{
+				UINT8* block = iterFind->second.back();
+				iterFind->second.pop_back();
+
+				pool.stats.numCachedBlocks--;
+				pool.stats.cachedBytes -= numBytes;
+
+				return block;
+			}
+		}
+
+		return (UINT8*)bs_alloc((size_t)numBytes);
+	}
+
+	void ParticleBufferPool::free(UINT8* data, UINT32 capacity, UINT32 bytesPerParticle)
+	{
+		const UINT64 numBytes = (UINT64)capacity * bytesPerParticle;
+		ParticleBufferPoolData& pool = getPoolData();
+
+		{
+			Lock lock(pool.mutex);
+			pool.stats.allocatedBytes -= numBytes;
+
+			Vector<UINT8*>& blocks = pool.freeBlocks[numBytes];
+			if(blocks.size() < MAX_CACHED_BLOCKS)
+			{
+				blocks.push_back(data);
+
+				pool.stats.numCachedBlocks++;
+				pool.stats.cachedBytes += numBytes;
+
+				return;
+			}
+		}
+
+		bs_free(data);
+	}
+
+	void ParticleBufferPool::trim()
+	{
+		ParticleBufferPoolData& pool = getPoolData();
+
+		Lock lock(pool.mutex);
+		pool.clear();
+	}
+
+	ParticleBufferPoolStats ParticleBufferPool::getStats()
+	{
+		ParticleBufferPoolData& pool = getPoolData();
+
+		Lock lock(pool.mutex);
+		return pool.stats;
+	}
+}
@@ -7,7 +7,6 @@
 #include "Math/BsVector3.h"
 #include "Math/BsVector2.h"
 #include "Utility/BsBitwise.h"
-#include "Allocators/BsGroupAlloc.h"
 
 namespace bs
 {
@@ -15,6 +14,50 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Information about memory currently cached by the ParticleBufferPool. */
+	struct ParticleBufferPoolStats
+	{
+		UINT32 numCachedBlocks = 0; /**< Number of free blocks held by the pool, ready for reuse. */
+		UINT64 cachedBytes = 0; /**< Total size of all free blocks held by the pool, in bytes. */
+		UINT64 allocatedBytes = 0; /**< Total size of all blocks currently in use by particle sets, in bytes. */
+	};
+
+	/** 
+	 * Allocator for particle set buffers, shared by all particle systems. Allocations are grouped into power of two size
+	 * classes based on particle capacity, and freed blocks are kept around so the next set requesting the same size
+	 * class can reuse them without going to the system allocator. This avoids reallocations and page faults when
+	 * particle systems rapidly grow and shrink, such as with bursty emitters.
+	 * 
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ParticleBufferPool
+	{
+	public:
+		/** Smallest capacity handed out by the pool, in particles. */
+		static constexpr UINT32 MIN_CAPACITY = 64;
+
+		/** Maximum number of free blocks to keep per size class. Any blocks freed past this limit are released. */
+		static constexpr UINT32 MAX_CACHED_BLOCKS = 8;
+
+		/** Returns the capacity of the smallest size class able to hold @p capacity particles. */
+		static UINT32 getClassCapacity(UINT32 capacity);
+
+		/** 
+		 * Allocates a block large enough to hold @p capacity particles, where @p capacity must be one of the values
+		 * returned by getClassCapacity(). Block is aligned to 16 bytes.
+		 */
+		static UINT8* alloc(UINT32 capacity, UINT32 bytesPerParticle);
+
+		/** Returns a block previously allocated with alloc() to the pool. Parameters must match the ones used on alloc(). */
+		static void free(UINT8* data, UINT32 capacity, UINT32 bytesPerParticle);
+
+		/** Releases all free blocks held by the pool back to the system. */
+		static void trim();
+
+		/** Returns information about memory currently cached and in use by the pool. */
+		static ParticleBufferPoolStats getStats();
+	};
+
 	/** Handles buffers containing particle data and their allocation/deallocation. */
 	struct ParticleSetData
 	{
@@ -59,6 +102,16 @@ namespace bs
 			free();
 		}
 
+		/** Number of particles processed together by vectorized particle evolvers. */
+		static constexpr UINT32 SIMD_WIDTH = 4;
+
+		/** Size of all the buffers for a single particle, in bytes. */
+		static constexpr UINT32 BYTES_PER_PARTICLE = sizeof(Vector3) * 5 + sizeof(float) * 3 + sizeof(RGBA) + 
+			sizeof(UINT32) * 2;
+
+		/** Returns the number of bytes allocated by this set. */
+		UINT64 getAllocatedBytes() const { return data ? (UINT64)capacity * BYTES_PER_PARTICLE : 0; }
+
 		UINT32 capacity = 0;
 
 		Vector3* prevPosition = nullptr;
@@ -75,54 +128,59 @@ namespace bs
 
 	private:
 		/** 
-		 * Allocates a new set of buffers with enough space to store number of particles equal to the current capacity. *
-		 * Called must ensure any previously allocated buffer is freed by calling free().
+		 * Allocates a new set of buffers with enough space to store number of particles equal to the current capacity.
+		 * Capacity is rounded up to the nearest pool size class. Caller must ensure any previously allocated buffer is
+		 * freed by calling free().
 		 */
 		void allocate()
 		{
-			alloc.
-				reserve<Vector3>(capacity).
-				reserve<Vector3>(capacity).
-				reserve<Vector3>(capacity).
-				reserve<Vector3>(capacity).
-				reserve<Vector3>(capacity).
-				reserve<float>(capacity).
-				reserve<float>(capacity).
-				reserve<RGBA>(capacity).
-				reserve<UINT32>(capacity).
-				reserve<float>(capacity).
-				reserve<UINT32>(capacity).
-				init();
-
-			prevPosition = alloc.alloc<Vector3>(capacity);
-			position = alloc.alloc<Vector3>(capacity);
-			velocity = alloc.alloc<Vector3>(capacity);
-			size = alloc.alloc<Vector3>(capacity);
-			rotation = alloc.alloc<Vector3>(capacity);
-			lifetime = alloc.alloc<float>(capacity);
-			initialLifetime = alloc.alloc<float>(capacity);
-			color = alloc.alloc<RGBA>(capacity);
-			seed = alloc.alloc<UINT32>(capacity);
-			frame = alloc.alloc<float>(capacity);
-			indices = alloc.alloc<UINT32>(capacity);
+			// Size classes are always a multiple of SIMD_WIDTH particles. All elements are 4 bytes per component, 
+			// ensuring every buffer starts on a 16-byte boundary, which is the alignment of the base allocation.
+			capacity = ParticleBufferPool::getClassCapacity(capacity);
+			data = ParticleBufferPool::alloc(capacity, BYTES_PER_PARTICLE);
+
+			UINT8* dataPtr = data;
+			const auto carve = [this, &dataPtr](auto*& output)
+			{
+				using T = std::remove_reference_t<decltype(*output)>;
+
+				output = (T*)dataPtr;
+				dataPtr += sizeof(T) * capacity;
+			};
+
+			carve(prevPosition);
+			carve(position);
+			carve(velocity);
+			carve(size);
+			carve(rotation);
+			carve(lifetime);
+			carve(initialLifetime);
+			carve(color);
+			carve(seed);
+			carve(frame);
+			carve(indices);
+
+			assert((UINT64)(dataPtr - data) == getAllocatedBytes());
 		}
 
-		/** Frees the internal buffers. */
+		/** Returns the internal buffers to the pool. */
 		void free()
 		{
-			if(prevPosition) alloc.free(prevPosition);
-			if(position) alloc.free(position);
-			if(velocity) alloc.free(velocity);
-			if(size) alloc.free(size);
-			if(rotation) alloc.free(rotation);
-			if(lifetime) alloc.free(lifetime);
-			if(initialLifetime) alloc.free(initialLifetime);
-			if(color) alloc.free(color);
-			if(seed) alloc.free(seed);
-			if(frame) alloc.free(frame);
-			if(indices) alloc.free(indices);
-
-			alloc.clear();
+			if(data)
+				ParticleBufferPool::free(data, capacity, BYTES_PER_PARTICLE);
+
+			data = nullptr;
+			prevPosition = nullptr;
+			position = nullptr;
+			velocity = nullptr;
+			size = nullptr;
+			rotation = nullptr;
+			lifetime = nullptr;
+			initialLifetime = nullptr;
+			color = nullptr;
+			seed = nullptr;
+			frame = nullptr;
+			indices = nullptr;
 		}
 
 		/** Transfers ownership of @p other internal buffers to this object. */
@@ -140,8 +198,7 @@ namespace bs
 			frame = std::exchange(other.frame, nullptr);
 			indices = std::exchange(other.indices, nullptr);
 			capacity = std::exchange(other.capacity, 0);
-
-			alloc = std::move(other.alloc);
+			data = std::exchange(other.data, nullptr);
 		}
 
 		/** Copies data from @p other buffers to this object. */
@@ -162,15 +219,15 @@ namespace bs
 			bs_copy(indices, other.indices, other.capacity);
 		}
 
-		GroupAlloc alloc;
+		UINT8* data = nullptr;
 	};
 
-	/** Provides a simple and fast way to allocate and deallocate particles. */
+	/** 
+	 * Provides a simple and fast way to allocate and deallocate particles. Particle buffers are allocated from the
+	 * ParticleBufferPool and grow by moving to the next size class once the capacity is reached.
+	 */
 	class ParticleSet : public INonCopyable
 	{
-		/** Determines how much to increase capacity once the cap is reached, in percent. */
-		static constexpr float CAPACITY_SCALE = 1.2f; // 20%
-
 	public:
 		/** 
 		 * Constructs a new particle set with enough space to hold @p capacity particles. The set will automatically 
@@ -191,11 +248,7 @@ namespace bs
 			mCount += count;
 
 			if(mCount > mParticles.capacity)
-			{
-				const auto newCapacity = (UINT32)(mCount * CAPACITY_SCALE);
-				ParticleSetData newData(newCapacity, mParticles);
-				mParticles = std::move(newData);
-			}
+				reserve(mCount);
 
 			const UINT32 particleEnd = particleIdx + count;
 			if(particleEnd > mMaxIndex)
@@ -207,6 +260,19 @@ namespace bs
 			return particleIdx;
 		}
 
+		/** 
+		 * Ensures the set can hold at least @p capacity particles without needing to grow. Existing particles are
+		 * preserved.
+		 */
+		void reserve(UINT32 capacity)
+		{
+			if(capacity <= mParticles.capacity)
+				return;
+
+			ParticleSetData newData(capacity, mParticles);
+			mParticles = std::move(newData);
+		}
+
 		/** Deallocates a particle. Can invalidate particle indices. */
 		void freeParticle(UINT32 idx)
 		{
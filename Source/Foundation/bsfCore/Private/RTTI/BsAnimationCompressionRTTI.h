@@ -0,0 +1,52 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsRTTIType.h"
+#include "Animation/BsAnimationCompression.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	class BS_CORE_EXPORT CompressedAnimationCurvesRTTI : 
+		public RTTIType <CompressedAnimationCurves, IReflectable, CompressedAnimationCurvesRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mPositionTracks, 0)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mRotationTracks, 1)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mScaleTracks, 2)
+			BS_RTTI_MEMBER_PLAIN(mFrameData, 3)
+			BS_RTTI_MEMBER_PLAIN(mFrameSize, 4)
+			BS_RTTI_MEMBER_PLAIN(mNumFrames, 5)
+			BS_RTTI_MEMBER_PLAIN(mSampleRate, 6)
+			BS_RTTI_MEMBER_PLAIN(mStart, 7)
+			BS_RTTI_MEMBER_PLAIN(mEnd, 8)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "CompressedAnimationCurves";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_CompressedAnimationCurves;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<CompressedAnimationCurves>();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
@@ -17,6 +17,10 @@ namespace bs
 	{
 		enum { id = TID_KeyFrame }; enum { hasDynamicSize = 0 };
 
+		// Fields are written in declaration order, so if there is no padding the keyframe can be copied as is
+		enum { isMemcpy = RTTIPlainTypeIsMemcpy<T>::value && 
+			sizeof(TKeyframe<T>) == sizeof(T) * 3 + sizeof(float) };
+
 		/** @copydoc RTTIPlainType::toMemory */
 		static void toMemory(const TKeyframe<T>& data, char* memory)
 		{
@@ -30,19 +30,22 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mLength, 10)
 		BS_END_RTTI_MEMBERS
 
-		SPtr<DataStream> getData(AudioClip* obj, UINT32& size)
+		SPtr<DataStream> getData(AudioClip* obj, UINT64& size)
 		{
-			SPtr<DataStream> stream = obj->getSourceStream(size);
+			UINT32 streamSize = 0;
+			SPtr<DataStream> stream = obj->getSourceStream(streamSize);
+			size = streamSize;
+
 			if (stream != nullptr && stream->isFile())
 				LOGWRN("Saving an AudioClip which uses streaming data. Streaming data might not be available if saving to the same file.");
 
 			return stream;
 		}
 
-		void setData(AudioClip* obj, const SPtr<DataStream>& val, UINT32 size)
+		void setData(AudioClip* obj, const SPtr<DataStream>& val, UINT64 size)
 		{
 			obj->mStreamData = val->clone(); // Making sure that the AudioClip cannot modify the source stream, which is still used by the deserializer
-			obj->mStreamSize = size;
+			obj->mStreamSize = (UINT32)size;
 			obj->mStreamOffset = (UINT32)val->tell();
 		}
 
@@ -34,6 +34,15 @@ namespace bs
 		bool& getItalic(FontImportOptions* obj) { return obj->mItalic; }
 		void setItalic(FontImportOptions* obj, bool& value) { obj->mItalic = value; }
 
+		bool& getDynamic(FontImportOptions* obj) { return obj->mDynamic; }
+		void setDynamic(FontImportOptions* obj, bool& value) { obj->mDynamic = value; }
+
+		UINT32& getDynamicPageSize(FontImportOptions* obj) { return obj->mDynamicPageSize; }
+		void setDynamicPageSize(FontImportOptions* obj, UINT32& value) { obj->mDynamicPageSize = value; }
+
+		UINT32& getDynamicMaxPages(FontImportOptions* obj) { return obj->mDynamicMaxPages; }
+		void setDynamicMaxPages(FontImportOptions* obj, UINT32& value) { obj->mDynamicMaxPages = value; }
+
 	public:
 		FontImportOptionsRTTI()
 		{
@@ -43,6 +52,11 @@ namespace bs
 			addPlainField("mRenderMode", 3, &FontImportOptionsRTTI::getRenderMode, &FontImportOptionsRTTI::setRenderMode);
 			addPlainField("mBold", 4, &FontImportOptionsRTTI::getBold, &FontImportOptionsRTTI::setBold);
 			addPlainField("mItalic", 5, &FontImportOptionsRTTI::getItalic, &FontImportOptionsRTTI::setItalic);
+			addPlainField("mDynamic", 6, &FontImportOptionsRTTI::getDynamic, &FontImportOptionsRTTI::setDynamic);
+			addPlainField("mDynamicPageSize", 7, &FontImportOptionsRTTI::getDynamicPageSize,
+				&FontImportOptionsRTTI::setDynamicPageSize);
+			addPlainField("mDynamicMaxPages", 8, &FontImportOptionsRTTI::getDynamicMaxPages,
+				&FontImportOptionsRTTI::setDynamicMaxPages);
 		}
 
 		const String& getRTTIName() override
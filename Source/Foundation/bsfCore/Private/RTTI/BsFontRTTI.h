@@ -6,6 +6,7 @@
 #include "Reflection/BsRTTIType.h"
 #include "Text/BsFont.h"
 #include "Image/BsTexture.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -25,6 +26,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(spaceWidth, 4)
 			BS_RTTI_MEMBER_REFL_ARRAY(texturePages, 5)
 			BS_RTTI_MEMBER_PLAIN(characters, 6)
+			BS_RTTI_MEMBER_PLAIN(distanceField, 7)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -48,6 +50,38 @@ namespace bs
 	class BS_CORE_EXPORT FontRTTI : public RTTIType<Font, Resource, FontRTTI>
 	{
 	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_NAMED(dynamicRenderMode, mDynamicDesc.renderMode, 1)
+			BS_RTTI_MEMBER_PLAIN_NAMED(dynamicDPI, mDynamicDesc.dpi, 2)
+			BS_RTTI_MEMBER_PLAIN_NAMED(dynamicPageSize, mDynamicDesc.pageSize, 3)
+			BS_RTTI_MEMBER_PLAIN_NAMED(dynamicMaxPages, mDynamicDesc.maxPages, 4)
+		BS_END_RTTI_MEMBERS
+
+		SPtr<DataStream> getSourceData(Font* obj, UINT64& size)
+		{
+			if(obj->mSourceData == nullptr)
+			{
+				size = 0;
+				return bs_shared_ptr_new<MemoryDataStream>(nullptr, 0, false);
+			}
+
+			size = obj->mSourceData->size();
+
+			obj->mSourceData->seek(0);
+			return obj->mSourceData;
+		}
+
+		void setSourceData(Font* obj, const SPtr<DataStream>& value, UINT64 size)
+		{
+			if(size == 0)
+				return;
+
+			SPtr<MemoryDataStream> sourceData = bs_shared_ptr_new<MemoryDataStream>((size_t)size);
+			value->read(sourceData->getPtr(), (size_t)size);
+
+			obj->mSourceData = sourceData;
+		}
+
 		FontBitmap& getBitmap(Font* obj, UINT32 idx)
 		{
 			if(idx >= obj->mFontDataPerSize.size())
@@ -80,6 +114,7 @@ namespace bs
 		FontRTTI()
 		{
 			addReflectableArrayField("mBitmaps", 0, &FontRTTI::getBitmap, &FontRTTI::getNumBitmaps, &FontRTTI::setBitmap, &FontRTTI::setNumBitmaps);
+			addDataBlockField("mSourceData", 5, &FontRTTI::getSourceData, &FontRTTI::setSourceData);
 		}
 
 		const String& getRTTIName() override
@@ -102,7 +137,11 @@ namespace bs
 		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
 		{
 			Font* font = static_cast<Font*>(obj);
-			font->initialize(mFontDataPerSize);
+
+			if(font->mSourceData != nullptr)
+				font->initialize(font->mSourceData, font->mDynamicDesc);
+			else
+				font->initialize(mFontDataPerSize);
 		}
 
 		Vector<SPtr<FontBitmap>> mFontDataPerSize;
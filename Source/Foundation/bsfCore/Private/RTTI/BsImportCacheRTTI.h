@@ -0,0 +1,45 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Reflection/BsRTTIType.h"
+#include "Importer/BsImportCache.h"
+#include "Resources/BsResource.h"
+
+namespace bs
+{
+	/** @cond RTTI */
+	/** @addtogroup RTTI-Impl-Core
+	 *  @{
+	 */
+
+	class BS_CORE_EXPORT ImportCacheEntryRTTI : public RTTIType <ImportCacheEntry, IReflectable, ImportCacheEntryRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mNames, 0)
+			BS_RTTI_MEMBER_REFLPTR_ARRAY(mResources, 1)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "ImportCacheEntry";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_ImportCacheEntry;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<ImportCacheEntry>();
+		}
+	};
+
+	/** @} */
+	/** @endcond */
+}
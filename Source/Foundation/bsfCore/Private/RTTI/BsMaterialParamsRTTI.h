@@ -49,19 +49,19 @@ namespace bs
 	class BS_CORE_EXPORT MaterialParamStructDataRTTI : public RTTIType<MaterialParamStructData, IReflectable, MaterialParamStructDataRTTI>
 	{
 	public:
-		SPtr<DataStream> getDataBuffer(MaterialParamStructData* obj, UINT32& size)
+		SPtr<DataStream> getDataBuffer(MaterialParamStructData* obj, UINT64& size)
 		{
 			size = obj->dataSize;
 
 			return bs_shared_ptr_new<MemoryDataStream>(obj->data, obj->dataSize, false);
 		}
 
-		void setDataBuffer(MaterialParamStructData* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setDataBuffer(MaterialParamStructData* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
 			obj->data = (UINT8*)bs_alloc(size);
 			value->read(obj->data, size);
 
-			obj->dataSize = size;
+			obj->dataSize = (UINT32)size;
 		}
 
 		MaterialParamStructDataRTTI()
@@ -121,19 +121,19 @@ namespace bs
 			obj->mParams.resize(size);
 		}
 
-		SPtr<DataStream> getDataBuffer(MaterialParams* obj, UINT32& size)
+		SPtr<DataStream> getDataBuffer(MaterialParams* obj, UINT64& size)
 		{
 			size = obj->mDataSize;
 
 			return bs_shared_ptr_new<MemoryDataStream>(obj->mDataParamsBuffer, obj->mDataSize, false);
 		}
 
-		void setDataBuffer(MaterialParams* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setDataBuffer(MaterialParams* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
-			obj->mDataParamsBuffer = obj->mAlloc.alloc(size);
+			obj->mDataParamsBuffer = obj->mAlloc.alloc((UINT32)size);
 			value->read(obj->mDataParamsBuffer, size);
 
-			obj->mDataSize = size;
+			obj->mDataSize = (UINT32)size;
 		}
 
 		MaterialParamStructData& getStructParam(MaterialParams* obj, UINT32 idx) { return obj->mStructParams[idx]; }
@@ -16,6 +16,7 @@ namespace bs
 	 */
 
 	BS_ALLOW_MEMCPY_SERIALIZATION(SubMesh);
+	BS_ALLOW_MEMCPY_SERIALIZATION(Meshlet);
 
 	class MeshBaseRTTI : public RTTIType<MeshBase, Resource, MeshBaseRTTI>
 	{
@@ -24,6 +25,16 @@ namespace bs
 		UINT32 getNumSubmeshes(MeshBase* obj) { return (UINT32)obj->mProperties.mSubMeshes.size(); }
 		void setNumSubmeshes(MeshBase* obj, UINT32 numElements) { obj->mProperties.mSubMeshes.resize(numElements); }
 
+		SubMesh& getLODSubMesh(MeshBase* obj, UINT32 arrayIdx) { return obj->mProperties.mLODSubMeshes[arrayIdx]; }
+		void setLODSubMesh(MeshBase* obj, UINT32 arrayIdx, SubMesh& value) { obj->mProperties.mLODSubMeshes[arrayIdx] = value; }
+		UINT32 getNumLODSubmeshes(MeshBase* obj) { return (UINT32)obj->mProperties.mLODSubMeshes.size(); }
+		void setNumLODSubmeshes(MeshBase* obj, UINT32 numElements) { obj->mProperties.mLODSubMeshes.resize(numElements); }
+
+		Meshlet& getMeshlet(MeshBase* obj, UINT32 arrayIdx) { return obj->mProperties.mMeshlets[arrayIdx]; }
+		void setMeshlet(MeshBase* obj, UINT32 arrayIdx, Meshlet& value) { obj->mProperties.mMeshlets[arrayIdx] = value; }
+		UINT32 getNumMeshlets(MeshBase* obj) { return (UINT32)obj->mProperties.mMeshlets.size(); }
+		void setNumMeshlets(MeshBase* obj, UINT32 numElements) { obj->mProperties.mMeshlets.resize(numElements); }
+
 		UINT32& getNumVertices(MeshBase* obj) { return obj->mProperties.mNumVertices; }
 		void setNumVertices(MeshBase* obj, UINT32& value) { obj->mProperties.mNumVertices = value; }
 
@@ -38,6 +49,10 @@ namespace bs
 
 			addPlainArrayField("mSubMeshes", 2, &MeshBaseRTTI::getSubMesh, 
 				&MeshBaseRTTI::getNumSubmeshes, &MeshBaseRTTI::setSubMesh, &MeshBaseRTTI::setNumSubmeshes);
+			addPlainArrayField("mLODSubMeshes", 3, &MeshBaseRTTI::getLODSubMesh, 
+				&MeshBaseRTTI::getNumLODSubmeshes, &MeshBaseRTTI::setLODSubMesh, &MeshBaseRTTI::setNumLODSubmeshes);
+			addPlainArrayField("mMeshlets", 4, &MeshBaseRTTI::getMeshlet, 
+				&MeshBaseRTTI::getNumMeshlets, &MeshBaseRTTI::setMeshlet, &MeshBaseRTTI::setNumMeshlets);
 		}
 
 		SPtr<IReflectable> newRTTIObject() override
@@ -32,16 +32,16 @@ namespace bs
 		UINT32& getNumIndices(MeshData* obj) { return obj->mNumIndices; }
 		void setNumIndices(MeshData* obj, UINT32& value) { obj->mNumIndices = value; }
 
-		SPtr<DataStream> getData(MeshData* obj, UINT32& size)
+		SPtr<DataStream> getData(MeshData* obj, UINT64& size)
 		{
 			size = obj->getInternalBufferSize();
 
 			return bs_shared_ptr_new<MemoryDataStream>(obj->getData(), size, false);
 		}
 
-		void setData(MeshData* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setData(MeshData* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
-			obj->allocateInternalBuffer(size);
+			obj->allocateInternalBuffer((UINT32)size);
 			value->read(obj->getData(), size);
 		}
 
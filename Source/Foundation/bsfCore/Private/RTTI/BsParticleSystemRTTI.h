@@ -649,6 +649,38 @@ namespace bs
 		}
 	};
 
+	class BS_CORE_EXPORT ParticleSDFCollisionSettingsRTTI : 
+	public RTTIType<ParticleSDFCollisionSettings, IReflectable, ParticleSDFCollisionSettingsRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_REFL(sdf, 0)
+			BS_RTTI_MEMBER_PLAIN(position, 1)
+			BS_RTTI_MEMBER_PLAIN(rotation, 2)
+			BS_RTTI_MEMBER_PLAIN(size, 3)
+			BS_RTTI_MEMBER_PLAIN(restitution, 4)
+			BS_RTTI_MEMBER_PLAIN(dampening, 5)
+			BS_RTTI_MEMBER_PLAIN(radiusScale, 6)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "ParticleSDFCollisionSettings";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_ParticleSDFCollisionSettings;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<ParticleSDFCollisionSettings>();
+		}
+	};
+
 	class BS_CORE_EXPORT ParticleDepthCollisionSettingsRTTI : 
 	public RTTIType<ParticleDepthCollisionSettings, IReflectable, ParticleDepthCollisionSettingsRTTI>
 	{
@@ -678,6 +710,38 @@ namespace bs
 		}
 	};
 
+	class BS_CORE_EXPORT ParticleLODSettingsRTTI : 
+	public RTTIType<ParticleLODSettings, IReflectable, ParticleLODSettingsRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(enabled, 0)
+			BS_RTTI_MEMBER_PLAIN(startDistance, 1)
+			BS_RTTI_MEMBER_PLAIN(endDistance, 2)
+			BS_RTTI_MEMBER_PLAIN(minEmissionScale, 3)
+			BS_RTTI_MEMBER_PLAIN(maxUpdateInterval, 4)
+			BS_RTTI_MEMBER_PLAIN(cullOffscreen, 5)
+			BS_RTTI_MEMBER_PLAIN(maxCatchUpTime, 6)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "ParticleLODSettings";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_ParticleLODSettings;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<ParticleLODSettings>();
+		}
+	};
+
 	class BS_CORE_EXPORT ParticleGpuSimulationSettingsRTTI : 
 	public RTTIType<ParticleGpuSimulationSettings, IReflectable, ParticleGpuSimulationSettingsRTTI>
 	{
@@ -689,6 +753,7 @@ namespace bs
 			BS_RTTI_MEMBER_REFL(depthCollision, 3)
 			BS_RTTI_MEMBER_PLAIN(acceleration, 4)
 			BS_RTTI_MEMBER_PLAIN(drag, 5)
+			BS_RTTI_MEMBER_REFL(sdfCollision, 6)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -730,6 +795,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(customBounds, 13)
 			BS_RTTI_MEMBER_PLAIN(renderMode, 14)
 			BS_RTTI_MEMBER_REFL(mesh, 15)
+			BS_RTTI_MEMBER_REFL(lod, 16)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -6,6 +6,7 @@
 #include "Reflection/BsRTTIType.h"
 #include "Private/RTTI/BsGpuProgramRTTI.h"
 #include "Material/BsPass.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -96,7 +97,7 @@ namespace bs
 
 		void setVertexProgramDesc(Pass* obj, SerializedGpuProgramData& val)
 		{
-			obj->mData.vertexProgramDesc = val;
+			mVertexProgramDesc = val;
 		}
 
 		SerializedGpuProgramData& getFragmentProgramDesc(Pass* obj) 
@@ -106,7 +107,7 @@ namespace bs
 
 		void setFragmentProgramDesc(Pass* obj, SerializedGpuProgramData& val)
 		{
-			obj->mData.fragmentProgramDesc = val;
+			mFragmentProgramDesc = val;
 		}
 
 		SerializedGpuProgramData& getGeometryProgramDesc(Pass* obj)
@@ -116,7 +117,7 @@ namespace bs
 
 		void setGeometryProgramDesc(Pass* obj, SerializedGpuProgramData& val)
 		{
-			obj->mData.geometryProgramDesc = val;
+			mGeometryProgramDesc = val;
 		}
 
 		SerializedGpuProgramData& getHullProgramDesc(Pass* obj)
@@ -126,7 +127,7 @@ namespace bs
 
 		void setHullProgramDesc(Pass* obj, SerializedGpuProgramData& val)
 		{
-			obj->mData.hullProgramDesc = val;
+			mHullProgramDesc = val;
 		}
 
 		SerializedGpuProgramData& getDomainProgramDesc(Pass* obj)
@@ -136,7 +137,7 @@ namespace bs
 
 		void setDomainProgramDesc(Pass* obj, SerializedGpuProgramData& val)
 		{
-			obj->mData.domainProgramDesc = val;
+			mDomainProgramDesc = val;
 		}
 
 		SerializedGpuProgramData& getComputeProgramDesc(Pass* obj)
@@ -146,8 +147,23 @@ namespace bs
 
 		void setComputeProgramDesc(Pass* obj, SerializedGpuProgramData& val)
 		{
-			obj->mData.computeProgramDesc = val;
+			mComputeProgramDesc = val;
 		}
+
+		SPtr<DataStream> getPrograms(Pass* obj, UINT64& size)
+		{
+			size = mEncodedPrograms->size();
+			return bs_shared_ptr_new<MemoryDataStream>(mEncodedPrograms->getPtr(), size, false);
+		}
+
+		void setPrograms(Pass* obj, const SPtr<DataStream>& value, UINT64 size)
+		{
+			mEncodedPrograms = bs_shared_ptr_new<MemoryDataStream>((size_t)size);
+			value->read(mEncodedPrograms->getPtr(), (size_t)size);
+		}
+
+		bool& getIsCompute(Pass* obj) { return mIsCompute; }
+		void setIsCompute(Pass* obj, bool& val) { mIsCompute = val; }
 	public:
 		PassRTTI()
 		{
@@ -157,18 +173,29 @@ namespace bs
 			addReflectableField("mHullProgramDesc", 6, &PassRTTI::getHullProgramDesc, &PassRTTI::setHullProgramDesc);
 			addReflectableField("mDomainProgramDesc", 7, &PassRTTI::getDomainProgramDesc, &PassRTTI::setDomainProgramDesc);
 			addReflectableField("mComputeProgramDesc", 8, &PassRTTI::getComputeProgramDesc, &PassRTTI::setComputeProgramDesc);
+
+			addDataBlockField("programs", 10, &PassRTTI::getPrograms, &PassRTTI::setPrograms, 0);
+			addPlainField("isCompute", 11, &PassRTTI::getIsCompute, &PassRTTI::setIsCompute);
 		}
 
 		void onSerializationStarted(IReflectable* obj, SerializationContext* context) override
 		{
 			Pass* pass = static_cast<Pass*>(obj);
-
-			mVertexProgramDesc = pass->mData.vertexProgramDesc;
-			mFragmentProgramDesc = pass->mData.fragmentProgramDesc;
-			mGeometryProgramDesc = pass->mData.geometryProgramDesc;
-			mHullProgramDesc = pass->mData.hullProgramDesc;
-			mDomainProgramDesc = pass->mData.domainProgramDesc;
-			mComputeProgramDesc = pass->mData.computeProgramDesc;
+			mIsCompute = pass->isCompute();
+
+			// Programs that were never decoded can be written out as is. Bytecode cannot have been generated for them
+			// since they were never compiled.
+			mEncodedPrograms = pass->mPrograms->getEncoded();
+			if(mEncodedPrograms)
+				return;
+
+			PASS_DESC desc;
+			desc.vertexProgramDesc = pass->getProgramDesc(GPT_VERTEX_PROGRAM);
+			desc.fragmentProgramDesc = pass->getProgramDesc(GPT_FRAGMENT_PROGRAM);
+			desc.geometryProgramDesc = pass->getProgramDesc(GPT_GEOMETRY_PROGRAM);
+			desc.hullProgramDesc = pass->getProgramDesc(GPT_HULL_PROGRAM);
+			desc.domainProgramDesc = pass->getProgramDesc(GPT_DOMAIN_PROGRAM);
+			desc.computeProgramDesc = pass->getProgramDesc(GPT_COMPUTE_PROGRAM);
 
 			auto initBytecode = [](const SPtr<GpuProgram>& prog, GPU_PROGRAM_DESC& desc)
 			{
@@ -182,21 +209,40 @@ namespace bs
 			const SPtr<GraphicsPipelineState>& graphicsPipeline = pass->getGraphicsPipelineState();
 			if(graphicsPipeline)
 			{
-				initBytecode(graphicsPipeline->getVertexProgram(), mVertexProgramDesc);
-				initBytecode(graphicsPipeline->getFragmentProgram(), mFragmentProgramDesc);
-				initBytecode(graphicsPipeline->getGeometryProgram(), mGeometryProgramDesc);
-				initBytecode(graphicsPipeline->getHullProgram(), mHullProgramDesc);
-				initBytecode(graphicsPipeline->getDomainProgram(), mDomainProgramDesc);
+				initBytecode(graphicsPipeline->getVertexProgram(), desc.vertexProgramDesc);
+				initBytecode(graphicsPipeline->getFragmentProgram(), desc.fragmentProgramDesc);
+				initBytecode(graphicsPipeline->getGeometryProgram(), desc.geometryProgramDesc);
+				initBytecode(graphicsPipeline->getHullProgram(), desc.hullProgramDesc);
+				initBytecode(graphicsPipeline->getDomainProgram(), desc.domainProgramDesc);
 			}
 			
 			const SPtr<ComputePipelineState>& computePipeline = pass->getComputePipelineState();
 			if(computePipeline)
-				initBytecode(computePipeline->getProgram(), mComputeProgramDesc);
+				initBytecode(computePipeline->getProgram(), desc.computeProgramDesc);
+
+			mEncodedPrograms = PassProgramData::encode(desc);
 		}
 
 		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
 		{
 			Pass* pass = static_cast<Pass*>(obj);
+
+			if(mEncodedPrograms)
+				pass->mPrograms = bs_shared_ptr_new<PassProgramData>(mEncodedPrograms, mIsCompute);
+			else
+			{
+				// Older data that stores the program descriptors directly
+				PASS_DESC desc;
+				desc.vertexProgramDesc = mVertexProgramDesc;
+				desc.fragmentProgramDesc = mFragmentProgramDesc;
+				desc.geometryProgramDesc = mGeometryProgramDesc;
+				desc.hullProgramDesc = mHullProgramDesc;
+				desc.domainProgramDesc = mDomainProgramDesc;
+				desc.computeProgramDesc = mComputeProgramDesc;
+
+				pass->mPrograms = bs_shared_ptr_new<PassProgramData>(desc);
+			}
+
 			pass->initialize();
 		}
 
@@ -223,6 +269,9 @@ namespace bs
 		SerializedGpuProgramData mHullProgramDesc;
 		SerializedGpuProgramData mDomainProgramDesc;
 		SerializedGpuProgramData mComputeProgramDesc;
+
+		SPtr<MemoryDataStream> mEncodedPrograms;
+		bool mIsCompute = false;
 	};
 
 	/** @} */
@@ -43,16 +43,16 @@ namespace bs
 		PixelFormat& getFormat(PixelData* obj) { return obj->mFormat; }
 		void setFormat(PixelData* obj, PixelFormat& val) { obj->mFormat = val; }
 
-		SPtr<DataStream> getData(PixelData* obj, UINT32& size)
+		SPtr<DataStream> getData(PixelData* obj, UINT64& size)
 		{
 			size = obj->getConsecutiveSize();
 
 			return bs_shared_ptr_new<MemoryDataStream>(obj->getData(), size, false);
 		}
 
-		void setData(PixelData* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setData(PixelData* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
-			obj->allocateInternalBuffer(size);
+			obj->allocateInternalBuffer((UINT32)size);
 			value->read(obj->getData(), size);
 		}
 		
@@ -302,6 +302,7 @@ namespace bs
 			BS_RTTI_MEMBER_REFL(shadowSettings, 17)
 			BS_RTTI_MEMBER_PLAIN(enableSkybox, 18)
 			BS_RTTI_MEMBER_REFL(bloom, 19)
+			BS_RTTI_MEMBER_PLAIN(enableTemporalAA, 20)
 		BS_END_RTTI_MEMBERS
 
 	public:
@@ -23,9 +23,32 @@ namespace bs
 			BS_RTTI_MEMBER_REFL(mMesh, 3)
 			BS_RTTI_MEMBER_PLAIN(mLayer, 4)
 			BS_RTTI_MEMBER_REFL_ARRAY(mMaterials, 5)
+			BS_RTTI_MEMBER_PLAIN(mLODScreenSizes, 6)
+			BS_RTTI_MEMBER_PLAIN(mDrawDistanceOrigin, 7)
+			BS_RTTI_MEMBER_PLAIN(mMinDrawDistance, 8)
+			BS_RTTI_MEMBER_PLAIN(mMaxDrawDistance, 9)
+			BS_RTTI_MEMBER_PLAIN(mCastsShadows, 10)
 		BS_END_RTTI_MEMBERS
 
+		HTexture& getTextureOverride(Renderable* obj, UINT32 idx) { return obj->mTextureOverrides[idx]; }
+
+		void setTextureOverride(Renderable* obj, UINT32 idx, HTexture& value)
+		{
+			if (idx < (UINT32)RenderableTexture::Count)
+				obj->mTextureOverrides[idx] = value;
+		}
+
+		UINT32 getNumTextureOverrides(Renderable* obj) { return (UINT32)RenderableTexture::Count; }
+		void setNumTextureOverrides(Renderable* obj, UINT32 size) { /* Do nothing */ }
+
 	public:
+		RenderableRTTI()
+		{
+			addReflectableArrayField("mTextureOverrides", 11, &RenderableRTTI::getTextureOverride,
+				&RenderableRTTI::getNumTextureOverrides, &RenderableRTTI::setTextureOverride,
+				&RenderableRTTI::setNumTextureOverrides);
+		}
+
 		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
 		{
 			// Note: Since this is a CoreObject I should call initialize() right after deserialization,
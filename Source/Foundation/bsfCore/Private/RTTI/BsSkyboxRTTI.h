@@ -22,6 +22,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mBrightness, 1)
 			BS_RTTI_MEMBER_REFLPTR(mFilteredRadiance, 2)
 			BS_RTTI_MEMBER_REFLPTR(mIrradiance, 3)
+			BS_RTTI_MEMBER_PLAIN(mAtmosphere, 4)
 		BS_END_RTTI_MEMBERS
 	public:
 		void onSerializationStarted(IReflectable* obj, SerializationContext* context) override
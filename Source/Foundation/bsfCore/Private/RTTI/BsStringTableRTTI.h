@@ -19,13 +19,29 @@ namespace bs
 		Language& getActiveLanguage(StringTable* obj) { return obj->mActiveLanguage; }
 		void setActiveLanguage(StringTable* obj, Language& val) { obj->mActiveLanguage = val; }
 
-		LanguageData& getLanguageData(StringTable* obj, UINT32 idx) { return obj->mAllLanguages[idx]; }
-		void setLanguageData(StringTable* obj, UINT32 idx, LanguageData& val) { obj->mAllLanguages[idx] = val; }
+		LanguageData& getLanguageData(StringTable* obj, UINT32 idx) { return mLanguageData[idx]; }
+		void setLanguageData(StringTable* obj, UINT32 idx, LanguageData& val)
+		{
+			Vector<SPtr<LocalizedStringData>>& strings = obj->mAllLanguages[idx].strings;
+			for (auto& entry : val.strings)
+			{
+				const UINT32 identifierIdx = obj->addIdentifier(entry.first);
+				if (identifierIdx >= (UINT32)strings.size())
+					strings.resize(identifierIdx + 1);
+
+				strings[identifierIdx] = entry.second;
+			}
+		}
+
 		UINT32 getNumLanguages(StringTable* obj) { return (UINT32)Language::Count; }
 		void setNumLanguages(StringTable* obj, UINT32 val) { /* Do nothing */ }
 
-		UnorderedSet<String>& getIdentifiers(StringTable* obj) { return obj->mIdentifiers; }
-		void setIdentifiers(StringTable* obj, UnorderedSet<String>& val) { obj->mIdentifiers = val; }
+		UnorderedSet<String>& getIdentifiers(StringTable* obj) { return mIdentifiers; }
+		void setIdentifiers(StringTable* obj, UnorderedSet<String>& val)
+		{
+			for (auto& entry : val)
+				obj->addIdentifier(entry);
+		}
 
 	public:
 		StringTableRTTI()
@@ -36,10 +52,27 @@ namespace bs
 			addPlainField("mIdentifiers", 2, &StringTableRTTI::getIdentifiers, &StringTableRTTI::setIdentifiers);
 		}
 
-		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
+		void onSerializationStarted(IReflectable* obj, SerializationContext* context) override
 		{
 			StringTable* stringTable = static_cast<StringTable*>(obj);
-			stringTable->setActiveLanguage(stringTable->mActiveLanguage);
+
+			// Strings are stored by identifier index at runtime, but serialized by identifier name
+			mLanguageData.resize((UINT32)Language::Count);
+			for (UINT32 i = 0; i < (UINT32)Language::Count; i++)
+			{
+				const Vector<SPtr<LocalizedStringData>>& strings = stringTable->mAllLanguages[i].strings;
+				for (UINT32 j = 0; j < (UINT32)strings.size(); j++)
+				{
+					if (strings[j] != nullptr)
+						mLanguageData[i].strings[stringTable->mIdentifiers[j].name] = strings[j];
+				}
+			}
+
+			for (auto& entry : stringTable->mIdentifiers)
+			{
+				if (entry.active)
+					mIdentifiers.insert(entry.name);
+			}
 		}
 
 		const String& getRTTIName() override
@@ -57,6 +90,10 @@ namespace bs
 		{
 			return StringTable::_createPtr();
 		}
+
+	private:
+		Vector<LanguageData> mLanguageData;
+		UnorderedSet<String> mIdentifiers;
 	};
 
 	/**
@@ -183,7 +220,7 @@ namespace bs
 			dataSize += rttiGetElemSize(data.numParameters);
 
 			for (UINT32 i = 0; i < data.numParameters; i++)
-				dataSize = rttiGetElemSize(data.parameterOffsets[i]);
+				dataSize += rttiGetElemSize(data.parameterOffsets[i]);
 
 			assert(dataSize <= std::numeric_limits<UINT32>::max());
 
@@ -10,6 +10,8 @@
 #include "RenderAPI/BsRenderAPI.h"
 #include "Managers/BsTextureManager.h"
 #include "Image/BsPixelData.h"
+#include "Managers/BsTextureStreamingManager.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -31,6 +33,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN_NAMED(numSamples, mProperties.mDesc.numSamples, 7)
 			BS_RTTI_MEMBER_PLAIN_NAMED(type, mProperties.mDesc.type, 9)
 			BS_RTTI_MEMBER_PLAIN_NAMED(format, mProperties.mDesc.format, 10)
+			BS_RTTI_MEMBER_PLAIN(mStreaming, 13)
 		BS_END_RTTI_MEMBERS
 
 		INT32& getUsage(Texture* obj) { return obj->mProperties.mDesc.usage; }
@@ -67,6 +70,10 @@ namespace bs
 
 		UINT32 getPixelDataArraySize(Texture* obj)
 		{
+			// Streamed textures store their pixel data in a single data block instead
+			if (isStreamable(obj))
+				return 0;
+
 			return obj->mProperties.getNumFaces() * (obj->mProperties.getNumMipmaps() + 1);
 		}
 
@@ -75,6 +82,68 @@ namespace bs
 			mPixelData.resize(size);
 		}
 
+		SPtr<DataStream> getSurfaceData(Texture* obj, UINT64& size)
+		{
+			if (!isStreamable(obj))
+			{
+				size = 0;
+				return bs_shared_ptr_new<MemoryDataStream>(nullptr, 0, false);
+			}
+
+			const TextureProperties& props = obj->mProperties;
+			const UINT32 numFaces = props.getNumFaces();
+			const UINT32 numMips = props.getNumMipmaps() + 1;
+
+			size = 0;
+			for (UINT32 i = 0; i < numMips; i++)
+			{
+				UINT32 width, height, depth;
+				PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), props.getDepth(), i,
+					width, height, depth);
+
+				size += PixelUtil::getMemorySize(width, height, depth, props.getFormat());
+			}
+
+			size *= numFaces;
+
+			// Surfaces are stored one after another, so they can be read individually when streaming
+			SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>((size_t)size);
+			for (UINT32 face = 0; face < numFaces; face++)
+			{
+				for (UINT32 mip = 0; mip < numMips; mip++)
+				{
+					SPtr<PixelData> pixelData;
+
+					// Mip levels of streamed textures might not be resident, so read them from the source
+					if (obj->mStreamingData != nullptr)
+						pixelData = obj->mStreamingData->readSurface(face, mip);
+					else
+					{
+						pixelData = props.allocBuffer(face, mip);
+
+						obj->readData(pixelData, face, mip);
+						gCoreThread().submitAll(true);
+					}
+
+					stream->write(pixelData->getData(), pixelData->getConsecutiveSize());
+				}
+			}
+
+			stream->seek(0);
+			return stream;
+		}
+
+		void setSurfaceData(Texture* obj, const SPtr<DataStream>& value, UINT64 size)
+		{
+			if (size == 0)
+				return;
+
+			// File streams are only valid until deserialization ends, so open a separate stream for later reads. Other
+			// streams (e.g. memory mapped files) are kept as they are.
+			mSurfaceDataOffset = value->tell();
+			mSurfaceData = value->isFile() ? value->clone() : value;
+		}
+
 	public:
 		TextureRTTI()
 		{
@@ -82,6 +151,7 @@ namespace bs
 
 			addReflectablePtrArrayField("mPixelData", 12, &TextureRTTI::getPixelData, &TextureRTTI::getPixelDataArraySize, 
 				&TextureRTTI::setPixelData, &TextureRTTI::setPixelDataArraySize, RTTI_Flag_SkipInReferenceSearch);
+			addDataBlockField("mSurfaceData", 14, &TextureRTTI::getSurfaceData, &TextureRTTI::setSurfaceData, 0);
 		}
 
 		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
@@ -95,6 +165,29 @@ namespace bs
 			PixelFormat validFormat = TextureManager::instance().getNativeFormat(
 				texProps.getTextureType(), texProps.getFormat(), texProps.getUsage(), texProps.isHardwareGammaEnabled());
 
+			if (mSurfaceData != nullptr)
+			{
+				texProps.mDesc.format = validFormat;
+				texture->mStreamingData = bs_shared_ptr_new<TextureStreamingData>(texProps.mDesc, mSurfaceData,
+					mSurfaceDataOffset, originalFormat);
+
+				texture->initialize();
+
+				// Only the least detailed mip levels are loaded initially, the rest are loaded by the streaming manager.
+				// Core texture only contains the resident mip levels, so its mip indices start at the resident one.
+				const UINT32 residentMip = texture->mStreamingData->residentMip;
+				for (UINT32 face = 0; face < texProps.getNumFaces(); face++)
+				{
+					for (UINT32 mip = residentMip; mip <= texProps.getNumMipmaps(); mip++)
+					{
+						SPtr<PixelData> pixelData = texture->mStreamingData->readSurface(face, mip);
+						texture->writeData(pixelData, face, mip - residentMip, false);
+					}
+				}
+
+				return;
+			}
+
 			if (originalFormat != validFormat)
 			{
 				texProps.mDesc.format = validFormat;
@@ -139,7 +232,16 @@ namespace bs
 		}
 
 	private:
+		/** Checks should the texture's pixel data be serialized in a form that allows its mip levels to be streamed. */
+		static bool isStreamable(Texture* obj)
+		{
+			const INT32 nonStreamableUsage = TU_CPUCACHED | TU_RENDERTARGET | TU_DEPTHSTENCIL | TU_LOADSTORE;
+			return obj->mStreaming && (obj->mProperties.getUsage() & nonStreamableUsage) == 0;
+		}
+
 		Vector<SPtr<PixelData>> mPixelData;
+		SPtr<DataStream> mSurfaceData;
+		size_t mSurfaceDataOffset = 0;
 	};
 
 	/** @} */
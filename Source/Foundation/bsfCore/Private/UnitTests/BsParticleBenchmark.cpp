@@ -0,0 +1,270 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsApplication.h"
+#include "BsEngineConfig.h"
+#include "Particles/BsParticleManager.h"
+#include "Particles/BsParticleSystem.h"
+#include "Particles/BsParticleEmitter.h"
+#include "Particles/BsParticleEvolver.h"
+#include "Animation/BsAnimationManager.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Utility/BsTime.h"
+#include <iostream>
+#include <iomanip>
+
+namespace bs
+{
+	/** Describes a standardized particle scene to benchmark. */
+	struct ParticleBenchmarkScene
+	{
+		/** Name to display in the results. */
+		const char* name;
+
+		/** Simulate on the GPU instead of the CPU. */
+		bool gpuSimulation = false;
+
+		/** Camera-independent sort mode to use. Distance sorting happens during rendering and is not measured here. */
+		ParticleSortMode sortMode = ParticleSortMode::None;
+
+		/** Creates the evolvers to attach to each particle system in the scene. */
+		std::function<Vector<SPtr<ParticleEvolver>>()> createEvolvers;
+	};
+
+	/** Controls the size of the benchmark. */
+	struct ParticleBenchmarkOptions
+	{
+		UINT32 numSystems = 16;
+		UINT32 numParticles = 10000;
+		UINT32 numWarmupFrames = 60;
+		UINT32 numFrames = 240;
+		float timeStep = 1.0f / 60.0f;
+	};
+
+	/** Time spent in each update stage, averaged over all measured frames. */
+	struct ParticleBenchmarkResult
+	{
+		double total = 0.0;
+		double simulation = 0.0;
+		double renderData = 0.0;
+		double bounds = 0.0;
+		double sorting = 0.0;
+		UINT32 numParticles = 0;
+	};
+
+	/** Base seed for the particle systems. Each system offsets it by its index so systems don't emit in lockstep. */
+	static constexpr UINT32 BENCHMARK_SEED = 0x9E3779B9;
+
+	/** Creates a particle system that reaches roughly @p numParticles live particles once warmed up. */
+	SPtr<ParticleSystem> createBenchmarkSystem(const ParticleBenchmarkScene& scene, const ParticleBenchmarkOptions& options,
+		UINT32 systemIdx)
+	{
+		static constexpr float LIFETIME = 1.0f;
+
+		ParticleSystemSettings settings;
+		settings.maxParticles = options.numParticles;
+		settings.gpuSimulation = scene.gpuSimulation;
+		settings.sortMode = scene.sortMode;
+		settings.useAutomaticSeed = false;
+		settings.manualSeed = BENCHMARK_SEED + systemIdx;
+
+		PARTICLE_SPHERE_SHAPE_DESC shapeDesc;
+		shapeDesc.radius = 1.0f;
+
+		SPtr<ParticleEmitter> emitter = ParticleEmitter::create();
+		emitter->setShape(ParticleEmitterSphereShape::create(shapeDesc));
+		emitter->setEmissionRate((float)options.numParticles / LIFETIME);
+		emitter->setInitialLifetime(LIFETIME);
+		emitter->setInitialSpeed(2.0f);
+
+		SPtr<ParticleSystem> system = ParticleSystem::create();
+		system->setSettings(settings);
+		system->setEmitters({ emitter });
+
+		if(scene.createEvolvers)
+			system->setEvolvers(scene.createEvolvers());
+
+		system->play();
+		return system;
+	}
+
+	/** Runs a single scene and returns the average per-frame stage timings, in microseconds. */
+	ParticleBenchmarkResult runBenchmarkScene(const ParticleBenchmarkScene& scene,
+		const ParticleBenchmarkOptions& options)
+	{
+		Vector<SPtr<ParticleSystem>> systems;
+		for(UINT32 i = 0; i < options.numSystems; i++)
+			systems.push_back(createBenchmarkSystem(scene, options, i));
+
+		// Particle systems are initialized on the core thread, wait until that is done
+		gCoreThread().submitAll(true);
+
+		EvaluatedAnimationData animData;
+		ParticleManager& particleManager = ParticleManager::instance();
+
+		for(UINT32 i = 0; i < options.numWarmupFrames; i++)
+			particleManager.update(animData, options.timeStep);
+
+		ParticleBenchmarkResult result;
+		for(UINT32 i = 0; i < options.numFrames; i++)
+		{
+			particleManager.update(animData, options.timeStep);
+
+			const ParticleUpdateTimings timings = particleManager.getUpdateTimings();
+			result.total += (double)timings.total;
+			result.simulation += (double)timings.simulation;
+			result.renderData += (double)timings.renderData;
+			result.bounds += (double)timings.bounds;
+			result.sorting += (double)timings.sorting;
+			result.numParticles = timings.numParticles;
+		}
+
+		const double invNumFrames = 1.0 / std::max(options.numFrames, 1U);
+		result.total *= invNumFrames;
+		result.simulation *= invNumFrames;
+		result.renderData *= invNumFrames;
+		result.bounds *= invNumFrames;
+		result.sorting *= invNumFrames;
+
+		for(auto& system : systems)
+			system->destroy();
+
+		gCoreThread().submitAll(true);
+		return result;
+	}
+
+	/** Returns the set of standardized scenes, covering each evolver type, sort mode and both simulation paths. */
+	Vector<ParticleBenchmarkScene> getBenchmarkScenes()
+	{
+		Vector<ParticleBenchmarkScene> scenes;
+
+		scenes.push_back({ "Baseline (CPU)", false, ParticleSortMode::None, nullptr });
+		scenes.push_back({ "Baseline (GPU)", true, ParticleSortMode::None, nullptr });
+
+		scenes.push_back({ "Velocity", false, ParticleSortMode::None, []()
+		{
+			PARTICLE_VELOCITY_DESC desc;
+			desc.velocity = Vector3Distribution(Vector3(-1.0f, 0.0f, -1.0f), Vector3(1.0f, 2.0f, 1.0f));
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleVelocity::create(desc) };
+		}});
+
+		scenes.push_back({ "Force", false, ParticleSortMode::None, []()
+		{
+			PARTICLE_FORCE_DESC desc;
+			desc.force = Vector3(1.0f, 0.0f, 0.5f);
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleForce::create(desc) };
+		}});
+
+		scenes.push_back({ "Gravity", false, ParticleSortMode::None, []()
+		{
+			return Vector<SPtr<ParticleEvolver>>{ ParticleGravity::create(PARTICLE_GRAVITY_DESC()) };
+		}});
+
+		scenes.push_back({ "Orbit", false, ParticleSortMode::None, []()
+		{
+			PARTICLE_ORBIT_DESC desc;
+			desc.radial = 0.5f;
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleOrbit::create(desc) };
+		}});
+
+		scenes.push_back({ "Color", false, ParticleSortMode::None, []()
+		{
+			PARTICLE_COLOR_DESC desc;
+			desc.color = ColorDistribution(ColorGradient({ ColorGradientKey(Color::White, 0.0f),
+				ColorGradientKey(Color::Red, 1.0f) }));
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleColor::create(desc) };
+		}});
+
+		scenes.push_back({ "Size", false, ParticleSortMode::None, []()
+		{
+			PARTICLE_SIZE_DESC desc;
+			desc.size = FloatDistribution(TAnimationCurve<float>({ { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } }));
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleSize::create(desc) };
+		}});
+
+		scenes.push_back({ "Rotation", false, ParticleSortMode::None, []()
+		{
+			PARTICLE_ROTATION_DESC desc;
+			desc.rotation = FloatDistribution(-180.0f, 180.0f);
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleRotation::create(desc) };
+		}});
+
+		scenes.push_back({ "Collisions (planes)", false, ParticleSortMode::None, []()
+		{
+			SPtr<ParticleCollisions> collisions = ParticleCollisions::create();
+			collisions->setPlanes({ Plane(Vector3::UNIT_Y, -0.5f), Plane(Vector3::UNIT_X, -0.5f) });
+
+			return Vector<SPtr<ParticleEvolver>>{ ParticleGravity::create(PARTICLE_GRAVITY_DESC()), collisions };
+		}});
+
+		scenes.push_back({ "Sort old to young", false, ParticleSortMode::OldToYoung, nullptr });
+		scenes.push_back({ "Sort young to old", false, ParticleSortMode::YoungToOld, nullptr });
+
+		return scenes;
+	}
+
+	/** Prints a single row of the results table. */
+	void printBenchmarkRow(const char* name, const ParticleBenchmarkResult& result)
+	{
+		std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << result.numParticles
+			<< std::setw(12) << result.total
+			<< std::setw(12) << result.simulation
+			<< std::setw(12) << result.renderData
+			<< std::setw(12) << result.bounds
+			<< std::setw(12) << result.sorting
+			<< std::endl;
+	}
+}
+
+using namespace bs;
+
+/**
+ * Runs ParticleManager::update() on a set of standardized scenes with fixed seeds and time steps, and reports the average
+ * time spent in each update stage. Accepts optional arguments: number of systems, particles per system and number of
+ * measured frames, in that order.
+ */
+int main(int argc, char* argv[])
+{
+	ParticleBenchmarkOptions options;
+	if(argc > 1) options.numSystems = (UINT32)std::max(atoi(argv[1]), 1);
+	if(argc > 2) options.numParticles = (UINT32)std::max(atoi(argv[2]), 1);
+	if(argc > 3) options.numFrames = (UINT32)std::max(atoi(argv[3]), 1);
+
+	START_UP_DESC desc;
+	desc.renderAPI = BS_RENDER_API_MODULE;
+	desc.renderer = BS_RENDERER_MODULE;
+	desc.audio = BS_AUDIO_MODULE;
+	desc.physics = BS_PHYSICS_MODULE;
+	desc.scripting = false;
+
+	desc.primaryWindowDesc.videoMode = VideoMode(64, 64);
+	desc.primaryWindowDesc.fullscreen = false;
+	desc.primaryWindowDesc.title = "bsf particle benchmark";
+	desc.primaryWindowDesc.hidden = true;
+
+	Application::startUp(desc);
+
+	std::cout << "Particle update benchmark: " << options.numSystems << " systems, " << options.numParticles
+		<< " particles each, " << options.numFrames << " frames. Times are in microseconds per frame." << std::endl;
+
+	std::cout << std::left << std::setw(24) << "Scene" << std::right
+		<< std::setw(12) << "Particles"
+		<< std::setw(12) << "Total"
+		<< std::setw(12) << "Simulation"
+		<< std::setw(12) << "RenderData"
+		<< std::setw(12) << "Bounds"
+		<< std::setw(12) << "Sorting"
+		<< std::endl;
+
+	for(auto& scene : getBenchmarkScenes())
+		printBenchmarkRow(scene.name, runBenchmarkScene(scene, options));
+
+	Application::shutDown();
+	return 0;
+}
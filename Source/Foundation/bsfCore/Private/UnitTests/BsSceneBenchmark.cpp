@@ -0,0 +1,583 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsApplication.h"
+#include "BsEngineConfig.h"
+#include "Scene/BsSceneObject.h"
+#include "Components/BsCCamera.h"
+#include "Components/BsCRenderable.h"
+#include "Components/BsCLight.h"
+#include "Components/BsCDecal.h"
+#include "Components/BsCParticleSystem.h"
+#include "Components/BsCAnimation.h"
+#include "Resources/BsBuiltinResources.h"
+#include "Material/BsMaterial.h"
+#include "Mesh/BsMesh.h"
+#include "Renderer/BsRendererMeshData.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsAnimationClip.h"
+#include "Particles/BsParticleEmitter.h"
+#include "Profiling/BsProfilingManager.h"
+#include "Profiling/BsProfilerGPU.h"
+#include "Profiling/BsFrameTelemetry.h"
+#include "Math/BsRandom.h"
+#include <iostream>
+#include <iomanip>
+
+namespace bs
+{
+	/** Controls the contents and the length of the benchmark. */
+	struct SceneBenchmarkOptions
+	{
+		UINT32 numRenderables = 4096;
+		UINT32 numLights = 128;
+		UINT32 numShadowedLights = 8;
+		UINT32 numParticleSystems = 16;
+		UINT32 numDecals = 64;
+		UINT32 numCharacters = 32;
+		UINT32 numWarmupFrames = 60;
+		UINT32 numFrames = 600;
+		UINT32 width = 1280;
+		UINT32 height = 720;
+	};
+
+	/** Seed used for placing the scene objects, so every run renders the same scene. */
+	static constexpr UINT32 BENCHMARK_SEED = 0x9E3779B9;
+
+	/** Distance between two neighbouring renderables on the placement grid. */
+	static constexpr float GRID_SPACING = 4.0f;
+
+	/** Application that notifies the benchmark at the start of every frame. */
+	class SceneBenchmarkApplication : public Application
+	{
+	public:
+		SceneBenchmarkApplication(const START_UP_DESC& desc)
+			:Application(desc)
+		{ }
+
+		/** Triggered at the start of every frame on the sim thread, before the scene is updated. */
+		std::function<void()> onPreUpdate;
+
+	protected:
+		/** @copydoc Application::preUpdate */
+		void preUpdate() override
+		{
+			Application::preUpdate();
+
+			if(onPreUpdate)
+				onPreUpdate();
+		}
+	};
+
+	/**
+	 * Builds a synthetic scene, flies the camera along a fixed path and collects the time spent in each rendering stage
+	 * on the core thread (as reported by ProfilerCPU) and on the GPU (as reported by ProfilerGPU).
+	 */
+	class SceneBenchmark
+	{
+	public:
+		SceneBenchmark(const SceneBenchmarkOptions& options)
+			:mOptions(options)
+		{ }
+
+		/** Creates all the scene objects to render. */
+		void buildScene();
+
+		/** Called at the start of every frame. Moves the camera and records the timings of the previous frame. */
+		void update();
+
+		/** Prints the collected timings to stdout. */
+		void printResults() const;
+
+	private:
+		/** Returns the half-size of the area the scene objects are placed in. */
+		float getSceneExtent() const;
+
+		/** Creates a mesh with a two bone skeleton, bending in the middle. */
+		HMesh createCharacterMesh() const;
+
+		/** Creates an animation clip that bends the character mesh back and forth. */
+		HAnimationClip createCharacterClip() const;
+
+		/** Moves the camera to its position on the path, at @p t in range [0, 1]. */
+		void updateCamera(float t);
+
+		/** Adds the self time of every sample in the provided CPU profiler entry and its children to mCPUStages. */
+		void addCPUSamples(const CPUProfilerBasicSamplingEntry& entry);
+
+		/** Adds the time of the provided GPU profiler sample and its children to mGPUStages. */
+		void addGPUSamples(const GPUProfileSample& sample);
+
+		SceneBenchmarkOptions mOptions;
+		UINT32 mFrameIdx = 0;
+		HSceneObject mCameraSO;
+
+		Map<String, double> mCPUStages;
+		Map<String, double> mGPUStages;
+		UINT32 mNumCPUFrames = 0;
+		UINT32 mNumGPUFrames = 0;
+	};
+
+	float SceneBenchmark::getSceneExtent() const
+	{
+		const UINT32 gridSize = (UINT32)std::ceil(std::sqrt((float)std::max(mOptions.numRenderables, 1U)));
+		return gridSize * GRID_SPACING * 0.5f;
+	}
+
+	void SceneBenchmark::buildScene()
+	{
+		Random random(BENCHMARK_SEED);
+
+		const float extent = getSceneExtent();
+		const auto randomPosition = [&random, extent](float height)
+		{
+			return Vector3(random.getSNorm() * extent, height, random.getSNorm() * extent);
+		};
+
+		BuiltinResources& builtinResources = BuiltinResources::instance();
+		HMaterial standardMaterial = Material::create(builtinResources.getBuiltinShader(BuiltinShader::Standard));
+
+		// Camera
+		mCameraSO = SceneObject::create("Camera");
+		HCamera camera = mCameraSO->addComponent<CCamera>();
+		camera->setMain(true);
+		updateCamera(0.0f);
+
+		// Renderables, placed on a grid
+		const HMesh meshes[] =
+		{
+			builtinResources.getMesh(BuiltinMesh::Box),
+			builtinResources.getMesh(BuiltinMesh::Sphere),
+			builtinResources.getMesh(BuiltinMesh::Cylinder),
+			builtinResources.getMesh(BuiltinMesh::Cone)
+		};
+
+		const UINT32 gridSize = (UINT32)std::ceil(std::sqrt((float)std::max(mOptions.numRenderables, 1U)));
+		for(UINT32 i = 0; i < mOptions.numRenderables; i++)
+		{
+			const float x = (i % gridSize) * GRID_SPACING - extent;
+			const float z = (i / gridSize) * GRID_SPACING - extent;
+			const float scale = 0.5f + random.getUNorm() * 1.5f;
+
+			HSceneObject so = SceneObject::create("Renderable");
+			so->setPosition(Vector3(x, scale * 0.5f, z));
+			so->setScale(Vector3::ONE * scale);
+
+			HRenderable renderable = so->addComponent<CRenderable>();
+			renderable->setMesh(meshes[i % (sizeof(meshes) / sizeof(meshes[0]))]);
+			renderable->setMaterial(standardMaterial);
+		}
+
+		// Directional light, always casting shadows
+		{
+			HSceneObject so = SceneObject::create("Sun");
+			so->setPosition(Vector3(0.0f, 100.0f, 0.0f));
+			so->lookAt(Vector3(30.0f, 0.0f, 20.0f));
+
+			HLight light = so->addComponent<CLight>();
+			light->setType(LightType::Directional);
+			light->setCastsShadow(true);
+		}
+
+		// Radial lights, none of them casting shadows
+		for(UINT32 i = 0; i < mOptions.numLights; i++)
+		{
+			HSceneObject so = SceneObject::create("Radial light");
+			so->setPosition(randomPosition(2.0f + random.getUNorm() * 4.0f));
+
+			HLight light = so->addComponent<CLight>();
+			light->setType(LightType::Radial);
+			light->setColor(Color(0.5f + random.getUNorm() * 0.5f, 0.5f + random.getUNorm() * 0.5f, 1.0f));
+			light->setIntensity(500.0f);
+		}
+
+		// Spot lights casting shadows
+		for(UINT32 i = 0; i < mOptions.numShadowedLights; i++)
+		{
+			const Vector3 position = randomPosition(10.0f);
+
+			HSceneObject so = SceneObject::create("Spot light");
+			so->setPosition(position);
+			so->lookAt(Vector3(position.x, 0.0f, position.z), Vector3::UNIT_Z);
+
+			HLight light = so->addComponent<CLight>();
+			light->setType(LightType::Spot);
+			light->setSpotAngle(Degree(60.0f));
+			light->setIntensity(5000.0f);
+			light->setCastsShadow(true);
+		}
+
+		// Particle systems
+		HMaterial particleMaterial = Material::create(builtinResources.getBuiltinShader(BuiltinShader::ParticlesUnlit));
+		for(UINT32 i = 0; i < mOptions.numParticleSystems; i++)
+		{
+			static constexpr UINT32 NUM_PARTICLES = 2000;
+			static constexpr float LIFETIME = 2.0f;
+
+			ParticleSystemSettings settings;
+			settings.material = particleMaterial;
+			settings.maxParticles = NUM_PARTICLES;
+			settings.useAutomaticSeed = false;
+			settings.manualSeed = BENCHMARK_SEED + i;
+
+			PARTICLE_SPHERE_SHAPE_DESC shapeDesc;
+			shapeDesc.radius = 0.5f;
+
+			SPtr<ParticleEmitter> emitter = ParticleEmitter::create();
+			emitter->setShape(ParticleEmitterSphereShape::create(shapeDesc));
+			emitter->setEmissionRate((float)NUM_PARTICLES / LIFETIME);
+			emitter->setInitialLifetime(LIFETIME);
+			emitter->setInitialSpeed(1.0f);
+			emitter->setInitialSize(0.1f);
+
+			HSceneObject so = SceneObject::create("Particle system");
+			so->setPosition(randomPosition(3.0f));
+
+			HParticleSystem particleSystem = so->addComponent<CParticleSystem>();
+			particleSystem->setSettings(settings);
+			particleSystem->setEmitters({ emitter });
+		}
+
+		// Decals, projecting downwards onto the renderables
+		HMaterial decalMaterial = Material::create(builtinResources.getBuiltinShader(BuiltinShader::Decal));
+		for(UINT32 i = 0; i < mOptions.numDecals; i++)
+		{
+			const Vector3 position = randomPosition(3.0f);
+
+			HSceneObject so = SceneObject::create("Decal");
+			so->setPosition(position);
+			so->lookAt(Vector3(position.x, 0.0f, position.z), Vector3::UNIT_Z);
+
+			HDecal decal = so->addComponent<CDecal>();
+			decal->setMaterial(decalMaterial);
+			decal->setSize(Vector2(3.0f, 3.0f));
+			decal->setMaxDistance(5.0f);
+		}
+
+		// Skinned characters
+		if(mOptions.numCharacters > 0)
+		{
+			HMesh characterMesh = createCharacterMesh();
+			HAnimationClip characterClip = createCharacterClip();
+
+			for(UINT32 i = 0; i < mOptions.numCharacters; i++)
+			{
+				HSceneObject so = SceneObject::create("Character");
+				so->setPosition(randomPosition(0.0f));
+
+				HRenderable renderable = so->addComponent<CRenderable>();
+				renderable->setMesh(characterMesh);
+				renderable->setMaterial(standardMaterial);
+
+				HAnimation animation = so->addComponent<CAnimation>();
+				animation->setWrapMode(AnimWrapMode::Loop);
+				animation->play(characterClip);
+			}
+		}
+	}
+
+	HMesh SceneBenchmark::createCharacterMesh() const
+	{
+		static constexpr UINT32 NUM_RINGS = 9;
+		static constexpr UINT32 VERTICES_PER_RING = 8;
+		static constexpr float HEIGHT = 2.0f;
+		static constexpr float RADIUS = 0.3f;
+
+		const UINT32 numVertices = NUM_RINGS * VERTICES_PER_RING;
+		const UINT32 numIndices = (NUM_RINGS - 1) * VERTICES_PER_RING * 6;
+
+		Vector<Vector3> positions(numVertices);
+		Vector<Vector3> normals(numVertices);
+		Vector<Vector4> tangents(numVertices);
+		Vector<Vector2> uvs(numVertices);
+		Vector<BoneWeight> boneWeights(numVertices);
+		Vector<UINT32> indices;
+		indices.reserve(numIndices);
+
+		for(UINT32 ring = 0; ring < NUM_RINGS; ring++)
+		{
+			const float v = ring / (float)(NUM_RINGS - 1);
+			const float y = v * HEIGHT;
+
+			// Lower half follows the root bone, upper half the second bone, blended in between
+			const float upperWeight = Math::clamp01((v - 0.25f) * 2.0f);
+
+			for(UINT32 i = 0; i < VERTICES_PER_RING; i++)
+			{
+				const float u = i / (float)VERTICES_PER_RING;
+				const float angle = u * Math::TWO_PI;
+				const float cos = std::cos(angle);
+				const float sin = std::sin(angle);
+
+				const UINT32 idx = ring * VERTICES_PER_RING + i;
+				positions[idx] = Vector3(cos * RADIUS, y, sin * RADIUS);
+				normals[idx] = Vector3(cos, 0.0f, sin);
+				tangents[idx] = Vector4(-sin, 0.0f, cos, 1.0f);
+				uvs[idx] = Vector2(u, v);
+
+				BoneWeight& weight = boneWeights[idx];
+				weight.index0 = 0;
+				weight.index1 = 1;
+				weight.index2 = 0;
+				weight.index3 = 0;
+				weight.weight0 = 1.0f - upperWeight;
+				weight.weight1 = upperWeight;
+				weight.weight2 = 0.0f;
+				weight.weight3 = 0.0f;
+			}
+		}
+
+		for(UINT32 ring = 0; ring < NUM_RINGS - 1; ring++)
+		{
+			for(UINT32 i = 0; i < VERTICES_PER_RING; i++)
+			{
+				const UINT32 a = ring * VERTICES_PER_RING + i;
+				const UINT32 b = ring * VERTICES_PER_RING + (i + 1) % VERTICES_PER_RING;
+				const UINT32 c = a + VERTICES_PER_RING;
+				const UINT32 d = b + VERTICES_PER_RING;
+
+				indices.insert(indices.end(), { a, c, b, b, c, d });
+			}
+		}
+
+		const VertexLayout layout = (VertexLayout)((UINT32)VertexLayout::PNTU | (UINT32)VertexLayout::BoneWeights);
+		SPtr<RendererMeshData> meshData = RendererMeshData::create(numVertices, numIndices, layout);
+		meshData->setPositions(positions.data(), numVertices * sizeof(Vector3));
+		meshData->setNormals(normals.data(), numVertices * sizeof(Vector3));
+		meshData->setTangents(tangents.data(), numVertices * sizeof(Vector4));
+		meshData->setUV0(uvs.data(), numVertices * sizeof(Vector2));
+		meshData->setBoneWeights(boneWeights.data(), numVertices * sizeof(BoneWeight));
+		meshData->setIndices(indices.data(), numIndices * sizeof(UINT32));
+
+		BONE_DESC bones[2];
+		bones[0].name = "Root";
+		bones[0].parent = (UINT32)-1;
+		bones[0].localTfrm = Transform(Vector3::ZERO, Quaternion::IDENTITY, Vector3::ONE);
+		bones[0].invBindPose = Matrix4::IDENTITY;
+
+		bones[1].name = "Upper";
+		bones[1].parent = 0;
+		bones[1].localTfrm = Transform(Vector3(0.0f, HEIGHT * 0.5f, 0.0f), Quaternion::IDENTITY, Vector3::ONE);
+		bones[1].invBindPose = Matrix4::translation(Vector3(0.0f, -HEIGHT * 0.5f, 0.0f));
+
+		MESH_DESC desc;
+		desc.subMeshes.push_back(SubMesh(0, numIndices, DOT_TRIANGLE_LIST));
+		desc.skeleton = Skeleton::create(bones, 2);
+
+		return Mesh::create(meshData->getData(), desc);
+	}
+
+	HAnimationClip SceneBenchmark::createCharacterClip() const
+	{
+		const Quaternion bent(Vector3::UNIT_Z, Degree(45.0f));
+		TAnimationCurve<Quaternion> curve({
+			{ Quaternion::IDENTITY, Quaternion::ZERO, Quaternion::ZERO, 0.0f },
+			{ bent, Quaternion::ZERO, Quaternion::ZERO, 0.5f },
+			{ Quaternion::IDENTITY, Quaternion::ZERO, Quaternion::ZERO, 1.0f }
+		});
+
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		curves->addRotationCurve("Upper", curve);
+
+		return AnimationClip::create(curves);
+	}
+
+	void SceneBenchmark::updateCamera(float t)
+	{
+		// A full orbit around the scene, bobbing up and down twice along the way
+		const float extent = getSceneExtent();
+		const float angle = t * Math::TWO_PI;
+		const float radius = extent * 0.75f;
+		const float height = 10.0f + extent * 0.1f * (1.0f + std::sin(angle * 2.0f));
+
+		mCameraSO->setPosition(Vector3(std::cos(angle) * radius, height, std::sin(angle) * radius));
+		const float targetRadius = radius * 0.5f;
+		mCameraSO->lookAt(Vector3(std::cos(angle + 0.5f) * targetRadius, 0.0f, std::sin(angle + 0.5f) * targetRadius));
+	}
+
+	void SceneBenchmark::update()
+	{
+		const UINT32 frameIdx = mFrameIdx++;
+
+		// Keep the camera still during warmup, so shadow maps and pooled resources settle before measuring
+		if(frameIdx < mOptions.numWarmupFrames)
+		{
+			updateCamera(0.0f);
+
+			// Discard any GPU reports from warmup
+			while(gProfilerGPU().getNumAvailableReports() > 0)
+				gProfilerGPU().getNextReport();
+
+			return;
+		}
+
+		// Record the previous frame
+		if(frameIdx > mOptions.numWarmupFrames)
+		{
+			const ProfilerReport& report = ProfilingManager::instance().getReport(ProfiledThread::Core);
+			addCPUSamples(report.cpuReport.getBasicSamplingData());
+			mNumCPUFrames++;
+
+			while(gProfilerGPU().getNumAvailableReports() > 0)
+			{
+				addGPUSamples(gProfilerGPU().getNextReport().frameSample);
+				mNumGPUFrames++;
+			}
+		}
+
+		const UINT32 measuredFrameIdx = frameIdx - mOptions.numWarmupFrames;
+		if(measuredFrameIdx >= mOptions.numFrames)
+		{
+			gApplication().stopMainLoop();
+			return;
+		}
+
+		updateCamera(measuredFrameIdx / (float)mOptions.numFrames);
+	}
+
+	void SceneBenchmark::addCPUSamples(const CPUProfilerBasicSamplingEntry& entry)
+	{
+		for(auto& child : entry.childEntries)
+		{
+			mCPUStages[child.data.name] += child.data.totalTimeMs;
+			addCPUSamples(child);
+		}
+	}
+
+	void SceneBenchmark::addGPUSamples(const GPUProfileSample& sample)
+	{
+		mGPUStages[sample.name] += sample.timeMs;
+
+		for(auto& child : sample.children)
+			addGPUSamples(child);
+	}
+
+	/** Prints the average time of each stage, sorted from the slowest to the fastest. */
+	void printStages(const char* title, const Map<String, double>& stages, UINT32 numFrames)
+	{
+		std::cout << std::endl << title << " (" << numFrames << " frames, average ms per frame)" << std::endl;
+		if(numFrames == 0)
+			return;
+
+		Vector<std::pair<String, double>> sorted(stages.begin(), stages.end());
+		std::sort(sorted.begin(), sorted.end(),
+			[](const std::pair<String, double>& a, const std::pair<String, double>& b) { return a.second > b.second; });
+
+		for(auto& entry : sorted)
+		{
+			std::cout << "  " << std::left << std::setw(48) << entry.first << std::right << std::fixed
+				<< std::setprecision(3) << std::setw(10) << entry.second / numFrames << std::endl;
+		}
+	}
+
+	/** Prints a single row of the frame telemetry table. */
+	void printPercentiles(const char* name, const FrameTelemetryPercentiles& percentiles)
+	{
+		std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3)
+			<< std::setw(10) << percentiles.average
+			<< std::setw(10) << percentiles.p50
+			<< std::setw(10) << percentiles.p95
+			<< std::setw(10) << percentiles.p99
+			<< std::setw(10) << percentiles.max
+			<< std::endl;
+	}
+
+	void SceneBenchmark::printResults() const
+	{
+		const FrameTelemetryStats stats = gFrameTelemetry().getStats(mOptions.numFrames);
+
+		std::cout << std::endl << "Frame times (" << stats.numFrames << " frames, ms)" << std::endl;
+		std::cout << "  " << std::left << std::setw(16) << "" << std::right
+			<< std::setw(10) << "Average"
+			<< std::setw(10) << "p50"
+			<< std::setw(10) << "p95"
+			<< std::setw(10) << "p99"
+			<< std::setw(10) << "Max"
+			<< std::endl;
+
+		printPercentiles("Frame", stats.frameTimeMs);
+		printPercentiles("Sim thread", stats.simThreadMs);
+		printPercentiles("Core thread", stats.coreThreadMs);
+		printPercentiles("GPU", stats.gpuTimeMs);
+
+#if BS_PROFILING_ENABLED
+		printStages("Core thread CPU stages", mCPUStages, mNumCPUFrames);
+		printStages("GPU stages", mGPUStages, mNumGPUFrames);
+#else
+		std::cout << std::endl << "Per-stage timings require a build with profiling enabled." << std::endl;
+#endif
+	}
+}
+
+using namespace bs;
+
+/**
+ * Renders a synthetic scene while flying the camera along a fixed path, and reports frame time percentiles along with
+ * the time spent in each rendering stage on the core thread and on the GPU. The scene is placed using a fixed seed and
+ * the camera path only depends on the frame index, so every run renders the same frames. Accepted arguments, each
+ * followed by a count: --renderables, --lights, --shadowed-lights, --particles, --decals, --characters, --warmup,
+ * --frames, --width and --height.
+ */
+int main(int argc, char* argv[])
+{
+	SceneBenchmarkOptions options;
+
+	const std::pair<const char*, UINT32*> arguments[] =
+	{
+		{ "--renderables", &options.numRenderables },
+		{ "--lights", &options.numLights },
+		{ "--shadowed-lights", &options.numShadowedLights },
+		{ "--particles", &options.numParticleSystems },
+		{ "--decals", &options.numDecals },
+		{ "--characters", &options.numCharacters },
+		{ "--warmup", &options.numWarmupFrames },
+		{ "--frames", &options.numFrames },
+		{ "--width", &options.width },
+		{ "--height", &options.height }
+	};
+
+	for(int i = 1; i < argc - 1; i += 2)
+	{
+		for(auto& entry : arguments)
+		{
+			if(strcmp(argv[i], entry.first) == 0)
+				*entry.second = (UINT32)std::max(atoi(argv[i + 1]), 0);
+		}
+	}
+
+	options.numFrames = std::max(options.numFrames, 1U);
+
+	START_UP_DESC desc;
+	desc.renderAPI = BS_RENDER_API_MODULE;
+	desc.renderer = BS_RENDERER_MODULE;
+	desc.audio = BS_AUDIO_MODULE;
+	desc.physics = BS_PHYSICS_MODULE;
+	desc.scripting = false;
+
+	desc.primaryWindowDesc.videoMode = VideoMode(std::max(options.width, 1U), std::max(options.height, 1U));
+	desc.primaryWindowDesc.fullscreen = false;
+	desc.primaryWindowDesc.vsync = false;
+	desc.primaryWindowDesc.title = "bsf scene benchmark";
+
+	Application::startUp<SceneBenchmarkApplication>(desc);
+
+	// Measure how fast frames can be rendered, not the frame limiter
+	gApplication().setFPSLimit(0);
+
+	std::cout << "Scene benchmark: " << options.numRenderables << " renderables, " << options.numLights << " lights, "
+		<< options.numShadowedLights << " shadowed lights, " << options.numParticleSystems << " particle systems, "
+		<< options.numDecals << " decals, " << options.numCharacters << " characters, " << options.numFrames
+		<< " frames at " << options.width << "x" << options.height << "." << std::endl;
+
+	SceneBenchmark benchmark(options);
+	benchmark.buildScene();
+
+	auto& app = static_cast<SceneBenchmarkApplication&>(gApplication());
+	app.onPreUpdate = [&benchmark]() { benchmark.update(); };
+	app.runMainLoop();
+	app.onPreUpdate = nullptr;
+
+	benchmark.printResults();
+
+	Application::shutDown();
+	return 0;
+}
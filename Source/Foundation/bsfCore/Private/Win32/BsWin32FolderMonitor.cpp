@@ -324,6 +324,7 @@ namespace bs
 	FolderMonitor::~FolderMonitor()
 	{
 		stopMonitorAll();
+		waitForBatch();
 
 		// No need for mutex since we know worker thread is shut down by now
 		while(!m->mFileActions.empty())
@@ -660,25 +661,23 @@ namespace bs
 			switch (action->type)
 			{
 			case FileActionType::Added:
-				if (!onAdded.empty())
-					onAdded(Path(action->newName));
+				queueChange(FolderChangeType::Added, Path(action->newName));
 				break;
 			case FileActionType::Removed:
-				if (!onRemoved.empty())
-					onRemoved(Path(action->newName));
+				queueChange(FolderChangeType::Removed, Path(action->newName));
 				break;
 			case FileActionType::Modified:
-				if (!onModified.empty())
-					onModified(Path(action->newName));
+				queueChange(FolderChangeType::Modified, Path(action->newName));
 				break;
 			case FileActionType::Renamed:
-				if (!onRenamed.empty())
-					onRenamed(Path(action->oldName), Path(action->newName));
+				queueChange(FolderChangeType::Renamed, Path(action->newName), Path(action->oldName));
 				break;
 			}
 
 			m->mActiveFileActions.erase(iter++);
 			FileAction::destroy(action);
 		}
+
+		dispatchChanges();
 	}
 }
@@ -13,6 +13,10 @@
 #include <shellapi.h>
 #include "String/BsUnicode.h"
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace bs
 {
 	/** Encapsulate native cursor data so we can avoid including windows.h as it pollutes the global namespace. */
@@ -317,6 +321,45 @@ namespace bs
 		Sleep((DWORD)duration);
 	}
 
+	void Platform::sleepPrecise(UINT64 duration)
+	{
+		// Waitable timer owned by a single thread, created on first use
+		struct ThreadTimer
+		{
+			ThreadTimer()
+			{
+				// High resolution timers are only supported on Windows 10 1803 and later, fall back to a regular one
+				handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+					TIMER_ALL_ACCESS);
+
+				if(!handle)
+					handle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+			}
+
+			~ThreadTimer()
+			{
+				if(handle)
+					CloseHandle(handle);
+			}
+
+			HANDLE handle;
+		};
+
+		static thread_local ThreadTimer timer;
+
+		// Negative due time is relative, in 100 nanosecond units
+		LARGE_INTEGER dueTime;
+		dueTime.QuadPart = -(LONGLONG)(duration * 10);
+
+		if(!timer.handle || !SetWaitableTimer(timer.handle, &dueTime, 0, nullptr, nullptr, FALSE))
+		{
+			Sleep((DWORD)(duration / 1000));
+			return;
+		}
+
+		WaitForSingleObject(timer.handle, INFINITE);
+	}
+
 	void Win32Platform::registerDropTarget(DropTarget* target)
 	{
 		const RenderWindow* window = target->_getOwnerWindow();
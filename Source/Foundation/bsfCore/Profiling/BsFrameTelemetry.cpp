@@ -0,0 +1,197 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Profiling/BsFrameTelemetry.h"
+#include "Profiling/BsProfilerTimeline.h"
+#include "Utility/BsTime.h"
+#include "FileSystem/BsFileSystem.h"
+
+namespace bs
+{
+	namespace
+	{
+		/** Calculates percentiles of the provided values. Values are reordered in the process. */
+		FrameTelemetryPercentiles calculatePercentiles(ProfilerVector<float>& values)
+		{
+			FrameTelemetryPercentiles output;
+			if(values.empty())
+				return output;
+
+			float sum = 0.0f;
+			for(auto& entry : values)
+				sum += entry;
+
+			output.average = sum / (float)values.size();
+
+			// Nearest rank, calculated in ascending order so every nth_element only needs to partition the upper part
+			const auto findPercentile = [&values](UINT32 percentile, size_t first)
+			{
+				const size_t rank = (values.size() * percentile + 99) / 100;
+				const size_t idx = std::max(first, rank > 0 ? rank - 1 : 0);
+
+				std::nth_element(values.begin() + first, values.begin() + idx, values.end());
+				return idx;
+			};
+
+			const size_t p50 = findPercentile(50, 0);
+			output.p50 = values[p50];
+
+			const size_t p95 = findPercentile(95, p50);
+			output.p95 = values[p95];
+
+			const size_t p99 = findPercentile(99, p95);
+			output.p99 = values[p99];
+
+			output.max = *std::max_element(values.begin() + p99, values.end());
+			return output;
+		}
+	}
+
+	FrameTelemetry::FrameTelemetry()
+	{
+		mFrames.resize(HISTORY_SIZE);
+	}
+
+	const FrameTelemetrySample& FrameTelemetry::getFrame(UINT32 idx) const
+	{
+		assert(idx < mNumFrames);
+
+		return mFrames[(mNextFrameIdx + HISTORY_SIZE - 1 - idx) % HISTORY_SIZE];
+	}
+
+	GPUProfileSample FrameTelemetry::getLastGPUFrame() const
+	{
+		Lock lock(mCoreMutex);
+		return mLastGPUFrame;
+	}
+
+	FrameTelemetryStats FrameTelemetry::getStats(UINT32 numFrames) const
+	{
+		FrameTelemetryStats output;
+		output.numFrames = std::min(numFrames, mNumFrames);
+
+		ProfilerVector<float> values(output.numFrames);
+		const auto calculate = [this, &values](float FrameTelemetrySample::* counter)
+		{
+			for(UINT32 i = 0; i < (UINT32)values.size(); i++)
+				values[i] = getFrame(i).*counter;
+
+			return calculatePercentiles(values);
+		};
+
+		output.frameTimeMs = calculate(&FrameTelemetrySample::frameTimeMs);
+		output.simThreadMs = calculate(&FrameTelemetrySample::simThreadMs);
+		output.coreThreadMs = calculate(&FrameTelemetrySample::coreThreadMs);
+		output.gpuTimeMs = calculate(&FrameTelemetrySample::gpuTimeMs);
+
+		return output;
+	}
+
+	void FrameTelemetry::_beginSimFrame()
+	{
+		mSimTimer.reset();
+		mSimWaitUs = 0;
+	}
+
+	void FrameTelemetry::_addSimWaitTime(UINT64 timeUs)
+	{
+		mSimWaitUs += timeUs;
+	}
+
+	void FrameTelemetry::_endSimFrame()
+	{
+		const UINT64 simTimeUs = mSimTimer.getMicroseconds();
+
+		FrameTelemetrySample& frame = mFrames[mNextFrameIdx];
+		frame.frameIdx = gTime().getFrameIdx();
+		frame.frameTimeMs = gTime().getFrameDelta() * 1000.0f;
+		frame.simThreadMs = (simTimeUs - std::min(mSimWaitUs, simTimeUs)) / 1000.0f;
+		frame.simWaitMs = mSimWaitUs / 1000.0f;
+
+		{
+			Lock lock(mCoreMutex);
+			frame.coreThreadMs = mCoreThreadMs;
+			frame.gpuTimeMs = mGPUTimeMs;
+			frame.numDrawCalls = mNumDrawCalls;
+			frame.numComputeCalls = mNumComputeCalls;
+			frame.numPipelineStateChanges = mNumPipelineStateChanges;
+			frame.numBytesUploaded = mNumBytesUploaded;
+			frame.numBytesDownloaded = mNumBytesDownloaded;
+		}
+
+		frame.memoryBytes = 0;
+		if(MemoryTags::isEnabled())
+		{
+			for(UINT32 i = 0; i < (UINT32)MemoryTag::Count; i++)
+				frame.memoryBytes += MemoryTags::getStats((MemoryTag)i).bytes;
+		}
+
+		mNextFrameIdx = (mNextFrameIdx + 1) % HISTORY_SIZE;
+		mNumFrames = std::min(mNumFrames + 1, HISTORY_SIZE);
+
+		detectHitch(frame);
+	}
+
+	void FrameTelemetry::_beginCoreFrame()
+	{
+		mCoreTimer.reset();
+		mCoreStartStats = RenderStats::instance().getData();
+	}
+
+	void FrameTelemetry::_endCoreFrame()
+	{
+		const float coreThreadMs = mCoreTimer.getMicroseconds() / 1000.0f;
+		const RenderStatsData& stats = RenderStats::instance().getData();
+
+		Lock lock(mCoreMutex);
+		mCoreThreadMs = coreThreadMs;
+		mNumDrawCalls = (UINT32)(stats.numDrawCalls - mCoreStartStats.numDrawCalls);
+		mNumComputeCalls = (UINT32)(stats.numComputeCalls - mCoreStartStats.numComputeCalls);
+		mNumPipelineStateChanges = (UINT32)(stats.numPipelineStateChanges - mCoreStartStats.numPipelineStateChanges);
+		mNumBytesUploaded = stats.numBytesUploaded - mCoreStartStats.numBytesUploaded;
+		mNumBytesDownloaded = stats.numBytesDownloaded - mCoreStartStats.numBytesDownloaded;
+	}
+
+	void FrameTelemetry::_addGPUFrame(const GPUProfileSample& frame)
+	{
+		Lock lock(mCoreMutex);
+		mGPUTimeMs = frame.timeMs;
+		mLastGPUFrame = frame;
+	}
+
+	void FrameTelemetry::detectHitch(const FrameTelemetrySample& frame)
+	{
+		// The first frame includes start-up, so it would always be reported
+		if(mHitchThresholdMs <= 0.0f || frame.frameTimeMs <= mHitchThresholdMs || mNumFrames <= 1)
+			return;
+
+		if(mHitches.size() >= MAX_HITCHES)
+			mHitches.erase(mHitches.begin());
+
+		mHitches.push_back(FrameTelemetryHitch());
+		FrameTelemetryHitch& hitch = mHitches.back();
+		hitch.frame = frame;
+		hitch.gpuFrame = getLastGPUFrame();
+
+		const UINT32 numFrames = std::min(mHitchHistory, mNumFrames);
+		hitch.history.reserve(numFrames);
+		for(UINT32 i = numFrames; i > 0; i--)
+			hitch.history.push_back(getFrame(i - 1));
+
+		if(!mHitchTraceFolder.isEmpty() && ProfilerTimeline::isStarted() && gProfilerTimeline().isEnabled())
+		{
+			if(!FileSystem::exists(mHitchTraceFolder))
+				FileSystem::createDir(mHitchTraceFolder);
+
+			const Path tracePath = mHitchTraceFolder + Path("Hitch_" + toString(frame.frameIdx) + ".json");
+			if(gProfilerTimeline().exportChromeTrace(tracePath))
+				hitch.tracePath = tracePath;
+		}
+
+		onHitch(hitch);
+	}
+
+	FrameTelemetry& gFrameTelemetry()
+	{
+		return FrameTelemetry::instance();
+	}
+}
@@ -0,0 +1,244 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Utility/BsTimer.h"
+#include "FileSystem/BsPath.h"
+#include "Profiling/BsRenderStats.h"
+#include "Profiling/BsProfilerGPU.h"
+
+namespace bs
+{
+	/** @addtogroup Profiling
+	 *  @{
+	 */
+
+	/** Counters recorded by FrameTelemetry for a single frame. */
+	struct FrameTelemetrySample
+	{
+		/** Index of the frame on the sim thread. */
+		UINT64 frameIdx = 0;
+
+		/** Time between the start of this and the previous frame, in milliseconds. */
+		float frameTimeMs = 0.0f;
+
+		/** Time the sim thread spent working on the frame, excluding the time spent waiting on the core thread. */
+		float simThreadMs = 0.0f;
+
+		/** Time the sim thread spent waiting for the core thread to finish the previous frame, in milliseconds. */
+		float simWaitMs = 0.0f;
+
+		/** Time the core thread spent working on the most recently finished core frame, in milliseconds. */
+		float coreThreadMs = 0.0f;
+
+		/** GPU time of the most recently resolved GPU frame, in milliseconds. Lags a few frames behind the CPU. */
+		float gpuTimeMs = 0.0f;
+
+		/** Number of draw calls issued by the most recently finished core frame. */
+		UINT32 numDrawCalls = 0;
+
+		/** Number of compute dispatches issued by the most recently finished core frame. */
+		UINT32 numComputeCalls = 0;
+
+		/** Number of pipeline state changes made by the most recently finished core frame. */
+		UINT32 numPipelineStateChanges = 0;
+
+		/** Number of bytes uploaded to GPU resources by the most recently finished core frame. */
+		UINT64 numBytesUploaded = 0;
+
+		/** Number of bytes downloaded from GPU resources by the most recently finished core frame. */
+		UINT64 numBytesDownloaded = 0;
+
+		/** Memory allocated by all memory tags. Zero unless the framework is built with memory tags. */
+		UINT64 memoryBytes = 0;
+	};
+
+	/** Percentiles of a single counter over a range of frames. */
+	struct FrameTelemetryPercentiles
+	{
+		float p50 = 0.0f;
+		float p95 = 0.0f;
+		float p99 = 0.0f;
+		float max = 0.0f;
+		float average = 0.0f;
+	};
+
+	/** Statistics of the frame timings recorded by FrameTelemetry, over a range of frames. */
+	struct FrameTelemetryStats
+	{
+		/** Number of frames the statistics were calculated from. */
+		UINT32 numFrames = 0;
+
+		FrameTelemetryPercentiles frameTimeMs;
+		FrameTelemetryPercentiles simThreadMs;
+		FrameTelemetryPercentiles coreThreadMs;
+		FrameTelemetryPercentiles gpuTimeMs;
+	};
+
+	/** Information about a frame that took longer than the hitch threshold. */
+	struct FrameTelemetryHitch
+	{
+		/** Sample of the frame that triggered the hitch. */
+		FrameTelemetrySample frame;
+
+		/** Samples of the frames preceding the hitch, ordered from oldest to newest, ending with @p frame. */
+		Vector<FrameTelemetrySample> history;
+
+		/**
+		 * Most recently resolved GPU frame at the time of the hitch, with a sample for every compositor node and shadow
+		 * map. GPU frames are resolved a few frames late, so this is usually a frame preceding the hitch.
+		 */
+		GPUProfileSample gpuFrame{};
+
+		/** Chrome trace written for the hitch, or an empty path if none was written. */
+		Path tracePath;
+	};
+
+	/**
+	 * Records a small set of counters every frame (frame time, sim and core thread time, GPU time, render statistics
+	 * and memory usage), keeping a history of recent frames from which percentile statistics can be calculated. Unlike
+	 * the other profilers it is always enabled, including in builds without BS_PROFILING_ENABLED, and is cheap enough
+	 * to keep running in shipping builds.
+	 *
+	 * Frames taking longer than the hitch threshold are reported as hitches, along with the counters of the frames
+	 * leading up to them. If a trace folder is set and ProfilerTimeline is recording, the timeline is also exported for
+	 * every hitch.
+	 *
+	 * @note	Sim thread only unless specified otherwise.
+	 */
+	class BS_CORE_EXPORT FrameTelemetry : public Module<FrameTelemetry>
+	{
+	public:
+		/** Maximum number of frames kept in the history. */
+		static constexpr UINT32 HISTORY_SIZE = 1024;
+
+		/** Maximum number of hitches kept, older hitches are discarded. */
+		static constexpr UINT32 MAX_HITCHES = 8;
+
+		FrameTelemetry();
+
+		/** Returns the counters of a recent frame, where 0 is the latest frame. Must be less than getNumFrames(). */
+		const FrameTelemetrySample& getFrame(UINT32 idx = 0) const;
+
+		/** Returns the number of frames in the history. */
+		UINT32 getNumFrames() const { return mNumFrames; }
+
+		/**
+		 * Returns the most recently resolved GPU frame, containing the GPU time of every compositor node and shadow map
+		 * (as long as the framework is built with profiling enabled).
+		 *
+		 * @note	Thread safe.
+		 */
+		GPUProfileSample getLastGPUFrame() const;
+
+		/** Calculates statistics over the last @p numFrames frames. Clamped to the number of frames in the history. */
+		FrameTelemetryStats getStats(UINT32 numFrames = 120) const;
+
+		/**
+		 * Sets the frame time, in milliseconds, above which a frame is reported as a hitch. Zero disables hitch
+		 * detection.
+		 */
+		void setHitchThreshold(float thresholdMs) { mHitchThresholdMs = thresholdMs; }
+
+		/** @copydoc setHitchThreshold */
+		float getHitchThreshold() const { return mHitchThresholdMs; }
+
+		/** Sets the number of frames of history that are stored with each hitch. */
+		void setHitchHistory(UINT32 numFrames) { mHitchHistory = std::min(std::max(numFrames, 1U), HISTORY_SIZE); }
+
+		/** @copydoc setHitchHistory */
+		UINT32 getHitchHistory() const { return mHitchHistory; }
+
+		/**
+		 * Sets a folder in which a Chrome trace is written for every hitch, as long as ProfilerTimeline is recording.
+		 * An empty path disables writing of the traces.
+		 */
+		void setHitchTraceFolder(const Path& folder) { mHitchTraceFolder = folder; }
+
+		/** @copydoc setHitchTraceFolder */
+		const Path& getHitchTraceFolder() const { return mHitchTraceFolder; }
+
+		/** Returns the most recent hitches, ordered from oldest to newest. */
+		const Vector<FrameTelemetryHitch>& getHitches() const { return mHitches; }
+
+		/** Discards all recorded hitches. */
+		void clearHitches() { mHitches.clear(); }
+
+		/** Triggered whenever a hitch is detected. */
+		Event<void(const FrameTelemetryHitch&)> onHitch;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Signals the start of a new frame on the sim thread. */
+		void _beginSimFrame();
+
+		/** Signals that the sim thread waited for the core thread for the provided number of microseconds. */
+		void _addSimWaitTime(UINT64 timeUs);
+
+		/** Signals the end of a frame on the sim thread, recording its counters. */
+		void _endSimFrame();
+
+		/**
+		 * Signals the start of a new frame on the core thread.
+		 *
+		 * @note	Core thread only.
+		 */
+		void _beginCoreFrame();
+
+		/**
+		 * Signals the end of a frame on the core thread.
+		 *
+		 * @note	Core thread only.
+		 */
+		void _endCoreFrame();
+
+		/**
+		 * Records a resolved GPU frame, as reported by ProfilerGPU.
+		 *
+		 * @note	Core thread only.
+		 */
+		void _addGPUFrame(const GPUProfileSample& frame);
+
+		/** @} */
+
+	private:
+		/** Detects if the latest frame is a hitch, and records it if so. */
+		void detectHitch(const FrameTelemetrySample& frame);
+
+		ProfilerVector<FrameTelemetrySample> mFrames;
+		UINT32 mNextFrameIdx = 0;
+		UINT32 mNumFrames = 0;
+
+		Timer mSimTimer;
+		UINT64 mSimWaitUs = 0;
+
+		float mHitchThresholdMs = 100.0f;
+		UINT32 mHitchHistory = 60;
+		Path mHitchTraceFolder;
+		Vector<FrameTelemetryHitch> mHitches;
+
+		// Core thread only
+		Timer mCoreTimer;
+		RenderStatsData mCoreStartStats;
+
+		// Written by the core thread, read by the sim thread
+		mutable Mutex mCoreMutex;
+		float mCoreThreadMs = 0.0f;
+		float mGPUTimeMs = 0.0f;
+		GPUProfileSample mLastGPUFrame{};
+		UINT32 mNumDrawCalls = 0;
+		UINT32 mNumComputeCalls = 0;
+		UINT32 mNumPipelineStateChanges = 0;
+		UINT64 mNumBytesUploaded = 0;
+		UINT64 mNumBytesDownloaded = 0;
+	};
+
+	/** Provides global access to FrameTelemetry instance. */
+	BS_CORE_EXPORT FrameTelemetry& gFrameTelemetry();
+
+	/** @} */
+}
@@ -1,6 +1,9 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilerCPU.h"
+#include "Profiling/BsProfilerTimeline.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Particles/BsParticleManager.h"
 #include "Debug/BsDebug.h"
 #include "Platform/BsPlatform.h"
 #include <chrono>
@@ -310,6 +313,9 @@ namespace bs
 		}
 
 		thread->begin(name);
+
+		if(ProfilerTimeline::isStarted())
+			gProfilerTimeline()._beginThread(name);
 	}
 
 	void ProfilerCPU::endThread()
@@ -347,6 +353,9 @@ namespace bs
 		thread->activeBlocks->push(thread->activeBlock);
 
 		block->basic.beginSample();
+
+		if(ProfilerTimeline::isStarted())
+			gProfilerTimeline()._beginSample(name);
 	}
 
 	void ProfilerCPU::endSample(const char* name)
@@ -377,6 +386,9 @@ namespace bs
 
 		block->basic.endSample();
 
+		if(ProfilerTimeline::isStarted())
+			gProfilerTimeline()._endSample(name);
+
 		thread->activeBlocks->pop();
 
 		if (!thread->activeBlocks->empty())
@@ -414,6 +426,9 @@ namespace bs
 		thread->activeBlocks->push(thread->activeBlock);
 
 		block->precise.beginSample();
+
+		if(ProfilerTimeline::isStarted())
+			gProfilerTimeline()._beginSample(name);
 	}
 
 	void ProfilerCPU::endSamplePrecise(const char* name)
@@ -444,6 +459,9 @@ namespace bs
 
 		block->precise.endSample();
 
+		if(ProfilerTimeline::isStarted())
+			gProfilerTimeline()._endSample(name);
+
 		thread->activeBlocks->pop();
 
 		if (!thread->activeBlocks->empty())
@@ -464,6 +482,19 @@ namespace bs
 	{
 		CPUProfilerReport report;
 
+		if(CoreThread::isStarted())
+			report.mCoreThreadQueueStats = CoreThread::instance().getQueueStats();
+
+		report.mFrameArenaStats = FrameArena::getStats();
+
+		if(ParticleManager::isStarted())
+			*report.mParticleMemoryStats = ParticleManager::instance().getMemoryStats();
+
+		if(LockProfiler::isEnabled())
+			report.mLockStats = LockProfiler::getStats();
+
+		report.mScriptGCStats = ScriptGCProfiler::getStats();
+
 		ThreadInfo* thread = ThreadInfo::activeThread;
 		if(thread == nullptr)
 			return report;
@@ -1012,10 +1043,18 @@ namespace bs
 	{ }
 
 	CPUProfilerReport::CPUProfilerReport()
+		:mParticleMemoryStats(bs_shared_ptr_new<ParticleMemoryStats>())
 	{
 
 	}
 
+	CPUProfilerReport::CPUProfilerReport(const CPUProfilerReport& other) = default;
+	CPUProfilerReport::CPUProfilerReport(CPUProfilerReport&& other) = default;
+	CPUProfilerReport::~CPUProfilerReport() = default;
+
+	CPUProfilerReport& CPUProfilerReport::operator=(const CPUProfilerReport& other) = default;
+	CPUProfilerReport& CPUProfilerReport::operator=(CPUProfilerReport&& other) = default;
+
 	ProfilerCPU& gProfilerCPU()
 	{
 		return ProfilerCPU::instance();
@@ -4,6 +4,9 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Allocators/BsFrameArena.h"
+#include "Threading/BsProfiledMutex.h"
+#include "Profiling/BsScriptGCProfiler.h"
 
 namespace bs
 {
@@ -12,6 +15,8 @@ namespace bs
 	 */
 
 	class CPUProfilerReport;
+	struct CoreThreadQueueStats;
+	struct ParticleMemoryStats;
 
 	/**
 	 * Provides various performance measuring methods.
@@ -390,6 +395,12 @@ namespace bs
 	{
 	public:
 		CPUProfilerReport();
+		CPUProfilerReport(const CPUProfilerReport& other);
+		CPUProfilerReport(CPUProfilerReport&& other);
+		~CPUProfilerReport();
+
+		CPUProfilerReport& operator=(const CPUProfilerReport& other);
+		CPUProfilerReport& operator=(CPUProfilerReport&& other);
 
 		/**
 		 * Returns root entry for the basic (time based) sampling data. Root entry always contains the profiling block 
@@ -403,11 +414,43 @@ namespace bs
 		 */
 		const CPUProfilerPreciseSamplingEntry& getPreciseSamplingData() const { return mPreciseSamplingRootEntry; }
 
+		/** 
+		 * Returns the number of commands queued and executed on the core thread, for every thread that queued at least
+		 * one command. Counters are totals since the thread first queued a command.
+		 */
+		const Vector<CoreThreadQueueStats>& getCoreThreadQueueStats() const { return mCoreThreadQueueStats; }
+
+		/** Returns memory usage of the frame arena at the time the report was generated. */
+		const FrameArenaStats& getFrameArenaStats() const { return mFrameArenaStats; }
+
+		/** Returns memory used by particle buffers, for each particle system, at the time the report was generated. */
+		const ParticleMemoryStats& getParticleMemoryStats() const { return *mParticleMemoryStats; }
+
+		/**
+		 * Returns wait, hold and contention statistics of engine mutexes, ordered by total wait time. Counters are
+		 * totals since the application started, or since LockProfiler::reset(). Empty unless the framework is built
+		 * with BS_LOCK_PROFILING.
+		 */
+		const Vector<LockProfileStats>& getLockStats() const { return mLockStats; }
+
+		/**
+		 * Returns garbage collection pause statistics of the scripting runtime. Counters are totals since the
+		 * application started, or since ScriptGCProfiler::reset().
+		 */
+		const ScriptGCStats& getScriptGCStats() const { return mScriptGCStats; }
+
 	private:
 		friend class ProfilerCPU;
 
 		CPUProfilerBasicSamplingEntry mBasicSamplingRootEntry;
 		CPUProfilerPreciseSamplingEntry mPreciseSamplingRootEntry;
+		// Core thread and particle types are only forward declared, so copying and destroying the report is done in the
+		// source file. Particle statistics never change once the report is generated, so copies share them.
+		Vector<CoreThreadQueueStats> mCoreThreadQueueStats;
+		FrameArenaStats mFrameArenaStats;
+		SPtr<ParticleMemoryStats> mParticleMemoryStats;
+		Vector<LockProfileStats> mLockStats;
+		ScriptGCStats mScriptGCStats;
 	};
 
 	/** Provides global access to ProfilerCPU instance. */
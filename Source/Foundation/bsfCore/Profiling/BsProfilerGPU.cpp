@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Profiling/BsProfilerGPU.h"
 #include "Profiling/BsRenderStats.h"
+#include "Profiling/BsProfilerTimeline.h"
+#include "Profiling/BsFrameTelemetry.h"
 #include "RenderAPI/BsTimerQuery.h"
 #include "RenderAPI/BsOcclusionQuery.h"
 #include "Error/BsException.h"
@@ -39,6 +41,7 @@ namespace bs
 
 		mFrameSample = ProfiledSample();
 		mFrameSample.name = "Frame";
+		mFrameSample.submitTime = ProfilerTimeline::_getTimestamp();
 		beginSampleInternal(mFrameSample, true);
 
 		mIsFrameActive = true;
@@ -141,6 +144,12 @@ namespace bs
 				GPUProfilerReport report;
 				resolveSample(frameSample, report.frameSample);
 
+				if(ProfilerTimeline::isStarted())
+					gProfilerTimeline()._addGPUFrame(report.frameSample, frameSample.submitTime);
+
+				if(FrameTelemetry::isStarted())
+					gFrameTelemetry()._addGPUFrame(report.frameSample);
+
 				freeSample(frameSample);
 				mUnresolvedFrames.pop();
 
@@ -198,12 +207,31 @@ namespace bs
 		reportSample.numVertexBufferBinds = (UINT32)(sample.endStats.numVertexBufferBinds - sample.startStats.numVertexBufferBinds);
 		reportSample.numIndexBufferBinds = (UINT32)(sample.endStats.numIndexBufferBinds - sample.startStats.numIndexBufferBinds);
 
+		reportSample.numStateChanges = (UINT32)(sample.endStats.numStateChanges - sample.startStats.numStateChanges);
+		reportSample.numRedundantStateChanges =
+			(UINT32)(sample.endStats.numRedundantStateChanges - sample.startStats.numRedundantStateChanges);
+
 		reportSample.numResourceWrites = (UINT32)(sample.endStats.numResourceWrites - sample.startStats.numResourceWrites);
 		reportSample.numResourceReads = (UINT32)(sample.endStats.numResourceReads - sample.startStats.numResourceReads);
 
 		reportSample.numObjectsCreated = (UINT32)(sample.endStats.numObjectsCreated - sample.startStats.numObjectsCreated);
 		reportSample.numObjectsDestroyed = (UINT32)(sample.endStats.numObjectsDestroyed - sample.startStats.numObjectsDestroyed);
 
+		reportSample.numBytesUploaded = sample.endStats.numBytesUploaded - sample.startStats.numBytesUploaded;
+		reportSample.numBytesDownloaded = sample.endStats.numBytesDownloaded - sample.startStats.numBytesDownloaded;
+
+		for(UINT32 i = 0; i < (UINT32)RenderStatResourceCategory::Count; i++)
+		{
+			const RenderStatsResourceData& start = sample.startStats.resources[i];
+			const RenderStatsResourceData& end = sample.endStats.resources[i];
+
+			RenderStatsResourceData& output = reportSample.resources[i];
+			output.numCreated = end.numCreated - start.numCreated;
+			output.numDestroyed = end.numDestroyed - start.numDestroyed;
+			output.numReads = end.numReads - start.numReads;
+			output.numWrites = end.numWrites - start.numWrites;
+		}
+
 		for(auto& entry : sample.children)
 		{
 			reportSample.children.push_back(GPUProfileSample());
@@ -34,12 +34,21 @@ namespace bs
 		UINT32 numVertexBufferBinds; /**< How many times was a vertex buffer bound. */
 		UINT32 numIndexBufferBinds; /**< How many times was an index buffer bound. */
 
+		UINT32 numStateChanges; /**< How many times was an individual piece of render API state changed. */
+		UINT32 numRedundantStateChanges; /**< How many state changes were skipped as the state was already set. */
+
 		UINT32 numResourceWrites; /**< How many times were GPU resources written to. */
 		UINT32 numResourceReads; /**< How many times were GPU resources read from. */
 
 		UINT32 numObjectsCreated; /**< How many GPU objects were created. */
 		UINT32 numObjectsDestroyed; /**< How many GPU objects were destroyed. */
 
+		UINT64 numBytesUploaded; /**< How many bytes were written to GPU resources from the CPU. */
+		UINT64 numBytesDownloaded; /**< How many bytes were read from GPU resources to the CPU. */
+
+		/** GPU resources created, destroyed, read and written, for each RenderStatResourceCategory. */
+		RenderStatsResourceData resources[(UINT32)RenderStatResourceCategory::Count];
+
 		Vector<GPUProfileSample> children;
 	};
 
@@ -64,6 +73,7 @@ namespace bs
 			RenderStatsData endStats;
 			SPtr<ct::TimerQuery> activeTimeQuery;
 			SPtr<ct::OcclusionQuery> activeOcclusionQuery;
+			UINT64 submitTime = 0;
 
 			Vector<ProfiledSample*> children;
 		};
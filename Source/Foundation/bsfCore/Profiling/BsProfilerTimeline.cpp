@@ -0,0 +1,357 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Profiling/BsProfilerTimeline.h"
+#include "Profiling/BsProfilerGPU.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include <chrono>
+#include <cinttypes>
+
+namespace bs
+{
+	/** Ring buffer of events recorded by a single thread. */
+	struct ProfilerTimeline::ThreadTimeline
+	{
+		/** Maximum length of a name, including the null terminator. Longer names are truncated. */
+		static constexpr UINT32 NAME_LENGTH = 55;
+
+		struct Event
+		{
+			UINT64 timestamp;
+			EventType type;
+			char name[NAME_LENGTH];
+		};
+
+		static_assert(sizeof(Event) == 64, "Unexpected event size.");
+
+		char name[NAME_LENGTH];
+		UINT32 id;
+
+		Event events[EVENTS_PER_THREAD];
+
+		/** Total number of events recorded. Only written by the owning thread. */
+		std::atomic<UINT64> numEvents;
+
+		/** Events recorded before this index are ignored during export. Set by clear(). */
+		std::atomic<UINT64> firstEvent;
+	};
+
+	namespace
+	{
+		/** Copies a name into a fixed size buffer, truncating it if needed. */
+		void copyName(char* dst, const char* src, UINT32 length)
+		{
+			UINT32 i = 0;
+			for(; i < length - 1 && src[i] != '\0'; i++)
+				dst[i] = src[i];
+
+			dst[i] = '\0';
+		}
+
+		/** Writes a string as a JSON string literal, escaping any characters not allowed in JSON strings. */
+		void writeJSONString(StringStream& stream, const char* str)
+		{
+			stream << '"';
+			for(const char* iter = str; *iter != '\0'; ++iter)
+			{
+				const char ch = *iter;
+				if(ch == '"' || ch == '\\')
+					stream << '\\' << ch;
+				else if((UINT8)ch < 0x20)
+				{
+					char escaped[8];
+					snprintf(escaped, sizeof(escaped), "\\u%04x", (UINT32)(UINT8)ch);
+					stream << escaped;
+				}
+				else
+					stream << ch;
+			}
+			stream << '"';
+		}
+
+		/** Writes a timestamp in nanoseconds, relative to @p base, as microseconds expected by the trace format. */
+		void writeTimestamp(StringStream& stream, UINT64 timestamp, UINT64 base)
+		{
+			const UINT64 relative = timestamp > base ? timestamp - base : 0;
+
+			char output[32];
+			snprintf(output, sizeof(output), "%" PRIu64 ".%03u", relative / 1000, (UINT32)(relative % 1000));
+			stream << output;
+		}
+
+		/**
+		 * Incremented whenever a ProfilerTimeline is created, so that timelines cached by threads for a previous
+		 * instance aren't reused.
+		 */
+		std::atomic<UINT32> sGeneration{0};
+
+		BS_THREADLOCAL void* sThreadTimeline = nullptr;
+		BS_THREADLOCAL UINT32 sThreadTimelineGeneration = 0;
+	}
+
+	ProfilerTimeline::ProfilerTimeline()
+		:mEnabled(false)
+	{
+		sGeneration++;
+	}
+
+	ProfilerTimeline::~ProfilerTimeline()
+	{
+		Lock lock(mMutex);
+
+		for(auto& entry : mTimelines)
+			bs_delete<ThreadTimeline, ProfilerAlloc>(entry);
+	}
+
+	void ProfilerTimeline::setEnabled(bool enabled)
+	{
+		mEnabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void ProfilerTimeline::clear()
+	{
+		Lock lock(mMutex);
+
+		for(auto& entry : mTimelines)
+			entry->firstEvent.store(entry->numEvents.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+
+	void ProfilerTimeline::_beginThread(const char* name)
+	{
+		if(!isEnabled())
+			return;
+
+		ThreadTimeline& timeline = getThreadTimeline();
+		if(strncmp(timeline.name, name, ThreadTimeline::NAME_LENGTH - 1) != 0)
+		{
+			Lock lock(mMutex);
+			copyName(timeline.name, name, ThreadTimeline::NAME_LENGTH);
+		}
+
+		record(timeline, EventType::Frame, name, _getTimestamp());
+	}
+
+	void ProfilerTimeline::_beginSample(const char* name)
+	{
+		if(!isEnabled())
+			return;
+
+		record(getThreadTimeline(), EventType::Begin, name, _getTimestamp());
+	}
+
+	void ProfilerTimeline::_endSample(const char* name)
+	{
+		if(!isEnabled())
+			return;
+
+		record(getThreadTimeline(), EventType::End, name, _getTimestamp());
+	}
+
+	void ProfilerTimeline::_addGPUFrame(const GPUProfileSample& frame, UINT64 submitTime)
+	{
+		if(!isEnabled())
+			return;
+
+		if(mGPUTimeline == nullptr)
+			mGPUTimeline = createTimeline("GPU");
+
+		const UINT64 start = std::max(submitTime, mLastGPUFrameEnd);
+		record(*mGPUTimeline, EventType::Frame, frame.name.c_str(), start);
+
+		mLastGPUFrameEnd = addGPUSample(frame, start);
+	}
+
+	UINT64 ProfilerTimeline::addGPUSample(const GPUProfileSample& sample, UINT64 start)
+	{
+		record(*mGPUTimeline, EventType::Begin, sample.name.c_str(), start);
+
+		UINT64 childStart = start;
+		for(auto& child : sample.children)
+			childStart = addGPUSample(child, childStart);
+
+		const UINT64 end = std::max(start + (UINT64)(sample.timeMs * 1000000.0), childStart);
+		record(*mGPUTimeline, EventType::End, sample.name.c_str(), end);
+
+		return end;
+	}
+
+	UINT64 ProfilerTimeline::_getTimestamp()
+	{
+		using namespace std::chrono;
+		return (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	void ProfilerTimeline::record(ThreadTimeline& timeline, EventType type, const char* name, UINT64 timestamp)
+	{
+		const UINT64 idx = timeline.numEvents.load(std::memory_order_relaxed);
+
+		ThreadTimeline::Event& event = timeline.events[idx % EVENTS_PER_THREAD];
+		event.timestamp = timestamp;
+		event.type = type;
+		copyName(event.name, name, ThreadTimeline::NAME_LENGTH);
+
+		timeline.numEvents.store(idx + 1, std::memory_order_release);
+	}
+
+	ProfilerTimeline::ThreadTimeline& ProfilerTimeline::getThreadTimeline()
+	{
+		const UINT32 generation = sGeneration.load(std::memory_order_relaxed);
+		if(sThreadTimeline == nullptr || sThreadTimelineGeneration != generation)
+		{
+			sThreadTimeline = createTimeline("Unknown");
+			sThreadTimelineGeneration = generation;
+		}
+
+		return *(ThreadTimeline*)sThreadTimeline;
+	}
+
+	ProfilerTimeline::ThreadTimeline* ProfilerTimeline::createTimeline(const char* name)
+	{
+		auto timeline = bs_new<ThreadTimeline, ProfilerAlloc>();
+		copyName(timeline->name, name, ThreadTimeline::NAME_LENGTH);
+		timeline->numEvents = 0;
+		timeline->firstEvent = 0;
+
+		Lock lock(mMutex);
+		timeline->id = mNextTimelineId++;
+		mTimelines.push_back(timeline);
+
+		return timeline;
+	}
+
+	bool ProfilerTimeline::exportChromeTrace(const Path& path) const
+	{
+		using Event = ThreadTimeline::Event;
+
+		struct ExportedTimeline
+		{
+			const ThreadTimeline* timeline;
+			ProfilerVector<Event> events;
+			char name[ThreadTimeline::NAME_LENGTH];
+		};
+
+		// Copy out the events first, so the threads can keep recording while the output is being generated
+		ProfilerVector<ExportedTimeline> timelines;
+		{
+			Lock lock(mMutex);
+
+			timelines.resize(mTimelines.size());
+			for(UINT32 i = 0; i < (UINT32)mTimelines.size(); i++)
+			{
+				const ThreadTimeline* timeline = mTimelines[i];
+				ExportedTimeline& exported = timelines[i];
+				exported.timeline = timeline;
+				memcpy(exported.name, timeline->name, sizeof(exported.name));
+
+				const UINT64 end = timeline->numEvents.load(std::memory_order_acquire);
+				UINT64 start = timeline->firstEvent.load(std::memory_order_relaxed);
+				if(end - start > EVENTS_PER_THREAD)
+					start = end - EVENTS_PER_THREAD;
+
+				exported.events.reserve((size_t)(end - start));
+				for(UINT64 j = start; j < end; j++)
+					exported.events.push_back(timeline->events[j % EVENTS_PER_THREAD]);
+
+				// Events at the start of the range might have been overwritten by the owning thread while copying
+				std::atomic_thread_fence(std::memory_order_acquire);
+				const UINT64 newEnd = timeline->numEvents.load(std::memory_order_relaxed);
+				if(newEnd - start > EVENTS_PER_THREAD)
+				{
+					const UINT64 numOverwritten = std::min(newEnd - start - EVENTS_PER_THREAD, end - start);
+					exported.events.erase(exported.events.begin(), exported.events.begin() + (size_t)numOverwritten);
+				}
+			}
+		}
+
+		UINT64 base = std::numeric_limits<UINT64>::max();
+		for(auto& entry : timelines)
+		{
+			if(!entry.events.empty())
+				base = std::min(base, entry.events[0].timestamp);
+		}
+
+		StringStream output;
+		output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool first = true;
+		auto beginEvent = [&output, &first](const char* name, const char* phase, UINT32 tid)
+		{
+			if(!first)
+				output << ",\n";
+
+			first = false;
+
+			output << "{\"name\":";
+			writeJSONString(output, name);
+			output << ",\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << tid;
+		};
+
+		for(auto& entry : timelines)
+		{
+			const UINT32 tid = entry.timeline->id;
+
+			beginEvent("thread_name", "M", tid);
+			output << ",\"args\":{\"name\":";
+			writeJSONString(output, entry.name);
+			output << "}}";
+
+			// Keep the GPU and the main threads sorted before the workers
+			beginEvent("thread_sort_index", "M", tid);
+			output << ",\"args\":{\"sort_index\":" << tid << "}}";
+
+			UINT32 depth = 0;
+			for(auto& event : entry.events)
+			{
+				switch(event.type)
+				{
+				case EventType::Begin:
+					beginEvent(event.name, "B", tid);
+					depth++;
+					break;
+				case EventType::End:
+					// Begin event was overwritten, skip the unmatched end event
+					if(depth == 0)
+						continue;
+
+					beginEvent(event.name, "E", tid);
+					depth--;
+					break;
+				case EventType::Frame:
+					beginEvent("Frame", "i", tid);
+					output << ",\"s\":\"t\"";
+					break;
+				}
+
+				output << ",\"ts\":";
+				writeTimestamp(output, event.timestamp, base);
+				output << "}";
+			}
+		}
+
+		output << "]}\n";
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if(stream == nullptr || !stream->isWriteable())
+		{
+			LOGERR("Cannot export profiler timeline to: " + path.toString());
+			return false;
+		}
+
+		const String contents = output.str();
+		const size_t written = stream->write(contents.data(), contents.size());
+		stream->close();
+
+		if(written != contents.size())
+		{
+			LOGERR("Cannot export profiler timeline to: " + path.toString());
+			return false;
+		}
+
+		return true;
+	}
+
+	ProfilerTimeline& gProfilerTimeline()
+	{
+		return ProfilerTimeline::instance();
+	}
+}
@@ -0,0 +1,128 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+
+namespace bs
+{
+	/** @addtogroup Profiling
+	 *  @{
+	 */
+
+	struct GPUProfileSample;
+
+	/**
+	 * Records CPU and GPU profiler samples on a timeline, so the interaction between threads (e.g. the sim thread
+	 * waiting on the core thread, or the core thread waiting on task scheduler workers) can be inspected. Unlike
+	 * ProfilerCPU, which aggregates samples per frame, the timeline keeps every individual sample along with its start
+	 * and end time.
+	 *
+	 * Each thread records its samples into its own fixed size ring buffer, without any synchronization, so once the
+	 * buffer is full the oldest events are overwritten. The start of each frame on a thread, as signaled by
+	 * ProfilerCPU::beginThread(), is recorded as a frame marker. GPU samples are recorded on a separate GPU track once
+	 * ProfilerGPU resolves them.
+	 *
+	 * The recorded timeline can be exported in the Chrome trace event format, which can be viewed in chrome://tracing
+	 * or in Perfetto.
+	 *
+	 * Recording is disabled by default and can be enabled through setEnabled().
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ProfilerTimeline : public Module<ProfilerTimeline>
+	{
+		struct ThreadTimeline;
+
+	public:
+		/** Maximum number of events kept for each thread. */
+		static constexpr UINT32 EVENTS_PER_THREAD = 8192;
+
+		ProfilerTimeline();
+		~ProfilerTimeline();
+
+		/** Enables or disables recording of new events. Already recorded events are kept. */
+		void setEnabled(bool enabled);
+
+		/** Checks if new events are being recorded. */
+		bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+		/** Discards all events recorded so far. */
+		void clear();
+
+		/**
+		 * Writes all recorded events to a file, in the Chrome trace event JSON format. Returns false if the file cannot
+		 * be written to.
+		 */
+		bool exportChromeTrace(const Path& path) const;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Names the timeline of the calling thread and records the start of a new frame on it. Called by
+		 * ProfilerCPU::beginThread().
+		 */
+		void _beginThread(const char* name);
+
+		/** Records the start of a sample on the calling thread. Called by ProfilerCPU when a sample begins. */
+		void _beginSample(const char* name);
+
+		/** Records the end of a sample on the calling thread. Called by ProfilerCPU when a sample ends. */
+		void _endSample(const char* name);
+
+		/**
+		 * Records a resolved GPU frame on the GPU track. GPU samples only report their duration, so they are laid out
+		 * one after another, starting either at @p submitTime or at the end of the previous GPU frame, whichever is
+		 * later. Their position on the timeline is therefore an estimate, while their durations are exact.
+		 *
+		 * @param[in]	frame		Sample containing the entire GPU frame, as reported by ProfilerGPU.
+		 * @param[in]	submitTime	Time at which the frame started being submitted on the core thread, as returned by
+		 *							_getTimestamp().
+		 *
+		 * @note	Core thread only.
+		 */
+		void _addGPUFrame(const GPUProfileSample& frame, UINT64 submitTime);
+
+		/** Returns the current time, in nanoseconds, in the same time base used for all recorded events. */
+		static UINT64 _getTimestamp();
+
+		/** @} */
+
+	private:
+		/** Type of an event stored on the timeline. */
+		enum class EventType : UINT8
+		{
+			Begin,
+			End,
+			Frame
+		};
+
+		/** Records an event on the provided timeline. Must only be called from the thread that owns the timeline. */
+		static void record(ThreadTimeline& timeline, EventType type, const char* name, UINT64 timestamp);
+
+		/** Returns the timeline of the calling thread, creating it if it doesn't exist yet. */
+		ThreadTimeline& getThreadTimeline();
+
+		/** Creates a new timeline and registers it so it gets included in exports. */
+		ThreadTimeline* createTimeline(const char* name);
+
+		/** Records @p sample and its children on the GPU timeline, starting at @p start. Returns the end time. */
+		UINT64 addGPUSample(const GPUProfileSample& sample, UINT64 start);
+
+		std::atomic<bool> mEnabled;
+
+		ProfilerVector<ThreadTimeline*> mTimelines;
+		ThreadTimeline* mGPUTimeline = nullptr;
+		UINT64 mLastGPUFrameEnd = 0;
+		UINT32 mNextTimelineId = 1;
+		mutable Mutex mMutex;
+	};
+
+	/** Provides global access to ProfilerTimeline instance. */
+	BS_CORE_EXPORT ProfilerTimeline& gProfilerTimeline();
+
+	/** @} */
+}
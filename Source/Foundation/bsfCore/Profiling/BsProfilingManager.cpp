@@ -27,7 +27,12 @@ namespace bs
 	void ProfilingManager::_update()
 	{
 #if BS_PROFILING_ENABLED
-		mSavedSimReports[mNextSimReportIdx].cpuReport = gProfilerCPU().generateReport();
+		ProfilerReport& report = mSavedSimReports[mNextSimReportIdx];
+		report.cpuReport = gProfilerCPU().generateReport();
+
+		// Also updates the peak usage of each tag, once per frame
+		for(UINT32 i = 0; i < (UINT32)MemoryTag::Count; i++)
+			report.memoryTags[i] = MemoryTags::getStats((MemoryTag)i);
 
 		gProfilerCPU().reset();
 
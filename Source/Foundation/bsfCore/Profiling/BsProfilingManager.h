@@ -16,6 +16,12 @@ namespace bs
 	struct ProfilerReport
 	{
 		CPUProfilerReport cpuReport;
+
+		/**
+		 * Memory usage of each memory tag, indexed by MemoryTag. Memory usage isn't specific to a thread, so it is only
+		 * provided in sim thread reports. All zero unless the framework is built with memory tags.
+		 */
+		MemoryTagStats memoryTags[(UINT32)MemoryTag::Count];
 	};
 
 	/**	Type of thread used by the profiler. */
@@ -26,7 +32,8 @@ namespace bs
 	};
 
 	/**
-	 * Tracks CPU profiling information with each frame for sim and core threads.
+	 * Tracks CPU profiling information with each frame for sim and core threads, as well as memory usage of each memory
+	 * tag.
 	 *
 	 * @note	Sim thread only unless specified otherwise.
 	 */
@@ -23,13 +23,45 @@ namespace bs
 		RenderStatObject_Query
 	};
 
+	/**
+	 * First value render API specific object types may use. Such types are reported under
+	 * RenderStatResourceCategory::Other unless a different category is assigned through
+	 * RenderStats::setResourceCategory().
+	 */
+	static constexpr UINT32 RenderStatObject_APISpecific = 100;
+
+	/** Categories GPU resource statistics are grouped under. */
+	enum class RenderStatResourceCategory
+	{
+		Texture,
+		/** Vertex, index and generic GPU buffers. */
+		Buffer,
+		ParamBlock,
+		/** Pipeline state objects, or the individual state objects on render APIs without them. */
+		PipelineState,
+		DescriptorSet,
+		/** GPU programs, queries, views and any other render API specific objects. */
+		Other,
+		Count // Keep at end
+	};
+
+	/** Resource statistics of a single RenderStatResourceCategory. */
+	struct RenderStatsResourceData
+	{
+		UINT64 numCreated = 0;
+		UINT64 numDestroyed = 0;
+		UINT64 numReads = 0;
+		UINT64 numWrites = 0;
+	};
+
 	/** Object that stores various render statistics. */
 	struct BS_CORE_EXPORT RenderStatsData
 	{
 		RenderStatsData()
 		: numDrawCalls(0), numComputeCalls(0), numRenderTargetChanges(0), numPresents(0), numClears(0)
 		, numVertices(0), numPrimitives(0), numPipelineStateChanges(0), numGpuParamBinds(0), numVertexBufferBinds(0)
-		, numIndexBufferBinds(0)
+		, numIndexBufferBinds(0), numStateChanges(0), numRedundantStateChanges(0), numResourceWrites(0)
+		, numResourceReads(0), numObjectsCreated(0), numObjectsDestroyed(0), numBytesUploaded(0), numBytesDownloaded(0)
 		{ }
 
 		UINT64 numDrawCalls;
@@ -47,11 +79,23 @@ namespace bs
 		UINT64 numVertexBufferBinds; 
 		UINT64 numIndexBufferBinds;
 
+		UINT64 numStateChanges;
+		UINT64 numRedundantStateChanges;
+
 		UINT64 numResourceWrites;
 		UINT64 numResourceReads;
 
 		UINT64 numObjectsCreated; 
 		UINT64 numObjectsDestroyed;
+
+		/** Number of bytes written to GPU resources from the CPU. */
+		UINT64 numBytesUploaded;
+
+		/** Number of bytes read from GPU resources to the CPU. */
+		UINT64 numBytesDownloaded;
+
+		/** Resource statistics for each resource category, indexed by RenderStatResourceCategory. */
+		RenderStatsResourceData resources[(UINT32)RenderStatResourceCategory::Count];
 	};
 
 	/**
@@ -62,6 +106,15 @@ namespace bs
 	class BS_CORE_EXPORT RenderStats : public Module<RenderStats>
 	{
 	public:
+		/** Maximum number of render API specific object types that can be assigned a category. */
+		static constexpr UINT32 MAX_API_SPECIFIC_TYPES = 32;
+
+		RenderStats()
+		{
+			for(auto& entry : mAPISpecificCategories)
+				entry = RenderStatResourceCategory::Other;
+		}
+
 		/** Increments draw call counter indicating how many times were render system API Draw methods called. */
 		void incNumDrawCalls() { mData.numDrawCalls++; }
 
@@ -98,44 +151,98 @@ namespace bs
 		/** Increments index buffer change counter indicating how many times was a index buffer bound to the pipeline. */
 		void incNumIndexBufferBinds() { mData.numIndexBufferBinds++; }
 
+		/**
+		 * Increments state change counter indicating how many times was an individual piece of render API state (e.g.
+		 * blend function or depth test) changed. Only tracked by render APIs that filter redundant state changes.
+		 */
+		void incNumStateChanges() { mData.numStateChanges++; }
+
+		/**
+		 * Increments redundant state change counter indicating how many state changes were skipped because the state
+		 * was already set to the requested value.
+		 */
+		void incNumRedundantStateChanges() { mData.numRedundantStateChanges++; }
+
 		/**
 		 * Increments created GPU resource counter. 
 		 *
-		 * @param[in]	category	Category of the resource.
+		 * @param[in]	type	Type of the resource, one of RenderStatResourceType or a render API specific type.
 		 */
-		void incResCreated(UINT32 category) 
+		void incResCreated(UINT32 type) 
 		{
-			// TODO - I'm ignoring resourceType for now. Later I will want to
-			// count object creation/destruction/read/write per type. I will
-			// also want to allow the caller to assign names to specific "resourceType" id.
-			// (Since many types will be RenderAPI specific).
-
-			// TODO - I should also track number of active GPU objects using this method, instead
-			// of just keeping track of how many were created and destroyed during the frame.
-
 			mData.numObjectsCreated++;
+			mData.resources[(UINT32)getResourceCategory(type)].numCreated++;
 		}
 
 		/**
 		 * Increments destroyed GPU resource counter. 
 		 *
-		 * @param[in]	category	Category of the resource.
+		 * @param[in]	type	Type of the resource, one of RenderStatResourceType or a render API specific type.
 		 */
-		void incResDestroyed(UINT32 category) { mData.numObjectsDestroyed++; }
+		void incResDestroyed(UINT32 type)
+		{
+			mData.numObjectsDestroyed++;
+			mData.resources[(UINT32)getResourceCategory(type)].numDestroyed++;
+		}
 
 		/**
 		 * Increments GPU resource read counter. 
 		 *
-		 * @param[in]	category	Category of the resource.
+		 * @param[in]	type	Type of the resource, one of RenderStatResourceType or a render API specific type.
+		 * @param[in]	bytes	Number of bytes read from the resource, if known.
 		 */
-		void incResRead(UINT32 category) { mData.numResourceReads++; }
+		void incResRead(UINT32 type, UINT64 bytes = 0)
+		{
+			mData.numResourceReads++;
+			mData.numBytesDownloaded += bytes;
+			mData.resources[(UINT32)getResourceCategory(type)].numReads++;
+		}
 
 		/**
 		 * Increments GPU resource write counter. 
 		 *
-		 * @param[in]	category	Category of the resource.
+		 * @param[in]	type	Type of the resource, one of RenderStatResourceType or a render API specific type.
+		 * @param[in]	bytes	Number of bytes written to the resource, if known.
+		 */
+		void incResWrite(UINT32 type, UINT64 bytes = 0)
+		{
+			mData.numResourceWrites++;
+			mData.numBytesUploaded += bytes;
+			mData.resources[(UINT32)getResourceCategory(type)].numWrites++;
+		}
+
+		/**
+		 * Assigns a category to a render API specific resource type, starting at RenderStatObject_APISpecific. Types
+		 * without an assigned category are reported as RenderStatResourceCategory::Other.
 		 */
-		void incResWrite(UINT32 category) { mData.numResourceWrites++; }
+		void setResourceCategory(UINT32 type, RenderStatResourceCategory category)
+		{
+			if(type >= RenderStatObject_APISpecific && type < RenderStatObject_APISpecific + MAX_API_SPECIFIC_TYPES)
+				mAPISpecificCategories[type - RenderStatObject_APISpecific] = category;
+		}
+
+		/** Returns the category statistics of the provided resource type are reported under. */
+		RenderStatResourceCategory getResourceCategory(UINT32 type) const
+		{
+			switch(type)
+			{
+			case RenderStatObject_Texture:
+				return RenderStatResourceCategory::Texture;
+			case RenderStatObject_IndexBuffer:
+			case RenderStatObject_VertexBuffer:
+			case RenderStatObject_GpuBuffer:
+				return RenderStatResourceCategory::Buffer;
+			case RenderStatObject_GpuParamBuffer:
+				return RenderStatResourceCategory::ParamBlock;
+			default:
+				break;
+			}
+
+			if(type >= RenderStatObject_APISpecific && type < RenderStatObject_APISpecific + MAX_API_SPECIFIC_TYPES)
+				return mAPISpecificCategories[type - RenderStatObject_APISpecific];
+
+			return RenderStatResourceCategory::Other;
+		}
 
 		/**
 		 * Returns an object containing various rendering statistics.
@@ -147,14 +254,18 @@ namespace bs
 
 	private:
 		RenderStatsData mData;
+		RenderStatResourceCategory mAPISpecificCategories[MAX_API_SPECIFIC_TYPES];
 	};
 
 #if BS_PROFILING_ENABLED
 	#define BS_INC_RENDER_STAT_CAT(Stat, Category) RenderStats::instance().inc##Stat((UINT32)Category)
+	#define BS_INC_RENDER_STAT_CAT_BYTES(Stat, Category, Bytes) \
+		RenderStats::instance().inc##Stat((UINT32)Category, (UINT64)(Bytes))
 	#define BS_INC_RENDER_STAT(Stat) RenderStats::instance().inc##Stat()
 	#define BS_ADD_RENDER_STAT(Stat, Count) RenderStats::instance().add##Stat(Count)
 #else
 	#define BS_INC_RENDER_STAT_CAT(Stat, Category)
+	#define BS_INC_RENDER_STAT_CAT_BYTES(Stat, Category, Bytes)
 	#define BS_INC_RENDER_STAT(Stat)
 	#define BS_ADD_RENDER_STAT(Stat, Count)
 #endif
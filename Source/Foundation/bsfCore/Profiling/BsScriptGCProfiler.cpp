@@ -0,0 +1,55 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Profiling/BsScriptGCProfiler.h"
+
+namespace bs
+{
+	namespace
+	{
+		std::atomic<UINT64> sNumCollections{0};
+		std::atomic<UINT64> sNumMajorCollections{0};
+		std::atomic<UINT64> sTotalPauseNs{0};
+		std::atomic<UINT64> sMaxPauseNs{0};
+		std::atomic<UINT64> sLastPauseNs{0};
+
+		/** Raises @p counter to @p value, if @p value is larger. */
+		void updateMax(std::atomic<UINT64>& counter, UINT64 value)
+		{
+			UINT64 current = counter.load(std::memory_order_relaxed);
+			while(value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{ }
+		}
+	}
+
+	ScriptGCStats ScriptGCProfiler::getStats()
+	{
+		ScriptGCStats stats;
+		stats.numCollections = sNumCollections.load(std::memory_order_relaxed);
+		stats.numMajorCollections = sNumMajorCollections.load(std::memory_order_relaxed);
+		stats.totalPauseNs = sTotalPauseNs.load(std::memory_order_relaxed);
+		stats.maxPauseNs = sMaxPauseNs.load(std::memory_order_relaxed);
+		stats.lastPauseNs = sLastPauseNs.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	void ScriptGCProfiler::reset()
+	{
+		sNumCollections.store(0, std::memory_order_relaxed);
+		sNumMajorCollections.store(0, std::memory_order_relaxed);
+		sTotalPauseNs.store(0, std::memory_order_relaxed);
+		sMaxPauseNs.store(0, std::memory_order_relaxed);
+		sLastPauseNs.store(0, std::memory_order_relaxed);
+	}
+
+	void ScriptGCProfiler::_recordPause(UINT64 pauseNs, UINT32 generation)
+	{
+		sNumCollections.fetch_add(1, std::memory_order_relaxed);
+		if(generation > 0)
+			sNumMajorCollections.fetch_add(1, std::memory_order_relaxed);
+
+		sTotalPauseNs.fetch_add(pauseNs, std::memory_order_relaxed);
+		sLastPauseNs.store(pauseNs, std::memory_order_relaxed);
+		updateMax(sMaxPauseNs, pauseNs);
+	}
+}
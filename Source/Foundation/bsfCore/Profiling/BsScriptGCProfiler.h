@@ -0,0 +1,55 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Profiling
+	 *  @{
+	 */
+
+	/** Garbage collection statistics of the scripting runtime. Totals since the application started. */
+	struct ScriptGCStats
+	{
+		UINT64 numCollections = 0; /**< Number of garbage collections, of any generation. */
+		UINT64 numMajorCollections = 0; /**< Number of collections of generations older than the nursery. */
+		UINT64 totalPauseNs = 0; /**< Time the runtime was stopped for garbage collection, in nanoseconds. */
+		UINT64 maxPauseNs = 0; /**< Longest single garbage collection pause, in nanoseconds. */
+		UINT64 lastPauseNs = 0; /**< Duration of the most recent garbage collection pause, in nanoseconds. */
+	};
+
+	/**
+	 * Collects garbage collection pause statistics reported by the active scripting runtime. Statistics are only
+	 * available if the runtime reports them, otherwise all values remain zero.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ScriptGCProfiler
+	{
+	public:
+		/** Returns the statistics accumulated since the application started, or since the last call to reset(). */
+		static ScriptGCStats getStats();
+
+		/** Resets all statistics to zero. */
+		static void reset();
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Records a single garbage collection pause. Called by the scripting runtime, from the thread that performed
+		 * the collection.
+		 *
+		 * @param[in]	pauseNs		Time the runtime was stopped for, in nanoseconds.
+		 * @param[in]	generation	Oldest generation that was collected, 0 being the nursery.
+		 */
+		static void _recordPause(UINT64 pauseNs, UINT32 generation);
+
+		/** @} */
+	};
+
+	/** @} */
+}
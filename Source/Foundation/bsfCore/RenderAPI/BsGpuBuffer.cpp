@@ -140,12 +140,12 @@ namespace bs
 #if BS_PROFILING_ENABLED
 		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuBuffer);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_GpuBuffer, length);
 		}
 
 		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuBuffer);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_GpuBuffer, length);
 		}
 #endif
 
@@ -159,7 +159,7 @@ namespace bs
 
 	void GpuBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
 	{
-		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_GpuBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_GpuBuffer, length);
 
 		mBuffer->readData(offset, length, dest, deviceIdx, queueIdx);
 	}
@@ -167,7 +167,7 @@ namespace bs
 	void GpuBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags, 
 		UINT32 queueIdx)
 	{
-		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_GpuBuffer, length);
 
 		mBuffer->writeData(offset, length, source, writeFlags, queueIdx);
 	}
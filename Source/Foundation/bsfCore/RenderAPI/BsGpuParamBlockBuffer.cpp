@@ -174,7 +174,7 @@ namespace bs
 	{
 		mBuffer->writeData(0, mSize, data, BWT_DISCARD, queueIdx);
 
-		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_GpuParamBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_GpuParamBuffer, mSize);
 	}
 
 	void GpuParamBlockBuffer::syncToCore(const CoreSyncData& data)
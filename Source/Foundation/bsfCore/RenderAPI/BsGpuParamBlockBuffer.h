@@ -97,7 +97,7 @@ namespace bs
 		 * @param[in]	data		Data to write. Must match the size of the buffer.
 		 * @param[in]	queueIdx	Device queue to perform the write operation on. See @ref queuesDoc.
 		 */
-		void writeToGPU(const UINT8* data, UINT32 queueIdx = 0);
+		virtual void writeToGPU(const UINT8* data, UINT32 queueIdx = 0);
 
 		/** 
 		 * Flushes any cached data into the actual GPU buffer. 
@@ -88,12 +88,12 @@ namespace bs
 #if BS_PROFILING_ENABLED
 		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_IndexBuffer);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_IndexBuffer, length);
 		}
 
 		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_IndexBuffer);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_IndexBuffer, length);
 		}
 #endif
 
@@ -109,7 +109,7 @@ namespace bs
 	{
 		mBuffer->readData(offset, length, dest, deviceIdx, queueIdx);
 
-		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_IndexBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_IndexBuffer, length);
 	}
 
 	void IndexBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags, 
@@ -117,7 +117,7 @@ namespace bs
 	{
 		mBuffer->writeData(offset, length, source, writeFlags, queueIdx);
 
-		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_IndexBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_IndexBuffer, length);
 	}
 
 	void IndexBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length, 
@@ -209,6 +209,11 @@ namespace bs
 		 * If set, the render API support rendering to multiple layers of a render texture at once (via a geometry shader).
 		 */
 		RenderTargetLayers		= 1 << 10,
+		/**
+		 * If set, secondary command buffers can be recorded from multiple threads at once, and appended to a primary
+		 * command buffer through addCommands().
+		 */
+		ParallelSecondaryCB		= 1 << 11,
 	};
 
 	typedef Flags<RenderAPIFeatureFlag> RenderAPIFeatures;
@@ -259,6 +264,33 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Layout of the arguments read from a GPU buffer by RenderAPI::drawIndirect(). */
+	struct DRAW_INDIRECT_ARGS
+	{
+		UINT32 vertexCount;
+		UINT32 instanceCount;
+		UINT32 vertexOffset;
+		UINT32 instanceOffset;
+	};
+
+	/** Layout of the arguments read from a GPU buffer by RenderAPI::drawIndexedIndirect(). */
+	struct DRAW_INDEXED_INDIRECT_ARGS
+	{
+		UINT32 indexCount;
+		UINT32 instanceCount;
+		UINT32 startIndex;
+		INT32 vertexOffset;
+		UINT32 instanceOffset;
+	};
+
+	/** Layout of the arguments read from a GPU buffer by RenderAPI::dispatchComputeIndirect(). */
+	struct DISPATCH_INDIRECT_ARGS
+	{
+		UINT32 numGroupsX;
+		UINT32 numGroupsY;
+		UINT32 numGroupsZ;
+	};
+
 	/**
 	 * Provides low-level API access to rendering commands (internally wrapping DirectX/OpenGL/Vulkan or similar). 
 	 * 
@@ -445,6 +477,61 @@ namespace bs
 		virtual void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1, 
 			const SPtr<CommandBuffer>& commandBuffer = nullptr) = 0;
 
+		/**
+		 * Same as draw() except the draw arguments are read from a GPU buffer, allowing them to be generated on the
+		 * GPU. Requires the RSC_DRAW_INDIRECT capability.
+		 *
+		 * @param[in]	argsBuffer		Buffer containing one or multiple DRAW_INDIRECT_ARGS entries. Must be created
+		 *								with the GBT_INDIRECTARGUMENT type.
+		 * @param[in]	offset			Offset into the buffer at which the first entry starts, in bytes. Must be a
+		 *								multiple of 4.
+		 * @param[in]	drawCount		Number of draws to execute, each using a separate entry in the buffer. If the
+		 *								RSC_MULTI_DRAW_INDIRECT capability is not supported all draws are issued
+		 *								separately.
+		 * @param[in]	stride			Distance between two consecutive entries in the buffer, in bytes. Zero means the
+		 *								entries are tightly packed.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided operation
+		 *								is executed immediately. Otherwise it is executed when executeCommands() is called.
+		 *								Buffer must support graphics operations.
+		 */
+		virtual void drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) = 0;
+
+		/**
+		 * Same as drawIndexed() except the draw arguments are read from a GPU buffer, allowing them to be generated on
+		 * the GPU. Requires the RSC_DRAW_INDIRECT capability.
+		 *
+		 * @param[in]	argsBuffer		Buffer containing one or multiple DRAW_INDEXED_INDIRECT_ARGS entries. Must be
+		 *								created with the GBT_INDIRECTARGUMENT type.
+		 * @param[in]	offset			Offset into the buffer at which the first entry starts, in bytes. Must be a
+		 *								multiple of 4.
+		 * @param[in]	drawCount		Number of draws to execute, each using a separate entry in the buffer. If the
+		 *								RSC_MULTI_DRAW_INDIRECT capability is not supported all draws are issued
+		 *								separately.
+		 * @param[in]	stride			Distance between two consecutive entries in the buffer, in bytes. Zero means the
+		 *								entries are tightly packed.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided operation
+		 *								is executed immediately. Otherwise it is executed when executeCommands() is called.
+		 *								Buffer must support graphics operations.
+		 */
+		virtual void drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) = 0;
+
+		/**
+		 * Same as dispatchCompute() except the number of groups is read from a GPU buffer, allowing it to be generated
+		 * on the GPU. Requires the RSC_DRAW_INDIRECT capability.
+		 *
+		 * @param[in]	argsBuffer		Buffer containing a DISPATCH_INDIRECT_ARGS entry. Must be created with the
+		 *								GBT_INDIRECTARGUMENT type.
+		 * @param[in]	offset			Offset into the buffer at which the entry starts, in bytes. Must be a multiple
+		 *								of 4.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided operation
+		 *								is executed immediately. Otherwise it is executed when executeCommands() is called.
+		 *								Buffer must support compute or graphics operations.
+		 */
+		virtual void dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) = 0;
+
 		/** 
 		 * Swap the front and back buffer of the specified render target. 
 		 *
@@ -547,6 +634,40 @@ namespace bs
 		/** Returns the number of devices supported by this render API. */
 		UINT32 getNumDevices() const { return mNumDevices; }
 
+		/**
+		 * Returns the number of devices that can be used for rendering in parallel, by assigning them through
+		 * setActiveDevice(). Only larger than one on render APIs supporting explicit multi-GPU setups, and only if the
+		 * system has multiple similar GPUs available.
+		 */
+		virtual UINT32 getNumRenderDevices() const { return 1; }
+
+		/**
+		 * Changes the device that receives commands issued without an explicit command buffer. Resources created with
+		 * the default device mask are available on all render devices.
+		 *
+		 * @param[in]	idx		Index of the render device, in range [0, getNumRenderDevices()). Device 0 is the one
+		 *						presenting to render windows.
+		 *
+		 * @note	Core thread only.
+		 */
+		virtual void setActiveDevice(UINT32 idx) { }
+
+		/** Returns the render device set by setActiveDevice(). */
+		virtual UINT32 getActiveDevice() const { return 0; }
+
+		/**
+		 * Assigns a texture to a slot of the global descriptor-indexed texture table, visible to all shaders declaring
+		 * it. Only supported if the device reports RSC_TEXTURE_DESCRIPTOR_INDEXING. Normally called by TextureTable.
+		 *
+		 * @param[in]	index		Index of the slot, in range [0, TextureTable::MAX_INDEXED_TEXTURES).
+		 * @param[in]	texture		Texture to assign to the slot. Set to null to release the slot. A slot must not be
+		 *							re-assigned or released while draws referencing it might still be executing on
+		 *							the GPU, and released slots must not be referenced until they are assigned again.
+		 *
+		 * @note	Core thread only.
+		 */
+		virtual void setTextureTableEntry(UINT32 index, const SPtr<Texture>& texture) { }
+
 		/**
 		 * Returns information about available output devices and their video modes.
 		 *
@@ -38,6 +38,9 @@ namespace bs
 		RSC_GEOMETRY_PROGRAM			= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 3), /**< Supports hardware geometry programs. */
 		RSC_TESSELLATION_PROGRAM		= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 4), /**< Supports hardware tessellation programs. */
 		RSC_COMPUTE_PROGRAM				= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 5), /**< Supports hardware compute programs. */
+		RSC_DRAW_INDIRECT				= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 6), /**< Supports draw and dispatch calls with arguments read from a GPU buffer. */
+		RSC_MULTI_DRAW_INDIRECT			= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 7), /**< Supports issuing multiple indirect draws with a single call. */
+		RSC_TEXTURE_DESCRIPTOR_INDEXING	= BS_CAPS_VALUE(CAPS_CATEGORY_COMMON, 8), /**< Supports a global texture table indexed by non-uniform values in shaders. See RenderAPI::setTextureTableEntry(). */
 	};
 
 	/** Holds data about render system driver version. */
@@ -151,7 +151,7 @@ namespace bs
 		 *
 		 * @note	Sim thread only.
 		 */
-		mutable Event<void()> onResized;
+		mutable Event<void(), false> onResized;
 
 	protected:
 		friend class ct::RenderTarget;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BsCorePrerequisites.h"
+#include "Math/BsVector3.h"
 
 namespace bs
 {
@@ -26,5 +27,34 @@ namespace bs
 		DrawOperationType drawOp;
 	};
 
+	/**
+	 * Cluster of nearby triangles belonging to a sub-mesh, along with bounds that allow the renderer to cull the
+	 * cluster independently of the rest of the sub-mesh.
+	 */
+	struct BS_CORE_EXPORT Meshlet
+	{
+		/** Offset of the first index of the meshlet, in the mesh's index buffer. */
+		UINT32 indexOffset = 0;
+
+		/** Number of indices in the meshlet. */
+		UINT32 indexCount = 0;
+
+		/** Center of the sphere bounding all triangles in the meshlet, in mesh space. */
+		Vector3 boundsCenter = Vector3::ZERO;
+
+		/** Radius of the sphere bounding all triangles in the meshlet. */
+		float boundsRadius = 0.0f;
+
+		/** Axis of a cone containing the normals of all triangles in the meshlet, in mesh space. */
+		Vector3 coneAxis = Vector3::ZERO;
+
+		/**
+		 * Sine of the angle between the cone axis and the triangle normal furthest away from it. All triangles in the
+		 * meshlet face away from point P if dot(C - P, axis) >= cutoff * |C - P| + radius, where C is the bounds
+		 * center. Set to one if the triangle normals are spread too far apart for the meshlet to ever be culled.
+		 */
+		float coneCutoff = 1.0f;
+	};
+
 	/** @} */
 }
\ No newline at end of file
@@ -78,12 +78,12 @@ namespace bs
 #if BS_PROFILING_ENABLED
 		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_VertexBuffer);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_VertexBuffer, length);
 		}
 
 		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_VertexBuffer);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_VertexBuffer, length);
 		}
 #endif
 
@@ -98,14 +98,14 @@ namespace bs
 	void VertexBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
 	{
 		mBuffer->readData(offset, length, dest, deviceIdx, queueIdx);
-		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_VertexBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_VertexBuffer, length);
 	}
 
 	void VertexBuffer::writeData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags, 
 		UINT32 queueIdx)
 	{
 		mBuffer->writeData(offset, length, source, writeFlags, queueIdx);
-		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_VertexBuffer);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_VertexBuffer, length);
 	}
 
 	void VertexBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset,
@@ -67,6 +67,10 @@ namespace bs
 			return sizeof(INT32) * 3;
 		case VET_UBYTE4:
 			return sizeof(UINT8) * 4;
+		case VET_HALF2:
+			return sizeof(UINT16) * 2;
+		case VET_HALF4:
+			return sizeof(UINT16) * 4;
 		default:
 			break;
 		}
@@ -93,6 +97,7 @@ namespace bs
 		case VET_USHORT2:
 		case VET_INT2:
 		case VET_UINT2:
+		case VET_HALF2:
 			return 2;
 		case VET_FLOAT3:
 		case VET_INT3:
@@ -105,6 +110,7 @@ namespace bs
 		case VET_UINT4:
 		case VET_UBYTE4:
 		case VET_UBYTE4_NORM:
+		case VET_HALF4:
 			return 4;
 		default:
 			break;
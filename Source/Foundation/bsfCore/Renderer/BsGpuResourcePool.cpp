@@ -34,6 +34,9 @@ namespace bs { namespace ct
 
 		for (auto& buffer : mBuffers)
 			buffer.second.lock()->mPool = nullptr;
+
+		mFreeTextures.clear();
+		mFreeBuffers.clear();
 	}
 
 	SPtr<PooledRenderTexture> GpuResourcePool::get(const POOLED_RENDER_TEXTURE_DESC& desc)
@@ -51,11 +54,15 @@ namespace bs { namespace ct
 			if (matches(textureData->texture, desc))
 			{
 				textureData->mIsFree = false;
+				textureData->mLastUsedFrame = mFrameIdx;
+				removeFree(mFreeTextures, textureData.get());
+
 				return textureData;
 			}
 		}
 
 		SPtr<PooledRenderTexture> newTextureData = bs_shared_ptr_new<PooledRenderTexture>(this);
+		newTextureData->mLastUsedFrame = mFrameIdx;
 		_registerTexture(newTextureData);
 
 		TEXTURE_DESC texDesc;
@@ -115,11 +122,15 @@ namespace bs { namespace ct
 			if (matches(bufferData->buffer, desc))
 			{
 				bufferData->mIsFree = false;
+				bufferData->mLastUsedFrame = mFrameIdx;
+				removeFree(mFreeBuffers, bufferData.get());
+
 				return bufferData;
 			}
 		}
 
 		SPtr<PooledStorageBuffer> newBufferData = bs_shared_ptr_new<PooledStorageBuffer>(this);
+		newBufferData->mLastUsedFrame = mFrameIdx;
 		_registerBuffer(newBufferData);
 
 		GPU_BUFFER_DESC bufferDesc;
@@ -136,14 +147,34 @@ namespace bs { namespace ct
 
 	void GpuResourcePool::release(const SPtr<PooledRenderTexture>& texture)
 	{
-		auto iterFind = mTextures.find(texture.get());
-		iterFind->second.lock()->mIsFree = true;
+		if (texture->mIsFree)
+			return;
+
+		texture->mIsFree = true;
+		texture->mLastUsedFrame = mFrameIdx;
+		mFreeTextures.push_back(texture);
 	}
 
 	void GpuResourcePool::release(const SPtr<PooledStorageBuffer>& buffer)
 	{
-		auto iterFind = mBuffers.find(buffer.get());
-		iterFind->second.lock()->mIsFree = true;
+		if (buffer->mIsFree)
+			return;
+
+		buffer->mIsFree = true;
+		buffer->mLastUsedFrame = mFrameIdx;
+		mFreeBuffers.push_back(buffer);
+	}
+
+	void GpuResourcePool::update()
+	{
+		mFrameIdx++;
+
+		if (mFrameIdx <= FREE_RESOURCE_LIFETIME)
+			return;
+
+		const UINT64 oldestFrame = mFrameIdx - FREE_RESOURCE_LIFETIME;
+		evictFree(mFreeTextures, oldestFrame);
+		evictFree(mFreeBuffers, oldestFrame);
 	}
 
 	bool GpuResourcePool::matches(const SPtr<Texture>& texture, const POOLED_RENDER_TEXTURE_DESC& desc)
@@ -189,6 +220,34 @@ namespace bs { namespace ct
 		return match;
 	}
 
+	template<class T>
+	void GpuResourcePool::removeFree(Vector<SPtr<T>>& freeList, T* entry)
+	{
+		auto iterFind = std::find_if(freeList.begin(), freeList.end(), 
+			[entry](const SPtr<T>& other) { return other.get() == entry; });
+
+		if (iterFind == freeList.end())
+			return;
+
+		std::swap(*iterFind, freeList.back());
+		freeList.pop_back();
+	}
+
+	template<class T>
+	void GpuResourcePool::evictFree(Vector<SPtr<T>>& freeList, UINT64 oldestFrame)
+	{
+		for (UINT32 i = 0; i < (UINT32)freeList.size();)
+		{
+			if (freeList[i]->mLastUsedFrame < oldestFrame)
+			{
+				std::swap(freeList[i], freeList.back());
+				freeList.pop_back();
+			}
+			else
+				i++;
+		}
+	}
+
 	void GpuResourcePool::_registerTexture(const SPtr<PooledRenderTexture>& texture)
 	{
 		mTextures.insert(std::make_pair(texture.get(), texture));
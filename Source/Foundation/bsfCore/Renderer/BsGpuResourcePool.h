@@ -31,6 +31,7 @@ namespace bs { namespace ct
 
 		GpuResourcePool* mPool;
 		bool mIsFree;
+		UINT64 mLastUsedFrame = 0;
 	};
 
 	/**	Contains data about a single storage buffer in the GPU resource pool. */
@@ -46,11 +47,16 @@ namespace bs { namespace ct
 
 		GpuResourcePool* mPool;
 		bool mIsFree;
+		UINT64 mLastUsedFrame = 0;
 	};
 
 	/** 
 	 * Contains a pool of textures and buffers meant to accommodate reuse of such resources for the main purpose of using
 	 * them as write targets on the GPU.
+	 * 
+	 * Released resources are kept alive by the pool, so that later users requesting a resource with the same
+	 * parameters can reuse the same memory. Resources that remain unused for more than a few frames are destroyed
+	 * during update(), as soon as nothing outside of the pool references them.
 	 */
 	class BS_CORE_EXPORT GpuResourcePool : public Module<GpuResourcePool>
 	{
@@ -93,6 +99,15 @@ namespace bs { namespace ct
 		 */
 		void release(const SPtr<PooledStorageBuffer>& buffer);
 
+		/** 
+		 * Advances the pool to the next frame and stops keeping alive any released resources that weren't requested for 
+		 * more than FREE_RESOURCE_LIFETIME frames. Should be called once per frame.
+		 */
+		void update();
+
+		/** Number of frames a released resource is kept alive by the pool, waiting to be reused. */
+		static constexpr UINT32 FREE_RESOURCE_LIFETIME = 3;
+
 	private:
 		friend struct PooledRenderTexture;
 		friend struct PooledStorageBuffer;
@@ -125,8 +140,20 @@ namespace bs { namespace ct
 		 */
 		static bool matches(const SPtr<GpuBuffer>& buffer, const POOLED_STORAGE_BUFFER_DESC& desc);
 
+		/** Removes the entry from a list of free resources, if present. Doesn't preserve the order of the list. */
+		template<class T>
+		static void removeFree(Vector<SPtr<T>>& freeList, T* entry);
+
+		/** Removes all entries that weren't used since the provided frame from a list of free resources. */
+		template<class T>
+		static void evictFree(Vector<SPtr<T>>& freeList, UINT64 oldestFrame);
+
 		Map<PooledRenderTexture*, std::weak_ptr<PooledRenderTexture>> mTextures;
 		Map<PooledStorageBuffer*, std::weak_ptr<PooledStorageBuffer>> mBuffers;
+
+		Vector<SPtr<PooledRenderTexture>> mFreeTextures;
+		Vector<SPtr<PooledStorageBuffer>> mFreeBuffers;
+		UINT64 mFrameIdx = 0;
 	};
 
 	/** Structure used for creating a new pooled render texture. */
@@ -0,0 +1,772 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Renderer/BsHLODBuilder.h"
+#include "Components/BsCRenderable.h"
+#include "Renderer/BsRenderable.h"
+#include "Scene/BsSceneObject.h"
+#include "Mesh/BsMesh.h"
+#include "Mesh/BsMeshData.h"
+#include "Mesh/BsMeshUtility.h"
+#include "Material/BsMaterial.h"
+#include "Material/BsMaterialParams.h"
+#include "Material/BsShader.h"
+#include "Image/BsTexture.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsTextureAtlasLayout.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+
+namespace bs
+{
+	/** Names of the parameters the built-in shaders transform the texture coordinates with. */
+	static const char* UV_TILE_PARAM = "gUVTile";
+	static const char* UV_OFFSET_PARAM = "gUVOffset";
+
+	/** Empty space around each texture in an atlas, in pixels, that keeps neighbors from bleeding in when filtering. */
+	static constexpr UINT32 ATLAS_PADDING = 4;
+
+	/** Material of a cluster whose textures are packed into an atlas, and the area they occupy. */
+	struct AtlasEntry
+	{
+		UINT32 materialIdx = 0;
+		Vector2 uvScale = Vector2::ONE;
+		Vector2 uvOffset = Vector2::ZERO;
+		UINT32 width = 0;
+		UINT32 height = 0;
+		UINT32 x = 0;
+		UINT32 y = 0;
+	};
+
+	/** Materials merged into a single material, whose textures are atlases of theirs. */
+	struct AtlasGroup
+	{
+		Vector<AtlasEntry> entries;
+		TextureAtlasLayout layout;
+	};
+
+	/** Checks do the two vertex layouts contain the same elements, in the same order. */
+	static bool isSameLayout(const VertexDataDesc& a, const VertexDataDesc& b)
+	{
+		if (a.getNumElements() != b.getNumElements())
+			return false;
+
+		for (UINT32 i = 0; i < a.getNumElements(); i++)
+		{
+			const VertexElement& elemA = a.getElement(i);
+			const VertexElement& elemB = b.getElement(i);
+
+			if (elemA.getSemantic() != elemB.getSemantic() || elemA.getSemanticIdx() != elemB.getSemanticIdx() ||
+				elemA.getType() != elemB.getType() || elemA.getStreamIdx() != elemB.getStreamIdx())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Checks can the data of the vertex layout be transformed into the space of the proxy mesh. */
+	static bool isSupportedLayout(const VertexDataDesc& layout)
+	{
+		for (UINT32 i = 0; i < layout.getNumElements(); i++)
+		{
+			const VertexElement& element = layout.getElement(i);
+			if (element.getSemanticIdx() != 0)
+				continue;
+
+			switch (element.getSemantic())
+			{
+			case VES_POSITION:
+				if (element.getType() != VET_FLOAT3)
+					return false;
+				break;
+			case VES_NORMAL:
+				if (element.getType() != VET_FLOAT3 && element.getType() != VET_UBYTE4_NORM)
+					return false;
+				break;
+			case VES_TANGENT:
+				if (element.getType() != VET_FLOAT4 && element.getType() != VET_UBYTE4_NORM)
+					return false;
+				break;
+			default:
+				break;
+			}
+		}
+
+		return layout.hasElement(VES_POSITION);
+	}
+
+	/** Transforms a range of vertices in place, as described by isSupportedLayout(). */
+	static void transformVertices(MeshData& meshData, UINT32 vertexOffset, UINT32 numVertices, const Matrix4& transform)
+	{
+		const Matrix3 linear = transform.get3x3();
+
+		Matrix3 normalTransform;
+		if (linear.inverse(normalTransform))
+			normalTransform = normalTransform.transpose();
+		else
+			normalTransform = linear;
+
+		// Mirroring transforms flip the bitangent
+		const float bitangentSign = transform.determinant3x3() < 0.0f ? -1.0f : 1.0f;
+
+		const SPtr<VertexDataDesc>& layout = meshData.getVertexDesc();
+		for (UINT32 i = 0; i < layout->getNumElements(); i++)
+		{
+			const VertexElement& element = layout->getElement(i);
+			if (element.getSemanticIdx() != 0)
+				continue;
+
+			const UINT32 stride = layout->getVertexStride(element.getStreamIdx());
+			UINT8* data = meshData.getElementData(element.getSemantic(), 0, element.getStreamIdx()) +
+				vertexOffset * stride;
+
+			switch (element.getSemantic())
+			{
+			case VES_POSITION:
+				for (UINT32 j = 0; j < numVertices; j++)
+				{
+					auto& position = *(Vector3*)(data + j * stride);
+					position = transform.multiplyAffine(position);
+				}
+				break;
+			case VES_NORMAL:
+				if (element.getType() == VET_FLOAT3)
+				{
+					for (UINT32 j = 0; j < numVertices; j++)
+					{
+						auto& normal = *(Vector3*)(data + j * stride);
+						normal = Vector3::normalize(normalTransform.multiply(normal));
+					}
+				}
+				else
+				{
+					for (UINT32 j = 0; j < numVertices; j++)
+					{
+						Vector3 normal = MeshUtility::unpackNormal(data + j * stride);
+						normal = Vector3::normalize(normalTransform.multiply(normal));
+
+						MeshUtility::packNormals(&normal, data + j * stride, 1, sizeof(Vector3), stride);
+					}
+				}
+				break;
+			case VES_TANGENT:
+				for (UINT32 j = 0; j < numVertices; j++)
+				{
+					Vector4 tangent;
+					if (element.getType() == VET_FLOAT4)
+						tangent = *(Vector4*)(data + j * stride);
+					else
+						MeshUtility::unpackNormals(data + j * stride, &tangent, 1, stride);
+
+					Vector3 direction(tangent.x, tangent.y, tangent.z);
+					direction = Vector3::normalize(linear.multiply(direction));
+
+					tangent = Vector4(direction.x, direction.y, direction.z, tangent.w * bitangentSign);
+
+					if (element.getType() == VET_FLOAT4)
+						*(Vector4*)(data + j * stride) = tangent;
+					else
+						MeshUtility::packNormals(&tangent, data + j * stride, 1, sizeof(Vector4), stride);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	/** Checks does the shader have a 2D vector parameter with the specified name. */
+	static bool hasVec2Param(const HShader& shader, const String& name)
+	{
+		const Map<String, SHADER_DATA_PARAM_DESC>& dataParams = shader->getDataParams();
+
+		const auto iterFind = dataParams.find(name);
+		return iterFind != dataParams.end() && iterFind->second.type == GPDT_FLOAT2 && iterFind->second.arraySize == 1;
+	}
+
+	/**
+	 * Checks can the textures of the material be packed into an atlas, and returns the size of the area they require.
+	 * All textures of the material are scaled to the size of the first one, so they can share texture coordinates.
+	 */
+	static bool canAtlas(const HMaterial& material, UINT32& width, UINT32& height)
+	{
+		const HShader shader = material->getShader();
+		if (!shader.isLoaded())
+			return false;
+
+		width = 0;
+		height = 0;
+		for (auto& entry : shader->getTextureParams())
+		{
+			const HTexture texture = material->getTexture(entry.first);
+			if (texture == nullptr)
+				continue;
+
+			if (entry.second.type != GPOT_TEXTURE2D || !texture.isLoaded())
+				return false;
+
+			const TextureProperties& props = texture->getProperties();
+			if (props.getTextureType() != TEX_TYPE_2D || props.getNumArraySlices() != 1 ||
+				(props.getUsage() & TU_CPUCACHED) == 0 || PixelUtil::isCompressed(props.getFormat()))
+			{
+				return false;
+			}
+
+			if (width == 0)
+			{
+				width = props.getWidth();
+				height = props.getHeight();
+			}
+		}
+
+		return width > 0 && height > 0;
+	}
+
+	/** Checks can the two materials be merged into one, assuming both satisfy canAtlas(). */
+	static bool canShareAtlas(const HMaterial& a, const HMaterial& b)
+	{
+		const HShader shader = a->getShader();
+		if (shader != b->getShader() || !(a->getVariation() == b->getVariation()))
+			return false;
+
+		// The same textures must be present, and the atlas can only be in a single color space
+		for (auto& entry : shader->getTextureParams())
+		{
+			const HTexture textureA = a->getTexture(entry.first);
+			const HTexture textureB = b->getTexture(entry.first);
+
+			if ((textureA == nullptr) != (textureB == nullptr))
+				return false;
+
+			if (textureA != nullptr && textureA->getProperties().isHardwareGammaEnabled() !=
+				textureB->getProperties().isHardwareGammaEnabled())
+			{
+				return false;
+			}
+		}
+
+		// Texture coordinate transforms get baked into the vertices, all other parameters must match
+		const SPtr<MaterialParams> paramsA = a->_getInternalParams();
+		const SPtr<MaterialParams> paramsB = b->_getInternalParams();
+		for (auto& entry : shader->getDataParams())
+		{
+			if (entry.first == UV_TILE_PARAM || entry.first == UV_OFFSET_PARAM)
+				continue;
+
+			const UINT32 paramIdx = paramsA->getParamIndex(entry.first);
+			if (paramIdx == (UINT32)-1)
+				continue;
+
+			// Struct parameters aren't stored in the data buffer
+			const MaterialParams::ParamData* param = paramsA->getParamData(paramIdx);
+			if (param->dataType == GPDT_STRUCT)
+				return false;
+
+			const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[param->dataType];
+			const UINT32 paramSize = typeInfo.numColumns * typeInfo.numRows * typeInfo.baseTypeSize;
+
+			for (UINT32 i = 0; i < param->arraySize; i++)
+			{
+				if (memcmp(paramsA->getData(param->index + i), paramsB->getData(param->index + i), paramSize) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Packs the textures assigned to the specified parameter of all the materials in the group into an atlas. */
+	static HTexture createAtlasTexture(const AtlasGroup& group, const Vector<HMaterial>& materials, const String& name)
+	{
+		const UINT32 width = group.layout.getWidth();
+		const UINT32 height = group.layout.getHeight();
+
+		SPtr<PixelData> atlasData = bs_shared_ptr_new<PixelData>(width, height, 1, PF_RGBA8);
+		atlasData->allocateInternalBuffer();
+		memset(atlasData->getData(), 0, atlasData->getConsecutiveSize());
+
+		const UINT32 pixelSize = PixelUtil::getNumElemBytes(PF_RGBA8);
+		for (auto& entry : group.entries)
+		{
+			const HTexture texture = materials[entry.materialIdx]->getTexture(name);
+			const TextureProperties& props = texture->getProperties();
+
+			SPtr<PixelData> cachedData = props.allocBuffer(0, 0);
+			texture->readCachedData(*cachedData);
+
+			SPtr<PixelData> sourceData = bs_shared_ptr_new<PixelData>(props.getWidth(), props.getHeight(), 1, PF_RGBA8);
+			sourceData->allocateInternalBuffer();
+			PixelUtil::bulkPixelConversion(*cachedData, *sourceData);
+
+			if (sourceData->getWidth() != entry.width || sourceData->getHeight() != entry.height)
+			{
+				SPtr<PixelData> scaledData = bs_shared_ptr_new<PixelData>(entry.width, entry.height, 1, PF_RGBA8);
+				scaledData->allocateInternalBuffer();
+				PixelUtil::scale(*sourceData, *scaledData);
+
+				sourceData = scaledData;
+			}
+
+			// Edge pixels are repeated over the padding
+			const UINT8* src = sourceData->getData();
+			UINT8* dst = atlasData->getData();
+			for (UINT32 y = 0; y < entry.height + ATLAS_PADDING * 2; y++)
+			{
+				const UINT32 srcY = (UINT32)Math::clamp((INT32)y - (INT32)ATLAS_PADDING, 0, (INT32)entry.height - 1);
+				for (UINT32 x = 0; x < entry.width + ATLAS_PADDING * 2; x++)
+				{
+					const UINT32 srcX = (UINT32)Math::clamp((INT32)x - (INT32)ATLAS_PADDING, 0, (INT32)entry.width - 1);
+
+					memcpy(dst + ((entry.y + y) * atlasData->getRowPitch() + entry.x + x) * pixelSize,
+						src + (srcY * sourceData->getRowPitch() + srcX) * pixelSize, pixelSize);
+				}
+			}
+		}
+
+		const HTexture firstTexture = materials[group.entries[0].materialIdx]->getTexture(name);
+		const bool hwGamma = firstTexture->getProperties().isHardwareGammaEnabled();
+
+		MipMapGenOptions mipOptions;
+		mipOptions.isSRGB = hwGamma;
+
+		const Vector<SPtr<PixelData>> mipLevels = PixelUtil::genMipmaps(*atlasData, mipOptions);
+
+		TEXTURE_DESC texDesc;
+		texDesc.width = width;
+		texDesc.height = height;
+		texDesc.format = PF_RGBA8;
+		texDesc.numMips = (UINT32)mipLevels.size() - 1;
+		texDesc.hwGamma = hwGamma;
+
+		HTexture atlas = Texture::create(texDesc);
+		for (UINT32 i = 0; i < (UINT32)mipLevels.size(); i++)
+		{
+			SPtr<PixelData> mipData = atlas->getProperties().allocBuffer(0, i);
+			PixelUtil::bulkPixelConversion(*mipLevels[i], *mipData);
+
+			atlas->writeData(mipData, 0, i);
+		}
+
+		atlas->setName("HLODAtlas");
+		return atlas;
+	}
+
+	/** Creates a copy of the first material in the group, that uses atlases of the textures of all of them. */
+	static HMaterial createAtlasMaterial(const AtlasGroup& group, const Vector<HMaterial>& materials)
+	{
+		const HMaterial& source = materials[group.entries[0].materialIdx];
+		const HShader shader = source->getShader();
+
+		HMaterial material = source->clone();
+		for (auto& entry : shader->getTextureParams())
+		{
+			if (source->getTexture(entry.first) != nullptr)
+				material->setTexture(entry.first, createAtlasTexture(group, materials, entry.first));
+		}
+
+		if (hasVec2Param(shader, UV_TILE_PARAM))
+			material->setVec2(UV_TILE_PARAM, Vector2::ONE);
+
+		if (hasVec2Param(shader, UV_OFFSET_PARAM))
+			material->setVec2(UV_OFFSET_PARAM, Vector2::ZERO);
+
+		return material;
+	}
+
+	/**
+	 * Merges materials that differ only in their textures into a single material that uses texture atlases, and remaps
+	 * the texture coordinates of the vertices using them into the atlases. Indices of the merged materials are merged
+	 * as well. Materials that can't be merged are left as is.
+	 */
+	static void atlasMaterials(MeshData& meshData, Vector<HMaterial>& materials,
+		Vector<Vector<UINT32>>& materialIndices, UINT32 maxAtlasSize)
+	{
+		if (maxAtlasSize <= ATLAS_PADDING * 2)
+			return;
+
+		const SPtr<VertexDataDesc>& layout = meshData.getVertexDesc();
+
+		const VertexElement* uvElement = nullptr;
+		for (UINT32 i = 0; i < layout->getNumElements(); i++)
+		{
+			const VertexElement& element = layout->getElement(i);
+			if (element.getSemantic() == VES_TEXCOORD && element.getSemanticIdx() == 0)
+				uvElement = &element;
+		}
+
+		if (uvElement == nullptr || uvElement->getType() != VET_FLOAT2)
+			return;
+
+		const UINT32 uvStride = layout->getVertexStride(uvElement->getStreamIdx());
+		UINT8* uvData = meshData.getElementData(VES_TEXCOORD, 0, uvElement->getStreamIdx());
+
+		// A vertex can only be remapped into a single area of the atlas, so materials sharing vertices are left as is
+		const auto numMaterials = (UINT32)materials.size();
+		Vector<UINT32> vertexMaterials(meshData.getNumVertices(), (UINT32)-1);
+		Vector<bool> sharesVertices(numMaterials, false);
+		for (UINT32 i = 0; i < numMaterials; i++)
+		{
+			for (auto& index : materialIndices[i])
+			{
+				UINT32& vertexMaterial = vertexMaterials[index];
+				if (vertexMaterial == (UINT32)-1)
+					vertexMaterial = i;
+				else if (vertexMaterial != i)
+				{
+					sharesVertices[i] = true;
+					sharesVertices[vertexMaterial] = true;
+				}
+			}
+		}
+
+		const UINT32 maxEntrySize = maxAtlasSize - ATLAS_PADDING * 2;
+
+		Vector<AtlasEntry> candidates;
+		for (UINT32 i = 0; i < numMaterials; i++)
+		{
+			AtlasEntry entry;
+			entry.materialIdx = i;
+
+			if (sharesVertices[i] || !canAtlas(materials[i], entry.width, entry.height))
+				continue;
+
+			const HShader shader = materials[i]->getShader();
+			if (hasVec2Param(shader, UV_TILE_PARAM))
+				entry.uvScale = materials[i]->getVec2(UV_TILE_PARAM);
+
+			if (hasVec2Param(shader, UV_OFFSET_PARAM))
+				entry.uvOffset = materials[i]->getVec2(UV_OFFSET_PARAM);
+
+			// Wrapped texture coordinates would sample neighboring textures in the atlas
+			bool inRange = true;
+			for (auto& index : materialIndices[i])
+			{
+				const Vector2 uv = *(Vector2*)(uvData + index * uvStride) * entry.uvScale + entry.uvOffset;
+				if (uv.x < -0.001f || uv.x > 1.001f || uv.y < -0.001f || uv.y > 1.001f)
+				{
+					inRange = false;
+					break;
+				}
+			}
+
+			if (!inRange)
+				continue;
+
+			if (entry.width > maxEntrySize || entry.height > maxEntrySize)
+			{
+				const float scale = maxEntrySize / (float)std::max(entry.width, entry.height);
+				entry.width = std::max((UINT32)(entry.width * scale), 1U);
+				entry.height = std::max((UINT32)(entry.height * scale), 1U);
+			}
+
+			candidates.push_back(entry);
+		}
+
+		// Atlas layout works best when elements are added from largest to smallest
+		std::sort(candidates.begin(), candidates.end(),
+			[](const AtlasEntry& a, const AtlasEntry& b) { return a.width * a.height > b.width * b.height; });
+
+		Vector<AtlasGroup> groups;
+		for (auto& entry : candidates)
+		{
+			const UINT32 paddedWidth = entry.width + ATLAS_PADDING * 2;
+			const UINT32 paddedHeight = entry.height + ATLAS_PADDING * 2;
+
+			bool added = false;
+			for (auto& group : groups)
+			{
+				if (!canShareAtlas(materials[group.entries[0].materialIdx], materials[entry.materialIdx]))
+					continue;
+
+				if (group.layout.addElement(paddedWidth, paddedHeight, entry.x, entry.y))
+				{
+					group.entries.push_back(entry);
+					added = true;
+					break;
+				}
+			}
+
+			if (added)
+				continue;
+
+			AtlasGroup group;
+			group.layout = TextureAtlasLayout(0, 0, maxAtlasSize, maxAtlasSize);
+			if (group.layout.addElement(paddedWidth, paddedHeight, entry.x, entry.y))
+			{
+				group.entries.push_back(entry);
+				groups.push_back(std::move(group));
+			}
+		}
+
+		// Merging a single material would only cost texture memory
+		Vector<UINT32> materialGroups(numMaterials, (UINT32)-1);
+		Vector<const AtlasEntry*> materialEntries(numMaterials, nullptr);
+		for (UINT32 i = 0; i < (UINT32)groups.size(); i++)
+		{
+			if (groups[i].entries.size() < 2)
+				continue;
+
+			for (auto& entry : groups[i].entries)
+			{
+				materialGroups[entry.materialIdx] = i;
+				materialEntries[entry.materialIdx] = &entry;
+			}
+		}
+
+		for (UINT32 i = 0; i < meshData.getNumVertices(); i++)
+		{
+			const UINT32 materialIdx = vertexMaterials[i];
+			if (materialIdx == (UINT32)-1 || materialEntries[materialIdx] == nullptr)
+				continue;
+
+			const AtlasEntry& entry = *materialEntries[materialIdx];
+			const TextureAtlasLayout& atlasLayout = groups[materialGroups[materialIdx]].layout;
+
+			Vector2& uv = *(Vector2*)(uvData + i * uvStride);
+			const Vector2 transformed = uv * entry.uvScale + entry.uvOffset;
+
+			uv.x = (entry.x + ATLAS_PADDING + Math::clamp01(transformed.x) * entry.width) / atlasLayout.getWidth();
+			uv.y = (entry.y + ATLAS_PADDING + Math::clamp01(transformed.y) * entry.height) / atlasLayout.getHeight();
+		}
+
+		// Merged materials are drawn where the first material of the group was
+		Vector<HMaterial> mergedMaterials;
+		Vector<Vector<UINT32>> mergedIndices;
+		Vector<UINT32> groupSlots(groups.size(), (UINT32)-1);
+		for (UINT32 i = 0; i < numMaterials; i++)
+		{
+			const UINT32 groupIdx = materialGroups[i];
+			if (groupIdx == (UINT32)-1)
+			{
+				mergedMaterials.push_back(materials[i]);
+				mergedIndices.push_back(std::move(materialIndices[i]));
+				continue;
+			}
+
+			if (groupSlots[groupIdx] == (UINT32)-1)
+			{
+				groupSlots[groupIdx] = (UINT32)mergedMaterials.size();
+				mergedMaterials.push_back(createAtlasMaterial(groups[groupIdx], materials));
+				mergedIndices.push_back(Vector<UINT32>());
+			}
+
+			Vector<UINT32>& indices = mergedIndices[groupSlots[groupIdx]];
+			indices.insert(indices.end(), materialIndices[i].begin(), materialIndices[i].end());
+		}
+
+		materials = std::move(mergedMaterials);
+		materialIndices = std::move(mergedIndices);
+	}
+
+	Vector<HLODBuilder::Cluster> HLODBuilder::build(const Vector<HRenderable>& renderables, const HLOD_DESC& desc,
+		const HSceneObject& parent)
+	{
+		Vector<SPtr<VertexDataDesc>> layouts;
+
+		// Renderables are grouped by grid cell, layer and vertex layout
+		using ClusterKey = std::tuple<INT32, INT32, INT32, UINT64, UINT32>;
+		Map<ClusterKey, Vector<HRenderable>> groups;
+
+		const float cellSize = std::max(desc.cellSize, 0.001f);
+		for (auto& renderable : renderables)
+		{
+			if (renderable.isDestroyed() || renderable->SO()->getMobility() == ObjectMobility::Movable)
+				continue;
+
+			const SPtr<Renderable>& internal = renderable->_getInternal();
+			if (internal->isAnimated() || internal->hasDrawDistance())
+				continue;
+
+			const HMesh mesh = renderable->getMesh();
+			if (!mesh.isLoaded() || mesh->getCachedData() == nullptr)
+				continue;
+
+			const SPtr<VertexDataDesc>& layout = mesh->getCachedData()->getVertexDesc();
+			if (!isSupportedLayout(*layout))
+				continue;
+
+			UINT32 layoutIdx = 0;
+			while (layoutIdx < (UINT32)layouts.size() && !isSameLayout(*layouts[layoutIdx], *layout))
+				layoutIdx++;
+
+			if (layoutIdx == (UINT32)layouts.size())
+				layouts.push_back(layout);
+
+			const Vector3 center = renderable->getBounds().getBox().getCenter();
+			const ClusterKey key(
+				Math::floorToInt(center.x / cellSize),
+				Math::floorToInt(center.y / cellSize),
+				Math::floorToInt(center.z / cellSize),
+				renderable->getLayer(),
+				layoutIdx);
+
+			groups[key].push_back(renderable);
+		}
+
+		Vector<Cluster> clusters;
+		for (auto& entry : groups)
+		{
+			if ((UINT32)entry.second.size() < std::max(desc.minRenderables, 1U))
+				continue;
+
+			clusters.push_back(createCluster(entry.second, desc, parent));
+		}
+
+		return clusters;
+	}
+
+	void HLODBuilder::destroy(const Vector<Cluster>& clusters)
+	{
+		for (auto& cluster : clusters)
+		{
+			for (auto& renderable : cluster.renderables)
+			{
+				if (!renderable.isDestroyed())
+					renderable->setDrawDistance(Vector3::ZERO, 0.0f, 0.0f);
+			}
+
+			if (!cluster.proxy.isDestroyed())
+				cluster.proxy->destroy();
+		}
+	}
+
+	HLODBuilder::Cluster HLODBuilder::createCluster(const Vector<HRenderable>& renderables, const HLOD_DESC& desc,
+		const HSceneObject& parent)
+	{
+		Cluster cluster;
+		cluster.renderables = renderables;
+		cluster.bounds = renderables[0]->getBounds().getBox();
+
+		for (auto& renderable : renderables)
+			cluster.bounds.merge(renderable->getBounds().getBox());
+
+		const Vector3 origin = cluster.bounds.getCenter();
+		const Matrix4 toProxySpace = Matrix4::translation(-origin);
+
+		// Gather indices of all sub-meshes using the same material, so each material is drawn using a single sub-mesh
+		Vector<HMaterial> materials;
+		Vector<Vector<UINT32>> materialIndices;
+
+		UINT32 numVertices = 0;
+		for (auto& renderable : renderables)
+		{
+			const HMesh mesh = renderable->getMesh();
+			const SPtr<MeshData>& meshData = mesh->getCachedData();
+			const MeshProperties& meshProps = mesh->getProperties();
+			const Vector<HMaterial>& renderableMaterials = renderable->getMaterials();
+
+			for (UINT32 i = 0; i < meshProps.getNumSubMeshes(); i++)
+			{
+				const SubMesh& subMesh = meshProps.getSubMesh(i);
+				if (subMesh.drawOp != DOT_TRIANGLE_LIST)
+					continue;
+
+				// Sub-meshes without their own material use the primary material
+				HMaterial material;
+				if (i < (UINT32)renderableMaterials.size() && renderableMaterials[i].isLoaded())
+					material = renderableMaterials[i];
+				else if (!renderableMaterials.empty() && renderableMaterials[0].isLoaded())
+					material = renderableMaterials[0];
+				else
+					continue;
+
+				const auto iterFind = std::find(materials.begin(), materials.end(), material);
+				const auto materialIdx = (UINT32)(iterFind - materials.begin());
+				if (iterFind == materials.end())
+				{
+					materials.push_back(material);
+					materialIndices.push_back(Vector<UINT32>());
+				}
+
+				Vector<UINT32>& indices = materialIndices[materialIdx];
+				for (UINT32 j = subMesh.indexOffset; j < subMesh.indexOffset + subMesh.indexCount; j++)
+				{
+					const UINT32 index = meshData->getIndexType() == IT_16BIT ? meshData->getIndices16()[j] :
+						meshData->getIndices32()[j];
+
+					indices.push_back(numVertices + index);
+				}
+
+				// Mirroring transforms flip the winding order
+				const Matrix4& worldTransform = renderable->SO()->getWorldMatrix();
+				if (worldTransform.determinant3x3() < 0.0f)
+				{
+					for (size_t j = indices.size() - subMesh.indexCount; j + 2 < indices.size(); j += 3)
+						std::swap(indices[j + 1], indices[j + 2]);
+				}
+			}
+
+			numVertices += meshData->getNumVertices();
+		}
+
+		UINT32 numIndices = 0;
+		for (auto& indices : materialIndices)
+			numIndices += (UINT32)indices.size();
+
+		const SPtr<VertexDataDesc>& layout = renderables[0]->getMesh()->getCachedData()->getVertexDesc();
+		SPtr<MeshData> proxyData = MeshData::create(numVertices, numIndices, layout, IT_32BIT);
+
+		Vector<UINT32> streams;
+		for (UINT32 i = 0; i < layout->getNumElements(); i++)
+		{
+			const UINT32 streamIdx = layout->getElement(i).getStreamIdx();
+			if (std::find(streams.begin(), streams.end(), streamIdx) == streams.end())
+				streams.push_back(streamIdx);
+		}
+
+		// Copy vertices of all the renderables, transformed relative to the cluster origin
+		UINT32 vertexOffset = 0;
+		for (auto& renderable : renderables)
+		{
+			const SPtr<MeshData>& meshData = renderable->getMesh()->getCachedData();
+			for (auto& streamIdx : streams)
+			{
+				UINT8* dst = proxyData->getStreamData(streamIdx) + vertexOffset * layout->getVertexStride(streamIdx);
+				memcpy(dst, meshData->getStreamData(streamIdx), meshData->getStreamSize(streamIdx));
+			}
+
+			const Matrix4 transform = toProxySpace * renderable->SO()->getWorldMatrix();
+			transformVertices(*proxyData, vertexOffset, meshData->getNumVertices(), transform);
+
+			vertexOffset += meshData->getNumVertices();
+		}
+
+		atlasMaterials(*proxyData, materials, materialIndices, desc.maxAtlasSize);
+
+		MESH_DESC meshDesc;
+		meshDesc.numVertices = numVertices;
+		meshDesc.numIndices = numIndices;
+		meshDesc.vertexDesc = layout;
+		meshDesc.indexType = IT_32BIT;
+
+		UINT32* proxyIndices = proxyData->getIndices32();
+		UINT32 indexOffset = 0;
+		for (auto& indices : materialIndices)
+		{
+			memcpy(proxyIndices + indexOffset, indices.data(), indices.size() * sizeof(UINT32));
+			meshDesc.subMeshes.push_back(SubMesh(indexOffset, (UINT32)indices.size(), DOT_TRIANGLE_LIST));
+
+			indexOffset += (UINT32)indices.size();
+		}
+
+		cluster.proxy = SceneObject::create("HLOD");
+		if (parent != nullptr)
+			cluster.proxy->setParent(parent);
+
+		cluster.proxy->setWorldPosition(origin);
+		cluster.proxy->setMobility(ObjectMobility::Static);
+
+		HRenderable proxyRenderable = cluster.proxy->addComponent<CRenderable>();
+		proxyRenderable->setMesh(Mesh::create(proxyData, meshDesc));
+		proxyRenderable->setMaterials(materials);
+		proxyRenderable->setLayer(renderables[0]->getLayer());
+		proxyRenderable->setDrawDistance(origin, desc.switchDistance, 0.0f);
+
+		for (auto& renderable : renderables)
+			renderable->setDrawDistance(origin, 0.0f, desc.switchDistance);
+
+		return cluster;
+	}
+}
@@ -0,0 +1,96 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsAABox.h"
+
+namespace bs
+{
+	/** @addtogroup Renderer
+	 *  @{
+	 */
+
+	/** Options controlling how are renderables grouped into hierarchical levels of detail by HLODBuilder. */
+	struct HLOD_DESC
+	{
+		/** Size of the grid cells renderables are clustered by, in world units. */
+		float cellSize = 50.0f;
+
+		/**
+		 * Distance from the center of a cluster from which on the cluster's proxy is drawn instead of the clustered
+		 * renderables.
+		 */
+		float switchDistance = 150.0f;
+
+		/** Minimum number of renderables a cluster must contain for a proxy to be created for it. */
+		UINT32 minRenderables = 2;
+
+		/**
+		 * Maximum width and height of the texture atlases created for the proxies, in pixels. Set to zero to disable
+		 * atlasing, in which case each proxy is drawn with one draw call per unique material.
+		 */
+		UINT32 maxAtlasSize = 2048;
+	};
+
+	/**
+	 * Builds hierarchical levels of detail for static scenery. Renderables are clustered spatially, and the meshes of
+	 * each cluster are merged into a single proxy mesh, with one sub-mesh per unique material used by the cluster. Past
+	 * the switch distance the proxy is drawn instead of the clustered renderables, replacing their draw calls with one
+	 * per material. Swapping is performed by the renderer, through Renderable::setDrawDistance().
+	 *
+	 * Materials of a cluster that differ only in their textures are merged into a single material, whose textures are
+	 * atlases of the original ones, so the proxy needs a single draw call for all of them. This requires the materials
+	 * to use the same shader and variation, have the same values for all non-texture parameters (except for gUVTile
+	 * and gUVOffset, which get baked into the texture coordinates), and to only use 2D textures whose data is cached on
+	 * the CPU (i.e. created or imported with TU_CPUCACHED usage) and isn't compressed. Textures must be sampled using
+	 * the first set of texture coordinates, and those must not wrap. Materials that don't qualify keep their own
+	 * sub-mesh.
+	 *
+	 * Only renderables that can't move, aren't animated and whose meshes have their data cached on the CPU (i.e. were
+	 * created or imported with MU_CPUCACHED usage) can be clustered. Renderables are only clustered with others on the
+	 * same layers, whose meshes have the same vertex layout.
+	 */
+	class BS_CORE_EXPORT HLODBuilder
+	{
+	public:
+		/** Group of renderables replaced by a single proxy. */
+		struct Cluster
+		{
+			/** Scene object containing the proxy renderable. */
+			HSceneObject proxy;
+
+			/** Renderables drawn in place of the proxy when the view is close to the cluster. */
+			Vector<HRenderable> renderables;
+
+			/** Bounds of all the renderables in the cluster, in world space. */
+			AABox bounds;
+		};
+
+		/**
+		 * Clusters the provided renderables and creates proxies for them. Renderables that cannot be clustered, or end
+		 * up in clusters with too few renderables, are left as is.
+		 *
+		 * @param[in]	renderables		Renderables to cluster.
+		 * @param[in]	desc			Options controlling the clustering.
+		 * @param[in]	parent			Scene object to parent the created proxy scene objects to. If not provided they
+		 *								are created at the scene root.
+		 * @return						Created clusters.
+		 */
+		static Vector<Cluster> build(const Vector<HRenderable>& renderables, const HLOD_DESC& desc = HLOD_DESC(),
+			const HSceneObject& parent = HSceneObject());
+
+		/**
+		 * Destroys the proxies of the provided clusters, and makes the clustered renderables drawn at all distances
+		 * again. Use before re-building the clusters after the scenery changes.
+		 */
+		static void destroy(const Vector<Cluster>& clusters);
+
+	private:
+		/** Creates the proxy mesh and scene object for the provided renderables. */
+		static Cluster createCluster(const Vector<HRenderable>& renderables, const HLOD_DESC& desc,
+			const HSceneObject& parent);
+	};
+
+	/** @} */
+}
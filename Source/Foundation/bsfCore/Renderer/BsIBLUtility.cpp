@@ -2,12 +2,23 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Renderer/BsIBLUtility.h"
 #include "Math/BsVector2I.h"
+#include "Image/BsTexture.h"
+#include "RenderAPI/BsRenderAPI.h"
 
 namespace bs { namespace ct
 {
 	const UINT32 IBLUtility::REFLECTION_CUBEMAP_SIZE = 256;
 	const UINT32 IBLUtility::IRRADIANCE_CUBEMAP_SIZE = 32;
 
+	INT32 IBLUtility::getSpecularCubemapUsage()
+	{
+		INT32 usage = TU_STATIC | TU_RENDERTARGET;
+		if (RenderAPI::instance().getCapabilities(0).hasCapability(RSC_COMPUTE_PROGRAM))
+			usage |= TU_LOADSTORE;
+
+		return usage;
+	}
+
 	/** Returns the size of the texture required to store the provided number of SH coefficients. */
 	Vector2I IBLUtility::getSHCoeffTextureSize(UINT32 numCoeffSets, UINT32 shOrder)
 	{
@@ -26,6 +26,21 @@ namespace bs { namespace ct
 		 */
 		virtual void filterCubemapForSpecular(const SPtr<Texture>& cubemap, const SPtr<Texture>& scratch) const = 0;
 
+		/**
+		 * Performs a single step of filterCubemapForSpecular(), allowing the filtering to be spread over multiple
+		 * frames. Step 0 prepares the scratch cubemap, and every following step filters a single mip level of the
+		 * cubemap. Steps must be executed in order, with the same scratch cubemap.
+		 *
+		 * @param[in, out]	cubemap		Cubemap to filter. Its mip level 0 will be read, filtered and written into
+		 *								other mip levels.
+		 * @param[in]		scratch		Temporary cubemap texture to use for the filtering process. Must match the size
+		 *								of the source cubemap.
+		 * @param[in]		step		Index of the step to execute.
+		 * @return						True if this was the last step of the filtering.
+		 */
+		virtual bool filterCubemapForSpecular(const SPtr<Texture>& cubemap, const SPtr<Texture>& scratch, 
+			UINT32 step) const = 0;
+
 		/**
 		 * Performs filtering on the cubemap, populating the output cubemap with values that can be used for evaluating
 		 * irradiance for use in diffuse lighting. Uses order-5 SH (25 coefficients) and outputs the values in the form of
@@ -61,6 +76,13 @@ namespace bs { namespace ct
 		virtual void scaleCubemap(const SPtr<Texture>& src, UINT32 srcMip, const SPtr<Texture>& dst, UINT32 dstMip) const = 0;
 
 
+		/** 
+		 * Returns the usage flags that cubemaps filtered using filterCubemapForSpecular() should be created with.
+		 * Includes load-store usage if supported by the render API, allowing the filtering to be performed by compute
+		 * shaders.
+		 */
+		static INT32 getSpecularCubemapUsage();
+
 		/** Returns the size of the texture required to store the provided number of SH coefficient sets. */
 		static Vector2I getSHCoeffTextureSize(UINT32 numCoeffSets, UINT32 shOrder);
 		
@@ -95,57 +95,75 @@ namespace bs
 		cubemapDesc.width = ct::IBLUtility::REFLECTION_CUBEMAP_SIZE;
 		cubemapDesc.height = ct::IBLUtility::REFLECTION_CUBEMAP_SIZE;
 		cubemapDesc.numMips = PixelUtil::getMaxMipmaps(cubemapDesc.width, cubemapDesc.height, 1, cubemapDesc.format);
-		cubemapDesc.usage = TU_STATIC | TU_RENDERTARGET;
+		cubemapDesc.usage = ct::IBLUtility::getSpecularCubemapUsage();
 
-		mFilteredTexture = Texture::_createPtr(cubemapDesc);
+		// Note: The current filtered texture remains in use until the new one is fully captured and filtered
+		SPtr<Texture> filteredTexture = Texture::_createPtr(cubemapDesc);
 
-		auto renderComplete = [this]()
+		auto renderComplete = [this, filteredTexture]()
 		{
+			mFilteredTexture = filteredTexture;
 			mRendererTask = nullptr;
 		};
 
 		SPtr<ct::ReflectionProbe> coreProbe = getCore();
-		SPtr<ct::Texture> coreTexture = mFilteredTexture->getCore();
+		SPtr<ct::Texture> coreTexture = filteredTexture->getCore();
+		SPtr<ct::Texture> coreScratch;
 
-		if (mCustomTexture == nullptr)
+		SPtr<ct::Texture> coreCustomTex;
+		if (mCustomTexture != nullptr)
+			coreCustomTex = mCustomTexture->getCore();
+
+		// Capture one face per step (or scale the custom texture in a single step), followed by filtering steps that
+		// each filter a single mip level. The renderer decides how many steps run per frame, and in which order.
+		const UINT32 numCaptureSteps = coreCustomTex ? 1 : 6;
+		UINT32 step = 0;
+
+		auto updateReflProbe = [coreCustomTex, coreTexture, coreScratch, coreProbe, cubemapDesc, numCaptureSteps, 
+			step]() mutable
 		{
-			auto renderReflProbe = [coreTexture, coreProbe]()
+			if (!ct::gRenderer()->_requestReflectionProbeUpdateStep(*coreProbe))
+				return false;
+
+			if (step < numCaptureSteps)
 			{
-				float radius = coreProbe->mType == ReflectionProbeType::Sphere ? coreProbe->mRadius : 
-					coreProbe->mExtents.length();
+				if (coreCustomTex)
+					ct::gIBLUtility().scaleCubemap(coreCustomTex, 0, coreTexture, 0);
+				else
+				{
+					float radius = coreProbe->mType == ReflectionProbeType::Sphere ? coreProbe->mRadius :
+						coreProbe->mExtents.length();
+
+					ct::CaptureSettings settings;
+					settings.encodeDepth = true;
+					settings.depthEncodeNear = radius;
+					settings.depthEncodeFar = radius + 1; // + 1 arbitrary, make it a customizable value?
 
-				ct::CaptureSettings settings;
-				settings.encodeDepth = true;
-				settings.depthEncodeNear = radius;
-				settings.depthEncodeFar = radius + 1; // + 1 arbitrary, make it a customizable value?
+					ct::gRenderer()->captureSceneCubeMapFace(coreTexture, step, coreProbe->getTransform().getPosition(),
+						settings);
+				}
 
-				ct::gRenderer()->captureSceneCubeMap(coreTexture, coreProbe->getTransform().getPosition(), settings);
-				ct::gIBLUtility().filterCubemapForSpecular(coreTexture, nullptr);
+				step++;
+				return false;
+			}
 
-				coreProbe->mFilteredTexture = coreTexture;
-				ct::gRenderer()->notifyReflectionProbeUpdated(coreProbe.get(), true);
+			if (coreScratch == nullptr)
+				coreScratch = ct::Texture::create(cubemapDesc);
 
-				return true;
-			};
+			const UINT32 filterStep = step - numCaptureSteps;
+			const bool filtered = ct::gIBLUtility().filterCubemapForSpecular(coreTexture, coreScratch, filterStep);
+			step++;
 
-			mRendererTask = ct::RendererTask::create("ReflProbeRender", renderReflProbe);
-		}
-		else
-		{
-			SPtr<ct::Texture> coreCustomTex = mCustomTexture->getCore();
-			auto filterReflProbe = [coreCustomTex, coreTexture, coreProbe]()
-			{
-				ct::gIBLUtility().scaleCubemap(coreCustomTex, 0, coreTexture, 0);
-				ct::gIBLUtility().filterCubemapForSpecular(coreTexture, nullptr);
+			if (!filtered)
+				return false;
 
-				coreProbe->mFilteredTexture = coreTexture;
-				ct::gRenderer()->notifyReflectionProbeUpdated(coreProbe.get(), true);
+			coreProbe->mFilteredTexture = coreTexture;
+			ct::gRenderer()->notifyReflectionProbeUpdated(coreProbe.get(), true);
 
-				return true;
-			};
+			return true;
+		};
 
-			mRendererTask = ct::RendererTask::create("ReflProbeRender", filterReflProbe);
-		}
+		mRendererTask = ct::RendererTask::create("ReflProbeRender", updateReflProbe);
 
 		mRendererTask->onComplete.connect(renderComplete);
 		ct::gRenderer()->addTask(mRendererTask);
@@ -206,6 +206,7 @@ namespace bs
 		p(exposureScale);
 		p(gamma);
 		p(enableFXAA);
+		p(enableTemporalAA);
 		p(enableHDR);
 		p(enableLighting);
 		p(enableShadows);
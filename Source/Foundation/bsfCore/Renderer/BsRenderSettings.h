@@ -608,6 +608,17 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		bool enableFXAA = true;
 
+		/**
+		 * Enables temporal anti-aliasing. The projection is offset by a different sub-pixel amount every frame, and the
+		 * rendered image is accumulated with the image of the previous frames, reprojected according to the camera
+		 * movement. When the view is rendered at a reduced resolution (see dynamic resolution option of the renderer)
+		 * the accumulated image is output at full resolution, yielding better quality than simple upscaling.
+		 *
+		 * Only supported for views that don't use MSAA, and usually makes FXAA unnecessary.
+		 */
+		BS_SCRIPT_EXPORT()
+		bool enableTemporalAA = false;
+
 		/**
 		 * Log2 value to scale the eye adaptation by (for example 2^0 = 1). Smaller values yield darker image, while larger
 		 * yield brighter image. Allows you to customize exposure manually, applied on top of eye adaptation exposure (if
@@ -5,6 +5,7 @@
 #include "Scene/BsSceneObject.h"
 #include "Mesh/BsMesh.h"
 #include "Material/BsMaterial.h"
+#include "Image/BsTexture.h"
 #include "Math/BsBounds.h"
 #include "Renderer/BsRenderer.h"
 #include "Animation/BsAnimation.h"
@@ -132,6 +133,77 @@ namespace bs
 		_markCoreDirty();
 	}
 
+	template<bool Core>
+	void TRenderable<Core>::setLODScreenSizes(const Vector<float>& sizes)
+	{
+		mLODScreenSizes = sizes;
+		_markCoreDirty();
+	}
+
+	template<bool Core>
+	void TRenderable<Core>::setDrawDistance(const Vector3& origin, float minDistance, float maxDistance)
+	{
+		mDrawDistanceOrigin = origin;
+		mMinDrawDistance = std::max(minDistance, 0.0f);
+		mMaxDrawDistance = std::max(maxDistance, 0.0f);
+		_markCoreDirty();
+	}
+
+	template<bool Core>
+	void TRenderable<Core>::setCastsShadows(bool enable)
+	{
+		if (mCastsShadows == enable)
+			return;
+
+		mCastsShadows = enable;
+		_markCoreDirty();
+	}
+
+	template<bool Core>
+	void TRenderable<Core>::setTextureOverride(RenderableTexture slot, const TextureType& texture)
+	{
+		mTextureOverrides[(UINT32)slot] = texture;
+
+		_markDependenciesDirty();
+		_markResourcesDirty();
+		_markCoreDirty();
+	}
+
+	template<bool Core>
+	bool TRenderable<Core>::hasTextureOverrides() const
+	{
+		for (auto& entry : mTextureOverrides)
+		{
+			if (entry != nullptr)
+				return true;
+		}
+
+		return false;
+	}
+
+	template<bool Core>
+	UINT32 TRenderable<Core>::getLOD(float screenSize) const
+	{
+		UINT32 lod = 0;
+		if(mLODScreenSizes.empty())
+		{
+			// No thresholds provided, halve the threshold for each subsequent LOD
+			float threshold = 0.5f;
+			while (screenSize < threshold && lod < 16)
+			{
+				threshold *= 0.5f;
+				lod++;
+			}
+		}
+		else
+		{
+			while (lod < (UINT32)mLODScreenSizes.size() && screenSize < mLODScreenSizes[lod])
+				lod++;
+		}
+
+		return lod;
+	}
+
 	template class TRenderable < false >;
 	template class TRenderable < true >;
 
@@ -307,11 +379,17 @@ namespace bs
 				rttiGetElemSize(mLayer) +
 				rttiGetElemSize(mOverrideBounds) +
 				rttiGetElemSize(mUseOverrideBounds) +
+				rttiGetElemSize(mLODScreenSizes) +
+				rttiGetElemSize(mDrawDistanceOrigin) +
+				rttiGetElemSize(mMinDrawDistance) +
+				rttiGetElemSize(mMaxDrawDistance) +
+				rttiGetElemSize(mCastsShadows) +
 				rttiGetElemSize(numMaterials) +
 				rttiGetElemSize(animationId) +
 				rttiGetElemSize(mAnimType) +
 				sizeof(SPtr<ct::Mesh>) +
-				numMaterials * sizeof(SPtr<ct::Material>);
+				numMaterials * sizeof(SPtr<ct::Material>) +
+				(UINT32)RenderableTexture::Count * sizeof(SPtr<ct::Texture>);
 		}
 
 
@@ -326,6 +404,11 @@ namespace bs
 			dataPtr = rttiWriteElem(mLayer, dataPtr);
 			dataPtr = rttiWriteElem(mOverrideBounds, dataPtr);
 			dataPtr = rttiWriteElem(mUseOverrideBounds, dataPtr);
+			dataPtr = rttiWriteElem(mLODScreenSizes, dataPtr);
+			dataPtr = rttiWriteElem(mDrawDistanceOrigin, dataPtr);
+			dataPtr = rttiWriteElem(mMinDrawDistance, dataPtr);
+			dataPtr = rttiWriteElem(mMaxDrawDistance, dataPtr);
+			dataPtr = rttiWriteElem(mCastsShadows, dataPtr);
 			dataPtr = rttiWriteElem(numMaterials, dataPtr);
 			dataPtr = rttiWriteElem(animationId, dataPtr);
 			dataPtr = rttiWriteElem(mAnimType, dataPtr);
@@ -344,6 +427,15 @@ namespace bs
 
 				dataPtr += sizeof(SPtr<ct::Material>);
 			}
+
+			for (auto& entry : mTextureOverrides)
+			{
+				SPtr<ct::Texture>* texture = new (dataPtr) SPtr<ct::Texture>();
+				if (entry.isLoaded())
+					*texture = entry->getCore();
+
+				dataPtr += sizeof(SPtr<ct::Texture>);
+			}
 		}
 
 		return CoreSyncData(data, size);
@@ -359,6 +451,12 @@ namespace bs
 			if (material.isLoaded())
 				dependencies.push_back(material.get());
 		}
+
+		for (auto& entry : mTextureOverrides)
+		{
+			if (entry.isLoaded())
+				dependencies.push_back(entry.get());
+		}
 	}
 
 	void Renderable::onDependencyDirty(CoreObject* dependency, UINT32 dirtyFlags)
@@ -383,6 +481,12 @@ namespace bs
 			if (material != nullptr)
 				resources.push_back(material);
 		}
+
+		for (auto& entry : mTextureOverrides)
+		{
+			if (entry != nullptr)
+				resources.push_back(entry);
+		}
 	}
 
 	void Renderable::notifyResourceLoaded(const HResource& resource)
@@ -526,24 +630,150 @@ namespace bs
 			UINT32 vertexSize = sizeof(Vector3) + sizeof(UINT32);
 			UINT32 numVertices = morphShapes->getNumVertices();
 
+			// When blending on the GPU the buffer is written to by a compute shader instead of being mapped
+			const bool gpuMorphShapes = gRenderer()->supportsGpuMorphShapes();
+
 			VERTEX_BUFFER_DESC desc;
 			desc.vertexSize = vertexSize;
 			desc.numVerts = numVertices;
-			desc.usage = GBU_DYNAMIC;
+			desc.usage = gpuMorphShapes ? GBU_LOADSTORE : GBU_DYNAMIC;
 
 			SPtr<VertexBuffer> vertexBuffer = VertexBuffer::create(desc);
 
 			UINT32 totalSize = vertexSize * numVertices;
-			UINT8* dest = (UINT8*)vertexBuffer->lock(0, totalSize, GBL_WRITE_ONLY_DISCARD);
-			memset(dest, 0, totalSize);
-			vertexBuffer->unlock();
+			if (gpuMorphShapes)
+			{
+				Vector<UINT8> zeroes(totalSize, 0);
+				vertexBuffer->writeData(0, totalSize, zeroes.data(), BWT_DISCARD);
+			}
+			else
+			{
+				UINT8* dest = (UINT8*)vertexBuffer->lock(0, totalSize, GBL_WRITE_ONLY_DISCARD);
+				memset(dest, 0, totalSize);
+				vertexBuffer->unlock();
+			}
 
 			mMorphShapeBuffer = vertexBuffer;
+
+			if (gpuMorphShapes)
+				createMorphShapeGpuBuffers(*morphShapes);
+			else
+				mMorphShapeGpuBuffers = nullptr;
 		}
 		else
+		{
 			mMorphShapeBuffer = nullptr;
+			mMorphShapeGpuBuffers = nullptr;
+		}
 
 		mMorphShapeVersion = 0;
+		mMorphShapeBlendPending = false;
+	}
+
+	/** Morph shape delta, as laid out in MorphShapeGpuBuffers::deltas. */
+	struct GpuMorphShapeDelta
+	{
+		Vector3 deltaPosition;
+		UINT32 shapeIdx;
+		Vector3 deltaNormal;
+		float padding;
+	};
+
+	void Renderable::createMorphShapeGpuBuffers(const MorphShapes& morphShapes)
+	{
+		const UINT32 numVertices = morphShapes.getNumVertices();
+
+		// Group the deltas of all shapes by the vertex they affect, so each vertex can be blended by a single thread
+		Vector<UINT32> vertexRanges(numVertices * 2, 0);
+
+		UINT32 numShapes = 0;
+		UINT32 numDeltas = 0;
+		for (UINT32 i = 0; i < morphShapes.getNumChannels(); i++)
+		{
+			SPtr<MorphChannel> channel = morphShapes.getChannel(i);
+			for (UINT32 j = 0; j < channel->getNumShapes(); j++)
+			{
+				for (auto& vertex : channel->getShape(j)->getVertices())
+					vertexRanges[vertex.sourceIdx * 2 + 1]++;
+
+				numDeltas += (UINT32)channel->getShape(j)->getVertices().size();
+				numShapes++;
+			}
+		}
+
+		UINT32 offset = 0;
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			vertexRanges[i * 2] = offset;
+			offset += vertexRanges[i * 2 + 1];
+
+			// Reset the count, it gets incremented again as the deltas are written
+			vertexRanges[i * 2 + 1] = 0;
+		}
+
+		// Shapes are indexed in the same order as animation evaluation outputs their weights, channel by channel
+		Vector<GpuMorphShapeDelta> deltas(std::max(numDeltas, 1U));
+
+		UINT32 shapeIdx = 0;
+		for (UINT32 i = 0; i < morphShapes.getNumChannels(); i++)
+		{
+			SPtr<MorphChannel> channel = morphShapes.getChannel(i);
+			for (UINT32 j = 0; j < channel->getNumShapes(); j++)
+			{
+				for (auto& vertex : channel->getShape(j)->getVertices())
+				{
+					UINT32& count = vertexRanges[vertex.sourceIdx * 2 + 1];
+
+					GpuMorphShapeDelta& delta = deltas[vertexRanges[vertex.sourceIdx * 2] + count];
+					delta.deltaPosition = vertex.deltaPosition;
+					delta.shapeIdx = shapeIdx;
+					delta.deltaNormal = vertex.deltaNormal;
+					delta.padding = 0.0f;
+
+					count++;
+				}
+
+				shapeIdx++;
+			}
+		}
+
+		SPtr<MorphShapeGpuBuffers> buffers = bs_shared_ptr_new<MorphShapeGpuBuffers>();
+		buffers->numVertices = numVertices;
+
+		GPU_BUFFER_DESC rangesDesc;
+		rangesDesc.type = GBT_STANDARD;
+		rangesDesc.format = BF_32X2U;
+		rangesDesc.elementCount = std::max(numVertices, 1U);
+		rangesDesc.usage = GBU_STATIC;
+
+		buffers->vertexRanges = GpuBuffer::create(rangesDesc);
+		if (numVertices > 0)
+			buffers->vertexRanges->writeData(0, numVertices * 2 * sizeof(UINT32), vertexRanges.data(), BWT_DISCARD);
+
+		GPU_BUFFER_DESC deltasDesc;
+		deltasDesc.type = GBT_STRUCTURED;
+		deltasDesc.format = BF_UNKNOWN;
+		deltasDesc.elementSize = sizeof(GpuMorphShapeDelta);
+		deltasDesc.elementCount = (UINT32)deltas.size();
+		deltasDesc.usage = GBU_STATIC;
+
+		buffers->deltas = GpuBuffer::create(deltasDesc);
+		buffers->deltas->writeData(0, (UINT32)(deltas.size() * sizeof(GpuMorphShapeDelta)), deltas.data(), BWT_DISCARD);
+
+		GPU_BUFFER_DESC weightsDesc;
+		weightsDesc.type = GBT_STANDARD;
+		weightsDesc.format = BF_32X1F;
+		weightsDesc.elementCount = std::max(numShapes, 1U);
+		weightsDesc.usage = GBU_DYNAMIC;
+
+		buffers->weights = GpuBuffer::create(weightsDesc);
+
+		Vector<float> zeroWeights(weightsDesc.elementCount, 0.0f);
+		buffers->weights->writeData(0, weightsDesc.elementCount * sizeof(float), zeroWeights.data(), BWT_DISCARD);
+
+		buffers->output = mMorphShapeBuffer->getLoadStore(GBT_STANDARD, BF_32X1U);
+
+		mMorphShapeGpuBuffers = buffers;
 	}
 
 	void Renderable::updateAnimationBuffers(const EvaluatedAnimationData& animData)
@@ -580,15 +810,31 @@ namespace bs
 
 		if (mAnimType == RenderableAnimType::Morph || mAnimType == RenderableAnimType::SkinnedMorph)
 		{
-			if (mMorphShapeVersion != animInfo->morphShapeInfo.version)
+			const EvaluatedAnimationData::MorphShapeInfo& morphShapeInfo = animInfo->morphShapeInfo;
+			if (mMorphShapeVersion != morphShapeInfo.version)
 			{
-				SPtr<MeshData> meshData = animInfo->morphShapeInfo.meshData;
+				if (morphShapeInfo.meshData != nullptr)
+				{
+					SPtr<MeshData> meshData = morphShapeInfo.meshData;
 
-				UINT32 bufferSize = meshData->getSize();
-				UINT8* data = meshData->getData();
+					UINT32 bufferSize = meshData->getSize();
+					UINT8* data = meshData->getData();
+
+					mMorphShapeBuffer->writeData(0, bufferSize, data, BWT_DISCARD);
+				}
+				else if (mMorphShapeGpuBuffers != nullptr && !morphShapeInfo.weights.empty())
+				{
+					// Only the weights are uploaded, the renderer blends the shapes in a compute pass
+					const UINT32 numWeights = std::min((UINT32)morphShapeInfo.weights.size(),
+						mMorphShapeGpuBuffers->weights->getProperties().getElementCount());
 
-				mMorphShapeBuffer->writeData(0, bufferSize, data, BWT_DISCARD);
-				mMorphShapeVersion = animInfo->morphShapeInfo.version;
+					mMorphShapeGpuBuffers->weights->writeData(0, numWeights * sizeof(float),
+						morphShapeInfo.weights.data(), BWT_DISCARD);
+
+					mMorphShapeBlendPending = true;
+				}
+
+				mMorphShapeVersion = morphShapeInfo.version;
 			}
 		}
 	}
@@ -614,6 +860,11 @@ namespace bs
 			dataPtr = rttiReadElem(mLayer, dataPtr);
 			dataPtr = rttiReadElem(mOverrideBounds, dataPtr);
 			dataPtr = rttiReadElem(mUseOverrideBounds, dataPtr);
+			dataPtr = rttiReadElem(mLODScreenSizes, dataPtr);
+			dataPtr = rttiReadElem(mDrawDistanceOrigin, dataPtr);
+			dataPtr = rttiReadElem(mMinDrawDistance, dataPtr);
+			dataPtr = rttiReadElem(mMaxDrawDistance, dataPtr);
+			dataPtr = rttiReadElem(mCastsShadows, dataPtr);
 			dataPtr = rttiReadElem(numMaterials, dataPtr);
 			dataPtr = rttiReadElem(mAnimationId, dataPtr);
 			dataPtr = rttiReadElem(mAnimType, dataPtr);
@@ -630,6 +881,14 @@ namespace bs
 				material->~SPtr<Material>();
 				dataPtr += sizeof(SPtr<Material>);
 			}
+
+			for (auto& entry : mTextureOverrides)
+			{
+				SPtr<Texture>* texture = (SPtr<Texture>*)dataPtr;
+				entry = *texture;
+				texture->~SPtr<Texture>();
+				dataPtr += sizeof(SPtr<Texture>);
+			}
 		}
 
 		UINT32 updateEverythingFlag = (UINT32)ActorDirtyFlag::Everything 
@@ -28,6 +28,16 @@ namespace bs
 		Count // Keep at end
 	};
 
+	/** Textures of the standard surface material that can be overridden per renderable. */
+	enum class RenderableTexture
+	{
+		Albedo,
+		Normal,
+		Roughness,
+		Metalness,
+		Count // Keep at end
+	};
+
 	/**
 	 * Renderable represents any visible object in the scene. It has a mesh, bounds and a set of materials. Renderer will
 	 * render any Renderable objects visible by a camera.
@@ -37,6 +47,7 @@ namespace bs
 	{
 		using MeshType = CoreVariantHandleType<Mesh, Core>;
 		using MaterialType = CoreVariantHandleType<Material, Core>;
+		using TextureType = CoreVariantHandleType<Texture, Core>;
 
 	public:
 		TRenderable();
@@ -95,6 +106,71 @@ namespace bs
 		 */
 		void setUseOverrideBounds(bool enable);
 
+		/**
+		 * Determines the screen size thresholds at which the renderer switches to lower levels of detail of the mesh. 
+		 * Screen size is the diameter of the object's bounding sphere relative to the viewport height. Entry at index 0
+		 * is the threshold below which LOD 1 is used, index 1 for LOD 2 and so on. Sizes should be in decreasing order.
+		 * If empty, the size is halved for each subsequent LOD, starting at 0.5. Only relevant if the mesh contains more
+		 * than one level of detail.
+		 */
+		void setLODScreenSizes(const Vector<float>& sizes);
+
+		/** @copydoc setLODScreenSizes() */
+		const Vector<float>& getLODScreenSizes() const { return mLODScreenSizes; }
+
+		/** 
+		 * Returns the level of detail to use for a specific screen size, as described by setLODScreenSizes(). The 
+		 * returned level is not clamped to the number of levels available in the mesh.
+		 */
+		UINT32 getLOD(float screenSize) const;
+
+		/**
+		 * Determines the range of distances from the view at which the renderable is drawn. Distance is measured from
+		 * the view origin to @p origin. Used for hierarchical levels of detail, where a group of renderables is
+		 * replaced by a single proxy renderable beyond a certain distance. Using the same origin for all of them, and
+		 * the maximum distance of the group as the minimum distance of the proxy, ensures exactly one of them is drawn
+		 * at any distance.
+		 *
+		 * @param[in]	origin			Point to measure the distance to, in world space.
+		 * @param[in]	minDistance		Distance from which on the renderable is drawn.
+		 * @param[in]	maxDistance		Distance from which on the renderable is no longer drawn. Zero for no limit.
+		 */
+		void setDrawDistance(const Vector3& origin, float minDistance, float maxDistance);
+
+		/** Returns the point the draw distance is measured to. See setDrawDistance(). */
+		const Vector3& getDrawDistanceOrigin() const { return mDrawDistanceOrigin; }
+
+		/** Returns the distance from which on the renderable is drawn. See setDrawDistance(). */
+		float getMinDrawDistance() const { return mMinDrawDistance; }
+
+		/** Returns the distance from which on the renderable is no longer drawn, or zero for no limit. */
+		float getMaxDrawDistance() const { return mMaxDrawDistance; }
+
+		/** Checks is the renderable only drawn within a range of distances. See setDrawDistance(). */
+		bool hasDrawDistance() const { return mMinDrawDistance > 0.0f || mMaxDrawDistance > 0.0f; }
+
+		/**
+		 * Determines is the renderable drawn into shadow maps. Shadow maps are rendered using the renderer's own
+		 * shaders, so this should be disabled for renderables whose material moves the vertices.
+		 */
+		void setCastsShadows(bool enable);
+
+		/** @copydoc setCastsShadows() */
+		bool getCastsShadows() const { return mCastsShadows; }
+
+		/**
+		 * Overrides a texture of the standard surface material, for this renderable only. Renderables using the same
+		 * material but different texture overrides can still be drawn together using instancing, with the textures read
+		 * from the renderer's global texture table. Set to null to use the material's texture.
+		 */
+		void setTextureOverride(RenderableTexture slot, const TextureType& texture);
+
+		/** @copydoc setTextureOverride() */
+		const TextureType& getTextureOverride(RenderableTexture slot) const { return mTextureOverrides[(UINT32)slot]; }
+
+		/** Checks does the renderable override any of the material's textures. See setTextureOverride(). */
+		bool hasTextureOverrides() const;
+
 		/** @copydoc setLayer() */
 		UINT64 getLayer() const { return mLayer; }
 
@@ -132,6 +208,12 @@ namespace bs
 		UINT64 mLayer = 1;
 		AABox mOverrideBounds;
 		bool mUseOverrideBounds = false;
+		Vector<float> mLODScreenSizes;
+		Vector3 mDrawDistanceOrigin = Vector3::ZERO;
+		float mMinDrawDistance = 0.0f;
+		float mMaxDrawDistance = 0.0f;
+		bool mCastsShadows = true;
+		TextureType mTextureOverrides[(UINT32)RenderableTexture::Count];
 		Matrix4 mTfrmMatrix = BsIdentity;
 		Matrix4 mTfrmMatrixNoScale = BsIdentity;
 		RenderableAnimType mAnimType = RenderableAnimType::None;
@@ -230,6 +312,28 @@ namespace bs
 
 	namespace ct
 	{
+	/** 
+	 * Buffers used for blending morph shapes on the GPU. Morph shape deltas are uploaded once, grouped per vertex, so
+	 * only the shape weights need to be uploaded every frame.
+	 */
+	struct MorphShapeGpuBuffers
+	{
+		/** First entry in @p deltas and number of entries, for each morph shape vertex. */
+		SPtr<GpuBuffer> vertexRanges;
+
+		/** Position and normal deltas of all morph shapes, along with the index of their shape. */
+		SPtr<GpuBuffer> deltas;
+
+		/** Current weight of every morph shape. */
+		SPtr<GpuBuffer> weights;
+
+		/** Load-store view of the morph shape vertex buffer, the blended vertices are written to. */
+		SPtr<GpuBuffer> output;
+
+		/** Number of morph shape vertices. */
+		UINT32 numVertices = 0;
+	};
+
 	/** @copydoc TRenderable */
 	class BS_CORE_EXPORT Renderable : public CoreObject, public TRenderable<true>
 	{
@@ -266,6 +370,21 @@ namespace bs
 		/** Returns vertex declaration used for rendering meshes containing morph shape information. */
 		const SPtr<VertexDeclaration>& getMorphVertexDeclaration() const { return mMorphVertexDeclaration; }
 
+		/** 
+		 * Returns buffers used for blending morph shapes on the GPU. Null if the renderable has no morph shapes, or the
+		 * renderer doesn't support GPU morph shapes.
+		 */
+		const MorphShapeGpuBuffers* getMorphShapeGpuBuffers() const { return mMorphShapeGpuBuffers.get(); }
+
+		/** 
+		 * Checks if morph shape weights changed in the last call to updateAnimationBuffers(), and the renderer needs to
+		 * blend the morph shapes using getMorphShapeGpuBuffers() before rendering.
+		 */
+		bool isMorphShapeBlendPending() const { return mMorphShapeBlendPending; }
+
+		/** Notifies the renderable that the renderer blended the morph shapes using the latest weights. */
+		void _notifyMorphShapesBlended() { mMorphShapeBlendPending = false; }
+
 	protected:
 		friend class bs::Renderable;
 
@@ -280,6 +399,9 @@ namespace bs
 		/** Creates any buffers required for renderable animation. Should be called whenever animation properties change. */
 		void createAnimationBuffers();
 
+		/** Creates the buffers used for blending morph shapes on the GPU, and uploads the morph shape deltas. */
+		void createMorphShapeGpuBuffers(const MorphShapes& morphShapes);
+
 		UINT32 mRendererId;
 		UINT64 mAnimationId;
 		UINT32 mMorphShapeVersion;
@@ -287,6 +409,8 @@ namespace bs
 		SPtr<GpuBuffer> mBoneMatrixBuffer;
 		SPtr<VertexBuffer> mMorphShapeBuffer;
 		SPtr<VertexDeclaration> mMorphVertexDeclaration;
+		SPtr<MorphShapeGpuBuffers> mMorphShapeGpuBuffers;
+		bool mMorphShapeBlendPending = false;
 	};
 	}
 
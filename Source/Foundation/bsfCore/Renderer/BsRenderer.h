@@ -47,6 +47,19 @@ namespace bs
 		return variation;
 	}
 
+	/** Returns the vertex input shader variation used for drawing multiple instances of a static mesh at once. */
+	static const ShaderVariation& getInstancedVertexInputVariation()
+	{
+		static ShaderVariation variation = ShaderVariation(
+		{
+			ShaderVariation::Param("SKINNED", false),
+			ShaderVariation::Param("MORPH", false),
+			ShaderVariation::Param("INSTANCED", true),
+		});
+
+		return variation;
+	}
+
 	/** Returns a specific forward rendering shader variation. */
 	template<bool skinned, bool morph, bool clustered>
 	static const ShaderVariation& getForwardRenderingVariation()
@@ -62,9 +75,9 @@ namespace bs
 	}
 
 	/** Technique tags. */
-	static StringID RTag_Skinned = "Skinned";
-	static StringID RTag_Morph = "Morph";
-	static StringID RTag_SkinnedMorph = "SkinnedMorph";
+	static StringID RTag_Skinned = BS_SID("Skinned");
+	static StringID RTag_Morph = BS_SID("Morph");
+	static StringID RTag_SkinnedMorph = BS_SID("SkinnedMorph");
 
 	/**	Set of options that can be used for controlling the renderer. */	
 	struct BS_CORE_EXPORT RendererOptions
@@ -131,6 +144,12 @@ namespace bs
 	class BS_CORE_EXPORT Renderer
 	{
 	public:
+		/**
+		 * Callback used for late latching camera input. Receives a camera the renderer is about to render, and returns
+		 * true if it modified the camera's transform.
+		 */
+		typedef std::function<bool(Camera& camera)> LateLatchCallback;
+
 		Renderer();
 		virtual ~Renderer() = default;
 
@@ -149,6 +168,13 @@ namespace bs
 		/** Called in order to render all currently active cameras. */
 		virtual void renderAll(PerFrameData perFrameData) = 0;
 
+		/**
+		 * Checks if the renderer blends morph shapes on the GPU. If true, animation evaluation only outputs morph shape
+		 * weights, and the renderer is responsible for blending the shapes before rendering (see
+		 * Renderable::isMorphShapeBlendPending()). Must not change after the renderer is initialized.
+		 */
+		virtual bool supportsGpuMorphShapes() const { return false; }
+
 		/**
 		 * Called whenever a new camera is created.
 		 *
@@ -325,6 +351,32 @@ namespace bs
 		virtual void captureSceneCubeMap(const SPtr<Texture>& cubemap, const Vector3& position, 
 			const CaptureSettings& settings) = 0;
 
+		/** 
+		 * Captures the scene at the specified location into a single face of a cubemap. Allows the capture of a cubemap
+		 * to be spread over multiple frames.
+		 * 
+		 * @param[in]	cubemap		Cubemap to store the results in.
+		 * @param[in]	face		Face of the cubemap to render to, in range [0, 5].
+		 * @param[in]	position	Position to capture the scene at.
+		 * @param[in]	settings	Settings that allow you to customize the capture.
+		 *
+		 * @note	Core thread.
+		 */
+		virtual void captureSceneCubeMapFace(const SPtr<Texture>& cubemap, UINT32 face, const Vector3& position, 
+			const CaptureSettings& settings) = 0;
+
+		/**
+		 * Called by reflection probes before every step of their time-sliced capture and filtering. Allows the renderer
+		 * to limit the number of probe updates per frame, and to pick which probes get updated first.
+		 *
+		 * @param[in]	probe	Probe requesting to perform an update step.
+		 * @return				True if the probe should perform the step during this frame, or false if it should try
+		 *						again on a later frame.
+		 *
+		 * @note	Core thread.
+		 */
+		virtual bool _requestReflectionProbeUpdateStep(const ReflectionProbe& probe) { return true; }
+
 		/**
 		 * Creates a new empty renderer mesh data.
 		 *
@@ -359,6 +411,17 @@ namespace bs
 		 */
 		void removePlugin(RendererExtension* plugin) { mCallbacks.erase(plugin); }
 
+		/**
+		 * Registers a callback that is triggered for every camera, right before the renderer uses the cameras to render
+		 * the frame. The callback can adjust the camera transform using the most recent input (e.g. as reported by
+		 * Input::getUnprocessedMouseAxes()), reducing the latency between input and what is displayed. Changes made by
+		 * the callback are only used for the current frame, after which the camera transform is restored. Only movable
+		 * cameras can be modified. Set to null to disable late latching.
+		 *
+		 * @note	Core thread.
+		 */
+		void setLateLatchCallback(const LateLatchCallback& callback) { mLateLatchCallback = callback; }
+
 		/**
 		 * Registers a new task for execution on the core thread.
 		 * 
@@ -431,6 +494,7 @@ namespace bs
 		static bool compareCallback(const RendererExtension* a, const RendererExtension* b);
 
 		Set<RendererExtension*, std::function<bool(const RendererExtension*, const RendererExtension*)>> mCallbacks;
+		LateLatchCallback mLateLatchCallback;
 
 		Vector<SPtr<RendererTask>> mQueuedTasks; // Sim & core thread
 		Vector<SPtr<RendererTask>> mUnresolvedTasks; // Sim thread
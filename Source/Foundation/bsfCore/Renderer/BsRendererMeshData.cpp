@@ -157,48 +157,64 @@ namespace bs
 		mMeshData->setVertexData(VES_COLOR, buffer, size);
 	}
 
-	void RendererMeshData::getUV0(Vector2* buffer, UINT32 size)
+	void RendererMeshData::getUV(UINT32 idx, Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 0))
+		const VertexElement* element = mMeshData->getVertexDesc()->getElement(VES_TEXCOORD, idx);
+		if (element == nullptr)
 			return;
 
 		UINT32 numElements = mMeshData->getNumVertices();
 		assert(numElements * sizeof(Vector2) == size);
 
-		mMeshData->getVertexData(VES_TEXCOORD, buffer, size, 0);
+		if (element->getType() == VET_HALF2)
+		{
+			UINT8* uvSrc = mMeshData->getElementData(VES_TEXCOORD, idx);
+			UINT32 stride = mMeshData->getVertexDesc()->getVertexStride(0);
+
+			MeshUtility::unpackUVs(uvSrc, buffer, numElements, stride);
+		}
+		else
+			mMeshData->getVertexData(VES_TEXCOORD, buffer, size, idx);
 	}
 
-	void RendererMeshData::setUV0(Vector2* buffer, UINT32 size)
+	void RendererMeshData::setUV(UINT32 idx, Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 0))
+		const VertexElement* element = mMeshData->getVertexDesc()->getElement(VES_TEXCOORD, idx);
+		if (element == nullptr)
 			return;
 
 		UINT32 numElements = mMeshData->getNumVertices();
 		assert(numElements * sizeof(Vector2) == size);
 
-		mMeshData->setVertexData(VES_TEXCOORD, buffer, size, 0);
+		if (element->getType() == VET_HALF2)
+		{
+			UINT8* uvDst = mMeshData->getElementData(VES_TEXCOORD, idx);
+			UINT32 stride = mMeshData->getVertexDesc()->getVertexStride(0);
+
+			MeshUtility::packUVs(buffer, uvDst, numElements, sizeof(Vector2), stride);
+		}
+		else
+			mMeshData->setVertexData(VES_TEXCOORD, buffer, size, idx);
 	}
 
-	void RendererMeshData::getUV1(Vector2* buffer, UINT32 size)
+	void RendererMeshData::getUV0(Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 1))
-			return;
+		getUV(0, buffer, size);
+	}
 
-		UINT32 numElements = mMeshData->getNumVertices();
-		assert(numElements * sizeof(Vector2) == size);
+	void RendererMeshData::setUV0(Vector2* buffer, UINT32 size)
+	{
+		setUV(0, buffer, size);
+	}
 
-		mMeshData->getVertexData(VES_TEXCOORD, buffer, size, 1);
+	void RendererMeshData::getUV1(Vector2* buffer, UINT32 size)
+	{
+		getUV(1, buffer, size);
 	}
 
 	void RendererMeshData::setUV1(Vector2* buffer, UINT32 size)
 	{
-		if (!mMeshData->getVertexDesc()->hasElement(VES_TEXCOORD, 1))
-			return;
-
-		UINT32 numElements = mMeshData->getNumVertices();
-		assert(numElements * sizeof(Vector2) == size);
-
-		mMeshData->setVertexData(VES_TEXCOORD, buffer, size, 1);
+		setUV(1, buffer, size);
 	}
 
 	void RendererMeshData::getBoneWeights(BoneWeight* buffer, UINT32 size)
@@ -217,17 +233,24 @@ namespace bs
 
 		UINT32 stride = vertexDesc->getVertexStride(0);
 
+		const bool packedWeights = vertexDesc->getElement(VES_BLEND_WEIGHTS)->getType() == VET_UBYTE4_NORM;
+
 		BoneWeight* weightDst = buffer;
 		for (UINT32 i = 0; i < numElements; i++)
 		{
 			UINT8* indices = indexPtr;
-			float* weights = (float*)weightPtr;
 
 			weightDst->index0 = indices[0];
 			weightDst->index1 = indices[1];
 			weightDst->index2 = indices[2];
 			weightDst->index3 = indices[3];
 
+			Vector4 weights;
+			if (packedWeights)
+				weights = MeshUtility::unpackBoneWeight(weightPtr);
+			else
+				weights = *(Vector4*)weightPtr;
+
 			weightDst->weight0 = weights[0];
 			weightDst->weight1 = weights[1];
 			weightDst->weight2 = weights[2];
@@ -255,21 +278,23 @@ namespace bs
 
 		UINT32 stride = vertexDesc->getVertexStride(0);
 
+		const bool packedWeights = vertexDesc->getElement(VES_BLEND_WEIGHTS)->getType() == VET_UBYTE4_NORM;
+
 		BoneWeight* weightSrc = buffer;
 		for (UINT32 i = 0; i < numElements; i++)
 		{
 			UINT8* indices = indexPtr;
-			float* weights = (float*)weightPtr;
 
 			indices[0] = weightSrc->index0;
 			indices[1] = weightSrc->index1;
 			indices[2] = weightSrc->index2;
 			indices[3] = weightSrc->index3;
 
-			weights[0] = weightSrc->weight0;
-			weights[1] = weightSrc->weight1;
-			weights[2] = weightSrc->weight2;
-			weights[3] = weightSrc->weight3;
+			Vector4 weights(weightSrc->weight0, weightSrc->weight1, weightSrc->weight2, weightSrc->weight3);
+			if (packedWeights)
+				MeshUtility::packBoneWeights(&weights, weightPtr, 1, sizeof(Vector4), sizeof(UINT32));
+			else
+				*(Vector4*)weightPtr = weights;
 
 			weightSrc++;
 			indexPtr += stride;
@@ -531,4 +556,63 @@ namespace bs
 
 		return output;
 	}
+
+	SPtr<MeshData> RendererMeshData::quantize(const SPtr<MeshData>& meshData)
+	{
+		SPtr<VertexDataDesc> vertexDesc = meshData->getVertexDesc();
+
+		UINT32 numVertices = meshData->getNumVertices();
+		UINT32 numIndices = meshData->getNumIndices();
+
+		auto getQuantizedType = [](const VertexElement& element)
+		{
+			if (element.getSemantic() == VES_TEXCOORD && element.getType() == VET_FLOAT2)
+				return VET_HALF2;
+
+			if (element.getSemantic() == VES_BLEND_WEIGHTS && element.getType() == VET_FLOAT4)
+				return VET_UBYTE4_NORM;
+
+			return element.getType();
+		};
+
+		SPtr<VertexDataDesc> outputVertexDesc = VertexDataDesc::create();
+		for (UINT32 i = 0; i < vertexDesc->getNumElements(); i++)
+		{
+			const VertexElement& element = vertexDesc->getElement(i);
+			outputVertexDesc->addVertElem(getQuantizedType(element), element.getSemantic(), element.getSemanticIdx(),
+				element.getStreamIdx(), element.getInstanceStepRate());
+		}
+
+		SPtr<MeshData> output = MeshData::create(numVertices, numIndices, outputVertexDesc, meshData->getIndexType());
+		for (UINT32 i = 0; i < vertexDesc->getNumElements(); i++)
+		{
+			const VertexElement& element = vertexDesc->getElement(i);
+			const VertexElementSemantic semantic = element.getSemantic();
+			const UINT32 semanticIdx = element.getSemanticIdx();
+			const UINT32 streamIdx = element.getStreamIdx();
+
+			UINT8* inData = meshData->getElementData(semantic, semanticIdx, streamIdx);
+			UINT8* outData = output->getElementData(semantic, semanticIdx, streamIdx);
+			UINT32 inputStride = vertexDesc->getVertexStride(streamIdx);
+			UINT32 outputStride = outputVertexDesc->getVertexStride(streamIdx);
+
+			const VertexElementType outputType = getQuantizedType(element);
+			if (outputType == element.getType())
+			{
+				for (UINT32 j = 0; j < numVertices; j++)
+					memcpy(outData + j * outputStride, inData + j * inputStride, element.getSize());
+			}
+			else if (outputType == VET_HALF2)
+				MeshUtility::packUVs((Vector2*)inData, outData, numVertices, inputStride, outputStride);
+			else
+				MeshUtility::packBoneWeights((Vector4*)inData, outData, numVertices, inputStride, outputStride);
+		}
+
+		if (meshData->getIndexType() == IT_32BIT)
+			memcpy(output->getIndices32(), meshData->getIndices32(), numIndices * sizeof(UINT32));
+		else
+			memcpy(output->getIndices16(), meshData->getIndices16(), numIndices * sizeof(UINT16));
+
+		return output;
+	}
 }
\ No newline at end of file
@@ -218,9 +218,22 @@ namespace bs
 		/** Converts a generic mesh data into mesh data format expected by the renderer. */
 		static SPtr<MeshData> convert(const SPtr<MeshData>& meshData);
 
+		/**
+		 * Converts mesh data in the format expected by the renderer into a more compact format, storing texture
+		 * coordinates as 16-bit floating point values and bone weights as 8-bit normalized values. Other vertex
+		 * elements are copied unchanged. Data in the compact format can still be accessed through RendererMeshData.
+		 */
+		static SPtr<MeshData> quantize(const SPtr<MeshData>& meshData);
+
 	private:
 		friend class ct::Renderer;
 
+		/** Reads the coordinates of the UV channel with the specified index. */
+		void getUV(UINT32 idx, Vector2* buffer, UINT32 size);
+
+		/** Writes the coordinates of the UV channel with the specified index. */
+		void setUV(UINT32 idx, Vector2* buffer, UINT32 size);
+
 		RendererMeshData(UINT32 numVertices, UINT32 numIndices, VertexLayout layout, IndexType indexType = IT_32BIT);
 		RendererMeshData(const SPtr<MeshData>& meshData);
 
@@ -17,6 +17,7 @@ namespace bs
 	{
 		p(mBrightness);
 		p(mTexture);
+		p(mAtmosphere);
 	}
 
 	Skybox::Skybox()
@@ -49,7 +50,7 @@ namespace bs
 			cubemapDesc.width = ct::IBLUtility::REFLECTION_CUBEMAP_SIZE;
 			cubemapDesc.height = ct::IBLUtility::REFLECTION_CUBEMAP_SIZE;
 			cubemapDesc.numMips = PixelUtil::getMaxMipmaps(cubemapDesc.width, cubemapDesc.height, 1, cubemapDesc.format);
-			cubemapDesc.usage = TU_STATIC | TU_RENDERTARGET;
+			cubemapDesc.usage = ct::IBLUtility::getSpecularCubemapUsage();
 
 			mFilteredRadiance = Texture::_createPtr(cubemapDesc);
 		}
@@ -83,8 +84,9 @@ namespace bs
 
 			coreSkybox->mFilteredRadiance = coreFilteredRadiance;
 
-			// Generate irradiance
-			ct::gIBLUtility().filterCubemapForIrradiance(coreSkybox->getTexture(), coreIrradiance);
+			// Generate irradiance. Irradiance is low frequency, so the scaled down radiance (whose first mip level is
+			// left unfiltered) is used as the source instead of the full resolution sky texture.
+			ct::gIBLUtility().filterCubemapForIrradiance(coreFilteredRadiance, coreIrradiance);
 			coreSkybox->mIrradiance = coreIrradiance;
 
 			return true;
@@ -103,12 +105,35 @@ namespace bs
 		mFilteredRadiance = nullptr;
 		mIrradiance = nullptr;
 
-		if(mTexture.isLoaded())
+		// Filtered textures are generated by the renderer when using the atmosphere
+		if(mTexture.isLoaded() && !mAtmosphere)
 			filterTexture();
 
 		_markCoreDirty((ActorDirtyFlag)SkyboxDirtyFlag::Texture);
 	}
 
+	void Skybox::setAtmosphere(bool enabled)
+	{
+		if (mAtmosphere == enabled)
+			return;
+
+		mAtmosphere = enabled;
+
+		if (mAtmosphere)
+		{
+			// Filtered textures are generated by the renderer from the atmosphere instead
+			if (mRendererTask != nullptr)
+				mRendererTask->cancel();
+
+			mFilteredRadiance = nullptr;
+			mIrradiance = nullptr;
+		}
+		else if (mTexture.isLoaded())
+			filterTexture();
+
+		_markCoreDirty();
+	}
+
 	SPtr<ct::Skybox> Skybox::getCore() const
 	{
 		return std::static_pointer_cast<ct::Skybox>(mCoreSpecific);
@@ -42,8 +42,15 @@ namespace bs
 		/** @see setBrightness */
 		float getBrightness() const { return mBrightness; }
 
+		/** 
+		 * Determines is the sky radiance evaluated from a physically based model of an earth-like atmosphere, instead
+		 * of being read from the skybox texture. The atmosphere is lit by the first directional light in the scene.
+		 */
+		bool getAtmosphere() const { return mAtmosphere; }
+
 	protected:
 		float mBrightness = 1.0f; /**< Multiplier to apply to evaluated skybox values before using them. */
+		bool mAtmosphere = false; /**< True if the sky is evaluated from the atmosphere model. */
 	};
 
 	/** Templated base class for both core and sim thread implementations of a skybox. */
@@ -84,6 +91,9 @@ namespace bs
 		/** @copydoc TSkybox::getTexture */
 		void setTexture(const HTexture& texture);
 
+		/** @copydoc SkyboxBase::getAtmosphere */
+		void setAtmosphere(bool enabled);
+
 		/**	Retrieves an implementation of the skybox usable only from the core thread. */
 		SPtr<ct::Skybox> getCore() const;
 
@@ -143,6 +153,21 @@ namespace bs
 			 */
 			SPtr<Texture> getIrradiance() const { return mIrradiance; }
 
+			/** @name Internal
+			 *  @{
+			 */
+
+			/** 
+			 * Assigns the filtered radiance and irradiance textures. Used by the renderer when it generates the sky
+			 * radiance itself, instead of it being read from the skybox texture (see getAtmosphere()).
+			 */
+			void _setFilteredTextures(const SPtr<Texture>& filteredRadiance, const SPtr<Texture>& irradiance)
+			{
+				mFilteredRadiance = filteredRadiance;
+				mIrradiance = irradiance;
+			}
+
+			/** @} */
 		protected:
 			friend class bs::Skybox;
 
@@ -0,0 +1,311 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Renderer/BsTerrainBuilder.h"
+#include "Components/BsCRenderable.h"
+#include "Components/BsCHeightFieldCollider.h"
+#include "Scene/BsSceneObject.h"
+#include "Mesh/BsMesh.h"
+#include "Mesh/BsMeshData.h"
+#include "Mesh/BsMeshUtility.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+
+namespace bs
+{
+	/** Provides access to the samples of a height field, clamping the sample coordinates to the height field edges. */
+	struct HeightFieldSampler
+	{
+		HeightFieldSampler(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows, const Vector2& spacing)
+			:heights(heights), numColumns(numColumns), numRows(numRows), spacing(spacing)
+		{ }
+
+		/** Returns the height of the sample at the provided coordinates. */
+		float getHeight(INT32 x, INT32 z) const
+		{
+			x = Math::clamp(x, 0, (INT32)numColumns - 1);
+			z = Math::clamp(z, 0, (INT32)numRows - 1);
+
+			return heights[z * numColumns + x];
+		}
+
+		/** Returns the rate of change of height along the X and Z axes, at the sample at the provided coordinates. */
+		Vector2 getSlope(INT32 x, INT32 z) const
+		{
+			return Vector2(
+				(getHeight(x + 1, z) - getHeight(x - 1, z)) / (2.0f * spacing.x),
+				(getHeight(x, z + 1) - getHeight(x, z - 1)) / (2.0f * spacing.y));
+		}
+
+		const Vector<float>& heights;
+		UINT32 numColumns;
+		UINT32 numRows;
+		Vector2 spacing;
+	};
+
+	/**
+	 * Creates the mesh of a single level of detail of a tile covering the samples in range [start, end], using every
+	 * @p step-th sample. The tile edge is extended downwards by @p skirtDepth.
+	 */
+	static SPtr<MeshData> createTileMesh(const HeightFieldSampler& sampler, UINT32 startX, UINT32 startZ, UINT32 endX,
+		UINT32 endZ, UINT32 step, float skirtDepth)
+	{
+		// Samples of the grid vertices. If the tile size isn't divisible by the step, the last quad is narrower.
+		auto getSamples = [step](UINT32 start, UINT32 end, Vector<UINT32>& samples)
+		{
+			for (UINT32 i = start; i < end; i += step)
+				samples.push_back(i);
+
+			samples.push_back(end);
+		};
+
+		Vector<UINT32> samplesX;
+		Vector<UINT32> samplesZ;
+		getSamples(startX, endX, samplesX);
+		getSamples(startZ, endZ, samplesZ);
+
+		const UINT32 numQuadsX = (UINT32)samplesX.size() - 1;
+		const UINT32 numQuadsZ = (UINT32)samplesZ.size() - 1;
+		const UINT32 numGridVertices = (numQuadsX + 1) * (numQuadsZ + 1);
+
+		// Grid vertices along the tile edge, ordered so the skirt faces outwards
+		Vector<UINT32> edge;
+		for (UINT32 i = 0; i < numQuadsX; i++)
+			edge.push_back(numQuadsZ * (numQuadsX + 1) + i);
+
+		for (UINT32 i = numQuadsZ; i > 0; i--)
+			edge.push_back(i * (numQuadsX + 1) + numQuadsX);
+
+		for (UINT32 i = numQuadsX; i > 0; i--)
+			edge.push_back(i);
+
+		for (UINT32 i = 0; i < numQuadsZ; i++)
+			edge.push_back(i * (numQuadsX + 1));
+
+		const auto numEdgeVertices = (UINT32)edge.size();
+		const UINT32 numVertices = numGridVertices + numEdgeVertices;
+		const UINT32 numIndices = (numQuadsX * numQuadsZ + numEdgeVertices) * 6;
+
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		vertexDesc->addVertElem(VET_UBYTE4_NORM, VES_NORMAL);
+		vertexDesc->addVertElem(VET_UBYTE4_NORM, VES_TANGENT);
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD);
+
+		SPtr<MeshData> meshData = MeshData::create(numVertices, numIndices, vertexDesc);
+
+		auto positionIter = meshData->getVec3DataIter(VES_POSITION);
+		auto uvIter = meshData->getVec2DataIter(VES_TEXCOORD);
+
+		// Normals and tangents are packed into the format the standard shaders decode, once all vertices are written
+		Vector<Vector3> normals;
+		Vector<Vector4> tangents;
+		normals.reserve(numVertices);
+		tangents.reserve(numVertices);
+
+		const Vector2 uvScale(1.0f / (sampler.numColumns - 1), 1.0f / (sampler.numRows - 1));
+		auto writeVertex = [&](UINT32 gridIdx, float offsetY)
+		{
+			const UINT32 x = samplesX[gridIdx % (numQuadsX + 1)];
+			const UINT32 z = samplesZ[gridIdx / (numQuadsX + 1)];
+
+			// Normals are always calculated from the full resolution height field, so lighting doesn't change between
+			// levels of detail or across tile edges
+			const Vector2 slope = sampler.getSlope((INT32)x, (INT32)z);
+			const Vector3 normal = Vector3::normalize(Vector3(-slope.x, 1.0f, -slope.y));
+			const Vector3 tangent = Vector3::normalize(Vector3(1.0f, slope.x, 0.0f));
+
+			positionIter.addValue(Vector3(
+				(x - startX) * sampler.spacing.x,
+				sampler.getHeight((INT32)x, (INT32)z) + offsetY,
+				(z - startZ) * sampler.spacing.y));
+
+			normals.push_back(normal);
+			tangents.push_back(Vector4(tangent.x, tangent.y, tangent.z, 1.0f));
+			uvIter.addValue(Vector2(x * uvScale.x, z * uvScale.y));
+		};
+
+		for (UINT32 i = 0; i < numGridVertices; i++)
+			writeVertex(i, 0.0f);
+
+		for (auto& entry : edge)
+			writeVertex(entry, -skirtDepth);
+
+		const UINT32 vertexStride = vertexDesc->getVertexStride();
+		MeshUtility::packNormals(normals.data(), meshData->getElementData(VES_NORMAL), numVertices, sizeof(Vector3),
+			vertexStride);
+		MeshUtility::packNormals(tangents.data(), meshData->getElementData(VES_TANGENT), numVertices, sizeof(Vector4),
+			vertexStride);
+
+		UINT32* indices = meshData->getIndices32();
+		for (UINT32 z = 0; z < numQuadsZ; z++)
+		{
+			for (UINT32 x = 0; x < numQuadsX; x++)
+			{
+				const UINT32 v00 = z * (numQuadsX + 1) + x;
+				const UINT32 v10 = v00 + 1;
+				const UINT32 v01 = v00 + numQuadsX + 1;
+				const UINT32 v11 = v01 + 1;
+
+				indices[0] = v00;
+				indices[1] = v10;
+				indices[2] = v11;
+
+				indices[3] = v00;
+				indices[4] = v11;
+				indices[5] = v01;
+
+				indices += 6;
+			}
+		}
+
+		for (UINT32 i = 0; i < numEdgeVertices; i++)
+		{
+			const UINT32 next = (i + 1) % numEdgeVertices;
+
+			const UINT32 top0 = edge[i];
+			const UINT32 top1 = edge[next];
+			const UINT32 bottom0 = numGridVertices + i;
+			const UINT32 bottom1 = numGridVertices + next;
+
+			indices[0] = top0;
+			indices[1] = top1;
+			indices[2] = bottom1;
+
+			indices[3] = top0;
+			indices[4] = bottom1;
+			indices[5] = bottom0;
+
+			indices += 6;
+		}
+
+		return meshData;
+	}
+
+	Vector<TerrainBuilder::Tile> TerrainBuilder::build(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows,
+		const TERRAIN_DESC& desc, const HSceneObject& parent)
+	{
+		if (numColumns < 2 || numRows < 2 || (UINT32)heights.size() != numColumns * numRows)
+		{
+			LOGERR("Cannot build terrain. Height field must have at least two rows and columns, and one height per "
+				"sample.");
+			return Vector<Tile>();
+		}
+
+		const UINT32 tileSize = std::max(desc.tileSize, 1U);
+		const UINT32 numTilesX = Math::divideAndRoundUp(numColumns - 1, tileSize);
+		const UINT32 numTilesZ = Math::divideAndRoundUp(numRows - 1, tileSize);
+
+		Vector<Tile> tiles;
+		tiles.reserve(numTilesX * numTilesZ);
+
+		for (UINT32 z = 0; z < numTilesZ; z++)
+		{
+			for (UINT32 x = 0; x < numTilesX; x++)
+				tiles.push_back(createTile(heights, numColumns, numRows, x, z, desc, parent));
+		}
+
+		return tiles;
+	}
+
+	TerrainBuilder::Tile TerrainBuilder::createTile(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows,
+		UINT32 tileX, UINT32 tileZ, const TERRAIN_DESC& desc, const HSceneObject& parent)
+	{
+		Tile tile;
+		if (numColumns < 2 || numRows < 2 || (UINT32)heights.size() != numColumns * numRows)
+		{
+			LOGERR("Cannot create terrain tile. Height field must have at least two rows and columns, and one height "
+				"per sample.");
+			return tile;
+		}
+
+		const UINT32 tileSize = std::max(desc.tileSize, 1U);
+		const UINT32 startX = tileX * tileSize;
+		const UINT32 startZ = tileZ * tileSize;
+
+		if (startX >= numColumns - 1 || startZ >= numRows - 1)
+			return tile;
+
+		const UINT32 endX = std::min(startX + tileSize, numColumns - 1);
+		const UINT32 endZ = std::min(startZ + tileSize, numRows - 1);
+
+		// Copy the samples covered by the tile, for the collider and for determining the tile bounds
+		const UINT32 numTileColumns = endX - startX + 1;
+		const UINT32 numTileRows = endZ - startZ + 1;
+
+		Vector<float> tileHeights;
+		tileHeights.reserve(numTileColumns * numTileRows);
+
+		for (UINT32 z = startZ; z <= endZ; z++)
+		{
+			for (UINT32 x = startX; x <= endX; x++)
+				tileHeights.push_back(heights[z * numColumns + x]);
+		}
+
+		const auto minmax = std::minmax_element(tileHeights.begin(), tileHeights.end());
+		const float minHeight = *minmax.first;
+		const float maxHeight = *minmax.second;
+
+		tile.so = SceneObject::create("Terrain tile");
+		if (parent != nullptr)
+			tile.so->setParent(parent, false);
+
+		tile.so->setPosition(Vector3(startX * desc.spacing.x, 0.0f, startZ * desc.spacing.y));
+		tile.so->setMobility(ObjectMobility::Static);
+
+		const Vector3 extents((endX - startX) * desc.spacing.x, 0.0f, (endZ - startZ) * desc.spacing.y);
+		tile.bounds = AABox(Vector3(0.0f, minHeight, 0.0f), Vector3(extents.x, maxHeight, extents.z));
+		tile.bounds.transformAffine(tile.so->getWorldMatrix());
+
+		// Deep enough to cover the height difference between any two levels of detail within the tile
+		const float skirtDepth = (maxHeight - minHeight) + std::max(desc.spacing.x, desc.spacing.y);
+
+		const HeightFieldSampler sampler(heights, numColumns, numRows, desc.spacing);
+		const Vector3 origin = tile.bounds.getCenter();
+
+		const UINT32 numLODs = std::max(desc.numLODs, 1U);
+		for (UINT32 i = 0; i < numLODs; i++)
+		{
+			const UINT32 step = 1 << i;
+
+			// Lower levels of detail would end up with the same geometry as this one
+			const bool last = i == (numLODs - 1) || step >= tileSize;
+
+			SPtr<MeshData> meshData = createTileMesh(sampler, startX, startZ, endX, endZ, step, skirtDepth);
+
+			HSceneObject lodSO = SceneObject::create("LOD " + toString(i));
+			lodSO->setParent(tile.so, false);
+			lodSO->setMobility(ObjectMobility::Static);
+
+			HRenderable renderable = lodSO->addComponent<CRenderable>();
+			renderable->setMesh(Mesh::create(meshData));
+			renderable->setMaterial(desc.material);
+			renderable->setLayer(desc.layer);
+
+			const float minDistance = i == 0 ? 0.0f : desc.lodDistance * (float)(1 << (i - 1));
+			const float maxDistance = last ? 0.0f : desc.lodDistance * (float)step;
+			renderable->setDrawDistance(origin, minDistance, maxDistance);
+
+			tile.lods.push_back(renderable);
+
+			if (last)
+				break;
+		}
+
+		if (desc.createColliders)
+		{
+			tile.collider = tile.so->addComponent<CHeightFieldCollider>();
+			tile.collider->setSpacing(desc.spacing);
+			tile.collider->setHeights(tileHeights, numTileColumns, numTileRows);
+		}
+
+		return tile;
+	}
+
+	void TerrainBuilder::destroy(const Vector<Tile>& tiles)
+	{
+		for (auto& tile : tiles)
+		{
+			if (tile.so != nullptr && !tile.so.isDestroyed())
+				tile.so->destroy();
+		}
+	}
+}
@@ -0,0 +1,114 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsAABox.h"
+#include "Math/BsVector2.h"
+
+namespace bs
+{
+	/** @addtogroup Renderer
+	 *  @{
+	 */
+
+	/** Options controlling how is a height field turned into terrain by TerrainBuilder. */
+	struct TERRAIN_DESC
+	{
+		/** Distance between neighbouring height samples, along the X and Z axes. */
+		Vector2 spacing = Vector2::ONE;
+
+		/** Number of quads along each side of a tile, at the highest level of detail. */
+		UINT32 tileSize = 64;
+
+		/** Number of levels of detail of each tile. Each level has half the resolution of the previous one. */
+		UINT32 numLODs = 4;
+
+		/**
+		 * Distance from the tile center up to which the highest level of detail is drawn. Each following level is
+		 * drawn up to twice the distance of the previous one, and the last level at any distance.
+		 */
+		float lodDistance = 64.0f;
+
+		/** Material to render the terrain with. */
+		HMaterial material;
+
+		/** Layer the terrain renderables are drawn on. */
+		UINT64 layer = 1;
+
+		/** Determines should a height field collider be created for each tile. */
+		bool createColliders = true;
+	};
+
+	/**
+	 * Builds terrain from a height field. The height field is split into square tiles, each a separate scene object
+	 * with one renderable per level of detail, and optionally a HeightFieldCollider. Levels of detail are regular grids
+	 * of decreasing resolution, selected by distance through Renderable::setDrawDistance(), so each tile is drawn
+	 * with a single draw call. Tile edges are extended downwards by skirts, hiding cracks between neighbouring tiles
+	 * drawn at different levels of detail.
+	 *
+	 * Terrain meshes contain positions, normals, tangents and texture coordinates spanning the entire height field in
+	 * range [0, 1], which the material can use to sample splat maps. Because tiles are standalone scene objects they
+	 * can be saved as prefabs and streamed in and out through WorldPartition.
+	 *
+	 * Every level of detail is kept in memory, so this suits terrain of moderate size. Large terrain should be rendered
+	 * through TerrainClipmap instead, which displaces a few fixed meshes on the GPU and streams the height field in
+	 * tiles.
+	 */
+	class BS_CORE_EXPORT TerrainBuilder
+	{
+	public:
+		/** Single terrain tile. */
+		struct Tile
+		{
+			/** Scene object containing the tile. */
+			HSceneObject so;
+
+			/** Renderables for each level of detail, from the highest to the lowest. */
+			Vector<HRenderable> lods;
+
+			/** Collider of the tile, if colliders were requested. */
+			HHeightFieldCollider collider;
+
+			/** Bounds of the tile, in world space. */
+			AABox bounds;
+		};
+
+		/**
+		 * Creates terrain tiles covering the entire height field.
+		 *
+		 * @param[in]	heights		Height of each sample. Samples are stored row by row, where each row contains
+		 *							@p numColumns samples along the X axis, and rows follow each other along the Z axis.
+		 * @param[in]	numColumns	Number of samples along the X axis. Must be at least two.
+		 * @param[in]	numRows		Number of samples along the Z axis. Must be at least two.
+		 * @param[in]	desc		Options controlling the terrain creation.
+		 * @param[in]	parent		Scene object to parent the tiles to. The height field starts at the origin of the
+		 *							parent. If not provided tiles are created at the scene root.
+		 * @return					Created tiles, row by row.
+		 */
+		static Vector<Tile> build(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows,
+			const TERRAIN_DESC& desc = TERRAIN_DESC(), const HSceneObject& parent = HSceneObject());
+
+		/**
+		 * Creates a single terrain tile. Same as the tiles created by build(), allowing tiles to be created on demand
+		 * (e.g. when streaming large terrain).
+		 *
+		 * @param[in]	heights		Height of each sample. See build().
+		 * @param[in]	numColumns	Number of samples along the X axis.
+		 * @param[in]	numRows		Number of samples along the Z axis.
+		 * @param[in]	tileX		Index of the tile along the X axis.
+		 * @param[in]	tileZ		Index of the tile along the Z axis.
+		 * @param[in]	desc		Options controlling the terrain creation.
+		 * @param[in]	parent		Scene object to parent the tile to. See build().
+		 * @return					Created tile, or a tile with an empty scene object if the tile lies outside of
+		 *							the height field.
+		 */
+		static Tile createTile(const Vector<float>& heights, UINT32 numColumns, UINT32 numRows, UINT32 tileX,
+			UINT32 tileZ, const TERRAIN_DESC& desc = TERRAIN_DESC(), const HSceneObject& parent = HSceneObject());
+
+		/** Destroys the scene objects of the provided tiles. */
+		static void destroy(const Vector<Tile>& tiles);
+	};
+
+	/** @} */
+}
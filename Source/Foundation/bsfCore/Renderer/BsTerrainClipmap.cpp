@@ -0,0 +1,581 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Renderer/BsTerrainClipmap.h"
+#include "Renderer/BsRenderable.h"
+#include "Components/BsCRenderable.h"
+#include "Components/BsCHeightFieldCollider.h"
+#include "Scene/BsSceneObject.h"
+#include "Material/BsMaterial.h"
+#include "Mesh/BsMesh.h"
+#include "Mesh/BsMeshData.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "Image/BsTexture.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Resources/BsResources.h"
+
+namespace bs
+{
+	/**
+	 * Creates a grid of @p gridSize quads along each side, centered at the origin, with one vertex per integer
+	 * coordinate. If @p hole is true, quads in the central area of half the grid size, offset by @p holeOffsetX and
+	 * @p holeOffsetZ, are left out.
+	 */
+	static SPtr<MeshData> createGridMesh(UINT32 gridSize, bool hole, INT32 holeOffsetX, INT32 holeOffsetZ)
+	{
+		const INT32 halfSize = (INT32)gridSize / 2;
+		const INT32 holeStartX = -halfSize / 2 + holeOffsetX;
+		const INT32 holeStartZ = -halfSize / 2 + holeOffsetZ;
+
+		const UINT32 numVertices = (gridSize + 1) * (gridSize + 1);
+		const UINT32 numQuads = gridSize * gridSize - (hole ? (UINT32)(halfSize * halfSize) : 0);
+
+		SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::create();
+		vertexDesc->addVertElem(VET_FLOAT2, VES_POSITION);
+
+		SPtr<MeshData> meshData = MeshData::create(numVertices, numQuads * 6, vertexDesc);
+
+		auto positionIter = meshData->getVec2DataIter(VES_POSITION);
+		for (UINT32 z = 0; z <= gridSize; z++)
+		{
+			for (UINT32 x = 0; x <= gridSize; x++)
+				positionIter.addValue(Vector2((float)((INT32)x - halfSize), (float)((INT32)z - halfSize)));
+		}
+
+		UINT32* indices = meshData->getIndices32();
+		for (UINT32 z = 0; z < gridSize; z++)
+		{
+			for (UINT32 x = 0; x < gridSize; x++)
+			{
+				if (hole)
+				{
+					const INT32 quadX = (INT32)x - halfSize;
+					const INT32 quadZ = (INT32)z - halfSize;
+
+					if (quadX >= holeStartX && quadX < holeStartX + halfSize &&
+						quadZ >= holeStartZ && quadZ < holeStartZ + halfSize)
+						continue;
+				}
+
+				const UINT32 v00 = z * (gridSize + 1) + x;
+				const UINT32 v10 = v00 + 1;
+				const UINT32 v01 = v00 + gridSize + 1;
+				const UINT32 v11 = v01 + 1;
+
+				indices[0] = v00;
+				indices[1] = v10;
+				indices[2] = v11;
+
+				indices[3] = v00;
+				indices[4] = v11;
+				indices[5] = v01;
+
+				indices += 6;
+			}
+		}
+
+		return meshData;
+	}
+
+	/**
+	 * Reads the cached pixels of a loaded tile texture. Returns null and logs a warning if the texture doesn't have
+	 * cached data, or is not of the expected size.
+	 */
+	static SPtr<PixelData> readTileTexture(const HTexture& texture, UINT32 numSamples)
+	{
+		const TextureProperties& props = texture->getProperties();
+		if ((props.getUsage() & TU_CPUCACHED) == 0 || PixelUtil::isCompressed(props.getFormat()))
+		{
+			LOGWRN("Cannot stream terrain tile \"" + texture->getName() + "\". Tile textures must use uncompressed "
+				"formats and have CPU cached data.");
+			return nullptr;
+		}
+
+		if (props.getWidth() != numSamples || props.getHeight() != numSamples)
+		{
+			LOGWRN("Cannot stream terrain tile \"" + texture->getName() + "\". Tile textures must have " +
+				toString(numSamples) + " samples along each side.");
+			return nullptr;
+		}
+
+		SPtr<PixelData> pixelData = props.allocBuffer(0, 0);
+		texture->readCachedData(*pixelData);
+
+		return pixelData;
+	}
+
+	TerrainClipmap::TerrainClipmap(const TERRAIN_CLIPMAP_DESC& desc)
+		:mDesc(desc)
+	{
+		// Level edges must land on even samples, and the morph region must span a whole number of samples
+		mDesc.gridSize = std::max(Math::divideAndRoundUp(mDesc.gridSize, 8U) * 8, 8U);
+		mDesc.tileSize = std::max(mDesc.tileSize, 1U);
+		mDesc.numLevels = Math::clamp(mDesc.numLevels, 1U, 16U);
+	}
+
+	TerrainClipmap::~TerrainClipmap()
+	{
+		clearTiles();
+	}
+
+	void TerrainClipmap::setTiles(UINT32 numTilesX, UINT32 numTilesZ,
+		const Vector<WeakResourceHandle<Texture>>& heightTiles, const Vector<WeakResourceHandle<Texture>>& splatTiles)
+	{
+		clearTiles();
+
+		const UINT32 numTiles = numTilesX * numTilesZ;
+		if (numTiles == 0 || (UINT32)heightTiles.size() != numTiles ||
+			(!splatTiles.empty() && (UINT32)splatTiles.size() != numTiles))
+		{
+			LOGERR("Cannot set terrain tiles. A height map must be provided for each tile, and a splat map for either "
+				"each tile or none.");
+			return;
+		}
+
+		mNumTilesX = numTilesX;
+		mNumTilesZ = numTilesZ;
+		mTiles.resize(numTiles);
+
+		for (UINT32 i = 0; i < numTiles; i++)
+		{
+			mTiles[i].heightMap = heightTiles[i];
+
+			if (!splatTiles.empty())
+				mTiles[i].splatMap = splatTiles[i];
+		}
+	}
+
+	void TerrainClipmap::clearTiles()
+	{
+		for (auto& entry : mTiles)
+			unload(entry);
+
+		mTiles.clear();
+		mNumTilesX = 0;
+		mNumTilesZ = 0;
+
+		destroyLevels();
+	}
+
+	void TerrainClipmap::setParent(const HSceneObject& parent)
+	{
+		mParent = parent;
+
+		if (mParent == nullptr || mParent.isDestroyed())
+			return;
+
+		for (auto& entry : mLevels)
+			entry.so->setParent(mParent, false);
+
+		for (auto& entry : mTiles)
+		{
+			if (entry.colliderSO != nullptr)
+				entry.colliderSO->setParent(mParent, false);
+		}
+	}
+
+	void TerrainClipmap::update(const Vector3& viewPosition)
+	{
+		if (mTiles.empty())
+			return;
+
+		if (mLevels.empty())
+		{
+			createLevels();
+
+			if (mLevels.empty())
+				return;
+		}
+
+		Vector3 localPosition = viewPosition;
+		if (mParent != nullptr && !mParent.isDestroyed())
+			localPosition = mParent->getWorldMatrix().inverseAffine().multiplyAffine(viewPosition);
+
+		const Vector2 viewPos(localPosition.x, localPosition.z);
+		updateTiles(viewPos);
+
+		for (UINT32 i = 0; i < (UINT32)mLevels.size(); i++)
+		{
+			Level& level = mLevels[i];
+
+			const Vector2 levelSpacing = mDesc.spacing * (float)(1 << i);
+			const INT32 centerX = Math::roundToInt(viewPos.x / levelSpacing.x * 0.5f) * 2;
+			const INT32 centerZ = Math::roundToInt(viewPos.y / levelSpacing.y * 0.5f) * 2;
+
+			if (centerX != level.centerX || centerZ != level.centerZ)
+			{
+				level.centerX = centerX;
+				level.centerZ = centerZ;
+				level.dirty = true;
+			}
+
+			if (level.dirty)
+				updateLevel(i);
+
+			if (i == 0)
+				continue;
+
+			// The hole is placed where the previous level is drawn. Its center, in samples of this level, can be up
+			// to one sample away from the center of this level.
+			const Level& prevLevel = mLevels[i - 1];
+			const INT32 offsetX = prevLevel.centerX / 2 - level.centerX;
+			const INT32 offsetZ = prevLevel.centerZ / 2 - level.centerZ;
+
+			const INT32 meshIdx = (offsetZ + 1) * 3 + (offsetX + 1);
+			if (meshIdx != level.meshIdx)
+			{
+				level.meshIdx = meshIdx;
+				level.renderable->setMesh(mRingMeshes[meshIdx]);
+			}
+		}
+	}
+
+	bool TerrainClipmap::isTileLoaded(UINT32 x, UINT32 z) const
+	{
+		if (x >= mNumTilesX || z >= mNumTilesZ)
+			return false;
+
+		return mTiles[z * mNumTilesX + x].state == TileState::Loaded;
+	}
+
+	UINT32 TerrainClipmap::getNumPending() const
+	{
+		UINT32 numPending = 0;
+		for (auto& entry : mTiles)
+		{
+			if (entry.state == TileState::Loading)
+				numPending++;
+		}
+
+		return numPending;
+	}
+
+	void TerrainClipmap::createLevels()
+	{
+		if (mDesc.material == nullptr)
+		{
+			LOGERR("Cannot create terrain clipmap levels, no material was provided.");
+			return;
+		}
+
+		const UINT32 gridSize = mDesc.gridSize;
+		const float halfSize = (float)(gridSize / 2);
+		const float morphWidth = (float)(gridSize / 8);
+		const float textureSize = (float)(gridSize + 3);
+
+		// Levels are drawn with one of these depending on which way the hole is offset
+		mCenterMesh = Mesh::create(createGridMesh(gridSize, false, 0, 0));
+		for (INT32 z = -1; z <= 1; z++)
+		{
+			for (INT32 x = -1; x <= 1; x++)
+				mRingMeshes.push_back(Mesh::create(createGridMesh(gridSize, true, x, z)));
+		}
+
+		const float minHeight = std::min(mDesc.heightOffset, mDesc.heightOffset + mDesc.heightScale);
+		const float maxHeight = std::max(mDesc.heightOffset, mDesc.heightOffset + mDesc.heightScale);
+		const AABox bounds(Vector3(-halfSize, minHeight, -halfSize), Vector3(halfSize, maxHeight, halfSize));
+
+		for (UINT32 i = 0; i < mDesc.numLevels; i++)
+		{
+			const Vector2 levelSpacing = mDesc.spacing * (float)(1 << i);
+
+			// The last level has no next level to morph towards
+			const bool last = i == (mDesc.numLevels - 1);
+			const float morphStart = last ? halfSize + 1.0f : halfSize - morphWidth;
+
+			Level level;
+			level.so = SceneObject::create("Terrain level " + toString(i), SOF_DontSave);
+			if (mParent != nullptr && !mParent.isDestroyed())
+				level.so->setParent(mParent, false);
+
+			level.so->setScale(Vector3(levelSpacing.x, 1.0f, levelSpacing.y));
+
+			level.material = mDesc.material->clone();
+			level.material->setVec4("gClipmapLevel", Vector4(1.0f / textureSize, halfSize + 1.0f, morphStart,
+				1.0f / morphWidth));
+			level.material->setVec2("gClipmapSpacing", levelSpacing);
+			level.material->setVec2("gHeightScaleOffset", Vector2(mDesc.heightScale, mDesc.heightOffset));
+
+			level.renderable = level.so->addComponent<CRenderable>();
+			level.renderable->setMaterial(level.material);
+			level.renderable->setLayer(mDesc.layer);
+			level.renderable->setCastsShadows(false);
+
+			// Mesh bounds don't account for the displacement
+			level.renderable->_getInternal()->setOverrideBounds(bounds);
+			level.renderable->_getInternal()->setUseOverrideBounds(true);
+
+			if (i == 0)
+				level.renderable->setMesh(mCenterMesh);
+
+			mLevels.push_back(level);
+		}
+	}
+
+	void TerrainClipmap::destroyLevels()
+	{
+		for (auto& entry : mLevels)
+		{
+			if (entry.so != nullptr && !entry.so.isDestroyed())
+				entry.so->destroy();
+		}
+
+		mLevels.clear();
+		mCenterMesh = nullptr;
+		mRingMeshes.clear();
+	}
+
+	void TerrainClipmap::updateTiles(const Vector2& viewPosition)
+	{
+		const float maxSpacing = std::max(mDesc.spacing.x, mDesc.spacing.y);
+		const float tileExtent = mDesc.tileSize * maxSpacing;
+
+		// Tiles overlapping the last level are needed. It extends this far from the view, including the rounding of
+		// the level center.
+		const float loadDistance = (mDesc.gridSize / 2 + 2) * (float)(1 << (mDesc.numLevels - 1)) * maxSpacing;
+		const float unloadDistance = loadDistance + tileExtent;
+
+		bool changed = false;
+		for (UINT32 z = 0; z < mNumTilesZ; z++)
+		{
+			for (UINT32 x = 0; x < mNumTilesX; x++)
+			{
+				Tile& tile = mTiles[z * mNumTilesX + x];
+
+				const Vector2 tileMin(x * mDesc.tileSize * mDesc.spacing.x, z * mDesc.tileSize * mDesc.spacing.y);
+				const Vector2 tileMax = tileMin + Vector2(mDesc.tileSize * mDesc.spacing.x,
+					mDesc.tileSize * mDesc.spacing.y);
+
+				// Levels are square, so the distance along the further axis determines if they overlap the tile
+				const Vector2 closest = Vector2::max(tileMin, Vector2::min(viewPosition, tileMax));
+				const float distance = std::max(std::abs(viewPosition.x - closest.x),
+					std::abs(viewPosition.y - closest.y));
+
+				if (tile.state == TileState::Unloaded)
+				{
+					if (distance < loadDistance)
+						load(tile, distance);
+				}
+				else if (distance > unloadDistance)
+				{
+					changed |= tile.state == TileState::Loaded;
+					unload(tile);
+				}
+
+				if (tile.state != TileState::Loading)
+					continue;
+
+				const bool heightLoaded = tile.loadedHeightMap == nullptr || tile.loadedHeightMap.isLoaded();
+				const bool splatLoaded = tile.loadedSplatMap == nullptr || tile.loadedSplatMap.isLoaded();
+
+				if (heightLoaded && splatLoaded)
+				{
+					finishLoad(tile, x, z);
+					changed = true;
+				}
+				else
+				{
+					RESOURCE_LOAD_PRIORITY priority;
+					priority.priority = -distance;
+
+					if (!heightLoaded)
+						gResources().setLoadPriority(tile.loadedHeightMap, priority);
+
+					if (!splatLoaded)
+						gResources().setLoadPriority(tile.loadedSplatMap, priority);
+				}
+			}
+		}
+
+		// Level textures are tiny compared to the tiles, so they are simply all rebuilt
+		if (changed)
+		{
+			for (auto& entry : mLevels)
+				entry.dirty = true;
+		}
+	}
+
+	void TerrainClipmap::load(Tile& tile, float distance)
+	{
+		RESOURCE_LOAD_PRIORITY priority;
+		priority.priority = -distance;
+
+		// No internal reference is kept, so the textures get unloaded as soon as their samples are copied out
+		auto loadTexture = [&priority](const WeakResourceHandle<Texture>& texture)
+		{
+			if (texture.getUUID().empty())
+				return HTexture();
+
+			HTexture loaded = static_resource_cast<Texture>(gResources().loadFromUUID(texture.getUUID(), true,
+				ResourceLoadFlag::None, priority));
+
+			if (loaded == nullptr)
+			{
+				LOGWRN("Cannot load terrain tile, texture with UUID " + texture.getUUID().toString() +
+					" cannot be found.");
+			}
+
+			return loaded;
+		};
+
+		tile.loadedHeightMap = loadTexture(tile.heightMap);
+		tile.loadedSplatMap = loadTexture(tile.splatMap);
+		tile.state = TileState::Loading;
+	}
+
+	void TerrainClipmap::finishLoad(Tile& tile, UINT32 x, UINT32 z)
+	{
+		const UINT32 numSamples = mDesc.tileSize + 1;
+
+		if (tile.loadedHeightMap != nullptr)
+		{
+			SPtr<PixelData> pixelData = readTileTexture(tile.loadedHeightMap, numSamples);
+			if (pixelData != nullptr)
+			{
+				tile.heights.resize(numSamples * numSamples);
+				for (UINT32 i = 0; i < numSamples; i++)
+				{
+					for (UINT32 j = 0; j < numSamples; j++)
+						tile.heights[i * numSamples + j] = pixelData->getColorAt(j, i).r;
+				}
+			}
+		}
+
+		if (tile.loadedSplatMap != nullptr)
+		{
+			SPtr<PixelData> pixelData = readTileTexture(tile.loadedSplatMap, numSamples);
+			if (pixelData != nullptr)
+			{
+				tile.weights.resize(numSamples * numSamples);
+				for (UINT32 i = 0; i < numSamples; i++)
+				{
+					for (UINT32 j = 0; j < numSamples; j++)
+						tile.weights[i * numSamples + j] = pixelData->getColorAt(j, i);
+				}
+			}
+		}
+
+		tile.loadedHeightMap = nullptr;
+		tile.loadedSplatMap = nullptr;
+		tile.state = TileState::Loaded;
+
+		if (!mDesc.createColliders || tile.heights.empty())
+			return;
+
+		Vector<float> heights(tile.heights.size());
+		for (UINT32 i = 0; i < (UINT32)heights.size(); i++)
+			heights[i] = tile.heights[i] * mDesc.heightScale + mDesc.heightOffset;
+
+		tile.colliderSO = SceneObject::create("Terrain tile collider", SOF_DontSave);
+		if (mParent != nullptr && !mParent.isDestroyed())
+			tile.colliderSO->setParent(mParent, false);
+
+		tile.colliderSO->setPosition(Vector3(x * mDesc.tileSize * mDesc.spacing.x, 0.0f,
+			z * mDesc.tileSize * mDesc.spacing.y));
+		tile.colliderSO->setMobility(ObjectMobility::Static);
+
+		HHeightFieldCollider collider = tile.colliderSO->addComponent<CHeightFieldCollider>();
+		collider->setSpacing(mDesc.spacing);
+		collider->setHeights(heights, numSamples, numSamples);
+	}
+
+	void TerrainClipmap::unload(Tile& tile)
+	{
+		if (tile.state == TileState::Loading)
+		{
+			if (tile.loadedHeightMap != nullptr)
+				gResources().cancelLoad(tile.loadedHeightMap);
+
+			if (tile.loadedSplatMap != nullptr)
+				gResources().cancelLoad(tile.loadedSplatMap);
+		}
+
+		if (tile.colliderSO != nullptr && !tile.colliderSO.isDestroyed())
+			tile.colliderSO->destroy();
+
+		tile.state = TileState::Unloaded;
+		tile.loadedHeightMap = nullptr;
+		tile.loadedSplatMap = nullptr;
+		tile.colliderSO = nullptr;
+
+		// Release the memory, not just the contents
+		Vector<float>().swap(tile.heights);
+		Vector<Color>().swap(tile.weights);
+	}
+
+	void TerrainClipmap::updateLevel(UINT32 idx)
+	{
+		Level& level = mLevels[idx];
+		level.dirty = false;
+
+		const INT32 step = 1 << idx;
+		const Vector2 levelSpacing = mDesc.spacing * (float)step;
+		level.so->setPosition(Vector3(level.centerX * levelSpacing.x, 0.0f, level.centerZ * levelSpacing.y));
+
+		// One sample wider than the level on each side, for calculating normals at the level edge
+		const INT32 halfSize = (INT32)mDesc.gridSize / 2 + 1;
+		const UINT32 textureSize = mDesc.gridSize + 3;
+
+		SPtr<PixelData> heightData = PixelData::create(textureSize, textureSize, 1, PF_R16);
+		SPtr<PixelData> splatData = PixelData::create(textureSize, textureSize, 1, PF_RGBA8);
+
+		auto heights = (UINT16*)heightData->getData();
+		const UINT32 rowPitch = heightData->getRowPitch();
+
+		for (UINT32 i = 0; i < textureSize; i++)
+		{
+			const INT32 z = (level.centerZ - halfSize + (INT32)i) * step;
+			for (UINT32 j = 0; j < textureSize; j++)
+			{
+				const INT32 x = (level.centerX - halfSize + (INT32)j) * step;
+
+				heights[i * rowPitch + j] = (UINT16)Math::roundToPosInt(Math::clamp01(getHeight(x, z)) * 65535.0f);
+				splatData->setColorAt(getWeights(x, z), j, i);
+			}
+		}
+
+		// New textures are created, rather than written to, so the GPU never sees heights that don't match the level
+		// position
+		level.material->setTexture("gHeightTex", Texture::create(heightData));
+		level.material->setTexture("gSplatTex", Texture::create(splatData));
+
+		// Terrain area, relative to the level center, in samples of the level
+		const float maxX = (float)(mNumTilesX * mDesc.tileSize) / step;
+		const float maxZ = (float)(mNumTilesZ * mDesc.tileSize) / step;
+		level.material->setVec4("gClipmapBounds", Vector4((float)-level.centerX, (float)-level.centerZ,
+			maxX - level.centerX, maxZ - level.centerZ));
+	}
+
+	float TerrainClipmap::getHeight(INT32 x, INT32 z) const
+	{
+		const INT32 tileSize = (INT32)mDesc.tileSize;
+		x = Math::clamp(x, 0, (INT32)mNumTilesX * tileSize);
+		z = Math::clamp(z, 0, (INT32)mNumTilesZ * tileSize);
+
+		// Samples along tile edges are shared, and read from the tile preceding the edge
+		const INT32 tileX = std::min(x / tileSize, (INT32)mNumTilesX - 1);
+		const INT32 tileZ = std::min(z / tileSize, (INT32)mNumTilesZ - 1);
+
+		const Tile& tile = mTiles[tileZ * mNumTilesX + tileX];
+		if (tile.heights.empty())
+			return 0.0f;
+
+		return tile.heights[(z - tileZ * tileSize) * (tileSize + 1) + (x - tileX * tileSize)];
+	}
+
+	Color TerrainClipmap::getWeights(INT32 x, INT32 z) const
+	{
+		const INT32 tileSize = (INT32)mDesc.tileSize;
+		x = Math::clamp(x, 0, (INT32)mNumTilesX * tileSize);
+		z = Math::clamp(z, 0, (INT32)mNumTilesZ * tileSize);
+
+		const INT32 tileX = std::min(x / tileSize, (INT32)mNumTilesX - 1);
+		const INT32 tileZ = std::min(z / tileSize, (INT32)mNumTilesZ - 1);
+
+		const Tile& tile = mTiles[tileZ * mNumTilesX + tileX];
+		if (tile.weights.empty())
+			return Color(1.0f, 0.0f, 0.0f, 0.0f);
+
+		return tile.weights[(z - tileZ * tileSize) * (tileSize + 1) + (x - tileX * tileSize)];
+	}
+}
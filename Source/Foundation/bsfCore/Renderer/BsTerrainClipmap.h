@@ -0,0 +1,196 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsColor.h"
+#include "Math/BsVector2.h"
+#include "Math/BsVector3.h"
+#include "Resources/BsResourceHandle.h"
+
+namespace bs
+{
+	/** @addtogroup Renderer
+	 *  @{
+	 */
+
+	/** Options controlling how is terrain rendered and streamed by TerrainClipmap. */
+	struct TERRAIN_CLIPMAP_DESC
+	{
+		/** Distance between neighbouring height samples, along the X and Z axes. */
+		Vector2 spacing = Vector2::ONE;
+
+		/**
+		 * Number of quads along each side of a streamed tile. Tile textures must contain one more sample than this
+		 * along each side, with neighbouring tiles sharing the samples along their common edge.
+		 */
+		UINT32 tileSize = 256;
+
+		/** Number of quads along each side of a clipmap level. Rounded up to a multiple of 8. */
+		UINT32 gridSize = 64;
+
+		/** Number of clipmap levels. Each level covers twice the area of the previous one, at half the resolution. */
+		UINT32 numLevels = 6;
+
+		/** Multiplier applied to values stored in the height tiles, in range [0, 1], to get the height. */
+		float heightScale = 100.0f;
+
+		/** Offset added to the heights after applying @p heightScale. */
+		float heightOffset = 0.0f;
+
+		/**
+		 * Material to render the terrain with. Must use BuiltinShader::Terrain, or a shader providing the same
+		 * parameters. Each level renders with its own copy of the material.
+		 */
+		HMaterial material;
+
+		/** Layer the terrain is drawn on. */
+		UINT64 layer = 1;
+
+		/** Determines should a height field collider be created for each loaded tile. */
+		bool createColliders = true;
+	};
+
+	/**
+	 * Renders terrain as a set of nested square rings (a geometry clipmap) centered around the viewer, streaming the
+	 * terrain height and splat maps in tiles. Each level is a fixed grid mesh drawn with a single draw call, covering
+	 * twice the area of the previous level at half the resolution, with a hole in its center where the previous level
+	 * is drawn. Grid vertices are displaced on the GPU by sampling a small per-level height texture, built on the CPU
+	 * from the resident tiles whenever the level moves. Vertices near the outer edge of a level are morphed towards the
+	 * grid of the next level, so neighbouring levels meet without cracks or popping.
+	 *
+	 * Tiles are textures with TU_CPUCACHED usage, stored as resources loadable by their UUID through
+	 * Resources::loadFromUUID(). Height tiles store heights in their red channel and splat tiles store weights of up to
+	 * four material layers. Tiles covered by the clipmap are loaded asynchronously, closest tiles first. Once loaded
+	 * their samples are copied out and the texture released, so only the samples of tiles near the viewer stay in
+	 * memory. Missing or still loading tiles are treated as flat.
+	 *
+	 * Terrain levels don't cast shadows, because shadow maps are rendered without displacement.
+	 */
+	class BS_CORE_EXPORT TerrainClipmap
+	{
+	public:
+		TerrainClipmap(const TERRAIN_CLIPMAP_DESC& desc = TERRAIN_CLIPMAP_DESC());
+		~TerrainClipmap();
+
+		/**
+		 * Sets up the tiles the terrain consists of, replacing any previous ones.
+		 *
+		 * @param[in]	numTilesX	Number of tiles along the X axis.
+		 * @param[in]	numTilesZ	Number of tiles along the Z axis.
+		 * @param[in]	heightTiles	Height map of each tile, row by row, where each row contains @p numTilesX tiles
+		 *							along the X axis, and rows follow each other along the Z axis. The textures don't
+		 *							need to be loaded.
+		 * @param[in]	splatTiles	Splat map of each tile, in the same order as @p heightTiles. Must be of the same
+		 *							size as the height tiles. Can be empty, in which case the first layer is used
+		 *							everywhere.
+		 */
+		void setTiles(UINT32 numTilesX, UINT32 numTilesZ, const Vector<WeakResourceHandle<Texture>>& heightTiles,
+			const Vector<WeakResourceHandle<Texture>>& splatTiles = Vector<WeakResourceHandle<Texture>>());
+
+		/** Removes all tiles, releasing their samples and destroying the terrain scene objects. */
+		void clearTiles();
+
+		/**
+		 * Scene object to parent the terrain to. The terrain starts at the origin of the parent. If not provided, the
+		 * terrain is created at the scene root.
+		 */
+		void setParent(const HSceneObject& parent);
+
+		/**
+		 * Moves the clipmap levels to the provided view position, starts and stops tile loads, and updates the level
+		 * textures. Should be called once per frame.
+		 *
+		 * @param[in]	viewPosition	Position of the viewer, in world space.
+		 */
+		void update(const Vector3& viewPosition);
+
+		/** Checks if the samples of the tile at the provided index are resident. */
+		bool isTileLoaded(UINT32 x, UINT32 z) const;
+
+		/** Returns the number of tiles that have started loading but haven't loaded yet. */
+		UINT32 getNumPending() const;
+
+	private:
+		/** Loading stage a tile is in. */
+		enum class TileState
+		{
+			Unloaded,
+			Loading,
+			Loaded
+		};
+
+		/** Information about a single streamed tile. */
+		struct Tile
+		{
+			WeakResourceHandle<Texture> heightMap;
+			WeakResourceHandle<Texture> splatMap;
+
+			TileState state = TileState::Unloaded;
+			HTexture loadedHeightMap;
+			HTexture loadedSplatMap;
+
+			/** Resident samples of the tile, row by row. Empty if the tile isn't loaded or its texture is missing. */
+			Vector<float> heights;
+			Vector<Color> weights;
+
+			HSceneObject colliderSO;
+		};
+
+		/** A single clipmap level. */
+		struct Level
+		{
+			HSceneObject so;
+			HRenderable renderable;
+			HMaterial material;
+
+			/** Position of the level center, in samples of the level. Always even. */
+			INT32 centerX = 0;
+			INT32 centerZ = 0;
+
+			/** Index of the ring mesh the level is drawn with, or -1 if it hasn't been assigned yet. */
+			INT32 meshIdx = -1;
+
+			bool dirty = true;
+		};
+
+		/** Creates the level scene objects, materials and meshes. */
+		void createLevels();
+
+		/** Destroys the level scene objects. */
+		void destroyLevels();
+
+		/** Streams tiles in and out depending on their distance from the view position, in terrain space. */
+		void updateTiles(const Vector2& viewPosition);
+
+		/** Starts loading the tile textures. */
+		void load(Tile& tile, float distance);
+
+		/** Copies the samples out of the loaded tile textures, and creates the tile collider. */
+		void finishLoad(Tile& tile, UINT32 x, UINT32 z);
+
+		/** Releases the tile samples and textures, and destroys its collider. */
+		void unload(Tile& tile);
+
+		/** Rebuilds the level height and splat textures from the resident tile samples, and updates its material. */
+		void updateLevel(UINT32 idx);
+
+		/** Returns the height map value of the sample at the provided coordinates, clamped to the terrain. */
+		float getHeight(INT32 x, INT32 z) const;
+
+		/** Returns the layer weights of the sample at the provided coordinates, clamped to the terrain. */
+		Color getWeights(INT32 x, INT32 z) const;
+
+		TERRAIN_CLIPMAP_DESC mDesc;
+		UINT32 mNumTilesX = 0;
+		UINT32 mNumTilesZ = 0;
+		Vector<Tile> mTiles;
+
+		Vector<Level> mLevels;
+		HMesh mCenterMesh;
+		Vector<HMesh> mRingMeshes;
+		HSceneObject mParent;
+	};
+
+	/** @} */
+}
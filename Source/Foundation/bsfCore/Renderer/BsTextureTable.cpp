@@ -0,0 +1,283 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Renderer/BsTextureTable.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "CoreThread/BsCoreThread.h"
+
+namespace bs { namespace ct
+{
+	constexpr UINT32 TextureTable::MAX_LAYERS_PER_PAGE;
+	constexpr UINT32 TextureTable::MAX_INDEXED_TEXTURES;
+	constexpr UINT32 TextureTable::INVALID_INDEX;
+
+	/** Number of layers a page is created with. Pages double in size as they fill up. */
+	static constexpr UINT32 INITIAL_LAYERS_PER_PAGE = 4;
+
+	/**
+	 * Number of frames a released slot of an indexed table waits before it is re-used. Matches the number of frames the
+	 * GPU might still be executing, so draws recorded before the release never see a different texture.
+	 */
+	static constexpr UINT64 SLOT_REUSE_DELAY = CoreThread::NUM_SYNC_BUFFERS + 1;
+
+	TextureTable::TextureTable()
+	{
+		mIndexed = RenderAPI::instance().getCapabilities(0).hasCapability(RSC_TEXTURE_DESCRIPTOR_INDEXING);
+	}
+
+	TextureTable::~TextureTable()
+	{
+		if (!mIndexed)
+			return;
+
+		// Clears retired slots as well, since the render API keeps referencing their textures until they're re-used
+		RenderAPI& rapi = RenderAPI::instance();
+		for (UINT32 i = 0; i < (UINT32)mSlots.size(); i++)
+			rapi.setTextureTableEntry(i, nullptr);
+	}
+
+	UINT32 TextureTable::registerTexture(const SPtr<Texture>& texture)
+	{
+		if (texture == nullptr)
+			return INVALID_INDEX;
+
+		auto iterFind = mIndices.find(texture.get());
+		if (iterFind != mIndices.end())
+		{
+			getEntry(iterFind->second).refCount++;
+			return iterFind->second;
+		}
+
+		const TextureProperties& props = texture->getProperties();
+		if (props.getTextureType() != TEX_TYPE_2D || props.getNumArraySlices() > 1 || props.getNumSamples() > 1)
+			return INVALID_INDEX;
+
+		// Textures written by the GPU or updated every frame would need to be re-copied or re-transitioned on every use
+		const int unsupportedUsage = TU_DYNAMIC | TU_RENDERTARGET | TU_DEPTHSTENCIL | TU_LOADSTORE;
+		if ((props.getUsage() & unsupportedUsage) != 0)
+			return INVALID_INDEX;
+
+		const UINT32 index = mIndexed ? registerIndexed(texture) : registerInPage(texture);
+		if (index == INVALID_INDEX)
+			return INVALID_INDEX;
+
+		Entry& entry = getEntry(index);
+		entry.texture = texture;
+		entry.refCount = 1;
+
+		mIndices[texture.get()] = index;
+		return index;
+	}
+
+	void TextureTable::unregisterTexture(UINT32 index)
+	{
+		if (index == INVALID_INDEX)
+			return;
+
+		Entry& entry = getEntry(index);
+		assert(entry.texture != nullptr && entry.refCount > 0);
+
+		entry.refCount--;
+		if (entry.refCount > 0)
+			return;
+
+		mIndices.erase(entry.texture.get());
+		entry.texture = nullptr;
+
+		// Draws already submitted might still be sampling the slot, so it is left as is until it is safe to re-use
+		if (mIndexed)
+		{
+			mRetiredSlots.push_back({ index, mFrameIdx });
+			return;
+		}
+
+		Page& page = mPages[getPage(index)];
+		page.freeLayers.push_back(getLayer(index));
+		page.numUsedLayers--;
+
+		// Release the memory of pages no longer in use
+		if (page.numUsedLayers == 0)
+		{
+			page.texture = nullptr;
+			page.layers.clear();
+			page.freeLayers.clear();
+			page.desc.numArraySlices = 0;
+		}
+	}
+
+	void TextureTable::updateTexture(UINT32 index)
+	{
+		if (index == INVALID_INDEX || mIndexed)
+			return;
+
+		const Page& page = mPages[getPage(index)];
+		const UINT32 layer = getLayer(index);
+
+		copyToLayer(page, page.layers[layer].texture, layer);
+	}
+
+	void TextureTable::update()
+	{
+		mFrameIdx++;
+
+		UINT32 numRetired = 0;
+		for (auto& entry : mRetiredSlots)
+		{
+			if (mFrameIdx - entry.frameIdx >= SLOT_REUSE_DELAY)
+			{
+				RenderAPI::instance().setTextureTableEntry(entry.index, nullptr);
+				mFreeSlots.push_back(entry.index);
+			}
+			else
+				mRetiredSlots[numRetired++] = entry;
+		}
+
+		mRetiredSlots.resize(numRetired);
+	}
+
+	SPtr<Texture> TextureTable::getPageTexture(UINT32 index) const
+	{
+		if (index == INVALID_INDEX || mIndexed)
+			return nullptr;
+
+		return mPages[getPage(index)].texture;
+	}
+
+	UINT32 TextureTable::registerIndexed(const SPtr<Texture>& texture)
+	{
+		UINT32 index;
+		if (!mFreeSlots.empty())
+		{
+			index = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+		else if ((UINT32)mSlots.size() < MAX_INDEXED_TEXTURES)
+		{
+			index = (UINT32)mSlots.size();
+			mSlots.push_back(Entry());
+		}
+		else
+			return INVALID_INDEX;
+
+		RenderAPI::instance().setTextureTableEntry(index, texture);
+		return index;
+	}
+
+	UINT32 TextureTable::registerInPage(const SPtr<Texture>& texture)
+	{
+		const TextureProperties& props = texture->getProperties();
+
+		UINT32 pageIdx = 0;
+		for (; pageIdx < (UINT32)mPages.size(); pageIdx++)
+		{
+			const Page& page = mPages[pageIdx];
+			if (isCompatible(page, props) && page.numUsedLayers < MAX_LAYERS_PER_PAGE)
+				break;
+		}
+
+		if (pageIdx == (UINT32)mPages.size())
+		{
+			// Re-use an empty page, if any, before creating a new one
+			pageIdx = 0;
+			for (; pageIdx < (UINT32)mPages.size(); pageIdx++)
+			{
+				if (mPages[pageIdx].numUsedLayers == 0)
+					break;
+			}
+
+			if (pageIdx == (UINT32)mPages.size())
+				mPages.push_back(Page());
+
+			Page& page = mPages[pageIdx];
+			page.desc = TEXTURE_DESC();
+			page.desc.type = TEX_TYPE_2D;
+			page.desc.format = props.getFormat();
+			page.desc.width = props.getWidth();
+			page.desc.height = props.getHeight();
+			page.desc.numMips = props.getNumMipmaps();
+			page.desc.hwGamma = props.isHardwareGammaEnabled();
+			page.desc.usage = TU_STATIC;
+			page.desc.numArraySlices = 0;
+
+			page.texture = nullptr;
+			page.layers.clear();
+			page.freeLayers.clear();
+		}
+
+		Page& page = mPages[pageIdx];
+		if (page.freeLayers.empty())
+			resizePage(page, std::max(INITIAL_LAYERS_PER_PAGE, page.desc.numArraySlices * 2));
+
+		const UINT32 layer = page.freeLayers.back();
+		page.freeLayers.pop_back();
+		page.numUsedLayers++;
+
+		copyToLayer(page, texture, layer);
+		return pageIdx * MAX_LAYERS_PER_PAGE + layer;
+	}
+
+	TextureTable::Entry& TextureTable::getEntry(UINT32 index)
+	{
+		if (mIndexed)
+			return mSlots[index];
+
+		return mPages[getPage(index)].layers[getLayer(index)];
+	}
+
+	bool TextureTable::isCompatible(const Page& page, const TextureProperties& props)
+	{
+		return page.texture != nullptr &&
+			page.desc.format == props.getFormat() &&
+			page.desc.width == props.getWidth() &&
+			page.desc.height == props.getHeight() &&
+			page.desc.numMips == props.getNumMipmaps() &&
+			page.desc.hwGamma == props.isHardwareGammaEnabled();
+	}
+
+	void TextureTable::resizePage(Page& page, UINT32 numLayers)
+	{
+		numLayers = std::min(numLayers, MAX_LAYERS_PER_PAGE);
+
+		const UINT32 oldNumLayers = page.desc.numArraySlices;
+		const SPtr<Texture> oldTexture = page.texture;
+
+		page.desc.numArraySlices = numLayers;
+		page.texture = Texture::create(page.desc);
+
+		// Copy the existing layers on the GPU, rather than from the source textures, since those might have changed
+		for (UINT32 layer = 0; layer < oldNumLayers; layer++)
+		{
+			if (page.layers[layer].texture == nullptr)
+				continue;
+
+			for (UINT32 mip = 0; mip <= page.desc.numMips; mip++)
+			{
+				TEXTURE_COPY_DESC copyDesc;
+				copyDesc.srcFace = layer;
+				copyDesc.srcMip = mip;
+				copyDesc.dstFace = layer;
+				copyDesc.dstMip = mip;
+
+				oldTexture->copy(page.texture, copyDesc);
+			}
+		}
+
+		page.layers.resize(numLayers);
+
+		// Free layers are taken from the back, so push them in reverse order to fill the page from the start
+		for (UINT32 layer = numLayers; layer > oldNumLayers; layer--)
+			page.freeLayers.push_back(layer - 1);
+	}
+
+	void TextureTable::copyToLayer(const Page& page, const SPtr<Texture>& texture, UINT32 layer)
+	{
+		for (UINT32 mip = 0; mip <= page.desc.numMips; mip++)
+		{
+			TEXTURE_COPY_DESC copyDesc;
+			copyDesc.srcMip = mip;
+			copyDesc.dstFace = layer;
+			copyDesc.dstMip = mip;
+
+			texture->copy(page.texture, copyDesc);
+		}
+	}
+}}
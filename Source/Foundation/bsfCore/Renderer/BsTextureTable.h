@@ -0,0 +1,144 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Image/BsTexture.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Renderer-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Global table of textures, assigning each registered texture a stable index. Materials can reference textures by
+	 * their index (e.g. through per-object data) instead of binding them individually, allowing objects using different
+	 * textures to share the same GPU parameters and be drawn together.
+	 *
+	 * When the render API supports RSC_TEXTURE_DESCRIPTOR_INDEXING the table is indexed: every index refers to a slot
+	 * in a single array of textures visible to all shaders, which the render API keeps up to date through
+	 * RenderAPI::setTextureTableEntry(). Textures are referenced directly, without copying.
+	 *
+	 * Otherwise textures are stored in pages, each page being a 2D texture array holding textures of the same format,
+	 * size and number of mip levels. Registered textures are copied into a free layer of a compatible page. Shaders
+	 * sample the page texture array, using the layer returned by getLayer(). Textures in the same page can always be
+	 * drawn together.
+	 */
+	class BS_CORE_EXPORT TextureTable : public Module<TextureTable>
+	{
+	public:
+		/** Maximum number of textures a single page can hold. */
+		static constexpr UINT32 MAX_LAYERS_PER_PAGE = 64;
+
+		/** Number of slots in the table when it is indexed. Must match the size of the table array in shaders. */
+		static constexpr UINT32 MAX_INDEXED_TEXTURES = 1024;
+
+		/** Index returned when a texture cannot be registered. */
+		static constexpr UINT32 INVALID_INDEX = (UINT32)-1;
+
+		TextureTable();
+		~TextureTable();
+
+		/**
+		 * Registers a texture with the table. Only non-multisampled 2D textures without array slices, that aren't
+		 * written to by the GPU or dynamically updated, are supported. Registering the same texture multiple times
+		 * returns the same index, and each registration must be matched by a call to unregisterTexture().
+		 *
+		 * @param[in]	texture		Texture to register.
+		 * @return					Index of the texture in the table, or INVALID_INDEX if the texture is not supported
+		 *							or the table is full. Index remains valid until the texture is unregistered.
+		 */
+		UINT32 registerTexture(const SPtr<Texture>& texture);
+
+		/**
+		 * Releases a registration made by registerTexture(). Once all registrations of a texture are released its slot
+		 * is freed for use by other textures.
+		 */
+		void unregisterTexture(UINT32 index);
+
+		/**
+		 * Copies the contents of a registered texture into its page again, after the texture was modified. Not required
+		 * if the table is indexed.
+		 */
+		void updateTexture(UINT32 index);
+
+		/**
+		 * Releases slots freed by unregisterTexture() for re-use, once the GPU can no longer be referencing them.
+		 * Should be called once per frame.
+		 */
+		void update();
+
+		/** Checks are the textures referenced through a single descriptor-indexed array, rather than through pages. */
+		bool isIndexed() const { return mIndexed; }
+
+		/**
+		 * Returns the texture array containing the texture with the specified index. Pages are re-created when they
+		 * need to grow, so the returned texture should not be stored and should be retrieved each time it is bound.
+		 * Returns null if the table is indexed.
+		 */
+		SPtr<Texture> getPageTexture(UINT32 index) const;
+
+		/** Returns the page containing the texture with the specified index. Always zero if the table is indexed. */
+		UINT32 getPage(UINT32 index) const { return mIndexed ? 0 : index / MAX_LAYERS_PER_PAGE; }
+
+		/** Returns the layer of the page texture array containing the texture with the specified index. */
+		static UINT32 getLayer(UINT32 index) { return index % MAX_LAYERS_PER_PAGE; }
+
+	private:
+		/** Texture registered with the table. */
+		struct Entry
+		{
+			SPtr<Texture> texture;
+			UINT32 refCount = 0;
+		};
+
+		/** 2D texture array storing textures with the same properties. */
+		struct Page
+		{
+			TEXTURE_DESC desc;
+			SPtr<Texture> texture;
+			Vector<Entry> layers;
+			Vector<UINT32> freeLayers;
+			UINT32 numUsedLayers = 0;
+		};
+
+		/** Slot of an indexed table released by unregisterTexture(), waiting for the GPU to finish using it. */
+		struct RetiredSlot
+		{
+			UINT32 index;
+			UINT64 frameIdx;
+		};
+
+		/** Finds a free slot of the indexed table and assigns the texture to it. */
+		UINT32 registerIndexed(const SPtr<Texture>& texture);
+
+		/** Copies the texture into a free layer of a compatible page. */
+		UINT32 registerInPage(const SPtr<Texture>& texture);
+
+		/** Returns the entry representing the texture with the specified index. */
+		Entry& getEntry(UINT32 index);
+
+		/** Checks can the texture with the specified properties be stored in the page. */
+		static bool isCompatible(const Page& page, const TextureProperties& props);
+
+		/** Re-creates the page texture array with more layers, preserving the contents of the existing layers. */
+		void resizePage(Page& page, UINT32 numLayers);
+
+		/** Copies all mip levels of the texture into a layer of the page texture array. */
+		static void copyToLayer(const Page& page, const SPtr<Texture>& texture, UINT32 layer);
+
+		bool mIndexed = false;
+		UnorderedMap<Texture*, UINT32> mIndices;
+
+		Vector<Page> mPages;
+
+		Vector<Entry> mSlots;
+		Vector<UINT32> mFreeSlots;
+		Vector<RetiredSlot> mRetiredSlots;
+		UINT64 mFrameIdx = 0;
+	};
+
+	/** @} */
+}}
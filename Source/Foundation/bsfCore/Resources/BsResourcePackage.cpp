@@ -0,0 +1,314 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Resources/BsResourcePackage.h"
+#include "Resources/BsResourceManifest.h"
+#include "Resources/BsSavedResourceData.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Serialization/BsFileSerializer.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Utility/BsCompression.h"
+#include "Utility/BsBitwise.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	/** Reads the list of dependencies from the resource file at the specified path, without loading the resource. */
+	static Vector<UUID> readResourceDependencies(const Path& path)
+	{
+		FileDecoder fs(path);
+		SPtr<SavedResourceData> savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
+
+		if(savedResourceData)
+			return savedResourceData->getDependencies();
+
+		return Vector<UUID>();
+	}
+
+	ResourcePackage::ResourcePackage(const ConstructPrivately& dummy)
+	{ }
+
+	const ResourcePackage::Entry* ResourcePackage::findEntry(const UUID& uuid) const
+	{
+		const Entry* end = mEntries + mNumEntries;
+		const Entry* iterFind = std::lower_bound(mEntries, end, uuid,
+			[](const Entry& entry, const UUID& value) { return entry.uuid < value; });
+
+		if(iterFind != end && iterFind->uuid == uuid)
+			return iterFind;
+
+		return nullptr;
+	}
+
+	SPtr<DataStream> ResourcePackage::openEntry(const UUID& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if(!entry)
+			return nullptr;
+
+		if((entry->flags & EF_Compressed) == 0)
+			return bs_shared_ptr_new<MappedFileDataStream>(mFile, (size_t)entry->offset, (size_t)entry->size);
+
+		UINT8* data = const_cast<UINT8*>(mFile->getData()) + entry->offset;
+
+		SPtr<DataStream> compressedStream = bs_shared_ptr_new<MemoryDataStream>(data + entry->headerSize,
+			(size_t)(entry->size - entry->headerSize), false);
+
+		if ((entry->uncompressedSize - entry->headerSize) > Compression::STREAMING_THRESHOLD)
+		{
+			SPtr<DataStream> entryStream = bs_shared_ptr_new<MappedFileDataStream>(mFile, (size_t)entry->offset, 
+				(size_t)entry->size);
+			SPtr<DataStream> output = Compression::decompressBlocksStreamed(entryStream, entry->headerSize);
+			if (!output || output->size() != entry->uncompressedSize)
+			{
+				LOGERR("Corrupt resource package entry for resource " + uuid.toString() + " in package \"" +
+					mPath.toString() + "\".");
+				return nullptr;
+			}
+
+			return output;
+		}
+
+		SPtr<MemoryDataStream> bodyStream = Compression::decompressBlocks(compressedStream);
+		if(!bodyStream || (bodyStream->size() + entry->headerSize) != entry->uncompressedSize)
+		{
+			LOGERR("Corrupt resource package entry for resource " + uuid.toString() + " in package \"" +
+				mPath.toString() + "\".");
+			return nullptr;
+		}
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)entry->uncompressedSize);
+		UINT8* outputData = output->getPtr();
+
+		memcpy(outputData, data, entry->headerSize);
+		memcpy(outputData + entry->headerSize, bodyStream->getPtr(), bodyStream->size());
+
+		return output;
+	}
+
+	SPtr<DataStream> ResourcePackage::openEntryHeader(const UUID& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if(!entry)
+			return nullptr;
+
+		return bs_shared_ptr_new<MappedFileDataStream>(mFile, (size_t)entry->offset, (size_t)entry->headerSize);
+	}
+
+	UINT64 ResourcePackage::getEntryOffset(const UUID& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		return entry ? entry->offset : 0;
+	}
+
+	void ResourcePackage::prefetchEntry(const UUID& uuid) const
+	{
+		const Entry* entry = findEntry(uuid);
+		if(entry)
+			mFile->prefetch(entry->offset, entry->size);
+	}
+
+	SPtr<ResourcePackage> ResourcePackage::open(const Path& path)
+	{
+		SPtr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+		if(!file)
+			return nullptr;
+
+		const UINT64 fileSize = file->getSize();
+		if(fileSize < sizeof(Header))
+		{
+			LOGERR("Invalid resource package \"" + path.toString() + "\". File is too small.");
+			return nullptr;
+		}
+
+		Header header;
+		memcpy(&header, file->getData(), sizeof(header));
+
+		if(header.magic != MAGIC || header.version != VERSION)
+		{
+			LOGERR("Invalid resource package \"" + path.toString() + "\". Unrecognized format or version.");
+			return nullptr;
+		}
+
+		const UINT64 tocEnd = sizeof(Header) + (UINT64)header.numEntries * sizeof(Entry);
+		if(fileSize < tocEnd)
+		{
+			LOGERR("Invalid resource package \"" + path.toString() + "\". Table of contents is truncated.");
+			return nullptr;
+		}
+
+		const Entry* entries = (const Entry*)(file->getData() + sizeof(Header));
+		for(UINT32 i = 0; i < header.numEntries; i++)
+		{
+			const Entry& entry = entries[i];
+			if(entry.offset < tocEnd || entry.headerSize > entry.size || entry.offset + entry.size > fileSize)
+			{
+				LOGERR("Invalid resource package \"" + path.toString() + "\". Entry data is out of bounds.");
+				return nullptr;
+			}
+		}
+
+		SPtr<ResourcePackage> output = bs_shared_ptr_new<ResourcePackage>(ConstructPrivately());
+		output->mPath = path;
+		output->mFile = file;
+		output->mEntries = entries;
+		output->mNumEntries = header.numEntries;
+
+		return output;
+	}
+
+	bool ResourcePackage::create(const ResourceManifest& manifest, const Path& path, const RESOURCE_PACKAGE_DESC& desc)
+	{
+		UINT32 alignment = desc.alignment;
+		if(alignment == 0 || !Bitwise::isPow2(alignment))
+		{
+			LOGWRN("Resource package alignment must be a power of two. Using no alignment instead.");
+			alignment = 1;
+		}
+
+		const UnorderedMap<UUID, Path>& resources = manifest.getResources();
+
+		// Order the resources in the same order they will be loaded in. Resources load their dependencies before
+		// themselves, so do a depth-first traversal and output resources after all their dependencies.
+		Vector<UUID> order;
+		UnorderedSet<UUID> visited;
+
+		std::function<void(const UUID&)> visit = [&](const UUID& uuid)
+		{
+			if(!visited.insert(uuid).second)
+				return;
+
+			const auto iterFind = resources.find(uuid);
+			if(iterFind == resources.end() || !FileSystem::isFile(iterFind->second))
+				return;
+
+			for(auto& dependency : readResourceDependencies(iterFind->second))
+				visit(dependency);
+
+			order.push_back(uuid);
+		};
+
+		for(auto& root : desc.roots)
+			visit(root);
+
+		// Place the remaining resources ordered by path, so resources from the same folder end up close together
+		Vector<std::pair<Path, UUID>> remaining;
+		for(auto& entry : resources)
+		{
+			if(visited.find(entry.first) == visited.end() && FileSystem::isFile(entry.second))
+				remaining.push_back(std::make_pair(entry.second, entry.first));
+		}
+
+		std::sort(remaining.begin(), remaining.end(),
+			[](const std::pair<Path, UUID>& lhs, const std::pair<Path, UUID>& rhs)
+			{
+				return lhs.first.toString() < rhs.first.toString();
+			});
+
+		for(auto& entry : remaining)
+			order.push_back(entry.second);
+
+		Path parentDir = path.getDirectory();
+		if (!FileSystem::exists(parentDir))
+			FileSystem::createDir(parentDir);
+
+		std::ofstream stream;
+		stream.open(path.toPlatformString().c_str(), std::ios::out | std::ios::binary);
+		if (stream.fail())
+		{
+			LOGERR("Failed to create resource package: \"" + path.toString() + "\". Error: " + strerror(errno) + ".");
+			return false;
+		}
+
+		// Table of contents is written once all entries are known, reserve space for it
+		Header header;
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.numEntries = (UINT32)order.size();
+		header.alignment = alignment;
+
+		Vector<Entry> entries(order.size());
+		memset(entries.data(), 0, entries.size() * sizeof(Entry));
+
+		stream.write((char*)&header, sizeof(header));
+		stream.write((char*)entries.data(), entries.size() * sizeof(Entry));
+
+		UINT64 offset = sizeof(Header) + entries.size() * sizeof(Entry);
+		for(UINT32 i = 0; i < (UINT32)order.size(); i++)
+		{
+			const UUID& uuid = order[i];
+			const Path& resourcePath = resources.at(uuid);
+
+			SPtr<DataStream> fileStream = FileSystem::openFile(resourcePath);
+			if(!fileStream)
+			{
+				LOGERR("Unable to read resource \"" + resourcePath.toString() + "\" while creating a resource package.");
+				return false;
+			}
+
+			MemoryDataStream fileData(*fileStream);
+			fileStream->close();
+
+			// Meta-data is always stored uncompressed so dependencies can be read without decompressing the entry
+			UINT64 metaDataSize = 0;
+			BinarySerializer::decodeSize(fileData, metaDataSize);
+
+			const UINT32 headerSize = (UINT32)std::min((UINT64)fileData.tell() + metaDataSize, (UINT64)fileData.size());
+
+			Entry& entry = entries[i];
+			entry.uuid = uuid;
+			entry.uncompressedSize = fileData.size();
+			entry.headerSize = headerSize;
+			entry.flags = 0;
+
+			const UINT64 alignedOffset = Math::divideAndRoundUp(offset, (UINT64)alignment) * alignment;
+			for(; offset < alignedOffset; offset++)
+				stream.put(0);
+
+			entry.offset = offset;
+
+			SPtr<MemoryDataStream> compressedBody;
+			const UINT64 bodySize = fileData.size() - headerSize;
+			if(desc.compress && bodySize > 0)
+			{
+				SPtr<DataStream> bodyStream = bs_shared_ptr_new<MemoryDataStream>(fileData.getPtr() + headerSize,
+					(size_t)bodySize, false);
+
+				compressedBody = Compression::compressBlocks(bodyStream);
+				if(compressedBody->size() >= bodySize)
+					compressedBody = nullptr;
+			}
+
+			stream.write((char*)fileData.getPtr(), headerSize);
+			if(compressedBody)
+			{
+				stream.write((char*)compressedBody->getPtr(), compressedBody->size());
+
+				entry.size = headerSize + compressedBody->size();
+				entry.flags |= EF_Compressed;
+			}
+			else
+			{
+				stream.write((char*)fileData.getPtr() + headerSize, bodySize);
+				entry.size = fileData.size();
+			}
+
+			offset += entry.size;
+		}
+
+		// Sort the table of contents so entries can be looked up using a binary search
+		std::sort(entries.begin(), entries.end(),
+			[](const Entry& lhs, const Entry& rhs) { return lhs.uuid < rhs.uuid; });
+
+		stream.seekp(sizeof(Header));
+		stream.write((char*)entries.data(), entries.size() * sizeof(Entry));
+
+		const bool success = !stream.fail();
+		stream.close();
+
+		if(!success)
+			LOGERR("Failed to write resource package: \"" + path.toString() + "\".");
+
+		return success;
+	}
+}
@@ -0,0 +1,137 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsUUID.h"
+
+namespace bs
+{
+	/** @addtogroup Resources-Internal
+	 *  @{
+	 */
+
+	/** Options that control how is a resource package built. */
+	struct RESOURCE_PACKAGE_DESC
+	{
+		/**
+		 * Resources to start the load order from. Resources reachable from the roots are placed in the package in the order
+		 * they will be loaded (dependencies first), while all other resources are placed after them.
+		 */
+		Vector<UUID> roots;
+
+		/** If true, the contents of each resource will be compressed, unless they would end up larger than the original. */
+		bool compress = false;
+
+		/** Alignment of individual resource entries within the package, in bytes. Must be a power of two. */
+		UINT32 alignment = 64;
+	};
+
+	/**
+	 * A single file containing data of multiple resources, allowing them to be loaded without opening a separate file for
+	 * each resource. The table of contents is memory mapped and kept sorted by resource UUID, while resource entries are
+	 * stored in the order they are expected to be loaded in, to minimize seeks.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT ResourcePackage final : public INonCopyable
+	{
+		struct ConstructPrivately {};
+	public:
+		/** Header of the package file. */
+		struct Header
+		{
+			UINT32 magic;
+			UINT32 version;
+			UINT32 numEntries;
+			UINT32 alignment;
+		};
+
+		/** Table of contents entry describing where is a single resource located in the package. */
+		struct Entry
+		{
+			UUID uuid;
+			UINT64 offset; /**< Offset of the entry data, relative to the start of the file. */
+			UINT64 size; /**< Size of the entry data as stored in the package. */
+			UINT64 uncompressedSize; /**< Size of the resource file data the entry was created from. */
+			UINT32 headerSize; /**< Number of bytes at the start of the entry that are never compressed. */
+			UINT32 flags; /**< Combination of EntryFlag values. */
+		};
+
+		/** Flags describing a package entry. */
+		enum EntryFlag
+		{
+			/** Data following the entry header is compressed. */
+			EF_Compressed = 1 << 0
+		};
+
+		static constexpr UINT32 MAGIC = 0x4B505342; // "BSPK"
+		static constexpr UINT32 VERSION = 2;
+
+		ResourcePackage(const ConstructPrivately& dummy);
+
+		/** Returns the path to the package file. */
+		const Path& getPath() const { return mPath; }
+
+		/** Returns the number of resources stored in the package. */
+		UINT32 getNumEntries() const { return mNumEntries; }
+
+		/** Checks does the package contain a resource with the specified UUID. */
+		bool contains(const UUID& uuid) const { return findEntry(uuid) != nullptr; }
+
+		/**
+		 * Opens a stream to the data of the resource with the specified UUID. The data matches the contents of the
+		 * resource file the package was built from. Returns null if the resource isn't in the package. Uncompressed
+		 * entries are read directly from the mapped package file, allowing data blocks to be deserialized without an
+		 * intermediate copy. Large compressed entries are decompressed on demand as the stream is read.
+		 */
+		SPtr<DataStream> openEntry(const UUID& uuid) const;
+
+		/**
+		 * Similar to openEntry() except it only provides access to the saved resource meta-data stored at the start of
+		 * the entry, which can be retrieved without decompressing the rest of the entry.
+		 */
+		SPtr<DataStream> openEntryHeader(const UUID& uuid) const;
+
+		/** 
+		 * Returns the offset of the resource data from the start of the package file, in bytes. Returns zero if the
+		 * resource isn't in the package.
+		 */
+		UINT64 getEntryOffset(const UUID& uuid) const;
+
+		/** 
+		 * Reads the data of the resource with the specified UUID into memory, blocking until done. Subsequent calls to
+		 * openEntry() will then not need to access the disk. Does nothing if the resource isn't in the package.
+		 */
+		void prefetchEntry(const UUID& uuid) const;
+
+		/**
+		 * Opens an existing resource package at the specified path. Returns null if the file doesn't exist or isn't a
+		 * valid resource package.
+		 */
+		static SPtr<ResourcePackage> open(const Path& path);
+
+		/**
+		 * Packs all the resources registered in the manifest into a new package file at the specified location,
+		 * overwriting any existing file.
+		 *
+		 * @param[in]	manifest	Manifest containing the resources to pack.
+		 * @param[in]	path		Location to write the package to.
+		 * @param[in]	desc		Options controlling how is the package built.
+		 * @return					True if the package was successfully written.
+		 */
+		static bool create(const ResourceManifest& manifest, const Path& path,
+			const RESOURCE_PACKAGE_DESC& desc = RESOURCE_PACKAGE_DESC());
+
+	private:
+		/** Finds a table of contents entry for the specified UUID, or returns null if not found. */
+		const Entry* findEntry(const UUID& uuid) const;
+
+		Path mPath;
+		SPtr<MemoryMappedFile> mFile;
+		const Entry* mEntries = nullptr;
+		UINT32 mNumEntries = 0;
+	};
+
+	/** @} */
+}
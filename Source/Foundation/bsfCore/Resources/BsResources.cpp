@@ -3,9 +3,11 @@
 #include "Resources/BsResources.h"
 #include "Resources/BsResource.h"
 #include "Resources/BsResourceManifest.h"
+#include "Resources/BsResourcePackage.h"
 #include "Error/BsException.h"
 #include "Serialization/BsFileSerializer.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsAsyncFileIO.h"
 #include "Threading/BsTaskScheduler.h"
 #include "Utility/BsUUID.h"
 #include "Debug/BsDebug.h"
@@ -20,17 +22,65 @@
 
 namespace bs
 {
+	float ResourceLoadBatch::getProgress() const
+	{
+		if(mAllResources.empty())
+			return 1.0f;
+
+		UINT32 numDone = 0;
+		for(auto& resource : mAllResources)
+		{
+			const UUID& uuid = resource.getUUID();
+			if(gResources().isLoaded(uuid, false) || !gResources().isLoaded(uuid, true))
+				numDone++;
+		}
+
+		return numDone / (float)mAllResources.size();
+	}
+
+	bool ResourceLoadBatch::isDone() const
+	{
+		for(auto& resource : mAllResources)
+		{
+			const UUID& uuid = resource.getUUID();
+			if(!gResources().isLoaded(uuid, false) && gResources().isLoaded(uuid, true))
+				return false;
+		}
+
+		return true;
+	}
+
 	Resources::Resources()
 	{
 		{
-			Lock lock(mDefaultManifestMutex);
+			ProfiledLock lock(mDefaultManifestMutex);
 			mDefaultResourceManifest = ResourceManifest::create("Default");
 			mResourceManifests.push_back(mDefaultResourceManifest);
 		}
+
+		mIOThread = ThreadPool::instance().run("ResourceIO", std::bind(&Resources::runIOThread, this));
 	}
 
 	Resources::~Resources()
 	{
+		{
+			ProfiledLock lock(mIOMutex);
+			mIOThreadShutdown = true;
+		}
+
+		mIOCondition.notify_one();
+		mIOThread.blockUntilComplete();
+
+		// Catch any loads queued after the I/O thread stopped
+		failQueuedLoads();
+
+		// Wait for any reads the I/O thread started to finish, as their callbacks reference this object
+		{
+			ProfiledLock lock(mIOMutex);
+			while(mNumAsyncReads > 0)
+				mIOCondition.wait(lock);
+		}
+
 		unloadAll();
 	}
 
@@ -49,7 +99,7 @@ namespace bs
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, true, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, true, loadFlags, RESOURCE_LOAD_PRIORITY());
 	}
 
 	HResource Resources::load(const WeakResourceHandle<Resource>& handle, ResourceLoadFlags loadFlags)
@@ -61,7 +111,8 @@ namespace bs
 		return loadFromUUID(uuid, false, loadFlags);
 	}
 
-	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags)
+	HResource Resources::loadAsync(const Path& filePath, ResourceLoadFlags loadFlags,
+		const RESOURCE_LOAD_PRIORITY& priority)
 	{
 		if (!FileSystem::isFile(filePath))
 		{
@@ -76,25 +127,270 @@ namespace bs
 		if (!foundUUID)
 			uuid = UUIDGenerator::generateRandom();
 
-		return loadInternal(uuid, filePath, false, loadFlags);
+		return loadInternal(uuid, filePath, nullptr, false, loadFlags, priority);
 	}
 
-	HResource Resources::loadFromUUID(const UUID& uuid, bool async, ResourceLoadFlags loadFlags)
+	HResource Resources::loadFromUUID(const UUID& uuid, bool async, ResourceLoadFlags loadFlags,
+		const RESOURCE_LOAD_PRIORITY& priority)
 	{
+		SPtr<ResourcePackage> package;
 		Path filePath;
+		findResourceSource(uuid, package, filePath);
+
+		return loadInternal(uuid, filePath, package, !async, loadFlags, priority);
+	}
+
+	bool Resources::findResourceSource(const UUID& uuid, SPtr<ResourcePackage>& package, Path& filePath) const
+	{
+		// Packages take priority over individual files
+		for (auto iter = mResourcePackages.rbegin(); iter != mResourcePackages.rend(); ++iter)
+		{
+			if ((*iter)->contains(uuid))
+			{
+				package = *iter;
+				return true;
+			}
+		}
 
 		// Default manifest is at 0th index but all other take priority since Default manifest could
 		// contain obsolete data. 
 		for (auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter)
 		{
 			if ((*iter)->uuidToFilePath(uuid, filePath))
+				return true;
+		}
+
+		return false;
+	}
+
+	SPtr<SavedResourceData> Resources::readSavedResourceData(const UUID& uuid, const Path& filePath,
+		const SPtr<ResourcePackage>& package)
+	{
+		if (package)
+		{
+			SPtr<DataStream> stream = package->openEntryHeader(uuid);
+			UINT64 objectSize = 0;
+			if (stream && BinarySerializer::decodeSize(*stream, objectSize))
+			{
+				BinarySerializer bs;
+				return std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize));
+			}
+		}
+		else if (!filePath.isEmpty())
+		{
+			FileDecoder fs(filePath);
+			return std::static_pointer_cast<SavedResourceData>(fs.decode());
+		}
+
+		return nullptr;
+	}
+
+	SPtr<DataStream> Resources::readFile(const Path& filePath)
+	{
+		FileLock fileLock = FileScheduler::getLock(filePath);
+
+		// Prefer mapping the file, which avoids copying the data out of the page cache
+		SPtr<MemoryMappedFile> file = MemoryMappedFile::open(filePath);
+		if(file)
+		{
+			file->prefetch(0, file->getSize());
+			return bs_shared_ptr_new<MappedFileDataStream>(file);
+		}
+
+		SPtr<DataStream> fileStream = FileSystem::openFile(filePath, true);
+		if(!fileStream)
+			return nullptr;
+
+		return bs_shared_ptr_new<MemoryDataStream>(fileStream);
+	}
+
+	bool Resources::readFileAsync(const ResourceIORequest& request)
+	{
+		SPtr<AsyncFile> file = AsyncFile::open(request.filePath);
+		if(!file)
+			return false;
+
+		// Blocks while the device is saturated, so reads are issued in priority order. The lock is held until the read
+		// completes.
+		auto fileLock = bs_shared_ptr_new<FileLock>(FileScheduler::getLock(request.filePath));
+
+		const UINT64 size = file->getSize();
+		auto buffer = (UINT8*)bs_alloc((size_t)std::max(size, (UINT64)1));
+
+		{
+			ProfiledLock lock(mIOMutex);
+			mNumAsyncReads++;
+		}
+
+		auto onReadComplete = [this, request, fileLock, buffer](const AsyncReadResult& result)
+		{
+			fileLock->unlock();
+
+			SPtr<DataStream> stream;
+			if(result.success)
+				stream = bs_shared_ptr_new<MemoryDataStream>(buffer, (size_t)result.numBytes, true);
+			else
+			{
+				LOGERR("Failed reading resource file: " + request.filePath.toString());
+				bs_free(buffer);
+			}
+
+			// Without a stream the worker falls back to a blocking read, and reports the failure if that fails too
+			queueLoadTask(request, stream);
+
+			{
+				ProfiledLock lock(mIOMutex);
+				mNumAsyncReads--;
+			}
+
+			mIOCondition.notify_all();
+		};
+
+		AsyncFileIO::instance().read(file, 0, size, buffer, onReadComplete);
+		return true;
+	}
+
+	ResourceLoadBatch Resources::loadBatch(const Vector<UUID>& uuids, ResourceLoadFlags loadFlags, 
+		const RESOURCE_LOAD_PRIORITY& priority)
+	{
+		struct BatchEntry
+		{
+			UUID uuid;
+			SPtr<ResourcePackage> package;
+			Path filePath;
+			bool requested;
+		};
+
+		// Resolve the full dependency closure, visiting each resource only once
+		Vector<BatchEntry> entries;
+		UnorderedMap<UUID, UINT32> entryLookup;
+
+		Vector<UUID> todo(uuids.rbegin(), uuids.rend());
+		while(!todo.empty())
+		{
+			UUID uuid = todo.back();
+			todo.pop_back();
+
+			if(entryLookup.find(uuid) != entryLookup.end())
+				continue;
+
+			BatchEntry entry;
+			entry.uuid = uuid;
+			entry.requested = false;
+			findResourceSource(uuid, entry.package, entry.filePath);
+
+			const bool hasSource = entry.package || (!entry.filePath.isEmpty() && FileSystem::isFile(entry.filePath));
+			if(loadFlags.isSet(ResourceLoadFlag::LoadDependencies) && hasSource)
+			{
+				SPtr<SavedResourceData> savedResourceData = readSavedResourceData(uuid, entry.filePath, entry.package);
+				if(savedResourceData)
+				{
+					const Vector<UUID>& dependencies = savedResourceData->getDependencies();
+					for(auto iter = dependencies.rbegin(); iter != dependencies.rend(); ++iter)
+						todo.push_back(*iter);
+				}
+			}
+
+			entryLookup[uuid] = (UINT32)entries.size();
+			entries.push_back(entry);
+		}
+
+		for(auto& uuid : uuids)
+			entries[entryLookup[uuid]].requested = true;
+
+		// Issue the reads in the order the data is laid out on disk. Package entries are ordered by their location
+		// within the package, and loose files by path, as files in the same folder are likely to be close together.
+		auto packageIdx = [this](const SPtr<ResourcePackage>& package)
+		{
+			if(!package)
+				return (UINT32)mResourcePackages.size();
+
+			return (UINT32)(std::find(mResourcePackages.begin(), mResourcePackages.end(), package) - 
+				mResourcePackages.begin());
+		};
+
+		Vector<UINT32> order(entries.size());
+		for(UINT32 i = 0; i < (UINT32)order.size(); i++)
+			order[i] = i;
+
+		std::stable_sort(order.begin(), order.end(), [&](UINT32 lhsIdx, UINT32 rhsIdx)
+		{
+			const BatchEntry& lhs = entries[lhsIdx];
+			const BatchEntry& rhs = entries[rhsIdx];
+
+			const UINT32 lhsPackage = packageIdx(lhs.package);
+			const UINT32 rhsPackage = packageIdx(rhs.package);
+			if(lhsPackage != rhsPackage)
+				return lhsPackage < rhsPackage;
+
+			if(lhs.package)
+				return lhs.package->getEntryOffset(lhs.uuid) < rhs.package->getEntryOffset(rhs.uuid);
+
+			return lhs.filePath.toString() < rhs.filePath.toString();
+		});
+
+		// Dependencies of each resource are issued before the resource itself, so a dependency placed after its dependant
+		// on disk will still be read first. Packages avoid this by storing dependencies first.
+		ResourceLoadBatch output;
+		output.mAllResources.reserve(entries.size());
+
+		UnorderedMap<UUID, HResource> handles;
+		for(auto& idx : order)
+		{
+			const BatchEntry& entry = entries[idx];
+
+			ResourceLoadFlags entryLoadFlags = loadFlags;
+			if(!entry.requested)
+				entryLoadFlags.unset(ResourceLoadFlag::KeepInternalRef);
+
+			HResource handle = loadInternal(entry.uuid, entry.filePath, entry.package, false, entryLoadFlags, priority);
+			handles[entry.uuid] = handle;
+			output.mAllResources.push_back(handle);
+		}
+
+		output.mResources.reserve(uuids.size());
+		for(auto& uuid : uuids)
+			output.mResources.push_back(handles[uuid]);
+
+		return output;
+	}
+
+	void Resources::setLoadPriority(const HResource& resource, const RESOURCE_LOAD_PRIORITY& priority)
+	{
+		ProfiledLock lock(mIOMutex);
+
+		for(auto& request : mIORequests)
+		{
+			if(request.resource.getUUID() == resource.getUUID())
+			{
+				request.priority = priority;
 				break;
+			}
+		}
+	}
+
+	bool Resources::cancelLoad(const HResource& resource)
+	{
+		HResource cancelledResource;
+		{
+			ProfiledLock lock(mIOMutex);
+
+			auto iterFind = std::find_if(mIORequests.begin(), mIORequests.end(),
+				[&](const ResourceIORequest& x) { return x.resource.getUUID() == resource.getUUID(); });
+
+			if(iterFind == mIORequests.end())
+				return false;
+
+			cancelledResource = iterFind->resource;
+			mIORequests.erase(iterFind);
 		}
 
-		return loadInternal(uuid, filePath, !async, loadFlags);
+		setLoadedData(cancelledResource, nullptr);
+		return true;
 	}
 
-	HResource Resources::loadInternal(const UUID& uuid, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags)
+	HResource Resources::loadInternal(const UUID& uuid, const Path& filePath, const SPtr<ResourcePackage>& package,
+		bool synchronous, ResourceLoadFlags loadFlags, const RESOURCE_LOAD_PRIORITY& priority)
 	{
 		HResource outputResource;
 
@@ -107,8 +403,8 @@ namespace bs
 			bool alreadyLoading = false;
 
 			// Check if the resource is being loaded on a worker thread
-			Lock inProgressLock(mInProgressResourcesMutex);
-			Lock loadedLock(mLoadedResourceMutex);
+			ProfiledLock inProgressLock(mInProgressResourcesMutex);
+			ProfiledLock loadedLock(mLoadedResourceMutex);
 
 			auto iterFind2 = mInProgressResources.find(uuid);
 			if (iterFind2 != mInProgressResources.end())
@@ -159,7 +455,7 @@ namespace bs
 
 			// If we have nowhere to load from, warn and complete load if a file path was provided, otherwise pass through
 			// as we might just want to complete a previously queued load 
-			if (filePath.isEmpty())
+			if (!package && filePath.isEmpty())
 			{
 				if (!alreadyLoading)
 				{
@@ -167,7 +463,7 @@ namespace bs
 					loadFailed = true;
 				}
 			}
-			else if (!FileSystem::isFile(filePath))
+			else if (!package && !FileSystem::isFile(filePath))
 			{
 				LOGWRN_VERBOSE("Cannot load resource. Specified file: " + filePath.toString() + " doesn't exist.");
 				loadFailed = true;
@@ -176,12 +472,7 @@ namespace bs
 			if(!loadFailed)
 			{
 				// Load dependency data if a file path is provided
-				SPtr<SavedResourceData> savedResourceData;
-				if (!filePath.isEmpty())
-				{
-					FileDecoder fs(filePath);
-					savedResourceData = std::static_pointer_cast<SavedResourceData>(fs.decode());
-				}
+				SPtr<SavedResourceData> savedResourceData = readSavedResourceData(uuid, filePath, package);
 
 				// Register an in-progress load unless there is an existing load operation, or the resource is already
 				// loaded
@@ -277,13 +568,38 @@ namespace bs
 					}
 				}
 
-				initiateLoad = !alreadyLoading && !filePath.isEmpty();
+				initiateLoad = !alreadyLoading && (package || !filePath.isEmpty());
 
 				if(savedResourceData != nullptr)
 					synchronous = synchronous || !savedResourceData->allowAsyncLoading();
 			}
 		}
 
+		// Previously being loaded as async. If the data wasn't read yet move it to the front of the queue, or raise its
+		// priority if the new request is more urgent.
+		if (loadInProgress)
+		{
+			ProfiledLock lock(mIOMutex);
+			for(auto& request : mIORequests)
+			{
+				if(request.resource.getUUID() != uuid)
+					continue;
+
+				if(synchronous)
+					request.priority.priority = std::numeric_limits<float>::infinity();
+				else
+				{
+					request.priority.priority = std::max(request.priority.priority, priority.priority);
+
+					if(priority.deadline > 0.0f && 
+						(request.priority.deadline == 0.0f || priority.deadline < request.priority.deadline))
+						request.priority.deadline = priority.deadline;
+				}
+
+				break;
+			}
+		}
+
 		// Previously being loaded as async but now we want it synced, so we wait
 		if (loadInProgress && synchronous)
 			outputResource.blockUntilLoaded();
@@ -306,11 +622,11 @@ namespace bs
 
 			Vector<HResource> dependencies(numDependencies);
 			for (UINT32 i = 0; i < numDependencies; i++)
-				dependencies[i] = loadFromUUID(dependenciesToLoad[i], !synchronous, depLoadFlags);
+				dependencies[i] = loadFromUUID(dependenciesToLoad[i], !synchronous, depLoadFlags, priority);
 
 			// Keep dependencies alive until the parent is done loading
 			{
-				Lock inProgressLock(mInProgressResourcesMutex);
+				ProfiledLock inProgressLock(mInProgressResourcesMutex);
 
 				// If we're doing a dependency-only load (main resource itself was previously loaded), then the in-progress
 				// operation could have already finished when the last dependency was loaded (this will always be true for
@@ -327,17 +643,26 @@ namespace bs
 			// Synchronous or the resource doesn't support async, read the file immediately
 			if (synchronous)
 			{
-				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
+				loadCallback(filePath, package, nullptr, outputResource, 
+					loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
 			}
-			else // Asynchronous, read the file on a worker thread
+			else // Asynchronous, queue the file read on the I/O thread
 			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
+				ResourceIORequest request;
+				request.filePath = filePath;
+				request.package = package;
+				request.resource = outputResource;
+				request.priority = priority;
+				request.keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
+
+				{
+					ProfiledLock lock(mIOMutex);
 
-				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
+					request.sequenceIdx = mNextIORequestIdx++;
+					mIORequests.push_back(request);
+				}
+
+				mIOCondition.notify_one();
 			}
 		}
 		else
@@ -352,31 +677,33 @@ namespace bs
 		return outputResource;
 	}
 
-	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
+	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const UUID& uuid, const Path& filePath, 
+		const SPtr<ResourcePackage>& package, SPtr<DataStream> stream, bool loadWithSaveData)
 	{
-		Lock fileLock = FileScheduler::getLock(filePath);
-
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
-		if (stream == nullptr)
-			return nullptr;
+		MemoryTagScope memoryTagScope(MemoryTag::Resources);
 
-		if (stream->size() > std::numeric_limits<UINT32>::max())
+		// Packages are memory mapped and paged in on access, there is no need to schedule access to them. Same goes for
+		// streams already read by the I/O thread.
+		if (!stream)
 		{
-			BS_EXCEPT(InternalErrorException,
-				"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
+			if (package)
+				stream = package->openEntry(uuid);
+			else
+				stream = readFile(filePath);
 		}
 
+		if (stream == nullptr)
+			return nullptr;
+
 		CoreSerializationContext serzContext;
 		serzContext.flags = loadWithSaveData ? SF_KeepResourceSourceData : 0;
 
 		// Read meta-data
 		SPtr<SavedResourceData> metaData;
 		{
-			if (!stream->eof())
+			UINT64 objectSize = 0;
+			if (!stream->eof() && BinarySerializer::decodeSize(*stream, objectSize))
 			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
 				BinarySerializer bs;
 				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, &serzContext));
 			}
@@ -385,22 +712,42 @@ namespace bs
 		// Read resource data
 		SPtr<IReflectable> loadedData;
 		{
-			if(metaData && !stream->eof())
+			UINT64 objectSize = 0;
+			if(metaData && !stream->eof() && BinarySerializer::decodeSize(*stream, objectSize))
 			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
-
-				if (metaData->getCompressionMethod() != 0)
+				if (metaData->getCompressionMethod() == 1)
 					stream = Compression::decompress(stream);
+				else if (metaData->getCompressionMethod() == 2)
+				{
+					// Large resources are decompressed as they are deserialized, instead of requiring the entire
+					// uncompressed data to be held in memory on top of the deserialized object
+					UINT64 uncompressedSize = 0;
+					if (Compression::getBlockDecompressedSize(stream, uncompressedSize) && 
+						uncompressedSize > Compression::STREAMING_THRESHOLD)
+						stream = Compression::decompressBlocksStreamed(stream);
+					else
+						stream = Compression::decompressBlocks(stream);
+				}
 
-				BinarySerializer bs;
-				loadedData = bs.decode(stream, objectSize, &serzContext);
+				if (stream)
+				{
+					BinarySerializer bs;
+					loadedData = bs.decode(stream, objectSize, &serzContext);
+				}
 			}
 		}
 
 		if (loadedData == nullptr)
 		{
-			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
+			if (package)
+			{
+				LOGERR("Unable to load resource " + uuid.toString() + " from package \"" + 
+					package->getPath().toString() + "\"");
+			}
+			else
+			{
+				LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
+			}
 		}
 		else
 		{
@@ -420,7 +767,7 @@ namespace bs
 			bool loadInProgress = false;
 
 			{
-				Lock inProgressLock(mInProgressResourcesMutex);
+				ProfiledLock inProgressLock(mInProgressResourcesMutex);
 				auto iterFind2 = mInProgressResources.find(uuid);
 				if (iterFind2 != mInProgressResources.end())
 					loadInProgress = true;
@@ -435,7 +782,7 @@ namespace bs
 
 			bool lostLastRef = false;
 			{
-				Lock loadedLock(mLoadedResourceMutex);
+				ProfiledLock loadedLock(mLoadedResourceMutex);
 				auto iterFind = mLoadedResources.find(uuid);
 				if (iterFind != mLoadedResources.end())
 				{
@@ -460,7 +807,7 @@ namespace bs
 		Vector<HResource> resourcesToUnload;
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			ProfiledLock lock(mLoadedResourceMutex);
 			for(auto iter = mLoadedResources.begin(); iter != mLoadedResources.end(); ++iter)
 			{
 				const LoadedResourceData& resData = iter->second;
@@ -488,7 +835,7 @@ namespace bs
 		UnorderedMap<UUID, LoadedResourceData> loadedResourcesCopy;
 		
 		{
-			Lock lock(mLoadedResourceMutex);
+			ProfiledLock lock(mLoadedResourceMutex);
 			loadedResourcesCopy = mLoadedResources;
 		}
 
@@ -509,7 +856,7 @@ namespace bs
 		{
 			bool loadInProgress = false;
 			{
-				Lock lock(mInProgressResourcesMutex);
+				ProfiledLock lock(mInProgressResourcesMutex);
 				auto iterFind2 = mInProgressResources.find(uuid);
 				if (iterFind2 != mInProgressResources.end())
 					loadInProgress = true;
@@ -529,7 +876,7 @@ namespace bs
 		resource.mData->mPtr->destroy();
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			ProfiledLock lock(mLoadedResourceMutex);
 			auto iterFind = mLoadedResources.find(uuid);
 			if (iterFind != mLoadedResources.end())
 			{
@@ -560,7 +907,7 @@ namespace bs
 		{
 			bool loadInProgress = false;
 			{
-				Lock lock(mInProgressResourcesMutex);
+				ProfiledLock lock(mInProgressResourcesMutex);
 				auto iterFind2 = mInProgressResources.find(resource.getUUID());
 				if (iterFind2 != mInProgressResources.end())
 					loadInProgress = true;
@@ -580,7 +927,7 @@ namespace bs
 		}
 
 		{
-			Lock lock(mDefaultManifestMutex);
+			ProfiledLock lock(mDefaultManifestMutex);
 			mDefaultResourceManifest->registerResource(resource.getUUID(), filePath);
 		}
 
@@ -610,7 +957,14 @@ namespace bs
 		for (UINT32 i = 0; i < (UINT32)dependencyList.size(); i++)
 			dependencyUUIDs[i] = dependencyList[i].resource.getUUID();
 
-		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
+		MemorySerializer objectSerializer;
+		UINT64 objectNumBytes = 0;
+		UINT8* objectBytes = objectSerializer.encode(resource.get(), objectNumBytes);
+
+		// Method 1 (a single Snappy stream) is only supported for loading. New resources use the block compression 
+		// format which allows the data to be decompressed in parallel, and has no size limit.
+		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 2 : 0;
+
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs, 
 			resource->allowAsyncLoading(), compressionMethod);
 
@@ -634,6 +988,7 @@ namespace bs
 				if(safetyCounter > 10)
 				{
 					LOGERR("Internal error. Unable to save resource due to not being able to find a unique filename.");
+					bs_free(objectBytes);
 					return;
 				}
 
@@ -645,44 +1000,43 @@ namespace bs
 		else
 			savePath = filePath;
 		
-		Lock fileLock = FileScheduler::getLock(filePath);
+		// Encode and compress the data before accessing the file, so the device is only held for the actual write
+		MemorySerializer metaDataSerializer;
+		UINT64 metaDataNumBytes = 0;
+		UINT8* metaDataBytes = metaDataSerializer.encode(resourceData.get(), metaDataNumBytes);
 
-		std::ofstream stream;
-		stream.open(savePath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
-		if (stream.fail())
-			LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
-	
-		// Write meta-data
+		SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(objectBytes, (size_t)objectNumBytes);
+		if (compressionMethod != 0)
 		{
-			MemorySerializer ms;
-			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resourceData.get(), numBytes);
-			
-			stream.write((char*)&numBytes, sizeof(numBytes));
-			stream.write((char*)bytes, numBytes);
-			
-			bs_free(bytes);
+			SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
+			objStream = Compression::compressBlocks(srcStream);
 		}
 
-		// Write object data
 		{
-			MemorySerializer ms;
-			UINT32 numBytes = 0;
-			UINT8* bytes = ms.encode(resource.get(), numBytes);
+			FileLock fileLock = FileScheduler::getLock(savePath);
 
-			SPtr<MemoryDataStream> objStream = bs_shared_ptr_new<MemoryDataStream>(bytes, numBytes);
-			if (compressionMethod != 0)
-			{
-				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
-				objStream = Compression::compress(srcStream);
-			}
+			std::ofstream stream;
+			stream.open(savePath.toPlatformString().c_str(), std::ios::out | std::ios::binary);
+			if (stream.fail())
+				LOGWRN("Failed to save file: \"" + filePath.toString() + "\". Error: " + strerror(errno) + ".");
+
+			UINT8 sizeData[BinarySerializer::MAX_SIZE_FIELD_SIZE];
 
-			stream.write((char*)&numBytes, sizeof(numBytes));
+			// Write meta-data
+			UINT32 sizeFieldSize = BinarySerializer::encodeSize(metaDataNumBytes, sizeData);
+			stream.write((char*)sizeData, sizeFieldSize);
+			stream.write((char*)metaDataBytes, metaDataNumBytes);
+
+			// Write object data
+			sizeFieldSize = BinarySerializer::encodeSize(objectNumBytes, sizeData);
+			stream.write((char*)sizeData, sizeFieldSize);
 			stream.write((char*)objStream->getPtr(), objStream->size());
+
+			stream.close();
+			stream.clear();
 		}
 
-		stream.close();
-		stream.clear();
+		bs_free(metaDataBytes);
 
 		if (fileExists)
 		{
@@ -698,7 +1052,7 @@ namespace bs
 
 		if(resource)
 		{
-			Lock lock(mLoadedResourceMutex);
+			ProfiledLock lock(mLoadedResourceMutex);
 			auto iterFind = mLoadedResources.find(uuid);
 			if (iterFind == mLoadedResources.end())
 			{
@@ -744,6 +1098,20 @@ namespace bs
 			mResourceManifests.erase(findIter);
 	}
 
+	void Resources::registerResourcePackage(const SPtr<ResourcePackage>& package)
+	{
+		auto findIter = std::find(mResourcePackages.begin(), mResourcePackages.end(), package);
+		if(findIter == mResourcePackages.end())
+			mResourcePackages.push_back(package);
+	}
+
+	void Resources::unregisterResourcePackage(const SPtr<ResourcePackage>& package)
+	{
+		auto findIter = std::find(mResourcePackages.begin(), mResourcePackages.end(), package);
+		if (findIter != mResourcePackages.end())
+			mResourcePackages.erase(findIter);
+	}
+
 	SPtr<ResourceManifest> Resources::getResourceManifest(const String& name) const
 	{
 		for(auto iter = mResourceManifests.rbegin(); iter != mResourceManifests.rend(); ++iter) 
@@ -759,7 +1127,7 @@ namespace bs
 	{
 		if (checkInProgress)
 		{
-			Lock inProgressLock(mInProgressResourcesMutex);
+			ProfiledLock inProgressLock(mInProgressResourcesMutex);
 			auto iterFind2 = mInProgressResources.find(uuid);
 			if (iterFind2 != mInProgressResources.end())
 			{
@@ -768,7 +1136,7 @@ namespace bs
 		}
 
 		{
-			Lock loadedLock(mLoadedResourceMutex);
+			ProfiledLock loadedLock(mLoadedResourceMutex);
 			auto iterFind = mLoadedResources.find(uuid);
 			if (iterFind != mLoadedResources.end())
 			{
@@ -790,7 +1158,7 @@ namespace bs
 		HResource newHandle(obj, UUID);
 
 		{
-			Lock lock(mLoadedResourceMutex);
+			ProfiledLock lock(mLoadedResourceMutex);
 
 			if(obj)
 			{
@@ -806,7 +1174,7 @@ namespace bs
 
 	HResource Resources::_getResourceHandle(const UUID& uuid)
 	{
-		Lock lock(mLoadedResourceMutex);
+		ProfiledLock lock(mLoadedResourceMutex);
 		auto iterFind3 = mHandles.find(uuid);
 		if (iterFind3 != mHandles.end()) // Not loaded, but handle does exist
 		{
@@ -854,7 +1222,7 @@ namespace bs
 		bool finishLoad = true;
 		Vector<ResourceLoadData*> dependantLoads;
 		{
-			Lock inProgresslock(mInProgressResourcesMutex);
+			ProfiledLock inProgresslock(mInProgressResourcesMutex);
 
 			auto iterFind = mInProgressResources.find(uuid);
 			if (iterFind != mInProgressResources.end())
@@ -879,7 +1247,7 @@ namespace bs
 				// by its dependencies.
 				if (myLoadData != nullptr && myLoadData->loadedData != nullptr)
 				{
-					Lock loadedLock(mLoadedResourceMutex);
+					ProfiledLock loadedLock(mLoadedResourceMutex);
 
 					mLoadedResources[uuid] = myLoadData->resData;
 					resource.setHandleData(myLoadData->loadedData, uuid);
@@ -908,22 +1276,114 @@ namespace bs
 		}
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	void Resources::loadCallback(const Path& filePath, const SPtr<ResourcePackage>& package, 
+		const SPtr<DataStream>& stream, HResource& resource, bool loadWithSaveData)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
+		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(resource.getUUID(), filePath, package, stream, 
+			loadWithSaveData);
+
+		setLoadedData(resource, rawResource);
+	}
 
+	void Resources::setLoadedData(HResource& resource, const SPtr<Resource>& data)
+	{
 		{
-			Lock lock(mInProgressResourcesMutex);
+			ProfiledLock lock(mInProgressResourcesMutex);
 
 			// Check if all my dependencies are loaded
 			ResourceLoadData* myLoadData = mInProgressResources[resource.getUUID()];
-			myLoadData->loadedData = rawResource;
+			myLoadData->loadedData = data;
 			myLoadData->remainingDependencies--;
 		}
 
 		loadComplete(resource);
 	}
 
+	bool Resources::isHigherPriority(const ResourceIORequest& lhs, const ResourceIORequest& rhs)
+	{
+		if(lhs.priority.priority != rhs.priority.priority)
+			return lhs.priority.priority > rhs.priority.priority;
+
+		// Loads with a deadline go before loads without one
+		const float lhsDeadline = lhs.priority.deadline > 0.0f ? lhs.priority.deadline : 
+			std::numeric_limits<float>::infinity();
+		const float rhsDeadline = rhs.priority.deadline > 0.0f ? rhs.priority.deadline : 
+			std::numeric_limits<float>::infinity();
+
+		if(lhsDeadline != rhsDeadline)
+			return lhsDeadline < rhsDeadline;
+
+		return lhs.sequenceIdx < rhs.sequenceIdx;
+	}
+
+	void Resources::runIOThread()
+	{
+		while(true)
+		{
+			ResourceIORequest request;
+			{
+				ProfiledLock lock(mIOMutex);
+
+				while(mIORequests.empty() && !mIOThreadShutdown)
+					mIOCondition.wait(lock);
+
+				if(mIOThreadShutdown)
+				{
+					lock.unlock();
+					failQueuedLoads();
+					break;
+				}
+
+				auto iterFind = std::min_element(mIORequests.begin(), mIORequests.end(), &Resources::isHigherPriority);
+				request = *iterFind;
+
+				if(iterFind != (mIORequests.end() - 1))
+					std::swap(*iterFind, mIORequests.back());
+
+				mIORequests.pop_back();
+			}
+
+			// Files are read asynchronously in priority order, with the FileScheduler limiting the number of reads in
+			// flight to the device's queue depth. Worker threads then deserialize the data without needing to wait on
+			// the device.
+			if(!request.package && AsyncFileIO::isStarted() && readFileAsync(request))
+				continue;
+
+			// Without asynchronous I/O, devices that can only serve one file at a time are read from here so the
+			// device is never shared between multiple loads. Devices that can serve multiple reads at once (e.g. SSDs)
+			// are read from the worker threads, keeping the device's queue full.
+			SPtr<DataStream> stream;
+			if(request.package)
+				request.package->prefetchEntry(request.resource.getUUID());
+			else if(FileScheduler::getQueueDepth(request.filePath) == 1)
+				stream = readFile(request.filePath);
+
+			queueLoadTask(request, stream);
+		}
+	}
+
+	void Resources::failQueuedLoads()
+	{
+		Vector<ResourceIORequest> requests;
+		{
+			ProfiledLock lock(mIOMutex);
+			std::swap(requests, mIORequests);
+		}
+
+		for(auto& entry : requests)
+			setLoadedData(entry.resource, nullptr);
+	}
+
+	void Resources::queueLoadTask(const ResourceIORequest& request, const SPtr<DataStream>& stream)
+	{
+		String fileName = request.package ? request.resource.getUUID().toString() : request.filePath.getFilename();
+		String taskName = "Resource load: " + fileName;
+
+		SPtr<Task> task = Task::create(taskName, std::bind(&Resources::loadCallback, this, request.filePath, 
+			request.package, stream, request.resource, request.keepSourceData));
+		TaskScheduler::instance().addTask(task);
+	}
+
 	BS_CORE_EXPORT Resources& gResources()
 	{
 		return Resources::instance();
@@ -4,6 +4,8 @@
 
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
+#include "Threading/BsThreadPool.h"
+#include "Threading/BsProfiledMutex.h"
 
 namespace bs
 {
@@ -39,6 +41,51 @@ namespace bs
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
 	BS_FLAGS_OPERATORS(ResourceLoadFlag);
 
+	/** Hints that control the order in which asynchronous resource loads are read from disk. */
+	struct RESOURCE_LOAD_PRIORITY
+	{
+		/** 
+		 * Loads with higher priority are read first. When streaming this is normally derived from how important the
+		 * resource is to the viewer, for example the negated distance between the camera and the object using it.
+		 */
+		float priority = 0.0f;
+
+		/** 
+		 * Time (as reported by Time::getTime()) at which the resource is expected to be needed, in seconds. Among loads with
+		 * equal priority, loads with earlier deadlines are read first. Zero if the load has no deadline.
+		 */
+		float deadline = 0.0f;
+	};
+
+	/** Group of resources started loading through Resources::loadBatch(). */
+	class BS_CORE_EXPORT ResourceLoadBatch
+	{
+	public:
+		/** Returns handles to the requested resources, in the order they were requested in. */
+		const Vector<HResource>& getResources() const { return mResources; }
+
+		/** 
+		 * Returns handles to all the resources loaded as part of the batch, including all the dependencies of the requested
+		 * resources, in the order their reads were issued in.
+		 */
+		const Vector<HResource>& getAllResources() const { return mAllResources; }
+
+		/** 
+		 * Returns the fraction of resources in the batch (including dependencies) that are done loading, in [0, 1] range.
+		 * Resources that failed to load count as done.
+		 */
+		float getProgress() const;
+
+		/** Checks have all the resources in the batch (including dependencies) finished loading. */
+		bool isDone() const;
+
+	private:
+		friend class Resources;
+
+		Vector<HResource> mResources;
+		Vector<HResource> mAllResources;
+	};
+
 	/**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
 	 *
@@ -75,6 +122,17 @@ namespace bs
 			bool notifyImmediately;
 		};
 
+		/** Asynchronous load waiting for the I/O thread to read its data. */
+		struct ResourceIORequest
+		{
+			Path filePath;
+			SPtr<ResourcePackage> package;
+			HResource resource;
+			RESOURCE_LOAD_PRIORITY priority;
+			UINT64 sequenceIdx = 0;
+			bool keepSourceData = false;
+		};
+
 	public:
 		Resources();
 		~Resources();
@@ -117,18 +175,25 @@ namespace bs
 		 * done. Use ResourceHandle<T>::isLoaded to check if resource has been loaded, or 
 		 * ResourceHandle<T>::blockUntilLoaded to wait until load completes.
 		 *
+		 * Resource data is read from disk by a dedicated I/O thread, in order determined by @p priority. Decompression and
+		 * deserialization then happen on worker threads.
+		 *
 		 * @param[in]	filePath	Full pathname of the file.
 		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Determines when will the resource be read, relative to other asynchronous loads. 
+		 *							Dependencies are read with the same priority.
 		 *			
-		 * @see		load(const Path&, ResourceLoadFlags)
+		 * @see		load(const Path&, ResourceLoadFlags), setLoadPriority(), cancelLoad()
 		 */
-		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+		HResource loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			const RESOURCE_LOAD_PRIORITY& priority = RESOURCE_LOAD_PRIORITY());
 
 		/** @copydoc loadAsync */
 		template <class T>
-		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default)
+		ResourceHandle<T> loadAsync(const Path& filePath, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			const RESOURCE_LOAD_PRIORITY& priority = RESOURCE_LOAD_PRIORITY())
 		{
-			return static_resource_cast<T>(loadAsync(filePath, loadFlags));
+			return static_resource_cast<T>(loadAsync(filePath, loadFlags, priority));
 		}
 
 		/**
@@ -138,10 +203,42 @@ namespace bs
 		 * @param[in]	async		If true resource will be loaded asynchronously. Handle to non-loaded resource will be
 		 *							returned immediately while loading will continue in the background.		
 		 * @param[in]	loadFlags	Flags used to control the load process.
+		 * @param[in]	priority	Determines the order of asynchronous loads. Ignored for synchronous loads.
 		 *													
 		 * @see		load(const Path&, bool)
 		 */
-		HResource loadFromUUID(const UUID& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default);
+		HResource loadFromUUID(const UUID& uuid, bool async = false, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			const RESOURCE_LOAD_PRIORITY& priority = RESOURCE_LOAD_PRIORITY());
+
+		/** 
+		 * Changes the priority of an asynchronous load that is still waiting to be read from disk. Does nothing if the
+		 * resource isn't waiting to be read.
+		 */
+		void setLoadPriority(const HResource& resource, const RESOURCE_LOAD_PRIORITY& priority);
+
+		/**
+		 * Cancels an asynchronous load that is still waiting to be read from disk. The load completes as if it failed, 
+		 * leaving the resource unloaded. Dependencies that were already queued continue loading.
+		 *
+		 * @return	True if the load was cancelled, false if the resource isn't waiting to be read.
+		 */
+		bool cancelLoad(const HResource& resource);
+
+		/**
+		 * Asynchronously loads a set of resources, along with all of their dependencies. Unlike calling loadFromUUID() for
+		 * each resource, the full set of dependencies is resolved up front from the saved resource meta-data, and the
+		 * reads are issued in the order the resources are stored on disk, so the batch can be read with minimal seeking.
+		 * Resources shared between multiple requested resources are only read once.
+		 *
+		 * @param[in]	uuids		UUIDs of the resources to load. Resources are looked up the same way as in 
+		 *							loadFromUUID().
+		 * @param[in]	loadFlags	Flags used to control the load process. ResourceLoadFlag::KeepInternalRef only applies
+		 *							to the requested resources, and not their dependencies.
+		 * @param[in]	priority	Determines the order of the batch, relative to other asynchronous loads.
+		 * @return					Object that can be used for accessing the loaded resources and tracking load progress.
+		 */
+		ResourceLoadBatch loadBatch(const Vector<UUID>& uuids, ResourceLoadFlags loadFlags = ResourceLoadFlag::Default,
+			const RESOURCE_LOAD_PRIORITY& priority = RESOURCE_LOAD_PRIORITY());
 
 		/**
 		 * Releases an internal reference to the resource held by the resources system. This allows the resource to be 
@@ -244,6 +341,21 @@ namespace bs
 		/**	Unregisters a resource manifest previously registered with registerResourceManifest(). */
 		void unregisterResourceManifest(const SPtr<ResourceManifest>& manifest);
 
+		/**
+		 * Registers a resource package. Resources contained in the package will be loaded from it when loaded by UUID, 
+		 * instead of from their individual files. Packages take priority over resource manifests, and packages
+		 * registered later take priority over earlier ones.
+		 * 
+		 * @see		ResourcePackage
+		 */
+		void registerResourcePackage(const SPtr<ResourcePackage>& package);
+
+		/**	
+		 * Unregisters a resource package previously registered with registerResourcePackage(). Resources already loaded
+		 * from the package remain loaded.
+		 */
+		void unregisterResourcePackage(const SPtr<ResourcePackage>& package);
+
 		/**
 		 * Allows you to retrieve resource manifest containing UUID <-> file path mapping that is used when resolving 
 		 * resource references.
@@ -321,33 +433,102 @@ namespace bs
 		 * resource, although you may provide an empty path in which case the resource will be retrieved from memory if its
 		 * currently loaded.
 		 */
-		HResource loadInternal(const UUID& UUID, const Path& filePath, bool synchronous, ResourceLoadFlags loadFlags);
+		HResource loadInternal(const UUID& UUID, const Path& filePath, const SPtr<ResourcePackage>& package,
+			bool synchronous, ResourceLoadFlags loadFlags, const RESOURCE_LOAD_PRIORITY& priority);
+
+		/** 
+		 * Finds the location the resource with the specified UUID should be loaded from. Outputs either a package 
+		 * containing the resource, or a path to the resource file. Returns false if the resource cannot be found.
+		 */
+		bool findResourceSource(const UUID& uuid, SPtr<ResourcePackage>& package, Path& filePath) const;
 
-		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
-		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
+		/** 
+		 * Reads the meta-data saved along the resource, from either the package (if provided) or the resource file. Returns
+		 * null if the meta-data cannot be read.
+		 */
+		static SPtr<SavedResourceData> readSavedResourceData(const UUID& uuid, const Path& filePath, 
+			const SPtr<ResourcePackage>& package);
+
+		/**
+		 * Reads the contents of a resource file into memory, scheduling access to the file through the FileScheduler.
+		 * The device is only held while the file is being read, so the contents can be decoded without blocking other
+		 * reads. Returns null if the file cannot be read.
+		 */
+		static SPtr<DataStream> readFile(const Path& filePath);
+
+		/**
+		 * Starts an asynchronous read of the file of a queued load, and queues the load on a worker thread once the
+		 * read completes. Returns false if the file cannot be opened for asynchronous reading.
+		 */
+		bool readFileAsync(const ResourceIORequest& request);
+
+		/** Queues deserialization of a resource on a worker thread. @p stream contains the file data, if read. */
+		void queueLoadTask(const ResourceIORequest& request, const SPtr<DataStream>& stream);
+
+		/** 
+		 * Performs actually reading and deserializing of the resource file. If @p package is provided the resource is read
+		 * from the package instead of the file at @p filePath. If @p stream is provided the data is read from it instead,
+		 * without accessing either. Called from various worker threads.
+		 */
+		SPtr<Resource> loadFromDiskAndDeserialize(const UUID& uuid, const Path& filePath, 
+			const SPtr<ResourcePackage>& package, SPtr<DataStream> stream, bool loadWithSaveData);
 
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
 
-		/**	Callback triggered when the task manager is ready to process the loading task. */
-		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+		/**	
+		 * Callback triggered when the task manager is ready to process the loading task. @p stream contains data read
+		 * by the I/O thread, if any.
+		 */
+		void loadCallback(const Path& filePath, const SPtr<ResourcePackage>& package, const SPtr<DataStream>& stream, 
+			HResource& resource, bool loadWithSaveData);
+
+		/** 
+		 * Assigns the deserialized data to an in-progress load, and completes the load if it has no outstanding
+		 * dependencies. Null data marks the load as failed.
+		 */
+		void setLoadedData(HResource& resource, const SPtr<Resource>& data);
+
+		/** 
+		 * Main loop of the I/O thread. Reads data of queued asynchronous loads in priority order, then hands them off to 
+		 * worker threads for deserialization.
+		 */
+		void runIOThread();
+
+		/**
+		 * Removes all loads still waiting in the I/O queue and completes them as failed, same as cancelLoad(). Called
+		 * on shutdown so resources waited on by blockUntilLoaded() don't stay in progress forever.
+		 */
+		void failQueuedLoads();
+
+		/** Checks should @p lhs be read before @p rhs. */
+		static bool isHigherPriority(const ResourceIORequest& lhs, const ResourceIORequest& rhs);
 
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
 
 	private:
 		Vector<SPtr<ResourceManifest>> mResourceManifests;
+		Vector<SPtr<ResourcePackage>> mResourcePackages;
 		SPtr<ResourceManifest> mDefaultResourceManifest;
 
-		Mutex mInProgressResourcesMutex;
-		Mutex mLoadedResourceMutex;
-		Mutex mDefaultManifestMutex;
+		ProfiledMutex mInProgressResourcesMutex{"Resources in progress"};
+		ProfiledMutex mLoadedResourceMutex{"Resources loaded"};
+		ProfiledMutex mDefaultManifestMutex{"Resources manifest"};
 		RecursiveMutex mDestroyMutex;
 
 		UnorderedMap<UUID, WeakResourceHandle<Resource>> mHandles;
 		UnorderedMap<UUID, LoadedResourceData> mLoadedResources;
 		UnorderedMap<UUID, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
 		UnorderedMap<UUID, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+
+		HThread mIOThread;
+		ProfiledMutex mIOMutex{"Resources I/O"};
+		ProfiledSignal mIOCondition;
+		Vector<ResourceIORequest> mIORequests;
+		UINT64 mNextIORequestIdx = 0;
+		bool mIOThreadShutdown = false;
+		UINT32 mNumAsyncReads = 0;
 	};
 
 	/** Provides easier access to Resources manager. */
@@ -28,7 +28,10 @@ namespace bs
 		/**	Returns true if this resource is allow to be asynchronously loaded. */
 		bool allowAsyncLoading() const { return mAllowAsync; }
 
-		/** Returns the method used for compressing the resource. 0 if none. */
+		/**
+		 * Returns the method used for compressing the resource. 0 if none, 1 for a single Snappy stream, 2 for the block
+		 * compression format (see Compression::compressBlocks()).
+		 */
 		UINT32 getCompressionMethod() const { return mCompressionMethod; }
 
 	private:
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Scene/BsComponent.h"
 #include "Scene/BsSceneObject.h"
+#include "Scene/BsSceneManager.h"
 #include "Private/RTTI/BsComponentRTTI.h"
 
 namespace bs
@@ -27,6 +28,16 @@ namespace bs
 
 	void Component::destroy(bool immediate)
 	{
+		// Scene structure cannot change while components are being updated in parallel
+		const auto deferredDestroy = [handle = mThisHandle, immediate]()
+		{
+			if (!handle.isDestroyed())
+				handle->destroy(immediate);
+		};
+
+		if (SceneManager::isStarted() && gSceneManager()._deferStructuralChange(deferredDestroy))
+			return;
+
 		SO()->destroyComponent(this, immediate);
 	}
 
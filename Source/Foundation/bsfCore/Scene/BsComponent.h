@@ -20,7 +20,16 @@ namespace bs
 		 * Note that this flag must be specified on component creation, in its constructor and any later changes
 		 * to the flag could be ignored.
 		 */
-		AlwaysRun = 1 
+		AlwaysRun = 1,
+
+		/**
+		 * Declares that update() and fixedUpdate() of the component can run in parallel with the updates of other
+		 * components of the same type. Such updates may only modify the component itself and the transform of its own
+		 * scene object. Structural scene changes, like changing the parent or destroying objects, are deferred until
+		 * all updates finish. Components of a type are only updated in parallel if all of them have this flag set. Like
+		 * AlwaysRun, this flag must be specified in the component's constructor.
+		 */
+		ParallelUpdate = 2
 	};
 
 	typedef Flags<ComponentFlag> ComponentFlags;
@@ -165,6 +174,12 @@ namespace bs
 		/** Returns an index that unique identifies a component with the SceneManager. */
 		UINT32 getSceneManagerId() const { return mSceneManagerId; }
 
+		/** Sets the index of the component in the SceneManager's update group for its type. */
+		void setUpdateGroupIdx(UINT32 idx) { mUpdateGroupIdx = idx; }
+
+		/** Returns the index of the component in the SceneManager's update group for its type. */
+		UINT32 getUpdateGroupIdx() const { return mUpdateGroupIdx; }
+
 		/**
 		 * Destroys this component.
 		 *
@@ -183,6 +198,7 @@ namespace bs
 		TransformChangedFlags mNotifyFlags = TCF_None;
 		ComponentFlags mFlags;
 		UINT32 mSceneManagerId = 0;
+		UINT32 mUpdateGroupIdx = 0;
 
 	private:
 		HSceneObject mParent;
@@ -8,7 +8,7 @@ namespace bs
 {
 	void GameObject::initialize(const SPtr<GameObject>& object, UINT64 instanceId)
 	{
-		mInstanceData = bs_shared_ptr_new<GameObjectInstanceData>();
+		mInstanceData = bs_pool_shared_ptr_new<GameObjectInstanceData>();
 		mInstanceData->object = object;
 		mInstanceData->mInstanceId = instanceId;
 	}
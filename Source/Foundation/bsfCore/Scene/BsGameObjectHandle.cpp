@@ -11,7 +11,7 @@ namespace bs
 {
 	GameObjectHandleBase::GameObjectHandleBase(const SPtr<GameObject>& ptr)
 	{
-		mData = bs_shared_ptr_new<GameObjectHandleData>(ptr->mInstanceData);
+		mData = bs_pool_shared_ptr_new<GameObjectHandleData>(ptr->mInstanceData);
 	}
 
 	bool GameObjectHandleBase::isDestroyed(bool checkQueued) const
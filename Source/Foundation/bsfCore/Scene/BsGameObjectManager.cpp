@@ -48,8 +48,13 @@ namespace bs
 			return;
 
 		Lock lock(mMutex);
-		mObjects[newId] = mObjects[oldId];
-		mObjects.erase(oldId);
+		const auto iterFind = mObjects.find(oldId);
+		if (iterFind == mObjects.end())
+			return;
+
+		GameObjectHandleBase handle = std::move(iterFind->second);
+		mObjects.erase(iterFind);
+		mObjects[newId] = std::move(handle);
 	}
 
 	UINT64 GameObjectManager::reserveId()
@@ -62,16 +67,26 @@ namespace bs
 		if (object.isDestroyed())
 			return;
 
-		const UINT64 instanceId = object->getInstanceId();
-		mQueuedForDestroy[instanceId] = object;
+		// Objects queued more than once are skipped when destroyed, as their handles are already invalidated
+		mQueuedForDestroy.push_back(object);
 	}
 
 	void GameObjectManager::destroyQueuedObjects()
 	{
-		for (auto& objPair : mQueuedForDestroy)
-			objPair.second->destroyInternal(objPair.second, true);
+		// Destruction can queue more objects, keep going until none are left
+		Vector<GameObjectHandleBase> toDestroy;
+		while (!mQueuedForDestroy.empty())
+		{
+			std::swap(toDestroy, mQueuedForDestroy);
 
-		mQueuedForDestroy.clear();
+			for (auto& handle : toDestroy)
+			{
+				if (!handle.isDestroyed())
+					handle->destroyInternal(handle, true);
+			}
+
+			toDestroy.clear();
+		}
 	}
 
 	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object)
@@ -107,8 +107,8 @@ namespace bs
 
 	private:
 		std::atomic<UINT64> mNextAvailableID = { 1 } ; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
-		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
+		UnorderedMap<UINT64, GameObjectHandleBase> mObjects;
+		Vector<GameObjectHandleBase> mQueuedForDestroy;
 
 		mutable Mutex mMutex;
 	};
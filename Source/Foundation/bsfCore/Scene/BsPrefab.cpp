@@ -5,6 +5,10 @@
 #include "Resources/BsResources.h"
 #include "Scene/BsSceneObject.h"
 #include "Scene/BsPrefabUtility.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsSerializedObject.h"
+#include "Scene/BsComponent.h"
 #include "BsCoreApplication.h"
 
 namespace bs
@@ -17,6 +21,8 @@ namespace bs
 
 	Prefab::~Prefab()
 	{
+		_clearInstanceTemplate();
+
 		if (mRoot != nullptr)
 			mRoot->destroy(true);
 	}
@@ -72,6 +78,8 @@ namespace bs
 		}
 
 		// Clone the hierarchy for internal storage
+		_clearInstanceTemplate();
+
 		if (mRoot != nullptr)
 			mRoot->destroy(true);
 
@@ -109,6 +117,9 @@ namespace bs
 
 	void Prefab::_updateChildInstances()
 	{
+		// Child instances might change, the hierarchy needs to be serialized again
+		_clearInstanceTemplate();
+
 		Stack<HSceneObject> todo;
 		todo.push(mRoot);
 
@@ -154,10 +165,52 @@ namespace bs
 		if (mRoot == nullptr)
 			return HSceneObject();
 
-		mRoot->mPrefabHash = mHash;
-		mRoot->mLinkId = -1;
+		// The hierarchy is serialized only once and every instance is then decoded from the same data, instead of
+		// serializing the hierarchy again for each instance
+		if (mInstanceTemplate == nullptr)
+		{
+			mRoot->mPrefabHash = mHash;
+			mRoot->mLinkId = -1;
+
+			const bool isInstantiated = !mRoot->hasFlag(SOF_DontInstantiate);
+			mRoot->_setFlags(SOF_DontInstantiate);
+
+			MemorySerializer serializer;
+			mInstanceTemplate = serializer.encode(mRoot.get(), mInstanceTemplateSize, (void*(*)(size_t))&bs_alloc);
+
+			if (isInstantiated)
+				mRoot->_unsetFlags(SOF_DontInstantiate);
+		}
+
+		CoreSerializationContext serzContext;
+		serzContext.goState = bs_shared_ptr_new<GameObjectDeserializationState>(GODM_RestoreExternal | GODM_UseNewIds);
+
+		MemorySerializer serializer;
+		SPtr<SceneObject> cloneObj = std::static_pointer_cast<SceneObject>(
+			serializer.decode(mInstanceTemplate, mInstanceTemplateSize, &serzContext));
+
+		return cloneObj->getHandle();
+	}
+
+	SPtr<SerializedObject> Prefab::_getSerializedComponent(const HComponent& component)
+	{
+		SPtr<SerializedObject>& output = mSerializedComponents[component.getInstanceId()];
+		if (output == nullptr)
+			output = SerializedObject::create(*component);
+
+		return output;
+	}
+
+	void Prefab::_clearInstanceTemplate()
+	{
+		if (mInstanceTemplate != nullptr)
+		{
+			bs_free(mInstanceTemplate);
+			mInstanceTemplate = nullptr;
+			mInstanceTemplateSize = 0;
+		}
 
-		return mRoot->clone(false);
+		mSerializedComponents.clear();
 	}
 
 	RTTITypeBase* Prefab::getRTTIStatic()
@@ -70,17 +70,32 @@ namespace bs
 
 		/**
 		 * Returns a reference to the internal prefab hierarchy. Returned hierarchy is not instantiated and cannot be 
-		 * interacted with in a manner you would with normal scene objects.
+		 * interacted with in a manner you would with normal scene objects. If the hierarchy is modified, 
+		 * _clearInstanceTemplate() must be called afterwards.
 		 */
 		HSceneObject _getRoot() const { return mRoot; }
 
 		/**
-		 * Creates the clone of the prefab's current hierarchy but doesn't instantiate it.
+		 * Creates the clone of the prefab's current hierarchy but doesn't instantiate it. The hierarchy is serialized on
+		 * first use and the serialized data is then reused for creating all subsequent clones.
 		 *			
 		 * @return	Clone of the prefab's scene object hierarchy.
 		 */
 		HSceneObject _clone();
 
+		/**
+		 * Returns the serialized data of a component in the prefab's hierarchy, used for generating the differences
+		 * between the prefab and its instances. The component is serialized on first use and the data is then reused
+		 * for all instances.
+		 */
+		SPtr<SerializedObject> _getSerializedComponent(const HComponent& component);
+
+		/** 
+		 * Releases the cached serialized hierarchy used for creating clones, and the cached serialized components,
+		 * forcing them to be rebuilt from the current hierarchy on next use.
+		 */
+		void _clearInstanceTemplate();
+
 		/** @} */
 
 	private:
@@ -97,6 +112,10 @@ namespace bs
 		UUID mUUID;
 		bool mIsScene;
 
+		UINT8* mInstanceTemplate = nullptr;
+		UINT64 mInstanceTemplateSize = 0;
+		UnorderedMap<UINT64, SPtr<SerializedObject>> mSerializedComponents;
+
 		/************************************************************************/
 		/* 								RTTI		                     		*/
 		/************************************************************************/
@@ -3,10 +3,11 @@
 #include "Scene/BsPrefabDiff.h"
 #include "Private/RTTI/BsPrefabDiffRTTI.h"
 #include "Scene/BsSceneObject.h"
-#include "Serialization/BsMemorySerializer.h"
 #include "Serialization/BsBinarySerializer.h"
 #include "Serialization/BsBinaryDiff.h"
+#include "Serialization/BsBinaryCompare.h"
 #include "Scene/BsSceneManager.h"
+#include "Scene/BsPrefab.h"
 #include "Utility/BsUtility.h"
 
 namespace bs
@@ -31,7 +32,20 @@ namespace bs
 		return PrefabObjectDiff::getRTTIStatic();
 	}
 
+	SPtr<PrefabDiff> PrefabDiff::create(const HPrefab& prefab, const HSceneObject& instance)
+	{
+		if (!prefab.isLoaded(false))
+			return nullptr;
+
+		return create(prefab->_getRoot(), instance, prefab.get());
+	}
+
 	SPtr<PrefabDiff> PrefabDiff::create(const HSceneObject& prefab, const HSceneObject& instance)
+	{
+		return create(prefab, instance, nullptr);
+	}
+
+	SPtr<PrefabDiff> PrefabDiff::create(const HSceneObject& prefab, const HSceneObject& instance, Prefab* source)
 	{
 		if (prefab->mPrefabLinkUUID != instance->mPrefabLinkUUID)
 			return nullptr;
@@ -47,7 +61,7 @@ namespace bs
 		renameInstanceIds(prefab, instance, renamedObjects);
 
 		SPtr<PrefabDiff> output = bs_shared_ptr_new<PrefabDiff>();
-		output->mRoot = generateDiff(prefab, instance);
+		output->mRoot = generateDiff(prefab, instance, source);
 
 		restoreInstanceIds(renamedObjects);
 
@@ -160,7 +174,8 @@ namespace bs
 		}
 	}
 
-	SPtr<PrefabObjectDiff> PrefabDiff::generateDiff(const HSceneObject& prefab, const HSceneObject& instance)
+	SPtr<PrefabObjectDiff> PrefabDiff::generateDiff(const HSceneObject& prefab, const HSceneObject& instance,
+		Prefab* source)
 	{
 		SPtr<PrefabObjectDiff> output;
 
@@ -228,7 +243,7 @@ namespace bs
 				if (prefabChild->getLinkId() == instanceChild->getLinkId())
 				{
 					if (instanceChild->mPrefabLinkUUID.empty())
-						childDiff = generateDiff(prefabChild, instanceChild);
+						childDiff = generateDiff(prefabChild, instanceChild, source);
 
 					foundMatching = true;
 					break;
@@ -307,7 +322,17 @@ namespace bs
 
 				if (prefabComponent->getLinkId() == instanceComponent->getLinkId())
 				{
-					SPtr<SerializedObject> encodedPrefab = SerializedObject::create(*prefabComponent);
+					foundMatching = true;
+
+					// Game object IDs were renamed to match the instance, so unmodified components have identical data.
+					// The vast majority of components are unmodified, and comparing them directly is much cheaper than
+					// serializing and diffing them.
+					if (BinaryCompare::isEqual(prefabComponent.get(), instanceComponent.get()))
+						break;
+
+					// Prefab data is the same for all instances, so it only needs to be serialized once
+					SPtr<SerializedObject> encodedPrefab = source != nullptr ?
+						source->_getSerializedComponent(prefabComponent) : SerializedObject::create(*prefabComponent);
 					SPtr<SerializedObject> encodedInstance = SerializedObject::create(*instanceComponent);
 
 					IDiff& diffHandler = prefabComponent->getRTTI()->getDiffHandler();
@@ -320,7 +345,6 @@ namespace bs
 						childDiff->data = diff;
 					}
 
-					foundMatching = true;
 					break;
 				}
 			}
@@ -89,6 +89,14 @@ namespace bs
 	class BS_CORE_EXPORT PrefabDiff : public IReflectable
 	{
 	public:
+		/**
+		 * Creates a new prefab diff by comparing the provided instanced scene object hierarchy with the hierarchy of
+		 * the prefab. Serialized prefab data required for the comparison is cached in the prefab, making this cheaper
+		 * than create(const HSceneObject&, const HSceneObject&) when diffing multiple instances of the same prefab.
+		 * Returns null if the prefab isn't loaded.
+		 */
+		static SPtr<PrefabDiff> create(const HPrefab& prefab, const HSceneObject& instance);
+
 		/**
 		 * Creates a new prefab diff by comparing the provided instanced scene object hierarchy with the prefab scene 
 		 * object hierarchy.
@@ -113,12 +121,19 @@ namespace bs
 			UINT64 originalId;
 		};
 
+		/**
+		 * Creates a prefab diff between the prefab hierarchy and the instance hierarchy. If @p source is provided, it
+		 * must be the prefab owning the prefab hierarchy, and is used for caching serialized prefab data.
+		 */
+		static SPtr<PrefabDiff> create(const HSceneObject& prefab, const HSceneObject& instance, Prefab* source);
+
 		/**
 		 * Recurses over every scene object in the prefab a generates differences between itself and the instanced version.
 		 *
 		 * @see		create
 		 */
-		static SPtr<PrefabObjectDiff> generateDiff(const HSceneObject& prefab, const HSceneObject& instance);
+		static SPtr<PrefabObjectDiff> generateDiff(const HSceneObject& prefab, const HSceneObject& instance,
+			Prefab* source);
 
 		/**
 		 * Recursively applies a per-object set of prefab differences to a specific object.
@@ -285,7 +285,7 @@ namespace bs
 
 				HPrefab prefabLink = static_resource_cast<Prefab>(gResources().loadFromUUID(current->mPrefabLinkUUID, false, ResourceLoadFlag::None));
 				if (prefabLink.isLoaded(false))
-					current->mPrefabDiff = PrefabDiff::create(prefabLink->_getRoot(), current->getHandle());
+					current->mPrefabDiff = PrefabDiff::create(prefabLink, current->getHandle());
 			}
 
 			UINT32 childCount = current->getNumChildren();
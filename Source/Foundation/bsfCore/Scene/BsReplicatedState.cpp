@@ -0,0 +1,242 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsReplicatedState.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsComponent.h"
+#include "Reflection/BsRTTIPlainField.h"
+
+namespace bs
+{
+	void ReplicatedState::registerField(RTTITypeBase* type, const String& name)
+	{
+		// Not using findField(const String&), since it throws if the field doesn't exist
+		RTTIField* field = nullptr;
+		for (UINT32 i = 0; i < type->getNumFields(); i++)
+		{
+			if (type->getField(i)->mName == name)
+			{
+				field = type->getField(i);
+				break;
+			}
+		}
+
+		if (field == nullptr)
+		{
+			LOGERR("Cannot register replicated field. Type \"" + type->getRTTIName() + "\" has no field named \"" +
+				name + "\".");
+			return;
+		}
+
+		if (!field->isPlainType() || field->isArray() || field->hasDynamicSize())
+		{
+			LOGERR("Cannot register replicated field \"" + name + "\". Only non-array plain fields of static size are "
+				"supported.");
+			return;
+		}
+
+		for (auto& entry : mFields)
+		{
+			if (entry.type == type && entry.field == field)
+				return;
+		}
+
+		mFields.push_back({ type, static_cast<RTTIPlainFieldBase*>(field) });
+	}
+
+	void ReplicatedState::addSceneObject(const HSceneObject& so)
+	{
+		if (so.isDestroyed())
+			return;
+
+		addSlot(SlotType::Position, so, HComponent(), FieldInfo(), sizeof(Vector3));
+		addSlot(SlotType::Rotation, so, HComponent(), FieldInfo(), sizeof(Quaternion));
+		addSlot(SlotType::Scale, so, HComponent(), FieldInfo(), sizeof(Vector3));
+
+		for (auto& component : so->getComponents())
+		{
+			RTTITypeBase* componentType = component->getRTTI();
+			for (auto& entry : mFields)
+			{
+				if (componentType != entry.type && !componentType->isDerivedFrom(entry.type))
+					continue;
+
+				addSlot(SlotType::Field, so, component, entry, entry.field->getTypeSize());
+			}
+		}
+	}
+
+	void ReplicatedState::clear()
+	{
+		mSlots.clear();
+		mSnapshotSize = 0;
+	}
+
+	void ReplicatedState::capture(Vector<UINT8>& snapshot) const
+	{
+		snapshot.resize(mSnapshotSize);
+
+		for (auto& slot : mSlots)
+			readSlot(slot, snapshot.data() + slot.offset);
+	}
+
+	void ReplicatedState::restore(const Vector<UINT8>& snapshot) const
+	{
+		if (snapshot.size() != mSnapshotSize)
+		{
+			LOGERR("Cannot restore snapshot, its size doesn't match the replicated state.");
+			return;
+		}
+
+		// Setters take non-const data, but never modify it
+		UINT8* data = const_cast<UINT8*>(snapshot.data());
+		for (auto& slot : mSlots)
+			writeSlot(slot, data + slot.offset);
+	}
+
+	void ReplicatedState::createDelta(const Vector<UINT8>& baseline, const Vector<UINT8>& snapshot,
+		Vector<UINT8>& delta) const
+	{
+		delta.clear();
+
+		if (baseline.size() != mSnapshotSize || snapshot.size() != mSnapshotSize)
+		{
+			LOGERR("Cannot create snapshot delta, snapshot size doesn't match the replicated state.");
+			return;
+		}
+
+		const UINT32 maskSize = ((UINT32)mSlots.size() + 7) / 8;
+		delta.resize(maskSize, 0);
+		delta.reserve(maskSize + mSnapshotSize);
+
+		for (UINT32 i = 0; i < (UINT32)mSlots.size(); i++)
+		{
+			const Slot& slot = mSlots[i];
+
+			const UINT8* baselineValue = baseline.data() + slot.offset;
+			const UINT8* value = snapshot.data() + slot.offset;
+			if (memcmp(baselineValue, value, slot.size) == 0)
+				continue;
+
+			delta[i / 8] |= 1 << (i % 8);
+
+			for (UINT32 j = 0; j < slot.size; j++)
+				delta.push_back(baselineValue[j] ^ value[j]);
+		}
+	}
+
+	bool ReplicatedState::applyDelta(const Vector<UINT8>& baseline, const Vector<UINT8>& delta,
+		Vector<UINT8>& snapshot) const
+	{
+		const UINT32 maskSize = ((UINT32)mSlots.size() + 7) / 8;
+		if (baseline.size() != mSnapshotSize || delta.size() < maskSize)
+		{
+			LOGERR("Cannot apply snapshot delta, baseline or delta size doesn't match the replicated state.");
+			return false;
+		}
+
+		snapshot = baseline;
+
+		UINT32 readOffset = maskSize;
+		for (UINT32 i = 0; i < (UINT32)mSlots.size(); i++)
+		{
+			if ((delta[i / 8] & (1 << (i % 8))) == 0)
+				continue;
+
+			const Slot& slot = mSlots[i];
+			if (readOffset + slot.size > (UINT32)delta.size())
+			{
+				LOGERR("Cannot apply snapshot delta, delta is truncated.");
+				return false;
+			}
+
+			UINT8* value = snapshot.data() + slot.offset;
+			for (UINT32 j = 0; j < slot.size; j++)
+				value[j] ^= delta[readOffset + j];
+
+			readOffset += slot.size;
+		}
+
+		return true;
+	}
+
+	void ReplicatedState::addSlot(SlotType type, const HSceneObject& so, const HComponent& component,
+		const FieldInfo& field, UINT32 size)
+	{
+		Slot slot;
+		slot.type = type;
+		slot.so = so;
+		slot.component = component;
+		slot.field = field;
+		slot.offset = mSnapshotSize;
+		slot.size = size;
+
+		mSlots.push_back(slot);
+		mSnapshotSize += size;
+	}
+
+	void ReplicatedState::readSlot(const Slot& slot, UINT8* data) const
+	{
+		if (slot.so.isDestroyed() || (slot.type == SlotType::Field && slot.component.isDestroyed()))
+		{
+			memset(data, 0, slot.size);
+			return;
+		}
+
+		const Transform& tfrm = slot.so->getLocalTransform();
+		switch (slot.type)
+		{
+		case SlotType::Position:
+			memcpy(data, &tfrm.getPosition(), sizeof(Vector3));
+			break;
+		case SlotType::Rotation:
+			memcpy(data, &tfrm.getRotation(), sizeof(Quaternion));
+			break;
+		case SlotType::Scale:
+			memcpy(data, &tfrm.getScale(), sizeof(Vector3));
+			break;
+		case SlotType::Field:
+		{
+			IReflectable* object = slot.component.get();
+			slot.field.field->toBuffer(slot.field.type, object, data);
+		}
+			break;
+		}
+	}
+
+	void ReplicatedState::writeSlot(const Slot& slot, UINT8* data) const
+	{
+		if (slot.so.isDestroyed() || (slot.type == SlotType::Field && slot.component.isDestroyed()))
+			return;
+
+		switch (slot.type)
+		{
+		case SlotType::Position:
+		{
+			Vector3 position;
+			memcpy(&position, data, sizeof(Vector3));
+			slot.so->setPosition(position);
+		}
+			break;
+		case SlotType::Rotation:
+		{
+			Quaternion rotation;
+			memcpy(&rotation, data, sizeof(Quaternion));
+			slot.so->setRotation(rotation);
+		}
+			break;
+		case SlotType::Scale:
+		{
+			Vector3 scale;
+			memcpy(&scale, data, sizeof(Vector3));
+			slot.so->setScale(scale);
+		}
+			break;
+		case SlotType::Field:
+		{
+			IReflectable* object = slot.component.get();
+			slot.field.field->fromBuffer(slot.field.type, object, data);
+		}
+			break;
+		}
+	}
+}
@@ -0,0 +1,133 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	struct RTTIPlainFieldBase;
+
+	/** @addtogroup Scene
+	 *  @{
+	 */
+
+	/**
+	 * Set of scene object transforms and component fields that are captured into compact binary snapshots, for
+	 * replicating scene state over the network or rewinding it. Snapshots contain only the raw values of the
+	 * replicated fields, laid out in the order the scene objects were added in, so snapshots are only compatible
+	 * between states that had the same scene objects added in the same order.
+	 *
+	 * Snapshots can be encoded as deltas against an earlier (baseline) snapshot, which only contain the fields that
+	 * changed since the baseline.
+	 */
+	class BS_CORE_EXPORT ReplicatedState
+	{
+	public:
+		/**
+		 * Registers a field that will be replicated on all components of type @p type (or derived from it), added
+		 * through addSceneObject() after this call. Only non-array plain fields of static size are supported. The field
+		 * is read and written directly through its RTTI getter and setter, without triggering any serialization
+		 * callbacks.
+		 *
+		 * @param[in]	type	RTTI type of the component that declares the field.
+		 * @param[in]	name	Name of the field, as declared in the RTTI type.
+		 */
+		void registerField(RTTITypeBase* type, const String& name);
+
+		/** @copydoc registerField(RTTITypeBase*, const String&) */
+		template<class T>
+		void registerField(const String& name)
+		{
+			registerField(T::getRTTIStatic(), name);
+		}
+
+		/**
+		 * Adds a scene object whose local transform and registered component fields should be replicated. Child scene
+		 * objects are not added.
+		 */
+		void addSceneObject(const HSceneObject& so);
+
+		/** Removes all the added scene objects. Registered fields remain registered. */
+		void clear();
+
+		/** Returns the size of a single snapshot, in bytes. */
+		UINT32 getSnapshotSize() const { return mSnapshotSize; }
+
+		/**
+		 * Captures the current values of all replicated fields. Fields of scene objects or components that were
+		 * destroyed since being added are captured as zero.
+		 */
+		void capture(Vector<UINT8>& snapshot) const;
+
+		/**
+		 * Assigns the values from the provided snapshot to all replicated fields. Scene objects or components that were
+		 * destroyed since being added are skipped.
+		 */
+		void restore(const Vector<UINT8>& snapshot) const;
+
+		/**
+		 * Encodes the difference between two snapshots. The delta consists of a bit mask marking the changed fields,
+		 * followed by the changed field values, XOR-ed with their baseline values. Unchanged fields take up only a bit.
+		 *
+		 * @param[in]	baseline	Snapshot to encode the difference against.
+		 * @param[in]	snapshot	Snapshot to encode.
+		 * @param[out]	delta		Encoded difference.
+		 */
+		void createDelta(const Vector<UINT8>& baseline, const Vector<UINT8>& snapshot, Vector<UINT8>& delta) const;
+
+		/**
+		 * Reconstructs a snapshot from a delta created by createDelta().
+		 *
+		 * @param[in]	baseline	Snapshot the delta was created against.
+		 * @param[in]	delta		Difference to apply to the baseline.
+		 * @param[out]	snapshot	Reconstructed snapshot.
+		 * @return					False if the delta or the baseline are malformed.
+		 */
+		bool applyDelta(const Vector<UINT8>& baseline, const Vector<UINT8>& delta, Vector<UINT8>& snapshot) const;
+
+	private:
+		/** Types of values that can be stored in a snapshot. */
+		enum class SlotType
+		{
+			Position,
+			Rotation,
+			Scale,
+			Field
+		};
+
+		/** Field registered through registerField(). */
+		struct FieldInfo
+		{
+			RTTITypeBase* type = nullptr;
+			RTTIPlainFieldBase* field = nullptr;
+		};
+
+		/** Location of a single replicated value in a snapshot. */
+		struct Slot
+		{
+			SlotType type;
+			HSceneObject so;
+			HComponent component;
+			FieldInfo field;
+			UINT32 offset;
+			UINT32 size;
+		};
+
+		/** Adds a new slot to the end of the snapshot layout. */
+		void addSlot(SlotType type, const HSceneObject& so, const HComponent& component, const FieldInfo& field,
+			UINT32 size);
+
+		/** Copies the current value referenced by the slot into the provided buffer. */
+		void readSlot(const Slot& slot, UINT8* data) const;
+
+		/** Assigns the value in the provided buffer to the value referenced by the slot. */
+		void writeSlot(const Slot& slot, UINT8* data) const;
+
+		Vector<FieldInfo> mFields;
+		Vector<Slot> mSlots;
+		UINT32 mSnapshotSize = 0;
+	};
+
+	/** @} */
+}
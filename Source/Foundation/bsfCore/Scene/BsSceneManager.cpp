@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Scene/BsSceneManager.h"
 #include "Scene/BsSceneObject.h"
+#include "Scene/BsPrefab.h"
 #include "Scene/BsComponent.h"
 #include "Renderer/BsRenderable.h"
 #include "Renderer/BsCamera.h"
@@ -11,6 +12,8 @@
 #include "RenderAPI/BsRenderTarget.h"
 #include "Renderer/BsLightProbeVolume.h"
 #include "Scene/BsSceneActor.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -58,6 +61,7 @@ namespace bs
 		}
 
 		GameObjectManager::instance().destroyQueuedObjects();
+		mPendingInstantiations.clear();
 
 		HSceneObject newRoot = SceneObject::createInternal("SceneRoot");
 		setRootNode(newRoot);
@@ -97,19 +101,40 @@ namespace bs
 
 	void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
 	{
-		mBoundActors[actor.get()] = BoundActorData(actor, so);
+		auto iterFind = mBoundActorLookup.find(actor.get());
+		if (iterFind != mBoundActorLookup.end())
+		{
+			mBoundActors[iterFind->second] = BoundActorData(actor, so);
+			return;
+		}
+
+		mBoundActorLookup[actor.get()] = (UINT32)mBoundActors.size();
+		mBoundActors.push_back(BoundActorData(actor, so));
 	}
 
 	void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
 	{
-		mBoundActors.erase(actor.get());
+		auto iterFind = mBoundActorLookup.find(actor.get());
+		if (iterFind == mBoundActorLookup.end())
+			return;
+
+		const UINT32 idx = iterFind->second;
+		mBoundActorLookup.erase(iterFind);
+
+		if (idx != (UINT32)mBoundActors.size() - 1)
+		{
+			mBoundActors[idx] = std::move(mBoundActors.back());
+			mBoundActorLookup[mBoundActors[idx].actor.get()] = idx;
+		}
+
+		mBoundActors.erase(mBoundActors.end() - 1);
 	}
 
 	HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
 	{
-		auto iterFind = mBoundActors.find(actor.get());
-		if (iterFind != mBoundActors.end())
-			return iterFind->second.so;
+		auto iterFind = mBoundActorLookup.find(actor.get());
+		if (iterFind != mBoundActorLookup.end())
+			return mBoundActors[iterFind->second].so;
 
 		return HSceneObject();		
 	}
@@ -161,8 +186,53 @@ namespace bs
 
 	void SceneManager::_updateCoreObjectTransforms()
 	{
+		updateDirtyTransforms();
+
 		for (auto& entry : mBoundActors)
-			entry.second.actor->_updateState(*entry.second.so);
+			entry.actor->_updateState(*entry.so);
+	}
+
+	void SceneManager::_notifyTransformDirty(const HSceneObject& so)
+	{
+		if (mParallelUpdateActive)
+		{
+			Lock lock(mDirtyTransformsMutex);
+			mDirtyTransformRoots.push_back(so);
+		}
+		else
+			mDirtyTransformRoots.push_back(so);
+	}
+
+	void SceneManager::updateDirtyTransforms()
+	{
+		bs_frame_mark();
+		{
+			FrameVector<SceneObject*> queue;
+			for (auto& root : mDirtyTransformRoots)
+			{
+				// Already updated, either on access, or as a part of another dirty hierarchy
+				if (root.isDestroyed() || root->isCachedWorldTfrmUpToDate())
+					continue;
+
+				queue.clear();
+				queue.push_back(root.get());
+
+				for (UINT32 i = 0; i < (UINT32)queue.size(); i++)
+				{
+					SceneObject* so = queue[i];
+					if (so->isCachedWorldTfrmUpToDate())
+						continue;
+
+					so->updateTransformsIfDirty();
+
+					for (auto& child : so->mChildren)
+						queue.push_back(child.get());
+				}
+			}
+		}
+		bs_frame_clear();
+
+		mDirtyTransformRoots.clear();
 	}
 
 	SPtr<Camera> SceneManager::getMainCamera() const
@@ -412,6 +482,9 @@ namespace bs
 		list.push_back(component);
 
 		component->setSceneManagerId(encodeComponentId(idx, listType));
+
+		if(listType == ActiveList)
+			addToUpdateGroup(component.get());
 	}
 
 	void SceneManager::removeFromStateList(const HComponent& component)
@@ -437,6 +510,9 @@ namespace bs
 		}
 
 		list.erase(list.end() - 1);
+
+		if(listType == ActiveList)
+			removeFromUpdateGroup(component.get());
 	}
 
 	void SceneManager::processStateChanges()
@@ -488,6 +564,245 @@ namespace bs
 		mStateChanges.clear();
 	}
 
+	void SceneManager::setComponentTypeUpdate(UINT32 rttiId, INT32 priority, ComponentBatchUpdateFunc update,
+		ComponentBatchUpdateFunc fixedUpdate)
+	{
+		ComponentUpdateGroup& group = getUpdateGroup(rttiId, "");
+		group.update = std::move(update);
+		group.fixedUpdate = std::move(fixedUpdate);
+
+		if(group.priority != priority)
+		{
+			group.priority = priority;
+			sortUpdateGroups();
+		}
+	}
+
+	SceneManager::ComponentUpdateGroup& SceneManager::getUpdateGroup(UINT32 rttiId, const String& name)
+	{
+		auto iterFind = mUpdateGroupLookup.find(rttiId);
+		if(iterFind != mUpdateGroupLookup.end())
+		{
+			ComponentUpdateGroup& group = mUpdateGroups[iterFind->second];
+
+			// Groups registered before any components of their type existed don't have a name yet
+			if(group.name.empty())
+				group.name = name;
+
+			return group;
+		}
+
+		ComponentUpdateGroup group;
+		group.rttiId = rttiId;
+		group.name = name;
+
+		mUpdateGroups.push_back(std::move(group));
+		sortUpdateGroups();
+
+		return mUpdateGroups[mUpdateGroupLookup[rttiId]];
+	}
+
+	void SceneManager::addToUpdateGroup(Component* component)
+	{
+		RTTITypeBase* rtti = component->getRTTI();
+		ComponentUpdateGroup& group = getUpdateGroup(rtti->getRTTIId(), rtti->getRTTIName());
+
+		component->setUpdateGroupIdx((UINT32)group.components.size());
+		group.components.push_back(component);
+
+		if(!component->hasFlag(ComponentFlag::ParallelUpdate))
+			group.numSerial++;
+	}
+
+	void SceneManager::removeFromUpdateGroup(Component* component)
+	{
+		auto iterFind = mUpdateGroupLookup.find(component->getRTTI()->getRTTIId());
+		if(iterFind == mUpdateGroupLookup.end())
+			return;
+
+		ComponentUpdateGroup& group = mUpdateGroups[iterFind->second];
+		Vector<Component*>& components = group.components;
+
+		const UINT32 idx = component->getUpdateGroupIdx();
+		assert(components[idx] == component);
+
+		if(idx != (UINT32)components.size() - 1)
+		{
+			components[idx] = components.back();
+			components[idx]->setUpdateGroupIdx(idx);
+		}
+
+		components.erase(components.end() - 1);
+
+		if(!component->hasFlag(ComponentFlag::ParallelUpdate))
+			group.numSerial--;
+	}
+
+	void SceneManager::sortUpdateGroups()
+	{
+		std::stable_sort(mUpdateGroups.begin(), mUpdateGroups.end(), 
+			[](const ComponentUpdateGroup& a, const ComponentUpdateGroup& b)
+		{
+			return a.priority < b.priority;
+		});
+
+		mUpdateGroupLookup.clear();
+		for(UINT32 i = 0; i < (UINT32)mUpdateGroups.size(); i++)
+			mUpdateGroupLookup[mUpdateGroups[i].rttiId] = i;
+	}
+
+	void SceneManager::updateGroup(ComponentUpdateGroup& group, bool fixed)
+	{
+		const ComponentBatchUpdateFunc& batchUpdate = fixed ? group.fixedUpdate : group.update;
+		const auto updateRange = [&group, &batchUpdate, fixed](UINT32 start, UINT32 end)
+		{
+			if (batchUpdate)
+				batchUpdate(group.components.data() + start, end - start);
+			else
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					if (fixed)
+						group.components[i]->fixedUpdate();
+					else
+						group.components[i]->update();
+				}
+			}
+		};
+
+		const auto numComponents = (UINT32)group.components.size();
+		const bool parallel = group.numSerial == 0 && numComponents > PARALLEL_UPDATE_GRAIN_SIZE &&
+			TaskScheduler::isStarted();
+
+		if (!parallel)
+		{
+			updateRange(0, numComponents);
+			return;
+		}
+
+		mParallelUpdateActive = true;
+		TaskScheduler::instance().parallelFor(numComponents, PARALLEL_UPDATE_GRAIN_SIZE, updateRange);
+		mParallelUpdateActive = false;
+	}
+
+	bool SceneManager::_deferStructuralChange(std::function<void()> change)
+	{
+		if (!mParallelUpdateActive)
+			return false;
+
+		Lock lock(mDeferredChangesMutex);
+		mDeferredChanges.push_back(std::move(change));
+
+		return true;
+	}
+
+	void SceneManager::applyDeferredChanges()
+	{
+		// Changes can queue more changes, which are executed right away as no parallel update is in progress anymore
+		Vector<std::function<void()>> changes;
+		{
+			Lock lock(mDeferredChangesMutex);
+			std::swap(changes, mDeferredChanges);
+		}
+
+		for (auto& change : changes)
+			change();
+	}
+
+	void SceneManager::instantiateAsync(const HPrefab& prefab, std::function<void(const HSceneObject&)> onComplete,
+		const HSceneObject& parent)
+	{
+		if (prefab == nullptr)
+			return;
+
+		PendingInstantiation entry;
+		entry.prefab = prefab;
+		entry.parent = parent;
+		entry.onComplete = std::move(onComplete);
+
+		mPendingInstantiations.push_back(std::move(entry));
+	}
+
+	void SceneManager::processPendingInstantiations()
+	{
+		if (mPendingInstantiations.empty())
+			return;
+
+		const UINT64 deadline = mInstantiationTimer.getMicroseconds() + (UINT64)(mInstantiationBudget * 1000.0f);
+		bool first = true;
+
+		auto iter = mPendingInstantiations.begin();
+		while (iter != mPendingInstantiations.end())
+		{
+			PendingInstantiation& entry = *iter;
+			if (entry.root == nullptr)
+			{
+				if (!entry.prefab.isLoaded())
+				{
+					++iter;
+					continue;
+				}
+
+				if (!first && mInstantiationTimer.getMicroseconds() >= deadline)
+					return;
+
+				first = false;
+
+				// Cloning (decoding the hierarchy and resolving its handles) cannot be split, so it's done in one go
+				entry.root = entry.prefab->_clone();
+				entry.prefab = nullptr;
+
+				if (entry.root == nullptr)
+				{
+					auto onComplete = std::move(entry.onComplete);
+					iter = mPendingInstantiations.erase(iter);
+
+					if (onComplete)
+						onComplete(HSceneObject());
+
+					continue;
+				}
+
+				if (entry.parent != nullptr && !entry.parent.isDestroyed())
+					entry.root->setParent(entry.parent);
+
+				entry.todo.push_back(entry.root);
+			}
+			else if (entry.root.isDestroyed())
+			{
+				iter = mPendingInstantiations.erase(iter);
+				continue;
+			}
+
+			while (!entry.todo.empty())
+			{
+				if (!first && mInstantiationTimer.getMicroseconds() >= deadline)
+					return;
+
+				first = false;
+
+				HSceneObject so = entry.todo.back();
+				entry.todo.pop_back();
+
+				if (so.isDestroyed())
+					continue;
+
+				// Queued in reverse, so children are instantiated in their original order
+				for (UINT32 i = so->getNumChildren(); i > 0; i--)
+					entry.todo.push_back(so->getChild(i - 1));
+
+				so->_instantiate(false, false);
+			}
+
+			HSceneObject root = entry.root;
+			auto onComplete = std::move(entry.onComplete);
+			iter = mPendingInstantiations.erase(iter);
+
+			if (onComplete)
+				onComplete(root);
+		}
+	}
+
 
 	UINT32 SceneManager::encodeComponentId(UINT32 idx, UINT32 type)
 	{
@@ -509,14 +824,30 @@ namespace bs
 
 	void SceneManager::_update()
 	{
-		processStateChanges();
+		gProfilerCPU().beginSample("InstantiateAsync");
+		processPendingInstantiations();
+		gProfilerCPU().endSample("InstantiateAsync");
 
-		// Note: Eventually perform updates based on component types and/or on component priority. Right now we just
-		// iterate in an undefined order, but it wouldn't be hard to change it.
+		processStateChanges();
 
+		// Components are updated one type at a time, in order of priority. This keeps the code and data of a single
+		// type hot in the cache, and lets types update all of their components in one go.
 		ScopeToggle toggle(mDisableStateChange);
-		for (auto& entry : mActiveComponents)
-			entry->update();
+		for (auto& group : mUpdateGroups)
+		{
+			if (group.components.empty())
+				continue;
+
+			gProfilerCPU().beginSample(group.name.c_str());
+			updateGroup(group, false);
+			gProfilerCPU().endSample(group.name.c_str());
+		}
+
+		applyDeferredChanges();
+
+		// Remove components destroyed during the update from the lists while they're still accessible, since the lists
+		// reference them directly
+		processStateChanges();
 
 		GameObjectManager::instance().destroyQueuedObjects();
 	}
@@ -526,8 +857,15 @@ namespace bs
 		processStateChanges();
 
 		ScopeToggle toggle(mDisableStateChange);
-		for (auto& entry : mActiveComponents)
-			entry->fixedUpdate();
+		for (auto& group : mUpdateGroups)
+		{
+			if (group.components.empty())
+				continue;
+
+			updateGroup(group, true);
+		}
+
+		applyDeferredChanges();
 	}
 
 	void SceneManager::registerNewSO(const HSceneObject& node)
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Scene/BsGameObject.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
@@ -27,6 +28,12 @@ namespace bs
 		HSceneObject so;
 	};
 
+	/** 
+	 * Callback that updates a range of active components of the same type. Receives a pointer to the first component
+	 * of the range, and the number of components in the range. Components are stored contiguously.
+	 */
+	typedef std::function<void(Component* const*, UINT32)> ComponentBatchUpdateFunc;
+
 	/** Possible states components can be in. Controls which component callbacks are triggered. */
 	enum class ComponentState
 	{
@@ -42,6 +49,9 @@ namespace bs
 	class BS_CORE_EXPORT SceneManager : public Module<SceneManager>
 	{
 	public:
+		/** Minimum number of components a single task updates, when components are updated in parallel. */
+		static constexpr UINT32 PARALLEL_UPDATE_GRAIN_SIZE = 64;
+
 		SceneManager();
 		~SceneManager();
 
@@ -78,6 +88,58 @@ namespace bs
 		template<class T>
 		Vector<GameObjectHandle<T>> findComponents(bool activeOnly = true);
 
+		/**
+		 * Determines how are the update() and fixedUpdate() callbacks of components of a specific type executed.
+		 * Components are updated one type at a time, in order of their type's priority. 
+		 *
+		 * @param[in]	rttiId		RTTI id of the component type.
+		 * @param[in]	priority	Components of types with lower priority are updated first. Types that weren't
+		 *							registered have priority 0. Types with the same priority update in undefined order.
+		 * @param[in]	update		Optional callback to call instead of update() on each individual component. Allows
+		 *							the type to update all of its active components in a single loop.
+		 * @param[in]	fixedUpdate	Optional callback to call instead of fixedUpdate() on each individual component.
+		 */
+		void setComponentTypeUpdate(UINT32 rttiId, INT32 priority, ComponentBatchUpdateFunc update = nullptr,
+			ComponentBatchUpdateFunc fixedUpdate = nullptr);
+
+		/** @copydoc setComponentTypeUpdate(UINT32, INT32, ComponentBatchUpdateFunc, ComponentBatchUpdateFunc) */
+		template<class T>
+		void setComponentTypeUpdate(INT32 priority, ComponentBatchUpdateFunc update = nullptr,
+			ComponentBatchUpdateFunc fixedUpdate = nullptr)
+		{
+			const UINT32 rttiId = T::getRTTIStatic()->getRTTIId();
+			setComponentTypeUpdate(rttiId, priority, std::move(update), std::move(fixedUpdate));
+		}
+
+		/**
+		 * Instantiates a prefab over multiple frames, in order to avoid a long stall when instantiating large prefabs.
+		 * The prefab hierarchy is cloned during the first frame the prefab is processed, after which its scene objects
+		 * are instantiated one at a time, parents first, until the per-frame budget set by setInstantiationBudget()
+		 * runs out. Unlike Prefab::instantiate(), components of a scene object are initialized as soon as the scene
+		 * object is instantiated, before any of its children are.
+		 *
+		 * Prefabs are processed in the order they were queued in. The prefab doesn't need to be loaded when queued, in
+		 * which case its processing starts once it finishes loading, without holding up the prefabs queued after it.
+		 *
+		 * @param[in]	prefab		Prefab to instantiate.
+		 * @param[in]	onComplete	Callback triggered with the root of the instantiated hierarchy once all of its
+		 *							scene objects have been instantiated. Not triggered if the hierarchy is destroyed
+		 *							before that. Triggered with an empty handle if the prefab is empty.
+		 * @param[in]	parent		Scene object to parent the instantiated hierarchy to. If not provided the
+		 *							hierarchy is instantiated at the scene root.
+		 */
+		void instantiateAsync(const HPrefab& prefab, std::function<void(const HSceneObject&)> onComplete = nullptr,
+			const HSceneObject& parent = HSceneObject());
+
+		/** 
+		 * Maximum amount of time to spend on prefabs queued with instantiateAsync() during a single frame, in
+		 * milliseconds. At least one scene object is instantiated per frame, even if it exceeds the budget.
+		 */
+		void setInstantiationBudget(float budget) { mInstantiationBudget = budget; }
+
+		/** Returns the number of prefabs queued with instantiateAsync() that haven't yet been fully instantiated. */
+		UINT32 getNumPendingInstantiations() const { return (UINT32)mPendingInstantiations.size(); }
+
 		/** Returns all cameras in the scene. */
 		const UnorderedMap<Camera*, SPtr<Camera>>& getAllCameras() const { return mCameras; }
 
@@ -123,6 +185,15 @@ namespace bs
 		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
 		void _updateCoreObjectTransforms();
 
+		/** 
+		 * Notifies the manager that the transform of a scene object changed, while the object's parent transform is
+		 * up to date. The object's hierarchy will have its world transforms updated in the next call to
+		 * _updateCoreObjectTransforms().
+		 *
+		 * @note	Thread safe during parallel component updates.
+		 */
+		void _notifyTransformDirty(const HSceneObject& so);
+
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
 		void _notifyComponentCreated(const HComponent& component, bool parentActive);
 
@@ -141,6 +212,18 @@ namespace bs
 		/** Notifies the manager that a component is about to be destroyed. The manager triggers necessary callbacks. */
 		void _notifyComponentDestroyed(const HComponent& component, bool immediate);
 
+		/**
+		 * Queues a structural change of the scene requested during a parallel component update, to be executed once
+		 * all updates finish. 
+		 *
+		 * @param[in]	change	Callback performing the change.
+		 * @return				True if the change was queued. False if no parallel update is in progress, in which case
+		 *						the caller should perform the change right away.
+		 *
+		 * @note	Thread safe.
+		 */
+		bool _deferStructuralChange(std::function<void()> change);
+
 	protected:
 		/** Types of events that represent component state changes relevant to the scene manager. */
 		enum class ComponentStateEventType
@@ -148,6 +231,16 @@ namespace bs
 			Created, Activated, Deactivated, Destroyed
 		};
 
+		/** Prefab queued for instantiation through instantiateAsync(). */
+		struct PendingInstantiation
+		{
+			HPrefab prefab;
+			HSceneObject parent;
+			HSceneObject root;
+			Vector<HSceneObject> todo;
+			std::function<void(const HSceneObject&)> onComplete;
+		};
+
 		/** Describes a single component state change. */
 		struct ComponentStateChange
 		{
@@ -159,6 +252,18 @@ namespace bs
 			ComponentStateEventType type;
 		};
 
+		/** Active components of a single type, along with information on how to update them. */
+		struct ComponentUpdateGroup
+		{
+			UINT32 rttiId = 0;
+			INT32 priority = 0;
+			String name;
+			ComponentBatchUpdateFunc update;
+			ComponentBatchUpdateFunc fixedUpdate;
+			Vector<Component*> components;
+			UINT32 numSerial = 0; /**< Number of components without the ComponentFlag::ParallelUpdate flag. */
+		};
+
 		friend class SceneObject;
 
 		/**
@@ -189,6 +294,37 @@ namespace bs
 		/** Iterates over components that had their state modified and moves them to the appropriate state lists. */
 		void processStateChanges();
 
+		/** Returns the update group for components of the specified type, creating one if it doesn't exist. */
+		ComponentUpdateGroup& getUpdateGroup(UINT32 rttiId, const String& name);
+
+		/** Adds a component to the update group for its type. */
+		void addToUpdateGroup(Component* component);
+
+		/** Removes a component from the update group for its type. */
+		void removeFromUpdateGroup(Component* component);
+
+		/** Sorts update groups by priority, and rebuilds the lookup from RTTI ids to groups. */
+		void sortUpdateGroups();
+
+		/** 
+		 * Triggers update() or fixedUpdate() callbacks on all components in the group, in parallel if all components
+		 * in the group allow it.
+		 */
+		void updateGroup(ComponentUpdateGroup& group, bool fixed);
+
+		/** Instantiates prefabs queued with instantiateAsync(), until the instantiation budget runs out. */
+		void processPendingInstantiations();
+
+		/** Executes structural changes deferred by parallel component updates. */
+		void applyDeferredChanges();
+
+		/** 
+		 * Updates world transforms of all hierarchies reported through _notifyTransformDirty(). Each hierarchy is 
+		 * traversed breadth first so parents are always up to date when their children are updated, with no recursive
+		 * parent walks.
+		 */
+		void updateDirtyTransforms();
+
 		/** 
 		 * Encodes an index and a type into a single 32-bit integer. Top 2 bits represent the type, while the rest represent
 		 * the index.
@@ -204,7 +340,10 @@ namespace bs
 	protected:
 		HSceneObject mRootNode;
 
-		UnorderedMap<SceneActor*, BoundActorData> mBoundActors;
+		Vector<BoundActorData> mBoundActors;
+		UnorderedMap<SceneActor*, UINT32> mBoundActorLookup;
+		Vector<HSceneObject> mDirtyTransformRoots;
+		Mutex mDirtyTransformsMutex;
 		UnorderedMap<Camera*, SPtr<Camera>> mCameras;
 		Vector<SPtr<Camera>> mMainCameras;
 
@@ -215,12 +354,23 @@ namespace bs
 		std::array<Vector<HComponent>*, 3> mComponentsPerState = 
 			{ { &mActiveComponents, &mInactiveComponents, &mUninitializedComponents } };
 
+		Vector<ComponentUpdateGroup> mUpdateGroups;
+		UnorderedMap<UINT32, UINT32> mUpdateGroupLookup;
+
+		bool mParallelUpdateActive = false;
+		Vector<std::function<void()>> mDeferredChanges;
+		Mutex mDeferredChangesMutex;
+
 		SPtr<RenderTarget> mMainRT;
 		HEvent mMainRTResizedConn;
 
 		ComponentState mComponentState = ComponentState::Running;
 		bool mDisableStateChange = false;
 		Vector<ComponentStateChange> mStateChanges;
+
+		List<PendingInstantiation> mPendingInstantiations;
+		float mInstantiationBudget = 2.0f;
+		Timer mInstantiationTimer;
 	};
 
 	/**	Provides easy access to the SceneManager. */
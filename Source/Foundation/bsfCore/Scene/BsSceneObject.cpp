@@ -43,8 +43,9 @@ namespace bs
 
 	HSceneObject SceneObject::createInternal(const String& name, UINT32 flags)
 	{
-		SPtr<SceneObject> sceneObjectPtr = SPtr<SceneObject>(new (bs_alloc<SceneObject>()) SceneObject(name, flags),
-			&bs_delete<SceneObject>, StdAlloc<SceneObject>());
+		SceneObject* rawPtr = new (bs_std_pool_alloc<SceneObject, POOL_ELEMS_PER_BLOCK>()) SceneObject(name, flags);
+		SPtr<SceneObject> sceneObjectPtr = SPtr<SceneObject>(rawPtr, 
+			&bs_std_pool_delete<SceneObject, POOL_ELEMS_PER_BLOCK>, StdPoolAlloc<SceneObject, POOL_ELEMS_PER_BLOCK>());
 
 		HSceneObject sceneObject = static_object_cast<SceneObject>(
 			GameObjectManager::instance().registerObject(sceneObjectPtr));
@@ -64,6 +65,16 @@ namespace bs
 
 	void SceneObject::destroy(bool immediate)
 	{
+		// Scene structure cannot change while components are being updated in parallel
+		const auto deferredDestroy = [handle = mThisHandle, immediate]()
+		{
+			if (!handle.isDestroyed())
+				handle->destroy(immediate);
+		};
+
+		if (SceneManager::isStarted() && gSceneManager()._deferStructuralChange(deferredDestroy))
+			return;
+
 		// Parent is our owner, so when his reference to us is removed, delete might be called.
 		// So make sure this is the last thing we do.
 		if(mParent != nullptr)
@@ -195,7 +206,7 @@ namespace bs
 			child->_unsetFlags(flags);
 	}
 
-	void SceneObject::_instantiate(bool prefabOnly)
+	void SceneObject::_instantiate(bool prefabOnly, bool children)
 	{
 		std::function<void(SceneObject*)> instantiateRecursive = [&](SceneObject* obj)
 		{
@@ -207,6 +218,9 @@ namespace bs
 			for (auto& component : obj->mComponents)
 				component->_instantiate();
 
+			if (!children && obj == this)
+				return;
+
 			for (auto& child : obj->mChildren)
 			{
 				if(!prefabOnly || child->mPrefabLinkUUID.empty())
@@ -219,6 +233,9 @@ namespace bs
 			for (auto& component : obj->mComponents)
 				gSceneManager()._notifyComponentCreated(component, obj->getActive());
 
+			if (!children && obj == this)
+				return;
+
 			for (auto& child : obj->mChildren)
 			{
 				if (!prefabOnly || child->mPrefabLinkUUID.empty())
@@ -287,6 +304,26 @@ namespace bs
 		notifyTransformChanged(TCF_Transform);
 	}
 
+	void SceneObject::setWorldPositionAndRotation(const Vector3& position, const Quaternion& rotation)
+	{
+		if (mMobility != ObjectMobility::Movable)
+			return;
+
+		if (mParent != nullptr)
+		{
+			const Transform& parentTfrm = mParent->getTransform();
+			mLocalTfrm.setWorldPosition(position, parentTfrm);
+			mLocalTfrm.setWorldRotation(rotation, parentTfrm);
+		}
+		else
+		{
+			mLocalTfrm.setPosition(position);
+			mLocalTfrm.setRotation(rotation);
+		}
+
+		notifyTransformChanged(TCF_Transform);
+	}
+
 	void SceneObject::setWorldScale(const Vector3& scale)
 	{
 		if (mMobility != ObjectMobility::Movable)
@@ -433,6 +470,14 @@ namespace bs
 			componentFlags = (TransformChangedFlags)(componentFlags & ~TCF_Transform);
 		else
 		{
+			// Report roots of dirty hierarchies, so their world transforms can be updated in a single pass. Objects
+			// with a dirty parent belong to a hierarchy that was already reported.
+			const bool isRoot = isCachedWorldTfrmUpToDate() && (mParent == nullptr || mParent.isDestroyed() ||
+				mParent->isCachedWorldTfrmUpToDate());
+
+			if (isRoot && isInstantiated() && SceneManager::isStarted())
+				gSceneManager()._notifyTransformDirty(mThisHandle);
+
 			mDirtyFlags |= DirtyFlags::LocalTfrmDirty | DirtyFlags::WorldTfrmDirty;
 			mDirtyHash++;
 		}
@@ -494,6 +539,16 @@ namespace bs
 		if (parent.isDestroyed())
 			return;
 
+		// Scene structure cannot change while components are being updated in parallel
+		const auto deferredSetParent = [handle = mThisHandle, parent, keepWorldTransform]()
+		{
+			if (!handle.isDestroyed())
+				handle->setParent(parent, keepWorldTransform);
+		};
+
+		if (SceneManager::isStarted() && gSceneManager()._deferStructuralChange(deferredSetParent))
+			return;
+
 #if BS_IS_BANSHEE3D
 		UUID originalPrefab = getPrefabLink();
 #endif
@@ -734,7 +789,7 @@ namespace bs
 		else
 			_unsetFlags(SOF_DontInstantiate);
 
-		UINT32 bufferSize = 0;
+		UINT64 bufferSize = 0;
 
 		MemorySerializer serializer;
 		UINT8* buffer = serializer.encode(this, bufferSize, (void*(*)(size_t))&bs_alloc);
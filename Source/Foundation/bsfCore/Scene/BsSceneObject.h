@@ -52,6 +52,12 @@ namespace bs
 		friend class PrefabDiff;
 		friend class PrefabUtility;
 	public:
+		/** 
+		 * Number of objects allocated at once by the pool of a single scene object or component type. Scene objects
+		 * and components created through create() and addComponent() are allocated from pools of their type.
+		 */
+		static constexpr int POOL_ELEMS_PER_BLOCK = 64;
+
 		~SceneObject();
 
 		/**
@@ -109,8 +115,11 @@ namespace bs
 		 *
 		 * @param[in]	prefabOnly	If true, only objects within the current prefab will be instantiated. If false all child
 		 *							objects and components will.
+		 * @param[in]	children	If false only this object will be instantiated, and the children need to be
+		 *							instantiated separately by calling this method on each of them. This allows
+		 *							instantiation of large hierarchies to be spread over multiple frames.
 		 */
-		void _instantiate(bool prefabOnly = false);
+		void _instantiate(bool prefabOnly = false, bool children = true);
 
 		/**
 		 * Clears the internally stored prefab diff. If this object is updated from prefab its instance specific changes 
@@ -211,6 +220,12 @@ namespace bs
 		/**	Sets the world rotation of the object. */
 		void setWorldRotation(const Quaternion& rotation);
 
+		/**
+		 * Sets both the world position and rotation of the object. Cheaper than setting them separately, since the
+		 * object and its children only get notified of the transform change once.
+		 */
+		void setWorldPositionAndRotation(const Vector3& position, const Quaternion& rotation);
+
 		/**	Sets the local scale of the object. */
 		void setScale(const Vector3& scale);
 
@@ -481,9 +496,9 @@ namespace bs
 			static_assert((std::is_base_of<bs::Component, T>::value),
 				"Specified type is not a valid Component.");
 
-			SPtr<T> gameObject(new (bs_alloc<T>()) T(mThisHandle,
+			SPtr<T> gameObject(new (bs_std_pool_alloc<T, POOL_ELEMS_PER_BLOCK>()) T(mThisHandle,
 				std::forward<Args>(args)...),
-				&bs_delete<T>, StdAlloc<T>());
+				&bs_std_pool_delete<T, POOL_ELEMS_PER_BLOCK>, StdPoolAlloc<T, POOL_ELEMS_PER_BLOCK>());
 
 			const HComponent newComponent =
 				static_object_cast<Component>(GameObjectManager::instance().registerObject(gameObject));
@@ -609,8 +624,9 @@ namespace bs
 		{
 			static_assert((std::is_base_of<bs::Component, T>::value), "Specified type is not a valid Component.");
 
-			T* rawPtr = new (bs_alloc<T>()) T();
-			SPtr<T> gameObject(rawPtr, &bs_delete<T>, StdAlloc<T>());
+			T* rawPtr = new (bs_std_pool_alloc<T, POOL_ELEMS_PER_BLOCK>()) T();
+			SPtr<T> gameObject(rawPtr, &bs_std_pool_delete<T, POOL_ELEMS_PER_BLOCK>,
+				StdPoolAlloc<T, POOL_ELEMS_PER_BLOCK>());
 
 			return gameObject;
 		}
@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsSceneObjectPool.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsPrefab.h"
+
+namespace bs
+{
+	SceneObjectPool::SceneObjectPool(std::function<HSceneObject()> create, UINT32 maxPooled)
+		:mCreate(std::move(create)), mMaxPooled(maxPooled)
+	{ }
+
+	SceneObjectPool::SceneObjectPool(const HPrefab& prefab, UINT32 maxPooled)
+		:mMaxPooled(maxPooled)
+	{
+		mCreate = [prefab]()
+		{
+			if (!prefab.isLoaded())
+				return HSceneObject();
+
+			return prefab->instantiate();
+		};
+	}
+
+	SceneObjectPool::~SceneObjectPool()
+	{
+		clear();
+	}
+
+	HSceneObject SceneObjectPool::acquire()
+	{
+		while (!mPooled.empty())
+		{
+			HSceneObject so = mPooled.back();
+			mPooled.pop_back();
+
+			// Could have been destroyed externally while in the pool, e.g. when the scene was cleared
+			if (so.isDestroyed(true))
+				continue;
+
+			so->setActive(true);
+			return so;
+		}
+
+		return mCreate();
+	}
+
+	void SceneObjectPool::release(const HSceneObject& so)
+	{
+		if (so.isDestroyed(true))
+			return;
+
+		if ((UINT32)mPooled.size() >= mMaxPooled)
+		{
+			so->destroy();
+			return;
+		}
+
+		so->setActive(false);
+		mPooled.push_back(so);
+	}
+
+	void SceneObjectPool::reserve(UINT32 count)
+	{
+		count = std::min(count, mMaxPooled);
+		while ((UINT32)mPooled.size() < count)
+		{
+			HSceneObject so = mCreate();
+			if (so.isDestroyed())
+				break;
+
+			so->setActive(false);
+			mPooled.push_back(so);
+		}
+	}
+
+	void SceneObjectPool::clear()
+	{
+		for (auto& entry : mPooled)
+		{
+			if (!entry.isDestroyed(true))
+				entry->destroy();
+		}
+
+		mPooled.clear();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Scene
+	 *  @{
+	 */
+
+	/**
+	 * Recycles scene object hierarchies that are frequently created and destroyed, such as projectiles or effects.
+	 * Instead of being destroyed, released hierarchies are deactivated and kept around, and are re-activated when
+	 * the next hierarchy is requested.
+	 */
+	class BS_CORE_EXPORT SceneObjectPool
+	{
+	public:
+		/**
+		 * Creates a new pool that creates its scene objects using the provided callback.
+		 *
+		 * @param[in]	create		Callback that creates a new scene object hierarchy, called when the pool has no
+		 *							released hierarchies to reuse.
+		 * @param[in]	maxPooled	Maximum number of released hierarchies kept for reuse. Hierarchies released while
+		 *							the pool is full get destroyed.
+		 */
+		SceneObjectPool(std::function<HSceneObject()> create, UINT32 maxPooled = 256);
+
+		/** Creates a new pool that instantiates the provided prefab. */
+		SceneObjectPool(const HPrefab& prefab, UINT32 maxPooled = 256);
+
+		/** Destroys all hierarchies currently kept in the pool. Hierarchies acquired from the pool are not affected. */
+		~SceneObjectPool();
+
+		/**
+		 * Returns an active scene object hierarchy, reusing a released one if available, or creating a new one
+		 * otherwise. Reused hierarchies keep any state they had when released, except for being activated.
+		 */
+		HSceneObject acquire();
+
+		/**
+		 * Returns the hierarchy to the pool. The scene object is deactivated and must not be used until it is acquired
+		 * again.
+		 */
+		void release(const HSceneObject& so);
+
+		/** Populates the pool with new hierarchies, until it contains at least @p count of them. */
+		void reserve(UINT32 count);
+
+		/** Destroys all hierarchies currently kept in the pool. */
+		void clear();
+
+		/** Returns the number of released hierarchies currently kept in the pool. */
+		UINT32 getNumPooled() const { return (UINT32)mPooled.size(); }
+
+	private:
+		std::function<HSceneObject()> mCreate;
+		Vector<HSceneObject> mPooled;
+		UINT32 mMaxPooled;
+	};
+
+	/** @} */
+}
\ No newline at end of file
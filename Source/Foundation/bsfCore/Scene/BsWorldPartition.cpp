@@ -0,0 +1,248 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsWorldPartition.h"
+#include "Scene/BsPrefab.h"
+#include "Scene/BsSceneObject.h"
+#include "Resources/BsResources.h"
+
+namespace bs
+{
+	WorldPartition::WorldPartition(const WORLD_PARTITION_DESC& desc)
+		:mDesc(desc)
+	{
+		mDesc.unloadDistance = std::max(mDesc.unloadDistance, mDesc.loadDistance);
+	}
+
+	WorldPartition::~WorldPartition()
+	{
+		clearSectors();
+	}
+
+	UINT32 WorldPartition::addSector(const WeakResourceHandle<Prefab>& prefab, const AABox& bounds)
+	{
+		Sector sector;
+		sector.prefab = prefab;
+		sector.bounds = bounds;
+
+		mSectors.push_back(sector);
+		return (UINT32)mSectors.size() - 1;
+	}
+
+	void WorldPartition::clearSectors()
+	{
+		for (auto& entry : mSectors)
+			unload(entry);
+
+		mSectors.clear();
+	}
+
+	void WorldPartition::addSource(const HSceneObject& source)
+	{
+		auto iterFind = std::find(mSources.begin(), mSources.end(), source);
+		if (iterFind == mSources.end())
+			mSources.push_back(source);
+	}
+
+	void WorldPartition::removeSource(const HSceneObject& source)
+	{
+		auto iterFind = std::find(mSources.begin(), mSources.end(), source);
+		if (iterFind != mSources.end())
+			mSources.erase(iterFind);
+	}
+
+	void WorldPartition::update()
+	{
+		const UINT64 deadline = mTimer.getMicroseconds() + (UINT64)(mDesc.timeBudget * 1000.0f);
+
+		mSources.erase(std::remove_if(mSources.begin(), mSources.end(),
+			[](const HSceneObject& source) { return source.isDestroyed(); }), mSources.end());
+
+		Vector<Vector3> sourcePositions;
+		sourcePositions.reserve(mSources.size());
+
+		for (auto& entry : mSources)
+			sourcePositions.push_back(entry->getTransform().getPosition());
+
+		// Distance and index of sectors whose contents are waiting to be instantiated
+		Vector<std::pair<float, UINT32>> toInstantiate;
+		for (UINT32 i = 0; i < (UINT32)mSectors.size(); i++)
+		{
+			Sector& sector = mSectors[i];
+			const float distance = getDistance(sector, sourcePositions);
+
+			if (sector.state == SectorState::Unloaded)
+			{
+				if (distance < mDesc.loadDistance)
+					load(sector, distance);
+
+				continue;
+			}
+
+			if (distance > mDesc.unloadDistance)
+			{
+				unload(sector);
+				continue;
+			}
+
+			if (sector.state == SectorState::Loading)
+			{
+				if (sector.loadedPrefab.isLoaded())
+					sector.state = SectorState::Instantiating;
+				else
+				{
+					RESOURCE_LOAD_PRIORITY priority;
+					priority.priority = -distance;
+
+					gResources().setLoadPriority(sector.loadedPrefab, priority);
+				}
+			}
+
+			if (sector.state == SectorState::Instantiating)
+				toInstantiate.push_back(std::make_pair(distance, i));
+		}
+
+		// Closest sectors are instantiated first
+		std::sort(toInstantiate.begin(), toInstantiate.end());
+
+		bool first = true;
+		for (auto& entry : toInstantiate)
+		{
+			if (!first && mTimer.getMicroseconds() >= deadline)
+				break;
+
+			first = false;
+
+			Sector& sector = mSectors[entry.second];
+			if (sector.root == nullptr)
+			{
+				beginInstantiate(sector);
+
+				if (sector.root == nullptr)
+				{
+					sector.state = SectorState::Loaded;
+					continue;
+				}
+
+				if (mTimer.getMicroseconds() >= deadline)
+					break;
+			}
+
+			if (instantiatePending(sector, deadline))
+				sector.state = SectorState::Loaded;
+		}
+	}
+
+	HSceneObject WorldPartition::getSectorRoot(UINT32 idx) const
+	{
+		if (idx >= (UINT32)mSectors.size())
+			return HSceneObject();
+
+		return mSectors[idx].root;
+	}
+
+	bool WorldPartition::isSectorLoaded(UINT32 idx) const
+	{
+		if (idx >= (UINT32)mSectors.size())
+			return false;
+
+		return mSectors[idx].state == SectorState::Loaded;
+	}
+
+	UINT32 WorldPartition::getNumPending() const
+	{
+		UINT32 numPending = 0;
+		for (auto& entry : mSectors)
+		{
+			if (entry.state == SectorState::Loading || entry.state == SectorState::Instantiating)
+				numPending++;
+		}
+
+		return numPending;
+	}
+
+	float WorldPartition::getDistance(const Sector& sector, const Vector<Vector3>& sourcePositions) const
+	{
+		float distance = std::numeric_limits<float>::max();
+		for (auto& entry : sourcePositions)
+		{
+			const Vector3 closest = Vector3::max(sector.bounds.getMin(), Vector3::min(entry, sector.bounds.getMax()));
+			distance = std::min(distance, entry.distance(closest));
+		}
+
+		return distance;
+	}
+
+	void WorldPartition::load(Sector& sector, float distance)
+	{
+		RESOURCE_LOAD_PRIORITY priority;
+		priority.priority = -distance;
+
+		// No internal reference is kept, so the prefab and its dependencies get unloaded once the sector is destroyed
+		sector.loadedPrefab = static_resource_cast<Prefab>(gResources().loadFromUUID(sector.prefab.getUUID(), true,
+			ResourceLoadFlag::LoadDependencies, priority));
+
+		if (sector.loadedPrefab == nullptr)
+		{
+			LOGWRN("Cannot load world sector, prefab with UUID " + sector.prefab.getUUID().toString() +
+				" cannot be found.");
+
+			// Treat the sector as loaded, so the load isn't retried every update
+			sector.state = SectorState::Loaded;
+			return;
+		}
+
+		sector.state = SectorState::Loading;
+	}
+
+	void WorldPartition::unload(Sector& sector)
+	{
+		if (sector.state == SectorState::Loading)
+			gResources().cancelLoad(sector.loadedPrefab);
+
+		if (sector.root != nullptr && !sector.root.isDestroyed())
+			sector.root->destroy();
+
+		sector.state = SectorState::Unloaded;
+		sector.loadedPrefab = nullptr;
+		sector.root = nullptr;
+		sector.pendingChildren.clear();
+	}
+
+	void WorldPartition::beginInstantiate(Sector& sector)
+	{
+		sector.root = sector.loadedPrefab->_clone();
+
+		// Instance doesn't reference the prefab, so it can be unloaded while the sector remains loaded
+		sector.loadedPrefab = nullptr;
+
+		if (sector.root == nullptr)
+			return;
+
+		if (mParent != nullptr && !mParent.isDestroyed())
+			sector.root->setParent(mParent);
+
+		// Queued in reverse, so children are instantiated in their original order
+		const UINT32 numChildren = sector.root->getNumChildren();
+		for (UINT32 i = numChildren; i > 0; i--)
+			sector.pendingChildren.push_back(sector.root->getChild(i - 1));
+
+		sector.root->_instantiate(false, false);
+	}
+
+	bool WorldPartition::instantiatePending(Sector& sector, UINT64 deadline)
+	{
+		while (!sector.pendingChildren.empty())
+		{
+			HSceneObject child = sector.pendingChildren.back();
+			sector.pendingChildren.pop_back();
+
+			if (!child.isDestroyed())
+				child->_instantiate();
+
+			if (mTimer.getMicroseconds() >= deadline)
+				break;
+		}
+
+		return sector.pendingChildren.empty();
+	}
+}
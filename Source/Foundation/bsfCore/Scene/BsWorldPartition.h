@@ -0,0 +1,143 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Math/BsAABox.h"
+#include "Resources/BsResourceHandle.h"
+#include "Utility/BsTimer.h"
+
+namespace bs
+{
+	/** @addtogroup Scene
+	 *  @{
+	 */
+
+	/** Options controlling how are sectors streamed in and out by WorldPartition. */
+	struct WORLD_PARTITION_DESC
+	{
+		/** Sectors closer than this distance to any of the streaming sources start loading. */
+		float loadDistance = 200.0f;
+
+		/**
+		 * Sectors further than this distance from all of the streaming sources get unloaded. Should be larger than
+		 * the load distance, so sectors near the boundary don't keep getting loaded and unloaded as the source moves.
+		 */
+		float unloadDistance = 250.0f;
+
+		/**
+		 * Maximum amount of time to spend instantiating sector contents during a single update(), in milliseconds.
+		 * At least one scene object hierarchy is instantiated per update, even if it exceeds the budget.
+		 */
+		float timeBudget = 2.0f;
+	};
+
+	/**
+	 * Streams a large world in and out of the scene, so it can be traversed without load screens. The world is split
+	 * into sectors, each stored as a prefab along with its bounds in world space. Sectors near streaming sources (e.g.
+	 * the player or the camera) are loaded asynchronously, closest sectors first, and their contents are instantiated
+	 * across multiple frames within a time budget. Sectors that move out of range of all sources are destroyed, and
+	 * their resources released.
+	 *
+	 * Sector contents are instantiated one child of the prefab root at a time, so prefabs should split their contents
+	 * into multiple child hierarchies of roughly equal size. Contents keep their world transforms when parented to
+	 * the scene object provided to setParent().
+	 */
+	class BS_CORE_EXPORT WorldPartition
+	{
+	public:
+		WorldPartition(const WORLD_PARTITION_DESC& desc = WORLD_PARTITION_DESC());
+		~WorldPartition();
+
+		/**
+		 * Registers a new sector.
+		 *
+		 * @param[in]	prefab		Prefab containing the sector contents. It doesn't need to be loaded, and must be
+		 *							loadable by its UUID through Resources::loadFromUUID().
+		 * @param[in]	bounds		Bounds of the sector contents, in world space.
+		 * @return					Index of the sector, that can be used for querying its state.
+		 */
+		UINT32 addSector(const WeakResourceHandle<Prefab>& prefab, const AABox& bounds);
+
+		/** Removes all sectors, destroying the contents of any loaded ones. */
+		void clearSectors();
+
+		/** Registers a scene object whose position determines which sectors get loaded. */
+		void addSource(const HSceneObject& source);
+
+		/** Unregisters a streaming source registered through addSource(). */
+		void removeSource(const HSceneObject& source);
+
+		/**
+		 * Scene object to parent the sector contents to. If not provided, sector contents are instantiated at the
+		 * scene root.
+		 */
+		void setParent(const HSceneObject& parent) { mParent = parent; }
+
+		/**
+		 * Starts and stops sector loads depending on the streaming source positions, and instantiates the contents
+		 * of loaded sectors. Should be called once per frame.
+		 */
+		void update();
+
+		/** Returns the scene object containing the sector contents, or an empty handle if it isn't loaded yet. */
+		HSceneObject getSectorRoot(UINT32 idx) const;
+
+		/** Checks if the sector contents have been fully instantiated. */
+		bool isSectorLoaded(UINT32 idx) const;
+
+		/** Returns the number of sectors that have started loading but aren't fully instantiated yet. */
+		UINT32 getNumPending() const;
+
+	private:
+		/** Loading stage a sector is in. */
+		enum class SectorState
+		{
+			Unloaded,
+			Loading,
+			Instantiating,
+			Loaded
+		};
+
+		/** Information about a single sector. */
+		struct Sector
+		{
+			WeakResourceHandle<Prefab> prefab;
+			AABox bounds;
+
+			SectorState state = SectorState::Unloaded;
+			HPrefab loadedPrefab;
+			HSceneObject root;
+			Vector<HSceneObject> pendingChildren;
+		};
+
+		/** Returns the distance between the sector bounds and the closest streaming source. */
+		float getDistance(const Sector& sector, const Vector<Vector3>& sourcePositions) const;
+
+		/** Starts loading the sector prefab. */
+		void load(Sector& sector, float distance);
+
+		/** Destroys the sector contents and releases the sector prefab. */
+		void unload(Sector& sector);
+
+		/**
+		 * Creates the sector contents from its loaded prefab. Only the prefab root is instantiated, while its children
+		 * are queued for instantiation by instantiatePending().
+		 */
+		void beginInstantiate(Sector& sector);
+
+		/**
+		 * Instantiates the queued sector children, until the timer reaches @p deadline, in microseconds. At least one
+		 * child is instantiated. Returns true if all children have been instantiated.
+		 */
+		bool instantiatePending(Sector& sector, UINT64 deadline);
+
+		WORLD_PARTITION_DESC mDesc;
+		Vector<Sector> mSectors;
+		Vector<HSceneObject> mSources;
+		HSceneObject mParent;
+		Timer mTimer;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,295 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Text/BsDynamicFontAtlas.h"
+#include "Text/BsFont.h"
+#include "Text/BsFontManager.h"
+#include "Image/BsTexture.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Utility/BsTime.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	DynamicFontAtlas::DynamicFontAtlas(const SPtr<FontFace>& face, FontBitmap& bitmap, UINT32 pageSize,
+		UINT32 maxPages)
+		: mFace(face), mBitmap(bitmap), mPageSize(pageSize), mMaxPages(std::max(maxPages, 1U))
+	{
+		// Pages are only ever appended, so reserving up front ensures readers never see the page list reallocate
+		mBitmap.texturePages.reserve(mMaxPages);
+
+		// Text layout treats a bitmap without pages as empty
+		addPage();
+		addMissingGlyph();
+
+		// Only the atlas' own copy is returned during text layout, this one is for completeness
+		mBitmap.missingGlyph = *mMissingGlyph;
+
+		FontManager::instance()._registerAtlas(this);
+	}
+
+	DynamicFontAtlas::~DynamicFontAtlas()
+	{
+		if(FontManager::isStarted())
+			FontManager::instance()._unregisterAtlas(this);
+	}
+
+	const CharDesc& DynamicFontAtlas::getCharDesc(UINT32 charId)
+	{
+		Lock lock(mMutex);
+
+		auto iterFind = mChars.find(charId);
+		if(iterFind != mChars.end() && iterFind->second.resident)
+		{
+			markUsed(*iterFind->second.desc);
+			return *iterFind->second.desc;
+		}
+
+		if(mMissingChars.find(charId) != mMissingChars.end())
+			return getMissingGlyph();
+
+		// Other threads might be reading the descriptor of an evicted character, so it's never reused
+		CharDesc desc;
+		Vector<UINT8> pixels;
+		if(!mFace->renderChar(charId, mBitmap.size, desc, pixels))
+		{
+			mMissingChars.insert(charId);
+			return getMissingGlyph();
+		}
+
+		desc.charId = charId;
+		if(!place(desc, pixels))
+		{
+			if(!mWarnedFull)
+			{
+				LOGWRN("Dynamic font atlas is full, characters will be rendered as missing. Increase the page size or "
+					"the maximum number of pages of the font.");
+				mWarnedFull = true;
+			}
+
+			return getMissingGlyph();
+		}
+
+		mDescs.push_back(std::move(desc));
+		const CharDesc& output = mDescs.back();
+
+		CachedChar& entry = mChars[charId];
+		entry.desc = &output;
+		entry.resident = true;
+
+		if(output.width > 0 && output.height > 0)
+			mPages[output.page].charIds.push_back(charId);
+
+		markUsed(output);
+		return output;
+	}
+
+	INT32 DynamicFontAtlas::getKerning(UINT32 charId, UINT32 nextCharId)
+	{
+		if(!mFace->hasKerning())
+			return 0;
+
+		const UINT64 key = ((UINT64)charId << 32) | nextCharId;
+
+		Lock lock(mMutex);
+
+		auto iterFind = mKerning.find(key);
+		if(iterFind != mKerning.end())
+			return iterFind->second;
+
+		const INT32 kerning = mFace->getKerning(charId, nextCharId, mBitmap.size);
+		mKerning[key] = kerning;
+
+		return kerning;
+	}
+
+	void DynamicFontAtlas::_flush()
+	{
+		Lock lock(mMutex);
+
+		for(auto& page : mPages)
+		{
+			if(!page.dirty)
+				continue;
+
+			// The CPU copy keeps changing as characters get added, so the upload gets a snapshot of it
+			SPtr<PixelData> pixelData = bs_shared_ptr_new<PixelData>(mPageSize, mPageSize, 1, PF_RG8);
+			pixelData->allocateInternalBuffer();
+			memcpy(pixelData->getData(), page.pixels.data(), page.pixels.size());
+
+			// It's possible the formats no longer match
+			const TextureProperties& texProps = page.texture->getProperties();
+			if (texProps.getFormat() != pixelData->getFormat())
+			{
+				SPtr<PixelData> temp = texProps.allocBuffer(0, 0);
+				PixelUtil::bulkPixelConversion(*pixelData, *temp);
+
+				page.texture->writeData(temp);
+			}
+			else
+				page.texture->writeData(pixelData);
+
+			page.dirty = false;
+		}
+	}
+
+	bool DynamicFontAtlas::place(CharDesc& desc, const Vector<UINT8>& pixels)
+	{
+		desc.page = 0;
+		desc.uvX = desc.uvY = desc.uvWidth = desc.uvHeight = 0.0f;
+
+		// Characters without any visible pixels, like whitespace, need no space in the atlas
+		if(desc.width == 0 || desc.height == 0)
+			return true;
+
+		UINT32 pageIdx, x, y;
+		if(!allocate(desc.width + PADDING, desc.height + PADDING, pageIdx, x, y))
+			return false;
+
+		Page& page = mPages[pageIdx];
+		for(UINT32 row = 0; row < desc.height; row++)
+		{
+			const UINT8* src = &pixels[row * desc.width];
+			UINT8* dst = &page.pixels[((y + row) * mPageSize + x) * 2];
+
+			for(UINT32 column = 0; column < desc.width; column++)
+			{
+				dst[column * 2 + 0] = src[column];
+				dst[column * 2 + 1] = src[column];
+			}
+		}
+
+		page.dirty = true;
+
+		const float invPageSize = 1.0f / mPageSize;
+		desc.page = pageIdx;
+		desc.uvX = x * invPageSize;
+		desc.uvY = y * invPageSize;
+		desc.uvWidth = desc.width * invPageSize;
+		desc.uvHeight = desc.height * invPageSize;
+
+		return true;
+	}
+
+	bool DynamicFontAtlas::allocate(UINT32 width, UINT32 height, UINT32& page, UINT32& x, UINT32& y)
+	{
+		if(width > mPageSize || height > mPageSize)
+			return false;
+
+		for(UINT32 i = 0; i < (UINT32)mPages.size(); i++)
+		{
+			if(mPages[i].layout.addElement(width, height, x, y))
+			{
+				page = i;
+				return true;
+			}
+		}
+
+		if((UINT32)mPages.size() < mMaxPages)
+		{
+			addPage();
+
+			page = (UINT32)mPages.size() - 1;
+			return mPages[page].layout.addElement(width, height, x, y);
+		}
+
+		// Text laid out during the current frame might reference any page used during it, so only older pages can be
+		// evicted
+		const UINT64 frameIdx = gTime().getFrameIdx();
+
+		UINT32 lruPage = (UINT32)-1;
+		UINT64 lruFrame = frameIdx;
+		for(UINT32 i = 0; i < (UINT32)mPages.size(); i++)
+		{
+			if(mPages[i].lastUsedFrame < lruFrame)
+			{
+				lruFrame = mPages[i].lastUsedFrame;
+				lruPage = i;
+			}
+		}
+
+		if(lruPage == (UINT32)-1)
+			return false;
+
+		evict(lruPage);
+
+		page = lruPage;
+		return mPages[page].layout.addElement(width, height, x, y);
+	}
+
+	void DynamicFontAtlas::addPage()
+	{
+		TEXTURE_DESC texDesc;
+		texDesc.width = mPageSize;
+		texDesc.height = mPageSize;
+		texDesc.format = PF_RG8;
+
+		Page page;
+		page.texture = Texture::create(texDesc);
+		page.texture->setName(u8"DynamicFontPage" + toString((UINT32)mPages.size()));
+		page.pixels.resize(mPageSize * mPageSize * 2, 0);
+		page.layout = TextureAtlasLayout(mPageSize, mPageSize, mPageSize, mPageSize);
+		page.dirty = true;
+
+		mBitmap.texturePages.push_back(page.texture);
+		mPages.push_back(std::move(page));
+	}
+
+	void DynamicFontAtlas::evict(UINT32 pageIdx)
+	{
+		Page& page = mPages[pageIdx];
+		for(auto& charId : page.charIds)
+		{
+			auto iterFind = mChars.find(charId);
+			if(iterFind != mChars.end())
+				iterFind->second.resident = false;
+		}
+
+		page.charIds.clear();
+		page.layout.clear();
+		memset(page.pixels.data(), 0, page.pixels.size());
+		page.dirty = true;
+
+		FontManager::instance()._notifyEvicted();
+
+		// The missing glyph is returned without a lookup, so it must always be present in the atlas
+		if(page.hasMissingGlyph)
+		{
+			page.hasMissingGlyph = false;
+			addMissingGlyph();
+		}
+	}
+
+	void DynamicFontAtlas::addMissingGlyph()
+	{
+		CharDesc missingGlyph;
+		Vector<UINT8> pixels;
+		if(mFace->renderChar(0, mBitmap.size, missingGlyph, pixels) && place(missingGlyph, pixels))
+			mPages[missingGlyph.page].hasMissingGlyph = missingGlyph.width > 0 && missingGlyph.height > 0;
+		else
+		{
+			missingGlyph.width = missingGlyph.height = 0;
+			missingGlyph.xOffset = missingGlyph.yOffset = 0;
+			missingGlyph.xAdvance = missingGlyph.yAdvance = 0;
+			missingGlyph.page = 0;
+			missingGlyph.uvX = missingGlyph.uvY = missingGlyph.uvWidth = missingGlyph.uvHeight = 0.0f;
+		}
+
+		missingGlyph.charId = 0;
+
+		mDescs.push_back(std::move(missingGlyph));
+		mMissingGlyph = &mDescs.back();
+	}
+
+	const CharDesc& DynamicFontAtlas::getMissingGlyph()
+	{
+		markUsed(*mMissingGlyph);
+		return *mMissingGlyph;
+	}
+
+	void DynamicFontAtlas::markUsed(const CharDesc& desc)
+	{
+		if(desc.width > 0 && desc.height > 0)
+			mPages[desc.page].lastUsedFrame = gTime().getFrameIdx();
+	}
+}
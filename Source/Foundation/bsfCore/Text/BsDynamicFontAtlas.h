@@ -0,0 +1,123 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Text/BsFontDesc.h"
+#include "Image/BsTextureAtlasLayout.h"
+
+namespace bs
+{
+	/** @addtogroup Text-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Rasterizes characters of a dynamic font of a specific size when they are first requested, and packs them into a
+	 * set of texture pages. Once all pages are full the least recently used page is cleared and its characters are
+	 * rasterized again when next requested. Character descriptors are never modified or destroyed once returned, so
+	 * references returned by getCharDesc() remain valid and safe to read while the atlas exists. A character rasterized
+	 * again after eviction gets a new descriptor, and the old one keeps its stale texture coordinates. Kerning is
+	 * queried from the font face the first time a pair of characters is requested, and cached.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_CORE_EXPORT DynamicFontAtlas
+	{
+		/** Character rasterized at least once, and its location in the atlas. */
+		struct CachedChar
+		{
+			const CharDesc* desc = nullptr;
+			bool resident = false;
+		};
+
+		/** A single texture page, and its contents on the CPU. */
+		struct Page
+		{
+			HTexture texture;
+			Vector<UINT8> pixels;
+			TextureAtlasLayout layout;
+			Vector<UINT32> charIds;
+			UINT64 lastUsedFrame = 0;
+			bool hasMissingGlyph = false;
+			bool dirty = false;
+		};
+
+	public:
+		/**
+		 * Creates a new atlas and rasterizes the missing glyph of the font.
+		 *
+		 * @param[in]	face		Face to rasterize the characters with. Can be shared with atlases of other sizes.
+		 * @param[in]	bitmap		Bitmap that owns the atlas. The atlas writes the missing glyph and the texture pages
+		 *							into it.
+		 * @param[in]	pageSize	Width and height of a single texture page, in pixels.
+		 * @param[in]	maxPages	Maximum number of pages that can be created.
+		 */
+		DynamicFontAtlas(const SPtr<FontFace>& face, FontBitmap& bitmap, UINT32 pageSize, UINT32 maxPages);
+		~DynamicFontAtlas();
+
+		/**
+		 * Returns the descriptor of the specified character, rasterizing it if it isn't present in the atlas. Returns
+		 * the missing glyph if the font doesn't contain the character, or if all pages are used by characters requested
+		 * during the current frame.
+		 */
+		const CharDesc& getCharDesc(UINT32 charId);
+
+		/**
+		 * Returns the amount, in pixels, by which to adjust the distance between the two characters when the second one
+		 * follows the first one.
+		 */
+		INT32 getKerning(UINT32 charId, UINT32 nextCharId);
+
+		/** Uploads the pages modified since the last call to the GPU. Must be called from the simulation thread. */
+		void _flush();
+
+	private:
+		/**
+		 * Copies the pixels of a rasterized character into the atlas, and updates its page and texture coordinates.
+		 * Returns false if no space could be found for the character.
+		 */
+		bool place(CharDesc& desc, const Vector<UINT8>& pixels);
+
+		/** Rasterizes the missing glyph into a new descriptor and makes it the one returned for missing characters. */
+		void addMissingGlyph();
+
+		/** Marks the missing glyph as used during the current frame and returns it. */
+		const CharDesc& getMissingGlyph();
+
+		/** Finds a free area of the specified size, evicting characters if needed. Returns false if none is found. */
+		bool allocate(UINT32 width, UINT32 height, UINT32& page, UINT32& x, UINT32& y);
+
+		/** Creates and appends a new empty page. */
+		void addPage();
+
+		/** Removes all characters from the page and marks them as not resident. */
+		void evict(UINT32 page);
+
+		/** Marks the page containing the character as used during the current frame. */
+		void markUsed(const CharDesc& desc);
+
+		/** Padding around every character, in pixels, that prevents neighboring characters from bleeding in. */
+		static constexpr UINT32 PADDING = 1;
+
+		SPtr<FontFace> mFace;
+		FontBitmap& mBitmap;
+		UINT32 mPageSize;
+		UINT32 mMaxPages;
+
+		/** Storage for all descriptors ever returned. Appending to it keeps references to existing entries valid. */
+		Deque<CharDesc> mDescs;
+		const CharDesc* mMissingGlyph = nullptr;
+
+		UnorderedMap<UINT32, CachedChar> mChars;
+		UnorderedSet<UINT32> mMissingChars;
+
+		/** Kerning of character pairs queried so far, keyed by both character IDs. */
+		UnorderedMap<UINT64, INT32> mKerning;
+		Vector<Page> mPages;
+		bool mWarnedFull = false;
+		Mutex mMutex;
+	};
+
+	/** @} */
+}
@@ -3,18 +3,38 @@
 #include "Text/BsFont.h"
 #include "Private/RTTI/BsFontRTTI.h"
 #include "Resources/BsResources.h"
+#include "Text/BsFontManager.h"
+#include "Text/BsDynamicFontAtlas.h"
+#include "FileSystem/BsDataStream.h"
+#include "Math/BsMath.h"
+#include "Debug/BsDebug.h"
 
 namespace bs
 {
 	const CharDesc& FontBitmap::getCharDesc(UINT32 charId) const
 	{
+		if(dynamicAtlas != nullptr)
+			return dynamicAtlas->getCharDesc(charId);
+
 		auto iterFind = characters.find(charId);
 		if(iterFind != characters.end())
+			return iterFind->second;
+
+		return missingGlyph;
+	}
+
+	INT32 FontBitmap::getKerning(const CharDesc& charDesc, UINT32 nextCharId) const
+	{
+		if(dynamicAtlas != nullptr)
+			return dynamicAtlas->getKerning(charDesc.charId, nextCharId);
+
+		for(auto& entry : charDesc.kerningPairs)
 		{
-			return characters.at(charId);
+			if(entry.otherCharId == nextCharId)
+				return entry.amount;
 		}
 
-		return missingGlyph;
+		return 0;
 	}
 
 	RTTITypeBase* FontBitmap::getRTTIStatic()
@@ -37,8 +57,37 @@ namespace bs
 	void Font::initialize(const Vector<SPtr<FontBitmap>>& fontData)
 	{
 		for(auto iter = fontData.begin(); iter != fontData.end(); ++iter)
+		{
 			mFontDataPerSize[(*iter)->size] = *iter;
 
+			// Scale down from the largest distance field, so as much detail as possible is preserved
+			if(!(*iter)->distanceField)
+				continue;
+
+			if(mDistanceFieldBitmap == nullptr || mDistanceFieldBitmap->size < (*iter)->size)
+				mDistanceFieldBitmap = *iter;
+		}
+
+		Resource::initialize();
+	}
+
+	void Font::initialize(const SPtr<MemoryDataStream>& sourceData, const DYNAMIC_FONT_DESC& desc)
+	{
+		mSourceData = sourceData;
+		mDynamicDesc = desc;
+
+		SPtr<FontRasterizer> rasterizer = FontManager::instance().getRasterizer();
+		if(rasterizer != nullptr)
+		{
+			mFace = rasterizer->createFace(mSourceData, mDynamicDesc);
+
+			if(mFace == nullptr)
+				LOGERR("Failed to create a dynamic font. The font data is not in a supported format.");
+		}
+		else
+			LOGERR("Failed to create a dynamic font. No font rasterizer is registered, make sure the font importer "
+				"plugin is loaded.");
+
 		Resource::initialize();
 	}
 
@@ -46,14 +95,31 @@ namespace bs
 	{
 		auto iterFind = mFontDataPerSize.find(size);
 
-		if(iterFind == mFontDataPerSize.end())
+		if(iterFind != mFontDataPerSize.end())
+			return iterFind->second;
+
+		if(mDistanceFieldBitmap == nullptr && mFace == nullptr)
 			return nullptr;
 
-		return iterFind->second;
+		Lock lock(mGeneratedBitmapsMutex);
+
+		SPtr<FontBitmap>& generatedBitmap = mGeneratedBitmaps[size];
+		if(generatedBitmap == nullptr)
+		{
+			if(mFace != nullptr)
+				generatedBitmap = createDynamicBitmap(size);
+			else
+				generatedBitmap = createScaledBitmap(*mDistanceFieldBitmap, size);
+		}
+
+		return generatedBitmap;
 	}
 
 	INT32 Font::getClosestSize(UINT32 size) const
 	{
+		if(mDistanceFieldBitmap != nullptr || mFace != nullptr)
+			return size;
+
 		UINT32 minDiff = std::numeric_limits<UINT32>::max();
 		UINT32 bestSize = size;
 
@@ -84,6 +150,57 @@ namespace bs
 		return bestSize;
 	}
 
+	SPtr<FontBitmap> Font::createScaledBitmap(const FontBitmap& source, UINT32 size)
+	{
+		const float scale = size / (float)source.size;
+		const auto scaleMetric = [scale](INT32 value) { return Math::roundToInt(value * scale); };
+
+		// Textures and UV coordinates are shared, only the pixel metrics change
+		const auto scaleChar = [&scaleMetric](const CharDesc& input)
+		{
+			CharDesc output = input;
+			output.width = (UINT32)scaleMetric((INT32)input.width);
+			output.height = (UINT32)scaleMetric((INT32)input.height);
+			output.xOffset = scaleMetric(input.xOffset);
+			output.yOffset = scaleMetric(input.yOffset);
+			output.xAdvance = scaleMetric(input.xAdvance);
+			output.yAdvance = scaleMetric(input.yAdvance);
+
+			for(auto& entry : output.kerningPairs)
+				entry.amount = scaleMetric(entry.amount);
+
+			return output;
+		};
+
+		SPtr<FontBitmap> output = bs_shared_ptr_new<FontBitmap>();
+		output->size = size;
+		output->baselineOffset = scaleMetric(source.baselineOffset);
+		output->lineHeight = (UINT32)scaleMetric((INT32)source.lineHeight);
+		output->spaceWidth = (UINT32)scaleMetric((INT32)source.spaceWidth);
+		output->missingGlyph = scaleChar(source.missingGlyph);
+		output->texturePages = source.texturePages;
+		output->distanceField = true;
+
+		for(auto& entry : source.characters)
+			output->characters[entry.first] = scaleChar(entry.second);
+
+		return output;
+	}
+
+	SPtr<FontBitmap> Font::createDynamicBitmap(UINT32 size) const
+	{
+		SPtr<FontBitmap> output = bs_shared_ptr_new<FontBitmap>();
+		output->size = size;
+
+		if(!mFace->getMetrics(size, output->baselineOffset, output->lineHeight, output->spaceWidth))
+			return nullptr;
+
+		output->dynamicAtlas = bs_shared_ptr_new<DynamicFontAtlas>(mFace, *output, mDynamicDesc.pageSize,
+			mDynamicDesc.maxPages);
+
+		return output;
+	}
+
 	void Font::getResourceDependencies(FrameVector<HResource>& dependencies) const
 	{
 		for (auto& fontDataEntry : mFontDataPerSize)
@@ -124,6 +241,22 @@ namespace bs
 		return newFont;
 	}
 
+	HFont Font::createDynamic(const SPtr<DataStream>& fontData, const DYNAMIC_FONT_DESC& desc)
+	{
+		SPtr<Font> newFont = _createDynamicPtr(fontData, desc);
+
+		return static_resource_cast<Font>(gResources()._createResourceHandle(newFont));
+	}
+
+	SPtr<Font> Font::_createDynamicPtr(const SPtr<DataStream>& fontData, const DYNAMIC_FONT_DESC& desc)
+	{
+		SPtr<Font> newFont = bs_core_ptr<Font>(new (bs_alloc<Font>()) Font());
+		newFont->_setThisPtr(newFont);
+		newFont->initialize(bs_shared_ptr_new<MemoryDataStream>(fontData), desc);
+
+		return newFont;
+	}
+
 	SPtr<Font> Font::_createEmpty()
 	{
 		SPtr<Font> newFont = bs_core_ptr<Font>(new (bs_alloc<Font>()) Font());
@@ -12,6 +12,25 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Determines how are the characters of a dynamic font rasterized and stored. */
+	struct BS_CORE_EXPORT DYNAMIC_FONT_DESC
+	{
+		/** Determines how are the characters rendered. Distance fields are not supported by dynamic fonts. */
+		FontRenderMode renderMode = FontRenderMode::HintedSmooth;
+
+		/** Dots per inch resolution to render the characters at. */
+		UINT32 dpi = 96;
+
+		/** Width and height of a single atlas texture page, in pixels. */
+		UINT32 pageSize = 512;
+
+		/**
+		 * Maximum number of atlas texture pages per font size. Once all pages are full the least recently used page is
+		 * cleared to make room for new characters.
+		 */
+		UINT32 maxPages = 4;
+	};
+
 	/**	Contains textures and data about every character for a bitmap font of a specific size. */
 	struct BS_CORE_EXPORT BS_SCRIPT_EXPORT(m:GUI_Engine) FontBitmap : public IReflectable
 	{
@@ -19,6 +38,12 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		const CharDesc& getCharDesc(UINT32 charId) const;
 
+		/**
+		 * Returns the amount, in pixels, by which to adjust the distance between the character and the character
+		 * following it.
+		 */
+		INT32 getKerning(const CharDesc& charDesc, UINT32 nextCharId) const;
+
 		/** Font size for which the data is contained. */
 		BS_SCRIPT_EXPORT()
 		UINT32 size;
@@ -43,8 +68,24 @@ namespace bs
 		BS_SCRIPT_EXPORT()
 		Vector<HTexture> texturePages;
 
-		/** All characters in the font referenced by character ID. */
-		Map<UINT32, CharDesc> characters;
+		/**
+		 * True if the texture pages contain signed distance fields of the characters, rather than their coverage. Such
+		 * bitmaps can be scaled to any size, and need to be rendered with a material that supports distance fields.
+		 */
+		BS_SCRIPT_EXPORT()
+		bool distanceField = false;
+
+		/**
+		 * All characters in the font referenced by character ID. Hashed since it's queried for every character of every
+		 * text that gets laid out, and fonts for some languages contain many thousands of characters.
+		 */
+		UnorderedMap<UINT32, CharDesc> characters;
+
+		/**
+		 * Atlas that rasterizes characters on demand, if the bitmap belongs to a dynamic font. When set, the character
+		 * map is unused and the texture pages are owned by the atlas.
+		 */
+		SPtr<DynamicFontAtlas> dynamicAtlas;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -65,7 +106,9 @@ namespace bs
 		virtual ~Font();
 
 		/**
-		 * Returns font bitmap for a specific font size.
+		 * Returns font bitmap for a specific font size. If the font contains a distance field bitmap and no bitmap of
+		 * the exact size exists, a bitmap scaled from the distance field is returned instead. Dynamic fonts return a
+		 * bitmap whose characters are rasterized when first requested.
 		 *
 		 * @param[in]	size	Size of the bitmap in points.
 		 * @return				Bitmap object if it exists, false otherwise.
@@ -74,7 +117,8 @@ namespace bs
 		SPtr<FontBitmap> getBitmap(UINT32 size) const;
 
 		/**	
-		 * Finds the available font bitmap size closest to the provided size. 
+		 * Finds the available font bitmap size closest to the provided size. Dynamic fonts and fonts containing a
+		 * distance field bitmap are available in any size.
 		 * 
 		 * @param[in]	size	Size of the bitmap in points.
 		 * @return				Nearest available bitmap size.
@@ -85,6 +129,13 @@ namespace bs
 		/**	Creates a new font from the provided per-size font data. */
 		static HFont create(const Vector<SPtr<FontBitmap>>& fontInitData);
 
+		/**
+		 * Creates a new dynamic font from the contents of a font file (e.g. TrueType or OpenType). Characters are
+		 * rasterized at runtime when first used, in any size, and only the font file is stored with the resource.
+		 * Requires a font rasterizer, provided by the font importer plugin.
+		 */
+		static HFont createDynamic(const SPtr<DataStream>& fontData, const DYNAMIC_FONT_DESC& desc);
+
 	public: // ***** INTERNAL ******
 		using Resource::initialize;
 
@@ -99,9 +150,19 @@ namespace bs
 		 */
 		void initialize(const Vector<SPtr<FontBitmap>>& fontData);
 
+		/**
+		 * Initializes the font as a dynamic font, rasterizing characters from the provided font file contents.
+		 *
+		 * @note	Internal method. Factory methods will call this automatically for you.
+		 */
+		void initialize(const SPtr<MemoryDataStream>& sourceData, const DYNAMIC_FONT_DESC& desc);
+
 		/** Creates a new font as a pointer instead of a resource handle. */
 		static SPtr<Font> _createPtr(const Vector<SPtr<FontBitmap>>& fontInitData);
 
+		/** Creates a new dynamic font as a pointer instead of a resource handle. */
+		static SPtr<Font> _createDynamicPtr(const SPtr<DataStream>& fontData, const DYNAMIC_FONT_DESC& desc);
+
 		/** Creates a Font without initializing it. */
 		static SPtr<Font> _createEmpty();
 
@@ -119,7 +180,22 @@ namespace bs
 		void getCoreDependencies(Vector<CoreObject*>& dependencies) override;
 
 	private:
+		/** Creates a copy of the provided distance field bitmap, with all the metrics scaled to a different size. */
+		static SPtr<FontBitmap> createScaledBitmap(const FontBitmap& source, UINT32 size);
+
+		/** Creates an empty bitmap whose characters are rasterized from the font face on demand. */
+		SPtr<FontBitmap> createDynamicBitmap(UINT32 size) const;
+
 		Map<UINT32, SPtr<FontBitmap>> mFontDataPerSize;
+		SPtr<FontBitmap> mDistanceFieldBitmap;
+
+		SPtr<MemoryDataStream> mSourceData;
+		DYNAMIC_FONT_DESC mDynamicDesc;
+		SPtr<FontFace> mFace;
+
+		// Bitmaps created on demand, either scaled from the distance field or rasterized by the dynamic font
+		mutable Map<UINT32, SPtr<FontBitmap>> mGeneratedBitmaps;
+		mutable Mutex mGeneratedBitmapsMutex;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
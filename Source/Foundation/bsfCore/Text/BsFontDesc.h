@@ -10,6 +10,21 @@ namespace bs
 	 *  @{
 	 */
 
+	/**	Determines how is a font rendered into the bitmap texture. */
+	enum class FontRenderMode
+	{
+		Smooth, /*< Render antialiased fonts without hinting (slightly more blurry). */
+		Raster, /*< Render non-antialiased fonts without hinting (slightly more blurry). */
+		HintedSmooth, /*< Render antialiased fonts with hinting. */
+		HintedRaster, /*< Render non-antialiased fonts with hinting. */
+		/**
+		 * Render a signed distance field of each character instead of its coverage. Such a font can be rendered at any
+		 * size from a single bitmap, without becoming blurry when magnified. Usually only the largest size for which
+		 * the text needs to be sharp should be imported.
+		 */
+		DistanceField
+	};
+
 	/**	Kerning pair representing larger or smaller offset between a specific pair of characters. */
 	struct BS_SCRIPT_EXPORT(pl:true,m:GUI_Engine) KerningPair
 	{
@@ -12,15 +12,6 @@ namespace bs
 	 *  @{
 	 */
 
-	/**	Determines how is a font rendered into the bitmap texture. */
-	enum class FontRenderMode
-	{
-		Smooth, /*< Render antialiased fonts without hinting (slightly more blurry). */
-		Raster, /*< Render non-antialiased fonts without hinting (slightly more blurry). */
-		HintedSmooth, /*< Render antialiased fonts with hinting. */
-		HintedRaster /*< Render non-antialiased fonts with hinting. */
-	};
-
 	/**	Import options that allow you to control how is a font imported. */
 	class BS_CORE_EXPORT FontImportOptions : public ImportOptions
 	{
@@ -48,6 +39,22 @@ namespace bs
 		/**	Sets whether the italic font style should be used when rendering. */
 		void setItalic(bool italic) { mItalic = italic; }
 
+		/**
+		 * Sets whether the font should be imported as a dynamic font. Dynamic fonts store the font file instead of
+		 * pre-rendered characters, and rasterize characters when they are first used, in any size. Font sizes and
+		 * character ranges are ignored for such fonts. Distance field render mode is not supported.
+		 */
+		void setDynamic(bool dynamic) { mDynamic = dynamic; }
+
+		/** Sets the width and height of a single atlas texture page of a dynamic font, in pixels. */
+		void setDynamicPageSize(UINT32 pageSize) { mDynamicPageSize = pageSize; }
+
+		/**
+		 * Sets the maximum number of atlas texture pages per size of a dynamic font. Once all pages are full the least
+		 * recently used page is cleared to make room for new characters.
+		 */
+		void setDynamicMaxPages(UINT32 maxPages) { mDynamicMaxPages = maxPages; }
+
 		/**	Gets the sizes that are to be imported. Ranges are defined as unicode numbers. */
 		Vector<UINT32> getFontSizes() const { return mFontSizes; }
 
@@ -66,6 +73,15 @@ namespace bs
 		/**	Sets whether the italic font style should be used when rendering. */
 		bool getItalic() const { return mItalic; }
 
+		/** Checks should the font be imported as a dynamic font. */
+		bool getDynamic() const { return mDynamic; }
+
+		/** Returns the width and height of a single atlas texture page of a dynamic font, in pixels. */
+		UINT32 getDynamicPageSize() const { return mDynamicPageSize; }
+
+		/** Returns the maximum number of atlas texture pages per size of a dynamic font. */
+		UINT32 getDynamicMaxPages() const { return mDynamicMaxPages; }
+
 		/** Creates a new import options object that allows you to customize how are fonts imported. */
 		static SPtr<FontImportOptions> create();
 
@@ -76,6 +92,9 @@ namespace bs
 		FontRenderMode mRenderMode;
 		bool mBold;
 		bool mItalic;
+		bool mDynamic = false;
+		UINT32 mDynamicPageSize = 512;
+		UINT32 mDynamicMaxPages = 4;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
@@ -0,0 +1,39 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Text/BsFontManager.h"
+#include "Text/BsDynamicFontAtlas.h"
+
+namespace bs
+{
+	void FontManager::_registerRasterizer(const SPtr<FontRasterizer>& rasterizer)
+	{
+		Lock lock(mMutex);
+		mRasterizer = rasterizer;
+	}
+
+	SPtr<FontRasterizer> FontManager::getRasterizer() const
+	{
+		Lock lock(mMutex);
+		return mRasterizer;
+	}
+
+	void FontManager::_update()
+	{
+		Lock lock(mMutex);
+
+		for(auto& atlas : mAtlases)
+			atlas->_flush();
+	}
+
+	void FontManager::_registerAtlas(DynamicFontAtlas* atlas)
+	{
+		Lock lock(mMutex);
+		mAtlases.insert(atlas);
+	}
+
+	void FontManager::_unregisterAtlas(DynamicFontAtlas* atlas)
+	{
+		Lock lock(mMutex);
+		mAtlases.erase(atlas);
+	}
+}
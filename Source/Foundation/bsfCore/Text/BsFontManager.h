@@ -0,0 +1,113 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Text/BsFont.h"
+
+namespace bs
+{
+	/** @addtogroup Text-Internal
+	 *  @{
+	 */
+
+	/**
+	 * A single font face able to rasterize its characters at any size. Implementations must be thread safe, since faces
+	 * are shared by all sizes of a dynamic font.
+	 */
+	class BS_CORE_EXPORT FontFace
+	{
+	public:
+		virtual ~FontFace() = default;
+
+		/**
+		 * Returns metrics shared by all characters of the face at a specific size.
+		 *
+		 * @param[in]	size			Size of the characters, in points.
+		 * @param[out]	baselineOffset	Y offset to the baseline on which the characters are placed, in pixels.
+		 * @param[out]	lineHeight		Height of a single line of the font, in pixels.
+		 * @param[out]	spaceWidth		Width of a space, in pixels.
+		 * @return						False if the face cannot be rendered at the provided size.
+		 */
+		virtual bool getMetrics(UINT32 size, INT32& baselineOffset, UINT32& lineHeight, UINT32& spaceWidth) = 0;
+
+		/**
+		 * Rasterizes a single character.
+		 *
+		 * @param[in]	charId	Unicode key of the character. Zero rasterizes the glyph used for missing characters.
+		 * @param[in]	size	Size of the character, in points.
+		 * @param[out]	desc	Receives the character size, offsets and advance. Page, UV coordinates and kerning pairs
+		 *						are not touched.
+		 * @param[out]	pixels	Receives 8-bit coverage of the character, one row after another, without any padding.
+		 * @return				False if the face doesn't contain the character.
+		 */
+		virtual bool renderChar(UINT32 charId, UINT32 size, CharDesc& desc, Vector<UINT8>& pixels) = 0;
+
+		/** Checks does the face provide kerning information. When false getKerning() always returns zero. */
+		virtual bool hasKerning() const = 0;
+
+		/** Returns the horizontal kerning between a character and the character following it, in pixels. */
+		virtual INT32 getKerning(UINT32 charId, UINT32 nextCharId, UINT32 size) = 0;
+	};
+
+	/** Creates font faces from font file contents. Implemented by a plugin that links with a font rendering library. */
+	class BS_CORE_EXPORT FontRasterizer
+	{
+	public:
+		virtual ~FontRasterizer() = default;
+
+		/**
+		 * Creates a new face from the contents of a font file. The face keeps a reference to the data. Returns null if
+		 * the data isn't in a supported format.
+		 */
+		virtual SPtr<FontFace> createFace(const SPtr<MemoryDataStream>& data, const DYNAMIC_FONT_DESC& desc) = 0;
+	};
+
+	/** Keeps track of the font rasterizer, and uploads characters rasterized by dynamic fonts to their atlases. */
+	class BS_CORE_EXPORT FontManager : public Module<FontManager>
+	{
+	public:
+		/**
+		 * Registers a rasterizer used for creating faces of dynamic fonts. Replaces any previously registered
+		 * rasterizer.
+		 *
+		 * @note	This method should only be called by plugins on startup.
+		 */
+		void _registerRasterizer(const SPtr<FontRasterizer>& rasterizer);
+
+		/** Returns the registered font rasterizer, or null if no plugin provides it. */
+		SPtr<FontRasterizer> getRasterizer() const;
+
+		/**
+		 * Returns a value that changes whenever characters of any dynamic font are evicted from its atlas. Text meshes
+		 * built while the previous value was current might reference evicted characters and should be rebuilt.
+		 */
+		UINT64 getAtlasVersion() const { return mAtlasVersion.load(); }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Uploads the atlas pages modified since the last call. Called once per frame. */
+		void _update();
+
+		/** Registers a newly created dynamic font atlas. */
+		void _registerAtlas(DynamicFontAtlas* atlas);
+
+		/** Unregisters a dynamic font atlas that is about to be destroyed. */
+		void _unregisterAtlas(DynamicFontAtlas* atlas);
+
+		/** Notifies the manager that a dynamic font atlas evicted some of its characters. */
+		void _notifyEvicted() { mAtlasVersion++; }
+
+		/** @} */
+	private:
+		SPtr<FontRasterizer> mRasterizer;
+		UnorderedSet<DynamicFontAtlas*> mAtlases;
+		std::atomic<UINT64> mAtlasVersion { 0 };
+		mutable Mutex mMutex;
+	};
+
+	/** @} */
+}
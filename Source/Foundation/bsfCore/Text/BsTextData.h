@@ -35,11 +35,12 @@ namespace bs
 			/**
 			 * Appends a new character to the word.
 			 *
+			 * @param[in]	font		Font the character belongs to.
 			 * @param[in]	charIdx		Sequential index of the character in the original string.
 			 * @param[in]	desc		Character description from the font.
 			 * @return					How many pixels did the added character expand the word by.
 			 */
-			UINT32 addChar(UINT32 charIdx, const CharDesc& desc);
+			UINT32 addChar(const FontBitmap& font, UINT32 charIdx, const CharDesc& desc);
 
 			/** Adds a space to the word. Word must have previously have been declared as a "spacer". */
 			void addSpace(UINT32 spaceWidth);
@@ -53,10 +54,11 @@ namespace bs
 			/**
 			 * Calculates new width of the word if we were to add the provided character, without actually adding it.
 			 *
+			 * @param[in]	font	Font the character belongs to.
 			 * @param[in]	desc	Character description from the font.
 			 * @return				Width of the word in pixels with the character appended to it.
 			 */
-			UINT32 calcWidthWithChar(const CharDesc& desc);
+			UINT32 calcWidthWithChar(const FontBitmap& font, const CharDesc& desc);
 
 			/**
 			 * Returns true if word is a spacer. Spacers contain just a space of a certain length with no actual characters.
@@ -75,11 +77,12 @@ namespace bs
 			/**
 			 * Calculates width of the character by which it would expand the width of the word if it was added to it.
 			 *
+			 * @param[in]	font		Font the characters belong to.
 			 * @param[in]	prevDesc	Descriptor of the character preceding the one we need the width for. Can be null.
 			 * @param[in]	desc		Character description from the font.
 			 * @return 					How many pixels would the added character expand the word by.
 			 */
-			static UINT32 calcCharWidth(const CharDesc* prevDesc, const CharDesc& desc);
+			static UINT32 calcCharWidth(const FontBitmap& font, const CharDesc* prevDesc, const CharDesc& desc);
 
 		private:
 			UINT32 mCharsStart, mCharsEnd;
@@ -236,6 +239,9 @@ namespace bs
 		/**	Returns font texture for the provided page index.  */
 		BS_CORE_EXPORT const HTexture& getTextureForPage(UINT32 page) const;
 
+		/**	Checks do the font textures contain signed distance fields instead of character coverage. */
+		BS_CORE_EXPORT bool isDistanceField() const;
+
 		/**	Returns the number of quads used by all the characters in the provided page. */
 		BS_CORE_EXPORT UINT32 getNumQuadsForPage(UINT32 page) const { return mPageInfos[page].numQuads; }
 
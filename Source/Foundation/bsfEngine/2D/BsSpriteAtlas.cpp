@@ -0,0 +1,168 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "2D/BsSpriteAtlas.h"
+#include "Image/BsSpriteTexture.h"
+#include "Image/BsTexture.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "Image/BsTextureAtlasLayout.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Managers/BsTextureStreamingManager.h"
+
+namespace bs
+{
+	/** Block size used for aligning areas of block compressed textures, in pixels. */
+	static constexpr UINT32 BLOCK_SIZE = 4;
+
+	/** Copies an area of a texture into another texture. */
+	static void copyArea(const SPtr<ct::Texture>& source, const SPtr<ct::Texture>& target,
+		const TEXTURE_COPY_DESC& desc)
+	{
+		source->copy(target, desc);
+	}
+
+	/**
+	 * Returns the area of the texture referenced by the sprite texture, in pixels. Returns false if the area cannot be
+	 * copied into an atlas.
+	 */
+	static bool getSourceArea(const HSpriteTexture& sprite, PixelVolume& area)
+	{
+		if(!sprite.isLoaded() || !sprite->getTexture().isLoaded())
+			return false;
+
+		const HTexture& texture = sprite->getTexture();
+		const TextureProperties& props = texture->getProperties();
+		if(props.getTextureType() != TEX_TYPE_2D || props.getNumArraySlices() > 1)
+			return false;
+
+		// The most detailed mip level of streamed textures might not be loaded yet
+		const SPtr<TextureStreamingData>& streamingData = texture->_getStreamingData();
+		if(streamingData != nullptr && streamingData->residentMip != 0)
+			return false;
+
+		const auto width = (INT32)props.getWidth();
+		const auto height = (INT32)props.getHeight();
+
+		const Vector2 offset = sprite->getOffset();
+		const Vector2 scale = sprite->getScale();
+
+		const UINT32 left = (UINT32)Math::clamp(Math::roundToInt(offset.x * width), 0, width);
+		const UINT32 top = (UINT32)Math::clamp(Math::roundToInt(offset.y * height), 0, height);
+		const UINT32 right = (UINT32)Math::clamp(Math::roundToInt((offset.x + scale.x) * width), (INT32)left, width);
+		const UINT32 bottom = (UINT32)Math::clamp(Math::roundToInt((offset.y + scale.y) * height), (INT32)top, height);
+
+		if(left == right || top == bottom)
+			return false;
+
+		// Block compressed textures can only be copied in whole blocks
+		if(PixelUtil::isCompressed(props.getFormat()))
+		{
+			if(left % BLOCK_SIZE != 0 || top % BLOCK_SIZE != 0)
+				return false;
+
+			if(right % BLOCK_SIZE != 0 && right != (UINT32)width)
+				return false;
+
+			if(bottom % BLOCK_SIZE != 0 && bottom != (UINT32)height)
+				return false;
+		}
+
+		area = PixelVolume(left, top, right, bottom);
+		return true;
+	}
+
+	Vector<HSpriteTexture> SpriteAtlas::create(const Vector<HSpriteTexture>& sprites, UINT32 maxSize, UINT32 padding)
+	{
+		Vector<HSpriteTexture> output = sprites;
+
+		// Only textures of the same format can be copied into the same atlas
+		Vector<PixelVolume> sourceAreas(sprites.size());
+		Map<PixelFormat, Vector<UINT32>> spritesPerFormat;
+		for(UINT32 i = 0; i < (UINT32)sprites.size(); i++)
+		{
+			if(!getSourceArea(sprites[i], sourceAreas[i]))
+				continue;
+
+			const PixelFormat format = sprites[i]->getTexture()->getProperties().getFormat();
+			spritesPerFormat[format].push_back(i);
+		}
+
+		for(auto& entry : spritesPerFormat)
+		{
+			const PixelFormat format = entry.first;
+			const Vector<UINT32>& spriteIndices = entry.second;
+
+			const UINT32 alignment = PixelUtil::isCompressed(format) ? BLOCK_SIZE : 1;
+			const UINT32 alignedPadding = Math::divideAndRoundUp(padding, alignment) * alignment;
+
+			Vector<TextureAtlasUtility::Element> elements(spriteIndices.size());
+			for(UINT32 i = 0; i < (UINT32)spriteIndices.size(); i++)
+			{
+				const PixelVolume& area = sourceAreas[spriteIndices[i]];
+
+				const UINT32 width = Math::divideAndRoundUp(area.getWidth(), alignment) * alignment;
+				const UINT32 height = Math::divideAndRoundUp(area.getHeight(), alignment) * alignment;
+
+				elements[i].input.width = width + alignedPadding * 2;
+				elements[i].input.height = height + alignedPadding * 2;
+			}
+
+			Vector<TextureAtlasUtility::Page> pages = TextureAtlasUtility::createAtlasLayout(elements, 64, 64,
+				maxSize, maxSize, true);
+
+			Vector<HTexture> pageTextures;
+			for(auto& page : pages)
+			{
+				TEXTURE_DESC pageDesc;
+				pageDesc.width = page.width;
+				pageDesc.height = page.height;
+				pageDesc.format = format;
+
+				HTexture pageTexture = Texture::create(pageDesc);
+				pageTexture->setName(u8"SpriteAtlas" + toString((UINT32)pageTextures.size()));
+
+				// Padding must be empty, make sure nothing undefined is left in it
+				SPtr<PixelData> clearData = pageTexture->getProperties().allocBuffer(0, 0);
+				memset(clearData->getData(), 0, clearData->getSize());
+				pageTexture->writeData(clearData);
+
+				pageTextures.push_back(pageTexture);
+			}
+
+			for(auto& element : elements)
+			{
+				if(element.output.page < 0)
+					continue;
+
+				const UINT32 spriteIdx = spriteIndices[element.output.idx];
+				const HSpriteTexture& sprite = sprites[spriteIdx];
+				const PixelVolume& area = sourceAreas[spriteIdx];
+
+				const HTexture& pageTexture = pageTextures[element.output.page];
+				const UINT32 x = element.output.x + alignedPadding;
+				const UINT32 y = element.output.y + alignedPadding;
+
+				TEXTURE_COPY_DESC copyDesc;
+				copyDesc.srcVolume = area;
+				copyDesc.dstPosition = Vector3I((INT32)x, (INT32)y, 0);
+
+				gCoreThread().queueCommand(std::bind(&copyArea, sprite->getTexture()->getCore(), pageTexture->getCore(),
+					copyDesc));
+
+				const auto& pageProps = pageTexture->getProperties();
+				const Vector2 invPageSize(1.0f / pageProps.getWidth(), 1.0f / pageProps.getHeight());
+
+				const Vector2 uvOffset = Vector2((float)x, (float)y) * invPageSize;
+				const Vector2 uvScale = Vector2((float)area.getWidth(), (float)area.getHeight()) * invPageSize;
+
+				HSpriteTexture atlasSprite = SpriteTexture::create(uvOffset, uvScale, pageTexture);
+				atlasSprite->setAnimation(sprite->getAnimation());
+				atlasSprite->setAnimationPlayback(sprite->getAnimationPlayback());
+
+				output[spriteIdx] = atlasSprite;
+			}
+		}
+
+		return output;
+	}
+}
\ No newline at end of file
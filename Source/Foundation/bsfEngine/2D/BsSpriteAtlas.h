@@ -0,0 +1,39 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup 2D
+	 *  @{
+	 */
+
+	/**
+	 * Packs the areas referenced by multiple sprite textures into a smaller number of shared textures at runtime.
+	 * Sprites using the packed sprite textures can then be rendered in fewer draw calls, for example by SpriteBatch.
+	 */
+	class BS_EXPORT SpriteAtlas
+	{
+	public:
+		/**
+		 * Copies the areas referenced by the provided sprite textures into one or multiple atlas textures, and creates
+		 * new sprite textures referencing the copies. Copying is performed on the GPU.
+		 *
+		 * @param[in]	sprites		Sprite textures to pack. Only sprites referencing textures of the same format are
+		 *							packed into the same atlas texture. Sprite textures whose texture isn't loaded or
+		 *							resident, whose area doesn't fit into an atlas texture, or whose area isn't aligned
+		 *							to the block size of a compressed format, are returned as is.
+		 * @param[in]	maxSize		Maximum width and height of a single atlas texture, in pixels.
+		 * @param[in]	padding		Empty space to leave around each sprite, in pixels. Prevents neighbouring sprites
+		 *							from bleeding into each other when filtered.
+		 * @return					Sprite textures referencing the atlas textures, one for each entry in @p sprites
+		 *							and in the same order. Animation properties of the sprite textures are preserved.
+		 */
+		static Vector<HSpriteTexture> create(const Vector<HSpriteTexture>& sprites, UINT32 maxSize = 2048,
+			UINT32 padding = 1);
+	};
+
+	/** @} */
+}
\ No newline at end of file
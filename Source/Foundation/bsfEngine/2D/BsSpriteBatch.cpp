@@ -0,0 +1,204 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "2D/BsSpriteBatch.h"
+#include "Image/BsSpriteTexture.h"
+#include "Image/BsTexture.h"
+#include "CoreThread/BsCoreThread.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsIndexBuffer.h"
+#include "RenderAPI/BsVertexDataDesc.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+#include "Renderer/BsCamera.h"
+#include "Utility/BsTime.h"
+#include "Math/BsRect2.h"
+
+namespace bs
+{
+	SpriteBatch::SpriteBatch()
+	{
+		mRenderer = RendererExtension::create<ct::SpriteBatchRenderer>(nullptr);
+	}
+
+	void SpriteBatch::draw(const HSpriteTexture& texture, const Vector3& position, const Vector2& size,
+		const Color& color, Radian rotation, INT32 layer)
+	{
+		if(!texture.isLoaded() || !texture->getTexture().isLoaded())
+			return;
+
+		const Rect2 uv = texture->evaluate(gTime().getTime());
+
+		SpriteInstance instance;
+		instance.positionAndRotation = Vector4(position.x, position.y, position.z, rotation.valueRadians());
+		instance.sizeAndUVOffset = Vector4(size.x, size.y, uv.x, uv.y);
+		instance.uvScale = Vector2(uv.width, uv.height);
+		instance.color = color;
+
+		// Flip the sign bit so that negative layers sort before positive ones
+		const UINT32 sortLayer = (UINT32)layer ^ 0x80000000;
+		const UINT64 sortKey = ((UINT64)sortLayer << 32) | getTextureIdx(texture->getTexture());
+
+		mSortKeys.push_back(std::make_pair(sortKey, (UINT32)mSprites.size()));
+		mSprites.push_back(instance);
+	}
+
+	UINT32 SpriteBatch::getTextureIdx(const HTexture& texture)
+	{
+		auto iterFind = mTextureIndices.find(texture->getInternalID());
+		if(iterFind != mTextureIndices.end())
+			return iterFind->second;
+
+		const auto idx = (UINT32)mTextures.size();
+		mTextures.push_back(texture->getCore());
+		mTextureIndices[texture->getInternalID()] = idx;
+
+		return idx;
+	}
+
+	void SpriteBatch::_update()
+	{
+		SPtr<FrameData> frameData = bs_shared_ptr_new<FrameData>();
+
+		// Sprite index is a part of the key so the order within a batch matches the order the sprites were queued in
+		std::sort(mSortKeys.begin(), mSortKeys.end());
+
+		frameData->instances.reserve(mSprites.size());
+		for(UINT32 i = 0; i < (UINT32)mSortKeys.size(); i++)
+		{
+			const UINT64 sortKey = mSortKeys[i].first;
+			if(i == 0 || sortKey != mSortKeys[i - 1].first)
+			{
+				const auto textureIdx = (UINT32)(sortKey & 0xFFFFFFFF);
+				frameData->batches.push_back({ mTextures[textureIdx], i, 0 });
+			}
+
+			frameData->batches.back().count++;
+			frameData->instances.push_back(mSprites[mSortKeys[i].second]);
+		}
+
+		mSprites.clear();
+		mSortKeys.clear();
+		mTextures.clear();
+		mTextureIndices.clear();
+
+		ct::SpriteBatchRenderer* renderer = mRenderer.get();
+		gCoreThread().queueCommand(std::bind(&ct::SpriteBatchRenderer::updateData, renderer, frameData));
+	}
+
+	namespace ct
+	{
+	SpriteBatchParamsDef gSpriteBatchParamsDef;
+
+	SpriteBatchMat::SpriteBatchMat()
+	{
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gMainTexture", mTexture);
+	}
+
+	void SpriteBatchMat::bind(const SPtr<GpuParamBlockBuffer>& params, const SPtr<Texture>& texture)
+	{
+		mParams->setParamBlockBuffer("Params", params);
+		mTexture.set(texture);
+
+		RendererMaterial::bind();
+	}
+
+	SpriteBatchRenderer::SpriteBatchRenderer()
+		:RendererExtension(RenderLocation::PostLightPass, 0)
+	{ }
+
+	void SpriteBatchRenderer::initialize(const Any& data)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		mParamBuffer = gSpriteBatchParamsDef.createBuffer();
+
+		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
+		vertexDesc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 0, 0, 1); // Position & rotation, per instance
+		vertexDesc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 1, 0, 1); // Size & UV offset, per instance
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD, 2, 0, 1); // UV scale, per instance
+		vertexDesc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 3, 0, 1); // Color, per instance
+		vertexDesc->addVertElem(VET_FLOAT2, VES_TEXCOORD, 4, 1); // Quad corner
+
+		mVertexDecl = VertexDeclaration::create(vertexDesc);
+
+		VERTEX_BUFFER_DESC instanceBufferDesc;
+		instanceBufferDesc.numVerts = NUM_SCRATCH_INSTANCES;
+		instanceBufferDesc.vertexSize = vertexDesc->getVertexStride(0);
+		instanceBufferDesc.usage = GBU_DYNAMIC;
+
+		mInstanceBuffer = VertexBuffer::create(instanceBufferDesc);
+
+		VERTEX_BUFFER_DESC quadBufferDesc;
+		quadBufferDesc.numVerts = 4;
+		quadBufferDesc.vertexSize = vertexDesc->getVertexStride(1);
+
+		mQuadVertices = VertexBuffer::create(quadBufferDesc);
+
+		auto* const corners = (Vector2*)mQuadVertices->lock(GBL_WRITE_ONLY_DISCARD);
+		corners[0] = Vector2(0.0f, 0.0f);
+		corners[1] = Vector2(1.0f, 0.0f);
+		corners[2] = Vector2(1.0f, 1.0f);
+		corners[3] = Vector2(0.0f, 1.0f);
+		mQuadVertices->unlock();
+
+		INDEX_BUFFER_DESC quadIndexBufferDesc;
+		quadIndexBufferDesc.indexType = IT_16BIT;
+		quadIndexBufferDesc.numIndices = 6;
+
+		mQuadIndices = IndexBuffer::create(quadIndexBufferDesc);
+
+		auto* const indices = (UINT16*)mQuadIndices->lock(GBL_WRITE_ONLY_DISCARD);
+		indices[0] = 0; indices[1] = 1; indices[2] = 2;
+		indices[3] = 0; indices[4] = 2; indices[5] = 3;
+		mQuadIndices->unlock();
+	}
+
+	void SpriteBatchRenderer::updateData(const SPtr<SpriteBatch::FrameData>& data)
+	{
+		mData = data;
+	}
+
+	bool SpriteBatchRenderer::check(const Camera& camera)
+	{
+		return mData != nullptr && !mData->batches.empty();
+	}
+
+	void SpriteBatchRenderer::render(const Camera& camera)
+	{
+		const Matrix4 viewProjMat = camera.getProjectionMatrixRS() * camera.getViewMatrix();
+		gSpriteBatchParamsDef.gMatViewProj.set(mParamBuffer, viewProjMat);
+
+		RenderAPI& rapi = RenderAPI::instance();
+		SpriteBatchMat* material = SpriteBatchMat::get();
+
+		for(auto& batch : mData->batches)
+		{
+			material->bind(mParamBuffer, batch.texture);
+
+			rapi.setVertexDeclaration(mVertexDecl);
+
+			SPtr<VertexBuffer> buffers[] = { mInstanceBuffer, mQuadVertices };
+			rapi.setVertexBuffers(0, buffers, (UINT32)bs_size(buffers));
+			rapi.setIndexBuffer(mQuadIndices);
+			rapi.setDrawOperation(DOT_TRIANGLE_LIST);
+
+			// Draw calls have no base instance offset, so each draw call uploads its instances to the start of the
+			// scratch buffer
+			UINT32 instanceStart = batch.start;
+			const UINT32 instanceEnd = batch.start + batch.count;
+			while(instanceStart < instanceEnd)
+			{
+				const UINT32 numInstances = std::min(instanceEnd - instanceStart, (UINT32)NUM_SCRATCH_INSTANCES);
+				const UINT32 size = numInstances * sizeof(SpriteBatch::SpriteInstance);
+
+				void* const instanceData = mInstanceBuffer->lock(GBL_WRITE_ONLY_DISCARD);
+				memcpy(instanceData, &mData->instances[instanceStart], size);
+				mInstanceBuffer->unlock();
+
+				rapi.drawIndexed(0, 6, 0, 4, numInstances);
+				instanceStart += numInstances;
+			}
+		}
+	}
+	}
+}
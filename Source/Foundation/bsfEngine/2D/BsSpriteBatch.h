@@ -0,0 +1,165 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "Utility/BsModule.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Renderer/BsRendererExtension.h"
+#include "Renderer/BsRendererMaterial.h"
+#include "Image/BsColor.h"
+#include "Math/BsVector4.h"
+#include "Math/BsRadian.h"
+
+namespace bs
+{
+	namespace ct { class SpriteBatchRenderer; }
+
+	/** @addtogroup 2D
+	 *  @{
+	 */
+
+	/**
+	 * Renders large amounts of textured quads (e.g. gameplay sprites) in the scene, independently of GUI. Sprites are
+	 * queued every frame, and are sorted by layer and texture so that all sprites sharing a layer and a texture are
+	 * rendered using a single instanced draw call. Use SpriteAtlas to pack sprite textures into shared textures, in
+	 * order to reduce the number of draw calls.
+	 */
+	class BS_EXPORT SpriteBatch : public Module<SpriteBatch>
+	{
+	public:
+		SpriteBatch();
+
+		/**
+		 * Queues a sprite to be rendered during the current frame. Sprites need to be queued again each frame.
+		 *
+		 * @param[in]	texture		Sprite texture to render the quad with. If the sprite texture is animated, the
+		 *							animation is evaluated using the current time.
+		 * @param[in]	position	Position of the center of the sprite, in world space. Sprites lie in the XY plane.
+		 * @param[in]	size		Width and height of the sprite, in world units.
+		 * @param[in]	color		Color to multiply the texture with.
+		 * @param[in]	rotation	Rotation of the sprite around its center, along the Z axis.
+		 * @param[in]	layer		Sprites in layers with lower values are rendered first, beneath the sprites in
+		 *							layers with higher values. Order of sprites within the same layer isn't defined.
+		 */
+		void draw(const HSpriteTexture& texture, const Vector3& position, const Vector2& size,
+			const Color& color = Color::White, Radian rotation = Radian(0.0f), INT32 layer = 0);
+
+		/** Returns the number of sprites queued for rendering, since the last update. */
+		UINT32 getNumQueuedSprites() const { return (UINT32)mSprites.size(); }
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Sorts the sprites queued since the last update into batches and sends them to the renderer. Must be called
+		 * once per frame.
+		 */
+		void _update();
+
+		/** @} */
+	private:
+		friend class ct::SpriteBatchRenderer;
+
+		/** Per-instance vertex data of a single sprite, as read by the shader. */
+		struct SpriteInstance
+		{
+			Vector4 positionAndRotation;
+			Vector4 sizeAndUVOffset;
+			Vector2 uvScale;
+			Color color;
+		};
+
+		/** Range of sprites using the same texture and in the same layer. */
+		struct Batch
+		{
+			SPtr<ct::Texture> texture;
+			UINT32 start;
+			UINT32 count;
+		};
+
+		/** Sprites to render in a single frame, sorted into batches. */
+		struct FrameData
+		{
+			Vector<SpriteInstance> instances;
+			Vector<Batch> batches;
+		};
+
+		/** Returns the index of the provided texture in the list of textures used this frame, adding it if needed. */
+		UINT32 getTextureIdx(const HTexture& texture);
+
+		Vector<SpriteInstance> mSprites;
+		Vector<std::pair<UINT64, UINT32>> mSortKeys;
+
+		Vector<SPtr<ct::Texture>> mTextures;
+		UnorderedMap<UINT64, UINT32> mTextureIndices;
+
+		SPtr<ct::SpriteBatchRenderer> mRenderer;
+	};
+
+	/** @} */
+
+	namespace ct
+	{
+	/** @addtogroup 2D-Internal
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(SpriteBatchParamsDef)
+		BS_PARAM_BLOCK_ENTRY(Matrix4, gMatViewProj)
+	BS_PARAM_BLOCK_END
+
+	extern SpriteBatchParamsDef gSpriteBatchParamsDef;
+
+	/** Renders instanced sprite quads queued through SpriteBatch. */
+	class SpriteBatchMat : public RendererMaterial<SpriteBatchMat>
+	{
+		RMAT_DEF("SpriteBatch.bsl");
+
+	public:
+		SpriteBatchMat();
+
+		/** Binds the material for rendering, using the provided parameters and texture. */
+		void bind(const SPtr<GpuParamBlockBuffer>& params, const SPtr<Texture>& texture);
+
+	private:
+		GpuParamTexture mTexture;
+	};
+
+	/** Performs rendering of sprites provided by SpriteBatch. */
+	class SpriteBatchRenderer : public RendererExtension
+	{
+		friend class bs::SpriteBatch;
+
+	public:
+		/** Maximum number of sprites rendered by a single draw call. Larger batches are split into multiple calls. */
+		static constexpr UINT32 NUM_SCRATCH_INSTANCES = 8192;
+
+		SpriteBatchRenderer();
+
+	private:
+		/**	@copydoc RendererExtension::initialize */
+		void initialize(const Any& data) override;
+
+		/**	@copydoc RendererExtension::check */
+		bool check(const Camera& camera) override;
+
+		/**	@copydoc RendererExtension::render */
+		void render(const Camera& camera) override;
+
+		/** Updates the sprites to render. Called once per frame with the sprites queued on the sim thread. */
+		void updateData(const SPtr<SpriteBatch::FrameData>& data);
+
+		SPtr<SpriteBatch::FrameData> mData;
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+
+		SPtr<VertexDeclaration> mVertexDecl;
+		SPtr<VertexBuffer> mInstanceBuffer;
+		SPtr<VertexBuffer> mQuadVertices;
+		SPtr<IndexBuffer> mQuadIndices;
+	};
+
+	/** @} */
+	}
+}
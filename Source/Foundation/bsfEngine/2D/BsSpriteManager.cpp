@@ -10,11 +10,13 @@ namespace bs
 		SpriteMaterial* imageTransparentMat = registerMaterial<SpriteImageTransparentMaterial>();
 		SpriteMaterial* imageOpaqueMat = registerMaterial<SpriteImageOpaqueMaterial>();
 		SpriteMaterial* textMat = registerMaterial<SpriteTextMaterial>();
+		SpriteMaterial* distanceFieldTextMat = registerMaterial<SpriteDistanceFieldTextMaterial>();
 		SpriteMaterial* lineMat = registerMaterial<SpriteLineMaterial>();
 
 		builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::ImageTransparent] = imageTransparentMat->getId();
 		builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::ImageOpaque] = imageOpaqueMat->getId();
 		builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::Text] = textMat->getId();
+		builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::DistanceFieldText] = distanceFieldTextMat->getId();
 		builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::Line] = lineMat->getId();
 	}
 
@@ -21,6 +21,7 @@ namespace bs
 			ImageTransparent,
 			ImageOpaque,
 			Text,
+			DistanceFieldText,
 			Line,
 			Count // Keep at end
 		};
@@ -41,6 +42,10 @@ namespace bs
 		SpriteMaterial* getTextMaterial() const
 			{ return getMaterial(builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::Text]); }
 
+		/** Returns the material used for rendering text sprites using fonts containing signed distance fields. */
+		SpriteMaterial* getDistanceFieldTextMaterial() const
+			{ return getMaterial(builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::DistanceFieldText]); }
+
 		/** Returns the material used for rendering antialiased lines. */
 		SpriteMaterial* getLineMaterial() const
 			{ return getMaterial(builtinMaterialIds[(UINT32)BuiltinSpriteMaterialType::Line]); }
@@ -4,6 +4,8 @@
 #include "Resources/BsBuiltinResources.h"
 #include "RenderAPI/BsGpuBuffer.h"
 #include "Material/BsMaterial.h"
+#include "Managers/BsRenderStateManager.h"
+#include "CoreThread/BsCoreThread.h"
 
 namespace bs
 {
@@ -19,6 +21,34 @@ namespace bs
 		: SpriteMaterial(2, BuiltinResources::instance().createSpriteTextMaterial())
 	{ }
 
+	SpriteDistanceFieldTextMaterial::SpriteDistanceFieldTextMaterial()
+		: SpriteMaterial(4, BuiltinResources::instance().createSpriteDistanceFieldTextMaterial())
+	{ }
+
+	SpriteDistanceFieldTextMaterial::~SpriteDistanceFieldTextMaterial()
+	{
+		// Make sure the last reference to the sampler is lost on the core thread
+		SPtr<ct::SamplerState> samplerState = mSamplerState;
+		gCoreThread().queueCommand([samplerState]() { });
+	}
+
+	void SpriteDistanceFieldTextMaterial::render(const SPtr<ct::MeshBase>& mesh, const SubMesh& subMesh,
+		const SPtr<ct::Texture>& texture, const SPtr<ct::SamplerState>& sampler,
+		const SPtr<ct::GpuParamBlockBuffer>& paramBuffer, const SPtr<SpriteMaterialExtraInfo>& additionalData) const
+	{
+		if(mSamplerState == nullptr)
+		{
+			SAMPLER_STATE_DESC ssDesc;
+			ssDesc.magFilter = FO_LINEAR;
+			ssDesc.minFilter = FO_LINEAR;
+			ssDesc.mipFilter = FO_POINT;
+
+			mSamplerState = ct::RenderStateManager::instance().createSamplerState(ssDesc);
+		}
+
+		SpriteMaterial::render(mesh, subMesh, texture, mSamplerState, paramBuffer, additionalData);
+	}
+
 	SpriteLineMaterial::SpriteLineMaterial()
 		: SpriteMaterial(3, BuiltinResources::instance().createSpriteLineMaterial())
 	{ }
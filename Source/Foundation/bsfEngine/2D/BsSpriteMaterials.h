@@ -32,6 +32,26 @@ namespace bs
 		SpriteTextMaterial();
 	};
 
+	/** 
+	 * Sprite material used for rendering text using fonts containing signed distance fields. Always samples the font
+	 * textures bilinearly, since distance fields are usually rendered at a different size than they were created at.
+	 */
+	class BS_EXPORT SpriteDistanceFieldTextMaterial : public SpriteMaterial
+	{
+	public:
+		SpriteDistanceFieldTextMaterial();
+		~SpriteDistanceFieldTextMaterial();
+
+		/** @copydoc SpriteMaterial::render */
+		void render(const SPtr<ct::MeshBase>& mesh, const SubMesh& subMesh, const SPtr<ct::Texture>& texture,
+			const SPtr<ct::SamplerState>& sampler, const SPtr<ct::GpuParamBlockBuffer>& paramBuffer,
+			const SPtr<SpriteMaterialExtraInfo>& additionalData) const override;
+
+	private:
+		// Core thread only
+		mutable SPtr<ct::SamplerState> mSamplerState;
+	};
+
 	/** Sprite material used for antialiased lines. */
 	class BS_EXPORT SpriteLineMaterial : public SpriteMaterial
 	{
@@ -5,6 +5,7 @@
 #include "Math/BsVector2.h"
 #include "2D/BsSpriteManager.h"
 #include "String/BsUnicode.h"
+#include "Text/BsFontManager.h"
 
 namespace bs
 {
@@ -20,6 +21,19 @@ namespace bs
 
 	void TextSprite::update(const TEXT_SPRITE_DESC& desc, UINT64 groupId)
 	{
+		// Most updates are caused by changes that don't affect the text itself (e.g. the parent moving), in which case
+		// the layout and the quads can be kept as is
+		if(isGeometryEqual(desc))
+		{
+			for (auto& cachedElem : mCachedRenderElements)
+			{
+				cachedElem.matInfo.groupId = groupId;
+				cachedElem.matInfo.tint = desc.color;
+			}
+
+			return;
+		}
+
 		bs_frame_mark();
 		{
 			const U32String utf32text = UTF8::toUTF32(desc.text);
@@ -28,6 +42,12 @@ namespace bs
 
 			UINT32 numPages = textData.getNumPages();
 
+			SpriteMaterial* material;
+			if (numPages > 0 && textData.isDistanceField())
+				material = SpriteManager::instance().getDistanceFieldTextMaterial();
+			else
+				material = SpriteManager::instance().getTextMaterial();
+
 			// Free all previous memory
 			for (auto& cachedElem : mCachedRenderElements)
 			{
@@ -60,7 +80,7 @@ namespace bs
 				matInfo.texture = tex;
 				matInfo.tint = desc.color;
 
-				cachedElem.material = SpriteManager::instance().getTextMaterial();
+				cachedElem.material = material;
 
 				texPage++;
 			}
@@ -77,9 +97,34 @@ namespace bs
 
 		bs_frame_clear();
 
+		mGeometryDesc = desc;
+		mGeometryFontLoaded = desc.font.isLoaded();
+		mGeometryAtlasVersion = FontManager::instance().getAtlasVersion();
+		mHasGeometry = true;
+
 		updateBounds();
 	}
 
+	bool TextSprite::isGeometryEqual(const TEXT_SPRITE_DESC& desc) const
+	{
+		if(!mHasGeometry)
+			return false;
+
+		// Font that finished loading since the last update changes the layout even though the handle stays the same
+		if(desc.font != mGeometryDesc.font || desc.font.isLoaded() != mGeometryFontLoaded)
+			return false;
+
+		// Characters of a dynamic font might have moved within its atlas since the quads were generated
+		if(FontManager::instance().getAtlasVersion() != mGeometryAtlasVersion)
+			return false;
+
+		return desc.width == mGeometryDesc.width && desc.height == mGeometryDesc.height &&
+			desc.anchor == mGeometryDesc.anchor && desc.fontSize == mGeometryDesc.fontSize &&
+			desc.horzAlign == mGeometryDesc.horzAlign && desc.vertAlign == mGeometryDesc.vertAlign &&
+			desc.wordWrap == mGeometryDesc.wordWrap && desc.wordBreak == mGeometryDesc.wordBreak &&
+			desc.text == mGeometryDesc.text;
+	}
+
 	UINT32 TextSprite::genTextQuads(UINT32 page, const TextDataBase& textData, UINT32 width, UINT32 height,
 		TextHorzAlign horzAlign, TextVertAlign vertAlign, SpriteAnchor anchor, Vector2* vertices, Vector2* uv, UINT32* indices, UINT32 bufferSizeQuads)
 	{
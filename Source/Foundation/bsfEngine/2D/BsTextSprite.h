@@ -57,7 +57,9 @@ namespace bs
 		~TextSprite();
 
 		/**
-		 * Recreates internal sprite data according the specified description structure.
+		 * Recreates internal sprite data according the specified description structure. Text layout and geometry are
+		 * only regenerated if the properties affecting them changed since the last update, otherwise only the material
+		 * information is refreshed.
 		 *
 		 * @param[in]	desc	Describes the geometry and material of the sprite.
 		 * @param[in]	groupId	Group identifier that forces different materials to be used for different groups (for 
@@ -133,7 +135,15 @@ namespace bs
 		/**	Clears internal geometry buffers. */
 		void clearMesh();
 
+		/** Checks would the provided description result in the same geometry as the currently generated one. */
+		bool isGeometryEqual(const TEXT_SPRITE_DESC& desc) const;
+
 		mutable StaticAlloc<STATIC_BUFFER_SIZE> mAlloc;
+
+		TEXT_SPRITE_DESC mGeometryDesc;
+		bool mGeometryFontLoaded = false;
+		UINT64 mGeometryAtlasVersion = 0;
+		bool mHasGeometry = false;
 	};
 
 	/** @} */
@@ -19,6 +19,7 @@
 #include "Renderer/BsRendererManager.h"
 #include "Renderer/BsRendererMaterialManager.h"
 #include "Debug/BsDebugDraw.h"
+#include "2D/BsSpriteBatch.h"
 #include "Platform/BsPlatform.h"
 #include "Resources/BsEngineShaderIncludeHandler.h"
 #include "Resources/BsResources.h"
@@ -56,8 +57,13 @@ namespace bs
 
 		VirtualInput::startUp();
 		BuiltinResources::startUp();
+		recordStartUpStage("Builtin resources");
+
 		RendererMaterialManager::startUp();
+		BuiltinResources::instance()._releaseStartUpResources();
 		RendererManager::instance().initialize();
+		recordStartUpStage("Renderer materials");
+
 		SpriteManager::startUp();
 		GUIManager::startUp();
 		ShortcutManager::startUp();
@@ -68,11 +74,15 @@ namespace bs
 
 		SceneManager::instance().setMainRenderTarget(getPrimaryWindow());
 		DebugDraw::startUp();
+		SpriteBatch::startUp();
 
 		ScriptManager::startUp();
 
 		if(mStartUpDesc.scripting)
 			loadScriptSystem();
+
+		recordStartUpStage("GUI and scripting");
+		logStartUpTimings();
 	}
 
 	void Application::onShutDown()
@@ -88,6 +98,7 @@ namespace bs
 		ShortcutManager::shutDown();
 
 		ScriptManager::shutDown();
+		SpriteBatch::shutDown();
 		DebugDraw::shutDown();
 
 		if (mStartUpDesc.scripting)
@@ -110,8 +121,13 @@ namespace bs
 	{
 		CoreApplication::postUpdate();
 
-		PROFILE_CALL(GUIManager::instance().update(), "GUI");
+		{
+			MemoryTagScope memoryTagScope(MemoryTag::GUI);
+			PROFILE_CALL(GUIManager::instance().update(), "GUI");
+		}
+
 		DebugDraw::instance()._update();
+		SpriteBatch::instance()._update();
 	}
 
 	void Application::showProfilerOverlay(ProfilerOverlayType type, const SPtr<Camera>& camera)
@@ -122,7 +122,7 @@
 
 namespace bs
 {
-	static const StringID RendererDefault = "RenderBeast";
+	static const StringID RendererDefault = BS_SID("RenderBeast");
 
 	class VirtualButton;
 	class VirtualInput;
@@ -146,6 +146,7 @@ namespace bs
 	class GUIScrollBarVert;
 	class GUIScrollBarHorz;
 	class GUIScrollArea;
+	class GUIVirtualList;
 	class GUISkin;
 	class GUIRenderTexture;
 	struct GUIElementStyle;
@@ -195,6 +196,8 @@ namespace bs
 	class ImageSprite;
 	class SpriteMaterial;
 	struct SpriteMaterialInfo;
+	class SpriteBatch;
+	class SpriteAtlas;
 
 	typedef GameObjectHandle<CGUIWidget> HGUIWidget;
 	typedef GameObjectHandle<CProfilerOverlay> HProfilerOverlay;
@@ -39,6 +39,7 @@ set(BS_ENGINE_SRC_GUI
 	"bsfEngine/GUI/BsGUIScrollBarVert.cpp"
 	"bsfEngine/GUI/BsGUIScrollBarHorz.cpp"
 	"bsfEngine/GUI/BsGUIScrollArea.cpp"
+	"bsfEngine/GUI/BsGUIVirtualList.cpp"
 	"bsfEngine/GUI/BsGUIScrollBar.cpp"
 	"bsfEngine/GUI/BsGUIToggleGroup.cpp"
 	"bsfEngine/GUI/BsDragAndDropManager.cpp"
@@ -100,6 +101,8 @@ set(BS_ENGINE_SRC_2D
 	"bsfEngine/2D/BsSpriteMaterial.cpp"
 	"bsfEngine/2D/BsSpriteMaterials.cpp"
 	"bsfEngine/2D/BsSpriteManager.cpp"
+	"bsfEngine/2D/BsSpriteBatch.cpp"
+	"bsfEngine/2D/BsSpriteAtlas.cpp"
 )
 
 set(BS_ENGINE_SRC_UTILITY
@@ -125,6 +128,8 @@ set(BS_ENGINE_INC_2D
 	"bsfEngine/2D/BsSpriteMaterial.h"
 	"bsfEngine/2D/BsSpriteMaterials.h"
 	"bsfEngine/2D/BsSpriteManager.h"
+	"bsfEngine/2D/BsSpriteBatch.h"
+	"bsfEngine/2D/BsSpriteAtlas.h"
 )
 
 set(BS_ENGINE_INC_RTTI
@@ -210,6 +215,7 @@ set(BS_ENGINE_INC_GUI
 	"bsfEngine/GUI/BsGUIScrollBarVert.h"
 	"bsfEngine/GUI/BsGUIScrollBarHorz.h"
 	"bsfEngine/GUI/BsGUIScrollArea.h"
+	"bsfEngine/GUI/BsGUIVirtualList.h"
 	"bsfEngine/GUI/BsGUIScrollBar.h"
 	"bsfEngine/GUI/BsGUIToggleGroup.h"
 	"bsfEngine/GUI/BsDragAndDropManager.h"
@@ -17,97 +17,130 @@
 #include "Resources/BsBuiltinResources.h"
 #include "Renderer/BsCamera.h"
 #include "Profiling/BsProfilerGPU.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsIndexBuffer.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+#include "Mesh/BsMeshData.h"
+#include "Math/BsAABox.h"
+#include "Math/BsSphere.h"
 
 using namespace std::placeholders;
 
 namespace bs
 {
 	DebugDraw::DebugDraw()
-		: mDrawHelper(nullptr)
 	{
-		mDrawHelper = bs_new<DrawHelper>();
+		mGroups[DEFAULT_GROUP];
 		mRenderer = RendererExtension::create<ct::DebugDrawRenderer>(nullptr);
 	}
 
-	DebugDraw::~DebugDraw()
-	{
-		bs_delete(mDrawHelper);
-	}
-
 	void DebugDraw::setColor(const Color& color)
 	{
-		mDrawHelper->setColor(color);
+		mColor = color;
+		getActiveGroup().drawHelper.setColor(color);
 	}
 
 	void DebugDraw::setTransform(const Matrix4& transform)
 	{
-		mDrawHelper->setTransform(transform);
+		mTransform = transform;
+		getActiveGroup().drawHelper.setTransform(transform);
 	}
 
 	void DebugDraw::drawCube(const Vector3& position, const Vector3& extents)
 	{
-		mDrawHelper->cube(position, extents);
+		addInstance(InstancedShape::SolidCube, Matrix4::TRS(position, Quaternion::IDENTITY, extents));
 	}
 
 	void DebugDraw::drawSphere(const Vector3& position, float radius)
 	{
-		mDrawHelper->sphere(position, radius);
+		addInstance(InstancedShape::SolidSphere, Matrix4::TRS(position, Quaternion::IDENTITY, Vector3::ONE * radius));
 	}
 
 	void DebugDraw::drawCone(const Vector3& base, const Vector3& normal, float height, float radius, const Vector2& scale)
 	{
-		mDrawHelper->cone(base, normal, height, radius, scale);
+		Group& group = getActiveGroup();
+		group.drawHelper.cone(base, normal, height, radius, scale);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawDisc(const Vector3& position, const Vector3& normal, float radius)
 	{
-		mDrawHelper->disc(position, normal, radius);
+		Group& group = getActiveGroup();
+		group.drawHelper.disc(position, normal, radius);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawWireCube(const Vector3& position, const Vector3& extents)
 	{
-		mDrawHelper->wireCube(position, extents);
+		addInstance(InstancedShape::WireCube, Matrix4::TRS(position, Quaternion::IDENTITY, extents));
 	}
 
 	void DebugDraw::drawWireSphere(const Vector3& position, float radius)
 	{
-		mDrawHelper->wireSphere(position, radius);
+		addInstance(InstancedShape::WireSphere, Matrix4::TRS(position, Quaternion::IDENTITY, Vector3::ONE * radius));
 	}
 
 	void DebugDraw::drawWireCone(const Vector3& base, const Vector3& normal, float height, float radius, const Vector2& scale)
 	{
-		mDrawHelper->wireCone(base, normal, height, radius, scale);
+		Group& group = getActiveGroup();
+		group.drawHelper.wireCone(base, normal, height, radius, scale);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawLine(const Vector3& start, const Vector3& end)
 	{
-		mDrawHelper->line(start, end);
+		// Maps the unit line along the X axis onto the line from start to end
+		const Vector3 diff = end - start;
+		const Matrix4 transform(
+			diff.x, 0.0f, 0.0f, start.x,
+			diff.y, 0.0f, 0.0f, start.y,
+			diff.z, 0.0f, 0.0f, start.z,
+			0.0f, 0.0f, 0.0f, 1.0f);
+
+		addInstance(InstancedShape::Line, transform);
 	}
 
 	void DebugDraw::drawLineList(const Vector<Vector3>& linePoints)
 	{
-		mDrawHelper->lineList(linePoints);
+		Group& group = getActiveGroup();
+		group.drawHelper.lineList(linePoints);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawWireDisc(const Vector3& position, const Vector3& normal, float radius)
 	{
-		mDrawHelper->wireDisc(position, normal, radius);
+		Group& group = getActiveGroup();
+		group.drawHelper.wireDisc(position, normal, radius);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawWireArc(const Vector3& position, const Vector3& normal, float radius, 
 		Degree startAngle, Degree amountAngle)
 	{
-		mDrawHelper->wireArc(position, normal, radius, startAngle, amountAngle);
+		Group& group = getActiveGroup();
+		group.drawHelper.wireArc(position, normal, radius, startAngle, amountAngle);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawWireMesh(const SPtr<MeshData>& meshData)
 	{
-		mDrawHelper->wireMesh(meshData);
+		Group& group = getActiveGroup();
+		group.drawHelper.wireMesh(meshData);
+		group.dirty = true;
 	}
 
 	void DebugDraw::drawFrustum(const Vector3& position, float aspect, Degree FOV, float near, float far)
 	{
-		mDrawHelper->frustum(position, aspect, FOV, near, far);
+		Group& group = getActiveGroup();
+		group.drawHelper.frustum(position, aspect, FOV, near, far);
+		group.dirty = true;
+	}
+
+	void DebugDraw::addInstance(InstancedShape shape, const Matrix4& transform)
+	{
+		Group& group = getActiveGroup();
+		group.instances[(UINT32)shape].push_back({ mTransform * transform, mColor });
+		group.dirty = true;
 	}
 
 	Vector<DebugDraw::MeshRenderData> DebugDraw::createMeshProxyData(const Vector<DrawHelper::ShapeMeshData>& meshData)
@@ -128,18 +161,87 @@ namespace bs
 
 	void DebugDraw::clear()
 	{
-		mDrawHelper->clear();
+		Group& group = getActiveGroup();
+		group.drawHelper.clear();
+
+		for (auto& instances : group.instances)
+			instances.clear();
+
+		group.dirty = true;
 	}
 
-	void DebugDraw::_update()
+	UINT32 DebugDraw::createGroup()
+	{
+		const UINT32 groupId = mNextGroupId++;
+
+		Group& group = mGroups[groupId];
+		group.drawHelper.setColor(mColor);
+		group.drawHelper.setTransform(mTransform);
+
+		return groupId;
+	}
+
+	void DebugDraw::destroyGroup(UINT32 group)
+	{
+		if (group == DEFAULT_GROUP)
+			return;
+
+		auto iterFind = mGroups.find(group);
+		if (iterFind == mGroups.end())
+			return;
+
+		mGroups.erase(iterFind);
+		mDestroyedGroups.push_back(group);
+
+		if (mActiveGroup == group)
+			setGroup(DEFAULT_GROUP);
+	}
+
+	void DebugDraw::setGroup(UINT32 group)
 	{
-		mActiveMeshes.clear();
-		mActiveMeshes = mDrawHelper->buildMeshes(DrawHelper::SortType::None);
+		if (mGroups.find(group) == mGroups.end())
+		{
+			LOGWRN("Cannot activate debug draw group " + toString(group) + ", it doesn't exist.");
+			return;
+		}
+
+		mActiveGroup = group;
 
-		Vector<MeshRenderData> proxyData = createMeshProxyData(mActiveMeshes);
+		Group& activeGroup = getActiveGroup();
+		activeGroup.drawHelper.setColor(mColor);
+		activeGroup.drawHelper.setTransform(mTransform);
+	}
 
+	void DebugDraw::_update()
+	{
 		ct::DebugDrawRenderer* renderer = mRenderer.get();
-		gCoreThread().queueCommand(std::bind(&ct::DebugDrawRenderer::updateData, renderer, proxyData));
+
+		for (auto& groupId : mDestroyedGroups)
+			gCoreThread().queueCommand(std::bind(&ct::DebugDrawRenderer::destroyGroup, renderer, groupId));
+
+		mDestroyedGroups.clear();
+
+		// Only groups whose shapes changed since the last update need to be rebuilt, others keep their meshes and
+		// instance buffers from earlier frames
+		for (auto& entry : mGroups)
+		{
+			Group& group = entry.second;
+			if (!group.dirty)
+				continue;
+
+			group.meshes = group.drawHelper.buildMeshes(DrawHelper::SortType::None);
+
+			SPtr<GroupRenderData> renderData = bs_shared_ptr_new<GroupRenderData>();
+			renderData->meshes = createMeshProxyData(group.meshes);
+
+			for (UINT32 i = 0; i < (UINT32)InstancedShape::Count; i++)
+				renderData->instances[i] = group.instances[i];
+
+			gCoreThread().queueCommand(std::bind(&ct::DebugDrawRenderer::updateGroup, renderer, entry.first,
+				renderData));
+
+			group.dirty = false;
+		}
 	}
 
 	namespace ct
@@ -152,25 +254,43 @@ namespace bs
 		// Do nothing
 	}
 
+	void DebugDrawMat::bind(const SPtr<GpuParamBlockBuffer>& params)
+	{
+		mParams->setParamBlockBuffer("Params", params);
+
+		RendererMaterial::bind();
+	}
+
 	void DebugDrawMat::execute(const SPtr<GpuParamBlockBuffer>& params, const SPtr<Mesh>& mesh, const SubMesh& subMesh)
 	{
 		BS_RENMAT_PROFILE_BLOCK
 
-		mParams->setParamBlockBuffer("Params", params);
-
-		bind();
+		bind(params);
 		gRendererUtility().draw(mesh, subMesh);
 	}
 
-	DebugDrawMat* DebugDrawMat::getVariation(DebugDrawMaterial mat)
+	DebugDrawMat* DebugDrawMat::getVariation(DebugDrawMaterial mat, bool instanced)
 	{
 		if (mat == DebugDrawMaterial::Solid)
-			return get(getVariation<true, false, false>());
+		{
+			if (instanced)
+				return get(getVariation<true, false, false, true>());
+
+			return get(getVariation<true, false, false, false>());
+		}
 		
 		if (mat == DebugDrawMaterial::Wire)
-			return get(getVariation<false, false, true>());
+		{
+			if (instanced)
+				return get(getVariation<false, false, true, true>());
+
+			return get(getVariation<false, false, true, false>());
+		}
+
+		if (instanced)
+			return get(getVariation<false, true, false, true>());
 
-		return get(getVariation<false, true, false>());
+		return get(getVariation<false, true, false, false>());
 	}
 
 	DebugDrawRenderer::DebugDrawRenderer()
@@ -183,11 +303,126 @@ namespace bs
 		THROW_IF_NOT_CORE_THREAD;
 
 		mParamBuffer = gDebugDrawParamsDef.createBuffer();
+
+		// Stream 0 contains the shared shape mesh, stream 1 the per-instance transform and color
+		SPtr<VertexDataDesc> solidDesc = bs_shared_ptr_new<VertexDataDesc>();
+		solidDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		solidDesc->addVertElem(VET_FLOAT3, VES_NORMAL);
+
+		SPtr<VertexDataDesc> wireDesc = bs_shared_ptr_new<VertexDataDesc>();
+		wireDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+
+		SPtr<VertexDataDesc> solidInstancedDesc = bs_shared_ptr_new<VertexDataDesc>();
+		solidInstancedDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+		solidInstancedDesc->addVertElem(VET_FLOAT3, VES_NORMAL);
+
+		SPtr<VertexDataDesc> wireInstancedDesc = bs_shared_ptr_new<VertexDataDesc>();
+		wireInstancedDesc->addVertElem(VET_FLOAT3, VES_POSITION);
+
+		for (auto& desc : { solidInstancedDesc, wireInstancedDesc })
+		{
+			desc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 0, 1, 1); // Transform, first row
+			desc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 1, 1, 1); // Transform, second row
+			desc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 2, 1, 1); // Transform, third row
+			desc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 3, 1, 1); // Transform, fourth row
+			desc->addVertElem(VET_FLOAT4, VES_TEXCOORD, 4, 1, 1); // Color
+		}
+
+		UINT32 numVertices, numIndices;
+
+		ShapeMeshes3D::getNumElementsAABox(numVertices, numIndices);
+		SPtr<MeshData> solidCube = bs_shared_ptr_new<MeshData>(numVertices, numIndices, solidDesc);
+		ShapeMeshes3D::solidAABox(AABox(-Vector3::ONE, Vector3::ONE), solidCube, 0, 0);
+
+		ShapeMeshes3D::getNumElementsSphere(SPHERE_QUALITY, numVertices, numIndices);
+		SPtr<MeshData> solidSphere = bs_shared_ptr_new<MeshData>(numVertices, numIndices, solidDesc);
+		ShapeMeshes3D::solidSphere(Sphere(Vector3::ZERO, 1.0f), solidSphere, 0, 0, SPHERE_QUALITY);
+
+		ShapeMeshes3D::getNumElementsWireAABox(numVertices, numIndices);
+		SPtr<MeshData> wireCube = bs_shared_ptr_new<MeshData>(numVertices, numIndices, wireDesc);
+		ShapeMeshes3D::wireAABox(AABox(-Vector3::ONE, Vector3::ONE), wireCube, 0, 0);
+
+		ShapeMeshes3D::getNumElementsWireSphere(WIRE_SPHERE_QUALITY, numVertices, numIndices);
+		SPtr<MeshData> wireSphere = bs_shared_ptr_new<MeshData>(numVertices, numIndices, wireDesc);
+		ShapeMeshes3D::wireSphere(Sphere(Vector3::ZERO, 1.0f), wireSphere, 0, 0, WIRE_SPHERE_QUALITY);
+
+		SPtr<MeshData> line = bs_shared_ptr_new<MeshData>(2, 2, wireDesc);
+		ShapeMeshes3D::pixelLine(Vector3::ZERO, Vector3::UNIT_X, line, 0, 0);
+
+		mShapeMeshes[(UINT32)DebugDraw::InstancedShape::SolidCube] =
+			createShapeMesh(solidCube, solidInstancedDesc, DOT_TRIANGLE_LIST, DebugDrawMaterial::Solid);
+		mShapeMeshes[(UINT32)DebugDraw::InstancedShape::SolidSphere] =
+			createShapeMesh(solidSphere, solidInstancedDesc, DOT_TRIANGLE_LIST, DebugDrawMaterial::Solid);
+		mShapeMeshes[(UINT32)DebugDraw::InstancedShape::WireCube] =
+			createShapeMesh(wireCube, wireInstancedDesc, DOT_LINE_LIST, DebugDrawMaterial::Wire);
+		mShapeMeshes[(UINT32)DebugDraw::InstancedShape::WireSphere] =
+			createShapeMesh(wireSphere, wireInstancedDesc, DOT_LINE_LIST, DebugDrawMaterial::Wire);
+		mShapeMeshes[(UINT32)DebugDraw::InstancedShape::Line] =
+			createShapeMesh(line, wireInstancedDesc, DOT_LINE_LIST, DebugDrawMaterial::Line);
+	}
+
+	DebugDrawRenderer::ShapeMesh DebugDrawRenderer::createShapeMesh(const SPtr<MeshData>& meshData,
+		const SPtr<VertexDataDesc>& vertexDesc, DrawOperationType drawOp, DebugDrawMaterial material)
+	{
+		ShapeMesh shapeMesh;
+		shapeMesh.vertexDecl = VertexDeclaration::create(vertexDesc);
+		shapeMesh.numIndices = meshData->getNumIndices();
+		shapeMesh.drawOp = drawOp;
+		shapeMesh.material = material;
+
+		VERTEX_BUFFER_DESC vertexBufferDesc;
+		vertexBufferDesc.numVerts = meshData->getNumVertices();
+		vertexBufferDesc.vertexSize = vertexDesc->getVertexStride(0);
+
+		shapeMesh.vertexBuffer = VertexBuffer::create(vertexBufferDesc);
+		shapeMesh.vertexBuffer->writeData(0, meshData->getStreamSize(0), meshData->getStreamData(0), BWT_DISCARD);
+
+		INDEX_BUFFER_DESC indexBufferDesc;
+		indexBufferDesc.indexType = IT_32BIT;
+		indexBufferDesc.numIndices = meshData->getNumIndices();
+
+		shapeMesh.indexBuffer = IndexBuffer::create(indexBufferDesc);
+		shapeMesh.indexBuffer->writeData(0, meshData->getIndexBufferSize(), meshData->getIndices32(), BWT_DISCARD);
+
+		return shapeMesh;
+	}
+
+	void DebugDrawRenderer::updateGroup(UINT32 group, const SPtr<DebugDraw::GroupRenderData>& data)
+	{
+		GroupData& groupData = mGroups[group];
+		groupData.meshes = data->meshes;
+
+		for (UINT32 i = 0; i < (UINT32)DebugDraw::InstancedShape::Count; i++)
+		{
+			const Vector<DebugDraw::ShapeInstance>& instances = data->instances[i];
+			const auto numInstances = (UINT32)instances.size();
+
+			groupData.numInstances[i] = numInstances;
+			if (numInstances == 0)
+			{
+				groupData.instanceBuffers[i] = nullptr;
+				continue;
+			}
+
+			// Instances are uploaded once and then re-used until the group changes
+			SPtr<VertexBuffer>& instanceBuffer = groupData.instanceBuffers[i];
+			if (instanceBuffer == nullptr || instanceBuffer->getProperties().getNumVertices() < numInstances)
+			{
+				VERTEX_BUFFER_DESC instanceBufferDesc;
+				instanceBufferDesc.numVerts = numInstances;
+				instanceBufferDesc.vertexSize = sizeof(DebugDraw::ShapeInstance);
+
+				instanceBuffer = VertexBuffer::create(instanceBufferDesc);
+			}
+
+			const UINT32 size = numInstances * sizeof(DebugDraw::ShapeInstance);
+			instanceBuffer->writeData(0, size, instances.data(), BWT_DISCARD);
+		}
 	}
 
-	void DebugDrawRenderer::updateData(const Vector<DebugDraw::MeshRenderData>& meshes)
+	void DebugDrawRenderer::destroyGroup(UINT32 group)
 	{
-		mMeshes = meshes;
+		mGroups.erase(group);
 	}
 
 	bool DebugDrawRenderer::check(const Camera& camera)
@@ -208,10 +443,34 @@ namespace bs
 		gDebugDrawParamsDef.gMatViewProj.set(mParamBuffer, viewProjMat);
 		gDebugDrawParamsDef.gViewDir.set(mParamBuffer, (Vector4)camera.getTransform().getForward());
 
-		for (auto& entry : mMeshes)
+		RenderAPI& rapi = RenderAPI::instance();
+		for (auto& groupEntry : mGroups)
 		{
-			DebugDrawMat* mat = DebugDrawMat::getVariation(entry.type);
-			mat->execute(mParamBuffer, entry.mesh, entry.subMesh);
+			const GroupData& group = groupEntry.second;
+			for (auto& entry : group.meshes)
+			{
+				DebugDrawMat* mat = DebugDrawMat::getVariation(entry.type);
+				mat->execute(mParamBuffer, entry.mesh, entry.subMesh);
+			}
+
+			for (UINT32 i = 0; i < (UINT32)DebugDraw::InstancedShape::Count; i++)
+			{
+				if (group.numInstances[i] == 0)
+					continue;
+
+				const ShapeMesh& shapeMesh = mShapeMeshes[i];
+
+				DebugDrawMat* mat = DebugDrawMat::getVariation(shapeMesh.material, true);
+				mat->bind(mParamBuffer);
+
+				SPtr<VertexBuffer> buffers[] = { shapeMesh.vertexBuffer, group.instanceBuffers[i] };
+				rapi.setVertexDeclaration(shapeMesh.vertexDecl);
+				rapi.setVertexBuffers(0, buffers, (UINT32)bs_size(buffers));
+				rapi.setIndexBuffer(shapeMesh.indexBuffer);
+				rapi.setDrawOperation(shapeMesh.drawOp);
+				rapi.drawIndexed(0, shapeMesh.numIndices, 0, shapeMesh.vertexBuffer->getProperties().getNumVertices(),
+					group.numInstances[i]);
+			}
 		}
 	}
 	}
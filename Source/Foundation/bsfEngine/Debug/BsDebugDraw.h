@@ -23,12 +23,21 @@ namespace bs
 		Solid, Wire, Line
 	};
 
-	/** Provides an easy access to draw basic 2D and 3D shapes, primarily meant for debugging purposes. */
+	/**
+	 * Provides an easy access to draw basic 2D and 3D shapes, primarily meant for debugging purposes.
+	 *
+	 * Shapes persist until they are cleared, and their geometry is only rebuilt on frames when shapes were added or
+	 * cleared. Shapes can be split into groups so that shapes that rarely change (e.g. static level geometry) don't
+	 * get rebuilt when others do. Cubes, spheres and lines are rendered by instancing a single shared mesh, which makes
+	 * them significantly cheaper to draw in large numbers than the other shapes.
+	 */
 	class BS_EXPORT DebugDraw : public Module<DebugDraw>
 	{
 	public:
+		/** Identifier of the group that is active by default, and that cannot be destroyed. */
+		static constexpr UINT32 DEFAULT_GROUP = 0;
+
 		DebugDraw();
-		~DebugDraw();
 
 		/**	Changes the color of any further draw calls. */
 		void setColor(const Color& color);
@@ -139,10 +148,33 @@ namespace bs
 		void drawFrustum(const Vector3& position, float aspect, Degree FOV, float near, float far);
 
 		/**
-		 * Clears any objects that are currently drawing. All objects must be re-queued.
+		 * Clears any objects that are currently drawing in the active group. All objects must be re-queued.
 		 */
 		void clear();
 
+		/**
+		 * Creates a new group of shapes. Shapes in a group are only rebuilt when the shapes in that group change. Use
+		 * setGroup() to draw shapes into the group.
+		 *
+		 * @return	Identifier of the new group.
+		 */
+		UINT32 createGroup();
+
+		/**
+		 * Clears and destroys a group created by createGroup(). If the group is active the default group is activated
+		 * instead.
+		 */
+		void destroyGroup(UINT32 group);
+
+		/**
+		 * Changes the group that any further draw calls, and calls to clear(), apply to. Color and transform are kept
+		 * when switching groups.
+		 */
+		void setGroup(UINT32 group);
+
+		/** @copydoc setGroup */
+		UINT32 getGroup() const { return mActiveGroup; }
+
 		/** Performs per-frame operations. */
 		void _update();
 
@@ -161,11 +193,51 @@ namespace bs
 			DebugDrawMaterial type;
 		};
 
+		/** Shapes rendered by instancing a shared mesh. */
+		enum class InstancedShape
+		{
+			SolidCube, SolidSphere, WireCube, WireSphere, Line, Count
+		};
+
+		/** Per-instance vertex data of a single instanced shape, as read by the shader. */
+		struct ShapeInstance
+		{
+			Matrix4 transform;
+			Color color;
+		};
+
+		/** Data required for rendering all the shapes in a single group. */
+		struct GroupRenderData
+		{
+			Vector<MeshRenderData> meshes;
+			Vector<ShapeInstance> instances[(UINT32)InstancedShape::Count];
+		};
+
+		/** Shapes drawn into a single group. */
+		struct Group
+		{
+			DrawHelper drawHelper;
+			Vector<DrawHelper::ShapeMeshData> meshes;
+			Vector<ShapeInstance> instances[(UINT32)InstancedShape::Count];
+			bool dirty = false;
+		};
+
 		/** Converts mesh data from DrawHelper into mesh data usable by the debug draw renderer. */
 		Vector<MeshRenderData> createMeshProxyData(const Vector<DrawHelper::ShapeMeshData>& meshData);
 
-		DrawHelper* mDrawHelper;
-		Vector<DrawHelper::ShapeMeshData> mActiveMeshes;
+		/** Queues an instance of a shape in the active group, transformed by the provided transform. */
+		void addInstance(InstancedShape shape, const Matrix4& transform);
+
+		/** Returns the group that draw calls are currently applied to. */
+		Group& getActiveGroup() { return mGroups[mActiveGroup]; }
+
+		Map<UINT32, Group> mGroups;
+		Vector<UINT32> mDestroyedGroups;
+		UINT32 mActiveGroup = DEFAULT_GROUP;
+		UINT32 mNextGroupId = DEFAULT_GROUP + 1;
+
+		Color mColor;
+		Matrix4 mTransform = Matrix4::IDENTITY;
 
 		SPtr<ct::DebugDrawRenderer> mRenderer;
 	};
@@ -191,14 +263,15 @@ namespace bs
 		RMAT_DEF("DebugDraw.bsl");
 
 		/** Helper method used for initializing variations of this material. */
-		template<bool solid, bool line, bool wire>
+		template<bool solid, bool line, bool wire, bool instanced>
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
 			{
 				ShaderVariation::Param("SOLID", solid),
 				ShaderVariation::Param("LINE", line),
-				ShaderVariation::Param("WIRE", wire)
+				ShaderVariation::Param("WIRE", wire),
+				ShaderVariation::Param("INSTANCED", instanced)
 			});
 
 			return variation;
@@ -206,11 +279,20 @@ namespace bs
 	public:
 		DebugDrawMat();
 
+		/** Binds the material for rendering, using the provided parameters. */
+		void bind(const SPtr<GpuParamBlockBuffer>& params);
+
 		/** Executes the material using the provided parameters. */
 		void execute(const SPtr<GpuParamBlockBuffer>& params, const SPtr<Mesh>& mesh, const SubMesh& subMesh);
 
-		/** Returns the material variation matching the provided parameters. */
-		static DebugDrawMat* getVariation(DebugDrawMaterial drawMat);
+		/**
+		 * Returns the material variation matching the provided parameters.
+		 *
+		 * @param[in]	drawMat		Type of material to return.
+		 * @param[in]	instanced	If true, returns a variation that reads the shape transform and color from
+		 *							per-instance vertex data, instead of expecting pre-transformed vertices.
+		 */
+		static DebugDrawMat* getVariation(DebugDrawMaterial drawMat, bool instanced = false);
 	};
 
 	/** Performs rendering of meshes provided by DebugDraw. */
@@ -219,6 +301,12 @@ namespace bs
 		friend class bs::DebugDraw;
 
 	public:
+		/** Tessellation quality of the instanced solid sphere mesh. Matches the default used by DrawHelper. */
+		static constexpr UINT32 SPHERE_QUALITY = 1;
+
+		/** Tessellation quality of the instanced wireframe sphere mesh. Matches the default used by DrawHelper. */
+		static constexpr UINT32 WIRE_SPHERE_QUALITY = 10;
+
 		DebugDrawRenderer();
 
 	private:
@@ -231,15 +319,46 @@ namespace bs
 		/**	@copydoc RendererExtension::render */
 		void render(const Camera& camera) override;
 
+		/** Mesh shared by all instances of a particular instanced shape. */
+		struct ShapeMesh
+		{
+			SPtr<VertexDeclaration> vertexDecl;
+			SPtr<VertexBuffer> vertexBuffer;
+			SPtr<IndexBuffer> indexBuffer;
+			UINT32 numIndices = 0;
+			DrawOperationType drawOp = DOT_TRIANGLE_LIST;
+			DebugDrawMaterial material = DebugDrawMaterial::Solid;
+		};
+
+		/** Render data of a single group of shapes. Instance buffers are only re-created when the group changes. */
+		struct GroupData
+		{
+			Vector<DebugDraw::MeshRenderData> meshes;
+			SPtr<VertexBuffer> instanceBuffers[(UINT32)DebugDraw::InstancedShape::Count];
+			UINT32 numInstances[(UINT32)DebugDraw::InstancedShape::Count] = { };
+		};
+
 		/**
-		 * Updates the internal data that is used for rendering. Normally you would call this after updating the meshes
-		 * on the sim thread.
+		 * Creates a shape mesh from the provided mesh data. Vertices of the mesh data are expected to match the first
+		 * stream of @p vertexDesc, while the second stream is expected to contain the per-instance data.
+		 */
+		static ShapeMesh createShapeMesh(const SPtr<MeshData>& meshData, const SPtr<VertexDataDesc>& vertexDesc,
+			DrawOperationType drawOp, DebugDrawMaterial material);
+
+		/**
+		 * Updates the data used for rendering a group of shapes. Normally you would call this after the shapes in the
+		 * group change on the sim thread.
 		 *
-		 * @param[in]	meshes			Meshes to render.
+		 * @param[in]	group	Identifier of the group to update.
+		 * @param[in]	data	Meshes and shape instances to render for the group.
 		 */
-		void updateData(const Vector<DebugDraw::MeshRenderData>& meshes);
+		void updateGroup(UINT32 group, const SPtr<DebugDraw::GroupRenderData>& data);
+
+		/** Stops rendering the shapes in the specified group. */
+		void destroyGroup(UINT32 group);
 
-		Vector<DebugDraw::MeshRenderData> mMeshes;
+		Map<UINT32, GroupData> mGroups;
+		ShapeMesh mShapeMeshes[(UINT32)DebugDraw::InstancedShape::Count];
 		SPtr<GpuParamBlockBuffer> mParamBuffer;
 	};
 
@@ -93,12 +93,39 @@ namespace bs
 		// Preserve element depth as that is not controlled by layout but is stored
 		// there only for convenience
 		UINT8 elemDepth = _getElementDepth();
-		GUIElementBase::_setLayoutData(data);
-		_setElementDepth(elemDepth);
+
+		GUILayoutData newData = data;
+		newData.depth = elemDepth | (data.depth & 0xFFFFFF00);
+
+		// Only elements that actually moved or resized need their contents rebuilt after a layout update
+		if (newData != mLayoutData)
+			_markContentAsDirty();
+
+		GUIElementBase::_setLayoutData(newData);
+		_markMeshAsDirty();
 
 		updateClippedBounds();
 	}
 
+	void GUIElement::_updateOptimalLayoutSizes()
+	{
+		GUIElementBase::_updateOptimalLayoutSizes();
+
+		if ((mFlags & GUIElem_SizeDirty) != 0 || !mChildren.empty())
+		{
+			mCachedSizeRange = _calculateLayoutSizeRange();
+			mFlags &= ~GUIElem_SizeDirty;
+		}
+	}
+
+	LayoutSizeRange GUIElement::_getLayoutSizeRange() const
+	{
+		if ((mFlags & GUIElem_SizeDirty) != 0 || !mChildren.empty())
+			return _calculateLayoutSizeRange();
+
+		return mCachedSizeRange;
+	}
+
 	void GUIElement::_changeParentWidget(GUIWidget* widget)
 	{
 		if (_isDestroyed())
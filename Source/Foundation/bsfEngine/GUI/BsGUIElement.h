@@ -214,9 +214,24 @@ namespace bs
 		/** Retrieve element part of element depth. Less significant than both widget and area depth. */
 		UINT8 _getElementDepth() const;
 
-		/** @copydoc GUIElementBase::_setLayoutData */
+		/**
+		 * @copydoc GUIElementBase::_setLayoutData
+		 *
+		 * @note	Marks the element's contents as dirty if the layout data changed.
+		 */
 		void _setLayoutData(const GUILayoutData& data) override;
 
+		/**
+		 * @copydoc GUIElementBase::_updateOptimalLayoutSizes
+		 *
+		 * @note	Size range of elements without children is cached, and only recalculated when the element's layout
+		 *			is marked as dirty.
+		 */
+		void _updateOptimalLayoutSizes() override;
+
+		/** @copydoc GUIElementBase::_getLayoutSizeRange */
+		LayoutSizeRange _getLayoutSizeRange() const override;
+
 		/** @copydoc GUIElementBase::_changeParentWidget */
 		void _changeParentWidget(GUIWidget* widget) override;
 
@@ -340,6 +355,7 @@ namespace bs
 		bool mIsDestroyed = false;
 		GUIElementOptions mOptionFlags;
 		Rect2I mClippedBounds;
+		LayoutSizeRange mCachedSizeRange;
 		
 	private:
 		static const Color DISABLED_COLOR;
@@ -207,6 +207,9 @@ namespace bs
 
 	void GUIElementBase::_markLayoutAsDirty() 
 	{ 
+		// Size is tracked even while hidden, since the element won't be re-measured when made visible otherwise
+		mFlags |= GUIElem_SizeDirty;
+
 		if(!_isVisible())
 			return;
 
@@ -214,6 +217,10 @@ namespace bs
 			mUpdateParent->mFlags |= GUIElem_Dirty;
 		else
 			mFlags |= GUIElem_Dirty;
+
+		// Elements whose layout ends up unchanged won't have their contents refreshed by the layout update, so make
+		// sure the element that triggered the update does
+		_markContentAsDirty();
 	}
 
 	void GUIElementBase::_markContentAsDirty()
@@ -39,7 +39,8 @@ namespace bs
 			GUIElem_HiddenSelf = 0x08,
 			GUIElem_InactiveSelf = 0x10,
 			GUIElem_Disabled = 0x20,
-			GUIElem_DisabledSelf = 0x40
+			GUIElem_DisabledSelf = 0x40,
+			GUIElem_SizeDirty = 0x80 /**< Optimal size of the element needs to be recalculated. */
 		};
 
 	public:
@@ -276,7 +277,10 @@ namespace bs
 		/**	Checks if element has been destroyed and is queued for deletion. */
 		virtual bool _isDestroyed() const { return false; }
 
-		/**	Marks the element's dimensions as dirty, triggering a layout rebuild. */
+		/**
+		 * Marks the element's dimensions as dirty, triggering a layout rebuild. Also marks the element's contents as
+		 * dirty and invalidates its cached optimal size.
+		 */
 		void _markLayoutAsDirty();
 
 		/**	Marks the element's contents as dirty, which causes the sprite meshes to be recreated from scratch. */
@@ -334,7 +338,7 @@ namespace bs
 		GUIElementBase* mParentElement = nullptr;
 
 		Vector<GUIElementBase*> mChildren;	
-		UINT8 mFlags = GUIElem_Dirty;
+		UINT8 mFlags = GUIElem_Dirty | GUIElem_SizeDirty;
 
 		GUIDimensions mDimensions;
 		GUILayoutData mLayoutData;
@@ -9,7 +9,8 @@
 #include "Material/BsMaterial.h"
 #include "Mesh/BsMeshData.h"
 #include "RenderAPI/BsVertexDataDesc.h"
-#include "Mesh/BsMesh.h"
+#include "Mesh/BsMeshHeap.h"
+#include "Mesh/BsTransientMesh.h"
 #include "Managers/BsRenderWindowManager.h"
 #include "Platform/BsPlatform.h"
 #include "Math/BsRect2I.h"
@@ -37,6 +38,7 @@
 #include "RenderAPI/BsSamplerState.h"
 #include "Managers/BsRenderStateManager.h"
 #include "Resources/BsBuiltinResources.h"
+#include "Text/BsFontManager.h"
 
 using namespace std::placeholders;
 
@@ -70,10 +72,12 @@ namespace bs
 
 	const UINT32 GUIManager::DRAG_DISTANCE = 3;
 	const float GUIManager::TOOLTIP_HOVER_TIME = 1.0f;
+	const UINT32 GUIManager::MESH_HEAP_INITIAL_NUM_VERTS = 16384;
+	const UINT32 GUIManager::MESH_HEAP_INITIAL_NUM_INDICES = 49152;
 
 	GUIManager::GUIManager()
 		: mCoreDirty(false), mActiveMouseButton(GUIMouseButton::Left), mShowTooltip(false), mTooltipElementHoverStart(0.0f)
-		, mInputCaret(nullptr), mInputSelection(nullptr), mSeparateMeshesByWidget(true), mDragState(DragState::NoDrag)
+		, mInputCaret(nullptr), mInputSelection(nullptr), mDragState(DragState::NoDrag)
 		, mCaretColor(1.0f, 0.6588f, 0.0f), mCaretBlinkInterval(0.5f), mCaretLastBlinkTime(0.0f), mIsCaretOn(false)
 		, mActiveCursor(CursorType::Arrow), mTextSelectionColor(0.0f, 114/255.0f, 188/255.0f)
 	{
@@ -108,6 +112,12 @@ namespace bs
 		mLineVertexDesc = bs_shared_ptr_new<VertexDataDesc>();
 		mLineVertexDesc->addVertElem(VET_FLOAT2, VES_POSITION);
 
+		// GUI meshes change often (e.g. whenever any text changes), so they're allocated from heaps to avoid creating
+		// new GPU buffers, and waiting on the GPU when overwriting ones still in use
+		mTriangleMeshHeap = MeshHeap::create(MESH_HEAP_INITIAL_NUM_VERTS, MESH_HEAP_INITIAL_NUM_INDICES,
+			mTriangleVertexDesc);
+		mLineMeshHeap = MeshHeap::create(MESH_HEAP_INITIAL_NUM_VERTS, MESH_HEAP_INITIAL_NUM_INDICES, mLineVertexDesc);
+
 		// Need to defer this call because I want to make sure all managers are initialized first
 		deferredCall(std::bind(&GUIManager::updateCaretTexture, this));
 		deferredCall(std::bind(&GUIManager::updateTextSelectionTexture, this));
@@ -168,9 +178,9 @@ namespace bs
 		if(findIter == end(mCachedGUIData))
 			mCachedGUIData[renderTarget] = GUIRenderData();
 
+		// Meshes of the new widget will be built during the next update
 		GUIRenderData& windowData = mCachedGUIData[renderTarget];
 		windowData.widgets.push_back(widget);
-		windowData.isDirty = true;
 	}
 
 	void GUIManager::unregisterWidget(GUIWidget* widget)
@@ -210,13 +220,18 @@ namespace bs
 				renderData.widgets.erase(findIter);
 		}
 
-		if(renderData.widgets.size() == 0)
+		// Meshes of other widgets remain valid, they only needs to be re-submitted without the removed widget
+		auto iterFindData = renderData.widgetData.find(widget);
+		if(iterFindData != renderData.widgetData.end())
 		{
-			mCachedGUIData.erase(renderTarget);
-			mCoreDirty = true;
+			freeWidgetMeshes(iterFindData->second);
+			renderData.widgetData.erase(iterFindData);
 		}
-		else
-			renderData.isDirty = true;
+
+		if(renderData.widgets.size() == 0)
+			mCachedGUIData.erase(renderTarget);
+
+		mCoreDirty = true;
 	}
 
 	void GUIManager::update()
@@ -251,6 +266,19 @@ namespace bs
 			}
 		}
 
+		// Dynamic fonts evicted some characters from their atlases, which existing text meshes might reference
+		const UINT64 fontAtlasVersion = FontManager::instance().getAtlasVersion();
+		if(fontAtlasVersion != mFontAtlasVersion)
+		{
+			for(auto& widgetInfo : mWidgets)
+			{
+				for(auto& element : widgetInfo.widget->getElements())
+					element->_markContentAsDirty();
+			}
+
+			mFontAtlasVersion = fontAtlasVersion;
+		}
+
 		// Update layouts
 		gProfilerCPU().beginSample("UpdateLayout");
 		for(auto& widgetInfo : mWidgets)
@@ -399,11 +427,37 @@ namespace bs
 				auto insertedData = corePerCameraData.insert(std::make_pair(camera->getCore(), Vector<GUICoreRenderData>()));
 				Vector<GUICoreRenderData>& cameraData = insertedData.first->second;
 
-				for (auto& entry : renderData.cachedMeshes)
+				// Render meshes of all widgets from farthest to nearest. Meshes at the same depth are ordered by their
+				// widget and their order within the widget, so the order remains stable between rebuilds.
+				Vector<std::pair<const GUIMeshData*, const SPtr<TransientMesh>*>> sortedMeshes;
+				for (auto& widgetEntry : renderData.widgetData)
+				{
+					const GUIWidgetRenderData& widgetData = widgetEntry.second;
+					for (auto& entry : widgetData.cachedMeshes)
+					{
+						const SPtr<TransientMesh>& mesh = entry.isLine ? widgetData.lineMesh : widgetData.triangleMesh;
+						if(mesh)
+							sortedMeshes.push_back(std::make_pair(&entry, &mesh));
+					}
+				}
+
+				std::sort(sortedMeshes.begin(), sortedMeshes.end(),
+					[](const std::pair<const GUIMeshData*, const SPtr<TransientMesh>*>& a,
+						const std::pair<const GUIMeshData*, const SPtr<TransientMesh>*>& b)
 				{
-					const SPtr<Mesh>& mesh = entry.isLine ? renderData.lineMesh : renderData.triangleMesh;
-					if(!mesh)
-						continue;
+					if (a.first->depth != b.first->depth)
+						return a.first->depth > b.first->depth;
+
+					if (a.first->widget != b.first->widget)
+						return a.first->widget < b.first->widget;
+
+					return a.first < b.first;
+				});
+
+				for (auto& sortedEntry : sortedMeshes)
+				{
+					const GUIMeshData& entry = *sortedEntry.first;
+					const SPtr<TransientMesh>& mesh = *sortedEntry.second;
 
 					cameraData.push_back(GUICoreRenderData());
 					GUICoreRenderData& newEntry = cameraData.back();
@@ -446,284 +500,363 @@ namespace bs
 		{
 			GUIRenderData& renderData = cachedMeshData.second;
 
-			// Check if anything is dirty. If nothing is we can skip the update
-			bool isDirty = renderData.isDirty;
-			renderData.isDirty = false;
-
-			for(auto& widget : renderData.widgets)
-			{
-				if (widget->isDirty(true))
-				{
-					isDirty = true;
-				}
-			}
-
-			if(!isDirty)
-				continue;
-
-			mCoreDirty = true;
-
 			bs_frame_mark();
 			{
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+				// Rebuild only the meshes of widgets whose contents changed, other widgets keep their existing meshes
+				FrameVector<GUIWidget*> changedWidgets;
+				for(auto& widget : renderData.widgets)
 				{
-					UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
-					UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
-
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-					return (aDepth > bDepth) || 
-						(aDepth == bDepth && a.element > b.element) || 
-						(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
-				};
+					bool isDirty = widget->isDirty(true);
+					if(isDirty || renderData.widgetData.find(widget) == renderData.widgetData.end())
+					{
+						updateWidgetMeshes(renderData, widget, true);
+						changedWidgets.push_back(widget);
+					}
+				}
 
-				FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
+				if(!changedWidgets.empty())
+					mCoreDirty = true;
 
-				for (auto& widget : renderData.widgets)
+				// Meshes of other widgets might have been grouped across depths that the changed widgets now have
+				// overlapping elements at, in which case they would no longer render in the right order. Rebuild such
+				// widgets without grouping across depths, which guarantees they can't cause further conflicts.
+				FrameSet<GUIWidget*> rebuiltWidgets;
+				while(!changedWidgets.empty())
 				{
-					const Vector<GUIElement*>& elements = widget->getElements();
-
-					for (auto& element : elements)
+					FrameVector<GUIWidget*> conflictingWidgets;
+					for(auto& widget : renderData.widgets)
 					{
-						if (!element->_isVisible())
+						if(rebuiltWidgets.find(widget) != rebuiltWidgets.end())
 							continue;
 
-						UINT32 numRenderElems = element->_getNumRenderElements();
-						for (UINT32 i = 0; i < numRenderElems; i++)
+						const GUIWidgetRenderData& widgetData = renderData.widgetData[widget];
+						for(auto& changedWidget : changedWidgets)
 						{
-							allElements.insert(GUIGroupElement(element, i));
+							if(changedWidget == widget)
+								continue;
+
+							if(hasDepthConflict(widgetData, renderData.widgetData[changedWidget]))
+							{
+								conflictingWidgets.push_back(widget);
+								break;
+							}
 						}
 					}
+
+					for(auto& widget : conflictingWidgets)
+					{
+						updateWidgetMeshes(renderData, widget, false);
+						rebuiltWidgets.insert(widget);
+					}
+
+					std::swap(changedWidgets, conflictingWidgets);
 				}
+			}
+			bs_frame_clear();
+		}
+	}
+
+	bool GUIManager::hasDepthConflict(const GUIWidgetRenderData& widgetData, const GUIWidgetRenderData& otherData)
+	{
+		for(auto& mesh : widgetData.cachedMeshes)
+		{
+			// Meshes with elements at a single depth always render in the right order
+			if(mesh.minDepth == mesh.depth)
+				continue;
 
-				// Group the elements in such a way so that we end up with a smallest amount of
-				// meshes, without breaking back to front rendering order
-				FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
-				for (auto& elem : allElements)
+			for(auto& otherMesh : otherData.cachedMeshes)
+			{
+				if ((otherMesh.minDepth >= mesh.minDepth && otherMesh.minDepth <= mesh.depth)
+					|| (otherMesh.depth >= mesh.minDepth && otherMesh.depth <= mesh.depth))
 				{
-					GUIElement* guiElem = elem.element;
-					UINT32 renderElemIdx = elem.renderElement;
-					UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+					if (otherMesh.bounds.overlaps(mesh.bounds))
+						return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	void GUIManager::updateWidgetMeshes(GUIRenderData& renderData, GUIWidget* widget, bool allowDepthGaps)
+	{
+		bs_frame_mark();
+		{
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto elemComp = [](const GUIGroupElement& a, const GUIGroupElement& b)
+			{
+				UINT32 aDepth = a.element->_getRenderElementDepth(a.renderElement);
+				UINT32 bDepth = b.element->_getRenderElementDepth(b.renderElement);
 
-					Rect2I tfrmedBounds = guiElem->_getClippedBounds();
-					tfrmedBounds.transform(guiElem->_getParentWidget()->getWorldTfrm());
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+				return (aDepth > bDepth) || 
+					(aDepth == bDepth && a.element > b.element) || 
+					(aDepth == bDepth && a.element == b.element && a.renderElement > b.renderElement); 
+			};
 
-					SpriteMaterial* spriteMaterial = nullptr;
-					const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
-					assert(spriteMaterial != nullptr);
+			FrameSet<GUIGroupElement, std::function<bool(const GUIGroupElement&, const GUIGroupElement&)>> allElements(elemComp);
 
-					UINT64 hash = spriteMaterial->getMergeHash(matInfo);
-					FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
-					
-					// Try to find a group this material will fit in:
-					//  - Group that has a depth value same or one below elements depth will always be a match
-					//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
-					//    overlap the current elements bounds.
-					GUIMaterialGroup* foundGroup = nullptr;
+			const Vector<GUIElement*>& elements = widget->getElements();
+			for (auto& element : elements)
+			{
+				if (!element->_isVisible())
+					continue;
+
+				UINT32 numRenderElems = element->_getNumRenderElements();
+				for (UINT32 i = 0; i < numRenderElems; i++)
+				{
+					allElements.insert(GUIGroupElement(element, i));
+				}
+			}
 
-					for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+			// Group the elements in such a way so that we end up with a smallest amount of
+			// meshes, without breaking back to front rendering order
+			FrameUnorderedMap<UINT64, FrameVector<GUIMaterialGroup>> materialGroups;
+			for (auto& elem : allElements)
+			{
+				GUIElement* guiElem = elem.element;
+				UINT32 renderElemIdx = elem.renderElement;
+				UINT32 elemDepth = guiElem->_getRenderElementDepth(renderElemIdx);
+
+				Rect2I tfrmedBounds = guiElem->_getClippedBounds();
+				tfrmedBounds.transform(widget->getWorldTfrm());
+
+				SpriteMaterial* spriteMaterial = nullptr;
+				const SpriteMaterialInfo& matInfo = guiElem->_getMaterial(renderElemIdx, &spriteMaterial);
+				assert(spriteMaterial != nullptr);
+
+				UINT64 hash = spriteMaterial->getMergeHash(matInfo);
+				FrameVector<GUIMaterialGroup>& groupsPerMaterial = materialGroups[hash];
+				
+				// Try to find a group this material will fit in:
+				//  - Group that has a depth value same or one below elements depth will always be a match
+				//  - Otherwise, we search higher depth values as well, but we only use them if no elements in between those depth values
+				//    overlap the current elements bounds. This includes the elements of other widgets.
+				GUIMaterialGroup* foundGroup = nullptr;
+
+				for (auto groupIter = groupsPerMaterial.rbegin(); groupIter != groupsPerMaterial.rend(); ++groupIter)
+				{
+					GUIMaterialGroup& group = *groupIter;
+
+					if (group.depth == elemDepth)
 					{
-						// If we separate meshes by widget, ignore any groups with widget parents other than mine
-						if (mSeparateMeshesByWidget)
+						foundGroup = &group;
+						break;
+					}
+					else if (allowDepthGaps)
+					{
+						UINT32 startDepth = elemDepth;
+						UINT32 endDepth = group.depth;
+
+						Rect2I potentialGroupBounds = group.bounds;
+						potentialGroupBounds.encapsulate(tfrmedBounds);
+
+						auto isOverlapping = [&](UINT32 minDepth, UINT32 depth, const Rect2I& bounds)
 						{
-							if (groupIter->elements.size() > 0)
+							if ((minDepth >= startDepth && minDepth <= endDepth)
+								|| (depth >= startDepth && depth <= endDepth))
 							{
-								GUIElement* otherElem = groupIter->elements.begin()->element; // We only need to check the first element
-								if (otherElem->_getParentWidget() != guiElem->_getParentWidget())
-									continue;
+								return bounds.overlaps(potentialGroupBounds);
 							}
-						}
 
-						GUIMaterialGroup& group = *groupIter;
+							return false;
+						};
 
-						if (group.depth == elemDepth)
+						bool foundOverlap = false;
+						for (auto& material : materialGroups)
 						{
-							foundGroup = &group;
-							break;
+							for (auto& matGroup : material.second)
+							{
+								if (&matGroup == &group)
+									continue;
+
+								if (isOverlapping(matGroup.minDepth, matGroup.depth, matGroup.bounds))
+								{
+									foundOverlap = true;
+									break;
+								}
+							}
 						}
-						else
+
+						for (auto& otherWidgetData : renderData.widgetData)
 						{
-							UINT32 startDepth = elemDepth;
-							UINT32 endDepth = group.depth;
+							if (foundOverlap)
+								break;
 
-							Rect2I potentialGroupBounds = group.bounds;
-							potentialGroupBounds.encapsulate(tfrmedBounds);
+							if (otherWidgetData.first == widget)
+								continue;
 
-							bool foundOverlap = false;
-							for (auto& material : materialGroups)
+							for (auto& otherMesh : otherWidgetData.second.cachedMeshes)
 							{
-								for (auto& matGroup : material.second)
+								if (isOverlapping(otherMesh.minDepth, otherMesh.depth, otherMesh.bounds))
 								{
-									if (&matGroup == &group)
-										continue;
-
-									if ((matGroup.minDepth >= startDepth && matGroup.minDepth <= endDepth)
-										|| (matGroup.depth >= startDepth && matGroup.depth <= endDepth))
-									{
-										if (matGroup.bounds.overlaps(potentialGroupBounds))
-										{
-											foundOverlap = true;
-											break;
-										}
-									}
+									foundOverlap = true;
+									break;
 								}
 							}
-
-							if (!foundOverlap)
-							{
-								foundGroup = &group;
-								break;
-							}
 						}
-					}
-
-					if (foundGroup == nullptr)
-					{
-						groupsPerMaterial.push_back(GUIMaterialGroup());
-						foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
-
-						foundGroup->depth = elemDepth;
-						foundGroup->minDepth = elemDepth;
-						foundGroup->bounds = tfrmedBounds;
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->matInfo = matInfo.clone();
-						foundGroup->material = spriteMaterial;
 
-						guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
-					}
-					else
-					{
-						foundGroup->bounds.encapsulate(tfrmedBounds);
-						foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
-						foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
-						
-						UINT32 numVertices;
-						UINT32 numIndices;
-						GUIMeshType meshType;
-						guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
-						assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
-
-						foundGroup->numVertices += numVertices;
-						foundGroup->numIndices += numIndices;
-
-						spriteMaterial->merge(foundGroup->matInfo, matInfo);
+						if (!foundOverlap)
+						{
+							foundGroup = &group;
+							break;
+						}
 					}
 				}
 
-				// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
-				auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+				if (foundGroup == nullptr)
 				{
-					return (a->depth > b->depth) || (a->depth == b->depth && a > b);
-					// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
-					// requires all elements to be unique
-				};
+					groupsPerMaterial.push_back(GUIMaterialGroup());
+					foundGroup = &groupsPerMaterial[groupsPerMaterial.size() - 1];
 
-				UINT32 numMeshes = 0;
-				UINT32 numIndices[2] = { 0, 0 };
-				UINT32 numVertices[2] = { 0, 0 };
+					foundGroup->depth = elemDepth;
+					foundGroup->minDepth = elemDepth;
+					foundGroup->bounds = tfrmedBounds;
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->matInfo = matInfo.clone();
+					foundGroup->material = spriteMaterial;
 
-				FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
-				for(auto& material : materialGroups)
+					guiElem->_getMeshInfo(renderElemIdx, foundGroup->numVertices, foundGroup->numIndices, foundGroup->meshType);
+				}
+				else
 				{
-					for(auto& group : material.second)
-					{
-						sortedGroups.insert(&group);
+					foundGroup->bounds.encapsulate(tfrmedBounds);
+					foundGroup->elements.push_back(GUIGroupElement(guiElem, renderElemIdx));
+					foundGroup->minDepth = std::min(foundGroup->minDepth, elemDepth);
+					
+					UINT32 numVertices;
+					UINT32 numIndices;
+					GUIMeshType meshType;
+					guiElem->_getMeshInfo(renderElemIdx, numVertices, numIndices, meshType);
+					assert(meshType == foundGroup->meshType); // It's expected that GUI element doesn't use same material for different mesh types so this should always be true
 
-						UINT32 typeIdx = (UINT32)group.meshType;
-						numIndices[typeIdx] += group.numIndices;
-						numVertices[typeIdx] += group.numVertices;
+					foundGroup->numVertices += numVertices;
+					foundGroup->numIndices += numIndices;
 
-						numMeshes++;
-					}
+					spriteMaterial->merge(foundGroup->matInfo, matInfo);
 				}
+			}
 
-				renderData.triangleMesh = nullptr;
-				renderData.lineMesh = nullptr;
-
-				renderData.cachedMeshes.resize(numMeshes);
-
-				SPtr<MeshData> meshData[2];
-				SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
+			// Make a list of all GUI elements, sorted from farthest to nearest (highest depth to lowest)
+			auto groupComp = [](GUIMaterialGroup* a, GUIMaterialGroup* b)
+			{
+				return (a->depth > b->depth) || (a->depth == b->depth && a > b);
+				// Compare pointers just to differentiate between two elements with the same depth, their order doesn't really matter, but std::set
+				// requires all elements to be unique
+			};
 
-				UINT8* vertices[2] = { nullptr, nullptr };
-				UINT32* indices[2] = { nullptr, nullptr };
+			UINT32 numMeshes = 0;
+			UINT32 numIndices[2] = { 0, 0 };
+			UINT32 numVertices[2] = { 0, 0 };
 
-				for(UINT32 i = 0; i < 2; i++)
+			FrameSet<GUIMaterialGroup*, std::function<bool(GUIMaterialGroup*, GUIMaterialGroup*)>> sortedGroups(groupComp);
+			for(auto& material : materialGroups)
+			{
+				for(auto& group : material.second)
 				{
-					if(numVertices[i] > 0 && numIndices[i] > 0)
-					{
-						meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
+					sortedGroups.insert(&group);
 
-						vertices[i] = meshData[i]->getElementData(VES_POSITION);
-						indices[i] = meshData[i]->getIndices32();
-					}
+					UINT32 typeIdx = (UINT32)group.meshType;
+					numIndices[typeIdx] += group.numIndices;
+					numVertices[typeIdx] += group.numVertices;
+
+					numMeshes++;
 				}
+			}
 
-				// Fill buffers for each group and update their meshes
-				UINT32 meshIdx = 0;
-				UINT32 vertexOffset[2] = { 0, 0 };
-				UINT32 indexOffset[2] = { 0, 0 };
+			GUIWidgetRenderData& widgetData = renderData.widgetData[widget];
+			freeWidgetMeshes(widgetData);
 
-				for(auto& group : sortedGroups)
-				{
-					GUIWidget* widget;
+			widgetData.cachedMeshes.resize(numMeshes);
 
-					if (group->elements.size() == 0)
-						widget = nullptr;
-					else
-					{
-						GUIElement* elem = group->elements.begin()->element;
-						widget = elem->_getParentWidget();
-					}
+			SPtr<MeshData> meshData[2];
+			SPtr<VertexDataDesc> vertexDesc[2] = { mTriangleVertexDesc, mLineVertexDesc };
 
-					GUIMeshData& guiMeshData = renderData.cachedMeshes[meshIdx];
-					guiMeshData.matInfo = group->matInfo;
-					guiMeshData.material = group->material;
-					guiMeshData.widget = widget;
-					guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+			UINT8* vertices[2] = { nullptr, nullptr };
+			UINT32* indices[2] = { nullptr, nullptr };
 
-					UINT32 typeIdx = (UINT32)group->meshType;
-					guiMeshData.indexOffset = indexOffset[typeIdx];
+			for(UINT32 i = 0; i < 2; i++)
+			{
+				if(numVertices[i] > 0 && numIndices[i] > 0)
+				{
+					meshData[i] = MeshData::create(numVertices[i], numIndices[i], vertexDesc[i]);
 
-					UINT32 groupNumIndices = 0;
-					for(auto& matElement : group->elements)
-					{
-						matElement.element->_fillBuffer(
-							vertices[typeIdx], indices[typeIdx], 
-							vertexOffset[typeIdx], indexOffset[typeIdx], 
-							numVertices[typeIdx], numIndices[typeIdx], matElement.renderElement);
+					vertices[i] = meshData[i]->getElementData(VES_POSITION);
+					indices[i] = meshData[i]->getIndices32();
+				}
+			}
 
-						UINT32 elemNumVertices;
-						UINT32 elemNumIndices;
-						GUIMeshType meshType;
-						matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
+			// Fill buffers for each group and update their meshes
+			UINT32 meshIdx = 0;
+			UINT32 vertexOffset[2] = { 0, 0 };
+			UINT32 indexOffset[2] = { 0, 0 };
 
-						UINT32 indexStart = indexOffset[typeIdx];
-						UINT32 indexEnd = indexStart + elemNumIndices;
+			for(auto& group : sortedGroups)
+			{
+				GUIMeshData& guiMeshData = widgetData.cachedMeshes[meshIdx];
+				guiMeshData.matInfo = group->matInfo;
+				guiMeshData.material = group->material;
+				guiMeshData.widget = widget;
+				guiMeshData.isLine = group->meshType == GUIMeshType::Line;
+				guiMeshData.depth = group->depth;
+				guiMeshData.minDepth = group->minDepth;
+				guiMeshData.bounds = group->bounds;
+
+				UINT32 typeIdx = (UINT32)group->meshType;
+				guiMeshData.indexOffset = indexOffset[typeIdx];
+
+				UINT32 groupNumIndices = 0;
+				for(auto& matElement : group->elements)
+				{
+					matElement.element->_fillBuffer(
+						vertices[typeIdx], indices[typeIdx], 
+						vertexOffset[typeIdx], indexOffset[typeIdx],
+						numVertices[typeIdx], numIndices[typeIdx], matElement.renderElement);
 
-						for(UINT32 i = indexStart; i < indexEnd; i++)
-							indices[typeIdx][i] += vertexOffset[typeIdx];
+					UINT32 elemNumVertices;
+					UINT32 elemNumIndices;
+					GUIMeshType meshType;
+					matElement.element->_getMeshInfo(matElement.renderElement, elemNumVertices, elemNumIndices, meshType);
 
-						indexOffset[typeIdx] += elemNumIndices;
-						vertexOffset[typeIdx] += elemNumVertices;
+					UINT32 indexStart = indexOffset[typeIdx];
+					UINT32 indexEnd = indexStart + elemNumIndices;
 
-						groupNumIndices += elemNumIndices;
-					}
+					for(UINT32 i = indexStart; i < indexEnd; i++)
+						indices[typeIdx][i] += vertexOffset[typeIdx];
 
-					guiMeshData.indexCount = groupNumIndices;
+					indexOffset[typeIdx] += elemNumIndices;
+					vertexOffset[typeIdx] += elemNumVertices;
 
-					meshIdx++;
+					groupNumIndices += elemNumIndices;
 				}
 
-				if(meshData[0])
-					renderData.triangleMesh = Mesh::_createPtr(meshData[0], MU_STATIC, DOT_TRIANGLE_LIST);
+				guiMeshData.indexCount = groupNumIndices;
 
-				if(meshData[1])
-					renderData.lineMesh = Mesh::_createPtr(meshData[1], MU_STATIC, DOT_LINE_LIST);
+				meshIdx++;
 			}
 
-			bs_frame_clear();			
+			if(meshData[0])
+				widgetData.triangleMesh = mTriangleMeshHeap->alloc(meshData[0], DOT_TRIANGLE_LIST);
+
+			if(meshData[1])
+				widgetData.lineMesh = mLineMeshHeap->alloc(meshData[1], DOT_LINE_LIST);
+		}
+		bs_frame_clear();
+	}
+
+	void GUIManager::freeWidgetMeshes(GUIWidgetRenderData& widgetData)
+	{
+		if(widgetData.triangleMesh)
+		{
+			mTriangleMeshHeap->dealloc(widgetData.triangleMesh);
+			widgetData.triangleMesh = nullptr;
+		}
+
+		if(widgetData.lineMesh)
+		{
+			mLineMeshHeap->dealloc(widgetData.lineMesh);
+			widgetData.lineMesh = nullptr;
 		}
 	}
 
@@ -58,26 +58,37 @@ namespace bs
 			SpriteMaterialInfo matInfo;
 			GUIWidget* widget;
 			bool isLine;
+
+			/** Depth of the farthest element in the mesh, determining when the mesh is rendered. */
+			UINT32 depth = 0;
+			/** Depth of the nearest element in the mesh. */
+			UINT32 minDepth = 0;
+			/** Bounds of all the elements in the mesh, in render target space. */
+			Rect2I bounds;
+		};
+
+		/**
+		 * GUI meshes of a single widget. Only rebuilt when the widget's contents change. Meshes are allocated from the
+		 * GUI manager's mesh heaps.
+		 */
+		struct GUIWidgetRenderData
+		{
+			SPtr<TransientMesh> triangleMesh;
+			SPtr<TransientMesh> lineMesh;
+			Vector<GUIMeshData> cachedMeshes;
 		};
 
 		/**	GUI render data for a single viewport. */
 		struct GUIRenderData
 		{
-			GUIRenderData()
-				:isDirty(true)
-			{ }
-
-			SPtr<Mesh> triangleMesh;
-			SPtr<Mesh> lineMesh;
-			Vector<GUIMeshData> cachedMeshes;
+			UnorderedMap<GUIWidget*, GUIWidgetRenderData> widgetData;
 			Vector<GUIWidget*> widgets;
-			bool isDirty;
 		};
 
 		/**	Render data for a single GUI group used for notifying the core GUI renderer. */
 		struct GUICoreRenderData
 		{
-			SPtr<ct::Mesh> mesh;
+			SPtr<ct::MeshBase> mesh;
 			SubMesh subMesh;
 			SPtr<ct::Texture> texture;
 			SpriteMaterial* material;
@@ -244,6 +255,27 @@ namespace bs
 		/**	Recreates all dirty GUI meshes and makes them ready for rendering. */
 		void updateMeshes();
 
+		/**
+		 * Recreates the meshes of a single widget, grouping its elements into as few meshes as possible without
+		 * breaking the back to front rendering order with the elements of other widgets.
+		 *
+		 * @param[in]	renderData		Render data of the render target the widget belongs to.
+		 * @param[in]	widget			Widget whose meshes to recreate.
+		 * @param[in]	allowDepthGaps	If true, elements at different depths can be grouped together as long as none
+		 *								of the elements at the depths in between overlap them. If false only elements at
+		 *								the same depth are grouped, ensuring other widgets can't end up in between.
+		 */
+		void updateWidgetMeshes(GUIRenderData& renderData, GUIWidget* widget, bool allowDepthGaps);
+
+		/** Releases the meshes of a widget back to the mesh heaps they were allocated from. */
+		void freeWidgetMeshes(GUIWidgetRenderData& widgetData);
+
+		/**
+		 * Checks if any of the meshes of @p widgetData spans a range of depths that contains an overlapping mesh of
+		 * @p otherData, in which case the other mesh would be rendered in the wrong order.
+		 */
+		static bool hasDepthConflict(const GUIWidgetRenderData& widgetData, const GUIWidgetRenderData& otherData);
+
 		/**	Recreates the input caret texture. */
 		void updateCaretTexture();
 
@@ -369,9 +401,12 @@ namespace bs
 
 		SPtr<ct::GUIRenderer> mRenderer;
 		bool mCoreDirty;
+		UINT64 mFontAtlasVersion = 0;
 
 		SPtr<VertexDataDesc> mTriangleVertexDesc;
 		SPtr<VertexDataDesc> mLineVertexDesc;
+		SPtr<MeshHeap> mTriangleMeshHeap;
+		SPtr<MeshHeap> mLineMeshHeap;
 
 		Stack<GUIElement*> mScheduledForDestruction;
 
@@ -398,7 +433,6 @@ namespace bs
 		GUIInputCaret* mInputCaret;
 		GUIInputSelection* mInputSelection;
 
-		bool mSeparateMeshesByWidget;
 		Vector2I mLastPointerScreenPos;
 
 		DragState mDragState;
@@ -0,0 +1,264 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "GUI/BsGUIVirtualList.h"
+#include "GUI/BsGUIDimensions.h"
+#include "GUI/BsGUIScrollArea.h"
+#include "GUI/BsGUIScrollBarVert.h"
+#include "GUI/BsGUIMouseEvent.h"
+
+using namespace std::placeholders;
+
+namespace bs
+{
+	const UINT32 GUIVirtualList::WheelScrollAmount = 50;
+
+	GUIVirtualList::GUIVirtualList(UINT32 rowHeight, const String& scrollBarStyle, const String& listStyle, 
+		const GUIDimensions& dimensions)
+		: GUIElementContainer(dimensions, listStyle), mRowHeight(rowHeight)
+	{
+		mVertScroll = GUIScrollBarVert::create(scrollBarStyle);
+		_registerChildElement(mVertScroll);
+
+		mVertScroll->onScrollOrResize.connect(std::bind(&GUIVirtualList::vertScrollUpdate, this, _1));
+	}
+
+	void GUIVirtualList::setNumRows(UINT32 numRows)
+	{
+		if (mNumRows == numRows)
+			return;
+
+		mNumRows = numRows;
+		mVertOffset = Math::clamp(mVertOffset, 0.0f, (float)getScrollableHeight());
+
+		updateRows(false);
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualList::refreshRows()
+	{
+		updateRows(true);
+	}
+
+	void GUIVirtualList::scrollToRow(UINT32 row)
+	{
+		const float rowTop = (float)(row * mRowHeight);
+		const float rowBottom = rowTop + mRowHeight;
+
+		if (rowTop < mVertOffset)
+			mVertOffset = rowTop;
+		else if (rowBottom > mVertOffset + mVisibleHeight)
+			mVertOffset = rowBottom - mVisibleHeight;
+
+		mVertOffset = Math::clamp(mVertOffset, 0.0f, (float)getScrollableHeight());
+
+		updateRows(false);
+		_markLayoutAsDirty();
+	}
+
+	void GUIVirtualList::scrollToVertical(float pct)
+	{
+		mVertOffset = getScrollableHeight() * Math::clamp01(pct);
+
+		updateRows(false);
+		_markLayoutAsDirty();
+	}
+
+	float GUIVirtualList::getVerticalScroll() const
+	{
+		return mVertScroll->getScrollPos();
+	}
+
+	void GUIVirtualList::vertScrollUpdate(float scrollPos)
+	{
+		mVertOffset = getScrollableHeight() * Math::clamp01(scrollPos);
+
+		updateRows(false);
+		_markLayoutAsDirty();
+	}
+
+	UINT32 GUIVirtualList::getScrollableHeight() const
+	{
+		return (UINT32)std::max(0, (INT32)(mNumRows * mRowHeight) - (INT32)mVisibleHeight);
+	}
+
+	void GUIVirtualList::updateRows(bool force)
+	{
+		UINT32 firstRow = 0;
+		UINT32 numRows = 0;
+		if (mRowHeight > 0 && mNumRows > 0)
+		{
+			const UINT32 offset = (UINT32)Math::floorToInt(mVertOffset);
+			firstRow = std::min(offset / mRowHeight, mNumRows - 1);
+
+			UINT32 lastRow = Math::divideAndRoundUp(offset + mVisibleHeight, mRowHeight);
+			lastRow = std::min(std::max(lastRow, firstRow + 1), mNumRows);
+
+			numRows = lastRow - firstRow;
+		}
+
+		if (mCreateRow)
+		{
+			while ((UINT32)mRows.size() < numRows)
+			{
+				GUIElementBase* row = mCreateRow();
+				_registerChildElement(row);
+
+				mRows.push_back(row);
+				mRowEntries.push_back(NO_ROW);
+			}
+		}
+
+		numRows = std::min(numRows, (UINT32)mRows.size());
+
+		// Each entry maps to the same row element as long as the number of row elements doesn't change, so scrolling
+		// only needs to update the rows that came into view
+		for (UINT32 i = firstRow; i < firstRow + numRows; i++)
+		{
+			const UINT32 rowIdx = i % (UINT32)mRows.size();
+			if (force || mRowEntries[rowIdx] != i)
+			{
+				mRowEntries[rowIdx] = i;
+
+				if (mUpdateRow)
+					mUpdateRow(mRows[rowIdx], i);
+			}
+		}
+
+		mFirstVisibleRow = firstRow;
+		mNumVisibleRows = numRows;
+	}
+
+	void GUIVirtualList::updateClippedBounds()
+	{
+		mClippedBounds = mLayoutData.area;
+		mClippedBounds.clip(mLayoutData.clipRect);
+	}
+
+	Vector2I GUIVirtualList::_getOptimalSize() const
+	{
+		// List is expected to be sized by its layout options, as its contents can be arbitrarily large. Provide 10x10
+		// because 0 doesn't work well with the layout system.
+		return Vector2I(10, 10);
+	}
+
+	void GUIVirtualList::_updateOptimalLayoutSizes()
+	{
+		// Only the visible rows need their optimal sizes, which get updated right before they're laid out
+		mVertScroll->_updateOptimalLayoutSizes();
+	}
+
+	void GUIVirtualList::_updateLayoutInternal(const GUILayoutData& data)
+	{
+		const UINT32 contentHeight = mNumRows * mRowHeight;
+		mVisibleHeight = data.area.height;
+
+		const bool hasScrollbar = contentHeight > mVisibleHeight;
+		UINT32 rowWidth = data.area.width;
+		if (hasScrollbar)
+			rowWidth = (UINT32)std::max(0, (INT32)rowWidth - (INT32)GUIScrollArea::ScrollBarWidth);
+
+		// Visible area might have changed since the last update
+		const UINT32 scrollableHeight = getScrollableHeight();
+		mVertOffset = Math::clamp(mVertOffset, 0.0f, (float)scrollableHeight);
+		updateRows(false);
+
+		// Rows
+		Rect2I rowClipRect(data.area.x, data.area.y, rowWidth, data.area.height);
+		rowClipRect.clip(data.clipRect);
+
+		const INT32 offset = Math::floorToInt(mVertOffset);
+		const UINT32 numRowElements = (UINT32)mRows.size();
+		for (UINT32 i = 0; i < numRowElements; i++)
+		{
+			GUIElementBase* row = mRows[i];
+			const UINT32 entry = mRowEntries[i];
+
+			const bool isVisible = entry != NO_ROW && entry >= mFirstVisibleRow && 
+				entry < (mFirstVisibleRow + mNumVisibleRows) && (entry % numRowElements) == i;
+
+			GUILayoutData rowData = data;
+			if (isVisible)
+			{
+				rowData.area = Rect2I(data.area.x, data.area.y + (INT32)(entry * mRowHeight) - offset, rowWidth, 
+					mRowHeight);
+				rowData.clipRect = rowData.area;
+				rowData.clipRect.clip(rowClipRect);
+
+				row->_updateOptimalLayoutSizes();
+			}
+			else
+			{
+				// Unused rows are kept around to be recycled, but are fully clipped
+				rowData.area = Rect2I(data.area.x, data.area.y, 0, 0);
+				rowData.clipRect = rowData.area;
+			}
+
+			row->_setLayoutData(rowData);
+			row->_updateLayoutInternal(rowData);
+		}
+
+		// Vertical scrollbar
+		{
+			GUILayoutData vertScrollData = data;
+			if (hasScrollbar)
+			{
+				vertScrollData.area = Rect2I(data.area.x + rowWidth, data.area.y, GUIScrollArea::ScrollBarWidth, 
+					data.area.height);
+			}
+			else
+				vertScrollData.area = Rect2I(data.area.x + data.area.width, data.area.y, 0, 0);
+
+			vertScrollData.clipRect = vertScrollData.area;
+			vertScrollData.clipRect.clip(data.clipRect);
+
+			mVertScroll->_setLayoutData(vertScrollData);
+			mVertScroll->_updateLayoutInternal(vertScrollData);
+
+			float newScrollPct = 0.0f;
+			if (scrollableHeight > 0)
+				newScrollPct = mVertOffset / scrollableHeight;
+
+			if (contentHeight > 0)
+				mVertScroll->_setHandleSize(data.area.height / (float)contentHeight);
+
+			mVertScroll->_setScrollPos(newScrollPct);
+		}
+	}
+
+	bool GUIVirtualList::_mouseEvent(const GUIMouseEvent& ev)
+	{
+		if(ev.getType() == GUIMouseEventType::MouseWheelScroll)
+		{
+			const UINT32 scrollableHeight = getScrollableHeight();
+			if (scrollableHeight > 0)
+			{
+				float additionalScroll = (float)WheelScrollAmount / scrollableHeight;
+				mVertScroll->scroll(additionalScroll * ev.getWheelScrollAmount());
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	GUIVirtualList* GUIVirtualList::create(UINT32 rowHeight, const String& scrollBarStyle, const String& listStyle)
+	{
+		return new (bs_alloc<GUIVirtualList>()) GUIVirtualList(rowHeight, scrollBarStyle, 
+			getStyleName<GUIVirtualList>(listStyle), GUIDimensions::create());
+	}
+
+	GUIVirtualList* GUIVirtualList::create(UINT32 rowHeight, const GUIOptions& options, const String& scrollBarStyle, 
+		const String& listStyle)
+	{
+		return new (bs_alloc<GUIVirtualList>()) GUIVirtualList(rowHeight, scrollBarStyle, 
+			getStyleName<GUIVirtualList>(listStyle), GUIDimensions::create(options));
+	}
+
+	const String& GUIVirtualList::getGUITypeName()
+	{
+		// Styled the same as a scroll area
+		static String typeName = "ScrollArea";
+		return typeName;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsPrerequisites.h"
+#include "GUI/BsGUIElementContainer.h"
+
+namespace bs
+{
+	/** @addtogroup GUI
+	 *  @{
+	 */
+
+	/**
+	 * A vertically scrollable list of rows of equal height, meant for displaying a very large number of entries. Only
+	 * the rows intersecting the visible area are instantiated and laid out. Row elements are recycled as the list is
+	 * scrolled, and are assigned their entries through a user provided callback.
+	 */
+	class BS_EXPORT GUIVirtualList : public GUIElementContainer
+	{
+	public:
+		/** Returns type name of the GUI element used for finding GUI element styles. */
+		static const String& getGUITypeName();
+
+		/**
+		 * Creates a new empty virtual list.
+		 *
+		 * @param[in]	rowHeight		Height of a single row, in pixels.
+		 * @param[in]	scrollBarStyle	Style used by the scroll bar.
+		 * @param[in]	listStyle		Style used by the list content area.
+		 */
+		static GUIVirtualList* create(UINT32 rowHeight, const String& scrollBarStyle = StringUtil::BLANK, 
+			const String& listStyle = StringUtil::BLANK);
+
+		/**
+		 * Creates a new empty virtual list.
+		 *
+		 * @param[in]	rowHeight		Height of a single row, in pixels.
+		 * @param[in]	options			Options that allow you to control how is the element positioned and sized. This 
+		 *								will override any similar options set by style.
+		 * @param[in]	scrollBarStyle	Style used by the scroll bar.
+		 * @param[in]	listStyle		Style used by the list content area.
+		 */
+		static GUIVirtualList* create(UINT32 rowHeight, const GUIOptions& options, 
+			const String& scrollBarStyle = StringUtil::BLANK, const String& listStyle = StringUtil::BLANK);
+
+		/**
+		 * Sets a callback that creates a new GUI element (or a layout) used for displaying a single row. Called
+		 * whenever the list needs more rows to fill its visible area. Created elements are owned by the list.
+		 */
+		void setCreateRowCallback(std::function<GUIElementBase*()> callback) { mCreateRow = callback; }
+
+		/**
+		 * Sets a callback that updates the contents of a row element so it displays the entry at the provided index.
+		 * Called whenever a row element gets assigned a different entry.
+		 */
+		void setUpdateRowCallback(std::function<void(GUIElementBase*, UINT32)> callback) { mUpdateRow = callback; }
+
+		/** Changes the number of entries in the list. */
+		void setNumRows(UINT32 numRows);
+
+		/** Returns the number of entries in the list. */
+		UINT32 getNumRows() const { return mNumRows; }
+
+		/**
+		 * Re-assigns the entries of all the visible rows, triggering the update row callback for each of them. Call
+		 * this when the data displayed by the rows changes.
+		 */
+		void refreshRows();
+
+		/** Scrolls the list so the entry with the specified index is visible. */
+		void scrollToRow(UINT32 row);
+
+		/**
+		 * Scrolls the contents to some position. 0 means top-most part of the content is visible, and 1 means
+		 * bottom-most part is visible.
+		 */
+		void scrollToVertical(float pct);
+
+		/**
+		 * Returns how much is the list scrolled. 0 means top-most part of the content is visible, and 1 means
+		 * bottom-most part is visible.
+		 */
+		float getVerticalScroll() const;
+
+		/** Value passed to the update row callback and stored for rows that aren't assigned to any entry. */
+		static constexpr UINT32 NO_ROW = (UINT32)-1;
+
+	protected:
+		/** @copydoc GUIElementBase::_updateOptimalLayoutSizes */
+		void _updateOptimalLayoutSizes() override;
+
+		/** @copydoc GUIElementContainer::_getOptimalSize */
+		Vector2I _getOptimalSize() const override;
+
+		/** @copydoc GUIElementContainer::updateClippedBounds */
+		void updateClippedBounds() override;
+
+	private:
+		GUIVirtualList(UINT32 rowHeight, const String& scrollBarStyle, const String& listStyle, 
+			const GUIDimensions& dimensions);
+
+		/** @copydoc GUIElementContainer::_mouseEvent */
+		bool _mouseEvent(const GUIMouseEvent& ev) override;
+
+		/** @copydoc GUIElementContainer::_updateLayoutInternal */
+		void _updateLayoutInternal(const GUILayoutData& data) override;
+
+		/**
+		 * Called when the vertical scrollbar moves.
+		 *
+		 * @param[in]	pct	Scrollbar position ranging [0, 1].
+		 */
+		void vertScrollUpdate(float pct);
+
+		/** Returns the number of pixels the contents can be scrolled by. */
+		UINT32 getScrollableHeight() const;
+
+		/**
+		 * Determines which entries are visible at the current scroll offset, creates any missing row elements and
+		 * assigns the entries to row elements.
+		 *
+		 * @param[in]	force	If true all visible rows get their contents updated, even if they already displayed the
+		 *						correct entry.
+		 */
+		void updateRows(bool force);
+
+		UINT32 mRowHeight;
+		UINT32 mNumRows = 0;
+		GUIScrollBarVert* mVertScroll = nullptr;
+
+		Vector<GUIElementBase*> mRows;
+		Vector<UINT32> mRowEntries;
+		UINT32 mFirstVisibleRow = 0;
+		UINT32 mNumVisibleRows = 0;
+
+		float mVertOffset = 0.0f;
+		UINT32 mVisibleHeight = 0;
+
+		std::function<GUIElementBase*()> mCreateRow;
+		std::function<void(GUIElementBase*, UINT32)> mUpdateRow;
+
+		static const UINT32 WheelScrollAmount;
+	};
+
+	/** @} */
+}
\ No newline at end of file
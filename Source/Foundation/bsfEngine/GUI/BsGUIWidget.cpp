@@ -227,7 +227,8 @@ namespace bs
 			updateParent->_updateLayout(childLayoutData);
 		}
 		
-		// Mark dirty contents
+		// Mark the updated hierarchy as clean. Contents only need to be rebuilt for elements whose layout changed,
+		// which are marked when their layout data is assigned.
 		bs_frame_mark();
 		{
 			FrameStack<GUIElementBase*> todo;
@@ -238,9 +239,6 @@ namespace bs
 				GUIElementBase* currentElem = todo.top();
 				todo.pop();
 
-				if (currentElem->_getType() == GUIElementBase::Type::Element)
-					mDirtyContents.insert(static_cast<GUIElement*>(currentElem));
-
 				currentElem->_markAsClean();
 
 				UINT32 numChildren = currentElem->_getNumChildren();
@@ -24,6 +24,22 @@ namespace bs
 {
 	constexpr UINT32 MAX_DEPTH = 4;
 
+	/** Formats the provided number of bytes as a string, using the largest unit the value doesn't fall below one of. */
+	String formatMemorySize(UINT64 bytes)
+	{
+		static const char* UNITS[] = { "B", "KB", "MB", "GB" };
+
+		double value = (double)bytes;
+		UINT32 unit = 0;
+		while(value >= 1024.0 && unit < (UINT32)bs_size(UNITS) - 1)
+		{
+			value /= 1024.0;
+			unit++;
+		}
+
+		return toString(value, 2, 0, ' ', std::ios::fixed) + " " + UNITS[unit];
+	}
+
 	class BasicRowFiller
 	{
 	public:
@@ -476,40 +492,71 @@ namespace bs
 		mGPULayoutFrameContentsRight->addElement(mGPUIndexBufferBindsLbl);
 		mGPULayoutFrameContentsRight->addNewElement<GUIFlexibleSpace>();
 
+		// Set up memory area
+		mMemoryLayout = mWidget->getPanel()->addNewElement<GUILayoutY>();
+
+		if(!MemoryTags::isEnabled())
+		{
+			mMemoryLayout->addNewElement<GUILabel>(HEString(u8"__ProfOvMemDisabled",
+				u8"Memory tags are disabled. Enable the MEMORY_TAGS build option to track memory usage."));
+		}
+
+		GUILayout* memoryTitleLayout = mMemoryLayout->addNewElement<GUILayoutX>();
+		memoryTitleLayout->addNewElement<GUILabel>(HEString(u8"__ProfOvMemTag", u8"Tag"),
+			GUIOptions(GUIOption::fixedWidth(200)));
+		memoryTitleLayout->addNewElement<GUILabel>(HEString(u8"__ProfOvMemCurrent", u8"Current"),
+			GUIOptions(GUIOption::fixedWidth(100)));
+		memoryTitleLayout->addNewElement<GUILabel>(HEString(u8"__ProfOvMemPeak", u8"Peak"),
+			GUIOptions(GUIOption::fixedWidth(100)));
+		memoryTitleLayout->addNewElement<GUILabel>(HEString(u8"__ProfOvMemAllocs", u8"# allocs"),
+			GUIOptions(GUIOption::fixedWidth(100)));
+		memoryTitleLayout->addNewElement<GUILabel>(HEString(u8"__ProfOvMemFrees", u8"# frees"),
+			GUIOptions(GUIOption::fixedWidth(100)));
+
+		for(UINT32 i = 0; i < (UINT32)MemoryTag::Count; i++)
+		{
+			MemoryRow& row = mMemoryRows[i];
+			row.bytes = HEString(u8"{0}");
+			row.peakBytes = HEString(u8"{0}");
+			row.numAllocs = HEString(u8"{0}");
+			row.numFrees = HEString(u8"{0}");
+
+			const GUIOptions valueOptions(GUIOption::fixedWidth(100));
+
+			GUILayout* rowLayout = mMemoryLayout->addNewElement<GUILayoutX>();
+			row.guiName = rowLayout->addNewElement<GUILabel>(HEString(MemoryTags::getName((MemoryTag)i)),
+				GUIOptions(GUIOption::fixedWidth(200)));
+			row.guiBytes = rowLayout->addNewElement<GUILabel>(row.bytes, valueOptions);
+			row.guiPeakBytes = rowLayout->addNewElement<GUILabel>(row.peakBytes, valueOptions);
+			row.guiNumAllocs = rowLayout->addNewElement<GUILabel>(row.numAllocs, valueOptions);
+			row.guiNumFrees = rowLayout->addNewElement<GUILabel>(row.numFrees, valueOptions);
+		}
+
+		mMemoryLayout->addNewElement<GUIFlexibleSpace>();
+
 		updateCPUSampleAreaSizes();
 		updateGPUSampleAreaSizes();
+		updateMemoryAreaSizes();
 
 		if (!mIsShown)
 			hide();
 		else
-		{
-			if (mType == ProfilerOverlayType::CPUSamples)
-				show(ProfilerOverlayType::CPUSamples);
-			else
-				show(ProfilerOverlayType::GPUSamples);
-		}
+			show(mType);
 	}
 
 	void ProfilerOverlay::show(ProfilerOverlayType type)
 	{
-		if (type == ProfilerOverlayType::CPUSamples)
-		{
-			mBasicLayoutLabels->setVisible(true);
-			mPreciseLayoutLabels->setVisible(true);
-			mBasicLayoutContents->setVisible(true);
-			mPreciseLayoutContents->setVisible(true);
-			mGPULayoutFrameContents->setVisible(false);
-			mGPULayoutSamples->setVisible(false);
-		}
-		else
-		{
-			mGPULayoutFrameContents->setVisible(true);
-			mGPULayoutSamples->setVisible(true);
-			mBasicLayoutLabels->setVisible(false);
-			mPreciseLayoutLabels->setVisible(false);
-			mBasicLayoutContents->setVisible(false);
-			mPreciseLayoutContents->setVisible(false);
-		}
+		const bool showCPU = type == ProfilerOverlayType::CPUSamples;
+		const bool showGPU = type == ProfilerOverlayType::GPUSamples;
+		const bool showMemory = type == ProfilerOverlayType::Memory;
+
+		mBasicLayoutLabels->setVisible(showCPU);
+		mPreciseLayoutLabels->setVisible(showCPU);
+		mBasicLayoutContents->setVisible(showCPU);
+		mPreciseLayoutContents->setVisible(showCPU);
+		mGPULayoutFrameContents->setVisible(showGPU);
+		mGPULayoutSamples->setVisible(showGPU);
+		mMemoryLayout->setVisible(showMemory);
 
 		mType = type;
 		mIsShown = true;
@@ -523,6 +570,7 @@ namespace bs
 		mPreciseLayoutContents->setVisible(false);
 		mGPULayoutFrameContents->setVisible(false);
 		mGPULayoutSamples->setVisible(false);
+		mMemoryLayout->setVisible(false);
 		mIsShown = false;
 	}
 
@@ -532,6 +580,7 @@ namespace bs
 		const ProfilerReport& latestCoreReport = ProfilingManager::instance().getReport(ProfiledThread::Core);
 
 		updateCPUSampleContents(latestSimReport, latestCoreReport);
+		updateMemoryContents(latestSimReport);
 
 		while (ProfilerGPU::instance().getNumAvailableReports() > 1)
 			ProfilerGPU::instance().getNextReport(); // Drop any extra reports, we only want the latest
@@ -546,6 +595,7 @@ namespace bs
 	{
 		updateCPUSampleAreaSizes();
 		updateGPUSampleAreaSizes();
+		updateMemoryAreaSizes();
 	}
 
 	void ProfilerOverlay::updateCPUSampleAreaSizes()
@@ -614,6 +664,18 @@ namespace bs
 		mNumGPUSamplesPerColumn = columnHeight / HEIGHT_PER_ENTRY;
 	}
 
+	void ProfilerOverlay::updateMemoryAreaSizes()
+	{
+		static const INT32 PADDING = 10;
+
+		UINT32 width = (UINT32)std::max(0, (INT32)mTarget->getPixelArea().width - PADDING * 2);
+		UINT32 height = (UINT32)std::max(0, (INT32)(mTarget->getPixelArea().height - PADDING * 2));
+
+		mMemoryLayout->setPosition(PADDING, PADDING);
+		mMemoryLayout->setWidth(width);
+		mMemoryLayout->setHeight(height);
+	}
+
 	void ProfilerOverlay::updateCPUSampleContents(const ProfilerReport& simReport, const ProfilerReport& coreReport)
 	{
 		static const UINT32 NUM_ROOT_ENTRIES = 2;
@@ -789,4 +851,23 @@ namespace bs
 			}
 		}
 	}
+
+	void ProfilerOverlay::updateMemoryContents(const ProfilerReport& simReport)
+	{
+		for(UINT32 i = 0; i < (UINT32)MemoryTag::Count; i++)
+		{
+			const MemoryTagStats& stats = simReport.memoryTags[i];
+			MemoryRow& row = mMemoryRows[i];
+
+			row.bytes.setParameter(0, formatMemorySize(stats.bytes));
+			row.peakBytes.setParameter(0, formatMemorySize(stats.peakBytes));
+			row.numAllocs.setParameter(0, toString(stats.numAllocs));
+			row.numFrees.setParameter(0, toString(stats.numFrees));
+
+			row.guiBytes->setContent(row.bytes);
+			row.guiPeakBytes->setContent(row.peakBytes);
+			row.guiNumAllocs->setContent(row.numAllocs);
+			row.guiNumFrees->setContent(row.numFrees);
+		}
+	}
 }
\ No newline at end of file
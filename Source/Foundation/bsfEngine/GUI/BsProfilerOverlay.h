@@ -95,6 +95,21 @@ namespace bs
 			bool disabled;
 		};
 
+		/**	Holds data about GUI elements in a single row of the memory view, showing usage of a single memory tag. */
+		struct MemoryRow
+		{
+			GUILabel* guiName;
+			GUILabel* guiBytes;
+			GUILabel* guiPeakBytes;
+			GUILabel* guiNumAllocs;
+			GUILabel* guiNumFrees;
+
+			HString bytes;
+			HString peakBytes;
+			HString numAllocs;
+			HString numFrees;
+		};
+
 	public:
 		/**	Constructs a new overlay attached to the specified parent and displayed on the provided camera. */
 		ProfilerOverlay(const SPtr<Camera>& camera);
@@ -121,6 +136,9 @@ namespace bs
 		/** Updates sizes of GUI areas used for displaying GPU sample data. To be called after viewport change or resize. */
 		void updateGPUSampleAreaSizes();
 
+		/** Updates sizes of GUI areas used for displaying memory data. To be called after viewport change or resize. */
+		void updateMemoryAreaSizes();
+
 		/**
 		 * Updates CPU GUI elements from the data in the provided profiler reports. To be called whenever a new report is 
 		 * received.
@@ -133,6 +151,9 @@ namespace bs
 		 */
 		void updateGPUSampleContents(const GPUProfilerReport& gpuReport);
 
+		/** Updates memory GUI elements from the data in the provided profiler report. */
+		void updateMemoryContents(const ProfilerReport& simReport);
+
 		static constexpr UINT32 GPU_NUM_SAMPLE_COLUMNS = 3;
 
 		ProfilerOverlayType mType;
@@ -215,6 +236,9 @@ namespace bs
 		Vector<PreciseRow> mPreciseRows;
 		Vector<GPUSampleRow> mGPUSampleRows[GPU_NUM_SAMPLE_COLUMNS];
 
+		GUILayout* mMemoryLayout = nullptr;
+		MemoryRow mMemoryRows[(UINT32)MemoryTag::Count];
+
 		HEvent mTargetResizedConn;
 		bool mIsShown;
 		UINT32 mNumGPUSamplesPerColumn = 20;
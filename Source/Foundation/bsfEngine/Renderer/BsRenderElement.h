@@ -33,8 +33,11 @@ namespace bs { namespace ct
 		/** Renderer specific value that identifies the type of this renderable element. */
 		UINT32 type = 0;
 
-		/** Executes the draw call for the render element. */
-		virtual void draw() const = 0;
+		/** 
+		 * Executes the draw call for the render element. If a command buffer is provided the draw call is queued on it,
+		 * instead of being executed immediately.
+		 */
+		virtual void draw(const SPtr<CommandBuffer>& commandBuffer = nullptr) const = 0;
 
 	protected:
 		~RenderElement() = default;
@@ -6,8 +6,7 @@
 #include "Mesh/BsMesh.h"
 #include "Material/BsMaterial.h"
 #include "Renderer/BsRenderElement.h"
-
-using namespace std::placeholders;
+#include "Utility/BsSmallVector.h"
 
 namespace bs { namespace ct
 {
@@ -20,8 +19,7 @@ namespace bs { namespace ct
 	void RenderQueue::clear()
 	{
 		mSortableElements.clear();
-		mSortableElementIdx.clear();
-		mElements.clear();
+		mSortKeys.clear();
 
 		mSortedRenderElements.clear();
 	}
@@ -54,51 +52,30 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < numPasses; i++)
 		{
-			UINT32 idx = (UINT32)mSortableElementIdx.size();
-			mSortableElementIdx.push_back(idx);
-
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
+			sortableElem.renderElem = element;
 			sortableElem.priority = queuePriority;
 			sortableElem.shaderId = shaderId;
 			sortableElem.techniqueIdx = techniqueIdx;
 			sortableElem.passIdx = i;
 			sortableElem.distFromCamera = distFromCamera;
-
-			mElements.push_back(element);
 		}
 	}
 
 	void RenderQueue::sort()
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
-
-		switch (mStateReductionMode)
-		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
-		}
-
-		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		generateSortKeys();
+		radixSort(mSortKeys, mSortKeysScratch);
 
 		UINT32 prevShaderId = (UINT32)-1;
 		UINT32 prevTechniqueIdx = (UINT32)-1;
 		UINT32 prevPassIdx = (UINT32)-1;
-		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
+		for (auto& sortKey : mSortKeys)
 		{
-			const UINT32 idx = mSortableElementIdx[i];
-			const SortableElement& elem = mSortableElements[idx];
-			const RenderElement* renderElem = mElements[idx];
+			const SortableElement& elem = mSortableElements[sortKey.elementIdx];
+			const RenderElement* renderElem = elem.renderElem;
 
 			const bool separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
 
@@ -147,64 +124,119 @@ namespace bs { namespace ct
 		}
 	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	/** Converts a floating point value into an unsigned integer with the same relative ordering. */
+	static UINT32 toSortableBits(float value)
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
+		UINT32 bits;
+		memcpy(&bits, &value, sizeof(bits));
 
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		// Negative values have their order reversed, and need to end up below positive ones
+		return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
 	}
 
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	void RenderQueue::generateSortKeys()
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 5 |
-			(a.shaderId < b.shaderId) << 4 |
-			(a.techniqueIdx < b.techniqueIdx) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 5 |
-			(a.shaderId > b.shaderId) << 4 |
-			(a.techniqueIdx > b.techniqueIdx) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		// Priorities don't fit into the key, so they are replaced with their rank in descending order
+		SmallVector<INT32, 4> priorities;
+		for (auto& elem : mSortableElements)
+		{
+			if (std::find(priorities.begin(), priorities.end(), elem.priority) == priorities.end())
+				priorities.add(elem.priority);
+		}
+
+		std::sort(priorities.begin(), priorities.end(), std::greater<INT32>());
+
+		const auto numElements = (UINT32)mSortableElements.size();
+		mSortKeys.resize(numElements);
+
+		INT32 prevPriority = priorities.empty() ? 0 : priorities[0];
+		UINT64 rank = 0;
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const SortableElement& elem = mSortableElements[i];
+
+			if (elem.priority != prevPriority)
+			{
+				const auto iterFind = std::find(priorities.begin(), priorities.end(), elem.priority);
+				rank = std::min((UINT64)(iterFind - priorities.begin()), (UINT64)0xFF);
+				prevPriority = elem.priority;
+			}
+
+			const UINT64 distance = toSortableBits(elem.distFromCamera) >> 8;
+			const UINT64 shader = elem.shaderId & 0xFFFF;
+			const UINT64 technique = std::min(elem.techniqueIdx, 0xFFU);
+			const UINT64 pass = std::min(elem.passIdx, 0xFFU);
+
+			UINT64 key = rank << 56;
+			switch (mStateReductionMode)
+			{
+			case StateReduction::None:
+				key |= distance << 32;
+				break;
+			case StateReduction::Material:
+				key |= (shader << 40) | (technique << 32) | (pass << 24) | distance;
+				break;
+			case StateReduction::Distance:
+				key |= (distance << 32) | (shader << 16) | (technique << 8) | pass;
+				break;
+			}
+
+			mSortKeys[i].key = key;
+			mSortKeys[i].elementIdx = i;
+		}
 	}
 
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	void RenderQueue::radixSort(Vector<SortKey>& keys, Vector<SortKey>& scratch)
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 5 | 
-			(a.distFromCamera < b.distFromCamera) << 4 | 
-			(a.shaderId < b.shaderId) << 3 | 
-			(a.techniqueIdx < b.techniqueIdx) << 2 |
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 5 |
-			(a.distFromCamera > b.distFromCamera) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.techniqueIdx > b.techniqueIdx) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		static constexpr UINT32 NUM_DIGITS = sizeof(UINT64);
+
+		const auto numKeys = (UINT32)keys.size();
+		if (numKeys == 0)
+			return;
+
+		scratch.resize(numKeys);
+
+		// Count occurrences of every value of every 8-bit digit, in a single pass
+		UINT32 counts[NUM_DIGITS][256];
+		memset(counts, 0, sizeof(counts));
+
+		for (auto& entry : keys)
+		{
+			for (UINT32 i = 0; i < NUM_DIGITS; i++)
+				counts[i][(entry.key >> (i * 8)) & 0xFF]++;
+		}
+
+		SortKey* src = keys.data();
+		SortKey* dst = scratch.data();
+		UINT32 numPasses = 0;
+		for (UINT32 i = 0; i < NUM_DIGITS; i++)
+		{
+			// Skip digits that are the same for all keys (e.g. unused bits)
+			const UINT32 firstDigit = (UINT32)(src[0].key >> (i * 8)) & 0xFF;
+			if (counts[i][firstDigit] == numKeys)
+				continue;
+
+			UINT32 offsets[256];
+			UINT32 offset = 0;
+			for (UINT32 j = 0; j < 256; j++)
+			{
+				offsets[j] = offset;
+				offset += counts[i][j];
+			}
+
+			for (UINT32 j = 0; j < numKeys; j++)
+			{
+				const UINT32 digit = (UINT32)(src[j].key >> (i * 8)) & 0xFF;
+				dst[offsets[digit]++] = src[j];
+			}
+
+			std::swap(src, dst);
+			numPasses++;
+		}
+
+		// Sorted results ended up in the scratch buffer
+		if (numPasses % 2 != 0)
+			std::swap(keys, scratch);
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
@@ -41,7 +41,7 @@ namespace bs { namespace ct
 		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
 		struct SortableElement
 		{
-			UINT32 seqIdx;
+			const RenderElement* renderElem;
 			INT32 priority;
 			float distFromCamera;
 			UINT32 shaderId;
@@ -49,6 +49,13 @@ namespace bs { namespace ct
 			UINT32 passIdx;
 		};
 
+		/** Key by which elements are sorted, packing the sort criteria into a single value. */
+		struct SortKey
+		{
+			UINT64 key;
+			UINT32 elementIdx;
+		};
+
 	public:
 		RenderQueue(StateReduction grouping = StateReduction::Distance);
 		virtual ~RenderQueue() = default;
@@ -79,18 +86,27 @@ namespace bs { namespace ct
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
 	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
-
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/**
+		 * Generates sort keys for all elements added to the queue, according to the current state reduction mode. Keys are
+		 * laid out so that sorting them in ascending order yields the expected rendering order:
+		 *  - Bits [56, 63] contain the rank of the element's queue priority, with higher priorities ranked first.
+		 *  - With StateReduction::None the next 24 bits contain the distance.
+		 *  - With StateReduction::Material the next bits contain the low 16 bits of the shader ID, technique index, pass
+		 *    index and distance, in that order.
+		 *  - With StateReduction::Distance the next bits contain the distance, low 16 bits of the shader ID, technique 
+		 *    index and pass index, in that order.
+		 *  
+		 * Distance is stored using its 24 most significant bits, so elements at nearly the same distance are further
+		 * ordered by the remaining criteria. Sequence index is not part of the key, since sorting is stable.
+		 */
+		void generateSortKeys();
 
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/** Sorts the provided keys in ascending order, using @p scratch as temporary storage. The sort is stable. */
+		static void radixSort(Vector<SortKey>& keys, Vector<SortKey>& scratch);
 
 		Vector<SortableElement> mSortableElements;
-		Vector<UINT32> mSortableElementIdx;
-		Vector<const RenderElement*> mElements;
+		Vector<SortKey> mSortKeys;
+		Vector<SortKey> mSortKeysScratch;
 
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
@@ -193,29 +193,30 @@ namespace bs { namespace ct
 		/** 
 		 * Binds the materials and its parameters to the pipeline. This material will be used for rendering any subsequent
 		 * draw calls, or executing dispatch calls. If @p bindParams is false you need to call bindParams() separately
-		 * to bind material parameters (if any).
+		 * to bind material parameters (if any). Optionally a command buffer to bind to can be provided, otherwise the
+		 * main command buffer is used.
 		 */
-		void bind(bool bindParams = true) const
+		void bind(bool bindParams = true, const SPtr<CommandBuffer>& commandBuffer = nullptr) const
 		{
 			RenderAPI& rapi = RenderAPI::instance();
 
 			if(mGfxPipeline)
 			{
-				rapi.setGraphicsPipeline(mGfxPipeline);
-				rapi.setStencilRef(mStencilRef);
+				rapi.setGraphicsPipeline(mGfxPipeline, commandBuffer);
+				rapi.setStencilRef(mStencilRef, commandBuffer);
 			}
 			else
-				rapi.setComputePipeline(mComputePipeline);
+				rapi.setComputePipeline(mComputePipeline, commandBuffer);
 
 			if(bindParams)
-				rapi.setGpuParams(mParams);
+				rapi.setGpuParams(mParams, commandBuffer);
 		}
 
 		/** Binds the material parameters to the pipeline. */
-		void bindParams() const
+		void bindParams(const SPtr<CommandBuffer>& commandBuffer = nullptr) const
 		{
 			RenderAPI& rapi = RenderAPI::instance();
-			rapi.setGpuParams(mParams);
+			rapi.setGpuParams(mParams, commandBuffer);
 		}
 
 	protected:
@@ -79,6 +79,17 @@ namespace bs
 		return output;
 	}
 
+	Vector<Path> RendererMaterialManager::_getShaderPaths()
+	{
+		Lock lock(getMutex());
+
+		Vector<Path> output;
+		for (auto& entry : getMaterials())
+			output.push_back(entry.shaderPath);
+
+		return output;
+	}
+
 	void RendererMaterialManager::destroyOnCore()
 	{
 		Lock lock(getMutex());
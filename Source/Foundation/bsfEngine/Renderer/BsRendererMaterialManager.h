@@ -36,6 +36,9 @@ namespace bs
 
 		/** Returns a set of defines to be used when importing the shader. */
 		static ShaderDefines _getDefines(const Path& shaderPath);
+
+		/** Returns paths to the shaders of all registered materials, relative to the builtin shader folder. */
+		static Vector<Path> _getShaderPaths();
 	private:
 		template<class T>
 		friend class RendererMaterial;
@@ -91,10 +91,13 @@ namespace bs { namespace ct
 		 * @param[in]	material		Material containing the pass.
 		 * @param[in]	passIdx			Index of the pass in the material.
 		 * @param[in]	techniqueIdx	Index of the technique the pass belongs to, if the material has multiple techniques.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided the operation is
+		 *								executed immediately.
 		 *
 		 * @note	Core thread.
 		 */
-		void setPass(const SPtr<Material>& material, UINT32 passIdx = 0, UINT32 techniqueIdx = 0);
+		void setPass(const SPtr<Material>& material, UINT32 passIdx = 0, UINT32 techniqueIdx = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/**
 		 * Activates the specified material pass for compute. Any further dispatch calls will be executed using this pass.
@@ -110,21 +113,26 @@ namespace bs { namespace ct
 		 * Sets parameters (textures, samplers, buffers) for the currently active pass.
 		 *
 		 * @param[in]	params		Object containing the parameters.
-		 * @param[in]	passIdx		Pass for which to set the parameters.
+		 * @param[in]	passIdx			Pass for which to set the parameters.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided the operation is
+		 *								executed immediately.
 		 *					
 		 * @note	Core thread.
 		 */
-		void setPassParams(const SPtr<GpuParamsSet>& params, UINT32 passIdx = 0);
+		void setPassParams(const SPtr<GpuParamsSet>& params, UINT32 passIdx = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/**
 		 * Draws the specified mesh.
 		 *
 		 * @param[in]	mesh			Mesh to draw.
 		 * @param[in]	numInstances	Number of times to draw the mesh using instanced rendering.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided the operation is
+		 *								executed immediately.
 		 *
 		 * @note	Core thread.
 		 */
-		void draw(const SPtr<MeshBase>& mesh, UINT32 numInstances = 1);
+		void draw(const SPtr<MeshBase>& mesh, UINT32 numInstances = 1, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/**
 		 * Draws the specified mesh.
@@ -132,10 +140,31 @@ namespace bs { namespace ct
 		 * @param[in]	mesh			Mesh to draw.
 		 * @param[in]	subMesh			Portion of the mesh to draw.
 		 * @param[in]	numInstances	Number of times to draw the mesh using instanced rendering.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided the operation is
+		 *								executed immediately.
 		 *
 		 * @note	Core thread.
 		 */
-		void draw(const SPtr<MeshBase>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1);
+		void draw(const SPtr<MeshBase>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr);
+
+		/**
+		 * Draws the specified mesh using draw arguments read from a GPU buffer.
+		 *
+		 * @param[in]	mesh			Mesh to draw.
+		 * @param[in]	drawOp			Type of primitives to draw.
+		 * @param[in]	argsBuffer		Buffer containing DRAW_INDEXED_INDIRECT_ARGS entries, tightly packed. Index and
+		 *								vertex offsets in the entries are used as-is, meaning they must already account
+		 *								for MeshBase::getIndexOffset() and MeshBase::getVertexOffset().
+		 * @param[in]	offset			Offset into the buffer at which the first entry starts, in bytes.
+		 * @param[in]	drawCount		Number of entries to draw.
+		 * @param[in]	commandBuffer	Optional command buffer to queue the operation on. If not provided the operation is
+		 *								executed immediately.
+		 *
+		 * @note	Core thread.
+		 */
+		void drawIndirect(const SPtr<MeshBase>& mesh, DrawOperationType drawOp, const SPtr<GpuBuffer>& argsBuffer,
+			UINT32 offset, UINT32 drawCount, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/**
 		 * Draws the specified mesh with an additional vertex buffer containing morph shape vertices.
@@ -146,11 +175,13 @@ namespace bs { namespace ct
 		 *										Expected to contain the same number of vertices as the source mesh.
 		 * @param[in]	morphVertexDeclaration	Vertex declaration describing vertices of the provided mesh and the vertices
 		 *										provided in the morph vertex buffer.
+		 * @param[in]	commandBuffer			Optional command buffer to queue the operation on. If not provided the
+		 *										operation is executed immediately.
 		 *
 		 * @note	Core thread.
 		 */
 		void drawMorph(const SPtr<MeshBase>& mesh, const SubMesh& subMesh, const SPtr<VertexBuffer>& morphVertices, 
-			const SPtr<VertexDeclaration>& morphVertexDeclaration);
+			const SPtr<VertexDeclaration>& morphVertexDeclaration, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/**
 		 * Blits contents of the provided texture into the currently bound render target. If the provided texture contains
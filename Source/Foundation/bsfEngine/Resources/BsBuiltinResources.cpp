@@ -14,6 +14,7 @@
 #include "Reflection/BsRTTIType.h"
 #include "FileSystem/BsFileSystem.h"
 #include "CoreThread/BsCoreThread.h"
+#include "Renderer/BsRendererMaterialManager.h"
 #include "Utility/BsShapeMeshes3D.h"
 #include "Mesh/BsMesh.h"
 
@@ -71,6 +72,7 @@ namespace bs
 	constexpr const char* ShaderParticlesLitFile = u8"ParticlesLit.bsl";
 	constexpr const char* ShaderParticlesLitOpaqueFile = u8"ParticlesLitOpaque.bsl";
 	constexpr const char* ShaderDecalFile = u8"Decal.bsl";
+	constexpr const char* ShaderTerrainFile = u8"Terrain.bsl";
 
 	BuiltinResources::~BuiltinResources()
 	{
@@ -109,6 +111,8 @@ namespace bs
 
 		gResources().registerResourceManifest(mResourceManifest);
 
+		startUpResourceLoad();
+
 		// Load basic resources
 		mShaderSpriteText = getShader(ShaderSpriteTextFile);
 		mShaderSpriteImage = getShader(ShaderSpriteImageAlphaFile);
@@ -120,6 +124,7 @@ namespace bs
 		mShaderParticlesLit = getShader(ShaderParticlesLitFile);
 		mShaderParticlesLitOpaque = getShader(ShaderParticlesLitOpaqueFile);
 		mShaderDecal = getShader(ShaderDecalFile);
+		mShaderTerrain = getShader(ShaderTerrainFile);
 
 		SPtr<PixelData> dummyPixelData = PixelData::create(2, 2, 1, PF_RGBA8);
 
@@ -197,29 +202,99 @@ namespace bs
 		gCoreThread().submit(true);
 	}
 
-	HSpriteTexture BuiltinResources::getSkinTexture(const String& name) const
+	void BuiltinResources::startUpResourceLoad()
 	{
-		Path texturePath = mEngineSkinSpritesFolder;
-		texturePath.append(u8"sprite_" + name + u8".asset");
+		Path iconPath = mBuiltinDataFolder + ICON_FOLDER;
+		iconPath.append(String(IconTextureName) + u8".asset");
+
+		Vector<Path> paths =
+		{
+			getShaderPath(ShaderSpriteTextFile),
+			getShaderPath(ShaderSpriteImageAlphaFile),
+			getShaderPath(ShaderSpriteImageNoAlphaFile),
+			getShaderPath(ShaderSpriteLineFile),
+			getShaderPath(ShaderDiffuseFile),
+			getShaderPath(ShaderTransparentFile),
+			getShaderPath(ShaderParticlesUnlitFile),
+			getShaderPath(ShaderParticlesLitFile),
+			getShaderPath(ShaderParticlesLitOpaqueFile),
+			getShaderPath(ShaderDecalFile),
+			getShaderPath(ShaderTerrainFile),
+			getSkinTexturePath(WhiteTex),
+			mBuiltinDataFolder + (String(DEFAULT_FONT_NAME) + u8".asset"),
+			mBuiltinDataFolder + (String(GUI_SKIN_FILE) + u8".json.asset"),
+			getCursorTexturePath(CursorArrowTex),
+			getCursorTexturePath(CursorArrowDragTex),
+			getCursorTexturePath(CursorArrowLeftRightTex),
+			getCursorTexturePath(CursorIBeamTex),
+			getCursorTexturePath(CursorDenyTex),
+			getCursorTexturePath(CursorWaitTex),
+			getCursorTexturePath(CursorSizeNESWTex),
+			getCursorTexturePath(CursorSizeNSTex),
+			getCursorTexturePath(CursorSizeNWSETex),
+			getCursorTexturePath(CursorSizeWETex),
+			iconPath
+		};
+
+		// Renderer materials are initialized right after this module, load their shaders as part of the same batch
+		for(auto& entry : RendererMaterialManager::_getShaderPaths())
+			paths.push_back(getShaderPath(entry));
+
+		Vector<UUID> uuids;
+		for(auto& entry : paths)
+		{
+			UUID uuid;
+			if(gResources().getUUIDFromFilePath(entry, uuid))
+				uuids.push_back(uuid);
+		}
 
-		return gResources().load<SpriteTexture>(texturePath);
+		ResourceLoadBatch batch = gResources().loadBatch(uuids);
+		mStartUpResources = batch.getResources();
 	}
 
-	HShader BuiltinResources::getShader(const Path& path) const
+	void BuiltinResources::_releaseStartUpResources()
+	{
+		mStartUpResources.clear();
+	}
+
+	Path BuiltinResources::getShaderPath(const Path& path) const
 	{
 		Path programPath = mEngineShaderFolder;
 		programPath.append(path);
 		programPath.setExtension(programPath.getExtension() + ".asset");
 
-		return gResources().load<Shader>(programPath);
+		return programPath;
 	}
 
-	HTexture BuiltinResources::getCursorTexture(const String& name) const
+	Path BuiltinResources::getSkinTexturePath(const String& name) const
+	{
+		Path texturePath = mEngineSkinSpritesFolder;
+		texturePath.append(u8"sprite_" + name + u8".asset");
+
+		return texturePath;
+	}
+
+	Path BuiltinResources::getCursorTexturePath(const String& name) const
 	{
 		Path cursorPath = mEngineCursorFolder;
 		cursorPath.append(name + u8".asset");
 
-		return gResources().load<Texture>(cursorPath);
+		return cursorPath;
+	}
+
+	HSpriteTexture BuiltinResources::getSkinTexture(const String& name) const
+	{
+		return gResources().load<SpriteTexture>(getSkinTexturePath(name));
+	}
+
+	HShader BuiltinResources::getShader(const Path& path) const
+	{
+		return gResources().load<Shader>(getShaderPath(path));
+	}
+
+	HTexture BuiltinResources::getCursorTexture(const String& name) const
+	{
+		return gResources().load<Texture>(getCursorTexturePath(name));
 	}
 
 	const PixelData& BuiltinResources::getCursorArrow(Vector2I& hotSpot)
@@ -347,6 +422,8 @@ namespace bs
 			return mShaderParticlesLitOpaque;
 		case BuiltinShader::Decal:
 			return mShaderDecal;
+		case BuiltinShader::Terrain:
+			return mShaderTerrain;
 		default:
 			break;
 		}
@@ -380,6 +457,16 @@ namespace bs
 		return Material::create(mShaderSpriteText);
 	}
 
+	HMaterial BuiltinResources::createSpriteDistanceFieldTextMaterial() const
+	{
+		static ShaderVariation variation = ShaderVariation(
+		{
+			ShaderVariation::Param("DISTANCE_FIELD", true)
+		});
+
+		return Material::create(mShaderSpriteText, variation);
+	}
+
 	HMaterial BuiltinResources::createSpriteImageMaterial() const
 	{
 		return Material::create(mShaderSpriteImage);
@@ -49,7 +49,9 @@ namespace bs
 		 */
 		ParticlesLitOpaque,
 		/** Special shader used for rendering decals that project onto other geometry. */
-		Decal
+		Decal,
+		/** Special shader used for rendering terrain clipmap levels created by TerrainClipmap. */
+		Terrain
 	};
 
 	/**	Holds references to built-in resources used by the core engine. */
@@ -113,6 +115,9 @@ namespace bs
 		/**	Creates a material used for textual sprite rendering (for example text in GUI). */
 		HMaterial createSpriteTextMaterial() const;
 
+		/**	Creates a material used for textual sprite rendering, using fonts containing signed distance fields. */
+		HMaterial createSpriteDistanceFieldTextMaterial() const;
+
 		/**	Creates a material used for image sprite rendering (for example images in GUI). */
 		HMaterial createSpriteImageMaterial() const;
 
@@ -174,7 +179,34 @@ namespace bs
 		static constexpr const UINT32 DEFAULT_FONT_SIZE = 8;
 
 		static constexpr const char* GUI_SKIN_FILE = u8"GUISkin";
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Releases the references to the resources that were started loading during start-up, but aren't used by this
+		 * module directly (e.g. renderer material shaders). Should be called once start-up is done.
+		 */
+		void _releaseStartUpResources();
+
+		/** @} */
 	private:
+		/**
+		 * Starts asynchronously loading all the resources required during start-up, as a single batch. Subsequent
+		 * synchronous loads of those resources wait on the in-progress loads instead of reading them one by one.
+		 */
+		void startUpResourceLoad();
+
+		/**	Returns the path to the shader at the specified path relative to the default shader folder. */
+		Path getShaderPath(const Path& path) const;
+
+		/**	Returns the path to the GUI skin texture with the specified filename. */
+		Path getSkinTexturePath(const String& name) const;
+
+		/**	Returns the path to the cursor texture with the specified filename. */
+		Path getCursorTexturePath(const String& name) const;
+
 		/**	Loads a GUI skin texture with the specified filename. */
 		HSpriteTexture getSkinTexture(const String& name) const;
 
@@ -212,8 +244,10 @@ namespace bs
 		HShader mShaderParticlesLit;
 		HShader mShaderParticlesLitOpaque;
 		HShader mShaderDecal;
+		HShader mShaderTerrain;
 
 		SPtr<ResourceManifest> mResourceManifest;
+		Vector<HResource> mStartUpResources;
 
 		Path mBuiltinRawDataFolder;
 		Path mBuiltinDataFolder;
@@ -24,7 +24,7 @@ namespace bs
 	{
 		WString textData;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 			textData = stream->getAsWString();
@@ -6,13 +6,20 @@ namespace bs
 {
 	void ScriptManager::initialize()
 	{
+		MemoryTagScope memoryTagScope(MemoryTag::Scripting);
+
 		if (mScriptLibrary != nullptr)
 			mScriptLibrary->initialize();
 	}
 
-	void ScriptManager::reload()
+	void ScriptManager::reload(bool force)
 	{
-		if (mScriptLibrary != nullptr)
+		MemoryTagScope memoryTagScope(MemoryTag::Scripting);
+
+		if (mScriptLibrary == nullptr)
+			return;
+
+		if (force || mScriptLibrary->isReloadRequired())
 			mScriptLibrary->reload();
 	}
 
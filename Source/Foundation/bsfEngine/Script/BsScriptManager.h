@@ -23,6 +23,12 @@ namespace bs
 		/** Called when the script libraries should be reloaded (for example when they are recompiled). */
 		virtual void reload() = 0;
 
+		/**
+		 * Checks if reload() needs to be called for recent changes to take effect. Allows libraries to skip the reload
+		 * when none of their scripts changed.
+		 */
+		virtual bool isReloadRequired() const { return true; }
+
 		/**	Called when the script system is being destroyed. */
 		virtual void destroy() = 0;
 	};
@@ -40,8 +46,10 @@ namespace bs
 		/**
 		 * Reloads any scripts in the currently active library. Should be called after some change to the scripts was made
 		 * (for example project was changed, or scripts were recompiled).
+		 *
+		 * @param[in]	force	If false the reload is skipped if the library reports none of its scripts changed.
 		 */
-		void reload();
+		void reload(bool force = true);
 
 		/** Sets the active script library that controls what kind and which scripts are loaded. */
 		void _setScriptLibrary(const SPtr<ScriptLibrary>& library);
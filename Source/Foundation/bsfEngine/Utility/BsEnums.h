@@ -51,7 +51,10 @@ namespace bs
 		CPUSamples,
 
 		/** Display GPU samples on the overlay. */
-		GPUSamples
+		GPUSamples,
+
+		/** Display memory usage of each memory tag on the overlay. */
+		Memory
 	};
 
 	/** @} */
@@ -0,0 +1,239 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Allocators/BsFrameArena.h"
+
+namespace bs
+{
+	/** Part of the free list head value that holds the block pointer. Remaining bits hold the modification counter. */
+	static constexpr UINT64 FREE_LIST_POINTER_MASK = (1ULL << 48) - 1;
+
+	/** Amount to add to the free list head value in order to increment the modification counter. */
+	static constexpr UINT64 FREE_LIST_COUNTER_INC = 1ULL << 48;
+
+	/** Per-thread state of the arena. */
+	struct FrameArena::ThreadArena
+	{
+		/** Frame the blocks in the chain are being used for. */
+		UINT64 frameIdx = 0;
+
+		/** Chain of blocks used in the current frame. First block in the chain is the one being allocated from. */
+		Block* chain = nullptr;
+	};
+
+	std::atomic<UINT64> FrameArena::sFrameIdx{0};
+	std::atomic<UINT64> FrameArena::sFreeBlocks{0};
+	std::atomic<FrameArena::Block*> FrameArena::sRetiredChains{nullptr};
+	FrameArena::Block* FrameArena::sPendingChains = nullptr;
+	std::atomic<UINT64> FrameArena::sBytesReserved{0};
+	std::atomic<UINT64> FrameArena::sBytesInUse{0};
+	std::atomic<UINT64> FrameArena::sPeakBytesInUse{0};
+
+	UINT8* FrameArena::alloc(UINT32 amount, UINT32 alignment)
+	{
+		assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+		ThreadArena* arena = getThreadArena();
+
+		// Hand over the blocks used in the previous frame, they will be released once that frame is retired
+		const UINT64 frameIdx = sFrameIdx.load(std::memory_order_acquire);
+		if (arena->frameIdx != frameIdx)
+		{
+			if (arena->chain != nullptr)
+				retireChain(arena->chain, arena->frameIdx);
+
+			arena->chain = nullptr;
+			arena->frameIdx = frameIdx;
+		}
+
+		const auto allocFromBlock = [amount, alignment](Block* block) -> UINT8*
+		{
+			const uintptr_t start = (uintptr_t)(block->data + block->offset);
+			const uintptr_t aligned = (start + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			const UINT32 offset = block->offset + (UINT32)(aligned - start);
+
+			if (offset + amount > block->size)
+				return nullptr;
+
+			block->offset = offset + amount;
+			return block->data + offset;
+		};
+
+		if (arena->chain != nullptr)
+		{
+			UINT8* data = allocFromBlock(arena->chain);
+			if (data != nullptr)
+				return data;
+		}
+
+		// Block data is always 16 byte aligned, so larger alignments might need some padding
+		const UINT32 padding = alignment > 16 ? alignment - 16 : 0;
+
+		Block* block = acquireBlock(amount + padding);
+		block->next = arena->chain;
+		arena->chain = block;
+
+		return allocFromBlock(block);
+	}
+
+	void FrameArena::advanceFrame(UINT32 numFramesInFlight)
+	{
+		assert(numFramesInFlight > 0);
+
+		const UINT64 frameIdx = sFrameIdx.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+		// Check chains handed over since the last call, as well as the ones that were still in flight back then
+		Block* chains[2];
+		chains[0] = sRetiredChains.exchange(nullptr, std::memory_order_acquire);
+		chains[1] = sPendingChains;
+
+		sPendingChains = nullptr;
+		for (auto& chain : chains)
+		{
+			while (chain != nullptr)
+			{
+				Block* nextChain = chain->nextChain;
+
+				if (chain->frameIdx + numFramesInFlight <= frameIdx)
+					releaseChain(chain);
+				else
+				{
+					chain->nextChain = sPendingChains;
+					sPendingChains = chain;
+				}
+
+				chain = nextChain;
+			}
+		}
+	}
+
+	FrameArena::ThreadArena* FrameArena::getThreadArena()
+	{
+		static BS_THREADLOCAL ThreadArena* arena = nullptr;
+		if (arena == nullptr)
+		{
+			// Note: This will leak memory once the thread exits, but only a few bytes since its blocks are retired
+			// through the global list
+			arena = new ThreadArena();
+			arena->frameIdx = sFrameIdx.load(std::memory_order_acquire);
+		}
+
+		return arena;
+	}
+
+	FrameArenaStats FrameArena::getStats()
+	{
+		FrameArenaStats stats;
+		stats.frameIdx = sFrameIdx.load(std::memory_order_relaxed);
+		stats.bytesReserved = sBytesReserved.load(std::memory_order_relaxed);
+		stats.bytesInUse = sBytesInUse.load(std::memory_order_relaxed);
+		stats.peakBytesInUse = sPeakBytesInUse.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	FrameArena::Block* FrameArena::acquireBlock(UINT32 size)
+	{
+		Block* block = nullptr;
+		if (size <= BLOCK_SIZE)
+		{
+			block = popFreeBlock();
+			size = BLOCK_SIZE;
+		}
+
+		if (block == nullptr)
+		{
+			const UINT32 headerSize = (sizeof(Block) + 15) & ~15;
+
+			UINT8* data = (UINT8*)bs_alloc_aligned16(headerSize + size);
+			block = new (data) Block();
+			block->data = data + headerSize;
+			block->size = size;
+			block->pooled = size == BLOCK_SIZE;
+
+			if (block->pooled)
+				sBytesReserved.fetch_add(size, std::memory_order_relaxed);
+		}
+
+		block->offset = 0;
+		block->next = nullptr;
+		block->nextChain = nullptr;
+
+		trackUsage(block->size);
+		return block;
+	}
+
+	void FrameArena::releaseChain(Block* chain)
+	{
+		Block* block = chain;
+		while (block != nullptr)
+		{
+			Block* next = block->next;
+			trackUsage(-(INT64)block->size);
+
+			if (block->pooled)
+				pushFreeBlock(block);
+			else
+			{
+				block->~Block();
+				bs_free_aligned16(block);
+			}
+
+			block = next;
+		}
+	}
+
+	void FrameArena::pushFreeBlock(Block* block)
+	{
+		assert(((uintptr_t)block & ~FREE_LIST_POINTER_MASK) == 0);
+
+		UINT64 head = sFreeBlocks.load(std::memory_order_relaxed);
+		UINT64 newHead;
+		do
+		{
+			block->nextFree.store((Block*)(uintptr_t)(head & FREE_LIST_POINTER_MASK), std::memory_order_relaxed);
+			newHead = (UINT64)(uintptr_t)block | ((head & ~FREE_LIST_POINTER_MASK) + FREE_LIST_COUNTER_INC);
+		} while (!sFreeBlocks.compare_exchange_weak(head, newHead, std::memory_order_release,
+			std::memory_order_relaxed));
+	}
+
+	FrameArena::Block* FrameArena::popFreeBlock()
+	{
+		UINT64 head = sFreeBlocks.load(std::memory_order_acquire);
+		while (true)
+		{
+			Block* block = (Block*)(uintptr_t)(head & FREE_LIST_POINTER_MASK);
+			if (block == nullptr)
+				return nullptr;
+
+			// The block might get popped and reused by another thread before we get to it, but since pooled blocks are
+			// never freed reading it is safe, and the counter ensures the exchange below fails in that case
+			Block* next = block->nextFree.load(std::memory_order_relaxed);
+			const UINT64 newHead = (UINT64)(uintptr_t)next | ((head & ~FREE_LIST_POINTER_MASK) + FREE_LIST_COUNTER_INC);
+
+			if (sFreeBlocks.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+				return block;
+		}
+	}
+
+	void FrameArena::retireChain(Block* chain, UINT64 frameIdx)
+	{
+		chain->frameIdx = frameIdx;
+		chain->nextChain = sRetiredChains.load(std::memory_order_relaxed);
+
+		while (!sRetiredChains.compare_exchange_weak(chain->nextChain, chain, std::memory_order_release,
+			std::memory_order_relaxed))
+		{ }
+	}
+
+	void FrameArena::trackUsage(INT64 bytes)
+	{
+		const UINT64 inUse = sBytesInUse.fetch_add((UINT64)bytes, std::memory_order_relaxed) + (UINT64)bytes;
+
+		if (bytes > 0)
+		{
+			UINT64 peak = sPeakBytesInUse.load(std::memory_order_relaxed);
+			while (inUse > peak && !sPeakBytesInUse.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+			{ }
+		}
+	}
+}
@@ -0,0 +1,148 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Memory
+	 *  @{
+	 */
+
+	/** Information about memory used by FrameArena. */
+	struct FrameArenaStats
+	{
+		UINT64 frameIdx = 0; /**< Index of the current frame. */
+		UINT64 bytesReserved = 0; /**< Memory allocated from the system for standard sized blocks, in use or pooled. */
+		UINT64 bytesInUse = 0; /**< Memory in blocks that belong to frames that haven't been retired yet. */
+		UINT64 peakBytesInUse = 0; /**< Highest value of @p bytesInUse since the application started. */
+	};
+
+	/**
+	 * Frame-scoped memory arena, providing very fast allocations for data that lives for a fixed number of frames. Unlike
+	 * FrameAlloc the arena can be allocated from any thread without synchronization, and allocations from all threads
+	 * share the same lifetime: memory allocated during a frame remains valid until that frame is retired by a later call
+	 * to advanceFrame(). This makes it suitable for data produced on worker threads and consumed on another thread (e.g.
+	 * the core thread) later in the frame.
+	 *
+	 * Each thread bump-allocates from its own chain of blocks, and finished chains are handed to a global list which is
+	 * released on frame advance. Released blocks go to a lock-free free list and are reused by any thread, instead of
+	 * being returned to the system.
+	 *
+	 * @note	Individual allocations cannot be freed, and destructors of constructed objects are never called.
+	 * @note	A thread that stops allocating keeps the blocks of its last frame until it allocates again.
+	 */
+	class BS_UTILITY_EXPORT FrameArena
+	{
+		/** Block of memory that allocations are served from. */
+		struct Block
+		{
+			UINT8* data = nullptr;
+			UINT32 size = 0;
+			UINT32 offset = 0;
+
+			/** True if the block has the standard size and is pooled, false if it was allocated for a large request. */
+			bool pooled = false;
+
+			/** Previous block in the chain of blocks used by a thread in a single frame. */
+			Block* next = nullptr;
+
+			/** Next chain in the list of chains waiting to be retired. Only valid for the first block in a chain. */
+			Block* nextChain = nullptr;
+
+			/** Frame the chain was used in. Only valid for the first block in a chain. */
+			UINT64 frameIdx = 0;
+
+			/** Next block in the free list. */
+			std::atomic<Block*> nextFree{nullptr};
+		};
+
+	public:
+		/** Size of a standard block. Allocations larger than this get a dedicated block. */
+		static constexpr UINT32 BLOCK_SIZE = 64 * 1024;
+
+		/**
+		 * Allocates memory that remains valid until the current frame is retired.
+		 *
+		 * @param[in]	amount		Number of bytes to allocate.
+		 * @param[in]	alignment	Alignment of the returned memory. Must be a power of two.
+		 *
+		 * @note	Thread safe.
+		 */
+		static UINT8* alloc(UINT32 amount, UINT32 alignment = 16);
+
+		/**
+		 * Allocates and constructs a new object. The destructor will never be called, so the object must either be
+		 * trivially destructible, or destructed manually.
+		 *
+		 * @note	Thread safe.
+		 */
+		template<class T, class... Args>
+		static T* construct(Args &&...args)
+		{
+			return new (alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * Starts a new frame, and releases memory of all frames that are at least @p numFramesInFlight frames older than
+		 * the new one. Must be called from a single thread at a point where no memory from the released frames is in use
+		 * anymore.
+		 *
+		 * @param[in]	numFramesInFlight	Number of most recent frames whose memory needs to stay valid, including the
+		 *									new frame.
+		 */
+		static void advanceFrame(UINT32 numFramesInFlight);
+
+		/** Returns the index of the current frame. */
+		static UINT64 getFrameIndex() { return sFrameIdx.load(std::memory_order_relaxed); }
+
+		/** Returns information about memory used by the arena. */
+		static FrameArenaStats getStats();
+
+	private:
+		struct ThreadArena;
+
+		/** Returns the arena of the calling thread, creating it on first use. */
+		static ThreadArena* getThreadArena();
+
+		/** Returns a block with at least the specified amount of available memory. */
+		static Block* acquireBlock(UINT32 size);
+
+		/** Releases all blocks in the chain, returning standard blocks to the free list. */
+		static void releaseChain(Block* chain);
+
+		/** Pushes a block onto the free list. */
+		static void pushFreeBlock(Block* block);
+
+		/** Pops a block from the free list, or returns null if the list is empty. */
+		static Block* popFreeBlock();
+
+		/** Adds a chain of blocks used by a thread in a now finished frame to the list of chains to be retired. */
+		static void retireChain(Block* chain, UINT64 frameIdx);
+
+		/** Adjusts the memory usage counters by the specified amount of bytes. */
+		static void trackUsage(INT64 bytes);
+
+		static std::atomic<UINT64> sFrameIdx;
+
+		/**
+		 * Top of the free list. Low 48 bits hold the pointer to the first block, and the top 16 bits a counter that
+		 * changes on every modification, to protect against ABA issues.
+		 */
+		static std::atomic<UINT64> sFreeBlocks;
+
+		/** Chains handed over by threads, waiting to be retired in advanceFrame(). */
+		static std::atomic<Block*> sRetiredChains;
+
+		/** Chains that were collected by advanceFrame() but still belong to frames in flight. */
+		static Block* sPendingChains;
+
+		static std::atomic<UINT64> sBytesReserved;
+		static std::atomic<UINT64> sBytesInUse;
+		static std::atomic<UINT64> sPeakBytesInUse;
+	};
+
+	/** @} */
+}
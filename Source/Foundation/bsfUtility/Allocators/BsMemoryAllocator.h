@@ -13,6 +13,9 @@
 #  include <malloc.h>
 #endif
 
+#include "Allocators/BsThreadCacheAlloc.h"
+#include "Allocators/BsMemoryTags.h"
+
 namespace bs
 {
 	class MemoryAllocatorBase;
@@ -130,13 +133,55 @@ namespace bs
 	protected:
 		static void incAllocCount() { MemoryCounter::incAllocCount(); }
 		static void incFreeCount() { MemoryCounter::incFreeCount(); }
+
+		/** Allocates @p bytes bytes using the general purpose allocator selected at build time. */
+		static void* backendAllocate(size_t bytes)
+		{
+#if BS_THREAD_CACHE_ALLOCATOR
+			return ThreadCacheAlloc::allocate(bytes);
+#else
+			return malloc(bytes);
+#endif
+		}
+
+		/** Frees memory allocated with backendAllocate(). */
+		static void backendFree(void* ptr)
+		{
+#if BS_THREAD_CACHE_ALLOCATOR
+			ThreadCacheAlloc::free(ptr);
+#else
+			::free(ptr);
+#endif
+		}
+
+		/** Allocates @p bytes bytes aligned to a 16 byte boundary, using the allocator selected at build time. */
+		static void* backendAllocateAligned16(size_t bytes)
+		{
+#if BS_THREAD_CACHE_ALLOCATOR
+			return ThreadCacheAlloc::allocate(bytes);
+#else
+			return platformAlignedAlloc16(bytes);
+#endif
+		}
+
+		/** Frees memory allocated with backendAllocateAligned16(). */
+		static void backendFreeAligned16(void* ptr)
+		{
+#if BS_THREAD_CACHE_ALLOCATOR
+			ThreadCacheAlloc::free(ptr);
+#else
+			platformAlignedFree16(ptr);
+#endif
+		}
 	};
 
 	/**
 	 * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
 	 *
 	 * @note	For example you might implement a pool allocator for specific types in order
-	 * 			to reduce allocation overhead. By default standard malloc/free are used.
+	 * 			to reduce allocation overhead. By default standard malloc/free are used, unless the framework is built
+	 * 			with the ThreadCache general allocator, in which case ThreadCacheAlloc is used instead. When the
+	 * 			framework is built with memory tags, every allocation is attributed to the current MemoryTag.
 	 */
 	template<class T>
 	class MemoryAllocator : public MemoryAllocatorBase
@@ -149,7 +194,12 @@ namespace bs
 			incAllocCount();
 #endif
 
-			return malloc(bytes);
+#if BS_MEMORY_TAGS
+			void* base = backendAllocate(bytes + MemoryTags::HEADER_SIZE);
+			return MemoryTags::_tagAllocation(base, MemoryTags::HEADER_SIZE, bytes);
+#else
+			return backendAllocate(bytes);
+#endif
 		}
 
 		/**
@@ -162,7 +212,13 @@ namespace bs
 			incAllocCount();
 #endif
 
+#if BS_MEMORY_TAGS
+			const size_t offset = alignment > MemoryTags::HEADER_SIZE ? alignment : MemoryTags::HEADER_SIZE;
+			void* base = platformAlignedAlloc(bytes + offset, alignment);
+			return MemoryTags::_tagAllocation(base, offset, bytes);
+#else
 			return platformAlignedAlloc(bytes, alignment);
+#endif
 		}
 
 		/** Allocates @p bytes and aligns them to a 16 byte boundary. */
@@ -172,7 +228,12 @@ namespace bs
 			incAllocCount();
 #endif
 
-			return platformAlignedAlloc16(bytes);
+#if BS_MEMORY_TAGS
+			void* base = backendAllocateAligned16(bytes + MemoryTags::HEADER_SIZE);
+			return MemoryTags::_tagAllocation(base, MemoryTags::HEADER_SIZE, bytes);
+#else
+			return backendAllocateAligned16(bytes);
+#endif
 		}
 
 		/** Frees the memory at the specified location. */
@@ -182,7 +243,11 @@ namespace bs
 			incFreeCount();
 #endif
 
-			::free(ptr);
+#if BS_MEMORY_TAGS
+			backendFree(MemoryTags::_untagAllocation(ptr));
+#else
+			backendFree(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned() */
@@ -192,7 +257,11 @@ namespace bs
 			incFreeCount();
 #endif
 
+#if BS_MEMORY_TAGS
+			platformAlignedFree(MemoryTags::_untagAllocation(ptr));
+#else
 			platformAlignedFree(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned16() */
@@ -202,13 +271,17 @@ namespace bs
 			incFreeCount();
 #endif
 
-			platformAlignedFree16(ptr);
+#if BS_MEMORY_TAGS
+			backendFreeAligned16(MemoryTags::_untagAllocation(ptr));
+#else
+			backendFreeAligned16(ptr);
+#endif
 		}
 	};
 
 	/**
-	 * General allocator provided by the OS. Use for persistent long term allocations, and allocations that don't
-	 * happen often.
+	 * General allocator provided by the OS, or ThreadCacheAlloc if selected through the GENERAL_ALLOCATOR build option.
+	 * Use for persistent long term allocations, and allocations that don't happen often.
 	 */
 	class GenAlloc
 	{ };
@@ -356,6 +429,35 @@ namespace bs
 		MemoryAllocator<GenAlloc>::freeAligned16(ptr);
 	}
 
+	/** Allocates the specified number of bytes, attributing them to the provided memory tag. Free with bs_free(). */
+	inline void* bs_alloc_tagged(size_t count, MemoryTag tag)
+	{
+		MemoryTagScope tagScope(tag);
+		return MemoryAllocator<GenAlloc>::allocate(count);
+	}
+
+	/**
+	 * Creates and constructs an array of @p count elements, attributing the array and any allocations made by the
+	 * element constructors to the provided memory tag. Free with bs_deleteN().
+	 */
+	template<class T>
+	inline T* bs_newN_tagged(size_t count, MemoryTag tag)
+	{
+		MemoryTagScope tagScope(tag);
+		return bs_newN<T>(count);
+	}
+
+	/**
+	 * Create a new object with the specified parameters, attributing the object and any allocations made by its
+	 * constructor to the provided memory tag. Free with bs_delete().
+	 */
+	template<class Type, class... Args>
+	Type* bs_new_tagged(MemoryTag tag, Args &&...args)
+	{
+		MemoryTagScope tagScope(tag);
+		return new (bs_alloc<Type, GenAlloc>()) Type(std::forward<Args>(args)...);
+	}
+
 /************************************************************************/
 /*			MACRO VERSIONS					*/
 /* You will almost always want to use the template versions but in some */
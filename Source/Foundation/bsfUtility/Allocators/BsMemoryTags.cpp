@@ -0,0 +1,255 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsMemoryTags.h"
+
+namespace bs
+{
+	namespace
+	{
+		constexpr UINT32 NUM_TAGS = (UINT32)MemoryTag::Count;
+
+		const char* TAG_NAMES[NUM_TAGS] =
+		{
+			"General",
+			"Rendering",
+			"Animation",
+			"Physics",
+			"GUI",
+			"Resources",
+			"Scripting"
+		};
+
+		/** Header stored in front of every tracked allocation. */
+		struct TagHeader
+		{
+			UINT32 tag;
+			UINT32 offset; /**< Offset of the user memory from the start of the underlying allocation. */
+			UINT64 size;
+		};
+
+		static_assert(sizeof(TagHeader) == MemoryTags::HEADER_SIZE, "Header size mismatch.");
+
+		/** Counters of a single thread. Only written by the owning thread, but readable from any thread. */
+		struct ThreadTagCounters
+		{
+			ThreadTagCounters();
+			~ThreadTagCounters();
+
+			/** Increments a counter. Avoids a locked read-modify-write since there is only ever a single writer. */
+			template<class T>
+			static void add(std::atomic<T>& counter, T value)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+
+			// Bytes can go negative on a single thread, if it frees memory allocated on another thread
+			std::atomic<INT64> bytes[NUM_TAGS];
+			std::atomic<UINT64> numAllocs[NUM_TAGS];
+			std::atomic<UINT64> numFrees[NUM_TAGS];
+
+			ThreadTagCounters* prev = nullptr;
+			ThreadTagCounters* next = nullptr;
+		};
+
+		/** State shared between all threads. */
+		struct GlobalState
+		{
+			Mutex threadsMutex;
+			ThreadTagCounters* threads = nullptr;
+
+			/** Counters of exited threads, and of allocations made by threads after their counters were released. */
+			std::atomic<INT64> bytes[NUM_TAGS];
+			std::atomic<UINT64> numAllocs[NUM_TAGS];
+			std::atomic<UINT64> numFrees[NUM_TAGS];
+
+			std::atomic<UINT64> peakBytes[NUM_TAGS];
+		};
+
+		GlobalState& getGlobalState()
+		{
+			// Intentionally never destroyed since thread counters can be released after the static destructors ran.
+			// Allocated from the system since the allocator is the one being tracked.
+			static GlobalState* state = []()
+			{
+				auto* output = new (::malloc(sizeof(GlobalState))) GlobalState();
+				for(UINT32 i = 0; i < NUM_TAGS; i++)
+				{
+					output->bytes[i] = 0;
+					output->numAllocs[i] = 0;
+					output->numFrees[i] = 0;
+					output->peakBytes[i] = 0;
+				}
+
+				return output;
+			}();
+
+			return *state;
+		}
+
+		/** Tag new allocations on the current thread are attributed to. */
+		BS_THREADLOCAL MemoryTag sCurrentTag = MemoryTag::General;
+
+		/** Set once the counters of the current thread are released, after which the global counters are used. */
+		BS_THREADLOCAL bool sThreadCountersReleased = false;
+
+		ThreadTagCounters::ThreadTagCounters()
+		{
+			for(UINT32 i = 0; i < NUM_TAGS; i++)
+			{
+				bytes[i] = 0;
+				numAllocs[i] = 0;
+				numFrees[i] = 0;
+			}
+
+			GlobalState& state = getGlobalState();
+
+			Lock lock(state.threadsMutex);
+			next = state.threads;
+			if(next)
+				next->prev = this;
+
+			state.threads = this;
+		}
+
+		ThreadTagCounters::~ThreadTagCounters()
+		{
+			GlobalState& state = getGlobalState();
+
+			Lock lock(state.threadsMutex);
+			if(prev)
+				prev->next = next;
+			else
+				state.threads = next;
+
+			if(next)
+				next->prev = prev;
+
+			for(UINT32 i = 0; i < NUM_TAGS; i++)
+			{
+				state.bytes[i] += bytes[i].load(std::memory_order_relaxed);
+				state.numAllocs[i] += numAllocs[i].load(std::memory_order_relaxed);
+				state.numFrees[i] += numFrees[i].load(std::memory_order_relaxed);
+			}
+
+			sThreadCountersReleased = true;
+		}
+
+		/** Returns the counters of the current thread, or null if they were already released during thread exit. */
+		ThreadTagCounters* getThreadCounters()
+		{
+			if(sThreadCountersReleased)
+				return nullptr;
+
+			static thread_local ThreadTagCounters counters;
+			return &counters;
+		}
+	}
+
+	MemoryTag MemoryTags::getCurrent()
+	{
+		return sCurrentTag;
+	}
+
+	void MemoryTags::_setCurrent(MemoryTag tag)
+	{
+		sCurrentTag = tag;
+	}
+
+	const char* MemoryTags::getName(MemoryTag tag)
+	{
+		if(tag >= MemoryTag::Count)
+			return "Unknown";
+
+		return TAG_NAMES[(UINT32)tag];
+	}
+
+	MemoryTagStats MemoryTags::getStats(MemoryTag tag)
+	{
+		MemoryTagStats stats;
+		if(tag >= MemoryTag::Count)
+			return stats;
+
+		const auto idx = (UINT32)tag;
+		GlobalState& state = getGlobalState();
+
+		INT64 bytes = state.bytes[idx].load(std::memory_order_relaxed);
+		stats.numAllocs = state.numAllocs[idx].load(std::memory_order_relaxed);
+		stats.numFrees = state.numFrees[idx].load(std::memory_order_relaxed);
+		{
+			Lock lock(state.threadsMutex);
+			for(ThreadTagCounters* counters = state.threads; counters != nullptr; counters = counters->next)
+			{
+				bytes += counters->bytes[idx].load(std::memory_order_relaxed);
+				stats.numAllocs += counters->numAllocs[idx].load(std::memory_order_relaxed);
+				stats.numFrees += counters->numFrees[idx].load(std::memory_order_relaxed);
+			}
+		}
+
+		// Counters are read while other threads keep allocating, so the sum can be briefly out of date
+		stats.bytes = bytes > 0 ? (UINT64)bytes : 0;
+
+		UINT64 peakBytes = state.peakBytes[idx].load(std::memory_order_relaxed);
+		while(stats.bytes > peakBytes &&
+			!state.peakBytes[idx].compare_exchange_weak(peakBytes, stats.bytes, std::memory_order_relaxed))
+		{ }
+
+		stats.peakBytes = std::max(peakBytes, stats.bytes);
+		return stats;
+	}
+
+	void* MemoryTags::_tagAllocation(void* base, size_t offset, size_t bytes)
+	{
+		if(base == nullptr)
+			return nullptr;
+
+		const MemoryTag tag = sCurrentTag;
+		const auto idx = (UINT32)tag;
+
+		UINT8* ptr = (UINT8*)base + offset;
+		auto* header = (TagHeader*)(ptr - HEADER_SIZE);
+		header->tag = idx;
+		header->offset = (UINT32)offset;
+		header->size = bytes;
+
+		ThreadTagCounters* counters = getThreadCounters();
+		if(counters)
+		{
+			ThreadTagCounters::add(counters->bytes[idx], (INT64)bytes);
+			ThreadTagCounters::add(counters->numAllocs[idx], (UINT64)1);
+		}
+		else
+		{
+			GlobalState& state = getGlobalState();
+			state.bytes[idx] += (INT64)bytes;
+			state.numAllocs[idx]++;
+		}
+
+		return ptr;
+	}
+
+	void* MemoryTags::_untagAllocation(void* ptr)
+	{
+		if(ptr == nullptr)
+			return nullptr;
+
+		auto* header = (TagHeader*)((UINT8*)ptr - HEADER_SIZE);
+		const UINT32 idx = header->tag;
+		const auto bytes = (INT64)header->size;
+
+		ThreadTagCounters* counters = getThreadCounters();
+		if(counters)
+		{
+			ThreadTagCounters::add(counters->bytes[idx], -bytes);
+			ThreadTagCounters::add(counters->numFrees[idx], (UINT64)1);
+		}
+		else
+		{
+			GlobalState& state = getGlobalState();
+			state.bytes[idx] -= bytes;
+			state.numFrees[idx]++;
+		}
+
+		return (UINT8*)ptr - header->offset;
+	}
+}
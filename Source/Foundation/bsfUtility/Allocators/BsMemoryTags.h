@@ -0,0 +1,129 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+namespace bs
+{
+	/** @addtogroup Memory
+	 *  @{
+	 */
+
+	/** Subsystems that memory allocations can be attributed to. */
+	enum class MemoryTag : UINT8
+	{
+		/** Allocations that weren't attributed to any specific subsystem. */
+		General,
+		Rendering,
+		Animation,
+		Physics,
+		GUI,
+		Resources,
+		Scripting,
+		Count // Keep at end
+	};
+
+	/** Memory usage attributed to a single MemoryTag. */
+	struct MemoryTagStats
+	{
+		/** Number of bytes currently allocated. */
+		UINT64 bytes = 0;
+
+		/** Highest value of @p bytes observed so far. See MemoryTags::getStats(). */
+		UINT64 peakBytes = 0;
+
+		/** Total number of allocations made. */
+		UINT64 numAllocs = 0;
+
+		/** Total number of frees made. */
+		UINT64 numFrees = 0;
+	};
+
+	/**
+	 * Keeps track of memory used by each MemoryTag. Allocations made through GenAlloc are attributed to the tag that
+	 * is current on the allocating thread, which can be changed through MemoryTagScope or by using the tagged variants
+	 * of the allocation methods (e.g. bs_new_tagged()). Frees are attributed to the tag the memory was allocated with,
+	 * regardless of the thread they happen on.
+	 *
+	 * Counters are kept separately for each thread and only summed up when statistics are requested, so tracking
+	 * doesn't require any synchronization between threads.
+	 *
+	 * Tracking is only performed when the framework is built with the MEMORY_TAGS option, as it requires a small header
+	 * to be stored with each allocation. Otherwise all statistics are reported as zero.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT MemoryTags
+	{
+	public:
+		/** Number of bytes stored in front of each allocation when tracking is enabled. */
+		static constexpr UINT32 HEADER_SIZE = 16;
+
+		/** Checks if the framework was built with memory tag tracking enabled. */
+		static constexpr bool isEnabled() { return BS_MEMORY_TAGS != 0; }
+
+		/** Returns the tag new allocations made by the calling thread are attributed to. */
+		static MemoryTag getCurrent();
+
+		/** Returns a human readable name of the provided tag. */
+		static const char* getName(MemoryTag tag);
+
+		/**
+		 * Returns memory usage of the provided tag, summed up over all threads. Peak usage is only updated when this
+		 * method is called, which ProfilingManager does once per frame.
+		 */
+		static MemoryTagStats getStats(MemoryTag tag);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Changes the tag new allocations made by the calling thread are attributed to. */
+		static void _setCurrent(MemoryTag tag);
+
+		/**
+		 * Records a new allocation under the current tag.
+		 *
+		 * @param[in]	base	Memory returned by the underlying allocator. If null, null is returned.
+		 * @param[in]	offset	Offset from @p base at which the user memory starts. Must be at least HEADER_SIZE and
+		 *						must preserve the required alignment.
+		 * @param[in]	bytes	Number of bytes requested by the user.
+		 * @return				Pointer to the user memory.
+		 */
+		static void* _tagAllocation(void* base, size_t offset, size_t bytes);
+
+		/**
+		 * Records a free of memory returned by _tagAllocation(). Returns the pointer originally returned by the
+		 * underlying allocator, or null if @p ptr is null.
+		 */
+		static void* _untagAllocation(void* ptr);
+
+		/** @} */
+	};
+
+	/**
+	 * Changes the memory tag of the calling thread for the lifetime of the object, restoring the previous tag when
+	 * destroyed. Scopes can be nested.
+	 */
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag tag)
+			:mPrevious(MemoryTags::getCurrent())
+		{
+			MemoryTags::_setCurrent(tag);
+		}
+
+		~MemoryTagScope()
+		{
+			MemoryTags::_setCurrent(mPrevious);
+		}
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag mPrevious;
+	};
+
+	/** @} */
+}
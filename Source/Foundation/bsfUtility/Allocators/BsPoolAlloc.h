@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsBitwise.h"
 #include <climits>
 
 namespace bs
@@ -229,6 +230,195 @@ namespace bs
 		UINT32 mNumBlocks = 0;
 	};
 
+	/**
+	 * A thread safe memory allocator that allocates elements of the same size, without using any locks for allocations
+	 * or deallocations. Elements can be freed on a different thread than the one they were allocated on.
+	 *
+	 * Free elements are kept in a single lock-free stack. The head of the stack is an element index combined with a
+	 * counter that changes on every operation, so a thread can't mistake a head that was popped and pushed again in the
+	 * meantime for an unchanged one (ABA problem). A lock is only taken when the pool runs out of elements and needs to
+	 * allocate a new block.
+	 *
+	 * Unlike PoolAlloc, memory of the blocks is only released when the pool is destroyed.
+	 *
+	 * @tparam	ElemSize		Size of a single element in the pool. This will be the exact allocation size. 4 byte minimum.
+	 * @tparam	ElemsPerBlock	Number of elements in the first block. Every following block holds twice as many
+	 *							elements as the block before it.
+	 * @tparam	Alignment		Memory alignment of each allocated element. Note that alignments that are larger than
+	 *							element size, or aren't a multiplier of element size will introduce additionally padding
+	 *							for each element, and therefore require more internal memory.
+	 */
+	template <int ElemSize, int ElemsPerBlock = 512, int Alignment = 4>
+	class LockFreePoolAlloc
+	{
+	public:
+		LockFreePoolAlloc()
+		{
+			static_assert(ElemSize >= 4, "Pool allocator minimum allowed element size is 4 bytes.");
+			static_assert(ElemsPerBlock > 0, "Number of elements per block must be at least 1.");
+			static_assert(ElemsPerBlock * ActualElemSize <= UINT_MAX, "Pool allocator block size too large.");
+		}
+
+		~LockFreePoolAlloc()
+		{
+			const UINT32 numBlocks = mNumBlocks.load(std::memory_order_acquire);
+			for(UINT32 i = 0; i < numBlocks; i++)
+				bs_free_aligned(mBlocks[i]);
+		}
+
+		/** Allocates enough memory for a single element in the pool. */
+		UINT8* alloc()
+		{
+			UINT64 head = mHead.load(std::memory_order_acquire);
+			while(true)
+			{
+				const auto index = (UINT32)head;
+				if(index == NO_ELEMENT)
+				{
+					if(!allocBlock())
+						return nullptr;
+
+					head = mHead.load(std::memory_order_acquire);
+					continue;
+				}
+
+				// Element might get popped and modified by another thread before the exchange below, in which case the
+				// value read here is garbage. The counter in the head will have changed as well, so the exchange fails.
+				UINT8* element = getElement(index);
+				const UINT32 next = ((std::atomic<UINT32>*)element)->load(std::memory_order_relaxed);
+
+				if(mHead.compare_exchange_weak(head, makeHead(next, head), std::memory_order_acquire,
+					std::memory_order_acquire))
+				{
+					return element;
+				}
+			}
+		}
+
+		/** Deallocates an element from the pool. */
+		void free(void* data)
+		{
+			const UINT32 index = getIndex((UINT8*)data);
+			assert(index != NO_ELEMENT);
+
+			UINT64 head = mHead.load(std::memory_order_relaxed);
+			do
+			{
+				((std::atomic<UINT32>*)data)->store((UINT32)head, std::memory_order_relaxed);
+			} while(!mHead.compare_exchange_weak(head, makeHead(index, head), std::memory_order_release,
+				std::memory_order_relaxed));
+		}
+
+		/** Allocates and constructs a single pool element. */
+		template<class T, class... Args>
+		T* construct(Args &&...args)
+		{
+			T* data = (T*)alloc();
+			new ((void*)data) T(std::forward<Args>(args)...);
+
+			return data;
+		}
+
+		/** Destructs and deallocates a single pool element. */
+		template<class T>
+		void destruct(T* data)
+		{
+			data->~T();
+			free(data);
+		}
+
+	private:
+		/** Index value signifying an empty stack, or the end of the stack. Element indices start at 1. */
+		static constexpr UINT32 NO_ELEMENT = 0;
+
+		/** Maximum number of blocks. Elements in all blocks must be addressable using a 32-bit index. */
+		static constexpr UINT32 MAX_BLOCKS = 32;
+
+		/** Returns the number of elements in the block with the specified index. */
+		static constexpr UINT64 getNumBlockElems(UINT32 block) { return (UINT64)ElemsPerBlock << block; }
+
+		/** Returns the index of the first element in the block with the specified index. */
+		static constexpr UINT64 getFirstBlockElem(UINT32 block) { return getNumBlockElems(block) - ElemsPerBlock + 1; }
+
+		/** Creates a new stack head pointing to @p index, with the counter incremented from the previous head. */
+		static UINT64 makeHead(UINT32 index, UINT64 prevHead)
+		{
+			return (((prevHead >> 32) + 1) << 32) | index;
+		}
+
+		/** Returns the address of the element with the specified index. */
+		UINT8* getElement(UINT32 index) const
+		{
+			// Element indices in block i start from ElemsPerBlock * (2^i - 1) + 1
+			const UINT32 block = Bitwise::mostSignificantBit((UINT32)((index - 1) / ElemsPerBlock + 1));
+			const UINT64 offset = index - getFirstBlockElem(block);
+
+			return mBlocks[block] + offset * ActualElemSize;
+		}
+
+		/** Returns the index of the element at the specified address, or NO_ELEMENT if not part of this pool. */
+		UINT32 getIndex(UINT8* data) const
+		{
+			const UINT32 numBlocks = mNumBlocks.load(std::memory_order_acquire);
+			for(UINT32 i = 0; i < numBlocks; i++)
+			{
+				UINT8* blockData = mBlocks[i];
+				if(data >= blockData && data < blockData + getNumBlockElems(i) * ActualElemSize)
+					return (UINT32)(getFirstBlockElem(i) + (data - blockData) / ActualElemSize);
+			}
+
+			return NO_ELEMENT;
+		}
+
+		/**
+		 * Allocates a new block and pushes all of its elements to the free stack. Does nothing if another thread
+		 * already added a block since the stack was found empty. Returns false if the maximum number of elements was
+		 * reached.
+		 */
+		bool allocBlock()
+		{
+			Lock lock(mBlockMutex);
+
+			if((UINT32)mHead.load(std::memory_order_acquire) != NO_ELEMENT)
+				return true;
+
+			const UINT32 block = mNumBlocks.load(std::memory_order_relaxed);
+			if(block >= MAX_BLOCKS || getFirstBlockElem(block) + getNumBlockElems(block) > UINT_MAX)
+			{
+				assert(false && "Maximum number of pool elements reached.");
+				return false;
+			}
+
+			const auto numElems = (UINT32)getNumBlockElems(block);
+			const auto firstElem = (UINT32)getFirstBlockElem(block);
+
+			auto* blockData = (UINT8*)bs_alloc_aligned(numElems * (size_t)ActualElemSize, Alignment);
+			for(UINT32 i = 0; i < numElems - 1; i++)
+				*(UINT32*)&blockData[i * (size_t)ActualElemSize] = firstElem + i + 1;
+
+			mBlocks[block] = blockData;
+			mNumBlocks.store(block + 1, std::memory_order_release);
+
+			// Frees can push new elements while the lock is held, so the block is linked in front of whatever is there
+			auto* lastElem = (std::atomic<UINT32>*)&blockData[(numElems - 1) * (size_t)ActualElemSize];
+			UINT64 head = mHead.load(std::memory_order_relaxed);
+			do
+			{
+				lastElem->store((UINT32)head, std::memory_order_relaxed);
+			} while(!mHead.compare_exchange_weak(head, makeHead(firstElem, head), std::memory_order_release,
+				std::memory_order_relaxed));
+
+			return true;
+		}
+
+		static constexpr int ActualElemSize = ((ElemSize + Alignment - 1) / Alignment) * Alignment;
+
+		std::atomic<UINT64> mHead { NO_ELEMENT };
+		std::atomic<UINT32> mNumBlocks { 0 };
+		UINT8* mBlocks[MAX_BLOCKS] = { };
+		Mutex mBlockMutex;
+	};
+
 	/** 
 	 * Helper class used by GlobalPoolAlloc that allocates a static pool allocator. GlobalPoolAlloc cannot do it
 	 * directly since it gets specialized which means the static members would need to be defined in the implementation
@@ -293,5 +483,94 @@ namespace bs
 		bs_pool_free(ptr);
 	}
 
+	/** 
+	 * Allocator for the standard library that allocates single elements from a lock-free pool, with a separate pool
+	 * for each type. Allocations of multiple elements at once use the general allocator. Primarily meant for use with 
+	 * std::allocate_shared(), so both the object and the shared pointer control block get allocated from a pool.
+	 */
+	template <class T, int ElemsPerBlock = 512>
+	class StdPoolAlloc
+	{
+	public:
+		typedef T value_type;
+		typedef value_type* pointer;
+		typedef const value_type* const_pointer;
+		typedef value_type& reference;
+		typedef const value_type& const_reference;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		StdPoolAlloc() noexcept = default;
+		template<class U> StdPoolAlloc(const StdPoolAlloc<U, ElemsPerBlock>&) noexcept { }
+
+		template<class U> bool operator==(const StdPoolAlloc<U, ElemsPerBlock>&) const noexcept { return true; }
+		template<class U> bool operator!=(const StdPoolAlloc<U, ElemsPerBlock>&) const noexcept { return false; }
+		template<class U> class rebind { public: typedef StdPoolAlloc<U, ElemsPerBlock> other; };
+
+		/** Allocate but don't initialize number elements of type T.*/
+		T* allocate(const size_t num) const
+		{
+			if (num == 0)
+				return nullptr;
+
+			if (num == 1)
+				return (T*)getPool().alloc();
+
+			if (num > static_cast<size_t>(-1) / sizeof(T))
+				return nullptr; // Error
+
+			return (T*)bs_alloc(num * sizeof(T));
+		}
+
+		/** Deallocate storage p of deleted elements. */
+		void deallocate(T* p, size_t num) const noexcept
+		{
+			if (num == 1)
+				getPool().free(p);
+			else
+				bs_free(p);
+		}
+
+	private:
+		static constexpr int ElemSize = sizeof(T) < 4 ? 4 : (int)sizeof(T);
+		static constexpr int ElemAlignment = alignof(T) < 4 ? 4 : (int)alignof(T);
+		typedef LockFreePoolAlloc<ElemSize, ElemsPerBlock, ElemAlignment> Pool;
+
+		/** 
+		 * Returns the pool for this type. The pool is purposely never destroyed, so objects with static storage 
+		 * duration can safely release their elements regardless of destruction order.
+		 */
+		static Pool& getPool()
+		{
+			static Pool* pool = new (bs_alloc(sizeof(Pool))) Pool();
+			return *pool;
+		}
+	};
+
+	/** 
+	 * Allocates memory for a single object of type T from the pool StdPoolAlloc uses for that type, without
+	 * constructing it.
+	 */
+	template<class T, int ElemsPerBlock = 512>
+	T* bs_std_pool_alloc()
+	{
+		return StdPoolAlloc<T, ElemsPerBlock>().allocate(1);
+	}
+
+	/** Destructs and frees an object allocated with bs_std_pool_alloc(). */
+	template<class T, int ElemsPerBlock = 512>
+	void bs_std_pool_delete(T* ptr)
+	{
+		ptr->~T();
+		StdPoolAlloc<T, ElemsPerBlock>().deallocate(ptr, 1);
+	}
+
+	/** Creates a new shared pointer, allocating the object and the pointer data from a pool of the object type. */
+	template<class T, class... Args>
+	SPtr<T> bs_pool_shared_ptr_new(Args &&...args)
+	{
+		return std::allocate_shared<T>(StdPoolAlloc<T>(), std::forward<Args>(args)...);
+	}
+
 	/** @} */
 }
@@ -123,7 +123,7 @@ namespace bs
 			mTotalAllocBytes -= *storedSize;
 #endif
 
-			if(data > mStaticData && data < (mStaticData + BlockSize))
+			if(dataPtr >= mStaticData && dataPtr < (mStaticData + BlockSize))
 			{
 				if((((UINT8*)data) + allocSize) == (mStaticData + mFreePtr))
 					mFreePtr -= allocSize;
@@ -257,7 +257,7 @@ namespace bs
 		/** Deallocate storage p of deleted elements. */
 		void deallocate(T* p, size_t num) const noexcept
 		{
-			mStaticAlloc->free((UINT8*)p, (UINT32)num);
+			mStaticAlloc->free((UINT8*)p, (UINT32)(num * sizeof(T)));
 		}
 
 		StaticAlloc<BlockSize, FreeAlloc>* mStaticAlloc = nullptr;
@@ -0,0 +1,454 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsThreadCacheAlloc.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	namespace
+	{
+		/** Number of bytes reserved in front of every allocation. Keeps the returned memory 16 byte aligned. */
+		constexpr UINT32 HEADER_SIZE = 16;
+
+		/** Size of the largest size class, including the header. Larger allocations are forwarded to the system. */
+		constexpr UINT32 MAX_SMALL_SIZE = 32768;
+
+		/** Eight 16 byte classes up to 128 bytes, followed by four classes per power of two up to MAX_SMALL_SIZE. */
+		constexpr UINT32 NUM_SIZE_CLASSES = 8 + (15 - 7) * 4;
+
+		/** Size class stored in the header of allocations forwarded to the system allocator. */
+		constexpr UINT32 LARGE_ALLOC = (UINT32)-1;
+
+		/** Minimum size of a span requested from the system, to be split into blocks of a single size class. */
+		constexpr UINT32 MIN_SPAN_SIZE = 64 * 1024;
+
+		/** Minimum number of blocks in a single span. */
+		constexpr UINT32 MIN_BLOCKS_PER_SPAN = 8;
+
+		/** Block that is currently not allocated, stored in a free list. */
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		/** Header stored in front of every allocation. */
+		struct BlockHeader
+		{
+			UINT32 sizeClass;
+			UINT32 padding;
+			UINT64 size; /**< Requested size, only valid for allocations forwarded to the system. */
+		};
+
+		static_assert(sizeof(BlockHeader) == HEADER_SIZE, "Block header must not change the allocation alignment.");
+
+		/** Counters of a single thread. Only written by the owning thread, but readable from any thread. */
+		struct ThreadCounters
+		{
+			/** Increments a counter. Avoids a locked read-modify-write since there is only ever a single writer. */
+			static void add(std::atomic<UINT64>& counter, UINT64 value)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+
+			/** Adds the values of the counters to the provided statistics. */
+			void accumulate(ThreadCacheAllocStats& stats) const
+			{
+				stats.numAllocs += numAllocs.load(std::memory_order_relaxed);
+				stats.numFrees += numFrees.load(std::memory_order_relaxed);
+				stats.bytesAllocated += bytesAllocated.load(std::memory_order_relaxed);
+				stats.bytesFreed += bytesFreed.load(std::memory_order_relaxed);
+			}
+
+			std::atomic<UINT64> numAllocs { 0 };
+			std::atomic<UINT64> numFrees { 0 };
+			std::atomic<UINT64> bytesAllocated { 0 };
+			std::atomic<UINT64> bytesFreed { 0 };
+		};
+
+		/** List of free blocks of a single size class, shared by all threads. */
+		struct CentralFreeList
+		{
+			Mutex mutex;
+			FreeBlock* head = nullptr;
+			UINT32 count = 0;
+		};
+
+		struct ThreadCache;
+
+		/** State shared between all threads. */
+		struct GlobalState
+		{
+			CentralFreeList freeLists[NUM_SIZE_CLASSES];
+
+			Mutex threadsMutex;
+			ThreadCache* threads = nullptr;
+
+			/** Statistics of threads whose caches were released, and of allocations made after that. */
+			std::atomic<UINT64> numAllocs { 0 };
+			std::atomic<UINT64> numFrees { 0 };
+			std::atomic<UINT64> bytesAllocated { 0 };
+			std::atomic<UINT64> bytesFreed { 0 };
+		};
+
+		GlobalState& getGlobalState()
+		{
+			// Intentionally never destroyed since thread caches can be released after the static destructors ran.
+			// Allocated from the system so the global state doesn't depend on the allocator it serves.
+			static GlobalState* state = new (::malloc(sizeof(GlobalState))) GlobalState();
+			return *state;
+		}
+
+		/** Returns the index of the size class able to hold @p size bytes. @p size must not exceed MAX_SMALL_SIZE. */
+		UINT32 getSizeClass(size_t size)
+		{
+			if(size <= 128)
+				return (UINT32)((size + 15) >> 4) - 1;
+
+			const UINT32 log2 = Bitwise::mostSignificantBit((UINT32)(size - 1));
+			const UINT32 subClass = (UINT32)((size - 1) >> (log2 - 2)) & 0x3;
+
+			return 8 + (log2 - 7) * 4 + subClass;
+		}
+
+		/** Returns the size of a block in the specified size class, in bytes. */
+		UINT32 getClassSize(UINT32 sizeClass)
+		{
+			if(sizeClass < 8)
+				return (sizeClass + 1) * 16;
+
+			const UINT32 log2 = 7 + (sizeClass - 8) / 4;
+			const UINT32 subClass = (sizeClass - 8) % 4;
+
+			return (5 + subClass) << (log2 - 2);
+		}
+
+		/** Returns the number of blocks moved between a thread cache and the central free list at once. */
+		UINT32 getBatchSize(UINT32 sizeClass)
+		{
+			return std::min(std::max(MIN_SPAN_SIZE / getClassSize(sizeClass), 4U), 64U);
+		}
+
+		/**
+		 * Requests a new span of memory from the system, splits it into blocks of the specified size class and adds
+		 * them to the provided list. Returns false if the system is out of memory.
+		 */
+		bool allocateSpan(UINT32 sizeClass, FreeBlock*& head, UINT32& count)
+		{
+			const UINT32 classSize = getClassSize(sizeClass);
+			const UINT32 spanSize = std::max(MIN_SPAN_SIZE, classSize * MIN_BLOCKS_PER_SPAN);
+
+			// System allocations are at least 16 byte aligned, and all class sizes are multiples of 16
+			auto* span = (UINT8*)::malloc(spanSize);
+			if(span == nullptr)
+				return false;
+
+			const UINT32 numBlocks = spanSize / classSize;
+			for(UINT32 i = numBlocks; i > 0; i--)
+			{
+				auto* block = (FreeBlock*)(span + (i - 1) * classSize);
+				block->next = head;
+				head = block;
+			}
+
+			count += numBlocks;
+			return true;
+		}
+
+		/** Cache of free blocks, owned by a single thread. */
+		struct ThreadCache
+		{
+			ThreadCache();
+			~ThreadCache();
+
+			/** Moves a batch of blocks from the central free list, or from a new span, into the cache. */
+			bool refill(UINT32 sizeClass);
+
+			/** Moves a batch of blocks from the cache back to the central free list. */
+			void release(UINT32 sizeClass);
+
+			FreeBlock* freeLists[NUM_SIZE_CLASSES] = {};
+			UINT32 counts[NUM_SIZE_CLASSES] = {};
+			ThreadCounters counters;
+
+			ThreadCache* prev = nullptr;
+			ThreadCache* next = nullptr;
+		};
+
+		/** Set once the cache of the current thread is released, after which only the central lists are used. */
+		BS_THREADLOCAL bool sThreadCacheReleased = false;
+
+		ThreadCache::ThreadCache()
+		{
+			GlobalState& state = getGlobalState();
+
+			Lock lock(state.threadsMutex);
+			next = state.threads;
+			if(next)
+				next->prev = this;
+
+			state.threads = this;
+		}
+
+		ThreadCache::~ThreadCache()
+		{
+			GlobalState& state = getGlobalState();
+
+			for(UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+			{
+				while(counts[i] > 0)
+					release(i);
+			}
+
+			Lock lock(state.threadsMutex);
+			if(prev)
+				prev->next = next;
+			else
+				state.threads = next;
+
+			if(next)
+				next->prev = prev;
+
+			// Keep the statistics of the exited thread
+			state.numAllocs += counters.numAllocs.load(std::memory_order_relaxed);
+			state.numFrees += counters.numFrees.load(std::memory_order_relaxed);
+			state.bytesAllocated += counters.bytesAllocated.load(std::memory_order_relaxed);
+			state.bytesFreed += counters.bytesFreed.load(std::memory_order_relaxed);
+
+			sThreadCacheReleased = true;
+		}
+
+		bool ThreadCache::refill(UINT32 sizeClass)
+		{
+			CentralFreeList& centralList = getGlobalState().freeLists[sizeClass];
+			const UINT32 batchSize = getBatchSize(sizeClass);
+
+			FreeBlock* first = nullptr;
+			UINT32 numBlocks = 0;
+			{
+				Lock lock(centralList.mutex);
+
+				if(centralList.count > 0)
+				{
+					first = centralList.head;
+
+					FreeBlock* last = first;
+					numBlocks = 1;
+					while(numBlocks < batchSize && last->next != nullptr)
+					{
+						last = last->next;
+						numBlocks++;
+					}
+
+					centralList.head = last->next;
+					centralList.count -= numBlocks;
+					last->next = freeLists[sizeClass];
+				}
+			}
+
+			if(numBlocks == 0)
+				return allocateSpan(sizeClass, freeLists[sizeClass], counts[sizeClass]);
+
+			freeLists[sizeClass] = first;
+			counts[sizeClass] += numBlocks;
+
+			return true;
+		}
+
+		void ThreadCache::release(UINT32 sizeClass)
+		{
+			CentralFreeList& centralList = getGlobalState().freeLists[sizeClass];
+			const UINT32 numBlocks = std::min(getBatchSize(sizeClass), counts[sizeClass]);
+
+			FreeBlock* first = freeLists[sizeClass];
+			FreeBlock* last = first;
+			for(UINT32 i = 1; i < numBlocks; i++)
+				last = last->next;
+
+			freeLists[sizeClass] = last->next;
+			counts[sizeClass] -= numBlocks;
+
+			Lock lock(centralList.mutex);
+			last->next = centralList.head;
+			centralList.head = first;
+			centralList.count += numBlocks;
+		}
+
+		/** Returns the cache of the current thread, or null if it was already released during thread exit. */
+		ThreadCache* getThreadCache()
+		{
+			if(sThreadCacheReleased)
+				return nullptr;
+
+			static thread_local ThreadCache cache;
+			return &cache;
+		}
+
+		/** Allocates a block directly from the central free list. Used when the thread has no cache. */
+		FreeBlock* allocateFromCentralList(UINT32 sizeClass)
+		{
+			CentralFreeList& centralList = getGlobalState().freeLists[sizeClass];
+
+			Lock lock(centralList.mutex);
+			if(centralList.count == 0 && !allocateSpan(sizeClass, centralList.head, centralList.count))
+				return nullptr;
+
+			FreeBlock* block = centralList.head;
+			centralList.head = block->next;
+			centralList.count--;
+
+			return block;
+		}
+
+		/** Returns a block directly to the central free list. Used when the thread has no cache. */
+		void freeToCentralList(UINT32 sizeClass, FreeBlock* block)
+		{
+			CentralFreeList& centralList = getGlobalState().freeLists[sizeClass];
+
+			Lock lock(centralList.mutex);
+			block->next = centralList.head;
+			centralList.head = block;
+			centralList.count++;
+		}
+
+		/** Records an allocation or a free in the statistics of the current thread. */
+		void recordStats(ThreadCache* cache, bool alloc, UINT64 bytes)
+		{
+			if(cache)
+			{
+				ThreadCounters& counters = cache->counters;
+				if(alloc)
+				{
+					ThreadCounters::add(counters.numAllocs, 1);
+					ThreadCounters::add(counters.bytesAllocated, bytes);
+				}
+				else
+				{
+					ThreadCounters::add(counters.numFrees, 1);
+					ThreadCounters::add(counters.bytesFreed, bytes);
+				}
+			}
+			else
+			{
+				GlobalState& state = getGlobalState();
+				if(alloc)
+				{
+					state.numAllocs++;
+					state.bytesAllocated += bytes;
+				}
+				else
+				{
+					state.numFrees++;
+					state.bytesFreed += bytes;
+				}
+			}
+		}
+	}
+
+	void* ThreadCacheAlloc::allocate(size_t bytes)
+	{
+		ThreadCache* cache = getThreadCache();
+
+		const size_t totalSize = bytes + HEADER_SIZE;
+		if(totalSize > MAX_SMALL_SIZE)
+		{
+			auto* header = (BlockHeader*)::malloc(totalSize);
+			if(header == nullptr)
+				return nullptr;
+
+			header->sizeClass = LARGE_ALLOC;
+			header->size = bytes;
+
+			recordStats(cache, true, bytes);
+			return (UINT8*)header + HEADER_SIZE;
+		}
+
+		const UINT32 sizeClass = getSizeClass(totalSize);
+
+		FreeBlock* block;
+		if(cache)
+		{
+			if(cache->counts[sizeClass] == 0 && !cache->refill(sizeClass))
+				return nullptr;
+
+			block = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block->next;
+			cache->counts[sizeClass]--;
+		}
+		else
+		{
+			block = allocateFromCentralList(sizeClass);
+			if(block == nullptr)
+				return nullptr;
+		}
+
+		auto* header = (BlockHeader*)block;
+		header->sizeClass = sizeClass;
+
+		recordStats(cache, true, getClassSize(sizeClass));
+		return (UINT8*)header + HEADER_SIZE;
+	}
+
+	void ThreadCacheAlloc::free(void* ptr)
+	{
+		if(ptr == nullptr)
+			return;
+
+		ThreadCache* cache = getThreadCache();
+
+		auto* header = (BlockHeader*)((UINT8*)ptr - HEADER_SIZE);
+		const UINT32 sizeClass = header->sizeClass;
+		if(sizeClass == LARGE_ALLOC)
+		{
+			recordStats(cache, false, header->size);
+			::free(header);
+			return;
+		}
+
+		recordStats(cache, false, getClassSize(sizeClass));
+
+		auto* block = (FreeBlock*)header;
+		if(cache)
+		{
+			block->next = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block;
+			cache->counts[sizeClass]++;
+
+			// Keep a batch in the cache after releasing, so alternating allocs and frees don't move the same batch
+			// back and forth
+			if(cache->counts[sizeClass] > getBatchSize(sizeClass) * 2)
+				cache->release(sizeClass);
+		}
+		else
+			freeToCentralList(sizeClass, block);
+	}
+
+	ThreadCacheAllocStats ThreadCacheAlloc::getThreadStats()
+	{
+		ThreadCacheAllocStats stats;
+
+		ThreadCache* cache = getThreadCache();
+		if(cache)
+			cache->counters.accumulate(stats);
+
+		return stats;
+	}
+
+	ThreadCacheAllocStats ThreadCacheAlloc::getGlobalStats()
+	{
+		GlobalState& state = getGlobalState();
+
+		ThreadCacheAllocStats stats;
+
+		Lock lock(state.threadsMutex);
+		for(ThreadCache* cache = state.threads; cache != nullptr; cache = cache->next)
+			cache->counters.accumulate(stats);
+
+		stats.numAllocs += state.numAllocs.load(std::memory_order_relaxed);
+		stats.numFrees += state.numFrees.load(std::memory_order_relaxed);
+		stats.bytesAllocated += state.bytesAllocated.load(std::memory_order_relaxed);
+		stats.bytesFreed += state.bytesFreed.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+}
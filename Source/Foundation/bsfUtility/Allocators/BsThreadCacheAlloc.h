@@ -0,0 +1,69 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/** Allocation statistics gathered by ThreadCacheAlloc. */
+	struct ThreadCacheAllocStats
+	{
+		/** Number of allocations performed. */
+		UINT64 numAllocs = 0;
+
+		/** Number of frees performed. */
+		UINT64 numFrees = 0;
+
+		/**
+		 * Total number of bytes allocated, rounded up to the size class of each allocation. Large allocations are
+		 * counted using their requested size.
+		 */
+		UINT64 bytesAllocated = 0;
+
+		/** Total number of bytes freed, counted the same way as @p bytesAllocated. */
+		UINT64 bytesFreed = 0;
+	};
+
+	/**
+	 * General purpose allocator that keeps a cache of free blocks on each thread, so most allocations and frees don't
+	 * need to take a lock. Allocations are rounded up to one of a set of size classes, and each thread keeps a
+	 * separate list of free blocks for every size class. Blocks are carved from larger spans requested from the
+	 * system, and are exchanged in batches with a global list when a thread's cache runs out or grows too large.
+	 * Allocations larger than the largest size class are forwarded to the system allocator.
+	 *
+	 * Blocks freed on a thread other than the one that allocated them are added to the freeing thread's cache. Memory
+	 * of the spans is never returned to the system, but it is reused for all future allocations of the same size class.
+	 *
+	 * Used as the backend for GenAlloc when the framework is built with the ThreadCache general allocator.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT ThreadCacheAlloc
+	{
+	public:
+		/** Allocates @p bytes bytes. Returned memory is aligned to a 16 byte boundary. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory allocated with allocate(). */
+		static void free(void* ptr);
+
+		/**
+		 * Returns the allocation statistics of the calling thread. Frees are counted on the thread that performed them,
+		 * which isn't necessarily the thread that performed the allocation.
+		 */
+		static ThreadCacheAllocStats getThreadStats();
+
+		/** Returns the allocation statistics summed over all threads that used the allocator, including exited ones. */
+		static ThreadCacheAllocStats getGlobalStats();
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -4,6 +4,7 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsProfiledMutex.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -43,6 +44,7 @@ set(BS_UTILITY_SRC_IMAGE
 set(BS_UTILITY_SRC_UTILITY
 	"bsfUtility/Utility/BsDynLib.cpp"
 	"bsfUtility/Utility/BsDynLibManager.cpp"
+	"bsfUtility/Utility/BsEvent.cpp"
 	"bsfUtility/Utility/BsMessageHandler.cpp"
 	"bsfUtility/Utility/BsTimer.cpp"
 	"bsfUtility/Utility/BsTime.cpp"
@@ -51,6 +53,7 @@ set(BS_UTILITY_SRC_UTILITY
 	"bsfUtility/Utility/BsTriangulation.cpp"
 	"bsfUtility/Utility/BsUUID.cpp"
 	"bsfUtility/Utility/BsLookupTable.cpp"
+	"bsfUtility/Utility/BsBVH.cpp"
 )
 
 set(BS_UTILITY_INC_DEBUG
@@ -63,18 +66,21 @@ set(BS_UTILITY_INC_FILESYSTEM
 	"bsfUtility/FileSystem/BsFileSystem.h"
 	"bsfUtility/FileSystem/BsDataStream.h"
 	"bsfUtility/FileSystem/BsPath.h"
+	"bsfUtility/FileSystem/BsAsyncFileIO.h"
 )
 
 set(BS_UTILITY_SRC_FILESYSTEM
 	"bsfUtility/FileSystem/BsDataStream.cpp"
 	"bsfUtility/FileSystem/BsFileSystem.cpp"
 	"bsfUtility/FileSystem/BsPath.cpp"
+	"bsfUtility/FileSystem/BsAsyncFileIO.cpp"
 )
 
 set(BS_UTILITY_SRC_THREADING
 	"bsfUtility/Threading/BsAsyncOp.cpp"
 	"bsfUtility/Threading/BsTaskScheduler.cpp"
 	"bsfUtility/Threading/BsThreadPool.cpp"
+	"bsfUtility/Threading/BsProfiledMutex.cpp"
 )
 
 set(BS_UTILITY_INC_UTILITY
@@ -83,6 +89,7 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsBitwise.h"
 	"bsfUtility/Utility/BsDynLib.h"
 	"bsfUtility/Utility/BsDynLibManager.h"
+	"bsfUtility/Utility/BsDelegate.h"
 	"bsfUtility/Utility/BsEvent.h"
 	"bsfUtility/Utility/BsMessageHandler.h"
 	"bsfUtility/Utility/BsMessageHandlerFwd.h"
@@ -103,12 +110,17 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsSmallVector.h"
 	"bsfUtility/Utility/BsDynArray.h"
 	"bsfUtility/Utility/BsMinHeap.h"
+	"bsfUtility/Utility/BsRadixSort.h"
+	"bsfUtility/Utility/BsBVH.h"
 )
 
 set(BS_UTILITY_SRC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.cpp"
+	"bsfUtility/Allocators/BsFrameArena.cpp"
 	"bsfUtility/Allocators/BsStackAlloc.cpp"
 	"bsfUtility/Allocators/BsMemoryAllocator.cpp"
+	"bsfUtility/Allocators/BsThreadCacheAlloc.cpp"
+	"bsfUtility/Allocators/BsMemoryTags.cpp"
 )
 
 set(BS_UTILITY_SRC_REFLECTION
@@ -131,6 +143,7 @@ set(BS_UTILITY_INC_RTTI
 
 set(BS_UTILITY_INC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.h"
+	"bsfUtility/Allocators/BsFrameArena.h"
 	"bsfUtility/Allocators/BsMemAllocProfiler.h"
 	"bsfUtility/Allocators/BsMemoryAllocator.h"
 	"bsfUtility/Allocators/BsStackAlloc.h"
@@ -138,6 +151,8 @@ set(BS_UTILITY_INC_ALLOCATORS
 	"bsfUtility/Allocators/BsGroupAlloc.h"
 	"bsfUtility/Allocators/BsFreeAlloc.h"
 	"bsfUtility/Allocators/BsPoolAlloc.h"
+	"bsfUtility/Allocators/BsThreadCacheAlloc.h"
+	"bsfUtility/Allocators/BsMemoryTags.h"
 )
 
 set(BS_UTILITY_INC_THIRDPARTY
@@ -181,12 +196,14 @@ set(BS_UTILITY_INC_TESTING
 	"bsfUtility/Testing/BsTestSuite.h"
 	"bsfUtility/Testing/BsTestOutput.h"
 	"bsfUtility/Testing/BsConsoleTestOutput.h"
+	"bsfUtility/Testing/BsBenchmarkOutput.h"
 )
 
 set(BS_UTILITY_SRC_TESTING
 	"bsfUtility/Testing/BsTestSuite.cpp"
 	"bsfUtility/Testing/BsTestOutput.cpp"
 	"bsfUtility/Testing/BsConsoleTestOutput.cpp"
+	"bsfUtility/Testing/BsBenchmarkOutput.cpp"
 )
 
 set(BS_UTILITY_SRC_SERIALIZATION
@@ -196,6 +213,7 @@ set(BS_UTILITY_SRC_SERIALIZATION
 	"bsfUtility/Serialization/BsBinaryDiff.cpp"
 	"bsfUtility/Serialization/BsSerializedObject.cpp"
 	"bsfUtility/Serialization/BsBinaryCloner.cpp"
+	"bsfUtility/Serialization/BsBinaryCompare.cpp"
 )
 
 set(BS_UTILITY_INC_MATH
@@ -241,6 +259,7 @@ set(BS_UTILITY_INC_SERIALIZATION
 	"bsfUtility/Serialization/BsBinaryDiff.h"
 	"bsfUtility/Serialization/BsSerializedObject.h"
 	"bsfUtility/Serialization/BsBinaryCloner.h"
+	"bsfUtility/Serialization/BsBinaryCompare.h"
 )
 
 set(BS_UTILITY_SRC_STRING
@@ -267,6 +286,7 @@ set(BS_UTILITY_INC_WIN32
 
 set(BS_UTILITY_SRC_WIN32
 	"bsfUtility/Private/Win32/BsWin32FileSystem.cpp"
+	"bsfUtility/Private/Win32/BsWin32AsyncFileIO.cpp"
 	"bsfUtility/Private/Win32/BsWin32CrashHandler.cpp"
 	"bsfUtility/Private/Win32/BsWin32PlatformUtility.cpp"
 	"bsfUtility/Private/Win32/BsWin32Window.cpp"
@@ -275,6 +295,7 @@ set(BS_UTILITY_SRC_WIN32
 
 set(BS_UTILITY_SRC_UNIX
 	"bsfUtility/Private/Unix/BsUnixFileSystem.cpp"
+	"bsfUtility/Private/Unix/BsUnixAsyncFileIO.cpp"
 	"bsfUtility/Private/Unix/BsUnixCrashHandler.cpp"
 )
 
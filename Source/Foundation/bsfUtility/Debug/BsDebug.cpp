@@ -32,33 +32,203 @@ void logToIDEConsole(const bs::String& message, const char* channel)
 
 namespace bs
 {
+	/** Time window over which the number of repeats of a message is limited, in milliseconds. */
+	static constexpr UINT64 REPEAT_WINDOW_MS = 1000;
+
+	/** Maximum time the writer thread sleeps for before checking for new messages, in milliseconds. */
+	static constexpr UINT32 WRITER_SLEEP_MS = 100;
+
+	/** Returns the name used for the channel when writing out log entries, or null for custom channels. */
+	static const char* getChannelName(UINT32 channel)
+	{
+		if (channel == (UINT32)DebugChannel::Debug)
+			return "DEBUG";
+		if (channel == (UINT32)DebugChannel::Warning || channel == (UINT32)DebugChannel::CompilerWarning)
+			return "WARNING";
+		if (channel == (UINT32)DebugChannel::Error || channel == (UINT32)DebugChannel::CompilerError)
+			return "ERROR";
+
+		return nullptr;
+	}
+
 	void Debug::logDebug(const String& msg)
 	{
-		mLog.logMsg(msg, (UINT32)DebugChannel::Debug);
-		logToIDEConsole(msg, "DEBUG");
+		log(msg, (UINT32)DebugChannel::Debug);
 	}
 
 	void Debug::logWarning(const String& msg)
 	{
-		mLog.logMsg(msg, (UINT32)DebugChannel::Warning);
-		logToIDEConsole(msg, "WARNING");
+		log(msg, (UINT32)DebugChannel::Warning);
 	}
 
 	void Debug::logError(const String& msg)
 	{
-		mLog.logMsg(msg, (UINT32)DebugChannel::Error);
-		logToIDEConsole(msg, "ERROR");
+		log(msg, (UINT32)DebugChannel::Error);
 	}
 
 	void Debug::log(const String& msg, UINT32 channel)
 	{
-		mLog.logMsg(msg, channel);
-		if (channel == (UINT32)DebugChannel::Debug)
-			logToIDEConsole(msg, "DEBUG");
-		if (channel == (UINT32)DebugChannel::Warning || channel == (UINT32)DebugChannel::CompilerWarning)
-			logToIDEConsole(msg, "WARNING");
-		if (channel == (UINT32)DebugChannel::Error || channel == (UINT32)DebugChannel::CompilerError)
-			logToIDEConsole(msg, "ERROR");
+		if (!isChannelEnabled(channel))
+			return;
+
+		UINT32 numSuppressed;
+		if (!checkRepeatLimit(msg, numSuppressed))
+			return;
+
+		if (numSuppressed > 0)
+			mLog.logMsg(msg + "\t\t(" + toString(numSuppressed) + " identical messages were suppressed)\n", channel);
+		else
+			mLog.logMsg(msg, channel);
+
+		// Errors are written out immediately, in case the application terminates right after
+		const bool isError = channel == (UINT32)DebugChannel::Error || channel == (UINT32)DebugChannel::CompilerError;
+		if (mWriterRunning.load(std::memory_order_acquire) && !isError)
+			mWriterSignal.notify_one();
+		else
+			writeEntries();
+	}
+
+	void Debug::setChannelEnabled(UINT32 channel, bool enabled)
+	{
+		if (channel >= 64)
+			return;
+
+		const UINT64 bit = 1ULL << channel;
+		if (enabled)
+			mDisabledChannels.fetch_and(~bit, std::memory_order_relaxed);
+		else
+			mDisabledChannels.fetch_or(bit, std::memory_order_relaxed);
+	}
+
+	bool Debug::isChannelEnabled(UINT32 channel) const
+	{
+		if (channel >= 64)
+			return true;
+
+		return (mDisabledChannels.load(std::memory_order_relaxed) & (1ULL << channel)) == 0;
+	}
+
+	bool Debug::checkRepeatLimit(const String& msg, UINT32& numSuppressed)
+	{
+		numSuppressed = 0;
+
+		const UINT32 maxRepeats = mMaxRepeats.load(std::memory_order_relaxed);
+		if (maxRepeats == 0)
+			return true;
+
+		// Zero marks an unused slot
+		const UINT64 hash = (UINT64)std::hash<String>()(msg) | 1;
+		const UINT64 now = (UINT64)std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+
+		// Note: The slots are updated without locking, so with multiple threads logging at once the limit is only
+		// approximate. Different messages sharing a slot keep resetting each other's window, and aren't limited.
+		RepeatSlot& slot = mRepeatSlots[hash % NUM_REPEAT_SLOTS];
+		if (slot.hash.load(std::memory_order_relaxed) != hash ||
+			now - slot.windowStart.load(std::memory_order_relaxed) >= REPEAT_WINDOW_MS)
+		{
+			if (slot.hash.exchange(hash, std::memory_order_relaxed) == hash)
+				numSuppressed = slot.numSuppressed.exchange(0, std::memory_order_relaxed);
+			else
+				slot.numSuppressed.store(0, std::memory_order_relaxed);
+
+			slot.windowStart.store(now, std::memory_order_relaxed);
+			slot.count.store(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		if (slot.count.fetch_add(1, std::memory_order_relaxed) < maxRepeats)
+			return true;
+
+		slot.numSuppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void Debug::setLogFile(const Path& path)
+	{
+		Lock lock(mWriteMutex);
+
+		if (mLogFile)
+			mLogFile->close();
+
+		if (!path.isEmpty())
+			mLogFile = FileSystem::createAndOpenFile(path);
+		else
+			mLogFile = nullptr;
+	}
+
+	void Debug::writeEntries()
+	{
+		// Keeps the entries in order when written from multiple threads
+		Lock lock(mWriteMutex);
+
+		Vector<LogEntry> entries = mLog.getUnwrittenEntries();
+		for (auto& entry : entries)
+		{
+			const char* channelName = getChannelName(entry.getChannel());
+			if (channelName != nullptr)
+				logToIDEConsole(entry.getMessage(), channelName);
+
+			if (mLogFile)
+			{
+				if (channelName == nullptr)
+					channelName = "CUSTOM";
+
+				StringStream stream;
+				stream << "[" << entry.getLocalTime() << "] [" << channelName << "] " << entry.getMessage() << "\n";
+
+				mLogFile->writeString(stream.str());
+			}
+		}
+	}
+
+	void Debug::_startWriterThread()
+	{
+		if (mWriterRunning.load(std::memory_order_relaxed))
+			return;
+
+		mWriterShutdown = false;
+		mWriterThread = ThreadPool::instance().run("Log", std::bind(&Debug::runWriterThread, this));
+		mWriterRunning.store(true, std::memory_order_release);
+	}
+
+	void Debug::_stopWriterThread()
+	{
+		if (!mWriterRunning.load(std::memory_order_relaxed))
+			return;
+
+		mWriterRunning.store(false, std::memory_order_release);
+
+		{
+			Lock lock(mWriterMutex);
+			mWriterShutdown = true;
+		}
+
+		mWriterSignal.notify_one();
+		mWriterThread.blockUntilComplete();
+
+		// Anything logged while the thread was shutting down
+		writeEntries();
+	}
+
+	void Debug::runWriterThread()
+	{
+		while (true)
+		{
+			bool shutdown;
+			{
+				Lock lock(mWriterMutex);
+
+				// Woken up whenever a message is logged, the timeout only guards against a missed notification
+				mWriterSignal.wait_for(lock, std::chrono::milliseconds(WRITER_SLEEP_MS));
+				shutdown = mWriterShutdown;
+			}
+
+			writeEntries();
+
+			if (shutdown)
+				break;
+		}
 	}
 
 	void Debug::writeAsBMP(UINT8* rawPixels, UINT32 bytesPerPixel, UINT32 width, UINT32 height, const Path& filePath, 
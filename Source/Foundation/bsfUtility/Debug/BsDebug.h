@@ -4,6 +4,7 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Debug/BsLog.h"
+#include "Threading/BsThreadPool.h"
 
 namespace bs
 {
@@ -22,6 +23,10 @@ namespace bs
 	/**
 	 * Utility class providing various debug functionality.
 	 *
+	 * Logged messages are written out to the console and the log file (if any) by a dedicated writer thread, once it is
+	 * started. Errors are always written out immediately. Messages on disabled channels are dropped, as are identical
+	 * messages repeated more than the allowed number of times per second (see setMaxRepeats()).
+	 *
 	 * @note	Thread safe.
 	 */
 	class BS_UTILITY_EXPORT Debug
@@ -41,6 +46,30 @@ namespace bs
 		/** Adds a log entry in the specified channel. You may specify custom channels as needed. */
 		void log(const String& msg, UINT32 channel);
 
+		/**
+		 * Enables or disables logging to the specified channel. Messages logged to disabled channels are discarded.
+		 * Only channels with an index lower than 64 can be disabled.
+		 */
+		void setChannelEnabled(UINT32 channel, bool enabled);
+
+		/** Checks are messages logged to the specified channel recorded. */
+		bool isChannelEnabled(UINT32 channel) const;
+
+		/**
+		 * Determines how many times can the same message be logged per second. Any further repeats are discarded and
+		 * reported along with the next instance of the message. Set to zero to disable the limit.
+		 */
+		void setMaxRepeats(UINT32 count) { mMaxRepeats.store(count, std::memory_order_relaxed); }
+
+		/** @copydoc setMaxRepeats */
+		UINT32 getMaxRepeats() const { return mMaxRepeats.load(std::memory_order_relaxed); }
+
+		/**
+		 * Sets a file that all logged messages will be written to, as plain text. Any existing file at the path is
+		 * overwritten. Provide an empty path to stop writing to a file.
+		 */
+		void setLogFile(const Path& path);
+
 		/** Retrieves the Log used by the Debug instance. */
 		Log& getLog() { return mLog; }
 
@@ -81,20 +110,81 @@ namespace bs
 		 */
 		void _triggerCallbacks();
 
+		/**
+		 * Starts a thread that writes logged messages to the console and the log file. Until the thread is started
+		 * (and after it is stopped) messages are written out on the thread that logs them.
+		 */
+		void _startWriterThread();
+
+		/** Writes out any remaining messages and stops the thread started with _startWriterThread(). */
+		void _stopWriterThread();
+
 		/** @} */
 	private:
+		/** Limits the number of times a message can be repeated, across all threads. */
+		struct RepeatSlot
+		{
+			std::atomic<UINT64> hash{0};
+			std::atomic<UINT64> windowStart{0}; // Milliseconds
+			std::atomic<UINT32> count{0};
+			std::atomic<UINT32> numSuppressed{0};
+		};
+
+		/**
+		 * Checks if the message is allowed to be logged according to the repeat limit. If it is, @p numSuppressed
+		 * receives the number of its repeats that were discarded since it was last logged.
+		 */
+		bool checkRepeatLimit(const String& msg, UINT32& numSuppressed);
+
+		/** Writes all the log entries that weren't written yet to the console and the log file. */
+		void writeEntries();
+
+		/** Main loop of the writer thread. */
+		void runWriterThread();
+
+		static constexpr UINT32 NUM_REPEAT_SLOTS = 64;
+
 		UINT64 mLogHash = 0;
 		Log mLog;
+
+		std::atomic<UINT64> mDisabledChannels{0};
+		std::atomic<UINT32> mMaxRepeats{10};
+		RepeatSlot mRepeatSlots[NUM_REPEAT_SLOTS];
+
+		SPtr<DataStream> mLogFile;
+		Mutex mWriteMutex;
+
+		HThread mWriterThread;
+		std::atomic<bool> mWriterRunning{false};
+		bool mWriterShutdown = false;
+		Mutex mWriterMutex;
+		Signal mWriterSignal;
 	};
 
 	/** A simpler way of accessing the Debug module. */
 	BS_UTILITY_EXPORT Debug& gDebug();
 
+/**
+ * Minimum severity of the messages logged through the logging macros below. Macros for lower severities compile to
+ * nothing. 0 - all messages, 1 - warnings and errors, 2 - errors only.
+ */
+#ifndef BS_LOG_LEVEL
+#define BS_LOG_LEVEL 0
+#endif
+
+#if BS_LOG_LEVEL <= 0
 /** Shortcut for logging a message in the debug channel. */
 #define LOGDBG(x) bs::gDebug().logDebug((x) + String("\n\t\t in ") + __PRETTY_FUNCTION__ + " [" + __FILE__ + ":" + toString(__LINE__) + "]\n");
+#else
+#define LOGDBG(x) ((void)0)
+#endif
 
+#if BS_LOG_LEVEL <= 1
 /** Shortcut for logging a message in the warning channel. */
 #define LOGWRN(x) bs::gDebug().logWarning((x) + String("\n\t\t in ") + __PRETTY_FUNCTION__ + " [" + __FILE__ + ":" + toString(__LINE__) + "]\n");
+#else
+#define LOGWRN(x) ((void)0)
+#endif
 
 /** Shortcut for logging a message in the error channel. */
 #define LOGERR(x) bs::gDebug().logError((x) + String("\n\t\t in ") + __PRETTY_FUNCTION__ + " [" + __FILE__ + ":" + toString(__LINE__) + "]\n");
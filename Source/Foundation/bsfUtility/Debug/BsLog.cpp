@@ -5,6 +5,15 @@
 
 namespace bs
 {
+	LogEntry::LogEntry(String msg, UINT32 channel, std::time_t time)
+		:mMsg(std::move(msg)), mChannel(channel)
+	{
+		// Same format as Time::getCurrentTime()
+		char out[15];
+		std::strftime(out, sizeof(out), "%T", std::localtime(&time));
+		mLocalTime = out;
+	}
+
 	Log::~Log()
 	{
 		clear();
@@ -12,16 +21,51 @@ namespace bs
 
 	void Log::logMsg(const String& message, UINT32 channel)
 	{
-		RecursiveLock lock(mMutex);
+		PendingEntry* entry = bs_new<PendingEntry>();
+		entry->message = message;
+		entry->channel = channel;
+		entry->time = std::time(nullptr);
+		entry->next = mPending.load(std::memory_order_relaxed);
+
+		while(!mPending.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed))
+			;
+	}
+
+	void Log::processPending() const
+	{
+		// Readers always take the whole list at once, so unlike popping individual entries this isn't prone to ABA
+		PendingEntry* entry = mPending.exchange(nullptr, std::memory_order_acquire);
+
+		// The list is in reverse logging order
+		PendingEntry* reversed = nullptr;
+		while(entry)
+		{
+			PendingEntry* next = entry->next;
+			entry->next = reversed;
+			reversed = entry;
+			entry = next;
+		}
+
+		while(reversed)
+		{
+			PendingEntry* next = reversed->next;
 
-		mUnreadEntries.push(LogEntry(message, channel));
+			LogEntry logEntry(std::move(reversed->message), reversed->channel, reversed->time);
+			mUnwrittenEntries.push_back(logEntry);
+			mUnreadEntries.push(std::move(logEntry));
+
+			bs_delete(reversed);
+			reversed = next;
+		}
 	}
 
 	void Log::clear()
 	{
 		RecursiveLock lock(mMutex);
+		processPending();
 
 		mEntries.clear();
+		mUnwrittenEntries.clear();
 
 		while (!mUnreadEntries.empty())
 			mUnreadEntries.pop();
@@ -32,6 +76,7 @@ namespace bs
 	void Log::clear(UINT32 channel)
 	{
 		RecursiveLock lock(mMutex);
+		processPending();
 
 		Vector<LogEntry> newEntries;
 		for(auto& entry : mEntries)
@@ -63,6 +108,7 @@ namespace bs
 	bool Log::getUnreadEntry(LogEntry& entry)
 	{
 		RecursiveLock lock(mMutex);
+		processPending();
 
 		if (mUnreadEntries.empty())
 			return false;
@@ -96,6 +142,7 @@ namespace bs
 		Vector<LogEntry> entries;
 		{
 			RecursiveLock lock(mMutex);
+			processPending();
 
 			for (auto& entry : mEntries)
 				entries.push_back(entry);
@@ -109,4 +156,17 @@ namespace bs
 		}
 		return entries;
 	}
+
+	Vector<LogEntry> Log::getUnwrittenEntries()
+	{
+		Vector<LogEntry> entries;
+		{
+			RecursiveLock lock(mMutex);
+			processPending();
+
+			std::swap(entries, mUnwrittenEntries);
+		}
+
+		return entries;
+	}
 }
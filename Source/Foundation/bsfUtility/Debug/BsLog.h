@@ -4,6 +4,8 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsTime.h"
+#include <atomic>
+#include <ctime>
 
 namespace bs
 {
@@ -20,6 +22,9 @@ namespace bs
 			:mMsg(std::move(msg)), mChannel(channel), mLocalTime(gTime().getCurrentTime(false))
 		{ }
 
+		/** Creates an entry for a message that was logged at the specified time. */
+		LogEntry(String msg, UINT32 channel, std::time_t time);
+
 		/** Channel the message was recorded on. */
 		UINT32 getChannel() const { return mChannel; }
 
@@ -38,6 +43,9 @@ namespace bs
 	/**
 	 * Used for logging messages. Can categorize messages according to channels, save the log to a file
 	 * and send out callbacks when a new message is added.
+	 *
+	 * Logging a message never blocks. Messages are pushed onto a lock-free list, and are only turned into log entries
+	 * (including the formatting of their time) once the log is read from.
 	 * 			
 	 * @note	Thread safe.
 	 */
@@ -48,7 +56,7 @@ namespace bs
 		~Log();
 
 		/**
-		 * Logs a new message. 
+		 * Logs a new message. Lock-free.
 		 *
 		 * @param[in]	message	The message describing the log entry.
 		 * @param[in]	channel Channel in which to store the log entry.
@@ -89,11 +97,31 @@ namespace bs
 	private:
 		friend class Debug;
 
+		/** Message logged through logMsg() that wasn't yet moved to the unread entries. */
+		struct PendingEntry
+		{
+			String message;
+			UINT32 channel;
+			std::time_t time;
+			PendingEntry* next;
+		};
+
 		/** Returns all log entries, including those marked as unread. */
 		Vector<LogEntry> getAllEntries() const;
 
+		/** Returns all entries that weren't yet written out by Debug, and marks them as written. */
+		Vector<LogEntry> getUnwrittenEntries();
+
+		/**
+		 * Moves all the pending messages to the unread and unwritten entry lists, in the order they were logged in.
+		 * Caller must hold @p mMutex.
+		 */
+		void processPending() const;
+
 		Vector<LogEntry> mEntries;
-		Queue<LogEntry> mUnreadEntries;
+		mutable Queue<LogEntry> mUnreadEntries;
+		mutable Vector<LogEntry> mUnwrittenEntries;
+		mutable std::atomic<PendingEntry*> mPending{nullptr};
 		UINT64 mHash = 0;
 		mutable RecursiveMutex mMutex;
 	};
@@ -0,0 +1,55 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "FileSystem/BsAsyncFileIO.h"
+
+namespace bs
+{
+	AsyncOp AsyncFileIO::read(const SPtr<AsyncFile>& file, UINT64 offset, UINT64 size, void* buffer,
+		AsyncReadCallback callback)
+	{
+		Request* request = bs_new<Request>();
+		request->file = file;
+		request->offset = offset;
+		request->size = size;
+		request->buffer = (UINT8*)buffer;
+		request->callback = std::move(callback);
+		request->op = AsyncOp(mSyncData);
+
+		AsyncOp op = request->op;
+		mNumPending.fetch_add(1, std::memory_order_relaxed);
+
+		if (file == nullptr || size == 0)
+			_completeRequest(request, file != nullptr);
+		else
+			submit(request);
+
+		return op;
+	}
+
+	void AsyncFileIO::_completeRequest(Request* request, bool success)
+	{
+		AsyncReadResult result;
+		result.success = success;
+		result.numBytes = request->numRead;
+
+		if (request->callback)
+			request->callback(result);
+
+		{
+			// Completing under the lock ensures the notification can't be missed by a thread about to start waiting
+			Lock lock(mSyncData->mMutex);
+			request->op._completeOperation(result);
+			mNumPending.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		mSyncData->mCondition.notify_all();
+		bs_delete(request);
+	}
+
+	void AsyncFileIO::waitUntilIdle()
+	{
+		Lock lock(mSyncData->mMutex);
+		while (mNumPending.load(std::memory_order_relaxed) > 0)
+			mSyncData->mCondition.wait(lock);
+	}
+}
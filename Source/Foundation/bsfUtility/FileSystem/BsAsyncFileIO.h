@@ -0,0 +1,142 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsModule.h"
+#include "Threading/BsAsyncOp.h"
+
+namespace bs
+{
+	/** @addtogroup Filesystem
+	 *  @{
+	 */
+
+	/** File opened for asynchronous reading. Reads from the file are queued through AsyncFileIO. */
+	class BS_UTILITY_EXPORT AsyncFile final
+	{
+	public:
+		struct Pimpl;
+
+		~AsyncFile();
+
+		/** Returns the size of the file, in bytes. */
+		UINT64 getSize() const { return mSize; }
+
+		/** Returns the path the file was opened from. */
+		const Path& getPath() const { return mPath; }
+
+		/** Opens a file for asynchronous reading. Returns null if the file cannot be opened. */
+		static SPtr<AsyncFile> open(const Path& path);
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Returns the platform specific file handle. */
+		Pimpl* _getInternal() const { return m; }
+
+		/** @} */
+	private:
+		AsyncFile();
+
+		Pimpl* m;
+		Path mPath;
+		UINT64 mSize = 0;
+	};
+
+	/** Outcome of an asynchronous read. */
+	struct AsyncReadResult
+	{
+		/** True if the read succeeded. */
+		bool success = false;
+
+		/** Number of bytes read. Only smaller than the requested size if the end of the file was reached. */
+		UINT64 numBytes = 0;
+	};
+
+	/**
+	 * Callback triggered when an asynchronous read completes. Called from the I/O completion thread, and should
+	 * therefore only do minimal work (e.g. queue a task that processes the read data). If the read couldn't be
+	 * submitted to the native mechanism (e.g. the file failed to open, or the mechanism rejected the read) the read
+	 * finishes on the thread that queued it instead, and the callback is called before AsyncFileIO::read() returns.
+	 */
+	typedef std::function<void(const AsyncReadResult&)> AsyncReadCallback;
+
+	/**
+	 * Reads files asynchronously, allowing many reads to be in flight without blocking a thread per read. Uses io_uring
+	 * on Linux and I/O completion ports on Windows. On other platforms, or if the native mechanism isn't available, the
+	 * reads are performed by a small number of dedicated threads.
+	 *
+	 * Any reads still in flight are completed before the module shuts down.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT AsyncFileIO : public Module<AsyncFileIO>
+	{
+	public:
+		/** A single queued read. */
+		struct Request
+		{
+			SPtr<AsyncFile> file;
+			UINT64 offset;
+			UINT64 size;
+			UINT8* buffer;
+			UINT64 numRead = 0;
+			AsyncReadCallback callback;
+			AsyncOp op;
+		};
+
+		struct Pimpl;
+
+		AsyncFileIO();
+		~AsyncFileIO();
+
+		/**
+		 * Queues a read from a file.
+		 *
+		 * @param[in]	file		File to read from.
+		 * @param[in]	offset		Offset into the file to start reading at, in bytes.
+		 * @param[in]	size		Number of bytes to read.
+		 * @param[in]	buffer		Buffer to read the data into. Must be at least @p size bytes large, and must remain
+		 *							valid until the read completes.
+		 * @param[in]	callback	Optional callback to trigger when the read completes.
+		 * @return					Operation that completes after the callback was triggered. Its return value is an
+		 *							AsyncReadResult.
+		 */
+		AsyncOp read(const SPtr<AsyncFile>& file, UINT64 offset, UINT64 size, void* buffer,
+			AsyncReadCallback callback = nullptr);
+
+		/** Returns the number of reads that were queued, but haven't completed yet. */
+		UINT32 getNumPending() const { return mNumPending.load(std::memory_order_relaxed); }
+
+		/** Returns the name of the mechanism used for performing the reads. */
+		const char* getBackendName() const;
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/**
+		 * Finishes a request, triggering its callback and completing its operation. Called by the platform specific
+		 * implementation once all the data of the request was read, or the read failed.
+		 */
+		void _completeRequest(Request* request, bool success);
+
+		/** @} */
+	private:
+		/** Starts the platform specific read of a request. */
+		void submit(Request* request);
+
+		/** Blocks until all queued reads complete. */
+		void waitUntilIdle();
+
+		Pimpl* m;
+		std::atomic<UINT32> mNumPending{0};
+
+		// Shared by all read operations, and used for waiting on pending reads during shut down
+		SPtr<AsyncOpSyncData> mSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
+	};
+
+	/** @} */
+}
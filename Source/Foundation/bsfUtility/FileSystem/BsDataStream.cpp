@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsFileSystem.h"
 #include "Debug/BsDebug.h"
 #include "String/BsUnicode.h"
 
@@ -180,7 +181,7 @@ namespace bs
 	MemoryDataStream::MemoryDataStream(size_t size)
 		: DataStream(READ | WRITE), mData(nullptr), mFreeOnClose(true)
 	{
-		mData = mPos = (UINT8*)bs_alloc((UINT32)size);
+		mData = mPos = (UINT8*)bs_alloc(size);
 		mSize = size;
 		mEnd = mData + mSize;
 
@@ -203,7 +204,7 @@ namespace bs
 		// Copy data from incoming stream
 		mSize = sourceStream.size();
 
-		mData = (UINT8*)bs_alloc((UINT32)mSize);
+		mData = (UINT8*)bs_alloc(mSize);
 		mPos = mData;
 		mEnd = mData + sourceStream.read(mData, mSize);
 		mFreeOnClose = true;
@@ -217,7 +218,7 @@ namespace bs
 		// Copy data from incoming stream
 		mSize = sourceStream->size();
 
-		mData = (UINT8*)bs_alloc((UINT32)mSize);
+		mData = (UINT8*)bs_alloc(mSize);
 		mPos = mData;
 		mEnd = mData + sourceStream->read(mData, mSize);
 		mFreeOnClose = true;
@@ -418,4 +419,40 @@ namespace bs
 			}
 		}
 	}
+
+	MappedFileDataStream::MappedFileDataStream(const SPtr<MemoryMappedFile>& file)
+		: MappedFileDataStream(file, 0, (size_t)file->getSize())
+	{ }
+
+	MappedFileDataStream::MappedFileDataStream(const SPtr<MemoryMappedFile>& file, size_t offset, size_t size)
+		: MemoryDataStream(const_cast<UINT8*>(file->getData()) + offset, size, false), mFile(file)
+	{
+		assert(offset + size <= file->getSize());
+		mAccess = READ;
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	SPtr<MappedFileDataStream> MappedFileDataStream::createView(size_t size) const
+	{
+		assert(mPos + size <= mEnd);
+
+		const size_t offset = (size_t)(mPos - mFile->getData());
+		return bs_shared_ptr_new<MappedFileDataStream>(mFile, offset, size);
+	}
+
+	SPtr<DataStream> MappedFileDataStream::clone(bool copyData) const
+	{
+		const size_t offset = (size_t)(mData - mFile->getData());
+		return bs_shared_ptr_new<MappedFileDataStream>(mFile, offset, mSize);
+	}
+
+	void MappedFileDataStream::close()
+	{
+		MemoryDataStream::close();
+		mFile = nullptr;
+	}
 }
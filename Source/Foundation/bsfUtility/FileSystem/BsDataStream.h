@@ -50,6 +50,12 @@ namespace bs
 		virtual bool isWriteable() const { return (mAccess & WRITE) != 0; }
 		virtual bool isFile() const = 0;
 
+		/** 
+		 * Checks is the stream data backed by a memory mapped file. Such streams are read-only and their data can be
+		 * referenced through MappedFileDataStream::createView() without copying it.
+		 */
+		virtual bool isMapped() const { return false; }
+
 		/** Reads data from the buffer and copies it to the specified value. */
 		template<typename T> DataStream& operator>>(T& val);
 
@@ -282,6 +288,56 @@ namespace bs
 		bool mFreeOnClose;	
 	};
 
+	/** 
+	 * Read-only data stream providing access to a range of a memory mapped file. Data is paged in by the OS on first 
+	 * access. Streams referencing the same mapping keep it alive until all of them are closed.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Wraps the entire contents of a memory mapped file in a stream.
+		 *
+		 * @param[in]	file		File to read the data from.
+		 */
+		MappedFileDataStream(const SPtr<MemoryMappedFile>& file);
+
+		/**
+		 * Wraps a range of a memory mapped file in a stream.
+		 *
+		 * @param[in]	file		File to read the data from.
+		 * @param[in]	offset		Offset from the start of the file at which the stream starts, in bytes.
+		 * @param[in]	size		Size of the stream, in bytes. Must not extend past the end of the file.
+		 */
+		MappedFileDataStream(const SPtr<MemoryMappedFile>& file, size_t offset, size_t size);
+
+		~MappedFileDataStream();
+
+		bool isMapped() const override { return true; }
+
+		/** 
+		 * Creates a new stream referencing @p size bytes of this stream's data, starting at the current read position.
+		 * The data is not copied and the new stream keeps the mapping alive on its own. Does not advance the read pointer.
+		 */
+		SPtr<MappedFileDataStream> createView(size_t size) const;
+
+		/** Returns the memory mapped file the stream is reading from. */
+		const SPtr<MemoryMappedFile>& getFile() const { return mFile; }
+
+		/** 
+		 * @copydoc DataStream::clone 
+		 *
+		 * @note	Mapped data is read-only so the clone always references the same mapping, regardless of @p copyData.
+		 */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+	protected:
+		SPtr<MemoryMappedFile> mFile;
+	};
+
 	/** @} */
 }
 
@@ -107,5 +107,165 @@ namespace bs
 		FileSystem::moveFile(oldPath, newPath);
 	}
 
-	Mutex FileScheduler::mMutex;
+	/** Access state of a single storage device, as tracked by the FileScheduler. */
+	struct FileLock::Device
+	{
+		Device(UINT32 queueDepth)
+			:queueDepth(queueDepth)
+		{ }
+
+		/** Waits until the device has a free slot, and occupies it. */
+		void acquire()
+		{
+			ProfiledLock lock(mutex);
+			signal.wait(lock, [this]() { return numActive < queueDepth; });
+
+			numActive++;
+		}
+
+		/** Frees a slot occupied by acquire(). */
+		void release()
+		{
+			{
+				ProfiledLock lock(mutex);
+				numActive--;
+			}
+
+			signal.notify_one();
+		}
+
+		ProfiledMutex mutex { "FileScheduler" };
+		ProfiledSignal signal;
+		UINT32 queueDepth;
+		UINT32 numActive = 0;
+	};
+
+	/** Devices known to the FileScheduler. */
+	struct FileSchedulerDevices
+	{
+		Mutex mutex;
+		UnorderedMap<UINT64, FileLock::Device*> devices;
+	};
+
+	/**
+	 * Returns the devices known to the FileScheduler. Never destroyed, since files can be accessed from static
+	 * destructors, and locks might be held by threads that outlive the application.
+	 */
+	static FileSchedulerDevices& getFileSchedulerDevices()
+	{
+		static FileSchedulerDevices* devices = new (bs_alloc<FileSchedulerDevices>()) FileSchedulerDevices();
+		return *devices;
+	}
+
+	FileLock::FileLock(FileLock&& other) noexcept
+		:mDevice(other.mDevice)
+	{
+		other.mDevice = nullptr;
+	}
+
+	FileLock::~FileLock()
+	{
+		unlock();
+	}
+
+	FileLock& FileLock::operator=(FileLock&& other) noexcept
+	{
+		if (this != &other)
+		{
+			unlock();
+
+			mDevice = other.mDevice;
+			other.mDevice = nullptr;
+		}
+
+		return *this;
+	}
+
+	void FileLock::unlock()
+	{
+		if (mDevice != nullptr)
+		{
+			mDevice->release();
+			mDevice = nullptr;
+		}
+	}
+
+	void FileScheduler::lock(const Path& path)
+	{
+		getDevice(path)->acquire();
+	}
+
+	void FileScheduler::unlock(const Path& path)
+	{
+		getDevice(path)->release();
+	}
+
+	FileLock FileScheduler::getLock(const Path& path)
+	{
+		FileLock::Device* device = getDevice(path);
+		device->acquire();
+
+		return FileLock(device);
+	}
+
+	void FileScheduler::setQueueDepth(const Path& path, UINT32 queueDepth)
+	{
+		FileLock::Device* device = getDevice(path);
+
+		{
+			ProfiledLock lock(device->mutex);
+			device->queueDepth = std::max(queueDepth, 1U);
+		}
+
+		// Larger queue depth might allow waiting threads to proceed
+		device->signal.notify_all();
+	}
+
+	UINT32 FileScheduler::getQueueDepth(const Path& path)
+	{
+		FileLock::Device* device = getDevice(path);
+
+		ProfiledLock lock(device->mutex);
+		return device->queueDepth;
+	}
+
+	FileLock::Device* FileScheduler::getDevice(const Path& path)
+	{
+		const UINT64 deviceId = getDeviceId(path);
+		FileSchedulerDevices& devices = getFileSchedulerDevices();
+
+		{
+			Lock lock(devices.mutex);
+
+			auto iterFind = devices.devices.find(deviceId);
+			if (iterFind != devices.devices.end())
+				return iterFind->second;
+		}
+
+		// Determining the device type might be slow, so do it outside of the lock. Only done once per device.
+		const bool isRotational = isRotationalDevice(path, deviceId);
+		const UINT32 queueDepth = isRotational ? DEFAULT_ROTATIONAL_QUEUE_DEPTH : DEFAULT_SOLID_STATE_QUEUE_DEPTH;
+
+		Lock lock(devices.mutex);
+		FileLock::Device*& device = devices.devices[deviceId];
+		if (device == nullptr)
+			device = bs_new<FileLock::Device>(queueDepth);
+
+		return device;
+	}
+
+	void MemoryMappedFile::prefetch(UINT64 offset, UINT64 size) const
+	{
+		static constexpr UINT64 PAGE_SIZE = 4096;
+
+		const UINT64 end = std::min(offset + size, mSize);
+		if(offset >= end)
+			return;
+
+		volatile UINT8 sink = 0;
+		for(UINT64 i = offset; i < end; i += PAGE_SIZE)
+			sink += mData[i];
+
+		sink += mData[end - 1];
+	}
 }
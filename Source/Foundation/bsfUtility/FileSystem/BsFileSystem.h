@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Threading/BsProfiledMutex.h"
 
 namespace bs
 {
@@ -141,44 +142,140 @@ namespace bs
 	};
 
 	/** 
-	 * Locks access to files on the same drive, allowing only one file to be read at a time, per drive. This prevents
-	 * multiple threads accessing multiple files on the same drive at once, ruining performance on mechanical drives.
+	 * Provides read-only access to contents of a file by mapping it into the process address space. File contents are
+	 * paged in by the OS on first access instead of being read up front.
+	 */
+	class BS_UTILITY_EXPORT MemoryMappedFile final : public INonCopyable
+	{
+		struct Pimpl;
+	public:
+		~MemoryMappedFile();
+
+		/** Returns a pointer to the start of the file contents. */
+		const UINT8* getData() const { return mData; }
+
+		/** Returns the size of the file, in bytes. */
+		UINT64 getSize() const { return mSize; }
+
+		/** 
+		 * Touches every page in the specified range, blocking until the OS has read them into memory. Useful for moving
+		 * the cost of reading the file to a thread of the caller's choosing, instead of paying it on first access.
+		 */
+		void prefetch(UINT64 offset, UINT64 size) const;
+
+		/** 
+		 * Maps the file at the specified path into memory. Returns null if the file doesn't exist or cannot be mapped.
+		 * The file must not be modified while it is mapped.
+		 */
+		static SPtr<MemoryMappedFile> open(const Path& fullPath);
+
+	private:
+		MemoryMappedFile();
+
+		Pimpl* m;
+		const UINT8* mData = nullptr;
+		UINT64 mSize = 0;
+	};
+
+	class FileScheduler;
+
+	/**
+	 * Grants access to a storage device, as scheduled by the FileScheduler. Access is released when the lock goes out
+	 * of scope, or when unlock() is called.
+	 */
+	class BS_UTILITY_EXPORT FileLock final
+	{
+	public:
+		struct Device;
+
+		FileLock() = default;
+		FileLock(FileLock&& other) noexcept;
+		~FileLock();
+
+		FileLock(const FileLock&) = delete;
+		FileLock& operator=(const FileLock&) = delete;
+
+		FileLock& operator=(FileLock&& other) noexcept;
+
+		/** Releases access to the device, if the lock has any. */
+		void unlock();
+
+		/** Checks does the lock currently have access to a device. */
+		bool owns_lock() const { return mDevice != nullptr; }
+
+	private:
+		friend class FileScheduler;
+
+		explicit FileLock(Device* device)
+			:mDevice(device)
+		{ }
+
+		Device* mDevice = nullptr;
+	};
+
+	/**
+	 * Schedules access to files on a per-device basis. Each storage device allows a limited number of files to be
+	 * accessed at once (its queue depth), while files on different devices can always be accessed in parallel. Devices
+	 * with a seek penalty (mechanical drives) default to a queue depth of one, so multiple threads don't thrash the
+	 * drive by reading different files at the same time. Solid state drives default to a larger queue depth, as they
+	 * only reach their full throughput with multiple requests in flight.
+	 *
+	 * Access should only be held while the file is actually being read or written, and not while its contents are
+	 * being processed.
+	 *
+	 * @note	Thread safe.
 	 */
 	class BS_UTILITY_EXPORT FileScheduler final
 	{
 	public:
+		/** Default queue depth for devices that have a seek penalty, or whose type couldn't be determined. */
+		static constexpr UINT32 DEFAULT_ROTATIONAL_QUEUE_DEPTH = 1;
+
+		/** Default queue depth for solid state devices. */
+		static constexpr UINT32 DEFAULT_SOLID_STATE_QUEUE_DEPTH = 8;
+
 		/** 
-		 * Locks access and doesn't allow other threads to get past this point until access is unlocked. Any scheduled
-		 * file access should happen past this point.
+		 * Waits until the device the file is located on has a free slot, and occupies it. Any scheduled file access
+		 * should happen past this point.
 		 */
-		static void lock(const Path& path)
-		{
-			// Note: File path should be analyzed and determined on which drive does the path belong to. Locks can then
-			// be issued on a per-drive basis, instead of having one global lock. This would allow multiple files to be
-			// accessed at the same time, as long as they're on different drives.
-			mMutex.lock();
-		}
+		static void lock(const Path& path);
 
 		/** 
-		 * Unlocks access and allows another thread to lock file access. Must be provided with the same file path as
-		 * lock().
+		 * Frees a slot previously occupied by lock(), allowing another thread access to the device. Must be provided
+		 * with the same file path as lock().
 		 */
-		static void unlock(const Path& path)
-		{
-			mMutex.unlock();
-		}
+		static void unlock(const Path& path);
 
 		/**
 		 * Returns a lock object that immediately locks access (same as lock()), and then calls unlock() when it goes
 		 * out of scope.
 		 */
-		static Lock getLock(const Path& path)
-		{
-			return Lock(mMutex);
-		}
+		static FileLock getLock(const Path& path);
+
+		/**
+		 * Changes the number of files that can be accessed at once, on the device the provided path is located on.
+		 * Overrides the default queue depth determined from the device type.
+		 */
+		static void setQueueDepth(const Path& path, UINT32 queueDepth);
+
+		/** Returns the number of files that can be accessed at once, on the device the provided path is located on. */
+		static UINT32 getQueueDepth(const Path& path);
 
 	private:
-		static Mutex mMutex;
+		/** Finds the device the provided path is located on, registering the device if it isn't known yet. */
+		static FileLock::Device* getDevice(const Path& path);
+
+		/**
+		 * Returns an identifier unique to the device the file is located on. The file doesn't need to exist. Platform
+		 * specific.
+		 */
+		static UINT64 getDeviceId(const Path& path);
+
+		/**
+		 * Checks does the device with the provided identifier have a seek penalty. @p path is any path located on the
+		 * device. Returns true if the device type cannot be determined. Platform specific.
+		 */
+		static bool isRotationalDevice(const Path& path, UINT64 deviceId);
 	};
 
 	/** @} */
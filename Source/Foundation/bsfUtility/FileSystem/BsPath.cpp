@@ -16,7 +16,7 @@ namespace bs
 
 	Path::Path(const char* pathStr, PathType type)
 	{
-		assign(pathStr);
+		assign(pathStr, type);
 	}
 
 	Path::Path(const Path& other)
@@ -24,12 +24,28 @@ namespace bs
 		assign(other);
 	}
 
+	Path::Path(Path&& other) noexcept
+		: mDirectories(std::move(other.mDirectories)), mDevice(std::move(other.mDevice))
+		, mFilename(std::move(other.mFilename)), mNode(std::move(other.mNode)), mIsAbsolute(other.mIsAbsolute)
+	{ }
+
 	Path& Path::operator= (const Path& path)
 	{
 		assign(path);
 		return *this;
 	}
 
+	Path& Path::operator= (Path&& path) noexcept
+	{
+		mDirectories = std::move(path.mDirectories);
+		mDevice = std::move(path.mDevice);
+		mFilename = std::move(path.mFilename);
+		mNode = std::move(path.mNode);
+		mIsAbsolute = path.mIsAbsolute;
+
+		return *this;
+	}
+
 	Path& Path::operator= (const String& pathStr)
 	{
 		assign(pathStr);
@@ -100,18 +116,28 @@ namespace bs
 #endif
 
 	String Path::toString(PathType type) const
+	{
+		String output;
+		toString(output, type);
+
+		return output;
+	}
+
+	void Path::toString(String& output, PathType type) const
 	{
 		switch (type)
 		{
 		case PathType::Windows:
-			return buildWindows();
+			buildWindows(output);
+			break;
 		case PathType::Unix:
-			return buildUnix();
+			buildUnix(output);
+			break;
 		default:
 #if BS_PLATFORM == BS_PLATFORM_WIN32
-			return buildWindows();
+			buildWindows(output);
 #elif BS_PLATFORM == BS_PLATFORM_OSX || BS_PLATFORM == BS_PLATFORM_LINUX
-			return buildUnix();
+			buildUnix(output);
 #else
 			static_assert(false, "Unsupported platform for path.");
 #endif
@@ -346,11 +372,11 @@ namespace bs
 
 	void Path::setExtension(const String& extension)
 	{
-		StringStream stream;
-		stream << getFilename(false);
-		stream << extension;
+		String::size_type pos = mFilename.rfind('.');
+		if (pos != String::npos)
+			mFilename.erase(pos);
 
-		mFilename = stream.str();
+		mFilename += extension;
 	}
 
 	String Path::getFilename(bool extension) const
@@ -411,65 +437,87 @@ namespace bs
 		BS_EXCEPT(InvalidParametersException, "Incorrectly formatted path provided: " + path);
 	}
 
-	String Path::buildWindows() const
+	void Path::buildWindows(String& output) const
 	{
-		StringStream result;
+		// Calculate the length up front so the output is allocated at most once
+		size_t length = mFilename.length();
+		if (!mNode.empty())
+			length += mNode.length() + 3;
+		else if (!mDevice.empty())
+			length += mDevice.length() + 2;
+		else if (mIsAbsolute)
+			length += 1;
+
+		for (auto& dir : mDirectories)
+			length += dir.length() + 1;
+
+		output.clear();
+		output.reserve(length);
+
 		if (!mNode.empty())
 		{
-			result << "\\\\";
-			result << mNode;
-			result << "\\";
+			output += "\\\\";
+			output += mNode;
+			output += "\\";
 		}
 		else if (!mDevice.empty())
 		{
-			result << mDevice;
-			result << ":\\";
+			output += mDevice;
+			output += ":\\";
 		}
 		else if (mIsAbsolute)
 		{
-			result << "\\";
+			output += "\\";
 		}
 
 		for (auto& dir : mDirectories)
 		{
-			result << dir;
-			result << "\\";
+			output += dir;
+			output += "\\";
 		}
 
-		result << mFilename;
-		return result.str();
+		output += mFilename;
 	}
 
-	String Path::buildUnix() const
+	void Path::buildUnix(String& output) const
 	{
-		StringStream result;
 		auto dirIter = mDirectories.begin();
 
+		// Calculate the length up front so the output is allocated at most once
+		size_t length = mFilename.length() + 1;
+		if (!mDevice.empty())
+			length += mDevice.length() + 3;
+
+		for (auto& dir : mDirectories)
+			length += dir.length() + 1;
+
+		output.clear();
+		output.reserve(length);
+
 		if (!mDevice.empty())
 		{
-			result << "/";
-			result << mDevice;
-			result << ":/";
+			output += "/";
+			output += mDevice;
+			output += ":/";
 		}
 		else if (mIsAbsolute)
 		{
 			if (dirIter != mDirectories.end() && *dirIter == "~")
 			{
-				result << "~";
+				output += "~";
 				dirIter++;
 			}
 
-			result << "/";
+			output += "/";
 		}
 
 		for (; dirIter != mDirectories.end(); ++dirIter)
 		{
-			result << *dirIter;
-			result << "/";
+			output += *dirIter;
+			output += "/";
 		}
 
-		result << mFilename;
-		return result.str();
+		output += mFilename;
 	}
 
 	Path Path::operator+ (const Path& rhs) const
@@ -482,13 +530,93 @@ namespace bs
 		return append(rhs);
 	}
 
+	/** Converts an ASCII character to lower case. */
+	static char toLowerASCII(char ch)
+	{
+		return (ch >= 'A' && ch <= 'Z') ? (char)(ch - 'A' + 'a') : ch;
+	}
+
+	/** Calculates a case insensitive hash of a string, ignoring case only for ASCII characters. */
+	static size_t hashLowerASCII(const String& str)
+	{
+		// FNV-1a
+		UINT32 hash = 2166136261u;
+		for (char ch : str)
+		{
+			hash ^= (UINT8)toLowerASCII(ch);
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+	/** Checks does the string contain any characters outside of the ASCII range. */
+	static bool hasNonASCII(const char* str, size_t length)
+	{
+		for (size_t i = 0; i < length; i++)
+		{
+			if ((UINT8)str[i] & 0x80)
+				return true;
+		}
+
+		return false;
+	}
+
 	bool Path::comparePathElem(const String& left, const String& right)
 	{
-		// Note: Might be more efficient to perform toLower character by character, and return as soon as comparison
-		// fails. Instead of this way where we're allocating two temporary strings with dynamic memory. Although that
-		// approach is problematic as well because UTF8 case conversion requires external library calls which might not
-		// support single character conversion, so it might end up being less efficient.
-		return UTF8::toLower(left) == UTF8::toLower(right);
+		// Compare ASCII characters directly. Only fall back to full UTF8 case conversion (which requires allocating
+		// temporary strings) if the strings contain other characters.
+		const size_t length = std::min(left.length(), right.length());
+		for (size_t i = 0; i < length; i++)
+		{
+			const char leftChar = left[i];
+			const char rightChar = right[i];
+
+			if (((UINT8)leftChar | (UINT8)rightChar) & 0x80)
+				return UTF8::toLower(left) == UTF8::toLower(right);
+
+			if (toLowerASCII(leftChar) != toLowerASCII(rightChar))
+				return false;
+		}
+
+		if (left.length() == right.length())
+			return true;
+
+		// Lower case version of non-ASCII characters might have a different length
+		const String& longer = left.length() > right.length() ? left : right;
+		if (hasNonASCII(longer.data() + length, longer.length() - length))
+			return UTF8::toLower(left) == UTF8::toLower(right);
+
+		return false;
+	}
+
+	size_t Path::hashPathElem(const String& elem)
+	{
+		if (hasNonASCII(elem.data(), elem.length()))
+			return hashLowerASCII(UTF8::toLower(elem));
+
+		return hashLowerASCII(elem);
+	}
+
+	size_t Path::getHash() const
+	{
+		// Must match the rules in equals(). Device is only compared for absolute paths, and filename is compared as if
+		// it was the last directory.
+		size_t hash = 0;
+		bs::hash_combine(hash, mIsAbsolute);
+
+		if (mIsAbsolute)
+			bs::hash_combine(hash, hashPathElem(mDevice));
+
+		bs::hash_combine(hash, hashPathElem(mNode));
+
+		for (auto& dir : mDirectories)
+			bs::hash_combine(hash, hashPathElem(dir));
+
+		if (!mFilename.empty())
+			bs::hash_combine(hash, hashPathElem(mFilename));
+
+		return hash;
 	}
 
 	Path Path::combine(const Path& left, const Path& right)
@@ -508,19 +636,20 @@ namespace bs
 		}
 	}
 
-	void Path::pushDirectory(const String& dir)
+	void Path::pushDirectory(const char* dir, UINT32 length)
 	{
-		if (!dir.empty() && dir != ".")
+		if (length == 0 || (length == 1 && dir[0] == '.'))
+			return;
+
+		if (length == 2 && dir[0] == '.' && dir[1] == '.')
 		{
-			if (dir == "..")
+			if (!mDirectories.empty() && mDirectories.back() != "..")
 			{
-				if (!mDirectories.empty() && mDirectories.back() != "..")
-					mDirectories.pop_back();
-				else
-					mDirectories.push_back(dir);
+				mDirectories.pop_back();
+				return;
 			}
-			else
-				mDirectories.push_back(dir);
 		}
+
+		mDirectories.emplace_back(dir, length);
 	}
 }
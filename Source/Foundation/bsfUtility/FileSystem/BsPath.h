@@ -55,6 +55,7 @@ namespace bs
 		 */
 		Path(const char* pathStr, PathType type = PathType::Default);
 		Path(const Path& other);
+		Path(Path&& other) noexcept;
 
 		/**
 		 * Assigns a path by parsing the provided path string. Path will be parsed according to the rules of the platform
@@ -69,6 +70,7 @@ namespace bs
 		Path& operator= (const char* pathStr);
 
 		Path& operator= (const Path& path);
+		Path& operator= (Path&& path) noexcept;
 
 		/**
 		 * Compares two paths and returns true if they match. Comparison is case insensitive and paths will be compared
@@ -120,6 +122,18 @@ namespace bs
 		 */
 		String toString(PathType type = PathType::Default) const;
 
+		/**
+		 * Converts the path in a string according to platform path rules, and writes it to the provided string. Re-uses
+		 * the memory of the output string, allowing the same string to be used for converting many paths without
+		 * allocating memory.
+		 *
+		 * @param[out]	output	String to write the path to, using the UTF8 string encoding. Existing contents are
+		 *						replaced.
+		 * @param[in]	type	If set to default path will be parsed according to the rules of the platform the
+		 *						application is being compiled to. Otherwise it will be parsed according to provided type.
+		 */
+		void toString(String& output, PathType type = PathType::Default) const;
+
 		/**
 		 * Converts the path to either a string or a wstring, doing The Right Thing for the current platform.
 		 *
@@ -257,9 +271,21 @@ namespace bs
 		/** Concatenates two paths. */
 		Path& operator+= (const Path& rhs);
 
-		/** Compares two path elements (filenames, directory names, etc.). */
+		/**
+		 * Returns a hash of the path, consistent with the equals() comparison. Paths that are equal always have the
+		 * same hash, making the hash usable as a key for looking up paths (e.g. in hash maps).
+		 */
+		size_t getHash() const;
+
+		/**
+		 * Compares two path elements (filenames, directory names, etc.). Comparison is case insensitive. Doesn't
+		 * allocate memory unless the elements contain non-ASCII characters.
+		 */
 		static bool comparePathElem(const String& left, const String& right);
 
+		/** Returns a hash of a path element, consistent with the comparePathElem() comparison. */
+		static size_t hashPathElem(const String& elem);
+
 		/** Combines two paths and returns the result. Right path should be relative. */
 		static Path combine(const Path& left, const Path& right);
 
@@ -286,8 +312,6 @@ namespace bs
 			clear();
 
 			UINT32 idx = 0;
-			BasicStringStream<T> tempStream;
-
 			if (idx < numChars)
 			{
 				if (pathStr[idx] == '\\' || pathStr[idx] == '/')
@@ -304,12 +328,11 @@ namespace bs
 				{
 					idx++;
 
-					tempStream.str(BasicString<T>());
-					tempStream.clear();
+					const UINT32 start = idx;
 					while (idx < numChars && pathStr[idx] != '\\' && pathStr[idx] != '/')
-						tempStream << pathStr[idx++];
+						idx++;
 
-					setNode(tempStream.str());
+					mNode.assign(pathStr + start, idx - start);
 
 					if (idx < numChars)
 						idx++;
@@ -325,7 +348,7 @@ namespace bs
 							throwInvalidPathException(BasicString<T>(pathStr, numChars));
 
 						mIsAbsolute = true;
-						setDevice(String(1, drive));
+						mDevice.assign(1, drive);
 
 						idx++;
 
@@ -340,18 +363,14 @@ namespace bs
 
 				while (idx < numChars)
 				{
-					tempStream.str(BasicString<T>());
-					tempStream.clear();
+					const UINT32 start = idx;
 					while (idx < numChars && pathStr[idx] != '\\' && pathStr[idx] != '/')
-					{
-						tempStream << pathStr[idx];
 						idx++;
-					}
 
 					if (idx < numChars)
-						pushDirectory(tempStream.str());
+						pushDirectory(pathStr + start, idx - start);
 					else
-						setFilename(tempStream.str());
+						mFilename.assign(pathStr + start, idx - start);
 
 					idx++;
 				}
@@ -365,8 +384,6 @@ namespace bs
 			clear();
 
 			UINT32 idx = 0;
-			BasicStringStream<T> tempStream;
-
 			if (idx < numChars)
 			{
 				if (pathStr[idx] == '/')
@@ -379,7 +396,7 @@ namespace bs
 					idx++;
 					if (idx >= numChars || pathStr[idx] == '/')
 					{
-						pushDirectory(String("~"));
+						pushDirectory("~", 1);
 						mIsAbsolute = true;
 					}
 					else
@@ -388,37 +405,24 @@ namespace bs
 
 				while (idx < numChars)
 				{
-					tempStream.str(BasicString<T>());
-					tempStream.clear();
+					const UINT32 start = idx;
 					while (idx < numChars && pathStr[idx] != '/')
-					{
-						tempStream << pathStr[idx];
 						idx++;
-					}
 
+					const UINT32 length = idx - start;
 					if (idx < numChars)
 					{
-						if (mDirectories.empty())
+						if (mDirectories.empty() && length > 0 && pathStr[idx - 1] == ':')
 						{
-							BasicString<T> deviceStr = tempStream.str();
-							if (!deviceStr.empty() && *(deviceStr.rbegin()) == ':')
-							{
-								setDevice(deviceStr.substr(0, deviceStr.length() - 1));
-								mIsAbsolute = true;
-							}
-							else
-							{
-								pushDirectory(deviceStr);
-							}
+							mDevice.assign(pathStr + start, length - 1);
+							mIsAbsolute = true;
 						}
 						else
-						{
-							pushDirectory(tempStream.str());
-						}
+							pushDirectory(pathStr + start, length);
 					}
 					else
 					{
-						setFilename(tempStream.str());
+						mFilename.assign(pathStr + start, length);
 					}
 
 					idx++;
@@ -430,19 +434,21 @@ namespace bs
 		void setDevice(const String& device) { mDevice = device; }
 
 		/** Build a Windows path string from internal path data. */
-		String buildWindows() const;
+		void buildWindows(String& output) const;
 
 		/** Build a Unix path string from internal path data. */
-		String buildUnix() const;
+		void buildUnix(String& output) const;
 
 		/** Add new directory to the end of the path. */
-		void pushDirectory(const String& dir);
+		void pushDirectory(const String& dir) { pushDirectory(dir.data(), (UINT32)dir.length()); }
+
+		/** Add new directory, consisting of @p length characters of @p dir, to the end of the path. */
+		void pushDirectory(const char* dir, UINT32 length);
 
 		/** Helper method that throws invalid path exception. */
 		void throwInvalidPathException(const String& path) const;
 	private:
 		friend struct RTTIPlainType<Path>; // For serialization
-		friend struct ::std::hash<bs::Path>;
 
 		Vector<String> mDirectories;
 		String mDevice;
@@ -520,15 +526,7 @@ namespace std
 	{
 		size_t operator()(const bs::Path& path) const
 		{
-			size_t hash = 0;
-			bs::hash_combine(hash, path.mFilename);
-			bs::hash_combine(hash, path.mDevice);
-			bs::hash_combine(hash, path.mNode);
-
-			for (auto& dir : path.mDirectories)
-				bs::hash_combine(hash, dir);
-
-			return hash;
+			return path.getHash();
 		}
 	};
 }
@@ -3,6 +3,7 @@
 #include "Image/BsTextureAtlasLayout.h"
 #include "Debug/BsDebug.h"
 #include "Utility/BsBitwise.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -15,157 +16,273 @@ namespace bs
 			return true;
 		}
 
-		// Try adding without expanding, if that fails try to expand
-		if(!addToNode(0, width, height, x, y, false))
-		{
-			if (!addToNode(0, width, height, x, y, true))
-				return false;
-		}
+		// Find the lowest position where the element fits, preferring ones that don't require the atlas to grow. If it
+		// has to grow, pick the position that grows its area the least.
+		UINT32 bestIdx = (UINT32)-1;
+		UINT32 bestY = 0;
+		bool bestGrows = true;
+		UINT64 bestArea = std::numeric_limits<UINT64>::max();
+		UINT32 bestTop = std::numeric_limits<UINT32>::max();
 
-		// Update size to cover all nodes
-		if(mPow2)
-		{
-			mWidth = std::max(mWidth, Bitwise::nextPow2(x + width));
-			mHeight = std::max(mHeight, Bitwise::nextPow2(y + height));
-		}
-		else
+		for(UINT32 i = 0; i < (UINT32)mSkyline.size(); i++)
 		{
-			mWidth = std::max(mWidth, x + width);
-			mHeight = std::max(mHeight, y + height);
+			UINT32 nodeY;
+			if(!fitsAt(i, width, height, nodeY))
+				continue;
+
+			const UINT32 right = mSkyline[i].x + width;
+			const UINT32 top = nodeY + height;
+			const bool grows = right > mWidth || top > mHeight;
+
+			if(grows)
+			{
+				if(!bestGrows)
+					continue;
+
+				const UINT64 area = (UINT64)growTo(mWidth, right) * growTo(mHeight, top);
+				if(area > bestArea || (area == bestArea && top >= bestTop))
+					continue;
+
+				bestArea = area;
+			}
+			else if(!bestGrows && top >= bestTop)
+				continue;
+
+			bestIdx = i;
+			bestY = nodeY;
+			bestTop = top;
+			bestGrows = grows;
 		}
 
+		if(bestIdx == (UINT32)-1)
+			return false;
+
+		x = mSkyline[bestIdx].x;
+		y = bestY;
+		insertAt(bestIdx, width, height, bestY);
+
+		mWidth = growTo(mWidth, x + width);
+		mHeight = growTo(mHeight, y + height);
+
 		return true;
 	}
 
 	void TextureAtlasLayout::clear()
 	{
-		mNodes.clear();
-		mNodes.push_back(TexAtlasNode(0, 0, mWidth, mHeight));
+		mSkyline.clear();
+		mSkyline.push_back({ 0, 0, mMaxWidth });
 
 		mWidth = mInitialWidth;
 		mHeight = mInitialHeight;
 	}
 
-	bool TextureAtlasLayout::addToNode(UINT32 nodeIdx, UINT32 width, UINT32 height, UINT32& x, UINT32& y, bool allowGrowth)
+	bool TextureAtlasLayout::fitsAt(UINT32 nodeIdx, UINT32 width, UINT32 height, UINT32& y) const
 	{
-		TexAtlasNode* node = &mNodes[nodeIdx];
-		float aspect = node->width / (float)node->height;
+		const UINT32 x = mSkyline[nodeIdx].x;
+		if(x + width > mMaxWidth)
+			return false;
 
-		if (node->children[0] != (UINT32)-1)
+		// Element rests on the highest node it spans
+		y = 0;
+		UINT32 remaining = width;
+		for(UINT32 i = nodeIdx; remaining > 0; i++)
 		{
-			if (addToNode(node->children[0], width, height, x, y, allowGrowth))
-				return true;
+			const SkylineNode& node = mSkyline[i];
 
-			return addToNode(node->children[1], width, height, x, y, allowGrowth);
-		}
-		else
-		{
-			if (node->nodeFull)
+			y = std::max(y, node.y);
+			if(y + height > mMaxHeight)
 				return false;
 
-			if (width > node->width || height > node->height)
-				return false;
+			remaining -= std::min(remaining, node.width);
+		}
 
-			if(!allowGrowth)
-			{
-				if (node->x + width > mWidth || node->y + height > mHeight)
-					return false;
-			}
+		return true;
+	}
 
-			if (width == node->width && height == node->height)
-			{
-				x = node->x;
-				y = node->y;
-				node->nodeFull = true;
+	void TextureAtlasLayout::insertAt(UINT32 nodeIdx, UINT32 width, UINT32 height, UINT32 y)
+	{
+		const UINT32 x = mSkyline[nodeIdx].x;
+		const UINT32 right = x + width;
 
-				return true;
-			}
+		// Remove the nodes covered by the element, and trim the one that is covered partially
+		UINT32 endIdx = nodeIdx;
+		while(endIdx < (UINT32)mSkyline.size() && mSkyline[endIdx].x + mSkyline[endIdx].width <= right)
+			endIdx++;
 
-			float dw = (float)(node->width - width);
-			float dh = (node->height - height) * aspect;
+		if(endIdx < (UINT32)mSkyline.size() && mSkyline[endIdx].x < right)
+		{
+			SkylineNode& node = mSkyline[endIdx];
+			node.width -= right - node.x;
+			node.x = right;
+		}
 
-			UINT32 nextChildIdx = (UINT32)mNodes.size();
-			node->children[0] = nextChildIdx;
-			node->children[1] = nextChildIdx + 1;
+		mSkyline.erase(mSkyline.begin() + nodeIdx, mSkyline.begin() + endIdx);
+		mSkyline.insert(mSkyline.begin() + nodeIdx, { x, y + height, width });
 
-			TexAtlasNode nodeCopy = *node;
-			node = nullptr; // Undefined past this point
-			if (dw > dh)
-			{
-				mNodes.emplace_back(nodeCopy.x, nodeCopy.y, width, nodeCopy.height);
-				mNodes.emplace_back(nodeCopy.x + width, nodeCopy.y, nodeCopy.width - width, nodeCopy.height);
-			}
-			else
-			{
-				mNodes.emplace_back(nodeCopy.x, nodeCopy.y, nodeCopy.width, height);
-				mNodes.emplace_back(nodeCopy.x, nodeCopy.y + height, nodeCopy.width, nodeCopy.height - height);
-			}
+		// Merge with neighbours at the same height
+		if(nodeIdx + 1 < (UINT32)mSkyline.size() && mSkyline[nodeIdx + 1].y == mSkyline[nodeIdx].y)
+		{
+			mSkyline[nodeIdx].width += mSkyline[nodeIdx + 1].width;
+			mSkyline.erase(mSkyline.begin() + nodeIdx + 1);
+		}
 
-			return addToNode(nodeCopy.children[0], width, height, x, y, allowGrowth);
+		if(nodeIdx > 0 && mSkyline[nodeIdx - 1].y == mSkyline[nodeIdx].y)
+		{
+			mSkyline[nodeIdx - 1].width += mSkyline[nodeIdx].width;
+			mSkyline.erase(mSkyline.begin() + nodeIdx);
 		}
 	}
 
+	UINT32 TextureAtlasLayout::growTo(UINT32 current, UINT32 extent) const
+	{
+		if(extent <= current)
+			return current;
+
+		return mPow2 ? Bitwise::nextPow2(extent) : extent;
+	}
+
 	Vector<TextureAtlasUtility::Page> TextureAtlasUtility::createAtlasLayout(Vector<Element>& elements, UINT32 width, 
 		UINT32 height, UINT32 maxWidth, UINT32 maxHeight, bool pow2)
 	{
+		Vector<Vector2I> sizes(elements.size());
+		for (size_t i = 0; i < elements.size(); i++)
+			sizes[i] = Vector2I((INT32)elements[i].input.width, (INT32)elements[i].input.height);
+
+		Vector<Placement> placements;
+		Vector<Page> pages = createAtlasLayout(sizes, placements, width, height, maxWidth, maxHeight, pow2);
+
 		for (size_t i = 0; i < elements.size(); i++)
 		{
-			elements[i].output.idx = (UINT32)i; // Preserve original index before sorting
-			elements[i].output.page = -1;
+			elements[i].output.x = placements[i].x;
+			elements[i].output.y = placements[i].y;
+			elements[i].output.idx = (UINT32)i;
+			elements[i].output.page = placements[i].page;
 		}
 
-		std::sort(elements.begin(), elements.end(), 
-			[](const Element& a, const Element& b)
+		return pages;
+	}
+
+	Vector<TextureAtlasUtility::Page> TextureAtlasUtility::createAtlasLayout(const Vector<Vector2I>& sizes,
+		Vector<Placement>& placements, UINT32 width, UINT32 height, UINT32 maxWidth, UINT32 maxHeight, bool pow2)
+	{
+		const auto numElements = (UINT32)sizes.size();
+		placements.assign(numElements, Placement());
+
+		for (auto& entry : sizes)
 		{
-			return a.input.width * a.input.height > b.input.width * b.input.height;
-		});
+			// Check if an element is too large to ever fit
+			if ((UINT32)entry.x > maxWidth || (UINT32)entry.y > maxHeight)
+			{
+				LOGWRN("Some of the provided elements don't fit in an atlas of provided size. Returning empty array of pages.");
+				return Vector<Page>();
+			}
+		}
+
+		// Skyline packing works best when taller elements are placed first
+		Vector<UINT32> remaining(numElements);
+		for (UINT32 i = 0; i < numElements; i++)
+			remaining[i] = i;
+
+		const auto compare = [&sizes](UINT32 a, UINT32 b)
+		{
+			if (sizes[a].y != sizes[b].y)
+				return sizes[a].y > sizes[b].y;
+
+			if (sizes[a].x != sizes[b].x)
+				return sizes[a].x > sizes[b].x;
+
+			return a < b;
+		};
+
+		std::sort(remaining.begin(), remaining.end(), compare);
+
+		const UINT64 pageArea = (UINT64)maxWidth * maxHeight;
+
+		// Page that rejected each element in the current round
+		Vector<UINT32> rejectedBy(numElements);
 
 		Vector<TextureAtlasLayout> layouts;
-		UINT32 remainingCount = (UINT32)elements.size();
-		while (remainingCount > 0)
+		while (!remaining.empty())
 		{
-			layouts.push_back(TextureAtlasLayout(width, height, maxWidth, maxHeight, pow2));
-			TextureAtlasLayout& curLayout = layouts.back();
+			UINT64 totalArea = 0;
+			for (auto& entry : remaining)
+				totalArea += (UINT64)sizes[entry].x * sizes[entry].y;
 
-			// Find largest unassigned element that fits
-			UINT32 sizeLimit = std::numeric_limits<UINT32>::max();
-			while (true)
+			// Distribute the elements over the minimum number of pages they could fit in, so every page gets a similar
+			// mix of sizes and they can be packed independently. Elements that end up not fitting are moved to other
+			// pages, or to the next round if all pages are full.
+			const auto numPages = (UINT32)std::min((UINT64)remaining.size(),
+				std::max((UINT64)1, Math::divideAndRoundUp(totalArea, pageArea)));
+
+			Vector<Vector<UINT32>> pageElements(numPages);
+			for (UINT32 i = 0; i < (UINT32)remaining.size(); i++)
 			{
-				UINT32 largestId = -1;
+				const UINT32 round = i / numPages;
+				const UINT32 offset = i % numPages;
 
-				// Assumes elements are sorted from largest to smallest
-				for (UINT32 i = 0; i < (UINT32)elements.size(); i++)
+				// Alternate the direction so the first page doesn't always get the larger element of each round
+				const UINT32 pageIdx = (round % 2) == 0 ? offset : numPages - offset - 1;
+				pageElements[pageIdx].push_back(remaining[i]);
+			}
+
+			const auto firstPage = (UINT32)layouts.size();
+			layouts.resize(firstPage + numPages, TextureAtlasLayout(width, height, maxWidth, maxHeight, pow2));
+
+			Vector<Vector<UINT32>> rejected(numPages);
+			const auto packPages = [&](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
 				{
-					if (elements[i].output.page == -1)
+					TextureAtlasLayout& layout = layouts[firstPage + i];
+					for (auto& entry : pageElements[i])
 					{
-						UINT32 size = elements[i].input.width * elements[i].input.height;
-						if (size < sizeLimit)
+						Placement& placement = placements[entry];
+						if (layout.addElement((UINT32)sizes[entry].x, (UINT32)sizes[entry].y, placement.x, placement.y))
+							placement.page = (INT32)(firstPage + i);
+						else
 						{
-							largestId = i;
-							break;
+							rejected[i].push_back(entry);
+							rejectedBy[entry] = i;
 						}
 					}
 				}
+			};
+
+			if (numPages > 1 && TaskScheduler::isStarted())
+				TaskScheduler::instance().parallelFor(numPages, 1, packPages);
+			else
+				packPages(0, numPages);
 
-				if (largestId == (UINT32)-1)
-					break; // Nothing fits, start a new page
+			// Try fitting the rejected elements in the other pages of this round, and carry the rest over to new pages.
+			// Pages from earlier rounds have already rejected them.
+			Vector<UINT32> nextRemaining;
+			for (UINT32 i = 0; i < numPages; i++)
+			{
+				for (auto& entry : rejected[i])
+					nextRemaining.push_back(entry);
+			}
 
-				Element& element = elements[largestId];
+			std::sort(nextRemaining.begin(), nextRemaining.end(), compare);
 
-				// Check if an element is too large to ever fit
-				if(element.input.width > maxWidth || element.input.height > maxHeight)
+			remaining.clear();
+			for (auto& entry : nextRemaining)
+			{
+				Placement& placement = placements[entry];
+				for (UINT32 i = 0; i < numPages; i++)
 				{
-					LOGWRN("Some of the provided elements don't fit in an atlas of provided size. Returning empty array of pages.");
-					return Vector<Page>();
-				}
+					if (rejectedBy[entry] == i)
+						continue;
 
-				if (curLayout.addElement(element.input.width, element.input.height, element.output.x, element.output.y))
-				{
-					element.output.page = (UINT32)layouts.size() - 1;
-					remainingCount--;
+					TextureAtlasLayout& layout = layouts[firstPage + i];
+					if (layout.addElement((UINT32)sizes[entry].x, (UINT32)sizes[entry].y, placement.x, placement.y))
+					{
+						placement.page = (INT32)(firstPage + i);
+						break;
+					}
 				}
-				else
-					sizeLimit = element.input.width * element.input.height;
+
+				if (placement.page == -1)
+					remaining.push_back(entry);
 			}
 		}
 
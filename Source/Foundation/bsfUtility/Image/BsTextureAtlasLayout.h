@@ -4,6 +4,7 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Math/BsVector2.h"
+#include "Math/BsVector2I.h"
 
 namespace bs
 {
@@ -11,24 +12,18 @@ namespace bs
 	 *  @{
 	 */
 
-	/** Organizes a set of textures into a single larger texture (an atlas) by minimizing empty space. */
+	/**
+	 * Organizes a set of textures into a single larger texture (an atlas) by minimizing empty space. Uses a skyline
+	 * packer that tracks the top edge of the occupied area, placing each element at the lowest position it fits.
+	 */
 	class BS_UTILITY_EXPORT TextureAtlasLayout
 	{
-		/** Represent a single node in the texture atlas binary tree. */
-		class TexAtlasNode
+		/** Horizontal segment of the skyline, at the height the area below it is occupied to. */
+		struct SkylineNode
 		{
-		public:
-			constexpr TexAtlasNode() = default;
-			constexpr TexAtlasNode(UINT32 x, UINT32 y, UINT32 width, UINT32 height)
-				: x(x), y(y), width(width), height(height)
-			{ }
-
-			UINT32 x = 0;
-			UINT32 y = 0;
-			UINT32 width = 0;
-			UINT32 height = 0;
-			UINT32 children[2] { std::numeric_limits<UINT32>::max(), std::numeric_limits<UINT32>::max() };
-			bool nodeFull = false;
+			UINT32 x;
+			UINT32 y;
+			UINT32 width;
 		};
 
 	public:
@@ -44,9 +39,10 @@ namespace bs
 		 * @param[in]	pow2			When true the resulting atlas size will always be a power of two.
 		 */
 		TextureAtlasLayout(UINT32 width, UINT32 height, UINT32 maxWidth, UINT32 maxHeight, bool pow2 = false)
-			: mInitialWidth(width), mInitialHeight(height), mWidth(width), mHeight(height), mPow2(pow2)
+			: mInitialWidth(width), mInitialHeight(height), mWidth(width), mHeight(height), mMaxWidth(maxWidth)
+			, mMaxHeight(maxHeight), mPow2(pow2)
 		{
-			mNodes.push_back(TexAtlasNode(0, 0, maxWidth, maxHeight));
+			mSkyline.push_back({ 0, 0, maxWidth });
 		}
 
 		/**
@@ -65,7 +61,7 @@ namespace bs
 		void clear();
 
 		/** Checks have any elements been added to the layout. */
-		bool isEmpty() const { return mNodes.size() == 1; }
+		bool isEmpty() const { return mSkyline.size() == 1 && mSkyline[0].y == 0; }
 
 		/** Returns the width of the atlas texture, in pixels. */
 		UINT32 getWidth() const { return mWidth; }
@@ -74,28 +70,27 @@ namespace bs
 		UINT32 getHeight() const { return mHeight; }
 
 	private:
-		/* 
-		 * Attempts to add a new element to the specified layout node. 
-		 * 
-		 * @param[in]	nodeIdx			Index of the node to which to add the element.
-		 * @param[in]	width			Width of the new element, in pixels.
-		 * @param[in]	height			Height of the new element, in pixels.
-		 * @param[out]	x				Horizontal position of the new element within the atlas. Only valid if method
-		 *								returns true.
-		 * @param[out]	y				Vertical position of the new element within the atlas. Only valid if method returns
-		 *								true.
-		 * @param[in]	allowGrowth		When true, the width/height of the atlas will be allowed to grow to fit the element.
-		 * @return						True if the element was added to the atlas, false if the element doesn't fit.
+		/**
+		 * Finds the vertical position at which an element would rest if its left edge was placed at the start of the
+		 * specified skyline node. Returns false if the element would extend past the maximum atlas size.
 		 */
-		bool addToNode(UINT32 nodeIdx, UINT32 width, UINT32 height, UINT32& x, UINT32& y, bool allowGrowth);
+		bool fitsAt(UINT32 nodeIdx, UINT32 width, UINT32 height, UINT32& y) const;
+
+		/** Raises the skyline to cover the element placed at the start of the specified node. */
+		void insertAt(UINT32 nodeIdx, UINT32 width, UINT32 height, UINT32 y);
+
+		/** Returns the value the atlas size grows to, in order to cover the specified extent. */
+		UINT32 growTo(UINT32 current, UINT32 extent) const;
 
 		UINT32 mInitialWidth = 0;
 		UINT32 mInitialHeight = 0;
 		UINT32 mWidth = 0;
 		UINT32 mHeight = 0;
+		UINT32 mMaxWidth = 0;
+		UINT32 mMaxHeight = 0;
 		bool mPow2 = false;
 
-		Vector<TexAtlasNode> mNodes;
+		Vector<SkylineNode> mSkyline;
 	};
 
 	/** Utility class used for texture atlas layouts. */
@@ -129,6 +124,16 @@ namespace bs
 			UINT32 width, height;
 		};
 
+		/** Position of a single element within the atlas, as output by createAtlasLayout(). */
+		struct Placement
+		{
+			UINT32 x = 0;
+			UINT32 y = 0;
+
+			/** Index of the page the element was placed on, or -1 if packing failed. */
+			INT32 page = -1;
+		};
+
 		/**
 		 * Creates an optimal texture layout by packing texture elements in order to end up with as little empty space 
 		 * as possible. Algorithm will split elements over multiple textures if they don't fit in a single texture.
@@ -145,6 +150,24 @@ namespace bs
 		 */
 		static Vector<Page> createAtlasLayout(Vector<Element>& elements, UINT32 width, UINT32 height, UINT32 maxWidth, 
 			UINT32 maxHeight, bool pow2 = false);
+
+		/**
+		 * Creates an optimal texture layout for elements of the provided sizes, same as the overload above. Elements are
+		 * sorted and inserted as a batch. When they don't fit in a single page they are distributed over multiple pages
+		 * that get packed in parallel, if the task scheduler is running.
+		 *
+		 * @param[in]	sizes		Width and height of each element, in pixels.
+		 * @param[out]	placements	Position of each element, in the same order as @p sizes.
+		 * @param[in]	width 		Initial width of the atlas texture.
+		 * @param[in]	height		Initial height of the atlas texture.
+		 * @param[in]	maxWidth	Maximum width the atlas texture is allowed to grow to, when elements don't fit.
+		 * @param[in]	maxHeight	Maximum height the atlas texture is allowed to grow to, when elements don't fit.
+		 * @param[in]	pow2		When true the resulting atlas size will always be a power of two.
+		 * @return					One or more descriptors that determine the size of the final atlas textures.
+		 *							Elements reference these pages through Placement::page.
+		 */
+		static Vector<Page> createAtlasLayout(const Vector<Vector2I>& sizes, Vector<Placement>& placements, UINT32 width,
+			UINT32 height, UINT32 maxWidth, UINT32 maxHeight, bool pow2 = false);
 	};
 
 	/** @} */
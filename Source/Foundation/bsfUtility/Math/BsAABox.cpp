@@ -5,6 +5,7 @@
 #include "Math/BsPlane.h"
 #include "Math/BsSphere.h"
 #include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -165,30 +166,7 @@ namespace bs
 
 	void AABox::transformAffine(const Matrix4& m)
 	{
-		Vector3 min = m.getTranslation();
-		Vector3 max = m.getTranslation();
-		for(UINT32 i = 0; i < 3; i++)
-		{
-			for(UINT32 j = 0; j < 3; j++)
-			{
-				float e = m[i][j] * mMinimum[j];
-				float f = m[i][j] * mMaximum[j];
-
-				if(e < f)
-				{
-					min[i] += e;
-					max[i] += f;
-				}
-				else
-				{
-					min[i] += f;
-					max[i] += e;
-				}
-			}
-
-		}
-
-		setExtents(min, max);
+		*this = simd::transformAffine(*this, m);
 	}
 
 	bool AABox::intersects(const AABox& b2) const
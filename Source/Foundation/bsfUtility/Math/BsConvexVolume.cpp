@@ -5,6 +5,7 @@
 #include "Math/BsSphere.h"
 #include "Math/BsPlane.h"
 #include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 #include "Error/BsException.h"
 
 namespace bs
@@ -114,6 +115,27 @@ namespace bs
 		return true;
 	}
 
+	bool ConvexVolume::contains(const AABox& box) const
+	{
+		Vector3 center = box.getCenter();
+		Vector3 extents = box.getHalfSize();
+		Vector3 absExtents(Math::abs(extents.x), Math::abs(extents.y), Math::abs(extents.z));
+
+		for (auto& plane : mPlanes)
+		{
+			float dist = center.dot(plane.normal) - plane.d;
+
+			float effectiveRadius = absExtents.x * Math::abs(plane.normal.x);
+			effectiveRadius += absExtents.y * Math::abs(plane.normal.y);
+			effectiveRadius += absExtents.z * Math::abs(plane.normal.z);
+
+			if (dist < effectiveRadius)
+				return false;
+		}
+
+		return true;
+	}
+
 	bool ConvexVolume::intersects(const Sphere& sphere) const
 	{
 		Vector3 center = sphere.getCenter();
@@ -150,4 +172,154 @@ namespace bs
 
 		return mPlanes[whichPlane];
 	}
+
+	ConvexVolumeCuller::ConvexVolumeCuller(const ConvexVolume& volume)
+	{
+		const Vector<Plane> planes = volume.getPlanes();
+		mNumPlanes = (UINT32)planes.size();
+
+		const UINT32 numGroups = Math::divideAndRoundUp(mNumPlanes, 4U);
+		for (UINT32 i = 0; i < numGroups; i++)
+		{
+			PlaneGroup group;
+			for (UINT32 j = 0; j < 4; j++)
+			{
+				const UINT32 planeIdx = i * 4 + j;
+				if (planeIdx < mNumPlanes)
+				{
+					const Plane& plane = planes[planeIdx];
+
+					group.normalX[j] = plane.normal.x;
+					group.normalY[j] = plane.normal.y;
+					group.normalZ[j] = plane.normal.z;
+					group.d[j] = plane.d;
+				}
+				else
+				{
+					// Everything is infinitely far on the positive side of this plane
+					group.normalX[j] = 0.0f;
+					group.normalY[j] = 0.0f;
+					group.normalZ[j] = 0.0f;
+					group.d[j] = -std::numeric_limits<float>::max();
+				}
+
+				group.absNormalX[j] = Math::abs(group.normalX[j]);
+				group.absNormalY[j] = Math::abs(group.normalY[j]);
+				group.absNormalZ[j] = Math::abs(group.normalZ[j]);
+			}
+
+			mGroups.add(group);
+		}
+	}
+
+	/**
+	 * Tests a box, provided by its center and absolute extents, against groups of four planes. Returns true if the box
+	 * is fully on the negative side of any of the planes.
+	 */
+	template<class PlaneGroups>
+	static bool isBoxCulled(const PlaneGroups& groups, const Vector3& center, const Vector3& extents)
+	{
+		using namespace simd;
+
+		const float32x4 centerX = splat<float32x4>(center.x);
+		const float32x4 centerY = splat<float32x4>(center.y);
+		const float32x4 centerZ = splat<float32x4>(center.z);
+		const float32x4 extentX = splat<float32x4>(extents.x);
+		const float32x4 extentY = splat<float32x4>(extents.y);
+		const float32x4 extentZ = splat<float32x4>(extents.z);
+
+		for (auto& group : groups)
+		{
+			float32x4 distance = mul(centerX, load_u<float32x4>(group.normalX));
+			distance = add(distance, mul(centerY, load_u<float32x4>(group.normalY)));
+			distance = add(distance, mul(centerZ, load_u<float32x4>(group.normalZ)));
+			distance = sub(distance, load_u<float32x4>(group.d));
+
+			float32x4 radius = mul(extentX, load_u<float32x4>(group.absNormalX));
+			radius = add(radius, mul(extentY, load_u<float32x4>(group.absNormalY)));
+			radius = add(radius, mul(extentZ, load_u<float32x4>(group.absNormalZ)));
+
+			const uint32x4 culled = bit_cast<uint32x4>(cmp_lt(distance, neg(radius)));
+			if (test_bits_any(culled))
+				return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Tests a sphere against groups of four planes. Returns true if the sphere is fully on the negative side of any of
+	 * the planes.
+	 */
+	template<class PlaneGroups>
+	static bool isSphereCulled(const PlaneGroups& groups, const Vector3& center, float radius)
+	{
+		using namespace simd;
+
+		const float32x4 centerX = splat<float32x4>(center.x);
+		const float32x4 centerY = splat<float32x4>(center.y);
+		const float32x4 centerZ = splat<float32x4>(center.z);
+		const float32x4 negRadius = splat<float32x4>(-radius);
+
+		for (auto& group : groups)
+		{
+			float32x4 distance = mul(centerX, load_u<float32x4>(group.normalX));
+			distance = add(distance, mul(centerY, load_u<float32x4>(group.normalY)));
+			distance = add(distance, mul(centerZ, load_u<float32x4>(group.normalZ)));
+			distance = sub(distance, load_u<float32x4>(group.d));
+
+			const uint32x4 culled = bit_cast<uint32x4>(cmp_lt(distance, negRadius));
+			if (test_bits_any(culled))
+				return true;
+		}
+
+		return false;
+	}
+
+	/** Returns the center and the absolute half-size of a box. */
+	static void getBoxCenterExtents(const AABox& box, Vector3& center, Vector3& extents)
+	{
+		const Vector3& min = box.getMin();
+		const Vector3& max = box.getMax();
+
+		center = (min + max) * 0.5f;
+		extents = (max - min) * 0.5f;
+		extents = Vector3(Math::abs(extents.x), Math::abs(extents.y), Math::abs(extents.z));
+	}
+
+	bool ConvexVolumeCuller::intersects(const AABox& box) const
+	{
+		Vector3 center, extents;
+		getBoxCenterExtents(box, center, extents);
+
+		return !isBoxCulled(mGroups, center, extents);
+	}
+
+	bool ConvexVolumeCuller::intersects(const Sphere& sphere) const
+	{
+		return !isSphereCulled(mGroups, sphere.getCenter(), sphere.getRadius());
+	}
+
+	void ConvexVolumeCuller::intersects(const AABox* boxes, UINT32 count, UINT32* visibility) const
+	{
+		// Testing a single box against four planes at once allows the test to stop at the first plane group that culls
+		// the box, which is faster than testing four boxes at once when most of them are outside of the volume
+		for (UINT32 i = 0; i < count; i++)
+		{
+			Vector3 center, extents;
+			getBoxCenterExtents(boxes[i], center, extents);
+
+			if (!isBoxCulled(mGroups, center, extents))
+				visibility[i / 32] |= 1U << (i % 32);
+		}
+	}
+
+	void ConvexVolumeCuller::intersects(const Sphere* spheres, UINT32 count, UINT32* visibility) const
+	{
+		for (UINT32 i = 0; i < count; i++)
+		{
+			if (!isSphereCulled(mGroups, spheres[i].getCenter(), spheres[i].getRadius()))
+				visibility[i / 32] |= 1U << (i % 32);
+		}
+	}
 }
@@ -53,6 +53,9 @@ namespace bs
 		 */
 		bool contains(const Vector3& p, float expand = 0.0f) const;
 
+		/** Checks if the convex volume fully contains the provided axis aligned box. */
+		bool contains(const AABox& box) const;
+
 		/** Returns the internal set of planes that represent the volume. */
 		Vector<Plane> getPlanes() const { return mPlanes; }
 
@@ -63,5 +66,68 @@ namespace bs
 		Vector<Plane> mPlanes;
 	};
 
+	/**
+	 * Convex volume prepared for culling large numbers of bounds against it. Provides the same tests as ConvexVolume
+	 * but with the plane data precomputed: planes are stored in groups of four in a structure-of-arrays layout, along
+	 * with the absolute values of their normals used for the box tests, so a single bound is tested against four planes
+	 * at once. Batched methods test entire arrays of bounds and output a visibility bitset.
+	 *
+	 * Box tests are equivalent to testing the box corner furthest along the plane normal (the p-vertex) against the
+	 * plane, without having to select the corner per plane.
+	 */
+	class BS_UTILITY_EXPORT ConvexVolumeCuller
+	{
+	public:
+		ConvexVolumeCuller() = default;
+		ConvexVolumeCuller(const ConvexVolume& volume);
+
+		/** @copydoc ConvexVolume::intersects(const AABox&) const */
+		bool intersects(const AABox& box) const;
+
+		/** @copydoc ConvexVolume::intersects(const Sphere&) const */
+		bool intersects(const Sphere& sphere) const;
+
+		/**
+		 * Tests a set of boxes against the volume.
+		 *
+		 * @param[in]	boxes		Boxes to test.
+		 * @param[in]	count		Number of entries in the @p boxes array.
+		 * @param[out]	visibility	Bitset with one bit per box, which gets set if the box intersects the volume.
+		 *							Bits of boxes outside of the volume are left unchanged, so results of multiple
+		 *							volumes can be combined. Must have room for at least (count + 31) / 32 entries.
+		 */
+		void intersects(const AABox* boxes, UINT32 count, UINT32* visibility) const;
+
+		/**
+		 * Tests a set of spheres against the volume.
+		 *
+		 * @param[in]	spheres		Spheres to test.
+		 * @param[in]	count		Number of entries in the @p spheres array.
+		 * @param[out]	visibility	Bitset with one bit per sphere, which gets set if the sphere intersects the volume.
+		 *							Bits of spheres outside of the volume are left unchanged, so results of multiple
+		 *							volumes can be combined. Must have room for at least (count + 31) / 32 entries.
+		 */
+		void intersects(const Sphere* spheres, UINT32 count, UINT32* visibility) const;
+
+		/** Returns the number of planes the volume was created with. */
+		UINT32 getNumPlanes() const { return mNumPlanes; }
+
+	private:
+		/** Four planes in a structure-of-arrays layout. Unused entries are set up to never cull anything. */
+		struct PlaneGroup
+		{
+			float normalX[4];
+			float normalY[4];
+			float normalZ[4];
+			float d[4];
+			float absNormalX[4];
+			float absNormalY[4];
+			float absNormalZ[4];
+		};
+
+		SmallVector<PlaneGroup, 2> mGroups;
+		UINT32 mNumPlanes = 0;
+	};
+
 	/** @} */
 }
@@ -6,6 +6,9 @@
 #include "Math/BsVector4.h"
 #include "Math/BsAABox.h"
 #include "Math/BsSphere.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsQuaternion.h"
+#include "Math/BsBounds.h"
 
 #define SIMDPP_ARCH_X86_SSE4_1
 
@@ -83,6 +86,352 @@ namespace bs
 			}
 		};
 
+		/** 
+		 * Multiplies two 4x4 matrices (@p lhs * @p rhs) and writes the result in @p output. Output is allowed to be the
+		 * same object as one of the inputs.
+		 */
+		inline void multiply(const bs::Matrix4& lhs, const bs::Matrix4& rhs, bs::Matrix4& output)
+		{
+			const float* lhsData = &lhs[0].x;
+			const float* rhsData = &rhs[0].x;
+
+			float32x4 rhsRow0 = load_u<float32x4>(rhsData + 0);
+			float32x4 rhsRow1 = load_u<float32x4>(rhsData + 4);
+			float32x4 rhsRow2 = load_u<float32x4>(rhsData + 8);
+			float32x4 rhsRow3 = load_u<float32x4>(rhsData + 12);
+
+			float32x4 rows[4];
+			for(UINT32 i = 0; i < 4; i++)
+			{
+				const float* lhsRow = lhsData + i * 4;
+
+				float32x4 row = mul(load_splat<float32x4>(lhsRow + 0), rhsRow0);
+				row = add(row, mul(load_splat<float32x4>(lhsRow + 1), rhsRow1));
+				row = add(row, mul(load_splat<float32x4>(lhsRow + 2), rhsRow2));
+				row = add(row, mul(load_splat<float32x4>(lhsRow + 3), rhsRow3));
+
+				rows[i] = row;
+			}
+
+			// Store only once all rows are calculated, in case output aliases one of the inputs
+			float* outputData = &output[0].x;
+			for(UINT32 i = 0; i < 4; i++)
+				store_u(outputData + i * 4, rows[i]);
+		}
+
+		/** 
+		 * Multiplies two affine 4x4 matrices (@p lhs * @p rhs) and writes the result in @p output. Equivalent to
+		 * bs::Matrix4::concatenateAffine(). Output is allowed to be the same object as one of the inputs.
+		 */
+		inline void multiplyAffine(const bs::Matrix4& lhs, const bs::Matrix4& rhs, bs::Matrix4& output)
+		{
+			const float* lhsData = &lhs[0].x;
+			const float* rhsData = &rhs[0].x;
+
+			float32x4 rhsRow0 = load_u<float32x4>(rhsData + 0);
+			float32x4 rhsRow1 = load_u<float32x4>(rhsData + 4);
+			float32x4 rhsRow2 = load_u<float32x4>(rhsData + 8);
+			float32x4 rhsRow3 = make_float(0.0f, 0.0f, 0.0f, 1.0f);
+
+			float32x4 rows[3];
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				const float* lhsRow = lhsData + i * 4;
+
+				float32x4 row = mul(load_splat<float32x4>(lhsRow + 0), rhsRow0);
+				row = add(row, mul(load_splat<float32x4>(lhsRow + 1), rhsRow1));
+				row = add(row, mul(load_splat<float32x4>(lhsRow + 2), rhsRow2));
+				row = add(row, mul(load_splat<float32x4>(lhsRow + 3), rhsRow3));
+
+				rows[i] = row;
+			}
+
+			float* outputData = &output[0].x;
+			for(UINT32 i = 0; i < 3; i++)
+				store_u(outputData + i * 4, rows[i]);
+
+			store_u(outputData + 12, rhsRow3);
+		}
+
+		/** 
+		 * Multiplies @p count pairs of 4x4 matrices (@p lhs[i] * @p rhs[i]) and writes the results in @p output. Output
+		 * is allowed to be the same array as one of the inputs.
+		 */
+		inline void multiply(const bs::Matrix4* lhs, const bs::Matrix4* rhs, bs::Matrix4* output, UINT32 count)
+		{
+			for(UINT32 i = 0; i < count; i++)
+				multiply(lhs[i], rhs[i], output[i]);
+		}
+
+		/** Multiplies @p count matrices by a single matrix (@p lhs * @p rhs[i]) and writes the results in @p output. */
+		inline void multiply(const bs::Matrix4& lhs, const bs::Matrix4* rhs, bs::Matrix4* output, UINT32 count)
+		{
+			for(UINT32 i = 0; i < count; i++)
+				multiply(lhs, rhs[i], output[i]);
+		}
+
+		/** 
+		 * Multiplies @p count pairs of affine 4x4 matrices (@p lhs[i] * @p rhs[i]) and writes the results in @p output.
+		 * Output is allowed to be the same array as one of the inputs.
+		 */
+		inline void multiplyAffine(const bs::Matrix4* lhs, const bs::Matrix4* rhs, bs::Matrix4* output, UINT32 count)
+		{
+			for(UINT32 i = 0; i < count; i++)
+				multiplyAffine(lhs[i], rhs[i], output[i]);
+		}
+
+		/** 
+		 * Linearly interpolates between @p count pairs of matrices (@p a[i] * (1 - t) + @p b[i] * t) and writes the
+		 * results in @p output. Output is allowed to be the same array as one of the inputs.
+		 */
+		inline void lerp(const bs::Matrix4* a, const bs::Matrix4* b, bs::Matrix4* output, UINT32 count, float t)
+		{
+			const float32x4 weightA = splat<float32x4>(1.0f - t);
+			const float32x4 weightB = splat<float32x4>(t);
+
+			for(UINT32 i = 0; i < count; i++)
+			{
+				const float* aData = &a[i][0].x;
+				const float* bData = &b[i][0].x;
+				float* outputData = &output[i][0].x;
+
+				for(UINT32 j = 0; j < 4; j++)
+				{
+					float32x4 row = mul(load_u<float32x4>(aData + j * 4), weightA);
+					row = add(row, mul(load_u<float32x4>(bData + j * 4), weightB));
+
+					store_u(outputData + j * 4, row);
+				}
+			}
+		}
+
+		/** 
+		 * Calculates the inverse of an affine 4x4 matrix and writes it in @p output. Equivalent to
+		 * bs::Matrix4::inverseAffine(). Output is allowed to be the same object as the input.
+		 */
+		inline void inverseAffine(const bs::Matrix4& input, bs::Matrix4& output)
+		{
+			const float* data = &input[0].x;
+
+			// Rows of the 3x3 part, with the translation in the W component
+			float32x4 row0 = load_u<float32x4>(data + 0);
+			float32x4 row1 = load_u<float32x4>(data + 4);
+			float32x4 row2 = load_u<float32x4>(data + 8);
+
+			// Columns of the inverse 3x3 part are the cross products of the rows, divided by the determinant. W
+			// components cancel out and end up being zero.
+			const auto cross = [](const float32x4& a, const float32x4& b)
+			{
+				float32x4 ayzx = permute4<1, 2, 0, 3>(a);
+				float32x4 azxy = permute4<2, 0, 1, 3>(a);
+				float32x4 byzx = permute4<1, 2, 0, 3>(b);
+				float32x4 bzxy = permute4<2, 0, 1, 3>(b);
+
+				return float32x4(sub(mul(ayzx, bzxy), mul(azxy, byzx)));
+			};
+
+			float32x4 col0 = cross(row1, row2);
+			float32x4 col1 = cross(row2, row0);
+			float32x4 col2 = cross(row0, row1);
+
+			const float det = reduce_add(mul(row0, col0));
+			const float32x4 invDet = splat<float32x4>(1.0f / det);
+			col0 = mul(col0, invDet);
+			col1 = mul(col1, invDet);
+			col2 = mul(col2, invDet);
+
+			// Translation of the inverse is the inverse 3x3 part applied to the negated translation
+			float32x4 translation = mul(col0, permute4<3, 3, 3, 3>(row0));
+			translation = add(translation, mul(col1, permute4<3, 3, 3, 3>(row1)));
+			translation = add(translation, mul(col2, permute4<3, 3, 3, 3>(row2)));
+			translation = neg(translation);
+
+			transpose4(col0, col1, col2, translation);
+
+			float* outputData = &output[0].x;
+			store_u(outputData + 0, col0);
+			store_u(outputData + 4, col1);
+			store_u(outputData + 8, col2);
+
+			float32x4 lastRow = make_float(0.0f, 0.0f, 0.0f, 1.0f);
+			store_u(outputData + 12, lastRow);
+		}
+
+		/** 
+		 * Transforms an axis aligned box by an affine matrix and returns the axis aligned box enclosing the result.
+		 * Equivalent to bs::AABox::transformAffine().
+		 */
+		inline bs::AABox transformAffine(const bs::AABox& box, const bs::Matrix4& m)
+		{
+			float32x4 col0 = load_u<float32x4>(&m[0]);
+			float32x4 col1 = load_u<float32x4>(&m[1]);
+			float32x4 col2 = load_u<float32x4>(&m[2]);
+			float32x4 col3 = load_u<float32x4>(&m[3]);
+			transpose4(col0, col1, col2, col3);
+
+			const bs::Vector3& boxMin = box.getMin();
+			const bs::Vector3& boxMax = box.getMax();
+
+			float32x4 min = col3;
+			float32x4 max = col3;
+
+			const float32x4 cols[3] = { col0, col1, col2 };
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				float32x4 e = mul(cols[i], splat<float32x4>(boxMin[i]));
+				float32x4 f = mul(cols[i], splat<float32x4>(boxMax[i]));
+
+				min = add(min, simdpp::min(e, f));
+				max = add(max, simdpp::max(e, f));
+			}
+
+			SIMDPP_ALIGN(16) float minData[4];
+			SIMDPP_ALIGN(16) float maxData[4];
+			store(minData, min);
+			store(maxData, max);
+
+			return bs::AABox(
+				bs::Vector3(minData[0], minData[1], minData[2]),
+				bs::Vector3(maxData[0], maxData[1], maxData[2]));
+		}
+
+		/** 
+		 * Transforms a sphere by an affine matrix, scaling the radius by the largest scale of the matrix. Equivalent
+		 * to bs::Sphere::transform().
+		 */
+		inline Sphere transform(const Sphere& sphere, const bs::Matrix4& m)
+		{
+			float32x4 row0 = load_u<float32x4>(&m[0]);
+			float32x4 row1 = load_u<float32x4>(&m[1]);
+			float32x4 row2 = load_u<float32x4>(&m[2]);
+
+			// Squared lengths of the three basis vectors (columns), in XYZ
+			float32x4 lengthSqrd = add(add(mul(row0, row0), mul(row1, row1)), mul(row2, row2));
+			lengthSqrd = max(lengthSqrd, permute4<1, 2, 0, 3>(lengthSqrd));
+			lengthSqrd = max(lengthSqrd, permute4<2, 0, 1, 3>(lengthSqrd));
+
+			float32x4 col0 = row0;
+			float32x4 col1 = row1;
+			float32x4 col2 = row2;
+			float32x4 col3 = load_u<float32x4>(&m[3]);
+			transpose4(col0, col1, col2, col3);
+
+			const bs::Vector3& center = sphere.getCenter();
+			float32x4 output = mul(col0, splat<float32x4>(center.x));
+			output = add(output, mul(col1, splat<float32x4>(center.y)));
+			output = add(output, mul(col2, splat<float32x4>(center.z)));
+			output = add(output, col3);
+
+			SIMDPP_ALIGN(16) float centerData[4];
+			store(centerData, output);
+
+			const float radius = sphere.getRadius() * std::sqrt(extract<0>(lengthSqrd));
+			return Sphere(bs::Vector3(centerData[0], centerData[1], centerData[2]), radius);
+		}
+
+		/** 
+		 * Transforms @p count bounds by their respective affine matrices (@p input[i] by @p transforms[i]) and writes
+		 * the results in @p output. Output is allowed to be the same array as the input.
+		 */
+		inline void transformAffine(const Bounds* input, const bs::Matrix4* transforms, Bounds* output, UINT32 count)
+		{
+			for(UINT32 i = 0; i < count; i++)
+			{
+				const bs::AABox box = transformAffine(input[i].getBox(), transforms[i]);
+				const Sphere sphere = transform(input[i].getSphere(), transforms[i]);
+
+				output[i].setBounds(box, sphere);
+			}
+		}
+
+		/** 
+		 * Normalizes four quaternions, and builds four matrices from them and the provided translations and scales,
+		 * equivalent to calling bs::Matrix4::TRS() for each entry. Rotations are normalized in-place.
+		 */
+		inline void normalizeAndComposeTRS4(const bs::Vector3* translations, bs::Quaternion* rotations, 
+			const bs::Vector3* scales, bs::Matrix4* output)
+		{
+			// Convert quaternions to SoA layout
+			float32x4 qx = load_u<float32x4>(&rotations[0]);
+			float32x4 qy = load_u<float32x4>(&rotations[1]);
+			float32x4 qz = load_u<float32x4>(&rotations[2]);
+			float32x4 qw = load_u<float32x4>(&rotations[3]);
+			transpose4(qx, qy, qz, qw);
+
+			// Normalize
+			float32x4 lengthSqrd = add(add(mul(qx, qx), mul(qy, qy)), add(mul(qz, qz), mul(qw, qw)));
+			float32x4 invLength = div(splat<float32x4>(1.0f), sqrt(lengthSqrd));
+
+			qx = mul(qx, invLength);
+			qy = mul(qy, invLength);
+			qz = mul(qz, invLength);
+			qw = mul(qw, invLength);
+
+			// Write back the normalized rotations
+			{
+				float32x4 r0 = qx, r1 = qy, r2 = qz, r3 = qw;
+				transpose4(r0, r1, r2, r3);
+
+				store_u(&rotations[0], r0);
+				store_u(&rotations[1], r1);
+				store_u(&rotations[2], r2);
+				store_u(&rotations[3], r3);
+			}
+
+			// Build rotation matrices (see bs::Quaternion::toRotationMatrix)
+			float32x4 tx = add(qx, qx);
+			float32x4 ty = add(qy, qy);
+			float32x4 tz = add(qz, qz);
+			float32x4 twx = mul(tx, qw);
+			float32x4 twy = mul(ty, qw);
+			float32x4 twz = mul(tz, qw);
+			float32x4 txx = mul(tx, qx);
+			float32x4 txy = mul(ty, qx);
+			float32x4 txz = mul(tz, qx);
+			float32x4 tyy = mul(ty, qy);
+			float32x4 tyz = mul(tz, qy);
+			float32x4 tzz = mul(tz, qz);
+
+			float32x4 one = splat<float32x4>(1.0f);
+			float32x4 r00 = sub(one, add(tyy, tzz));
+			float32x4 r01 = sub(txy, twz);
+			float32x4 r02 = add(txz, twy);
+			float32x4 r10 = add(txy, twz);
+			float32x4 r11 = sub(one, add(txx, tzz));
+			float32x4 r12 = sub(tyz, twx);
+			float32x4 r20 = sub(txz, twy);
+			float32x4 r21 = add(tyz, twx);
+			float32x4 r22 = sub(one, add(txx, tyy));
+
+			// Apply scale
+			float32x4 sx = make_float(scales[0].x, scales[1].x, scales[2].x, scales[3].x);
+			float32x4 sy = make_float(scales[0].y, scales[1].y, scales[2].y, scales[3].y);
+			float32x4 sz = make_float(scales[0].z, scales[1].z, scales[2].z, scales[3].z);
+
+			float32x4 rows[3][4] =
+			{
+				{ mul(r00, sx), mul(r01, sy), mul(r02, sz), 
+					make_float(translations[0].x, translations[1].x, translations[2].x, translations[3].x) },
+				{ mul(r10, sx), mul(r11, sy), mul(r12, sz), 
+					make_float(translations[0].y, translations[1].y, translations[2].y, translations[3].y) },
+				{ mul(r20, sx), mul(r21, sy), mul(r22, sz), 
+					make_float(translations[0].z, translations[1].z, translations[2].z, translations[3].z) }
+			};
+
+			// Convert back to AoS layout, one matrix per entry
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				transpose4(rows[i][0], rows[i][1], rows[i][2], rows[i][3]);
+
+				for(UINT32 j = 0; j < 4; j++)
+					store_u(&output[j][i].x, rows[i][j]);
+			}
+
+			float32x4 lastRow = make_float(0.0f, 0.0f, 0.0f, 1.0f);
+			for(UINT32 j = 0; j < 4; j++)
+				store_u(&output[j][3].x, lastRow);
+		}
+
 		/** @} */
 	}
 }
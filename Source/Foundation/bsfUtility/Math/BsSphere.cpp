@@ -5,6 +5,7 @@
 #include "Math/BsPlane.h"
 #include "Math/BsAABox.h"
 #include "Math/BsMath.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -27,17 +28,7 @@ namespace bs
 
 	void Sphere::transform(const Matrix4& matrix)
 	{
-		float lengthSqrd[3];
-		for(UINT32 i = 0; i < 3; i++)
-		{
-			Vector3 column = matrix.getColumn(i);
-			lengthSqrd[i] = column.dot(column);
-		}
-
-		float maxLengthSqrd = std::max(lengthSqrd[0], std::max(lengthSqrd[1], lengthSqrd[2]));
-
-		mCenter = matrix.multiplyAffine(mCenter);
-		mRadius *= sqrt(maxLengthSqrd);
+		*this = simd::transform(*this, matrix);
 	}
 
 	bool Sphere::contains(const Vector3& v) const
@@ -68,8 +68,10 @@ namespace bs
 	class DataStream;
 	class MemoryDataStream;
 	class FileDataStream;
+	class MappedFileDataStream;
 	class MeshData;
 	class FileSystem;
+	class MemoryMappedFile;
 	class Timer;
 	class Task;
 	class GpuResourceData;
@@ -46,6 +46,7 @@ namespace bs
 
 		enum { id = 0 /**< Unique id for the serializable type. */ };
 		enum { hasDynamicSize = 0 /**< 0 (Object has static size less than 255 bytes, for example int) or 1 (Dynamic size with no size restriction, for example string) */ };
+		enum { isMemcpy = 1 /**< 1 if the serialized form of the type is identical to its in-memory form. See RTTIPlainTypeIsMemcpy. */ };
 
 		/** Serializes the provided object into the provided pre-allocated memory buffer. */
 		static void toMemory(const T& data, char* memory)
@@ -153,6 +154,48 @@ namespace bs
 		return memory + elemSize;
 	}
 
+	/**
+	 * Checks is the serialized form of a plain type identical to its in-memory form, meaning arrays of such type can be
+	 * serialized using a single memcpy. True for types using the default RTTIPlainType implementation or 
+	 * BS_ALLOW_MEMCPY_SERIALIZATION. Custom RTTIPlainType specializations can opt in by defining an @p isMemcpy enum
+	 * with value 1, as long as they have a static size and their toMemory/fromMemory just copy sizeof(T) bytes.
+	 */
+	template <class T>
+	struct RTTIPlainTypeIsMemcpy
+	{
+		template <typename C>
+		static std::integral_constant<bool, C::isMemcpy != 0 && C::hasDynamicSize == 0> test(int);
+
+		template <typename>
+		static std::false_type test(...);
+
+		static const bool value = decltype(test<RTTIPlainType<T>>(0))::value;
+	};
+
+	/** 
+	 * Returns a pointer to the contiguous elements of the container, if they can be serialized using a single memcpy
+	 * (see RTTIPlainTypeIsMemcpy). Returns null otherwise.
+	 */
+	template <class T>
+	typename T::value_type* rttiGetArrayData(T& container)
+	{
+		return nullptr;
+	}
+
+	/** @copydoc rttiGetArrayData */
+	template <class T, class A>
+	T* rttiGetArrayData(std::vector<T, A>& container)
+	{
+		return RTTIPlainTypeIsMemcpy<T>::value ? container.data() : nullptr;
+	}
+
+	/** @copydoc rttiGetArrayData */
+	template <class A>
+	bool* rttiGetArrayData(std::vector<bool, A>& container)
+	{
+		return nullptr;
+	}
+
 	/** Helper for checking for existance of rttiEnumFields method on a class. */
 	template <class T>  
 	struct has_rttiEnumFields
@@ -180,7 +223,7 @@ namespace bs
 	static_assert (std::is_trivially_copyable<type>()==true,			\
 						#type " is not trivially copyable");			\
 	template<> struct RTTIPlainType<type>								\
-	{	enum { id=0 }; enum { hasDynamicSize = 0 };						\
+	{	enum { id=0 }; enum { hasDynamicSize = 0 }; enum { isMemcpy = 1 };	\
 		static void toMemory(const type& data, char* memory)			\
 		{ memcpy(memory, &data, sizeof(type)); }						\
 		static UINT32 fromMemory(type& data, char* memory)				\
@@ -212,13 +255,24 @@ namespace bs
 			memory += sizeof(UINT32);
 			size += sizeof(UINT32);
 
-			for(const auto& item : data)
+			const T* elements = rttiGetArrayData(const_cast<std::vector<T, StdAlloc<T>>&>(data));
+			if(elements != nullptr)
 			{
-				UINT32 elementSize = rttiGetElemSize(item);
-				RTTIPlainType<T>::toMemory(item, memory);
+				if(numElements > 0)
+					memcpy(memory, elements, numElements * sizeof(T));
 
-				memory += elementSize;
-				size += elementSize;
+				size += numElements * sizeof(T);
+			}
+			else
+			{
+				for(const auto& item : data)
+				{
+					UINT32 elementSize = rttiGetElemSize(item);
+					RTTIPlainType<T>::toMemory(item, memory);
+
+					memory += elementSize;
+					size += elementSize;
+				}
 			}
 
 			memcpy(memoryStart, &size, sizeof(UINT32));
@@ -236,6 +290,23 @@ namespace bs
 			memory += sizeof(UINT32);
 
 			data.clear();
+
+			if(RTTIPlainTypeIsMemcpy<T>::value)
+			{
+				data.resize(numElements);
+
+				T* elements = rttiGetArrayData(data);
+				if(elements != nullptr)
+				{
+					if(numElements > 0)
+						memcpy(elements, memory, numElements * sizeof(T));
+
+					return size;
+				}
+
+				data.clear();
+			}
+
 			for(UINT32 i = 0; i < numElements; i++)
 			{
 				T element;
@@ -253,8 +324,13 @@ namespace bs
 		{
 			UINT64 dataSize = sizeof(UINT32) * 2;
 
-			for(const auto& item : data)
-				dataSize += rttiGetElemSize(item);
+			if(RTTIPlainTypeIsMemcpy<T>::value)
+				dataSize += data.size() * sizeof(T);
+			else
+			{
+				for(const auto& item : data)
+					dataSize += rttiGetElemSize(item);
+			}
 
 			assert(dataSize <= std::numeric_limits<UINT32>::max());
 
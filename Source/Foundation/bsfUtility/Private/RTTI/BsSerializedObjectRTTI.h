@@ -37,17 +37,17 @@ namespace bs
 	class BS_UTILITY_EXPORT SerializedFieldRTTI : public RTTIType <SerializedField, SerializedInstance, SerializedFieldRTTI>
 	{
 	private:
-		SPtr<DataStream> getData(SerializedField* obj, UINT32& size)
+		SPtr<DataStream> getData(SerializedField* obj, UINT64& size)
 		{
 			size = obj->size;
 
 			return bs_shared_ptr_new<MemoryDataStream>(obj->value, obj->size, false);
 		}
 
-		void setData(SerializedField* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setData(SerializedField* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
 			obj->value = (UINT8*)bs_alloc(size);
-			obj->size = size;
+			obj->size = (UINT32)size;
 			obj->ownsMemory = true;
 
 			value->read(obj->value, size);
@@ -79,7 +79,7 @@ namespace bs
 	class BS_UTILITY_EXPORT SerializedDataBlockRTTI : public RTTIType <SerializedDataBlock, SerializedInstance, SerializedDataBlockRTTI>
 	{
 	private:
-		SPtr<DataStream> getData(SerializedDataBlock* obj, UINT32& size)
+		SPtr<DataStream> getData(SerializedDataBlock* obj, UINT64& size)
 		{
 			size = obj->size;
 			obj->stream->seek(obj->offset);
@@ -87,14 +87,14 @@ namespace bs
 			return obj->stream;
 		}
 
-		void setData(SerializedDataBlock* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setData(SerializedDataBlock* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
 			UINT8* data = (UINT8*)bs_alloc(size);
 			SPtr<MemoryDataStream> memStream = bs_shared_ptr_new<MemoryDataStream>(data, size);
 			value->read(data, size);
 
 			obj->stream = memStream;
-			obj->size = size;
+			obj->size = (UINT32)size;
 			obj->offset = 0;
 		}
 	public:
@@ -5,6 +5,8 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "FileSystem/BsAsyncFileIO.h"
 
 #include <algorithm>
 #include <fstream>
@@ -84,6 +86,11 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testMemoryMappedFile);
+		BS_ADD_TEST(FileSystemTestSuite::testMemoryMappedFile_empty);
+		BS_ADD_TEST(FileSystemTestSuite::testMappedFileDataStream);
+		BS_ADD_TEST(FileSystemTestSuite::testFileScheduler);
+		BS_ADD_TEST(FileSystemTestSuite::testAsyncFileIO);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +306,135 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testMemoryMappedFile()
+	{
+		Path path = mTestDirectory + "mapped-file-test-1";
+		createFile(path, "0123456789");
+
+		{
+			SPtr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+			BS_TEST_ASSERT(file != nullptr);
+			BS_TEST_ASSERT(file->getSize() == 10);
+			BS_TEST_ASSERT(memcmp(file->getData(), "0123456789", 10) == 0);
+		}
+
+		FileSystem::remove(path);
+		BS_TEST_ASSERT(MemoryMappedFile::open(path) == nullptr);
+	}
+
+	void FileSystemTestSuite::testMemoryMappedFile_empty()
+	{
+		Path path = mTestDirectory + "mapped-file-test-2";
+		createEmptyFile(path);
+
+		{
+			SPtr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+			BS_TEST_ASSERT(file != nullptr);
+			BS_TEST_ASSERT(file->getSize() == 0);
+		}
+
+		FileSystem::remove(path);
+	}
+
+	void FileSystemTestSuite::testMappedFileDataStream()
+	{
+		Path path = mTestDirectory + "mapped-file-test-3";
+		createFile(path, "0123456789");
+
+		{
+			SPtr<MemoryMappedFile> file = MemoryMappedFile::open(path);
+			BS_TEST_ASSERT(file != nullptr);
+
+			MappedFileDataStream stream(file, 2, 6);
+			BS_TEST_ASSERT(stream.isMapped());
+			BS_TEST_ASSERT(!stream.isWriteable());
+			BS_TEST_ASSERT(stream.size() == 6);
+
+			char buffer[4];
+			BS_TEST_ASSERT(stream.read(buffer, 2) == 2);
+			BS_TEST_ASSERT(memcmp(buffer, "23", 2) == 0);
+
+			// View starts at the current read position and references the same memory
+			SPtr<MappedFileDataStream> view = stream.createView(3);
+			BS_TEST_ASSERT(view->size() == 3);
+			BS_TEST_ASSERT(view->getPtr() == file->getData() + 4);
+			BS_TEST_ASSERT(stream.tell() == 2);
+
+			// View keeps the mapping alive after the source stream and file are released
+			file = nullptr;
+			stream.close();
+
+			BS_TEST_ASSERT(view->read(buffer, 4) == 3);
+			BS_TEST_ASSERT(memcmp(buffer, "456", 3) == 0);
+		}
+
+		FileSystem::remove(path);
+	}
+
+	void FileSystemTestSuite::testFileScheduler()
+	{
+		// File doesn't need to exist, the device is determined from its closest existing parent directory
+		Path path = mTestDirectory + "scheduler-test/file";
+		const UINT32 originalQueueDepth = FileScheduler::getQueueDepth(path);
+		BS_TEST_ASSERT(originalQueueDepth >= 1);
+		BS_TEST_ASSERT(FileScheduler::getQueueDepth(mTestDirectory) == originalQueueDepth);
+
+		FileScheduler::setQueueDepth(path, 2);
+		BS_TEST_ASSERT(FileScheduler::getQueueDepth(path) == 2);
+
+		// Two files can be accessed at once on the same device
+		FileLock lockA = FileScheduler::getLock(path);
+		FileLock lockB = FileScheduler::getLock(mTestDirectory);
+		BS_TEST_ASSERT(lockA.owns_lock());
+		BS_TEST_ASSERT(lockB.owns_lock());
+
+		FileLock movedLock = std::move(lockA);
+		BS_TEST_ASSERT(!lockA.owns_lock());
+		BS_TEST_ASSERT(movedLock.owns_lock());
+
+		movedLock.unlock();
+		lockB.unlock();
+		BS_TEST_ASSERT(!movedLock.owns_lock());
+
+		FileScheduler::setQueueDepth(path, originalQueueDepth);
+	}
+
+	void FileSystemTestSuite::testAsyncFileIO()
+	{
+		const bool startUp = !AsyncFileIO::isStarted();
+		if (startUp)
+			AsyncFileIO::startUp();
+
+		Path path = mTestDirectory + "async-file-test";
+		createFile(path, "0123456789");
+
+		SPtr<AsyncFile> file = AsyncFile::open(path);
+		BS_TEST_ASSERT(file != nullptr);
+		BS_TEST_ASSERT(file->getSize() == 10);
+
+		char data[16] = {};
+		bool callbackTriggered = false;
+		AsyncOp op = AsyncFileIO::instance().read(file, 2, 4, data,
+			[&callbackTriggered](const AsyncReadResult& result) { callbackTriggered = true; });
+
+		op.blockUntilComplete();
+		AsyncReadResult result = op.getReturnValue<AsyncReadResult>();
+		BS_TEST_ASSERT(callbackTriggered);
+		BS_TEST_ASSERT(result.success && result.numBytes == 4);
+		BS_TEST_ASSERT(memcmp(data, "2345", 4) == 0);
+
+		// Reads past the end of the file are truncated
+		op = AsyncFileIO::instance().read(file, 8, 8, data);
+		op.blockUntilComplete();
+		result = op.getReturnValue<AsyncReadResult>();
+		BS_TEST_ASSERT(result.success && result.numBytes == 2);
+		BS_TEST_ASSERT(memcmp(data, "89", 2) == 0);
+
+		file = nullptr;
+		FileSystem::remove(path);
+
+		if (startUp)
+			AsyncFileIO::shutDown();
+	}
 }
@@ -35,6 +35,11 @@ namespace bs
 		void testGetChildren();
 		void testGetLastModifiedTime();
 		void testGetTempDirectoryPath();
+		void testMemoryMappedFile();
+		void testMemoryMappedFile_empty();
+		void testMappedFileDataStream();
+		void testFileScheduler();
+		void testAsyncFileIO();
 
 		Path mTestDirectory;
 	};
@@ -0,0 +1,406 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsTestSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+#include "Testing/BsBenchmarkOutput.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsQuaternion.h"
+#include "Utility/BsOctree.h"
+#include "Allocators/BsFrameAlloc.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
+
+#include <iostream>
+
+using namespace bs;
+
+namespace bs
+{
+	struct BenchmarkOctreeData
+	{
+		Vector<AABox> bounds;
+	};
+
+	struct BenchmarkOctreeOptions
+	{
+		enum { LoosePadding = 16 };
+		enum { MinElementsPerNode = 8 };
+		enum { MaxElementsPerNode = 16 };
+		enum { MaxDepth = 12};
+
+		static simd::AABox getBounds(UINT32 elem, void* context)
+		{
+			BenchmarkOctreeData* octreeData = (BenchmarkOctreeData*)context;
+			return simd::AABox(octreeData->bounds[elem]);
+		}
+
+		static void setElementId(UINT32 elem, const OctreeElementId& id, void* context) { }
+	};
+
+	typedef Octree<UINT32, BenchmarkOctreeOptions> BenchmarkOctree;
+
+	/**
+	 * Benchmarks of commonly used utility functionality. Each benchmark is a single iteration that repeats the measured
+	 * operation the number of times it was registered with, so that very fast operations can be timed reliably.
+	 */
+	class UtilityBenchmarkSuite : public TestSuite
+	{
+	public:
+		UtilityBenchmarkSuite();
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void benchmarkMatrixMultiply();
+		void benchmarkMatrixInverse();
+		void benchmarkQuaternionRotate();
+		void benchmarkQuaternionSlerp();
+		void benchmarkOctreeQuery();
+		void benchmarkFrameAlloc();
+		void benchmarkSerializedSize();
+		void benchmarkPlainArraySerialization();
+		void benchmarkCompress();
+		void benchmarkDecompress();
+		void benchmarkStringSplit();
+		void benchmarkStringReplace();
+		void benchmarkPathParse();
+
+		static constexpr UINT32 NUM_MATH_OPS = 1000;
+		static constexpr UINT32 NUM_OCTREE_ELEMENTS = 10000;
+		static constexpr UINT32 NUM_OCTREE_QUERIES = 100;
+		static constexpr UINT32 NUM_ALLOCS = 1000;
+		static constexpr UINT32 NUM_SIZES = 1000;
+		static constexpr UINT32 COMPRESSION_DATA_SIZE = 1024 * 1024;
+		static constexpr UINT32 NUM_STRING_OPS = 100;
+
+		Vector<Matrix4> mMatrices;
+		Vector<Quaternion> mQuaternions;
+		Vector<Vector3> mVectors;
+
+		BenchmarkOctreeData mOctreeData;
+		BenchmarkOctree* mOctree = nullptr;
+		Vector<AABox> mOctreeQueries;
+
+		FrameAlloc mFrameAlloc;
+
+		Vector<UINT64> mSizes;
+		Vector<UINT8> mSizeBuffer;
+		Vector<UINT32> mPlainArray;
+		Vector<char> mPlainArrayBuffer;
+
+		SPtr<MemoryDataStream> mUncompressed;
+		SPtr<MemoryDataStream> mCompressed;
+
+		String mString;
+		String mPath;
+	};
+
+	UtilityBenchmarkSuite::UtilityBenchmarkSuite()
+	{
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkMatrixMultiply, NUM_MATH_OPS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkMatrixInverse, NUM_MATH_OPS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkQuaternionRotate, NUM_MATH_OPS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkQuaternionSlerp, NUM_MATH_OPS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkOctreeQuery, NUM_OCTREE_QUERIES)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkFrameAlloc, NUM_ALLOCS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkSerializedSize, NUM_SIZES)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkPlainArraySerialization, 1)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkCompress, 1)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkDecompress, 1)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkStringSplit, NUM_STRING_OPS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkStringReplace, NUM_STRING_OPS)
+		BS_ADD_BENCHMARK(UtilityBenchmarkSuite::benchmarkPathParse, NUM_STRING_OPS)
+	}
+
+	void UtilityBenchmarkSuite::startUp()
+	{
+		// Fixed seed, so every run measures the same data
+		srand(1234);
+		const auto random = [](float min, float max) { return min + (rand() / (float)RAND_MAX) * (max - min); };
+
+		for(UINT32 i = 0; i < NUM_MATH_OPS; i++)
+		{
+			const Quaternion rotation(Radian(random(0.0f, Math::TWO_PI)), Radian(random(0.0f, Math::TWO_PI)),
+				Radian(random(0.0f, Math::TWO_PI)));
+			const Vector3 position(random(-100.0f, 100.0f), random(-100.0f, 100.0f), random(-100.0f, 100.0f));
+			const Vector3 scale(random(0.5f, 2.0f), random(0.5f, 2.0f), random(0.5f, 2.0f));
+
+			mMatrices.push_back(Matrix4::TRS(position, rotation, scale));
+			mQuaternions.push_back(rotation);
+			mVectors.push_back(position);
+		}
+
+		// Octree
+		mOctree = bs_new<BenchmarkOctree>(Vector3::ZERO, 800.0f, &mOctreeData);
+		for(UINT32 i = 0; i < NUM_OCTREE_ELEMENTS; i++)
+		{
+			const Vector3 position(random(-750.0f, 750.0f), random(-750.0f, 750.0f), random(-750.0f, 750.0f));
+			const Vector3 extents(random(0.1f, 15.0f), random(0.1f, 15.0f), random(0.1f, 15.0f));
+
+			mOctreeData.bounds.push_back(AABox(position - extents, position + extents));
+			mOctree->addElement(i);
+		}
+
+		for(UINT32 i = 0; i < NUM_OCTREE_QUERIES; i++)
+		{
+			const Vector3 position(random(-750.0f, 750.0f), random(-750.0f, 750.0f), random(-750.0f, 750.0f));
+			const Vector3 extents(random(10.0f, 50.0f), random(10.0f, 50.0f), random(10.0f, 50.0f));
+
+			mOctreeQueries.push_back(AABox(position - extents, position + extents));
+		}
+
+		// Serialization
+		for(UINT32 i = 0; i < NUM_SIZES; i++)
+			mSizes.push_back(i % 2 == 0 ? (UINT64)rand() : 0x100000000ULL + (UINT64)rand());
+
+		mSizeBuffer.resize(NUM_SIZES * BinarySerializer::MAX_SIZE_FIELD_SIZE);
+
+		mPlainArray.resize(64 * 1024);
+		for(UINT32 i = 0; i < (UINT32)mPlainArray.size(); i++)
+			mPlainArray[i] = (UINT32)rand();
+
+		mPlainArrayBuffer.resize(rttiGetElemSize(mPlainArray));
+
+		// Compression, using data that is partially compressible
+		mUncompressed = bs_shared_ptr_new<MemoryDataStream>(COMPRESSION_DATA_SIZE);
+		UINT8* uncompressedData = mUncompressed->getPtr();
+		for(UINT32 i = 0; i < COMPRESSION_DATA_SIZE; i++)
+			uncompressedData[i] = (UINT8)((i / 7) % 13 + (rand() % 4));
+
+		mCompressed = Compression::compressBlocks(mUncompressed);
+
+		// Strings
+		for(UINT32 i = 0; i < 64; i++)
+			mString += "word" + toString(i) + (i % 8 == 0 ? "\n" : " ");
+
+		mPath = "C:/Projects/Framework/Data/Textures/Environment/../Shared/Sky_Cubemap.asset";
+	}
+
+	void UtilityBenchmarkSuite::shutDown()
+	{
+		bs_delete(mOctree);
+		mOctree = nullptr;
+
+		mUncompressed = nullptr;
+		mCompressed = nullptr;
+	}
+
+	void UtilityBenchmarkSuite::benchmarkMatrixMultiply()
+	{
+		Matrix4 output = Matrix4::IDENTITY;
+		for(UINT32 i = 0; i < NUM_MATH_OPS; i++)
+			output = output * mMatrices[i];
+
+		doNotOptimize(output);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkMatrixInverse()
+	{
+		for(UINT32 i = 0; i < NUM_MATH_OPS; i++)
+		{
+			Matrix4 output = mMatrices[i].inverse();
+			doNotOptimize(output);
+		}
+	}
+
+	void UtilityBenchmarkSuite::benchmarkQuaternionRotate()
+	{
+		Vector3 output = Vector3::ZERO;
+		for(UINT32 i = 0; i < NUM_MATH_OPS; i++)
+			output += mQuaternions[i].rotate(mVectors[i]);
+
+		doNotOptimize(output);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkQuaternionSlerp()
+	{
+		Quaternion output = Quaternion::IDENTITY;
+		for(UINT32 i = 0; i < NUM_MATH_OPS; i++)
+			output = Quaternion::slerp(0.3f, output, mQuaternions[i]);
+
+		doNotOptimize(output);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkOctreeQuery()
+	{
+		UINT32 numFound = 0;
+		for(auto& entry : mOctreeQueries)
+		{
+			BenchmarkOctree::BoxIntersectIterator iter(*mOctree, entry);
+			while(iter.moveNext())
+				numFound++;
+		}
+
+		doNotOptimize(numFound);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkFrameAlloc()
+	{
+		mFrameAlloc.markFrame();
+
+		for(UINT32 i = 0; i < NUM_ALLOCS; i++)
+		{
+			UINT8* data = mFrameAlloc.alloc(16 + (i % 8) * 16);
+			doNotOptimize(data);
+		}
+
+		mFrameAlloc.clear();
+	}
+
+	void UtilityBenchmarkSuite::benchmarkSerializedSize()
+	{
+		UINT32 offset = 0;
+		for(auto& entry : mSizes)
+			offset += BinarySerializer::encodeSize(entry, mSizeBuffer.data() + offset);
+
+		MemoryDataStream stream(mSizeBuffer.data(), offset, false);
+
+		UINT64 sum = 0;
+		for(UINT32 i = 0; i < NUM_SIZES; i++)
+		{
+			UINT64 size = 0;
+			BinarySerializer::decodeSize(stream, size);
+			sum += size;
+		}
+
+		doNotOptimize(sum);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkPlainArraySerialization()
+	{
+		rttiWriteElem(mPlainArray, mPlainArrayBuffer.data());
+
+		Vector<UINT32> output;
+		rttiReadElem(output, mPlainArrayBuffer.data());
+		doNotOptimize(output.data());
+	}
+
+	void UtilityBenchmarkSuite::benchmarkCompress()
+	{
+		mUncompressed->seek(0);
+
+		SPtr<MemoryDataStream> output = Compression::compressBlocks(mUncompressed);
+		doNotOptimize(output);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkDecompress()
+	{
+		mCompressed->seek(0);
+
+		SPtr<MemoryDataStream> output = Compression::decompressBlocks(mCompressed);
+		doNotOptimize(output);
+	}
+
+	void UtilityBenchmarkSuite::benchmarkStringSplit()
+	{
+		for(UINT32 i = 0; i < NUM_STRING_OPS; i++)
+		{
+			Vector<String> output = StringUtil::split(mString);
+			doNotOptimize(output.data());
+		}
+	}
+
+	void UtilityBenchmarkSuite::benchmarkStringReplace()
+	{
+		for(UINT32 i = 0; i < NUM_STRING_OPS; i++)
+		{
+			String output = StringUtil::replaceAll(mString, "word", "token");
+			doNotOptimize(output);
+		}
+	}
+
+	void UtilityBenchmarkSuite::benchmarkPathParse()
+	{
+		for(UINT32 i = 0; i < NUM_STRING_OPS; i++)
+		{
+			Path path(mPath);
+			String output = path.toString();
+			doNotOptimize(output);
+		}
+	}
+}
+
+/**
+ * Runs the utility benchmarks. Supported arguments:
+ *  - --output <path>: Saves the results as JSON.
+ *  - --baseline <path>: Compares the results against JSON results saved by a previous run, and fails if any benchmark
+ *    is slower than the baseline by more than the tolerance.
+ *  - --tolerance <ratio>: Allowed slowdown compared to the baseline, as a ratio. Defaults to 0.1 (10%).
+ *  - --iterations <count>: Number of timed iterations of each benchmark.
+ *  - --warmup <count>: Number of warmup iterations of each benchmark.
+ *  - --filter <text>: Only runs benchmarks whose name contains the provided text.
+ */
+int main(int argc, char* argv[])
+{
+	BenchmarkOptions options;
+	String outputPath;
+	String baselinePath;
+	double tolerance = 0.1;
+
+	for(int i = 1; i < argc - 1; i++)
+	{
+		const String arg = argv[i];
+		const String value = argv[i + 1];
+
+		if(arg == "--output")
+			outputPath = value;
+		else if(arg == "--baseline")
+			baselinePath = value;
+		else if(arg == "--tolerance")
+			tolerance = parseFloat(value, 0.1f);
+		else if(arg == "--iterations")
+			options.numIterations = parseUINT32(value, options.numIterations);
+		else if(arg == "--warmup")
+			options.numWarmupIterations = parseUINT32(value, options.numWarmupIterations);
+		else if(arg == "--filter")
+			options.filter = value;
+		else
+			continue;
+
+		i++;
+	}
+
+	SPtr<TestSuite> benchmarks = TestSuite::create<UtilityBenchmarkSuite>();
+
+	JSONBenchmarkOutput output;
+	benchmarks->runBenchmarks(output, options);
+
+	ConsoleTestOutput consoleOutput;
+	for(auto& entry : output.getResults())
+		consoleOutput.outputBenchmark(entry);
+
+	if(!outputPath.empty() && !output.save(Path(outputPath)))
+	{
+		std::cout << "Failed to save benchmark results to: " << outputPath << std::endl;
+		return 1;
+	}
+
+	if(!baselinePath.empty())
+	{
+		Vector<BenchmarkComparison> comparisons;
+		if(!output.compare(Path(baselinePath), comparisons))
+		{
+			std::cout << "Failed to read benchmark baseline from: " << baselinePath << std::endl;
+			return 1;
+		}
+
+		bool regressed = false;
+		for(auto& entry : comparisons)
+		{
+			const bool slower = entry.ratio > 1.0 + tolerance;
+			regressed |= slower;
+
+			char line[256];
+			snprintf(line, sizeof(line), "%-40s baseline %12.2f ns  current %12.2f ns  %+7.1f%%%s", entry.name.c_str(),
+				entry.baselineNs, entry.currentNs, (entry.ratio - 1.0) * 100.0, slower ? "  REGRESSION" : "");
+
+			std::cout << line << std::endl;
+		}
+
+		if(regressed)
+			return 1;
+	}
+
+	return 0;
+}
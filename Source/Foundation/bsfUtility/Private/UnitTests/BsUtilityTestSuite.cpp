@@ -3,10 +3,24 @@
 #include "Private/UnitTests/BsUtilityTestSuite.h"
 #include "Private/UnitTests/BsFileSystemTestSuite.h"
 #include "Utility/BsOctree.h"
+#include "Utility/BsBVH.h"
+#include "Image/BsTextureAtlasLayout.h"
+#include "Utility/BsBitwise.h"
 #include "Utility/BsBitfield.h"
 #include "Utility/BsDynArray.h"
 #include "Math/BsComplex.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsSphere.h"
+#include "Math/BsMatrix4.h"
 #include "Utility/BsMinHeap.h"
+#include "Utility/BsRadixSort.h"
+#include "Allocators/BsFrameArena.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
+#include "Debug/BsDebug.h"
+#include "String/BsStringID.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -60,6 +74,21 @@ namespace bs
 		BS_ADD_TEST(UtilityTestSuite::testDynArray)
 		BS_ADD_TEST(UtilityTestSuite::testComplex)
 		BS_ADD_TEST(UtilityTestSuite::testMinHeap)
+		BS_ADD_TEST(UtilityTestSuite::testRadixSort)
+		BS_ADD_TEST(UtilityTestSuite::testFrameArena)
+		BS_ADD_TEST(UtilityTestSuite::testSerializedSize)
+		BS_ADD_TEST(UtilityTestSuite::testBlockCompression)
+		BS_ADD_TEST(UtilityTestSuite::testPlainArraySerialization)
+		BS_ADD_TEST(UtilityTestSuite::testStreamHash)
+		BS_ADD_TEST(UtilityTestSuite::testLogFiltering)
+		BS_ADD_TEST(UtilityTestSuite::testEvent)
+		BS_ADD_TEST(UtilityTestSuite::testStringID)
+		BS_ADD_TEST(UtilityTestSuite::testPath)
+		BS_ADD_TEST(UtilityTestSuite::testBVH)
+		BS_ADD_TEST(UtilityTestSuite::testTextureAtlasLayout)
+		BS_ADD_TEST(UtilityTestSuite::testConvexVolumeCuller)
+		BS_ADD_TEST(UtilityTestSuite::testUUID)
+		BS_ADD_TEST(UtilityTestSuite::testTaskCancel)
 	}
 
 	void UtilityTestSuite::testBitfield()
@@ -135,6 +164,21 @@ namespace bs
 		// Find
 		BS_TEST_ASSERT(bitfield.find(true) == 0);
 		BS_TEST_ASSERT(bitfield.find(false) == 5);
+
+		// Resize
+		bitfield.resize(20);
+		BS_TEST_ASSERT(bitfield.size() == 20);
+		BS_TEST_ASSERT(bitfield[5] == false);
+		BS_TEST_ASSERT(bitfield[19] == true);
+
+		bitfield.resize(curCount + EXTRA_COUNT, true);
+		BS_TEST_ASSERT(bitfield.size() == curCount + EXTRA_COUNT);
+		for (UINT32 j = 20; j < curCount + EXTRA_COUNT; j++)
+			BS_TEST_ASSERT(bitfield[j] == true);
+
+		// Reset
+		bitfield.reset(false);
+		BS_TEST_ASSERT(bitfield.find(true) == (UINT32)-1);
 	}
 
 	void UtilityTestSuite::testOctree()
@@ -549,4 +593,643 @@ namespace bs
 		m.erase(elements, v);
 		BS_TEST_ASSERT(m.size() == 1);
 	}
+
+	void UtilityTestSuite::testRadixSort()
+	{
+		const float values[] = { 3.5f, -1.0f, 0.0f, 1000.0f, -250.25f, 3.5f, 0.001f, -0.001f };
+		constexpr UINT32 count = sizeof(values) / sizeof(values[0]);
+
+		UINT32 keys[count];
+		UINT32 indices[count];
+		for(UINT32 i = 0; i < count; i++)
+		{
+			keys[i] = RadixSort::floatToKey(values[i]);
+			indices[i] = i;
+		}
+
+		UINT32 scratchKeys[count];
+		UINT32 scratchIndices[count];
+		RadixSort::sort(keys, indices, count, scratchKeys, scratchIndices);
+
+		for(UINT32 i = 1; i < count; i++)
+		{
+			BS_TEST_ASSERT(keys[i - 1] <= keys[i]);
+			BS_TEST_ASSERT(values[indices[i - 1]] <= values[indices[i]]);
+		}
+
+		BS_TEST_ASSERT(values[indices[0]] == -250.25f);
+		BS_TEST_ASSERT(values[indices[count - 1]] == 1000.0f);
+
+		// Sort must be stable
+		BS_TEST_ASSERT(indices[5] == 0 && indices[6] == 5);
+	}
+
+	void UtilityTestSuite::testFrameArena()
+	{
+		// Make sure memory from any earlier frames is released
+		FrameArena::advanceFrame(1);
+		const FrameArenaStats initialStats = FrameArena::getStats();
+
+		UINT8* small = FrameArena::alloc(100);
+		BS_TEST_ASSERT(((UINT64)small & 15) == 0);
+
+		UINT8* aligned = FrameArena::alloc(10, 64);
+		BS_TEST_ASSERT(((UINT64)aligned & 63) == 0);
+		BS_TEST_ASSERT(aligned >= small + 100);
+
+		UINT8* large = FrameArena::alloc(FrameArena::BLOCK_SIZE * 2);
+		memset(large, 0, FrameArena::BLOCK_SIZE * 2);
+
+		UINT32* value = FrameArena::construct<UINT32>(5U);
+		BS_TEST_ASSERT(*value == 5);
+
+		FrameArenaStats stats = FrameArena::getStats();
+		BS_TEST_ASSERT(stats.bytesInUse >= initialStats.bytesInUse + FrameArena::BLOCK_SIZE * 3);
+		BS_TEST_ASSERT(stats.peakBytesInUse >= stats.bytesInUse);
+		const UINT64 usedBytes = stats.bytesInUse;
+
+		// Memory must stay around while the frame is in flight. The thread hands over its blocks on next allocation.
+		FrameArena::advanceFrame(2);
+		FrameArena::alloc(16);
+		BS_TEST_ASSERT(FrameArena::getStats().bytesInUse > usedBytes);
+
+		// Once retired, pooled blocks are kept for reuse while large blocks are freed
+		FrameArena::advanceFrame(2);
+		stats = FrameArena::getStats();
+		BS_TEST_ASSERT(stats.bytesInUse < usedBytes);
+		BS_TEST_ASSERT(stats.bytesReserved >= FrameArena::BLOCK_SIZE);
+		BS_TEST_ASSERT(stats.frameIdx == initialStats.frameIdx + 2);
+	}
+
+	void UtilityTestSuite::testSerializedSize()
+	{
+		const UINT64 sizes[] = { 0, 1234, 0xFFFFFFFE, 0xFFFFFFFF, 0x123456789ULL };
+		const UINT32 expectedFieldSizes[] = { 4, 4, 4, 12, 12 };
+
+		UINT8 buffer[5 * BinarySerializer::MAX_SIZE_FIELD_SIZE];
+		UINT32 offset = 0;
+		for(UINT32 i = 0; i < 5; i++)
+		{
+			const UINT32 fieldSize = BinarySerializer::encodeSize(sizes[i], buffer + offset);
+			BS_TEST_ASSERT(fieldSize == expectedFieldSizes[i]);
+
+			offset += fieldSize;
+		}
+
+		// Sizes below 4 GB must match the original 32-bit encoding
+		UINT32 legacySize = 0;
+		memcpy(&legacySize, buffer + 4, sizeof(legacySize));
+		BS_TEST_ASSERT(legacySize == 1234);
+
+		MemoryDataStream stream(buffer, offset, false);
+		for(UINT32 i = 0; i < 5; i++)
+		{
+			UINT64 size = 0;
+			BS_TEST_ASSERT(BinarySerializer::decodeSize(stream, size));
+			BS_TEST_ASSERT(size == sizes[i]);
+		}
+
+		UINT64 size = 0;
+		BS_TEST_ASSERT(!BinarySerializer::decodeSize(stream, size));
+	}
+
+	void UtilityTestSuite::testBlockCompression()
+	{
+		// Compressible data that doesn't end on a block boundary
+		const UINT32 blockSize = 1024;
+		const UINT32 dataSize = blockSize * 5 + 123;
+
+		SPtr<MemoryDataStream> input = bs_shared_ptr_new<MemoryDataStream>(dataSize);
+		UINT8* inputData = input->getPtr();
+		for(UINT32 i = 0; i < dataSize; i++)
+			inputData[i] = (UINT8)((i / 7) % 13);
+
+		for(auto codec : { CompressionCodec::None, CompressionCodec::Snappy })
+		{
+			input->seek(0);
+			SPtr<DataStream> compressed = Compression::compressBlocks(input, codec, blockSize);
+			BS_TEST_ASSERT(compressed != nullptr);
+
+			UINT64 uncompressedSize = 0;
+			BS_TEST_ASSERT(Compression::getBlockDecompressedSize(compressed, uncompressedSize));
+			BS_TEST_ASSERT(uncompressedSize == dataSize);
+
+			// Range spanning parts of three blocks
+			UINT8 range[blockSize * 2];
+			const UINT32 rangeOffset = blockSize / 2;
+			BS_TEST_ASSERT(Compression::decompressBlockRange(compressed, rangeOffset, sizeof(range), range));
+			BS_TEST_ASSERT(memcmp(range, inputData + rangeOffset, sizeof(range)) == 0);
+
+			// Out of bounds
+			BS_TEST_ASSERT(!Compression::decompressBlockRange(compressed, dataSize - 10, sizeof(range), range));
+
+			SPtr<MemoryDataStream> output = Compression::decompressBlocks(compressed);
+			BS_TEST_ASSERT(output != nullptr);
+			BS_TEST_ASSERT(output->size() == dataSize);
+			BS_TEST_ASSERT(memcmp(output->getPtr(), inputData, dataSize) == 0);
+
+			// Streamed decompression, reading across block boundaries and seeking back
+			compressed->seek(0);
+			SPtr<DataStream> streamed = Compression::decompressBlocksStreamed(compressed);
+			BS_TEST_ASSERT(streamed != nullptr);
+			BS_TEST_ASSERT(streamed->size() == dataSize);
+
+			streamed->seek(rangeOffset);
+			BS_TEST_ASSERT(streamed->read(range, sizeof(range)) == sizeof(range));
+			BS_TEST_ASSERT(memcmp(range, inputData + rangeOffset, sizeof(range)) == 0);
+
+			streamed->seek(0);
+			UINT8* streamedData = (UINT8*)bs_alloc(dataSize);
+			BS_TEST_ASSERT(streamed->read(streamedData, dataSize) == dataSize);
+			BS_TEST_ASSERT(memcmp(streamedData, inputData, dataSize) == 0);
+			BS_TEST_ASSERT(streamed->eof());
+			bs_free(streamedData);
+		}
+	}
+
+	void UtilityTestSuite::testPlainArraySerialization()
+	{
+		static_assert(RTTIPlainTypeIsMemcpy<UINT32>::value, "");
+		static_assert(RTTIPlainTypeIsMemcpy<Vector3>::value, "");
+		static_assert(!RTTIPlainTypeIsMemcpy<String>::value, "");
+
+		// Memcpy path, element-wise path, and bools which aren't stored contiguously by std::vector
+		Vector<UINT32> ints = { 1, 2, 3, 0xFFFFFFFF };
+		Vector<String> strings = { "first", "", "third" };
+		Vector<bool> bools = { true, false, true };
+
+		const UINT32 totalSize = rttiGetElemSize(ints) + rttiGetElemSize(strings) + rttiGetElemSize(bools);
+		BS_TEST_ASSERT(rttiGetElemSize(ints) == sizeof(UINT32) * 2 + sizeof(UINT32) * 4);
+
+		Vector<char> buffer(totalSize);
+		char* memory = buffer.data();
+		memory = rttiWriteElem(ints, memory);
+		memory = rttiWriteElem(strings, memory);
+		memory = rttiWriteElem(bools, memory);
+		BS_TEST_ASSERT(memory == buffer.data() + totalSize);
+
+		Vector<UINT32> readInts = { 5 };
+		Vector<String> readStrings;
+		Vector<bool> readBools;
+
+		memory = buffer.data();
+		memory = rttiReadElem(readInts, memory);
+		memory = rttiReadElem(readStrings, memory);
+		memory = rttiReadElem(readBools, memory);
+
+		BS_TEST_ASSERT(memory == buffer.data() + totalSize);
+		BS_TEST_ASSERT(readInts == ints);
+		BS_TEST_ASSERT(readStrings == strings);
+		BS_TEST_ASSERT(readBools == bools);
+	}
+
+	void UtilityTestSuite::testStreamHash()
+	{
+		// Larger than a single read chunk, to make sure hashing in chunks matches hashing all at once
+		String source;
+		for(UINT32 i = 0; i < 100000; i++)
+			source += (char)('a' + (i % 26));
+
+		MemoryDataStream stream((void*)source.data(), source.size(), false);
+		BS_TEST_ASSERT(md5(stream) == md5(source));
+		BS_TEST_ASSERT(stream.eof());
+
+		BS_TEST_ASSERT(md5(String("abc")) == "900150983cd24fb0d6963f7d28e17f72");
+	}
+
+	void UtilityTestSuite::testLogFiltering()
+	{
+		// Custom channel, so nothing gets written to the console
+		constexpr UINT32 channel = 10;
+
+		auto countUnread = [](Log& log)
+		{
+			UINT32 count = 0;
+			LogEntry entry;
+			while(log.getUnreadEntry(entry))
+				count++;
+
+			return count;
+		};
+
+		Debug debug;
+		debug.setChannelEnabled(channel, false);
+		debug.log("Disabled", channel);
+		BS_TEST_ASSERT(countUnread(debug.getLog()) == 0);
+
+		debug.setChannelEnabled(channel, true);
+		debug.log("Enabled", channel);
+		BS_TEST_ASSERT(countUnread(debug.getLog()) == 1);
+
+		debug.setMaxRepeats(3);
+		for(UINT32 i = 0; i < 10; i++)
+			debug.log("Repeated", channel);
+
+		debug.log("Other", channel);
+		BS_TEST_ASSERT(countUnread(debug.getLog()) == 4);
+
+		Vector<LogEntry> entries = debug.getLog().getEntries();
+		BS_TEST_ASSERT(entries.size() == 5);
+		BS_TEST_ASSERT(entries[1].getMessage() == "Repeated");
+		BS_TEST_ASSERT(entries[4].getMessage() == "Other");
+	}
+
+	void UtilityTestSuite::testEvent()
+	{
+		Event<void(UINT32), false> event;
+
+		UINT32 sum = 0;
+		HEvent first = event.connect([&sum](UINT32 value) { sum += value; });
+		BS_TEST_ASSERT(!event.empty());
+
+		// Disconnecting, and connecting new callbacks, while triggering
+		HEvent second;
+		HEvent third;
+		second = event.connect([&](UINT32 value)
+		{
+			sum += value * 10;
+			second.disconnect();
+
+			third = event.connect([&sum](UINT32 value) { sum += value * 100; });
+		});
+
+		event(1);
+		BS_TEST_ASSERT(sum == 11);
+
+		event(1);
+		BS_TEST_ASSERT(sum == 112);
+
+		// Copied handles keep the connection alive until all of them are released
+		HEvent copy = first;
+		first = HEvent();
+		event(1);
+		BS_TEST_ASSERT(sum == 213);
+
+		copy.disconnect();
+		third.disconnect();
+		BS_TEST_ASSERT(event.empty());
+
+		event(1);
+		BS_TEST_ASSERT(sum == 213);
+
+		// Large callables that don't fit in the delegate's inline storage
+		UINT64 large[16] = { 5 };
+		event.connect([&sum, large](UINT32 value) { sum += (UINT32)large[0] * value; });
+		event(2);
+		BS_TEST_ASSERT(sum == 223);
+
+		event.clear();
+		BS_TEST_ASSERT(event.empty());
+	}
+
+	void UtilityTestSuite::testStringID()
+	{
+		BS_TEST_ASSERT(StringID("TestID") == StringID(String("TestID")));
+		BS_TEST_ASSERT(StringID("TestID") != StringID("TestId"));
+		BS_TEST_ASSERT(BS_SID("TestID") == StringID("TestID"));
+		BS_TEST_ASSERT(StringID("TestIDSuffix", 6) == StringID("TestID"));
+
+		// Enough strings to require the string table to grow
+		for(UINT32 i = 0; i < 5000; i++)
+		{
+			const String name = "TestID" + toString(i);
+
+			StringID id(name);
+			BS_TEST_ASSERT(id == StringID(name));
+			BS_TEST_ASSERT(name == id.c_str());
+		}
+
+		// Long strings
+		const String longName(1000, 'a');
+		BS_TEST_ASSERT(StringID(longName).length() == 1000);
+		BS_TEST_ASSERT(longName == StringID(longName).c_str());
+	}
+
+	void UtilityTestSuite::testPath()
+	{
+		// Parsing and building
+		const Path winPath("C:\\Foo\\..\\Bar\\.\\file.txt", Path::PathType::Windows);
+		BS_TEST_ASSERT(winPath.getDevice() == "C");
+		BS_TEST_ASSERT(winPath.getNumDirectories() == 1);
+		BS_TEST_ASSERT(winPath.toString(Path::PathType::Windows) == "C:\\Bar\\file.txt");
+
+		const Path unixPath("/usr/local/../lib/file.so", Path::PathType::Unix);
+		BS_TEST_ASSERT(unixPath.isAbsolute());
+		BS_TEST_ASSERT(unixPath.toString(Path::PathType::Unix) == "/usr/lib/file.so");
+
+		String output;
+		unixPath.toString(output, Path::PathType::Unix);
+		BS_TEST_ASSERT(output == "/usr/lib/file.so");
+
+		// Comparison and hashing are case insensitive, and must agree with each other
+		const Path pathA("C:/Foo/BAR/file.TXT", Path::PathType::Windows);
+		const Path pathB("c:\\foo\\bar\\FILE.txt", Path::PathType::Windows);
+		const Path pathC("c:/foo/bar/file.txt/", Path::PathType::Windows);
+		BS_TEST_ASSERT(pathA == pathB);
+		BS_TEST_ASSERT(pathA.getHash() == pathB.getHash());
+		BS_TEST_ASSERT(pathA == pathC);
+		BS_TEST_ASSERT(pathA.getHash() == pathC.getHash());
+		BS_TEST_ASSERT(pathA != Path("C:/Foo/Bar/file2.txt", Path::PathType::Windows));
+
+		UnorderedMap<Path, UINT32> map;
+		map[pathA] = 5;
+		BS_TEST_ASSERT(map.find(pathB) != map.end());
+
+		// Moving
+		Path copy = pathA;
+		Path moved(std::move(copy));
+		BS_TEST_ASSERT(moved == pathA);
+
+		moved = Path("a/b.txt", Path::PathType::Unix);
+		moved.setExtension(".png");
+		BS_TEST_ASSERT(moved.toString(Path::PathType::Unix) == "a/b.png");
+	}
+
+	void UtilityTestSuite::testBVH()
+	{
+		static constexpr UINT32 NUM_BOXES = 5000;
+		static constexpr UINT32 NUM_RAYS = 200;
+
+		auto random = [](float min, float max) { return min + (rand() / (float)RAND_MAX) * (max - min); };
+
+		Vector<AABox> boxes(NUM_BOXES);
+		auto generateBoxes = [&boxes, &random]()
+		{
+			for (auto& entry : boxes)
+			{
+				Vector3 position(random(-500.0f, 500.0f), random(-500.0f, 500.0f), random(-500.0f, 500.0f));
+				Vector3 extents(random(0.1f, 10.0f), random(0.1f, 10.0f), random(0.1f, 10.0f));
+
+				entry = AABox(position - extents, position + extents);
+			}
+		};
+
+		generateBoxes();
+
+		BVH bvh;
+		bvh.build(boxes.data(), NUM_BOXES);
+		BS_TEST_ASSERT(bvh.getNumPrimitives() == NUM_BOXES);
+
+		auto testQueries = [&]()
+		{
+			// Closest ray hit must match a brute force search
+			for (UINT32 i = 0; i < NUM_RAYS; i++)
+			{
+				Vector3 origin(random(-600.0f, 600.0f), random(-600.0f, 600.0f), random(-600.0f, 600.0f));
+				Vector3 direction(random(-1.0f, 1.0f), random(-1.0f, 1.0f), random(-1.0f, 1.0f));
+				direction.normalize();
+
+				Ray ray(origin, direction);
+
+				float expectedDistance = std::numeric_limits<float>::max();
+				for (auto& entry : boxes)
+				{
+					auto result = ray.intersects(entry);
+					if (result.first && result.second < expectedDistance)
+						expectedDistance = result.second;
+				}
+
+				float closestDistance = std::numeric_limits<float>::max();
+				bvh.raycast(ray, std::numeric_limits<float>::max(), [&](UINT32 prim, float& maxDistance)
+				{
+					auto result = ray.intersects(boxes[prim]);
+					if (result.first && result.second < maxDistance)
+					{
+						maxDistance = result.second;
+						closestDistance = result.second;
+					}
+
+					return true;
+				});
+
+				BS_TEST_ASSERT(Math::approxEquals(closestDistance, expectedDistance, 0.01f));
+			}
+
+			// Volume query must find every intersecting box exactly once
+			Vector<Plane> planes =
+			{
+				Plane(Vector3::UNIT_X, -100.0f),
+				Plane(-Vector3::UNIT_X, -100.0f),
+				Plane(Vector3::UNIT_Y, -200.0f),
+				Plane(-Vector3::UNIT_Y, -50.0f),
+				Plane(Vector3::normalize(Vector3(1.0f, 0.0f, 1.0f)), -150.0f),
+			};
+
+			ConvexVolume volume(planes);
+
+			Vector<UINT32> found;
+			bvh.query(volume, [&found](UINT32 prim) { found.push_back(prim); });
+
+			UINT32 expectedCount = 0;
+			for (UINT32 i = 0; i < NUM_BOXES; i++)
+			{
+				if (volume.intersects(boxes[i]))
+				{
+					BS_TEST_ASSERT(std::find(found.begin(), found.end(), i) != found.end());
+					expectedCount++;
+				}
+			}
+
+			BS_TEST_ASSERT(found.size() == expectedCount);
+		};
+
+		testQueries();
+
+		// Move the primitives and ensure refit hierarchy still returns correct results
+		generateBoxes();
+		bvh.refit(boxes.data());
+
+		testQueries();
+	}
+
+	void UtilityTestSuite::testTextureAtlasLayout()
+	{
+		static constexpr UINT32 NUM_ELEMENTS = 3000;
+		static constexpr UINT32 MAX_SIZE = 512;
+
+		Vector<Vector2I> sizes(NUM_ELEMENTS);
+		for (auto& entry : sizes)
+			entry = Vector2I(4 + rand() % 40, 4 + rand() % 40);
+
+		// A few empty elements, as for glyphs without a bitmap
+		sizes[10] = Vector2I(0, 0);
+		sizes[20] = Vector2I(0, 15);
+
+		Vector<TextureAtlasUtility::Placement> placements;
+		Vector<TextureAtlasUtility::Page> pages = TextureAtlasUtility::createAtlasLayout(sizes, placements, 64, 64,
+			MAX_SIZE, MAX_SIZE, true);
+
+		BS_TEST_ASSERT(pages.size() > 1);
+		BS_TEST_ASSERT(placements.size() == NUM_ELEMENTS);
+
+		// Every element must be placed within its page, without overlapping any other
+		Vector<Vector<bool>> coverage(pages.size());
+		for (UINT32 i = 0; i < (UINT32)pages.size(); i++)
+		{
+			BS_TEST_ASSERT(pages[i].width <= MAX_SIZE && pages[i].height <= MAX_SIZE);
+			BS_TEST_ASSERT(Bitwise::isPow2(pages[i].width) && Bitwise::isPow2(pages[i].height));
+
+			coverage[i].resize(pages[i].width * pages[i].height, false);
+		}
+
+		bool overlaps = false;
+		for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+		{
+			const TextureAtlasUtility::Placement& placement = placements[i];
+			BS_TEST_ASSERT(placement.page >= 0 && placement.page < (INT32)pages.size());
+
+			const TextureAtlasUtility::Page& page = pages[placement.page];
+			BS_TEST_ASSERT(placement.x + sizes[i].x <= page.width && placement.y + sizes[i].y <= page.height);
+
+			for (UINT32 y = 0; y < (UINT32)sizes[i].y; y++)
+			{
+				for (UINT32 x = 0; x < (UINT32)sizes[i].x; x++)
+				{
+					const UINT32 texelIdx = (placement.y + y) * page.width + placement.x + x;
+
+					overlaps |= coverage[placement.page][texelIdx];
+					coverage[placement.page][texelIdx] = true;
+				}
+			}
+		}
+
+		BS_TEST_ASSERT(!overlaps);
+
+		// Elements too large for the atlas cannot be packed
+		sizes[0] = Vector2I(MAX_SIZE + 1, 1);
+		pages = TextureAtlasUtility::createAtlasLayout(sizes, placements, 64, 64, MAX_SIZE, MAX_SIZE, true);
+		BS_TEST_ASSERT(pages.empty());
+	}
+
+	void UtilityTestSuite::testConvexVolumeCuller()
+	{
+		static constexpr UINT32 NUM_BOUNDS = 1001;
+
+		auto random = [](float min, float max) { return min + (rand() / (float)RAND_MAX) * (max - min); };
+
+		Vector<AABox> boxes(NUM_BOUNDS);
+		Vector<Sphere> spheres(NUM_BOUNDS);
+		for (UINT32 i = 0; i < NUM_BOUNDS; i++)
+		{
+			Vector3 center(random(-100.0f, 100.0f), random(-100.0f, 100.0f), random(-150.0f, 50.0f));
+			Vector3 extents(random(0.1f, 10.0f), random(0.1f, 10.0f), random(0.1f, 10.0f));
+
+			boxes[i] = AABox(center - extents, center + extents);
+			spheres[i] = Sphere(center, random(0.1f, 10.0f));
+		}
+
+		// Frustums with and without the near plane, to test both full and partially filled plane groups
+		const Matrix4 proj = Matrix4::projectionPerspective(Degree(70.0f), 1.5f, 0.5f, 100.0f);
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			const ConvexVolume volume(proj, i == 0);
+			const ConvexVolumeCuller culler(volume);
+
+			Vector<UINT32> boxVisibility(Math::divideAndRoundUp(NUM_BOUNDS, 32U), 0);
+			Vector<UINT32> sphereVisibility(Math::divideAndRoundUp(NUM_BOUNDS, 32U), 0);
+
+			culler.intersects(boxes.data(), NUM_BOUNDS, boxVisibility.data());
+			culler.intersects(spheres.data(), NUM_BOUNDS, sphereVisibility.data());
+
+			for (UINT32 j = 0; j < NUM_BOUNDS; j++)
+			{
+				const bool boxVisible = volume.intersects(boxes[j]);
+				const bool sphereVisible = volume.intersects(spheres[j]);
+
+				BS_TEST_ASSERT(culler.intersects(boxes[j]) == boxVisible);
+				BS_TEST_ASSERT(culler.intersects(spheres[j]) == sphereVisible);
+				BS_TEST_ASSERT(((boxVisibility[j / 32] & (1U << (j % 32))) != 0) == boxVisible);
+				BS_TEST_ASSERT(((sphereVisibility[j / 32] & (1U << (j % 32))) != 0) == sphereVisible);
+			}
+		}
+	}
+
+	void UtilityTestSuite::testUUID()
+	{
+		const UUID uuid(0x0123ABCD, 0x4567EF01, 0x89AB2345, 0xCDEF6789);
+		const String string = uuid.toString();
+
+		BS_TEST_ASSERT(string == "0123abcd-4567-ef01-89ab-2345cdef6789");
+		BS_TEST_ASSERT(UUID(string) == uuid);
+		BS_TEST_ASSERT(UUID("0123ABCD-4567-EF01-89AB-2345CDEF6789") == uuid);
+		BS_TEST_ASSERT(UUID("0123abcd") == UUID::EMPTY);
+
+		UnorderedSet<UUID> generated;
+		for (UINT32 i = 0; i < 1000; i++)
+		{
+			const UUID random = UUIDGenerator::generateRandom();
+			const String randomString = random.toString();
+
+			BS_TEST_ASSERT(UUID(randomString) == random);
+			BS_TEST_ASSERT(randomString[14] == '4');
+			BS_TEST_ASSERT(randomString[19] == '8' || randomString[19] == '9' || randomString[19] == 'a' ||
+				randomString[19] == 'b');
+
+			generated.insert(random);
+		}
+
+		BS_TEST_ASSERT(generated.size() == 1000);
+	}
+
+	void UtilityTestSuite::testTaskCancel()
+	{
+		const bool startModules = !TaskScheduler::isStarted();
+		if(startModules)
+		{
+			if(!ThreadPool::isStarted())
+				ThreadPool::startUp<TThreadPool<>>(4);
+
+			TaskScheduler::startUp();
+		}
+
+		std::atomic<bool> executed{false};
+		const auto worker = [&executed]() { executed = true; };
+
+		// Root is never queued, so it is guaranteed to still be pending when canceled
+		SPtr<Task> root = Task::create("Root", worker);
+		SPtr<Task> dependent = Task::create("Dependent", worker, TaskPriority::Normal, root);
+		SPtr<Task> indirect = Task::create("Indirect", worker, TaskPriority::Normal, dependent);
+		SPtr<TaskGroup> group = TaskGroup::create("Group", [&executed](UINT32) { executed = true; }, 8,
+			TaskPriority::Normal, dependent);
+
+		TaskScheduler::instance().addTask(dependent);
+		TaskScheduler::instance().addTask(indirect);
+		TaskScheduler::instance().addTaskGroup(group);
+
+		root->cancel();
+
+		// Waits must return instead of waiting for dependents that will never execute
+		indirect->wait();
+		indirect->wait(true);
+		group->wait();
+		group->wait(true);
+
+		BS_TEST_ASSERT(dependent->isCanceled());
+		BS_TEST_ASSERT(indirect->isCanceled());
+		BS_TEST_ASSERT(group->isCanceled());
+		BS_TEST_ASSERT(!group->isComplete());
+
+		// Tasks queued after their dependency was canceled are canceled immediately
+		SPtr<Task> late = Task::create("Late", worker, TaskPriority::Normal, indirect);
+		TaskScheduler::instance().addTask(late);
+		late->wait();
+
+		BS_TEST_ASSERT(late->isCanceled());
+		BS_TEST_ASSERT(!executed);
+
+		// Completed tasks can no longer be canceled
+		SPtr<Task> completed = Task::create("Completed", worker);
+		TaskScheduler::instance().addTask(completed);
+		completed->wait();
+		completed->cancel();
+
+		BS_TEST_ASSERT(completed->isComplete());
+		BS_TEST_ASSERT(executed);
+
+		if(startModules)
+		{
+			TaskScheduler::shutDown();
+			ThreadPool::shutDown();
+		}
+	}
 }
@@ -20,5 +20,20 @@ namespace bs
 		void testDynArray();
 		void testComplex();
 		void testMinHeap();
+		void testRadixSort();
+		void testFrameArena();
+		void testSerializedSize();
+		void testBlockCompression();
+		void testPlainArraySerialization();
+		void testStreamHash();
+		void testLogFiltering();
+		void testEvent();
+		void testStringID();
+		void testPath();
+		void testBVH();
+		void testTextureAtlasLayout();
+		void testConvexVolumeCuller();
+		void testUUID();
+		void testTaskCancel();
 	};
 }
@@ -0,0 +1,576 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "FileSystem/BsAsyncFileIO.h"
+#include "Threading/BsThreadPool.h"
+#include "Debug/BsDebug.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <cstring>
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace bs
+{
+	/** Number of threads performing the reads, when the native asynchronous I/O mechanism isn't available. */
+	static constexpr UINT32 NUM_FALLBACK_THREADS = 4;
+
+	struct AsyncFile::Pimpl
+	{
+		int file = -1;
+	};
+
+	AsyncFile::AsyncFile()
+		:m(bs_new<Pimpl>())
+	{ }
+
+	AsyncFile::~AsyncFile()
+	{
+		if (m->file != -1)
+			close(m->file);
+
+		bs_delete(m);
+	}
+
+	SPtr<AsyncFile> AsyncFile::open(const Path& path)
+	{
+		const String pathString = path.toString();
+
+		const int file = ::open(pathString.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file == -1)
+		{
+			LOGERR("Unable to open file for asynchronous reading: " + pathString + ": " + strerror(errno));
+			return nullptr;
+		}
+
+		struct stat st_buf;
+		if (fstat(file, &st_buf) != 0)
+		{
+			LOGERR("Unable to open file for asynchronous reading: " + pathString + ": " + strerror(errno));
+			close(file);
+			return nullptr;
+		}
+
+		SPtr<AsyncFile> output = bs_shared_ptr(new (bs_alloc<AsyncFile>()) AsyncFile());
+		output->m->file = file;
+		output->mPath = path;
+		output->mSize = (UINT64)st_buf.st_size;
+
+		return output;
+	}
+
+	/** Maximum number of bytes to read with a single system call. Larger requests are split into multiple reads. */
+	static constexpr UINT64 MAX_READ_SIZE = 1 << 30;
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+	/**
+	 * Minimal wrapper around an io_uring instance, accessed directly through system calls. Only used for submitting
+	 * reads, and waiting on their completion. Submission must be synchronized externally, while completions must only
+	 * be reaped by a single thread.
+	 */
+	class IOUring
+	{
+	public:
+		/** Information about a completed operation. */
+		struct Completion
+		{
+			UINT64 userData;
+			INT32 result;
+		};
+
+		~IOUring()
+		{
+			if (mSQEs != nullptr)
+				munmap(mSQEs, mSQEsSize);
+
+			if (mCQRing != nullptr && mCQRing != mSQRing)
+				munmap(mCQRing, mCQRingSize);
+
+			if (mSQRing != nullptr)
+				munmap(mSQRing, mSQRingSize);
+
+			if (mRing != -1)
+				close(mRing);
+		}
+
+		/** Creates the ring. Returns false if io_uring isn't supported or permitted on this system. */
+		bool initialize(UINT32 numEntries)
+		{
+			io_uring_params params;
+			memset(&params, 0, sizeof(params));
+
+			mRing = (int)syscall(__NR_io_uring_setup, numEntries, &params);
+			if (mRing < 0)
+				return false;
+
+			mSQRingSize = params.sq_off.array + params.sq_entries * sizeof(UINT32);
+			mCQRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (singleMap)
+				mSQRingSize = mCQRingSize = std::max(mSQRingSize, mCQRingSize);
+
+			mSQRing = map(mSQRingSize, IORING_OFF_SQ_RING);
+			if (mSQRing == nullptr)
+				return false;
+
+			mCQRing = singleMap ? mSQRing : map(mCQRingSize, IORING_OFF_CQ_RING);
+			if (mCQRing == nullptr)
+				return false;
+
+			mSQEsSize = params.sq_entries * sizeof(io_uring_sqe);
+			mSQEs = (io_uring_sqe*)map(mSQEsSize, IORING_OFF_SQES);
+			if (mSQEs == nullptr)
+				return false;
+
+			mSQHead = (UINT32*)(mSQRing + params.sq_off.head);
+			mSQTail = (UINT32*)(mSQRing + params.sq_off.tail);
+			mSQMask = *(UINT32*)(mSQRing + params.sq_off.ring_mask);
+			mSQArray = (UINT32*)(mSQRing + params.sq_off.array);
+			mNumSQEntries = params.sq_entries;
+
+			mCQHead = (UINT32*)(mCQRing + params.cq_off.head);
+			mCQTail = (UINT32*)(mCQRing + params.cq_off.tail);
+			mCQMask = *(UINT32*)(mCQRing + params.cq_off.ring_mask);
+			mCQEs = (io_uring_cqe*)(mCQRing + params.cq_off.cqes);
+			mNumCQEntries = params.cq_entries;
+
+			return true;
+		}
+
+		/** Returns the number of completions the ring can hold. Operations in flight should never exceed it. */
+		UINT32 getNumCompletionEntries() const { return mNumCQEntries; }
+
+		/** Submits a vectored read of a single buffer. @p vec must remain valid until the read completes. */
+		bool submitRead(int file, iovec* vec, UINT64 offset, UINT64 userData)
+		{
+			io_uring_sqe* sqe = acquireSQE();
+			if (sqe == nullptr)
+				return false;
+
+			sqe->opcode = IORING_OP_READV;
+			sqe->fd = file;
+			sqe->addr = (UINT64)(UINT8*)vec;
+			sqe->len = 1;
+			sqe->off = offset;
+			sqe->user_data = userData;
+
+			return submit();
+		}
+
+		/** Submits an operation that does nothing, other than generate a completion with the provided user data. */
+		bool submitNop(UINT64 userData)
+		{
+			io_uring_sqe* sqe = acquireSQE();
+			if (sqe == nullptr)
+				return false;
+
+			sqe->opcode = IORING_OP_NOP;
+			sqe->user_data = userData;
+
+			return submit();
+		}
+
+		/**
+		 * Blocks until at least one operation completes, then outputs all the available completions. Returns false if
+		 * waiting fails.
+		 */
+		bool waitCompletions(Vector<Completion>& completions)
+		{
+			completions.clear();
+
+			while (true)
+			{
+				UINT32 head = *mCQHead;
+				const UINT32 tail = __atomic_load_n(mCQTail, __ATOMIC_ACQUIRE);
+
+				for (; head != tail; head++)
+				{
+					const io_uring_cqe& cqe = mCQEs[head & mCQMask];
+					completions.push_back({ (UINT64)cqe.user_data, (INT32)cqe.res });
+				}
+
+				__atomic_store_n(mCQHead, head, __ATOMIC_RELEASE);
+
+				if (!completions.empty())
+					return true;
+
+				if (syscall(__NR_io_uring_enter, mRing, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+					return false;
+			}
+		}
+
+	private:
+		/** Maps a region of the ring into memory. Returns null on failure. */
+		UINT8* map(size_t size, off_t offset)
+		{
+			void* output = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRing, offset);
+			return output != MAP_FAILED ? (UINT8*)output : nullptr;
+		}
+
+		/** Returns a cleared submission queue entry at the tail of the queue. */
+		io_uring_sqe* acquireSQE()
+		{
+			// Entries are consumed by the kernel during submit(), and failed submissions take their entry back, so the
+			// queue should never be full
+			const UINT32 head = __atomic_load_n(mSQHead, __ATOMIC_ACQUIRE);
+			if (mSQTailLocal - head >= mNumSQEntries)
+				return nullptr;
+
+			const UINT32 idx = mSQTailLocal & mSQMask;
+			io_uring_sqe* sqe = &mSQEs[idx];
+			memset(sqe, 0, sizeof(*sqe));
+
+			mSQArray[idx] = idx;
+			mSQTailLocal++;
+
+			return sqe;
+		}
+
+		/**
+		 * Makes the entry acquired through acquireSQE() visible to the kernel, and submits it. If the submission fails
+		 * the entry is removed from the queue, so the kernel never reads it after the caller frees its data.
+		 */
+		bool submit()
+		{
+			__atomic_store_n(mSQTail, mSQTailLocal, __ATOMIC_RELEASE);
+
+			while (true)
+			{
+				const long result = syscall(__NR_io_uring_enter, mRing, 1, 0, 0, nullptr, 0);
+				if (result > 0)
+					return true;
+
+				if (result == 0 || (errno != EINTR && errno != EAGAIN))
+					break;
+			}
+
+			// Without a kernel polling thread entries are only consumed from within io_uring_enter, so if the head
+			// didn't move the entry is still in the queue and can be safely taken back. Otherwise the entry was
+			// consumed and will complete normally.
+			if (__atomic_load_n(mSQHead, __ATOMIC_ACQUIRE) == mSQTailLocal)
+				return true;
+
+			mSQTailLocal--;
+			__atomic_store_n(mSQTail, mSQTailLocal, __ATOMIC_RELEASE);
+
+			return false;
+		}
+
+		int mRing = -1;
+
+		UINT8* mSQRing = nullptr;
+		UINT8* mCQRing = nullptr;
+		io_uring_sqe* mSQEs = nullptr;
+		size_t mSQRingSize = 0;
+		size_t mCQRingSize = 0;
+		size_t mSQEsSize = 0;
+
+		UINT32* mSQHead = nullptr;
+		UINT32* mSQTail = nullptr;
+		UINT32* mSQArray = nullptr;
+		UINT32 mSQMask = 0;
+		UINT32 mSQTailLocal = 0;
+		UINT32 mNumSQEntries = 0;
+
+		UINT32* mCQHead = nullptr;
+		UINT32* mCQTail = nullptr;
+		io_uring_cqe* mCQEs = nullptr;
+		UINT32 mCQMask = 0;
+		UINT32 mNumCQEntries = 0;
+	};
+
+	/** Number of entries in the io_uring submission queue. */
+	static constexpr UINT32 NUM_RING_ENTRIES = 256;
+
+	/** State of a request submitted to io_uring. */
+	struct RingRead
+	{
+		AsyncFileIO::Request* request;
+		iovec vec;
+	};
+#endif
+
+	struct AsyncFileIO::Pimpl
+	{
+		Mutex mutex;
+		Signal signal;
+		bool shutdown = false;
+		Vector<HThread> threads;
+
+		// Requests waiting for a thread to read them, or for room in the ring, depending on the backend
+		Deque<Request*> queue;
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		IOUring* ring = nullptr;
+		UINT32 numInFlight = 0;
+#endif
+	};
+
+	/** Reads the remaining data of a request with blocking reads. Returns false if reading fails. */
+	static bool readBlocking(AsyncFileIO::Request* request)
+	{
+		const int file = request->file->_getInternal()->file;
+		while (request->numRead < request->size)
+		{
+			const UINT64 size = std::min(request->size - request->numRead, MAX_READ_SIZE);
+			const ssize_t numRead = pread(file, request->buffer + request->numRead, (size_t)size,
+				(off_t)(request->offset + request->numRead));
+
+			if (numRead < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				return false;
+			}
+
+			// End of file
+			if (numRead == 0)
+				break;
+
+			request->numRead += (UINT64)numRead;
+		}
+
+		return true;
+	}
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+	/**
+	 * Submits the next read of a request to the ring, or queues it if the ring already has as many reads in flight as
+	 * it can report completions for. Must be called with the mutex locked. Returns false if the submission fails, in
+	 * which case @p read is freed and the caller is responsible for completing the request.
+	 */
+	static bool submitRingRead(AsyncFileIO::Pimpl* m, RingRead* read)
+	{
+		if (m->numInFlight >= m->ring->getNumCompletionEntries())
+		{
+			m->queue.push_back(read->request);
+			bs_delete(read);
+
+			return true;
+		}
+
+		AsyncFileIO::Request* request = read->request;
+		read->vec.iov_base = request->buffer + request->numRead;
+		read->vec.iov_len = (size_t)std::min(request->size - request->numRead, MAX_READ_SIZE);
+
+		if (!m->ring->submitRead(request->file->_getInternal()->file, &read->vec, request->offset + request->numRead,
+			(UINT64)(UINT8*)read))
+		{
+			bs_delete(read);
+			return false;
+		}
+
+		m->numInFlight++;
+		return true;
+	}
+
+	/** Main loop of the thread reaping io_uring completions. */
+	static void runRingThread(AsyncFileIO* owner, AsyncFileIO::Pimpl* m)
+	{
+		Vector<IOUring::Completion> completions;
+		Vector<std::pair<AsyncFileIO::Request*, bool>> finished;
+
+		bool shutdown = false;
+		while (!shutdown)
+		{
+			if (!m->ring->waitCompletions(completions))
+			{
+				LOGERR("Failed waiting on asynchronous file I/O: " + String(strerror(errno)));
+				break;
+			}
+
+			{
+				Lock lock(m->mutex);
+				for (auto& completion : completions)
+				{
+					// Shut down is signaled by an operation without any user data
+					if (completion.userData == 0)
+					{
+						shutdown = true;
+						continue;
+					}
+
+					m->numInFlight--;
+
+					auto read = (RingRead*)(UINT8*)completion.userData;
+					AsyncFileIO::Request* request = read->request;
+
+					bool done = true;
+					bool success = true;
+					if (completion.result < 0)
+					{
+						if (completion.result == -EINTR || completion.result == -EAGAIN)
+							done = false;
+						else
+							success = false;
+					}
+					else if (completion.result > 0)
+					{
+						request->numRead += (UINT64)completion.result;
+						done = request->numRead == request->size;
+					}
+
+					// Partial read, continue reading the rest
+					if (!done)
+					{
+						if (submitRingRead(m, read))
+							continue;
+
+						success = false;
+					}
+					else
+						bs_delete(read);
+
+					finished.push_back(std::make_pair(request, success));
+				}
+
+				// Freed room in the ring allows the queued requests to be submitted
+				while (!m->queue.empty() && m->numInFlight < m->ring->getNumCompletionEntries())
+				{
+					AsyncFileIO::Request* request = m->queue.front();
+					m->queue.pop_front();
+
+					if (!submitRingRead(m, bs_new<RingRead>(RingRead { request, {} })))
+						finished.push_back(std::make_pair(request, false));
+				}
+			}
+
+			// Callbacks are triggered without the lock, so they are free to queue more reads
+			for (auto& entry : finished)
+				owner->_completeRequest(entry.first, entry.second);
+
+			finished.clear();
+		}
+	}
+#endif
+
+	/** Main loop of the threads performing the reads, when the native asynchronous I/O mechanism isn't available. */
+	static void runReadThread(AsyncFileIO* owner, AsyncFileIO::Pimpl* m)
+	{
+		while (true)
+		{
+			AsyncFileIO::Request* request;
+			{
+				Lock lock(m->mutex);
+				m->signal.wait(lock, [m]() { return m->shutdown || !m->queue.empty(); });
+
+				if (m->queue.empty())
+					break;
+
+				request = m->queue.front();
+				m->queue.pop_front();
+			}
+
+			const bool success = readBlocking(request);
+			owner->_completeRequest(request, success);
+		}
+	}
+
+	AsyncFileIO::AsyncFileIO()
+		:m(bs_new<Pimpl>())
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		// io_uring can be unavailable on older kernels, or disabled (e.g. in containers)
+		m->ring = bs_new<IOUring>();
+		if (m->ring->initialize(NUM_RING_ENTRIES))
+		{
+			m->threads.push_back(ThreadPool::instance().run("AsyncFileIO", std::bind(&runRingThread, this, m)));
+			return;
+		}
+
+		bs_delete(m->ring);
+		m->ring = nullptr;
+#endif
+
+		for (UINT32 i = 0; i < NUM_FALLBACK_THREADS; i++)
+			m->threads.push_back(ThreadPool::instance().run("AsyncFileIO", std::bind(&runReadThread, this, m)));
+	}
+
+	AsyncFileIO::~AsyncFileIO()
+	{
+		waitUntilIdle();
+
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		if (m->ring != nullptr)
+		{
+			bool signaled;
+			{
+				Lock lock(m->mutex);
+				signaled = m->ring->submitNop(0);
+			}
+
+			if (signaled)
+			{
+				for (auto& thread : m->threads)
+					thread.blockUntilComplete();
+			}
+			else
+				LOGERR("Unable to stop the asynchronous file I/O thread.");
+
+			bs_delete(m->ring);
+			bs_delete(m);
+			return;
+		}
+#endif
+
+		{
+			Lock lock(m->mutex);
+			m->shutdown = true;
+		}
+
+		m->signal.notify_all();
+
+		for (auto& thread : m->threads)
+			thread.blockUntilComplete();
+
+		bs_delete(m);
+	}
+
+	void AsyncFileIO::submit(Request* request)
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		if (m->ring != nullptr)
+		{
+			bool submitted;
+			{
+				Lock lock(m->mutex);
+				submitted = submitRingRead(m, bs_new<RingRead>(RingRead { request, {} }));
+			}
+
+			// Read directly if the ring can't accept the request, so the request is still fulfilled. Its callback
+			// gets triggered on this thread, same as for other requests that fail to be submitted.
+			if (!submitted)
+				_completeRequest(request, readBlocking(request));
+
+			return;
+		}
+#endif
+
+		{
+			Lock lock(m->mutex);
+			m->queue.push_back(request);
+		}
+
+		m->signal.notify_one();
+	}
+
+	const char* AsyncFileIO::getBackendName() const
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		if (m->ring != nullptr)
+			return "io_uring";
+#endif
+
+		return "Threads";
+	}
+}
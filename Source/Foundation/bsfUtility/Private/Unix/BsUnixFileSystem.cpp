@@ -9,9 +9,15 @@
 #include <dirent.h>
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+#include <sys/sysmacros.h>
+#endif
+
 #include <climits>
 #include <cstring>
 #include <cstdio>
@@ -349,4 +355,104 @@ namespace bs
 
 		return Path(String(directoryName) + "/");
 	}
+
+	struct MemoryMappedFile::Pimpl
+	{
+		int file = -1;
+		void* mapping = nullptr;
+	};
+
+	MemoryMappedFile::MemoryMappedFile()
+		:m(bs_new<Pimpl>())
+	{ }
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		if(m->mapping)
+			munmap(m->mapping, (size_t)mSize);
+
+		if(m->file != -1)
+			close(m->file);
+
+		bs_delete(m);
+	}
+
+	SPtr<MemoryMappedFile> MemoryMappedFile::open(const Path& fullPath)
+	{
+		const String pathString = fullPath.toString();
+
+		SPtr<MemoryMappedFile> output = bs_shared_ptr(new (bs_alloc<MemoryMappedFile>()) MemoryMappedFile());
+		output->m->file = ::open(pathString.c_str(), O_RDONLY);
+		if(output->m->file == -1)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return nullptr;
+		}
+
+		struct stat st_buf;
+		if(fstat(output->m->file, &st_buf) != 0)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return nullptr;
+		}
+
+		output->mSize = (UINT64)st_buf.st_size;
+
+		// Mapping an empty file is not allowed, but there is nothing to read either
+		if(output->mSize == 0)
+			return output;
+
+		void* mapping = mmap(nullptr, (size_t)output->mSize, PROT_READ, MAP_PRIVATE, output->m->file, 0);
+		if(mapping == MAP_FAILED)
+		{
+			HANDLE_PATH_ERROR(pathString, errno);
+			return nullptr;
+		}
+
+		output->m->mapping = mapping;
+		output->mData = (const UINT8*)mapping;
+
+		return output;
+	}
+
+	UINT64 FileScheduler::getDeviceId(const Path& path)
+	{
+		// File might not exist yet (e.g. when saving), in which case find the closest parent directory that does
+		Path current = path.isAbsolute() ? path : path.getAbsolute(FileSystem::getWorkingDirectoryPath());
+		while (true)
+		{
+			struct stat st_buf;
+			if (stat(current.toString().c_str(), &st_buf) == 0)
+				return (UINT64)st_buf.st_dev;
+
+			if (!current.isFile() && current.getNumDirectories() == 0)
+				break;
+
+			current.makeParent();
+		}
+
+		return 0;
+	}
+
+	bool FileScheduler::isRotationalDevice(const Path& path, UINT64 deviceId)
+	{
+#if BS_PLATFORM == BS_PLATFORM_LINUX
+		const dev_t device = (dev_t)deviceId;
+		const String sysPath = "/sys/dev/block/" + toString((UINT32)major(device)) + ":" +
+			toString((UINT32)minor(device));
+
+		// Partitions don't report the queue properties, those are found on the disk they are a part of
+		const String queuePaths[] = { sysPath + "/queue/rotational", sysPath + "/../queue/rotational" };
+		for (auto& queuePath : queuePaths)
+		{
+			std::ifstream file(queuePath.c_str());
+
+			int rotational = 1;
+			if (file >> rotational)
+				return rotational != 0;
+		}
+#endif
+
+		return true;
+	}
 }
@@ -0,0 +1,227 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "FileSystem/BsAsyncFileIO.h"
+#include "Threading/BsThreadPool.h"
+#include "Error/BsException.h"
+#include "Debug/BsDebug.h"
+#include "String/BsUnicode.h"
+#include <windows.h>
+
+namespace bs
+{
+	/** Maximum number of bytes to read with a single call. Larger requests are split into multiple reads. */
+	static constexpr UINT64 MAX_READ_SIZE = 1 << 30;
+
+	struct AsyncFile::Pimpl
+	{
+		HANDLE file = INVALID_HANDLE_VALUE;
+		bool isAssociated = false; // Protected by the AsyncFileIO mutex
+	};
+
+	AsyncFile::AsyncFile()
+		:m(bs_new<Pimpl>())
+	{ }
+
+	AsyncFile::~AsyncFile()
+	{
+		if (m->file != INVALID_HANDLE_VALUE)
+			CloseHandle(m->file);
+
+		bs_delete(m);
+	}
+
+	SPtr<AsyncFile> AsyncFile::open(const Path& path)
+	{
+		const WString pathString = UTF8::toWide(path.toString());
+
+		HANDLE file = CreateFileW(pathString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			LOGERR("Unable to open file for asynchronous reading: " + path.toString() + ". Error code: " +
+				toString((UINT32)GetLastError()));
+			return nullptr;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			LOGERR("Unable to open file for asynchronous reading: " + path.toString() + ". Error code: " +
+				toString((UINT32)GetLastError()));
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		SPtr<AsyncFile> output = bs_shared_ptr(new (bs_alloc<AsyncFile>()) AsyncFile());
+		output->m->file = file;
+		output->mPath = path;
+		output->mSize = (UINT64)size.QuadPart;
+
+		return output;
+	}
+
+	/** State of a request submitted to the I/O completion port. */
+	struct OverlappedRead
+	{
+		OVERLAPPED overlapped; // Must be first, the completion port returns a pointer to it
+		AsyncFileIO::Request* request;
+	};
+
+	/** Outcome of starting an overlapped read. */
+	enum class ReadStatus
+	{
+		Pending,
+		EndOfFile,
+		Failed
+	};
+
+	struct AsyncFileIO::Pimpl
+	{
+		Mutex mutex;
+		HANDLE port = nullptr;
+		HThread thread;
+	};
+
+	/** Starts an overlapped read of the remaining data of a request. */
+	static ReadStatus startRead(OverlappedRead* read)
+	{
+		AsyncFileIO::Request* request = read->request;
+
+		const UINT64 offset = request->offset + request->numRead;
+		const UINT64 size = std::min(request->size - request->numRead, MAX_READ_SIZE);
+
+		memset(&read->overlapped, 0, sizeof(read->overlapped));
+		read->overlapped.Offset = (DWORD)offset;
+		read->overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+		// The completion is reported through the port even if the read completes immediately
+		if (!ReadFile(request->file->_getInternal()->file, request->buffer + request->numRead, (DWORD)size, nullptr,
+			&read->overlapped))
+		{
+			const DWORD error = GetLastError();
+			if (error == ERROR_HANDLE_EOF)
+				return ReadStatus::EndOfFile;
+
+			if (error != ERROR_IO_PENDING)
+				return ReadStatus::Failed;
+		}
+
+		return ReadStatus::Pending;
+	}
+
+	/** Main loop of the thread waiting on the I/O completion port. */
+	static void runCompletionThread(AsyncFileIO* owner, AsyncFileIO::Pimpl* m)
+	{
+		while (true)
+		{
+			DWORD numBytes = 0;
+			ULONG_PTR key = 0;
+			LPOVERLAPPED overlapped = nullptr;
+			const BOOL result = GetQueuedCompletionStatus(m->port, &numBytes, &key, &overlapped, INFINITE);
+
+			// Shut down is signaled by a completion without an overlapped structure
+			if (overlapped == nullptr)
+			{
+				if (!result)
+				{
+					LOGERR("Failed waiting on asynchronous file I/O. Error code: " +
+						toString((UINT32)GetLastError()));
+				}
+
+				break;
+			}
+
+			auto read = (OverlappedRead*)overlapped;
+			AsyncFileIO::Request* request = read->request;
+
+			bool done = true;
+			bool success = true;
+			if (!result)
+			{
+				if (GetLastError() != ERROR_HANDLE_EOF)
+					success = false;
+			}
+			else if (numBytes > 0)
+			{
+				request->numRead += numBytes;
+				done = request->numRead == request->size;
+			}
+
+			// Partial read, continue reading the rest
+			if (!done)
+			{
+				const ReadStatus status = startRead(read);
+				if (status == ReadStatus::Pending)
+					continue;
+
+				success = status == ReadStatus::EndOfFile;
+			}
+
+			bs_delete(read);
+			owner->_completeRequest(request, success);
+		}
+	}
+
+	AsyncFileIO::AsyncFileIO()
+		:m(bs_new<Pimpl>())
+	{
+		m->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+		if (m->port == nullptr)
+		{
+			BS_EXCEPT(InternalErrorException, "Unable to create an I/O completion port. Error code: " +
+				toString((UINT32)GetLastError()));
+		}
+
+		m->thread = ThreadPool::instance().run("AsyncFileIO", std::bind(&runCompletionThread, this, m));
+	}
+
+	AsyncFileIO::~AsyncFileIO()
+	{
+		waitUntilIdle();
+
+		PostQueuedCompletionStatus(m->port, 0, 0, nullptr);
+		m->thread.blockUntilComplete();
+
+		CloseHandle(m->port);
+		bs_delete(m);
+	}
+
+	void AsyncFileIO::submit(Request* request)
+	{
+		AsyncFile::Pimpl* file = request->file->_getInternal();
+
+		{
+			Lock lock(m->mutex);
+			if (!file->isAssociated)
+			{
+				if (CreateIoCompletionPort(file->file, m->port, 0, 0) == nullptr)
+				{
+					lock.unlock();
+
+					LOGERR("Unable to associate a file with the I/O completion port. Error code: " +
+						toString((UINT32)GetLastError()));
+					_completeRequest(request, false);
+					return;
+				}
+
+				file->isAssociated = true;
+			}
+		}
+
+		auto read = bs_new<OverlappedRead>();
+		read->request = request;
+
+		const ReadStatus status = startRead(read);
+		if (status != ReadStatus::Pending)
+		{
+			bs_delete(read);
+			_completeRequest(request, status == ReadStatus::EndOfFile);
+		}
+	}
+
+	const char* AsyncFileIO::getBackendName() const
+	{
+		return "IOCP";
+	}
+}
@@ -5,6 +5,7 @@
 #include "FileSystem/BsDataStream.h"
 #include "Debug/BsDebug.h"
 #include <windows.h>
+#include <winioctl.h>
 #include "String/BsUnicode.h"
 
 namespace bs
@@ -474,4 +475,115 @@ namespace bs
 		const String utf8dir = UTF8::fromWide(win32_getTempDirectory());
 		return Path(utf8dir);
 	}
+
+	struct MemoryMappedFile::Pimpl
+	{
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+	};
+
+	MemoryMappedFile::MemoryMappedFile()
+		:m(bs_new<Pimpl>())
+	{ }
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		if(mData)
+			UnmapViewOfFile(mData);
+
+		if(m->mapping)
+			CloseHandle(m->mapping);
+
+		if(m->file != INVALID_HANDLE_VALUE)
+			CloseHandle(m->file);
+
+		bs_delete(m);
+	}
+
+	SPtr<MemoryMappedFile> MemoryMappedFile::open(const Path& fullPath)
+	{
+		WString pathWString = UTF8::toWide(fullPath.toString());
+
+		SPtr<MemoryMappedFile> output = bs_shared_ptr(new (bs_alloc<MemoryMappedFile>()) MemoryMappedFile());
+		output->m->file = CreateFileW(pathWString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if(output->m->file == INVALID_HANDLE_VALUE)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		LARGE_INTEGER fileSize;
+		if(GetFileSizeEx(output->m->file, &fileSize) == FALSE)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		output->mSize = (UINT64)fileSize.QuadPart;
+
+		// Mapping an empty file is not allowed, but there is nothing to read either
+		if(output->mSize == 0)
+			return output;
+
+		output->m->mapping = CreateFileMappingW(output->m->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(output->m->mapping == nullptr)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		output->mData = (const UINT8*)MapViewOfFile(output->m->mapping, FILE_MAP_READ, 0, 0, 0);
+		if(output->mData == nullptr)
+		{
+			win32_handleError(GetLastError(), pathWString);
+			return nullptr;
+		}
+
+		return output;
+	}
+
+	UINT64 FileScheduler::getDeviceId(const Path& path)
+	{
+		const Path absolutePath = path.isAbsolute() ? path : path.getAbsolute(FileSystem::getWorkingDirectoryPath());
+
+		// Local volumes are identified by their drive letter, and network shares by the name of their server
+		const String& device = absolutePath.getDevice();
+		if (!device.empty())
+			return (UINT64)toupper(device[0]);
+
+		const UINT64 nodeHash = (UINT64)std::hash<String>()(UTF8::toLower(absolutePath.getNode()));
+		return (nodeHash << 8) | 0xFF;
+	}
+
+	bool FileScheduler::isRotationalDevice(const Path& path, UINT64 deviceId)
+	{
+		// Network shares are treated the same as mechanical drives
+		if (deviceId > 0xFF)
+			return true;
+
+		const WString volumePath = L"\\\\.\\" + WString(1, (wchar_t)deviceId) + L":";
+		HANDLE volume = CreateFileW(volumePath.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+			0, nullptr);
+
+		if (volume == INVALID_HANDLE_VALUE)
+			return true;
+
+		STORAGE_PROPERTY_QUERY query = {};
+		query.PropertyId = StorageDeviceSeekPenaltyProperty;
+		query.QueryType = PropertyStandardQuery;
+
+		DEVICE_SEEK_PENALTY_DESCRIPTOR descriptor = {};
+		DWORD numBytes = 0;
+		const BOOL result = DeviceIoControl(volume, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query), &descriptor,
+			sizeof(descriptor), &numBytes, nullptr);
+
+		CloseHandle(volume);
+
+		if (!result || numBytes < sizeof(descriptor))
+			return true;
+
+		return descriptor.IncursSeekPenalty != FALSE;
+	}
 }
@@ -25,18 +25,18 @@ namespace bs
 	struct RTTIManagedDataBlockFieldBase : public RTTIField
 	{
 		/** Retrieves a managed data block from the specified instance. */
-		virtual SPtr<DataStream> getValue(RTTITypeBase* rtti, void* object, UINT32& size) = 0;
+		virtual SPtr<DataStream> getValue(RTTITypeBase* rtti, void* object, UINT64& size) = 0;
 
 		/** Sets a managed data block on the specified instance. */
-		virtual void setValue(RTTITypeBase* rtti, void* object, const SPtr<DataStream>& data, UINT32 size) = 0;
+		virtual void setValue(RTTITypeBase* rtti, void* object, const SPtr<DataStream>& data, UINT64 size) = 0;
 	};
 
 	/** Class containing a managed data block field containing a specific type. */
 	template <class InterfaceType, class DataType, class ObjectType>
 	struct RTTIManagedDataBlockField : public RTTIManagedDataBlockFieldBase
 	{
-		typedef SPtr<DataStream> (InterfaceType::*GetterType)(ObjectType*, UINT32&);
-		typedef void (InterfaceType::*SetterType)(ObjectType*, const SPtr<DataStream>&, UINT32);
+		typedef SPtr<DataStream> (InterfaceType::*GetterType)(ObjectType*, UINT64&);
+		typedef void (InterfaceType::*SetterType)(ObjectType*, const SPtr<DataStream>&, UINT64);
 
 		/**
 		 * Initializes a field that returns a block of bytes. Can be used for serializing pretty much anything.
@@ -86,7 +86,7 @@ namespace bs
 		}
 
 		/** @copydoc RTTIManagedDataBlockFieldBase::getValue */
-		SPtr<DataStream> getValue(RTTITypeBase* rtti, void* object, UINT32& size) override
+		SPtr<DataStream> getValue(RTTITypeBase* rtti, void* object, UINT64& size) override
 		{
 			InterfaceType* rttiObject = static_cast<InterfaceType*>(rtti);
 			ObjectType* castObj = static_cast<ObjectType*>(object);
@@ -95,7 +95,7 @@ namespace bs
 		}
 
 		/** @copydoc RTTIManagedDataBlockFieldBase::setValue */
-		void setValue(RTTITypeBase* rtti, void* object, const SPtr<DataStream>& value, UINT32 size) override
+		void setValue(RTTITypeBase* rtti, void* object, const SPtr<DataStream>& value, UINT64 size) override
 		{
 			InterfaceType* rttiObject = static_cast<InterfaceType*>(rtti);
 			ObjectType* castObj = static_cast<ObjectType*>(object);
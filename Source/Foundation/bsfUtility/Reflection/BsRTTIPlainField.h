@@ -94,6 +94,13 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(RTTITypeBase* rtti, void* object, int index, void* buffer) = 0;
+
+		/**
+		 * Returns a pointer to the array elements of the provided object, if the field declared its elements are stored
+		 * contiguously and they can be serialized using a single memcpy (see RTTIPlainTypeIsMemcpy). Returns null 
+		 * otherwise, in which case the elements must be accessed individually.
+		 */
+		virtual void* getArrayData(RTTITypeBase* rtti, void* object) { return nullptr; }
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -107,6 +114,7 @@ namespace bs
 		typedef void (InterfaceType::*ArraySetterType)(ObjectType*, UINT32, DataType&);
 		typedef UINT32(InterfaceType::*ArrayGetSizeType)(ObjectType*);
 		typedef void(InterfaceType::*ArraySetSizeType)(ObjectType*, UINT32);
+		typedef DataType* (InterfaceType::*ArrayGetDataType)(ObjectType*);
 
 		/**
 		 * Initializes a plain field containing a single value.
@@ -145,9 +153,13 @@ namespace bs
 		 * @param[in]	setter  	The setter method for the field.
 		 * @param[in]	setSize 	Setter method that allows you to resize an array. Can be null.
 		 * @param[in]	flags		Various flags you can use to specialize how outside systems handle this field. See "RTTIFieldFlag".
+		 * @param[in]	getData		Optional getter method that returns a pointer to the contiguously stored array 
+		 *							elements, or null if they aren't contiguous. Allows the array to be serialized using a
+		 *							single memcpy, if the element type supports it.
 		 */
 		void initArray(String name, UINT16 uniqueId, ArrayGetterType getter,
-			ArrayGetSizeType getSize, ArraySetterType setter, ArraySetSizeType setSize, UINT64 flags)
+			ArrayGetSizeType getSize, ArraySetterType setter, ArraySetSizeType setSize, UINT64 flags, 
+			ArrayGetDataType getData = nullptr)
 		{
 			static_assert((RTTIPlainType<DataType>::id != 0) || true, ""); // Just making sure provided type has a type ID
 
@@ -159,6 +171,7 @@ namespace bs
 			arraySetter = setter;
 			arrayGetSize = getSize;
 			arraySetSize = setSize;
+			arrayGetData = RTTIPlainTypeIsMemcpy<DataType>::value ? getData : nullptr;
 
 			init(std::move(name), uniqueId, true, SerializableFT_Plain, flags);
 		}
@@ -300,6 +313,19 @@ namespace bs
 			(rttiObject->*arraySetter)(castObject, index, value);
 		}
 
+		/** @copydoc RTTIPlainFieldBase::getArrayData */
+		void* getArrayData(RTTITypeBase* rtti, void* object) override
+		{
+			checkIsArray(true);
+
+			if(!arrayGetData)
+				return nullptr;
+
+			InterfaceType* rttiObject = static_cast<InterfaceType*>(rtti);
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+			return (rttiObject->*arrayGetData)(castObject);
+		}
+
 	private:
 		union
 		{
@@ -316,6 +342,7 @@ namespace bs
 
 				ArrayGetSizeType arrayGetSize;
 				ArraySetSizeType arraySetSize;
+				ArrayGetDataType arrayGetData;
 			};
 		};
 	};
@@ -13,7 +13,8 @@ namespace bs
 
 	RTTIField* RTTITypeBase::findField(const String& name)
 	{
-		auto foundElement = std::find_if(mFields.begin(), mFields.end(), [&name](RTTIField* x) { return x->mName == name; });
+		auto foundElement = std::find_if(mFields.begin(), mFields.end(),
+			[&name](RTTIField* x) { return x->mName == name; });
 
 		if(foundElement == mFields.end())
 		{
@@ -26,9 +27,24 @@ namespace bs
 
 	RTTIField* RTTITypeBase::findField(int uniqueFieldId)
 	{
-		auto foundElement = std::find_if(mFields.begin(), mFields.end(), [&uniqueFieldId](RTTIField* x) { return x->mUniqueId == uniqueFieldId; });
+		if(mFieldsById.empty())
+			return nullptr;
 
-		if(foundElement == mFields.end())
+		// Most types use consecutive IDs, in which case the field can be indexed directly
+		const int firstId = mFieldsById.front()->mUniqueId;
+		const int lastId = mFieldsById.back()->mUniqueId;
+		if(lastId - firstId + 1 == (int)mFieldsById.size())
+		{
+			if(uniqueFieldId < firstId || uniqueFieldId > lastId)
+				return nullptr;
+
+			return mFieldsById[uniqueFieldId - firstId];
+		}
+
+		auto foundElement = std::lower_bound(mFieldsById.begin(), mFieldsById.end(), uniqueFieldId,
+			[](RTTIField* x, int id) { return x->mUniqueId < id; });
+
+		if(foundElement == mFieldsById.end() || (*foundElement)->mUniqueId != uniqueFieldId)
 			return nullptr;
 
 		return *foundElement;
@@ -43,16 +59,18 @@ namespace bs
 		}
 
 		int uniqueId = field->mUniqueId;
-		auto foundElementById = std::find_if(mFields.begin(), mFields.end(), [uniqueId](RTTIField* x) { return x->mUniqueId == uniqueId; });
+		auto insertPos = std::lower_bound(mFieldsById.begin(), mFieldsById.end(), uniqueId,
+			[](RTTIField* x, int id) { return x->mUniqueId < id; });
 
-		if(foundElementById != mFields.end())
+		if(insertPos != mFieldsById.end() && (*insertPos)->mUniqueId == uniqueId)
 		{
 			BS_EXCEPT(InternalErrorException, 
 				"Field with the same ID already exists.");
 		}
 
 		String& name = field->mName;
-		auto foundElementByName = std::find_if(mFields.begin(), mFields.end(), [&name](RTTIField* x) { return x->mName == name; });
+		auto foundElementByName = std::find_if(mFields.begin(), mFields.end(),
+			[&name](RTTIField* x) { return x->mName == name; });
 
 		if(foundElementByName != mFields.end())
 		{
@@ -61,6 +79,7 @@ namespace bs
 		}
 
 		mFields.push_back(field);
+		mFieldsById.insert(insertPos, field);
 	}
 
 	class SerializationContextRTTI : public RTTIType<SerializationContext, IReflectable, SerializationContextRTTI>
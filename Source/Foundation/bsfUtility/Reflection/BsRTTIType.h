@@ -77,11 +77,13 @@ namespace bs
 	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::name)>::type::value_type& val) { obj->name[idx] = val; }		\
 	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->name.size(); }																		\
 	void setSize##name(OwnerType* obj, UINT32 val) { obj->name.resize(val); }																		\
+	std::common_type<decltype(OwnerType::name)>::type::value_type* getData##name(OwnerType* obj) { return rttiGetArrayData(obj->name); }				\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addContiguousPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name,	\
+			&MyType::getData##name);																\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -97,11 +99,13 @@ namespace bs
 	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::field)>::type::value_type& val) { obj->field[idx] = val; }		\
 	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->field.size(); }																		\
 	void setSize##name(OwnerType* obj, UINT32 val) { obj->field.resize(val); }																		\
+	std::common_type<decltype(OwnerType::field)>::type::value_type* getData##name(OwnerType* obj) { return rttiGetArrayData(obj->field); }				\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addContiguousPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name,	\
+			&MyType::getData##name);																\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -418,6 +422,12 @@ namespace bs
 
 	private:
 		Vector<RTTIField*> mFields;
+
+		/** 
+		 * Same fields as in mFields, sorted by their unique ID for fast lookup during deserialization. If the IDs are
+		 * consecutive fields are indexed directly, and found through binary search otherwise.
+		 */
+		Vector<RTTIField*> mFieldsById;
 	};
 
 	/** Used for initializing a certain type as soon as the program is loaded. */
@@ -626,6 +636,33 @@ namespace bs
 			addNewField(newField);
 		}	
 
+		/** 
+		 * Registers a field referencing an array of plain types stored contiguously in memory. @p getData returns a 
+		 * pointer to the first element of the array, or null if the elements currently aren't contiguous. If the element 
+		 * type can be serialized using a memcpy (see RTTIPlainTypeIsMemcpy), the serializer will copy the entire array at
+		 * once instead of accessing each element individually. Otherwise the field behaves the same as a field
+		 * registered through addPlainArrayField().
+		 */
+		template<class InterfaceType, class ObjectType, class DataType>
+		void addContiguousPlainArrayField(const String& name, UINT32 uniqueId, 
+			DataType& (InterfaceType::*getter)(ObjectType*, UINT32),
+			UINT32(InterfaceType::*getSize)(ObjectType*),
+			void (InterfaceType::*setter)(ObjectType*, UINT32, DataType&),
+			void(InterfaceType::*setSize)(ObjectType*, UINT32),
+			DataType* (InterfaceType::*getData)(ObjectType*),
+			UINT64 flags = 0)
+		{
+			static_assert((std::is_base_of<bs::RTTIType<Type, BaseType, MyRTTIType>, InterfaceType>::value), 
+				"Class with the get/set methods must derive from bs::RTTIType.");
+
+			static_assert(!(std::is_base_of<bs::IReflectable, DataType>::value), 
+				"Data type derives from IReflectable but it is being added as a plain field.");
+
+			auto newField = bs_new<RTTIPlainField<InterfaceType, DataType, ObjectType>>();
+			newField->initArray(name, uniqueId, getter, getSize, setter, setSize, flags, getData);
+			addNewField(newField);
+		}
+
 		/** Registers a field referencing an array of IReflectable objects. */
 		template<class InterfaceType, class ObjectType, class DataType>
 		void addReflectableArrayField(const String& name, UINT32 uniqueId, 
@@ -660,8 +697,8 @@ namespace bs
 
 		/** Registers a field referencing a blob of memory. */
 		template<class InterfaceType, class ObjectType>
-		void addDataBlockField(const String& name, UINT32 uniqueId, SPtr<DataStream> (InterfaceType::*getter)(ObjectType*, UINT32&), 
-			void (InterfaceType::*setter)(ObjectType*, const SPtr<DataStream>&, UINT32), UINT64 flags = 0)
+		void addDataBlockField(const String& name, UINT32 uniqueId, SPtr<DataStream> (InterfaceType::*getter)(ObjectType*, UINT64&), 
+			void (InterfaceType::*setter)(ObjectType*, const SPtr<DataStream>&, UINT64), UINT64 flags = 0)
 		{
 			auto newField = bs_new<RTTIManagedDataBlockField<InterfaceType, UINT8*, ObjectType>>();
 			newField->initSingle(name, uniqueId, getter, setter, flags);
@@ -27,10 +27,10 @@ namespace bs
 			alloc.clear();
 		}
 
-		std::function<void*(UINT32)> allocator = &MemoryAllocator<GenAlloc>::allocate;
+		std::function<void*(size_t)> allocator = &MemoryAllocator<GenAlloc>::allocate;
 
 		MemorySerializer ms;
-		UINT32 dataSize = 0;
+		UINT64 dataSize = 0;
 		UINT8* data = ms.encode(object, dataSize, allocator, shallow);
 		SPtr<IReflectable> clonedObj = ms.decode(data, dataSize);
 
@@ -0,0 +1,242 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Serialization/BsBinaryCompare.h"
+#include "Reflection/BsIReflectable.h"
+#include "Reflection/BsRTTIType.h"
+#include "Reflection/BsRTTIField.h"
+#include "Reflection/BsRTTIPlainField.h"
+#include "Reflection/BsRTTIReflectableField.h"
+#include "Reflection/BsRTTIReflectablePtrField.h"
+#include "Reflection/BsRTTIManagedDataBlockField.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs
+{
+	/** Size of the chunks data block fields are read in when comparing them. */
+	static constexpr UINT32 DATA_BLOCK_CHUNK_SIZE = 4096;
+
+	bool BinaryCompare::isEqual(IReflectable* a, IReflectable* b)
+	{
+		if (a == b)
+			return true;
+
+		if (a == nullptr || b == nullptr)
+			return false;
+
+		FrameAlloc& alloc = gFrameAlloc();
+		alloc.markFrame();
+
+		bool equal;
+		{
+			Set<ObjectPair> visited;
+			equal = compareObjects(a, b, alloc, visited);
+		}
+
+		alloc.clear();
+		return equal;
+	}
+
+	bool BinaryCompare::compareObjects(IReflectable* a, IReflectable* b, FrameAlloc& alloc, Set<ObjectPair>& visited)
+	{
+		if (a->getTypeId() != b->getTypeId())
+			return false;
+
+		// Every level of the class hierarchy gets its own RTTI instances, kept alive until the entire object is
+		// compared, same as during serialization
+		Stack<std::pair<RTTITypeBase*, RTTITypeBase*>> rttiInstances;
+
+		bool equal = true;
+		RTTITypeBase* rtti = a->getRTTI();
+		while (rtti != nullptr && equal)
+		{
+			RTTITypeBase* rttiA = rtti->_clone(alloc);
+			RTTITypeBase* rttiB = rtti->_clone(alloc);
+			rttiInstances.push(std::make_pair(rttiA, rttiB));
+
+			rttiA->onSerializationStarted(a, nullptr);
+			rttiB->onSerializationStarted(b, nullptr);
+
+			const UINT32 numFields = rtti->getNumFields();
+			for (UINT32 i = 0; i < numFields && equal; i++)
+				equal = compareField(rtti->getField(i), rttiA, a, rttiB, b, alloc, visited);
+
+			rtti = rtti->getBaseClass();
+		}
+
+		while (!rttiInstances.empty())
+		{
+			RTTITypeBase* rttiA = rttiInstances.top().first;
+			RTTITypeBase* rttiB = rttiInstances.top().second;
+			rttiInstances.pop();
+
+			rttiA->onSerializationEnded(a, nullptr);
+			rttiB->onSerializationEnded(b, nullptr);
+
+			alloc.destruct(rttiB);
+			alloc.destruct(rttiA);
+		}
+
+		return equal;
+	}
+
+	bool BinaryCompare::compareField(RTTIField* field, RTTITypeBase* rttiA, IReflectable* a, RTTITypeBase* rttiB,
+		IReflectable* b, FrameAlloc& alloc, Set<ObjectPair>& visited)
+	{
+		const bool isArray = field->isArray();
+
+		UINT32 numElements = 1;
+		if (isArray)
+		{
+			numElements = field->getArraySize(rttiA, a);
+			if (numElements != field->getArraySize(rttiB, b))
+				return false;
+		}
+
+		switch (field->mType)
+		{
+		case SerializableFT_Plain:
+			{
+				auto* curField = static_cast<RTTIPlainFieldBase*>(field);
+
+				// Elements stored contiguously in their serialized form can be compared all at once
+				if (isArray && numElements > 0 && !curField->hasDynamicSize())
+				{
+					const UINT8* dataA = (UINT8*)curField->getArrayData(rttiA, a);
+					const UINT8* dataB = (UINT8*)curField->getArrayData(rttiB, b);
+
+					if (dataA != nullptr && dataB != nullptr)
+						return memcmp(dataA, dataB, (size_t)numElements * curField->getTypeSize()) == 0;
+				}
+
+				for (UINT32 i = 0; i < numElements; i++)
+				{
+					if (!comparePlain(curField, rttiA, a, rttiB, b, isArray ? (INT32)i : -1))
+						return false;
+				}
+
+				return true;
+			}
+		case SerializableFT_Reflectable:
+			{
+				auto* curField = static_cast<RTTIReflectableFieldBase*>(field);
+
+				for (UINT32 i = 0; i < numElements; i++)
+				{
+					IReflectable& childA = isArray ? curField->getArrayValue(rttiA, a, i) :
+						curField->getValue(rttiA, a);
+					IReflectable& childB = isArray ? curField->getArrayValue(rttiB, b, i) :
+						curField->getValue(rttiB, b);
+
+					if (!compareObjects(&childA, &childB, alloc, visited))
+						return false;
+				}
+
+				return true;
+			}
+		case SerializableFT_ReflectablePtr:
+			{
+				auto* curField = static_cast<RTTIReflectablePtrFieldBase*>(field);
+
+				for (UINT32 i = 0; i < numElements; i++)
+				{
+					SPtr<IReflectable> childA = isArray ? curField->getArrayValue(rttiA, a, i) :
+						curField->getValue(rttiA, a);
+					SPtr<IReflectable> childB = isArray ? curField->getArrayValue(rttiB, b, i) :
+						curField->getValue(rttiB, b);
+
+					if (childA == childB)
+						continue;
+
+					if (childA == nullptr || childB == nullptr)
+						return false;
+
+					// Objects referenced from multiple fields, or through circular references, only need to be compared
+					// once. References are kept alive so their addresses can't be reused by other compared objects.
+					if (!visited.insert(std::make_pair(childA, childB)).second)
+						continue;
+
+					if (!compareObjects(childA.get(), childB.get(), alloc, visited))
+						return false;
+				}
+
+				return true;
+			}
+		case SerializableFT_DataBlock:
+			{
+				auto* curField = static_cast<RTTIManagedDataBlockFieldBase*>(field);
+
+				UINT64 sizeA = 0;
+				UINT64 sizeB = 0;
+				SPtr<DataStream> streamA = curField->getValue(rttiA, a, sizeA);
+				SPtr<DataStream> streamB = curField->getValue(rttiB, b, sizeB);
+
+				if (sizeA != sizeB)
+					return false;
+
+				if (sizeA == 0 || streamA == streamB)
+					return true;
+
+				if (streamA == nullptr || streamB == nullptr)
+					return false;
+
+				UINT8* chunkA = (UINT8*)bs_stack_alloc(DATA_BLOCK_CHUNK_SIZE);
+				UINT8* chunkB = (UINT8*)bs_stack_alloc(DATA_BLOCK_CHUNK_SIZE);
+
+				bool equal = true;
+				for (UINT64 offset = 0; offset < sizeA && equal; offset += DATA_BLOCK_CHUNK_SIZE)
+				{
+					const size_t chunkSize = (size_t)std::min(sizeA - offset, (UINT64)DATA_BLOCK_CHUNK_SIZE);
+
+					equal = streamA->read(chunkA, chunkSize) == chunkSize &&
+						streamB->read(chunkB, chunkSize) == chunkSize && memcmp(chunkA, chunkB, chunkSize) == 0;
+				}
+
+				bs_stack_free(chunkB);
+				bs_stack_free(chunkA);
+
+				return equal;
+			}
+		default:
+			return false;
+		}
+	}
+
+	bool BinaryCompare::comparePlain(RTTIPlainFieldBase* field, RTTITypeBase* rttiA, IReflectable* a,
+		RTTITypeBase* rttiB, IReflectable* b, INT32 arrayIdx)
+	{
+		UINT32 size = field->getTypeSize();
+		if (field->hasDynamicSize())
+		{
+			size = arrayIdx >= 0 ? field->getArrayElemDynamicSize(rttiA, a, arrayIdx) : field->getDynamicSize(rttiA, a);
+			const UINT32 sizeB = arrayIdx >= 0 ? field->getArrayElemDynamicSize(rttiB, b, arrayIdx) :
+				field->getDynamicSize(rttiB, b);
+
+			if (size != sizeB)
+				return false;
+		}
+
+		if (size == 0)
+			return true;
+
+		UINT8* dataA = (UINT8*)bs_stack_alloc(size);
+		UINT8* dataB = (UINT8*)bs_stack_alloc(size);
+
+		if (arrayIdx >= 0)
+		{
+			field->arrayElemToBuffer(rttiA, a, arrayIdx, dataA);
+			field->arrayElemToBuffer(rttiB, b, arrayIdx, dataB);
+		}
+		else
+		{
+			field->toBuffer(rttiA, a, dataA);
+			field->toBuffer(rttiB, b, dataB);
+		}
+
+		const bool equal = memcmp(dataA, dataB, size) == 0;
+
+		bs_stack_free(dataB);
+		bs_stack_free(dataA);
+
+		return equal;
+	}
+}
@@ -0,0 +1,50 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	class RTTIPlainFieldBase;
+
+	/** @addtogroup Serialization
+	 *  @{
+	 */
+
+	/** Helper class that compares the data of objects that implement RTTI, without serializing them. */
+	class BS_UTILITY_EXPORT BinaryCompare
+	{
+	public:
+		/**
+		 * Checks if the two objects have identical data. Objects are walked field by field through their RTTI,
+		 * comparing plain fields in their serialized form and recursing into referenced objects. Stops as soon as a
+		 * difference is found.
+		 *
+		 * @note	Objects that would serialize into identical data compare equal. Unlike comparing the serialized data
+		 *			directly, objects that reference the same object from multiple fields are also equal to objects that
+		 *			reference separate, but equal, objects.
+		 */
+		static bool isEqual(IReflectable* a, IReflectable* b);
+
+	private:
+		/** Pair of referenced objects, one from each compared object, that have already been compared. */
+		using ObjectPair = std::pair<SPtr<IReflectable>, SPtr<IReflectable>>;
+
+		/** Compares all the fields of two objects of the same type, including the fields of their base classes. */
+		static bool compareObjects(IReflectable* a, IReflectable* b, FrameAlloc& alloc, Set<ObjectPair>& visited);
+
+		/** Compares the values of a single field in two objects, including all of its elements if it is an array. */
+		static bool compareField(RTTIField* field, RTTITypeBase* rttiA, IReflectable* a, RTTITypeBase* rttiB,
+			IReflectable* b, FrameAlloc& alloc, Set<ObjectPair>& visited);
+
+		/**
+		 * Compares the serialized form of a single plain field value, or of a single array element if @p arrayIdx is
+		 * not negative.
+		 */
+		static bool comparePlain(RTTIPlainFieldBase* field, RTTITypeBase* rttiA, IReflectable* a, RTTITypeBase* rttiB,
+			IReflectable* b, INT32 arrayIdx);
+	};
+
+	/** @} */
+}
@@ -44,16 +44,19 @@ namespace bs
 		:mAlloc(&gFrameAlloc())
 	{ }
 
-	void BinarySerializer::encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT32* bytesWritten, 
+	void BinarySerializer::encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT64* totalBytesWritten, 
 		std::function<UINT8*(UINT8*, UINT32, UINT32&)> flushBufferCallback, bool shallow, SerializationContext* context)
 	{
 		mObjectsToEncode.clear();
 		mObjectAddrToId.clear();
 		mLastUsedObjectId = 1;
-		*bytesWritten = 0;
 		mTotalBytesWritten = 0;
 		mContext = context;
 
+		// Number of bytes written to the current buffer, since the last flush
+		UINT32 bufferBytesWritten = 0;
+		UINT32* bytesWritten = &bufferBytesWritten;
+
 		mAlloc->markFrame();
 
 		Vector<SPtr<IReflectable>> encodedObjects;
@@ -114,7 +117,7 @@ namespace bs
 			buffer = flushBufferCallback(buffer - *bytesWritten, *bytesWritten, bufferLength);
 		}
 
-		*bytesWritten = mTotalBytesWritten;
+		*totalBytesWritten = mTotalBytesWritten;
 
 		encodedObjects.clear();
 		mObjectsToEncode.clear();
@@ -123,7 +126,7 @@ namespace bs
 		mAlloc->clear();
 	}
 
-	SPtr<IReflectable> BinarySerializer::decode(const SPtr<DataStream>& data, UINT32 dataLength, 
+	SPtr<IReflectable> BinarySerializer::decode(const SPtr<DataStream>& data, UINT64 dataLength, 
 		SerializationContext* context)
 	{
 		mContext = context;
@@ -132,7 +135,7 @@ namespace bs
 			return nullptr;
 
 		const size_t start = data->tell();
-		const size_t end = start + dataLength;
+		const size_t end = start + (size_t)dataLength;
 		mDecodeObjectMap.clear();
 
 		// Note: Ideally we can avoid iterating twice over the stream data
@@ -283,6 +286,27 @@ namespace bs
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							// Elements stored contiguously in their serialized form can be written all at once
+							if(arrayNumElems > 0 && !curField->hasDynamicSize())
+							{
+								const UINT64 arraySize = (UINT64)arrayNumElems * curField->getTypeSize();
+
+								UINT8* arrayData = (UINT8*)curField->getArrayData(rttiInstance, object);
+								if(arrayData != nullptr && arraySize <= std::numeric_limits<UINT32>::max())
+								{
+									buffer = dataBlockToBuffer(arrayData, (UINT32)arraySize, buffer, bufferLength, 
+										bytesWritten, flushBufferCallback);
+
+									if (buffer == nullptr || bufferLength == 0)
+									{
+										cleanup();
+										return nullptr;
+									}
+
+									break;
+								}
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -390,18 +414,16 @@ namespace bs
 						{
 							RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
 
-							UINT32 dataBlockSize = 0;
+							UINT64 dataBlockSize = 0;
 							SPtr<DataStream> blockStream = curField->getValue(rttiInstance, object, dataBlockSize);
 
 							// Data block size
-							COPY_TO_BUFFER(&dataBlockSize, sizeof(UINT32))
+							UINT8 sizeData[MAX_SIZE_FIELD_SIZE];
+							const UINT32 sizeFieldSize = encodeSize(dataBlockSize, sizeData);
+							COPY_TO_BUFFER(sizeData, sizeFieldSize)
 
 							// Data block data
-							UINT8* dataToStore = (UINT8*)bs_stack_alloc(dataBlockSize);
-							blockStream->read(dataToStore, dataBlockSize);
-
-							buffer = dataBlockToBuffer(dataToStore, dataBlockSize, buffer, bufferLength, bytesWritten, flushBufferCallback);
-							bs_stack_free(dataToStore);
+							buffer = dataBlockToBuffer(*blockStream, dataBlockSize, buffer, bufferLength, bytesWritten, flushBufferCallback);
 
 							if (buffer == nullptr || bufferLength == 0)
 							{
@@ -688,6 +710,22 @@ namespace bs
 				{
 					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+					// Elements stored contiguously in their serialized form can be read all at once
+					if (curField != nullptr && arrayNumElems > 0 && !hasDynamicSize)
+					{
+						void* arrayData = curField->getArrayData(rttiInstance, output.get());
+						if (arrayData != nullptr)
+						{
+							const size_t arraySize = (size_t)arrayNumElems * fieldSize;
+							if (data->read(arrayData, arraySize) != arraySize)
+							{
+								BS_EXCEPT(InternalErrorException, "Error decoding data.");
+							}
+
+							break;
+						}
+					}
+
 					for (int i = 0; i < arrayNumElems; i++)
 					{
 						UINT32 typeSize = fieldSize;
@@ -833,8 +871,8 @@ namespace bs
 					RTTIManagedDataBlockFieldBase* curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
 
 					// Data block size
-					UINT32 dataBlockSize = 0;
-					if(data->read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
+					UINT64 dataBlockSize = 0;
+					if(!decodeSize(*data, dataBlockSize))
 					{
 						BS_EXCEPT(InternalErrorException, "Error decoding data.");
 					}
@@ -848,19 +886,27 @@ namespace bs
 							curField->setValue(rttiInstance, output.get(), data, dataBlockSize);
 
 							// Seek past the data (use original offset in case the field read from the stream)
-							data->seek(dataBlockOffset + dataBlockSize);
+							data->seek(dataBlockOffset + (size_t)dataBlockSize);
+						}
+						else if (data->isMapped()) // Reference the mapped data directly instead of copying it
+						{
+							MappedFileDataStream* mappedData = static_cast<MappedFileDataStream*>(data.get());
+							SPtr<DataStream> stream = mappedData->createView((size_t)dataBlockSize);
+							curField->setValue(rttiInstance, output.get(), stream, dataBlockSize);
+
+							data->skip((size_t)dataBlockSize);
 						}
 						else
 						{
-							UINT8* dataBlockBuffer = (UINT8*)bs_alloc(dataBlockSize);
-							data->read(dataBlockBuffer, dataBlockSize);
+							UINT8* dataBlockBuffer = (UINT8*)bs_alloc((size_t)dataBlockSize);
+							data->read(dataBlockBuffer, (size_t)dataBlockSize);
 
-							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, dataBlockSize);
+							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, (size_t)dataBlockSize);
 							curField->setValue(rttiInstance, output.get(), stream, dataBlockSize);
 						}
 					}
 					else
-						data->skip(dataBlockSize);
+						data->skip((size_t)dataBlockSize);
 
 					break;
 				}
@@ -1013,6 +1059,71 @@ namespace bs
 		return buffer;
 	}
 
+	UINT8* BinarySerializer::dataBlockToBuffer(DataStream& stream, UINT64 size, UINT8* buffer, UINT32& bufferLength, 
+		UINT32* bytesWritten, std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback)
+	{
+		UINT64 remainingSize = size;
+		while (remainingSize > 0)
+		{
+			UINT32 remainingSpaceInBuffer = bufferLength - *bytesWritten;
+			if (remainingSpaceInBuffer == 0)
+			{
+				mTotalBytesWritten += *bytesWritten;
+				buffer = flushBufferCallback(buffer - *bytesWritten, *bytesWritten, bufferLength);
+				if (buffer == nullptr || bufferLength == 0)
+					return nullptr;
+
+				*bytesWritten = 0;
+				continue;
+			}
+
+			const UINT32 chunkSize = (UINT32)std::min(remainingSize, (UINT64)remainingSpaceInBuffer);
+			const size_t numRead = stream.read(buffer, chunkSize);
+
+			// Keep the size of the encoded block consistent even if the stream provided less data than it reported
+			if (numRead < chunkSize)
+				memset(buffer + numRead, 0, chunkSize - numRead);
+
+			buffer += chunkSize;
+			*bytesWritten += chunkSize;
+			remainingSize -= chunkSize;
+		}
+
+		return buffer;
+	}
+
+	UINT32 BinarySerializer::encodeSize(UINT64 size, UINT8* output)
+	{
+		if (size < LARGE_SIZE_MARKER)
+		{
+			const UINT32 smallSize = (UINT32)size;
+			memcpy(output, &smallSize, sizeof(smallSize));
+
+			return sizeof(smallSize);
+		}
+
+		const UINT32 marker = LARGE_SIZE_MARKER;
+		memcpy(output, &marker, sizeof(marker));
+		memcpy(output + sizeof(marker), &size, sizeof(size));
+
+		return MAX_SIZE_FIELD_SIZE;
+	}
+
+	bool BinarySerializer::decodeSize(DataStream& stream, UINT64& size)
+	{
+		UINT32 smallSize = 0;
+		if (stream.read(&smallSize, sizeof(smallSize)) != sizeof(smallSize))
+			return false;
+
+		if (smallSize != LARGE_SIZE_MARKER)
+		{
+			size = smallSize;
+			return true;
+		}
+
+		return stream.read(&size, sizeof(size)) == sizeof(size);
+	}
+
 	UINT32 BinarySerializer::findOrCreatePersistentId(IReflectable* object)
 	{
 		void* ptrAddress = (void*)object;
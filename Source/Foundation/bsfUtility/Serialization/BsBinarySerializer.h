@@ -43,7 +43,7 @@ namespace bs
 		 * @param[in]	object					Object to encode into binary format.
 		 * @param[out]	buffer					Preallocated buffer where the data will be stored.
 		 * @param[in]	bufferLength			Length of the buffer, in bytes.
-		 * @param[out]	bytesWritten			Length of the data that was actually written to the buffer, in bytes.
+		 * @param[out]	totalBytesWritten		Total length of the encoded data, in bytes.
 		 * @param[in]	flushBufferCallback 	This callback will get called whenever the buffer gets full (Be careful to 
 		 *										check the provided @p bytesRead variable, as buffer might not be full 
 		 *										completely). User must then either create a new buffer or empty the existing 
@@ -57,7 +57,7 @@ namespace bs
 		 *										maintaining state or sharing information between objects during 
 		 *										serialization.
 		 */
-		void encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT32* bytesWritten,
+		void encode(IReflectable* object, UINT8* buffer, UINT32 bufferLength, UINT64* totalBytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback,
 			bool shallow = false, SerializationContext* context = nullptr);
 
@@ -70,7 +70,30 @@ namespace bs
 		 *							their deserialization callbacks. Can be used for controlling deserialization, 
 		 *							maintaining state or sharing information between objects during deserialization.
 		 */
-		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT32 dataLength, SerializationContext* context = nullptr);
+		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT64 dataLength, SerializationContext* context = nullptr);
+
+		/**
+		 * Encodes the size of an encoded object or a data block. Sizes that fit in 32 bits are stored as a single UINT32,
+		 * while larger sizes are stored as LARGE_SIZE_MARKER followed by a UINT64. This keeps data encoded before 64-bit
+		 * sizes were supported readable.
+		 *
+		 * @param[in]	size	Size to encode.
+		 * @param[out]	output	Buffer to write the encoded size to. Must be at least MAX_SIZE_FIELD_SIZE bytes large.
+		 * @return				Number of bytes written to @p output.
+		 */
+		static UINT32 encodeSize(UINT64 size, UINT8* output);
+
+		/** 
+		 * Reads a size encoded by encodeSize() from the current position in the stream. Returns false if the stream ended 
+		 * before the size could be read.
+		 */
+		static bool decodeSize(DataStream& stream, UINT64& size);
+
+		/** Value stored in place of a 32-bit size to signal that a 64-bit size follows. */
+		static constexpr const UINT32 LARGE_SIZE_MARKER = 0xFFFFFFFF;
+
+		/** Maximum number of bytes a size encoded by encodeSize() can take up. */
+		static constexpr const int MAX_SIZE_FIELD_SIZE = sizeof(UINT32) + sizeof(UINT64);
 	private:
 		struct ObjectMetaData
 		{
@@ -115,6 +138,13 @@ namespace bs
 		UINT8* dataBlockToBuffer(UINT8* data, UINT32 size, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback);
 
+		/**	
+		 * Helper method for encoding a data block read from a stream to a buffer. Data is read directly into the buffer, 
+		 * one buffer-sized chunk at a time, so the block never needs to be fully loaded in memory.
+		 */
+		UINT8* dataBlockToBuffer(DataStream& stream, UINT64 size, UINT8* buffer, UINT32& bufferLength, 
+			UINT32* bytesWritten, std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback);
+
 		/**	Finds an existing, or creates a unique unique identifier for the specified object. */
 		UINT32 findOrCreatePersistentId(IReflectable* object);
 
@@ -153,7 +183,7 @@ namespace bs
 		Vector<ObjectToEncode> mObjectsToEncode;
 		UnorderedMap<void*, UINT32> mObjectAddrToId;
 		UINT32 mLastUsedObjectId = 1;
-		UINT32 mTotalBytesWritten;
+		UINT64 mTotalBytesWritten;
 		FrameAlloc* mAlloc = nullptr;
 
 		SerializationContext* mContext = nullptr;
@@ -161,7 +191,6 @@ namespace bs
 		static constexpr const int META_SIZE = 4; // Meta field size
 		static constexpr const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static constexpr const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
-		static constexpr const int DATA_BLOCK_TYPE_FIELD_SIZE = 4;
 	};
 
 	// TODO - Potential improvements:
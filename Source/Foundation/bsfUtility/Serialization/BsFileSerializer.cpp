@@ -42,15 +42,19 @@ namespace bs
 		if (object == nullptr)
 			return;
 
+		// Size isn't known until the object is encoded, so always reserve space for the 64-bit version of the size
 		UINT64 curPos = (UINT64)mOutputStream.tellp();
-		mOutputStream.seekp(sizeof(UINT32), std::ios_base::cur);
+		mOutputStream.seekp(BinarySerializer::MAX_SIZE_FIELD_SIZE, std::ios_base::cur);
 
 		BinarySerializer bs;
-		UINT32 totalBytesWritten = 0;
+		UINT64 totalBytesWritten = 0;
 		bs.encode(object, mWriteBuffer, WRITE_BUFFER_SIZE, &totalBytesWritten, 
 			std::bind(&FileEncoder::flushBuffer, this, _1, _2, _3), false, context);
 
+		const UINT32 sizeMarker = BinarySerializer::LARGE_SIZE_MARKER;
+
 		mOutputStream.seekp(curPos);
+		mOutputStream.write((char*)&sizeMarker, sizeof(sizeMarker));
 		mOutputStream.write((char*)&totalBytesWritten, sizeof(totalBytesWritten));
 		mOutputStream.seekp(totalBytesWritten, std::ios_base::cur);
 	}
@@ -65,15 +69,6 @@ namespace bs
 	FileDecoder::FileDecoder(const Path& fileLocation)
 	{
 		mInputStream = FileSystem::openFile(fileLocation, true);
-
-		if (mInputStream == nullptr)
-			return;
-
-		if (mInputStream->size() > std::numeric_limits<UINT32>::max())
-		{
-			BS_EXCEPT(InternalErrorException,
-				"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
-		}
 	}
 
 	SPtr<IReflectable> FileDecoder::decode(SerializationContext* context)
@@ -81,8 +76,9 @@ namespace bs
 		if (mInputStream->eof())
 			return nullptr;
 
-		UINT32 objectSize = 0;
-		mInputStream->read(&objectSize, sizeof(objectSize));
+		UINT64 objectSize = 0;
+		if (!BinarySerializer::decodeSize(*mInputStream, objectSize))
+			return nullptr;
 
 		BinarySerializer bs;
 		SPtr<IReflectable> object = bs.decode(mInputStream, objectSize, context);
@@ -95,8 +91,8 @@ namespace bs
 		if (mInputStream->eof())
 			return;
 
-		UINT32 objectSize = 0;
-		mInputStream->read(&objectSize, sizeof(objectSize));
-		mInputStream->skip(objectSize);
+		UINT64 objectSize = 0;
+		if (BinarySerializer::decodeSize(*mInputStream, objectSize))
+			mInputStream->skip((size_t)objectSize);
 	}
 }
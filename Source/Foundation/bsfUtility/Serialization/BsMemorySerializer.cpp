@@ -11,8 +11,8 @@ using namespace std::placeholders;
 
 namespace bs
 {
-	UINT8* MemorySerializer::encode(IReflectable* object, UINT32& bytesWritten, 
-		std::function<void*(UINT32)> allocator, bool shallow, SerializationContext* context)
+	UINT8* MemorySerializer::encode(IReflectable* object, UINT64& bytesWritten, 
+		std::function<void*(size_t)> allocator, bool shallow, SerializationContext* context)
 	{
 		using namespace std::placeholders;
 
@@ -29,11 +29,11 @@ namespace bs
 
 		UINT8* resultBuffer;
 		if(allocator != nullptr)
-			resultBuffer = (UINT8*)allocator(bytesWritten);
+			resultBuffer = (UINT8*)allocator((size_t)bytesWritten);
 		else
-			resultBuffer = (UINT8*)bs_alloc(bytesWritten);
+			resultBuffer = (UINT8*)bs_alloc((size_t)bytesWritten);
 
-		UINT32 offset = 0;
+		UINT64 offset = 0;
 		for(auto iter = mBufferPieces.begin(); iter != mBufferPieces.end(); ++iter)
 		{
 			if(iter->size > 0)
@@ -53,12 +53,12 @@ namespace bs
 		return resultBuffer;
 	}
 
-	SPtr<IReflectable> MemorySerializer::decode(UINT8* buffer, UINT32 bufferSize, SerializationContext* context)
+	SPtr<IReflectable> MemorySerializer::decode(UINT8* buffer, UINT64 bufferSize, SerializationContext* context)
 	{
-		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(buffer, bufferSize, false);
+		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(buffer, (size_t)bufferSize, false);
 
 		BinarySerializer bs;
-		SPtr<IReflectable> object = bs.decode(stream, (UINT32)bufferSize, context);
+		SPtr<IReflectable> object = bs.decode(stream, bufferSize, context);
 
 		return object;
 	}
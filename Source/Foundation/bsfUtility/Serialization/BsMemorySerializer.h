@@ -43,7 +43,7 @@ namespace bs
 		 * @return						A buffer containing the encoded object. It is up to the user to release the buffer 
 		 *								memory when no longer needed.
 		 */
-		UINT8* encode(IReflectable* object, UINT32& bytesWritten, std::function<void*(UINT32)> allocator = nullptr, 
+		UINT8* encode(IReflectable* object, UINT64& bytesWritten, std::function<void*(size_t)> allocator = nullptr, 
 			bool shallow = false, SerializationContext* context = nullptr);
 
 		/** 
@@ -56,7 +56,7 @@ namespace bs
 		 *							maintaining state or sharing information between objects during 
 		 *							deserialization.
 		 */
-		SPtr<IReflectable> decode(UINT8* buffer, UINT32 bufferSize, SerializationContext* context = nullptr);
+		SPtr<IReflectable> decode(UINT8* buffer, UINT64 bufferSize, SerializationContext* context = nullptr);
 
 	private:
 		Vector<BufferPiece> mBufferPieces;
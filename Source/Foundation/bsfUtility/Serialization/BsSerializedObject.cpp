@@ -517,19 +517,19 @@ namespace bs
 						{
 							auto curField = static_cast<RTTIManagedDataBlockFieldBase*>(curGenericField);
 
-							UINT32 dataBlockSize = 0;
+							UINT64 dataBlockSize = 0;
 							SPtr<DataStream> blockStream = curField->getValue(rttiInstance, object, dataBlockSize);
 
-							auto dataBlockBuffer = (UINT8*)bs_alloc(dataBlockSize);
-							blockStream->read(dataBlockBuffer, dataBlockSize);
+							auto dataBlockBuffer = (UINT8*)bs_alloc((size_t)dataBlockSize);
+							blockStream->read(dataBlockBuffer, (size_t)dataBlockSize);
 
-							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, dataBlockSize);
+							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, (size_t)dataBlockSize);
 
 							SPtr<SerializedDataBlock> serializedDataBlock = bs_shared_ptr_new<SerializedDataBlock>();
 							serializedDataBlock->stream = stream;
 							serializedDataBlock->offset = 0;
 
-							serializedDataBlock->size = dataBlockSize;
+							serializedDataBlock->size = (UINT32)dataBlockSize;
 							serializedEntry = serializedDataBlock;
 
 							break;
@@ -4,138 +4,121 @@
 
 namespace bs
 {
-	const StringID StringID::NONE;
+	/** Number of slots in the table of a shard, when the first string is added to it. Must be a power of two. */
+	static constexpr UINT32 INITIAL_TABLE_SIZE = 256;
 
-	volatile StringID::InitStatics StringID::mInitStatics = StringID::InitStatics();
+	/** Open addressing hash table containing entries of a single shard. */
+	struct StringID::Table
+	{
+		std::atomic<InternalData*>* slots;
+		UINT32 mask;
+		Table* previous;
+	};
+
+	/**
+	 * Part of the string table responsible for a subset of hash values. Entries are only added under the shard's lock,
+	 * while searching only requires the current table to be loaded.
+	 *
+	 * Shards are constant initialized, so string IDs can be safely created during static initialization.
+	 */
+	struct StringID::Shard
+	{
+		std::atomic<Table*> table { nullptr };
+		UINT32 numEntries = 0;
+		SpinLock lock;
+	};
 
-	StringID::InternalData* StringID::mStringHashTable[HASH_TABLE_SIZE];
-	StringID::InternalData* StringID::mChunks[MAX_CHUNK_COUNT];
+	const StringID StringID::NONE;
 
-	UINT32 StringID::mNextId = 0;
-	UINT32 StringID::mNumChunks = 0;
-	SpinLock StringID::mSync;
+	StringID::Shard StringID::mShards[NUM_SHARDS];
+	std::atomic<UINT32> StringID::mNextId { 0 };
 
-	StringID::InitStatics::InitStatics()
+	void StringID::construct(const char* name, UINT32 length, UINT32 hash)
 	{
-		ScopedSpinLock lock(mSync);
+		// Low bits of the hash are used for finding the slot within a table, high bits for picking the shard
+		static_assert(NUM_SHARDS == 16, "Shard selection must match the number of shards.");
+		Shard& shard = mShards[hash >> 28];
 
-		memset(mStringHashTable, 0, sizeof(mStringHashTable));
-		memset(mChunks, 0, sizeof(mChunks));
+		mData = find(shard.table.load(std::memory_order_acquire), name, length, hash);
+		if (mData != nullptr)
+			return;
 
-		mChunks[0] = (InternalData*)bs_alloc(sizeof(InternalData) * ELEMENTS_PER_CHUNK);
-		memset(mChunks[0], 0, sizeof(InternalData) * ELEMENTS_PER_CHUNK);
+		ScopedSpinLock lock(shard.lock);
 
-		mNumChunks++;
+		// Search for the value again in case other thread just added it
+		Table* table = shard.table.load(std::memory_order_relaxed);
+		mData = find(table, name, length, hash);
+		if (mData != nullptr)
+			return;
+
+		// Keep the load factor under one half, so probe sequences stay short
+		if (table == nullptr || (shard.numEntries + 1) * 2 > table->mask + 1)
+			table = grow(shard);
+
+		auto entry = (InternalData*)bs_alloc(sizeof(InternalData) + length);
+		entry->id = mNextId.fetch_add(1, std::memory_order_relaxed);
+		entry->hash = hash;
+		entry->length = length;
+		memcpy(entry->chars, name, length);
+		entry->chars[length] = '\0';
+
+		insert(table, entry);
+		shard.numEntries++;
+
+		mData = entry;
 	}
 
-	template<class T>
-	void StringID::construct(T const& name)
+	StringID::InternalData* StringID::find(const Table* table, const char* name, UINT32 length, UINT32 hash)
 	{
-		assert(StringIDUtil<T>::size(name) <= STRING_SIZE);
+		if (table == nullptr)
+			return nullptr;
 
-		UINT32 hash = calcHash(name) & (sizeof(mStringHashTable) / sizeof(mStringHashTable[0]) - 1);
-		InternalData* existingEntry = mStringHashTable[hash];
-		
-		while (existingEntry != nullptr)
+		for (UINT32 i = hash & table->mask; ; i = (i + 1) & table->mask)
 		{
-			if (StringIDUtil<T>::compare(name, existingEntry->chars))
-			{
-				mData = existingEntry;
-				return;
-			}
+			InternalData* entry = table->slots[i].load(std::memory_order_acquire);
+			if (entry == nullptr)
+				return nullptr;
 
-			existingEntry = existingEntry->next;
+			if (entry->hash == hash && entry->length == length && memcmp(entry->chars, name, length) == 0)
+				return entry;
 		}
-
-		ScopedSpinLock lock(mSync);
-
-		// Search for the value again in case other thread just added it
-		existingEntry = mStringHashTable[hash];
-		InternalData* lastEntry = nullptr;
-		while (existingEntry != nullptr)
-		{
-			if (StringIDUtil<T>::compare(name, existingEntry->chars))
-			{
-				mData = existingEntry;
-				return;
-			}
-
-			lastEntry = existingEntry;
-			existingEntry = existingEntry->next;
-		}
-
-		mData = allocEntry();
-		StringIDUtil<T>::copy(name, mData->chars);
-
-		if (lastEntry == nullptr)
-			mStringHashTable[hash] = mData;
-		else
-			lastEntry->next = mData;
 	}
 
-	template<class T>
-	UINT32 StringID::calcHash(T const& input)
+	void StringID::insert(Table* table, InternalData* entry)
 	{
-		UINT32 size = StringIDUtil<T>::size(input);
-
-		UINT32 hash = 0;
-		for (UINT32 i = 0; i < size; i++)
-			hash = hash * 101 + input[i];
+		UINT32 i = entry->hash & table->mask;
+		while (table->slots[i].load(std::memory_order_relaxed) != nullptr)
+			i = (i + 1) & table->mask;
 
-		return hash;
+		table->slots[i].store(entry, std::memory_order_release);
 	}
 
-	StringID::InternalData* StringID::allocEntry()
+	StringID::Table* StringID::grow(Shard& shard)
 	{
-		UINT32 chunkIdx = mNextId / ELEMENTS_PER_CHUNK;
+		Table* oldTable = shard.table.load(std::memory_order_relaxed);
+		const UINT32 size = oldTable != nullptr ? (oldTable->mask + 1) * 2 : INITIAL_TABLE_SIZE;
 
-		assert(chunkIdx < MAX_CHUNK_COUNT);
-		assert(chunkIdx <= mNumChunks); // Can only increment sequentially
+		auto table = bs_new<Table>();
+		table->slots = (std::atomic<InternalData*>*)bs_alloc(sizeof(std::atomic<InternalData*>) * size);
+		table->mask = size - 1;
+		table->previous = oldTable;
 
-		if (chunkIdx >= mNumChunks)
-		{
-			mChunks[chunkIdx] = (InternalData*)bs_alloc(sizeof(InternalData) * ELEMENTS_PER_CHUNK);
-			memset(mChunks[chunkIdx], 0, sizeof(InternalData) * ELEMENTS_PER_CHUNK);
+		for (UINT32 i = 0; i < size; i++)
+			new (&table->slots[i]) std::atomic<InternalData*>(nullptr);
 
-			mNumChunks++;
+		if (oldTable != nullptr)
+		{
+			for (UINT32 i = 0; i <= oldTable->mask; i++)
+			{
+				InternalData* entry = oldTable->slots[i].load(std::memory_order_relaxed);
+				if (entry != nullptr)
+					insert(table, entry);
+			}
 		}
 
-		InternalData* chunk = mChunks[chunkIdx];
-		UINT32 chunkSpecificIndex = mNextId % ELEMENTS_PER_CHUNK;
-
-		InternalData* newEntry = &chunk[chunkSpecificIndex];
-		newEntry->id = mNextId++;
-		newEntry->next = nullptr;
-
-		return newEntry;
+		// Entries are never removed, so searches in the old table either find the entry, or fall through to the locked
+		// search in the new table
+		shard.table.store(table, std::memory_order_release);
+		return table;
 	}
-
-	template<>
-	class StringID::StringIDUtil<const char*>
-	{
-	public:
-		static UINT32 size(const char* const& input) { return (UINT32)strlen(input); }
-		static void copy(const char* const& input, char* dest) { memcpy(dest, input, strlen(input) + 1); }
-		static bool compare(const char* const& a, char* b) { return strcmp(a, b) == 0; }
-	};
-
-	template<>
-	class StringID::StringIDUtil <String>
-	{
-	public:
-		static UINT32 size(String const& input) { return (UINT32)input.length(); }
-		static void copy(String const& input, char* dest)
-		{ 
-			UINT32 len = (UINT32)input.length();
-			input.copy(dest, len);
-			dest[len] = '\0';
-		}
-		static bool compare(String const& a, char* b) { return a.compare(b) == 0; }
-	};
-
-	template BS_UTILITY_EXPORT void StringID::construct(const char* const&);
-	template BS_UTILITY_EXPORT void StringID::construct(String const&);
-	
-	template BS_UTILITY_EXPORT UINT32 StringID::calcHash(const char* const&);
-	template BS_UTILITY_EXPORT UINT32 StringID::calcHash(String const&);
 }
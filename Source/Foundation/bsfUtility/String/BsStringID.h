@@ -19,56 +19,53 @@ namespace bs
 	 * Essentially a unique ID is generated for each string and then the ID is used for comparisons as if you were using 
 	 * an integer or an enum.
 	 * @note
-	 * Thread safe.
+	 * Thread safe. Looking up strings that were already added is lock free, and adding new strings only locks a single
+	 * shard of the string table, out of many. There is no limit on the number or the length of the strings.
 	 */
 	class BS_UTILITY_EXPORT StringID
 	{
-		static constexpr const int HASH_TABLE_SIZE = 4096;
-		static constexpr const int MAX_CHUNK_COUNT = 50;
-		static constexpr const int ELEMENTS_PER_CHUNK = 256;
-		static constexpr const int STRING_SIZE = 256;
-
-		/** Helper class that performs string actions on both null terminated character arrays and standard strings. */
-		template<class T>
-		class StringIDUtil
-		{
-		public:
-			static UINT32 size(T const& input) { return 0; }
-			static void copy(T const& input, char* dest) { }
-			static bool compare(T const& a, char* b) { return 0; }
-		};
+		/** Number of independently locked shards the string table is split into. Must be a power of two. */
+		static constexpr UINT32 NUM_SHARDS = 16;
 
 		/**	Internal data that is shared by all instances for a specific string. */
 		struct InternalData
 		{
 			UINT32 id;
-			InternalData* next;
-			char chars[STRING_SIZE];
+			UINT32 hash;
+			UINT32 length;
+			char chars[1]; // Null terminated, allocated together with the rest of the structure
 		};
 
-		/**	Performs initialization of static members as soon as the library is loaded. */
-		struct InitStatics
-		{
-			InitStatics();
-		};
+		struct Table;
+		struct Shard;
 
 	public:
-		StringID() = default;
+		constexpr StringID() = default;
 
 		StringID(const char* name)
 		{
-			construct(name);
+			const auto length = (UINT32)strlen(name);
+			construct(name, length, calcHash(name, length));
 		}
 
 		StringID(const String& name)
 		{
-			construct(name);
+			construct(name.data(), (UINT32)name.length(), calcHash(name.data(), (UINT32)name.length()));
+		}
+
+		/** Creates a string identifier from the first @p length characters of @p name. */
+		StringID(const char* name, UINT32 length)
+		{
+			construct(name, length, calcHash(name, length));
 		}
 
-		template<int N>
-		StringID(const char name[N])
+		/** 
+		 * Creates a string identifier from a string whose hash was already calculated using calcHash() (usually at
+		 * compile time, see BS_SID).
+		 */
+		StringID(const char* name, UINT32 length, UINT32 hash)
 		{
-			construct((const char*)name);
+			construct(name, length, hash);
 		}
 
 		/**	Compare to string ids for equality. Uses fast integer comparison. */
@@ -98,37 +95,60 @@ namespace bs
 			return mData->chars;
 		}
 
+		/** Returns the number of characters in the name of the string id. */
+		UINT32 length() const { return mData ? mData->length : 0; }
+
 		/** Returns the unique identifier of the string. */
 		UINT32 id() const { return mData ? mData->id : -1; }
 
+		/** Calculates the hash of a string, as used by the string table. Can be evaluated at compile time. */
+		static constexpr UINT32 calcHash(const char* input, UINT32 length)
+		{
+			// FNV-1a
+			UINT32 hash = 2166136261u;
+			for (UINT32 i = 0; i < length; i++)
+			{
+				hash ^= (UINT8)input[i];
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
 		static const StringID NONE;
 
 	private:
-		/**Constructs a StringID object in a way that works for pointers to character arrays and standard strings. */
-		template<class T>
-		void construct(T const& name);
+		/**
+		 * Finds the entry for the provided string in the string table, or adds a new one if it doesn't exist, and
+		 * assigns it to this object.
+		 */
+		void construct(const char* name, UINT32 length, UINT32 hash);
+
+		/** Searches for the entry with the provided string in a table of a shard. Returns null if not found. */
+		static InternalData* find(const Table* table, const char* name, UINT32 length, UINT32 hash);
 
-		/**	Calculates a hash value for the provided null-terminated string. */
-		template<class T>
-		UINT32 calcHash(T const& input);
+		/** Inserts a new entry into a table of a shard. Caller must guarantee the table has a free slot. */
+		static void insert(Table* table, InternalData* entry);
 
 		/**
-		 * Allocates a new string entry and assigns it a unique ID. Optionally expands the chunks buffer if the new entry 
-		 * doesn't fit.
+		 * Replaces the table of the shard with a new one double the size, and copies all the entries. The old table
+		 * is kept alive, since other threads might still be searching through it.
 		 */
-		InternalData* allocEntry();
+		static Table* grow(Shard& shard);
 
 		InternalData* mData = nullptr;
 
-		static volatile InitStatics mInitStatics;
-		static InternalData* mStringHashTable[HASH_TABLE_SIZE];
-		static InternalData* mChunks[MAX_CHUNK_COUNT];
-
-		static UINT32 mNextId;
-		static UINT32 mNumChunks;
-		static SpinLock mSync;
+		static Shard mShards[NUM_SHARDS];
+		static std::atomic<UINT32> mNextId;
 	};
 
+	/** 
+	 * Creates a StringID from a string literal, with the literal's hash calculated at compile time. Prefer over
+	 * constructing from a literal directly in code that creates string IDs often.
+	 */
+#define BS_SID(literal) bs::StringID(literal, (bs::UINT32)(sizeof(literal) - 1), \
+	std::integral_constant<bs::UINT32, bs::StringID::calcHash(literal, (bs::UINT32)(sizeof(literal) - 1))>::value)
+
 	/** @cond SPECIALIZATIONS */
 
 	template<> struct RTTIPlainType <StringID>
@@ -147,10 +167,7 @@ namespace bs
 			memory = rttiWriteElem(isEmpty, memory);
 
 			if (!isEmpty)
-			{
-				UINT32 length = (UINT32)strlen(data.c_str());
-				memcpy(memory, data.c_str(), length * sizeof(char));
-			}
+				memcpy(memory, data.c_str(), data.length() * sizeof(char));
 		}
 
 		static UINT32 fromMemory(StringID& data, char* memory)
@@ -165,13 +182,7 @@ namespace bs
 			if (!empty)
 			{
 				UINT32 length = (size - sizeof(UINT32) - sizeof(bool)) / sizeof(char);
-
-				auto name = (char*)bs_stack_alloc(length + 1);
-				memcpy(name, memory, length);
-				name[length] = '\0';
-
-				data = StringID(name);
-				bs_stack_free(name);
+				data = StringID(memory, length);
 			}
 
 			return size;
@@ -183,10 +194,7 @@ namespace bs
 
 			bool isEmpty = data.empty();
 			if (!isEmpty)
-			{
-				UINT32 length = (UINT32)strlen(data.c_str());
-				dataSize += length * sizeof(char);
-			}
+				dataSize += data.length() * sizeof(char);
 
 			return (UINT32)dataSize;
 		}
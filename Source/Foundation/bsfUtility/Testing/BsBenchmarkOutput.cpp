@@ -0,0 +1,107 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Testing/BsBenchmarkOutput.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "ThirdParty/json.hpp"
+
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace bs
+{
+	void JSONBenchmarkOutput::outputFail(const String& desc, const String& function, const String& file, long line)
+	{
+		std::cout << file << ":" << line << ": failure: " << desc << std::endl;
+	}
+
+	void JSONBenchmarkOutput::outputBenchmark(const BenchmarkResult& result)
+	{
+		mResults.push_back(result);
+	}
+
+	String JSONBenchmarkOutput::toJSON() const
+	{
+		json entries = json::array();
+		for(auto& entry : mResults)
+		{
+			json jsonEntry =
+			{
+				{ "name", entry.name.c_str() },
+				{ "iterations", entry.numIterations },
+				{ "opsPerIteration", entry.opsPerIteration },
+				{ "meanNs", entry.meanNs },
+				{ "medianNs", entry.medianNs },
+				{ "minNs", entry.minNs },
+				{ "maxNs", entry.maxNs },
+				{ "stdDevNs", entry.stdDevNs },
+				{ "p95Ns", entry.p95Ns }
+			};
+
+			entries.push_back(jsonEntry);
+		}
+
+		json root = { { "benchmarks", entries } };
+		return root.dump(4).c_str();
+	}
+
+	bool JSONBenchmarkOutput::save(const Path& path) const
+	{
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+		if(stream == nullptr || !stream->isWriteable())
+			return false;
+
+		const String contents = toJSON();
+		const size_t written = stream->write(contents.data(), contents.size());
+		stream->close();
+
+		return written == contents.size();
+	}
+
+	bool JSONBenchmarkOutput::compare(const Path& baseline, Vector<BenchmarkComparison>& output) const
+	{
+		if(!FileSystem::isFile(baseline))
+			return false;
+
+		SPtr<DataStream> stream = FileSystem::openFile(baseline);
+		if(stream == nullptr)
+			return false;
+
+		json root = json::parse(stream->getAsString().c_str(), nullptr, false);
+		if(root.is_discarded() || !root.is_object())
+			return false;
+
+		auto iterFind = root.find("benchmarks");
+		if(iterFind == root.end() || !iterFind->is_array())
+			return false;
+
+		UnorderedMap<String, double> baselineTimes;
+		for(auto& entry : *iterFind)
+		{
+			auto iterName = entry.find("name");
+			auto iterTime = entry.find("medianNs");
+			if(iterName == entry.end() || iterTime == entry.end() || !iterName->is_string() || !iterTime->is_number())
+				continue;
+
+			baselineTimes[iterName->get<std::string>().c_str()] = iterTime->get<double>();
+		}
+
+		for(auto& entry : mResults)
+		{
+			auto iterBaseline = baselineTimes.find(entry.name);
+			if(iterBaseline == baselineTimes.end())
+				continue;
+
+			BenchmarkComparison comparison;
+			comparison.name = entry.name;
+			comparison.baselineNs = iterBaseline->second;
+			comparison.currentNs = entry.medianNs;
+			comparison.ratio = comparison.baselineNs > 0.0 ? comparison.currentNs / comparison.baselineNs : 1.0;
+
+			output.push_back(comparison);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,67 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Testing/BsTestOutput.h"
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Testing
+	 *  @{
+	 */
+
+	/** Comparison of a single benchmark against its baseline, as returned by JSONBenchmarkOutput::compare(). */
+	struct BenchmarkComparison
+	{
+		/** Name of the benchmark. */
+		String name;
+
+		/** Median time per operation recorded in the baseline, in nanoseconds. */
+		double baselineNs = 0.0;
+
+		/** Median time per operation measured in the current run, in nanoseconds. */
+		double currentNs = 0.0;
+
+		/** Ratio of the current time to the baseline time. Values above one mean the benchmark got slower. */
+		double ratio = 1.0;
+	};
+
+	/**
+	 * Collects benchmark results so they can be saved as JSON, and compared against results saved by a previous run.
+	 * Unit test failures are printed to stdout.
+	 */
+	class BS_UTILITY_EXPORT JSONBenchmarkOutput : public TestOutput
+	{
+	public:
+		/** @copydoc TestOutput::outputFail */
+		void outputFail(const String& desc, const String& function, const String& file, long line) override;
+
+		/** @copydoc TestOutput::outputBenchmark */
+		void outputBenchmark(const BenchmarkResult& result) override;
+
+		/** Returns all results collected so far. */
+		const Vector<BenchmarkResult>& getResults() const { return mResults; }
+
+		/** Returns all results collected so far, as a JSON document. */
+		String toJSON() const;
+
+		/** Saves the results collected so far as JSON. Returns false if the file cannot be written to. */
+		bool save(const Path& path) const;
+
+		/**
+		 * Compares the results collected so far against results previously saved with save(). Benchmarks are matched
+		 * by name and compared by their median times. Benchmarks missing from the baseline are not reported.
+		 *
+		 * @param[in]	baseline	Path to the JSON file containing the baseline results.
+		 * @param[out]	output		Comparison of every benchmark present in the baseline.
+		 * @return					False if the baseline cannot be read or parsed.
+		 */
+		bool compare(const Path& baseline, Vector<BenchmarkComparison>& output) const;
+
+	private:
+		Vector<BenchmarkResult> mResults;
+	};
+
+	/** @} */
+}
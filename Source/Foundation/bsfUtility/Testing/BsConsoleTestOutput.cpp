@@ -13,4 +13,13 @@ namespace bs
 	{
 		std::cout << file << ":" << line << ": failure: " << desc << std::endl;
 	}
+
+	void ConsoleTestOutput::outputBenchmark(const BenchmarkResult& result)
+	{
+		char output[256];
+		snprintf(output, sizeof(output), "%-40s median %12.2f ns  mean %12.2f ns  p95 %12.2f ns  stddev %10.2f ns",
+			result.name.c_str(), result.medianNs, result.meanNs, result.p95Ns, result.stdDevNs);
+
+		std::cout << output << std::endl;
+	}
 }
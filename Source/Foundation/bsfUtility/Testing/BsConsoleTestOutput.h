@@ -20,6 +20,9 @@ namespace bs
 		                const String& function,
 		                const String& file,
 		                long line) final override;
+
+		/** @copydoc TestOutput::outputBenchmark */
+		void outputBenchmark(const BenchmarkResult& result) override;
 	};
 
 	/** @} */
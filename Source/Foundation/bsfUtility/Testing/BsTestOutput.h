@@ -10,6 +10,26 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Measurements of a single benchmark ran by TestSuite::runBenchmarks(). All times are per operation. */
+	struct BenchmarkResult
+	{
+		/** Name of the benchmark. */
+		String name;
+
+		/** Number of timed iterations the statistics were calculated from. */
+		UINT32 numIterations = 0;
+
+		/** Number of operations performed by a single iteration. Times are divided by this value. */
+		UINT32 opsPerIteration = 1;
+
+		double meanNs = 0.0;
+		double medianNs = 0.0;
+		double minNs = 0.0;
+		double maxNs = 0.0;
+		double stdDevNs = 0.0;
+		double p95Ns = 0.0;
+	};
+
 	/** Abstract interface used for outputting unit test results. */
 	class BS_UTILITY_EXPORT TestOutput
 	{
@@ -25,6 +45,9 @@ namespace bs
 		 * @param[in]	line		Line of code the unit test failed on.
 		 */
 		virtual void outputFail(const String& desc, const String& function, const String& file, long line) = 0;
+
+		/** Triggered when a benchmark finishes running. Ignored by default. */
+		virtual void outputBenchmark(const BenchmarkResult& result) {}
 	};
 
 	/** Outputs unit test results so that failures are reported as exceptions. Success is not reported. */
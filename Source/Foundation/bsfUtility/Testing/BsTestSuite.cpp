@@ -2,13 +2,63 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Testing/BsTestSuite.h"
 #include "Testing/BsTestOutput.h"
+#include <chrono>
 
 namespace bs
 {
+	namespace
+	{
+		/** Calculates statistics of the provided iteration times. Times are reordered in the process. */
+		BenchmarkResult calculateResult(const String& name, Vector<double>& timesNs, UINT32 opsPerIteration)
+		{
+			BenchmarkResult result;
+			result.name = name;
+			result.numIterations = (UINT32)timesNs.size();
+			result.opsPerIteration = opsPerIteration;
+
+			if(timesNs.empty())
+				return result;
+
+			for(auto& entry : timesNs)
+				entry /= opsPerIteration;
+
+			std::sort(timesNs.begin(), timesNs.end());
+
+			double sum = 0.0;
+			for(auto& entry : timesNs)
+				sum += entry;
+
+			result.meanNs = sum / timesNs.size();
+
+			double variance = 0.0;
+			for(auto& entry : timesNs)
+				variance += (entry - result.meanNs) * (entry - result.meanNs);
+
+			result.stdDevNs = std::sqrt(variance / timesNs.size());
+
+			const size_t count = timesNs.size();
+			result.minNs = timesNs.front();
+			result.maxNs = timesNs.back();
+			result.medianNs = timesNs[count / 2];
+			if((count % 2) == 0)
+				result.medianNs = (result.medianNs + timesNs[count / 2 - 1]) * 0.5;
+
+			result.p95Ns = timesNs[std::max((count * 95 + 99) / 100, (size_t)1) - 1];
+
+			return result;
+		}
+	}
+
+	const void* volatile TestSuite::sBenchmarkSink = nullptr;
+
 	TestSuite::TestEntry::TestEntry(Func test, const String& name)
 		:test(test), name(name)
 	{ }
 
+	TestSuite::BenchmarkEntry::BenchmarkEntry(Func benchmark, const String& name, UINT32 opsPerIteration)
+		:benchmark(benchmark), name(name), opsPerIteration(std::max(opsPerIteration, 1U))
+	{ }
+
 	void TestSuite::run(TestOutput& output)
 	{
 		mOutput = &output;
@@ -30,6 +80,46 @@ namespace bs
 		shutDown();
 	}
 
+	void TestSuite::runBenchmarks(TestOutput& output, const BenchmarkOptions& options)
+	{
+		using namespace std::chrono;
+
+		mOutput = &output;
+
+		startUp();
+
+		Vector<double> timesNs;
+		for (auto& entry : mBenchmarks)
+		{
+			if (!options.filter.empty() && entry.name.find(options.filter) == String::npos)
+				continue;
+
+			mActiveTestName = entry.name;
+
+			for (UINT32 i = 0; i < options.numWarmupIterations; i++)
+				(this->*(entry.benchmark))();
+
+			timesNs.resize(options.numIterations);
+			for (UINT32 i = 0; i < options.numIterations; i++)
+			{
+				const auto start = steady_clock::now();
+				(this->*(entry.benchmark))();
+				const auto end = steady_clock::now();
+
+				timesNs[i] = (double)duration_cast<nanoseconds>(end - start).count();
+			}
+
+			output.outputBenchmark(calculateResult(entry.name, timesNs, entry.opsPerIteration));
+		}
+
+		for (auto& suite : mSuites)
+		{
+			suite->runBenchmarks(output, options);
+		}
+
+		shutDown();
+	}
+
 	void TestSuite::add(const SPtr<TestSuite>& suite)
 	{
 		mSuites.push_back(suite);
@@ -40,6 +130,11 @@ namespace bs
 		mTests.push_back(TestEntry(test, name));
 	}
 
+	void TestSuite::addBenchmark(Func benchmark, const String& name, UINT32 opsPerIteration)
+	{
+		mBenchmarks.push_back(BenchmarkEntry(benchmark, name, opsPerIteration));
+	}
+
 	void TestSuite::assertment(bool success, const String& desc, const String& file, long line)
 	{
 		if (!success)
@@ -4,8 +4,6 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 
-
-
 namespace bs
 {
 	/** @addtogroup Testing
@@ -18,6 +16,19 @@ namespace bs
 /** Tests if condition is true, and reports unit test failure with a message if it fails. */
 #define BS_TEST_ASSERT_MSG(expr, msg) assertment((expr), msg, __FILE__, __LINE__); 
 
+	/** Controls how are benchmarks ran by TestSuite::runBenchmarks(). */
+	struct BenchmarkOptions
+	{
+		/** Number of iterations ran before the timed iterations, in order to warm up the caches. */
+		UINT32 numWarmupIterations = 10;
+
+		/** Number of timed iterations the statistics are calculated from. */
+		UINT32 numIterations = 100;
+
+		/** If not empty, only benchmarks whose name contains this string are ran. */
+		String filter;
+	};
+
 	/**
 	 * Primary class for unit testing. Override and register unit tests in constructor then run the tests using the 
 	 * desired method of output.
@@ -37,12 +48,29 @@ namespace bs
 			String name;
 		};
 
+		/** Contains data about a single benchmark. */
+		struct BenchmarkEntry
+		{
+			BenchmarkEntry(Func benchmark, const String& name, UINT32 opsPerIteration);
+
+			Func benchmark;
+			String name;
+			UINT32 opsPerIteration;
+		};
+
 	public:
 		virtual ~TestSuite() = default;
 
 		/** Runs all the tests in the suite (and sub-suites). Tests results are reported to the provided output class. */
 		void run(TestOutput& output);
 
+		/**
+		 * Runs all the benchmarks in the suite (and sub-suites). Each benchmark is first ran for a number of warmup
+		 * iterations, after which every iteration is timed separately. Statistics of the timed iterations are reported
+		 * to the provided output class.
+		 */
+		void runBenchmarks(TestOutput& output, const BenchmarkOptions& options = BenchmarkOptions());
+
 		/** Adds a new child suite to this suite. This method allows you to group suites and execute them all at once. */
 		void add(const SPtr<TestSuite>& suite);
 
@@ -72,6 +100,31 @@ namespace bs
 		 */
 		void addTest(Func test, const String& name);
 
+		/**
+		 * Register a new benchmark.
+		 *
+		 * @param[in]	benchmark			Function to call in order to execute a single iteration of the benchmark.
+		 * @param[in]	name				Name of the benchmark we can use for referencing it later.
+		 * @param[in]	opsPerIteration		Number of operations performed by a single iteration. Reported times are
+		 *									divided by this value, so fast operations can be repeated enough times to
+		 *									be measurable.
+		 */
+		void addBenchmark(Func benchmark, const String& name, UINT32 opsPerIteration = 1);
+
+		/**
+		 * Prevents the compiler from optimizing away the computation of @p value, so benchmarks can discard their
+		 * results.
+		 */
+		template<class T>
+		static void doNotOptimize(const T& value)
+		{
+#if BS_COMPILER == BS_COMPILER_GNUC || BS_COMPILER == BS_COMPILER_CLANG
+			asm volatile("" : : "r"(&value) : "memory");
+#else
+			sBenchmarkSink = &value;
+#endif
+		}
+
 		/**
 		 * Reports success or failure depending on the result of an expression.
 		 *
@@ -83,15 +136,22 @@ namespace bs
 		void assertment(bool success, const String& desc, const String& file, long line);
 
 		Vector<TestEntry> mTests;
+		Vector<BenchmarkEntry> mBenchmarks;
 		Vector<SPtr<TestSuite>> mSuites;
 
 		// Transient
 		TestOutput* mOutput = nullptr;
 		String mActiveTestName;
+
+	private:
+		static const void* volatile sBenchmarkSink;
 	};
 
 /** Registers a new unit test within an implementation of TestSuite. */
 #define BS_ADD_TEST(func) addTest(static_cast<Func>(&func), #func);
 
+/** Registers a new benchmark within an implementation of TestSuite, performing @p ops operations per iteration. */
+#define BS_ADD_BENCHMARK(func, ops) addBenchmark(static_cast<Func>(&func), #func, ops);
+
 	/** @} */
 }
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsAsyncOp.h"
 #include "Debug/BsDebug.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
@@ -10,9 +11,20 @@ namespace bs
 		return mData->mIsCompleted.load(std::memory_order_acquire);
 	}
 
+	float AsyncOp::getProgress() const
+	{
+		return mData->mProgress.load(std::memory_order_relaxed);
+	}
+
+	void AsyncOp::_setProgress(float progress)
+	{
+		mData->mProgress.store(Math::clamp01(progress), std::memory_order_relaxed);
+	}
+
 	void AsyncOp::_completeOperation(Any returnValue) 
 	{ 
 		mData->mReturnValue = returnValue; 
+		mData->mProgress.store(1.0f, std::memory_order_relaxed);
 		mData->mIsCompleted.store(true, std::memory_order_release);
 
 		if (mSyncData != nullptr)
@@ -21,6 +33,7 @@ namespace bs
 
 	void AsyncOp::_completeOperation() 
 	{ 
+		mData->mProgress.store(1.0f, std::memory_order_relaxed);
 		mData->mIsCompleted.store(true, std::memory_order_release);
 
 		if (mSyncData != nullptr)
@@ -57,6 +57,7 @@ namespace bs
 
 			Any mReturnValue;
 			volatile std::atomic<bool> mIsCompleted{false};
+			std::atomic<float> mProgress{0.0f};
 		};
 
 	public:
@@ -78,6 +79,12 @@ namespace bs
 		/** Returns true if the async operation has completed. */
 		bool hasCompleted() const;
 
+		/** 
+		 * Returns the progress of the async operation, in range [0, 1]. Only operations that explicitly report their
+		 * progress will report values other than 0 until they complete.
+		 */
+		float getProgress() const;
+
 		/**
 		 * Blocks the caller thread until the AsyncOp completes.
 		 *
@@ -117,6 +124,9 @@ namespace bs
 		/** Mark the async operation as completed, without setting a return value. */
 		void _completeOperation();
 
+		/** Updates the progress of the async operation, in range [0, 1]. Can be called from any thread. */
+		void _setProgress(float progress);
+
 		/** @} */
 	private:
 		friend bool operator==(const AsyncOp&, std::nullptr_t);
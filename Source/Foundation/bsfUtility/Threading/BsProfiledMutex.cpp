@@ -0,0 +1,180 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Threading/BsProfiledMutex.h"
+
+namespace bs
+{
+	struct LockProfiler::Counters
+	{
+		const char* name = nullptr;
+		std::atomic<UINT64> numAcquisitions{0};
+		std::atomic<UINT64> numContended{0};
+		std::atomic<UINT64> totalWaitNs{0};
+		std::atomic<UINT64> maxWaitNs{0};
+		std::atomic<UINT64> totalHoldNs{0};
+		std::atomic<UINT64> maxHoldNs{0};
+		std::atomic<UINT64> numSignalWaits{0};
+		std::atomic<UINT64> totalSignalWaitNs{0};
+	};
+
+	namespace
+	{
+		/** Counters of all mutex names, along with the mutex protecting the list. */
+		struct LockRegistry
+		{
+			Mutex mutex;
+			List<LockProfiler::Counters> counters;
+		};
+
+		/**
+		 * Returns the global registry. Never destroyed, since mutexes that outlive the statics (e.g. the ones used by
+		 * FileScheduler) can be locked after other statics have already been destroyed.
+		 */
+		LockRegistry& getRegistry()
+		{
+			static LockRegistry* registry = new LockRegistry();
+			return *registry;
+		}
+
+		/** Raises @p counter to @p value, if @p value is larger. */
+		void updateMax(std::atomic<UINT64>& counter, UINT64 value)
+		{
+			UINT64 current = counter.load(std::memory_order_relaxed);
+			while(value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{ }
+		}
+
+		/** Returns the current time, in nanoseconds. */
+		UINT64 getTimestamp()
+		{
+			using namespace std::chrono;
+			return (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		}
+	}
+
+	Vector<LockProfileStats> LockProfiler::getStats()
+	{
+		Vector<LockProfileStats> output;
+
+		LockRegistry& registry = getRegistry();
+		{
+			Lock lock(registry.mutex);
+
+			output.reserve(registry.counters.size());
+			for(auto& entry : registry.counters)
+			{
+				LockProfileStats stats;
+				stats.name = entry.name;
+				stats.numAcquisitions = entry.numAcquisitions.load(std::memory_order_relaxed);
+				stats.numContended = entry.numContended.load(std::memory_order_relaxed);
+				stats.totalWaitNs = entry.totalWaitNs.load(std::memory_order_relaxed);
+				stats.maxWaitNs = entry.maxWaitNs.load(std::memory_order_relaxed);
+				stats.totalHoldNs = entry.totalHoldNs.load(std::memory_order_relaxed);
+				stats.maxHoldNs = entry.maxHoldNs.load(std::memory_order_relaxed);
+				stats.numSignalWaits = entry.numSignalWaits.load(std::memory_order_relaxed);
+				stats.totalSignalWaitNs = entry.totalSignalWaitNs.load(std::memory_order_relaxed);
+
+				output.push_back(stats);
+			}
+		}
+
+		std::sort(output.begin(), output.end(),
+			[](const LockProfileStats& a, const LockProfileStats& b) { return a.totalWaitNs > b.totalWaitNs; });
+
+		return output;
+	}
+
+	void LockProfiler::reset()
+	{
+		LockRegistry& registry = getRegistry();
+		Lock lock(registry.mutex);
+
+		for(auto& entry : registry.counters)
+		{
+			entry.numAcquisitions.store(0, std::memory_order_relaxed);
+			entry.numContended.store(0, std::memory_order_relaxed);
+			entry.totalWaitNs.store(0, std::memory_order_relaxed);
+			entry.maxWaitNs.store(0, std::memory_order_relaxed);
+			entry.totalHoldNs.store(0, std::memory_order_relaxed);
+			entry.maxHoldNs.store(0, std::memory_order_relaxed);
+			entry.numSignalWaits.store(0, std::memory_order_relaxed);
+			entry.totalSignalWaitNs.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	LockProfiler::Counters* LockProfiler::_getCounters(const char* name)
+	{
+		LockRegistry& registry = getRegistry();
+		Lock lock(registry.mutex);
+
+		for(auto& entry : registry.counters)
+		{
+			if(strcmp(entry.name, name) == 0)
+				return &entry;
+		}
+
+		registry.counters.emplace_back();
+
+		Counters& counters = registry.counters.back();
+		counters.name = name;
+
+		return &counters;
+	}
+
+#if BS_LOCK_PROFILING
+	ProfiledMutex::ProfiledMutex(const char* name)
+		:mCounters(LockProfiler::_getCounters(name))
+	{ }
+
+	void ProfiledMutex::lock()
+	{
+		if(!mMutex.try_lock())
+		{
+			const UINT64 waitStart = getTimestamp();
+			mMutex.lock();
+			mLockTime = getTimestamp();
+
+			const UINT64 waitNs = mLockTime - waitStart;
+			mCounters->numContended.fetch_add(1, std::memory_order_relaxed);
+			mCounters->totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+			updateMax(mCounters->maxWaitNs, waitNs);
+		}
+		else
+			mLockTime = getTimestamp();
+
+		mCounters->numAcquisitions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool ProfiledMutex::try_lock()
+	{
+		if(!mMutex.try_lock())
+			return false;
+
+		mLockTime = getTimestamp();
+		mCounters->numAcquisitions.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	void ProfiledMutex::unlock()
+	{
+		const UINT64 holdNs = getTimestamp() - mLockTime;
+		mMutex.unlock();
+
+		mCounters->totalHoldNs.fetch_add(holdNs, std::memory_order_relaxed);
+		updateMax(mCounters->maxHoldNs, holdNs);
+	}
+
+	void ProfiledSignal::wait(ProfiledLock& lock)
+	{
+		// The signal unlocks and re-locks the mutex through ProfiledMutex, so the hold time recorded by unlock() ends
+		// here, and any contention when waking up is recorded as a regular wait
+		const UINT64 waitStart = getTimestamp();
+		mSignal.wait(lock);
+		const UINT64 waitNs = getTimestamp() - waitStart;
+
+		LockProfiler::Counters* counters = lock.mutex()->mCounters;
+		counters->numSignalWaits.fetch_add(1, std::memory_order_relaxed);
+		counters->totalSignalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+	}
+#endif
+}
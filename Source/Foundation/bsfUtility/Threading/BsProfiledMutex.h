@@ -0,0 +1,135 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
+	/** Contention statistics of all profiled mutexes sharing the same name. Totals since the application started. */
+	struct LockProfileStats
+	{
+		const char* name = nullptr; /**< Name the mutexes were created with. */
+		UINT64 numAcquisitions = 0; /**< Number of times any of the mutexes was locked. */
+		UINT64 numContended = 0; /**< Number of acquisitions that had to wait for another thread. */
+		UINT64 totalWaitNs = 0; /**< Time spent waiting to acquire the mutexes, in nanoseconds. */
+		UINT64 maxWaitNs = 0; /**< Longest single wait to acquire one of the mutexes, in nanoseconds. */
+		UINT64 totalHoldNs = 0; /**< Time the mutexes were held for, in nanoseconds. */
+		UINT64 maxHoldNs = 0; /**< Longest time one of the mutexes was held for, in nanoseconds. */
+		UINT64 numSignalWaits = 0; /**< Number of times a thread waited on a signal while holding one of the mutexes. */
+		UINT64 totalSignalWaitNs = 0; /**< Time spent waiting on signals, in nanoseconds. Not part of the hold time. */
+	};
+
+	/**
+	 * Collects statistics of every ProfiledMutex. Statistics are only recorded if the framework is built with
+	 * BS_LOCK_PROFILING, otherwise ProfiledMutex compiles down to a plain Mutex and no statistics are reported.
+	 *
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT LockProfiler
+	{
+	public:
+		struct Counters;
+
+		/** Checks if the framework was built with lock profiling. */
+		static constexpr bool isEnabled() { return BS_LOCK_PROFILING != 0; }
+
+		/** Returns the statistics for every mutex name, ordered by total wait time, from highest to lowest. */
+		static Vector<LockProfileStats> getStats();
+
+		/** Resets the statistics of all mutexes to zero. */
+		static void reset();
+
+		/** @name Internal
+		 *  @{
+		 */
+
+		/** Returns the counters for the provided name, creating them if they don't exist. Name must be a literal. */
+		static Counters* _getCounters(const char* name);
+
+		/** @} */
+	};
+
+#if BS_LOCK_PROFILING
+	/**
+	 * Mutex that records how long threads wait to acquire it, how long it is held for and how often it is contended.
+	 * Statistics are accumulated per name, and can be retrieved through LockProfiler or from the CPU profiler reports.
+	 * Must be locked through ProfiledLock, and waited on through ProfiledSignal, so the statistics are recorded.
+	 */
+	class BS_UTILITY_EXPORT ProfiledMutex
+	{
+	public:
+		/** Creates a new mutex. @p name must be a string literal, or otherwise outlive the application. */
+		explicit ProfiledMutex(const char* name);
+
+		ProfiledMutex(const ProfiledMutex&) = delete;
+		ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+		/** Locks the mutex, blocking until it is available. */
+		void lock();
+
+		/** Attempts to lock the mutex without blocking. Returns true if the mutex was locked. */
+		bool try_lock();
+
+		/** Unlocks a previously locked mutex. */
+		void unlock();
+
+	private:
+		friend class ProfiledSignal;
+
+		Mutex mMutex;
+		LockProfiler::Counters* mCounters;
+		UINT64 mLockTime = 0;
+	};
+
+	/** Wrapper for the C++ std::unique_lock<ProfiledMutex>. */
+	using ProfiledLock = std::unique_lock<ProfiledMutex>;
+
+	/**
+	 * Condition variable that can be waited on with a ProfiledLock. Time spent waiting is recorded as signal wait time
+	 * of the locked mutex, instead of being counted as hold time.
+	 */
+	class BS_UTILITY_EXPORT ProfiledSignal
+	{
+	public:
+		/** Blocks the calling thread until the signal is notified. @p lock must be locked. */
+		void wait(ProfiledLock& lock);
+
+		/** Blocks the calling thread until the signal is notified and @p predicate returns true. */
+		template<class Predicate>
+		void wait(ProfiledLock& lock, Predicate predicate)
+		{
+			while(!predicate())
+				wait(lock);
+		}
+
+		/** Wakes up a single thread waiting on the signal. */
+		void notify_one() { mSignal.notify_one(); }
+
+		/** Wakes up all threads waiting on the signal. */
+		void notify_all() { mSignal.notify_all(); }
+
+	private:
+		std::condition_variable_any mSignal;
+	};
+#else
+	/** Plain Mutex that accepts a name, so it can be swapped with an instrumented mutex when lock profiling is on. */
+	class ProfiledMutex : public Mutex
+	{
+	public:
+		explicit ProfiledMutex(const char* name) { }
+	};
+
+	/** Lock for a ProfiledMutex. */
+	using ProfiledLock = Lock;
+
+	/** Signal that can be waited on with a ProfiledLock. */
+	using ProfiledSignal = Signal;
+#endif
+
+	/** @} */
+}
@@ -20,10 +20,7 @@ namespace bs
 	class SpinLock
 	{
 	public:
-		SpinLock()
-		{
-			mLock.clear(std::memory_order_relaxed);
-		}
+		SpinLock() = default;
 
 		/** Lock any following operations with the spin lock, not allowing any other thread to access them. */
 		void lock()
@@ -39,7 +36,7 @@ namespace bs
 		}
 
 	private:
-		std::atomic_flag mLock;
+		std::atomic_flag mLock = ATOMIC_FLAG_INIT;
 	};
 
 	/**
@@ -7,9 +7,10 @@ namespace bs
 {
 	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
 		TaskPriority priority, SPtr<Task> dependency)
-		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker)), mTaskDependency(std::move(dependency))
+		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker))
 	{
-
+		if(dependency != nullptr)
+			mTaskDependencies.push_back(std::move(dependency));
 	}
 
 	SPtr<Task> Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority, 
@@ -28,15 +29,33 @@ namespace bs
 		return mState == 3;
 	}
 
-	void Task::wait()
+	void Task::wait(bool help)
 	{
-		if(mParent != nullptr)
+		if(mParent == nullptr)
+			return;
+
+		if(help)
+			mParent->helpUntil([this]() { return isComplete() || isCanceled(); });
+		else
 			mParent->waitUntilComplete(this);
 	}
 
 	void Task::cancel()
 	{
-		mState = 3;
+		// Tasks that are executing or have completed can no longer be canceled
+		UINT32 state = 0;
+		if(!mState.compare_exchange_strong(state, 3))
+			return;
+
+		TaskScheduler::cancelDependents(*this);
+	}
+
+	void Task::addDependency(SPtr<Task> dependency)
+	{
+		assert(mState != 1 && "Cannot add a dependency to a task that is executing.");
+
+		if(dependency != nullptr)
+			mTaskDependencies.push_back(std::move(dependency));
 	}
 
 	TaskGroup::TaskGroup(const PrivatelyConstruct& dummy, String name, std::function<void(UINT32)> taskWorker, 
@@ -59,188 +78,518 @@ namespace bs
 		return mNumRemainingTasks == 0;
 	}
 
-	void TaskGroup::wait()
+	bool TaskGroup::isCanceled() const
+	{
+		return mCanceled;
+	}
+
+	void TaskGroup::wait(bool help)
 	{
-		if(mParent != nullptr)
+		if(mParent == nullptr)
+			return;
+
+		if(help)
+			mParent->helpUntil([this]() { return isComplete() || isCanceled(); });
+		else
 			mParent->waitUntilComplete(this);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare)
+	TaskGraph::TaskGraph(const PrivatelyConstruct& dummy, String name)
+		: mName(std::move(name))
+	{ }
+
+	SPtr<TaskGraph> TaskGraph::create(String name)
+	{
+		return bs_shared_ptr_new<TaskGraph>(PrivatelyConstruct(), std::move(name));
+	}
+
+	SPtr<Task> TaskGraph::add(std::function<void()> taskWorker, const Vector<SPtr<Task>>& predecessors,
+		TaskPriority priority)
 	{
-		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
+		SPtr<Task> task = Task::create(mName, std::move(taskWorker), priority);
+		for(auto& entry : predecessors)
+			task->addDependency(entry);
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+		mTasks.push_back(task);
+		return task;
 	}
 
-	TaskScheduler::~TaskScheduler()
+	SPtr<Task> TaskGraph::then(const SPtr<Task>& task, std::function<void()> taskWorker, TaskPriority priority)
+	{
+		return add(std::move(taskWorker), { task }, priority);
+	}
+
+	bool TaskGraph::isComplete() const
 	{
-		// Wait until all tasks complete
+		for(auto& entry : mTasks)
 		{
-			Lock activeTaskLock(mReadyMutex);
+			if(!entry->isComplete() && !entry->isCanceled())
+				return false;
+		}
 
-			while (mActiveTasks.size() > 0)
-			{
-				SPtr<Task> task = mActiveTasks[0];
-				activeTaskLock.unlock();
+		return true;
+	}
 
-				task->wait();
-				activeTaskLock.lock();
-			}
-		}
+	void TaskGraph::wait(bool help)
+	{
+		for(auto& entry : mTasks)
+			entry->wait(help);
+	}
 
-		// Start shutdown of the main queue worker and wait until it exits
+	/** Worker of the scheduler the current thread belongs to, or null if it is not a worker thread. */
+	static BS_THREADLOCAL TaskWorker* sCurrentWorker = nullptr;
+
+	/** State used for picking random victims to steal from, on threads that aren't workers. */
+	static BS_THREADLOCAL UINT32 sHelperRandomState = 2463534242U;
+
+	/** Maximum number of worker threads the scheduler will spawn, as a multiple of the logical core count. */
+	static constexpr UINT32 MAX_WORKERS_PER_CORE = 2;
+
+	/** Minimum number of worker threads the scheduler can spawn, regardless of the core count. */
+	static constexpr UINT32 MIN_WORKER_CAPACITY = 16;
+
+	/** Number of threads the scheduler leaves available in the thread pool for other systems (e.g. the core thread). */
+	static constexpr UINT32 RESERVED_POOL_THREADS = 2;
+
+	TaskScheduler::TaskScheduler()
+		:mTaskQueue(&TaskScheduler::taskCompare)
+	{
+		const UINT32 numCores = std::max(1U, (UINT32)BS_THREAD_HARDWARE_CONCURRENCY);
+		mMaxActiveTasks = (INT32)numCores;
+
+		mWorkers.resize(std::max(MIN_WORKER_CAPACITY, numCores * MAX_WORKERS_PER_CORE), nullptr);
+
+		Lock lock(mReadyMutex);
+		spawnWorkers();
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		// Signal the workers to exit after they finish their current task
 		{
 			Lock lock(mReadyMutex);
-
 			mShutdown = true;
 		}
 
-		mTaskReadyCond.notify_one();
+		mTaskReadyCond.notify_all();
+
+		const UINT32 numWorkers = mNumWorkers.load();
+		for(UINT32 i = 0; i < numWorkers; i++)
+		{
+			mWorkers[i]->thread.blockUntilComplete();
+
+			// Break any reference cycles between tasks and their dependents
+			for(auto& task : mWorkers[i]->tasks)
+				task->mDependents.clear();
 
-		mTaskSchedulerThread.blockUntilComplete();
+			bs_delete(mWorkers[i]);
+		}
+
+		for(auto& task : mTaskQueue)
+			task->mDependents.clear();
 	}
 
 	void TaskScheduler::addTask(SPtr<Task> task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
 		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mCheckTasks = true;
-		mTaskQueue.insert(std::move(task));
+		if(!registerDependencies(task))
+			return;
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		queueReadyTask(std::move(task));
+		wakeWorkers();
 	}
 
 	void TaskScheduler::addTaskGroup(const SPtr<TaskGroup>& taskGroup)
 	{
-		Lock lock(mReadyMutex);
+		taskGroup->mParent = this;
 
-		for(UINT32 i = 0; i < taskGroup->mCount; i++)
+		// No point in queuing more tasks than can execute in parallel, each task processes items until there are none left
+		const UINT32 numTasks = std::min(taskGroup->mCount, std::max(getNumWorkers(), 1U));
+		for(UINT32 i = 0; i < numTasks; i++)
 		{
-			const auto worker = [i, taskGroup] 
+			const auto worker = [taskGroup] 
 			{ 
-				taskGroup->mTaskWorker(i); 
-				--taskGroup->mNumRemainingTasks;
+				while(true)
+				{
+					const UINT32 itemIdx = taskGroup->mNextItem++;
+					if(itemIdx >= taskGroup->mCount)
+						break;
+
+					taskGroup->mTaskWorker(itemIdx); 
+					--taskGroup->mNumRemainingTasks;
+				}
 			};
 
 			SPtr<Task> task = Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency);
+			task->mGroup = taskGroup.get();
 			task->mParent = this;
 			task->mTaskId = mNextTaskId++;
 			task->mState.store(0); // Reset state in case the task is getting re-queued
 
-			mCheckTasks = true;
-			mTaskQueue.insert(std::move(task));
+			if(!registerDependencies(task))
+				continue;
+
+			queueReadyTask(std::move(task));
 		}
 
-		taskGroup->mParent = this;
+		wakeWorkers(numTasks > 1);
+	}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+	void TaskScheduler::addTaskGraph(const SPtr<TaskGraph>& taskGraph)
+	{
+		for(auto& task : taskGraph->mTasks)
+			addTask(task);
 	}
 
-	void TaskScheduler::addWorker()
+	void TaskScheduler::parallelFor(UINT32 count, UINT32 grainSize, 
+		const std::function<void(UINT32 start, UINT32 end)>& worker, bool help)
 	{
-		Lock lock(mReadyMutex);
+		if(count == 0)
+			return;
+
+		grainSize = std::max(grainSize, 1U);
+		const UINT32 numChunks = (count + grainSize - 1) / grainSize;
+
+		// Not worth scheduling anything, just execute on this thread
+		if(numChunks == 1)
+		{
+			worker(0, count);
+			return;
+		}
+
+		struct ParallelForData
+		{
+			std::function<void(UINT32, UINT32)> worker;
+			UINT32 count;
+			UINT32 grainSize;
+			UINT32 numChunks;
+			std::atomic<UINT32> nextChunk{0};
+			std::atomic<UINT32> numCompletedChunks{0};
+		};
+
+		// Helpers keep a reference to the data, as they might only start executing after this method returns
+		SPtr<ParallelForData> data = bs_shared_ptr_new<ParallelForData>();
+		data->worker = worker;
+		data->count = count;
+		data->grainSize = grainSize;
+		data->numChunks = numChunks;
+
+		const auto processChunks = [data]()
+		{
+			while(true)
+			{
+				const UINT32 chunkIdx = data->nextChunk++;
+				if(chunkIdx >= data->numChunks)
+					break;
+
+				const UINT32 start = chunkIdx * data->grainSize;
+				const UINT32 end = std::min(start + data->grainSize, data->count);
+
+				data->worker(start, end);
+				data->numCompletedChunks++;
+			}
+		};
+
+		// The calling thread will process chunks as well, so one less helper is needed
+		const UINT32 numHelpers = std::min(numChunks - 1, std::max(getNumWorkers(), 1U));
+		for(UINT32 i = 0; i < numHelpers; i++)
+		{
+			SPtr<Task> task = Task::create("ParallelFor", processChunks);
+			task->mParent = this;
+			task->mTaskId = mNextTaskId++;
+
+			queueReadyTask(std::move(task));
+		}
+
+		wakeWorkers(numHelpers > 1);
+
+		processChunks();
+
+		if(help)
+			helpUntil([&data]() { return data->numCompletedChunks == data->numChunks; });
+		else
+		{
+			// Remaining chunks are already being processed by the helpers, so this will never wait on queued tasks
+			Lock lock(mCompleteMutex);
+			mNumWaiters++;
 
+			while(data->numCompletedChunks != data->numChunks)
+			{
+				addWorker();
+				mTaskCompleteCond.wait(lock);
+				removeWorker();
+			}
+
+			mNumWaiters--;
+		}
+	}
+
+	void TaskScheduler::addWorker()
+	{
 		mMaxActiveTasks++;
 
-		// A spot freed up, queue new tasks on main scheduler thread if they exist
-		mTaskReadyCond.notify_one();
+		// Spawn a new thread if all existing ones are already allowed to run
+		if((UINT32)mMaxActiveTasks.load() > mNumWorkers.load())
+		{
+			Lock lock(mReadyMutex);
+			spawnWorkers();
+		}
+
+		// A spot freed up, wake up a worker if there are tasks waiting
+		if(mNumQueuedTasks > 0)
+			wakeWorkers();
 	}
 
 	void TaskScheduler::removeWorker()
 	{
-		Lock lock(mReadyMutex);
-
-		if(mMaxActiveTasks > 0)
-			mMaxActiveTasks--;
+		// Active workers will notice the reduced limit once they finish their current task
+		mMaxActiveTasks--;
 	}
 
-	void TaskScheduler::runMain()
+	void TaskScheduler::runWorker(TaskWorker* worker)
 	{
+		sCurrentWorker = worker;
+
 		while(true)
 		{
+			if(mShutdown)
+				break;
+
+			if(tryAcquireSlot())
+			{
+				SPtr<Task> task = findTask(worker);
+				if(task != nullptr)
+				{
+					runTask(task);
+					mNumActiveTasks--;
+
+					continue;
+				}
+
+				mNumActiveTasks--;
+			}
+
+			// Nothing to do (or not allowed to do it), sleep until more work is queued or a slot frees up
 			Lock lock(mReadyMutex);
 
-			while((!mCheckTasks || (UINT32)mActiveTasks.size() >= mMaxActiveTasks) && !mShutdown)
+			mNumSleepingWorkers++;
+			while(!mShutdown && (mNumQueuedTasks == 0 || mNumActiveTasks >= mMaxActiveTasks))
 				mTaskReadyCond.wait(lock);
 
-			mCheckTasks = false;
+			mNumSleepingWorkers--;
+		}
+
+		sCurrentWorker = nullptr;
+	}
 
-			if(mShutdown)
-				break;
+	void TaskScheduler::runTask(const SPtr<Task>& task)
+	{
+		task->mState.store(1);
+		task->mTaskWorker();
+
+		Vector<SPtr<Task>> dependents;
+		{
+			ScopedSpinLock lock(task->mDependentsLock);
+			task->mState.store(2);
+
+			std::swap(dependents, task->mDependents);
+		}
+
+		// Only take the lock if someone is actually waiting on a task to complete
+		if(mNumWaiters > 0)
+		{
+			Lock lock(mCompleteMutex);
+			mTaskCompleteCond.notify_all();
+		}
 
-			for(auto iter = mTaskQueue.begin(); iter != mTaskQueue.end();)
+		// Queue any tasks that were waiting on this one, and have no other dependencies remaining
+		UINT32 numQueued = 0;
+		for(auto& dependent : dependents)
+		{
+			if(--dependent->mNumPendingDependencies > 0 || dependent->isCanceled())
+				continue;
+
+			queueReadyTask(std::move(dependent));
+			numQueued++;
+		}
+
+		if(numQueued > 0)
+			wakeWorkers(numQueued > 1);
+	}
+
+	bool TaskScheduler::registerDependencies(const SPtr<Task>& task)
+	{
+		if(task->mTaskDependencies.empty())
+			return true;
+
+		// Hold an extra count while registering, so dependencies completing in the meantime can't queue the task early
+		task->mNumPendingDependencies = 1;
+		bool dependencyCanceled = false;
+		for(auto& dependency : task->mTaskDependencies)
+		{
+			ScopedSpinLock lock(dependency->mDependentsLock);
+			if(dependency->isComplete())
+				continue;
+
+			// Canceled tasks never complete, so neither can the tasks depending on them
+			if(dependency->isCanceled())
 			{
-				if ((UINT32)mActiveTasks.size() >= mMaxActiveTasks)
-					break;	
+				dependencyCanceled = true;
+				continue;
+			}
 
-				SPtr<Task> curTask = *iter;
+			task->mNumPendingDependencies++;
+			dependency->mDependents.push_back(task);
+		}
+
+		if(dependencyCanceled)
+		{
+			task->cancel();
+			return false;
+		}
 
-				if(curTask->isCanceled())
+		return --task->mNumPendingDependencies == 0;
+	}
+
+	void TaskScheduler::queueReadyTask(SPtr<Task> task)
+	{
+		TaskWorker* worker = getCurrentWorker();
+		if(worker != nullptr)
+		{
+			ScopedSpinLock lock(worker->lock);
+			worker->tasks.push_back(std::move(task));
+		}
+		else
+		{
+			ScopedSpinLock lock(mTaskQueueLock);
+			mTaskQueue.insert(std::move(task));
+			mNumSharedQueuedTasks++;
+		}
+
+		mNumQueuedTasks++;
+	}
+
+	SPtr<Task> TaskScheduler::findTask(TaskWorker* worker)
+	{
+		while(mNumQueuedTasks > 0)
+		{
+			SPtr<Task> task;
+
+			// Local queue first, newest task first as its data is most likely still in cache
+			if(worker != nullptr)
+			{
+				ScopedSpinLock lock(worker->lock);
+				if(!worker->tasks.empty())
 				{
-					iter = mTaskQueue.erase(iter);
-					continue;
+					task = std::move(worker->tasks.back());
+					worker->tasks.pop_back();
 				}
+			}
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
+			// Then the shared queue, in priority order
+			if(task == nullptr && mNumSharedQueuedTasks > 0)
+			{
+				ScopedSpinLock lock(mTaskQueueLock);
+				if(!mTaskQueue.empty())
 				{
-					++iter;
-					continue;
+					task = *mTaskQueue.begin();
+					mTaskQueue.erase(mTaskQueue.begin());
+					mNumSharedQueuedTasks--;
 				}
+			}
+
+			// Finally try to steal the oldest task from other workers, starting from a random victim
+			if(task == nullptr)
+			{
+				const UINT32 numWorkers = mNumWorkers.load();
+				if(numWorkers == 0)
+					return nullptr;
+
+				UINT32& randomState = worker != nullptr ? worker->randomState : sHelperRandomState;
+				randomState ^= randomState << 13;
+				randomState ^= randomState >> 17;
+				randomState ^= randomState << 5;
 
-				// Spin until a thread becomes available. This happens primarily because our mActiveTask count and
-				// ThreadPool's thread idle count aren't synced, so while the task manager thinks it's free to run new
-				// tasks, the ThreadPool might still have those threads as running, meaning their allocation will fail.
-				// So we just spin here for a bit, in that rare case.
-				if(ThreadPool::instance().getNumAvailable() == 0)
+				const UINT32 start = randomState % numWorkers;
+				for(UINT32 i = 0; i < numWorkers && task == nullptr; i++)
 				{
-					mCheckTasks = true;
-					break;
+					TaskWorker* victim = mWorkers[(start + i) % numWorkers];
+					if(victim == worker)
+						continue;
+
+					ScopedSpinLock lock(victim->lock);
+					if(!victim->tasks.empty())
+					{
+						task = std::move(victim->tasks.front());
+						victim->tasks.pop_front();
+					}
 				}
+			}
 
-				iter = mTaskQueue.erase(iter);
+			if(task == nullptr)
+				return nullptr;
 
-				curTask->mState.store(1);
-				mActiveTasks.push_back(curTask);
+			mNumQueuedTasks--;
 
-				ThreadPool::instance().run(curTask->mName, std::bind(&TaskScheduler::runTask, this, curTask));
+			if(task->isCanceled())
+			{
+				// Dependents were canceled along with the task, this only releases any registered since
+				cancelDependents(*task);
+				continue;
 			}
+
+			return task;
 		}
+
+		return nullptr;
 	}
 
-	void TaskScheduler::runTask(SPtr<Task> task)
+	bool TaskScheduler::tryAcquireSlot()
 	{
-		task->mTaskWorker();
-
+		INT32 numActive = mNumActiveTasks.load();
+		while(numActive < mMaxActiveTasks.load())
 		{
-			Lock lock(mReadyMutex);
-
-			auto findIter = std::find(mActiveTasks.begin(), mActiveTasks.end(), task);
-			if (findIter != mActiveTasks.end())
-				mActiveTasks.erase(findIter);
+			if(mNumActiveTasks.compare_exchange_weak(numActive, numActive + 1))
+				return true;
 		}
 
-		{
-			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+		return false;
+	}
 
-			mTaskCompleteCond.notify_all();
-		}
+	void TaskScheduler::wakeWorkers(bool all)
+	{
+		if(mNumSleepingWorkers == 0)
+			return;
+
+		Lock lock(mReadyMutex);
+		if(all)
+			mTaskReadyCond.notify_all();
+		else
+			mTaskReadyCond.notify_one();
+	}
 
-		// Wake the main scheduler thread in case there are other tasks waiting or this task was someone's dependency
+	void TaskScheduler::spawnWorkers()
+	{
+		UINT32 numWorkers = mNumWorkers.load();
+		while(numWorkers < (UINT32)std::max(mMaxActiveTasks.load(), 0) && numWorkers < (UINT32)mWorkers.size())
 		{
-			Lock lock(mReadyMutex);
+			if(ThreadPool::instance().getNumAvailable() <= RESERVED_POOL_THREADS)
+				break;
 
-			mCheckTasks = true;
-			mTaskReadyCond.notify_one();
+			TaskWorker* worker = bs_new<TaskWorker>();
+			worker->index = numWorkers;
+			worker->randomState = numWorkers * 2654435761U + 1;
+
+			// Publish the worker before it starts so other workers can steal from it
+			mWorkers[numWorkers] = worker;
+			mNumWorkers.store(++numWorkers);
+
+			worker->thread = ThreadPool::instance().run("TaskWorker", std::bind(&TaskScheduler::runWorker, this, worker));
 		}
 	}
 
@@ -251,26 +600,111 @@ namespace bs
 
 		{
 			Lock lock(mCompleteMutex);
+			mNumWaiters++;
 
-			while(!task->isComplete())
+			while(!task->isComplete() && !task->isCanceled())
 			{
 				addWorker();
 				mTaskCompleteCond.wait(lock);
 				removeWorker();
 			}
+
+			mNumWaiters--;
 		}
 	}
 
 	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
 	{
 		Lock lock(mCompleteMutex);
+		mNumWaiters++;
 
-		while (taskGroup->mNumRemainingTasks > 0)
+		while (taskGroup->mNumRemainingTasks > 0 && !taskGroup->isCanceled())
 		{
 			addWorker();
 			mTaskCompleteCond.wait(lock);
 			removeWorker();
 		}
+
+		mNumWaiters--;
+	}
+
+	void TaskScheduler::helpUntil(const std::function<bool()>& isDone)
+	{
+		TaskWorker* worker = getCurrentWorker();
+		while(!isDone())
+		{
+			SPtr<Task> task = findTask(worker);
+			if(task != nullptr)
+			{
+				runTask(task);
+				continue;
+			}
+
+			// Nothing to help with, block until some task completes and check again
+			Lock lock(mCompleteMutex);
+			mNumWaiters++;
+
+			if(!isDone())
+			{
+				addWorker();
+				mTaskCompleteCond.wait(lock);
+				removeWorker();
+			}
+
+			mNumWaiters--;
+		}
+	}
+
+	void TaskScheduler::cancelDependents(Task& task)
+	{
+		Vector<SPtr<Task>> toCancel;
+		{
+			ScopedSpinLock lock(task.mDependentsLock);
+			std::swap(toCancel, task.mDependents);
+		}
+
+		if(task.mGroup != nullptr)
+			task.mGroup->mCanceled = true;
+
+		TaskScheduler* scheduler = task.mParent;
+		while(!toCancel.empty())
+		{
+			SPtr<Task> dependent = std::move(toCancel.back());
+			toCancel.pop_back();
+
+			// Dependents are still waiting on the canceled task, so none of them could have started executing
+			{
+				ScopedSpinLock lock(dependent->mDependentsLock);
+				dependent->mState.store(3);
+
+				toCancel.insert(toCancel.end(), dependent->mDependents.begin(), dependent->mDependents.end());
+				dependent->mDependents.clear();
+			}
+
+			if(dependent->mGroup != nullptr)
+				dependent->mGroup->mCanceled = true;
+
+			if(scheduler == nullptr)
+				scheduler = dependent->mParent;
+		}
+
+		// Wake up anyone waiting on the canceled tasks
+		if(scheduler != nullptr && scheduler->mNumWaiters > 0)
+		{
+			Lock lock(scheduler->mCompleteMutex);
+			scheduler->mTaskCompleteCond.notify_all();
+		}
+	}
+
+	TaskWorker* TaskScheduler::getCurrentWorker() const
+	{
+		if(sCurrentWorker == nullptr || sCurrentWorker->index >= mNumWorkers)
+			return nullptr;
+
+		if(mWorkers[sCurrentWorker->index] != sCurrentWorker)
+			return nullptr;
+
+		return sCurrentWorker;
 	}
 
 	bool TaskScheduler::taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs)
@@ -5,6 +5,7 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsModule.h"
 #include "Threading/BsThreadPool.h"
+#include "Threading/BsSpinLock.h"
 
 namespace bs
 {
@@ -12,6 +13,7 @@ namespace bs
 	 *  @{
 	 */
 	class TaskScheduler;
+	class TaskGroup;
 
 	/** Task priority. Tasks with higher priority will get executed sooner. */
 	enum class TaskPriority
@@ -55,15 +57,28 @@ namespace bs
 		bool isCanceled() const;
 
 		/**
-		 * Blocks the current thread until the task has completed.
+		 * Blocks the current thread until the task has completed or has been canceled.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @param[in]	help	If true the calling thread will execute other queued tasks while it waits, instead of
+		 *						blocking. Avoid it if the queue might contain long running tasks, as the wait might not
+		 *						return until they complete.
+		 *
+		 * @note	When not helping, adds a new worker while waiting, so that the blocking threads core can be utilized.
 		 */
-		void wait();
+		void wait(bool help = false);
 
-		/** Cancels the task and removes it from the TaskSchedulers queue. */
+		/**
+		 * Cancels the task and removes it from the TaskSchedulers queue. Any tasks (and task groups) depending on the
+		 * task, directly or indirectly, are canceled as well. Has no effect if the task is executing or has completed.
+		 */
 		void cancel();
 
+		/**
+		 * Adds a task that needs to complete before this task can be executed. Must be called before the task is queued.
+		 * This allows a task to depend on multiple other tasks, in addition to the dependency provided on creation.
+		 */
+		void addDependency(SPtr<Task> dependency);
+
 	private:
 		friend class TaskScheduler;
 
@@ -71,9 +86,16 @@ namespace bs
 		TaskPriority mPriority;
 		UINT32 mTaskId = 0;
 		std::function<void()> mTaskWorker;
-		SPtr<Task> mTaskDependency;
+		Vector<SPtr<Task>> mTaskDependencies;
 		std::atomic<UINT32> mState{0}; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
+		/** Tasks waiting on this task to complete before they can be queued. */
+		Vector<SPtr<Task>> mDependents;
+		std::atomic<UINT32> mNumPendingDependencies{0};
+		SpinLock mDependentsLock;
+
+		/** Group the task processes the items of, if any. Kept alive by the task worker. */
+		TaskGroup* mGroup = nullptr;
 		TaskScheduler* mParent = nullptr;
 	};
 
@@ -96,7 +118,7 @@ namespace bs
 		 * @param[in]	name		Name you can use to more easily identify the tasks in the group.
 		 * @param[in]	taskWorker	Worker method that will get called for each item in the group. Each call will receive
 		 *							a sequential index of the item in the group.
-		 * @param[in]	count		Number of items in the task group. Each item will be processed in a worker thread.
+		 * @param[in]	count		Number of items in the task group. Items will be distributed between worker threads.
 		 * @param[in]	priority  	(optional) Higher priority means the tasks will be executed sooner.
 		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
 		 * 							not be executed until its dependency is complete.
@@ -107,12 +129,18 @@ namespace bs
 		/** Returns true if all the tasks in the group have completed. */
 		bool isComplete() const;
 
+		/** Returns true if the group will never complete, because a task it depends on has been canceled. */
+		bool isCanceled() const;
+
 		/**
-		 * Blocks the current thread until all tasks in the group have completed.
+		 * Blocks the current thread until all tasks in the group have completed, or the group has been canceled.
+		 *
+		 * @param[in]	help	If true the calling thread will execute other queued tasks (including the items of this
+		 *						group) while it waits, instead of blocking.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	When not helping, adds a new worker while waiting, so that the blocking threads core can be utilized.
 		 */
-		void wait();
+		void wait(bool help = false);
 
 	private:
 		friend class TaskScheduler;
@@ -122,11 +150,99 @@ namespace bs
 		TaskPriority mPriority;
 		std::function<void(UINT32)> mTaskWorker;
 		SPtr<Task> mTaskDependency;
+		std::atomic<UINT32> mNextItem{0};
 		std::atomic<UINT32> mNumRemainingTasks{mCount};
+		std::atomic<bool> mCanceled{false};
 
 		TaskScheduler* mParent = nullptr;
 	};
 
+	/**
+	 * Represents a graph of tasks, where each task may be executed only after all of its predecessors have completed.
+	 * Graph should be provided to the TaskScheduler in order for it to start.
+	 *
+	 * @note	Not thread safe while the graph is being built. Thread safe once it has been queued.
+	 */
+	class BS_UTILITY_EXPORT TaskGraph
+	{
+		struct PrivatelyConstruct {};
+
+	public:
+		TaskGraph(const PrivatelyConstruct& dummy, String name);
+
+		/**
+		 * Creates a new empty task graph.
+		 *
+		 * @param[in]	name		Name you can use to more easily identify the tasks in the graph.
+		 */
+		static SPtr<TaskGraph> create(String name);
+
+		/**
+		 * Adds a new task to the graph.
+		 *
+		 * @param[in]	taskWorker		Worker method that does all of the work in the task.
+		 * @param[in]	predecessors	Tasks (previously added to this graph) that must complete before this task starts.
+		 * @param[in]	priority		(optional) Higher priority means the task will be executed sooner.
+		 * @return						Task that can be used as a predecessor for other tasks added to the graph.
+		 */
+		SPtr<Task> add(std::function<void()> taskWorker, const Vector<SPtr<Task>>& predecessors = {},
+			TaskPriority priority = TaskPriority::Normal);
+
+		/**
+		 * Adds a new task that will execute after @p task completes. Shorthand for add() with a single predecessor.
+		 */
+		SPtr<Task> then(const SPtr<Task>& task, std::function<void()> taskWorker,
+			TaskPriority priority = TaskPriority::Normal);
+
+		/** Returns true if all the tasks in the graph have completed. */
+		bool isComplete() const;
+
+		/**
+		 * Blocks the current thread until all tasks in the graph have completed.
+		 *
+		 * @param[in]	help	If true the calling thread will execute queued tasks (including the tasks of this graph)
+		 *						while it waits, instead of blocking.
+		 */
+		void wait(bool help = true);
+
+	private:
+		friend class TaskScheduler;
+
+		String mName;
+		Vector<SPtr<Task>> mTasks;
+	};
+
+	/** @} */
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/** Persistent worker thread used by the TaskScheduler, along with its local task queue. */
+	struct TaskWorker
+	{
+		UINT32 index = 0;
+		UINT32 randomState = 0;
+		HThread thread;
+
+		/**
+		 * Tasks local to this worker. Owner pushes and pops at the back (LIFO), while other workers steal from the
+		 * front (FIFO).
+		 */
+		Deque<SPtr<Task>> tasks;
+		SpinLock lock;
+	};
+
+	/** @} */
+	/** @} */
+
+	/** @addtogroup Threading
+	 *  @{
+	 */
+
 	/**
 	 * Represents a task scheduler running on multiple threads. You may queue tasks on it from any thread and they will be
 	 * executed in user specified order on any available thread.
@@ -134,12 +250,13 @@ namespace bs
 	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially
-	 * at the cost of flexibility.)
+	 * Tasks are executed by a set of persistent worker threads, each owning its own task queue. Tasks queued from a
+	 * worker thread are placed on that worker's local queue and executed in LIFO order, while idle workers steal from
+	 * the queues of other workers. Tasks queued from non-worker threads are placed on a shared queue sorted by priority.
+	 * Priority is only respected between tasks in the shared queue.
 	 * @note
-	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
-	 * threads using addWorker()/removeWorker() methods.
+	 * By default the task scheduler will allow as many tasks to run in parallel as there are logical CPU cores. You may
+	 * add or remove workers using addWorker()/removeWorker() methods.
 	 */
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
@@ -153,40 +270,107 @@ namespace bs
 		/** Queues a new task group. */
 		void addTaskGroup(const SPtr<TaskGroup>& taskGroup);
 
-		/**	Adds a new worker thread which will be used for executing queued tasks. */
+		/** Queues all the tasks in a task graph. Tasks in the graph will start as soon as their predecessors complete. */
+		void addTaskGraph(const SPtr<TaskGraph>& taskGraph);
+
+		/**
+		 * Executes the provided worker over the range [0, @p count), split into chunks of @p grainSize items that get
+		 * distributed between the worker threads. The calling thread participates in the work and the method returns
+		 * once the entire range has been processed.
+		 *
+		 * @param[in]	count		Number of items to process.
+		 * @param[in]	grainSize	Number of items in a single chunk. Chunks should be large enough so their processing
+		 *							cost dominates the cost of scheduling.
+		 * @param[in]	worker		Method that processes the items in range [start, end).
+		 * @param[in]	help		If true the calling thread executes other queued tasks while waiting for the workers
+		 *							to finish their chunks. Disable if the caller holds a lock other tasks might need.
+		 */
+		void parallelFor(UINT32 count, UINT32 grainSize, const std::function<void(UINT32 start, UINT32 end)>& worker,
+			bool help = true);
+
+		/**	Adds a new worker which will be used for executing queued tasks. */
 		void addWorker();
 
-		/**	Removes a worker thread (as soon as its current task is finished). */
+		/**	Removes a worker (as soon as its current task is finished). */
 		void removeWorker();
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
-		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+		UINT32 getNumWorkers() const { return (UINT32)std::max(mMaxActiveTasks.load(), 0); }
 	protected:
 		friend class Task;
 		friend class TaskGroup;
 
-		/**	Main task scheduler method that dispatches tasks to other threads. */
-		void runMain();
+		/** Main loop of a single worker thread. Finds and executes tasks until the scheduler shuts down. */
+		void runWorker(TaskWorker* worker);
+
+		/**	Executes a single task and queues any tasks that were waiting on it. */
+		void runTask(const SPtr<Task>& task);
+
+		/**
+		 * Registers the task with its dependencies that aren't complete. Returns false if there were any, in which case
+		 * the task will be queued once they complete.
+		 */
+		bool registerDependencies(const SPtr<Task>& task);
+
+		/**
+		 * Queues a task whose dependencies are satisfied. Task is placed on the local queue if called from a worker
+		 * thread, or to the shared queue otherwise.
+		 */
+		void queueReadyTask(SPtr<Task> task);
+
+		/**
+		 * Finds a task for the specified worker to execute, searching local, shared and then other workers' queues.
+		 * Worker can be null, in which case the local queue is skipped.
+		 */
+		SPtr<Task> findTask(TaskWorker* worker);
 
-		/**	Worker method that runs a single task. */
-		void runTask(SPtr<Task> task);
+		/** Attempts to reserve an active task slot. Returns false if the maximum number of active tasks is reached. */
+		bool tryAcquireSlot();
 
-		/**	Blocks the calling thread until the specified task has completed. */
+		/** Wakes up a sleeping worker, if any, to process newly available tasks. */
+		void wakeWorkers(bool all = false);
+
+		/** Spawns new worker threads if the number of allowed active tasks is larger than the number of workers. */
+		void spawnWorkers();
+
+		/**
+		 * Cancels all tasks depending on the provided canceled task, directly or indirectly, and wakes up any threads
+		 * waiting on them.
+		 */
+		static void cancelDependents(Task& task);
+
+		/**	Blocks the calling thread until the specified task has completed or has been canceled. */
 		void waitUntilComplete(const Task* task);
 
-		/**	Blocks the calling thread until all the tasks in the provided task group have completed. */
+		/**	Blocks the calling thread until all the tasks in the provided task group have completed or were canceled. */
 		void waitUntilComplete(const TaskGroup* taskGroup);
 
+		/**
+		 * Executes queued tasks on the calling thread until @p isDone returns true. If no tasks are available the thread
+		 * blocks until some task completes.
+		 */
+		void helpUntil(const std::function<bool()>& isDone);
+
+		/** Returns the worker the calling thread belongs to, or null if the thread isn't a worker of this scheduler. */
+		TaskWorker* getCurrentWorker() const;
+
 		/**	Method used for sorting tasks. */
 		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
 
-		HThread mTaskSchedulerThread;
+		Vector<TaskWorker*> mWorkers;
+		std::atomic<UINT32> mNumWorkers{0};
+
 		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
-		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks = 0;
-		UINT32 mNextTaskId = 0;
-		bool mShutdown = false;
-		bool mCheckTasks = false;
+		SpinLock mTaskQueueLock;
+
+		std::atomic<INT32> mMaxActiveTasks{0};
+		std::atomic<INT32> mNumActiveTasks{0};
+		std::atomic<UINT32> mNumQueuedTasks{0};
+		std::atomic<UINT32> mNumSharedQueuedTasks{0};
+		std::atomic<UINT32> mNumSleepingWorkers{0};
+		std::atomic<UINT32> mNumWaiters{0};
+		std::atomic<UINT32> mNextTaskId{0};
+		std::atomic<bool> mShutdown{false};
 
 		Mutex mReadyMutex;
 		Mutex mCompleteMutex;
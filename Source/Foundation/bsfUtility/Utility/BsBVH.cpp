@@ -0,0 +1,460 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsBVH.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	/** Number of bins the primitives are sorted into when looking for the best split. */
+	static constexpr UINT32 NUM_BINS = 12;
+
+	/** Cost of traversing a node, relative to the cost of testing a primitive. */
+	static constexpr float TRAVERSAL_COST = 1.0f;
+
+	/** Minimal box used during the build, cheaper to grow than AABox. */
+	struct BuildBounds
+	{
+		Vector3 min = Vector3::INF;
+		Vector3 max = -Vector3::INF;
+
+		void grow(const Vector3& point)
+		{
+			min.min(point);
+			max.max(point);
+		}
+
+		void grow(const AABox& box)
+		{
+			min.min(box.getMin());
+			max.max(box.getMax());
+		}
+
+		void grow(const BuildBounds& other)
+		{
+			min.min(other.min);
+			max.max(other.max);
+		}
+
+		/** Returns half of the surface area of the box, or zero if the box is empty. */
+		float getHalfArea() const
+		{
+			const Vector3 size = max - min;
+			if (size.x < 0.0f || size.y < 0.0f || size.z < 0.0f)
+				return 0.0f;
+
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+	};
+
+	struct BVH::BuildData
+	{
+		const AABox* bounds;
+		Vector<Vector3> centroids;
+	};
+
+	/** Range of primitives that becomes a single child of a node. */
+	struct BuildRange
+	{
+		UINT32 start;
+		UINT32 end;
+		BuildBounds bounds;
+		bool canSplit;
+	};
+
+	/** Calculates the bounds of all primitives in the provided range. */
+	static BuildBounds calculateBounds(const UINT32* primitives, UINT32 start, UINT32 end, const AABox* bounds)
+	{
+		BuildBounds output;
+		for (UINT32 i = start; i < end; i++)
+			output.grow(bounds[primitives[i]]);
+
+		return output;
+	}
+
+	/**
+	 * Finds the best way to split the range in two using the surface area heuristic, and partitions the primitives
+	 * accordingly. Returns false if the range should rather be kept as a single leaf.
+	 */
+	static bool split(UINT32* primitives, const BuildRange& range, const AABox* bounds, const Vector3* centroids,
+		UINT32& mid)
+	{
+		const UINT32 count = range.end - range.start;
+
+		BuildBounds centroidBounds;
+		for (UINT32 i = range.start; i < range.end; i++)
+			centroidBounds.grow(centroids[primitives[i]]);
+
+		float bestCost = std::numeric_limits<float>::max();
+		INT32 bestAxis = -1;
+		UINT32 bestBin = 0;
+
+		for (UINT32 axis = 0; axis < 3; axis++)
+		{
+			const float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+			if (extent <= 0.0f)
+				continue;
+
+			BuildBounds binBounds[NUM_BINS];
+			UINT32 binCounts[NUM_BINS] = { 0 };
+
+			const float scale = NUM_BINS / extent;
+			for (UINT32 i = range.start; i < range.end; i++)
+			{
+				const UINT32 primitive = primitives[i];
+				const auto bin = std::min((UINT32)((centroids[primitive][axis] - centroidBounds.min[axis]) * scale),
+					NUM_BINS - 1);
+
+				binBounds[bin].grow(bounds[primitive]);
+				binCounts[bin]++;
+			}
+
+			// Cost of everything right of each split position, swept from the right
+			float rightCosts[NUM_BINS];
+			BuildBounds rightBounds;
+			UINT32 rightCount = 0;
+			for (UINT32 i = NUM_BINS - 1; i > 0; i--)
+			{
+				rightBounds.grow(binBounds[i]);
+				rightCount += binCounts[i];
+				rightCosts[i] = rightBounds.getHalfArea() * rightCount;
+			}
+
+			BuildBounds leftBounds;
+			UINT32 leftCount = 0;
+			for (UINT32 i = 0; i < NUM_BINS - 1; i++)
+			{
+				leftBounds.grow(binBounds[i]);
+				leftCount += binCounts[i];
+
+				if (leftCount == 0 || leftCount == count)
+					continue;
+
+				const float cost = leftBounds.getHalfArea() * leftCount + rightCosts[i + 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = (INT32)axis;
+					bestBin = i;
+				}
+			}
+		}
+
+		// All centroids are at the same position, split in the middle if the range is too large for a leaf
+		if (bestAxis == -1)
+		{
+			if (count <= BVH::MAX_LEAF_SIZE)
+				return false;
+
+			mid = range.start + count / 2;
+			return true;
+		}
+
+		const float area = range.bounds.getHalfArea();
+		const float leafCost = area * count;
+		const float splitCost = area * TRAVERSAL_COST + bestCost;
+		if (count <= BVH::MAX_LEAF_SIZE && splitCost >= leafCost)
+			return false;
+
+		const float minCentroid = centroidBounds.min[bestAxis];
+		const float scale = NUM_BINS / (centroidBounds.max[bestAxis] - minCentroid);
+		UINT32* midPtr = std::partition(primitives + range.start, primitives + range.end,
+			[&](UINT32 primitive)
+			{
+				const auto bin = std::min((UINT32)((centroids[primitive][bestAxis] - minCentroid) * scale),
+					NUM_BINS - 1);
+				return bin <= bestBin;
+			});
+
+		mid = (UINT32)(midPtr - primitives);
+		return true;
+	}
+
+	/** Writes the bounds into a child slot of a node. */
+	template<class NodeType>
+	static void setChildBounds(NodeType& node, UINT32 idx, const BuildBounds& bounds)
+	{
+		node.minX[idx] = bounds.min.x;
+		node.minY[idx] = bounds.min.y;
+		node.minZ[idx] = bounds.min.z;
+		node.maxX[idx] = bounds.max.x;
+		node.maxY[idx] = bounds.max.y;
+		node.maxZ[idx] = bounds.max.z;
+	}
+
+	BVH::RayData::RayData(const Ray& ray)
+		:origin(ray.getOrigin())
+	{
+		// Avoid infinities in the slab test, as they produce NaNs when multiplied by zero
+		const Vector3& direction = ray.getDirection();
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			const float value = Math::abs(direction[i]) < 1e-20f ? 1e-20f : direction[i];
+			invDirection[i] = 1.0f / value;
+		}
+	}
+
+	void BVH::build(const AABox* bounds, UINT32 count)
+	{
+		mNodes.clear();
+		mPrimitives.resize(count);
+		mPrimitiveBounds.resize(count);
+
+		if (count == 0)
+			return;
+
+		BuildData data;
+		data.bounds = bounds;
+		data.centroids.resize(count);
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			mPrimitives[i] = i;
+			data.centroids[i] = bounds[i].getCenter();
+		}
+
+		mNodes.push_back(Node());
+		buildNode(0, 0, count, data);
+
+		for (UINT32 i = 0; i < count; i++)
+			mPrimitiveBounds[i] = bounds[mPrimitives[i]];
+	}
+
+	void BVH::buildNode(UINT32 nodeIdx, UINT32 start, UINT32 end, BuildData& data)
+	{
+		BuildRange ranges[4];
+		ranges[0] = { start, end, calculateBounds(mPrimitives.data(), start, end, data.bounds), true };
+		UINT32 numRanges = 1;
+
+		// Keep splitting the largest range until all four children are used, or no range is worth splitting
+		while (numRanges < 4)
+		{
+			INT32 bestRange = -1;
+			float bestArea = -1.0f;
+			for (UINT32 i = 0; i < numRanges; i++)
+			{
+				if (!ranges[i].canSplit || (ranges[i].end - ranges[i].start) < 2)
+					continue;
+
+				const float area = ranges[i].bounds.getHalfArea();
+				if (area > bestArea)
+				{
+					bestArea = area;
+					bestRange = (INT32)i;
+				}
+			}
+
+			if (bestRange == -1)
+				break;
+
+			BuildRange& range = ranges[bestRange];
+
+			UINT32 mid;
+			if (!split(mPrimitives.data(), range, data.bounds, data.centroids.data(), mid))
+			{
+				range.canSplit = false;
+				continue;
+			}
+
+			BuildRange& right = ranges[numRanges++];
+			right = { mid, range.end, calculateBounds(mPrimitives.data(), mid, range.end, data.bounds), true };
+
+			range.end = mid;
+			range.bounds = calculateBounds(mPrimitives.data(), range.start, mid, data.bounds);
+		}
+
+		UINT32 childNodes[4];
+		for (UINT32 i = 0; i < numRanges; i++)
+		{
+			const UINT32 count = ranges[i].end - ranges[i].start;
+			if (count <= MAX_LEAF_SIZE)
+			{
+				childNodes[i] = (UINT32)-1;
+
+				Node& node = mNodes[nodeIdx];
+				node.children[i] = ranges[i].start;
+				node.counts[i] = (UINT8)count;
+			}
+			else
+			{
+				childNodes[i] = (UINT32)mNodes.size();
+				mNodes.push_back(Node());
+
+				Node& node = mNodes[nodeIdx];
+				node.children[i] = childNodes[i];
+				node.counts[i] = 0;
+			}
+
+			setChildBounds(mNodes[nodeIdx], i, ranges[i].bounds);
+		}
+
+		mNodes[nodeIdx].numChildren = numRanges;
+
+		for (UINT32 i = 0; i < numRanges; i++)
+		{
+			if (childNodes[i] != (UINT32)-1)
+				buildNode(childNodes[i], ranges[i].start, ranges[i].end, data);
+		}
+	}
+
+	void BVH::refit(const AABox* bounds)
+	{
+		const auto count = (UINT32)mPrimitives.size();
+		for (UINT32 i = 0; i < count; i++)
+			mPrimitiveBounds[i] = bounds[mPrimitives[i]];
+
+		// Children are always stored after their parents, so iterating backwards updates children first
+		for (auto iter = mNodes.rbegin(); iter != mNodes.rend(); ++iter)
+		{
+			Node& node = *iter;
+			for (UINT32 i = 0; i < node.numChildren; i++)
+			{
+				BuildBounds childBounds;
+				if (node.counts[i] > 0)
+				{
+					const UINT32 first = node.children[i];
+					for (UINT32 j = first; j < first + node.counts[i]; j++)
+						childBounds.grow(mPrimitiveBounds[j]);
+				}
+				else
+				{
+					const Node& child = mNodes[node.children[i]];
+					for (UINT32 j = 0; j < child.numChildren; j++)
+					{
+						childBounds.grow(Vector3(child.minX[j], child.minY[j], child.minZ[j]));
+						childBounds.grow(Vector3(child.maxX[j], child.maxY[j], child.maxZ[j]));
+					}
+				}
+
+				setChildBounds(node, i, childBounds);
+			}
+		}
+	}
+
+	AABox BVH::getBounds() const
+	{
+		if (mNodes.empty())
+			return AABox::BOX_EMPTY;
+
+		const Node& root = mNodes[0];
+
+		BuildBounds bounds;
+		for (UINT32 i = 0; i < root.numChildren; i++)
+		{
+			bounds.grow(Vector3(root.minX[i], root.minY[i], root.minZ[i]));
+			bounds.grow(Vector3(root.maxX[i], root.maxY[i], root.maxZ[i]));
+		}
+
+		return AABox(bounds.min, bounds.max);
+	}
+
+	UINT32 BVH::intersectChildren(const Node& node, const RayData& ray, float maxDistance,
+		float (&distances)[4]) const
+	{
+		using namespace simd;
+
+		const float32x4 originX = splat<float32x4>(ray.origin.x);
+		const float32x4 originY = splat<float32x4>(ray.origin.y);
+		const float32x4 originZ = splat<float32x4>(ray.origin.z);
+		const float32x4 invDirX = splat<float32x4>(ray.invDirection.x);
+		const float32x4 invDirY = splat<float32x4>(ray.invDirection.y);
+		const float32x4 invDirZ = splat<float32x4>(ray.invDirection.z);
+
+		const float32x4 t0x = mul(sub(load_u<float32x4>(node.minX), originX), invDirX);
+		const float32x4 t1x = mul(sub(load_u<float32x4>(node.maxX), originX), invDirX);
+		const float32x4 t0y = mul(sub(load_u<float32x4>(node.minY), originY), invDirY);
+		const float32x4 t1y = mul(sub(load_u<float32x4>(node.maxY), originY), invDirY);
+		const float32x4 t0z = mul(sub(load_u<float32x4>(node.minZ), originZ), invDirZ);
+		const float32x4 t1z = mul(sub(load_u<float32x4>(node.maxZ), originZ), invDirZ);
+
+		float32x4 entry = max(min(t0x, t1x), min(t0y, t1y));
+		entry = max(entry, max(min(t0z, t1z), splat<float32x4>(0.0f)));
+
+		float32x4 exit = min(max(t0x, t1x), max(t0y, t1y));
+		exit = min(exit, min(max(t0z, t1z), splat<float32x4>(maxDistance)));
+
+		SIMDPP_ALIGN(16) UINT32 hits[4];
+		store(hits, bit_cast<uint32x4>(cmp_le(entry, exit)));
+		store_u(distances, entry);
+
+		UINT32 mask = 0;
+		for (UINT32 i = 0; i < node.numChildren; i++)
+		{
+			if (hits[i] != 0)
+				mask |= 1 << i;
+		}
+
+		return mask;
+	}
+
+	UINT32 BVH::intersectChildren(const Node& node, const Plane* planes, UINT32 numPlanes) const
+	{
+		using namespace simd;
+
+		const float32x4 half = splat<float32x4>(0.5f);
+		const float32x4 minX = load_u<float32x4>(node.minX);
+		const float32x4 minY = load_u<float32x4>(node.minY);
+		const float32x4 minZ = load_u<float32x4>(node.minZ);
+		const float32x4 maxX = load_u<float32x4>(node.maxX);
+		const float32x4 maxY = load_u<float32x4>(node.maxY);
+		const float32x4 maxZ = load_u<float32x4>(node.maxZ);
+
+		const float32x4 centerX = mul(add(minX, maxX), half);
+		const float32x4 centerY = mul(add(minY, maxY), half);
+		const float32x4 centerZ = mul(add(minZ, maxZ), half);
+		const float32x4 extentX = mul(sub(maxX, minX), half);
+		const float32x4 extentY = mul(sub(maxY, minY), half);
+		const float32x4 extentZ = mul(sub(maxZ, minZ), half);
+
+		// Same test as ConvexVolume::intersects(const AABox&)
+		uint32x4 outside = make_zero();
+		for (UINT32 i = 0; i < numPlanes; i++)
+		{
+			const Plane& plane = planes[i];
+
+			float32x4 distance = mul(centerX, splat<float32x4>(plane.normal.x));
+			distance = add(distance, mul(centerY, splat<float32x4>(plane.normal.y)));
+			distance = add(distance, mul(centerZ, splat<float32x4>(plane.normal.z)));
+			distance = sub(distance, splat<float32x4>(plane.d));
+
+			float32x4 radius = mul(extentX, splat<float32x4>(Math::abs(plane.normal.x)));
+			radius = add(radius, mul(extentY, splat<float32x4>(Math::abs(plane.normal.y))));
+			radius = add(radius, mul(extentZ, splat<float32x4>(Math::abs(plane.normal.z))));
+
+			outside = bit_or(outside, bit_cast<uint32x4>(cmp_lt(distance, neg(radius))));
+		}
+
+		SIMDPP_ALIGN(16) UINT32 culled[4];
+		store(culled, outside);
+
+		UINT32 mask = 0;
+		for (UINT32 i = 0; i < node.numChildren; i++)
+		{
+			if (culled[i] == 0)
+				mask |= 1 << i;
+		}
+
+		return mask;
+	}
+
+	bool BVH::intersectPrimitive(UINT32 idx, const RayData& ray, float maxDistance) const
+	{
+		const AABox& bounds = mPrimitiveBounds[idx];
+		const Vector3& min = bounds.getMin();
+		const Vector3& max = bounds.getMax();
+
+		float entry = 0.0f;
+		float exit = maxDistance;
+		for (UINT32 i = 0; i < 3; i++)
+		{
+			float t0 = (min[i] - ray.origin[i]) * ray.invDirection[i];
+			float t1 = (max[i] - ray.origin[i]) * ray.invDirection[i];
+			if (t0 > t1)
+				std::swap(t0, t1);
+
+			entry = std::max(entry, t0);
+			exit = std::min(exit, t1);
+		}
+
+		return entry <= exit;
+	}
+}
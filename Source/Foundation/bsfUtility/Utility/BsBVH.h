@@ -0,0 +1,260 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Math/BsAABox.h"
+#include "Math/BsRay.h"
+#include "Math/BsConvexVolume.h"
+#include "Utility/BsSmallVector.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Bounding volume hierarchy over a set of primitives represented by their axis aligned bounds, used for accelerating
+	 * ray and volume queries. Primitives can be anything that can be bounded by a box, e.g. triangles of a mesh or
+	 * renderables in a scene. Primitives are identified by their index in the array of bounds the hierarchy was built
+	 * from.
+	 *
+	 * The hierarchy is built using the surface area heuristic, and each node has up to four children whose bounds are
+	 * tested against a query at once using SIMD instructions. If the primitives move (e.g. animated renderables, or
+	 * skinned vertices), the hierarchy can be refit to the new bounds, which is much faster than rebuilding it, at the
+	 * cost of query performance degrading as the primitives move further from where they were during the build.
+	 *
+	 * Compared to Octree this structure cannot be incrementally modified, but queries are faster, especially ray queries
+	 * looking for the closest intersection.
+	 *
+	 * @note	Queries are thread safe, as long as the hierarchy isn't being built or refit at the same time.
+	 */
+	class BS_UTILITY_EXPORT BVH
+	{
+	public:
+		/** Maximum number of primitives stored in a single leaf. */
+		static constexpr UINT32 MAX_LEAF_SIZE = 4;
+
+		/** Ray with data pre-computed for fast box intersection tests. */
+		struct RayData
+		{
+			RayData(const Ray& ray);
+
+			Vector3 origin;
+			Vector3 invDirection;
+		};
+
+		BVH() = default;
+
+		/**
+		 * Builds the hierarchy for the provided primitives, replacing any existing contents.
+		 *
+		 * @param[in]	bounds		Bounds of each primitive.
+		 * @param[in]	count		Number of entries in the @p bounds array.
+		 */
+		void build(const AABox* bounds, UINT32 count);
+
+		/**
+		 * Updates the bounds of all primitives, without changing the structure of the hierarchy.
+		 *
+		 * @param[in]	bounds		Bounds of each primitive. Must contain the same number of entries the hierarchy was
+		 *							built with.
+		 */
+		void refit(const AABox* bounds);
+
+		/** Returns the number of primitives the hierarchy was built for. */
+		UINT32 getNumPrimitives() const { return (UINT32)mPrimitives.size(); }
+
+		/** Returns the bounds enclosing all the primitives. */
+		AABox getBounds() const;
+
+		/**
+		 * Finds all primitives whose bounds are intersected by a ray, visiting the nodes closer to the ray origin first.
+		 *
+		 * @param[in]	ray				Ray to test. Direction doesn't need to be normalized, in which case distances are
+		 *								expressed in multiples of the direction's length.
+		 * @param[in]	maxDistance		Maximum distance along the ray to look for intersections.
+		 * @param[in]	visitor			Callable with signature bool(UINT32 primitiveIdx, float& maxDistance), called for
+		 *								every primitive whose bounds are intersected. The visitor can test the primitive
+		 *								exactly and reduce @p maxDistance to the intersection distance, which prunes
+		 *								further traversal when looking for the closest intersection. Returning false stops
+		 *								the traversal, i.e. when any intersection is enough.
+		 */
+		template<class Visitor>
+		void raycast(const Ray& ray, float maxDistance, Visitor visitor) const;
+
+		/**
+		 * Finds all primitives whose bounds intersect a convex volume, like a camera frustum.
+		 *
+		 * @param[in]	volume		Volume to test.
+		 * @param[in]	visitor		Callable with signature void(UINT32 primitiveIdx), called for every primitive whose
+		 *							bounds intersect the volume.
+		 */
+		template<class Visitor>
+		void query(const ConvexVolume& volume, Visitor visitor) const;
+
+	private:
+		/** Node containing up to four children, with bounds stored in a structure-of-arrays layout. */
+		struct Node
+		{
+			float minX[4];
+			float minY[4];
+			float minZ[4];
+			float maxX[4];
+			float maxY[4];
+			float maxZ[4];
+
+			/** Index of the child node for interior children, or of the first primitive in mPrimitives for leaves. */
+			UINT32 children[4];
+
+			/** Number of primitives in the child if it is a leaf, zero if it is an interior node. */
+			UINT8 counts[4];
+
+			/** Number of used child slots, always stored first. */
+			UINT32 numChildren;
+		};
+
+		/** Entry of the stack used for ray traversal. */
+		struct RayStackEntry
+		{
+			UINT32 node;
+			float distance;
+		};
+
+		struct BuildData;
+
+		/** Splits the provided range of primitives into up to four children of the specified node. */
+		void buildNode(UINT32 nodeIdx, UINT32 start, UINT32 end, BuildData& data);
+
+		/**
+		 * Tests the ray against bounds of all the children of a node. Returns a bitmask with a bit set for each
+		 * intersected child, and writes the distance at which the ray enters each child.
+		 */
+		UINT32 intersectChildren(const Node& node, const RayData& ray, float maxDistance, float (&distances)[4]) const;
+
+		/**
+		 * Tests the volume against bounds of all the children of a node. Returns a bitmask with a bit set for each
+		 * intersected child.
+		 */
+		UINT32 intersectChildren(const Node& node, const Plane* planes, UINT32 numPlanes) const;
+
+		/** Tests the ray against the bounds of a single primitive, as stored in mPrimitiveBounds. */
+		bool intersectPrimitive(UINT32 idx, const RayData& ray, float maxDistance) const;
+
+		Vector<Node> mNodes;
+
+		/** Primitive indices, ordered so the primitives in each leaf are stored sequentially. */
+		Vector<UINT32> mPrimitives;
+
+		/** Bounds of each primitive, in the same order as mPrimitives. */
+		Vector<AABox> mPrimitiveBounds;
+	};
+
+	template<class Visitor>
+	void BVH::raycast(const Ray& ray, float maxDistance, Visitor visitor) const
+	{
+		if (mNodes.empty())
+			return;
+
+		const RayData rayData(ray);
+
+		SmallVector<RayStackEntry, 64> stack;
+		stack.add({ 0, 0.0f });
+
+		while (!stack.empty())
+		{
+			const RayStackEntry entry = stack.back();
+			stack.pop();
+
+			// Skip nodes that are further away than an intersection found since they were queued
+			if (entry.distance > maxDistance)
+				continue;
+
+			const Node& node = mNodes[entry.node];
+
+			float distances[4];
+			const UINT32 mask = intersectChildren(node, rayData, maxDistance, distances);
+			if (mask == 0)
+				continue;
+
+			// Visit leaves right away, and queue interior children so the closest one is visited next
+			RayStackEntry children[4];
+			UINT32 numChildren = 0;
+			for (UINT32 i = 0; i < node.numChildren; i++)
+			{
+				if ((mask & (1 << i)) == 0)
+					continue;
+
+				if (node.counts[i] > 0)
+				{
+					const UINT32 first = node.children[i];
+					for (UINT32 j = first; j < first + node.counts[i]; j++)
+					{
+						if (!intersectPrimitive(j, rayData, maxDistance))
+							continue;
+
+						if (!visitor(mPrimitives[j], maxDistance))
+							return;
+					}
+				}
+				else
+				{
+					UINT32 insertIdx = numChildren;
+					while (insertIdx > 0 && children[insertIdx - 1].distance < distances[i])
+					{
+						children[insertIdx] = children[insertIdx - 1];
+						insertIdx--;
+					}
+
+					children[insertIdx] = { node.children[i], distances[i] };
+					numChildren++;
+				}
+			}
+
+			// Children are sorted from the furthest to the closest
+			for (UINT32 i = 0; i < numChildren; i++)
+				stack.add(children[i]);
+		}
+	}
+
+	template<class Visitor>
+	void BVH::query(const ConvexVolume& volume, Visitor visitor) const
+	{
+		if (mNodes.empty())
+			return;
+
+		const Vector<Plane> planes = volume.getPlanes();
+		const auto numPlanes = (UINT32)planes.size();
+
+		SmallVector<UINT32, 64> stack;
+		stack.add(0);
+
+		while (!stack.empty())
+		{
+			const Node& node = mNodes[stack.back()];
+			stack.pop();
+
+			const UINT32 mask = intersectChildren(node, planes.data(), numPlanes);
+			for (UINT32 i = 0; i < node.numChildren; i++)
+			{
+				if ((mask & (1 << i)) == 0)
+					continue;
+
+				if (node.counts[i] > 0)
+				{
+					const UINT32 first = node.children[i];
+					for (UINT32 j = first; j < first + node.counts[i]; j++)
+					{
+						if (volume.intersects(mPrimitiveBounds[j]))
+							visitor(mPrimitives[j]);
+					}
+				}
+				else
+					stack.add(node.children[i]);
+			}
+		}
+	}
+
+	/** @} */
+}
@@ -335,6 +335,22 @@ namespace bs
 			return counter;
 		}
 
+		/** 
+		 * Changes the number of bits in the field to @p count. If the field grows the new bits are set to @p value.
+		 * Existing memory is kept when the field shrinks, so it can be re-grown without reallocating.
+		 */
+		void resize(uint32_t count, bool value = false)
+		{
+			if(count > mMaxBits)
+				realloc(count);
+
+			const uint32_t oldNumBits = mNumBits;
+			mNumBits = count;
+
+			for(uint32_t i = oldNumBits; i < count; i++)
+				(*this)[i] = value;
+		}
+
 		/** Resets all the bits in the field to the specified value. */
 		void reset(bool value = false)
 		{
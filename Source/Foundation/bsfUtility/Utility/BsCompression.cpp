@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Utility/BsCompression.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Math/BsMath.h"
 
 // Third party
 #include "snappy.h"
@@ -96,7 +98,7 @@ namespace bs
 			if(mBufferPieces.size() == 0 || mBufferPieces.back().buffer != data)
 			{
 				BufferPiece piece;
-				piece.buffer = (char*)bs_alloc((UINT32)n);
+				piece.buffer = (char*)bs_alloc(n);
 				piece.size = n;
 
 				memcpy(piece.buffer, data, n);
@@ -114,7 +116,7 @@ namespace bs
 		char* GetAppendBuffer(size_t len, char* scratch) override
 		{
 			BufferPiece piece;
-			piece.buffer = (char*)bs_alloc((UINT32)len);
+			piece.buffer = (char*)bs_alloc(len);
 			piece.size = 0;
 
 			mBufferPieces.push_back(piece);
@@ -125,7 +127,7 @@ namespace bs
 			size_t* allocated_size) override
 		{
 			BufferPiece piece;
-			piece.buffer = (char*)bs_alloc((UINT32)desired_size_hint);
+			piece.buffer = (char*)bs_alloc(desired_size_hint);
 			piece.size = 0;
 
 			mBufferPieces.push_back(piece);
@@ -191,4 +193,500 @@ namespace bs
 
 		return dst.GetOutput();
 	}
+
+	/** Header at the start of data in the block compression format. Followed by a table of stored block sizes. */
+	struct BlockFrameHeader
+	{
+		UINT32 magic;
+		UINT32 codec;
+		UINT32 blockSize;
+		UINT32 numBlocks;
+		UINT64 uncompressedSize;
+	};
+
+	/** Identifies data in the block compression format. */
+	static constexpr UINT32 BLOCK_FRAME_MAGIC = 0x43425342; // "BSBC"
+
+	/** Set in a block table entry if the block is stored without compression. */
+	static constexpr UINT32 BLOCK_STORED_FLAG = 0x80000000;
+
+	/** Information about data in the block compression format, required for locating individual blocks. */
+	struct BlockFrame
+	{
+		BlockFrameHeader header;
+		Vector<UINT32> blockSizes; /**< Stored size of each block, including BLOCK_STORED_FLAG. */
+		Vector<UINT64> blockOffsets; /**< Offset of each block relative to the start of the first block. */
+		UINT64 compressedSize = 0; /**< Total size of all the stored blocks. */
+		size_t dataStart = 0; /**< Position of the first block in the stream. */
+	};
+
+	/** Reads the header and block table of data in the block compression format. Returns false if the data is invalid. */
+	static bool readBlockFrame(DataStream& stream, BlockFrame& frame)
+	{
+		BlockFrameHeader& header = frame.header;
+		if (stream.read(&header, sizeof(header)) != sizeof(header) || header.magic != BLOCK_FRAME_MAGIC)
+			return false;
+
+		if (header.blockSize == 0 || header.blockSize >= BLOCK_STORED_FLAG)
+			return false;
+
+		if (Math::divideAndRoundUp(header.uncompressedSize, (UINT64)header.blockSize) != header.numBlocks)
+			return false;
+
+		const size_t tableSize = header.numBlocks * sizeof(UINT32);
+		frame.blockSizes.resize(header.numBlocks);
+		if (tableSize > 0 && stream.read(frame.blockSizes.data(), tableSize) != tableSize)
+			return false;
+
+		frame.blockOffsets.resize(header.numBlocks);
+
+		UINT64 offset = 0;
+		for (UINT32 i = 0; i < header.numBlocks; i++)
+		{
+			frame.blockOffsets[i] = offset;
+			offset += frame.blockSizes[i] & ~BLOCK_STORED_FLAG;
+		}
+
+		frame.compressedSize = offset;
+		frame.dataStart = stream.tell();
+		return true;
+	}
+
+	/** Returns the size of the specified block once decompressed. */
+	static UINT32 getBlockSize(const BlockFrameHeader& header, UINT32 blockIdx)
+	{
+		const UINT64 blockStart = blockIdx * (UINT64)header.blockSize;
+		return (UINT32)std::min((UINT64)header.blockSize, header.uncompressedSize - blockStart);
+	}
+
+	/** Decompresses a single block. Returns false if the block data is corrupt. */
+	static bool decompressBlock(CompressionCodec codec, UINT32 storedSize, const UINT8* input, UINT8* output, 
+		UINT32 outputSize)
+	{
+		const UINT32 inputSize = storedSize & ~BLOCK_STORED_FLAG;
+		if ((storedSize & BLOCK_STORED_FLAG) != 0 || codec == CompressionCodec::None)
+		{
+			if (inputSize != outputSize)
+				return false;
+
+			memcpy(output, input, inputSize);
+			return true;
+		}
+
+		switch (codec)
+		{
+		case CompressionCodec::Snappy:
+		{
+			size_t length = 0;
+			if (!snappy::GetUncompressedLength((const char*)input, inputSize, &length) || length != outputSize)
+				return false;
+
+			return snappy::RawUncompress((const char*)input, inputSize, (char*)output);
+		}
+		default:
+			return false;
+		}
+	}
+
+	/** Executes the worker for each block, in parallel if the task scheduler is available. */
+	static void forEachBlock(UINT32 numBlocks, const std::function<void(UINT32)>& worker)
+	{
+		if (numBlocks > 1 && TaskScheduler::isStarted())
+		{
+			// Not helping since the caller might be holding a lock other tasks need (e.g. the file scheduler lock)
+			TaskScheduler::instance().parallelFor(numBlocks, 1, [&worker](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+					worker(i);
+			}, false);
+		}
+		else
+		{
+			for (UINT32 i = 0; i < numBlocks; i++)
+				worker(i);
+		}
+	}
+
+	SPtr<MemoryDataStream> Compression::compressBlocks(const SPtr<DataStream>& input, CompressionCodec codec, 
+		UINT32 blockSize)
+	{
+		if (blockSize == 0 || blockSize >= BLOCK_STORED_FLAG)
+		{
+			LOGWRN("Invalid compression block size. Using the default block size instead.");
+			blockSize = DEFAULT_BLOCK_SIZE;
+		}
+
+		// Blocks are compressed in parallel, so the entire input needs to be accessible
+		SPtr<MemoryDataStream> inputCopy;
+		const UINT8* inputData;
+		UINT64 inputSize = input->size() - input->tell();
+		if (!input->isFile())
+		{
+			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(input);
+			inputData = memStream->getCurrentPtr();
+			input->skip((size_t)inputSize);
+		}
+		else
+		{
+			inputCopy = bs_shared_ptr_new<MemoryDataStream>((size_t)inputSize);
+			inputSize = input->read(inputCopy->getPtr(), (size_t)inputSize);
+			inputData = inputCopy->getPtr();
+		}
+
+		BlockFrameHeader header;
+		header.magic = BLOCK_FRAME_MAGIC;
+		header.codec = (UINT32)codec;
+		header.blockSize = blockSize;
+		header.numBlocks = (UINT32)Math::divideAndRoundUp(inputSize, (UINT64)blockSize);
+		header.uncompressedSize = inputSize;
+
+		Vector<UINT8*> compressedBlocks(header.numBlocks, nullptr);
+		Vector<UINT32> blockSizes(header.numBlocks);
+
+		forEachBlock(header.numBlocks, [&](UINT32 blockIdx)
+		{
+			const UINT8* blockData = inputData + blockIdx * (UINT64)blockSize;
+			const UINT32 size = getBlockSize(header, blockIdx);
+
+			if (codec == CompressionCodec::Snappy)
+			{
+				UINT8* compressedData = (UINT8*)bs_alloc(snappy::MaxCompressedLength(size));
+
+				size_t compressedSize = 0;
+				snappy::RawCompress((const char*)blockData, size, (char*)compressedData, &compressedSize);
+
+				if (compressedSize < size)
+				{
+					compressedBlocks[blockIdx] = compressedData;
+					blockSizes[blockIdx] = (UINT32)compressedSize;
+					return;
+				}
+
+				bs_free(compressedData);
+			}
+
+			blockSizes[blockIdx] = size | BLOCK_STORED_FLAG;
+		});
+
+		UINT64 totalSize = sizeof(header) + header.numBlocks * sizeof(UINT32);
+		for (auto& entry : blockSizes)
+			totalSize += entry & ~BLOCK_STORED_FLAG;
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)totalSize);
+		output->write(&header, sizeof(header));
+		output->write(blockSizes.data(), blockSizes.size() * sizeof(UINT32));
+
+		for (UINT32 i = 0; i < header.numBlocks; i++)
+		{
+			if (compressedBlocks[i] != nullptr)
+			{
+				output->write(compressedBlocks[i], blockSizes[i]);
+				bs_free(compressedBlocks[i]);
+			}
+			else
+				output->write(inputData + i * (UINT64)blockSize, blockSizes[i] & ~BLOCK_STORED_FLAG);
+		}
+
+		output->seek(0);
+		return output;
+	}
+
+	SPtr<MemoryDataStream> Compression::decompressBlocks(const SPtr<DataStream>& input)
+	{
+		BlockFrame frame;
+		if (!readBlockFrame(*input, frame))
+		{
+			LOGERR("Decompression failed, data is not in the block compression format.");
+			return nullptr;
+		}
+
+		// Blocks are decompressed in parallel, so all the compressed data needs to be accessible
+		SPtr<MemoryDataStream> inputCopy;
+		const UINT8* inputData;
+		if (!input->isFile())
+		{
+			if ((UINT64)(input->size() - input->tell()) < frame.compressedSize)
+			{
+				LOGERR("Decompression failed, corrupt data.");
+				return nullptr;
+			}
+
+			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(input);
+			inputData = memStream->getCurrentPtr();
+			input->skip((size_t)frame.compressedSize);
+		}
+		else
+		{
+			inputCopy = bs_shared_ptr_new<MemoryDataStream>((size_t)frame.compressedSize);
+			if (input->read(inputCopy->getPtr(), (size_t)frame.compressedSize) != frame.compressedSize)
+			{
+				LOGERR("Decompression failed, corrupt data.");
+				return nullptr;
+			}
+
+			inputData = inputCopy->getPtr();
+		}
+
+		const BlockFrameHeader& header = frame.header;
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)header.uncompressedSize);
+		UINT8* outputData = output->getPtr();
+
+		std::atomic<bool> corrupt{false};
+		forEachBlock(header.numBlocks, [&](UINT32 blockIdx)
+		{
+			if (!decompressBlock((CompressionCodec)header.codec, frame.blockSizes[blockIdx], inputData + frame.blockOffsets[blockIdx], 
+				outputData + blockIdx * (UINT64)header.blockSize, getBlockSize(header, blockIdx)))
+				corrupt = true;
+		});
+
+		if (corrupt)
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		return output;
+	}
+
+	bool Compression::decompressBlockRange(const SPtr<DataStream>& input, UINT64 offset, UINT64 size, UINT8* output)
+	{
+		const size_t start = input->tell();
+
+		BlockFrame frame;
+		bool success = readBlockFrame(*input, frame);
+
+		const BlockFrameHeader& header = frame.header;
+		if (success && (size > header.uncompressedSize || offset > header.uncompressedSize - size))
+			success = false;
+
+		if (success && size > 0)
+		{
+			const UINT32 firstBlock = (UINT32)(offset / header.blockSize);
+			const UINT32 lastBlock = (UINT32)((offset + size - 1) / header.blockSize);
+
+			UINT8* inputBuffer = (UINT8*)bs_alloc(header.blockSize);
+			UINT8* blockBuffer = (UINT8*)bs_alloc(header.blockSize);
+
+			for (UINT32 i = firstBlock; i <= lastBlock; i++)
+			{
+				const UINT32 storedSize = frame.blockSizes[i] & ~BLOCK_STORED_FLAG;
+				if (storedSize > header.blockSize)
+				{
+					success = false;
+					break;
+				}
+
+				input->seek(frame.dataStart + (size_t)frame.blockOffsets[i]);
+				if (input->read(inputBuffer, storedSize) != storedSize)
+				{
+					success = false;
+					break;
+				}
+
+				const UINT64 blockStart = i * (UINT64)header.blockSize;
+				const UINT32 blockSize = getBlockSize(header, i);
+				success = decompressBlock((CompressionCodec)header.codec, frame.blockSizes[i], inputBuffer, blockBuffer, blockSize);
+				if (!success)
+					break;
+
+				const UINT64 copyStart = std::max(offset, blockStart);
+				const UINT64 copyEnd = std::min(offset + size, blockStart + blockSize);
+				memcpy(output + (copyStart - offset), blockBuffer + (copyStart - blockStart), (size_t)(copyEnd - copyStart));
+			}
+
+			bs_free(blockBuffer);
+			bs_free(inputBuffer);
+		}
+
+		input->seek(start);
+		return success;
+	}
+
+	bool Compression::getBlockDecompressedSize(const SPtr<DataStream>& input, UINT64& size)
+	{
+		const size_t start = input->tell();
+
+		BlockFrameHeader header;
+		const bool valid = input->read(&header, sizeof(header)) == sizeof(header) && header.magic == BLOCK_FRAME_MAGIC;
+		input->seek(start);
+
+		if (!valid)
+			return false;
+
+		size = header.uncompressedSize;
+		return true;
+	}
+
+	SPtr<DataStream> Compression::decompressBlocksStreamed(const SPtr<DataStream>& input, size_t prefixSize)
+	{
+		const size_t start = input->tell();
+		input->skip(prefixSize);
+
+		BlockFrame frame;
+		const bool valid = readBlockFrame(*input, frame);
+		input->seek(start);
+
+		if (!valid)
+		{
+			LOGERR("Decompression failed, data is not in the block compression format.");
+			return nullptr;
+		}
+
+		SPtr<BlockDecompressionDataStream> output = bs_shared_ptr_new<BlockDecompressionDataStream>(
+			BlockDecompressionDataStream::ConstructPrivately());
+		output->mSource = input;
+		output->mSourceStart = start;
+		output->mPrefixSize = prefixSize;
+		output->mCodec = (CompressionCodec)frame.header.codec;
+		output->mBlockSize = frame.header.blockSize;
+		output->mBlockSizes = std::move(frame.blockSizes);
+		output->mBlockOffsets = std::move(frame.blockOffsets);
+		output->mDataStart = frame.dataStart;
+		output->mSize = prefixSize + (size_t)frame.header.uncompressedSize;
+
+		if (frame.header.numBlocks > 0)
+		{
+			output->mBlockData = (UINT8*)bs_alloc(output->mBlockSize);
+			output->mReadBuffer = (UINT8*)bs_alloc(output->mBlockSize);
+		}
+
+		return output;
+	}
+
+	BlockDecompressionDataStream::BlockDecompressionDataStream(const ConstructPrivately& dummy)
+	{ }
+
+	BlockDecompressionDataStream::~BlockDecompressionDataStream()
+	{
+		close();
+	}
+
+	size_t BlockDecompressionDataStream::read(void* buf, size_t count)
+	{
+		if (!mSource)
+			return 0;
+
+		count = std::min(count, mSize - std::min(mPos, mSize));
+
+		UINT8* output = (UINT8*)buf;
+		size_t numRead = 0;
+
+		// Prefix is stored as is, read it directly from the source
+		if (mPos < mPrefixSize)
+		{
+			const size_t prefixCount = std::min(count, mPrefixSize - mPos);
+
+			mSource->seek(mSourceStart + mPos);
+			const size_t numPrefixRead = mSource->read(output, prefixCount);
+
+			numRead += numPrefixRead;
+			mPos += numPrefixRead;
+
+			if (numPrefixRead != prefixCount)
+				return numRead;
+		}
+
+		while (numRead < count)
+		{
+			const UINT64 offset = mPos - mPrefixSize;
+			const UINT32 blockIdx = (UINT32)(offset / mBlockSize);
+			if (!loadBlock(blockIdx))
+				break;
+
+			const UINT32 offsetInBlock = (UINT32)(offset - blockIdx * (UINT64)mBlockSize);
+			const size_t copySize = std::min(count - numRead, (size_t)(mCachedBlockSize - offsetInBlock));
+			memcpy(output + numRead, mBlockData + offsetInBlock, copySize);
+
+			numRead += copySize;
+			mPos += copySize;
+		}
+
+		return numRead;
+	}
+
+	void BlockDecompressionDataStream::skip(size_t count)
+	{
+		mPos = std::min(mPos + count, mSize);
+	}
+
+	void BlockDecompressionDataStream::seek(size_t pos)
+	{
+		mPos = std::min(pos, mSize);
+	}
+
+	size_t BlockDecompressionDataStream::tell() const
+	{
+		return mPos;
+	}
+
+	bool BlockDecompressionDataStream::eof() const
+	{
+		return mPos >= mSize;
+	}
+
+	SPtr<DataStream> BlockDecompressionDataStream::clone(bool copyData) const
+	{
+		if (!mSource)
+			return nullptr;
+
+		SPtr<DataStream> source = mSource->clone(copyData);
+		source->seek(mSourceStart);
+
+		return Compression::decompressBlocksStreamed(source, mPrefixSize);
+	}
+
+	void BlockDecompressionDataStream::close()
+	{
+		if (mBlockData != nullptr)
+		{
+			bs_free(mBlockData);
+			mBlockData = nullptr;
+		}
+
+		if (mReadBuffer != nullptr)
+		{
+			bs_free(mReadBuffer);
+			mReadBuffer = nullptr;
+		}
+
+		mSource = nullptr;
+		mCachedBlockIdx = (UINT32)-1;
+	}
+
+	bool BlockDecompressionDataStream::loadBlock(UINT32 blockIdx)
+	{
+		if (blockIdx == mCachedBlockIdx)
+			return true;
+
+		if (blockIdx >= (UINT32)mBlockSizes.size())
+			return false;
+
+		mCachedBlockIdx = (UINT32)-1;
+
+		const UINT32 storedSize = mBlockSizes[blockIdx] & ~BLOCK_STORED_FLAG;
+		if (storedSize > mBlockSize)
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return false;
+		}
+
+		mSource->seek(mDataStart + (size_t)mBlockOffsets[blockIdx]);
+		if (mSource->read(mReadBuffer, storedSize) != storedSize)
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return false;
+		}
+
+		const UINT64 blockStart = blockIdx * (UINT64)mBlockSize;
+		const UINT32 blockSize = (UINT32)std::min((UINT64)mBlockSize, (mSize - mPrefixSize) - blockStart);
+		if (!decompressBlock(mCodec, mBlockSizes[blockIdx], mReadBuffer, mBlockData, blockSize))
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return false;
+		}
+
+		mCachedBlockIdx = blockIdx;
+		mCachedBlockSize = blockSize;
+		return true;
+	}
 }
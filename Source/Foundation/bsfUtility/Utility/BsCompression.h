@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -10,15 +11,144 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Codecs that may be used for compressing individual blocks of the block compression format. */
+	enum class CompressionCodec
+	{
+		/** Blocks are stored without compression. */
+		None = 0,
+		/** Very fast compression and decompression, with moderate compression ratio. */
+		Snappy = 1
+	};
+
 	/** Performs generic compression and decompression on raw data. */
 	class BS_UTILITY_EXPORT Compression
 	{
 	public:
+		/** Default size of a single block of uncompressed data in the block compression format, in bytes. */
+		static constexpr UINT32 DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+		/** 
+		 * Size of uncompressed data in the block compression format above which it should be decompressed through
+		 * decompressBlocksStreamed() instead of being decompressed into memory all at once.
+		 */
+		static constexpr UINT64 STREAMING_THRESHOLD = 32 * 1024 * 1024;
+
 		/** Compresses the data from the provided data stream and outputs the new stream with compressed data. */
 		static SPtr<MemoryDataStream> compress(SPtr<DataStream>& input);
 
 		/** Decompresses the data from the provided data stream and outputs the new stream with decompressed data. */
 		static SPtr<MemoryDataStream> decompress(SPtr<DataStream>& input);
+
+		/**
+		 * Compresses the data from the current position in the provided stream into the block compression format. Data is
+		 * split into independent blocks, allowing them to be compressed and decompressed in parallel, as well as allowing
+		 * a part of the data to be decompressed without decompressing the rest. Blocks that would not get smaller 
+		 * when compressed are stored uncompressed.
+		 *
+		 * @param[in]	input		Stream to read the data to compress from. Read until the end.
+		 * @param[in]	codec		Codec to compress the blocks with.
+		 * @param[in]	blockSize	Size of a single block of uncompressed data, in bytes. Smaller blocks allow finer
+		 *							grained random access, at the cost of compression ratio.
+		 * @return					Stream containing the compressed data.
+		 */
+		static SPtr<MemoryDataStream> compressBlocks(const SPtr<DataStream>& input, 
+			CompressionCodec codec = CompressionCodec::Snappy, UINT32 blockSize = DEFAULT_BLOCK_SIZE);
+
+		/** 
+		 * Decompresses data in the block compression format, starting at the current position in the provided stream. 
+		 * Blocks are decompressed in parallel if the task scheduler is running. Returns null if the data is corrupt.
+		 */
+		static SPtr<MemoryDataStream> decompressBlocks(const SPtr<DataStream>& input);
+
+		/**
+		 * Decompresses a range of data in the block compression format, starting at the current position in the provided
+		 * stream. Only the blocks overlapping the range are read and decompressed. The stream position is left unchanged.
+		 *
+		 * @param[in]	input		Stream containing the compressed data.
+		 * @param[in]	offset		Offset into the uncompressed data to start decompressing at, in bytes.
+		 * @param[in]	size		Number of bytes of uncompressed data to output.
+		 * @param[out]	output		Buffer of at least @p size bytes to output the uncompressed data to.
+		 * @return					False if the range is out of bounds of the uncompressed data, or the data is corrupt.
+		 */
+		static bool decompressBlockRange(const SPtr<DataStream>& input, UINT64 offset, UINT64 size, UINT8* output);
+
+		/** 
+		 * Reads the size of the uncompressed data in the block compression format, starting at the current position in the
+		 * provided stream. The stream position is left unchanged. Returns false if the data isn't in the block compression
+		 * format.
+		 */
+		static bool getBlockDecompressedSize(const SPtr<DataStream>& input, UINT64& size);
+
+		/**
+		 * Creates a stream that decompresses data in the block compression format on demand, as it is being read, 
+		 * starting at the current position in the provided stream. Only a single block of uncompressed data is kept in
+		 * memory at a time, so arbitrarily large data can be read without decompressing all of it up front. Returns
+		 * null if the data isn't in the block compression format.
+		 *
+		 * @param[in]	input		Stream containing the compressed data. The returned stream takes over reading from it
+		 *							and it should not be accessed directly while the returned stream is in use.
+		 * @param[in]	prefixSize	Number of uncompressed bytes preceding the compressed data in @p input. These are
+		 *							returned as is at the start of the output stream.
+		 */
+		static SPtr<DataStream> decompressBlocksStreamed(const SPtr<DataStream>& input, size_t prefixSize = 0);
+	};
+
+	/** 
+	 * Read-only stream that decompresses data in the block compression format as it is read. Seeking is supported, but
+	 * moving outside of the current block requires the target block to be decompressed again. Reports itself as a file
+	 * stream since its data cannot be accessed directly in memory. Created through Compression::decompressBlocksStreamed().
+	 */
+	class BS_UTILITY_EXPORT BlockDecompressionDataStream : public DataStream
+	{
+		struct ConstructPrivately {};
+	public:
+		BlockDecompressionDataStream(const ConstructPrivately& dummy);
+		~BlockDecompressionDataStream();
+
+		bool isFile() const override { return true; }
+
+		/** @copydoc DataStream::read */
+		size_t read(void* buf, size_t count) override;
+
+		/** @copydoc DataStream::skip */
+		void skip(size_t count) override;
+	
+		/** @copydoc DataStream::seek */
+		void seek(size_t pos) override;
+
+		/** @copydoc DataStream::tell */
+		size_t tell() const override;
+
+		/** @copydoc DataStream::eof */
+		bool eof() const override;
+
+		/** @copydoc DataStream::clone */
+		SPtr<DataStream> clone(bool copyData = true) const override;
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+	private:
+		friend class Compression;
+
+		/** Decompresses the block with the specified index, unless it is already loaded. Returns false on failure. */
+		bool loadBlock(UINT32 blockIdx);
+
+		SPtr<DataStream> mSource;
+		size_t mSourceStart = 0;
+		size_t mPrefixSize = 0;
+		size_t mPos = 0;
+
+		CompressionCodec mCodec = CompressionCodec::None;
+		UINT32 mBlockSize = 0;
+		Vector<UINT32> mBlockSizes;
+		Vector<UINT64> mBlockOffsets;
+		size_t mDataStart = 0;
+
+		UINT8* mBlockData = nullptr;
+		UINT8* mReadBuffer = nullptr;
+		UINT32 mCachedBlockIdx = (UINT32)-1;
+		UINT32 mCachedBlockSize = 0;
 	};
 
 	/** @} */
@@ -0,0 +1,220 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	template <typename Signature>
+	class Delegate;
+
+	/**
+	 * Wrapper around any callable object, similar to std::function. Small callables (e.g. lambdas capturing a few
+	 * values, or the result of binding a method to an object with std::bind) are stored inline, without allocating
+	 * any memory. Larger callables are allocated on the heap.
+	 */
+	template <class RetType, class... Args>
+	class Delegate<RetType(Args...)>
+	{
+	public:
+		/** Number of bytes available for storing a callable inline. */
+		static constexpr UINT32 INLINE_SIZE = sizeof(void*) * 6;
+
+	private:
+		/** Operations performed on the stored callable, by the type specific manager function. */
+		enum class Op
+		{
+			Copy, Move, Destroy
+		};
+
+		using InvokeFunc = RetType(*)(const void*, Args&&...);
+		using ManageFunc = void(*)(Op, void*, void*);
+
+		/** Checks can a callable of type @p T be stored inline. */
+		template <class T>
+		struct IsInline
+		{
+			static constexpr bool value = sizeof(T) <= INLINE_SIZE && alignof(T) <= alignof(std::max_align_t) &&
+				std::is_nothrow_move_constructible<T>::value;
+		};
+
+	public:
+		Delegate() = default;
+		Delegate(std::nullptr_t) { }
+
+		/** Creates a delegate wrapping the provided callable. */
+		template <class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, Delegate>::value>>
+		Delegate(F&& func)
+		{
+			assign(std::forward<F>(func));
+		}
+
+		Delegate(const Delegate& other)
+		{
+			if (other.mManage != nullptr)
+				other.mManage(Op::Copy, mStorage, (void*)other.mStorage);
+
+			mInvoke = other.mInvoke;
+			mManage = other.mManage;
+		}
+
+		Delegate(Delegate&& other) noexcept
+		{
+			if (other.mManage != nullptr)
+				other.mManage(Op::Move, mStorage, other.mStorage);
+
+			mInvoke = other.mInvoke;
+			mManage = other.mManage;
+
+			other.mInvoke = nullptr;
+			other.mManage = nullptr;
+		}
+
+		~Delegate()
+		{
+			reset();
+		}
+
+		Delegate& operator=(const Delegate& other)
+		{
+			if (this != &other)
+			{
+				Delegate copy(other);
+				*this = std::move(copy);
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(Delegate&& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+
+				if (other.mManage != nullptr)
+					other.mManage(Op::Move, mStorage, other.mStorage);
+
+				mInvoke = other.mInvoke;
+				mManage = other.mManage;
+
+				other.mInvoke = nullptr;
+				other.mManage = nullptr;
+			}
+
+			return *this;
+		}
+
+		Delegate& operator=(std::nullptr_t)
+		{
+			reset();
+			return *this;
+		}
+
+		/** Calls the stored callable. Must not be called on an empty delegate. */
+		RetType operator()(Args... args) const
+		{
+			return mInvoke(mStorage, std::forward<Args>(args)...);
+		}
+
+		/** Checks does the delegate store a callable. */
+		explicit operator bool() const { return mInvoke != nullptr; }
+
+		bool operator==(std::nullptr_t) const { return mInvoke == nullptr; }
+		bool operator!=(std::nullptr_t) const { return mInvoke != nullptr; }
+
+	private:
+		/** Stores the provided callable, inline if possible. */
+		template <class F>
+		void assign(F&& func)
+		{
+			using T = std::decay_t<F>;
+
+			if (!isCallable(func))
+				return;
+
+			if (IsInline<T>::value)
+			{
+				new (mStorage) T(std::forward<F>(func));
+
+				mInvoke = [](const void* storage, Args&&... args) -> RetType
+				{
+					return (*(T*)storage)(std::forward<Args>(args)...);
+				};
+
+				mManage = [](Op op, void* dst, void* src)
+				{
+					switch (op)
+					{
+					case Op::Copy:
+						new (dst) T(*(const T*)src);
+						break;
+					case Op::Move:
+						new (dst) T(std::move(*(T*)src));
+						((T*)src)->~T();
+						break;
+					case Op::Destroy:
+						((T*)dst)->~T();
+						break;
+					}
+				};
+			}
+			else
+			{
+				*(T**)mStorage = bs_new<T>(std::forward<F>(func));
+
+				mInvoke = [](const void* storage, Args&&... args) -> RetType
+				{
+					return (**(T* const*)storage)(std::forward<Args>(args)...);
+				};
+
+				mManage = [](Op op, void* dst, void* src)
+				{
+					switch (op)
+					{
+					case Op::Copy:
+						*(T**)dst = bs_new<T>(**(const T* const*)src);
+						break;
+					case Op::Move:
+						*(T**)dst = *(T**)src;
+						break;
+					case Op::Destroy:
+						bs_delete(*(T**)dst);
+						break;
+					}
+				};
+			}
+		}
+
+		/** Destroys the stored callable, if any. */
+		void reset()
+		{
+			if (mManage != nullptr)
+				mManage(Op::Destroy, mStorage, nullptr);
+
+			mInvoke = nullptr;
+			mManage = nullptr;
+		}
+
+		/** Checks is a callable empty (e.g. a null function pointer or an empty std::function). */
+		template <class F>
+		static bool isCallable(const F& func) { return isCallable(func, 0); }
+
+		template <class F>
+		static auto isCallable(const F& func, int) -> decltype(func == nullptr) { return !(func == nullptr); }
+
+		template <class F>
+		static bool isCallable(const F& func, long) { return true; }
+
+		alignas(std::max_align_t) mutable UINT8 mStorage[INLINE_SIZE];
+		InvokeFunc mInvoke = nullptr;
+		ManageFunc mManage = nullptr;
+	};
+
+	/** @} */
+}
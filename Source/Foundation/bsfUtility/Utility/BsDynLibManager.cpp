@@ -45,6 +45,8 @@ namespace
 		if(DynLib::PREFIX != nullptr)
 			filename.insert(0, DynLib::PREFIX);
 
+		Lock lock(mMutex);
+
 		const auto& iterFind = mLoadedLibraries.lower_bound(filename);
 		if(iterFind != mLoadedLibraries.end() && (*iterFind)->getName() == filename)
 		{
@@ -60,6 +62,8 @@ namespace
 
 	void DynLibManager::unload(DynLib* lib)
 	{
+		Lock lock(mMutex);
+
 		const auto& iterFind = mLoadedLibraries.find(lib->getName());
 		if(iterFind != mLoadedLibraries.end())
 		{
@@ -15,7 +15,8 @@ namespace bs
 	 * This manager keeps track of all the open dynamic-loading libraries, it manages opening them opens them and can be
 	 * used to lookup already already-open libraries.
 	 *
-	 * @note	Not thread safe.
+	 * @note	Thread safe. Libraries are opened while holding a lock, so a library being opened on one thread is never
+	 *			opened for a second time on another.
 	 */
 	class BS_UTILITY_EXPORT DynLibManager : public Module<DynLibManager>
 	{
@@ -32,6 +33,7 @@ namespace bs
 
 	protected:
 		Set<UPtr<DynLib>, std::less<>> mLoadedLibraries;
+		Mutex mMutex;
 	};
 
 	/** Easy way of accessing DynLibManager. */
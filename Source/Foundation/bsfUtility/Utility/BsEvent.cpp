@@ -0,0 +1,31 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsEvent.h"
+#include "Allocators/BsPoolAlloc.h"
+
+namespace bs
+{
+	using EventConnectionPool = LockFreePoolAlloc<EVENT_CONNECTION_SIZE, 256, EVENT_CONNECTION_ALIGNMENT>;
+
+	/**
+	 * Returns the pool all event connections are allocated from. The pool is intentionally never destroyed, since
+	 * events in static objects can still release their connections during static de-initialization.
+	 */
+	static EventConnectionPool& getConnectionPool()
+	{
+		alignas(EventConnectionPool) static UINT8 storage[sizeof(EventConnectionPool)];
+		static EventConnectionPool* pool = new (storage) EventConnectionPool();
+
+		return *pool;
+	}
+
+	void* EventConnectionAlloc::alloc()
+	{
+		return getConnectionPool().alloc();
+	}
+
+	void EventConnectionAlloc::free(void* data)
+	{
+		getConnectionPool().free(data);
+	}
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsDelegate.h"
 
 namespace bs
 {
@@ -36,42 +37,79 @@ namespace bs
 		UINT32 handleLinks = 0;
 	};
 
+	/** 
+	 * Layout of the connection data for every event type, used for determining the size of the memory allocated for a
+	 * connection. All delegate types share the same size and alignment, regardless of their signature.
+	 */
+	class EventConnectionStorage : public BaseConnectionData
+	{
+		Delegate<void()> func;
+	};
+
+	/** 
+	 * Allocates and frees memory for event connections. Connections of all events are allocated from a single pool,
+	 * so connecting to an event doesn't require a heap allocation in the common case. Thread safe.
+	 */
+	class BS_UTILITY_EXPORT EventConnectionAlloc
+	{
+	public:
+		/** Allocates memory for a single connection, of size EVENT_CONNECTION_SIZE. */
+		static void* alloc();
+
+		/** Frees memory previously allocated with alloc(). */
+		static void free(void* data);
+	};
+
 	/** Internal data for an Event, storing all connections. */
 	struct EventInternalData
 	{
-		EventInternalData() = default;
-
-		~EventInternalData()
+		/** 
+		 * Locks the event's mutex for the duration of its lifetime. Does nothing if the event isn't thread safe.
+		 * Recursive, so callbacks are allowed to modify the event while it is being triggered.
+		 */
+		class ScopedLock
 		{
-			BaseConnectionData* conn = mConnections;
-			while (conn != nullptr)
+		public:
+			explicit ScopedLock(EventInternalData& data)
+				:mData(data)
 			{
-				BaseConnectionData* next = conn->next;
-				bs_free(conn);
-
-				conn = next;
+				if (mData.mThreadSafe)
+					mData.mMutex.lock();
 			}
 
-			conn = mFreeConnections;
-			while (conn != nullptr)
+			~ScopedLock()
 			{
-				BaseConnectionData* next = conn->next;
-				bs_free(conn);
-
-				conn = next;
+				if (mData.mThreadSafe)
+					mData.mMutex.unlock();
 			}
 
-			conn = mNewConnections;
+		private:
+			EventInternalData& mData;
+		};
+
+		explicit EventInternalData(bool threadSafe)
+			:mThreadSafe(threadSafe)
+		{ }
+
+		~EventInternalData()
+		{
+			BaseConnectionData* conn = mConnections;
 			while (conn != nullptr)
 			{
 				BaseConnectionData* next = conn->next;
-				bs_free(conn);
+
+				conn->deactivate();
+				conn->handleLinks = 0;
+				destroy(conn);
 
 				conn = next;
 			}
 		}
 
-		/** Appends a new connection to the active connection array. */
+		/** 
+		 * Appends a new connection to the active connection array. Connections added while the event is being triggered
+		 * will not be notified until the next time the event is triggered.
+		 */
 		void connect(BaseConnectionData* conn)
 		{
 			conn->prev = mLastConnection;
@@ -93,9 +131,9 @@ namespace bs
 		 */
 		void disconnect(BaseConnectionData* conn)
 		{
-			RecursiveLock lock(mMutex);
+			ScopedLock lock(*this);
 
-			conn->deactivate();
+			deactivate(conn);
 			conn->handleLinks--;
 
 			if (conn->handleLinks == 0)
@@ -105,22 +143,43 @@ namespace bs
 		/** Disconnects all connections in the event. */
 		void clear()
 		{
-			RecursiveLock lock(mMutex);
+			ScopedLock lock(*this);
 
 			BaseConnectionData* conn = mConnections;
 			while (conn != nullptr)
 			{
 				BaseConnectionData* next = conn->next;
-				conn->deactivate();
+				deactivate(conn);
 
+				// Connections still referenced by a handle stay in the list (inactive) until the handle is released
 				if (conn->handleLinks == 0)
 					free(conn);
 
 				conn = next;
 			}
+		}
 
-			mConnections = nullptr;
-			mLastConnection = nullptr;
+		/** 
+		 * Stops the connection from being notified. If the event is currently being triggered the connection's callback
+		 * might be executing, in which case it is only released once the trigger finishes.
+		 */
+		void deactivate(BaseConnectionData* conn)
+		{
+			if (mTriggerDepth > 0)
+			{
+				conn->isActive = false;
+				mHasPendingFrees = true;
+			}
+			else
+				conn->deactivate();
+		}
+
+		/** Called when a new event handle starts referencing the connection. */
+		void addHandle(BaseConnectionData* conn)
+		{
+			ScopedLock lock(*this);
+
+			conn->handleLinks++;
 		}
 
 		/**
@@ -129,7 +188,7 @@ namespace bs
 		 */
 		void freeHandle(BaseConnectionData* conn)
 		{
-			RecursiveLock lock(mMutex);
+			ScopedLock lock(*this);
 
 			conn->handleLinks--;
 
@@ -137,9 +196,18 @@ namespace bs
 				free(conn);
 		}
 
-		/** Releases connection data and makes it available for re-use when next connection is formed. */
+		/** 
+		 * Removes the connection from the connection list and releases its memory. If the event is currently being
+		 * triggered the connection is only released once the trigger finishes, so the list can be safely iterated over.
+		 */
 		void free(BaseConnectionData* conn)
 		{
+			if (mTriggerDepth > 0)
+			{
+				mHasPendingFrees = true;
+				return;
+			}
+
 			if (conn->prev != nullptr)
 				conn->prev->next = conn->next;
 			else
@@ -150,28 +218,68 @@ namespace bs
 			else
 				mLastConnection = conn->prev;
 
-			conn->prev = nullptr;
-			conn->next = nullptr;
+			destroy(conn);
+		}
+
+		/** 
+		 * Releases callbacks of connections that were deactivated while the event was triggering, as well as the
+		 * connections themselves if they have no handles.
+		 */
+		void freePending()
+		{
+			mHasPendingFrees = false;
+
+			BaseConnectionData* conn = mConnections;
+			while (conn != nullptr)
+			{
+				BaseConnectionData* next = conn->next;
+
+				if (!conn->isActive)
+				{
+					conn->deactivate();
+
+					if (conn->handleLinks == 0)
+						free(conn);
+				}
+
+				conn = next;
+			}
+		}
 
-			if (mFreeConnections != nullptr)
+		/** Checks are there any active connections. */
+		bool hasActiveConnections() const
+		{
+			for (BaseConnectionData* conn = mConnections; conn != nullptr; conn = conn->next)
 			{
-				conn->next = mFreeConnections;
-				mFreeConnections->prev = conn;
+				if (conn->isActive)
+					return true;
 			}
 
-			mFreeConnections = conn;
-			mFreeConnections->~BaseConnectionData();
+			return false;
+		}
+
+		/** Destructs the connection and returns its memory to the connection pool. */
+		static void destroy(BaseConnectionData* conn)
+		{
+			conn->~BaseConnectionData();
+			EventConnectionAlloc::free(conn);
 		}
 
 		BaseConnectionData* mConnections = nullptr;
 		BaseConnectionData* mLastConnection = nullptr;
-		BaseConnectionData* mFreeConnections = nullptr;
-		BaseConnectionData* mNewConnections = nullptr;
 
 		RecursiveMutex mMutex;
-		bool mIsCurrentlyTriggering = false;
+		UINT32 mTriggerDepth = 0;
+		bool mHasPendingFrees = false;
+		const bool mThreadSafe;
 	};
 
+	/** Size of the memory allocated for a single event connection. */
+	static constexpr UINT32 EVENT_CONNECTION_SIZE = sizeof(EventConnectionStorage);
+
+	/** Alignment of the memory allocated for a single event connection. */
+	static constexpr UINT32 EVENT_CONNECTION_ALIGNMENT = alignof(EventConnectionStorage);
+
 	/** @} */
 	/** @} */
 
@@ -191,6 +299,19 @@ namespace bs
 			connection->handleLinks++;
 		}
 
+		HEvent(const HEvent& other)
+			:mConnection(other.mConnection), mEventData(other.mEventData)
+		{
+			if (mConnection != nullptr)
+				mEventData->addHandle(mConnection);
+		}
+
+		HEvent(HEvent&& other) noexcept
+			:mConnection(other.mConnection), mEventData(std::move(other.mEventData))
+		{
+			other.mConnection = nullptr;
+		}
+
 		~HEvent()
 		{
 			if (mConnection != nullptr)
@@ -231,11 +352,27 @@ namespace bs
 
 		HEvent& operator=(const HEvent& rhs)
 		{
-			mConnection = rhs.mConnection;
-			mEventData = rhs.mEventData;
+			if (this != &rhs)
+			{
+				HEvent copy(rhs);
+				*this = std::move(copy);
+			}
 
-			if (mConnection != nullptr)
-				mConnection->handleLinks++;
+			return *this;
+		}
+
+		HEvent& operator=(HEvent&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				if (mConnection != nullptr)
+					mEventData->freeHandle(mConnection);
+
+				mConnection = rhs.mConnection;
+				mEventData = std::move(rhs.mEventData);
+
+				rhs.mConnection = nullptr;
+			}
 
 			return *this;
 		}
@@ -258,11 +395,16 @@ namespace bs
 	/**
 	 * Events allows you to register method callbacks that get notified when the event is triggered.
 	 *
+	 * Callbacks are stored in delegates which keep small callables inline, and connections are allocated from a pool
+	 * shared by all events, so connecting and triggering normally doesn't allocate any memory.
+	 *
+	 * @tparam	ThreadSafe	If true the event can be connected to, disconnected from and triggered from multiple
+	 *						threads. If false no locking is performed, and the event must only be used from a single
+	 *						thread.
+	 *
 	 * @note	Callback method return value is ignored.
 	 */
-	// Note: I could create a policy template argument that allows creation of 
-	// lockable and non-lockable events in the case mutex is causing too much overhead.
-	template <class RetType, class... Args>
+	template <bool ThreadSafe, class RetType, class... Args>
 	class TEvent
 	{
 		struct ConnectionData : BaseConnectionData
@@ -275,12 +417,15 @@ namespace bs
 				BaseConnectionData::deactivate();
 			}
 
-			std::function<RetType(Args...)> func;
+			Delegate<RetType(Args...)> func;
 		};
 
+		static_assert(sizeof(ConnectionData) <= EVENT_CONNECTION_SIZE &&
+			alignof(ConnectionData) <= EVENT_CONNECTION_ALIGNMENT, "Event connection doesn't fit the pooled memory.");
+
 	public:
 		TEvent()
-			:mInternalData(bs_shared_ptr_new<EventInternalData>())
+			:mInternalData(bs_shared_ptr_new<EventInternalData>(ThreadSafe))
 		{ }
 
 		~TEvent()
@@ -288,43 +433,21 @@ namespace bs
 			clear();
 		}
 
-		/** Register a new callback that will get notified once the event is triggered. */
-		HEvent connect(std::function<RetType(Args...)> func)
+		/** 
+		 * Register a new callback that will get notified once the event is triggered. Accepts any callable object
+		 * matching the event signature (function pointers, lambdas, std::function or Delegate).
+		 */
+		template <class F>
+		HEvent connect(F&& func)
 		{
-			RecursiveLock lock(mInternalData->mMutex);
+			ConnectionData* connData = new (EventConnectionAlloc::alloc()) ConnectionData();
+			connData->func = Delegate<RetType(Args...)>(std::forward<F>(func));
 
-			ConnectionData* connData = nullptr;
-			if (mInternalData->mFreeConnections != nullptr)
-			{
-				connData = static_cast<ConnectionData*>(mInternalData->mFreeConnections);
-				mInternalData->mFreeConnections = connData->next;
+			EventInternalData::ScopedLock lock(*mInternalData);
 
-				new (connData)ConnectionData();
-				if (connData->next != nullptr)
-					connData->next->prev = nullptr;
-
-				connData->isActive = true;
-			}
-
-			if (connData == nullptr)
-				connData = bs_new<ConnectionData>();
-
-			// If currently iterating over the connection list, delay modifying it until done
-			if(mInternalData->mIsCurrentlyTriggering)
-			{
-				connData->prev = mInternalData->mNewConnections;
-
-				if (mInternalData->mNewConnections != nullptr)
-					mInternalData->mNewConnections->next = connData;
-
-				mInternalData->mNewConnections = connData;
-			}
-			else
-			{
-				mInternalData->connect(connData);
-			}
-
-			connData->func = func;
+			// Connections added while triggering are appended after the last connection the trigger will notify, so
+			// they will only be notified by the next trigger
+			mInternalData->connect(connData);
 
 			return HEvent(mInternalData, connData);
 		}
@@ -336,43 +459,29 @@ namespace bs
 			// deletes the event itself.
 			SPtr<EventInternalData> internalData = mInternalData;
 
-			RecursiveLock lock(internalData->mMutex);
-			internalData->mIsCurrentlyTriggering = true;
+			EventInternalData::ScopedLock lock(*internalData);
+			internalData->mTriggerDepth++;
 
-			ConnectionData* conn = static_cast<ConnectionData*>(internalData->mConnections);
+			// Connections are never released while triggering, so the list can be walked without any special handling
+			// for callbacks that disconnect themselves or other connections
+			BaseConnectionData* last = internalData->mLastConnection;
+			BaseConnectionData* conn = internalData->mConnections;
 			while (conn != nullptr)
 			{
-				// Save next here in case the callback itself disconnects this connection
-				ConnectionData* next = static_cast<ConnectionData*>(conn->next);
-				
-				if (conn->func != nullptr)
-					conn->func(std::forward<Args>(args)...);
-
-				conn = next;
-			}
-
-			internalData->mIsCurrentlyTriggering = false;
+				if (conn->isActive)
+					static_cast<ConnectionData*>(conn)->func(args...);
 
-			// If any new connections were added during the above calls, add them to the connection list
-			if(internalData->mNewConnections != nullptr)
-			{
-				BaseConnectionData* lastNewConnection = internalData->mNewConnections;
-				while (lastNewConnection != nullptr)
-					lastNewConnection = lastNewConnection->next;
+				if (conn == last)
+					break;
 
-				BaseConnectionData* currentConnection = lastNewConnection;
-				while(currentConnection != nullptr)
-				{
-					BaseConnectionData* prevConnection = currentConnection->prev;
-					currentConnection->next = nullptr;
-					currentConnection->prev = nullptr;
+				conn = conn->next;
+			}
 
-					mInternalData->connect(currentConnection);
-					currentConnection = prevConnection;
-				}
+			internalData->mTriggerDepth--;
 
-				internalData->mNewConnections = nullptr;
-			}
+			// Release any connections that were disconnected during the above calls
+			if (internalData->mTriggerDepth == 0 && internalData->mHasPendingFrees)
+				internalData->freePending();
 		}
 
 		/** Clear all callbacks from the event. */
@@ -388,9 +497,9 @@ namespace bs
 		 */
 		bool empty() const
 		{
-			RecursiveLock lock(mInternalData->mMutex);
+			EventInternalData::ScopedLock lock(*mInternalData);
 
-			return mInternalData->mConnections == nullptr;
+			return !mInternalData->hasActiveConnections();
 		}
 
 	private:
@@ -410,12 +519,12 @@ namespace bs
 	/************************************************************************/
 	
 	/** @copydoc TEvent */
-	template <typename Signature>
+	template <typename Signature, bool ThreadSafe = true>
 	class Event;
 
 	/** @copydoc TEvent */
-	template <class RetType, class... Args>
-	class Event<RetType(Args...) > : public TEvent <RetType, Args...>
+	template <class RetType, class... Args, bool ThreadSafe>
+	class Event<RetType(Args...), ThreadSafe> : public TEvent <ThreadSafe, RetType, Args...>
 	{ };
 
 	/** @} */
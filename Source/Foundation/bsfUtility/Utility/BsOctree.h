@@ -608,7 +608,7 @@ namespace bs
 				bs_frame_mark();
 				{
 					FrameStack<Node*> todo;
-					todo.push(node);
+					todo.push(nodeToCollapse);
 
 					while(!todo.empty())
 					{
@@ -623,7 +623,7 @@ namespace bs
 
 								ElementIterator elemIter(childNode);
 								while(elemIter.moveNext())
-									pushElement(node, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
+									pushElement(nodeToCollapse, elemIter.getCurrentElem(), elemIter.getCurrentBounds());
 
 								todo.push(childNode);
 							}
@@ -632,17 +632,17 @@ namespace bs
 				}
 				bs_frame_clear();
 				
-				node->mIsLeaf = true;
+				nodeToCollapse->mIsLeaf = true;
 
 				// Recursively delete all child nodes
 				for (UINT32 i = 0; i < 8; i++)
 				{
-					if(node->mChildren[i])
+					if(nodeToCollapse->mChildren[i])
 					{
-						destroyNode(node->mChildren[i]);
+						destroyNode(nodeToCollapse->mChildren[i]);
 
-						mNodeAlloc.destruct(node->mChildren[i]);
-						node->mChildren[i] = nullptr;
+						mNodeAlloc.destruct(nodeToCollapse->mChildren[i]);
+						nodeToCollapse->mChildren[i] = nullptr;
 					}
 				}
 			}
@@ -758,7 +758,7 @@ namespace bs
 
 			ElementGroup* elemGroup;
 			ElementBoundGroup* boundGroup;
-			elementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
+			UINT32 groupElementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
 
 			ElementGroup* lastElemGroup;
 			ElementBoundGroup* lastBoundGroup;
@@ -766,10 +766,10 @@ namespace bs
 
 			if(elements.count > 1)
 			{
-				std::swap(elemGroup->v[elementIdx], lastElemGroup->v[lastElementIdx]);
-				std::swap(boundGroup->v[elementIdx], lastBoundGroup->v[lastElementIdx]);
+				std::swap(elemGroup->v[groupElementIdx], lastElemGroup->v[lastElementIdx]);
+				std::swap(boundGroup->v[groupElementIdx], lastBoundGroup->v[lastElementIdx]);
 
-				Options::setElementId(elemGroup->v[elementIdx], OctreeElementId(node, elementIdx), mContext);
+				Options::setElementId(elemGroup->v[groupElementIdx], OctreeElementId(node, elementIdx), mContext);
 			}
 
 			if(lastElementIdx == 0) // Last element in that group, remove it completely
@@ -0,0 +1,107 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * Sorts 32-bit integer keys and their associated values using a least-significant-digit radix sort. Runs in linear
+	 * time and is significantly faster than comparison based sorts for large number of elements, at the cost of requiring
+	 * scratch memory equal to the size of the input.
+	 */
+	class RadixSort
+	{
+		static constexpr UINT32 BITS_PER_PASS = 8;
+		static constexpr UINT32 NUM_BUCKETS = 1 << BITS_PER_PASS;
+		static constexpr UINT32 NUM_PASSES = 32 / BITS_PER_PASS;
+	public:
+		/**
+		 * Converts a floating point value into an integer key. Sorting the keys as unsigned integers yields the same order
+		 * as sorting the original floating point values, including negative values.
+		 */
+		static UINT32 floatToKey(float value)
+		{
+			UINT32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+
+			// Flip all bits of negative values so they sort in reverse, and only the sign bit of positive values so they
+			// sort after the negative ones
+			const UINT32 mask = (UINT32)(-(INT32)(bits >> 31)) | 0x80000000;
+			return bits ^ mask;
+		}
+
+		/**
+		 * Sorts the provided keys in ascending order, reordering the values along with them. The sort is stable.
+		 *
+		 * @param[in,out]	keys			Keys to sort. Receives the sorted keys.
+		 * @param[in,out]	values			Values associated with each key. Receives the values in sorted key order.
+		 * @param[in]		count			Number of entries in the @p keys and @p values arrays.
+		 * @param[in]		scratchKeys		Temporary buffer able to hold @p count keys.
+		 * @param[in]		scratchValues	Temporary buffer able to hold @p count values.
+		 */
+		template<class V>
+		static void sort(UINT32* keys, V* values, UINT32 count, UINT32* scratchKeys, V* scratchValues)
+		{
+			if(count <= 1)
+				return;
+
+			// Build histograms for all passes at once
+			UINT32 histograms[NUM_PASSES][NUM_BUCKETS] = {};
+			for(UINT32 i = 0; i < count; i++)
+			{
+				const UINT32 key = keys[i];
+				for(UINT32 pass = 0; pass < NUM_PASSES; pass++)
+					histograms[pass][(key >> (pass * BITS_PER_PASS)) & (NUM_BUCKETS - 1)]++;
+			}
+
+			UINT32* srcKeys = keys;
+			V* srcValues = values;
+			UINT32* dstKeys = scratchKeys;
+			V* dstValues = scratchValues;
+
+			for(UINT32 pass = 0; pass < NUM_PASSES; pass++)
+			{
+				const UINT32 shift = pass * BITS_PER_PASS;
+				UINT32* histogram = histograms[pass];
+
+				// All keys have the same digit, nothing to reorder
+				if(histogram[(srcKeys[0] >> shift) & (NUM_BUCKETS - 1)] == count)
+					continue;
+
+				// Convert counts to output offsets
+				UINT32 offset = 0;
+				for(UINT32 i = 0; i < NUM_BUCKETS; i++)
+				{
+					const UINT32 bucketCount = histogram[i];
+					histogram[i] = offset;
+					offset += bucketCount;
+				}
+
+				for(UINT32 i = 0; i < count; i++)
+				{
+					const UINT32 dstIdx = histogram[(srcKeys[i] >> shift) & (NUM_BUCKETS - 1)]++;
+					dstKeys[dstIdx] = srcKeys[i];
+					dstValues[dstIdx] = srcValues[i];
+				}
+
+				std::swap(srcKeys, dstKeys);
+				std::swap(srcValues, dstValues);
+			}
+
+			// Results ended up in the scratch buffers
+			if(srcKeys != keys)
+			{
+				std::copy(srcKeys, srcKeys + count, keys);
+				std::copy(srcValues, srcValues + count, values);
+			}
+		}
+	};
+
+	/** @} */
+}
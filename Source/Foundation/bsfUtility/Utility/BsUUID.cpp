@@ -3,169 +3,146 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsUUID.h"
 #include "Utility/BsPlatformUtility.h"
-
-namespace
-{
-	constexpr const char HEX_TO_LITERAL[16] = 
-		{ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
-
-	constexpr const bs::UINT8 LITERAL_TO_HEX[256] = 
-		{	0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			// 0 through 9 translate to 0  though 9
-			0x00,  0x01,  0x02,  0x03,  0x04,  0x05,  0x06,  0x07,  0x08,  0x09,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			// A through F translate to 10 though 15
-			0xFF,  0x0A,  0x0B,  0x0C,  0x0D,  0x0E,  0x0F,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			// a through f translate to 10 though 15
-			0xFF,  0x0A,  0x0B,  0x0C,  0x0D,  0x0E,  0x0F,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,
-			0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF,  0xFF 
-		};
-}
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
 	UUID UUID::EMPTY;
 
+	/** Position of the dash that precedes each of the groups in the UUID string, and of the end of the string. */
+	static constexpr UINT32 GROUP_OFFSETS[] = { 0, 8, 13, 18, 23, 36 };
+
 	UUID::UUID(const String& uuid)
 	{
+		using namespace simd;
+
 		memset(mData, 0, sizeof(mData));
 
 		if (uuid.size() < 36)
 			return;
 
-		UINT32 idx = 0;
-
-		// First group: 8 digits
-		for(INT32 i = 7; i >= 0; --i)
+		// Skip the dashes, so all 32 digits can be converted at once
+		char digits[32];
+		for(UINT32 i = 0; i < 5; i++)
 		{
-			char charVal = uuid[idx++];
-			UINT8 hexVal = LITERAL_TO_HEX[(int)charVal];
-
-			mData[0] |= hexVal << (i * 4);
+			const UINT32 start = i == 0 ? 0 : GROUP_OFFSETS[i] + 1;
+			const UINT32 end = GROUP_OFFSETS[i + 1];
+			memcpy(digits + start - i, uuid.data() + start, end - start);
 		}
 
-		idx++;
-		
-		// Second group: 4 digits
-		for(INT32 i = 7; i >= 4; --i)
-		{
-			char charVal = uuid[idx++];
-			UINT8 hexVal = LITERAL_TO_HEX[(int)charVal];
+		// Digits map to their low four bits, and both upper and lower case letters to their low four bits plus nine
+		const uint8<16> nine = splat(9);
+		const uint8<16> lowMask = splat(0x0F);
+		const uint8<16> lastDigit = splat('9');
 
-			mData[1] |= hexVal << (i * 4);
-		}
+		uint8<16> first = load_u(digits);
+		uint8<16> second = load_u(digits + 16);
+		first = add(bit_and(first, lowMask), bit_and(cmp_gt(first, lastDigit), nine));
+		second = add(bit_and(second, lowMask), bit_and(cmp_gt(second, lastDigit), nine));
 
-		idx++;
+		// Combine pairs of digits into bytes, the first digit being the more significant one
+		const uint8<16> high = unzip16_lo(first, second);
+		const uint8<16> low = unzip16_hi(first, second);
+		const uint8<16> bytes = bit_or(shift_l<4>(high), low);
 
-		// Third group: 4 digits
-		for(INT32 i = 3; i >= 0; --i)
-		{
-			char charVal = uuid[idx++];
-			UINT8 hexVal = LITERAL_TO_HEX[(int)charVal];
+		UINT8 output[16];
+		store_u(output, bytes);
 
-			mData[1] |= hexVal << (i * 4);
-		}
-
-		idx++;
-
-		// Fourth group: 4 digits
-		for(INT32 i = 7; i >= 4; --i)
-		{
-			char charVal = uuid[idx++];
-			UINT8 hexVal = LITERAL_TO_HEX[(int)charVal];
-
-			mData[2] |= hexVal << (i * 4);
-		}
-
-		idx++;
-
-		// Fifth group: 12 digits
-		for(INT32 i = 3; i >= 0; --i)
+		for(UINT32 i = 0; i < 4; i++)
 		{
-			char charVal = uuid[idx++];
-			UINT8 hexVal = LITERAL_TO_HEX[(int)charVal];
-
-			mData[2] |= hexVal << (i * 4);
-		}
-
-		for(INT32 i = 7; i >= 0; --i)
-		{
-			char charVal = uuid[idx++];
-			UINT8 hexVal = LITERAL_TO_HEX[(int)charVal];
-
-			mData[3] |= hexVal << (i * 4);
+			const UINT8* word = output + i * 4;
+			mData[i] = ((UINT32)word[0] << 24) | ((UINT32)word[1] << 16) | ((UINT32)word[2] << 8) | (UINT32)word[3];
 		}
 	}
 
 	String UUID::toString() const
 	{
-		UINT8 output[36];
-		UINT32 idx = 0;
+		using namespace simd;
 
-		// First group: 8 digits
-		for(INT32 i = 7; i >= 0; --i)
+		UINT8 input[16];
+		for(UINT32 i = 0; i < 4; i++)
 		{
-			UINT32 hexVal = (mData[0] >> (i * 4)) & 0xF;
-			output[idx++] = HEX_TO_LITERAL[hexVal];
+			UINT8* word = input + i * 4;
+			word[0] = (UINT8)(mData[i] >> 24);
+			word[1] = (UINT8)(mData[i] >> 16);
+			word[2] = (UINT8)(mData[i] >> 8);
+			word[3] = (UINT8)mData[i];
 		}
 
-		output[idx++] = '-';
+		// Split the bytes into digits, the more significant one first
+		const uint8<16> lowMask = splat(0x0F);
+		const uint8<16> bytes = load_u(input);
+		const uint8<16> high = bit_and(shift_r<4>(bytes), lowMask);
+		const uint8<16> low = bit_and(bytes, lowMask);
 
-		// Second group: 4 digits
-		for(INT32 i = 7; i >= 4; --i)
-		{
-			UINT32 hexVal = (mData[1] >> (i * 4)) & 0xF;
-			output[idx++] = HEX_TO_LITERAL[hexVal];
-		}
+		uint8<16> first = zip16_lo(high, low);
+		uint8<16> second = zip16_hi(high, low);
 
-		output[idx++] = '-';
+		// Values 0-9 map to digits, and 10-15 to lowercase letters
+		const uint8<16> lastDigit = splat(9);
+		const uint8<16> digitOffset = splat('0');
+		const uint8<16> letterOffset = splat('a' - '0' - 10);
 
-		// Third group: 4 digits
-		for(INT32 i = 3; i >= 0; --i)
-		{
-			UINT32 hexVal = (mData[1] >> (i * 4)) & 0xF;
-			output[idx++] = HEX_TO_LITERAL[hexVal];
-		}
+		first = add(add(first, digitOffset), bit_and(cmp_gt(first, lastDigit), letterOffset));
+		second = add(add(second, digitOffset), bit_and(cmp_gt(second, lastDigit), letterOffset));
 
-		output[idx++] = '-';
+		char digits[32];
+		store_u(digits, first);
+		store_u(digits + 16, second);
 
-		// Fourth group: 4 digits
-		for(INT32 i = 7; i >= 4; --i)
+		char output[36];
+		for(UINT32 i = 0; i < 5; i++)
 		{
-			UINT32 hexVal = (mData[2] >> (i * 4)) & 0xF;
-			output[idx++] = HEX_TO_LITERAL[hexVal];
+			const UINT32 start = i == 0 ? 0 : GROUP_OFFSETS[i] + 1;
+			const UINT32 end = GROUP_OFFSETS[i + 1];
+			memcpy(output + start, digits + start - i, end - start);
+
+			if(i > 0)
+				output[GROUP_OFFSETS[i]] = '-';
 		}
 
-		output[idx++] = '-';
+		return String(output, 36);
+	}
+
+	UUID UUIDGenerator::generateRandom()
+	{
+		// State of a xoroshiro128+ generator per thread, seeded from the platform generator on first use. Platform
+		// generators are usually backed by the operating system's entropy source, which is too slow to use for every
+		// identifier when creating many objects or resources at once.
+		static BS_THREADLOCAL UINT64 sState[2] = { 0, 0 };
 
-		// Fifth group: 12 digits
-		for(INT32 i = 3; i >= 0; --i)
+		if(sState[0] == 0 && sState[1] == 0)
 		{
-			UINT32 hexVal = (mData[2] >> (i * 4)) & 0xF;
-			output[idx++] = HEX_TO_LITERAL[hexVal];
+			const UUID seed = PlatformUtility::generateUUID();
+			sState[0] = ((UINT64)seed.mData[0] << 32) | seed.mData[1];
+			sState[1] = ((UINT64)seed.mData[2] << 32) | seed.mData[3];
+
+			// Generator never leaves the all-zero state
+			if(sState[0] == 0 && sState[1] == 0)
+				sState[0] = 0x9E3779B97F4A7C15ULL;
 		}
 
-		for(INT32 i = 7; i >= 0; --i)
+		const auto next = []()
 		{
-			UINT32 hexVal = (mData[3] >> (i * 4)) & 0xF;
-			output[idx++] = HEX_TO_LITERAL[hexVal];
-		}
+			const UINT64 s0 = sState[0];
+			UINT64 s1 = sState[1];
+			const UINT64 result = s0 + s1;
 
-		return String((const char*)output, 36);
-	}
+			s1 ^= s0;
+			sState[0] = ((s0 << 24) | (s0 >> 40)) ^ s1 ^ (s1 << 16);
+			sState[1] = (s1 << 37) | (s1 >> 27);
 
-	UUID UUIDGenerator::generateRandom()
-	{
-		return PlatformUtility::generateUUID();
+			return result;
+		};
+
+		const UINT64 first = next();
+		const UINT64 second = next();
+
+		// Mark the identifier as a random (version 4, variant 1) UUID
+		return UUID(
+			(UINT32)(first >> 32),
+			((UINT32)first & 0xFFFF0FFF) | 0x00004000,
+			((UINT32)(second >> 32) & 0x3FFFFFFF) | 0x80000000,
+			(UINT32)second);
 	}
 }
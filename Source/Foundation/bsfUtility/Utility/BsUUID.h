@@ -66,6 +66,7 @@ namespace bs
 		static UUID EMPTY;
 	private:
 		friend struct std::hash<UUID>;
+		friend class UUIDGenerator;
 
 		UINT32 mData[4] = {0, 0, 0, 0};
 	};
@@ -80,7 +81,10 @@ namespace bs
 	class BS_UTILITY_EXPORT UUIDGenerator
 	{
 	public:
-		/**	Generate a new random universally unique identifier. */
+		/**
+		 * Generate a new random universally unique identifier. Uses a per-thread pseudo random generator seeded from
+		 * the platform's generator, so it's cheap enough to call for every new object.
+		 */
 		static UUID generateRandom();
 	};
 
@@ -94,19 +98,27 @@ namespace bs
 
 namespace std
 {
-/**	Hash value generator for UUID. */
+/**
+ * Hash value generator for UUID. Mixes all 128 bits into the result, so it's well distributed even for identifiers that
+ * only differ in a few bits.
+ */
 template<>
 struct hash<bs::UUID>
 {
 	size_t operator()(const bs::UUID& value) const
 	{
-		size_t hash = 0;
-		bs::hash_combine(hash, value.mData[0]);
-		bs::hash_combine(hash, value.mData[1]);
-		bs::hash_combine(hash, value.mData[2]);
-		bs::hash_combine(hash, value.mData[3]);
-
-		return hash;
+		const bs::UINT64 low = ((bs::UINT64)value.mData[0] << 32) | value.mData[1];
+		const bs::UINT64 high = ((bs::UINT64)value.mData[2] << 32) | value.mData[3];
+
+		// Finalizer from MurmurHash3
+		bs::UINT64 hash = low ^ (high * 0x9E3779B97F4A7C15ULL);
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ULL;
+		hash ^= hash >> 33;
+
+		return (size_t)hash;
 	}
 };
 }
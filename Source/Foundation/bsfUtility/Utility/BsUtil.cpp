@@ -1,16 +1,14 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Prerequisites/BsPrerequisitesUtil.h"
+#include "FileSystem/BsDataStream.h"
 #include "ThirdParty/md5.h"
 
 namespace bs
 {
-	String md5(const WString& source)
+	/** Converts a finalized MD5 digest into a hex string. */
+	static String md5ToString(MD5& md5)
 	{
-		MD5 md5;
-		md5.update((UINT8*)source.data(), (UINT32)source.length() * sizeof(WString::value_type));
-		md5.finalize();
-
 		UINT8 digest[16];
 		md5.decdigest(digest, sizeof(digest));
 
@@ -22,20 +20,42 @@ namespace bs
 		return buf;
 	}
 
+	String md5(const WString& source)
+	{
+		MD5 md5;
+		md5.update((UINT8*)source.data(), (UINT32)source.length() * sizeof(WString::value_type));
+		md5.finalize();
+
+		return md5ToString(md5);
+	}
+
 	String md5(const String& source)
 	{
 		MD5 md5;
 		md5.update((UINT8*)source.data(), (UINT32)source.length() * sizeof(String::value_type));
 		md5.finalize();
 
-		UINT8 digest[16];
-		md5.decdigest(digest, sizeof(digest));
+		return md5ToString(md5);
+	}
 
-		String buf;
-		buf.resize(32);
-		for (int i = 0; i < 16; i++)
-			snprintf(&(buf[0]) + i * 2, 3, "%02x", digest[i]);
+	String md5(DataStream& source)
+	{
+		static constexpr UINT32 CHUNK_SIZE = 64 * 1024;
 
-		return buf;
+		MD5 md5;
+		UINT8* buffer = (UINT8*)bs_stack_alloc(CHUNK_SIZE);
+		while (!source.eof())
+		{
+			const size_t numRead = source.read(buffer, CHUNK_SIZE);
+			if (numRead == 0)
+				break;
+
+			md5.update(buffer, (UINT32)numRead);
+		}
+
+		bs_stack_free(buffer);
+		md5.finalize();
+
+		return md5ToString(md5);
 	}
 }
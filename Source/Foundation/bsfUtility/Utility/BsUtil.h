@@ -24,6 +24,9 @@ namespace bs
 	/**	Generates an MD5 hash string for the provided source string. */
 	String BS_UTILITY_EXPORT md5(const String& source);
 
+	/** Generates an MD5 hash string for the data from the current position in the stream, until its end. */
+	String BS_UTILITY_EXPORT md5(DataStream& source);
+
 	/** Sets contents of a struct to zero. */
 	template<class T>
 	void bs_zero_out(T& s)
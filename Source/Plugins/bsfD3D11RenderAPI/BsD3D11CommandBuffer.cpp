@@ -1,6 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsD3D11CommandBuffer.h"
+#include "BsD3D11Device.h"
 
 namespace bs { namespace ct
 {
@@ -9,10 +10,38 @@ namespace bs { namespace ct
 	{
 		if (deviceIdx != 0)
 			BS_EXCEPT(InvalidParametersException, "Only a single device supported on DX11.");
+
+		mState.reset();
+
+		// Without driver support the runtime emulates command lists, in which case there is no benefit over queueing
+		// the commands ourselves
+		D3D11RenderAPI* rapi = static_cast<D3D11RenderAPI*>(RenderAPI::instancePtr());
+		D3D11Device& device = rapi->getPrimaryDevice();
+		if (device.supportsCommandLists())
+		{
+			HRESULT hr = device.getD3D11Device()->CreateDeferredContext(0, &mState.context);
+			if (FAILED(hr))
+			{
+				LOGWRN("Failed to create a deferred context. Command buffer commands will be executed on submit.");
+				mState.context = nullptr;
+			}
+		}
+	}
+
+	D3D11CommandBuffer::~D3D11CommandBuffer()
+	{
+		if (mState.context != nullptr)
+		{
+			ID3D11CommandList* commandList = finishCommandList();
+			SAFE_RELEASE(commandList);
+			SAFE_RELEASE(mState.context);
+		}
 	}
 
 	void D3D11CommandBuffer::queueCommand(const std::function<void()> command)
 	{
+		assert(!isDeferred() && "Commands on a deferred command buffer must be executed as they are recorded.");
+
 		mCommands.push_back(command);
 	}
 
@@ -32,6 +61,21 @@ namespace bs { namespace ct
 		}
 #endif
 
+		if (isDeferred())
+		{
+			ID3D11CommandList* commandList = secondaryBuffer->finishCommandList();
+			if (commandList != nullptr)
+			{
+				// State isn't restored after the list executes, the context is left in its default state instead
+				mState.context->ExecuteCommandList(commandList, FALSE);
+				mState.reset();
+
+				SAFE_RELEASE(commandList);
+			}
+
+			return;
+		}
+
 		for (auto& entry : secondaryBuffer->mCommands)
 			mCommands.push_back(entry);
 	}
@@ -46,6 +90,20 @@ namespace bs { namespace ct
 		}
 #endif
 
+		if (isDeferred())
+		{
+			ID3D11CommandList* commandList = finishCommandList();
+			if (commandList != nullptr)
+			{
+				D3D11RenderAPI* rapi = static_cast<D3D11RenderAPI*>(RenderAPI::instancePtr());
+				rapi->getPrimaryDevice().getImmediateContext()->ExecuteCommandList(commandList, FALSE);
+
+				SAFE_RELEASE(commandList);
+			}
+
+			return;
+		}
+
 		for (auto& entry : mCommands)
 			entry();
 	}
@@ -53,5 +111,27 @@ namespace bs { namespace ct
 	void D3D11CommandBuffer::clear()
 	{
 		mCommands.clear();
+
+		if (isDeferred())
+		{
+			// Discard anything recorded since the last execution
+			ID3D11CommandList* commandList = finishCommandList();
+			SAFE_RELEASE(commandList);
+		}
+	}
+
+	ID3D11CommandList* D3D11CommandBuffer::finishCommandList()
+	{
+		ID3D11CommandList* commandList = nullptr;
+		HRESULT hr = mState.context->FinishCommandList(FALSE, &commandList);
+		if (FAILED(hr))
+		{
+			LOGERR("Failed to finish recording a D3D11 command list.");
+			commandList = nullptr;
+		}
+
+		// Deferred context is returned to its default state once the list is finished
+		mState.reset();
+		return commandList;
 	}
 }}
\ No newline at end of file
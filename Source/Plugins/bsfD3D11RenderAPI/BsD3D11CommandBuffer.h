@@ -13,13 +13,17 @@ namespace bs { namespace ct
 	 */
 
 	/**
-	 * Command buffer implementation for DirectX 11, which doesn't support multi-threaded command generation. Instead all
-	 * commands are stored in an internal buffer, and then sent to the actual render API when the buffer is executed.
+	 * Command buffer implementation for DirectX 11. If the driver supports command lists, commands are recorded
+	 * directly into a deferred context, allowing command buffers to be recorded on multiple threads at once, and are
+	 * later executed as a command list on the immediate context. Otherwise all commands are stored in an internal
+	 * buffer, and then sent to the actual render API when the buffer is executed.
 	 */
 	class D3D11CommandBuffer : public CommandBuffer
 	{
 	public:
-		/** Registers a new command in the command buffer. */
+		~D3D11CommandBuffer();
+
+		/** Registers a new command in the command buffer. Only valid if the buffer doesn't use a deferred context. */
 		void queueCommand(const std::function<void()> command);
 
 		/** Appends all commands from the secondary buffer into this command buffer. */
@@ -31,13 +35,26 @@ namespace bs { namespace ct
 		/** Removes all commands from the command buffer. */
 		void clear();
 
+		/**
+		 * Checks does the command buffer record commands directly into a deferred context. If true commands should be
+		 * executed on the context from getState() as they are recorded, instead of being queued.
+		 */
+		bool isDeferred() const { return mState.context != nullptr; }
+
+		/** Returns the deferred context the commands are recorded into, and the state currently bound to it. */
+		D3D11ContextState& getState() { return mState; }
+
 	private:
 		friend class D3D11CommandBufferManager;
 		friend class D3D11RenderAPI;
 
 		D3D11CommandBuffer(GpuQueueType type, UINT32 deviceIdx, UINT32 queueIdx, bool secondary);
 
+		/** Ends recording into the deferred context and returns the recorded commands. Caller must release the list. */
+		ID3D11CommandList* finishCommandList();
+
 		Vector<std::function<void()>> mCommands;
+		D3D11ContextState mState;
 
 		DrawOperationType mActiveDrawOp;
 	};
@@ -36,6 +36,8 @@ namespace bs { namespace ct
 
 			// Get feature options
 			mD3D11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &mD3D11FeatureOptions, sizeof(mD3D11FeatureOptions));
+			mD3D11Device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &mD3D11ThreadingSupport,
+				sizeof(mD3D11ThreadingSupport));
 		}	
 	}
 
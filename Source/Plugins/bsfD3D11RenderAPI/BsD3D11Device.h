@@ -43,6 +43,13 @@ namespace bs { namespace ct
 		/** Returns information about optional features supported by the device. */
 		const D3D11_FEATURE_DATA_D3D11_OPTIONS& getFeatureOptions() const { return mD3D11FeatureOptions; }
 
+		/**
+		 * Checks does the driver natively support command lists. If it does, commands can be recorded into deferred
+		 * contexts on multiple threads without the runtime emulating the command lists (and serializing their
+		 * execution).
+		 */
+		bool supportsCommandLists() const { return mD3D11ThreadingSupport.DriverCommandLists == TRUE; }
+
 		/**	Resets error state & error messages. */
 		void clearErrors();
 
@@ -69,6 +76,7 @@ namespace bs { namespace ct
 		ID3D11InfoQueue* mInfoQueue = nullptr; 
 		ID3D11ClassLinkage* mClassLinkage = nullptr;
 		D3D11_FEATURE_DATA_D3D11_OPTIONS mD3D11FeatureOptions;
+		D3D11_FEATURE_DATA_THREADING mD3D11ThreadingSupport;
 	};
 
 	/** @} */
@@ -44,18 +44,24 @@ namespace bs { namespace ct
 
 	void D3D11EventQuery::begin(const SPtr<CommandBuffer>& cb)
 	{
-		auto execute = [&]()
+		auto executeRef = [&](ID3D11DeviceContext* context)
 		{
-			mContext->End(mQuery);
+			context->End(mQuery);
 			setActive(true);
 		};
 
 		if (cb == nullptr)
-			execute();
+			executeRef(mContext);
 		else
 		{
 			SPtr<D3D11CommandBuffer> d3d11cb = std::static_pointer_cast<D3D11CommandBuffer>(cb);
-			d3d11cb->queueCommand(execute);
+			if (d3d11cb->isDeferred())
+				executeRef(d3d11cb->getState().context);
+			else
+			{
+				auto execute = [=]() { executeRef(mContext); };
+				d3d11cb->queueCommand(execute);
+			}
 		}
 	}
 
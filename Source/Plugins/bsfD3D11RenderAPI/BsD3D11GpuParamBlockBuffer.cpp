@@ -29,6 +29,17 @@ namespace bs { namespace ct
 		GpuParamBlockBuffer::initialize();
 	}
 
+	void D3D11GpuParamBlockBuffer::flushToGPU(ID3D11DeviceContext* context)
+	{
+		if (!mGPUBufferDirty)
+			return;
+
+		static_cast<D3D11HardwareBuffer*>(mBuffer)->writeData(context, 0, mSize, mCachedData);
+		mGPUBufferDirty = false;
+
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_GpuParamBuffer, mSize);
+	}
+
 	ID3D11Buffer* D3D11GpuParamBlockBuffer::getD3D11Buffer() const
 	{
 		return static_cast<D3D11HardwareBuffer*>(mBuffer)->getD3DBuffer();
@@ -18,6 +18,14 @@ namespace bs { namespace ct
 		D3D11GpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
 		~D3D11GpuParamBlockBuffer();
 
+		using GpuParamBlockBuffer::flushToGPU;
+
+		/**
+		 * Flushes any cached data into the actual GPU buffer, through the provided device context. Allows the buffer to
+		 * be updated while recording into a deferred context.
+		 */
+		void flushToGPU(ID3D11DeviceContext* context);
+
 		/**	Returns internal DX11 buffer object. */
 		ID3D11Buffer* getD3D11Buffer() const;
 	protected:
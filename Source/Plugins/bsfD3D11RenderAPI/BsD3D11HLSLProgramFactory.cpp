@@ -113,6 +113,18 @@ namespace bs { namespace ct
 		return 0;
 	}
 
+	String D3D11HLSLProgramFactory::getCompilerSignature() const
+	{
+		// Profiles are always shader model 5.0, and compile flags only depend on the build configuration
+		String signature = String(DIRECTX_COMPILER_ID) + "_" + toString(D3D_COMPILER_VERSION) + "_sm5_0";
+
+#if defined(BS_DEBUG_MODE)
+		signature += "_debug";
+#endif
+
+		return signature;
+	}
+
 	SPtr<GpuProgramBytecode> D3D11HLSLProgramFactory::compileBytecode(const GPU_PROGRAM_DESC& desc)
 	{
 		String hlslProfile;
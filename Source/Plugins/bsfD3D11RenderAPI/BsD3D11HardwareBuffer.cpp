@@ -252,13 +252,14 @@ namespace bs { namespace ct
 	void D3D11HardwareBuffer::copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, 
 		UINT32 dstOffset, UINT32 length, bool discardWholeBuffer, const SPtr<ct::CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [this](HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length)
+		auto executeRef = [this](ID3D11DeviceContext* context, HardwareBuffer& srcBuffer, UINT32 srcOffset,
+			UINT32 dstOffset, UINT32 length)
 		{
 			// If we're copying same-size buffers in their entirety
 			if (srcOffset == 0 && dstOffset == 0 &&
 				length == mSize && mSize == srcBuffer.getSize())
 			{
-				mDevice.getImmediateContext()->CopyResource(mD3DBuffer, 
+				context->CopyResource(mD3DBuffer, 
 					static_cast<D3D11HardwareBuffer&>(srcBuffer).getD3DBuffer());
 				if (mDevice.hasError())
 				{
@@ -277,7 +278,7 @@ namespace bs { namespace ct
 				srcBox.front = 0;
 				srcBox.back = 1;
 
-				mDevice.getImmediateContext()->CopySubresourceRegion(mD3DBuffer, 0, (UINT)dstOffset, 0, 0,
+				context->CopySubresourceRegion(mD3DBuffer, 0, (UINT)dstOffset, 0, 0,
 					static_cast<D3D11HardwareBuffer&>(srcBuffer).getD3DBuffer(), 0, &srcBox);
 				if (mDevice.hasError())
 				{
@@ -289,13 +290,18 @@ namespace bs { namespace ct
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(srcBuffer, srcOffset, dstOffset, length);
+			executeRef(mDevice.getImmediateContext(), srcBuffer, srcOffset, dstOffset, length);
 		else
 		{
-			auto execute = [&]() { executeRef(srcBuffer, srcOffset, dstOffset, length); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState().context, srcBuffer, srcOffset, dstOffset, length);
+			else
+			{
+				HardwareBuffer* src = &srcBuffer;
+				auto execute = [=]() { executeRef(mDevice.getImmediateContext(), *src, srcOffset, dstOffset, length); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
@@ -322,12 +328,36 @@ namespace bs { namespace ct
 			memcpy(pDst, pSource, length);
 			this->unlock();
 		}
+		else if(mDesc.Usage == D3D11_USAGE_DEFAULT)
+			writeData(mDevice.getImmediateContext(), offset, length, pSource);
+		else
+		{
+			LOGERR("Trying to write into a buffer with unsupported usage: " + toString(mDesc.Usage));
+		}
+	}
+
+	void D3D11HardwareBuffer::writeData(ID3D11DeviceContext* context, UINT32 offset, UINT32 length, const void* source)
+	{
+		if(mDesc.Usage == D3D11_USAGE_DYNAMIC)
+		{
+			// Deferred contexts only support discarding maps
+			D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+			HRESULT hr = context->Map(mD3DBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubResource);
+			if (FAILED(hr))
+			{
+				String msg = mDevice.getErrorDescription();
+				BS_EXCEPT(RenderingAPIException, "Error calling Map: " + msg);
+			}
+
+			memcpy(static_cast<UINT8*>(mappedSubResource.pData) + offset, source, length);
+			context->Unmap(mD3DBuffer, 0);
+		}
 		else if(mDesc.Usage == D3D11_USAGE_DEFAULT)
 		{
 			if (mBufferType == BT_CONSTANT)
 			{
 				assert(offset == 0);
-				mDevice.getImmediateContext()->UpdateSubresource(mD3DBuffer, 0, nullptr, pSource, 0, 0);
+				context->UpdateSubresource(mD3DBuffer, 0, nullptr, source, 0, 0);
 			}
 			else
 			{
@@ -339,7 +369,7 @@ namespace bs { namespace ct
 				dstBox.front = 0;
 				dstBox.back = 1;
 
-				mDevice.getImmediateContext()->UpdateSubresource(mD3DBuffer, 0, &dstBox, pSource, 0, 0);
+				context->UpdateSubresource(mD3DBuffer, 0, &dstBox, source, 0, 0);
 			}
 		}
 		else
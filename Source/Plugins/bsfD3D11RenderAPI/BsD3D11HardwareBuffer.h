@@ -46,6 +46,13 @@ namespace bs { namespace ct
 		void writeData(UINT32 offset, UINT32 length, const void* source, 
 			BufferWriteType writeFlags = BWT_NORMAL, UINT32 queueIdx = 0) override;
 
+		/**
+		 * Writes data to the buffer through the provided device context, allowing the write to be recorded into a
+		 * deferred context. Only supported for buffers with default usage, or dynamic buffers in which case the entire
+		 * buffer contents are discarded.
+		 */
+		void writeData(ID3D11DeviceContext* context, UINT32 offset, UINT32 length, const void* source);
+
 		/** @copydoc HardwareBuffer::copyData */
 		void copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, 
 			UINT32 length, bool discardWholeBuffer = false, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
@@ -59,6 +59,7 @@ namespace bs { namespace ct
 		 * @param[in]	vertexProgram		Instance of the vertex program we are creating input layout for.
 		 *
 		 * @note	Error will be thrown if the vertex buffer doesn't provide all the necessary data that the shader expects.
+		 * @note	Thread safe, as command buffers may be recorded from multiple threads.
 		 */
 		ID3D11InputLayout* retrieveInputLayout(const SPtr<VertexDeclaration>& vertexShaderDecl,
 			const SPtr<VertexDeclaration>& vertexBufferDecl, D3D11GpuProgram& vertexProgram);
@@ -76,6 +77,7 @@ namespace bs { namespace ct
 		static const int NUM_ELEMENTS_TO_PRUNE = 64;
 
 		UnorderedMap<VertexDeclarationKey, InputLayoutEntry*, HashFunc, EqualFunc> mInputLayoutMap;
+		Mutex mMutex;
 
 		bool mWarningShown;
 		UINT32 mLastUsedCounter;
@@ -319,6 +319,10 @@ namespace bs { namespace ct
 			return DXGI_FORMAT_R32G32B32A32_SINT;
 		case VET_UBYTE4:
 			return DXGI_FORMAT_R8G8B8A8_UINT;
+		case VET_HALF2:
+			return DXGI_FORMAT_R16G16_FLOAT;
+		case VET_HALF4:
+			return DXGI_FORMAT_R16G16B16A16_FLOAT;
 		}
 
 		// Unsupported type
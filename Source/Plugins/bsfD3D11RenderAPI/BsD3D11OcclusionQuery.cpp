@@ -40,9 +40,9 @@ namespace bs { namespace ct
 
 	void D3D11OcclusionQuery::begin(const SPtr<CommandBuffer>& cb)
 	{
-		auto execute = [&]()
+		auto executeRef = [&](ID3D11DeviceContext* context)
 		{
-			mContext->Begin(mQuery);
+			context->Begin(mQuery);
 
 			mNumSamples = 0;
 			mQueryEndCalled = false;
@@ -51,30 +51,42 @@ namespace bs { namespace ct
 		};
 
 		if (cb == nullptr)
-			execute();
+			executeRef(mContext);
 		else
 		{
 			SPtr<D3D11CommandBuffer> d3d11CB = std::static_pointer_cast<D3D11CommandBuffer>(cb);
-			d3d11CB->queueCommand(execute);
+			if (d3d11CB->isDeferred())
+				executeRef(d3d11CB->getState().context);
+			else
+			{
+				auto execute = [=]() { executeRef(mContext); };
+				d3d11CB->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11OcclusionQuery::end(const SPtr<CommandBuffer>& cb)
 	{
-		auto execute = [&]()
+		auto executeRef = [&](ID3D11DeviceContext* context)
 		{
-			mContext->End(mQuery);
+			context->End(mQuery);
 
 			mQueryEndCalled = true;
 			mFinalized = false;
 		};
 
 		if (cb == nullptr)
-			execute();
+			executeRef(mContext);
 		else
 		{
 			SPtr<D3D11CommandBuffer> d3d11CB = std::static_pointer_cast<D3D11CommandBuffer>(cb);
-			d3d11CB->queueCommand(execute);
+			if (d3d11CB->isDeferred())
+				executeRef(d3d11CB->getState().context);
+			else
+			{
+				auto execute = [=]() { executeRef(mContext); };
+				d3d11CB->queueCommand(execute);
+			}
 		}
 	}
 
@@ -35,11 +35,28 @@
 
 namespace bs { namespace ct
 {
+	void D3D11ContextState::reset()
+	{
+		psUAVsBound = false;
+		csUAVsBound = false;
+		stencilRef = 0;
+		viewportNorm = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+		bs_zero_out(viewport);
+		bs_zero_out(scissorRect);
+
+		activeRenderTarget = nullptr;
+		activeVertexDeclaration = nullptr;
+		activeVertexShader = nullptr;
+		activeDepthStencilState = nullptr;
+	}
+
 	D3D11RenderAPI::D3D11RenderAPI()
 		: mDXGIFactory(nullptr), mDevice(nullptr), mDriverList(nullptr), mActiveD3DDriver(nullptr)
-		, mFeatureLevel(D3D_FEATURE_LEVEL_11_0), mHLSLFactory(nullptr), mIAManager(nullptr), mPSUAVsBound(false)
-		, mCSUAVsBound(false), mStencilRef(0), mActiveDrawOp(DOT_TRIANGLE_LIST), mViewportNorm(0.0f, 0.0f, 1.0f, 1.0f)
-	{ }
+		, mFeatureLevel(D3D_FEATURE_LEVEL_11_0), mHLSLFactory(nullptr), mIAManager(nullptr)
+		, mActiveDrawOp(DOT_TRIANGLE_LIST)
+	{
+		mImmediateState.reset();
+	}
 
 	D3D11RenderAPI::~D3D11RenderAPI()
 	{
@@ -106,6 +123,7 @@ namespace bs { namespace ct
 			BS_EXCEPT(RenderingAPIException, "Failed to create Direct3D11 object. D3D11CreateDeviceN returned this error code: " + toString(hr));
 
 		mDevice = bs_new<D3D11Device>(device);
+		mImmediateState.context = mDevice->getImmediateContext();
 		
 		CommandBufferManager::startUp<D3D11CommandBufferManager>();
 
@@ -135,6 +153,13 @@ namespace bs { namespace ct
 
 		mIAManager = bs_new<D3D11InputLayoutManager>();
 
+		// D3D11 has no pipeline state objects, report the individual state objects in their place
+		RenderStats& renderStats = RenderStats::instance();
+		renderStats.setResourceCategory(RenderStatObject_DepthStencilState, RenderStatResourceCategory::PipelineState);
+		renderStats.setResourceCategory(RenderStatObject_RasterizerState, RenderStatResourceCategory::PipelineState);
+		renderStats.setResourceCategory(RenderStatObject_BlendState, RenderStatResourceCategory::PipelineState);
+		renderStats.setResourceCategory(RenderStatObject_InputLayout, RenderStatResourceCategory::PipelineState);
+
 		RenderAPI::initialize();
 	}
 
@@ -177,10 +202,8 @@ namespace bs { namespace ct
 			mHLSLFactory = nullptr;
 		}
 
-		mActiveVertexDeclaration = nullptr;
-		mActiveVertexShader = nullptr;
+		mImmediateState.reset();
 		mActiveRenderTarget = nullptr;
-		mActiveDepthStencilState = nullptr;
 
 		RenderStateManager::shutDown();
 		RenderWindowManager::shutDown();
@@ -199,6 +222,8 @@ namespace bs { namespace ct
 			mDevice = nullptr;
 		}
 
+		mImmediateState.context = nullptr;
+
 		if(mDriverList != nullptr)
 		{
 			bs_delete(mDriverList);
@@ -213,10 +238,8 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<GraphicsPipelineState>& pipelineState)
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<GraphicsPipelineState>& pipelineState)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
 			D3D11BlendState* d3d11BlendState;
 			D3D11RasterizerState* d3d11RasterizerState;
 
@@ -229,9 +252,9 @@ namespace bs { namespace ct
 			{
 				d3d11BlendState = static_cast<D3D11BlendState*>(pipelineState->getBlendState().get());
 				d3d11RasterizerState = static_cast<D3D11RasterizerState*>(pipelineState->getRasterizerState().get());
-				mActiveDepthStencilState = std::static_pointer_cast<D3D11DepthStencilState>(pipelineState->getDepthStencilState());
+				state.activeDepthStencilState = std::static_pointer_cast<D3D11DepthStencilState>(pipelineState->getDepthStencilState());
 
-				mActiveVertexShader = std::static_pointer_cast<D3D11GpuVertexProgram>(pipelineState->getVertexProgram());
+				state.activeVertexShader = std::static_pointer_cast<D3D11GpuVertexProgram>(pipelineState->getVertexProgram());
 				d3d11FragmentProgram = static_cast<D3D11GpuFragmentProgram*>(pipelineState->getFragmentProgram().get());
 				d3d11GeometryProgram = static_cast<D3D11GpuGeometryProgram*>(pipelineState->getGeometryProgram().get());
 				d3d11DomainProgram = static_cast<D3D11GpuDomainProgram*>(pipelineState->getDomainProgram().get());
@@ -243,30 +266,30 @@ namespace bs { namespace ct
 				if (d3d11RasterizerState == nullptr)
 					d3d11RasterizerState = static_cast<D3D11RasterizerState*>(RasterizerState::getDefault().get());
 
-				if (mActiveDepthStencilState == nullptr)
-					mActiveDepthStencilState = std::static_pointer_cast<D3D11DepthStencilState>(DepthStencilState::getDefault());
+				if (state.activeDepthStencilState == nullptr)
+					state.activeDepthStencilState = std::static_pointer_cast<D3D11DepthStencilState>(DepthStencilState::getDefault());
 			}
 			else
 			{
 				d3d11BlendState = static_cast<D3D11BlendState*>(BlendState::getDefault().get());
 				d3d11RasterizerState = static_cast<D3D11RasterizerState*>(RasterizerState::getDefault().get());
-				mActiveDepthStencilState = std::static_pointer_cast<D3D11DepthStencilState>(DepthStencilState::getDefault());
+				state.activeDepthStencilState = std::static_pointer_cast<D3D11DepthStencilState>(DepthStencilState::getDefault());
 
-				mActiveVertexShader = nullptr;
+				state.activeVertexShader = nullptr;
 				d3d11FragmentProgram = nullptr;
 				d3d11GeometryProgram = nullptr;
 				d3d11DomainProgram = nullptr;
 				d3d11HullProgram = nullptr;
 			}
 
-			ID3D11DeviceContext* d3d11Context = mDevice->getImmediateContext();
+			ID3D11DeviceContext* d3d11Context = state.context;
 			d3d11Context->OMSetBlendState(d3d11BlendState->getInternal(), nullptr, 0xFFFFFFFF);
 			d3d11Context->RSSetState(d3d11RasterizerState->getInternal());
-			d3d11Context->OMSetDepthStencilState(mActiveDepthStencilState->getInternal(), mStencilRef);
+			d3d11Context->OMSetDepthStencilState(state.activeDepthStencilState->getInternal(), state.stencilRef);
 
-			if (mActiveVertexShader != nullptr)
+			if (state.activeVertexShader != nullptr)
 			{
-				D3D11GpuVertexProgram* vertexProgram = static_cast<D3D11GpuVertexProgram*>(mActiveVertexShader.get());
+				D3D11GpuVertexProgram* vertexProgram = static_cast<D3D11GpuVertexProgram*>(state.activeVertexShader.get());
 				d3d11Context->VSSetShader(vertexProgram->getVertexShader(), nullptr, 0);
 			}
 			else
@@ -295,13 +318,17 @@ namespace bs { namespace ct
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(pipelineState);
+			executeRef(mImmediateState, pipelineState);
 		else
 		{
-			auto execute = [=]() { executeRef(pipelineState); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), pipelineState);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, pipelineState); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumPipelineStateChanges);
@@ -310,10 +337,8 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<ComputePipelineState>& pipelineState)
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<ComputePipelineState>& pipelineState)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
 			SPtr<GpuProgram> program;
 			if (pipelineState != nullptr)
 				program = pipelineState->getProgram();
@@ -321,20 +346,24 @@ namespace bs { namespace ct
 			if (program != nullptr && program->getType() == GPT_COMPUTE_PROGRAM)
 			{
 				D3D11GpuComputeProgram *d3d11ComputeProgram = static_cast<D3D11GpuComputeProgram*>(program.get());
-				mDevice->getImmediateContext()->CSSetShader(d3d11ComputeProgram->getComputeShader(), nullptr, 0);
+				state.context->CSSetShader(d3d11ComputeProgram->getComputeShader(), nullptr, 0);
 			}
 			else
-				mDevice->getImmediateContext()->CSSetShader(nullptr, nullptr, 0);
+				state.context->CSSetShader(nullptr, nullptr, 0);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(pipelineState);
+			executeRef(mImmediateState, pipelineState);
 		else
 		{
-			auto execute = [=]() { executeRef(pipelineState); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), pipelineState);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, pipelineState); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumPipelineStateChanges);
@@ -342,33 +371,31 @@ namespace bs { namespace ct
 
 	void D3D11RenderAPI::setGpuParams(const SPtr<GpuParams>& gpuParams, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<GpuParams>& gpuParams)
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<GpuParams>& gpuParams)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			ID3D11DeviceContext* context = mDevice->getImmediateContext();
+			ID3D11DeviceContext* context = state.context;
 
 			// Clear any previously bound UAVs (otherwise shaders attempting to read resources viewed by those views will
 			// be unable to)
-			if (mPSUAVsBound || mCSUAVsBound)
+			if (state.psUAVsBound || state.csUAVsBound)
 			{
 				ID3D11UnorderedAccessView* emptyUAVs[D3D11_PS_CS_UAV_REGISTER_COUNT];
 				bs_zero_out(emptyUAVs);
 
-				if(mPSUAVsBound)
+				if(state.psUAVsBound)
 				{
 					context->OMSetRenderTargetsAndUnorderedAccessViews(
 						D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr, 0, 
 						D3D11_PS_CS_UAV_REGISTER_COUNT, emptyUAVs, nullptr);
 
-					mPSUAVsBound = false;
+					state.psUAVsBound = false;
 				}
 
-				if(mCSUAVsBound)
+				if(state.csUAVsBound)
 				{
 					context->CSSetUnorderedAccessViews(0, D3D11_PS_CS_UAV_REGISTER_COUNT, emptyUAVs, nullptr);
 
-					mCSUAVsBound = false;
+					state.csUAVsBound = false;
 				}
 			}
 
@@ -492,10 +519,10 @@ namespace bs { namespace ct
 
 						if (buffer != nullptr)
 						{
-							buffer->flushToGPU();
+							D3D11GpuParamBlockBuffer* d3d11paramBlockBuffer =
+								static_cast<D3D11GpuParamBlockBuffer*>(buffer.get());
 
-							const D3D11GpuParamBlockBuffer* d3d11paramBlockBuffer =
-								static_cast<const D3D11GpuParamBlockBuffer*>(buffer.get());
+							d3d11paramBlockBuffer->flushToGPU(state.context);
 							constBuffers[slot] = d3d11paramBlockBuffer->getD3D11Buffer();
 						}
 					}
@@ -533,7 +560,7 @@ namespace bs { namespace ct
 				{
 					context->OMSetRenderTargetsAndUnorderedAccessViews(
 						D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL, nullptr, nullptr, 0, numUAVs, uavs.data(), nullptr);
-					mPSUAVsBound = true;
+					state.psUAVsBound = true;
 				}
 
 				if (numConstBuffers > 0)
@@ -596,7 +623,7 @@ namespace bs { namespace ct
 				if (numUAVs > 0)
 				{
 					context->CSSetUnorderedAccessViews(0, numUAVs, uavs.data(), nullptr);
-					mCSUAVsBound = true;
+					state.csUAVsBound = true;
 				}
 
 				if (numConstBuffers > 0)
@@ -613,13 +640,17 @@ namespace bs { namespace ct
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(gpuParams);
+			executeRef(mImmediateState, gpuParams);
 		else
 		{
-			auto execute = [=]() { executeRef(gpuParams); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), gpuParams);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, gpuParams); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumGpuParamBinds);
@@ -627,32 +658,32 @@ namespace bs { namespace ct
 
 	void D3D11RenderAPI::setViewport(const Rect2& vp, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const Rect2& vp)
+		auto executeRef = [&](D3D11ContextState& state, const Rect2& vp)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			mViewportNorm = vp;
-			applyViewport();
+			state.viewportNorm = vp;
+			applyViewport(state);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(vp);
+			executeRef(mImmediateState, vp);
 		else
 		{
-			auto execute = [=]() { executeRef(vp); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), vp);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, vp); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11RenderAPI::setVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
 			UINT32 maxBoundVertexBuffers = mCurrentCapabilities[0].getMaxBoundVertexBuffers();
 			if (index < 0 || (index + numBuffers) >= maxBoundVertexBuffers)
 			{
@@ -675,17 +706,21 @@ namespace bs { namespace ct
 				offsets[i] = 0;
 			}
 
-			mDevice->getImmediateContext()->IASetVertexBuffers(index, numBuffers, dx11buffers, strides, offsets);
+			state.context->IASetVertexBuffers(index, numBuffers, dx11buffers, strides, offsets);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(index, buffers, numBuffers);
+			executeRef(mImmediateState, index, buffers, numBuffers);
 		else
 		{
-			auto execute = [=]() { executeRef(index, buffers, numBuffers); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), index, buffers, numBuffers);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, index, buffers, numBuffers); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumVertexBufferBinds);
@@ -693,10 +728,8 @@ namespace bs { namespace ct
 
 	void D3D11RenderAPI::setIndexBuffer(const SPtr<IndexBuffer>& buffer, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<IndexBuffer>& buffer)
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<IndexBuffer>& buffer)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
 			SPtr<D3D11IndexBuffer> indexBuffer = std::static_pointer_cast<D3D11IndexBuffer>(buffer);
 
 			DXGI_FORMAT indexFormat = DXGI_FORMAT_R16_UINT;
@@ -707,17 +740,21 @@ namespace bs { namespace ct
 			else
 				BS_EXCEPT(InternalErrorException, "Unsupported index format: " + toString(indexBuffer->getProperties().getType()));
 
-			mDevice->getImmediateContext()->IASetIndexBuffer(indexBuffer->getD3DIndexBuffer(), indexFormat, 0);
+			state.context->IASetIndexBuffer(indexBuffer->getD3DIndexBuffer(), indexFormat, 0);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(buffer);
+			executeRef(mImmediateState, buffer);
 		else
 		{
-			auto execute = [=]() { executeRef(buffer); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), buffer);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, buffer); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumIndexBufferBinds);
@@ -726,42 +763,48 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<VertexDeclaration>& vertexDeclaration)
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<VertexDeclaration>& vertexDeclaration)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			mActiveVertexDeclaration = vertexDeclaration;
+			state.activeVertexDeclaration = vertexDeclaration;
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(vertexDeclaration);
+			executeRef(mImmediateState, vertexDeclaration);
 		else
 		{
-			auto execute = [=]() { executeRef(vertexDeclaration); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), vertexDeclaration);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, vertexDeclaration); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11RenderAPI::setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](DrawOperationType op)
+		auto executeRef = [&](D3D11ContextState& state, DrawOperationType op)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			mDevice->getImmediateContext()->IASetPrimitiveTopology(D3D11Mappings::getPrimitiveType(op));
-			mActiveDrawOp = op;
+			state.context->IASetPrimitiveTopology(D3D11Mappings::getPrimitiveType(op));
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(op);
+		{
+			executeRef(mImmediateState, op);
+			mActiveDrawOp = op;
+		}
 		else
 		{
-			auto execute = [=]() { executeRef(op); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), op);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, op); };
+				cb->queueCommand(execute);
+			}
 
 			cb->mActiveDrawOp = op;
 		}
@@ -770,16 +813,14 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			applyInputLayout();
+			applyInputLayout(state);
 
 			if (instanceCount <= 1)
-				mDevice->getImmediateContext()->Draw(vertexCount, vertexOffset);
+				state.context->Draw(vertexCount, vertexOffset);
 			else
-				mDevice->getImmediateContext()->DrawInstanced(vertexCount, instanceCount, vertexOffset, 0);
+				state.context->DrawInstanced(vertexCount, instanceCount, vertexOffset, 0);
 
 #if BS_DEBUG_MODE
 			if (mDevice->hasError())
@@ -790,15 +831,19 @@ namespace bs { namespace ct
 		UINT32 primCount;
 		if (commandBuffer == nullptr)
 		{
-			executeRef(vertexOffset, vertexCount, instanceCount);
+			executeRef(mImmediateState, vertexOffset, vertexCount, instanceCount);
 			primCount = vertexCountToPrimCount(mActiveDrawOp, vertexCount);
 		}
 		else
 		{
-			auto execute = [=]() { executeRef(vertexOffset, vertexCount, instanceCount); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), vertexOffset, vertexCount, instanceCount);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, vertexOffset, vertexCount, instanceCount); };
+				cb->queueCommand(execute);
+			}
 
 			primCount = vertexCountToPrimCount(cb->mActiveDrawOp, vertexCount);
 		}
@@ -811,17 +856,15 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount, 
 		UINT32 instanceCount, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
-			UINT32 instanceCount)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset,
+			UINT32 vertexCount, UINT32 instanceCount)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			applyInputLayout();
+			applyInputLayout(state);
 
 			if (instanceCount <= 1)
-				mDevice->getImmediateContext()->DrawIndexed(indexCount, startIndex, vertexOffset);
+				state.context->DrawIndexed(indexCount, startIndex, vertexOffset);
 			else
-				mDevice->getImmediateContext()->DrawIndexedInstanced(indexCount, instanceCount, startIndex, vertexOffset, 0);
+				state.context->DrawIndexedInstanced(indexCount, instanceCount, startIndex, vertexOffset, 0);
 
 #if BS_DEBUG_MODE
 			if (mDevice->hasError())
@@ -832,15 +875,23 @@ namespace bs { namespace ct
 		UINT32 primCount;
 		if (commandBuffer == nullptr)
 		{
-			executeRef(startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
+			executeRef(mImmediateState, startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
 			primCount = vertexCountToPrimCount(mActiveDrawOp, indexCount);
 		}
 		else
 		{
-			auto execute = [=]() { executeRef(startIndex, indexCount, vertexOffset, vertexCount, instanceCount); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
+			else
+			{
+				auto execute = [=]()
+				{
+					executeRef(mImmediateState, startIndex, indexCount, vertexOffset, vertexCount, instanceCount);
+				};
+
+				cb->queueCommand(execute);
+			}
 
 			primCount = vertexCountToPrimCount(cb->mActiveDrawOp, indexCount);
 		}
@@ -853,11 +904,84 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+		{
+			state.context->Dispatch(numGroupsX, numGroupsY, numGroupsZ);
+
+#if BS_DEBUG_MODE
+			if (mDevice->hasError())
+				LOGWRN(mDevice->getErrorDescription());
+#endif
+		};
+
+		if (commandBuffer == nullptr)
+			executeRef(mImmediateState, numGroupsX, numGroupsY, numGroupsZ);
+		else
+		{
+			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), numGroupsX, numGroupsY, numGroupsZ);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, numGroupsX, numGroupsY, numGroupsZ); };
+				cb->queueCommand(execute);
+			}
+		}
+
+		BS_INC_RENDER_STAT(NumComputeCalls);
+	}
+
+	void D3D11RenderAPI::drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount,
+		UINT32 stride, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<GpuBuffer>& argsBuffer, UINT32 offset,
+			UINT32 drawCount, UINT32 stride)
+		{
+			applyInputLayout(state);
+
+			// No native multi-draw support, issue the draws one by one
+			ID3D11Buffer* d3d11Buffer = static_cast<D3D11GpuBuffer*>(argsBuffer.get())->getDX11Buffer();
+			for (UINT32 i = 0; i < drawCount; i++)
+				state.context->DrawInstancedIndirect(d3d11Buffer, offset + i * stride);
+
+#if BS_DEBUG_MODE
+			if (mDevice->hasError())
+				LOGWRN(mDevice->getErrorDescription());
+#endif
+		};
+
+		if (stride == 0)
+			stride = sizeof(DRAW_INDIRECT_ARGS);
+
+		if (commandBuffer == nullptr)
+			executeRef(mImmediateState, argsBuffer, offset, drawCount, stride);
+		else
+		{
+			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), argsBuffer, offset, drawCount, stride);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, argsBuffer, offset, drawCount, stride); };
+				cb->queueCommand(execute);
+			}
+		}
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
+
+	void D3D11RenderAPI::drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount,
+		UINT32 stride, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<GpuBuffer>& argsBuffer, UINT32 offset,
+			UINT32 drawCount, UINT32 stride)
 		{
-			THROW_IF_NOT_CORE_THREAD;
+			applyInputLayout(state);
 
-			mDevice->getImmediateContext()->Dispatch(numGroupsX, numGroupsY, numGroupsZ);
+			// No native multi-draw support, issue the draws one by one
+			ID3D11Buffer* d3d11Buffer = static_cast<D3D11GpuBuffer*>(argsBuffer.get())->getDX11Buffer();
+			for (UINT32 i = 0; i < drawCount; i++)
+				state.context->DrawIndexedInstancedIndirect(d3d11Buffer, offset + i * stride);
 
 #if BS_DEBUG_MODE
 			if (mDevice->hasError())
@@ -865,14 +989,52 @@ namespace bs { namespace ct
 #endif
 		};
 
+		if (stride == 0)
+			stride = sizeof(DRAW_INDEXED_INDIRECT_ARGS);
+
 		if (commandBuffer == nullptr)
-			executeRef(numGroupsX, numGroupsY, numGroupsZ);
+			executeRef(mImmediateState, argsBuffer, offset, drawCount, stride);
 		else
 		{
-			auto execute = [=]() { executeRef(numGroupsX, numGroupsY, numGroupsZ); };
+			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), argsBuffer, offset, drawCount, stride);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, argsBuffer, offset, drawCount, stride); };
+				cb->queueCommand(execute);
+			}
+		}
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
 
+	void D3D11RenderAPI::dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<GpuBuffer>& argsBuffer, UINT32 offset)
+		{
+			ID3D11Buffer* d3d11Buffer = static_cast<D3D11GpuBuffer*>(argsBuffer.get())->getDX11Buffer();
+			state.context->DispatchIndirect(d3d11Buffer, offset);
+
+#if BS_DEBUG_MODE
+			if (mDevice->hasError())
+				LOGWRN(mDevice->getErrorDescription());
+#endif
+		};
+
+		if (commandBuffer == nullptr)
+			executeRef(mImmediateState, argsBuffer, offset);
+		else
+		{
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), argsBuffer, offset);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, argsBuffer, offset); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumComputeCalls);
@@ -881,67 +1043,71 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 left, UINT32 top, UINT32 right, UINT32 bottom)
 		{
-			THROW_IF_NOT_CORE_THREAD;
+			state.scissorRect.left = static_cast<LONG>(left);
+			state.scissorRect.top = static_cast<LONG>(top);
+			state.scissorRect.bottom = static_cast<LONG>(bottom);
+			state.scissorRect.right = static_cast<LONG>(right);
 
-			mScissorRect.left = static_cast<LONG>(left);
-			mScissorRect.top = static_cast<LONG>(top);
-			mScissorRect.bottom = static_cast<LONG>(bottom);
-			mScissorRect.right = static_cast<LONG>(right);
-
-			mDevice->getImmediateContext()->RSSetScissorRects(1, &mScissorRect);
+			state.context->RSSetScissorRects(1, &state.scissorRect);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(left, top, right, bottom);
+			executeRef(mImmediateState, left, top, right, bottom);
 		else
 		{
-			auto execute = [=]() { executeRef(left, top, right, bottom); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), left, top, right, bottom);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, left, top, right, bottom); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11RenderAPI::setStencilRef(UINT32 value, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 value)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 value)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			mStencilRef = value;
+			state.stencilRef = value;
 
-			if(mActiveDepthStencilState != nullptr)
-				mDevice->getImmediateContext()->OMSetDepthStencilState(mActiveDepthStencilState->getInternal(), mStencilRef);
+			if(state.activeDepthStencilState != nullptr)
+				state.context->OMSetDepthStencilState(state.activeDepthStencilState->getInternal(), state.stencilRef);
 			else
-				mDevice->getImmediateContext()->OMSetDepthStencilState(nullptr, mStencilRef);
+				state.context->OMSetDepthStencilState(nullptr, state.stencilRef);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(value);
+			executeRef(mImmediateState, value);
 		else
 		{
-			auto execute = [=]() { executeRef(value); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), value);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, value); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11RenderAPI::clearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil, UINT8 targetMask, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 buffers, const Color& color, float depth, UINT16 stencil, UINT8 targetMask)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+			UINT8 targetMask)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			if (mActiveRenderTarget == nullptr)
+			if (state.activeRenderTarget == nullptr)
 				return;
 
-			const RenderTargetProperties& rtProps = mActiveRenderTarget->getProperties();
+			const RenderTargetProperties& rtProps = state.activeRenderTarget->getProperties();
 
-			Rect2I clearArea((int)mViewport.TopLeftX, (int)mViewport.TopLeftY, (int)mViewport.Width, (int)mViewport.Height);
+			Rect2I clearArea((int)state.viewport.TopLeftX, (int)state.viewport.TopLeftY, (int)state.viewport.Width,
+				(int)state.viewport.Height);
 
 			bool clearEntireTarget = clearArea.width == 0 || clearArea.height == 0;
 			clearEntireTarget |= (clearArea.x == 0 && clearArea.y == 0 && clearArea.width == rtProps.width && 
@@ -950,92 +1116,50 @@ namespace bs { namespace ct
 			if (!clearEntireTarget)
 			{
 				// TODO - Ignoring targetMask here
-				D3D11RenderUtility::instance().drawClearQuad(buffers, color, depth, stencil);
-				BS_INC_RENDER_STAT(NumClears);
+				D3D11RenderUtility::instance().drawClearQuad(state.context, buffers, color, depth, stencil);
 			}
 			else
-				clearRenderTarget(buffers, color, depth, stencil, targetMask);
+				applyClear(state, buffers, color, depth, stencil, targetMask);
+
+			BS_INC_RENDER_STAT(NumClears);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(buffers, color, depth, stencil, targetMask);
+			executeRef(mImmediateState, buffers, color, depth, stencil, targetMask);
 		else
 		{
-			auto execute = [=]() { executeRef(buffers, color, depth, stencil, targetMask); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), buffers, color, depth, stencil, targetMask);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, buffers, color, depth, stencil, targetMask); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11RenderAPI::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil, 
 		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](UINT32 buffers, const Color& color, float depth, UINT16 stencil, UINT8 targetMask)
+		auto executeRef = [&](D3D11ContextState& state, UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+			UINT8 targetMask)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			if (mActiveRenderTarget == nullptr)
-				return;
-
-			// Clear render surfaces
-			if (buffers & FBT_COLOR)
-			{
-				UINT32 maxRenderTargets = mCurrentCapabilities[0].getNumMultiRenderTargets();
-
-				ID3D11RenderTargetView** views = bs_newN<ID3D11RenderTargetView*>(maxRenderTargets);
-				memset(views, 0, sizeof(ID3D11RenderTargetView*) * maxRenderTargets);
-
-				mActiveRenderTarget->getCustomAttribute("RTV", views);
-				if (!views[0])
-				{
-					bs_deleteN(views, maxRenderTargets);
-					return;
-				}
-
-				float clearColor[4];
-				clearColor[0] = color.r;
-				clearColor[1] = color.g;
-				clearColor[2] = color.b;
-				clearColor[3] = color.a;
-
-				for (UINT32 i = 0; i < maxRenderTargets; i++)
-				{
-					if (views[i] != nullptr && ((1 << i) & targetMask) != 0)
-						mDevice->getImmediateContext()->ClearRenderTargetView(views[i], clearColor);
-				}
-
-				bs_deleteN(views, maxRenderTargets);
-			}
-
-			// Clear depth stencil
-			if ((buffers & FBT_DEPTH) != 0 || (buffers & FBT_STENCIL) != 0)
-			{
-				ID3D11DepthStencilView* depthStencilView = nullptr;
-				mActiveRenderTarget->getCustomAttribute("DSV", &depthStencilView);
-
-				D3D11_CLEAR_FLAG clearFlag;
-
-				if ((buffers & FBT_DEPTH) != 0 && (buffers & FBT_STENCIL) != 0)
-					clearFlag = (D3D11_CLEAR_FLAG)(D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL);
-				else if ((buffers & FBT_STENCIL) != 0)
-					clearFlag = D3D11_CLEAR_STENCIL;
-				else
-					clearFlag = D3D11_CLEAR_DEPTH;
-
-				if (depthStencilView != nullptr)
-					mDevice->getImmediateContext()->ClearDepthStencilView(depthStencilView, clearFlag, depth, (UINT8)stencil);
-			}
+			applyClear(state, buffers, color, depth, stencil, targetMask);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(buffers, color, depth, stencil, targetMask);
+			executeRef(mImmediateState, buffers, color, depth, stencil, targetMask);
 		else
 		{
-			auto execute = [=]() { executeRef(buffers, color, depth, stencil, targetMask); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), buffers, color, depth, stencil, targetMask);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, buffers, color, depth, stencil, targetMask); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumClears);
@@ -1044,11 +1168,9 @@ namespace bs { namespace ct
 	void D3D11RenderAPI::setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags, 
 		RenderSurfaceMask loadMask, const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [&](const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
+		auto executeRef = [&](D3D11ContextState& state, const SPtr<RenderTarget>& target, UINT32 readOnlyFlags)
 		{
-			THROW_IF_NOT_CORE_THREAD;
-
-			mActiveRenderTarget = target;
+			state.activeRenderTarget = target;
 
 			UINT32 maxRenderTargets = mCurrentCapabilities[0].getNumMultiRenderTargets();
 			ID3D11RenderTargetView** views = bs_newN<ID3D11RenderTargetView*>(maxRenderTargets);
@@ -1077,22 +1199,26 @@ namespace bs { namespace ct
 			}
 
 			// Bind render targets
-			mDevice->getImmediateContext()->OMSetRenderTargets(maxRenderTargets, views, depthStencilView);
+			state.context->OMSetRenderTargets(maxRenderTargets, views, depthStencilView);
 			if (mDevice->hasError())
 				BS_EXCEPT(RenderingAPIException, "Failed to setRenderTarget : " + mDevice->getErrorDescription());
 
 			bs_deleteN(views, maxRenderTargets);
-			applyViewport();
+			applyViewport(state);
 		};
 
 		if (commandBuffer == nullptr)
-			executeRef(target, readOnlyFlags);
+			executeRef(mImmediateState, target, readOnlyFlags);
 		else
 		{
-			auto execute = [=]() { executeRef(target, readOnlyFlags); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState(), target, readOnlyFlags);
+			else
+			{
+				auto execute = [=]() { executeRef(mImmediateState, target, readOnlyFlags); };
+				cb->queueCommand(execute);
+			}
 		}
 
 		BS_INC_RENDER_STAT(NumRenderTargetChanges);
@@ -1121,32 +1247,37 @@ namespace bs { namespace ct
 			return;
 
 		cb->executeCommands();
+
+		// Executing a command list leaves the immediate context in its default state
+		if (cb->isDeferred())
+			mImmediateState.reset();
+
 		cb->clear();
 	}
 
-	void D3D11RenderAPI::applyViewport()
+	void D3D11RenderAPI::applyViewport(D3D11ContextState& state)
 	{
-		if (mActiveRenderTarget == nullptr)
+		if (state.activeRenderTarget == nullptr)
 			return;
 
-		const RenderTargetProperties& rtProps = mActiveRenderTarget->getProperties();
+		const RenderTargetProperties& rtProps = state.activeRenderTarget->getProperties();
 
 		// Set viewport dimensions
-		mViewport.TopLeftX = (FLOAT)(rtProps.width * mViewportNorm.x);
-		mViewport.TopLeftY = (FLOAT)(rtProps.height * mViewportNorm.y);
-		mViewport.Width = (FLOAT)(rtProps.width * mViewportNorm.width);
-		mViewport.Height = (FLOAT)(rtProps.height * mViewportNorm.height);
+		state.viewport.TopLeftX = (FLOAT)(rtProps.width * state.viewportNorm.x);
+		state.viewport.TopLeftY = (FLOAT)(rtProps.height * state.viewportNorm.y);
+		state.viewport.Width = (FLOAT)(rtProps.width * state.viewportNorm.width);
+		state.viewport.Height = (FLOAT)(rtProps.height * state.viewportNorm.height);
 
 		if (rtProps.requiresTextureFlipping)
 		{
 			// Convert "top-left" to "bottom-left"
-			mViewport.TopLeftY = rtProps.height - mViewport.Height - mViewport.TopLeftY;
+			state.viewport.TopLeftY = rtProps.height - state.viewport.Height - state.viewport.TopLeftY;
 		}
 
-		mViewport.MinDepth = 0.0f;
-		mViewport.MaxDepth = 1.0f;
+		state.viewport.MinDepth = 0.0f;
+		state.viewport.MaxDepth = 1.0f;
 
-		mDevice->getImmediateContext()->RSSetViewports(1, &mViewport);
+		state.context->RSSetViewports(1, &state.viewport);
 	}
 
 	void D3D11RenderAPI::initCapabilites(IDXGIAdapter* adapter, RenderAPICapabilities& caps) const
@@ -1199,6 +1330,7 @@ namespace bs { namespace ct
 		{
 			caps.setCapability(RSC_TESSELLATION_PROGRAM);
 			caps.setCapability(RSC_COMPUTE_PROGRAM);
+			caps.setCapability(RSC_DRAW_INDIRECT);
 
 			caps.setNumTextureUnits(GPT_HULL_PROGRAM, D3D11_COMMONSHADER_INPUT_RESOURCE_REGISTER_COUNT);
 			caps.setNumTextureUnits(GPT_DOMAIN_PROGRAM, D3D11_COMMONSHADER_INPUT_RESOURCE_REGISTER_COUNT);
@@ -1368,7 +1500,8 @@ namespace bs { namespace ct
 			RenderAPIFeatureFlag::Compute | 
 			RenderAPIFeatureFlag::LoadStore |
 			RenderAPIFeatureFlag::ByteCodeCaching |
-			RenderAPIFeatureFlag::RenderTargetLayers;
+			RenderAPIFeatureFlag::RenderTargetLayers |
+			RenderAPIFeatureFlag::ParallelSecondaryCB;
 
 		static RenderAPIInfo info(0.0f, 0.0f, 0.0f, 1.0f, VET_COLOR_ABGR, featureFlags);
 
@@ -1458,22 +1591,79 @@ namespace bs { namespace ct
 	/* 								PRIVATE		                     		*/
 	/************************************************************************/
 
-	void D3D11RenderAPI::applyInputLayout()
+	void D3D11RenderAPI::applyClear(D3D11ContextState& state, UINT32 buffers, const Color& color, float depth,
+		UINT16 stencil, UINT8 targetMask)
+	{
+		if (state.activeRenderTarget == nullptr)
+			return;
+
+		// Clear render surfaces
+		if (buffers & FBT_COLOR)
+		{
+			UINT32 maxRenderTargets = mCurrentCapabilities[0].getNumMultiRenderTargets();
+
+			ID3D11RenderTargetView** views = bs_newN<ID3D11RenderTargetView*>(maxRenderTargets);
+			memset(views, 0, sizeof(ID3D11RenderTargetView*) * maxRenderTargets);
+
+			state.activeRenderTarget->getCustomAttribute("RTV", views);
+			if (!views[0])
+			{
+				bs_deleteN(views, maxRenderTargets);
+				return;
+			}
+
+			float clearColor[4];
+			clearColor[0] = color.r;
+			clearColor[1] = color.g;
+			clearColor[2] = color.b;
+			clearColor[3] = color.a;
+
+			for (UINT32 i = 0; i < maxRenderTargets; i++)
+			{
+				if (views[i] != nullptr && ((1 << i) & targetMask) != 0)
+					state.context->ClearRenderTargetView(views[i], clearColor);
+			}
+
+			bs_deleteN(views, maxRenderTargets);
+		}
+
+		// Clear depth stencil
+		if ((buffers & FBT_DEPTH) != 0 || (buffers & FBT_STENCIL) != 0)
+		{
+			ID3D11DepthStencilView* depthStencilView = nullptr;
+			state.activeRenderTarget->getCustomAttribute("DSV", &depthStencilView);
+
+			D3D11_CLEAR_FLAG clearFlag;
+
+			if ((buffers & FBT_DEPTH) != 0 && (buffers & FBT_STENCIL) != 0)
+				clearFlag = (D3D11_CLEAR_FLAG)(D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL);
+			else if ((buffers & FBT_STENCIL) != 0)
+				clearFlag = D3D11_CLEAR_STENCIL;
+			else
+				clearFlag = D3D11_CLEAR_DEPTH;
+
+			if (depthStencilView != nullptr)
+				state.context->ClearDepthStencilView(depthStencilView, clearFlag, depth, (UINT8)stencil);
+		}
+	}
+
+	void D3D11RenderAPI::applyInputLayout(D3D11ContextState& state)
 	{
-		if(mActiveVertexDeclaration == nullptr)
+		if(state.activeVertexDeclaration == nullptr)
 		{
 			LOGWRN("Cannot apply input layout without a vertex declaration. Set vertex declaration before calling this method.");
 			return;
 		}
 
-		if(mActiveVertexShader == nullptr)
+		if(state.activeVertexShader == nullptr)
 		{
 			LOGWRN("Cannot apply input layout without a vertex shader. Set vertex shader before calling this method.");
 			return;
 		}
 
-		ID3D11InputLayout* ia = mIAManager->retrieveInputLayout(mActiveVertexShader->getInputDeclaration(), mActiveVertexDeclaration, *mActiveVertexShader);
+		ID3D11InputLayout* ia = mIAManager->retrieveInputLayout(state.activeVertexShader->getInputDeclaration(),
+			state.activeVertexDeclaration, *state.activeVertexShader);
 
-		mDevice->getImmediateContext()->IASetInputLayout(ia);
+		state.context->IASetInputLayout(ia);
 	}
 }}
\ No newline at end of file
@@ -11,6 +11,31 @@ namespace bs { namespace ct
 	 *  @{
 	 */
 
+	/**
+	 * Device context commands are recorded into, along with the render API state bound to it that needs to be tracked
+	 * on the CPU.
+	 */
+	struct D3D11ContextState
+	{
+		/** Resets the tracked state to the defaults of a freshly cleared context. */
+		void reset();
+
+		ID3D11DeviceContext* context = nullptr;
+
+		bool psUAVsBound = false;
+		bool csUAVsBound = false;
+
+		UINT32 stencilRef = 0;
+		Rect2 viewportNorm = Rect2(0.0f, 0.0f, 1.0f, 1.0f);
+		D3D11_VIEWPORT viewport;
+		D3D11_RECT scissorRect;
+
+		SPtr<RenderTarget> activeRenderTarget;
+		SPtr<VertexDeclaration> activeVertexDeclaration;
+		SPtr<D3D11GpuProgram> activeVertexShader;
+		SPtr<D3D11DepthStencilState> activeDepthStencilState;
+	};
+
 	/** Implementation of a render system using DirectX 11. Provides abstracted access to various low level DX11 methods. */
 	class D3D11RenderAPI : public RenderAPI
 	{
@@ -83,6 +108,18 @@ namespace bs { namespace ct
 		void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1,
 			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
 
+		/** @copydoc RenderAPI::drawIndirect */
+		void drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::drawIndexedIndirect */
+		void drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::dispatchComputeIndirect */
+		void dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
 		/** @copydoc RenderAPI::swapBuffers() */
 		void swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask = 0xFFFFFFFF) override;
 
@@ -140,13 +177,17 @@ namespace bs { namespace ct
 		 *
 		 * Applies the input layout to the pipeline.
 		 */
-		void applyInputLayout();
+		void applyInputLayout(D3D11ContextState& state);
 
 		/**
 		 * Recalculates actual viewport dimensions based on currently set viewport normalized dimensions and render target
 		 * and applies them for further rendering.
 		 */
-		void applyViewport();
+		void applyViewport(D3D11ContextState& state);
+
+		/** Clears the render target currently bound to the provided context. See clearRenderTarget(). */
+		void applyClear(D3D11ContextState& state, UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+			UINT8 targetMask);
 
 		/** Creates and populates a set of render system capabilities describing which functionality is available. */
 		void initCapabilites(IDXGIAdapter* adapter, RenderAPICapabilities& caps) const;
@@ -163,18 +204,7 @@ namespace bs { namespace ct
 		D3D11HLSLProgramFactory* mHLSLFactory;
 		D3D11InputLayoutManager* mIAManager;
 
-		bool mPSUAVsBound;
-		bool mCSUAVsBound;
-
-		UINT32 mStencilRef;
-		Rect2 mViewportNorm;
-		D3D11_VIEWPORT mViewport;
-		D3D11_RECT mScissorRect;
-
-		SPtr<VertexDeclaration> mActiveVertexDeclaration;
-		SPtr<D3D11GpuProgram> mActiveVertexShader;
-		SPtr<D3D11DepthStencilState> mActiveDepthStencilState;
-
+		D3D11ContextState mImmediateState;
 		DrawOperationType mActiveDrawOp;
 	};
 
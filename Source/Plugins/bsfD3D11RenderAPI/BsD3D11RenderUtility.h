@@ -23,13 +23,15 @@ namespace bs { namespace ct
 		 * APIs like DX9 and OpenGL where you can clear only a part of the render target. (DX11 API only provides a way to
 		 * clear the entire render target).
 		 *
+		 * @param[in]	context			Device context to record the draw into.
 		 * @param[in]	clearBuffers	Combination of one or more elements of FrameBufferType denoting which buffers are
 		 *								to be cleared.
 		 * @param[in]	color			(optional) The color to clear the color buffer with, if enabled.
 		 * @param[in]	depth			(optional) The value to initialize the depth buffer with, if enabled.
 		 * @param[in]	stencil			(optional) The value to initialize the stencil buffer with, if enabled.
 		 */
-		void drawClearQuad(UINT32 clearBuffers, const Color& color, float depth, UINT16 stencil);
+		void drawClearQuad(ID3D11DeviceContext* context, UINT32 clearBuffers, const Color& color, float depth,
+			UINT16 stencil);
 
 	protected:
 		/**	Initializes resources needed for drawing the clear quad. Should be called one time at start-up. */
@@ -64,7 +64,10 @@ namespace bs { namespace ct
 	void D3D11Texture::copyImpl(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc, 
 			const SPtr<CommandBuffer>& commandBuffer)
 	{
-		auto executeRef = [this](const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc)
+		// Command buffer is only provided if recording into a deferred context, otherwise the commands execute directly
+		// on the immediate context
+		auto executeRef = [this](ID3D11DeviceContext* context, const SPtr<Texture>& target,
+			const TEXTURE_COPY_DESC& desc, const SPtr<CommandBuffer>& commandBuffer)
 		{
 			D3D11Texture* other = static_cast<D3D11Texture*>(target.get());
 
@@ -84,7 +87,7 @@ namespace bs { namespace ct
 			if (srcHasMultisample && !destHasMultisample) // Resolving from MS to non-MS texture
 			{
 				if(copyEntireSurface)
-					device.getImmediateContext()->ResolveSubresource(other->getDX11Resource(), destResIdx, mTex, srcResIdx, mDXGIFormat);
+					context->ResolveSubresource(other->getDX11Resource(), destResIdx, mTex, srcResIdx, mDXGIFormat);
 				else
 				{
 					// Need to first resolve to a temporary texture, then copy
@@ -95,14 +98,14 @@ namespace bs { namespace ct
 					tempDesc.hwGamma = mProperties.isHardwareGammaEnabled();
 
 					SPtr<D3D11Texture> temporary = std::static_pointer_cast<D3D11Texture>(Texture::create(tempDesc));
-					device.getImmediateContext()->ResolveSubresource(temporary->getDX11Resource(), 0, mTex, srcResIdx, mDXGIFormat);
+					context->ResolveSubresource(temporary->getDX11Resource(), 0, mTex, srcResIdx, mDXGIFormat);
 
 					TEXTURE_COPY_DESC tempCopyDesc;
 					tempCopyDesc.dstMip = desc.dstMip;
 					tempCopyDesc.dstFace = desc.dstFace;
 					tempCopyDesc.dstPosition = desc.dstPosition;
 
-					temporary->copy(target, tempCopyDesc);
+					temporary->copy(target, tempCopyDesc, commandBuffer);
 				}
 			}
 			else
@@ -119,7 +122,7 @@ namespace bs { namespace ct
 				if(!copyEntireSurface)
 					srcRegionPtr = &srcRegion;
 
-				device.getImmediateContext()->CopySubresourceRegion(
+				context->CopySubresourceRegion(
 					other->getDX11Resource(),
 					destResIdx,
 					(UINT32)desc.dstPosition.x,
@@ -137,14 +140,21 @@ namespace bs { namespace ct
 			}
 		};
 
+		D3D11RenderAPI* rs = static_cast<D3D11RenderAPI*>(RenderAPI::instancePtr());
+		ID3D11DeviceContext* immediateContext = rs->getPrimaryDevice().getImmediateContext();
+
 		if (commandBuffer == nullptr)
-			executeRef(target, desc);
+			executeRef(immediateContext, target, desc, nullptr);
 		else
 		{
-			auto execute = [=]() { executeRef(target, desc); };
-
 			SPtr<D3D11CommandBuffer> cb = std::static_pointer_cast<D3D11CommandBuffer>(commandBuffer);
-			cb->queueCommand(execute);
+			if (cb->isDeferred())
+				executeRef(cb->getState().context, target, desc, commandBuffer);
+			else
+			{
+				auto execute = [=]() { executeRef(immediateContext, target, desc, nullptr); };
+				cb->queueCommand(execute);
+			}
 		}
 	}
 
@@ -154,29 +164,36 @@ namespace bs { namespace ct
 		if (mProperties.getNumSamples() > 1)
 			BS_EXCEPT(InvalidStateException, "Multisampled textures cannot be accessed from the CPU directly.");
 
+		UINT32 mipWidth = std::max(1u, mProperties.getWidth() >> mipLevel);
+		UINT32 mipHeight = std::max(1u, mProperties.getHeight() >> mipLevel);
+		UINT32 mipDepth = std::max(1u, mProperties.getDepth() >> mipLevel);
+
+		PixelData lockedArea(mipWidth, mipHeight, mipDepth, mInternalFormat);
+
 #if BS_PROFILING_ENABLED
 		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_Texture, lockedArea.getConsecutiveSize());
 		}
 
 		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_Texture, lockedArea.getConsecutiveSize());
 		}
 #endif
 
-		UINT32 mipWidth = std::max(1u, mProperties.getWidth() >> mipLevel);
-		UINT32 mipHeight = std::max(1u, mProperties.getHeight() >> mipLevel);
-		UINT32 mipDepth = std::max(1u, mProperties.getDepth() >> mipLevel);
-
-		PixelData lockedArea(mipWidth, mipHeight, mipDepth, mInternalFormat);
-
 		D3D11_MAP flags = D3D11Mappings::getLockOptions(options);
 		UINT32 rowPitch, slicePitch;
 		if(flags == D3D11_MAP_READ || flags == D3D11_MAP_READ_WRITE)
 		{
-			UINT8* data = (UINT8*)mapstagingbuffer(flags, face, mipLevel, rowPitch, slicePitch);
+			// CPU readable textures are staging resources themselves, and can be mapped without an extra copy. If the
+			// GPU is done writing to them the map doesn't need to wait either.
+			UINT8* data;
+			if ((mProperties.getUsage() & TU_CPUREADABLE) != 0)
+				data = (UINT8*)map(mTex, flags, mipLevel, face, rowPitch, slicePitch);
+			else
+				data = (UINT8*)mapstagingbuffer(flags, mipLevel, face, rowPitch, slicePitch);
+
 			lockedArea.setExternalBuffer(data);
 
 			if (PixelUtil::isCompressed(mProperties.getFormat()))
@@ -228,7 +245,12 @@ namespace bs { namespace ct
 	void D3D11Texture::unlockImpl()
 	{
 		if(mLockedForReading)
-			unmapstagingbuffer();
+		{
+			if ((mProperties.getUsage() & TU_CPUREADABLE) != 0)
+				unmap(mTex);
+			else
+				unmapstagingbuffer();
+		}
 		else
 		{
 			if ((mProperties.getUsage() & TU_DYNAMIC) != 0)
@@ -294,7 +316,7 @@ namespace bs { namespace ct
 				BS_EXCEPT(RenderingAPIException, "D3D11 device cannot map texture\nError Description:" + errorDescription);
 			}
 
-			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_Texture, src.getConsecutiveSize());
 		}
 		else
 		{
@@ -361,6 +383,15 @@ namespace bs { namespace ct
 			mDXGIColorFormat = D3D11Mappings::getShaderResourceDepthStencilPF(closestFormat); 
 			mDXGIDepthStencilFormat = d3dPF;
 		}
+		else if ((usage & TU_CPUREADABLE) != 0)
+		{
+			desc.Usage			= D3D11_USAGE_STAGING;
+			desc.BindFlags		= 0;
+			desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+			// Determine total number of mipmaps including main one (d3d11 convention)
+			desc.MipLevels = (numMips == MIP_UNLIMITED || (1U << numMips) > width) ? 0 : numMips + 1;
+		}
 		else
 		{
 			desc.Usage			= D3D11Mappings::getUsage((GpuBufferUsage)usage);
@@ -371,7 +402,7 @@ namespace bs { namespace ct
 			desc.MipLevels = (numMips == MIP_UNLIMITED || (1U << numMips) > width) ? 0 : numMips + 1;
 		}
 
-		if ((usage & TU_LOADSTORE) != 0)
+		if ((usage & TU_LOADSTORE) != 0 && (usage & TU_CPUREADABLE) == 0)
 			desc.BindFlags |= D3D11_BIND_UNORDERED_ACCESS;
 
 		// Create the texture
@@ -404,8 +435,8 @@ namespace bs { namespace ct
 
 		mDXGIFormat = desc.Format;
 
-		// Create texture view
-		if ((usage & TU_DEPTHSTENCIL) == 0 || readableDepth)
+		// Create texture view, unless the texture is a staging resource that can't be bound to the pipeline
+		if (((usage & TU_DEPTHSTENCIL) == 0 || readableDepth) && (usage & TU_CPUREADABLE) == 0)
 		{
 			TEXTURE_VIEW_DESC viewDesc;
 			viewDesc.mostDetailMip = 0;
@@ -488,6 +519,17 @@ namespace bs { namespace ct
 			mDXGIColorFormat = D3D11Mappings::getShaderResourceDepthStencilPF(closestFormat);
 			mDXGIDepthStencilFormat = d3dPF;
 		}
+		else if ((usage & TU_CPUREADABLE) != 0)
+		{
+			desc.Usage			= D3D11_USAGE_STAGING;
+			desc.BindFlags		= 0;
+			desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+			DXGI_SAMPLE_DESC sampleDesc;
+			sampleDesc.Count	= 1;
+			sampleDesc.Quality	= 0;
+			desc.SampleDesc		= sampleDesc;
+		}
 		else
 		{
 			desc.Usage = D3D11Mappings::getUsage((GpuBufferUsage)usage);
@@ -506,7 +548,7 @@ namespace bs { namespace ct
 		if (texType == TEX_TYPE_CUBE_MAP)
 			desc.MiscFlags |= D3D11_RESOURCE_MISC_TEXTURECUBE;
 
-		if ((usage & TU_LOADSTORE) != 0)
+		if ((usage & TU_LOADSTORE) != 0 && (usage & TU_CPUREADABLE) == 0)
 		{
 			if(desc.SampleDesc.Count <= 1)
 				desc.BindFlags |= D3D11_BIND_UNORDERED_ACCESS;
@@ -547,8 +589,8 @@ namespace bs { namespace ct
 
 		mDXGIFormat = desc.Format;
 
-		// Create shader texture view
-		if((usage & TU_DEPTHSTENCIL) == 0 || readableDepth)
+		// Create shader texture view, unless the texture is a staging resource that can't be bound to the pipeline
+		if(((usage & TU_DEPTHSTENCIL) == 0 || readableDepth) && (usage & TU_CPUREADABLE) == 0)
 		{
 			TEXTURE_VIEW_DESC viewDesc;
 			viewDesc.mostDetailMip = 0;
@@ -620,6 +662,16 @@ namespace bs { namespace ct
 			mDXGIColorFormat = D3D11Mappings::getShaderResourceDepthStencilPF(closestFormat);
 			mDXGIDepthStencilFormat = d3dPF;
 		}
+		else if ((usage & TU_CPUREADABLE) != 0)
+		{
+			desc.Usage			= D3D11_USAGE_STAGING;
+			desc.BindFlags		= 0;
+			desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+			// Determine total number of mipmaps including main one (d3d11 convention)
+			desc.MipLevels		= (numMips == MIP_UNLIMITED || (1U << numMips)
+				> std::max(std::max(width, height), depth)) ? 0 : numMips + 1;
+		}
 		else
 		{
 			desc.Usage			= D3D11Mappings::getUsage((GpuBufferUsage)usage);
@@ -631,7 +683,7 @@ namespace bs { namespace ct
 				> std::max(std::max(width, height), depth)) ? 0 : numMips + 1;
 		}
 
-		if ((usage & TU_LOADSTORE) != 0)
+		if ((usage & TU_LOADSTORE) != 0 && (usage & TU_CPUREADABLE) == 0)
 			desc.BindFlags |= D3D11_BIND_UNORDERED_ACCESS;
 
 		// Create the texture
@@ -665,7 +717,7 @@ namespace bs { namespace ct
 
 		mDXGIFormat = desc.Format;
 
-		if ((usage & TU_DEPTHSTENCIL) == 0 || readableDepth)
+		if (((usage & TU_DEPTHSTENCIL) == 0 || readableDepth) && (usage & TU_CPUREADABLE) == 0)
 		{
 			TEXTURE_VIEW_DESC viewDesc;
 			viewDesc.mostDetailMip = 0;
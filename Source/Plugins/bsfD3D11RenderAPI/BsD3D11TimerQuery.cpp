@@ -62,10 +62,10 @@ namespace bs { namespace ct
 
 	void D3D11TimerQuery::begin(const SPtr<CommandBuffer>& cb)
 	{
-		auto execute = [&]()
+		auto executeRef = [&](ID3D11DeviceContext* context)
 		{
-			mContext->Begin(mDisjointQuery);
-			mContext->End(mBeginQuery);
+			context->Begin(mDisjointQuery);
+			context->End(mBeginQuery);
 
 			mQueryEndCalled = false;
 
@@ -73,31 +73,43 @@ namespace bs { namespace ct
 		};
 
 		if (cb == nullptr)
-			execute();
+			executeRef(mContext);
 		else
 		{
 			SPtr<D3D11CommandBuffer> d3d11cb = std::static_pointer_cast<D3D11CommandBuffer>(cb);
-			d3d11cb->queueCommand(execute);
+			if (d3d11cb->isDeferred())
+				executeRef(d3d11cb->getState().context);
+			else
+			{
+				auto execute = [=]() { executeRef(mContext); };
+				d3d11cb->queueCommand(execute);
+			}
 		}
 	}
 
 	void D3D11TimerQuery::end(const SPtr<CommandBuffer>& cb)
 	{
-		auto execute = [&]()
+		auto executeRef = [&](ID3D11DeviceContext* context)
 		{
-			mContext->End(mEndQuery);
-			mContext->End(mDisjointQuery);
+			context->End(mEndQuery);
+			context->End(mDisjointQuery);
 
 			mQueryEndCalled = true;
 			mFinalized = false;
 		};
 
 		if (cb == nullptr)
-			execute();
+			executeRef(mContext);
 		else
 		{
 			SPtr<D3D11CommandBuffer> d3d11cb = std::static_pointer_cast<D3D11CommandBuffer>(cb);
-			d3d11cb->queueCommand(execute);
+			if (d3d11cb->isDeferred())
+				executeRef(d3d11cb->getState().context);
+			else
+			{
+				auto execute = [=]() { executeRef(mContext); };
+				d3d11cb->queueCommand(execute);
+			}
 		}
 	}
 
@@ -23,6 +23,7 @@
 #include "Animation/BsMorphShapes.h"
 #include "Physics/BsPhysics.h"
 #include "FileSystem/BsFileSystem.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -126,7 +127,19 @@ namespace bs
 		if (meshImportOptions->getCPUCached())
 			desc.usage |= MU_CPUCACHED;
 
-		SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->getData(), desc);
+		SPtr<MeshData> meshData = generateLODs(rendererMeshData->getData(), desc.subMeshes, *meshImportOptions,
+			desc.lodSubMeshes);
+
+		if (meshImportOptions->getOptimize())
+			optimizeMesh(meshData, desc.subMeshes, desc.lodSubMeshes, desc.morphShapes);
+
+		if (meshImportOptions->getGenerateMeshlets())
+			generateMeshlets(meshData, desc.subMeshes, desc.meshlets);
+
+		if (meshImportOptions->getQuantizeVertices())
+			meshData = RendererMeshData::quantize(meshData);
+
+		SPtr<Mesh> mesh = Mesh::_createPtr(meshData, desc);
 
 		const String fileName = filePath.getFilename(false);
 		mesh->setName(fileName);
@@ -148,7 +161,19 @@ namespace bs
 		if (meshImportOptions->getCPUCached())
 			desc.usage |= MU_CPUCACHED;
 
-		SPtr<Mesh> mesh = Mesh::_createPtr(rendererMeshData->getData(), desc);
+		SPtr<MeshData> meshData = generateLODs(rendererMeshData->getData(), desc.subMeshes, *meshImportOptions,
+			desc.lodSubMeshes);
+
+		if (meshImportOptions->getOptimize())
+			optimizeMesh(meshData, desc.subMeshes, desc.lodSubMeshes, desc.morphShapes);
+
+		if (meshImportOptions->getGenerateMeshlets())
+			generateMeshlets(meshData, desc.subMeshes, desc.meshlets);
+
+		if (meshImportOptions->getQuantizeVertices())
+			meshData = RendererMeshData::quantize(meshData);
+
+		SPtr<Mesh> mesh = Mesh::_createPtr(meshData, desc);
 
 		const String fileName = filePath.getFilename(false);
 		mesh->setName(fileName);
@@ -233,6 +258,13 @@ namespace bs
 		if (fbxImportOptions.importAnimation)
 			importAnimations(fbxScene, fbxImportOptions, importedScene);
 
+		// All the required data has been read from the SDK at this point, release it early to reduce peak memory usage
+		// while the meshes and animations are being processed
+		shutDownSdk();
+
+		if (!importedScene.clips.empty())
+			convertAnimationCurves(importedScene, fbxImportOptions);
+
 		splitMeshVertices(importedScene);
 		generateMissingTangentSpace(importedScene, fbxImportOptions);
 
@@ -250,8 +282,6 @@ namespace bs
 
 		// TODO - Later: Optimize mesh: Remove bad and degenerate polygons, weld nearby vertices, optimize for vertex cache
 
-		shutDownSdk();
-
 		return rendererMeshData;
 	}
 
@@ -494,7 +524,7 @@ namespace bs
 		int lSDKMajor,  lSDKMinor,  lSDKRevision;
 		FbxManager::GetFileFormatVersion(lSDKMajor, lSDKMinor, lSDKRevision);
 
-		Lock fileLock = FileScheduler::getLock(filePath);
+		FileLock fileLock = FileScheduler::getLock(filePath);
 		FbxImporter* importer = FbxImporter::Create(mFBXManager, "");
 		bool importStatus = importer->Initialize(filePath.toString().c_str(), -1, mFBXManager->GetIOSettings());
 		
@@ -659,20 +689,25 @@ namespace bs
 
 	void FBXImporter::splitMeshVertices(FBXImportScene& scene)
 	{
-		Vector<FBXImportMesh*> splitMeshes;
+		Vector<FBXImportMesh*> splitMeshes(scene.meshes.size());
 
-		for (auto& mesh : scene.meshes)
+		TaskScheduler::instance().parallelFor((UINT32)scene.meshes.size(), 1, [&](UINT32 start, UINT32 end)
 		{
-			FBXImportMesh* splitMesh = bs_new<FBXImportMesh>();
-			splitMesh->fbxMesh = mesh->fbxMesh;
-			splitMesh->referencedBy = mesh->referencedBy;
-			splitMesh->bones = mesh->bones;
+			for (UINT32 i = start; i < end; i++)
+			{
+				FBXImportMesh* mesh = scene.meshes[i];
 
-			FBXUtility::splitVertices(*mesh, *splitMesh);
-			splitMeshes.push_back(splitMesh);
+				FBXImportMesh* splitMesh = bs_new<FBXImportMesh>();
+				splitMesh->fbxMesh = mesh->fbxMesh;
+				splitMesh->referencedBy = mesh->referencedBy;
+				splitMesh->bones = mesh->bones;
 
-			bs_delete(mesh);
-		}
+				FBXUtility::splitVertices(*mesh, *splitMesh);
+				splitMeshes[i] = splitMesh;
+
+				bs_delete(mesh);
+			}
+		});
 
 		scene.meshes = splitMeshes;
 	}
@@ -862,220 +897,243 @@ namespace bs
 	SPtr<RendererMeshData> FBXImporter::generateMeshData(const FBXImportScene& scene, const FBXImportOptions& options, 
 		Vector<SubMesh>& outputSubMeshes)
 	{
-		Vector<SPtr<MeshData>> allMeshData;
-		Vector<Vector<SubMesh>> allSubMeshes;
-		Vector<BONE_DESC> allBones;
-		UnorderedMap<FBXImportNode*, UINT32> boneMap;
-		UINT32 boneIndexOffset = 0;
+		UINT32 numMeshes = (UINT32)scene.meshes.size();
 
-		for (auto& mesh : scene.meshes)
+		// Bone indices of each mesh are offset by the number of bones in all preceding meshes
+		Vector<UINT32> boneIndexOffsets(numMeshes);
+		UINT32 numPrecedingBones = 0;
+		for (UINT32 i = 0; i < numMeshes; i++)
+		{
+			boneIndexOffsets[i] = numPrecedingBones;
+			numPrecedingBones += (UINT32)scene.meshes[i]->bones.size();
+		}
+
+		// Meshes are processed in parallel, each outputting one mesh data object per node referencing it
+		Vector<Vector<SPtr<MeshData>>> meshDataPerMesh(numMeshes);
+		Vector<Vector<SubMesh>> subMeshesPerMesh(numMeshes);
+
+		TaskScheduler::instance().parallelFor(numMeshes, 1, [&](UINT32 start, UINT32 end)
 		{
-			Vector<Vector<UINT32>> indicesPerMaterial;
-			for (UINT32 i = 0; i < (UINT32)mesh->indices.size(); i++)
+			for (UINT32 meshIdx = start; meshIdx < end; meshIdx++)
 			{
-				while ((UINT32)mesh->materials[i] >= (UINT32)indicesPerMaterial.size())
-					indicesPerMaterial.push_back(Vector<UINT32>());
+				FBXImportMesh* mesh = scene.meshes[meshIdx];
+				const UINT32 boneIndexOffset = boneIndexOffsets[meshIdx];
 
-				indicesPerMaterial[mesh->materials[i]].push_back(mesh->indices[i]);
-			}
+				Vector<Vector<UINT32>> indicesPerMaterial;
+				for (UINT32 i = 0; i < (UINT32)mesh->indices.size(); i++)
+				{
+					while ((UINT32)mesh->materials[i] >= (UINT32)indicesPerMaterial.size())
+						indicesPerMaterial.push_back(Vector<UINT32>());
 
-			UINT32* orderedIndices = (UINT32*)bs_alloc((UINT32)mesh->indices.size() * sizeof(UINT32));
-			Vector<SubMesh> subMeshes;
-			UINT32 currentIndex = 0;
+					indicesPerMaterial[mesh->materials[i]].push_back(mesh->indices[i]);
+				}
 
-			for (auto& subMeshIndices : indicesPerMaterial)
-			{
-				UINT32 indexCount = (UINT32)subMeshIndices.size();
-				UINT32* dest = orderedIndices + currentIndex;
-				memcpy(dest, subMeshIndices.data(), indexCount * sizeof(UINT32));
+				UINT32* orderedIndices = (UINT32*)bs_alloc((UINT32)mesh->indices.size() * sizeof(UINT32));
+				Vector<SubMesh> subMeshes;
+				UINT32 currentIndex = 0;
 
-				subMeshes.push_back(SubMesh(currentIndex, indexCount, DOT_TRIANGLE_LIST));
+				for (auto& subMeshIndices : indicesPerMaterial)
+				{
+					UINT32 indexCount = (UINT32)subMeshIndices.size();
+					UINT32* dest = orderedIndices + currentIndex;
+					memcpy(dest, subMeshIndices.data(), indexCount * sizeof(UINT32));
 
-				currentIndex += indexCount;
-			}
+					subMeshes.push_back(SubMesh(currentIndex, indexCount, DOT_TRIANGLE_LIST));
 
-			UINT32 vertexLayout = (UINT32)VertexLayout::Position;
+					currentIndex += indexCount;
+				}
 
-			size_t numVertices = mesh->positions.size();
-			bool hasColors = mesh->colors.size() == numVertices;
-			bool hasNormals = mesh->normals.size() == numVertices;
-			bool hasBoneInfluences = mesh->boneInfluences.size() == numVertices;
+				UINT32 vertexLayout = (UINT32)VertexLayout::Position;
 
-			if (hasColors)
-				vertexLayout |= (UINT32)VertexLayout::Color;
+				size_t numVertices = mesh->positions.size();
+				bool hasColors = mesh->colors.size() == numVertices;
+				bool hasNormals = mesh->normals.size() == numVertices;
+				bool hasBoneInfluences = mesh->boneInfluences.size() == numVertices;
 
-			bool hasTangents = false;
-			if (hasNormals)
-			{
-				vertexLayout |= (UINT32)VertexLayout::Normal;
+				if (hasColors)
+					vertexLayout |= (UINT32)VertexLayout::Color;
 
-				if (mesh->tangents.size() == numVertices &&
-					mesh->bitangents.size() == numVertices)
+				bool hasTangents = false;
+				if (hasNormals)
 				{
-					vertexLayout |= (UINT32)VertexLayout::Tangent;
-					hasTangents = true;
+					vertexLayout |= (UINT32)VertexLayout::Normal;
+
+					if (mesh->tangents.size() == numVertices &&
+						mesh->bitangents.size() == numVertices)
+					{
+						vertexLayout |= (UINT32)VertexLayout::Tangent;
+						hasTangents = true;
+					}
 				}
-			}
 
-			if (hasBoneInfluences)
-				vertexLayout |= (UINT32)VertexLayout::BoneWeights;
+				if (hasBoneInfluences)
+					vertexLayout |= (UINT32)VertexLayout::BoneWeights;
 
-			for (UINT32 i = 0; i < FBX_IMPORT_MAX_UV_LAYERS; i++)
-			{
-				if (mesh->UV[i].size() == numVertices)
+				for (UINT32 i = 0; i < FBX_IMPORT_MAX_UV_LAYERS; i++)
 				{
-					if (i == 0)
-						vertexLayout |= (UINT32)VertexLayout::UV0;
-					else if (i == 1)
-						vertexLayout |= (UINT32)VertexLayout::UV1;
+					if (mesh->UV[i].size() == numVertices)
+					{
+						if (i == 0)
+							vertexLayout |= (UINT32)VertexLayout::UV0;
+						else if (i == 1)
+							vertexLayout |= (UINT32)VertexLayout::UV1;
+					}
 				}
-			}
-
-			UINT32 numIndices = (UINT32)mesh->indices.size();
-			for (auto& node : mesh->referencedBy)
-			{
-				Matrix4 worldTransform = scene.globalScale * node->worldTransform * node->geomTransform;
-				Matrix4 worldTransformIT = worldTransform.inverse();
-				worldTransformIT = worldTransformIT.transpose();
 
-				SPtr<RendererMeshData> meshData = RendererMeshData::create((UINT32)numVertices, numIndices, (VertexLayout)vertexLayout);
-
-				// Copy indices
-				if(!node->flipWinding)
-					meshData->setIndices(orderedIndices, numIndices * sizeof(UINT32));
-				else
+				UINT32 numIndices = (UINT32)mesh->indices.size();
+				for (auto& node : mesh->referencedBy)
 				{
-					UINT32* flippedIndices = bs_stack_alloc<UINT32>(numIndices);
+					Matrix4 worldTransform = scene.globalScale * node->worldTransform * node->geomTransform;
+					Matrix4 worldTransformIT = worldTransform.inverse();
+					worldTransformIT = worldTransformIT.transpose();
 
-					for (UINT32 i = 0; i < numIndices; i += 3)
+					SPtr<RendererMeshData> meshData = RendererMeshData::create((UINT32)numVertices, numIndices, (VertexLayout)vertexLayout);
+
+					// Copy indices
+					if(!node->flipWinding)
+						meshData->setIndices(orderedIndices, numIndices * sizeof(UINT32));
+					else
 					{
-						flippedIndices[i + 0] = orderedIndices[i + 0];
-						flippedIndices[i + 1] = orderedIndices[i + 2];
-						flippedIndices[i + 2] = orderedIndices[i + 1];
-					}
+						UINT32* flippedIndices = bs_stack_alloc<UINT32>(numIndices);
 
-					meshData->setIndices(flippedIndices, numIndices * sizeof(UINT32));
-					bs_stack_free(flippedIndices);
-				}
+						for (UINT32 i = 0; i < numIndices; i += 3)
+						{
+							flippedIndices[i + 0] = orderedIndices[i + 0];
+							flippedIndices[i + 1] = orderedIndices[i + 2];
+							flippedIndices[i + 2] = orderedIndices[i + 1];
+						}
 
-				// Copy & transform positions
-				UINT32 positionsSize = sizeof(Vector3) * (UINT32)numVertices;
-				Vector3* transformedPositions = (Vector3*)bs_stack_alloc(positionsSize);
+						meshData->setIndices(flippedIndices, numIndices * sizeof(UINT32));
+						bs_stack_free(flippedIndices);
+					}
 
-				for (UINT32 i = 0; i < (UINT32)numVertices; i++)
-					transformedPositions[i] = worldTransform.multiplyAffine((Vector3)mesh->positions[i]);
+					// Copy & transform positions
+					UINT32 positionsSize = sizeof(Vector3) * (UINT32)numVertices;
+					Vector3* transformedPositions = (Vector3*)bs_stack_alloc(positionsSize);
 
-				meshData->setPositions(transformedPositions, positionsSize);
-				bs_stack_free(transformedPositions);
+					for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+						transformedPositions[i] = worldTransform.multiplyAffine((Vector3)mesh->positions[i]);
 
-				// Copy & transform normals
-				if (hasNormals)
-				{
-					UINT32 normalsSize = sizeof(Vector3) * (UINT32)numVertices;
-					Vector3* transformedNormals = (Vector3*)bs_stack_alloc(normalsSize);
+					meshData->setPositions(transformedPositions, positionsSize);
+					bs_stack_free(transformedPositions);
 
-					// Copy, convert & transform tangents & bitangents
-					if (hasTangents)
+					// Copy & transform normals
+					if (hasNormals)
 					{
-						UINT32 tangentsSize = sizeof(Vector4) * (UINT32)numVertices;
-						Vector4* transformedTangents = (Vector4*)bs_stack_alloc(tangentsSize);
+						UINT32 normalsSize = sizeof(Vector3) * (UINT32)numVertices;
+						Vector3* transformedNormals = (Vector3*)bs_stack_alloc(normalsSize);
 
-						for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+						// Copy, convert & transform tangents & bitangents
+						if (hasTangents)
 						{
-							Vector3 normal = (Vector3)mesh->normals[i];
-							normal = worldTransformIT.multiplyDirection(normal);
-							transformedNormals[i] = Vector3::normalize(normal);
+							UINT32 tangentsSize = sizeof(Vector4) * (UINT32)numVertices;
+							Vector4* transformedTangents = (Vector4*)bs_stack_alloc(tangentsSize);
+
+							for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+							{
+								Vector3 normal = (Vector3)mesh->normals[i];
+								normal = worldTransformIT.multiplyDirection(normal);
+								transformedNormals[i] = Vector3::normalize(normal);
+
+								Vector3 tangent = (Vector3)mesh->tangents[i];
+								tangent = Vector3::normalize(worldTransformIT.multiplyDirection(tangent));
 
-							Vector3 tangent = (Vector3)mesh->tangents[i];
-							tangent = Vector3::normalize(worldTransformIT.multiplyDirection(tangent));
+								Vector3 bitangent = (Vector3)mesh->bitangents[i];
+								bitangent = worldTransformIT.multiplyDirection(bitangent);
 
-							Vector3 bitangent = (Vector3)mesh->bitangents[i];
-							bitangent = worldTransformIT.multiplyDirection(bitangent);
+								Vector3 engineBitangent = Vector3::cross(normal, tangent);
+								float sign = Vector3::dot(engineBitangent, bitangent);
 
-							Vector3 engineBitangent = Vector3::cross(normal, tangent);
-							float sign = Vector3::dot(engineBitangent, bitangent);
+								transformedTangents[i] = Vector4(tangent.x, tangent.y, tangent.z, sign > 0 ? 1.0f : -1.0f);
+							}
 
-							transformedTangents[i] = Vector4(tangent.x, tangent.y, tangent.z, sign > 0 ? 1.0f : -1.0f);
+							meshData->setTangents(transformedTangents, tangentsSize);
+							bs_stack_free(transformedTangents);
+						}
+						else // Just normals
+						{
+							for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+								transformedNormals[i] = Vector3::normalize(worldTransformIT.multiplyDirection((Vector3)mesh->normals[i]));
 						}
 
-						meshData->setTangents(transformedTangents, tangentsSize);
-						bs_stack_free(transformedTangents);
+						meshData->setNormals(transformedNormals, normalsSize);
+						bs_stack_free(transformedNormals);
 					}
-					else // Just normals
+
+					// Copy colors
+					if (hasColors)
 					{
-						for (UINT32 i = 0; i < (UINT32)numVertices; i++)
-							transformedNormals[i] = Vector3::normalize(worldTransformIT.multiplyDirection((Vector3)mesh->normals[i]));
+						meshData->setColors(mesh->colors.data(), sizeof(UINT32) * (UINT32)numVertices);
 					}
 
-					meshData->setNormals(transformedNormals, normalsSize);
-					bs_stack_free(transformedNormals);
-				}
-
-				// Copy colors
-				if (hasColors)
-				{
-					meshData->setColors(mesh->colors.data(), sizeof(UINT32) * (UINT32)numVertices);
-				}
-
-				// Copy UV
-				int writeUVIDx = 0;
-				for (auto& uvLayer : mesh->UV)
-				{
-					if (uvLayer.size() == numVertices)
+					// Copy UV
+					int writeUVIDx = 0;
+					for (auto& uvLayer : mesh->UV)
 					{
-						UINT32 size = sizeof(Vector2) * (UINT32)numVertices;
-						Vector2* transformedUV = (Vector2*)bs_stack_alloc(size);
-
-						UINT32 i = 0;
-						for (auto& uv : uvLayer)
+						if (uvLayer.size() == numVertices)
 						{
-							transformedUV[i] = uv;
-							transformedUV[i].y = 1.0f - uv.y;
+							UINT32 size = sizeof(Vector2) * (UINT32)numVertices;
+							Vector2* transformedUV = (Vector2*)bs_stack_alloc(size);
 
-							i++;
-						}
+							UINT32 i = 0;
+							for (auto& uv : uvLayer)
+							{
+								transformedUV[i] = uv;
+								transformedUV[i].y = 1.0f - uv.y;
 
-						if (writeUVIDx == 0)
-							meshData->setUV0(transformedUV, size);
-						else if (writeUVIDx == 1)
-							meshData->setUV1(transformedUV, size);
+								i++;
+							}
 
-						bs_stack_free(transformedUV);
+							if (writeUVIDx == 0)
+								meshData->setUV0(transformedUV, size);
+							else if (writeUVIDx == 1)
+								meshData->setUV1(transformedUV, size);
 
-						writeUVIDx++;
+							bs_stack_free(transformedUV);
+
+							writeUVIDx++;
+						}
 					}
-				}
 
-				// Copy bone influences
-				if(hasBoneInfluences)
-				{
-					UINT32 bufferSize = sizeof(BoneWeight) * (UINT32)numVertices;
-					BoneWeight* weights = (BoneWeight*)bs_stack_alloc(bufferSize);
-					for(UINT32 i = 0; i < (UINT32)numVertices; i++)
+					// Copy bone influences
+					if(hasBoneInfluences)
 					{
-						weights[i].index0 = mesh->boneInfluences[i].indices[0] + boneIndexOffset;
-						weights[i].index1 = mesh->boneInfluences[i].indices[1] + boneIndexOffset;
-						weights[i].index2 = mesh->boneInfluences[i].indices[2] + boneIndexOffset;
-						weights[i].index3 = mesh->boneInfluences[i].indices[3] + boneIndexOffset;
-
-						weights[i].weight0 = mesh->boneInfluences[i].weights[0];
-						weights[i].weight1 = mesh->boneInfluences[i].weights[1];
-						weights[i].weight2 = mesh->boneInfluences[i].weights[2];
-						weights[i].weight3 = mesh->boneInfluences[i].weights[3];
+						UINT32 bufferSize = sizeof(BoneWeight) * (UINT32)numVertices;
+						BoneWeight* weights = (BoneWeight*)bs_stack_alloc(bufferSize);
+						for(UINT32 i = 0; i < (UINT32)numVertices; i++)
+						{
+							weights[i].index0 = mesh->boneInfluences[i].indices[0] + boneIndexOffset;
+							weights[i].index1 = mesh->boneInfluences[i].indices[1] + boneIndexOffset;
+							weights[i].index2 = mesh->boneInfluences[i].indices[2] + boneIndexOffset;
+							weights[i].index3 = mesh->boneInfluences[i].indices[3] + boneIndexOffset;
+
+							weights[i].weight0 = mesh->boneInfluences[i].weights[0];
+							weights[i].weight1 = mesh->boneInfluences[i].weights[1];
+							weights[i].weight2 = mesh->boneInfluences[i].weights[2];
+							weights[i].weight3 = mesh->boneInfluences[i].weights[3];
+						}
+
+						meshData->setBoneWeights(weights, bufferSize);
+						bs_stack_free(weights);
 					}
 
-					meshData->setBoneWeights(weights, bufferSize);
-					bs_stack_free(weights);
+					meshDataPerMesh[meshIdx].push_back(meshData->getData());
 				}
 
-				allMeshData.push_back(meshData->getData());
-				allSubMeshes.push_back(subMeshes);
+				bs_free(orderedIndices);
+				subMeshesPerMesh[meshIdx] = subMeshes;
 			}
+		});
 
-			bs_free(orderedIndices);
-
-			UINT32 numBones = (UINT32)mesh->bones.size();
-			boneIndexOffset += numBones;
+		Vector<SPtr<MeshData>> allMeshData;
+		Vector<Vector<SubMesh>> allSubMeshes;
+		for (UINT32 i = 0; i < numMeshes; i++)
+		{
+			for (auto& meshData : meshDataPerMesh[i])
+			{
+				allMeshData.push_back(meshData);
+				allSubMeshes.push_back(subMeshesPerMesh[i]);
+			}
 		}
 
 		if (allMeshData.size() > 1)
@@ -1091,6 +1149,189 @@ namespace bs
 		return nullptr;
 	}
 
+	SPtr<MeshData> FBXImporter::generateLODs(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+		const MeshImportOptions& options, Vector<SubMesh>& lodSubMeshes)
+	{
+		const UINT32 numLODs = options.getLODCount();
+		const float reduction = Math::clamp(options.getLODReduction(), 0.01f, 0.99f);
+		if (meshData == nullptr || numLODs == 0)
+			return meshData;
+
+		const UINT32 numVertices = meshData->getNumVertices();
+		const UINT32 numIndices = meshData->getNumIndices();
+
+		Vector<Vector3> positions(numVertices);
+		VertexElemIter<Vector3> positionIter = meshData->getVec3DataIter(VES_POSITION);
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			positions[i] = positionIter.getValue();
+			positionIter.moveNext();
+		}
+
+		// Each level is generated from the previous one, and the indices of all levels are stored one after another
+		Vector<UINT32> lodIndices;
+		Vector<SubMesh> prevSubMeshes = subMeshes;
+		const UINT32* srcIndices = meshData->getIndices32();
+		for (UINT32 i = 0; i < numLODs; i++)
+		{
+			for (auto& subMesh : prevSubMeshes)
+			{
+				const UINT32* prevIndices = subMesh.indexOffset < numIndices 
+					? srcIndices + subMesh.indexOffset 
+					: lodIndices.data() + (subMesh.indexOffset - numIndices);
+
+				// Copy source indices since the array they come from might be reallocated below
+				Vector<UINT32> input(prevIndices, prevIndices + subMesh.indexCount);
+
+				const auto targetNumIndices = (UINT32)(subMesh.indexCount * reduction) / 3 * 3;
+				const auto offset = (UINT32)lodIndices.size();
+
+				lodIndices.resize(offset + subMesh.indexCount);
+				const UINT32 count = MeshUtility::simplify(positions.data(), (UINT8*)input.data(), numVertices, 
+					subMesh.indexCount, targetNumIndices, (UINT8*)(lodIndices.data() + offset));
+				lodIndices.resize(offset + count);
+
+				lodSubMeshes.push_back(SubMesh(numIndices + offset, count, subMesh.drawOp));
+			}
+
+			prevSubMeshes.assign(lodSubMeshes.end() - subMeshes.size(), lodSubMeshes.end());
+		}
+
+		const auto numLODIndices = (UINT32)lodIndices.size();
+		SPtr<MeshData> output = MeshData::create(numVertices, numIndices + numLODIndices, meshData->getVertexDesc(), 
+			IT_32BIT);
+
+		UINT32* dstIndices = output->getIndices32();
+		memcpy(dstIndices, srcIndices, numIndices * sizeof(UINT32));
+		memcpy(dstIndices + numIndices, lodIndices.data(), numLODIndices * sizeof(UINT32));
+
+		const SPtr<VertexDataDesc>& vertexDesc = meshData->getVertexDesc();
+		for (UINT32 i = 0; i <= vertexDesc->getMaxStreamIdx(); i++)
+		{
+			if (!vertexDesc->hasStream(i))
+				continue;
+
+			memcpy(output->getStreamData(i), meshData->getStreamData(i), meshData->getStreamSize(i));
+		}
+
+		return output;
+	}
+
+	void FBXImporter::optimizeMesh(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+		const Vector<SubMesh>& lodSubMeshes, SPtr<MorphShapes>& morphShapes)
+	{
+		if (meshData == nullptr)
+			return;
+
+		const UINT32 numVertices = meshData->getNumVertices();
+		const UINT32 numIndices = meshData->getNumIndices();
+
+		Vector<Vector3> positions(numVertices);
+		VertexElemIter<Vector3> positionIter = meshData->getVec3DataIter(VES_POSITION);
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			positions[i] = positionIter.getValue();
+			positionIter.moveNext();
+		}
+
+		// Triangles can only be reordered within their own sub-mesh, so each sub-mesh is optimized separately
+		UINT32* indices = meshData->getIndices32();
+		auto optimizeTriangles = [&](const Vector<SubMesh>& ranges)
+		{
+			for (auto& subMesh : ranges)
+			{
+				if (subMesh.drawOp != DOT_TRIANGLE_LIST || subMesh.indexCount == 0)
+					continue;
+
+				UINT8* subMeshIndices = (UINT8*)(indices + subMesh.indexOffset);
+
+				Vector<UINT32> cacheOptimized(subMesh.indexCount);
+				MeshUtility::optimizeVertexCache(subMeshIndices, numVertices, subMesh.indexCount, 
+					(UINT8*)cacheOptimized.data());
+				MeshUtility::optimizeOverdraw(positions.data(), (UINT8*)cacheOptimized.data(), numVertices, 
+					subMesh.indexCount, subMeshIndices);
+			}
+		};
+
+		optimizeTriangles(subMeshes);
+		optimizeTriangles(lodSubMeshes);
+
+		// All levels of detail share the same vertices, so the vertex order is determined from all of their indices
+		Vector<UINT32> remap(numVertices);
+		MeshUtility::optimizeVertexFetch((UINT8*)indices, numVertices, numIndices, remap.data());
+
+		const SPtr<VertexDataDesc>& vertexDesc = meshData->getVertexDesc();
+		for (UINT32 i = 0; i <= vertexDesc->getMaxStreamIdx(); i++)
+		{
+			if (!vertexDesc->hasStream(i))
+				continue;
+
+			UINT8* streamData = meshData->getStreamData(i);
+			const UINT32 stride = vertexDesc->getVertexStride(i);
+
+			Vector<UINT8> source(streamData, streamData + meshData->getStreamSize(i));
+			for (UINT32 j = 0; j < numVertices; j++)
+				memcpy(streamData + remap[j] * stride, source.data() + j * stride, stride);
+		}
+
+		// Morph shapes reference the vertices they modify, and need to be rebuilt using the new vertex locations
+		if (morphShapes != nullptr)
+		{
+			Vector<SPtr<MorphChannel>> channels;
+			for (auto& channel : morphShapes->getChannels())
+			{
+				Vector<SPtr<MorphShape>> shapes;
+				for (auto& shape : channel->getShapes())
+				{
+					Vector<MorphVertex> vertices = shape->getVertices();
+					for (auto& vertex : vertices)
+						vertex.sourceIdx = remap[vertex.sourceIdx];
+
+					shapes.push_back(MorphShape::create(shape->getName(), shape->getWeight(), vertices));
+				}
+
+				channels.push_back(MorphChannel::create(channel->getName(), shapes));
+			}
+
+			morphShapes = MorphShapes::create(channels, morphShapes->getNumVertices());
+		}
+	}
+
+	void FBXImporter::generateMeshlets(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+		Vector<Meshlet>& meshlets)
+	{
+		if (meshData == nullptr)
+			return;
+
+		const UINT32 numVertices = meshData->getNumVertices();
+
+		Vector<Vector3> positions(numVertices);
+		VertexElemIter<Vector3> positionIter = meshData->getVec3DataIter(VES_POSITION);
+		for (UINT32 i = 0; i < numVertices; i++)
+		{
+			positions[i] = positionIter.getValue();
+			positionIter.moveNext();
+		}
+
+		// Meshlets never cross sub-mesh boundaries, and are stored in the same order as the sub-meshes
+		UINT32* indices = meshData->getIndices32();
+		for (auto& subMesh : subMeshes)
+		{
+			if (subMesh.drawOp != DOT_TRIANGLE_LIST || subMesh.indexCount == 0)
+				continue;
+
+			const auto first = (UINT32)meshlets.size();
+			MeshUtility::generateMeshlets(positions.data(), (UINT8*)(indices + subMesh.indexOffset), numVertices,
+				subMesh.indexCount, meshlets);
+
+			for (UINT32 i = first; i < (UINT32)meshlets.size(); i++)
+				meshlets[i].indexOffset += subMesh.indexOffset;
+		}
+
+		std::sort(meshlets.begin(), meshlets.end(),
+			[](const Meshlet& a, const Meshlet& b) { return a.indexOffset < b.indexOffset; });
+	}
+
 	template<class TFBX, class TNative>
 	class FBXDirectIndexer
 	{
@@ -1672,49 +1913,54 @@ namespace bs
 
 	void FBXImporter::generateMissingTangentSpace(FBXImportScene& scene, const FBXImportOptions& options)
 	{
-		for (auto& mesh : scene.meshes)
+		TaskScheduler::instance().parallelFor((UINT32)scene.meshes.size(), 1, [&](UINT32 start, UINT32 end)
 		{
-			UINT32 numVertices = (UINT32)mesh->positions.size();
-			UINT32 numIndices = (UINT32)mesh->indices.size();
-
-			if ((options.importNormals || options.importTangents) && mesh->normals.empty())
+			for (UINT32 meshIdx = start; meshIdx < end; meshIdx++)
 			{
-				mesh->normals.resize(numVertices);
+				FBXImportMesh* mesh = scene.meshes[meshIdx];
 
-				MeshUtility::calculateNormals(mesh->positions.data(), (UINT8*)mesh->indices.data(), numVertices, numIndices, mesh->normals.data());
-			}
+				UINT32 numVertices = (UINT32)mesh->positions.size();
+				UINT32 numIndices = (UINT32)mesh->indices.size();
 
-			if (options.importTangents && !mesh->UV[0].empty() && (mesh->tangents.empty() || mesh->bitangents.empty()))
-			{
-				mesh->tangents.resize(numVertices);
-				mesh->bitangents.resize(numVertices);
+				if ((options.importNormals || options.importTangents) && mesh->normals.empty())
+				{
+					mesh->normals.resize(numVertices);
 
-				MeshUtility::calculateTangents(mesh->positions.data(), mesh->normals.data(), mesh->UV[0].data(), (UINT8*)mesh->indices.data(), 
-					numVertices, numIndices, mesh->tangents.data(), mesh->bitangents.data());
-			}
+					MeshUtility::calculateNormals(mesh->positions.data(), (UINT8*)mesh->indices.data(), numVertices, numIndices, mesh->normals.data());
+				}
 
-			for (auto& shape : mesh->blendShapes)
-			{
-				for (auto& frame : shape.frames)
+				if (options.importTangents && !mesh->UV[0].empty() && (mesh->tangents.empty() || mesh->bitangents.empty()))
 				{
-					if ((options.importNormals || options.importTangents) && frame.normals.empty())
-					{
-						frame.normals.resize(numVertices);
+					mesh->tangents.resize(numVertices);
+					mesh->bitangents.resize(numVertices);
 
-						MeshUtility::calculateNormals(mesh->positions.data(), (UINT8*)mesh->indices.data(), numVertices, numIndices, frame.normals.data());
-					}
+					MeshUtility::calculateTangents(mesh->positions.data(), mesh->normals.data(), mesh->UV[0].data(), (UINT8*)mesh->indices.data(), 
+						numVertices, numIndices, mesh->tangents.data(), mesh->bitangents.data());
+				}
 
-					if (options.importTangents && !mesh->UV[0].empty() && (frame.tangents.empty() || frame.bitangents.empty()))
+				for (auto& shape : mesh->blendShapes)
+				{
+					for (auto& frame : shape.frames)
 					{
-						frame.tangents.resize(numVertices);
-						frame.bitangents.resize(numVertices);
+						if ((options.importNormals || options.importTangents) && frame.normals.empty())
+						{
+							frame.normals.resize(numVertices);
+
+							MeshUtility::calculateNormals(mesh->positions.data(), (UINT8*)mesh->indices.data(), numVertices, numIndices, frame.normals.data());
+						}
 
-						MeshUtility::calculateTangents(mesh->positions.data(), frame.normals.data(), mesh->UV[0].data(), (UINT8*)mesh->indices.data(),
-							numVertices, numIndices, frame.tangents.data(), frame.bitangents.data());
+						if (options.importTangents && !mesh->UV[0].empty() && (frame.tangents.empty() || frame.bitangents.empty()))
+						{
+							frame.tangents.resize(numVertices);
+							frame.bitangents.resize(numVertices);
+
+							MeshUtility::calculateTangents(mesh->positions.data(), frame.normals.data(), mesh->UV[0].data(), (UINT8*)mesh->indices.data(),
+								numVertices, numIndices, frame.tangents.data(), frame.bitangents.data());
+						}
 					}
 				}
 			}
-		}
+		});
 	}
 
 	void FBXImporter::importAnimations(FbxScene* scene, FBXImportOptions& importOptions, FBXImportScene& importScene)
@@ -1847,13 +2093,13 @@ namespace bs
 				boneAnim.scale = TAnimationCurve<Vector3>(keyframes);
 			}
 
-			SPtr<TAnimationCurve<Vector3>> eulerAnimation = bs_shared_ptr_new<TAnimationCurve<Vector3>>();
 			if (hasCurveValues(rotation))
 			{
 				float defaultValues[3];
 				memcpy(defaultValues, &defaultRotation, sizeof(defaultValues));
 
-				*eulerAnimation = importCurve<Vector3, 3>(rotation, defaultValues, importOptions, clip.start, clip.end);
+				boneAnim.eulerRotation = importCurve<Vector3, 3>(rotation, defaultValues, importOptions, clip.start, 
+					clip.end);
 			}
 			else
 			{
@@ -1862,18 +2108,8 @@ namespace bs
 				keyframes[0].inTangent = Vector3::ZERO;
 				keyframes[0].outTangent = Vector3::ZERO;
 
-				*eulerAnimation = TAnimationCurve<Vector3>(keyframes);
-			}
-
-			if(importOptions.reduceKeyframes)
-			{
-				boneAnim.translation = reduceKeyframes(boneAnim.translation);
-				boneAnim.scale = reduceKeyframes(boneAnim.scale);
-				*eulerAnimation = reduceKeyframes(*eulerAnimation);
+				boneAnim.eulerRotation = TAnimationCurve<Vector3>(keyframes);
 			}
-
-			boneAnim.translation = AnimationUtility::scaleCurve(boneAnim.translation, importScene.scaleFactor);
-			boneAnim.rotation = *AnimationUtility::eulerToQuaternionCurve(eulerAnimation);
 		}
 
 		if (importOptions.importBlendShapes)
@@ -1923,6 +2159,37 @@ namespace bs
 		}
 	}
 
+	void FBXImporter::convertAnimationCurves(FBXImportScene& importScene, const FBXImportOptions& importOptions)
+	{
+		Vector<FBXBoneAnimation*> boneAnimations;
+		for (auto& clip : importScene.clips)
+		{
+			for (auto& boneAnim : clip.boneAnimations)
+				boneAnimations.push_back(&boneAnim);
+		}
+
+		TaskScheduler::instance().parallelFor((UINT32)boneAnimations.size(), 8, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				FBXBoneAnimation& boneAnim = *boneAnimations[i];
+
+				SPtr<TAnimationCurve<Vector3>> eulerAnimation = 
+					bs_shared_ptr_new<TAnimationCurve<Vector3>>(std::move(boneAnim.eulerRotation));
+
+				if (importOptions.reduceKeyframes)
+				{
+					boneAnim.translation = reduceKeyframes(boneAnim.translation);
+					boneAnim.scale = reduceKeyframes(boneAnim.scale);
+					*eulerAnimation = reduceKeyframes(*eulerAnimation);
+				}
+
+				boneAnim.translation = AnimationUtility::scaleCurve(boneAnim.translation, importScene.scaleFactor);
+				boneAnim.rotation = *AnimationUtility::eulerToQuaternionCurve(eulerAnimation);
+			}
+		});
+	}
+
 	void FBXImporter::bakeTransforms(FbxScene* scene)
 	{
 		// FBX stores transforms in a more complex way than just translation-rotation-scale as used by Banshee.
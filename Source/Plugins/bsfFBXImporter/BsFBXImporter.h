@@ -31,6 +31,9 @@ namespace bs
 		/** @copydoc SpecificImporter::isMagicNumberSupported */
 		bool isMagicNumberSupported(const UINT8* magicNumPtr, UINT32 numBytes) const override;
 
+		/** @copydoc SpecificImporter::isCacheable */
+		bool isCacheable() const override { return true; }
+
 		/** @copydoc SpecificImporter::getAsyncMode */
 		ImporterAsyncMode getAsyncMode() const override { return ImporterAsyncMode::Single; }
 
@@ -102,6 +105,12 @@ namespace bs
 		void importAnimations(FbxAnimLayer* layer, FbxNode* node, FBXImportOptions& importOptions, 
 			FBXAnimationClip& clip, FBXImportScene& importScene);
 
+		/**
+		 * Reduces keyframes of all imported bone animation curves, and converts them into the engine scale and
+		 * rotation format. Curves are processed in parallel, and this should be called after the SDK has been shut down.
+		 */
+		void convertAnimationCurves(FBXImportScene& importScene, const FBXImportOptions& importOptions);
+
 		/** Bakes all FBX node transforms into standard translation-rotation-scale transform components. */
 		void bakeTransforms(FbxScene* scene);
 
@@ -140,6 +149,31 @@ namespace bs
 		SPtr<RendererMeshData> generateMeshData(const FBXImportScene& scene, const FBXImportOptions& options, 
 			Vector<SubMesh>& outputSubMeshes);
 
+		/**
+		 * Generates lower levels of detail for the provided mesh data, by simplifying each of its sub-meshes. Returns a
+		 * copy of the mesh data with the indices of the generated levels appended after the existing indices. Index 
+		 * ranges of the generated levels are output in @p lodSubMeshes, in the format expected by MESH_DESC. Returns the
+		 * original mesh data if no levels of detail were requested.
+		 */
+		SPtr<MeshData> generateLODs(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes, 
+			const MeshImportOptions& options, Vector<SubMesh>& lodSubMeshes);
+
+		/**
+		 * Reorders the triangles of each sub-mesh and level of detail for vertex cache efficiency and lower overdraw,
+		 * and then reorders the vertices in the order they are referenced. Vertex indices in the provided morph shapes
+		 * are remapped to match, by creating a new morph shapes object. Mesh data is modified in-place.
+		 */
+		void optimizeMesh(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes, 
+			const Vector<SubMesh>& lodSubMeshes, SPtr<MorphShapes>& morphShapes);
+
+		/**
+		 * Splits the triangles of each full detail sub-mesh into meshlets, reordering the triangles so each meshlet
+		 * occupies a contiguous range of indices. Generated meshlets are output in @p meshlets, in the format expected
+		 * by MESH_DESC. Mesh data is modified in-place.
+		 */
+		void generateMeshlets(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+			Vector<Meshlet>& meshlets);
+
 		/** 
 		 * Parses the scene and outputs a skeleton for the imported meshes using the imported raw data. 
 		 *
@@ -3,12 +3,14 @@
 #include "BsFMODAudioClip.h"
 #include "BsFMODAudio.h"
 #include "FileSystem/BsDataStream.h"
+#include "BsOggVorbisDecoder.h"
+#include "BsADPCMDecoder.h"
 
 namespace bs
 {
 	FMOD_RESULT F_CALLBACK pcmReadCallback(FMOD_SOUND* sound, void *data, unsigned int dataLen)
 	{
-		FMODOggDecompressorData* decompressor = nullptr;
+		FMODDecompressorData* decompressor = nullptr;
 		((FMOD::Sound*)sound)->getUserData((void**)&decompressor);
 
 		const FMODAudioClip* clip = decompressor->clip;
@@ -17,16 +19,16 @@ namespace bs
 		assert(dataLen % bytesPerSample == 0);
 		UINT32 numSamples = dataLen / bytesPerSample;
 
-		decompressor->vorbisReader.seek(decompressor->readPos);
-		UINT32 readSamples = decompressor->vorbisReader.read((UINT8*)data, numSamples);
+		decompressor->reader->seek(decompressor->readPos);
+		UINT32 readSamples = decompressor->reader->read((UINT8*)data, numSamples);
 		while(readSamples < numSamples) // Looping
 		{
-			decompressor->vorbisReader.seek(0);
+			decompressor->reader->seek(0);
 
 			UINT8* writePtr = (UINT8*)data;
 			writePtr += readSamples * bytesPerSample;
 
-			readSamples += decompressor->vorbisReader.read(writePtr, numSamples - readSamples);
+			readSamples += decompressor->reader->read(writePtr, numSamples - readSamples);
 		}
 
 		assert(readSamples == numSamples);
@@ -39,7 +41,7 @@ namespace bs
 
 	FMOD_RESULT F_CALLBACK pcmSetPosCallback(FMOD_SOUND* sound, int subsound, unsigned int position, FMOD_TIMEUNIT posType)
 	{
-		FMODOggDecompressorData* decompressor = nullptr;
+		FMODDecompressorData* decompressor = nullptr;
 		((FMOD::Sound*)sound)->getUserData((void**)&decompressor);
 
 		const FMODAudioClip* clip = decompressor->clip;
@@ -63,7 +65,7 @@ namespace bs
 		}
 
 		decompressor->readPos %= clip->getNumSamples();
-		decompressor->vorbisReader.seek(decompressor->readPos);
+		decompressor->reader->seek(decompressor->readPos);
 		return FMOD_OK;
 	}
 
@@ -112,6 +114,9 @@ namespace bs
 
 			UINT32 bufferSize = info.numSamples * (info.bitDepth / 8);
 
+			// FMOD can't parse ADPCM data, decode it and pass it on as raw PCM
+			const bool isADPCM = mDesc.format == AudioFormat::ADPCM;
+
 			FMOD_CREATESOUNDEXINFO exInfo;
 			memset(&exInfo, 0, sizeof(exInfo));
 			exInfo.cbsize = sizeof(exInfo);
@@ -124,7 +129,7 @@ namespace bs
 			else
 				flags |= FMOD_2D;
 
-			if (mDesc.format == AudioFormat::PCM)
+			if (mDesc.format == AudioFormat::PCM || isADPCM)
 			{
 				flags |= FMOD_OPENRAW;
 
@@ -152,8 +157,19 @@ namespace bs
 			}
 
 			UINT8* sampleBuffer = (UINT8*)bs_stack_alloc(bufferSize);
-			stream->seek(offset);
-			stream->read(sampleBuffer, bufferSize);
+			if (isADPCM)
+			{
+				ADPCMDecoder reader;
+				if (reader.open(stream, info, offset))
+					reader.read(sampleBuffer, info.numSamples);
+				else
+					LOGERR("Failed decompressing AudioClip stream.");
+			}
+			else
+			{
+				stream->seek(offset);
+				stream->read(sampleBuffer, bufferSize);
+			}
 
 			FMOD::System* fmod = gFMODAudio()._getFMOD();
 			if (fmod->createSound((const char*)sampleBuffer, flags, &exInfo, &mSound) != FMOD_OK)
@@ -203,6 +219,10 @@ namespace bs
 			return nullptr;
 		}
 
+		// ADPCM data is decoded by us even when streaming, as FMOD can't parse it
+		const bool decodeManually =
+			mDesc.readMode == AudioReadMode::LoadCompressed || mDesc.format == AudioFormat::ADPCM;
+
 		FMOD_MODE flags = FMOD_CREATESTREAM;
 		const char* streamData;
 
@@ -211,7 +231,43 @@ namespace bs
 		exInfo.cbsize = sizeof(exInfo);
 
 		String pathStr;
-		if (mStreamData->isFile())
+		if (decodeManually)
+		{
+			flags |= FMOD_OPENUSER;
+
+			exInfo.decodebuffersize = mDesc.frequency;
+			exInfo.pcmreadcallback = pcmReadCallback;
+			exInfo.pcmsetposcallback = pcmSetPosCallback;
+
+			AudioDataInfo info;
+			info.bitDepth = mDesc.bitDepth;
+			info.numChannels = mDesc.numChannels;
+			info.numSamples = mNumSamples;
+			info.sampleRate = mDesc.frequency;
+
+			FMODDecompressorData* decompressorData = bs_new<FMODDecompressorData>();
+			decompressorData->clip = this;
+
+			if (mDesc.format == AudioFormat::ADPCM)
+				decompressorData->reader = bs_unique_ptr<AudioDecoder>(bs_new<ADPCMDecoder>());
+			else
+				decompressorData->reader = bs_unique_ptr<AudioDecoder>(bs_new<OggVorbisDecoder>());
+
+			// Each sound reads through its own stream, so sounds of the same clip can be decoded in parallel. Memory
+			// streams reference the clip's data instead of copying it.
+			if (!decompressorData->reader->open(mStreamData->clone(false), info, mStreamOffset))
+			{
+				LOGERR("Failed decompressing AudioClip stream.");
+				bs_delete(decompressorData);
+				return nullptr;
+			}
+
+			exInfo.userdata = decompressorData;
+			exInfo.length = mNumSamples * (mDesc.bitDepth / 8);
+
+			streamData = nullptr;
+		}
+		else if (mStreamData->isFile())
 		{
 			// initialize() guarantees the data was loaded in memory if it's not streaming
 			assert(mDesc.readMode == AudioReadMode::Stream);
@@ -228,46 +284,15 @@ namespace bs
 		{
 			SPtr<MemoryDataStream> memStream = std::static_pointer_cast<MemoryDataStream>(mStreamData);
 
-			if (mDesc.readMode == AudioReadMode::Stream)
-			{
-				// Note: I could use FMOD_OPENMEMORY_POINT here to save on memory, but then the caller would need to make
-				// sure the memory is not deallocated. I'm ignoring this for now as streaming from memory should be a rare
-				// occurence (normally only in editor)
-				flags |= FMOD_OPENMEMORY;
-
-				memStream->seek(mStreamOffset);
-				streamData = (const char*)memStream->getCurrentPtr();
-
-				exInfo.length = mStreamSize;
-			}
-			else // Load compressed
-			{
-				flags |= FMOD_OPENUSER;
-
-				exInfo.decodebuffersize = mDesc.frequency;
-				exInfo.pcmreadcallback = pcmReadCallback;
-				exInfo.pcmsetposcallback = pcmSetPosCallback;
+			// Note: I could use FMOD_OPENMEMORY_POINT here to save on memory, but then the caller would need to make
+			// sure the memory is not deallocated. I'm ignoring this for now as streaming from memory should be a rare
+			// occurence (normally only in editor)
+			flags |= FMOD_OPENMEMORY;
 
-				AudioDataInfo info;
-				info.bitDepth = mDesc.bitDepth;
-				info.numChannels = mDesc.numChannels;
-				info.numSamples = mNumSamples;
-				info.sampleRate = mDesc.frequency;
+			memStream->seek(mStreamOffset);
+			streamData = (const char*)memStream->getCurrentPtr();
 
-				FMODOggDecompressorData* decompressorData = bs_new<FMODOggDecompressorData>();
-				decompressorData->clip = this;
-
-				if (!decompressorData->vorbisReader.open(memStream, info, mStreamOffset))
-				{
-					LOGERR("Failed decompressing AudioClip stream.");
-					return nullptr;
-				}
-
-				exInfo.userdata = decompressorData;
-				exInfo.length = mNumSamples * (mDesc.bitDepth / 8);
-
-				streamData = nullptr;
-			}
+			exInfo.length = mStreamSize;
 		}
 
 		if (is3D())
@@ -275,7 +300,7 @@ namespace bs
 		else
 			flags |= FMOD_2D;
 
-		if (mDesc.format == AudioFormat::PCM || mDesc.readMode == AudioReadMode::LoadCompressed)
+		if (mDesc.format == AudioFormat::PCM || decodeManually)
 		{
 			switch (mDesc.bitDepth)
 			{
@@ -299,7 +324,7 @@ namespace bs
 			exInfo.numchannels = mDesc.numChannels;
 			exInfo.defaultfrequency = mDesc.frequency;
 
-			if(mDesc.readMode != AudioReadMode::LoadCompressed)
+			if(!decodeManually)
 				flags |= FMOD_OPENRAW;
 		}
 
@@ -317,7 +342,7 @@ namespace bs
 
 	void FMODAudioClip::releaseStreamingSound(FMOD::Sound* sound)
 	{
-		FMODOggDecompressorData* decompressorData = nullptr;
+		FMODDecompressorData* decompressorData = nullptr;
 		((FMOD::Sound*)sound)->getUserData((void**)&decompressorData);
 
 		if (decompressorData != nullptr)
@@ -337,6 +362,6 @@ namespace bs
 	bool FMODAudioClip::requiresStreaming() const
 	{
 		return mDesc.readMode == AudioReadMode::Stream || 
-			(mDesc.readMode == AudioReadMode::LoadCompressed && mDesc.format == AudioFormat::VORBIS);
+			(mDesc.readMode == AudioReadMode::LoadCompressed && mDesc.format != AudioFormat::PCM);
 	}
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 #include "BsFMODPrerequisites.h"
 #include "Audio/BsAudioClip.h"
-#include "BsOggVorbisDecoder.h"
+#include "BsAudioDecoder.h"
 #include <fmod.hpp>
 
 namespace bs
@@ -13,11 +13,11 @@ namespace bs
 	 *  @{
 	 */
 	
-	/** Contains data used for decompressing an Ogg Vorbis stream. */
-	struct FMODOggDecompressorData
+	/** Contains data used for decompressing an Ogg Vorbis or ADPCM stream. */
+	struct FMODDecompressorData
 	{
 		UINT32 readPos = 0;
-		OggVorbisDecoder vorbisReader;
+		UPtr<AudioDecoder> reader = UPtr<AudioDecoder>(nullptr, nullptr);
 		const FMODAudioClip* clip = nullptr;
 	};
 
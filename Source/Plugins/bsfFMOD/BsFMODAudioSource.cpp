@@ -3,9 +3,20 @@
 #include "BsFMODAudioSource.h"
 #include "BsFMODAudio.h"
 #include "BsFMODAudioClip.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
+	/**
+	 * Converts AudioSource priority, where higher values are more important and 0 is the default, into FMOD channel
+	 * priority, where 0 is the most important and 128 is the default. FMOD virtualizes channels in this order once it
+	 * runs out of real voices.
+	 */
+	INT32 toFMODPriority(INT32 priority)
+	{
+		return Math::clamp(128 - priority, 0, 256);
+	}
+
 	FMODAudioSource::FMODAudioSource()
 	{
 		gFMODAudio()._registerSource(this);
@@ -82,7 +93,7 @@ namespace bs
 		AudioSource::setPriority(priority);
 
 		if (mChannel != nullptr)
-			mChannel->setPriority(priority);
+			mChannel->setPriority(toFMODPriority(priority));
 	}
 
 	void FMODAudioSource::play()
@@ -130,7 +141,7 @@ namespace bs
 			mChannel->setVolume(mVolume);
 			mChannel->setPitch(mVolume);
 			mChannel->setMode(mLoop ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF);
-			mChannel->setPriority(mPriority);
+			mChannel->setPriority(toFMODPriority(mPriority));
 			mChannel->setPosition((UINT32)(mTime * 1000.0f), FMOD_TIMEUNIT_MS);
 
 			Vector3 position = getTransform().getPosition();
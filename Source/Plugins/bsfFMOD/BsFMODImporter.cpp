@@ -7,6 +7,7 @@
 #include "Audio/BsAudioUtility.h"
 #include "BsFMODAudio.h"
 #include "BsOggVorbisEncoder.h"
+#include "BsADPCMEncoder.h"
 
 #include <fmod.hpp>
 
@@ -50,7 +51,7 @@ namespace bs
 
 		FMOD::Sound* sound;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 
 			String pathStr = filePath.toString();
 			if (gFMODAudio()._getFMOD()->createSound(pathStr.c_str(), FMOD_CREATESAMPLE, nullptr, &sound) != FMOD_OK)
@@ -136,15 +137,16 @@ namespace bs
 			bufferSize = monoBufferSize;
 		}
 
-		// Convert bit depth if needed
-		if (clipIO->getBitDepth() != info.bitDepth)
+		// Convert bit depth if needed, ADPCM is always encoded from 16-bit samples
+		const UINT32 bitDepth = clipIO->getFormat() == AudioFormat::ADPCM ? 16 : clipIO->getBitDepth();
+		if (bitDepth != info.bitDepth)
 		{
-			UINT32 outBufferSize = info.numSamples * (clipIO->getBitDepth() / 8);
+			UINT32 outBufferSize = info.numSamples * (bitDepth / 8);
 			UINT8* outBuffer = (UINT8*)bs_alloc(outBufferSize);
 
-			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, clipIO->getBitDepth(), info.numSamples);
+			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, bitDepth, info.numSamples);
 
-			info.bitDepth = clipIO->getBitDepth();
+			info.bitDepth = bitDepth;
 
 			bs_free(sampleBuffer);
 
@@ -163,6 +165,14 @@ namespace bs
 			bs_free(sampleBuffer);
 			sampleBuffer = encodedSamples;
 		}
+		// Encode to ADPCM if needed
+		else if (clipIO->getFormat() == AudioFormat::ADPCM)
+		{
+			UINT8* encodedSamples = ADPCMEncoder::PCMToADPCM(sampleBuffer, info, bufferSize);
+
+			bs_free(sampleBuffer);
+			sampleBuffer = encodedSamples;
+		}
 
 		SPtr<MemoryDataStream> sampleStream = bs_shared_ptr_new<MemoryDataStream>(sampleBuffer, bufferSize);
 
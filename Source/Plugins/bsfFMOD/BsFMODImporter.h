@@ -24,6 +24,9 @@ namespace bs
 		/** @copydoc SpecificImporter::isMagicNumberSupported */
 		bool isMagicNumberSupported(const UINT8* magicNumPtr, UINT32 numBytes) const override;
 
+		/** @copydoc SpecificImporter::isCacheable */
+		bool isCacheable() const override { return true; }
+
 		/** @copydoc SpecificImporter::import */
 		SPtr<Resource> import(const Path& filePath, SPtr<const ImportOptions> importOptions) override;
 
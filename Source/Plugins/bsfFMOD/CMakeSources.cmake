@@ -8,6 +8,8 @@ set(BS_FMOD_INC_NOFILTER
 	"../bsfOpenAudio/BsOggVorbisEncoder.h"
 	"../bsfOpenAudio/BsAudioDecoder.h"
 	"../bsfOpenAudio/BsOggVorbisDecoder.h"
+	"../bsfOpenAudio/BsADPCMDecoder.h"
+	"../bsfOpenAudio/BsADPCMEncoder.h"
 )
 
 set(BS_FMOD_SRC_NOFILTER
@@ -19,6 +21,8 @@ set(BS_FMOD_SRC_NOFILTER
 	"BsFMODAudioClip.cpp"
 	"../bsfOpenAudio/BsOggVorbisEncoder.cpp"
 	"../bsfOpenAudio/BsOggVorbisDecoder.cpp"
+	"../bsfOpenAudio/BsADPCMDecoder.cpp"
+	"../bsfOpenAudio/BsADPCMEncoder.cpp"
 )
 
 if(WIN32)
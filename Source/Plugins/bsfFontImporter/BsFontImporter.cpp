@@ -1,10 +1,12 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsFontImporter.h"
+#include "BsFreeTypeRasterizer.h"
 #include "Text/BsFontImportOptions.h"
 #include "Image/BsPixelData.h"
 #include "Image/BsTexture.h"
 #include "Image/BsTextureAtlasLayout.h"
+#include "Math/BsMath.h"
 #include "BsCoreApplication.h"
 #include "CoreThread/BsCoreThread.h"
 
@@ -17,6 +19,55 @@ using namespace std::placeholders;
 
 namespace bs
 {
+	/** 
+	 * Generates a signed distance field from an 8-bit glyph coverage bitmap, and writes it into both channels of a
+	 * two channel 8-bit output. Output is larger than the input by @p spread pixels on each side. Distances are
+	 * normalized so the character edge maps to the middle of the range, and the values saturate at @p spread pixels.
+	 */
+	static void generateDistanceField(const UINT8* coverage, INT32 width, INT32 height, INT32 pitch, INT32 spread,
+		UINT8* output, UINT32 outputPitch)
+	{
+		const auto isInside = [&](INT32 x, INT32 y)
+		{
+			if(x < 0 || y < 0 || x >= width || y >= height)
+				return false;
+
+			return coverage[y * pitch + x] >= 128;
+		};
+
+		for(INT32 y = -spread; y < height + spread; y++)
+		{
+			UINT8* dst = output + (y + spread) * outputPitch;
+			for(INT32 x = -spread; x < width + spread; x++)
+			{
+				const bool inside = isInside(x, y);
+
+				// Brute force search for the nearest pixel on the other side of the edge, limited to the spread
+				INT32 minDistSqrd = (spread + 1) * (spread + 1);
+				for(INT32 offsetY = -spread; offsetY <= spread; offsetY++)
+				{
+					for(INT32 offsetX = -spread; offsetX <= spread; offsetX++)
+					{
+						const INT32 distSqrd = offsetX * offsetX + offsetY * offsetY;
+						if(distSqrd < minDistSqrd && isInside(x + offsetX, y + offsetY) != inside)
+							minDistSqrd = distSqrd;
+					}
+				}
+
+				// Edge lies halfway between the pixel centers
+				float distance = std::sqrt((float)minDistSqrd) - 0.5f;
+				if(!inside)
+					distance = -distance;
+
+				const float value = Math::clamp01(0.5f + distance / (2.0f * spread));
+				const UINT8 dstValue = (UINT8)Math::roundToInt(value * 255.0f);
+
+				dst[(x + spread) * 2 + 0] = dstValue;
+				dst[(x + spread) * 2 + 1] = dstValue;
+			}
+		}
+	}
+
 	FontImporter::FontImporter()
 		:SpecificImporter() 
 	{
@@ -46,6 +97,8 @@ namespace bs
 	SPtr<Resource> FontImporter::import(const Path& filePath, SPtr<const ImportOptions> importOptions)
 	{
 		const FontImportOptions* fontImportOptions = static_cast<const FontImportOptions*>(importOptions.get());
+		if(fontImportOptions->getDynamic())
+			return importDynamic(filePath, *fontImportOptions);
 
 		FT_Library library;
 
@@ -56,7 +109,7 @@ namespace bs
 		FT_Face face;
 
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 			error = FT_New_Face(library, filePath.toString().c_str(), 0, &face);
 		}
 
@@ -73,27 +126,18 @@ namespace bs
 		Vector<UINT32> fontSizes = fontImportOptions->getFontSizes();
 		UINT32 dpi = fontImportOptions->getDPI();
 
-		FT_Int32 loadFlags;
-		switch (fontImportOptions->getRenderMode())
+		FT_Int32 loadFlags = getFreeTypeLoadFlags(fontImportOptions->getRenderMode());
+		FT_Render_Mode renderMode = FT_LOAD_TARGET_MODE(loadFlags);
+		const bool distanceField = fontImportOptions->getRenderMode() == FontRenderMode::DistanceField;
+
+		// Distance field characters are padded so the distance can be encoded outside of the character edges
+		const auto getPadding = [distanceField](const FT_Bitmap& bitmap)
 		{
-		case FontRenderMode::Smooth:
-			loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
-			break;
-		case FontRenderMode::Raster:
-			loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_HINTING;
-			break;
-		case FontRenderMode::HintedSmooth:
-			loadFlags = FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_AUTOHINT;
-			break;
-		case FontRenderMode::HintedRaster:
-			loadFlags = FT_LOAD_TARGET_MONO | FT_LOAD_NO_AUTOHINT;
-			break;
-		default:
-			loadFlags = FT_LOAD_TARGET_NORMAL;
-			break;
-		}
+			if(!distanceField || bitmap.width == 0 || bitmap.rows == 0)
+				return 0;
 
-		FT_Render_Mode renderMode = FT_LOAD_TARGET_MODE(loadFlags);
+			return DISTANCE_FIELD_SPREAD;
+		};
 
 		Vector<SPtr<FontBitmap>> dataPerSize;
 		for(size_t i = 0; i < fontSizes.size(); i++)
@@ -139,10 +183,11 @@ namespace bs
 						BS_EXCEPT(InternalErrorException, "Failed to render a character");
 
 					FT_GlyphSlot slot = face->glyph;
+					const INT32 padding = getPadding(slot->bitmap);
 
 					TextureAtlasUtility::Element atlasElement;
-					atlasElement.input.width = slot->bitmap.width;
-					atlasElement.input.height = slot->bitmap.rows;
+					atlasElement.input.width = slot->bitmap.width + padding * 2;
+					atlasElement.input.height = slot->bitmap.rows + padding * 2;
 
 					atlasElements.push_back(atlasElement);
 					seqIdxToCharIdx[(UINT32)atlasElements.size() - 1] = charIdx;
@@ -162,10 +207,11 @@ namespace bs
 					BS_EXCEPT(InternalErrorException, "Failed to render a character");
 
 				FT_GlyphSlot slot = face->glyph;
+				const INT32 padding = getPadding(slot->bitmap);
 
 				TextureAtlasUtility::Element atlasElement;
-				atlasElement.input.width = slot->bitmap.width;
-				atlasElement.input.height = slot->bitmap.rows;
+				atlasElement.input.width = slot->bitmap.width + padding * 2;
+				atlasElement.input.height = slot->bitmap.rows + padding * 2;
 
 				atlasElements.push_back(atlasElement);
 			}
@@ -228,40 +274,17 @@ namespace bs
 
 					UINT8* sourceBuffer = slot->bitmap.buffer;
 					UINT8* dstBuffer = pixelBuffer + (curElement.output.y * pageIter->width * 2) + curElement.output.x * 2;
+					const INT32 padding = getPadding(slot->bitmap);
 
-					if(slot->bitmap.pixel_mode == ft_pixel_mode_grays)
-					{
-						for(INT32 bitmapRow = 0; bitmapRow < slot->bitmap.rows; bitmapRow++)
-						{
-							for(INT32 bitmapColumn = 0; bitmapColumn < slot->bitmap.width; bitmapColumn++)
-							{
-								dstBuffer[bitmapColumn * 2 + 0] = sourceBuffer[bitmapColumn];
-								dstBuffer[bitmapColumn * 2 + 1] = sourceBuffer[bitmapColumn];
-							}
-
-							dstBuffer += pageIter->width * 2;
-							sourceBuffer += slot->bitmap.pitch;
-						}
-					}
-					else if(slot->bitmap.pixel_mode == ft_pixel_mode_mono)
+					if(padding > 0)
 					{
-						// 8 pixels are packed into a byte, so do some unpacking
-						for(INT32 bitmapRow = 0; bitmapRow < slot->bitmap.rows; bitmapRow++)
-						{
-							for(INT32 bitmapColumn = 0; bitmapColumn < slot->bitmap.width; bitmapColumn++)
-							{
-								UINT8 srcValue = sourceBuffer[bitmapColumn >> 3];
-								UINT8 dstValue = (srcValue & (128 >> (bitmapColumn & 7))) != 0 ? 255 : 0;
+						if(slot->bitmap.pixel_mode != ft_pixel_mode_grays)
+							BS_EXCEPT(InternalErrorException, "Unsupported pixel mode for a distance field font.");
 
-								dstBuffer[bitmapColumn * 2 + 0] = dstValue;
-								dstBuffer[bitmapColumn * 2 + 1] = dstValue;
-							}
-
-							dstBuffer += pageIter->width * 2;
-							sourceBuffer += slot->bitmap.pitch;
-						}
+						generateDistanceField(sourceBuffer, slot->bitmap.width, slot->bitmap.rows, slot->bitmap.pitch,
+							padding, dstBuffer, pageIter->width * 2);
 					}
-					else
+					else if(!copyFreeTypeBitmap(slot->bitmap, dstBuffer, 2, pageIter->width * 2))
 						BS_EXCEPT(InternalErrorException, "Unsupported pixel mode for a FreeType bitmap.");
 
 					// Store character information
@@ -278,13 +301,13 @@ namespace bs
 					charDesc.uvHeight = invTexHeight * curElement.input.height;
 					charDesc.uvX = invTexWidth * curElement.output.x;
 					charDesc.uvY = invTexHeight * curElement.output.y;
-					charDesc.xOffset = slot->bitmap_left;
-					charDesc.yOffset = slot->bitmap_top;
+					charDesc.xOffset = slot->bitmap_left - padding;
+					charDesc.yOffset = slot->bitmap_top + padding;
 					charDesc.xAdvance = slot->advance.x >> 6;
 					charDesc.yAdvance = slot->advance.y >> 6;
 
 					baselineOffset = std::max(baselineOffset, (INT32)(slot->metrics.horiBearingY >> 6));
-					lineHeight = std::max(lineHeight, charDesc.height);
+					lineHeight = std::max(lineHeight, (UINT32)slot->bitmap.rows);
 
 					// Load kerning and store char
 					if(!isMissingGlypth)
@@ -349,6 +372,7 @@ namespace bs
 			}
 
 			fontData->size = fontSizes[i];
+			fontData->distanceField = distanceField;
 			fontData->baselineOffset = baselineOffset;
 			fontData->lineHeight = lineHeight;
 
@@ -372,4 +396,36 @@ namespace bs
 
 		return newFont;
 	}
+
+	SPtr<Resource> FontImporter::importDynamic(const Path& filePath, const FontImportOptions& importOptions)
+	{
+		DYNAMIC_FONT_DESC desc;
+		desc.renderMode = importOptions.getRenderMode();
+		desc.dpi = importOptions.getDPI();
+		desc.pageSize = importOptions.getDynamicPageSize();
+		desc.maxPages = importOptions.getDynamicMaxPages();
+
+		// Dynamic fonts are rasterized at the exact size they are used at, so distance fields provide no benefit
+		if(desc.renderMode == FontRenderMode::DistanceField)
+		{
+			LOGWRN("Distance field render mode is not supported by dynamic fonts. Using smooth rendering instead.");
+			desc.renderMode = FontRenderMode::Smooth;
+		}
+
+		SPtr<Font> newFont;
+		{
+			FileLock fileLock = FileScheduler::getLock(filePath);
+
+			SPtr<DataStream> fileData = FileSystem::openFile(filePath);
+			if(fileData == nullptr)
+				BS_EXCEPT(InternalErrorException, "Failed to load font file: " + filePath.toString() + ".");
+
+			newFont = Font::_createDynamicPtr(fileData, desc);
+		}
+
+		const String fileName = filePath.getFilename(false);
+		newFont->setName(fileName);
+
+		return newFont;
+	}
 }
\ No newline at end of file
@@ -31,9 +31,18 @@ namespace bs
 		/** @copydoc SpecificImporter::createImportOptions */
 		SPtr<ImportOptions> createImportOptions() const override;
 	private:
+		/** Imports the font as a dynamic font that stores the font file, and rasterizes characters at runtime. */
+		SPtr<Resource> importDynamic(const Path& filePath, const FontImportOptions& importOptions);
+
 		Vector<String> mExtensions;
 
 		const static int MAXIMUM_TEXTURE_SIZE = 2048;
+
+		/** 
+		 * Maximum distance from a character edge encoded in distance field fonts, in pixels. Characters are padded by
+		 * this amount on each side.
+		 */
+		const static int DISTANCE_FIELD_SPREAD = 4;
 	};
 
 	/** @} */
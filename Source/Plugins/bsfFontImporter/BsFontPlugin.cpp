@@ -3,6 +3,8 @@
 #include "BsFontPrerequisites.h"
 #include "Importer/BsImporter.h"
 #include "BsFontImporter.h"
+#include "BsFreeTypeRasterizer.h"
+#include "Text/BsFontManager.h"
 
 namespace bs
 {
@@ -19,6 +21,9 @@ namespace bs
 		FontImporter* importer = bs_new<FontImporter>();
 		Importer::instance()._registerAssetImporter(importer);
 
+		// Dynamic fonts rasterize their characters at runtime using the same library
+		FontManager::instance()._registerRasterizer(bs_shared_ptr_new<FreeTypeFontRasterizer>());
+
 		return nullptr;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,214 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsFreeTypeRasterizer.h"
+#include "FileSystem/BsDataStream.h"
+#include "Debug/BsDebug.h"
+
+namespace bs
+{
+	FT_Int32 getFreeTypeLoadFlags(FontRenderMode renderMode)
+	{
+		switch (renderMode)
+		{
+		case FontRenderMode::Smooth:
+			return FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
+		case FontRenderMode::Raster:
+			return FT_LOAD_TARGET_MONO | FT_LOAD_NO_HINTING;
+		case FontRenderMode::HintedSmooth:
+			return FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_AUTOHINT;
+		case FontRenderMode::HintedRaster:
+			return FT_LOAD_TARGET_MONO | FT_LOAD_NO_AUTOHINT;
+		case FontRenderMode::DistanceField:
+			// Hinting is meaningless since the characters will be scaled when rendered
+			return FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING;
+		default:
+			return FT_LOAD_TARGET_NORMAL;
+		}
+	}
+
+	bool copyFreeTypeBitmap(const FT_Bitmap& bitmap, UINT8* output, UINT32 pixelStride, UINT32 rowPitch)
+	{
+		const UINT8* sourceBuffer = bitmap.buffer;
+
+		if(bitmap.pixel_mode == ft_pixel_mode_grays)
+		{
+			for(UINT32 bitmapRow = 0; bitmapRow < bitmap.rows; bitmapRow++)
+			{
+				for(UINT32 bitmapColumn = 0; bitmapColumn < bitmap.width; bitmapColumn++)
+				{
+					for(UINT32 i = 0; i < pixelStride; i++)
+						output[bitmapColumn * pixelStride + i] = sourceBuffer[bitmapColumn];
+				}
+
+				output += rowPitch;
+				sourceBuffer += bitmap.pitch;
+			}
+		}
+		else if(bitmap.pixel_mode == ft_pixel_mode_mono)
+		{
+			// 8 pixels are packed into a byte, so do some unpacking
+			for(UINT32 bitmapRow = 0; bitmapRow < bitmap.rows; bitmapRow++)
+			{
+				for(UINT32 bitmapColumn = 0; bitmapColumn < bitmap.width; bitmapColumn++)
+				{
+					UINT8 srcValue = sourceBuffer[bitmapColumn >> 3];
+					UINT8 dstValue = (srcValue & (128 >> (bitmapColumn & 7))) != 0 ? 255 : 0;
+
+					for(UINT32 i = 0; i < pixelStride; i++)
+						output[bitmapColumn * pixelStride + i] = dstValue;
+				}
+
+				output += rowPitch;
+				sourceBuffer += bitmap.pitch;
+			}
+		}
+		else
+			return false;
+
+		return true;
+	}
+
+	FreeTypeLibrary::FreeTypeLibrary()
+	{
+		if (FT_Init_FreeType(&library))
+		{
+			LOGERR("Error occurred during FreeType library initialization.");
+			library = nullptr;
+		}
+	}
+
+	FreeTypeLibrary::~FreeTypeLibrary()
+	{
+		if (library != nullptr)
+			FT_Done_FreeType(library);
+	}
+
+	FreeTypeFontFace::FreeTypeFontFace(const SPtr<FreeTypeLibrary>& library, FT_Face face,
+		const SPtr<MemoryDataStream>& data, const DYNAMIC_FONT_DESC& desc)
+		: mLibrary(library), mData(data), mFace(face), mLoadFlags(getFreeTypeLoadFlags(desc.renderMode))
+		, mDPI(desc.dpi)
+	{ }
+
+	FreeTypeFontFace::~FreeTypeFontFace()
+	{
+		Lock lock(mLibrary->mutex);
+		FT_Done_Face(mFace);
+	}
+
+	bool FreeTypeFontFace::getMetrics(UINT32 size, INT32& baselineOffset, UINT32& lineHeight, UINT32& spaceWidth)
+	{
+		Lock lock(mMutex);
+
+		if(!setSize(size))
+			return false;
+
+		const FT_Size_Metrics& metrics = mFace->size->metrics;
+		baselineOffset = (INT32)(metrics.ascender >> 6);
+		lineHeight = (UINT32)(metrics.height >> 6);
+
+		if(FT_Load_Char(mFace, 32, mLoadFlags) == 0)
+			spaceWidth = (UINT32)(mFace->glyph->advance.x >> 6);
+		else
+			spaceWidth = (UINT32)(metrics.max_advance >> 6) / 2;
+
+		return true;
+	}
+
+	bool FreeTypeFontFace::renderChar(UINT32 charId, UINT32 size, CharDesc& desc, Vector<UINT8>& pixels)
+	{
+		Lock lock(mMutex);
+
+		if(!setSize(size))
+			return false;
+
+		// Glyph at index zero is the one fonts provide for missing characters
+		FT_UInt glyphIdx = 0;
+		if(charId != 0)
+		{
+			glyphIdx = FT_Get_Char_Index(mFace, (FT_ULong)charId);
+			if(glyphIdx == 0)
+				return false;
+		}
+
+		if(FT_Load_Glyph(mFace, glyphIdx, mLoadFlags))
+			return false;
+
+		FT_GlyphSlot slot = mFace->glyph;
+		if(FT_Render_Glyph(slot, FT_LOAD_TARGET_MODE(mLoadFlags)))
+			return false;
+
+		desc.width = slot->bitmap.width;
+		desc.height = slot->bitmap.rows;
+		desc.xOffset = slot->bitmap_left;
+		desc.yOffset = slot->bitmap_top;
+		desc.xAdvance = slot->advance.x >> 6;
+		desc.yAdvance = slot->advance.y >> 6;
+
+		pixels.resize(desc.width * desc.height);
+		if(pixels.empty())
+			return true;
+
+		if(slot->bitmap.buffer == nullptr)
+			return false;
+
+		return copyFreeTypeBitmap(slot->bitmap, pixels.data(), 1, desc.width);
+	}
+
+	bool FreeTypeFontFace::hasKerning() const
+	{
+		return FT_HAS_KERNING(mFace) != 0;
+	}
+
+	INT32 FreeTypeFontFace::getKerning(UINT32 charId, UINT32 nextCharId, UINT32 size)
+	{
+		Lock lock(mMutex);
+
+		if(!setSize(size))
+			return 0;
+
+		const FT_UInt glyphIdx = FT_Get_Char_Index(mFace, (FT_ULong)charId);
+		const FT_UInt nextGlyphIdx = FT_Get_Char_Index(mFace, (FT_ULong)nextCharId);
+
+		FT_Vector kerning;
+		if(FT_Get_Kerning(mFace, glyphIdx, nextGlyphIdx, FT_KERNING_DEFAULT, &kerning))
+			return 0;
+
+		// Y kerning is ignored because it is so rare
+		return (INT32)(kerning.x >> 6);
+	}
+
+	bool FreeTypeFontFace::setSize(UINT32 size)
+	{
+		if(size == mSize)
+			return true;
+
+		const FT_F26Dot6 ftSize = (FT_F26Dot6)(size * (1 << 6));
+		if(FT_Set_Char_Size(mFace, ftSize, 0, mDPI, mDPI))
+			return false;
+
+		mSize = size;
+		return true;
+	}
+
+	FreeTypeFontRasterizer::FreeTypeFontRasterizer()
+		: mLibrary(bs_shared_ptr_new<FreeTypeLibrary>())
+	{ }
+
+	SPtr<FontFace> FreeTypeFontRasterizer::createFace(const SPtr<MemoryDataStream>& data,
+		const DYNAMIC_FONT_DESC& desc)
+	{
+		if(mLibrary->library == nullptr || data == nullptr)
+			return nullptr;
+
+		FT_Face face;
+		{
+			Lock lock(mLibrary->mutex);
+
+			// Face references the data directly, so the face keeps a reference to the stream
+			if(FT_New_Memory_Face(mLibrary->library, data->getPtr(), (FT_Long)data->size(), 0, &face))
+				return nullptr;
+		}
+
+		return bs_shared_ptr_new<FreeTypeFontFace>(mLibrary, face, data, desc);
+	}
+}
@@ -0,0 +1,92 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsFontPrerequisites.h"
+#include "Text/BsFontManager.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+namespace bs
+{
+	/** @addtogroup Font
+	 *  @{
+	 */
+
+	/** Returns FreeType glyph load flags that render characters in the specified mode. */
+	FT_Int32 getFreeTypeLoadFlags(FontRenderMode renderMode);
+
+	/**
+	 * Converts a rendered FreeType bitmap to 8-bit coverage. Pixels of monochrome bitmaps are either fully covered or
+	 * empty.
+	 *
+	 * @param[in]	bitmap		Bitmap to convert.
+	 * @param[out]	output		Location to write the first pixel to.
+	 * @param[in]	pixelStride	Distance between two neighboring output pixels, in bytes. Coverage is written to every
+	 *							byte of the pixel.
+	 * @param[in]	rowPitch	Distance between two output rows, in bytes.
+	 * @return					False if the bitmap uses a pixel mode that cannot be converted.
+	 */
+	bool copyFreeTypeBitmap(const FT_Bitmap& bitmap, UINT8* output, UINT32 pixelStride, UINT32 rowPitch);
+
+	/** FreeType library instance, kept alive as long as any face created from it. */
+	struct FreeTypeLibrary
+	{
+		FreeTypeLibrary();
+		~FreeTypeLibrary();
+
+		FT_Library library = nullptr;
+
+		/** Serializes face creation and destruction, which FreeType doesn't allow to run in parallel. */
+		Mutex mutex;
+	};
+
+	/** Font face that rasterizes characters using FreeType. */
+	class FreeTypeFontFace : public FontFace
+	{
+	public:
+		FreeTypeFontFace(const SPtr<FreeTypeLibrary>& library, FT_Face face, const SPtr<MemoryDataStream>& data,
+			const DYNAMIC_FONT_DESC& desc);
+		~FreeTypeFontFace();
+
+		/** @copydoc FontFace::getMetrics */
+		bool getMetrics(UINT32 size, INT32& baselineOffset, UINT32& lineHeight, UINT32& spaceWidth) override;
+
+		/** @copydoc FontFace::renderChar */
+		bool renderChar(UINT32 charId, UINT32 size, CharDesc& desc, Vector<UINT8>& pixels) override;
+
+		/** @copydoc FontFace::hasKerning */
+		bool hasKerning() const override;
+
+		/** @copydoc FontFace::getKerning */
+		INT32 getKerning(UINT32 charId, UINT32 nextCharId, UINT32 size) override;
+
+	private:
+		/** Changes the size the face renders the characters at, unless it is already set. */
+		bool setSize(UINT32 size);
+
+		SPtr<FreeTypeLibrary> mLibrary;
+		SPtr<MemoryDataStream> mData;
+		FT_Face mFace;
+		FT_Int32 mLoadFlags;
+		UINT32 mDPI;
+		UINT32 mSize = 0;
+		Mutex mMutex;
+	};
+
+	/** Creates font faces of dynamic fonts using FreeType. */
+	class FreeTypeFontRasterizer : public FontRasterizer
+	{
+	public:
+		FreeTypeFontRasterizer();
+
+		/** @copydoc FontRasterizer::createFace */
+		SPtr<FontFace> createFace(const SPtr<MemoryDataStream>& data, const DYNAMIC_FONT_DESC& desc) override;
+
+	private:
+		SPtr<FreeTypeLibrary> mLibrary;
+	};
+
+	/** @} */
+}
@@ -16,6 +16,8 @@
 #include "FreeImage.h"
 #include "Utility/BsBitwise.h"
 #include "Renderer/BsRenderer.h"
+#include "Importer/BsImporter.h"
+#include "Threading/BsTaskScheduler.h"
 
 using namespace std::placeholders;
 
@@ -187,28 +189,68 @@ namespace bs
 		texDesc.hwGamma = sRGB;
 
 		SPtr<Texture> newTexture = Texture::_createPtr(texDesc);
+		newTexture->setStreaming(textureImportOptions->getStreaming());
 
-		UINT32 numFaces = (UINT32)faceData.size();
-		for (UINT32 i = 0; i < numFaces; i++)
+		// Mipmap generation and conversion (which includes compression) are performed in parallel, per face and per mip
+		// level. Progress is reported per completed face or mip level.
+		AsyncOp op = Importer::_getActiveOperation();
+		const UINT32 numFaces = (UINT32)faceData.size();
+		const UINT32 numLevels = numMips + 1;
+		const UINT32 numWorkItems = numFaces + numFaces * numLevels;
+		std::atomic<UINT32> numCompleted{0};
+
+		auto reportProgress = [&]()
+		{
+			const UINT32 completed = numCompleted.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (op != nullptr)
+				op._setProgress(completed / (float)numWorkItems);
+		};
+
+		Vector<Vector<SPtr<PixelData>>> mipLevels(numFaces);
+		TaskScheduler::instance().parallelFor(numFaces, 1, [&](UINT32 start, UINT32 end)
 		{
-			Vector<SPtr<PixelData>> mipLevels;
-			if (numMips > 0)
+			for (UINT32 i = start; i < end; i++)
 			{
-				MipMapGenOptions mipOptions;
-				mipOptions.isSRGB = sRGB;
+				if (numMips > 0)
+				{
+					MipMapGenOptions mipOptions;
+					mipOptions.isSRGB = sRGB;
 
-				mipLevels = PixelUtil::genMipmaps(*faceData[i], mipOptions);
+					mipLevels[i] = PixelUtil::genMipmaps(*faceData[i], mipOptions);
+				}
+				else
+					mipLevels[i].push_back(faceData[i]);
+
+				reportProgress();
 			}
-			else
-				mipLevels.push_back(faceData[i]);
+		});
 
-			for (UINT32 mip = 0; mip < (UINT32)mipLevels.size(); ++mip)
+		Vector<SPtr<PixelData>> dstLevels(numFaces * numLevels);
+		for (UINT32 i = 0; i < numFaces; i++)
+		{
+			for (UINT32 mip = 0; mip < numLevels; ++mip)
 			{
-				SPtr<PixelData> dst = newTexture->getProperties().allocBuffer(0, mip);
+				if (mip < (UINT32)mipLevels[i].size())
+					dstLevels[i * numLevels + mip] = newTexture->getProperties().allocBuffer(0, mip);
+			}
+		}
 
-				PixelUtil::bulkPixelConversion(*mipLevels[mip], *dst);
-				newTexture->writeData(dst, i, mip);
+		TaskScheduler::instance().parallelFor((UINT32)dstLevels.size(), 1, [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				const SPtr<PixelData>& dst = dstLevels[i];
+				if (dst)
+					PixelUtil::bulkPixelConversion(*mipLevels[i / numLevels][i % numLevels], *dst);
+
+				reportProgress();
 			}
+		});
+
+		for (UINT32 i = 0; i < (UINT32)dstLevels.size(); i++)
+		{
+			if (dstLevels[i])
+				newTexture->writeData(dstLevels[i], i / numLevels, i % numLevels);
 		}
 
 		const String fileName = filePath.getFilename(false);
@@ -222,7 +264,7 @@ namespace bs
 		UPtr<MemoryDataStream> memStream(nullptr, nullptr);
 		FREE_IMAGE_FORMAT imageFormat;
 		{
-			Lock lock = FileScheduler::getLock(filePath);
+			FileLock lock = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> fileData = FileSystem::openFile(filePath, true);
 			if (fileData->size() > std::numeric_limits<UINT32>::max())
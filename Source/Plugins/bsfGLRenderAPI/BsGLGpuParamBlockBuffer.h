@@ -21,6 +21,9 @@ namespace bs { namespace ct
 
 		/**	Returns internal OpenGL uniform buffer handle. */
 		GLuint getGLBufferId() const { return static_cast<GLHardwareBuffer*>(mBuffer)->getGLBufferId(); }
+
+		/** @copydoc GLHardwareBuffer::getGLBufferOffset */
+		UINT32 getGLBufferOffset() const { return static_cast<GLHardwareBuffer*>(mBuffer)->getGLBufferOffset(); }
 	protected:
 		/** @copydoc GpuParamBlockBuffer::initialize */
 		void initialize() override ;
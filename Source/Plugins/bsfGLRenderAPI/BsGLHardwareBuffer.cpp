@@ -10,6 +10,29 @@ namespace bs { namespace ct
 	GLHardwareBuffer::GLHardwareBuffer(GLenum target, UINT32 size, GpuBufferUsage usage)
 		: HardwareBuffer(size, usage, GDF_DEFAULT), mTarget(target)
 	{
+#if BS_OPENGL_4_4
+		const bool dynamic = (usage & GBU_DYNAMIC) != 0 && (usage & GBU_LOADSTORE) != GBU_LOADSTORE;
+		const bool ringTarget = target == GL_ARRAY_BUFFER || target == GL_ELEMENT_ARRAY_BUFFER ||
+			target == GL_UNIFORM_BUFFER;
+
+		if (dynamic && ringTarget)
+		{
+			auto& bufferManager = static_cast<GLHardwareBufferManager&>(HardwareBufferManager::instance());
+			const SPtr<GLRingBuffer>& ringBuffer = bufferManager.getDynamicRingBuffer();
+
+			// Buffers too large for the ring fall back to their own storage
+			mAllocation = ringBuffer->allocate(size);
+			if (mAllocation.bufferId != 0)
+			{
+				mRingBuffer = ringBuffer;
+				mBufferId = mAllocation.bufferId;
+				mOffset = mAllocation.offset;
+
+				return;
+			}
+		}
+#endif
+
 		glGenBuffers(1, &mBufferId);
 		BS_CHECK_GL_ERROR();
 
@@ -25,6 +48,14 @@ namespace bs { namespace ct
 
 	GLHardwareBuffer::~GLHardwareBuffer()
 	{
+#if BS_OPENGL_4_4
+		if (mRingBuffer != nullptr)
+		{
+			mRingBuffer->free(mAllocation);
+			return;
+		}
+#endif
+
 		if (mBufferId != 0)
 		{
 			glDeleteBuffers(1, &mBufferId);
@@ -39,6 +70,27 @@ namespace bs { namespace ct
 		if(mBufferId == 0)
 			return nullptr;
 
+#if BS_OPENGL_4_4
+		if (mRingBuffer != nullptr)
+		{
+			if (options == GBL_WRITE_ONLY_DISCARD)
+			{
+				// Move to a new region of the ring instead of waiting for the GPU to finish with the current one
+				const GLRingBuffer::Allocation allocation = mRingBuffer->allocate(mSize);
+				mRingBuffer->free(mAllocation);
+
+				mAllocation = allocation;
+				mBufferId = mAllocation.bufferId;
+				mOffset = mAllocation.offset;
+				mLocationVersion++;
+			}
+			else if (options != GBL_WRITE_ONLY_NO_OVERWRITE)
+				mRingBuffer->wait(mAllocation);
+
+			return mAllocation.data + offset;
+		}
+#endif
+
 		GLenum access = 0;
 
 		glBindBuffer(mTarget, mBufferId);
@@ -49,7 +101,14 @@ namespace bs { namespace ct
 			access = GL_MAP_WRITE_BIT;
 
 			if (options == GBL_WRITE_ONLY_DISCARD)
-				access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+			{
+				// Orphan the current storage, so the driver can provide new memory instead of waiting for the GPU. The
+				// new storage isn't used by the GPU yet, so no synchronization is needed when mapping it.
+				glBufferData(mTarget, mSize, nullptr, GLHardwareBufferManager::getGLUsage(mUsage));
+				BS_CHECK_GL_ERROR();
+
+				access |= GL_MAP_UNSYNCHRONIZED_BIT;
+			}
 			else if (options == GBL_WRITE_ONLY_NO_OVERWRITE)
 				access |= GL_MAP_UNSYNCHRONIZED_BIT;
 		}
@@ -81,6 +140,12 @@ namespace bs { namespace ct
 		if(mBufferId == 0)
 			return;
 
+#if BS_OPENGL_4_4
+		// Ring buffer memory stays mapped
+		if (mRingBuffer != nullptr)
+			return;
+#endif
+
 		glBindBuffer(mTarget, mBufferId);
 		BS_CHECK_GL_ERROR();
 
@@ -136,7 +201,8 @@ namespace bs { namespace ct
 			glBindBuffer(GL_COPY_WRITE_BUFFER, mBufferId);
 			BS_CHECK_GL_ERROR();
 
-			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, length);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, glSrcBuffer.getGLBufferOffset() + srcOffset,
+				mOffset + dstOffset, length);
 			BS_CHECK_GL_ERROR();
 		};
 
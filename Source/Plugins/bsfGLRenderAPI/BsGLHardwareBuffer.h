@@ -6,6 +6,7 @@
 #include "Allocators/BsPoolAlloc.h"
 #include "RenderAPI/BsVertexBuffer.h"
 #include "BsGLVertexArrayObjectManager.h"
+#include "BsGLRingBuffer.h"
 
 namespace bs { namespace ct
 {
@@ -13,7 +14,13 @@ namespace bs { namespace ct
 	 *  @{
 	 */
 
-	/** Wrapper around a generic OpenGL buffer. */
+	/**
+	 * Wrapper around a generic OpenGL buffer.
+	 *
+	 * Dynamic vertex, index and uniform buffers are sub-allocated from a persistently mapped ring buffer, when
+	 * supported. Each discard write moves such a buffer to a new region of the ring instead of waiting for the GPU, and
+	 * the data is written directly through the mapped pointer. Otherwise discard writes orphan the buffer's storage.
+	 */
 	class GLHardwareBuffer : public HardwareBuffer
 	{
 	public:
@@ -35,6 +42,18 @@ namespace bs { namespace ct
 		/**	Returns internal OpenGL buffer ID. */
 		GLuint getGLBufferId() const { return mBufferId; }
 
+		/**
+		 * Returns the offset of this buffer's data in the OpenGL buffer returned by getGLBufferId(), in bytes. Must be
+		 * applied whenever the buffer is bound. Both the OpenGL buffer and the offset can change on discard writes.
+		 */
+		UINT32 getGLBufferOffset() const { return mOffset; }
+
+		/**
+		 * Returns a value that changes whenever the buffer's data moves to a different OpenGL buffer or offset. Allows
+		 * objects referencing the buffer's location to detect when they need to be rebuilt.
+		 */
+		UINT32 getLocationVersion() const { return mLocationVersion; }
+
 	private:
 		/** @copydoc HardwareBuffer::map */
 		void* map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx) override;
@@ -44,8 +63,15 @@ namespace bs { namespace ct
 
 		GLenum mTarget;
 		GLuint mBufferId = 0;
+		UINT32 mOffset = 0;
+		UINT32 mLocationVersion = 0;
 
 		bool mZeroLocked = false;
+
+#if BS_OPENGL_4_4
+		SPtr<GLRingBuffer> mRingBuffer;
+		GLRingBuffer::Allocation mAllocation;
+#endif
 	};
 
 	/** @} */
@@ -11,6 +11,19 @@
 
 namespace bs { namespace ct
 {
+	GLHardwareBufferManager::GLHardwareBufferManager()
+	{
+#if BS_OPENGL_4_4
+		// Uniform buffers have the strictest alignment requirements of all the buffers bound from the ring
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		BS_CHECK_GL_ERROR();
+
+		mDynamicRingBuffer = bs_shared_ptr_new<GLRingBuffer>(DYNAMIC_RING_BUFFER_SIZE, (UINT32)std::max(alignment, 16),
+			DYNAMIC_RING_BUFFER_MAX_IDLE);
+#endif
+	}
+
 	SPtr<VertexBuffer> GLHardwareBufferManager::createVertexBufferInternal(const VERTEX_BUFFER_DESC& desc, 
 		GpuDeviceFlags deviceMask)
 	{
@@ -90,6 +103,9 @@ namespace bs { namespace ct
 			case VET_FLOAT3:
 			case VET_FLOAT4:
 				return GL_FLOAT;
+			case VET_HALF2:
+			case VET_HALF4:
+				return GL_HALF_FLOAT;
 			case VET_SHORT1:
 			case VET_SHORT2:
 			case VET_SHORT4:
@@ -4,6 +4,7 @@
 
 #include "BsGLPrerequisites.h"
 #include "Managers/BsHardwareBufferManager.h"
+#include "BsGLRingBuffer.h"
 
 namespace bs { namespace ct
 {
@@ -15,6 +16,16 @@ namespace bs { namespace ct
 	class GLHardwareBufferManager : public HardwareBufferManager
 	{
 	public:
+		GLHardwareBufferManager();
+
+#if BS_OPENGL_4_4
+		/**
+		 * Returns the ring buffer that dynamic vertex, index and uniform buffers are sub-allocated from. Buffers keep a
+		 * reference to the ring buffer, since they can be destroyed after the manager.
+		 */
+		const SPtr<GLRingBuffer>& getDynamicRingBuffer() const { return mDynamicRingBuffer; }
+#endif
+
 		/**	Converts engine buffer usage flags into OpenGL specific flags. */
 		static GLenum getGLUsage(GpuBufferUsage usage);
 
@@ -41,6 +52,16 @@ namespace bs { namespace ct
 		/** @copydoc HardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC&, SPtr<HardwareBuffer>) */
 		SPtr<GpuBuffer> createGpuBufferInternal(const GPU_BUFFER_DESC& desc, 
 			SPtr<HardwareBuffer> underlyingBuffer) override;
+
+#if BS_OPENGL_4_4
+		/** Size of a single buffer in the dynamic ring buffer, and the largest buffer that can be sub-allocated. */
+		static constexpr UINT32 DYNAMIC_RING_BUFFER_SIZE = 4 * 1024 * 1024;
+
+		/** Maximum number of unused buffers the dynamic ring buffer keeps around. */
+		static constexpr UINT32 DYNAMIC_RING_BUFFER_MAX_IDLE = 2;
+
+		SPtr<GLRingBuffer> mDynamicRingBuffer;
+#endif
 	};
 
 	/** @} */
@@ -161,6 +161,15 @@ namespace bs { namespace ct
 		mBuffer = PixelData(mWidth, mHeight, mDepth, mFormat);
 	}
 
+	GLTextureBuffer::~GLTextureBuffer()
+	{
+		if (mPackBuffer != 0)
+		{
+			glDeleteBuffers(1, &mPackBuffer);
+			BS_CHECK_GL_ERROR();
+		}
+	}
+
 	void GLTextureBuffer::upload(const PixelData& data, const PixelVolume& dest)
 	{
 		if ((mUsage & TU_DEPTHSTENCIL) != 0)
@@ -169,6 +178,8 @@ namespace bs { namespace ct
 			return;
 		}
 
+		mPackBufferValid = false;
+
 		glBindTexture(mTarget, mTextureID);
 		BS_CHECK_GL_ERROR();
 
@@ -293,7 +304,7 @@ namespace bs { namespace ct
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 		BS_CHECK_GL_ERROR();
 
-		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_Texture, data.getConsecutiveSize());
 	}
 
 	void GLTextureBuffer::download(const PixelData &data)
@@ -304,6 +315,28 @@ namespace bs { namespace ct
 			return;
 		}
 
+		// Contents were already copied into the pack buffer when the surface was last written to, so they can be read
+		// without stalling, as long as the GPU had time to complete the copy
+		if (mPackBufferValid && data.getFormat() == mFormat && data.isConsecutive())
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffer);
+			BS_CHECK_GL_ERROR();
+
+			const void* packedData = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, mSizeInBytes, GL_MAP_READ_BIT);
+			BS_CHECK_GL_ERROR();
+
+			memcpy(data.getData(), packedData, mSizeInBytes);
+
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			BS_CHECK_GL_ERROR();
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			BS_CHECK_GL_ERROR();
+
+			BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_Texture, data.getConsecutiveSize());
+			return;
+		}
+
 		glBindTexture(mTarget, mTextureID);
 		BS_CHECK_GL_ERROR();
 
@@ -375,7 +408,7 @@ namespace bs { namespace ct
 			BS_CHECK_GL_ERROR();
 		}
 
-		BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+		BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_Texture, data.getConsecutiveSize());
 	}
 
 	void GLTextureBuffer::bindToFramebuffer(GLenum attachment, UINT32 zoffset, bool allLayers)
@@ -527,5 +560,59 @@ namespace bs { namespace ct
 			}
 		}		
 #endif
+
+		if ((mUsage & TU_CPUREADABLE) != 0)
+			queueDownload();
+	}
+
+	void GLTextureBuffer::queueDownload()
+	{
+		mPackBufferValid = false;
+
+		if (PixelUtil::isCompressed(mFormat) || mMultisampleCount > 1)
+			return;
+
+		if (mPackBuffer == 0)
+		{
+			glGenBuffers(1, &mPackBuffer);
+			BS_CHECK_GL_ERROR();
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffer);
+			BS_CHECK_GL_ERROR();
+
+			glBufferData(GL_PIXEL_PACK_BUFFER, mSizeInBytes, nullptr, GL_STREAM_READ);
+			BS_CHECK_GL_ERROR();
+		}
+		else
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, mPackBuffer);
+			BS_CHECK_GL_ERROR();
+		}
+
+		glBindTexture(mTarget, mTextureID);
+		BS_CHECK_GL_ERROR();
+
+		const bool unaligned = ((mWidth * PixelUtil::getNumElemBytes(mFormat)) & 3) != 0;
+		if (unaligned)
+		{
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			BS_CHECK_GL_ERROR();
+		}
+
+		// With a pack buffer bound this only queues the copy, instead of waiting for the GPU to finish writing
+		glGetTexImage(mFaceTarget, mLevel, GLPixelUtil::getGLOriginFormat(mFormat),
+			GLPixelUtil::getGLOriginDataType(mFormat), nullptr);
+		BS_CHECK_GL_ERROR();
+
+		if (unaligned)
+		{
+			glPixelStorei(GL_PACK_ALIGNMENT, 4);
+			BS_CHECK_GL_ERROR();
+		}
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		BS_CHECK_GL_ERROR();
+
+		mPackBufferValid = true;
 	}
 }}
@@ -156,7 +156,7 @@ namespace bs { namespace ct
 		 */
 		GLTextureBuffer(GLenum target, GLuint id, GLint face, 
 			GLint level, PixelFormat format, GpuBufferUsage usage, bool hwGamma, UINT32 multisampleCount);
-		~GLTextureBuffer() = default;
+		~GLTextureBuffer();
 		
 		/** @copydoc GLPixelBuffer::bindToFramebuffer */
 		void bindToFramebuffer(GLenum attachment, UINT32 zoffset, bool allLayers) override;
@@ -181,6 +181,12 @@ namespace bs { namespace ct
 		void copyFromFramebuffer(UINT32 zoffset);
 
 	protected:
+		/**
+		 * Starts an asynchronous copy of the surface contents into a pixel pack buffer, from which download() can read
+		 * them later without waiting on the GPU. Only used for surfaces of CPU readable textures.
+		 */
+		void queueDownload();
+
 		GLenum mTarget;
 		GLenum mFaceTarget;
 		GLuint mTextureID;
@@ -188,6 +194,9 @@ namespace bs { namespace ct
 		GLint mLevel;
 		UINT32 mMultisampleCount;
 		bool mHwGamma;
+
+		GLuint mPackBuffer = 0;
+		bool mPackBufferValid = false;
 	};
 
 	/** @} */
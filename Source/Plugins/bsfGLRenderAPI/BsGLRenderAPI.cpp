@@ -140,6 +140,10 @@ namespace bs { namespace ct
 
 		QueryManager::startUp<GLQueryManager>();
 
+		// Program pipelines are the closest OpenGL equivalent to pipeline state objects
+		RenderStats::instance().setResourceCategory(RenderStatObject_PipelineObject,
+			RenderStatResourceCategory::PipelineState);
+
 		RenderAPI::initialize();
 	}
 
@@ -485,10 +489,11 @@ namespace bs { namespace ct
 						GLTexture* glTex = static_cast<GLTexture*>(texture.get());
 						GLenum newTextureType;
 						GLuint texId;
+						SPtr<TextureView> texView;
 						if (glTex != nullptr)
 						{
 #if BS_OPENGL_4_3 || BS_OPENGLES_3_1 
-							SPtr<TextureView> texView = glTex->requestView(
+							texView = glTex->requestView(
 								surface.mipLevel,
 								surface.numMipLevels,
 								surface.face,
@@ -531,7 +536,15 @@ namespace bs { namespace ct
 						glBindTexture(newTextureType, texId);
 						BS_CHECK_GL_ERROR();
 
+						// Sampler state is stored in the texture object, so it's only known if the same texture
+						// is bound
+						if (texInfo.id != texId || texInfo.type != newTextureType)
+							texInfo.samplerState = nullptr;
+
 						texInfo.type = newTextureType;
+						texInfo.id = texId;
+						texInfo.texture = texture;
+						texInfo.view = texView;
 
 						SPtr<GLSLGpuProgram> activeProgram = getActiveProgram(type);
 						if (activeProgram != nullptr)
@@ -555,13 +568,32 @@ namespace bs { namespace ct
 						if (!activateGLTextureUnit(unit))
 							continue;
 
+						TextureInfo& texInfo = mTextureInfos[unit];
+
 						// No sampler options for multisampled textures or buffers
-						bool supportsSampler = mTextureInfos[unit].type != GL_TEXTURE_2D_MULTISAMPLE &&
-							mTextureInfos[unit].type != GL_TEXTURE_2D_MULTISAMPLE_ARRAY &&
-							mTextureInfos[unit].type != GL_TEXTURE_BUFFER;
+						bool supportsSampler = texInfo.type != GL_TEXTURE_2D_MULTISAMPLE &&
+							texInfo.type != GL_TEXTURE_2D_MULTISAMPLE_ARRAY &&
+							texInfo.type != GL_TEXTURE_BUFFER;
+
+						if (supportsSampler && texInfo.id != 0 && texInfo.samplerState == samplerState)
+						{
+							BS_INC_RENDER_STAT(NumRedundantStateChanges);
+							supportsSampler = false;
+						}
 
 						if (supportsSampler)
 						{
+							BS_INC_RENDER_STAT(NumStateChanges);
+
+							// Other units with the same texture bound no longer know its sampler state
+							for (UINT32 i = 0; i < mNumTextureUnits; i++)
+							{
+								if (i != unit && mTextureInfos[i].id == texInfo.id)
+									mTextureInfos[i].samplerState = nullptr;
+							}
+
+							texInfo.samplerState = samplerState;
+
 							const SamplerProperties& stateProps = samplerState->getProperties();
 
 							setTextureFiltering(unit, FT_MIN, stateProps.getTextureFiltering(FT_MIN));
@@ -606,7 +638,12 @@ namespace bs { namespace ct
 									BS_CHECK_GL_ERROR();
 								}
 
-								mTextureInfos[unit].type = GL_TEXTURE_BUFFER;
+								TextureInfo& texInfo = mTextureInfos[unit];
+								texInfo.type = GL_TEXTURE_BUFFER;
+								texInfo.id = texId;
+								texInfo.texture = nullptr;
+								texInfo.view = nullptr;
+								texInfo.samplerState = nullptr;
 
 								glBindTexture(GL_TEXTURE_BUFFER, texId);
 								BS_CHECK_GL_ERROR();
@@ -897,7 +934,8 @@ namespace bs { namespace ct
 							glUniformBlockBinding(glProgram, binding - 1, unit);
 							BS_CHECK_GL_ERROR();
 
-							glBindBufferBase(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId());
+							glBindBufferRange(GL_UNIFORM_BUFFER, unit, glParamBlockBuffer->getGLBufferId(),
+								glParamBlockBuffer->getGLBufferOffset(), glParamBlockBuffer->getSize());
 							BS_CHECK_GL_ERROR();
 						}
 					}
@@ -1200,6 +1238,7 @@ namespace bs { namespace ct
 			BS_CHECK_GL_ERROR();
 
 			GLenum indexType = (ibProps.getType() == IT_16BIT) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+			UINT64 indexOffset = indexBuffer->getGLBufferOffset() + ibProps.getIndexSize() * startIndex;
 
 			if (instanceCount <= 1)
 			{
@@ -1207,7 +1246,7 @@ namespace bs { namespace ct
 					primType,
 					indexCount,
 					indexType,
-					(GLvoid*)(UINT64)(ibProps.getIndexSize() * startIndex),
+					(GLvoid*)indexOffset,
 					vertexOffset);
 				BS_CHECK_GL_ERROR();
 			}
@@ -1217,7 +1256,7 @@ namespace bs { namespace ct
 					primType,
 					indexCount,
 					indexType,
-					(GLvoid*)(UINT64)(ibProps.getIndexSize() * startIndex),
+					(GLvoid*)indexOffset,
 					instanceCount,
 					vertexOffset);
 				BS_CHECK_GL_ERROR();
@@ -1289,6 +1328,159 @@ namespace bs { namespace ct
 		BS_INC_RENDER_STAT(NumComputeCalls);
 	}
 
+	void GLRenderAPI::drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount, UINT32 stride,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		auto executeRef = [&](const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount, UINT32 stride)
+		{
+			THROW_IF_NOT_CORE_THREAD;
+
+			GLint primType = getGLDrawMode();
+			beginDraw();
+
+			GLGpuBuffer* glArgsBuffer = static_cast<GLGpuBuffer*>(argsBuffer.get());
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, glArgsBuffer->getGLBufferId());
+			BS_CHECK_GL_ERROR();
+
+#if BS_OPENGL_4_3
+			glMultiDrawArraysIndirect(primType, (GLvoid*)(UINT64)offset, drawCount, stride);
+			BS_CHECK_GL_ERROR();
+#else
+			for (UINT32 i = 0; i < drawCount; i++)
+			{
+				glDrawArraysIndirect(primType, (GLvoid*)(UINT64)(offset + i * stride));
+				BS_CHECK_GL_ERROR();
+			}
+#endif
+
+			endDraw();
+		};
+
+		if (stride == 0)
+			stride = sizeof(DRAW_INDIRECT_ARGS);
+
+		if (commandBuffer == nullptr)
+			executeRef(argsBuffer, offset, drawCount, stride);
+		else
+		{
+			auto execute = [=]() { executeRef(argsBuffer, offset, drawCount, stride); };
+
+			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
+			cb->queueCommand(execute);
+		}
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
+
+	void GLRenderAPI::drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount,
+		UINT32 stride, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		auto executeRef = [&](const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount, UINT32 stride)
+		{
+			THROW_IF_NOT_CORE_THREAD;
+
+			if (mBoundIndexBuffer == nullptr)
+			{
+				LOGWRN("Cannot draw indexed because index buffer is not set.");
+				return;
+			}
+
+			// Indirect arguments can only reference indices relative to the start of the OpenGL buffer, so index
+			// buffers sub-allocated from a larger buffer can't be used
+			SPtr<GLIndexBuffer> indexBuffer = std::static_pointer_cast<GLIndexBuffer>(mBoundIndexBuffer);
+			if (indexBuffer->getGLBufferOffset() != 0)
+			{
+				LOGWRN("Cannot draw indexed indirect using a dynamic index buffer.");
+				return;
+			}
+
+			GLint primType = getGLDrawMode();
+			beginDraw();
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getGLBufferId());
+			BS_CHECK_GL_ERROR();
+
+			GLGpuBuffer* glArgsBuffer = static_cast<GLGpuBuffer*>(argsBuffer.get());
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, glArgsBuffer->getGLBufferId());
+			BS_CHECK_GL_ERROR();
+
+			const IndexBufferProperties& ibProps = indexBuffer->getProperties();
+			GLenum indexType = (ibProps.getType() == IT_16BIT) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+#if BS_OPENGL_4_3
+			glMultiDrawElementsIndirect(primType, indexType, (GLvoid*)(UINT64)offset, drawCount, stride);
+			BS_CHECK_GL_ERROR();
+#else
+			for (UINT32 i = 0; i < drawCount; i++)
+			{
+				glDrawElementsIndirect(primType, indexType, (GLvoid*)(UINT64)(offset + i * stride));
+				BS_CHECK_GL_ERROR();
+			}
+#endif
+
+			endDraw();
+		};
+
+		if (stride == 0)
+			stride = sizeof(DRAW_INDEXED_INDIRECT_ARGS);
+
+		if (commandBuffer == nullptr)
+			executeRef(argsBuffer, offset, drawCount, stride);
+		else
+		{
+			auto execute = [=]() { executeRef(argsBuffer, offset, drawCount, stride); };
+
+			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
+			cb->queueCommand(execute);
+		}
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+		BS_INC_RENDER_STAT(NumIndexBufferBinds);
+	}
+
+	void GLRenderAPI::dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		auto executeRef = [&](const SPtr<GpuBuffer>& argsBuffer, UINT32 offset)
+		{
+			THROW_IF_NOT_CORE_THREAD;
+
+			if (mCurrentComputeProgram == nullptr)
+			{
+				LOGWRN("Cannot dispatch compute without a set compute program.");
+				return;
+			}
+
+#if BS_OPENGL_4_3 || BS_OPENGLES_3_1
+			glUseProgram(mCurrentComputeProgram->getGLHandle());
+			BS_CHECK_GL_ERROR();
+
+			GLGpuBuffer* glArgsBuffer = static_cast<GLGpuBuffer*>(argsBuffer.get());
+			glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, glArgsBuffer->getGLBufferId());
+			BS_CHECK_GL_ERROR();
+
+			glDispatchComputeIndirect((GLintptr)offset);
+			BS_CHECK_GL_ERROR();
+
+			glMemoryBarrier(GL_ALL_BARRIER_BITS);
+#else
+			LOGWRN("Compute shaders not supported on current OpenGL version.");
+#endif
+		};
+
+		if (commandBuffer == nullptr)
+			executeRef(argsBuffer, offset);
+		else
+		{
+			auto execute = [=]() { executeRef(argsBuffer, offset); };
+
+			SPtr<GLCommandBuffer> cb = std::static_pointer_cast<GLCommandBuffer>(commandBuffer);
+			cb->queueCommand(execute);
+		}
+
+		BS_INC_RENDER_STAT(NumComputeCalls);
+	}
+
 	void GLRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom, 
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
@@ -1609,17 +1801,16 @@ namespace bs { namespace ct
 		GLint sourceBlend = getBlendMode(sourceFactor);
 		GLint destBlend = getBlendMode(destFactor);
 		if(sourceFactor == BF_ONE && destFactor == BF_ZERO)
-		{
-			glDisable(GL_BLEND);
-			BS_CHECK_GL_ERROR();
-		}
+			setCapabilityEnabled(CAP_BLEND, false);
 		else
 		{
-			glEnable(GL_BLEND);
-			BS_CHECK_GL_ERROR();
+			setCapabilityEnabled(CAP_BLEND, true);
 
-			glBlendFunc(sourceBlend, destBlend);
-			BS_CHECK_GL_ERROR();
+			if(mBlendFunc.set({ sourceBlend, destBlend, sourceBlend, destBlend }))
+			{
+				glBlendFunc(sourceBlend, destBlend);
+				BS_CHECK_GL_ERROR();
+			}
 		}
 
 		GLint func = GL_FUNC_ADD;
@@ -1642,8 +1833,11 @@ namespace bs { namespace ct
 			break;
 		}
 
-		glBlendEquation(func);
-		BS_CHECK_GL_ERROR();
+		if(mBlendEquation.set({ func, func }))
+		{
+			glBlendEquation(func);
+			BS_CHECK_GL_ERROR();
+		}
 	}
 
 	void GLRenderAPI::setSceneBlending(BlendFactor sourceFactor, BlendFactor destFactor, 
@@ -1655,17 +1849,16 @@ namespace bs { namespace ct
 		GLint destBlendAlpha = getBlendMode(destFactorAlpha);
 
 		if(sourceFactor == BF_ONE && destFactor == BF_ZERO && sourceFactorAlpha == BF_ONE && destFactorAlpha == BF_ZERO)
-		{
-			glDisable(GL_BLEND);
-			BS_CHECK_GL_ERROR();
-		}
+			setCapabilityEnabled(CAP_BLEND, false);
 		else
 		{
-			glEnable(GL_BLEND);
-			BS_CHECK_GL_ERROR();
+			setCapabilityEnabled(CAP_BLEND, true);
 
-			glBlendFuncSeparate(sourceBlend, destBlend, sourceBlendAlpha, destBlendAlpha);
-			BS_CHECK_GL_ERROR();
+			if(mBlendFunc.set({ sourceBlend, destBlend, sourceBlendAlpha, destBlendAlpha }))
+			{
+				glBlendFuncSeparate(sourceBlend, destBlend, sourceBlendAlpha, destBlendAlpha);
+				BS_CHECK_GL_ERROR();
+			}
 		}
 
 		GLint func = GL_FUNC_ADD, alphaFunc = GL_FUNC_ADD;
@@ -1708,29 +1901,16 @@ namespace bs { namespace ct
 			break;
 		}
 
-		glBlendEquationSeparate(func, alphaFunc);
-		BS_CHECK_GL_ERROR();
+		if(mBlendEquation.set({ func, alphaFunc }))
+		{
+			glBlendEquationSeparate(func, alphaFunc);
+			BS_CHECK_GL_ERROR();
+		}
 	}
 
 	void GLRenderAPI::setAlphaToCoverage(bool enable)
 	{
-		static bool lasta2c = false;
-
-		if (enable != lasta2c)
-		{
-			if (enable)
-			{
-				glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-				BS_CHECK_GL_ERROR();
-			}
-			else
-			{
-				glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-				BS_CHECK_GL_ERROR();
-			}
-
-			lasta2c = enable;
-		}
+		setCapabilityEnabled(CAP_ALPHA_TO_COVERAGE, enable);
 	}
 
 	void GLRenderAPI::setScissorTestEnable(bool enable)
@@ -1773,44 +1953,18 @@ namespace bs { namespace ct
 
 	void GLRenderAPI::setMultisamplingEnable(bool enable)
 	{
-		if (enable)
-		{
-			glEnable(GL_MULTISAMPLE);
-			BS_CHECK_GL_ERROR();
-		}
-		else
-		{
-			glDisable(GL_MULTISAMPLE);
-			BS_CHECK_GL_ERROR();
-		}
+		setCapabilityEnabled(CAP_MULTISAMPLE, enable);
 	}
 
 	void GLRenderAPI::setDepthClipEnable(bool enable)
 	{
-		if (!enable) // If clipping disabled, clamp is enabled
-		{
-			glEnable(GL_DEPTH_CLAMP);
-			BS_CHECK_GL_ERROR();
-		}
-		else
-		{
-			glDisable(GL_DEPTH_CLAMP);
-			BS_CHECK_GL_ERROR();
-		}
+		// If clipping disabled, clamp is enabled
+		setCapabilityEnabled(CAP_DEPTH_CLAMP, !enable);
 	}
 
 	void GLRenderAPI::setAntialiasedLineEnable(bool enable)
 	{
-		if (enable)
-		{
-			glEnable(GL_LINE_SMOOTH);
-			BS_CHECK_GL_ERROR();
-		}
-		else
-		{
-			glDisable(GL_LINE_SMOOTH);
-			BS_CHECK_GL_ERROR();
-		}
+		setCapabilityEnabled(CAP_LINE_SMOOTH, enable);
 	}
 
 
@@ -1821,8 +1975,7 @@ namespace bs { namespace ct
 		switch( mode )
 		{
 		case CULL_NONE:
-			glDisable(GL_CULL_FACE);
-			BS_CHECK_GL_ERROR();
+			setCapabilityEnabled(CAP_CULL_FACE, false);
 			return;
 		default:
 		case CULL_CLOCKWISE:
@@ -1833,83 +1986,70 @@ namespace bs { namespace ct
 			break;
 		}
 
-		glEnable(GL_CULL_FACE);
-		BS_CHECK_GL_ERROR();
+		setCapabilityEnabled(CAP_CULL_FACE, true);
 
-		glCullFace(cullMode);
-		BS_CHECK_GL_ERROR();
+		if(mCullFace.set(cullMode))
+		{
+			glCullFace(cullMode);
+			BS_CHECK_GL_ERROR();
+		}
 	}
 
 	void GLRenderAPI::setDepthBufferCheckEnabled(bool enabled)
 	{
-		if (enabled)
-		{
-			glClearDepth(1.0f);
-			BS_CHECK_GL_ERROR();
-
-			glEnable(GL_DEPTH_TEST);
-			BS_CHECK_GL_ERROR();
-		}
-		else
-		{
-			glDisable(GL_DEPTH_TEST);
-			BS_CHECK_GL_ERROR();
-		}
+		setCapabilityEnabled(CAP_DEPTH_TEST, enabled);
 	}
 
 	void GLRenderAPI::setDepthBufferWriteEnabled(bool enabled)
 	{
-		GLboolean flag = enabled ? GL_TRUE : GL_FALSE;
-		glDepthMask(flag);  
-		BS_CHECK_GL_ERROR();
+		if(mDepthMask.set(enabled))
+		{
+			GLboolean flag = enabled ? GL_TRUE : GL_FALSE;
+			glDepthMask(flag);
+			BS_CHECK_GL_ERROR();
+		}
 
 		mDepthWrite = enabled;
 	}
 
 	void GLRenderAPI::setDepthBufferFunction(CompareFunction func)
 	{
-		glDepthFunc(convertCompareFunction(func));
-		BS_CHECK_GL_ERROR();
+		const GLint glFunc = convertCompareFunction(func);
+		if(mDepthFunc.set(glFunc))
+		{
+			glDepthFunc(glFunc);
+			BS_CHECK_GL_ERROR();
+		}
 	}
 
 	void GLRenderAPI::setDepthBias(float constantBias, float slopeScaleBias)
 	{
 		if (constantBias != 0 || slopeScaleBias != 0)
 		{
-			glEnable(GL_POLYGON_OFFSET_FILL);
-			BS_CHECK_GL_ERROR();
-
-			glEnable(GL_POLYGON_OFFSET_POINT);
-			BS_CHECK_GL_ERROR();
-
-			glEnable(GL_POLYGON_OFFSET_LINE);
-			BS_CHECK_GL_ERROR();
+			setCapabilityEnabled(CAP_POLYGON_OFFSET, true);
 
 			float scaledConstantBias = -constantBias * float((1 << 24) - 1); // Note: Assumes 24-bit depth buffer
-			glPolygonOffset(slopeScaleBias, scaledConstantBias);
-			BS_CHECK_GL_ERROR();
+			if(mPolygonOffset.set({ slopeScaleBias, scaledConstantBias }))
+			{
+				glPolygonOffset(slopeScaleBias, scaledConstantBias);
+				BS_CHECK_GL_ERROR();
+			}
 		}
 		else
-		{
-			glDisable(GL_POLYGON_OFFSET_FILL);
-			BS_CHECK_GL_ERROR();
-
-			glDisable(GL_POLYGON_OFFSET_POINT);
-			BS_CHECK_GL_ERROR();
-
-			glDisable(GL_POLYGON_OFFSET_LINE);
-			BS_CHECK_GL_ERROR();
-		}
+			setCapabilityEnabled(CAP_POLYGON_OFFSET, false);
 	}
 
 	void GLRenderAPI::setColorBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
 	{
-		glColorMask(red, green, blue, alpha);
-		BS_CHECK_GL_ERROR();
+		if(mColorMask.set({ red, green, blue, alpha }))
+		{
+			glColorMask(red, green, blue, alpha);
+			BS_CHECK_GL_ERROR();
+		}
 
 		mColorWrite[0] = red;
-		mColorWrite[1] = blue;
-		mColorWrite[2] = green;
+		mColorWrite[1] = green;
+		mColorWrite[2] = blue;
 		mColorWrite[3] = alpha;
 	}
 
@@ -1927,45 +2067,33 @@ namespace bs { namespace ct
 			break;
 		}
 
-		glPolygonMode(GL_FRONT_AND_BACK, glmode);
-		BS_CHECK_GL_ERROR();
+		if(mPolygonMode.set(glmode))
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, glmode);
+			BS_CHECK_GL_ERROR();
+		}
 	}
 
 	void GLRenderAPI::setStencilCheckEnabled(bool enabled)
 	{
-		if (enabled)
-		{
-			glEnable(GL_STENCIL_TEST);
-			BS_CHECK_GL_ERROR();
-		}
-		else
-		{
-			glDisable(GL_STENCIL_TEST);
-			BS_CHECK_GL_ERROR();
-		}
+		setCapabilityEnabled(CAP_STENCIL_TEST, enabled);
 	}
 
 	void GLRenderAPI::setStencilBufferOperations(StencilOperation stencilFailOp,
 		StencilOperation depthFailOp, StencilOperation passOp, bool front)
 	{
-		if (front)
-		{
-			glStencilOpSeparate(
-				GL_FRONT,
-				convertStencilOp(stencilFailOp),
-				convertStencilOp(depthFailOp),
-				convertStencilOp(passOp));
-			BS_CHECK_GL_ERROR();
-		}
-		else
-		{
-			glStencilOpSeparate(
-				GL_BACK,
-				convertStencilOp(stencilFailOp),
-				convertStencilOp(depthFailOp),
-				convertStencilOp(passOp));
-			BS_CHECK_GL_ERROR();
-		}
+		const std::array<GLint, 3> ops =
+		{{
+			convertStencilOp(stencilFailOp),
+			convertStencilOp(depthFailOp),
+			convertStencilOp(passOp)
+		}};
+
+		if (!mStencilOp[front ? 0 : 1].set(ops))
+			return;
+
+		glStencilOpSeparate(front ? GL_FRONT : GL_BACK, ops[0], ops[1], ops[2]);
+		BS_CHECK_GL_ERROR();
 	}
 
 	void GLRenderAPI::setStencilBufferFunc(CompareFunction func, UINT32 mask, bool front)
@@ -1975,14 +2103,12 @@ namespace bs { namespace ct
 		if(front)
 		{
 			mStencilCompareFront = func;
-			glStencilFuncSeparate(GL_FRONT, convertCompareFunction(mStencilCompareFront), mStencilRefValue, mStencilReadMask);
-			BS_CHECK_GL_ERROR();
+			applyStencilFunc(true);
 		}
 		else
 		{
 			mStencilCompareBack = func;
-			glStencilFuncSeparate(GL_BACK, convertCompareFunction(mStencilCompareBack), mStencilRefValue, mStencilReadMask);
-			BS_CHECK_GL_ERROR();
+			applyStencilFunc(false);
 		}
 	}
 
@@ -1990,8 +2116,11 @@ namespace bs { namespace ct
 	{
 		mStencilWriteMask = mask;
 
-		glStencilMask(mask);
-		BS_CHECK_GL_ERROR();
+		if(mStencilMask.set(mask))
+		{
+			glStencilMask(mask);
+			BS_CHECK_GL_ERROR();
+		}
 	}
 
 	void GLRenderAPI::setStencilRefValue(UINT32 refValue)
@@ -2000,13 +2129,81 @@ namespace bs { namespace ct
 
 		mStencilRefValue = refValue;
 
-		glStencilFuncSeparate(GL_FRONT, convertCompareFunction(mStencilCompareFront), mStencilRefValue, mStencilReadMask);
+		applyStencilFunc(true);
+		applyStencilFunc(false);
+	}
+
+	void GLRenderAPI::applyStencilFunc(bool front)
+	{
+		const CompareFunction func = front ? mStencilCompareFront : mStencilCompareBack;
+		const std::array<GLint, 3> params = { { convertCompareFunction(func), (GLint)mStencilRefValue,
+			(GLint)mStencilReadMask } };
+
+		if(!mStencilFunc[front ? 0 : 1].set(params))
+			return;
+
+		glStencilFuncSeparate(front ? GL_FRONT : GL_BACK, params[0], params[1], (GLuint)params[2]);
 		BS_CHECK_GL_ERROR();
+	}
+
+	void GLRenderAPI::setCapabilityEnabled(CachedCapability capability, bool enabled)
+	{
+		if(!mCapabilities[capability].set(enabled))
+			return;
+
+		// Polygon offset is toggled for all primitive modes at once
+		if(capability == CAP_POLYGON_OFFSET)
+		{
+			const GLenum offsetCaps[] = { GL_POLYGON_OFFSET_FILL, GL_POLYGON_OFFSET_POINT, GL_POLYGON_OFFSET_LINE };
+			for(auto& entry : offsetCaps)
+			{
+				if(enabled)
+					glEnable(entry);
+				else
+					glDisable(entry);
+
+				BS_CHECK_GL_ERROR();
+			}
+
+			return;
+		}
+
+		static const GLenum glCaps[] =
+		{
+			GL_BLEND, GL_SAMPLE_ALPHA_TO_COVERAGE, GL_MULTISAMPLE, GL_DEPTH_CLAMP, GL_LINE_SMOOTH, GL_CULL_FACE,
+			GL_DEPTH_TEST, GL_STENCIL_TEST
+		};
+
+		if(enabled)
+			glEnable(glCaps[capability]);
+		else
+			glDisable(glCaps[capability]);
 
-		glStencilFuncSeparate(GL_BACK, convertCompareFunction(mStencilCompareBack), mStencilRefValue, mStencilReadMask);
 		BS_CHECK_GL_ERROR();
 	}
 
+	void GLRenderAPI::invalidateStateCache()
+	{
+		for(auto& entry : mCapabilities)
+			entry.invalidate();
+
+		mBlendFunc.invalidate();
+		mBlendEquation.invalidate();
+		mColorMask.invalidate();
+		mDepthMask.invalidate();
+		mDepthFunc.invalidate();
+		mCullFace.invalidate();
+		mPolygonMode.invalidate();
+		mPolygonOffset.invalidate();
+		mStencilMask.invalidate();
+
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			mStencilOp[i].invalidate();
+			mStencilFunc[i].invalidate();
+		}
+	}
+
 	void GLRenderAPI::setTextureFiltering(UINT16 unit, FilterType ftype, FilterOptions fo)
 	{
 		switch(ftype)
@@ -2144,8 +2341,7 @@ namespace bs { namespace ct
 			mBoundVertexDeclaration,
 			mBoundVertexBuffers);
 
-		glBindVertexArray(vao.getGLHandle()); 
-		BS_CHECK_GL_ERROR();
+		GLVertexArrayObjectManager::instance().bind(vao);
 
 		BS_INC_RENDER_STAT(NumVertexBufferBinds);
 	}
@@ -2416,6 +2612,12 @@ namespace bs { namespace ct
 		mCurrentContext = context;
 		mCurrentContext->setCurrent(window);
 
+		// Cached state belongs to the previous context
+		invalidateStateCache();
+
+		if (GLVertexArrayObjectManager::isStarted())
+			GLVertexArrayObjectManager::instance().resetBoundVAO();
+
 		// Must reset depth/colour write mask to according with user desired, otherwise, clearFrameBuffer would be wrong 
 		// because the value we recorded may be different from the real state stored in GL context.
 		glDepthMask(mDepthWrite);
@@ -2562,6 +2764,11 @@ namespace bs { namespace ct
 		{
 #if BS_OPENGL_4_3 || BS_OPENGLES_3_1
 			caps.setCapability(RSC_COMPUTE_PROGRAM);
+			caps.setCapability(RSC_DRAW_INDIRECT);
+#endif
+
+#if BS_OPENGL_4_3
+			caps.setCapability(RSC_MULTI_DRAW_INDIRECT);
 #endif
 
 			GLint computeUnits;
@@ -2688,7 +2895,8 @@ namespace bs { namespace ct
 		RenderAPIFeatures featureFlags =
 			RenderAPIFeatureFlag::UVYAxisUp |
 			RenderAPIFeatureFlag::ColumnMajorMatrices |
-			RenderAPIFeatureFlag::MSAAImageStores;
+			RenderAPIFeatureFlag::MSAAImageStores |
+			RenderAPIFeatureFlag::ParallelSecondaryCB;
 
 #if BS_OPENGL_4_3 || BS_OPENGLES_3_1
 		featureFlags |= RenderAPIFeatureFlag::TextureViews;
@@ -7,6 +7,7 @@
 #include "BsGLHardwareBufferManager.h"
 #include "GLSL/BsGLSLProgramFactory.h"
 #include "Math/BsMatrix4.h"
+#include "Profiling/BsRenderStats.h"
 
 namespace bs { namespace ct
 {
@@ -14,6 +15,39 @@ namespace bs { namespace ct
 	 *  @{
 	 */
 
+	/**
+	 * Value of a piece of OpenGL state, as last set by the render API. Allows redundant state changes to be skipped, as
+	 * long as the state is only changed through the cache.
+	 */
+	template<class T>
+	struct GLCachedState
+	{
+		/**
+		 * Records a new value of the state. Returns true if the value differs from the current one and needs to be
+		 * applied, or false if the change is redundant.
+		 */
+		bool set(const T& newValue)
+		{
+			if (valid && value == newValue)
+			{
+				BS_INC_RENDER_STAT(NumRedundantStateChanges);
+				return false;
+			}
+
+			value = newValue;
+			valid = true;
+
+			BS_INC_RENDER_STAT(NumStateChanges);
+			return true;
+		}
+
+		/** Marks the current value as unknown, so the next change is always applied. */
+		void invalidate() { valid = false; }
+
+		T value = T();
+		bool valid = false;
+	};
+
 	/** Implementation of a render system using OpenGL. Provides abstracted access to various low level OpenGL methods. */
 	class GLRenderAPI : public RenderAPI
 	{
@@ -73,6 +107,18 @@ namespace bs { namespace ct
 		void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1, 
 			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
 
+		/** @copydoc RenderAPI::drawIndirect */
+		void drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::drawIndexedIndirect */
+		void drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::dispatchComputeIndirect */
+		void dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
 		/** @copydoc RenderAPI::swapBuffers() */
 		void swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask = 0xFFFFFFFF) override;
 
@@ -336,6 +382,12 @@ namespace bs { namespace ct
 		 */
 		void setStencilRefValue(UINT32 refValue);
 
+		/**
+		 * Applies the current stencil compare function, reference value and read mask for either front or back facing
+		 * polygons.
+		 */
+		void applyStencilFunc(bool front);
+
 		/************************************************************************/
 		/* 							UTILITY METHODS                      		*/
 		/************************************************************************/
@@ -360,8 +412,40 @@ namespace bs { namespace ct
 		struct TextureInfo
 		{
 			GLenum type = GL_TEXTURE_2D;
+			GLuint id = 0;
+
+			/** Keeps the bound texture and view alive, so their OpenGL IDs can't get reused while cached here. */
+			SPtr<Texture> texture;
+			SPtr<TextureView> view;
+
+			/** Sampler state last applied to the bound texture through this unit, if still valid. */
+			SPtr<SamplerState> samplerState;
+		};
+
+		/** OpenGL capabilities whose enabled state is cached. */
+		enum CachedCapability
+		{
+			CAP_BLEND,
+			CAP_ALPHA_TO_COVERAGE,
+			CAP_MULTISAMPLE,
+			CAP_DEPTH_CLAMP,
+			CAP_LINE_SMOOTH,
+			CAP_CULL_FACE,
+			CAP_DEPTH_TEST,
+			CAP_STENCIL_TEST,
+			CAP_POLYGON_OFFSET,
+			CAP_COUNT
 		};
 
+		/** Enables or disables an OpenGL capability, unless it is already in the requested state. */
+		void setCapabilityEnabled(CachedCapability capability, bool enabled);
+
+		/**
+		 * Marks all the cached OpenGL state as unknown. Must be called whenever the state might have changed without
+		 * going through the cache, such as when switching contexts.
+		 */
+		void invalidateStateCache();
+
 		static const UINT32 MAX_VB_COUNT = 32;
 
 		Rect2 mViewportNorm;
@@ -385,6 +469,20 @@ namespace bs { namespace ct
 		bool mDepthWrite;
 		bool mColorWrite[4];
 
+		// Shadow copy of the OpenGL state, used for skipping redundant state changes
+		GLCachedState<bool> mCapabilities[CAP_COUNT];
+		GLCachedState<std::array<GLint, 4>> mBlendFunc;
+		GLCachedState<std::array<GLint, 2>> mBlendEquation;
+		GLCachedState<std::array<bool, 4>> mColorMask;
+		GLCachedState<bool> mDepthMask;
+		GLCachedState<GLint> mDepthFunc;
+		GLCachedState<GLenum> mCullFace;
+		GLCachedState<GLenum> mPolygonMode;
+		GLCachedState<std::array<float, 2>> mPolygonOffset;
+		GLCachedState<std::array<GLint, 3>> mStencilOp[2];
+		GLCachedState<std::array<GLint, 3>> mStencilFunc[2];
+		GLCachedState<UINT32> mStencilMask;
+
 		GLSupport* mGLSupport;
 		bool mGLInitialised;
 
@@ -0,0 +1,216 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsGLRingBuffer.h"
+#include "Error/BsException.h"
+
+#if BS_OPENGL_4_4
+
+namespace bs { namespace ct
+{
+	GLRingBuffer::GLRingBuffer(UINT32 bufferSize, UINT32 alignment, UINT32 maxIdle)
+		: mBufferSize(bufferSize), mAlignment(std::max(alignment, 1U)), mMaxIdle(maxIdle)
+	{ }
+
+	GLRingBuffer::~GLRingBuffer()
+	{
+		for (auto& entry : mBuffers)
+		{
+			assert(entry.numAllocations == 0 && "Ring buffer destroyed while its allocations are still live.");
+			destroyBuffer(entry);
+		}
+	}
+
+	GLRingBuffer::Allocation GLRingBuffer::allocate(UINT32 size)
+	{
+		if (size > mBufferSize)
+			return Allocation();
+
+		const UINT32 offset = Math::divideAndRoundUp(mCurrentOffset, mAlignment) * mAlignment;
+		if (mCurrentBuffer == (UINT32)-1 || (UINT64)offset + size > mBufferSize)
+		{
+			// Move to the next buffer in the ring that isn't referenced by a live allocation or by the GPU
+			const UINT32 numBuffers = (UINT32)mBuffers.size();
+
+			UINT32 nextBuffer = (UINT32)-1;
+			for (UINT32 i = 1; i <= numBuffers; i++)
+			{
+				const UINT32 idx = (mCurrentBuffer + i) % numBuffers;
+				if (isIdle(mBuffers[idx]))
+				{
+					nextBuffer = idx;
+					break;
+				}
+			}
+
+			if (nextBuffer == (UINT32)-1)
+			{
+				nextBuffer = numBuffers;
+				mBuffers.push_back(createBuffer());
+			}
+
+			mCurrentBuffer = nextBuffer;
+			mCurrentOffset = 0;
+
+			trimIdleBuffers();
+		}
+		else
+			mCurrentOffset = offset;
+
+		BufferInfo& entry = mBuffers[mCurrentBuffer];
+		entry.numAllocations++;
+
+		Allocation allocation;
+		allocation.bufferId = entry.id;
+		allocation.data = entry.data + mCurrentOffset;
+		allocation.offset = mCurrentOffset;
+
+		mCurrentOffset += size;
+		return allocation;
+	}
+
+	void GLRingBuffer::free(const Allocation& allocation)
+	{
+		if (allocation.bufferId == 0)
+			return;
+
+		BufferInfo& entry = findBuffer(allocation);
+
+		assert(entry.numAllocations > 0);
+		entry.numAllocations--;
+
+		if (entry.numAllocations > 0)
+			return;
+
+		// Commands issued so far might still be reading from the released regions
+		if (entry.fence != nullptr)
+			glDeleteSync(entry.fence);
+
+		entry.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		BS_CHECK_GL_ERROR();
+	}
+
+	void GLRingBuffer::wait(const Allocation& allocation)
+	{
+		if (allocation.bufferId == 0)
+			return;
+
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		BS_CHECK_GL_ERROR();
+
+		GLenum result;
+		do
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+			BS_CHECK_GL_ERROR();
+		} while (result == GL_TIMEOUT_EXPIRED);
+
+		glDeleteSync(fence);
+		BS_CHECK_GL_ERROR();
+	}
+
+	bool GLRingBuffer::isIdle(BufferInfo& entry)
+	{
+		if (entry.numAllocations > 0)
+			return false;
+
+		if (entry.fence == nullptr)
+			return true;
+
+		const GLenum result = glClientWaitSync(entry.fence, 0, 0);
+		BS_CHECK_GL_ERROR();
+
+		if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+			return false;
+
+		glDeleteSync(entry.fence);
+		BS_CHECK_GL_ERROR();
+
+		entry.fence = nullptr;
+		return true;
+	}
+
+	GLRingBuffer::BufferInfo GLRingBuffer::createBuffer()
+	{
+		BufferInfo entry;
+		entry.numAllocations = 0;
+		entry.fence = nullptr;
+
+		glGenBuffers(1, &entry.id);
+		BS_CHECK_GL_ERROR();
+
+		if (!entry.id)
+			BS_EXCEPT(InternalErrorException, "Cannot create GL buffer");
+
+		// Buffer target doesn't matter for storage, the same buffer gets bound as vertex, index and uniform buffer
+		glBindBuffer(GL_COPY_WRITE_BUFFER, entry.id);
+		BS_CHECK_GL_ERROR();
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_COPY_WRITE_BUFFER, mBufferSize, nullptr, flags);
+		BS_CHECK_GL_ERROR();
+
+		entry.data = (UINT8*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, mBufferSize, flags);
+		BS_CHECK_GL_ERROR();
+
+		if (entry.data == nullptr)
+			BS_EXCEPT(InternalErrorException, "Cannot map OpenGL buffer.");
+
+		return entry;
+	}
+
+	void GLRingBuffer::destroyBuffer(BufferInfo& entry)
+	{
+		if (entry.fence != nullptr)
+		{
+			glDeleteSync(entry.fence);
+			BS_CHECK_GL_ERROR();
+		}
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, entry.id);
+		BS_CHECK_GL_ERROR();
+
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		BS_CHECK_GL_ERROR();
+
+		glDeleteBuffers(1, &entry.id);
+		BS_CHECK_GL_ERROR();
+	}
+
+	void GLRingBuffer::trimIdleBuffers()
+	{
+		UINT32 numIdle = 0;
+		for (UINT32 i = 0; i < (UINT32)mBuffers.size(); i++)
+		{
+			if (i != mCurrentBuffer && isIdle(mBuffers[i]))
+				numIdle++;
+		}
+
+		for (UINT32 i = 0; i < (UINT32)mBuffers.size() && numIdle > mMaxIdle;)
+		{
+			if (i == mCurrentBuffer || !isIdle(mBuffers[i]))
+			{
+				i++;
+				continue;
+			}
+
+			destroyBuffer(mBuffers[i]);
+			mBuffers.erase(mBuffers.begin() + i);
+
+			if (mCurrentBuffer > i)
+				mCurrentBuffer--;
+
+			numIdle--;
+		}
+	}
+
+	GLRingBuffer::BufferInfo& GLRingBuffer::findBuffer(const Allocation& allocation)
+	{
+		auto iterFind = std::find_if(mBuffers.begin(), mBuffers.end(),
+			[&allocation](const BufferInfo& entry) { return entry.id == allocation.bufferId; });
+
+		assert(iterFind != mBuffers.end() && "Allocation doesn't belong to this ring buffer.");
+		return *iterFind;
+	}
+}}
+
+#endif
\ No newline at end of file
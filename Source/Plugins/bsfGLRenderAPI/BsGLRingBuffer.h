@@ -0,0 +1,105 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsGLPrerequisites.h"
+
+#if BS_OPENGL_4_4
+
+namespace bs { namespace ct
+{
+	/** @addtogroup GL
+	 *  @{
+	 */
+
+	/**
+	 * Sub-allocates memory from a set of large, persistently mapped OpenGL buffers. Buffers are used as a ring:
+	 * allocations are made linearly from the current buffer, and once it runs out of space the next buffer is used, as
+	 * long as none of its allocations are still live and the GPU is done with it. If no such buffer exists a new one is
+	 * created. A fence is inserted whenever the last live allocation of a buffer is freed, and the buffer is only
+	 * reused once the GPU has passed that fence.
+	 *
+	 * Used for dynamic vertex, index and uniform buffers, so they can be discarded and rewritten without the driver
+	 * having to synchronize with the GPU.
+	 *
+	 * @note	Core thread only.
+	 */
+	class GLRingBuffer
+	{
+	public:
+		/** Region of a buffer assigned to a single allocation. */
+		struct Allocation
+		{
+			GLuint bufferId = 0;
+			UINT8* data = nullptr;
+			UINT32 offset = 0;
+		};
+
+		/**
+		 * @param[in]	bufferSize	Size of a single buffer, in bytes. This is also the largest possible allocation.
+		 * @param[in]	alignment	Alignment of all allocations, in bytes.
+		 * @param[in]	maxIdle		Maximum number of buffers to keep around while they're unused. Any buffers over
+		 *							this number are destroyed once they are no longer used.
+		 */
+		GLRingBuffer(UINT32 bufferSize, UINT32 alignment, UINT32 maxIdle);
+		~GLRingBuffer();
+
+		/**
+		 * Allocates a new region of the specified size. The region's memory is mapped and coherent, and can be written
+		 * to directly. Returns an empty allocation if the size is larger than the size of a single buffer.
+		 */
+		Allocation allocate(UINT32 size);
+
+		/**
+		 * Releases a region previously returned by allocate(). Its memory will only be reused once the GPU is done with
+		 * all the commands issued before this call.
+		 */
+		void free(const Allocation& allocation);
+
+		/**
+		 * Blocks until the GPU is done with all the commands issued so far. Must be called before reading from, or
+		 * modifying, a region the GPU might still be using.
+		 */
+		void wait(const Allocation& allocation);
+
+	private:
+		/** A single buffer the allocations are made from. */
+		struct BufferInfo
+		{
+			GLuint id;
+			UINT8* data;
+			UINT32 numAllocations;
+			GLsync fence;
+		};
+
+		/**
+		 * Checks if the buffer is not referenced by any live allocation, and the GPU is done using it. Doesn't block,
+		 * and releases the buffer's fence once it is passed.
+		 */
+		static bool isIdle(BufferInfo& entry);
+
+		/** Creates a new buffer with persistently mapped storage. */
+		BufferInfo createBuffer();
+
+		/** Unmaps and destroys the provided buffer. */
+		static void destroyBuffer(BufferInfo& entry);
+
+		/** Destroys idle buffers other than the current one, until there are no more than the allowed maximum. */
+		void trimIdleBuffers();
+
+		/** Finds the buffer the allocation was made from. */
+		BufferInfo& findBuffer(const Allocation& allocation);
+
+		UINT32 mBufferSize;
+		UINT32 mAlignment;
+		UINT32 mMaxIdle;
+
+		Vector<BufferInfo> mBuffers;
+		UINT32 mCurrentBuffer = (UINT32)-1;
+		UINT32 mCurrentOffset = 0;
+	};
+
+	/** @} */
+}}
+
+#endif
\ No newline at end of file
@@ -26,7 +26,7 @@ namespace bs { namespace ct
 		hash_combine(seed, vao.mVertProgId);
 
 		for (UINT32 i = 0; i < vao.mNumBuffers; i++)
-			hash_combine(seed, vao.mAttachedBuffers[i]->getGLBufferId());
+			hash_combine(seed, vao.mAttachedBuffers[i]);
 
 		return seed;
 	}
@@ -41,7 +41,7 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < a.mNumBuffers; i++)
 		{
-			if (a.mAttachedBuffers[i]->getGLBufferId() != b.mAttachedBuffers[i]->getGLBufferId())
+			if (a.mAttachedBuffers[i] != b.mAttachedBuffers[i])
 				return false;
 		}
 
@@ -58,7 +58,7 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < mNumBuffers; i++)
 		{
-			if (mAttachedBuffers[i]->getGLBufferId() != obj.mAttachedBuffers[i]->getGLBufferId())
+			if (mAttachedBuffers[i] != obj.mAttachedBuffers[i])
 				return false;
 		}
 
@@ -112,6 +112,14 @@ namespace bs { namespace ct
 
 			numUsedBuffers++;
 		}
+
+		// Attribute pointers reference the buffer's location directly, so VAOs created before a dynamic buffer moved to
+		// a new location can't be reused
+		for (UINT32 i = 0; i < numUsedBuffers; i++)
+		{
+			if (usedBuffers[i] != nullptr)
+				usedBuffers[i]->releaseStaleVAOs();
+		}
 		
 		GLVertexArrayObject wantedVAO(0, vertexProgram->getGLHandle(), usedBuffers, numUsedBuffers);
 
@@ -133,6 +141,8 @@ namespace bs { namespace ct
 		glBindVertexArray(wantedVAO.mHandle);
 		BS_CHECK_GL_ERROR();
 
+		mBoundVAO = wantedVAO.mHandle;
+
 		for (auto& elem : decl)
 		{
 			UINT16 streamIdx = elem.getStreamIdx();
@@ -164,7 +174,7 @@ namespace bs { namespace ct
 			glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer->getGLBufferId());
 			BS_CHECK_GL_ERROR();
 
-			void* bufferData = VBO_BUFFER_OFFSET(elem.getOffset());
+			void* bufferData = VBO_BUFFER_OFFSET(vertexBuffer->getGLBufferOffset() + elem.getOffset());
 
 			UINT16 typeCount = VertexElement::getTypeCount(elem.getType());
 			GLenum glType = GLHardwareBufferManager::getGLType(elem.getType());
@@ -220,6 +230,21 @@ namespace bs { namespace ct
 		return *iter.first;
 	}
 
+	void GLVertexArrayObjectManager::bind(const GLVertexArrayObject& vao)
+	{
+		if (mBoundVAO == vao.getGLHandle())
+		{
+			BS_INC_RENDER_STAT(NumRedundantStateChanges);
+			return;
+		}
+
+		glBindVertexArray(vao.getGLHandle());
+		BS_CHECK_GL_ERROR();
+
+		mBoundVAO = vao.getGLHandle();
+		BS_INC_RENDER_STAT(NumStateChanges);
+	}
+
 	// Note: This must receieve a copy and not a ref because original will be destroyed
 	void GLVertexArrayObjectManager::notifyBufferDestroyed(GLVertexArrayObject vao)
 	{
@@ -233,6 +258,10 @@ namespace bs { namespace ct
 		glDeleteVertexArrays(1, &vao.mHandle);
 		BS_CHECK_GL_ERROR();
 
+		// Deleting a bound VAO reverts the binding to zero
+		if (mBoundVAO == vao.mHandle)
+			mBoundVAO = 0;
+
 		bs_free(vao.mAttachedBuffers);
 
 		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_VertexArrayObject);
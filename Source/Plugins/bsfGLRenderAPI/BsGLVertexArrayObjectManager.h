@@ -13,7 +13,8 @@ namespace bs { namespace ct
 
 	/**
 	 * Vertex array object that contains vertex buffer object bindings and vertex attribute pointers for a specific set of
-	 * vertex buffers and a vertex declaration.
+	 * vertex buffers and a vertex declaration. Identified by the buffer objects rather than their OpenGL buffers, since
+	 * dynamic buffers can share a single OpenGL buffer.
 	 */
 	class GLVertexArrayObject
 	{
@@ -66,12 +67,22 @@ namespace bs { namespace ct
 		const GLVertexArrayObject& getVAO(const SPtr<GLSLGpuProgram>& vertexProgram,
 			const SPtr<VertexDeclaration>& vertexDecl, const std::array<SPtr<VertexBuffer>, 32>& boundBuffers);
 
+		/** Binds the provided VAO to the pipeline, unless it is already bound. */
+		void bind(const GLVertexArrayObject& vao);
+
+		/**
+		 * Forgets which VAO is currently bound, forcing the next bind() to be applied. Must be called when switching
+		 * OpenGL contexts.
+		 */
+		void resetBoundVAO() { mBoundVAO = 0; }
+
 		/**	Called when a vertex buffer containing the provided VAO is destroyed. */
 		void notifyBufferDestroyed(GLVertexArrayObject vao);
 	private:
 		typedef UnorderedSet<GLVertexArrayObject, GLVertexArrayObject::Hash, GLVertexArrayObject::Equal> VAOMap;
 
 		VAOMap mVAObjects;
+		GLuint mBoundVAO = 0;
 	};
 
 	/** @} */
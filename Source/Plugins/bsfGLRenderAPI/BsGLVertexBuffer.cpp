@@ -45,4 +45,16 @@ namespace bs { namespace ct
 		if (iterFind != mVAObjects.end())
 			mVAObjects.erase(iterFind);
 	}
+
+	void GLVertexBuffer::releaseStaleVAOs()
+	{
+		const UINT32 locationVersion = static_cast<GLHardwareBuffer*>(mBuffer)->getLocationVersion();
+		if (locationVersion == mVAOLocationVersion)
+			return;
+
+		while (!mVAObjects.empty())
+			GLVertexArrayObjectManager::instance().notifyBufferDestroyed(mVAObjects[0]);
+
+		mVAOLocationVersion = locationVersion;
+	}
 }}
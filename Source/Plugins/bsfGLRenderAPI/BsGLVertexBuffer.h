@@ -23,18 +23,28 @@ namespace bs { namespace ct
 		/**	Returns internal OpenGL buffer ID. */
 		GLuint getGLBufferId() const { return static_cast<GLHardwareBuffer*>(mBuffer)->getGLBufferId(); }
 
+		/** @copydoc GLHardwareBuffer::getGLBufferOffset */
+		UINT32 getGLBufferOffset() const { return static_cast<GLHardwareBuffer*>(mBuffer)->getGLBufferOffset(); }
+
 		/**	Registers a new VertexArrayObject that uses this vertex buffer. */
 		void registerVAO(const GLVertexArrayObject& vao);
 
 		/**	Unregisters a VAO from this vertex buffer. Does not destroy it. */
 		void unregisterVAO(const GLVertexArrayObject& vao);
 
+		/**
+		 * Destroys all VAOs using this vertex buffer, if the buffer's data moved to a different location since they
+		 * were created.
+		 */
+		void releaseStaleVAOs();
+
 	protected:
 		/** @copydoc VertexBuffer::initialize */
 		void initialize() override;
 
 	private:
 		Vector<GLVertexArrayObject> mVAObjects;
+		UINT32 mVAOLocationVersion = 0;
 	};
 
 	/** @} */
@@ -13,6 +13,35 @@ namespace bs
 	 *  @{
 	 */
 
+	/**
+	 * View over the elements of a managed array, accessing them in-place without copying. Only valid for arrays of
+	 * blittable types, and only as long as the array is referenced from managed code or by a GC handle.
+	 */
+	template<class T>
+	class ScriptArrayView
+	{
+	public:
+		ScriptArrayView(T* data, UINT32 size)
+			:mData(data), mSize(size)
+		{ }
+
+		/** Returns the element at the specified index. */
+		T& operator[](UINT32 idx) const { return mData[idx]; }
+
+		/** Returns a pointer to the first element of the array. */
+		T* data() const { return mData; }
+
+		/** Returns the number of elements in the array. */
+		UINT32 size() const { return mSize; }
+
+		T* begin() const { return mData; }
+		T* end() const { return mData + mSize; }
+
+	private:
+		T* mData;
+		UINT32 mSize;
+	};
+
 	/** Helper class for creating and parsing managed arrays.*/
 	class BS_MONO_EXPORT ScriptArray
 	{
@@ -63,6 +92,20 @@ namespace bs
 			return (T*)_getArrayAddr(mInternal, sizeof(T), idx);
 		}
 
+		/**
+		 * Returns a view over all elements of the array, allowing them to be read and written in-place. Must only be
+		 * used for blittable element types (containing no references), as writes through the view bypass the GC.
+		 */
+		template<class T>
+		ScriptArrayView<T> getView()
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Blittable types must be trivially copyable.");
+#if BS_DEBUG_MODE
+			assert(sizeof(T) == elementSize());
+#endif
+			return ScriptArrayView<T>((T*)_getArrayAddr(mInternal, sizeof(T), 0), size());
+		}
+
 		/** 
 		 * Creates a new array of managed objects. 
 		 *
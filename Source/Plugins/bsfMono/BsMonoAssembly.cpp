@@ -68,6 +68,9 @@ namespace bs
 		char* assemblyData = (char*)bs_stack_alloc(assemblySize);
 		assemblyStream->read(assemblyData, assemblySize);
 
+		mFileSize = assemblySize;
+		mLastModifiedTime = FileSystem::getLastModifiedTime(mPath);
+
 		String imageName = Path(mPath).getFilename();
 
 		MonoImageOpenStatus status = MONO_IMAGE_OK;
@@ -115,6 +118,18 @@ namespace bs
 		mIsDependency = false;
 	}
 
+	bool MonoAssembly::isModified() const
+	{
+		if (mIsDependency || !mIsLoaded)
+			return false;
+
+		if (!FileSystem::exists(mPath))
+			return true;
+
+		return FileSystem::getLastModifiedTime(mPath) != mLastModifiedTime ||
+			FileSystem::getFileSize(mPath) != mFileSize;
+	}
+
 	void MonoAssembly::loadFromImage(MonoImage* image)
 	{
 		::MonoAssembly* monoAssembly = mono_image_get_assembly(image);
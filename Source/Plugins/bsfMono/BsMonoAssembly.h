@@ -60,6 +60,12 @@ namespace bs
 	     */
 		void invoke(const String& functionName);
 
+		/**
+		 * Checks if the assembly file was modified since the assembly was loaded, and therefore needs to be reloaded
+		 * for the changes to take effect. Always false for assemblies loaded as dependencies.
+		 */
+		bool isModified() const;
+
 	private:
 		friend class MonoManager;
 
@@ -102,6 +108,8 @@ namespace bs
 		UINT8* mDebugData;
 		bool mIsLoaded;
 		bool mIsDependency;
+		std::time_t mLastModifiedTime = 0;
+		UINT64 mFileSize = 0;
 		
 		mutable UnorderedMap<ClassId, MonoClass*, ClassId::Hash, ClassId::Equals> mClasses;
 		mutable UnorderedMap<::MonoClass*, MonoClass*> mClassesByRaw;
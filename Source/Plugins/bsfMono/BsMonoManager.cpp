@@ -10,6 +10,7 @@
 #include "Error/BsException.h"
 #include "BsApplication.h"
 #include "BsEngineConfig.h"
+#include "Profiling/BsScriptGCProfiler.h"
 
 #include "mono/jit/jit.h"
 #include <mono/metadata/assembly.h>
@@ -18,6 +19,8 @@
 #include <mono/metadata/mono-debug.h>
 #include <mono/utils/mono-logger.h>
 #include <mono/metadata/threads.h>
+#include <mono/metadata/profiler.h>
+#include <chrono>
 
 namespace bs
 {
@@ -90,6 +93,37 @@ namespace bs
 	{
 		LOGERR(StringUtil::format("Mono error: {0}", string));
 	}	
+
+#ifdef MONO_PROFILER_API_VERSION
+	// Only accessed from the thread performing the collection, and collections never overlap
+	static UINT64 sGCPauseStart = 0;
+	static UINT32 sGCGeneration = 0;
+
+#if MONO_PROFILER_API_VERSION >= 3
+	void monoGCEventCallback(MonoProfiler* profiler, MonoProfilerGCEvent event, uint32_t generation, mono_bool isSerial)
+#else
+	void monoGCEventCallback(MonoProfiler* profiler, MonoProfilerGCEvent event, uint32_t generation)
+#endif
+	{
+		using namespace std::chrono;
+		const UINT64 now = (UINT64)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+
+		switch (event)
+		{
+		case MONO_GC_EVENT_PRE_STOP_WORLD:
+			sGCPauseStart = now;
+			break;
+		case MONO_GC_EVENT_START:
+			sGCGeneration = generation;
+			break;
+		case MONO_GC_EVENT_POST_START_WORLD:
+			ScriptGCProfiler::_recordPause(now - sGCPauseStart, sGCGeneration);
+			break;
+		default:
+			break;
+		}
+	}
+#endif
 	
 	MonoManager::MonoManager()
 		:mScriptDomain(nullptr), mRootDomain(nullptr), mCorlibAssembly(nullptr)
@@ -132,6 +166,11 @@ namespace bs
 
 		mono_config_parse(nullptr);
 
+#ifdef MONO_PROFILER_API_VERSION
+		MonoProfilerHandle profiler = mono_profiler_create(nullptr);
+		mono_profiler_set_gc_event_callback(profiler, monoGCEventCallback);
+#endif
+
 		mRootDomain = mono_jit_init_version("BansheeMono", MONO_VERSION_DATA[(int)MONO_VERSION].version.c_str());
 		if (mRootDomain == nullptr)
 			BS_EXCEPT(InternalErrorException, "Cannot initialize Mono runtime.");
@@ -239,6 +278,29 @@ namespace bs
 		return nullptr;
 	}
 
+	Vector<String> MonoManager::getModifiedAssemblies() const
+	{
+		Vector<String> output;
+		for (auto& entry : mAssemblies)
+		{
+			if (entry.second->isModified())
+				output.push_back(entry.first);
+		}
+
+		return output;
+	}
+
+	bool MonoManager::isReloadRequired() const
+	{
+		for (auto& entry : mAssemblies)
+		{
+			if (entry.second->isModified())
+				return true;
+		}
+
+		return false;
+	}
+
 	void MonoManager::registerScriptType(ScriptMeta* metaData, const ScriptMeta& localMetaData)
 	{
 		Vector<ScriptMetaInfo>& mMetas = getScriptMetaData()[localMetaData.assembly];
@@ -276,6 +338,7 @@ namespace bs
 		if (mScriptDomain != nullptr)
 		{
 			onDomainUnload();
+			MonoUtil::_clearStringCache();
 
 			mono_domain_set(mono_get_root_domain(), true);
 
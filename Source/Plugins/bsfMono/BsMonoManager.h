@@ -47,6 +47,15 @@ namespace bs
 		 */
 		MonoAssembly* getAssembly(const String& name) const;
 
+		/** Returns the names of all loaded assemblies whose files were modified since they were loaded. */
+		Vector<String> getModifiedAssemblies() const;
+
+		/**
+		 * Checks if any of the loaded assemblies were modified since they were loaded. If not, reloading the script
+		 * domain can be skipped, avoiding the cost of re-creating all script objects.
+		 */
+		bool isReloadRequired() const;
+
 		/**
 		 * Unloads the active domain (in which all script assemblies are loaded) and destroys any managed objects
 		 * associated with it.
@@ -0,0 +1,106 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsMonoObjectTable.h"
+#include "BsMonoUtil.h"
+
+namespace bs
+{
+	MonoObjectTable::~MonoObjectTable()
+	{
+		clear();
+	}
+
+	MonoObjectId MonoObjectTable::add(MonoObject* object, void* native, bool weak)
+	{
+		UINT32 index;
+		if (!mFreeSlots.empty())
+		{
+			index = mFreeSlots.back();
+			mFreeSlots.pop_back();
+		}
+		else
+		{
+			index = (UINT32)mEntries.size();
+			mEntries.push_back(Entry());
+		}
+
+		Entry& entry = mEntries[index];
+		entry.gcHandle = weak ? MonoUtil::newWeakGCHandle(object) : MonoUtil::newGCHandle(object, false);
+		entry.native = native;
+
+		mNumEntries++;
+
+		MonoObjectId id;
+		id.index = index;
+		id.generation = entry.generation;
+
+		return id;
+	}
+
+	void MonoObjectTable::remove(MonoObjectId id)
+	{
+		if (find(id) == nullptr)
+			return;
+
+		Entry& entry = mEntries[id.index];
+		MonoUtil::freeGCHandle(entry.gcHandle);
+
+		entry.gcHandle = 0;
+		entry.native = nullptr;
+
+		// Skip generation 0, so default constructed identifiers never match
+		entry.generation++;
+		if (entry.generation == 0)
+			entry.generation = 1;
+
+		mFreeSlots.push_back(id.index);
+		mNumEntries--;
+	}
+
+	bool MonoObjectTable::isValid(MonoObjectId id) const
+	{
+		return find(id) != nullptr;
+	}
+
+	void* MonoObjectTable::getNative(MonoObjectId id) const
+	{
+		const Entry* entry = find(id);
+		if (entry == nullptr)
+			return nullptr;
+
+		return entry->native;
+	}
+
+	MonoObject* MonoObjectTable::getManaged(MonoObjectId id) const
+	{
+		const Entry* entry = find(id);
+		if (entry == nullptr)
+			return nullptr;
+
+		return MonoUtil::getObjectFromGCHandle(entry->gcHandle);
+	}
+
+	void MonoObjectTable::clear()
+	{
+		for (UINT32 i = 0; i < (UINT32)mEntries.size(); i++)
+		{
+			MonoObjectId id;
+			id.index = i;
+			id.generation = mEntries[i].generation;
+
+			remove(id);
+		}
+	}
+
+	const MonoObjectTable::Entry* MonoObjectTable::find(MonoObjectId id) const
+	{
+		if (id.index >= (UINT32)mEntries.size())
+			return nullptr;
+
+		const Entry& entry = mEntries[id.index];
+		if (entry.gcHandle == 0 || entry.generation != id.generation)
+			return nullptr;
+
+		return &entry;
+	}
+}
@@ -0,0 +1,100 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsMonoPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Mono
+	 *  @{
+	 */
+
+	/**
+	 * Identifies an entry in MonoObjectTable. The generation changes every time an entry slot is reused, so identifiers
+	 * of removed entries can be detected instead of resolving to an unrelated object. Can be stored in managed code as
+	 * a 64-bit integer, through pack() and unpack().
+	 */
+	struct MonoObjectId
+	{
+		UINT32 index = 0;
+		UINT32 generation = 0; /**< Generation 0 is never assigned, making a default identifier invalid. */
+
+		/** Packs the identifier into a single 64-bit value. */
+		UINT64 pack() const { return ((UINT64)generation << 32) | index; }
+
+		/** Unpacks an identifier previously packed with pack(). */
+		static MonoObjectId unpack(UINT64 value)
+		{
+			MonoObjectId output;
+			output.index = (UINT32)(value & 0xFFFFFFFF);
+			output.generation = (UINT32)(value >> 32);
+
+			return output;
+		}
+
+		bool operator==(const MonoObjectId& rhs) const { return index == rhs.index && generation == rhs.generation; }
+		bool operator!=(const MonoObjectId& rhs) const { return !(*this == rhs); }
+	};
+
+	/**
+	 * Table linking managed objects with their native counterparts. Managed objects are referenced through unpinned GC
+	 * handles, leaving the GC free to move them, and are looked up through generation checked identifiers instead of
+	 * raw pointers, so stale identifiers resolve to null.
+	 *
+	 * @note	Not thread safe. Must be cleared before the script domain is unloaded.
+	 */
+	class BS_MONO_EXPORT MonoObjectTable
+	{
+	public:
+		MonoObjectTable() = default;
+		~MonoObjectTable();
+
+		/**
+		 * Adds a new entry to the table.
+		 *
+		 * @param[in]	object	Managed object to reference.
+		 * @param[in]	native	Native object associated with the managed object.
+		 * @param[in]	weak	If true, the table will not keep the managed object alive. getManaged() will return null
+		 *						once the object is collected.
+		 * @return				Identifier that can be used for retrieving the objects, until the entry is removed.
+		 */
+		MonoObjectId add(MonoObject* object, void* native, bool weak = false);
+
+		/** Removes an entry and frees its GC handle. Does nothing if the identifier is no longer valid. */
+		void remove(MonoObjectId id);
+
+		/** Checks if the identifier refers to an entry that is still in the table. */
+		bool isValid(MonoObjectId id) const;
+
+		/** Returns the native object of the entry, or null if the identifier is no longer valid. */
+		void* getNative(MonoObjectId id) const;
+
+		/** Returns the managed object of the entry, or null if the identifier is no longer valid. */
+		MonoObject* getManaged(MonoObjectId id) const;
+
+		/** Returns the number of entries in the table. */
+		UINT32 getNumEntries() const { return mNumEntries; }
+
+		/** Removes all entries and frees their GC handles. Previously returned identifiers become invalid. */
+		void clear();
+
+	private:
+		/** Single slot in the table. Slots without a GC handle are unused and are part of the free list. */
+		struct Entry
+		{
+			UINT32 gcHandle = 0;
+			UINT32 generation = 1;
+			void* native = nullptr;
+		};
+
+		/** Returns the entry the identifier refers to, or null if the identifier is no longer valid. */
+		const Entry* find(MonoObjectId id) const;
+
+		Vector<Entry> mEntries;
+		Vector<UINT32> mFreeSlots;
+		UINT32 mNumEntries = 0;
+	};
+
+	/** @} */
+}
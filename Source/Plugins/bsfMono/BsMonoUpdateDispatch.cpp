@@ -0,0 +1,148 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsMonoUpdateDispatch.h"
+#include "BsMonoMethod.h"
+#include "BsMonoUtil.h"
+
+namespace bs
+{
+	/** Initial number of objects in a type's array. Arrays double in size when full. */
+	static const UINT32 INITIAL_GROUP_CAPACITY = 16;
+
+	MonoUpdateDispatch::MonoUpdateDispatch(MonoMethod* dispatchMethod)
+		:mDispatchThunk((DispatchThunkDef)dispatchMethod->getThunk())
+	{
+		BS_ASSERT(dispatchMethod->isStatic() && dispatchMethod->getNumParameters() == 2);
+	}
+
+	MonoUpdateDispatch::~MonoUpdateDispatch()
+	{
+		clear();
+	}
+
+	void MonoUpdateDispatch::registerObject(MonoObject* object)
+	{
+		::MonoClass* klass = MonoUtil::getClass(object);
+
+		auto iterFind = mGroupLookup.find(klass);
+		if (iterFind == mGroupLookup.end())
+		{
+			ObjectGroup group;
+			group.klass = klass;
+
+			iterFind = mGroupLookup.insert(std::make_pair(klass, (UINT32)mGroups.size())).first;
+			mGroups.push_back(group);
+		}
+
+		ObjectGroup& group = mGroups[iterFind->second];
+		if (group.count == group.capacity)
+		{
+			// Entries can only be removed once the dispatch method is no longer iterating over them
+			if (group.hasHoles && !mIsDispatching)
+				compact(group);
+
+			if (group.count == group.capacity)
+			{
+				const UINT32 newCapacity = std::max(INITIAL_GROUP_CAPACITY, group.capacity * 2);
+				ScriptArray newArray(klass, newCapacity);
+
+				// The old array is left as is, in case the dispatch method is currently iterating over it
+				if (group.arrayHandle != 0)
+				{
+					ScriptArray oldArray((MonoArray*)MonoUtil::getObjectFromGCHandle(group.arrayHandle));
+					for (UINT32 i = 0; i < group.count; i++)
+						newArray.set(i, oldArray.get<MonoObject*>(i));
+
+					MonoUtil::freeGCHandle(group.arrayHandle);
+				}
+
+				group.arrayHandle = MonoUtil::newGCHandle((MonoObject*)newArray.getInternal(), false);
+				group.capacity = newCapacity;
+			}
+		}
+
+		ScriptArray array((MonoArray*)MonoUtil::getObjectFromGCHandle(group.arrayHandle));
+		array.set(group.count, object);
+		group.count++;
+	}
+
+	void MonoUpdateDispatch::unregisterObject(MonoObject* object)
+	{
+		auto iterFind = mGroupLookup.find(MonoUtil::getClass(object));
+		if (iterFind == mGroupLookup.end())
+			return;
+
+		ObjectGroup& group = mGroups[iterFind->second];
+		ScriptArray array((MonoArray*)MonoUtil::getObjectFromGCHandle(group.arrayHandle));
+		for (UINT32 i = 0; i < group.count; i++)
+		{
+			if (array.get<MonoObject*>(i) != object)
+				continue;
+
+			// Leave a hole rather than moving other entries, so a dispatch in progress doesn't skip or repeat any
+			array.set(i, nullptr);
+			group.hasHoles = true;
+			break;
+		}
+	}
+
+	void MonoUpdateDispatch::dispatch()
+	{
+		for (auto& group : mGroups)
+		{
+			if (group.hasHoles)
+				compact(group);
+		}
+
+		mIsDispatching = true;
+
+		// Registration can append to mGroups during dispatch, so iterate by index
+		for (UINT32 i = 0; i < (UINT32)mGroups.size(); i++)
+		{
+			const ObjectGroup& group = mGroups[i];
+			if (group.count == 0)
+				continue;
+
+			MonoArray* array = (MonoArray*)MonoUtil::getObjectFromGCHandle(group.arrayHandle);
+			MonoUtil::invokeThunk(mDispatchThunk, array, (INT32)group.count);
+		}
+
+		mIsDispatching = false;
+	}
+
+	void MonoUpdateDispatch::clear()
+	{
+		for (auto& group : mGroups)
+		{
+			if (group.arrayHandle != 0)
+				MonoUtil::freeGCHandle(group.arrayHandle);
+		}
+
+		mGroups.clear();
+		mGroupLookup.clear();
+	}
+
+	void MonoUpdateDispatch::compact(ObjectGroup& group)
+	{
+		ScriptArray array((MonoArray*)MonoUtil::getObjectFromGCHandle(group.arrayHandle));
+
+		UINT32 numKept = 0;
+		for (UINT32 i = 0; i < group.count; i++)
+		{
+			MonoObject* object = array.get<MonoObject*>(i);
+			if (object == nullptr)
+				continue;
+
+			if (i != numKept)
+				array.set(numKept, object);
+
+			numKept++;
+		}
+
+		for (UINT32 i = numKept; i < group.count; i++)
+			array.set(i, nullptr);
+
+		group.count = numKept;
+		group.hasHoles = false;
+	}
+}
@@ -0,0 +1,67 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsMonoPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Mono
+	 *  @{
+	 */
+
+	/**
+	 * Calls a per-frame managed method (e.g. OnUpdate) on a large number of managed objects, with a single transition
+	 * into managed code per object type. Registered objects are grouped by their class into managed arrays, and each
+	 * array is passed to a static managed dispatch method that loops over it and calls the method on each object.
+	 *
+	 * The dispatch method must be static and have the signature "void Method(T[] objects, int count)", where T is a
+	 * common base class of all registered objects. Array entries for objects unregistered during dispatch are set to
+	 * null, and must be skipped by the dispatch method.
+	 *
+	 * @note	Must be cleared before the script domain is unloaded.
+	 */
+	class BS_MONO_EXPORT MonoUpdateDispatch
+	{
+	public:
+		/** @param[in]	dispatchMethod	Static managed method to call once per object type, as described above. */
+		MonoUpdateDispatch(MonoMethod* dispatchMethod);
+		~MonoUpdateDispatch();
+
+		/** Registers an object to be updated by dispatch(). Object must not already be registered. */
+		void registerObject(MonoObject* object);
+
+		/** Unregisters an object previously registered with registerObject(). */
+		void unregisterObject(MonoObject* object);
+
+		/** Calls the dispatch method once for every type that has at least one registered object. */
+		void dispatch();
+
+		/** Unregisters all objects and releases the managed arrays. */
+		void clear();
+
+	private:
+		/** Registered objects of a single type. */
+		struct ObjectGroup
+		{
+			::MonoClass* klass = nullptr;
+			UINT32 arrayHandle = 0;
+			UINT32 capacity = 0;
+			UINT32 count = 0;
+			bool hasHoles = false;
+		};
+
+		/** Removes null entries left by unregistrations, keeping the order of the remaining objects. */
+		static void compact(ObjectGroup& group);
+
+		typedef void(BS_THUNKCALL *DispatchThunkDef) (MonoArray*, INT32, MonoException**);
+
+		DispatchThunkDef mDispatchThunk;
+
+		Vector<ObjectGroup> mGroups;
+		UnorderedMap<::MonoClass*, UINT32> mGroupLookup;
+		bool mIsDispatching = false;
+	};
+
+	/** @} */
+}
@@ -14,6 +14,9 @@ namespace bs
 	static bool sGenericHelpersInitialized = false;
 	static MonoProperty* sGenericParamsProp = nullptr;
 
+	static Mutex sStringCacheMutex;
+	static UnorderedMap<String, UINT32> sStringCache;
+
 	WString MonoUtil::monoToWString(MonoString* str)
 	{
 		if (str == nullptr)
@@ -31,9 +34,23 @@ namespace bs
 
 	String MonoUtil::monoToString(MonoString* str)
 	{
-		WString wideString = monoToWString(str);
+		if (str == nullptr)
+			return StringUtil::BLANK;
+
+		int len = mono_string_length(str);
+		mono_unichar2* monoChars = mono_string_chars(str);
 
-		return UTF8::fromWide(wideString);
+		// Most strings passed through bindings are ASCII, in which case they can be narrowed directly
+		String ret(len, '0');
+		for (int i = 0; i < len; i++)
+		{
+			if (monoChars[i] >= 0x80)
+				return UTF8::fromUTF16(U16String((const char16_t*)monoChars, (size_t)len));
+
+			ret[i] = (char)monoChars[i];
+		}
+
+		return ret;
 	}
 
 	MonoString* MonoUtil::wstringToMono(const WString& str)
@@ -46,7 +63,31 @@ namespace bs
 
 	MonoString* MonoUtil::stringToMono(const String& str)
 	{
-		return wstringToMono(UTF8::toWide(str));
+		return mono_string_new_len(MonoManager::instance().getDomain(), str.data(), (UINT32)str.size());
+	}
+
+	MonoString* MonoUtil::getCachedString(const String& str)
+	{
+		Lock lock(sStringCacheMutex);
+
+		auto iterFind = sStringCache.find(str);
+		if (iterFind != sStringCache.end())
+			return (MonoString*)mono_gchandle_get_target(iterFind->second);
+
+		MonoString* monoString = mono_string_intern(stringToMono(str));
+		sStringCache[str] = mono_gchandle_new((MonoObject*)monoString, true);
+
+		return monoString;
+	}
+
+	void MonoUtil::_clearStringCache()
+	{
+		Lock lock(sStringCacheMutex);
+
+		for (auto& entry : sStringCache)
+			mono_gchandle_free(entry.second);
+
+		sStringCache.clear();
 	}
 
 	void MonoUtil::getClassName(MonoObject* obj, String& ns, String& typeName)
@@ -26,6 +26,13 @@ namespace bs
 		/**	Converts a native narrow string to a Mono (managed) string. */
 		static MonoString* stringToMono(const String& str);
 
+		/**
+		 * Returns an interned managed string with the provided contents. The string is created on first use and cached,
+		 * so repeated calls with the same contents don't allocate. Meant for strings passed to managed code often, like
+		 * names and identifiers. Cache is cleared when the script domain is unloaded.
+		 */
+		static MonoString* getCachedString(const String& str);
+
 		/**	Outputs name and namespace for the type of the specified object. */
 		static void getClassName(MonoObject* obj, String& ns, String& typeName);
 
@@ -59,7 +66,7 @@ namespace bs
 		 *							Note that pinning can have an impact on memory fragmentation as it prevents the GC from
 		 *							moving the object, so use it sparingly.
 		 */
-		static UINT32 newGCHandle(MonoObject* object, bool pinned = true);
+		static UINT32 newGCHandle(MonoObject* object, bool pinned = false);
 
 		/**
 		 * Creates a new GC handle for the provided managed object. The handle can be stored and later used for retrieving
@@ -81,6 +88,27 @@ namespace bs
 		/** Unboxes a managed object back to a raw value type. */
 		static void* unbox(MonoObject* object);
 
+		/**
+		 * Unboxes a managed object holding a blittable value type (a struct with no references, with the same layout in
+		 * native and managed code), by copying it directly into @p T.
+		 */
+		template<class T>
+		static T unboxBlittable(MonoObject* object)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Blittable types must be trivially copyable.");
+
+			return *(T*)unbox(object);
+		}
+
+		/** Boxes a blittable value type. @p klass must be the managed equivalent of @p T. */
+		template<class T>
+		static MonoObject* boxBlittable(::MonoClass* klass, const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Blittable types must be trivially copyable.");
+
+			return box(klass, (void*)&value);
+		}
+
 		/** 
 		 * Copies the value from @p src to @p dest. This must be a value-type of type @p klass. You need to use this
 		 * form of copying if @p dest is a struct that gets passed to managed code and it contains a reference type. This
@@ -88,6 +116,18 @@ namespace bs
 		 */
 		static void valueCopy(void* dest, void* src, ::MonoClass* klass);
 
+		/**
+		 * Copies a blittable value type to @p dest. Unlike valueCopy() this doesn't need to look up the class layout,
+		 * but must only be used for types that contain no references.
+		 */
+		template<class T>
+		static void blittableCopy(void* dest, const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Blittable types must be trivially copyable.");
+
+			memcpy(dest, &value, sizeof(T));
+		}
+
 		/**
 		 * Copies the pointer to a reference type @p object to @p dest, ensuring @p dest also points to the object. This
 		 * needs to be used if @p dest is being passed to managed code (e.g. an output parameter in a method). Otherwise
@@ -184,6 +224,18 @@ namespace bs
 
 			throwIfException(exception);
 		}
+
+		/**
+		 * @name Internal
+		 * @{
+		 */
+
+		/** Releases all strings cached by getCachedString(). Must be called before the script domain is unloaded. */
+		static void _clearStringCache();
+
+		/**
+		 * @}
+		 */
 	};
 
 	/** @} */
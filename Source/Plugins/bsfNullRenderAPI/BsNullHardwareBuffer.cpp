@@ -0,0 +1,104 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullHardwareBuffer.h"
+
+namespace bs { namespace ct
+{
+	static void deleteBuffer(HardwareBuffer* buffer)
+	{
+		bs_pool_delete(static_cast<NullHardwareBuffer*>(buffer));
+	}
+
+	NullHardwareBuffer::NullHardwareBuffer(UINT32 size, GpuBufferUsage usage)
+		: HardwareBuffer(size, usage, GDF_DEFAULT)
+	{ }
+
+	NullHardwareBuffer::~NullHardwareBuffer()
+	{
+		if (mLockedData)
+			bs_free(mLockedData);
+	}
+
+	void NullHardwareBuffer::readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		memset(dest, 0, length);
+	}
+
+	void* NullHardwareBuffer::map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx,
+		UINT32 queueIdx)
+	{
+		mLockedData = (UINT8*)bs_alloc(length);
+		memset(mLockedData, 0, length);
+
+		return mLockedData;
+	}
+
+	void NullHardwareBuffer::unmap()
+	{
+		bs_free(mLockedData);
+		mLockedData = nullptr;
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const VERTEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		: VertexBuffer(desc, deviceMask)
+	{ }
+
+	void NullVertexBuffer::initialize()
+	{
+		mBuffer = bs_pool_new<NullHardwareBuffer>(mSize, mUsage);
+		mBufferDeleter = &deleteBuffer;
+
+		VertexBuffer::initialize();
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const INDEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		: IndexBuffer(desc, deviceMask)
+	{ }
+
+	void NullIndexBuffer::initialize()
+	{
+		mBuffer = bs_pool_new<NullHardwareBuffer>(mSize, mUsage);
+		mBufferDeleter = &deleteBuffer;
+
+		IndexBuffer::initialize();
+	}
+
+	NullGpuBuffer::NullGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+		: GpuBuffer(desc, deviceMask)
+	{ }
+
+	NullGpuBuffer::NullGpuBuffer(const GPU_BUFFER_DESC& desc, SPtr<HardwareBuffer> underlyingBuffer)
+		: GpuBuffer(desc, std::move(underlyingBuffer))
+	{ }
+
+	void NullGpuBuffer::initialize()
+	{
+		mBufferDeleter = &deleteBuffer;
+
+		// Create a buffer if not wrapping an external one
+		if(!mBuffer)
+		{
+			const auto& props = getProperties();
+			UINT32 size = props.getElementCount() * props.getElementSize();
+			mBuffer = bs_pool_new<NullHardwareBuffer>(size, props.getUsage());
+		}
+
+		GpuBuffer::initialize();
+	}
+
+	NullGpuParamBlockBuffer::NullGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask)
+		: GpuParamBlockBuffer(size, usage, deviceMask)
+	{ }
+
+	NullGpuParamBlockBuffer::~NullGpuParamBlockBuffer()
+	{
+		if(mBuffer)
+			bs_pool_delete(static_cast<NullHardwareBuffer*>(mBuffer));
+	}
+
+	void NullGpuParamBlockBuffer::initialize()
+	{
+		mBuffer = bs_pool_new<NullHardwareBuffer>(mSize, mUsage);
+		GpuParamBlockBuffer::initialize();
+	}
+}}
@@ -0,0 +1,102 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsHardwareBuffer.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsIndexBuffer.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsGpuParamBlockBuffer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * Hardware buffer that doesn't store its contents. Writes and copies are ignored and reads return zeroes. Locking
+	 * provides temporary memory that is released on unlock.
+	 */
+	class NullHardwareBuffer : public HardwareBuffer
+	{
+	public:
+		NullHardwareBuffer(UINT32 size, GpuBufferUsage usage);
+		~NullHardwareBuffer();
+
+		/** @copydoc HardwareBuffer::readData */
+		void readData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override;
+
+		/** @copydoc HardwareBuffer::writeData */
+		void writeData(UINT32 offset, UINT32 length, const void* source,
+			BufferWriteType writeFlags = BWT_NORMAL, UINT32 queueIdx = 0) override { }
+
+		/** @copydoc HardwareBuffer::copyData */
+		void copyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+			bool discardWholeBuffer = false, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+	protected:
+		/** @copydoc HardwareBuffer::map */
+		void* map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx) override;
+
+		/** @copydoc HardwareBuffer::unmap */
+		void unmap() override;
+
+		UINT8* mLockedData = nullptr;
+	};
+
+	/** Null implementation of a vertex buffer. */
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		NullVertexBuffer(const VERTEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+
+	protected:
+		/** @copydoc VertexBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** Null implementation of an index buffer. */
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(const INDEX_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+
+	protected:
+		/** @copydoc IndexBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** Null implementation of a generic GPU buffer. */
+	class NullGpuBuffer : public GpuBuffer
+	{
+	protected:
+		friend class NullHardwareBufferManager;
+
+		NullGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask);
+		NullGpuBuffer(const GPU_BUFFER_DESC& desc, SPtr<HardwareBuffer> underlyingBuffer);
+
+		/** @copydoc GpuBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** Null implementation of a GPU parameter buffer. */
+	class NullGpuParamBlockBuffer : public GpuParamBlockBuffer
+	{
+	public:
+		NullGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
+		~NullGpuParamBlockBuffer();
+
+	protected:
+		/** @copydoc GpuParamBlockBuffer::initialize */
+		void initialize() override;
+	};
+
+	/** @} */
+}}
+
+namespace bs
+{
+	IMPLEMENT_GLOBAL_POOL(ct::NullHardwareBuffer, 32)
+}
@@ -0,0 +1,56 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullHardwareBuffer.h"
+
+namespace bs { namespace ct
+{
+	SPtr<VertexBuffer> NullHardwareBufferManager::createVertexBufferInternal(const VERTEX_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullVertexBuffer> ret = bs_shared_ptr_new<NullVertexBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<IndexBuffer> NullHardwareBufferManager::createIndexBufferInternal(const INDEX_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullIndexBuffer> ret = bs_shared_ptr_new<NullIndexBuffer>(desc, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<GpuParamBlockBuffer> NullHardwareBufferManager::createGpuParamBlockBufferInternal(UINT32 size,
+		GpuBufferUsage usage, GpuDeviceFlags deviceMask)
+	{
+		SPtr<NullGpuParamBlockBuffer> ret = bs_shared_ptr_new<NullGpuParamBlockBuffer>(size, usage, deviceMask);
+		ret->_setThisPtr(ret);
+
+		return ret;
+	}
+
+	SPtr<GpuBuffer> NullHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+		GpuDeviceFlags deviceMask)
+	{
+		NullGpuBuffer* buffer = new (bs_alloc<NullGpuBuffer>()) NullGpuBuffer(desc, deviceMask);
+
+		SPtr<GpuBuffer> bufferPtr = bs_shared_ptr<NullGpuBuffer>(buffer);
+		bufferPtr->_setThisPtr(bufferPtr);
+
+		return bufferPtr;
+	}
+
+	SPtr<GpuBuffer> NullHardwareBufferManager::createGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+		SPtr<HardwareBuffer> underlyingBuffer)
+	{
+		NullGpuBuffer* buffer = new (bs_alloc<NullGpuBuffer>()) NullGpuBuffer(desc, std::move(underlyingBuffer));
+
+		SPtr<GpuBuffer> bufferPtr = bs_shared_ptr<NullGpuBuffer>(buffer);
+		bufferPtr->_setThisPtr(bufferPtr);
+
+		return bufferPtr;
+	}
+}}
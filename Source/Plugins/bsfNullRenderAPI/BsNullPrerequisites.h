@@ -0,0 +1,32 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+/** @addtogroup Plugins
+ *  @{
+ */
+
+/** @defgroup NullRenderAPI NullRenderAPI
+ *	Render API that performs no rendering and creates no GPU resources. Used for running the framework headless, such
+ *	as on dedicated servers or for automated tests.
+ */
+
+/** @} */
+
+namespace bs
+{
+	class NullRenderWindow;
+	class NullRenderTexture;
+
+	namespace ct
+	{
+	class NullRenderAPI;
+	class NullRenderWindow;
+	class NullRenderTexture;
+	class NullTexture;
+	class NullHardwareBuffer;
+	class NullCommandBuffer;
+	}
+}
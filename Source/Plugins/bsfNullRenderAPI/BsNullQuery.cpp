@@ -0,0 +1,37 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullQuery.h"
+
+namespace bs { namespace ct
+{
+	void NullEventQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		setActive(true);
+	}
+
+	void NullTimerQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = false;
+		setActive(true);
+	}
+
+	void NullTimerQuery::end(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = true;
+	}
+
+	NullOcclusionQuery::NullOcclusionQuery(bool binary)
+		: OcclusionQuery(binary)
+	{ }
+
+	void NullOcclusionQuery::begin(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = false;
+		setActive(true);
+	}
+
+	void NullOcclusionQuery::end(const SPtr<CommandBuffer>& cb)
+	{
+		mEndIssued = true;
+	}
+}}
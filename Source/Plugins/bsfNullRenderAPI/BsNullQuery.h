@@ -0,0 +1,73 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsEventQuery.h"
+#include "RenderAPI/BsTimerQuery.h"
+#include "RenderAPI/BsOcclusionQuery.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/** Event query that is ready as soon as it is issued. */
+	class NullEventQuery : public EventQuery
+	{
+	public:
+		/** @copydoc EventQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc EventQuery::isReady */
+		bool isReady() const override { return true; }
+	};
+
+	/** Timer query that is ready as soon as it is ended, and always reports zero elapsed time. */
+	class NullTimerQuery : public TimerQuery
+	{
+	public:
+		/** @copydoc TimerQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc TimerQuery::end */
+		void end(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc TimerQuery::isReady */
+		bool isReady() const override { return mEndIssued; }
+
+		/** @copydoc TimerQuery::getTimeMs */
+		float getTimeMs() override { return 0.0f; }
+
+	private:
+		bool mEndIssued = false;
+	};
+
+	/**
+	 * Occlusion query that is ready as soon as it is ended. Nothing is ever rendered, but binary queries report the
+	 * object as visible so code relying on them doesn't cull everything.
+	 */
+	class NullOcclusionQuery : public OcclusionQuery
+	{
+	public:
+		NullOcclusionQuery(bool binary);
+
+		/** @copydoc OcclusionQuery::begin */
+		void begin(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc OcclusionQuery::end */
+		void end(const SPtr<CommandBuffer>& cb = nullptr) override;
+
+		/** @copydoc OcclusionQuery::isReady */
+		bool isReady() const override { return mEndIssued; }
+
+		/** @copydoc OcclusionQuery::getNumSamples */
+		UINT32 getNumSamples() override { return mBinary ? 1 : 0; }
+
+	private:
+		bool mEndIssued = false;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,252 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderAPI.h"
+#include "BsNullHardwareBufferManager.h"
+#include "BsNullTextureManager.h"
+#include "BsNullRenderWindowManager.h"
+#include "BsNullQueryManager.h"
+#include "BsNullCommandBufferManager.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Managers/BsRenderStateManager.h"
+#include "RenderAPI/BsGpuParamDesc.h"
+#include "RenderAPI/BsGpuParams.h"
+#include "RenderAPI/BsRenderTarget.h"
+#include "RenderAPI/BsVideoModeInfo.h"
+#include "Profiling/BsRenderStats.h"
+#include "Utility/BsPlatformUtility.h"
+
+namespace bs { namespace ct
+{
+	/** Per-stage resource limits reported by the null device. Generous, so no renderer features get disabled. */
+	static constexpr UINT16 NUM_TEXTURE_UNITS = 128;
+	static constexpr UINT16 NUM_PARAM_BLOCK_BUFFERS = 14;
+	static constexpr UINT16 NUM_LOAD_STORE_TEXTURE_UNITS = 8;
+
+	const StringID& NullRenderAPI::getName() const
+	{
+		static StringID strName("NullRenderAPI");
+		return strName;
+	}
+
+	void NullRenderAPI::initialize()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		// No outputs to report
+		mVideoModeInfo = bs_shared_ptr_new<VideoModeInfo>();
+
+		GPUInfo gpuInfo;
+		gpuInfo.numGPUs = 1;
+		gpuInfo.names[0] = "Null";
+
+		PlatformUtility::_setGPUInfo(gpuInfo);
+
+		CommandBufferManager::startUp<NullCommandBufferManager>();
+
+		bs::TextureManager::startUp<bs::NullTextureManager>();
+		TextureManager::startUp<NullTextureManager>();
+
+		bs::HardwareBufferManager::startUp();
+		HardwareBufferManager::startUp<NullHardwareBufferManager>();
+
+		bs::RenderWindowManager::startUp<bs::NullRenderWindowManager>();
+		RenderWindowManager::startUp();
+
+		QueryManager::startUp<NullQueryManager>();
+		RenderStateManager::startUp();
+
+		mNumDevices = 1;
+		mCurrentCapabilities = bs_newN<RenderAPICapabilities>(mNumDevices);
+		initCapabilities(mCurrentCapabilities[0]);
+
+		RenderAPI::initialize();
+	}
+
+	void NullRenderAPI::destroyCore()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		RenderStateManager::shutDown();
+		QueryManager::shutDown();
+		RenderWindowManager::shutDown();
+		bs::RenderWindowManager::shutDown();
+		HardwareBufferManager::shutDown();
+		bs::HardwareBufferManager::shutDown();
+		TextureManager::shutDown();
+		bs::TextureManager::shutDown();
+		CommandBufferManager::shutDown();
+
+		RenderAPI::destroyCore();
+	}
+
+	void NullRenderAPI::swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+		target->swapBuffers(syncMask);
+
+		BS_INC_RENDER_STAT(NumPresents);
+	}
+
+	void NullRenderAPI::setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags,
+		RenderSurfaceMask loadMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		mActiveRenderTarget = target;
+	}
+
+	void NullRenderAPI::clearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::clearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+		UINT8 targetMask, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		// Do nothing
+	}
+
+	void NullRenderAPI::convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest)
+	{
+		dest = matrix;
+
+		// Convert depth range from [-1,+1] to [0,1]
+		dest[2][0] = (dest[2][0] + dest[3][0]) / 2;
+		dest[2][1] = (dest[2][1] + dest[3][1]) / 2;
+		dest[2][2] = (dest[2][2] + dest[3][2]) / 2;
+		dest[2][3] = (dest[2][3] + dest[3][3]) / 2;
+	}
+
+	const RenderAPIInfo& NullRenderAPI::getAPIInfo() const
+	{
+		RenderAPIFeatures featureFlags =
+			RenderAPIFeatureFlag::TextureViews |
+			RenderAPIFeatureFlag::Compute |
+			RenderAPIFeatureFlag::LoadStore |
+			RenderAPIFeatureFlag::RenderTargetLayers;
+
+		static RenderAPIInfo info(0.0f, 0.0f, 0.0f, 1.0f, VET_COLOR_ABGR, featureFlags);
+
+		return info;
+	}
+
+	// Uses the same layout rules as D3D11 constant buffers, so CPU side parameter buffers look the same as usual
+	GpuParamBlockDesc NullRenderAPI::generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params)
+	{
+		GpuParamBlockDesc block;
+		block.blockSize = 0;
+		block.isShareable = true;
+		block.name = name;
+		block.slot = 0;
+		block.set = 0;
+
+		for (auto& param : params)
+		{
+			const GpuParamDataTypeInfo& typeInfo = bs::GpuParams::PARAM_SIZES.lookup[param.type];
+
+			if (param.arraySize > 1)
+			{
+				// Arrays perform no packing and their elements are always padded and aligned to four component vectors
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+				else
+					size = Math::divideAndRoundUp(typeInfo.size, 16U) * 4;
+
+				block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				// Last array element isn't rounded up to four component vectors unless it's a struct
+				if(param.type != GPDT_STRUCT)
+				{
+					block.blockSize += size * (param.arraySize - 1);
+					block.blockSize += typeInfo.size / 4;
+				}
+				else
+					block.blockSize += param.arraySize * size;
+			}
+			else
+			{
+				UINT32 size;
+				if(param.type == GPDT_STRUCT)
+				{
+					// Structs are always aligned and arounded up to 4 component vectors
+					size = Math::divideAndRoundUp(param.elementSize, 16U) * 4;
+					block.blockSize = Math::divideAndRoundUp(block.blockSize, 4U) * 4;
+				}
+				else
+				{
+					size = typeInfo.baseTypeSize * (typeInfo.numRows * typeInfo.numColumns) / 4;
+
+					// Pack everything as tightly as possible as long as the data doesn't cross 16 byte boundary
+					UINT32 alignOffset = block.blockSize % 4;
+					if (alignOffset != 0 && size > (4 - alignOffset))
+					{
+						UINT32 padding = (4 - alignOffset);
+						block.blockSize += padding;
+					}
+				}
+
+				param.elementSize = size;
+				param.arrayElementStride = size;
+				param.cpuMemOffset = block.blockSize;
+				param.gpuMemOffset = 0;
+
+				block.blockSize += size;
+			}
+
+			param.paramBlockSlot = 0;
+			param.paramBlockSet = 0;
+		}
+
+		// Constant buffer size must always be a multiple of 16
+		if (block.blockSize % 4 != 0)
+			block.blockSize += (4 - (block.blockSize % 4));
+
+		return block;
+	}
+
+	void NullRenderAPI::initCapabilities(RenderAPICapabilities& caps) const
+	{
+		DriverVersion driverVersion;
+		driverVersion.major = 1;
+
+		caps.setDriverVersion(driverVersion);
+		caps.setDeviceName("Null");
+		caps.setVendor(GPU_UNKNOWN);
+		caps.setRenderAPIName(getName());
+
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_BC);
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_ETC2);
+		caps.setCapability(RSC_TEXTURE_COMPRESSION_ASTC);
+		caps.setCapability(RSC_GEOMETRY_PROGRAM);
+		caps.setCapability(RSC_TESSELLATION_PROGRAM);
+		caps.setCapability(RSC_COMPUTE_PROGRAM);
+		caps.setCapability(RSC_DRAW_INDIRECT);
+		caps.setCapability(RSC_MULTI_DRAW_INDIRECT);
+
+		caps.setMaxBoundVertexBuffers(BS_MAX_BOUND_VERTEX_BUFFERS);
+		caps.setNumMultiRenderTargets(BS_MAX_MULTIPLE_RENDER_TARGETS);
+		caps.setGeometryProgramNumOutputVertices(1024);
+
+		const GpuProgramType programTypes[] = { GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM, GPT_GEOMETRY_PROGRAM,
+			GPT_HULL_PROGRAM, GPT_DOMAIN_PROGRAM, GPT_COMPUTE_PROGRAM };
+
+		for(auto& type : programTypes)
+		{
+			caps.setNumTextureUnits(type, NUM_TEXTURE_UNITS);
+			caps.setNumGpuParamBlockBuffers(type, NUM_PARAM_BLOCK_BUFFERS);
+		}
+
+		caps.setNumLoadStoreTextureUnits(GPT_FRAGMENT_PROGRAM, NUM_LOAD_STORE_TEXTURE_UNITS);
+		caps.setNumLoadStoreTextureUnits(GPT_COMPUTE_PROGRAM, NUM_LOAD_STORE_TEXTURE_UNITS);
+
+		const UINT32 numStages = sizeof(programTypes) / sizeof(programTypes[0]);
+		caps.setNumCombinedTextureUnits((UINT16)(NUM_TEXTURE_UNITS * numStages));
+		caps.setNumCombinedGpuParamBlockBuffers((UINT16)(NUM_PARAM_BLOCK_BUFFERS * numStages));
+		caps.setNumCombinedLoadStoreTextureUnits(NUM_LOAD_STORE_TEXTURE_UNITS * 2);
+	}
+}}
@@ -0,0 +1,132 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "RenderAPI/BsRenderAPI.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**
+	 * Render API that accepts all commands and executes none of them. Textures and buffers it creates don't allocate
+	 * GPU (or any other) memory for their contents, and reading them back returns zeroes. Resources that need their
+	 * contents to be accessible should be created with CPU caching enabled, in which case their data is kept on the
+	 * simulation thread as usual.
+	 */
+	class NullRenderAPI : public RenderAPI
+	{
+	public:
+		NullRenderAPI() = default;
+		~NullRenderAPI() = default;
+
+		/** @copydoc RenderAPI::getName() */
+		const StringID& getName() const override;
+
+		/** @copydoc RenderAPI::setGraphicsPipeline */
+		void setGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setComputePipeline */
+		void setComputePipeline(const SPtr<ComputePipelineState>& pipelineState,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setGpuParams() */
+		void setGpuParams(const SPtr<GpuParams>& gpuParams,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setViewport() */
+		void setViewport(const Rect2& area, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setScissorRect() */
+		void setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setStencilRef */
+		void setStencilRef(UINT32 value, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setVertexBuffers() */
+		void setVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setIndexBuffer() */
+		void setIndexBuffer(const SPtr<IndexBuffer>& buffer,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setVertexDeclaration() */
+		void setVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::setDrawOperation() */
+		void setDrawOperation(DrawOperationType op, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::draw() */
+		void draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::drawIndexed() */
+		void drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount
+			, UINT32 instanceCount = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::dispatchCompute() */
+		void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1, 
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::drawIndirect */
+		void drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::drawIndexedIndirect */
+		void drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::dispatchComputeIndirect */
+		void dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override { }
+
+		/** @copydoc RenderAPI::swapBuffers() */
+		void swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask = 0xFFFFFFFF) override;
+
+		/** @copydoc RenderAPI::setRenderTarget() */
+		void setRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags = 0, 
+			RenderSurfaceMask loadMask = RT_NONE, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::clearRenderTarget() */
+		void clearRenderTarget(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f,
+			UINT16 stencil = 0, UINT8 targetMask = 0xFF, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::clearViewport() */
+		void clearViewport(UINT32 buffers, const Color& color = Color::Black, float depth = 1.0f,
+			UINT16 stencil = 0, UINT8 targetMask = 0xFF, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::addCommands() */
+		void addCommands(const SPtr<CommandBuffer>& commandBuffer, const SPtr<CommandBuffer>& secondary) override { }
+
+		/** @copydoc RenderAPI::submitCommandBuffer() */
+		void submitCommandBuffer(const SPtr<CommandBuffer>& commandBuffer, UINT32 syncMask = 0xFFFFFFFF) override { }
+
+		/** @copydoc RenderAPI::convertProjectionMatrix() */
+		void convertProjectionMatrix(const Matrix4& matrix, Matrix4& dest) override;
+
+		/** @copydoc RenderAPI::getAPIInfo */
+		const RenderAPIInfo& getAPIInfo() const override;
+
+		/** @copydoc RenderAPI::generateParamBlockDesc() */
+		GpuParamBlockDesc generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params) override;
+
+	protected:
+		/** @copydoc RenderAPI::initialize */
+		void initialize() override;
+
+		/** @copydoc RenderAPI::destroyCore */
+		void destroyCore() override;
+
+		/** Fills out the capabilities of the non-existent device, generous enough not to disable any features. */
+		void initCapabilities(RenderAPICapabilities& caps) const;
+	};
+
+	/** @} */
+}}
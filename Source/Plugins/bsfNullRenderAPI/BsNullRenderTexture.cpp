@@ -0,0 +1,17 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderTexture.h"
+
+namespace bs
+{
+	NullRenderTexture::NullRenderTexture(const RENDER_TEXTURE_DESC& desc)
+		: RenderTexture(desc), mProperties(desc, false)
+	{ }
+
+	namespace ct
+	{
+	NullRenderTexture::NullRenderTexture(const RENDER_TEXTURE_DESC& desc, UINT32 deviceIdx)
+		: RenderTexture(desc, deviceIdx), mProperties(desc, false)
+	{ }
+	}
+}
@@ -0,0 +1,15 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderWindowManager.h"
+#include "BsNullRenderWindow.h"
+
+namespace bs
+{
+	SPtr<RenderWindow> NullRenderWindowManager::createImpl(RENDER_WINDOW_DESC& desc, UINT32 windowId,
+		const SPtr<RenderWindow>& parentWindow)
+	{
+		NullRenderWindow* window = new (bs_alloc<NullRenderWindow>()) NullRenderWindow(desc, windowId);
+
+		return bs_core_ptr<NullRenderWindow>(window);
+	}
+}
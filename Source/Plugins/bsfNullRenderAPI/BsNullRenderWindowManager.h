@@ -0,0 +1,24 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullPrerequisites.h"
+#include "Managers/BsRenderWindowManager.h"
+
+namespace bs
+{
+	/** @addtogroup NullRenderAPI
+	 *  @{
+	 */
+
+	/**	Manager that handles creation of null render windows. */
+	class NullRenderWindowManager : public RenderWindowManager
+	{
+	protected:
+		/** @copydoc RenderWindowManager::createImpl() */
+		SPtr<RenderWindow> createImpl(RENDER_WINDOW_DESC& desc, UINT32 windowId,
+			const SPtr<RenderWindow>& parentWindow) override;
+	};
+
+	/** @} */
+}
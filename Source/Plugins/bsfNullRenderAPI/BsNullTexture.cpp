@@ -0,0 +1,44 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullTexture.h"
+
+namespace bs { namespace ct
+{
+	NullTexture::NullTexture(const TEXTURE_DESC& desc, const SPtr<PixelData>& initialData, GpuDeviceFlags deviceMask)
+		: Texture(desc, initialData, deviceMask)
+	{ }
+
+	NullTexture::~NullTexture()
+	{
+		if (mLockedData)
+			bs_free(mLockedData);
+	}
+
+	PixelData NullTexture::lockImpl(GpuLockOptions options, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx,
+		UINT32 queueIdx)
+	{
+		UINT32 mipWidth = std::max(1u, mProperties.getWidth() >> mipLevel);
+		UINT32 mipHeight = std::max(1u, mProperties.getHeight() >> mipLevel);
+		UINT32 mipDepth = std::max(1u, mProperties.getDepth() >> mipLevel);
+
+		PixelData lockedArea(mipWidth, mipHeight, mipDepth, mProperties.getFormat());
+
+		const UINT32 size = lockedArea.getSize();
+		mLockedData = (UINT8*)bs_alloc(size);
+		memset(mLockedData, 0, size);
+
+		lockedArea.setExternalBuffer(mLockedData);
+		return lockedArea;
+	}
+
+	void NullTexture::unlockImpl()
+	{
+		bs_free(mLockedData);
+		mLockedData = nullptr;
+	}
+
+	void NullTexture::readDataImpl(PixelData& dest, UINT32 mipLevel, UINT32 face, UINT32 deviceIdx, UINT32 queueIdx)
+	{
+		memset(dest.getData(), 0, dest.getSize());
+	}
+}}
@@ -0,0 +1,40 @@
+set(BS_NULLRENDERAPI_INC_NOFILTER
+	"BsNullCommandBuffer.h"
+	"BsNullCommandBufferManager.h"
+	"BsNullHardwareBuffer.h"
+	"BsNullHardwareBufferManager.h"
+	"BsNullPrerequisites.h"
+	"BsNullQuery.h"
+	"BsNullQueryManager.h"
+	"BsNullRenderAPI.h"
+	"BsNullRenderAPIFactory.h"
+	"BsNullRenderTexture.h"
+	"BsNullRenderWindow.h"
+	"BsNullRenderWindowManager.h"
+	"BsNullTexture.h"
+	"BsNullTextureManager.h"
+)
+
+set(BS_NULLRENDERAPI_SRC_NOFILTER
+	"BsNullCommandBuffer.cpp"
+	"BsNullCommandBufferManager.cpp"
+	"BsNullHardwareBuffer.cpp"
+	"BsNullHardwareBufferManager.cpp"
+	"BsNullPlugin.cpp"
+	"BsNullQuery.cpp"
+	"BsNullQueryManager.cpp"
+	"BsNullRenderAPI.cpp"
+	"BsNullRenderAPIFactory.cpp"
+	"BsNullRenderTexture.cpp"
+	"BsNullRenderWindow.cpp"
+	"BsNullRenderWindowManager.cpp"
+	"BsNullTexture.cpp"
+	"BsNullTextureManager.cpp"
+)
+
+source_group("" FILES ${BS_NULLRENDERAPI_INC_NOFILTER} ${BS_NULLRENDERAPI_SRC_NOFILTER})
+
+set(BS_NULLRENDERAPI_SRC
+	${BS_NULLRENDERAPI_INC_NOFILTER}
+	${BS_NULLRENDERAPI_SRC_NOFILTER}
+)
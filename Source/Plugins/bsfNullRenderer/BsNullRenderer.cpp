@@ -0,0 +1,46 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsNullRenderer.h"
+#include "CoreThread/BsCoreThread.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Profiling/BsProfilerGPU.h"
+
+namespace bs { namespace ct
+{
+	const StringID& NullRenderer::getName() const
+	{
+		static StringID name = "NullRenderer";
+		return name;
+	}
+
+	void NullRenderer::destroy()
+	{
+		Renderer::destroy();
+
+		gCoreThread().queueCommand(std::bind(&NullRenderer::destroyCore, this));
+		gCoreThread().submit(true);
+	}
+
+	void NullRenderer::renderAll(PerFrameData perFrameData)
+	{
+		// Sync all dirty sim thread CoreObject data to core thread
+		PROFILE_CALL(CoreObjectManager::instance().syncToCore(), "Sync to core")
+
+		gCoreThread().queueCommand(std::bind(&NullRenderer::renderAllCore, this));
+	}
+
+	void NullRenderer::renderAllCore()
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		gProfilerGPU().beginFrame();
+		processTasks(false);
+		gProfilerGPU().endFrame();
+	}
+
+	void NullRenderer::destroyCore()
+	{
+		processTasks(true);
+	}
+}}
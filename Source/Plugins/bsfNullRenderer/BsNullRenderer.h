@@ -0,0 +1,50 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullRendererPrerequisites.h"
+#include "Renderer/BsRenderer.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup NullRenderer
+	 *  @{
+	 */
+
+	/**
+	 * Renderer that ignores all scene objects and renders nothing. Dirty core objects are still synced to the core
+	 * thread every frame, and queued renderer tasks are still executed, so code waiting on either keeps working.
+	 */
+	class NullRenderer : public Renderer
+	{
+	public:
+		NullRenderer() = default;
+		~NullRenderer() = default;
+
+		/** @copydoc Renderer::getName */
+		const StringID& getName() const override;
+
+		/** @copydoc Renderer::destroy */
+		void destroy() override;
+
+		/** @copydoc Renderer::renderAll */
+		void renderAll(PerFrameData perFrameData) override;
+
+		/** @copydoc Renderer::captureSceneCubeMap */
+		void captureSceneCubeMap(const SPtr<Texture>& cubemap, const Vector3& position,
+			const CaptureSettings& settings) override { }
+
+		/** @copydoc Renderer::captureSceneCubeMapFace */
+		void captureSceneCubeMapFace(const SPtr<Texture>& cubemap, UINT32 face, const Vector3& position,
+			const CaptureSettings& settings) override { }
+
+	private:
+		/** Executes any queued renderer tasks. Called once per frame. Core thread only. */
+		void renderAllCore();
+
+		/** Finishes any remaining renderer tasks before the renderer is destroyed. Core thread only. */
+		void destroyCore();
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,28 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsNullRendererPrerequisites.h"
+#include "Renderer/BsRendererFactory.h"
+
+namespace bs
+{
+	/** @addtogroup NullRenderer
+	 *  @{
+	 */
+
+	/** Renderer factory implementation that creates the null renderer. Used by the RendererManager. */
+	class NullRendererFactory : public RendererFactory
+	{
+	public:
+		static constexpr const char* SystemName = "bsfNullRenderer";
+
+		/** @copydoc RendererFactory::create */
+		SPtr<ct::Renderer> create() override;
+
+		/** @copydoc RendererFactory::name */
+		const String& name() const override;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,21 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+
+/** @addtogroup Plugins
+ *  @{
+ */
+
+/** @defgroup NullRenderer NullRenderer
+ *	Renderer that keeps the scene and the core thread in sync, but doesn't render anything. Meant to be used together
+ *	with the null render API when running headless.
+ */
+
+/** @} */
+
+namespace bs { namespace ct
+{
+	class NullRenderer;
+}}
@@ -0,0 +1,18 @@
+set(BS_NULLRENDERER_INC_NOFILTER
+	"BsNullRenderer.h"
+	"BsNullRendererFactory.h"
+	"BsNullRendererPrerequisites.h"
+)
+
+set(BS_NULLRENDERER_SRC_NOFILTER
+	"BsNullRenderer.cpp"
+	"BsNullRendererFactory.cpp"
+	"BsNullRendererPlugin.cpp"
+)
+
+source_group("" FILES ${BS_NULLRENDERER_INC_NOFILTER} ${BS_NULLRENDERER_SRC_NOFILTER})
+
+set(BS_NULLRENDERER_SRC
+	${BS_NULLRENDERER_INC_NOFILTER}
+	${BS_NULLRENDERER_SRC_NOFILTER}
+)
@@ -0,0 +1,156 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsADPCMDecoder.h"
+#include "FileSystem/BsDataStream.h"
+#include "Math/BsMath.h"
+
+namespace bs
+{
+	static const INT32 ADPCM_STEP_TABLE[89] =
+	{
+		7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+		107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+		876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+		5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+		27086, 29794, 32767
+	};
+
+	static const INT32 ADPCM_INDEX_TABLE[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+	bool ADPCMDecoder::isValid(const SPtr<DataStream>& stream, UINT32 offset)
+	{
+		stream->seek(offset);
+
+		ADPCMHeader header;
+		if (stream->read(&header, sizeof(header)) != sizeof(header))
+			return false;
+
+		return header.magic == ADPCM_MAGIC && header.numChannels > 0 && header.framesPerBlock == ADPCM_BLOCK_FRAMES;
+	}
+
+	bool ADPCMDecoder::open(const SPtr<DataStream>& stream, AudioDataInfo& info, UINT32 offset)
+	{
+		if (stream == nullptr || !isValid(stream, offset))
+		{
+			LOGERR("Failed to open ADPCM data.");
+			return false;
+		}
+
+		ADPCMHeader header;
+		stream->seek(offset);
+		stream->read(&header, sizeof(header));
+
+		mStream = stream;
+		mDataOffset = offset + sizeof(ADPCMHeader);
+		mNumChannels = header.numChannels;
+		mNumFrames = header.numFrames;
+		mBlockSize = getBlockSize(mNumChannels);
+
+		mBlockData.resize(mBlockSize);
+		mDecodedBlock.resize(ADPCM_BLOCK_FRAMES * mNumChannels);
+		mDecodedBlockIdx = (UINT32)-1;
+		mFrame = 0;
+
+		info.numChannels = header.numChannels;
+		info.sampleRate = header.sampleRate;
+		info.numSamples = header.numFrames * header.numChannels;
+		info.bitDepth = 16;
+
+		return true;
+	}
+
+	void ADPCMDecoder::seek(UINT32 offset)
+	{
+		mFrame = std::min(offset / mNumChannels, mNumFrames);
+	}
+
+	UINT32 ADPCMDecoder::read(UINT8* samples, UINT32 numSamples)
+	{
+		INT16* output = (INT16*)samples;
+
+		UINT32 numFramesToRead = std::min(numSamples / mNumChannels, mNumFrames - mFrame);
+		const UINT32 numFramesRead = numFramesToRead;
+
+		// Only the blocks overlapping the requested range are read and decoded
+		while (numFramesToRead > 0)
+		{
+			const UINT32 blockIdx = mFrame / ADPCM_BLOCK_FRAMES;
+			const UINT32 frameInBlock = mFrame % ADPCM_BLOCK_FRAMES;
+			const UINT32 numFrames = std::min(numFramesToRead, ADPCM_BLOCK_FRAMES - frameInBlock);
+
+			decodeBlock(blockIdx);
+			memcpy(output, &mDecodedBlock[frameInBlock * mNumChannels], numFrames * mNumChannels * sizeof(INT16));
+
+			output += numFrames * mNumChannels;
+			mFrame += numFrames;
+			numFramesToRead -= numFrames;
+		}
+
+		return numFramesRead * mNumChannels;
+	}
+
+	void ADPCMDecoder::decodeBlock(UINT32 blockIdx)
+	{
+		if (blockIdx == mDecodedBlockIdx)
+			return;
+
+		mStream->seek(mDataOffset + blockIdx * mBlockSize);
+		mStream->read(mBlockData.data(), mBlockSize);
+
+		const UINT8* blockData = mBlockData.data();
+		const UINT8* sampleData = blockData + mNumChannels * 4;
+		for (UINT32 i = 0; i < mNumChannels; i++)
+		{
+			ADPCMChannelState state;
+			state.predictor = (INT16)(blockData[i * 4] | (blockData[i * 4 + 1] << 8));
+			state.stepIndex = Math::clamp((INT32)blockData[i * 4 + 2], 0, 88);
+
+			const UINT8* channelData = sampleData + i * (ADPCM_BLOCK_FRAMES / 2);
+			INT16* output = &mDecodedBlock[i];
+			for (UINT32 j = 0; j < ADPCM_BLOCK_FRAMES / 2; j++)
+			{
+				output[0] = decodeSample(state, channelData[j] & 0xF);
+				output[mNumChannels] = decodeSample(state, channelData[j] >> 4);
+
+				output += mNumChannels * 2;
+			}
+		}
+
+		mDecodedBlockIdx = blockIdx;
+	}
+
+	UINT32 ADPCMDecoder::getBlockSize(UINT32 numChannels)
+	{
+		return numChannels * (4 + ADPCM_BLOCK_FRAMES / 2);
+	}
+
+	INT16 ADPCMDecoder::decodeSample(ADPCMChannelState& state, UINT8 nibble)
+	{
+		const INT32 step = ADPCM_STEP_TABLE[state.stepIndex];
+
+		INT32 diff = step >> 3;
+		if (nibble & 4)
+			diff += step;
+
+		if (nibble & 2)
+			diff += step >> 1;
+
+		if (nibble & 1)
+			diff += step >> 2;
+
+		if (nibble & 8)
+			state.predictor -= diff;
+		else
+			state.predictor += diff;
+
+		state.predictor = Math::clamp(state.predictor, -32768, 32767);
+		state.stepIndex = Math::clamp(state.stepIndex + ADPCM_INDEX_TABLE[nibble], 0, 88);
+
+		return (INT16)state.predictor;
+	}
+
+	INT32 ADPCMDecoder::getStep(INT32 stepIndex)
+	{
+		return ADPCM_STEP_TABLE[stepIndex];
+	}
+}
@@ -0,0 +1,83 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsOAPrerequisites.h"
+#include "BsAudioDecoder.h"
+
+namespace bs
+{
+	/** @addtogroup OpenAudio
+	 *  @{
+	 */
+
+	/**
+	 * Header at the start of ADPCM audio data. The header is followed by fixed size blocks of IMA ADPCM samples, each
+	 * holding ADPCM_BLOCK_FRAMES frames. Every block starts with the decoder state of every channel, followed by the
+	 * 4-bit samples of each channel, so any block can be located and decoded without decoding the blocks before it.
+	 */
+	struct ADPCMHeader
+	{
+		UINT32 magic;
+		UINT16 numChannels;
+		UINT16 framesPerBlock;
+		UINT32 sampleRate;
+		UINT32 numFrames;
+	};
+
+	/** Identifier stored in ADPCMHeader::magic. */
+	static constexpr UINT32 ADPCM_MAGIC = 0x50444142; // "BADP"
+
+	/** Number of frames (samples of every channel) in a single ADPCM block. */
+	static constexpr UINT32 ADPCM_BLOCK_FRAMES = 1024;
+
+	/** Decoder state of a single ADPCM channel. */
+	struct ADPCMChannelState
+	{
+		INT32 predictor = 0;
+		INT32 stepIndex = 0;
+	};
+
+	/** Decodes block-indexed IMA ADPCM audio data into 16-bit PCM. */
+	class ADPCMDecoder : public AudioDecoder
+	{
+	public:
+		/** @copydoc AudioDecoder::open */
+		bool open(const SPtr<DataStream>& stream, AudioDataInfo& info, UINT32 offset = 0) override;
+
+		/** @copydoc AudioDecoder::read */
+		UINT32 read(UINT8* samples, UINT32 numSamples) override;
+
+		/** @copydoc AudioDecoder::seek */
+		void seek(UINT32 offset) override;
+
+		/** @copydoc AudioDecoder::isValid */
+		bool isValid(const SPtr<DataStream>& stream, UINT32 offset = 0) override;
+
+		/** Returns the size of a single block, in bytes. */
+		static UINT32 getBlockSize(UINT32 numChannels);
+
+		/** Decodes a single 4-bit sample, advancing the channel state. Returns the decoded 16-bit sample. */
+		static INT16 decodeSample(ADPCMChannelState& state, UINT8 nibble);
+
+		/** Returns the quantizer step for the provided step index. */
+		static INT32 getStep(INT32 stepIndex);
+
+	private:
+		/** Decodes the block at the provided index, unless it's already decoded. */
+		void decodeBlock(UINT32 blockIdx);
+
+		SPtr<DataStream> mStream;
+		UINT32 mDataOffset = 0;
+		UINT32 mNumChannels = 0;
+		UINT32 mNumFrames = 0;
+		UINT32 mBlockSize = 0;
+		UINT32 mFrame = 0;
+
+		Vector<UINT8> mBlockData;
+		Vector<INT16> mDecodedBlock;
+		UINT32 mDecodedBlockIdx = (UINT32)-1;
+	};
+
+	/** @} */
+}
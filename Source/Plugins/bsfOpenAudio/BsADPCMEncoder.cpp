@@ -0,0 +1,102 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsADPCMEncoder.h"
+
+namespace bs
+{
+	UINT8* ADPCMEncoder::PCMToADPCM(UINT8* samples, const AudioDataInfo& info, UINT32& size)
+	{
+		assert(info.bitDepth == 16 && info.numChannels > 0);
+
+		const UINT32 numChannels = info.numChannels;
+		const UINT32 numFrames = info.numSamples / numChannels;
+		const UINT32 numBlocks = (numFrames + ADPCM_BLOCK_FRAMES - 1) / ADPCM_BLOCK_FRAMES;
+		const UINT32 blockSize = ADPCMDecoder::getBlockSize(numChannels);
+
+		size = sizeof(ADPCMHeader) + numBlocks * blockSize;
+		UINT8* output = (UINT8*)bs_alloc(size);
+		memset(output, 0, size);
+
+		ADPCMHeader header;
+		header.magic = ADPCM_MAGIC;
+		header.numChannels = (UINT16)numChannels;
+		header.framesPerBlock = (UINT16)ADPCM_BLOCK_FRAMES;
+		header.sampleRate = info.sampleRate;
+		header.numFrames = numFrames;
+		memcpy(output, &header, sizeof(header));
+
+		const INT16* input = (const INT16*)samples;
+
+		// Start from the first sample so the first block doesn't need to ramp up from silence
+		Vector<ADPCMChannelState> states(numChannels);
+		for (UINT32 i = 0; i < numChannels && numFrames > 0; i++)
+			states[i].predictor = input[i];
+
+		for (UINT32 i = 0; i < numBlocks; i++)
+		{
+			UINT8* blockData = output + sizeof(ADPCMHeader) + i * blockSize;
+			UINT8* sampleData = blockData + numChannels * 4;
+
+			for (UINT32 j = 0; j < numChannels; j++)
+			{
+				ADPCMChannelState& state = states[j];
+
+				// State at the start of the block, so the block can be decoded on its own
+				const UINT16 predictor = (UINT16)(INT16)state.predictor;
+				blockData[j * 4 + 0] = (UINT8)(predictor & 0xFF);
+				blockData[j * 4 + 1] = (UINT8)(predictor >> 8);
+				blockData[j * 4 + 2] = (UINT8)state.stepIndex;
+
+				UINT8* channelData = sampleData + j * (ADPCM_BLOCK_FRAMES / 2);
+				for (UINT32 k = 0; k < ADPCM_BLOCK_FRAMES; k++)
+				{
+					// Pad the last block by holding the last value
+					const UINT32 frame = i * ADPCM_BLOCK_FRAMES + k;
+					const INT32 sample = frame < numFrames ? input[frame * numChannels + j] : state.predictor;
+
+					const UINT8 nibble = encodeSample(state, sample);
+					if ((k & 1) == 0)
+						channelData[k / 2] = nibble;
+					else
+						channelData[k / 2] |= nibble << 4;
+				}
+			}
+		}
+
+		return output;
+	}
+
+	UINT8 ADPCMEncoder::encodeSample(ADPCMChannelState& state, INT32 sample)
+	{
+		INT32 step = ADPCMDecoder::getStep(state.stepIndex);
+		INT32 diff = sample - state.predictor;
+
+		UINT8 nibble = 0;
+		if (diff < 0)
+		{
+			nibble = 8;
+			diff = -diff;
+		}
+
+		if (diff >= step)
+		{
+			nibble |= 4;
+			diff -= step;
+		}
+
+		step >>= 1;
+		if (diff >= step)
+		{
+			nibble |= 2;
+			diff -= step;
+		}
+
+		step >>= 1;
+		if (diff >= step)
+			nibble |= 1;
+
+		// Advance the state exactly as the decoder will, so the two stay in sync
+		ADPCMDecoder::decodeSample(state, nibble);
+		return nibble;
+	}
+}
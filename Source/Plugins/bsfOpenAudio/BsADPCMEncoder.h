@@ -0,0 +1,35 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsOAPrerequisites.h"
+#include "BsADPCMDecoder.h"
+
+namespace bs
+{
+	/** @addtogroup OpenAudio
+	 *  @{
+	 */
+
+	/** Used for encoding PCM to block-indexed IMA ADPCM audio data, as described by ADPCMHeader. */
+	class ADPCMEncoder
+	{
+	public:
+		/**
+		 * Converts 16-bit PCM data to ADPCM data. ADPCM stores 4 bits per sample and can be decoded from any block, so
+		 * it is a good fit for short clips that are kept compressed in memory and played often.
+		 *
+		 * @param[in]	samples		Buffer containing samples in 16-bit signed PCM format, channel data interleaved.
+		 * @param[in]	info		Meta-data describing the provided samples. Bit depth must be 16.
+		 * @param[out]	size		Number of bytes written to the output buffer.
+		 * @return					Buffer containing the encoded samples, allocated using the general allocator.
+		 */
+		static UINT8* PCMToADPCM(UINT8* samples, const AudioDataInfo& info, UINT32& size);
+
+	private:
+		/** Encodes a 16-bit sample into a 4-bit sample, advancing the channel state the same way decoding would. */
+		static UINT8 encodeSample(ADPCMChannelState& state, INT32 sample);
+	};
+
+	/** @} */
+}
@@ -4,9 +4,13 @@
 #include "BsOAAudioClip.h"
 #include "BsOAAudioListener.h"
 #include "BsOAAudioSource.h"
+#include "BsOAAudioStream.h"
 #include "Math/BsMath.h"
 #include "Threading/BsTaskScheduler.h"
 #include "Audio/BsAudioUtility.h"
+#include "Audio/BsAudioDSPThread.h"
+#include "Utility/BsTime.h"
+#include "Utility/BsTimer.h"
 #include "AL/al.h"
 
 namespace bs
@@ -70,6 +74,14 @@ namespace bs
 	{
 		stopManualSources();
 
+		if (mStreamingTask != nullptr)
+			mStreamingTask->wait();
+
+		for (auto& task : mDecodeTasks)
+			task->wait();
+
+		setDSPGraph(nullptr);
+
 		assert(mListeners.empty() && mSources.empty()); // Everything should be destroyed at this point
 		clearContexts();
 
@@ -99,10 +111,43 @@ namespace bs
 
 		for (auto& source : mSources)
 			source->setGlobalPause(paused);
+
+		// Resumed by the streaming thread, once it has data queued
+		Lock lock(mDSPMutex);
+		if (mDSPSource != 0 && paused)
+		{
+			if (mContexts.size() > 1)
+				alcMakeContextCurrent(mContexts[0]);
+
+			alSourcePause(mDSPSource);
+		}
+	}
+
+	void OAAudio::setDSPGraph(const SPtr<AudioDSPGraph>& graph)
+	{
+		Lock lock(mDSPMutex);
+
+		destroyDSPOutput();
+		mDSPThread = nullptr;
+
+		if (graph == nullptr)
+			return;
+
+		if (graph->getNumChannels() != 1 && graph->getNumChannels() != 2)
+		{
+			LOGERR("Only mono and stereo DSP graphs can be played.");
+			return;
+		}
+
+		// Queued OpenAL buffers already provide the playback latency, the DSP thread only needs to keep them filled
+		mDSPThread = bs_shared_ptr_new<AudioDSPThread>(graph, DSP_BUFFER_FRAMES * 2);
+		createDSPOutput();
 	}
 
 	void OAAudio::_update()
 	{
+		updateVoices();
+
 		auto worker = [this]() { updateStreaming(); };
 
 		// If previous task still hasn't completed, just skip streaming this frame, queuing more tasks won't help
@@ -227,7 +272,10 @@ namespace bs
 	void OAAudio::rebuildContexts()
 	{
 		for (auto& source : mSources)
-			source->clear();
+		{
+			if (!source->isVirtual())
+				source->clear();
+		}
 
 		clearContexts();
 
@@ -251,11 +299,22 @@ namespace bs
 			listener->rebuild();
 
 		for (auto& source : mSources)
-			source->rebuild();
+		{
+			if (!source->isVirtual())
+				source->rebuild();
+		}
+
+		Lock lock(mDSPMutex);
+		createDSPOutput();
 	}
 
 	void OAAudio::clearContexts()
 	{
+		{
+			Lock lock(mDSPMutex);
+			destroyDSPOutput();
+		}
+
 		alcMakeContextCurrent(nullptr);
 
 		for (auto& context : mContexts)
@@ -264,6 +323,64 @@ namespace bs
 		mContexts.clear();
 	}
 
+	void OAAudio::updateVoices()
+	{
+		// Sources keep their voices, and virtual sources their position, while paused
+		if (mIsPaused)
+			return;
+
+		mListenerPositions.clear();
+		for (auto& listener : mListeners)
+			mListenerPositions.push_back(listener->getTransform().getPosition());
+
+		// Without any listeners OpenAL uses a default one, placed at the origin
+		if (mListenerPositions.empty())
+			mListenerPositions.push_back(Vector3::ZERO);
+
+		const float timeDelta = gTime().getFrameDelta();
+
+		mVoiceCandidates.clear();
+		for (auto& source : mSources)
+		{
+			if (source->isVirtual())
+				source->updateVirtual(timeDelta);
+
+			// Paused and stopped sources don't need a voice, they will grab a new one once they start playing again
+			if (source->getState() != AudioSourceState::Playing)
+			{
+				source->makeVirtual();
+				continue;
+			}
+
+			float audibility = source->getAudibility(mListenerPositions);
+			if (!source->isVirtual())
+				audibility *= VOICE_HYSTERESIS;
+
+			mVoiceCandidates.push_back({ source, audibility });
+		}
+
+		std::sort(mVoiceCandidates.begin(), mVoiceCandidates.end(),
+			[](const VoiceCandidate& a, const VoiceCandidate& b)
+		{
+			if (a.source->getPriority() != b.source->getPriority())
+				return a.source->getPriority() > b.source->getPriority();
+
+			return a.audibility > b.audibility;
+		});
+
+		const UINT32 numCandidates = (UINT32)mVoiceCandidates.size();
+		const UINT32 numVoices = std::min(numCandidates, mMaxVoices);
+
+		// Release voices first, so they can be reused by the sources being promoted
+		for (UINT32 i = numVoices; i < numCandidates; i++)
+			mVoiceCandidates[i].source->makeVirtual();
+
+		for (UINT32 i = 0; i < numVoices; i++)
+			mVoiceCandidates[i].source->makeReal();
+
+		mNumVirtualVoices = numCandidates - numVoices;
+	}
+
 	void OAAudio::updateStreaming()
 	{
 		{
@@ -299,8 +416,151 @@ namespace bs
 					continue;
 			}
 
-			source->stream();
+			SPtr<OAAudioStream> stream = source->stream();
+			if (stream != nullptr)
+				mDecodeQueue.push_back(stream);
 		}
+
+		mNumStreamingSources.store((UINT32)mStreamingSources.size(), std::memory_order_relaxed);
+
+		updateDSPOutput();
+
+		mDecodeTasks.erase(std::remove_if(mDecodeTasks.begin(), mDecodeTasks.end(),
+			[](const SPtr<TaskGroup>& task) { return task->isComplete(); }), mDecodeTasks.end());
+
+		if (mDecodeQueue.empty())
+			return;
+
+		const UINT32 numStreams = (UINT32)mDecodeQueue.size();
+
+		// The task owns the streams until it completes, so sources can stop streaming while the decode is in flight
+		auto worker = [this, streams = std::move(mDecodeQueue)](UINT32 idx)
+		{
+			Timer timer;
+			const UINT32 numDecoded = streams[idx]->decode();
+
+			mNumDecodedBlocks.fetch_add(numDecoded, std::memory_order_relaxed);
+			mDecodeTimeUs.fetch_add(timer.getMicroseconds(), std::memory_order_relaxed);
+		};
+
+		mDecodeQueue.clear();
+
+		// One task per stream, so streams decode in parallel
+		SPtr<TaskGroup> decodeTask = TaskGroup::create("AudioDecode", worker, numStreams, TaskPriority::VeryHigh);
+		TaskScheduler::instance().addTaskGroup(decodeTask);
+
+		mDecodeTasks.push_back(decodeTask);
+	}
+
+	void OAAudio::createDSPOutput()
+	{
+		if (mDSPThread == nullptr || mContexts.empty())
+			return;
+
+		if (mContexts.size() > 1)
+			alcMakeContextCurrent(mContexts[0]);
+
+		alGenSources(1, &mDSPSource);
+		alSourcei(mDSPSource, AL_SOURCE_RELATIVE, AL_TRUE);
+		alSource3f(mDSPSource, AL_POSITION, 0.0f, 0.0f, 0.0f);
+		alSourcef(mDSPSource, AL_ROLLOFF_FACTOR, 0.0f);
+
+		alGenBuffers(DSP_NUM_BUFFERS, mDSPBuffers);
+		mFreeDSPBuffers.assign(mDSPBuffers, mDSPBuffers + DSP_NUM_BUFFERS);
+
+		const UINT32 numSamples = DSP_BUFFER_FRAMES * mDSPThread->getGraph()->getNumChannels();
+		mIsDSPFloatSupported = _isExtensionSupported("AL_EXT_float32");
+		mDSPSamples.resize(numSamples);
+
+		if (!mIsDSPFloatSupported)
+			mDSPConvertedSamples.resize(numSamples * sizeof(INT16));
+	}
+
+	void OAAudio::destroyDSPOutput()
+	{
+		if (mDSPSource == 0)
+			return;
+
+		if (mContexts.size() > 1)
+			alcMakeContextCurrent(mContexts[0]);
+
+		alSourceStop(mDSPSource);
+		alSourcei(mDSPSource, AL_BUFFER, 0);
+		alDeleteSources(1, &mDSPSource);
+		alDeleteBuffers(DSP_NUM_BUFFERS, mDSPBuffers);
+
+		mDSPSource = 0;
+		mFreeDSPBuffers.clear();
+	}
+
+	void OAAudio::updateDSPOutput()
+	{
+		Lock lock(mDSPMutex);
+
+		if (mDSPSource == 0)
+			return;
+
+		if (mContexts.size() > 1)
+			alcMakeContextCurrent(mContexts[0]);
+
+		INT32 numProcessedBuffers = 0;
+		alGetSourcei(mDSPSource, AL_BUFFERS_PROCESSED, &numProcessedBuffers);
+
+		for (INT32 i = 0; i < numProcessedBuffers; i++)
+		{
+			UINT32 buffer;
+			alSourceUnqueueBuffers(mDSPSource, 1, &buffer);
+			mFreeDSPBuffers.push_back(buffer);
+		}
+
+		const UINT32 numChannels = mDSPThread->getGraph()->getNumChannels();
+		const UINT32 sampleRate = mDSPThread->getGraph()->getSampleRate();
+
+		// Only full buffers are queued, so every buffer plays for the same amount of time
+		while (!mFreeDSPBuffers.empty() && mDSPThread->getNumAvailable() >= DSP_BUFFER_FRAMES)
+		{
+			UINT32 buffer = mFreeDSPBuffers.back();
+			mFreeDSPBuffers.pop_back();
+
+			mDSPThread->read(mDSPSamples.data(), DSP_BUFFER_FRAMES);
+
+			const UINT32 numSamples = DSP_BUFFER_FRAMES * numChannels;
+			if (mIsDSPFloatSupported)
+			{
+				alBufferData(buffer, _getOpenALBufferFormat(numChannels, 32), mDSPSamples.data(),
+					numSamples * sizeof(float), sampleRate);
+			}
+			else
+			{
+				AudioUtility::convertFromFloat(mDSPSamples.data(), 16, mDSPConvertedSamples.data(), numSamples);
+				alBufferData(buffer, _getOpenALBufferFormat(numChannels, 16), mDSPConvertedSamples.data(),
+					numSamples * sizeof(INT16), sampleRate);
+			}
+
+			alSourceQueueBuffers(mDSPSource, 1, &buffer);
+		}
+
+		// Starts the source once the first buffers are queued, and restarts it if it ran out of data
+		INT32 state;
+		alGetSourcei(mDSPSource, AL_SOURCE_STATE, &state);
+
+		INT32 numQueuedBuffers = 0;
+		alGetSourcei(mDSPSource, AL_BUFFERS_QUEUED, &numQueuedBuffers);
+
+		if (state != AL_PLAYING && numQueuedBuffers > 0 && !mIsPaused)
+			alSourcePlay(mDSPSource);
+	}
+
+	OAStreamingStats OAAudio::getStreamingStats() const
+	{
+		OAStreamingStats stats;
+		stats.numStreamingSources = mNumStreamingSources.load(std::memory_order_relaxed);
+		stats.numDecodedBlocks = mNumDecodedBlocks.load(std::memory_order_relaxed);
+		stats.decodeTimeUs = mDecodeTimeUs.load(std::memory_order_relaxed);
+		stats.numLateBlocks = mNumLateBlocks.load(std::memory_order_relaxed);
+		stats.numUnderruns = mNumUnderruns.load(std::memory_order_relaxed);
+
+		return stats;
 	}
 
 	ALenum OAAudio::_getOpenALBufferFormat(UINT32 numChannels, UINT32 bitDepth)
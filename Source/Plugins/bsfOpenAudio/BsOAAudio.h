@@ -8,10 +8,27 @@
 
 namespace bs
 {
+	class TaskGroup;
+	class AudioDSPThread;
+
 	/** @addtogroup OpenAudio
 	 *  @{
 	 */
 	
+	/** Statistics about streaming audio sources. Counters are totals since the audio system was started. */
+	struct OAStreamingStats
+	{
+		UINT32 numStreamingSources = 0; /**< Number of sources streaming during the last streaming update. */
+		UINT64 numDecodedBlocks = 0; /**< Number of blocks decoded ahead of playback. */
+		UINT64 decodeTimeUs = 0; /**< Time spent decoding blocks on the task scheduler workers, in microseconds. */
+
+		/** Number of times an OpenAL buffer was free, but the next block hadn't been decoded yet. */
+		UINT64 numLateBlocks = 0;
+
+		/** Number of times a source played all of its queued data and had to be restarted, causing an audible gap. */
+		UINT64 numUnderruns = 0;
+	};
+
 	/** Global manager for the audio implementation using OpenAL as the backend. */
 	class OAAudio : public Audio
 	{
@@ -46,6 +63,37 @@ namespace bs
 		/** @copydoc Audio::getAllDevices */
 		const Vector<AudioDevice>& getAllDevices() const override { return mAllDevices; };
 
+		/**
+		 * @copydoc Audio::setDSPGraph
+		 *
+		 * The graph output is played through a 2D OpenAL source, in the context of the first listener.
+		 */
+		void setDSPGraph(const SPtr<AudioDSPGraph>& graph) override;
+
+		/**
+		 * Determines the maximum number of sources that can play at once. When more sources are playing, only the ones
+		 * with the highest priority, and within the same priority the most audible ones, are bound to OpenAL sources.
+		 * The rest are virtualized: they keep advancing their playback position without being mixed, and resume from
+		 * that position once they get a voice again.
+		 */
+		void setMaxVoices(UINT32 count) { mMaxVoices = count; }
+
+		/** @copydoc setMaxVoices */
+		UINT32 getMaxVoices() const { return mMaxVoices; }
+
+		/** Returns the number of sources currently bound to OpenAL sources. */
+		UINT32 getNumVoices() const { return mNumVoices; }
+
+		/** Returns the number of playing sources that were virtualized during the last update. */
+		UINT32 getNumVirtualVoices() const { return mNumVirtualVoices; }
+
+		/**
+		 * Returns statistics about streaming sources, useful for detecting when decoding can't keep up with playback.
+		 *
+		 * @note	Thread safe.
+		 */
+		OAStreamingStats getStreamingStats() const;
+
 		/** @name Internal 
 		 *  @{
 		 */
@@ -65,6 +113,9 @@ namespace bs
 		/** Unregisters an existing AudioSource. Should be called before source destruction. */
 		void _unregisterSource(OAAudioSource* source);
 
+		/** Checks if a playing source can be bound to a voice without going over the voice limit. */
+		bool _hasFreeVoice() const { return mNumVoices < mMaxVoices; }
+
 		/** Returns a list of all OpenAL contexts. Each listener has its own context. */
 		const Vector<ALCcontext*>& _getContexts() const { return mContexts; }
 
@@ -102,6 +153,25 @@ namespace bs
 			OAAudioSource* source;
 		};
 
+		/** Playing source competing for a voice. */
+		struct VoiceCandidate
+		{
+			OAAudioSource* source;
+			float audibility;
+		};
+
+		/**
+		 * Audibility multiplier for sources that already have a voice, so sources of similar audibility don't keep
+		 * trading voices every frame.
+		 */
+		static constexpr float VOICE_HYSTERESIS = 1.25f;
+
+		/** Number of OpenAL buffers queued on the source playing the DSP graph output. */
+		static constexpr UINT32 DSP_NUM_BUFFERS = 3;
+
+		/** Number of frames in a single buffer queued on the source playing the DSP graph output. */
+		static constexpr UINT32 DSP_BUFFER_FRAMES = 1024;
+
 		/** @copydoc Audio::createClip */
 		SPtr<AudioClip> createClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples,
 			const AUDIO_CLIP_DESC& desc) override;
@@ -123,7 +193,16 @@ namespace bs
 		/** Delete all existing OpenAL contexts. */
 		void clearContexts();
 
-		/** Streams new data to audio sources that require it. */
+		/**
+		 * Advances virtual sources, and assigns voices to playing sources with the highest priority and audibility,
+		 * virtualizing the rest. Releases voices of sources that are no longer playing.
+		 */
+		void updateVoices();
+
+		/**
+		 * Queues decoded data on audio sources that require it, and queues decoding of more data on the task scheduler,
+		 * as a separate task per source.
+		 */
 		void updateStreaming();
 
 		/** Starts data streaming for the provided source. */
@@ -132,6 +211,15 @@ namespace bs
 		/** Stops data streaming for the provided source. */
 		void stopStreaming(OAAudioSource* source);
 
+		/** Creates the OpenAL source and buffers playing the DSP graph output, if a graph is set. */
+		void createDSPOutput();
+
+		/** Destroys the objects created by createDSPOutput(). */
+		void destroyDSPOutput();
+
+		/** Queues newly rendered samples of the DSP graph on the DSP output source. Called on the streaming thread. */
+		void updateDSPOutput();
+
 		float mVolume = 1.0f;
 		bool mIsPaused = false;
 
@@ -144,12 +232,36 @@ namespace bs
 		Vector<ALCcontext*> mContexts;
 		UnorderedSet<OAAudioSource*> mSources;
 
+		UINT32 mMaxVoices = 64;
+		UINT32 mNumVoices = 0;
+		UINT32 mNumVirtualVoices = 0;
+		Vector<VoiceCandidate> mVoiceCandidates;
+		Vector<Vector3> mListenerPositions;
+
 		// Streaming thread
 		Vector<StreamingCommand> mStreamingCommandQueue;
 		UnorderedSet<OAAudioSource*> mStreamingSources;
 		UnorderedSet<OAAudioSource*> mDestroyedSources;
+		Vector<SPtr<OAAudioStream>> mDecodeQueue;
+		Vector<SPtr<TaskGroup>> mDecodeTasks;
 		SPtr<Task> mStreamingTask;
 		mutable Mutex mMutex;
+
+		std::atomic<UINT32> mNumStreamingSources{0};
+		std::atomic<UINT64> mNumDecodedBlocks{0};
+		std::atomic<UINT64> mDecodeTimeUs{0};
+		std::atomic<UINT64> mNumLateBlocks{0};
+		std::atomic<UINT64> mNumUnderruns{0};
+
+		// DSP graph output, updated on the streaming thread
+		SPtr<AudioDSPThread> mDSPThread;
+		UINT32 mDSPSource = 0;
+		UINT32 mDSPBuffers[DSP_NUM_BUFFERS];
+		Vector<UINT32> mFreeDSPBuffers;
+		Vector<float> mDSPSamples;
+		Vector<UINT8> mDSPConvertedSamples;
+		bool mIsDSPFloatSupported = false;
+		Mutex mDSPMutex;
 	};
 
 	/** Provides easier access to OAAudio. */
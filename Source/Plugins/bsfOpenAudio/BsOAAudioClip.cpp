@@ -3,6 +3,7 @@
 #include "BsOAAudioClip.h"
 #include "BsOggVorbisEncoder.h"
 #include "BsOggVorbisDecoder.h"
+#include "BsADPCMDecoder.h"
 #include "FileSystem/BsDataStream.h"
 #include "BsOAAudio.h"
 #include "AL/al.h"
@@ -10,7 +11,8 @@
 namespace bs
 {
 	OAAudioClip::OAAudioClip(const SPtr<DataStream>& samples, UINT32 streamSize, UINT32 numSamples, const AUDIO_CLIP_DESC& desc)
-		:AudioClip(samples, streamSize, numSamples, desc), mNeedsDecompression(false), mBufferId((UINT32)-1), mSourceStreamSize(0)
+		:AudioClip(samples, streamSize, numSamples, desc), mDecoder(nullptr, nullptr), mNeedsDecompression(false)
+		, mBufferId((UINT32)-1), mSourceStreamSize(0)
 	{ }
 
 	OAAudioClip::~OAAudioClip()
@@ -64,12 +66,12 @@ namespace bs
 				UINT32 bufferSize = info.numSamples * (info.bitDepth / 8);
 				UINT8* sampleBuffer = (UINT8*)bs_stack_alloc(bufferSize);
 
-				// Decompress from Ogg
-				if (mDesc.format == AudioFormat::VORBIS)
+				// Decompress from Ogg or ADPCM
+				if (mDesc.format != AudioFormat::PCM)
 				{
-					OggVorbisDecoder reader;
-					if (reader.open(stream, info, offset))
-						reader.read(sampleBuffer, info.numSamples);
+					UPtr<AudioDecoder> reader = _createDecoder();
+					if (reader->open(stream, info, offset))
+						reader->read(sampleBuffer, info.numSamples);
 					else
 						LOGERR("Failed decompressing AudioClip stream.");
 				}
@@ -116,13 +118,14 @@ namespace bs
 				// Do nothing
 			}
 
-			if (mDesc.format == AudioFormat::VORBIS && mDesc.readMode != AudioReadMode::LoadDecompressed)
+			if (mDesc.format != AudioFormat::PCM && mDesc.readMode != AudioReadMode::LoadDecompressed)
 			{
 				mNeedsDecompression = true;
 
 				if (mStreamData != nullptr)
 				{
-					if (!mVorbisReader.open(mStreamData, info, mStreamOffset))
+					mDecoder = _createDecoder();
+					if (!mDecoder->open(mStreamData, info, mStreamOffset))
 						LOGERR("Failed decompressing AudioClip stream.");
 				}
 			}
@@ -140,8 +143,8 @@ namespace bs
 		{
 			if (mNeedsDecompression)
 			{
-				mVorbisReader.seek(offset);
-				mVorbisReader.read(samples, count);
+				mDecoder->seek(offset);
+				mDecoder->read(samples, count);
 			}
 			else
 			{
@@ -172,6 +175,40 @@ namespace bs
 		LOGWRN("Attempting to read samples while sample data is not available.");
 	}
 
+	SPtr<DataStream> OAAudioClip::_cloneSampleStream(UINT32& offset) const
+	{
+		Lock lock(mMutex);
+
+		// File streams open a new file handle when cloned, and memory streams reference the same memory
+		if (mStreamData != nullptr)
+		{
+			offset = mStreamOffset;
+			return mStreamData->clone(false);
+		}
+
+		if (mSourceStreamData != nullptr)
+		{
+			offset = 0;
+			return mSourceStreamData->clone(false);
+		}
+
+		offset = 0;
+		return nullptr;
+	}
+
+	UPtr<AudioDecoder> OAAudioClip::_createDecoder() const
+	{
+		switch (mDesc.format)
+		{
+		case AudioFormat::VORBIS:
+			return bs_unique_ptr<AudioDecoder>(bs_new<OggVorbisDecoder>());
+		case AudioFormat::ADPCM:
+			return bs_unique_ptr<AudioDecoder>(bs_new<ADPCMDecoder>());
+		default:
+			return UPtr<AudioDecoder>(nullptr, nullptr);
+		}
+	}
+
 	SPtr<DataStream> OAAudioClip::getSourceStream(UINT32& size)
 	{
 		Lock lock(mMutex);
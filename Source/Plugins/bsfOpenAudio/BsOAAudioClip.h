@@ -4,7 +4,7 @@
 
 #include "BsOAPrerequisites.h"
 #include "Audio/BsAudioClip.h"
-#include "BsOggVorbisDecoder.h"
+#include "BsAudioDecoder.h"
 
 namespace bs
 {
@@ -40,6 +40,24 @@ namespace bs
 		/** Returns the internal OpenAL buffer. Only valid if the audio clip was created without AudioReadMode::Stream. */
 		UINT32 _getOpenALBuffer() const { return mBufferId; }
 
+		/**
+		 * Creates a new stream for reading the clip's sample data, so the data can be read without locking the clip and
+		 * without disturbing other readers. Returns null if the sample data is not available.
+		 *
+		 * @param[out]	offset	Offset of the sample data in the returned stream, in bytes.
+		 * @return				Stream containing the sample data, in the clip's compressed format if
+		 *						_needsDecompression() is true, or PCM otherwise.
+		 *
+		 * @note	Thread safe.
+		 */
+		SPtr<DataStream> _cloneSampleStream(UINT32& offset) const;
+
+		/** Checks if the sample data returned by _cloneSampleStream() is compressed. */
+		bool _needsDecompression() const { return mNeedsDecompression; }
+
+		/** Creates a decoder for the clip's compressed format. Returns null if the clip's format is PCM. */
+		UPtr<AudioDecoder> _createDecoder() const;
+
 		/** @} */
 	protected:
 		/** @copydoc Resource::initialize */
@@ -49,7 +67,7 @@ namespace bs
 		SPtr<DataStream> getSourceStream(UINT32& size) override;
 	private:
 		mutable Mutex mMutex;
-		mutable OggVorbisDecoder mVorbisReader;
+		mutable UPtr<AudioDecoder> mDecoder;
 		bool mNeedsDecompression;
 		UINT32 mBufferId;
 
@@ -3,6 +3,7 @@
 #include "BsOAAudioSource.h"
 #include "BsOAAudio.h"
 #include "BsOAAudioClip.h"
+#include "BsOAAudioStream.h"
 #include "AL/al.h"
 
 namespace bs
@@ -10,13 +11,13 @@ namespace bs
 	OAAudioSource::OAAudioSource()
 		:mStreamBuffers(), mBusyBuffers()
 	{
+		// Sources start out virtual, and only get a voice once they start playing
 		gOAAudio()._registerSource(this);
-		rebuild();
 	}
 
 	OAAudioSource::~OAAudioSource()
 	{
-		clear();
+		makeVirtual();
 		gOAAudio()._unregisterSource(this);
 	}
 
@@ -34,6 +35,9 @@ namespace bs
 	{
 		AudioSource::setTransform(transform);
 
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -55,6 +59,9 @@ namespace bs
 	{
 		AudioSource::setVelocity(velocity);
 
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -73,6 +80,9 @@ namespace bs
 	{
 		AudioSource::setVolume(volume);
 
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -88,6 +98,9 @@ namespace bs
 	{
 		AudioSource::setPitch(pitch);
 
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -103,6 +116,16 @@ namespace bs
 	{
 		AudioSource::setIsLooping(loop);
 
+		{
+			Lock lock(mMutex);
+
+			if (mStream != nullptr)
+				mStream->setIsLooping(loop);
+		}
+
+		if (mIsVirtual)
+			return;
+
 		// When streaming we handle looping manually
 		if (requiresStreaming())
 			loop = false;
@@ -122,13 +145,16 @@ namespace bs
 	{
 		AudioSource::setPriority(priority);
 
-		// Do nothing, OpenAL doesn't support priorities (perhaps emulate the behaviour by manually disabling sources?)
+		// OpenAL doesn't support priorities, OAAudio uses them when deciding which sources get a voice
 	}
 
 	void OAAudioSource::setMinDistance(float distance)
 	{
 		AudioSource::setMinDistance(distance);
 
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -144,6 +170,9 @@ namespace bs
 	{
 		AudioSource::setAttenuation(attenuation);
 
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -160,6 +189,18 @@ namespace bs
 		if (mGloballyPaused)
 			return;
 
+		if (mIsVirtual)
+		{
+			// Grab a free voice right away if there is one, otherwise play virtually until OAAudio assigns a voice.
+			// Once real, rebuild() calls back into play().
+			mSavedState = AudioSourceState::Playing;
+
+			if (gOAAudio()._hasFreeVoice())
+				makeReal();
+
+			return;
+		}
+
 		if(requiresStreaming())
 		{
 			Lock lock(mMutex);
@@ -167,7 +208,13 @@ namespace bs
 			if (!mIsStreaming)
 			{
 				startStreaming();
-				streamUnlocked(); // Stream first block on this thread to ensure something can play right away
+
+				// Decode and queue the first block on this thread to ensure something can play right away, the rest
+				// is decoded by the workers
+				if (mStream->tryQueueDecode())
+					mStream->decode(1);
+
+				streamUnlocked();
 			}
 		}
 		
@@ -187,10 +234,24 @@ namespace bs
 			if(!is3D()) 
 				break;
 		}
+
+		if (requiresStreaming())
+		{
+			Lock lock(mMutex);
+			mStreamStarted = mIsStreaming;
+		}
 	}
 
 	void OAAudioSource::pause()
 	{
+		if (mIsVirtual)
+		{
+			if (mSavedState == AudioSourceState::Playing)
+				mSavedState = AudioSourceState::Paused;
+
+			return;
+		}
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -204,6 +265,14 @@ namespace bs
 
 	void OAAudioSource::stop()
 	{
+		if (mIsVirtual)
+		{
+			mSavedState = AudioSourceState::Stopped;
+			mSavedTime = 0.0f;
+
+			return;
+		}
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -233,6 +302,10 @@ namespace bs
 
 		mGloballyPaused = pause;
 
+		// Virtual playback position doesn't advance while paused, nothing else to do
+		if (mIsVirtual)
+			return;
+
 		if (getState() == AudioSourceState::Playing)
 		{
 			if (pause)
@@ -259,6 +332,12 @@ namespace bs
 		if (!mAudioClip.isLoaded())
 			return;
 
+		if (mIsVirtual)
+		{
+			mSavedTime = time;
+			return;
+		}
+
 		AudioSourceState state = getState();
 		stop();
 
@@ -300,6 +379,9 @@ namespace bs
 
 	float OAAudioSource::getTime() const
 	{
+		if (mIsVirtual)
+			return mSavedTime;
+
 		Lock lock(mMutex);
 
 		auto& contexts = gOAAudio()._getContexts();
@@ -328,6 +410,9 @@ namespace bs
 
 	AudioSourceState OAAudioSource::getState() const
 	{
+		if (mIsVirtual)
+			return mSavedState;
+
 		ALint state;
 		alGetSourcei(mSourceIDs[0], AL_SOURCE_STATE, &state);
 
@@ -391,6 +476,7 @@ namespace bs
 			if (contexts.size() > 1)
 				alcMakeContextCurrent(contexts[i]);
 
+			alSourcef(mSourceIDs[i], AL_GAIN, mVolume);
 			alSourcef(mSourceIDs[i], AL_PITCH, mPitch);
 			alSourcef(mSourceIDs[i], AL_REFERENCE_DISTANCE, mMinDistance);
 			alSourcef(mSourceIDs[i], AL_ROLLOFF_FACTOR, mAttenuation);
@@ -441,6 +527,77 @@ namespace bs
 			pause();
 	}
 
+	void OAAudioSource::makeReal()
+	{
+		if (!mIsVirtual || gOAAudio()._getContexts().empty())
+			return;
+
+		mIsVirtual = false;
+		gOAAudio().mNumVoices++;
+
+		rebuild();
+	}
+
+	void OAAudioSource::makeVirtual()
+	{
+		if (mIsVirtual)
+			return;
+
+		clear();
+
+		mIsVirtual = true;
+		gOAAudio().mNumVoices--;
+	}
+
+	void OAAudioSource::updateVirtual(float timeDelta)
+	{
+		if (mSavedState != AudioSourceState::Playing || mGloballyPaused)
+			return;
+
+		// Same as an OpenAL source with no buffer, which stops right away
+		if (!mAudioClip.isLoaded())
+		{
+			mSavedState = AudioSourceState::Stopped;
+			mSavedTime = 0.0f;
+			return;
+		}
+
+		const float length = mAudioClip->getLength();
+		mSavedTime += timeDelta * mPitch;
+
+		if (mSavedTime >= length)
+		{
+			if (mLoop && length > 0.0f)
+				mSavedTime = std::fmod(mSavedTime, length);
+			else
+			{
+				mSavedState = AudioSourceState::Stopped;
+				mSavedTime = 0.0f;
+			}
+		}
+	}
+
+	float OAAudioSource::getAudibility(const Vector<Vector3>& listenerPositions) const
+	{
+		if (!is3D())
+			return mVolume;
+
+		// Inverse distance clamped, the default OpenAL distance model
+		const Vector3 position = mTransform.getPosition();
+
+		float maxGain = 0.0f;
+		for (auto& listenerPosition : listenerPositions)
+		{
+			const float distance = std::max(position.distance(listenerPosition), mMinDistance);
+			const float denominator = mMinDistance + mAttenuation * (distance - mMinDistance);
+
+			const float gain = denominator > 0.0f ? mMinDistance / denominator : 1.0f;
+			maxGain = std::max(maxGain, gain);
+		}
+
+		return mVolume * maxGain;
+	}
+
 	void OAAudioSource::startStreaming()
 	{
 		assert(!mIsStreaming);
@@ -448,8 +605,14 @@ namespace bs
 		alGenBuffers(StreamBufferCount, mStreamBuffers);
 		gOAAudio().startStreaming(this);
 
+		// One second of data per block
+		SPtr<OAAudioClip> clip = std::static_pointer_cast<OAAudioClip>(mAudioClip.getInternalPtr());
+		const UINT32 blockSize = clip->getFrequency() * clip->getNumChannels();
+		mStream = bs_shared_ptr_new<OAAudioStream>(clip, blockSize, mStreamQueuedPosition, mLoop);
+
 		memset(&mBusyBuffers, 0, sizeof(mBusyBuffers));
 		mIsStreaming = true;
+		mStreamStarted = false;
 	}
 
 	void OAAudioSource::stopStreaming()
@@ -457,8 +620,13 @@ namespace bs
 		assert(mIsStreaming);
 
 		mIsStreaming = false;
+		mStreamStarted = false;
 		gOAAudio().stopStreaming(this);
 
+		// A decode might still be queued, it keeps the stream alive until it is done
+		mStream->cancel();
+		mStream = nullptr;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -477,22 +645,27 @@ namespace bs
 		alDeleteBuffers(StreamBufferCount, mStreamBuffers);
 	}
 
-	void OAAudioSource::stream()
+	SPtr<OAAudioStream> OAAudioSource::stream()
 	{
 		Lock lock(mMutex);
 
 		streamUnlocked();
+
+		if (mIsStreaming && mStream->tryQueueDecode())
+			return mStream;
+
+		return nullptr;
 	}
 
 	void OAAudioSource::streamUnlocked()
 	{
-		AudioDataInfo info;
-		info.bitDepth = mAudioClip->getBitDepth();
-		info.numChannels = mAudioClip->getNumChannels();
-		info.sampleRate = mAudioClip->getFrequency();
-		info.numSamples = 0;
+		// Streaming might have been stopped on the main thread (e.g. the source was made virtual) after this update was
+		// queued
+		if (!mIsStreaming)
+			return;
 
-		UINT32 totalNumSamples = mAudioClip->getNumSamples();
+		AudioDataInfo info = mStream->getInfo();
+		UINT32 totalNumSamples = info.numSamples;
 
 		// Note: It is safe to access contexts here only because it is guaranteed by the OAAudio manager that it will always
 		// stop all streaming before changing contexts. Otherwise a mutex lock would be needed for every context access.
@@ -566,53 +739,63 @@ namespace bs
 			if (mBusyBuffers[i] != 0)
 				continue;
 
-			if (fillBuffer(mStreamBuffers[i], info, totalNumSamples))
+			OAAudioStream::Block* block = mStream->peekBlock();
+			if (block == nullptr)
 			{
-				for (auto& source : mSourceIDs)
-					alSourceQueueBuffers(source, 1, &mStreamBuffers[i]);
+				// Decoding fell behind playback
+				if (!mStream->isFinished())
+					gOAAudio().mNumLateBlocks.fetch_add(1, std::memory_order_relaxed);
 
-				mBusyBuffers[i] |= 1 << i;
-			}
-			else
 				break;
-		}
-	}
-
-	bool OAAudioSource::fillBuffer(UINT32 buffer, AudioDataInfo& info, UINT32 maxNumSamples)
-	{
-		UINT32 numRemainingSamples = maxNumSamples - mStreamQueuedPosition;
-		if (numRemainingSamples == 0) // Reached the end
-		{
-			if (mLoop)
-			{
-				mStreamQueuedPosition = 0;
-				numRemainingSamples = maxNumSamples;
 			}
-			else // If not looping, don't queue any more buffers, we're done
-				return false;
-		}
 
-		// Read audio data
-		UINT32 numSamples = std::min(numRemainingSamples, info.sampleRate * info.numChannels); // 1 second of data
-		UINT32 sampleBufferSize = numSamples * (info.bitDepth / 8);
+			info.numSamples = block->numSamples;
+			gOAAudio()._writeToOpenALBuffer(mStreamBuffers[i], block->samples.data(), info);
+			mStream->popBlock();
+
+			for (auto& source : mSourceIDs)
+				alSourceQueueBuffers(source, 1, &mStreamBuffers[i]);
 
-		UINT8* samples = (UINT8*)bs_stack_alloc(sampleBufferSize);
+			mBusyBuffers[i] |= 1 << i;
+		}
 
-		OAAudioClip* audioClip = static_cast<OAAudioClip*>(mAudioClip.get());
+		if (!mStreamStarted)
+			return;
 
-		audioClip->getSamples(samples, mStreamQueuedPosition, numSamples);
-		mStreamQueuedPosition += numSamples;
+		// OpenAL stops a source once it plays all of its queued buffers. If that happened before the end of the clip
+		// the data arrived too late, so restart playback with the newly queued data.
+		bool underrun = false;
+		for (UINT32 i = 0; i < numContexts; i++)
+		{
+			if (contexts.size() > 1)
+				alcMakeContextCurrent(contexts[i]);
 
-		info.numSamples = numSamples;
-		gOAAudio()._writeToOpenALBuffer(buffer, samples, info);
+			INT32 state;
+			INT32 numQueuedBuffers;
+			alGetSourcei(mSourceIDs[i], AL_SOURCE_STATE, &state);
+			alGetSourcei(mSourceIDs[i], AL_BUFFERS_QUEUED, &numQueuedBuffers);
 
-		bs_stack_free(samples);
+			if (state == AL_STOPPED && numQueuedBuffers > 0)
+			{
+				alSourcePlay(mSourceIDs[i]);
+				underrun = true;
+			}
 
-		return true;
+			// Non-3D clips only play on a single source
+			if (!is3D())
+				break;
+		}
+
+		if (underrun)
+			gOAAudio().mNumUnderruns.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	void OAAudioSource::applyClip()
 	{
+		// Virtual sources apply the clip once they get a voice
+		if (mIsVirtual)
+			return;
+
 		auto& contexts = gOAAudio()._getContexts();
 		UINT32 numContexts = (UINT32)contexts.size();
 		for (UINT32 i = 0; i < numContexts; i++)
@@ -63,6 +63,12 @@ namespace bs
 		/** @copydoc AudioSource::getState */
 		AudioSourceState getState() const override;
 
+		/**
+		 * Checks is the source currently virtual. Virtual sources aren't bound to any OpenAL sources and only keep
+		 * track of their playback position, until they become audible enough to be given a voice by OAAudio.
+		 */
+		bool isVirtual() const { return mIsVirtual; }
+
 	private:
 		friend class OAAudio;
 
@@ -72,8 +78,11 @@ namespace bs
 		/** Rebuilds the internal representation of an audio source. */
 		void rebuild();
 
-		/** Streams new data into the source audio buffer, if needed. */
-		void stream();
+		/**
+		 * Queues decoded data on the source, if needed. Returns the read-ahead stream if it has been queued for
+		 * decoding and needs to be decoded by the caller, or null otherwise.
+		 */
+		SPtr<OAAudioStream> stream();
 
 		/** Same as stream(), but without a mutex lock (up to the caller to lock it). */
 		void streamUnlocked();
@@ -87,6 +96,21 @@ namespace bs
 		/** Pauses or resumes audio playback due to the global pause setting. */
 		void setGlobalPause(bool pause);
 
+		/** Binds the source to a voice, resuming playback from the position tracked while the source was virtual. */
+		void makeReal();
+
+		/** Releases the voice used by the source, continuing to track its playback position virtually. */
+		void makeVirtual();
+
+		/** Advances the playback position of a virtual source by the provided time, in seconds. */
+		void updateVirtual(float timeDelta);
+
+		/**
+		 * Estimates how loud the source is heard by the closest of the provided listeners, in [0, 1] range. Uses the
+		 * same distance model as OpenAL, ignoring the global volume.
+		 */
+		float getAudibility(const Vector<Vector3>& listenerPositions) const;
+
 		/** 
 		 * Returns true if the sound source is three dimensional (volume and pitch varies based on listener distance
 		 * and velocity). 
@@ -99,9 +123,6 @@ namespace bs
 		 */
 		bool requiresStreaming() const;
 
-		/** Fills the provided buffer with streaming data. */
-		bool fillBuffer(UINT32 buffer, AudioDataInfo& info, UINT32 maxNumSamples);
-
 		/** Makes the current audio clip active. Should be called whenever the audio clip changes. */
 		void applyClip();
 
@@ -109,16 +130,19 @@ namespace bs
 		void onClipChanged() override;
 
 		Vector<UINT32> mSourceIDs;
-		float mSavedTime = 0.0f;
-		AudioSourceState mSavedState = AudioSourceState::Stopped;
+		float mSavedTime = 0.0f; // Also the playback position while virtual
+		AudioSourceState mSavedState = AudioSourceState::Stopped; // Also the playback state while virtual
 		bool mGloballyPaused = false;
+		bool mIsVirtual = true;
 
 		static const UINT32 StreamBufferCount = 3; // Maximum 32
 		UINT32 mStreamBuffers[StreamBufferCount];
 		UINT32 mBusyBuffers[StreamBufferCount];
 		UINT32 mStreamProcessedPosition = 0;
-		UINT32 mStreamQueuedPosition = 0;
+		UINT32 mStreamQueuedPosition = 0; // Position streaming starts from
+		SPtr<OAAudioStream> mStream;
 		bool mIsStreaming = false;
+		bool mStreamStarted = false;
 		mutable Mutex mMutex;
 	};
 
@@ -0,0 +1,213 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsOAAudioStream.h"
+#include "BsOAAudioClip.h"
+#include "FileSystem/BsDataStream.h"
+
+namespace bs
+{
+	OAAudioStream::OAAudioStream(const SPtr<OAAudioClip>& clip, UINT32 blockSize, UINT32 startSample, bool loop)
+		: mLoop(loop), mClip(clip), mIsCompressed(clip->_needsDecompression()), mDecoder(clip->_createDecoder())
+		, mBlockSize(blockSize)
+	{
+		mStream = clip->_cloneSampleStream(mStreamOffset);
+
+		mInfo.bitDepth = clip->getBitDepth();
+		mInfo.numChannels = clip->getNumChannels();
+		mInfo.sampleRate = clip->getFrequency();
+		mInfo.numSamples = clip->getNumSamples();
+
+		// Blocks never hold more than the whole clip, so streams of short clips stay small
+		const UINT32 bytesPerSample = mInfo.bitDepth / 8;
+		for (auto& block : mBlocks)
+			block.samples.resize(std::min(mBlockSize, mInfo.numSamples) * bytesPerSample);
+
+		if (mIsCompressed)
+		{
+			AudioDataInfo decoderInfo;
+			if (mStream == nullptr || mDecoder == nullptr || !mDecoder->open(mStream, decoderInfo, mStreamOffset))
+			{
+				LOGERR("Failed decompressing AudioClip stream.");
+				mStream = nullptr;
+			}
+		}
+
+		else if (mStream != nullptr && AsyncFileIO::isStarted())
+		{
+			SPtr<FileDataStream> fileStream = std::dynamic_pointer_cast<FileDataStream>(mStream);
+			if (fileStream != nullptr)
+			{
+				mAsyncFile = AsyncFile::open(fileStream->getPath());
+				mReadAhead.resize(mBlocks[0].samples.size());
+			}
+		}
+
+		seek(std::min(startSample, mInfo.numSamples));
+	}
+
+	OAAudioStream::~OAAudioStream()
+	{
+		// The pending read still writes into the read-ahead buffer
+		waitReadAhead();
+	}
+
+	bool OAAudioStream::tryQueueDecode()
+	{
+		{
+			Lock lock(mMutex);
+
+			if (mNumReady == NUM_BLOCKS || mReachedEnd)
+				return false;
+		}
+
+		if (mCancelled.load(std::memory_order_relaxed))
+			return false;
+
+		return !mDecodeQueued.exchange(true, std::memory_order_acquire);
+	}
+
+	UINT32 OAAudioStream::decode(UINT32 maxBlocks)
+	{
+		UINT32 numDecoded = 0;
+		while (numDecoded < maxBlocks && !mCancelled.load(std::memory_order_relaxed))
+		{
+			UINT32 writeIdx;
+			{
+				Lock lock(mMutex);
+
+				if (mNumReady == NUM_BLOCKS || mReachedEnd)
+					break;
+
+				writeIdx = (mReadIdx + mNumReady) % NUM_BLOCKS;
+			}
+
+			// Blocks past the ready ones are never touched by the reader, so no need to keep the lock while decoding
+			const bool decoded = decodeBlock(mBlocks[writeIdx]);
+
+			Lock lock(mMutex);
+			if (decoded)
+			{
+				mNumReady++;
+				numDecoded++;
+			}
+			else
+				mReachedEnd = true;
+		}
+
+		mDecodeQueued.store(false, std::memory_order_release);
+		return numDecoded;
+	}
+
+	OAAudioStream::Block* OAAudioStream::peekBlock()
+	{
+		Lock lock(mMutex);
+
+		if (mNumReady == 0)
+			return nullptr;
+
+		return &mBlocks[mReadIdx];
+	}
+
+	void OAAudioStream::popBlock()
+	{
+		Lock lock(mMutex);
+
+		assert(mNumReady > 0);
+		mReadIdx = (mReadIdx + 1) % NUM_BLOCKS;
+		mNumReady--;
+	}
+
+	bool OAAudioStream::isFinished() const
+	{
+		Lock lock(mMutex);
+		return mReachedEnd && mNumReady == 0;
+	}
+
+	bool OAAudioStream::decodeBlock(Block& block)
+	{
+		if (mStream == nullptr)
+			return false;
+
+		UINT32 numRemainingSamples = mInfo.numSamples - mPosition;
+		if (numRemainingSamples == 0)
+		{
+			if (!mLoop.load(std::memory_order_relaxed) || mInfo.numSamples == 0)
+				return false;
+
+			seek(0);
+			numRemainingSamples = mInfo.numSamples;
+		}
+
+		// Blocks never span the end of the clip, the source relies on it to detect when playback loops or ends
+		const UINT32 numSamples = std::min(numRemainingSamples, mBlockSize);
+		if (mIsCompressed)
+			mDecoder->read(block.samples.data(), numSamples);
+		else if (mAsyncFile != nullptr)
+		{
+			// Read-ahead only misses when the stream starts, or after a seek
+			if (!mReadAheadPending || mReadAheadSample != mPosition || mReadAheadNumSamples != numSamples)
+				startReadAhead(mPosition, numSamples);
+
+			mReadAheadOp.blockUntilComplete();
+			mReadAheadPending = false;
+
+			const UINT32 numBytes = numSamples * (mInfo.bitDepth / 8);
+			const AsyncReadResult result = mReadAheadOp.getReturnValue<AsyncReadResult>();
+			const UINT32 numRead = result.success ? (UINT32)result.numBytes : 0;
+
+			// Both buffers are the same size, so they can be swapped instead of copied
+			std::swap(block.samples, mReadAhead);
+			if (numRead < numBytes)
+				memset(block.samples.data() + numRead, 0, numBytes - numRead);
+
+			UINT32 nextSample = mPosition + numSamples;
+			if (nextSample == mInfo.numSamples && mLoop.load(std::memory_order_relaxed))
+				nextSample = 0;
+
+			if (nextSample < mInfo.numSamples)
+				startReadAhead(nextSample, std::min(mInfo.numSamples - nextSample, mBlockSize));
+		}
+		else
+			mStream->read(block.samples.data(), numSamples * (mInfo.bitDepth / 8));
+
+		block.numSamples = numSamples;
+		mPosition += numSamples;
+
+		return true;
+	}
+
+	void OAAudioStream::seek(UINT32 sample)
+	{
+		mPosition = sample;
+
+		if (mStream == nullptr)
+			return;
+
+		if (mIsCompressed)
+			mDecoder->seek(sample);
+		else
+			mStream->seek(mStreamOffset + sample * (mInfo.bitDepth / 8));
+	}
+
+	void OAAudioStream::startReadAhead(UINT32 sample, UINT32 numSamples)
+	{
+		waitReadAhead();
+
+		const UINT32 bytesPerSample = mInfo.bitDepth / 8;
+		mReadAheadOp = AsyncFileIO::instance().read(mAsyncFile, mStreamOffset + (UINT64)sample * bytesPerSample,
+			numSamples * bytesPerSample, mReadAhead.data());
+
+		mReadAheadSample = sample;
+		mReadAheadNumSamples = numSamples;
+		mReadAheadPending = true;
+	}
+
+	void OAAudioStream::waitReadAhead()
+	{
+		if (!mReadAheadPending)
+			return;
+
+		mReadAheadOp.blockUntilComplete();
+		mReadAheadPending = false;
+	}
+}
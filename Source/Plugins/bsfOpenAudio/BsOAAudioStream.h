@@ -0,0 +1,127 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsOAPrerequisites.h"
+#include "BsAudioDecoder.h"
+#include "FileSystem/BsAsyncFileIO.h"
+
+namespace bs
+{
+	/** @addtogroup OpenAudio
+	 *  @{
+	 */
+
+	/**
+	 * Decodes the samples of a streamed audio clip ahead of playback, for a single audio source. Decoding happens on
+	 * task scheduler workers, into a small ring of blocks that the streaming thread then queues on the OpenAL source.
+	 * Each stream reads the clip data through its own data stream and decoder, so streams of the same clip can be
+	 * decoded in parallel, and decoders are only seeked when the stream starts or loops. Uncompressed samples read
+	 * directly from a file are read one block ahead through AsyncFileIO, so decoding rarely waits on the device.
+	 *
+	 * @note	Thread safe.
+	 */
+	class OAAudioStream
+	{
+	public:
+		/** Number of decoded blocks kept ahead of the blocks queued on the OpenAL source. */
+		static constexpr UINT32 NUM_BLOCKS = 2;
+
+		/** Decoded samples waiting to be queued on an OpenAL source. */
+		struct Block
+		{
+			Vector<UINT8> samples;
+			UINT32 numSamples = 0;
+		};
+
+		/**
+		 * Creates a new stream.
+		 *
+		 * @param[in]	clip			Clip to decode the samples of.
+		 * @param[in]	blockSize		Number of samples in a single block.
+		 * @param[in]	startSample		Sample at which to start decoding.
+		 * @param[in]	loop			If true decoding restarts from the first sample once the end of the clip is
+		 *								reached.
+		 */
+		OAAudioStream(const SPtr<OAAudioClip>& clip, UINT32 blockSize, UINT32 startSample, bool loop);
+		~OAAudioStream();
+
+		/** Returns the format of the decoded samples. */
+		const AudioDataInfo& getInfo() const { return mInfo; }
+
+		/** Determines if decoding restarts from the first sample once the end of the clip is reached. */
+		void setIsLooping(bool loop) { mLoop.store(loop, std::memory_order_relaxed); }
+
+		/** Stops any further decoding. Called when the source stops streaming, while a decode might still be queued. */
+		void cancel() { mCancelled.store(true, std::memory_order_relaxed); }
+
+		/**
+		 * Checks if the stream has room for more decoded blocks and, if so, marks it as queued for decoding. Only one
+		 * decode per stream can be queued at a time, so a stream must not be decoded unless this returns true.
+		 */
+		bool tryQueueDecode();
+
+		/**
+		 * Decodes blocks until the ring is full, the end of a non-looping clip is reached or the stream is cancelled.
+		 * Clears the flag set by tryQueueDecode().
+		 *
+		 * @param[in]	maxBlocks	Maximum number of blocks to decode.
+		 * @return					Number of blocks decoded.
+		 */
+		UINT32 decode(UINT32 maxBlocks = NUM_BLOCKS);
+
+		/** Returns the oldest decoded block, or null if no block is ready. Call popBlock() once it is consumed. */
+		Block* peekBlock();
+
+		/** Releases the block returned by peekBlock(), so it can be decoded into again. */
+		void popBlock();
+
+		/** Checks if all the samples of a non-looping clip were decoded and consumed. */
+		bool isFinished() const;
+
+	private:
+		/** Decodes the next block of samples. Returns false if the end of a non-looping clip was reached. */
+		bool decodeBlock(Block& block);
+
+		/** Moves the decoder to the provided sample. */
+		void seek(UINT32 sample);
+
+		/** Starts an asynchronous read of a block of uncompressed samples into the read-ahead buffer. */
+		void startReadAhead(UINT32 sample, UINT32 numSamples);
+
+		/** Waits until the read-ahead buffer is no longer being read into. */
+		void waitReadAhead();
+
+		mutable Mutex mMutex;
+		Block mBlocks[NUM_BLOCKS];
+		UINT32 mReadIdx = 0;
+		UINT32 mNumReady = 0;
+		bool mReachedEnd = false;
+
+		std::atomic<bool> mLoop;
+		std::atomic<bool> mCancelled{false};
+		std::atomic<bool> mDecodeQueued{false};
+
+		// The clip owns the memory read by in-memory streams, so it must outlive any queued decodes
+		SPtr<OAAudioClip> mClip;
+
+		// Only accessed by the thread decoding the stream
+		SPtr<DataStream> mStream;
+		UINT32 mStreamOffset = 0;
+		bool mIsCompressed;
+		UPtr<AudioDecoder> mDecoder;
+		AudioDataInfo mInfo;
+		UINT32 mBlockSize;
+		UINT32 mPosition = 0;
+
+		// Only used when the uncompressed samples are read directly from a file
+		SPtr<AsyncFile> mAsyncFile;
+		Vector<UINT8> mReadAhead;
+		AsyncOp mReadAheadOp;
+		UINT32 mReadAheadSample = 0;
+		UINT32 mReadAheadNumSamples = 0;
+		bool mReadAheadPending = false;
+	};
+
+	/** @} */
+}
@@ -7,6 +7,7 @@
 #include "BsFLACDecoder.h"
 #include "BsOggVorbisDecoder.h"
 #include "BsOggVorbisEncoder.h"
+#include "BsADPCMEncoder.h"
 #include "Audio/BsAudioClipImportOptions.h"
 #include "Audio/BsAudioUtility.h"
 
@@ -49,7 +50,7 @@ namespace bs
 		UINT32 bufferSize;
 		UINT8* sampleBuffer;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 
 			String extension = filePath.getExtension();
@@ -100,15 +101,16 @@ namespace bs
 			bufferSize = monoBufferSize;
 		}
 
-		// Convert bit depth if needed
-		if(clipIO->getBitDepth() != info.bitDepth)
+		// Convert bit depth if needed, ADPCM is always encoded from 16-bit samples
+		const UINT32 bitDepth = clipIO->getFormat() == AudioFormat::ADPCM ? 16 : clipIO->getBitDepth();
+		if(bitDepth != info.bitDepth)
 		{
-			UINT32 outBufferSize = info.numSamples * (clipIO->getBitDepth() / 8);
+			UINT32 outBufferSize = info.numSamples * (bitDepth / 8);
 			UINT8* outBuffer = (UINT8*)bs_alloc(outBufferSize);
 
-			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, clipIO->getBitDepth(), info.numSamples);
+			AudioUtility::convertBitDepth(sampleBuffer, info.bitDepth, outBuffer, bitDepth, info.numSamples);
 
-			info.bitDepth = clipIO->getBitDepth();
+			info.bitDepth = bitDepth;
 
 			bs_free(sampleBuffer);
 
@@ -127,6 +129,14 @@ namespace bs
 			bs_free(sampleBuffer);
 			sampleBuffer = encodedSamples;
 		}
+		// Encode to ADPCM if needed
+		else if(clipIO->getFormat() == AudioFormat::ADPCM)
+		{
+			UINT8* encodedSamples = ADPCMEncoder::PCMToADPCM(sampleBuffer, info, bufferSize);
+
+			bs_free(sampleBuffer);
+			sampleBuffer = encodedSamples;
+		}
 
 		SPtr<MemoryDataStream> sampleStream = bs_shared_ptr_new<MemoryDataStream>(sampleBuffer, bufferSize);
 
@@ -6,8 +6,10 @@
 
 namespace bs
 {
+	class OAAudioClip;
 	class OAAudioListener;
 	class OAAudioSource;
+	class OAAudioStream;
 }
 
 /** @addtogroup Plugins
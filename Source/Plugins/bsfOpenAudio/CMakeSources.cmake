@@ -10,6 +10,9 @@ set(BS_OPENAUDIO_INC_NOFILTER
 	"BsOAAudio.h"
 	"BsOAAudioSource.h"
 	"BsOAAudioListener.h"
+	"BsOAAudioStream.h"
+	"BsADPCMDecoder.h"
+	"BsADPCMEncoder.h"
 )
 
 set(BS_OPENAUDIO_SRC_NOFILTER
@@ -23,6 +26,9 @@ set(BS_OPENAUDIO_SRC_NOFILTER
 	"BsOAAudio.cpp"
 	"BsOAAudioSource.cpp"
 	"BsOAAudioListener.cpp"
+	"BsOAAudioStream.cpp"
+	"BsADPCMDecoder.cpp"
+	"BsADPCMEncoder.cpp"
 )
 
 if(WIN32)
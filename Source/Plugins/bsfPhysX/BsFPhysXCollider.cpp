@@ -17,8 +17,8 @@ namespace bs
 		mStaticBody = gPhysX().getPhysX()->createRigidStatic(PxTransform(PxIdentity));
 		mStaticBody->attachShape(*mShape);
 
-		PxScene* scene = gPhysX().getScene();
-		scene->addActor(*mStaticBody);
+		mScene = gPhysX().getScene();
+		mScene->addActor(*mStaticBody);
 
 		updateFilter();
 	}
@@ -126,8 +126,7 @@ namespace bs
 			mStaticBody = gPhysX().getPhysX()->createRigidStatic(PxTransform(PxIdentity));
 			mStaticBody->attachShape(*mShape);
 
-			PxScene* scene = gPhysX().getScene();
-			scene->addActor(*mStaticBody);
+			mScene->addActor(*mStaticBody);
 		}
 	}
 
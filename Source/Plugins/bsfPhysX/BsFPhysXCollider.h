@@ -85,6 +85,7 @@ namespace bs
 
 		physx::PxShape* mShape = nullptr;
 		physx::PxRigidStatic* mStaticBody = nullptr;
+		physx::PxScene* mScene = nullptr;
 		bool mIsTrigger = false;
 		bool mIsStatic = true;
 		UINT64 mLayer = 1;
@@ -10,6 +10,7 @@
 #include "BsPhysXPlaneCollider.h"
 #include "BsPhysXCapsuleCollider.h"
 #include "BsPhysXMeshCollider.h"
+#include "BsPhysXHeightFieldCollider.h"
 #include "BsPhysXFixedJoint.h"
 #include "BsPhysXDistanceJoint.h"
 #include "BsPhysXHingeJoint.h"
@@ -284,26 +285,77 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Executes tasks submitted by PhysX on the task scheduler. PhysX submits many small tasks every step, so the
+	 * scheduler tasks are pooled and re-queued instead of being created for each submitted task. Tasks submitted from
+	 * within other PhysX tasks end up on the local queue of the worker executing them.
+	 */
 	class PhysXCPUDispatcher : public PxCpuDispatcher
 	{
+		/** Scheduler task that can be re-queued to execute different PhysX tasks. */
+		struct TaskSlot
+		{
+			SPtr<Task> task;
+			PxBaseTask* physxTask = nullptr;
+		};
+
 	public:
-		void submitTask(PxBaseTask& physxTask) override
+		~PhysXCPUDispatcher()
 		{
-			// Note: Banshee's task scheduler is pretty low granularity. Consider a better task manager in case PhysX ends
-			// up submitting many tasks.
-			// - PhysX's task manager doesn't seem much lighter either. But perhaps I can at least create a task pool to 
-			//   avoid allocating them constantly.
+			for(auto& entry : mSlots)
+				bs_delete(entry);
+		}
 
-			auto runTask = [&]() { physxTask.run(); physxTask.release(); };
-			SPtr<Task> task = Task::create("PhysX", runTask);
+		void submitTask(PxBaseTask& physxTask) override
+		{
+			TaskSlot* slot = acquireSlot();
+			slot->physxTask = &physxTask;
 
-			TaskScheduler::instance().addTask(task);
+			TaskScheduler::instance().addTask(slot->task);
 		}
 
 		PxU32 getWorkerCount() const override
 		{
 			return (PxU32)TaskScheduler::instance().getNumWorkers();
 		}
+
+	private:
+		/** Returns a slot whose task is not queued nor executing, creating a new one if none are available. */
+		TaskSlot* acquireSlot()
+		{
+			{
+				ScopedSpinLock lock(mSlotsLock);
+
+				// Slots are returned from within their task, so the scheduler might not have yet marked it as complete
+				if(!mFreeSlots.empty() && mFreeSlots.back()->task->isComplete())
+				{
+					TaskSlot* slot = mFreeSlots.back();
+					mFreeSlots.pop_back();
+
+					return slot;
+				}
+			}
+
+			TaskSlot* slot = bs_new<TaskSlot>();
+			slot->task = Task::create("PhysX", [this, slot]()
+			{
+				PxBaseTask* physxTask = slot->physxTask;
+				physxTask->run();
+				physxTask->release();
+
+				ScopedSpinLock lock(mSlotsLock);
+				mFreeSlots.push_back(slot);
+			});
+
+			ScopedSpinLock lock(mSlotsLock);
+			mSlots.push_back(slot);
+
+			return slot;
+		}
+
+		Vector<TaskSlot*> mSlots;
+		Vector<TaskSlot*> mFreeSlots;
+		SpinLock mSlotsLock;
 	};
 
 	class PhysXBroadPhaseCallback : public PxBroadPhaseCallback
@@ -468,6 +520,10 @@ namespace bs
 	{
 		mScale.length = input.typicalLength;
 		mScale.speed = input.typicalSpeed;
+		mAsyncSimulation = input.asyncSimulation;
+		mRegionBroadPhase = input.regionBroadPhase;
+		mCCDEnabled = input.flags.isSet(PhysicsFlag::CCD_Enable);
+		mInitialGravity = input.gravity;
 
 		mFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gPhysXAllocator, gPhysXErrorHandler);
 		mPhysics = PxCreateBasePhysics(PX_PHYSICS_VERSION, *mFoundation, mScale);
@@ -483,8 +539,28 @@ namespace bs
 			mCooking = PxCreateCooking(PX_PHYSICS_VERSION, *mFoundation, cookingParams);
 		}
 
+		mScenes[0] = createScene();
+		setActiveScene(0);
+
+		mDefaultMaterial = mPhysics->createMaterial(1.0f, 1.0f, 0.5f);
+	}
+
+	PhysX::~PhysX()
+	{
+		for (auto& entry : mScenes)
+			destroyScene(entry.second);
+
+		if (mCooking != nullptr)
+			mCooking->release();
+
+		mPhysics->release();
+		mFoundation->release();
+	}
+
+	PhysX::SceneData PhysX::createScene() const
+	{
 		PxSceneDesc sceneDesc(mScale); // TODO - Test out various other parameters provided by scene desc
-		sceneDesc.gravity = toPxVector(input.gravity);
+		sceneDesc.gravity = toPxVector(mInitialGravity);
 		sceneDesc.cpuDispatcher = &gPhysXCPUDispatcher;
 		sceneDesc.filterShader = PhysXFilterShader;
 		sceneDesc.simulationEventCallback = &gPhysXEventCallback;
@@ -493,83 +569,226 @@ namespace bs
 		// Optionally: eENABLE_KINEMATIC_STATIC_PAIRS, eENABLE_KINEMATIC_PAIRS, eENABLE_PCM
 		sceneDesc.flags = PxSceneFlag::eENABLE_ACTIVETRANSFORMS;
 
-		if (input.flags.isSet(PhysicsFlag::CCD_Enable))
+		if (mCCDEnabled)
 			sceneDesc.flags |= PxSceneFlag::eENABLE_CCD;
 
-		// Optionally: eMBP
-		sceneDesc.broadPhaseType = PxBroadPhaseType::eSAP;
+		sceneDesc.broadPhaseType = mRegionBroadPhase ? PxBroadPhaseType::eMBP : PxBroadPhaseType::eSAP;
 
-		mScene = mPhysics->createScene(sceneDesc);
+		SceneData data;
+		data.scene = mPhysics->createScene(sceneDesc);
 
 		// Character controller
-		mCharManager = PxCreateControllerManager(*mScene);
+		// Locking enabled so controllers can be moved from multiple threads, see moveCharacterControllers()
+		data.charManager = PxCreateControllerManager(*data.scene, true);
+		applyControllerFlags(data.charManager);
 
-		mDefaultMaterial = mPhysics->createMaterial(1.0f, 1.0f, 0.5f);
+		// Each scene needs its own scratch memory, as multiple scenes can be simulating at once
+		data.scratchBuffer = (UINT8*)bs_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
+
+		return data;
 	}
 
-	PhysX::~PhysX()
+	void PhysX::destroyScene(SceneData& data)
 	{
-		mCharManager->release();
-		mScene->release();
+		if (data.simulationInProgress)
+			data.scene->fetchResults(true);
 
-		if (mCooking != nullptr)
-			mCooking->release();
+		bs_free_aligned(data.scratchBuffer);
 
-		mPhysics->release();
-		mFoundation->release();
+		data.charManager->release();
+		data.scene->release();
+	}
+
+	void PhysX::applyControllerFlags(PxControllerManager* charManager) const
+	{
+		charManager->setOverlapRecoveryModule(mFlags.isSet(PhysicsFlag::CCT_OverlapRecovery));
+		charManager->setPreciseSweeps(mFlags.isSet(PhysicsFlag::CCT_PreciseSweeps));
+		charManager->setTessellation(mFlags.isSet(PhysicsFlag::CCT_Tesselation), mTesselationLength);
 	}
 
 	void PhysX::fixedUpdate(float step)
 	{
+		if (mAsyncSimulation)
+		{
+			// Finish the step started during the last fixed update, and start the next one in the background. Physics
+			// objects can still be modified and queried while the simulation runs, which sees them as they were when
+			// the step started, and with modifications applied once its results are fetched.
+			fetchSimulationResults();
+
+			if (mPaused)
+				return;
+
+			for (auto& entry : mScenes)
+			{
+				SceneData& data = entry.second;
+
+				data.scene->simulate(step, nullptr, data.scratchBuffer, SCRATCH_BUFFER_SIZE);
+				data.simulationInProgress = true;
+			}
+
+			return;
+		}
+
 		if (mPaused)
 			return;
 
+		// Start all the scenes first so they simulate in parallel, then wait for each of them
+		for (auto& entry : mScenes)
+		{
+			SceneData& data = entry.second;
+			data.scene->simulate(step, nullptr, data.scratchBuffer, SCRATCH_BUFFER_SIZE);
+		}
+
 		mUpdateInProgress = true;
+		for (auto& entry : mScenes)
+		{
+			SceneData& data = entry.second;
 
-		// Note: Consider delaying fetchResults one frame. This could improve performance because Physics update would be
-		//       able to run parallel to the simulation thread, but at a cost to input latency.
-		bs_frame_mark();
-		UINT8* scratchBuffer = bs_frame_alloc_aligned(SCRATCH_BUFFER_SIZE, 16);
+			UINT32 errorState;
+			if (!data.scene->fetchResults(true, &errorState))
+				LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
 
-		mScene->simulate(step, nullptr, scratchBuffer, SCRATCH_BUFFER_SIZE);
+			applySimulationResults(data.scene);
+		}
+		mUpdateInProgress = false;
 
-		UINT32 errorState;
-		if (!mScene->fetchResults(true, &errorState))
-			LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
+		triggerEvents();
+	}
 
-		bs_frame_free_aligned(scratchBuffer);
-		bs_frame_clear();
+	void PhysX::fetchSimulationResults()
+	{
+		bool anyInProgress = false;
+		for (auto& entry : mScenes)
+			anyInProgress |= entry.second.simulationInProgress;
 
-		// Update rigidbodies with new transforms
-		PxU32 numActiveTransforms;
-		const PxActiveTransform* activeTransforms = mScene->getActiveTransforms(numActiveTransforms);
+		if (!anyInProgress)
+			return;
+
+		mUpdateInProgress = true;
 
-		for (PxU32 i = 0; i < numActiveTransforms; i++)
+		// Bodies the simulation no longer moves are snapped to their final transform, the rest start interpolating
+		// from it towards the new transform
+		for (auto& entry : mInterpolatedTransforms)
 		{
-			Rigidbody* rigidbody = static_cast<Rigidbody*>(activeTransforms[i].userData);
+			InterpolatedTransform& transform = entry.second;
+			entry.first->_setTransform(transform.position, transform.rotation);
+
+			transform.prevPosition = transform.position;
+			transform.prevRotation = transform.rotation;
+		}
 
-			// Note: This should never happen, as actors gets their userData set to null when they're destroyed. However
-			// in some cases PhysX seems to keep those actors alive for a frame or few, and reports their state here. Until
-			// I find out why I need to perform this check.
-			if(activeTransforms[i].actor->userData == nullptr)
+		for (auto& entry : mScenes)
+		{
+			SceneData& data = entry.second;
+			if (!data.simulationInProgress)
 				continue;
 
-			const PxTransform& transform = activeTransforms[i].actor2World;
+			UINT32 errorState;
+			if (!data.scene->fetchResults(true, &errorState))
+				LOGWRN("Physics simulation failed. Error code: " + toString(errorState));
 
-			// Note: Make this faster, avoid dereferencing Rigidbody and attempt to access pos/rot destination directly,
-			//       use non-temporal writes
-			rigidbody->_setTransform(fromPxVector(transform.p), fromPxQuaternion(transform.q));
+			data.simulationInProgress = false;
+			applySimulationResults(data.scene);
+		}
+
+		for (auto iter = mInterpolatedTransforms.begin(); iter != mInterpolatedTransforms.end();)
+		{
+			const InterpolatedTransform& transform = iter->second;
+			if (transform.position == transform.prevPosition && transform.rotation == transform.prevRotation)
+				iter = mInterpolatedTransforms.erase(iter);
+			else
+				++iter;
 		}
 
-		// Note: Consider extrapolating for the remaining "simulationAmount" value
 		mUpdateInProgress = false;
 
 		triggerEvents();
 	}
 
+	void PhysX::applySimulationResults(PxScene* scene)
+	{
+		PxU32 numActiveTransforms;
+		const PxActiveTransform* activeTransforms = scene->getActiveTransforms(numActiveTransforms);
+
+		bs_frame_mark();
+		{
+			// Gather the results in a linear pass over the PhysX data, and then write them back in bulk
+			FrameVector<Rigidbody*> rigidbodies;
+			FrameVector<Vector3> positions;
+			FrameVector<Quaternion> rotations;
+
+			rigidbodies.reserve(numActiveTransforms);
+			positions.reserve(numActiveTransforms);
+			rotations.reserve(numActiveTransforms);
+
+			for (PxU32 i = 0; i < numActiveTransforms; i++)
+			{
+				// Note: This should never happen, as actors gets their userData set to null when they're destroyed.
+				// However in some cases PhysX seems to keep those actors alive for a frame or few, and reports their
+				// state here. Until I find out why I need to perform this check.
+				if(activeTransforms[i].actor->userData == nullptr)
+					continue;
+
+				const PxTransform& transform = activeTransforms[i].actor2World;
+
+				rigidbodies.push_back(static_cast<Rigidbody*>(activeTransforms[i].userData));
+				positions.push_back(fromPxVector(transform.p));
+				rotations.push_back(fromPxQuaternion(transform.q));
+			}
+
+			const UINT32 numRigidbodies = (UINT32)rigidbodies.size();
+			if (mAsyncSimulation)
+			{
+				for (UINT32 i = 0; i < numRigidbodies; i++)
+				{
+					const Vector3& position = positions[i];
+					const Quaternion& rotation = rotations[i];
+
+					auto iterFind = mInterpolatedTransforms.find(rigidbodies[i]);
+					if (iterFind == mInterpolatedTransforms.end())
+					{
+						// Bodies that just started moving have no previous state to interpolate from
+						mInterpolatedTransforms[rigidbodies[i]] = { position, rotation, position, rotation };
+						rigidbodies[i]->_setTransform(position, rotation);
+					}
+					else
+					{
+						iterFind->second.position = position;
+						iterFind->second.rotation = rotation;
+					}
+				}
+			}
+			else if (numRigidbodies > 0)
+				Rigidbody::_setTransforms(rigidbodies.data(), positions.data(), rotations.data(), numRigidbodies);
+		}
+		bs_frame_clear();
+	}
+
 	void PhysX::update()
 	{
-		// Note: Potentially interpolate (would mean a one frame delay needs to be introduced)
+		if (!mAsyncSimulation || mInterpolatedTransforms.empty())
+			return;
+
+		// Time elapsed since the latest fixed update, as a fraction of the fixed step
+		const float fixedDelta = gTime().getFixedFrameDelta();
+		const float elapsed = gTime().getLastFrameTime() - gTime().getLastFixedUpdateTime();
+		const float t = fixedDelta > 0.0f ? Math::clamp01(elapsed / fixedDelta) : 1.0f;
+
+		mUpdateInProgress = true;
+		for (auto& entry : mInterpolatedTransforms)
+		{
+			const InterpolatedTransform& transform = entry.second;
+
+			const Vector3 position = Vector3::lerp(t, transform.prevPosition, transform.position);
+			const Quaternion rotation = Quaternion::lerp(t, transform.prevRotation, transform.rotation);
+			entry.first->_setTransform(position, rotation);
+		}
+		mUpdateInProgress = false;
+	}
+
+	void PhysX::_notifyRigidbodyDestroyed(Rigidbody* rigidbody)
+	{
+		mInterpolatedTransforms.erase(rigidbody);
 	}
 
 	void PhysX::_reportContactEvent(const ContactEvent& event)
@@ -731,6 +950,11 @@ namespace bs
 		return bs_shared_ptr_new<PhysXMeshCollider>(mPhysics, position, rotation);
 	}
 
+	SPtr<HeightFieldCollider> PhysX::createHeightFieldCollider(const Vector3& position, const Quaternion& rotation)
+	{
+		return bs_shared_ptr_new<PhysXHeightFieldCollider>(mPhysics, position, rotation);
+	}
+
 	SPtr<FixedJoint> PhysX::createFixedJoint(const FIXED_JOINT_DESC& desc)
 	{
 		return bs_shared_ptr_new<PhysXFixedJoint>(mPhysics, desc);
@@ -766,6 +990,40 @@ namespace bs
 		return bs_shared_ptr_new<PhysXCharacterController>(mCharManager, desc);
 	}
 
+	void PhysX::moveCharacterControllers(CharacterController* const* controllers, const Vector3* displacements,
+		UINT32 count, CharacterCollisionFlags* flags, Vector3* positions)
+	{
+		// Minimum number of controllers moved by a single worker. Moves are fairly expensive (multiple sweeps each), so
+		// even small batches benefit from being split up.
+		static constexpr UINT32 GRAIN_SIZE = 8;
+
+		auto worker = [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				flags[i] = controllers[i]->move(displacements[i]);
+
+				if (positions != nullptr)
+					positions[i] = controllers[i]->getPosition();
+			}
+		};
+
+		if (count <= GRAIN_SIZE || !TaskScheduler::isStarted())
+		{
+			worker(0, count);
+			return;
+		}
+
+		// Hit events run user code, so they're buffered and triggered on this thread once all the moves are done
+		for (UINT32 i = 0; i < count; i++)
+			static_cast<PhysXCharacterController*>(controllers[i])->_setDeferHitEvents(true);
+
+		TaskScheduler::instance().parallelFor(count, GRAIN_SIZE, worker);
+
+		for (UINT32 i = 0; i < count; i++)
+			static_cast<PhysXCharacterController*>(controllers[i])->_setDeferHitEvents(false);
+	}
+
 	Vector<PhysicsQueryHit> PhysX::sweepAll(const PxGeometry& geometry, const PxTransform& tfrm, const Vector3& unitDir,
 		UINT64 layer, float maxDist) const
 	{
@@ -809,6 +1067,130 @@ namespace bs
 		return wasHit;
 	}
 
+	UINT32 PhysX::rayCastBatch(const Ray* rays, const float* maxDistances, UINT32 count, PhysicsQueryHit* hits,
+		UINT64 layer) const
+	{
+		// Maximum number of rays submitted to the scene in a single batch execution
+		static constexpr UINT32 MAX_RAYS_PER_BATCH = 512;
+
+		if (count == 0)
+			return 0;
+
+		const UINT32 batchSize = std::min(count, MAX_RAYS_PER_BATCH);
+		PxRaycastQueryResult* results = bs_stack_alloc<PxRaycastQueryResult>(batchSize);
+
+		// Only the closest (blocking) hit is needed, so no touch buffer is provided
+		PxBatchQueryDesc desc(batchSize, 0, 0);
+		desc.queryMemory.userRaycastResultBuffer = results;
+
+		PxBatchQuery* batchQuery = mScene->createBatchQuery(desc);
+
+		PxQueryFilterData filterData;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		UINT32 numHits = 0;
+		for (UINT32 batchStart = 0; batchStart < count; batchStart += batchSize)
+		{
+			const UINT32 numRays = std::min(batchSize, count - batchStart);
+			for (UINT32 i = 0; i < numRays; i++)
+			{
+				const Ray& ray = rays[batchStart + i];
+				batchQuery->raycast(toPxVector(ray.getOrigin()), toPxVector(ray.getDirection()), 
+					maxDistances[batchStart + i], 0, PxHitFlag::eDEFAULT | PxHitFlag::eUV, filterData);
+			}
+
+			batchQuery->execute();
+
+			for (UINT32 i = 0; i < numRays; i++)
+			{
+				PhysicsQueryHit& hit = hits[batchStart + i];
+				hit = PhysicsQueryHit();
+
+				if (results[i].queryStatus == PxBatchQueryStatus::eSUCCESS && results[i].hasBlock)
+				{
+					parseHit(results[i].block, hit);
+					numHits++;
+				}
+			}
+		}
+
+		batchQuery->release();
+		bs_stack_free(results);
+
+		return numHits;
+	}
+
+	/** Converts geometry of a batched query into PhysX geometry. */
+	static PxGeometryHolder toPxGeometry(const PhysicsQueryShape& shape)
+	{
+		switch (shape.type)
+		{
+		case PhysicsQueryShapeType::Box:
+			return PxBoxGeometry(toPxVector(shape.halfExtents));
+		case PhysicsQueryShapeType::Capsule:
+			return PxCapsuleGeometry(shape.radius, shape.halfHeight);
+		default:
+		case PhysicsQueryShapeType::Sphere:
+			return PxSphereGeometry(shape.radius);
+		}
+	}
+
+	UINT32 PhysX::shapeCastBatch(const PhysicsQueryShape* shapes, const Vector3* unitDirs, const float* maxDistances,
+		UINT32 count, PhysicsQueryHit* hits, UINT64 layer) const
+	{
+		// Maximum number of sweeps submitted to the scene in a single batch execution
+		static constexpr UINT32 MAX_SWEEPS_PER_BATCH = 512;
+
+		if (count == 0)
+			return 0;
+
+		const UINT32 batchSize = std::min(count, MAX_SWEEPS_PER_BATCH);
+		PxSweepQueryResult* results = bs_stack_alloc<PxSweepQueryResult>(batchSize);
+
+		// Only the closest (blocking) hit is needed, so no touch buffer is provided
+		PxBatchQueryDesc desc(0, batchSize, 0);
+		desc.queryMemory.userSweepResultBuffer = results;
+
+		PxBatchQuery* batchQuery = mScene->createBatchQuery(desc);
+
+		PxQueryFilterData filterData;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		UINT32 numHits = 0;
+		for (UINT32 batchStart = 0; batchStart < count; batchStart += batchSize)
+		{
+			const UINT32 numSweeps = std::min(batchSize, count - batchStart);
+			for (UINT32 i = 0; i < numSweeps; i++)
+			{
+				const PhysicsQueryShape& shape = shapes[batchStart + i];
+				const PxGeometryHolder geometry = toPxGeometry(shape);
+
+				batchQuery->sweep(geometry.any(), toPxTransform(shape.center, shape.rotation),
+					toPxVector(unitDirs[batchStart + i]), maxDistances[batchStart + i], 0,
+					PxHitFlag::eDEFAULT | PxHitFlag::eUV, filterData);
+			}
+
+			batchQuery->execute();
+
+			for (UINT32 i = 0; i < numSweeps; i++)
+			{
+				PhysicsQueryHit& hit = hits[batchStart + i];
+				hit = PhysicsQueryHit();
+
+				if (results[i].queryStatus == PxBatchQueryStatus::eSUCCESS && results[i].hasBlock)
+				{
+					parseHit(results[i].block, hit);
+					numHits++;
+				}
+			}
+		}
+
+		batchQuery->release();
+		bs_stack_free(results);
+
+		return numHits;
+	}
+
 	bool PhysX::boxCast(const AABox& box, const Quaternion& rotation, const Vector3& unitDir, PhysicsQueryHit& hit,
 		UINT64 layer, float max) const
 	{
@@ -1088,6 +1470,142 @@ namespace bs
 		return wasHit;
 	}
 
+	UINT32 PhysX::shapeOverlapBatch(const PhysicsQueryShape* shapes, UINT32 count, Collider** colliders,
+		UINT32 maxColliders, UINT32* numOverlaps, UINT64 layer) const
+	{
+		// Maximum number of overlaps submitted to the scene in a single batch execution
+		static constexpr UINT32 MAX_OVERLAPS_PER_BATCH = 64;
+
+		// Maximum number of overlapping colliders that can be reported by all the queries in a single batch
+		static constexpr UINT32 MAX_TOUCHES_PER_BATCH = 1024;
+
+		if (count == 0)
+			return 0;
+
+		const UINT32 batchSize = std::min(count, MAX_OVERLAPS_PER_BATCH);
+		PxOverlapQueryResult* results = bs_stack_alloc<PxOverlapQueryResult>(batchSize);
+		PxOverlapHit* touches = bs_stack_alloc<PxOverlapHit>(MAX_TOUCHES_PER_BATCH);
+
+		PxBatchQueryDesc desc(0, 0, batchSize);
+		desc.queryMemory.userOverlapResultBuffer = results;
+		desc.queryMemory.userOverlapTouchBuffer = touches;
+		desc.queryMemory.overlapTouchBufferSize = MAX_TOUCHES_PER_BATCH;
+
+		PxBatchQuery* batchQuery = mScene->createBatchQuery(desc);
+
+		// Report all overlaps as touches, as no blocking hit is needed
+		PxQueryFilterData filterData;
+		filterData.flags |= PxQueryFlag::eNO_BLOCK;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		UINT32 numColliders = 0;
+		for (UINT32 batchStart = 0; batchStart < count; batchStart += batchSize)
+		{
+			const UINT32 numQueries = std::min(batchSize, count - batchStart);
+			for (UINT32 i = 0; i < numQueries; i++)
+			{
+				const PhysicsQueryShape& shape = shapes[batchStart + i];
+				const PxGeometryHolder geometry = toPxGeometry(shape);
+
+				batchQuery->overlap(geometry.any(), toPxTransform(shape.center, shape.rotation),
+					(PxU16)MAX_TOUCHES_PER_BATCH, filterData);
+			}
+
+			batchQuery->execute();
+
+			for (UINT32 i = 0; i < numQueries; i++)
+			{
+				const UINT32 queryIdx = batchStart + i;
+				const UINT32 remaining = maxColliders - numColliders;
+				numOverlaps[queryIdx] = 0;
+
+				if (results[i].queryStatus == PxBatchQueryStatus::eSUCCESS)
+				{
+					const UINT32 numToWrite = std::min((UINT32)results[i].nbTouches, remaining);
+					for (UINT32 j = 0; j < numToWrite; j++)
+						colliders[numColliders + j] = (Collider*)results[i].touches[j].shape->userData;
+
+					numOverlaps[queryIdx] = numToWrite;
+				}
+				else if (results[i].queryStatus == PxBatchQueryStatus::eOVERFLOW && remaining > 0)
+				{
+					// Touch buffer was exhausted by other queries in the batch, fall back to a regular query
+					const PhysicsQueryShape& shape = shapes[queryIdx];
+					const PxGeometryHolder geometry = toPxGeometry(shape);
+
+					Vector<Collider*> overlaps = overlap(geometry.any(), toPxTransform(shape.center, shape.rotation),
+						layer);
+
+					const UINT32 numToWrite = std::min((UINT32)overlaps.size(), remaining);
+					for (UINT32 j = 0; j < numToWrite; j++)
+						colliders[numColliders + j] = overlaps[j];
+
+					numOverlaps[queryIdx] = numToWrite;
+				}
+
+				numColliders += numOverlaps[queryIdx];
+			}
+		}
+
+		batchQuery->release();
+		bs_stack_free(touches);
+		bs_stack_free(results);
+
+		return numColliders;
+	}
+
+	UINT32 PhysX::shapeOverlapAnyBatch(const PhysicsQueryShape* shapes, UINT32 count, bool* overlaps,
+		UINT64 layer) const
+	{
+		// Maximum number of overlaps submitted to the scene in a single batch execution
+		static constexpr UINT32 MAX_OVERLAPS_PER_BATCH = 512;
+
+		if (count == 0)
+			return 0;
+
+		const UINT32 batchSize = std::min(count, MAX_OVERLAPS_PER_BATCH);
+		PxOverlapQueryResult* results = bs_stack_alloc<PxOverlapQueryResult>(batchSize);
+
+		// Any hit is reported as a blocking hit, so no touch buffer is provided
+		PxBatchQueryDesc desc(0, 0, batchSize);
+		desc.queryMemory.userOverlapResultBuffer = results;
+
+		PxBatchQuery* batchQuery = mScene->createBatchQuery(desc);
+
+		PxQueryFilterData filterData;
+		filterData.flags |= PxQueryFlag::eANY_HIT;
+		memcpy(&filterData.data.word0, &layer, sizeof(layer));
+
+		UINT32 numOverlapping = 0;
+		for (UINT32 batchStart = 0; batchStart < count; batchStart += batchSize)
+		{
+			const UINT32 numQueries = std::min(batchSize, count - batchStart);
+			for (UINT32 i = 0; i < numQueries; i++)
+			{
+				const PhysicsQueryShape& shape = shapes[batchStart + i];
+				const PxGeometryHolder geometry = toPxGeometry(shape);
+
+				batchQuery->overlap(geometry.any(), toPxTransform(shape.center, shape.rotation), 0, filterData);
+			}
+
+			batchQuery->execute();
+
+			for (UINT32 i = 0; i < numQueries; i++)
+			{
+				const bool overlapping = results[i].queryStatus == PxBatchQueryStatus::eSUCCESS && results[i].hasBlock;
+				overlaps[batchStart + i] = overlapping;
+
+				if (overlapping)
+					numOverlapping++;
+			}
+		}
+
+		batchQuery->release();
+		bs_stack_free(results);
+
+		return numOverlapping;
+	}
+
 	bool PhysX::overlapAny(const PxGeometry& geometry, const PxTransform& tfrm, UINT64 layer) const
 	{
 		PxOverlapBuffer output;
@@ -1114,9 +1632,8 @@ namespace bs
 	{
 		Physics::setFlag(flag, enabled);
 
-		mCharManager->setOverlapRecoveryModule(mFlags.isSet(PhysicsFlag::CCT_OverlapRecovery));
-		mCharManager->setPreciseSweeps(mFlags.isSet(PhysicsFlag::CCT_PreciseSweeps));
-		mCharManager->setTessellation(mFlags.isSet(PhysicsFlag::CCT_Tesselation), mTesselationLength);
+		for (auto& entry : mScenes)
+			applyControllerFlags(entry.second.charManager);
 	}
 
 	void PhysX::setPaused(bool paused)
@@ -1138,7 +1655,8 @@ namespace bs
 	{
 		mTesselationLength = length;
 
-		mCharManager->setTessellation(mFlags.isSet(PhysicsFlag::CCT_Tesselation), mTesselationLength);
+		for (auto& entry : mScenes)
+			applyControllerFlags(entry.second.charManager);
 	}
 
 	UINT32 PhysX::addBroadPhaseRegion(const AABox& region)
@@ -1150,27 +1668,78 @@ namespace bs
 		pxRegion.userData = (void*)(UINT64)id;
 
 		UINT32 handle = mScene->addBroadPhaseRegion(pxRegion, true);
-		mBroadPhaseRegionHandles[id] = handle;
+		mActiveScene->broadPhaseRegionHandles[id] = handle;
 
-		return handle;
+		return id;
 	}
 
 	void PhysX::removeBroadPhaseRegion(UINT32 regionId)
 	{
-		auto iterFind = mBroadPhaseRegionHandles.find(regionId);
-		if (iterFind == mBroadPhaseRegionHandles.end())
+		auto& regionHandles = mActiveScene->broadPhaseRegionHandles;
+
+		auto iterFind = regionHandles.find(regionId);
+		if (iterFind == regionHandles.end())
 			return;
 
 		mScene->removeBroadPhaseRegion(iterFind->second);
-		mBroadPhaseRegionHandles.erase(iterFind);
+		regionHandles.erase(iterFind);
 	}
 
 	void PhysX::clearBroadPhaseRegions()
 	{
-		for(auto& entry : mBroadPhaseRegionHandles)
+		for(auto& entry : mActiveScene->broadPhaseRegionHandles)
 			mScene->removeBroadPhaseRegion(entry.second);
 
-		mBroadPhaseRegionHandles.clear();
+		mActiveScene->broadPhaseRegionHandles.clear();
+	}
+
+	UINT32 PhysX::addScene()
+	{
+		const UINT32 sceneId = mNextSceneId++;
+		mScenes[sceneId] = createScene();
+
+		return sceneId;
+	}
+
+	void PhysX::removeScene(UINT32 sceneId)
+	{
+		if (sceneId == 0)
+		{
+			LOGWRN("The default physics scene cannot be removed.");
+			return;
+		}
+
+		auto iterFind = mScenes.find(sceneId);
+		if (iterFind == mScenes.end())
+			return;
+
+		SceneData& data = iterFind->second;
+		if (data.scene->getNbActors(PxActorTypeFlag::eRIGID_STATIC | PxActorTypeFlag::eRIGID_DYNAMIC) > 0)
+		{
+			LOGWRN("Cannot remove a physics scene that still contains physics objects.");
+			return;
+		}
+
+		if (mActiveSceneId == sceneId)
+			setActiveScene(0);
+
+		destroyScene(data);
+		mScenes.erase(iterFind);
+	}
+
+	void PhysX::setActiveScene(UINT32 sceneId)
+	{
+		auto iterFind = mScenes.find(sceneId);
+		if (iterFind == mScenes.end())
+		{
+			LOGWRN("Physics scene with ID " + toString(sceneId) + " doesn't exist.");
+			return;
+		}
+
+		mActiveSceneId = sceneId;
+		mActiveScene = &iterFind->second;
+		mScene = mActiveScene->scene;
+		mCharManager = mActiveScene->charManager;
 	}
 
 	PhysX& gPhysX()
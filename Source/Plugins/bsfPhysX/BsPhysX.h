@@ -87,6 +87,10 @@ namespace bs
 		/** @copydoc Physics::createMeshCollider */
 		SPtr<MeshCollider> createMeshCollider(const Vector3& position, const Quaternion& rotation) override;
 
+		/** @copydoc Physics::createHeightFieldCollider */
+		SPtr<HeightFieldCollider> createHeightFieldCollider(const Vector3& position,
+			const Quaternion& rotation) override;
+
 		/** @copydoc Physics::createFixedJoint */
 		SPtr<FixedJoint> createFixedJoint(const FIXED_JOINT_DESC& desc) override;
 
@@ -108,10 +112,22 @@ namespace bs
 		/** @copydoc Physics::createCharacterController*/
 		SPtr<CharacterController> createCharacterController(const CHAR_CONTROLLER_DESC& desc) override;
 
+		/** @copydoc Physics::moveCharacterControllers */
+		void moveCharacterControllers(CharacterController* const* controllers, const Vector3* displacements,
+			UINT32 count, CharacterCollisionFlags* flags, Vector3* positions = nullptr) override;
+
 		/** @copydoc Physics::rayCast(const Vector3&, const Vector3&, PhysicsQueryHit&, UINT64, float) const */
 		bool rayCast(const Vector3& origin, const Vector3& unitDir, PhysicsQueryHit& hit,
 			UINT64 layer = BS_ALL_LAYERS, float max = FLT_MAX) const override;
 
+		/** @copydoc Physics::rayCastBatch */
+		UINT32 rayCastBatch(const Ray* rays, const float* maxDistances, UINT32 count, PhysicsQueryHit* hits,
+			UINT64 layer = BS_ALL_LAYERS) const override;
+
+		/** @copydoc Physics::shapeCastBatch */
+		UINT32 shapeCastBatch(const PhysicsQueryShape* shapes, const Vector3* unitDirs, const float* maxDistances,
+			UINT32 count, PhysicsQueryHit* hits, UINT64 layer = BS_ALL_LAYERS) const override;
+
 		/** @copydoc Physics::boxCast */
 		bool boxCast(const AABox& box, const Quaternion& rotation, const Vector3& unitDir, PhysicsQueryHit& hit,
 			UINT64 layer = BS_ALL_LAYERS, float max = FLT_MAX) const override;
@@ -183,6 +199,14 @@ namespace bs
 		bool convexOverlapAny(const HPhysicsMesh& mesh, const Vector3& position, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const override;
 
+		/** @copydoc Physics::shapeOverlapBatch */
+		UINT32 shapeOverlapBatch(const PhysicsQueryShape* shapes, UINT32 count, Collider** colliders,
+			UINT32 maxColliders, UINT32* numOverlaps, UINT64 layer = BS_ALL_LAYERS) const override;
+
+		/** @copydoc Physics::shapeOverlapAnyBatch */
+		UINT32 shapeOverlapAnyBatch(const PhysicsQueryShape* shapes, UINT32 count, bool* overlaps,
+			UINT64 layer = BS_ALL_LAYERS) const override;
+
 		/** @copydoc Physics::setFlag */
 		void setFlag(PhysicsFlags flags, bool enabled) override;
 
@@ -210,6 +234,18 @@ namespace bs
 		/** @copydoc Physics::clearBroadPhaseRegions */
 		void clearBroadPhaseRegions() override;
 
+		/** @copydoc Physics::addScene */
+		UINT32 addScene() override;
+
+		/** @copydoc Physics::removeScene */
+		void removeScene(UINT32 sceneId) override;
+
+		/** @copydoc Physics::setActiveScene */
+		void setActiveScene(UINT32 sceneId) override;
+
+		/** @copydoc Physics::getActiveScene */
+		UINT32 getActiveScene() const override { return mActiveSceneId; }
+
 		/** @copydoc Physics::_boxOverlap */
 		Vector<Collider*> _boxOverlap(const AABox& box, const Quaternion& rotation,
 			UINT64 layer = BS_ALL_LAYERS) const override;
@@ -238,13 +274,16 @@ namespace bs
 		/** Triggered by the PhysX simulation when a joint breaks. */
 		void _reportJointBreakEvent(const JointBreakEvent& event);
 
+		/** Notifies the system a rigidbody is being destroyed, so it stops referencing it. */
+		void _notifyRigidbodyDestroyed(Rigidbody* rigidbody);
+
 		/** Returns the default PhysX material. */
 		physx::PxMaterial* getDefaultMaterial() const { return mDefaultMaterial; }
 
 		/** Returns the main PhysX object. */
 		physx::PxPhysics* getPhysX() const { return mPhysics; }
 
-		/** Returns the main PhysX scene. */
+		/** Returns the currently active PhysX scene. */
 		physx::PxScene* getScene() const { return mScene; }
 
 		/** Returns the PhysX object used for mesh cooking. */
@@ -256,9 +295,46 @@ namespace bs
 	private:
 		friend class PhysXEventCallback;
 
+		/** A single PhysX scene, along with the data required for simulating it. */
+		struct SceneData
+		{
+			physx::PxScene* scene = nullptr;
+			physx::PxControllerManager* charManager = nullptr;
+			UINT8* scratchBuffer = nullptr;
+			bool simulationInProgress = false;
+			UnorderedMap<UINT32, UINT32> broadPhaseRegionHandles;
+		};
+
+		/** Transform of a rigidbody moved by the simulation, interpolated each frame when simulating asynchronously. */
+		struct InterpolatedTransform
+		{
+			Vector3 prevPosition;
+			Quaternion prevRotation;
+			Vector3 position;
+			Quaternion rotation;
+		};
+
 		/** Sends out all events recorded during simulation to the necessary physics objects. */
 		void triggerEvents();
 
+		/** Creates a new PhysX scene and its character controller manager. */
+		SceneData createScene() const;
+
+		/** Releases a PhysX scene created with createScene(). */
+		void destroyScene(SceneData& data);
+
+		/** Applies the current character controller options to the controller manager of a scene. */
+		void applyControllerFlags(physx::PxControllerManager* charManager) const;
+
+		/**
+		 * Waits until the simulation of all scenes started by the last fixed update finishes, and applies its results
+		 * to the rigidbodies.
+		 */
+		void fetchSimulationResults();
+
+		/** Applies the transforms of all actors moved by the most recently fetched simulation step of the scene. */
+		void applySimulationResults(physx::PxScene* scene);
+
 		/**
 		 * Helper method that performs a sweep query by checking if the provided geometry hits any physics objects
 		 * when moved along the specified direction. Returns information about the first hit.
@@ -291,11 +367,19 @@ namespace bs
 		float mTesselationLength = 3.0f;
 		UINT32 mNextRegionIdx = 1;
 		bool mPaused = false;
+		bool mAsyncSimulation = false;
+		bool mRegionBroadPhase = false;
+		bool mCCDEnabled = false;
+		Vector3 mInitialGravity;
 
 		Vector<TriggerEvent> mTriggerEvents;
 		Vector<ContactEvent> mContactEvents;
 		Vector<JointBreakEvent> mJointBreakEvents;
-		UnorderedMap<UINT32, UINT32> mBroadPhaseRegionHandles;
+		UnorderedMap<UINT32, SceneData> mScenes;
+		UINT32 mNextSceneId = 1;
+		UINT32 mActiveSceneId = 0;
+		SceneData* mActiveScene = nullptr;
+		UnorderedMap<Rigidbody*, InterpolatedTransform> mInterpolatedTransforms;
 
 		physx::PxFoundation* mFoundation = nullptr;
 		physx::PxPhysics* mPhysics = nullptr;
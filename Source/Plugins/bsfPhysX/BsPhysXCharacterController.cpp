@@ -218,6 +218,23 @@ namespace bs
 		mController->setSlopeLimit(value.valueRadians());
 	}
 
+	void PhysXCharacterController::_setDeferHitEvents(bool defer)
+	{
+		mDeferHitEvents = defer;
+
+		if (defer)
+			return;
+
+		for (auto& entry : mDeferredColliderHits)
+			onColliderHit(entry);
+
+		for (auto& entry : mDeferredControllerHits)
+			CharacterController::onControllerHit(entry);
+
+		mDeferredColliderHits.clear();
+		mDeferredControllerHits.clear();
+	}
+
 	void PhysXCharacterController::onShapeHit(const PxControllerShapeHit& hit)
 	{
 		if (onColliderHit.empty())
@@ -231,7 +248,10 @@ namespace bs
 		collision.triangleIndex = hit.triangleIndex;
 		collision.colliderRaw = (Collider*)hit.shape->userData;
 
-		onColliderHit(collision);
+		if (mDeferHitEvents)
+			mDeferredColliderHits.push_back(collision);
+		else
+			onColliderHit(collision);
 	}
 
 	void PhysXCharacterController::onControllerHit(const PxControllersHit& hit)
@@ -246,7 +266,10 @@ namespace bs
 		collision.motionAmount = hit.length;
 		collision.controllerRaw = (CharacterController*)hit.controller->getUserData();
 
-		CharacterController::onControllerHit(collision);
+		if (mDeferHitEvents)
+			mDeferredControllerHits.push_back(collision);
+		else
+			CharacterController::onControllerHit(collision);
 	}
 
 	PxQueryHitType::Enum PhysXCharacterController::preFilter(const PxFilterData& filterData, const PxShape* shape,
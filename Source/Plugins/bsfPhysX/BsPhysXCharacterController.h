@@ -92,6 +92,12 @@ namespace bs
 		/** @copydoc CharacterController::setSlopeLimit */
 		void setSlopeLimit(Radian value) override;
 
+		/**
+		 * Determines should hit events be buffered instead of triggered as they occur. Used when moving controllers
+		 * from worker threads. Disabling deferral triggers all the buffered events.
+		 */
+		void _setDeferHitEvents(bool defer);
+
 	private:
 		/** @copydoc physx::PxUserControllerHitReport::onShapeHit */
 		void onShapeHit(const physx::PxControllerShapeHit& hit) override;
@@ -116,6 +122,10 @@ namespace bs
 		physx::PxCapsuleController* mController = nullptr;
 		float mMinMoveDistance = 0.0f;
 		float mLastMoveCall = 0.0f;
+
+		bool mDeferHitEvents = false;
+		Vector<ControllerColliderCollision> mDeferredColliderHits;
+		Vector<ControllerControllerCollision> mDeferredControllerHits;
 	};
 
 	/** @} */
@@ -0,0 +1,136 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsPhysXHeightFieldCollider.h"
+#include "BsPhysX.h"
+#include "PxPhysics.h"
+#include "BsFPhysXCollider.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxHeightFieldDesc.h"
+#include "geometry/PxHeightFieldGeometry.h"
+#include "geometry/PxHeightFieldSample.h"
+
+using namespace physx;
+
+namespace bs
+{
+	PhysXHeightFieldCollider::PhysXHeightFieldCollider(PxPhysics* physx, const Vector3& position,
+		const Quaternion& rotation)
+	{
+		PxSphereGeometry geometry(0.01f); // Dummy
+
+		PxShape* shape = physx->createShape(geometry, *gPhysX().getDefaultMaterial(), true);
+		shape->setLocalPose(toPxTransform(position, rotation));
+		shape->userData = this;
+
+		mInternal = bs_new<FPhysXCollider>(shape);
+	}
+
+	PhysXHeightFieldCollider::~PhysXHeightFieldCollider()
+	{
+		bs_delete(mInternal);
+
+		if (mHeightField != nullptr)
+			mHeightField->release();
+	}
+
+	void PhysXHeightFieldCollider::setScale(const Vector3& scale)
+	{
+		HeightFieldCollider::setScale(scale);
+		applyGeometry();
+	}
+
+	void PhysXHeightFieldCollider::setSpacing(const Vector2& spacing)
+	{
+		HeightFieldCollider::setSpacing(spacing);
+		applyGeometry();
+	}
+
+	void PhysXHeightFieldCollider::onHeightsChanged()
+	{
+		rebuildHeightField();
+		applyGeometry();
+	}
+
+	void PhysXHeightFieldCollider::rebuildHeightField()
+	{
+		if (mHeightField != nullptr)
+		{
+			// Shape must stop referencing the height field before it is released
+			setGeometry(PxSphereGeometry(0.01f)); // Dummy
+
+			mHeightField->release();
+			mHeightField = nullptr;
+		}
+
+		if (mHeights.empty())
+			return;
+
+		// Heights are stored as 16-bit integers, scaled so the largest height uses the full range
+		float maxHeight = 0.0f;
+		for (auto& entry : mHeights)
+			maxHeight = std::max(maxHeight, Math::abs(entry));
+
+		mHeightScale = maxHeight > 0.0f ? maxHeight / (float)std::numeric_limits<PxI16>::max() : 1.0f;
+
+		// PhysX height field rows run along the X axis, and columns along the Z axis
+		Vector<PxHeightFieldSample> samples(mNumColumns * mNumRows);
+		for (UINT32 z = 0; z < mNumRows; z++)
+		{
+			for (UINT32 x = 0; x < mNumColumns; x++)
+			{
+				PxHeightFieldSample& sample = samples[x * mNumRows + z];
+				sample.height = (PxI16)Math::clamp(Math::roundToInt(mHeights[z * mNumColumns + x] / mHeightScale),
+					-(INT32)std::numeric_limits<PxI16>::max(), (INT32)std::numeric_limits<PxI16>::max());
+				sample.materialIndex0 = 0;
+				sample.materialIndex1 = 0;
+			}
+		}
+
+		PxHeightFieldDesc desc;
+		desc.format = PxHeightFieldFormat::eS16_TM;
+		desc.nbRows = mNumColumns;
+		desc.nbColumns = mNumRows;
+		desc.samples.data = samples.data();
+		desc.samples.stride = sizeof(PxHeightFieldSample);
+
+		mHeightField = gPhysX().getPhysX()->createHeightField(desc);
+		if (mHeightField == nullptr)
+			LOGERR("Failed to create a PhysX height field.");
+	}
+
+	void PhysXHeightFieldCollider::applyGeometry()
+	{
+		if (mHeightField == nullptr)
+		{
+			setGeometry(PxSphereGeometry(0.01f)); // Dummy
+			return;
+		}
+
+		const Vector3 scale = getScale();
+
+		PxHeightFieldGeometry geometry;
+		geometry.heightField = mHeightField;
+		geometry.heightScale = mHeightScale * scale.y;
+		geometry.rowScale = std::max(mSpacing.x * scale.x, PX_MIN_HEIGHTFIELD_XZ_SCALE);
+		geometry.columnScale = std::max(mSpacing.y * scale.z, PX_MIN_HEIGHTFIELD_XZ_SCALE);
+
+		setGeometry(geometry);
+	}
+
+	void PhysXHeightFieldCollider::setGeometry(const PxGeometry& geometry)
+	{
+		PxShape* shape = getInternal()->_getShape();
+		if (shape->getGeometryType() != geometry.getType())
+		{
+			PxShape* newShape = gPhysX().getPhysX()->createShape(geometry, *gPhysX().getDefaultMaterial(), true);
+			getInternal()->_setShape(newShape);
+		}
+		else
+			getInternal()->_getShape()->setGeometry(geometry);
+	}
+
+	FPhysXCollider* PhysXHeightFieldCollider::getInternal() const
+	{
+		return static_cast<FPhysXCollider*>(mInternal);
+	}
+}
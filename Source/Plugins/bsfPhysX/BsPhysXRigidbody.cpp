@@ -59,6 +59,8 @@ namespace bs
 
 	PhysXRigidbody::~PhysXRigidbody()
 	{
+		gPhysX()._notifyRigidbodyDestroyed(this);
+
 		mInternal->userData = nullptr;
 		mInternal->release();
 	}
@@ -17,17 +17,17 @@ namespace bs
 	class FPhysXMeshRTTI : public RTTIType<FPhysXMesh, FPhysicsMesh, FPhysXMeshRTTI>
 	{
 	private:
-		SPtr<DataStream> getCookedData(FPhysXMesh* obj, UINT32& size)
+		SPtr<DataStream> getCookedData(FPhysXMesh* obj, UINT64& size)
 		{
 			size = obj->mCookedDataSize;
 
 			return bs_shared_ptr_new<MemoryDataStream>(obj->mCookedData, obj->mCookedDataSize, false);
 		}
 
-		void setCookedData(FPhysXMesh* obj, const SPtr<DataStream>& value, UINT32 size)
+		void setCookedData(FPhysXMesh* obj, const SPtr<DataStream>& value, UINT64 size)
 		{
 			obj->mCookedData = (UINT8*)bs_alloc(size);
-			obj->mCookedDataSize = size;
+			obj->mCookedDataSize = (UINT32)size;
 
 			value->read(obj->mCookedData, size);
 		}
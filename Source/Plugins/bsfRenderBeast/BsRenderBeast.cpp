@@ -10,6 +10,7 @@
 #include "RenderAPI/BsViewport.h"
 #include "RenderAPI/BsRenderTarget.h"
 #include "RenderAPI/BsGpuParamBlockBuffer.h"
+#include "RenderAPI/BsCommandBuffer.h"
 #include "Profiling/BsProfilerCPU.h"
 #include "Profiling/BsProfilerGPU.h"
 #include "Utility/BsTime.h"
@@ -24,7 +25,9 @@
 #include "Renderer/BsCamera.h"
 #include "Renderer/BsRendererUtility.h"
 #include "Utility/BsRendererTextures.h"
+#include "Utility/BsGpuTextureCompression.h"
 #include "Renderer/BsGpuResourcePool.h"
+#include "Renderer/BsTextureTable.h"
 #include "Renderer/BsRendererManager.h"
 #include "Shading/BsShadowRendering.h"
 #include "Shading/BsStandardDeferred.h"
@@ -38,6 +41,38 @@ using namespace std::placeholders;
 
 namespace bs { namespace ct
 {
+	/** Builds the light grid layout from the user provided renderer options. */
+	static LIGHT_GRID_DESC getLightGridDesc(const RenderBeastOptions& options)
+	{
+		LIGHT_GRID_DESC desc;
+		desc.cellSize = options.lightGridCellSize;
+		desc.numSlices = options.lightGridNumSlices;
+		desc.maxLightsPerCell = options.lightGridMaxLightsPerCell;
+
+		return desc;
+	}
+
+	/** 
+	 * Picks the render device to render an offscreen render target on, according to the multi-GPU mode. @p targetIdx
+	 * is the index of the target among all offscreen targets rendered this frame.
+	 */
+	static UINT32 getRenderDevice(const RenderBeastOptions& options, UINT64 frameIdx, UINT32 targetIdx)
+	{
+		const UINT32 numDevices = RenderAPI::instance().getNumRenderDevices();
+		if (numDevices <= 1)
+			return 0;
+
+		switch (options.multiGpu)
+		{
+		case RenderBeastMultiGpu::AlternateFrame:
+			return (UINT32)(frameIdx % numDevices);
+		case RenderBeastMultiGpu::SplitView:
+			return targetIdx % numDevices;
+		default:
+			return 0;
+		}
+	}
+
 	RenderBeast::RenderBeast()
 	{
 		mOptions = bs_shared_ptr_new<RenderBeastOptions>();
@@ -83,6 +118,7 @@ namespace bs { namespace ct
 		RendererUtility::startUp();
 		GpuSort::startUp();
 		GpuResourcePool::startUp();
+		TextureTable::startUp();
 		IBLUtility::startUp<RenderBeastIBLUtility>();
 		RendererTextures::startUp();
 
@@ -107,11 +143,13 @@ namespace bs { namespace ct
 		RenderCompositor::registerNodeType<RCNodeFinalResolve>();
 		RenderCompositor::registerNodeType<RCNodeSkybox>();
 		RenderCompositor::registerNodeType<RCNodePostProcess>();
+		RenderCompositor::registerNodeType<RCNodeTemporalAA>();
 		RenderCompositor::registerNodeType<RCNodeTonemapping>();
 		RenderCompositor::registerNodeType<RCNodeGaussianDOF>();
 		RenderCompositor::registerNodeType<RCNodeFXAA>();
 		RenderCompositor::registerNodeType<RCNodeResolvedSceneDepth>();
 		RenderCompositor::registerNodeType<RCNodeHiZ>();
+		RenderCompositor::registerNodeType<RCNodeOcclusionCulling>();
 		RenderCompositor::registerNodeType<RCNodeSSAO>();
 		RenderCompositor::registerNodeType<RCNodeClusteredForward>();
 		RenderCompositor::registerNodeType<RCNodeSSR>();
@@ -140,6 +178,7 @@ namespace bs { namespace ct
 
 		RendererTextures::shutDown();
 		IBLUtility::shutDown();
+		TextureTable::shutDown();
 		GpuResourcePool::shutDown();
 		GpuSort::shutDown();
 		RendererUtility::shutDown();
@@ -285,6 +324,10 @@ namespace bs { namespace ct
 
 		ShadowRendering& shadowRenderer = mMainViewGroup->getShadowRenderer();
 		shadowRenderer.setShadowMapSize(mCoreOptions->shadowMapSize);
+		shadowRenderer.setStaticShadowCaching(mCoreOptions->staticShadowCaching);
+		shadowRenderer.setShadowUpdateBudget(mCoreOptions->shadowUpdateBudget);
+
+		mMainViewGroup->setLightGridDesc(getLightGridDesc(*mCoreOptions));
 	}
 
 	ShaderExtensionPointInfo RenderBeast::getShaderExtensionPointInfo(const String& name)
@@ -359,6 +402,8 @@ namespace bs { namespace ct
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
+		MemoryTagScope memoryTagScope(MemoryTag::Rendering);
+
 		gProfilerGPU().beginFrame();
 		gProfilerCPU().beginSample("Render");
 
@@ -371,22 +416,31 @@ namespace bs { namespace ct
 
 		// Update global per-frame hardware buffers
 		mScene->setParamFrameParams(timings.time);
+		mScene->updateRenderableObjectData();
+		mScene->updateInstancedMaterialTextures();
 
 		// Update bounds for all particle systems
 		if(perFrameData.particles)
 			PROFILE_CALL(mScene->updateParticleSystemBounds(perFrameData.particles), "Particle bounds")
 
-		sceneInfo.renderableReady.resize(sceneInfo.renderables.size(), false);
-		sceneInfo.renderableReady.assign(sceneInfo.renderables.size(), false);
+		sceneInfo.renderableReady.resize((UINT32)sceneInfo.renderables.size());
+		sceneInfo.renderableReady.reset(false);
+
+		sceneInfo.decalReady.resize((UINT32)sceneInfo.decals.size());
+		sceneInfo.decalReady.reset(false);
 		
 		FrameInfo frameInfo(timings, perFrameData);
 
 		// Make sure any renderer tasks finish first, as rendering might depend on them
+		beginReflProbeUpdateFrame();
 		processTasks(false);
 
 		// If any reflection probes were updated or added, we need to copy them over in the global reflection probe array
 		updateReflProbeArray();
 
+		// Update the procedural sky, and its image based lighting if the sun moved
+		mScene->updateSkyAtmosphere();
+
 		// Update material animation times for all renderables
 		for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
 		{
@@ -395,15 +449,35 @@ namespace bs { namespace ct
 				element.materialAnimationTime += timings.timeDelta;
 		}
 
+		// Decals are prepared once their visibility is known, see renderViews()
 		for (UINT32 i = 0; i < sceneInfo.decals.size(); i++)
 		{
 			const RendererDecal& decal = sceneInfo.decals[i];
 			decal.renderElement.materialAnimationTime += timings.timeDelta;
+		}
 
-			mScene->prepareDecal(i, frameInfo);
+		// Let the application adjust camera transforms using the most recent input, as late as possible
+		Vector<std::pair<Camera*, Transform>> latchedCameras;
+		if (mLateLatchCallback)
+		{
+			for (auto& entry : sceneInfo.cameraToView)
+			{
+				auto* camera = const_cast<Camera*>(entry.first);
+				if (camera->getMobility() != ObjectMobility::Movable)
+					continue;
+
+				const Transform originalTransform = camera->getTransform();
+				if (!mLateLatchCallback(*camera))
+					continue;
+
+				latchedCameras.push_back(std::make_pair(camera, originalTransform));
+				mScene->updateCamera(camera, (UINT32)ActorDirtyFlag::Transform);
+			}
 		}
 
 		// Gather all views
+		RenderAPI& rapi = RenderAPI::instance();
+		UINT32 numOffscreenTargets = 0;
 		for (auto& rtInfo : sceneInfo.renderTargets)
 		{
 			Vector<RendererView*> views;
@@ -418,16 +492,41 @@ namespace bs { namespace ct
 				views.push_back(viewInfo);
 			}
 
+			// Windows must be rendered on the device presenting them, while offscreen targets can be distributed
+			const bool isWindow = rtInfo.target->getProperties().isWindow;
+			UINT32 deviceIdx = 0;
+			if(!isWindow)
+				deviceIdx = getRenderDevice(*mCoreOptions, frameInfo.frameIdx, numOffscreenTargets++);
+
+			// Compute queue sync only works within a single device
+			mMainViewGroup->setDevice(deviceIdx);
+			mMainViewGroup->setAsyncCompute(mCoreOptions->asyncCompute && deviceIdx == 0);
+			mMainViewGroup->setStereoCulling(mCoreOptions->stereoCulling);
+			rapi.setActiveDevice(deviceIdx);
+
 			mMainViewGroup->setViews(views.data(), (UINT32)views.size());
 			PROFILE_CALL(mMainViewGroup->determineVisibility(sceneInfo), "Determine visibility")
 
 			// Render everything
 			renderViews(*mMainViewGroup, frameInfo);
 
-			if(rtInfo.target->getProperties().isWindow)
-				PROFILE_CALL(RenderAPI::instance().swapBuffers(rtInfo.target), "Swap buffers");
+			rapi.setActiveDevice(0);
+
+			if(isWindow)
+				PROFILE_CALL(rapi.swapBuffers(rtInfo.target), "Swap buffers");
 		}
 
+		// Late latched transforms only apply to a single frame
+		for (auto& entry : latchedCameras)
+		{
+			entry.first->setTransform(entry.second);
+			mScene->updateCamera(entry.first, (UINT32)ActorDirtyFlag::Transform);
+		}
+
+		// Free any pooled render targets that are no longer being used
+		GpuResourcePool::instance().update();
+		TextureTable::instance().update();
+
 		gProfilerGPU().endFrame();
 		gProfilerCPU().endSample("Render");
 	}
@@ -439,18 +538,20 @@ namespace bs { namespace ct
 
 		// Render shadow maps
 		ShadowRendering& shadowRenderer = viewGroup.getShadowRenderer();
-		shadowRenderer.renderShadowMaps(*mScene, viewGroup, frameInfo);
+		PROFILE_CALL(shadowRenderer.renderShadowMaps(*mScene, viewGroup, frameInfo), "Render shadows")
 
-		// Update various buffers required by each renderable
-		UINT32 numRenderables = (UINT32)sceneInfo.renderables.size();
-		for (UINT32 i = 0; i < numRenderables; i++)
+		// Submit shadow rendering without waiting on the compute queue, so it can execute in parallel with any work
+		// queued there. Anything submitted after will wait on the compute queue by default.
+		if(viewGroup.hasPendingAsyncCompute())
 		{
-			if (!visibility.renderables[i])
-				continue;
-
-			mScene->prepareRenderable(i, frameInfo);
+			const UINT32 syncMask = ~CommandSyncMask::getGlobalQueueMask(GQT_COMPUTE, 0);
+			RenderAPI::instance().submitCommandBuffer(nullptr, syncMask);
 		}
 
+		// Update various buffers required by each renderable
+		PROFILE_CALL(mScene->prepareRenderables(visibility.renderables, frameInfo), "Prepare renderables")
+		PROFILE_CALL(mScene->prepareDecals(visibility.decals, frameInfo), "Prepare decals")
+
 		UINT32 numViews = viewGroup.getNumViews();
 		for (UINT32 i = 0; i < numViews; i++)
 		{
@@ -471,6 +572,8 @@ namespace bs { namespace ct
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 		auto& viewProps = view.getProperties();
 
+		view.updateRenderScale(*mCoreOptions);
+
 		SPtr<GpuParamBlockBuffer> perCameraBuffer = view.getPerViewBuffer();
 		perCameraBuffer->flushToGPU();
 
@@ -585,12 +688,17 @@ namespace bs { namespace ct
 			if(sceneInfo.reflProbeCubemapsTex != nullptr)
 				currentCubeArraySize = sceneInfo.reflProbeCubemapsTex->getProperties().getNumArraySlices();
 
+			const bool compress = mCoreOptions->compressReflectionProbes && GpuTextureCompression::isSupported(PF_BC6H);
+			const PixelFormat cubemapFormat = compress ? PF_BC6H : PF_RG11B10F;
+
 			bool forceArrayUpdate = false;
-			if(sceneInfo.reflProbeCubemapsTex == nullptr || (currentCubeArraySize < numProbes && currentCubeArraySize != MaxReflectionCubemaps))
+			if(sceneInfo.reflProbeCubemapsTex == nullptr || 
+				sceneInfo.reflProbeCubemapsTex->getProperties().getFormat() != cubemapFormat ||
+				(currentCubeArraySize < numProbes && currentCubeArraySize != MaxReflectionCubemaps))
 			{
 				TEXTURE_DESC cubeMapDesc;
 				cubeMapDesc.type = TEX_TYPE_CUBE_MAP;
-				cubeMapDesc.format = PF_RG11B10F;
+				cubeMapDesc.format = cubemapFormat;
 				cubeMapDesc.width = IBLUtility::REFLECTION_CUBEMAP_SIZE;
 				cubeMapDesc.height = IBLUtility::REFLECTION_CUBEMAP_SIZE;
 				cubeMapDesc.numMips = PixelUtil::getMaxMipmaps(cubeMapDesc.width, cubeMapDesc.height, 1, cubeMapDesc.format);
@@ -641,10 +749,18 @@ namespace bs { namespace ct
 						{
 							for(UINT32 mip = 0; mip <= srcProps.getNumMipmaps(); mip++)
 							{
+								const UINT32 dstFace = probeInfo.arrayIdx * 6 + face;
+								if(compress)
+								{
+									GpuTextureCompression::compress(texture, face, mip, sceneInfo.reflProbeCubemapsTex,
+										dstFace, mip);
+									continue;
+								}
+
 								TEXTURE_COPY_DESC copyDesc;
 								copyDesc.srcFace = face;
 								copyDesc.srcMip = mip;
-								copyDesc.dstFace = probeInfo.arrayIdx * 6 + face;
+								copyDesc.dstFace = dstFace;
 								copyDesc.dstMip = mip;
 
 								texture->copy(sceneInfo.reflProbeCubemapsTex, copyDesc);
@@ -661,8 +777,72 @@ namespace bs { namespace ct
 		bs_frame_clear();
 	}
 
+	void RenderBeast::beginReflProbeUpdateFrame()
+	{
+		std::swap(mReflProbeUpdateRequests, mPrevReflProbeUpdateRequests);
+		mReflProbeUpdateRequests.clear();
+
+		mReflProbeUpdateGranted = nullptr;
+		mReflProbeUpdateStepTaken = false;
+
+		const SceneInfo& sceneInfo = mScene->getSceneInfo();
+
+		float closestDistance = std::numeric_limits<float>::infinity();
+		for(auto& entry : mPrevReflProbeUpdateRequests)
+		{
+			float distance = sceneInfo.views.empty() ? 0.0f : std::numeric_limits<float>::infinity();
+			for(auto& view : sceneInfo.views)
+			{
+				const Vector3& viewOrigin = view->getProperties().viewOrigin;
+				distance = std::min(distance, viewOrigin.squaredDistance(entry.position));
+			}
+
+			if(distance < closestDistance || mReflProbeUpdateGranted == nullptr)
+			{
+				mReflProbeUpdateGranted = entry.probe;
+				closestDistance = distance;
+			}
+		}
+	}
+
+	bool RenderBeast::_requestReflectionProbeUpdateStep(const ReflectionProbe& probe)
+	{
+		// Probes requesting a step more than once per frame are being forced to complete (e.g. the task is waited on)
+		for(auto& entry : mReflProbeUpdateRequests)
+		{
+			if (entry.probe == &probe)
+				return true;
+		}
+
+		mReflProbeUpdateRequests.push_back({ &probe, probe.getTransform().getPosition() });
+
+		// Only a single step is taken per frame. If none of the probes were waiting since the last frame, the first
+		// one to request is allowed to proceed right away.
+		if (mReflProbeUpdateStepTaken)
+			return false;
+
+		if (mReflProbeUpdateGranted != nullptr && mReflProbeUpdateGranted != &probe)
+			return false;
+
+		mReflProbeUpdateStepTaken = true;
+		return true;
+	}
+
 	void RenderBeast::captureSceneCubeMap(const SPtr<Texture>& cubemap, const Vector3& position, 
 		const CaptureSettings& settings)
+	{
+		captureSceneCubeMapFaces(cubemap, 0, 6, position, settings);
+	}
+
+	void RenderBeast::captureSceneCubeMapFace(const SPtr<Texture>& cubemap, UINT32 face, const Vector3& position, 
+		const CaptureSettings& settings)
+	{
+		assert(face < 6);
+		captureSceneCubeMapFaces(cubemap, face, 1, position, settings);
+	}
+
+	void RenderBeast::captureSceneCubeMapFaces(const SPtr<Texture>& cubemap, UINT32 firstFace, UINT32 numFaces,
+		const Vector3& position, const CaptureSettings& settings)
 	{
 		const SceneInfo& sceneInfo = mScene->getSceneInfo();
 		auto& texProps = cubemap->getProperties();
@@ -716,13 +896,16 @@ namespace bs { namespace ct
 		// flip is required due to the fact how cubemap faces are defined. Another option would be to change the view
 		// orientation matrix, but that also requires a culling mode flip which is inconvenient to do globally.
 		RendererView views[6];
-		for(UINT32 i = 0; i < 6; i++)
+		RendererView* viewPtrs[6];
+		for(UINT32 i = 0; i < numFaces; i++)
 		{
+			const UINT32 face = firstFace + i;
+
 			// Calculate view matrix
 			Vector3 forward;
 			Vector3 up = Vector3::UNIT_Y;
 
-			switch (i)
+			switch (face)
 			{
 			case CF_PositiveX:
 				forward = -Vector3::UNIT_X;
@@ -773,7 +956,7 @@ namespace bs { namespace ct
 			// Set up face render target
 			RENDER_TEXTURE_DESC cubeFaceRTDesc;
 			cubeFaceRTDesc.colorSurfaces[0].texture = cubemap;
-			cubeFaceRTDesc.colorSurfaces[0].face = i;
+			cubeFaceRTDesc.colorSurfaces[0].face = face;
 			cubeFaceRTDesc.colorSurfaces[0].numFaces = 1;
 			
 			viewDesc.target.target = RenderTexture::create(cubeFaceRTDesc);
@@ -781,11 +964,12 @@ namespace bs { namespace ct
 			views[i].setView(viewDesc);
 			views[i].setRenderSettings(renderSettings);
 			views[i].updatePerViewBuffer();
-		}
 
-		RendererView* viewPtrs[] = { &views[0], &views[1], &views[2], &views[3], &views[4], &views[5] };
+			viewPtrs[i] = &views[i];
+		}
 
-		RendererViewGroup viewGroup(viewPtrs, 6, false, mCoreOptions->shadowMapSize);
+		RendererViewGroup viewGroup(viewPtrs, numFaces, false, mCoreOptions->shadowMapSize);
+		viewGroup.setLightGridDesc(getLightGridDesc(*mCoreOptions));
 		viewGroup.determineVisibility(sceneInfo);
 
 		FrameInfo frameInfo({ 0.0f, 1.0f / 60.0f, 0 }, PerFrameData());
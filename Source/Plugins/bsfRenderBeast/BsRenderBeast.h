@@ -69,6 +69,9 @@ namespace bs
 		/**	Returns current set of options used for controlling the rendering. */
 		SPtr<RendererOptions> getOptions() const override;
 
+		/** @copydoc Renderer::supportsGpuMorphShapes */
+		bool supportsGpuMorphShapes() const override { return mFeatureSet == RenderBeastFeatureSet::Desktop; }
+
 		/** Returns the feature set the renderer is operating on. Core thread only. */
 		RenderBeastFeatureSet getFeatureSet() const { return mFeatureSet; }
 
@@ -82,6 +85,13 @@ namespace bs
 		void captureSceneCubeMap(const SPtr<Texture>& cubemap, const Vector3& position, 
 			const CaptureSettings& settings) override;
 
+		/** @copydoc Renderer::captureSceneCubeMapFace */
+		void captureSceneCubeMapFace(const SPtr<Texture>& cubemap, UINT32 face, const Vector3& position, 
+			const CaptureSettings& settings) override;
+
+		/** @copydoc Renderer::_requestReflectionProbeUpdateStep */
+		bool _requestReflectionProbeUpdateStep(const ReflectionProbe& probe) override;
+
 		/** @copydoc Renderer::getShaderExtensionPointInfo */
 		ShaderExtensionPointInfo getShaderExtensionPointInfo(const String& name) override;
 
@@ -205,6 +215,23 @@ namespace bs
 		/** Updates the global reflection probe cubemap array with changed probe textures. */
 		void updateReflProbeArray();
 
+		/** 
+		 * Picks the reflection probe allowed to perform an update step during the current frame. Out of the probes that
+		 * requested a step during the previous frame, the one closest to any of the views is picked.
+		 */
+		void beginReflProbeUpdateFrame();
+
+		/** Renders the specified range of cubemap faces. See captureSceneCubeMap(). */
+		void captureSceneCubeMapFaces(const SPtr<Texture>& cubemap, UINT32 firstFace, UINT32 numFaces, 
+			const Vector3& position, const CaptureSettings& settings);
+
+		/** Reflection probe that requested an update step, and the position it requested it at. */
+		struct ReflProbeUpdateRequest
+		{
+			const ReflectionProbe* probe;
+			Vector3 position;
+		};
+
 		// Core thread only fields
 		RenderBeastFeatureSet mFeatureSet = RenderBeastFeatureSet::Desktop;
 
@@ -216,6 +243,12 @@ namespace bs
 		// Helpers to avoid memory allocations
 		RendererViewGroup* mMainViewGroup = nullptr;
 
+		// Reflection probe update scheduling
+		Vector<ReflProbeUpdateRequest> mReflProbeUpdateRequests;
+		Vector<ReflProbeUpdateRequest> mPrevReflProbeUpdateRequests;
+		const ReflectionProbe* mReflProbeUpdateGranted = nullptr;
+		bool mReflProbeUpdateStepTaken = false;
+
 		// Sim thread only fields
 		SPtr<RenderBeastOptions> mOptions;
 		bool mOptionsDirty = true;
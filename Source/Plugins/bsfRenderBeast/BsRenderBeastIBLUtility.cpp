@@ -87,6 +87,124 @@ namespace bs { namespace ct
 		gRendererUtility().drawScreenQuad();
 	}
 
+	const UINT32 ReflectionCubeImportanceSampleComputeMat::NUM_SAMPLES = 256;
+	const UINT32 ReflectionCubeImportanceSampleComputeMat::TILE_SIZE = 8;
+	ReflectionCubeImportanceSampleComputeParamDef gReflectionCubeImportanceSampleComputeParamDef;
+
+	ReflectionCubeImportanceSampleComputeMat::ReflectionCubeImportanceSampleComputeMat()
+	{
+		mParamBuffer = gReflectionCubeImportanceSampleComputeParamDef.createBuffer();
+
+		mParams->setParamBlockBuffer("Input", mParamBuffer);
+		mParams->getTextureParam(GPT_COMPUTE_PROGRAM, "gInputTex", mInputTexture);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gSamples", mSamplesParam);
+		mParams->getLoadStoreTextureParam(GPT_COMPUTE_PROGRAM, "gOutput", mOutputTexture);
+	}
+
+	void ReflectionCubeImportanceSampleComputeMat::_initDefines(ShaderDefines& defines)
+	{
+		defines.set("TILE_SIZE", TILE_SIZE);
+	}
+
+	void ReflectionCubeImportanceSampleComputeMat::execute(const SPtr<Texture>& source, UINT32 mip, 
+		const SPtr<Texture>& output)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		auto& props = source->getProperties();
+		updateSampleTable(props.getWidth(), props.getNumMipmaps() + 1);
+
+		const UINT32 faceSize = std::max(1U, props.getWidth() >> mip);
+		gReflectionCubeImportanceSampleComputeParamDef.gFaceSize.set(mParamBuffer, faceSize);
+		gReflectionCubeImportanceSampleComputeParamDef.gSampleOffset.set(mParamBuffer, mSampleRanges[mip].first);
+		gReflectionCubeImportanceSampleComputeParamDef.gNumSamples.set(mParamBuffer, mSampleRanges[mip].second);
+
+		mInputTexture.set(source);
+		mSamplesParam.set(mSampleTable);
+		mOutputTexture.set(output, TextureSurface(mip, 1, 0, 6));
+
+		bind();
+
+		const UINT32 numGroups = Math::divideAndRoundUp(faceSize, TILE_SIZE);
+		RenderAPI::instance().dispatchCompute(numGroups, numGroups, 6);
+	}
+
+	void ReflectionCubeImportanceSampleComputeMat::updateSampleTable(UINT32 faceSize, UINT32 numMips)
+	{
+		if (mSampleTable != nullptr && mSampleTableFaceSize == faceSize && (UINT32)mSampleRanges.size() == numMips)
+			return;
+
+		// Generates the same GGX samples as ReflectionCubeImportanceSampleMat does per-pixel. Since the view direction
+		// is assumed to be equal to the normal, the weights and mip levels only depend on the sample, not the pixel.
+		// First part of the equation for determining mip level to sample from.
+		// See http://http.developer.nvidia.com/GPUGems3/gpugems3_ch20.html
+		const float mipFactor = 0.5f * std::log2(faceSize * faceSize / (float)NUM_SAMPLES);
+
+		Vector<Vector4> samples;
+		mSampleRanges.assign(numMips, std::make_pair(0U, 0U));
+		for (UINT32 mip = 1; mip < numMips; mip++)
+		{
+			// Matches mapMipLevelToRoughness() in ReflectionCubemapCommon.bslinc
+			const float roughness = 1.0f - std::exp2(mip / -2.8f);
+			const float roughness2 = roughness * roughness;
+			const float roughness4 = roughness2 * roughness2;
+
+			mSampleRanges[mip].first = (UINT32)samples.size();
+			for (UINT32 i = 0; i < NUM_SAMPLES; i++)
+			{
+				// Hammersley sequence
+				UINT32 bits = i;
+				bits = (bits << 16u) | (bits >> 16u);
+				bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+				bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+				bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+				bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+
+				const float e0 = i / (float)NUM_SAMPLES;
+				const float e1 = bits * 2.3283064365386963e-10f;
+
+				// Importance sample GGX
+				const float cosTheta = std::sqrt((1.0f - e0) / (1.0f + (roughness4 - 1.0f) * e0));
+				const float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+				const float phi = Math::TWO_PI * e1;
+
+				// Light direction is reflected around the half-vector, assuming the view direction equals the normal
+				const float NoL = 2.0f * cosTheta * cosTheta - 1.0f;
+				if (NoL <= 0.0f)
+					continue;
+
+				const float d = (cosTheta * roughness4 - cosTheta) * cosTheta + 1.0f;
+				const float pdf = roughness4 * cosTheta * sinTheta / (d * d * Math::PI);
+
+				// Note: Adding +1 bias as it looks better
+				float mipLevel = std::max(mipFactor - 0.5f * std::log2(pdf), 0.0f);
+				mipLevel = std::min(std::floor(mipLevel) + 1.0f, (float)(numMips - 1));
+
+				// radiance * GGX(h, roughness) * NoL / PDF, where most of the factors cancel out
+				const float weight = NoL / cosTheta / NUM_SAMPLES;
+
+				Vector3 H(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+				samples.push_back(Vector4(H * weight, mipLevel));
+			}
+
+			mSampleRanges[mip].second = (UINT32)samples.size() - mSampleRanges[mip].first;
+		}
+
+		if (samples.empty())
+			samples.push_back(Vector4::ZERO);
+
+		GPU_BUFFER_DESC desc;
+		desc.type = GBT_STANDARD;
+		desc.elementSize = 0;
+		desc.elementCount = (UINT32)samples.size();
+		desc.usage = GBU_STATIC;
+		desc.format = BF_32X4F;
+
+		mSampleTable = GpuBuffer::create(desc);
+		mSampleTable->writeData(0, (UINT32)(samples.size() * sizeof(Vector4)), samples.data(), BWT_DISCARD);
+		mSampleTableFaceSize = faceSize;
+	}
+
 	IrradianceComputeSHParamDef gIrradianceComputeSHParamDef;
 
 	// TILE_WIDTH * TILE_HEIGHT must be pow2 because of parallel reduction algorithm
@@ -401,6 +519,25 @@ namespace bs { namespace ct
 			scratchCubemap = Texture::create(cubemapDesc);
 		}
 
+		UINT32 step = 0;
+		while (!filterCubemapForSpecular(cubemap, scratchCubemap, step))
+			step++;
+	}
+
+	/** Checks can the compute shader be used for filtering a cubemap with the provided properties. */
+	static bool supportsComputeSpecularFilter(const TextureProperties& props)
+	{
+		if (gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::Desktop)
+			return false;
+
+		return (props.getUsage() & TU_LOADSTORE) != 0;
+	}
+
+	bool RenderBeastIBLUtility::filterCubemapForSpecular(const SPtr<Texture>& cubemap, const SPtr<Texture>& scratch,
+		UINT32 step) const
+	{
+		auto& props = cubemap->getProperties();
+
 		// We sample the cubemaps using importance sampling to generate roughness
 		UINT32 numMips = props.getNumMipmaps() + 1;
 
@@ -412,26 +549,37 @@ namespace bs { namespace ct
 		//  2. Even if we were to use fully random samples we would need a lot to avoid noticeable noise, which isn't
 		//     practical
 
-		// Copy base mip level to scratch cubemap
-		for (UINT32 face = 0; face < 6; face++)
+		if (step == 0)
 		{
-			TEXTURE_COPY_DESC copyDesc;
-			copyDesc.srcFace = face;
-			copyDesc.dstFace = face;
+			// Copy base mip level to scratch cubemap
+			for (UINT32 face = 0; face < 6; face++)
+			{
+				TEXTURE_COPY_DESC copyDesc;
+				copyDesc.srcFace = face;
+				copyDesc.dstFace = face;
 
-			cubemap->copy(scratchCubemap, copyDesc);
-		}
+				cubemap->copy(scratch, copyDesc);
+			}
 
-		// Fill out remaining scratch mip levels by downsampling
-		for (UINT32 mip = 1; mip < numMips; mip++)
-		{
-			UINT32 sourceMip = mip - 1;
-			downsampleCubemap(scratchCubemap, sourceMip, scratchCubemap, mip);
+			// Fill out remaining scratch mip levels by downsampling
+			for (UINT32 mip = 1; mip < numMips; mip++)
+			{
+				UINT32 sourceMip = mip - 1;
+				downsampleCubemap(scratch, sourceMip, scratch, mip);
+			}
 		}
-
-		// Importance sample
-		for (UINT32 mip = 1; mip < numMips; mip++)
+		else if (step < numMips)
 		{
+			// Importance sample a single mip level
+			const UINT32 mip = step;
+			if (supportsComputeSpecularFilter(props))
+			{
+				ReflectionCubeImportanceSampleComputeMat* material = ReflectionCubeImportanceSampleComputeMat::get();
+				material->execute(scratch, mip, cubemap);
+
+				return (step + 1) >= numMips;
+			}
+
 			for (UINT32 face = 0; face < 6; face++)
 			{
 				RENDER_TEXTURE_DESC cubeFaceRTDesc;
@@ -443,12 +591,14 @@ namespace bs { namespace ct
 				SPtr<RenderTarget> target = RenderTexture::create(cubeFaceRTDesc);
 
 				ReflectionCubeImportanceSampleMat* material = ReflectionCubeImportanceSampleMat::get();
-				material->execute(scratchCubemap, face, mip, target);
+				material->execute(scratch, face, mip, target);
 			}
+
+			RenderAPI& rapi = RenderAPI::instance();
+			rapi.setRenderTarget(nullptr);
 		}
 
-		RenderAPI& rapi = RenderAPI::instance();
-		rapi.setRenderTarget(nullptr);
+		return (step + 1) >= numMips;
 	}
 
 	bool supportsComputeSH()
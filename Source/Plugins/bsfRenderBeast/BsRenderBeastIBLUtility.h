@@ -64,6 +64,53 @@ namespace bs { namespace ct
 		GpuParamTexture mInputTexture;
 	};
 
+	BS_PARAM_BLOCK_BEGIN(ReflectionCubeImportanceSampleComputeParamDef)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gFaceSize)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gSampleOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gNumSamples)
+	BS_PARAM_BLOCK_END
+
+	extern ReflectionCubeImportanceSampleComputeParamDef gReflectionCubeImportanceSampleComputeParamDef;
+
+	/** 
+	 * Compute shader version of ReflectionCubeImportanceSampleMat. Filters all the faces of a mip level in a single
+	 * dispatch, using a table of samples precomputed on the CPU, with samples that don't contribute to the result
+	 * already removed.
+	 */
+	class ReflectionCubeImportanceSampleComputeMat : public RendererMaterial<ReflectionCubeImportanceSampleComputeMat>
+	{
+		RMAT_DEF_CUSTOMIZED("ReflectionCubeImportanceSampleCompute.bsl")
+
+	public:
+		ReflectionCubeImportanceSampleComputeMat();
+
+		/** 
+		 * Importance samples all faces of a single mip level of the source texture.
+		 *
+		 * @param[in]	source		Cubemap to sample, with box filtered mip levels.
+		 * @param[in]	mip			Mip level to filter. Must be larger than zero.
+		 * @param[in]	output		Cubemap to write the filtered mip level to. Must have the same size as @p source,
+		 *							and be created with TU_LOADSTORE usage.
+		 */
+		void execute(const SPtr<Texture>& source, UINT32 mip, const SPtr<Texture>& output);
+
+	private:
+		/** Regenerates the sample table, unless it already matches a cubemap of the provided size. */
+		void updateSampleTable(UINT32 faceSize, UINT32 numMips);
+
+		static const UINT32 NUM_SAMPLES;
+		static const UINT32 TILE_SIZE;
+
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+		GpuParamTexture mInputTexture;
+		GpuParamBuffer mSamplesParam;
+		GpuParamLoadStoreTexture mOutputTexture;
+
+		SPtr<GpuBuffer> mSampleTable;
+		Vector<std::pair<UINT32, UINT32>> mSampleRanges;
+		UINT32 mSampleTableFaceSize = 0;
+	};
+
 	/** Vector representing spherical harmonic coefficients for 5 bands. */
 	struct SHVector5
 	{
@@ -349,9 +396,13 @@ namespace bs { namespace ct
 	class RenderBeastIBLUtility : public IBLUtility
 	{
 	public:
-		/** @copydoc IBLUtility::filterCubemapForSpecular */
+		/** @copydoc IBLUtility::filterCubemapForSpecular(const SPtr<Texture>&, const SPtr<Texture>&) const */
 		void filterCubemapForSpecular(const SPtr<Texture>& cubemap, const SPtr<Texture>& scratch) const override;
 
+		/** @copydoc IBLUtility::filterCubemapForSpecular(const SPtr<Texture>&, const SPtr<Texture>&, UINT32) const */
+		bool filterCubemapForSpecular(const SPtr<Texture>& cubemap, const SPtr<Texture>& scratch, 
+			UINT32 step) const override;
+
 		/** @copydoc IBLUtility::filterCubemapForIrradiance(const SPtr<Texture>&, const SPtr<Texture>&) const */
 		void filterCubemapForIrradiance(const SPtr<Texture>& cubemap, const SPtr<Texture>& output) const override;
 
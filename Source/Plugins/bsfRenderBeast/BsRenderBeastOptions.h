@@ -20,6 +20,16 @@ namespace bs { namespace ct
 		Anisotropic /**< High quality dynamic filtering that improves quality of angled surfaces */
 	};
 
+	/** Determines how is rendering distributed between multiple GPUs, when the render API exposes more than one. */
+	enum class RenderBeastMultiGpu
+	{
+		Disabled, /**< All rendering happens on the GPU presenting to the render windows. */
+		/** Each frame the offscreen render targets are all rendered on the next GPU in turn. */
+		AlternateFrame,
+		/** Offscreen render targets are distributed over the GPUs, each one always rendering on the same GPU. */
+		SplitView
+	};
+
 	/** A set of options used for controlling the rendering of the RenderBeast renderer. */
 	struct RenderBeastOptions : public RendererOptions
 	{
@@ -43,6 +53,134 @@ namespace bs { namespace ct
 		 * shadows far away, but will never increase the resolution past the provided value.
 		 */
 		UINT32 shadowMapSize = 2048;
+
+		/**
+		 * Determines should renderables and lights hidden behind other geometry be culled. Shadows of culled lights are not
+		 * rendered. Occlusion is determined on the GPU against the depth buffer of an earlier frame, meaning objects that
+		 * become visible can appear with a delay of a few frames.
+		 */
+		bool occlusionCulling = false;
+
+		/**
+		 * Determines should non-movable spot and radial lights cache shadows cast by static geometry, so only movable or
+		 * animated geometry needs to be rendered into their shadow maps every frame. Costs an extra shadow map worth of
+		 * memory per cached light.
+		 */
+		bool staticShadowCaching = true;
+
+		/**
+		 * Maximum number of spot and radial light shadow map texels to render per frame, with each cubemap face counted
+		 * separately. Shadow maps that don't fit in the budget are reused from the previous frame, prioritizing large
+		 * shadow maps that weren't updated for a while. Keeps frame times predictable when many shadow casting lights
+		 * are in view, at the cost of shadows lagging behind moving objects. Zero means no limit.
+		 */
+		UINT32 shadowUpdateBudget = 0;
+
+		/**
+		 * Determines should the resolution the scene is rendered at be adjusted dynamically, so the GPU time of each view
+		 * stays at #dynamicResolutionTargetTime. The scene is rendered at the reduced resolution, and upscaled to the
+		 * output resolution during tonemapping. Only applies to camera views with post-processing enabled.
+		 */
+		bool dynamicResolution = false;
+
+		/** GPU time to aim for when rendering a single view, in milliseconds. Only relevant if #dynamicResolution is on. */
+		float dynamicResolutionTargetTime = 14.0f;
+
+		/** 
+		 * Minimum scale to apply to the width and height of a view's resolution, in range (0, 1]. Only relevant if
+		 * #dynamicResolution is enabled.
+		 */
+		float dynamicResolutionMinScale = 0.5f;
+
+		/**
+		 * Determines should static renderables sharing the same mesh and material be grouped and drawn using a single
+		 * instanced draw call. Only applies to opaque renderables using the deferred rendering path.
+		 */
+		bool instancing = true;
+
+		/**
+		 * Determines should decals sharing the same material be applied together in a single full screen pass, finding
+		 * the decals affecting each pixel through the light grid, instead of rendering a volume per decal. Only applies
+		 * to materials whose shader provides the clustered decal variation, and to the Desktop feature set.
+		 */
+		bool clusteredDecals = true;
+
+		/**
+		 * Determines should meshlets of static renderables be culled against the view frustum and by facing on the
+		 * GPU, drawing only the meshlets that are visible. Only applies to opaque renderables using the deferred
+		 * rendering path, whose meshes were imported with meshlets, and to the Desktop feature set. Renderables whose
+		 * meshlets are culled are not grouped using #instancing.
+		 */
+		bool clusterCulling = true;
+
+		/**
+		 * Determines should static renderables using the same material but different textures be grouped by
+		 * #instancing, reading the textures through a global texture table instead of binding them individually (see
+		 * Renderable::setTextureOverride()). The table is descriptor-indexed if the render API supports
+		 * RSC_TEXTURE_DESCRIPTOR_INDEXING. Otherwise textures are copied into texture array pages, and only renderables
+		 * whose textures share the same pages are grouped. Only applies to materials whose shader provides the texture
+		 * table variation, such as the standard surface shader.
+		 */
+		bool textureTable = true;
+
+		/**
+		 * Determines should draw calls of the base and decal passes be recorded in parallel on worker threads, each
+		 * recording a portion of the render queue into its own secondary command buffer. Only has an effect if the
+		 * active render API supports parallel recording of secondary command buffers.
+		 */
+		bool parallelRecording = false;
+
+		/**
+		 * Size of a single cell of the light grid used for clustered forward rendering, in pixels. Rounded up to a power
+		 * of two. Smaller cells cull lights more precisely at the cost of more time spent building the grid.
+		 */
+		UINT32 lightGridCellSize = 64;
+
+		/** Number of depth slices of the light grid used for clustered forward rendering. */
+		UINT32 lightGridNumSlices = 32;
+
+		/**
+		 * Maximum number of lights (and separately, reflection probes) referenced by a single light grid cell, on 
+		 * average. Lights that don't fit are dropped. Increase when rendering scenes with many overlapping lights.
+		 */
+		UINT32 lightGridMaxLightsPerCell = 32;
+
+		/**
+		 * Determines should compute work that doesn't depend on the current frame's rendering, such as building of the
+		 * light grid, be submitted on the compute queue so it can execute in parallel with shadow map rendering. Only 
+		 * has an effect if the active render API exposes a separate compute queue.
+		 */
+		bool asyncCompute = false;
+
+		/**
+		 * Determines should filtered reflection probe cubemaps be compressed into the BC6H format on the GPU, when stored
+		 * for use by the renderer. Reduces the memory used by reflection probes at a small cost in quality. Only has an
+		 * effect if the active render API supports compute shaders.
+		 */
+		bool compressReflectionProbes = true;
+
+		/**
+		 * Determines should skinned renderables be skinned once per frame in a compute shader, instead of in the vertex
+		 * shader of every pass drawing them (depth, base pass and each shadow map). Mostly benefits characters casting
+		 * shadows into multiple cascades. Only affects renderables added after the option is changed, and only has an
+		 * effect if the active render API supports compute shaders.
+		 */
+		bool computeSkinning = true;
+
+		/**
+		 * Determines should objects be culled once for both eyes of a stereo camera setup (two cameras rendering the
+		 * same target with the same orientation, from nearby origins), rather than once per eye. See
+		 * RendererViewGroup::setStereoCulling().
+		 */
+		bool stereoCulling = true;
+
+		/**
+		 * Determines should rendering of offscreen render targets be distributed over multiple GPUs, if the active
+		 * render API supports explicit multi-GPU rendering and the system has multiple similar GPUs. Render windows are
+		 * always rendered on the GPU that presents them. Rendered textures remain on the GPU they were rendered on, so
+		 * they are only useful if read back, or if they are only used by views rendering on the same GPU.
+		 */
+		RenderBeastMultiGpu multiGpu = RenderBeastMultiGpu::Disabled;
 	};
 
 	/** @} */
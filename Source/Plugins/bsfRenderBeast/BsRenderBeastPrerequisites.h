@@ -37,7 +37,11 @@ namespace bs { namespace ct
 		/** See ParticlesRenderElement. */
 		Particle,
 		/** See DecalRenderElement. */
-		Decal
+		Decal,
+		/** See InstancedRenderableElement. */
+		InstancedRenderable,
+		/** See ClusteredDecalElement. */
+		ClusteredDecals
 	};
 
 	/** Types of ways for shaders to handle MSAA. */
@@ -6,6 +6,7 @@
 #include "Renderer/BsCamera.h"
 #include "Renderer/BsRendererUtility.h"
 #include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsCommandBuffer.h"
 #include "Utility/BsBitwise.h"
 #include "Mesh/BsMesh.h"
 #include "Material/BsGpuParamsSet.h"
@@ -17,6 +18,7 @@
 #include "Shading/BsPostProcessing.h"
 #include "Shading/BsShadowRendering.h"
 #include "Shading/BsLightGrid.h"
+#include "Shading/BsClusterCulling.h"
 #include "BsRendererView.h"
 #include "BsRenderBeastOptions.h"
 #include "BsRendererScene.h"
@@ -32,18 +34,144 @@ namespace bs { namespace ct
 {
 	UnorderedMap<StringID, RenderCompositor::NodeType*> RenderCompositor::mNodeTypes;
 
+	/** Minimum number of render queue elements recorded by a single worker, when recording in parallel. */
+	static constexpr UINT32 MIN_ELEMENTS_PER_RECORD_TASK = 128;
+
+	/** 
+	 * Renders a range of render queue elements. If a command buffer is provided the draw calls are queued on it, instead
+	 * of being executed immediately.
+	 */
+	void renderQueueElements(const RenderQueueElement* elements, UINT32 numElements,
+		const SPtr<CommandBuffer>& commandBuffer = nullptr)
+	{
+		for(UINT32 i = 0; i < numElements; i++)
+		{
+			const RenderQueueElement& entry = elements[i];
+			if (entry.applyPass)
+				gRendererUtility().setPass(entry.renderElem->material, entry.passIdx, entry.techniqueIdx, commandBuffer);
+
+			// Instanced elements share material parameters, so their buffers need to be assigned before every draw
+			if (entry.renderElem->type == (UINT32)RenderElementType::InstancedRenderable)
+				static_cast<const InstancedRenderableElement*>(entry.renderElem)->bindInstanceData();
+			else if (entry.renderElem->type == (UINT32)RenderElementType::ClusteredDecals)
+				static_cast<const ClusteredDecalElement*>(entry.renderElem)->bindClusterData();
+
+			gRendererUtility().setPassParams(entry.renderElem->params, entry.passIdx, commandBuffer);
+
+			entry.renderElem->draw(commandBuffer);
+		}
+	}
+
 	/** Renders all elements in a render queue. */
 	void renderQueueElements(const Vector<RenderQueueElement>& elements)
 	{
-		for(auto& entry : elements)
+		renderQueueElements(elements.data(), (UINT32)elements.size());
+	}
+
+	/** 
+	 * Renders all elements in a render queue. If enabled in @p options the elements are split into chunks, each recorded
+	 * on a worker thread into its own secondary command buffer. Secondary command buffers are then executed in order.
+	 * 
+	 * @param[in]	elements		Elements to render.
+	 * @param[in]	target			Render target the elements are rendered to. Must already be bound, with a full
+	 *								viewport.
+	 * @param[in]	readOnlyFlags	Read-only flags the render target was bound with.
+	 * @param[in]	options			Options determining whether parallel recording is enabled.
+	 */
+	void renderQueueElements(const Vector<RenderQueueElement>& elements, const SPtr<RenderTarget>& target,
+		UINT32 readOnlyFlags, const RenderBeastOptions& options)
+	{
+		const auto numElements = (UINT32)elements.size();
+		const bool canRecordInParallel = options.parallelRecording &&
+			RenderAPI::instance().getAPIInfo().isFlagSet(RenderAPIFeatureFlag::ParallelSecondaryCB);
+
+		if (!canRecordInParallel || numElements < MIN_ELEMENTS_PER_RECORD_TASK * 2)
 		{
-			if (entry.applyPass)
-				gRendererUtility().setPass(entry.renderElem->material, entry.passIdx, entry.techniqueIdx);
+			renderQueueElements(elements);
+			return;
+		}
+
+		bs_frame_mark();
+		{
+			// Only renderables and decals are recorded in parallel, other elements are rendered on this thread once
+			// recorded commands execute. Instanced and clustered decal elements in particular share material parameters
+			// that are modified right before each draw, which only works if the draw is executed immediately.
+			FrameVector<RenderQueueElement> recorded;
+			FrameVector<RenderQueueElement> immediate;
+			recorded.reserve(numElements);
+
+			INT32 lastRecordedIdx = -1;
+			INT32 lastImmediateIdx = -1;
+			for(UINT32 i = 0; i < numElements; i++)
+			{
+				const RenderQueueElement& entry = elements[i];
 
-			gRendererUtility().setPassParams(entry.renderElem->params, entry.passIdx);
+				const UINT32 type = entry.renderElem->type;
+				const bool canRecord = type == (UINT32)RenderElementType::Renderable ||
+					type == (UINT32)RenderElementType::Decal;
 
-			entry.renderElem->draw();
+				// Elements that don't apply a pass rely on state set by the element that precedes them, so the pass needs
+				// to be re-applied if that element ends up in the other list
+				INT32& lastIdx = canRecord ? lastRecordedIdx : lastImmediateIdx;
+				FrameVector<RenderQueueElement>& output = canRecord ? recorded : immediate;
+
+				output.push_back(entry);
+				if (lastIdx != (INT32)i - 1)
+					output.back().applyPass = true;
+
+				lastIdx = (INT32)i;
+			}
+
+			const auto numRecorded = (UINT32)recorded.size();
+			if (numRecorded < MIN_ELEMENTS_PER_RECORD_TASK * 2)
+				renderQueueElements(elements);
+			else
+			{
+				const UINT32 maxTasks = std::max(1U, TaskScheduler::instance().getNumWorkers());
+				const UINT32 elementsPerTask = Math::divideAndRoundUp(numRecorded,
+					std::min(numRecorded / MIN_ELEMENTS_PER_RECORD_TASK, maxTasks));
+				const UINT32 numTasks = Math::divideAndRoundUp(numRecorded, elementsPerTask);
+
+				// Command buffers need to execute on the device the view is being rendered on
+				const UINT32 deviceIdx = RenderAPI::instance().getActiveDevice();
+
+				FrameVector<SPtr<CommandBuffer>> commandBuffers(numTasks);
+				for(UINT32 i = 0; i < numTasks; i++)
+				{
+					commandBuffers[i] = CommandBuffer::create(GQT_GRAPHICS, deviceIdx, 0, true);
+
+					// Each chunk must start by applying its pass, as state isn't shared between command buffers
+					recorded[i * elementsPerTask].applyPass = true;
+				}
+
+				const auto recordElements = [&](UINT32 start, UINT32 end)
+				{
+					RenderAPI& rapi = RenderAPI::instance();
+					for(UINT32 i = start; i < end; i++)
+					{
+						const UINT32 first = i * elementsPerTask;
+						const UINT32 count = std::min(elementsPerTask, numRecorded - first);
+						const SPtr<CommandBuffer>& commandBuffer = commandBuffers[i];
+
+						rapi.setRenderTarget(target, readOnlyFlags, RT_ALL, commandBuffer);
+						rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f), commandBuffer);
+						renderQueueElements(&recorded[first], count, commandBuffer);
+					}
+				};
+
+				PROFILE_CALL(TaskScheduler::instance().parallelFor(numTasks, 1, recordElements), "Record draw calls")
+
+				RenderAPI& rapi = RenderAPI::instance();
+				SPtr<CommandBuffer> primary = CommandBuffer::create(GQT_GRAPHICS, deviceIdx);
+				for(auto& entry : commandBuffers)
+					rapi.addCommands(primary, entry);
+
+				rapi.submitCommandBuffer(primary);
+
+				renderQueueElements(immediate.data(), (UINT32)immediate.size());
+			}
 		}
+		bs_frame_clear();
 	}
 
 	RenderCompositor::~RenderCompositor()
@@ -228,6 +356,9 @@ namespace bs { namespace ct
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
 		resPool.release(depthTex);
+
+		// Let the pool own the released resources, so it can reuse or free them
+		depthTex = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeSceneDepth::getDependencies(const RendererView& view)
@@ -341,30 +472,52 @@ namespace bs { namespace ct
 			const auto numParticleSystems = (UINT32)inputs.scene.particleSystems.size();
 
 			const GpuParticleResources& gpuSimResources = GpuParticleSimulation::instance().getResources();
-			for (UINT32 i = 0; i < numParticleSystems; i++)
+
+			bs_frame_mark();
 			{
-				if (!visibility.particleSystems[i])
-					continue;
+				FrameVector<const RendererParticles*> meshSystems;
+				FrameVector<const ParticleMeshRenderData*> meshRenderData;
 
-				const RendererParticles& rendererParticles = inputs.scene.particleSystems[i];
-				ParticlesRenderElement& renderElement = rendererParticles.renderElement;
+				for (UINT32 i = 0; i < numParticleSystems; i++)
+				{
+					if (!visibility.particleSystems[i])
+						continue;
 
-				if(!renderElement.isValid())
-					continue;
+					const RendererParticles& rendererParticles = inputs.scene.particleSystems[i];
+					ParticlesRenderElement& renderElement = rendererParticles.renderElement;
 
-				ParticleSystem* particleSystem = rendererParticles.particleSystem;
+					if(!renderElement.isValid())
+						continue;
 
-				// Bind textures/buffers from CPU simulation
-				const auto iterFind = particleData->cpuData.find(particleSystem->getId());
-				if (iterFind != particleData->cpuData.end())
-				{
-					ParticleRenderData* renderData = iterFind->second;
-					rendererParticles.bindCPUSimulatedInputs(renderData, inputs.view);
+					ParticleSystem* particleSystem = rendererParticles.particleSystem;
+
+					// Bind textures/buffers from CPU simulation
+					const auto iterFind = particleData->cpuData.find(particleSystem->getId());
+					if (iterFind != particleData->cpuData.end())
+					{
+						ParticleRenderData* renderData = iterFind->second;
+
+						// Mesh particles from all systems are uploaded together, once all of them are known
+						if (renderElement.is3D)
+						{
+							meshSystems.push_back(&rendererParticles);
+							meshRenderData.push_back(static_cast<const ParticleMeshRenderData*>(renderData));
+						}
+						else
+						{
+							rendererParticles.bindCPUSimulatedInputs(
+								static_cast<const ParticleBillboardRenderData*>(renderData), inputs.view);
+						}
+					}
+					// Bind textures/buffers from GPU simulation
+					else if(rendererParticles.gpuParticleSystem)
+						rendererParticles.bindGPUSimulatedInputs(gpuSimResources, inputs.view);
 				}
-				// Bind textures/buffers from GPU simulation
-				else if(rendererParticles.gpuParticleSystem)
-					rendererParticles.bindGPUSimulatedInputs(gpuSimResources, inputs.view);
+
+				ParticleRenderer::instance().bindMeshInstances(meshSystems.data(), meshRenderData.data(), 
+					(UINT32)meshSystems.size(), inputs.view);
 			}
+			bs_frame_clear();
 		}
 
 		//// Prepare decals
@@ -391,6 +544,19 @@ namespace bs { namespace ct
 			renderElement.maskInputTexture.set(idTex->texture);
 		}
 
+		// Decals applied in clustered passes share parameters between all decals using the same material
+		for (auto& entry : inputs.view.getDecalQueue()->getSortedElements())
+		{
+			if (entry.renderElem->type != (UINT32)RenderElementType::ClusteredDecals)
+				continue;
+
+			ClusteredDecalMaterialParams* clustered =
+				static_cast<const ClusteredDecalElement*>(entry.renderElem)->clustered;
+
+			clustered->depthInputTexture.set(sceneDepthTex->texture);
+			clustered->maskInputTexture.set(idTex->texture);
+		}
+
 		Camera* sceneCamera = inputs.view.getSceneCamera();
 
 		// Trigger prepare callbacks
@@ -403,6 +569,30 @@ namespace bs { namespace ct
 			}
 		}
 
+		//// Cull meshlets of visible renderables against the view. Meshlets only cover the highest level of detail.
+		if (viewProps.clusterCulling)
+		{
+			for (UINT32 i = 0; i < numRenderables; i++)
+			{
+				if (!visibility.renderables[i])
+					continue;
+
+				RendererRenderable* rendererRenderable = inputs.scene.renderables[i];
+				if (rendererRenderable->lod != 0)
+					continue;
+
+				const Matrix4 worldTfrm = rendererRenderable->renderable->getMatrix();
+				for (auto& element : rendererRenderable->elements)
+				{
+					if (element.clusters == nullptr)
+						continue;
+
+					ClusterCullingMat::get()->execute(*element.clusters, element.mesh, worldTfrm, viewProps);
+					element.clustersCulled = true;
+				}
+			}
+		}
+
 		// Render base pass
 		RenderAPI& rapi = RenderAPI::instance();
 		rapi.setRenderTarget(renderTarget);
@@ -425,7 +615,17 @@ namespace bs { namespace ct
 
 		// Render all visible opaque elements that use the deferred pipeline
 		const Vector<RenderQueueElement>& opaqueElements = inputs.view.getOpaqueQueue(false)->getSortedElements();
-		renderQueueElements(opaqueElements);
+		renderQueueElements(opaqueElements, renderTarget, 0, inputs.options);
+
+		// Other passes draw the full sub-meshes, as they render from a different view or need all the triangles
+		if (viewProps.clusterCulling)
+		{
+			for (UINT32 i = 0; i < numRenderables; i++)
+			{
+				for (auto& element : inputs.scene.renderables[i]->elements)
+					element.clustersCulled = false;
+			}
+		}
 
 		// Determine MSAA coverage if required
 		if (viewProps.target.numSamples > 1)
@@ -451,7 +651,7 @@ namespace bs { namespace ct
 		rapi.setRenderTarget(renderTargetNoMask, FBT_DEPTH, RT_ALL);
 
 		const Vector<RenderQueueElement>& decalElements = inputs.view.getDecalQueue()->getSortedElements();
-		renderQueueElements(decalElements);
+		renderQueueElements(decalElements, renderTargetNoMask, FBT_DEPTH, inputs.options);
 
 		// Make sure that any compute shaders are able to read g-buffer by unbinding it
 		rapi.setRenderTarget(nullptr);
@@ -475,6 +675,11 @@ namespace bs { namespace ct
 		resPool.release(normalTex);
 		resPool.release(roughMetalTex);
 		resPool.release(idTex);
+
+		albedoTex = nullptr;
+		normalTex = nullptr;
+		roughMetalTex = nullptr;
+		idTex = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeBasePass::getDependencies(const RendererView& view)
@@ -547,6 +752,9 @@ namespace bs { namespace ct
 
 		if (sceneColorTexArray != nullptr)
 			resPool.release(sceneColorTexArray);
+
+		sceneColorTex = nullptr;
+		sceneColorTexArray = nullptr;
 	}
 
 	void RCNodeSceneColor::resolveMSAA()
@@ -591,6 +799,7 @@ namespace bs { namespace ct
 		{
 			GpuResourcePool& resPool = GpuResourcePool::instance();
 			resPool.release(output);
+			output = nullptr;
 		}
 	}
 
@@ -671,24 +880,24 @@ namespace bs { namespace ct
 			{
 				const SortData& data = systemsToSort[idx];
 
-				Vector3 refPoint = viewOrigin;
-
-				// Transform the view point into particle system's local space
 				const ParticleSystemSettings& settings = data.system->getSettings();
-				if (settings.simulationSpace == ParticleSimulationSpace::Local)
-					refPoint = data.system->getTransform().getInvMatrix().multiplyAffine(refPoint);
-
 				if (settings.renderMode == ParticleRenderMode::Billboard)
 				{
+					Vector3 refPoint = viewOrigin;
+
+					// Transform the view point into particle system's local space
+					if (settings.simulationSpace == ParticleSimulationSpace::Local)
+						refPoint = data.system->getTransform().getInvMatrix().multiplyAffine(refPoint);
+
 					auto renderData = static_cast<ParticleBillboardRenderData*>(data.renderData);
 					ParticleRenderer::sortByDistance(refPoint, renderData->positionAndRotation,
 						renderData->numParticles, 4, renderData->indices);
 				}
 				else
 				{
+					// Mesh particle instances are always in world space
 					auto renderData = static_cast<ParticleMeshRenderData*>(data.renderData);
-					ParticleRenderer::sortByDistance(refPoint, renderData->position, renderData->numParticles,
-						3, renderData->indices);
+					ParticleRenderer::sortByDistance(viewOrigin, renderData->instances, renderData->indices);
 				}
 			};
 
@@ -813,6 +1022,9 @@ namespace bs { namespace ct
 
 		if(lightAccumulationTexArray)
 			resPool.release(lightAccumulationTexArray);
+
+		lightAccumulationTex = nullptr;
+		lightAccumulationTexArray = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeLightAccumulation::getDependencies(const RendererView& view)
@@ -1568,8 +1780,14 @@ namespace bs { namespace ct
 			skybox = inputs.scene.skybox;
 
 		SPtr<Texture> radiance = skybox ? skybox->getTexture() : nullptr;
+		const SkyAtmosphere& atmosphere = inputs.scene.skyAtmosphere;
 
-		if (radiance != nullptr)
+		if (skybox && skybox->getAtmosphere() && atmosphere.isActive())
+		{
+			SkyAtmosphereMat* material = SkyAtmosphereMat::getVariation(false);
+			material->bind(inputs.view.getPerViewBuffer(), atmosphere);
+		}
+		else if (radiance != nullptr)
 		{
 			SkyboxMat* material = SkyboxMat::getVariation(false);
 			material->bind(inputs.view.getPerViewBuffer(), radiance, Color::White);
@@ -1676,6 +1894,9 @@ namespace bs { namespace ct
 		if(viewProps.encodeDepth)
 			deps.add(RCNodeResolvedSceneDepth::getNodeId());
 
+		if(viewProps.occlusionCulling)
+			deps.add(RCNodeOcclusionCulling::getNodeId());
+
 		return deps;
 	}
 
@@ -1687,9 +1908,10 @@ namespace bs { namespace ct
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
 
+		// Post-processing starting with tonemapping runs at output resolution, upscaling the scene if needed
 		const RendererViewProperties& viewProps = view.getProperties();
-		UINT32 width = viewProps.target.viewRect.width;
-		UINT32 height = viewProps.target.viewRect.height;
+		UINT32 width = viewProps.outputWidth;
+		UINT32 height = viewProps.outputHeight;
 
 		if(!mAllocated[mCurrentIdx])
 		{
@@ -1732,6 +1954,8 @@ namespace bs { namespace ct
 		if (mAllocated[1])
 			resPool.release(mOutput[1]);
 
+		mOutput[0] = nullptr;
+		mOutput[1] = nullptr;
 		mAllocated[0] = false;
 		mAllocated[1] = false;
 		mCurrentIdx = 0;
@@ -1884,6 +2108,59 @@ namespace bs { namespace ct
 		return deps;
 	}
 
+	RCNodeTemporalAA::~RCNodeTemporalAA()
+	{
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+
+		if (mPrevious)
+			resPool.release(mPrevious);
+	}
+
+	void RCNodeTemporalAA::render(const RenderCompositorNodeInputs& inputs)
+	{
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		auto* sceneColorNode = static_cast<RCNodeSceneColor*>(inputs.inputNodes[0]);
+		auto* sceneDepthNode = static_cast<RCNodeSceneDepth*>(inputs.inputNodes[1]);
+
+		const SPtr<Texture>& sceneColor = sceneColorNode->sceneColorTex->texture;
+		const SPtr<Texture>& sceneDepth = sceneDepthNode->depthTex->texture;
+
+		output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F, viewProps.outputWidth,
+			viewProps.outputHeight, TU_RENDERTARGET));
+
+		// If there is no usable history (first frame, or the view was resized) the current frame is used in its place,
+		// which the resolve then clips to the neighborhood of the current pixel, effectively restarting accumulation
+		SPtr<Texture> prevFrame = sceneColor;
+		if (mPrevious)
+		{
+			const TextureProperties& prevProps = mPrevious->texture->getProperties();
+			if (prevProps.getWidth() == viewProps.outputWidth && prevProps.getHeight() == viewProps.outputHeight)
+				prevFrame = mPrevious->texture;
+		}
+
+		TemporalAAMat* temporalAA = TemporalAAMat::get();
+		temporalAA->execute(inputs.view, sceneColor, prevFrame, sceneDepth, output->renderTexture);
+	}
+
+	void RCNodeTemporalAA::clear()
+	{
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+
+		// Save the output as history for the next frame
+		if (mPrevious)
+			resPool.release(mPrevious);
+
+		mPrevious = output;
+		output = nullptr;
+	}
+
+	SmallVector<StringID, 4> RCNodeTemporalAA::getDependencies(const RendererView& view)
+	{
+		return { RCNodeSceneColor::getNodeId(), RCNodeSceneDepth::getNodeId(), RCNodeClusteredForward::getNodeId() };
+	}
+
 	RCNodeTonemapping::~RCNodeTonemapping()
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
@@ -1902,10 +2179,18 @@ namespace bs { namespace ct
 		auto* eyeAdaptationNode = static_cast<RCNodeEyeAdaptation*>(inputs.inputNodes[0]);
 		auto* sceneColorNode = static_cast<RCNodeSceneColor*>(inputs.inputNodes[1]);
 		auto* postProcessNode = static_cast<RCNodePostProcess*>(inputs.inputNodes[3]);
-		const SPtr<Texture>& sceneColor = sceneColorNode->sceneColorTex->texture;
+		SPtr<Texture> sceneColor = sceneColorNode->sceneColorTex->texture;
+
+		// Temporal anti-aliasing output replaces the scene color, and is already at output resolution
+		if (viewProps.temporalAA)
+		{
+			const UINT32 temporalAAIdx = settings.bloom.enabled ? 6 : 5;
+			auto* temporalAANode = static_cast<RCNodeTemporalAA*>(inputs.inputNodes[temporalAAIdx]);
+			sceneColor = temporalAANode->output->texture;
+		}
 
 		const bool hdr = settings.enableHDR;
-		const bool msaa = viewProps.target.numSamples > 1;
+		const bool msaa = sceneColor->getProperties().getNumSamples() > 1;
 
 		const bool volumeLUT = inputs.featureSet == RenderBeastFeatureSet::Desktop;
 		bool gammaOnly;
@@ -1995,6 +2280,9 @@ namespace bs { namespace ct
 		if(view.getRenderSettings().bloom.enabled)
 			deps.add(RCNodeBloom::getNodeId());
 
+		if(view.getProperties().temporalAA)
+			deps.add(RCNodeTemporalAA::getNodeId());
+
 		return deps;
 	}
 
@@ -2130,6 +2418,7 @@ namespace bs { namespace ct
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
 		resPool.release(output);
+		output = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeHalfSceneColor::getDependencies(const RendererView& view)
@@ -2171,9 +2460,8 @@ namespace bs { namespace ct
 
 		if (!mPassThrough)
 			resPool.release(output);
-		else
-			output = nullptr;
 
+		output = nullptr;
 		mPassThrough = false;
 	}
 
@@ -2183,12 +2471,14 @@ namespace bs { namespace ct
 		return { RCNodeSceneDepth::getNodeId(), RCNodeBasePass::getNodeId() };
 	}
 
-	void RCNodeHiZ::render(const RenderCompositorNodeInputs& inputs)
+	/** 
+	 * Builds a hierarchical Z buffer from the provided depth buffer. Each texel contains the nearest depth of the area it
+	 * covers, or the farthest one if @p farDepth is true.
+	 */
+	static SPtr<PooledRenderTexture> buildHiZ(const RendererViewProperties& viewProps, const SPtr<Texture>& depth, 
+		bool farDepth)
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
-		const RendererViewProperties& viewProps = inputs.view.getProperties();
-
-		RCNodeResolvedSceneDepth* resolvedSceneDepth = static_cast<RCNodeResolvedSceneDepth*>(inputs.inputNodes[0]);
 
 		UINT32 width = viewProps.target.viewRect.width;
 		UINT32 height = viewProps.target.viewRect.height;
@@ -2200,8 +2490,8 @@ namespace bs { namespace ct
 		// Note: Use the 32-bit buffer here as 16-bit causes too much banding (most of the scene gets assigned 4-5 different
 		// depth values). 
 		//  - When I add UNORM 16-bit format I should be able to switch to that
-		output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R32F, size, size, TU_RENDERTARGET, 1, false, 1, 
-			numMips));
+		SPtr<PooledRenderTexture> output = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_R32F, size, size, 
+			TU_RENDERTARGET, 1, false, 1, numMips));
 
 		Rect2 srcRect = viewProps.target.nrmViewRect;
 
@@ -2212,7 +2502,7 @@ namespace bs { namespace ct
 		const RenderAPIInfo& rapiInfo = RenderAPI::instance().getAPIInfo();
 		bool noTextureViews = !rapiInfo.isFlagSet(RenderAPIFeatureFlag::TextureViews);
 
-		BuildHiZMat* material = BuildHiZMat::getVariation(noTextureViews);
+		BuildHiZMat* material = BuildHiZMat::getVariation(noTextureViews, farDepth);
 
 		// Generate first mip
 		RENDER_TEXTURE_DESC rtDesc;
@@ -2230,7 +2520,7 @@ namespace bs { namespace ct
 				Math::ceilToInt(viewProps.target.viewRect.width / 2.0f) / (float)size,
 				Math::ceilToInt(viewProps.target.viewRect.height / 2.0f) / (float)size);
 
-			material->execute(resolvedSceneDepth->output->texture, 0, srcRect, destRect, rt);
+			material->execute(depth, 0, srcRect, destRect, rt);
 		}
 		else // First level is just a copy of the depth buffer
 		{
@@ -2248,7 +2538,7 @@ namespace bs { namespace ct
 			srcAreaInt.width = (UINT32)(srcRect.width * viewProps.target.viewRect.width);
 			srcAreaInt.height = (UINT32)(srcRect.height * viewProps.target.viewRect.height);
 
-			gRendererUtility().blit(resolvedSceneDepth->output->texture, srcAreaInt);
+			gRendererUtility().blit(depth, srcAreaInt);
 			rapi.setViewport(Rect2(0, 0, 1, 1));
 		}
 
@@ -2260,12 +2550,23 @@ namespace bs { namespace ct
 
 			material->execute(output->texture, i - 1, destRect, destRect, rt);
 		}
+
+		return output;
+	}
+
+	void RCNodeHiZ::render(const RenderCompositorNodeInputs& inputs)
+	{
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		RCNodeResolvedSceneDepth* resolvedSceneDepth = static_cast<RCNodeResolvedSceneDepth*>(inputs.inputNodes[0]);
+		output = buildHiZ(viewProps, resolvedSceneDepth->output->texture, false);
 	}
 
 	void RCNodeHiZ::clear()
 	{
 		GpuResourcePool& resPool = GpuResourcePool::instance();
 		resPool.release(output);
+		output = nullptr;
 	}
 
 	SmallVector<StringID, 4> RCNodeHiZ::getDependencies(const RendererView& view)
@@ -2276,6 +2577,31 @@ namespace bs { namespace ct
 		return { RCNodeResolvedSceneDepth::getNodeId(), RCNodeBasePass::getNodeId() };
 	}
 
+	void RCNodeOcclusionCulling::render(const RenderCompositorNodeInputs& inputs)
+	{
+		// Requires compute shader support
+		if (inputs.featureSet != RenderBeastFeatureSet::Desktop)
+			return;
+
+		const RendererViewProperties& viewProps = inputs.view.getProperties();
+
+		RCNodeResolvedSceneDepth* resolvedSceneDepth = static_cast<RCNodeResolvedSceneDepth*>(inputs.inputNodes[0]);
+		SPtr<PooledRenderTexture> hiZ = buildHiZ(viewProps, resolvedSceneDepth->output->texture, true);
+
+		inputs.view.getOcclusionCulling().execute(inputs.view, inputs.scene, hiZ->texture);
+
+		GpuResourcePool::instance().release(hiZ);
+	}
+
+	void RCNodeOcclusionCulling::clear()
+	{ }
+
+	SmallVector<StringID, 4> RCNodeOcclusionCulling::getDependencies(const RendererView& view)
+	{
+		// Base pass required for the same reason as with RCNodeHiZ
+		return { RCNodeResolvedSceneDepth::getNodeId(), RCNodeBasePass::getNodeId() };
+	}
+
 	void RCNodeSSAO::render(const RenderCompositorNodeInputs& inputs)
 	{
 		/** Maximum valid depth range within samples in a sample set. In meters. */
@@ -2469,6 +2795,7 @@ namespace bs { namespace ct
 			resPool.release(mPooledOutput);
 		}
 
+		mPooledOutput = nullptr;
 		output = nullptr;
 	}
 
@@ -2710,6 +3037,7 @@ namespace bs { namespace ct
 		GpuResourcePool& resPool = GpuResourcePool::instance();
 		resPool.release(mPooledOutput);
 
+		mPooledOutput = nullptr;
 		output = nullptr;
 	}
 
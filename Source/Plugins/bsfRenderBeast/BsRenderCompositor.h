@@ -522,6 +522,30 @@ namespace ct
 		SPtr<PooledRenderTexture> previous;
 	};
 
+	/**
+	 * Performs temporal anti-aliasing by blending the scene color with the reprojected result of the previous frame.
+	 * Output is at the view's output resolution, upsampling the scene color if the view is rendered at a reduced
+	 * resolution. Only part of the hierarchy if RendererViewProperties::temporalAA is enabled.
+	 */
+	class RCNodeTemporalAA : public RenderCompositorNode
+	{
+	public:
+		SPtr<PooledRenderTexture> output;
+
+		~RCNodeTemporalAA();
+
+		static StringID getNodeId() { return "TemporalAA"; }
+		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+	protected:
+		/** @copydoc RenderCompositorNode::render */
+		void render(const RenderCompositorNodeInputs& inputs) override;
+
+		/** @copydoc RenderCompositorNode::clear */
+		void clear() override;
+
+		SPtr<PooledRenderTexture> mPrevious;
+	};
+
 	/**
 	 * Performs tone mapping on the contents of the scene color texture. At the same time resolves MSAA into a non-MSAA
 	 * scene color texture.
@@ -626,6 +650,23 @@ namespace ct
 		void clear() override;
 	};
 
+	/**
+	 * Tests renderables and lights visible in the view for occlusion, against a hierarchical Z buffer built from the
+	 * view's depth buffer. Results are used for culling in later frames.
+	 */
+	class RCNodeOcclusionCulling : public RenderCompositorNode
+	{
+	public:
+		static StringID getNodeId() { return "OcclusionCulling"; }
+		static SmallVector<StringID, 4> getDependencies(const RendererView& view);
+	protected:
+		/** @copydoc RenderCompositorNode::render */
+		void render(const RenderCompositorNodeInputs& inputs) override;
+
+		/** @copydoc RenderCompositorNode::clear */
+		void clear() override;
+	};
+
 	/** Renders screen space ambient occlusion. */
 	class RCNodeSSAO : public RenderCompositorNode
 	{
@@ -5,14 +5,39 @@
 #include "Renderer/BsDecal.h"
 #include "Mesh/BsMesh.h"
 #include "Renderer/BsRendererUtility.h"
+#include "Material/BsGpuParamsSet.h"
 
 namespace bs { namespace ct
 {
 	DecalParamDef gDecalParamDef;
 
-	void DecalRenderElement::draw() const
+	void DecalRenderElement::draw(const SPtr<CommandBuffer>& commandBuffer) const
 	{
-		gRendererUtility().draw(mesh, subMesh);
+		gRendererUtility().draw(mesh, subMesh, 1, commandBuffer);
+	}
+
+	void ClusteredDecalElement::bindClusterData() const
+	{
+		SPtr<GpuParams> gpuParams = params->getGpuParams();
+		gpuParams->setParamBlockBuffer("DecalParams", decalParamBuffer);
+		gpuParams->setParamBlockBuffer("GridParams", gridParamBuffer);
+
+		for(UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			const GpuParamBinding& binding = clustered->perCameraBindings[i];
+			if(binding.slot != (UINT32)-1)
+				gpuParams->setParamBlockBuffer(binding.set, binding.slot, perCameraParamBuffer);
+		}
+
+		clustered->decalDataParam.set(decalDataBuffer);
+		clustered->decalOffsetsAndSizeParam.set(decalOffsetsAndSizeBuffer);
+		clustered->decalIndicesParam.set(decalIndicesBuffer);
+	}
+
+	void ClusteredDecalElement::draw(const SPtr<CommandBuffer>& commandBuffer) const
+	{
+		// Clustered elements are never recorded on secondary command buffers, see renderQueueElements()
+		gRendererUtility().drawScreenQuad();
 	}
 
 	RendererDecal::RendererDecal()
@@ -59,6 +84,15 @@ namespace bs { namespace ct
 		gDecalParamDef.gNormalTolerance.set(decalParamBuffer, normalTolerance);
 		gDecalParamDef.gFlipDerivatives.set(decalParamBuffer, flipDerivatives);
 		gDecalParamDef.gLayerMask.set(decalParamBuffer, (INT32)decal->getLayerMask());
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			clusteredData.worldToDecal[i] = Vector4(worldToDecal[i][0], worldToDecal[i][1], worldToDecal[i][2],
+				worldToDecal[i][3]);
+		}
+
+		clusteredData.normal = decalNormal;
+		clusteredData.layerMask = decal->getLayerMask();
 	}
 
 	void RendererDecal::updatePerCallBuffer(const Matrix4& viewProj, bool flush) const
@@ -46,18 +46,56 @@ namespace bs { namespace ct
 	};
 
 	/** Returns a specific decal shader variation. */
-	template<bool INSIDE_GEOMETRY, MSAAMode MSAA_MODE>
+	template<bool INSIDE_GEOMETRY, MSAAMode MSAA_MODE, bool CLUSTERED = false>
 	static const ShaderVariation& getDecalShaderVariation()
 	{
 		static ShaderVariation variation = ShaderVariation(
 		{
 			ShaderVariation::Param("INSIDE_GEOMETRY", INSIDE_GEOMETRY),
 			ShaderVariation::Param("MSAA_MODE", (INT32)MSAA_MODE),
+			ShaderVariation::Param("CLUSTERED", CLUSTERED),
 		});
 
 		return variation;
 	}
 
+	/**
+	 * Material parameters used for applying all visible decals using the same material in a single full screen pass,
+	 * looking up the decals affecting each pixel through the light grid. Shared by all decals using the same material.
+	 */
+	struct ClusteredDecalMaterialParams
+	{
+		/** Indices of the material technique supporting clustered rendering, for each MSAA mode. */
+		UINT32 techniqueIndices[3];
+
+		/** GPU parameters used by all clustered draws using the material. */
+		SPtr<GpuParamsSet> params;
+
+		/** Binding indices representing where should the per-camera param block buffer be bound to. */
+		GpuParamBinding perCameraBindings[GPT_COUNT];
+
+		/** Parameter that receives the buffer containing per-decal data. */
+		GpuParamBuffer decalDataParam;
+
+		/** Parameter that receives the offset and number of decals affecting each grid cell. */
+		GpuParamBuffer decalOffsetsAndSizeParam;
+
+		/** Parameter that receives decal indices of all grid cells. */
+		GpuParamBuffer decalIndicesParam;
+
+		/** Texture input for the depth buffer. */
+		GpuParamTexture depthInputTexture;
+
+		/** Texture input for the mask buffer. */
+		GpuParamTexture maskInputTexture;
+
+		/** Optional overrides for material sampler states. See DecalRenderElement::samplerOverrides. */
+		MaterialSamplerOverrides* samplerOverrides = nullptr;
+
+		/** Number of decals using the parameters. */
+		UINT32 refCount = 0;
+	};
+
 	/** Contains information required for rendering a single Decal. */
 	class DecalRenderElement : public RenderElement
 	{
@@ -84,7 +122,59 @@ namespace bs { namespace ct
 		GpuParamTexture maskInputTexture;
 
 		/** @copydoc RenderElement::draw */
-		void draw() const override;
+		void draw(const SPtr<CommandBuffer>& commandBuffer = nullptr) const override;
+	};
+
+	/** Per-decal data used by clustered decal rendering, matching the layout of gDecalData in Decal.bsl. */
+	struct ClusteredDecalData
+	{
+		Vector4 worldToDecal[3];
+		Vector3 normal;
+		UINT32 layerMask;
+	};
+
+	/** 
+	 * Render element that applies all visible decals using the same material in a single full screen pass, using the
+	 * light grid to find the decals affecting each pixel.
+	 */
+	class ClusteredDecalElement final : public RenderElement
+	{
+	public:
+		/** Shared material parameters the element is rendered with. */
+		ClusteredDecalMaterialParams* clustered = nullptr;
+
+		/** Buffer containing the ClusteredDecalData of all clustered decals in the view. */
+		SPtr<GpuBuffer> decalDataBuffer;
+
+		/** Buffer containing the offset into @p decalIndicesBuffer and the number of decals, for each grid cell. */
+		SPtr<GpuBuffer> decalOffsetsAndSizeBuffer;
+
+		/** Indices into @p decalDataBuffer of decals affecting each grid cell, ordered back to front. */
+		SPtr<GpuBuffer> decalIndicesBuffer;
+
+		/** Decal parameters of the first decal, providing values not stored per decal. */
+		SPtr<GpuParamBlockBuffer> decalParamBuffer;
+
+		/** Per-camera parameters of the view the element is rendered from. */
+		SPtr<GpuParamBlockBuffer> perCameraParamBuffer;
+
+		/** Light grid parameters of the view the element is rendered from. */
+		SPtr<GpuParamBlockBuffer> gridParamBuffer;
+
+		/** Index of the first decal rendered by the element, within @p decalDataBuffer. */
+		UINT32 firstDecal = 0;
+
+		/** Number of decals rendered by the element, starting at @p firstDecal. */
+		UINT32 numDecals = 0;
+
+		/** 
+		 * Assigns the element's buffers to the shared material parameters. Must be called before the parameters are
+		 * bound for rendering.
+		 */
+		void bindClusterData() const;
+
+		/** @copydoc RenderElement::draw */
+		void draw(const SPtr<CommandBuffer>& commandBuffer = nullptr) const override;
 	};
 
 	 /** Contains information about a Decal, used by the Renderer. */
@@ -106,6 +196,15 @@ namespace bs { namespace ct
 		Decal* decal;
 		mutable DecalRenderElement renderElement;
 
+		/** 
+		 * Parameters used for rendering the decal together with other decals using the same material. Null if the
+		 * material doesn't support clustered rendering.
+		 */
+		ClusteredDecalMaterialParams* clustered = nullptr;
+
+		/** Data used for rendering the decal as part of a ClusteredDecalElement. Updated with the per-object buffer. */
+		ClusteredDecalData clusteredData;
+
 		SPtr<GpuParamBlockBuffer> decalParamBuffer;
 		SPtr<GpuParamBlockBuffer> perObjectParamBuffer;
 		SPtr<GpuParamBlockBuffer> perCallParamBuffer;
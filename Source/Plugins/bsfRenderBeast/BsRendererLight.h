@@ -154,6 +154,12 @@ namespace ct
 		/** Returns a GPU bindable buffer containing information about every light. */
 		SPtr<GpuBuffer> getLightBuffer() const { return mLightBuffer; }
 
+		/** 
+		 * Returns the GPU data of a visible light. Lights are ordered by type: directional, radial, spot. Index must be 
+		 * less than the total number of visible lights.
+		 */
+		const LightData& getLightData(UINT32 idx) const { return mVisibleLightData[idx]; }
+
 		/** 
 		 * Scans the list of lights visible in the view frustum to find the ones influencing the object described by
 		 * the provided bounds. A maximum number of STANDARD_FORWARD_MAX_NUM_LIGHTS will be output. If there are more
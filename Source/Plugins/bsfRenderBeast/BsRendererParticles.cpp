@@ -12,9 +12,19 @@
 #include "Material/BsGpuParamsSet.h"
 #include "BsRendererView.h"
 #include "Mesh/BsMeshUtility.h"
+#include "Utility/BsRadixSort.h"
+#include "Material/BsMaterial.h"
+#include "Material/BsShader.h"
+#include "BsRenderBeast.h"
 
 namespace bs { namespace ct
 {
+	/** Minimum number of particles in a system before distance sorting switches from a comparison to a radix sort. */
+	static constexpr UINT32 RADIX_SORT_THRESHOLD = 1024;
+
+	/** Smallest number of instances to allocate a mesh particle instance buffer for. */
+	static constexpr UINT32 MIN_MESH_INSTANCE_BUFFER_SIZE = 256;
+
 	template<bool LOCK_Y, bool GPU, bool IS_3D, ParticleForwardLightingType FWD>
 	const ShaderVariation& _getParticleShaderVariation(ParticleOrientation orient)
 	{
@@ -95,59 +105,50 @@ namespace bs { namespace ct
 		buffer->unlock();
 	}
 
-	void ParticlesRenderElement::draw() const
+	void ParticlesRenderElement::draw(const SPtr<CommandBuffer>& commandBuffer) const
 	{
 		if (numParticles > 0)
 		{
 			if (is3D)
-				gRendererUtility().draw(mesh, numParticles);
+				gRendererUtility().draw(mesh, numParticles, commandBuffer);
 			else
-				ParticleRenderer::instance().drawBillboards(numParticles);
+				ParticleRenderer::instance().drawBillboards(numParticles, commandBuffer);
 		}
 	}
 
-	void RendererParticles::bindCPUSimulatedInputs(const ParticleRenderData* renderData, const RendererView& view) const
+	void RendererParticles::bindCPUSimulatedInputs(const ParticleBillboardRenderData* renderData, 
+		const RendererView& view) const
 	{
 		ParticleTexturePool& particlesTexPool = ParticleRenderer::instance().getTexturePool();
+		const ParticleBillboardTextures* textures = particlesTexPool.alloc(*renderData);
 
-		const ParticleSystemSettings& settings = particleSystem->getSettings();
-		UINT32 texSize;
-		switch (settings.renderMode)
-		{
-		default:
-		case ParticleRenderMode::Billboard:
-		{
-			const auto billboardRenderData = static_cast<const ParticleBillboardRenderData*>(renderData);
-			const ParticleBillboardTextures* textures = particlesTexPool.alloc(*billboardRenderData);
-
-			renderElement.paramsCPUBillboard.positionAndRotTexture.set(textures->positionAndRotation);
-			renderElement.paramsCPUBillboard.colorTexture.set(textures->color);
-			renderElement.paramsCPUBillboard.sizeAndFrameIdxTexture.set(textures->sizeAndFrameIdx);
+		renderElement.paramsCPUBillboard.positionAndRotTexture.set(textures->positionAndRotation);
+		renderElement.paramsCPUBillboard.colorTexture.set(textures->color);
+		renderElement.paramsCPUBillboard.sizeAndFrameIdxTexture.set(textures->sizeAndFrameIdx);
 
-			renderElement.indicesBuffer.set(textures->indices);
-			texSize = textures->positionAndRotation->getProperties().getWidth();
-		}
-		break;
-		case ParticleRenderMode::Mesh:
-		{
-			const auto meshRenderData = static_cast<const ParticleMeshRenderData*>(renderData);
-			const ParticleMeshTextures* textures = particlesTexPool.alloc(*meshRenderData);
+		renderElement.indicesBuffer.set(textures->indices);
+		renderElement.numParticles = renderData->numParticles;
 
-			renderElement.paramsCPUMesh.positionTexture.set(textures->position);
-			renderElement.paramsCPUMesh.colorTexture.set(textures->color);
-			renderElement.paramsCPUMesh.rotationTexture.set(textures->rotation);
-			renderElement.paramsCPUMesh.sizeTexture.set(textures->size);
+		const UINT32 texSize = textures->positionAndRotation->getProperties().getWidth();
+		gParticlesParamDef.gTexSize.set(particlesParamBuffer, texSize);
+		gParticlesParamDef.gBufferOffset.set(particlesParamBuffer, 0);
 
-			renderElement.indicesBuffer.set(textures->indices);
-			texSize = textures->position->getProperties().getWidth();
-		}
-		break;
+		SPtr<GpuParams> gpuParams = renderElement.params->getGpuParams();
+		for (UINT32 j = 0; j < GPT_COUNT; j++)
+		{
+			const GpuParamBinding& binding = renderElement.perCameraBindings[j];
+			if (binding.slot != (UINT32)-1)
+				gpuParams->setParamBlockBuffer(binding.set, binding.slot, view.getPerViewBuffer());
 		}
+	}
 
-		renderElement.numParticles = renderData->numParticles;
+	void RendererParticles::bindCPUSimulatedMeshInputs(const SPtr<GpuBuffer>& instances, UINT32 firstInstance, 
+		UINT32 numInstances, const RendererView& view) const
+	{
+		renderElement.paramsCPUMesh.instancesBuffer.set(instances);
+		renderElement.numParticles = numInstances;
 
-		gParticlesParamDef.gTexSize.set(particlesParamBuffer, texSize);
-		gParticlesParamDef.gBufferOffset.set(particlesParamBuffer, 0);
+		gParticlesParamDef.gBufferOffset.set(particlesParamBuffer, firstInstance);
 
 		SPtr<GpuParams> gpuParams = renderElement.params->getGpuParams();
 		for (UINT32 j = 0; j < GPT_COUNT; j++)
@@ -202,11 +203,6 @@ namespace bs { namespace ct
 				mBillboardAlloc.destruct(entry);
 		}
 
-		for (auto& sizeEntry : mMeshBufferList)
-		{
-			for (auto& entry : sizeEntry.second.buffers)
-				mMeshAlloc.destruct(entry);
-		}
 	}
 
 	const ParticleBillboardTextures* ParticleTexturePool::alloc(const ParticleBillboardRenderData& simulationData)
@@ -238,34 +234,15 @@ namespace bs { namespace ct
 		return output;
 	}
 
-	const ParticleMeshTextures* ParticleTexturePool::alloc(const ParticleMeshRenderData& simulationData)
+	const SPtr<GpuBuffer>& ParticleTexturePool::allocMeshInstances(UINT32 numInstances)
 	{
-		const UINT32 size = simulationData.color.getWidth();
+		const UINT32 size = Bitwise::nextPow2(std::max(numInstances, MIN_MESH_INSTANCE_BUFFER_SIZE));
 
-		const ParticleMeshTextures* output = nullptr;
 		MeshBuffersPerSize& buffers = mMeshBufferList[size];
-		if (buffers.nextFreeIdx < (UINT32)buffers.buffers.size())
-		{
-			output = buffers.buffers[buffers.nextFreeIdx];
-			buffers.nextFreeIdx++;
-		}
+		if (buffers.nextFreeIdx >= (UINT32)buffers.buffers.size())
+			buffers.buffers.push_back(createNewMeshInstances(size));
 
-		if (!output)
-		{
-			output = createNewMeshTextures(size);
-			buffers.nextFreeIdx++;
-		}
-
-		// Populate texture contents
-		// Note: Perhaps instead of using write-discard here, we should track which frame has finished rendering and then
-		// just use no-overwrite? write-discard will very likely allocate memory under the hood.
-		output->position->writeData(simulationData.position, 0, 0, true);
-		output->color->writeData(simulationData.color, 0, 0, true);
-		output->size->writeData(simulationData.size, 0, 0, true);
-		output->rotation->writeData(simulationData.rotation, 0, 0, true);
-
-		writeIndices(output->indices.get(), simulationData.indices, size);
-		return output;
+		return buffers.buffers[buffers.nextFreeIdx++];
 	}
 
 	void ParticleTexturePool::clear()
@@ -307,38 +284,20 @@ namespace bs { namespace ct
 		return output;
 	}
 
-	ParticleMeshTextures* ParticleTexturePool::createNewMeshTextures(UINT32 size)
+	SPtr<GpuBuffer> ParticleTexturePool::createNewMeshInstances(UINT32 size)
 	{
-		ParticleMeshTextures* output = mMeshAlloc.construct<ParticleMeshTextures>();
-
-		TEXTURE_DESC texDesc;
-		texDesc.type = TEX_TYPE_2D;
-		texDesc.width = size;
-		texDesc.height = size;
-		texDesc.usage = TU_DYNAMIC;
-
-		texDesc.format = PF_RGBA32F;
-		output->position = Texture::create(texDesc);
-
-		texDesc.format = PF_RGBA8;
-		output->color = Texture::create(texDesc);
-
-		texDesc.format = PF_RGBA16F;
-		output->size = Texture::create(texDesc);
-
-		texDesc.format = PF_RGBA16F;
-		output->rotation = Texture::create(texDesc);
+		static_assert(sizeof(ParticleMeshInstance) == sizeof(UINT32) * 8, 
+			"Mesh instance is expected to map to two 4-component GPU buffer elements.");
 
 		GPU_BUFFER_DESC bufferDesc;
 		bufferDesc.type = GBT_STANDARD;
-		bufferDesc.elementCount = size * size;
-		bufferDesc.format = BF_16X2U;
+		bufferDesc.elementCount = size * 2;
+		bufferDesc.format = BF_32X4U;
+		bufferDesc.usage = GBU_DYNAMIC;
 
-		output->indices = GpuBuffer::create(bufferDesc);
-
-		mMeshBufferList[size].buffers.push_back(output);
-		return output;
+		return GpuBuffer::create(bufferDesc);
 	}
+
 	struct ParticleRenderer::Members
 	{
 		SPtr<VertexBuffer> billboardVB;
@@ -401,19 +360,107 @@ namespace bs { namespace ct
 		bs_delete(m);
 	}
 
-	void ParticleRenderer::drawBillboards(UINT32 count)
+	void ParticleRenderer::drawBillboards(UINT32 count, const SPtr<CommandBuffer>& commandBuffer)
 	{
 		SPtr<VertexBuffer> vertexBuffers[] = { m->billboardVB };
 
 		RenderAPI& rapi = RenderAPI::instance();
-		rapi.setVertexDeclaration(m->billboardVD);
-		rapi.setVertexBuffers(0, vertexBuffers, 1);
-		rapi.setDrawOperation(DOT_TRIANGLE_STRIP);
-		rapi.draw(0, 4, count);
+		rapi.setVertexDeclaration(m->billboardVD, commandBuffer);
+		rapi.setVertexBuffers(0, vertexBuffers, 1, commandBuffer);
+		rapi.setDrawOperation(DOT_TRIANGLE_STRIP, commandBuffer);
+		rapi.draw(0, 4, count, commandBuffer);
 	}
 
-	void ParticleRenderer::sortByDistance(const Vector3& refPoint, const PixelData& positions, UINT32 numParticles, 
-		UINT32 stride, Vector<UINT32>& indices)
+	void ParticleRenderer::bindMeshInstances(const RendererParticles* const* systems, 
+		const ParticleMeshRenderData* const* renderData, UINT32 count, const RendererView& view)
+	{
+		if(count == 0)
+			return;
+
+		const bool supportsClusteredForward = gRenderBeast()->getFeatureSet() == RenderBeastFeatureSet::Desktop;
+
+		bs_frame_mark();
+		{
+			FrameVector<UINT32> order(count);
+			FrameVector<UINT32> offsets(count);
+			FrameVector<bool> batchable(count);
+
+			UINT32 totalInstances = 0;
+			for(UINT32 i = 0; i < count; i++)
+			{
+				order[i] = i;
+				totalInstances += renderData[i]->numParticles;
+
+				// Merged systems draw in a single call, so their relative order can't be maintained which transparent
+				// systems rely on. Standard forward lighting also only binds lights relevant to a single system.
+				const ShaderFlags shaderFlags = systems[i]->renderElement.material->getShader()->getFlags();
+				batchable[i] = !shaderFlags.isSet(ShaderFlag::Transparent) &&
+					(!shaderFlags.isSet(ShaderFlag::Forward) || supportsClusteredForward);
+			}
+
+			const auto getBatchKey = [systems, &batchable](UINT32 idx)
+			{
+				const ParticlesRenderElement& element = systems[idx]->renderElement;
+
+				return std::make_tuple(!batchable[idx], (UINT64)(size_t)element.mesh.get(), 
+					(UINT64)(size_t)element.material.get(), systems[idx]->particleSystem->getLayer());
+			};
+
+			// Place systems that can be merged next to each other, so their instances end up sequential in the buffer
+			std::sort(order.begin(), order.end(), [&getBatchKey](UINT32 lhs, UINT32 rhs)
+			{
+				return std::make_tuple(getBatchKey(lhs), lhs) < std::make_tuple(getBatchKey(rhs), rhs);
+			});
+
+			const SPtr<GpuBuffer>& buffer = mTexturePool.allocMeshInstances(totalInstances);
+			if(totalInstances > 0)
+			{
+				auto* const instances = (ParticleMeshInstance*)buffer->lock(GBL_WRITE_ONLY_DISCARD);
+
+				UINT32 offset = 0;
+				for(auto& idx : order)
+				{
+					const ParticleMeshRenderData& data = *renderData[idx];
+					for(UINT32 i = 0; i < data.numParticles; i++)
+						instances[offset + i] = data.instances[data.indices[i]];
+
+					offsets[idx] = offset;
+					offset += data.numParticles;
+				}
+
+				buffer->unlock();
+			}
+
+			for(UINT32 i = 0; i < count;)
+			{
+				const UINT32 first = order[i];
+				UINT32 numInstances = renderData[first]->numParticles;
+
+				UINT32 end = i + 1;
+				if(batchable[first])
+				{
+					for(; end < count && getBatchKey(order[end]) == getBatchKey(first); end++)
+						numInstances += renderData[order[end]]->numParticles;
+				}
+
+				systems[first]->bindCPUSimulatedMeshInputs(buffer, offsets[first], numInstances, view);
+
+				// Instances of the remaining systems are rendered by the first system's draw call
+				for(UINT32 j = i + 1; j < end; j++)
+					systems[order[j]]->bindCPUSimulatedMeshInputs(buffer, offsets[order[j]], 0, view);
+
+				i = end;
+			}
+		}
+		bs_frame_clear();
+	}
+
+	/** 
+	 * Sorts the particle indices from furthest to nearest. @p forEachDistance must call the provided callback with the
+	 * index and squared distance of every particle.
+	 */
+	template<class DistanceIterator>
+	static void sortIndicesByDistance(UINT32 numParticles, Vector<UINT32>& indices, DistanceIterator forEachDistance)
 	{
 		struct ParticleSortData
 		{
@@ -425,21 +472,57 @@ namespace bs { namespace ct
 			UINT32 idx;
 		};
 
-		const UINT32 size = positions.getWidth();
-		UINT8* positionPtr = positions.getData();
-
 		bs_frame_mark();
+		if (numParticles >= RADIX_SORT_THRESHOLD)
+		{
+			// Keys are inverted so the radix sort (ascending) yields back to front order
+			FrameVector<UINT32> keys(numParticles * 2);
+			FrameVector<UINT32> scratchIndices(numParticles);
+
+			forEachDistance([&keys, &indices](UINT32 i, float distance)
+			{
+				keys[i] = ~RadixSort::floatToKey(distance);
+				indices[i] = i;
+			});
+
+			RadixSort::sort(keys.data(), indices.data(), numParticles, keys.data() + numParticles, 
+				scratchIndices.data());
+		}
+		else
 		{
 			FrameVector<ParticleSortData> sortData;
 			sortData.reserve(numParticles);
 
+			forEachDistance([&sortData](UINT32 i, float distance)
+			{
+				sortData.emplace_back(distance, i);
+			});
+
+			std::sort(sortData.begin(), sortData.end(),
+				[](const ParticleSortData& lhs, const ParticleSortData& rhs)
+			{
+				return rhs.key < lhs.key;
+			});
+
+			for (UINT32 i = 0; i < numParticles; i++)
+				indices[i] = sortData[i].idx;
+		}
+		bs_frame_clear();
+	}
+
+	void ParticleRenderer::sortByDistance(const Vector3& refPoint, const PixelData& positions, UINT32 numParticles, 
+		UINT32 stride, Vector<UINT32>& indices)
+	{
+		const UINT32 size = positions.getWidth();
+		UINT8* positionPtr = positions.getData();
+
+		sortIndicesByDistance(numParticles, indices, [&](auto func)
+		{
 			UINT32 x = 0;
 			for (UINT32 i = 0; i < numParticles; i++)
 			{
 				const Vector3& position = *(Vector3*)positionPtr;
-
-				float distance = refPoint.squaredDistance(position);
-				sortData.emplace_back(distance, i);
+				func(i, refPoint.squaredDistance(position));
 
 				positionPtr += sizeof(float) * stride;
 				x++;
@@ -450,17 +533,18 @@ namespace bs { namespace ct
 					positionPtr += positions.getRowSkip();
 				}
 			}
+		});
+	}
 
-			std::sort(sortData.begin(), sortData.end(),
-				[](const ParticleSortData& lhs, const ParticleSortData& rhs)
-			{
-				return rhs.key < lhs.key;
-			});
+	void ParticleRenderer::sortByDistance(const Vector3& refPoint, const Vector<ParticleMeshInstance>& instances,
+		Vector<UINT32>& indices)
+	{
+		const auto numParticles = (UINT32)indices.size();
 
+		sortIndicesByDistance(numParticles, indices, [&](auto func)
+		{
 			for (UINT32 i = 0; i < numParticles; i++)
-				indices[i] = sortData[i].idx;
-		}
-		bs_frame_clear();
+				func(i, refPoint.squaredDistance(instances[i].position));
+		});
 	}
-
-}}
+}}
\ No newline at end of file
@@ -17,6 +17,7 @@
 namespace bs 
 {
 	struct ParticleMeshRenderData;
+	struct ParticleMeshInstance;
 	struct ParticleBillboardRenderData;
 	struct ParticleRenderData; 
 }
@@ -140,17 +141,8 @@ namespace bs { namespace ct
 		/** Parameters relevant for mesh rendering of the outputs of the particle CPU simulation. */
 		struct CpuMeshSimulationParams
 		{
-			/** Binding spot for the texture containing position. */
-			GpuParamTexture positionTexture;
-
-			/** Binding spot for the texture containing color information. */
-			GpuParamTexture colorTexture;
-
-			/** Binding spot for the texture containing rotation. */
-			GpuParamTexture rotationTexture;
-
-			/** Binding spot for the texture containing size. */
-			GpuParamTexture sizeTexture;
+			/** Binding spot for the buffer containing per-instance data for every rendered mesh particle. */
+			GpuParamBuffer instancesBuffer;
 		};
 
 		/** Parameters relevant for rendering the outputs of the particle GPU simulation. */
@@ -200,7 +192,7 @@ namespace bs { namespace ct
 		bool isValid() const { return !is3D || mesh != nullptr; }
 
 		/** @copydoc RenderElement::draw */
-		void draw() const override;
+		void draw(const SPtr<CommandBuffer>& commandBuffer = nullptr) const override;
 	};
 
 	/** Contains information about a ParticleSystem, used by the Renderer. */
@@ -234,12 +226,25 @@ namespace bs { namespace ct
 		TextureRowAllocation sizeScaleFrameIdxCurveAlloc;
 
 		/** 
-		 * Binds all the GPU program inputs required for rendering a particle system that is being simulated by the CPU. 
+		 * Binds all the GPU program inputs required for rendering a particle system that is being simulated by the CPU,
+		 * and rendered using billboards.
 		 * 
 		 * @param[in]	renderData		Render data representing the state of a CPU simulated particle system. 
 		 * @param[in]	view			View the particle system is being rendered from.
 		 */
-		void bindCPUSimulatedInputs(const ParticleRenderData* renderData, const RendererView& view) const;
+		void bindCPUSimulatedInputs(const ParticleBillboardRenderData* renderData, const RendererView& view) const;
+
+		/** 
+		 * Binds all the GPU program inputs required for rendering a particle system that is being simulated by the CPU,
+		 * and rendered using meshes.
+		 * 
+		 * @param[in]	instances		Buffer containing per-instance data of the particles to render.
+		 * @param[in]	firstInstance	Index of the first instance in @p instances to render.
+		 * @param[in]	numInstances	Number of instances to render, starting at @p firstInstance.
+		 * @param[in]	view			View the particle system is being rendered from.
+		 */
+		void bindCPUSimulatedMeshInputs(const SPtr<GpuBuffer>& instances, UINT32 firstInstance, UINT32 numInstances,
+			const RendererView& view) const;
 
 		/** 
 		 * Binds all the GPU program inputs required for rendering a particle system that is being simulated by the GPU. 
@@ -265,20 +270,7 @@ namespace bs { namespace ct
 		SPtr<GpuBuffer> indices;
 	};
 
-	/**
-	 * Contains a set of textures used for rendering a particle system using 3D meshes. Each pixel in a texture represent 
-	 * properties of a single particle.
-	 */
-	struct ParticleMeshTextures
-	{
-		SPtr<Texture> position;
-		SPtr<Texture> color;
-		SPtr<Texture> size;
-		SPtr<Texture> rotation;
-		SPtr<GpuBuffer> indices;
-	};
-
-	/** Keeps a pool of textures used for the purposes of the particle system. */
+	/** Keeps a pool of textures and buffers used for the purposes of the particle system. */
 	class ParticleTexturePool final
 	{
 		/** A set of created textures for billboard rendering, per size. */
@@ -288,10 +280,10 @@ namespace bs { namespace ct
 			UINT32 nextFreeIdx = 0;
 		};
 
-		/** A set of created textures for mesh rendering, per size. */
+		/** A set of created instance buffers for mesh rendering, per size. */
 		struct MeshBuffersPerSize
 		{
-			Vector<ParticleMeshTextures*> buffers;
+			Vector<SPtr<GpuBuffer>> buffers;
 			UINT32 nextFreeIdx = 0;
 		};
 
@@ -305,10 +297,10 @@ namespace bs { namespace ct
 		const ParticleBillboardTextures* alloc(const ParticleBillboardRenderData& simulationData);
 
 		/** 
-		 * Returns a set of textures used for particle mesh rendering. The textures will contain the pixel data from 
-		 * the provided @p simulationData. Returned textures will remain in-use until the next call to clear().
+		 * Returns a buffer used for particle mesh rendering, able to hold at least @p numInstances instances of
+		 * ParticleMeshInstance. Returned buffer will remain in-use until the next call to clear().
 		 */
-		const ParticleMeshTextures* alloc(const ParticleMeshRenderData& simulationData);
+		const SPtr<GpuBuffer>& allocMeshInstances(UINT32 numInstances);
 
 		/** Frees all allocates textures and makes them available for re-use. */
 		void clear();
@@ -317,14 +309,13 @@ namespace bs { namespace ct
 		/** Creates a new set of textures for billboard rendering, with @p size width and height. */
 		ParticleBillboardTextures* createNewBillboardTextures(UINT32 size);
 
-		/** Creates a new set of textures for mesh rendering, with @p size width and height. */
-		ParticleMeshTextures* createNewMeshTextures(UINT32 size);
+		/** Creates a new instance buffer for mesh rendering, able to hold @p size instances. */
+		SPtr<GpuBuffer> createNewMeshInstances(UINT32 size);
 
 		UnorderedMap<UINT32, BillboardBuffersPerSize> mBillboardBufferList;
 		PoolAlloc<sizeof(ParticleBillboardTextures), 32> mBillboardAlloc;
 
 		UnorderedMap<UINT32, MeshBuffersPerSize> mMeshBufferList;
-		PoolAlloc<sizeof(ParticleMeshTextures), 32> mMeshAlloc;
 	};
 
 	/** Handles internal logic for rendering of particle systems. */
@@ -341,8 +332,24 @@ namespace bs { namespace ct
 		 */
 		ParticleTexturePool& getTexturePool() { return mTexturePool; }
 
-		/** Draws @p count quads used for billboard rendering, using instanced drawing. */
-		void drawBillboards(UINT32 count);
+		/** 
+		 * Draws @p count quads used for billboard rendering, using instanced drawing. If a command buffer is provided the
+		 * draw is queued on it, instead of being executed immediately.
+		 */
+		void drawBillboards(UINT32 count, const SPtr<CommandBuffer>& commandBuffer = nullptr);
+
+		/** 
+		 * Uploads per-instance data of all the provided particle systems rendered using meshes into a single instance
+		 * buffer, and binds it to their render elements. Opaque systems that share the same mesh, material and layer
+		 * are merged so they are all rendered using a single instanced draw call.
+		 * 
+		 * @param[in]	systems			CPU simulated particle systems using the mesh render mode.
+		 * @param[in]	renderData		Simulation outputs for each entry in @p systems.
+		 * @param[in]	count			Number of entries in the @p systems and @p renderData arrays.
+		 * @param[in]	view			View the particle systems are being rendered from.
+		 */
+		void bindMeshInstances(const RendererParticles* const* systems, const ParticleMeshRenderData* const* renderData,
+			UINT32 count, const RendererView& view);
 
 		/** 
 		 * Updates the provided indices buffer so they particles are sorted from further to nearest with respect to
@@ -358,6 +365,19 @@ namespace bs { namespace ct
 		 */
 		static void sortByDistance(const Vector3& refPoint, const PixelData& positions, UINT32 numParticles, 
 			UINT32 stride, Vector<UINT32>& indices);
+
+		/** 
+		 * Updates the provided indices buffer so mesh particle instances are sorted from further to nearest with respect
+		 * to some reference point.
+		 * 
+		 * @param[in]	refPoint		Reference point respect to which to determine the distance of individual particles.
+		 *								In world space.
+		 * @param[in]	instances		Per-instance data of individual particles.
+		 * @param[out]	indices			Index buffer that will be sorted according to the particle distance, in descending
+		 *								order.
+		 */
+		static void sortByDistance(const Vector3& refPoint, const Vector<ParticleMeshInstance>& instances,
+			Vector<UINT32>& indices);
 	private:
 		ParticleTexturePool mTexturePool;
 		Members* m;
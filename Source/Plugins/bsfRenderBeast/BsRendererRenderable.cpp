@@ -3,36 +3,157 @@
 #include "BsRendererRenderable.h"
 #include "Renderer/BsRendererUtility.h"
 #include "Mesh/BsMesh.h"
+#include "Material/BsGpuParamsSet.h"
+#include "RenderAPI/BsGpuParams.h"
 #include "Utility/BsBitwise.h"
+#include "Material/BsMaterial.h"
+#include "Material/BsMaterialParams.h"
+#include "Managers/BsTextureStreamingManager.h"
+#include "Math/BsSIMD.h"
+#include "Shading/BsClusterCulling.h"
+#include "Renderer/BsTextureTable.h"
 
 namespace bs { namespace ct
 {
 	PerObjectParamDef gPerObjectParamDef;
 	PerCallParamDef gPerCallParamDef;
+	TextureTableParamDef gTextureTableParamDef;
+
+	const ShaderVariation& getTextureTableVariation(bool indexed)
+	{
+		static ShaderVariation variations[2] =
+		{
+			ShaderVariation(
+			{
+				ShaderVariation::Param("SKINNED", false),
+				ShaderVariation::Param("MORPH", false),
+				ShaderVariation::Param("INSTANCED", true),
+				ShaderVariation::Param("TEXTURE_TABLE", 1),
+			}),
+			ShaderVariation(
+			{
+				ShaderVariation::Param("SKINNED", false),
+				ShaderVariation::Param("MORPH", false),
+				ShaderVariation::Param("INSTANCED", true),
+				ShaderVariation::Param("TEXTURE_TABLE", 2),
+			})
+		};
+
+		return variations[indexed ? 1 : 0];
+	}
 
 	void PerObjectBuffer::update(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm, const Matrix4& tfrmNoScale,
 		UINT32 layer)
 	{
 		gPerObjectParamDef.gMatWorld.set(buffer, tfrm);
-		gPerObjectParamDef.gMatInvWorld.set(buffer, tfrm.inverseAffine());
+		Matrix4 invTfrm, invTfrmNoScale;
+		simd::inverseAffine(tfrm, invTfrm);
+		simd::inverseAffine(tfrmNoScale, invTfrmNoScale);
+
+		gPerObjectParamDef.gMatInvWorld.set(buffer, invTfrm);
 		gPerObjectParamDef.gMatWorldNoScale.set(buffer, tfrmNoScale);
-		gPerObjectParamDef.gMatInvWorldNoScale.set(buffer, tfrmNoScale.inverseAffine());
+		gPerObjectParamDef.gMatInvWorldNoScale.set(buffer, invTfrmNoScale);
 		gPerObjectParamDef.gWorldDeterminantSign.set(buffer, tfrm.determinant3x3() >= 0.0f ? 1.0f : -1.0f);
 		gPerObjectParamDef.gLayer.set(buffer, (INT32)layer);
 	}
 
-	void RenderableElement::draw() const
+	void RenderableElement::draw(const SPtr<CommandBuffer>& commandBuffer) const
 	{
-		if (morphVertexDeclaration == nullptr)
-			gRendererUtility().draw(mesh, subMesh);
+		// Skinned vertices are bound to the same stream as morph shape vertices, replacing the mesh's own
+		if (skinnedVertexDeclaration != nullptr)
+		{
+			gRendererUtility().drawMorph(mesh, subMesh, skinnedVertexBuffer, skinnedVertexDeclaration,
+				commandBuffer);
+		}
+		else if (morphVertexDeclaration == nullptr)
+		{
+			if (clustersCulled)
+			{
+				gRendererUtility().drawIndirect(mesh, subMesh.drawOp, clusters->drawArgs, 0, clusters->numClusters,
+					commandBuffer);
+			}
+			else
+				gRendererUtility().draw(mesh, subMesh, 1, commandBuffer);
+		}
 		else
-			gRendererUtility().drawMorph(mesh, subMesh, morphShapeBuffer, morphVertexDeclaration);
+			gRendererUtility().drawMorph(mesh, subMesh, morphShapeBuffer, morphVertexDeclaration, commandBuffer);
+	}
+
+	void InstancedRenderableElement::bindInstanceData() const
+	{
+		SPtr<GpuParams> gpuParams = params->getGpuParams();
+		gpuParams->setParamBlockBuffer("PerObject", perObjectParamBuffer);
+		gpuParams->setParamBlockBuffer("PerCall", perCallParamBuffer);
+
+		for(UINT32 i = 0; i < GPT_COUNT; i++)
+		{
+			const GpuParamBinding& binding = instancing->perCameraBindings[i];
+			if(binding.slot != (UINT32)-1)
+				gpuParams->setParamBlockBuffer(binding.set, binding.slot, perCameraParamBuffer);
+		}
+
+		instancing->instanceDataParam.set(instanceBuffer);
+		instancing->objectDataParam.set(objectDataBuffer);
+
+		// Pages can be re-created as the table grows, so they are looked up on every bind
+		const TextureTable& textureTable = TextureTable::instance();
+		if (instancing->textureTable && !textureTable.isIndexed())
+		{
+			for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+				instancing->texturePageParams[i].set(textureTable.getPageTexture(textureIndices[i]));
+		}
+	}
+
+	void InstancedRenderableElement::draw(const SPtr<CommandBuffer>& commandBuffer) const
+	{
+		gRendererUtility().draw(mesh, subMesh, numInstances, commandBuffer);
 	}
 
 	RendererRenderable::RendererRenderable()
 	{
 		perObjectParamBuffer = gPerObjectParamDef.createBuffer();
 		perCallParamBuffer = gPerCallParamDef.createBuffer();
+
+		for (auto& entry : textureOverrides)
+			entry = TextureTable::INVALID_INDEX;
+	}
+
+	void RendererRenderable::setLOD(UINT32 lod)
+	{
+		if (this->lod == lod)
+			return;
+
+		this->lod = lod;
+
+		// Elements are created one per sub-mesh, in sub-mesh order
+		const auto numElements = (UINT32)elements.size();
+		for (UINT32 i = 0; i < numElements; i++)
+		{
+			const MeshProperties& meshProps = elements[i].mesh->getProperties();
+			elements[i].subMesh = meshProps.getSubMesh(i, lod);
+		}
+	}
+
+	void RendererRenderable::requestStreamedMips() const
+	{
+		for (auto& element : elements)
+		{
+			const SPtr<MaterialParams> params = element.material->_getInternalParams();
+			if (params == nullptr)
+				continue;
+
+			const UINT32 numTextures = params->getNumTextureParams();
+			for (UINT32 i = 0; i < numTextures; i++)
+			{
+				const SPtr<Texture>& texture = params->getTextureByIndex(i);
+				if (texture == nullptr)
+					continue;
+
+				const SPtr<TextureStreamingData>& streamingData = texture->getStreamingData();
+				if (streamingData != nullptr)
+					streamingData->requestMip(streamingData->getMipForScreenSize(screenPixelSize));
+			}
+		}
 	}
 
 	void RendererRenderable::updatePerObjectBuffer()
@@ -46,7 +167,8 @@ namespace bs { namespace ct
 
 	void RendererRenderable::updatePerCallBuffer(const Matrix4& viewProj, bool flush)
 	{
-		const Matrix4 worldViewProjMatrix = viewProj * renderable->getMatrix();
+		Matrix4 worldViewProjMatrix;
+		simd::multiply(viewProj, renderable->getMatrix(), worldViewProjMatrix);
 
 		gPerCallParamDef.gMatWorldViewProj.set(perCallParamBuffer, worldViewProjMatrix);
 
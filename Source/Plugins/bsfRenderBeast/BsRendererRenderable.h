@@ -9,9 +9,13 @@
 #include "Material/BsMaterialParam.h"
 #include "RenderAPI/BsGpuPipelineParamInfo.h"
 #include "BsRendererReflectionProbe.h"
+#include "Utility/BsOctree.h"
 
 namespace bs { namespace ct
 {
+	struct SkinnedVertexCache;
+	struct ClusterCullData;
+
 	/** @addtogroup RenderBeast
 	 *  @{
 	 */
@@ -33,6 +37,21 @@ namespace bs { namespace ct
 
 	extern PerCallParamDef gPerCallParamDef;
 
+	BS_PARAM_BLOCK_BEGIN(TextureTableParamDef)
+		BS_PARAM_BLOCK_ENTRY(Vector4I, gMaterialTextureIndices)
+	BS_PARAM_BLOCK_END
+
+	extern TextureTableParamDef gTextureTableParamDef;
+
+	/** 
+	 * Returns the shader variation used for drawing multiple instances of a static mesh at once, with the standard
+	 * surface textures read from the texture table.
+	 *
+	 * @param[in]	indexed		True to read the textures from a descriptor-indexed table, false to read them from the
+	 *							texture array pages. See TextureTable::isIndexed().
+	 */
+	const ShaderVariation& getTextureTableVariation(bool indexed);
+
 	/** Helper class used for manipulating the PerObject parameter buffer. */
 	class PerObjectBuffer
 	{
@@ -44,6 +63,58 @@ namespace bs { namespace ct
 
 	struct MaterialSamplerOverrides;
 
+	/** 
+	 * Material parameters used for drawing multiple instances of static renderables in a single draw call. Shared by all
+	 * render elements using the same material.
+	 */
+	struct InstancedMaterialParams
+	{
+		/** Index of the material technique that supports instanced rendering. */
+		UINT32 techniqueIdx = (UINT32)-1;
+
+		/** GPU parameters used by all instanced draws using the material. */
+		SPtr<GpuParamsSet> params;
+
+		/** Binding indices representing where should the per-camera param block buffer be bound to. */
+		GpuParamBinding perCameraBindings[GPT_COUNT];
+
+		/** Parameter that receives the buffer containing per-instance data. */
+		GpuParamBuffer instanceDataParam;
+
+		/** Parameter that receives the buffer containing per-object data of all renderables. */
+		GpuParamBuffer objectDataParam;
+
+		/** Optional overrides for material sampler states. See RenderableElement::samplerOverrides. */
+		MaterialSamplerOverrides* samplerOverrides = nullptr;
+
+		/** 
+		 * True if the technique reads the standard surface textures through the texture table, in which case
+		 * renderables with different texture overrides can be drawn together. See Renderable::setTextureOverride().
+		 */
+		bool textureTable = false;
+
+		/** Material textures registered with the texture table, for each RenderableTexture slot. */
+		SPtr<Texture> textures[(UINT32)RenderableTexture::Count];
+
+		/** Index of each of @p textures in the texture table. */
+		UINT32 textureIndices[(UINT32)RenderableTexture::Count];
+
+		/** Buffer providing @p textureIndices to the shader. */
+		SPtr<GpuParamBlockBuffer> textureTableParamBuffer;
+
+		/** Parameters receiving the texture table page of each slot. Only used if the table isn't indexed. */
+		GpuParamTexture texturePageParams[(UINT32)RenderableTexture::Count];
+
+		/** 
+		 * False if the material's latest textures couldn't be registered with the texture table, in which case elements
+		 * using the parameters are drawn individually until they can be.
+		 */
+		bool texturesRegistered = true;
+
+		/** Number of render elements using the parameters. */
+		UINT32 refCount = 0;
+	};
+
 	/**
 	 * Contains information required for rendering a single Renderable sub-mesh, representing a generic static or animated
 	 * 3D model.
@@ -81,14 +152,85 @@ namespace bs { namespace ct
 		/** Vertex declaration used for rendering meshes containing morph shape information. */
 		SPtr<VertexDeclaration> morphVertexDeclaration;
 
+		/** 
+		 * Vertex buffer containing element's vertices skinned in a compute shader, if the renderable is pre-skinned. In
+		 * that case the element is rendered as a static mesh and #animType is None.
+		 */
+		SPtr<VertexBuffer> skinnedVertexBuffer;
+
+		/** Vertex declaration used for rendering the mesh using the vertices in #skinnedVertexBuffer. */
+		SPtr<VertexDeclaration> skinnedVertexDeclaration;
+
 		/** Time to used for evaluating material animation. */
 		float materialAnimationTime = 0.0f;
 
 		/** Version of the morph shape vertices in the buffer. */
 		mutable UINT32 morphShapeVersion;
 
+		/** 
+		 * Parameters used for rendering the element together with other elements using the same mesh and material. Null
+		 * if the element doesn't support instanced rendering.
+		 */
+		InstancedMaterialParams* instancing = nullptr;
+
+		/**
+		 * Meshlets of the element's sub-mesh, culled on the GPU before the element is drawn. Null if the mesh has no
+		 * meshlets or the element is rendered in a way that doesn't support per-meshlet draws.
+		 */
+		SPtr<ClusterCullData> clusters;
+
+		/**
+		 * True if #clusters were culled against the view currently being rendered, in which case only the visible
+		 * meshlets are drawn. Otherwise the entire sub-mesh is drawn.
+		 */
+		mutable bool clustersCulled = false;
+
+		/** @copydoc RenderElement::draw */
+		void draw(const SPtr<CommandBuffer>& commandBuffer = nullptr) const override;
+	};
+
+	/** 
+	 * Render element that draws multiple static renderables, sharing the same sub-mesh and material, in a single draw
+	 * call using instanced rendering.
+	 */
+	class InstancedRenderableElement final : public RenderElement
+	{
+	public:
+		/** Shared material parameters the element is rendered with. */
+		InstancedMaterialParams* instancing = nullptr;
+
+		/** Buffer containing the index of each instance's renderable within @p objectDataBuffer. */
+		SPtr<GpuBuffer> instanceBuffer;
+
+		/** Buffer containing per-object data of all renderables in the scene. See ObjectDataBuffer. */
+		SPtr<GpuBuffer> objectDataBuffer;
+
+		/** Per-object parameters of the first instance, providing values not stored per instance (e.g. layer). */
+		SPtr<GpuParamBlockBuffer> perObjectParamBuffer;
+
+		/** Per-call parameters of the first instance. */
+		SPtr<GpuParamBlockBuffer> perCallParamBuffer;
+
+		/** Per-camera parameters of the view the element is rendered from. */
+		SPtr<GpuParamBlockBuffer> perCameraParamBuffer;
+
+		/** Number of instances to draw. */
+		UINT32 numInstances = 0;
+
+		/** 
+		 * Texture table index of the first instance's texture in each RenderableTexture slot. Determines which texture
+		 * table pages are bound, if the technique uses the texture table and the table isn't indexed.
+		 */
+		UINT32 textureIndices[(UINT32)RenderableTexture::Count];
+
+		/** 
+		 * Assigns the element's buffers to the shared material parameters. Must be called before the parameters are bound
+		 * for rendering.
+		 */
+		void bindInstanceData() const;
+
 		/** @copydoc RenderElement::draw */
-		void draw() const override;
+		void draw(const SPtr<CommandBuffer>& commandBuffer = nullptr) const override;
 	};
 
 	 /** Contains information about a Renderable, used by the Renderer. */
@@ -107,12 +249,76 @@ namespace bs { namespace ct
 		 */
 		void updatePerCallBuffer(const Matrix4& viewProj, bool flush = true);
 
+		/** 
+		 * Switches all elements to render the sub-meshes of the specified level of detail of the renderable's mesh. LOD
+		 * is clamped to the number of levels available in the mesh.
+		 */
+		void setLOD(UINT32 lod);
+
+		/**
+		 * Requests the mip levels of streamed textures used by the elements' materials, according to the current size of
+		 * the renderable on screen.
+		 */
+		void requestStreamedMips() const;
+
 		Renderable* renderable;
 		Vector<RenderableElement> elements;
 
 		SPtr<GpuParamBlockBuffer> perObjectParamBuffer;
 		SPtr<GpuParamBlockBuffer> perCallParamBuffer;
+
+		/** Identifier of the renderable in the scene octree. */
+		OctreeElementId octreeId;
+
+		/** 
+		 * True if the renderable can never move nor animate, in which case it is rendered into cached static shadow maps
+		 * instead of being redrawn every frame.
+		 */
+		bool isStaticShadowCaster = false;
+
+		/** Level of detail of the mesh currently used by the elements. */
+		UINT32 lod = 0;
+
+		/**
+		 * Texture table index of each of the renderable's texture overrides, or TextureTable::INVALID_INDEX if the slot
+		 * isn't overridden. See Renderable::setTextureOverride().
+		 */
+		UINT32 textureOverrides[(UINT32)RenderableTexture::Count];
+
+		/** 
+		 * Vertices skinned once per frame in a compute shader and shared by all passes drawing the renderable. Null if
+		 * the renderable isn't skinned or is skinned in the vertex shader.
+		 */
+		SPtr<SkinnedVertexCache> skinnedVertices;
+
+		/**
+		 * Size of the renderable's bounds on screen in pixels, as of the last time it was visible. Largest size among
+		 * all the views is used.
+		 */
+		float screenPixelSize = 0.0f;
 	};
 
+	/** Options for the octree used for culling renderables. */
+	struct RenderableOctreeOptions
+	{
+		enum { LoosePadding = 8 };
+		enum { MinElementsPerNode = 8 };
+		enum { MaxElementsPerNode = 16 };
+		enum { MaxDepth = 12 };
+
+		static simd::AABox getBounds(RendererRenderable* elem, void* context)
+		{
+			return simd::AABox(elem->renderable->getBounds().getBox());
+		}
+
+		static void setElementId(RendererRenderable* elem, const OctreeElementId& id, void* context)
+		{
+			elem->octreeId = id;
+		}
+	};
+
+	/** Spatial hierarchy containing all renderables in a scene, used for accelerating culling. */
+	typedef Octree<RendererRenderable*, RenderableOctreeOptions> RenderableOctree;
+
 	/** @} */
 }}
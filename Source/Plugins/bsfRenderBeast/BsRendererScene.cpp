@@ -11,6 +11,9 @@
 #include "Material/BsPass.h"
 #include "Material/BsGpuParamsSet.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Utility/BsMorphShapeBlend.h"
+#include "Utility/BsComputeSkinning.h"
+#include "Shading/BsClusterCulling.h"
 #include "BsRenderBeastOptions.h"
 #include "BsRenderBeast.h"
 #include "BsRendererDecal.h"
@@ -18,11 +21,156 @@
 #include "Shading/BsGpuParticleSimulation.h"
 #include "Renderer/BsDecal.h"
 #include "Renderer/BsRendererUtility.h"
+#include "Renderer/BsTextureTable.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Profiling/BsProfilerCPU.h"
 
 namespace bs {	namespace ct
 {
 	PerFrameParamDef gPerFrameParamDef;
 
+	/** Extent of the root node of the octree used for culling renderables. */
+	static constexpr float RENDERABLE_OCTREE_EXTENT = 16384.0f;
+
+	/** Maximum number of renderable ID changes kept in SceneInfo::renderableIdChanges. */
+	static constexpr UINT32 MAX_RENDERABLE_ID_CHANGES = 4096;
+
+	/** Maximum number of static shadow caster changes kept in SceneInfo::staticCasterChanges. */
+	static constexpr UINT32 MAX_STATIC_CASTER_CHANGES = 1024;
+
+	/** Number of renderables whose material parameters are evaluated by a single task in prepareRenderables(). */
+	static constexpr UINT32 PREPARE_RENDERABLES_GRAIN_SIZE = 128;
+
+	/**
+	 * Updates animation buffers of a renderable, blends its morph shapes on the GPU if their weights changed, and skins
+	 * its vertices if it's skinned in a compute shader.
+	 */
+	static void updateRenderableAnimation(RendererRenderable& rendererRenderable,
+		const EvaluatedAnimationData& animData)
+	{
+		Renderable& renderable = *rendererRenderable.renderable;
+		renderable.updateAnimationBuffers(animData);
+
+		const MorphShapeGpuBuffers* morphShapeBuffers = renderable.getMorphShapeGpuBuffers();
+		if (renderable.isMorphShapeBlendPending() && morphShapeBuffers != nullptr)
+		{
+			MorphShapeBlendMat::get()->execute(*morphShapeBuffers);
+			renderable._notifyMorphShapesBlended();
+		}
+
+		if (rendererRenderable.skinnedVertices != nullptr)
+			ComputeSkinningMat::get()->execute(*rendererRenderable.skinnedVertices, renderable.getBoneMatrixBuffer());
+	}
+
+	/** Names of the standard surface material textures, for each RenderableTexture slot. */
+	static const char* RENDERABLE_TEXTURE_NAMES[(UINT32)RenderableTexture::Count] =
+		{ "gAlbedoTex", "gNormalTex", "gRoughnessTex", "gMetalnessTex" };
+
+	/** Binds the renderable's texture overrides directly to the element's parameters, for drawing it on its own. */
+	static void applyTextureOverrides(const Renderable& renderable, const RenderableElement& element)
+	{
+		SPtr<GpuParams> gpuParams = element.params->getGpuParams();
+		for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+		{
+			const SPtr<Texture>& texture = renderable.getTextureOverride((RenderableTexture)i);
+			if (texture != nullptr && gpuParams->hasTexture(GPT_FRAGMENT_PROGRAM, RENDERABLE_TEXTURE_NAMES[i]))
+				gpuParams->setTexture(GPT_FRAGMENT_PROGRAM, RENDERABLE_TEXTURE_NAMES[i], texture);
+		}
+	}
+
+	/** 
+	 * Checks can the renderable be drawn using the provided instanced parameters, while still respecting its texture
+	 * overrides.
+	 */
+	static bool supportsTextureOverrides(const RendererRenderable& rendererRenderable,
+		const InstancedMaterialParams& instancing)
+	{
+		for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+		{
+			if (rendererRenderable.renderable->getTextureOverride((RenderableTexture)i) == nullptr)
+				continue;
+
+			if (!instancing.textureTable || rendererRenderable.textureOverrides[i] == TextureTable::INVALID_INDEX)
+				return false;
+		}
+
+		return true;
+	}
+
+	/** Returns the material's texture in the provided RenderableTexture slot, or the shader's default if not set. */
+	static SPtr<Texture> getMaterialTexture(const Material& material, UINT32 slot)
+	{
+		SPtr<Texture> texture;
+		if (material.getShader()->hasTextureParam(RENDERABLE_TEXTURE_NAMES[slot]))
+			texture = material.getTexture(RENDERABLE_TEXTURE_NAMES[slot]);
+
+		if (texture != nullptr)
+			return texture;
+
+		// Defaults used by the standard surface shader
+		switch ((RenderableTexture)slot)
+		{
+		case RenderableTexture::Normal:
+			return Texture::NORMAL;
+		case RenderableTexture::Metalness:
+			return Texture::BLACK;
+		default:
+			return Texture::WHITE;
+		}
+	}
+
+	/** 
+	 * Registers the material's standard surface textures with the texture table if they changed since the last call,
+	 * and provides their indices to the shader. Returns false if any of the textures couldn't be registered, in which
+	 * case the slot keeps its previous texture.
+	 */
+	static bool updateMaterialTextures(const Material& material, InstancedMaterialParams& instancing)
+	{
+		TextureTable& textureTable = TextureTable::instance();
+
+		bool dirty = false;
+		bool registered = true;
+		for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+		{
+			SPtr<Texture> texture = getMaterialTexture(material, i);
+			if (texture == instancing.textures[i])
+				continue;
+
+			const UINT32 index = textureTable.registerTexture(texture);
+			if (index == TextureTable::INVALID_INDEX)
+			{
+				registered = false;
+				continue;
+			}
+
+			textureTable.unregisterTexture(instancing.textureIndices[i]);
+			instancing.textures[i] = texture;
+			instancing.textureIndices[i] = index;
+			dirty = true;
+		}
+
+		if (dirty)
+		{
+			const UINT32* indices = instancing.textureIndices;
+			gTextureTableParamDef.gMaterialTextureIndices.set(instancing.textureTableParamBuffer,
+				Vector4I((INT32)indices[0], (INT32)indices[1], (INT32)indices[2], (INT32)indices[3]));
+			instancing.textureTableParamBuffer->flushToGPU();
+		}
+
+		return registered;
+	}
+
+	/** Releases the material textures registered by updateMaterialTextures(). */
+	static void releaseMaterialTextures(InstancedMaterialParams& instancing)
+	{
+		for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+		{
+			TextureTable::instance().unregisterTexture(instancing.textureIndices[i]);
+			instancing.textureIndices[i] = TextureTable::INVALID_INDEX;
+			instancing.textures[i] = nullptr;
+		}
+	}
+
 	static const ShaderVariation* DECAL_VAR_LOOKUP[2][3] = 
 	{
 		{
@@ -37,14 +185,24 @@ namespace bs {	namespace ct
 		}
 	};
 
+	static const ShaderVariation* CLUSTERED_DECAL_VAR_LOOKUP[3] = 
+	{
+		&getDecalShaderVariation<false, MSAAMode::None, true>(),
+		&getDecalShaderVariation<false, MSAAMode::Single, true>(),
+		&getDecalShaderVariation<false, MSAAMode::Full, true>()
+	};
+
 	RendererScene::RendererScene(const SPtr<RenderBeastOptions>& options)
 		:mOptions(options)
 	{
 		mPerFrameParamBuffer = gPerFrameParamDef.createBuffer();
+		mInfo.renderableOctree = bs_new<RenderableOctree>(Vector3::ZERO, RENDERABLE_OCTREE_EXTENT);
 	}
 
 	RendererScene::~RendererScene()
 	{
+		bs_delete(mInfo.renderableOctree);
+
 		for (auto& entry : mInfo.renderables)
 			bs_delete(entry);
 
@@ -52,6 +210,8 @@ namespace bs {	namespace ct
 			bs_delete(entry);
 
 		assert(mSamplerOverrides.empty());
+		assert(mInstancedMaterials.empty());
+		assert(mClusteredDecalMaterials.empty());
 	}
 
 	void RendererScene::registerCamera(Camera* camera)
@@ -245,11 +405,43 @@ namespace bs {	namespace ct
 
 		mInfo.renderables.push_back(bs_new<RendererRenderable>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableCullInfosSoA.add(mInfo.renderableCullInfos.back());
 
 		RendererRenderable* rendererRenderable = mInfo.renderables.back();
 		rendererRenderable->renderable = renderable;
 		rendererRenderable->updatePerObjectBuffer();
 
+		// Texture overrides are read from the texture table when the renderable is drawn using instancing
+		if (mOptions->textureTable)
+		{
+			for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+			{
+				const SPtr<Texture>& texture = renderable->getTextureOverride((RenderableTexture)i);
+				if (texture != nullptr)
+					rendererRenderable->textureOverrides[i] = TextureTable::instance().registerTexture(texture);
+			}
+		}
+
+		mInfo.renderableObjectData.markDirty(renderableId);
+
+		mInfo.renderableOctree->addElement(rendererRenderable);
+
+		// Non-movable renderables cannot be moved, so unless animated their shadows only change when they are added or
+		// removed
+		rendererRenderable->isStaticShadowCaster = renderable->getCastsShadows() &&
+			renderable->getMobility() != ObjectMobility::Movable &&
+			renderable->getAnimType() == RenderableAnimType::None;
+
+		if(rendererRenderable->isStaticShadowCaster)
+			recordStaticCasterChange(mInfo.renderableCullInfos[renderableId].bounds.getSphere());
+
+		if(renderable->hasDrawDistance())
+			mInfo.numDrawDistanceRenderables++;
+
+		// Skinned renderables can be skinned once per frame in a compute shader, and then drawn as static by all passes
+		if (renderable->getAnimType() == RenderableAnimType::Skinned && mOptions->computeSkinning)
+			rendererRenderable->skinnedVertices = SkinnedVertexCache::create(*renderable);
+
 		SPtr<Mesh> mesh = renderable->getMesh();
 		if (mesh != nullptr)
 		{
@@ -271,6 +463,13 @@ namespace bs {	namespace ct
 				renElement.boneMatrixBuffer = renderable->getBoneMatrixBuffer();
 				renElement.morphVertexDeclaration = renderable->getMorphVertexDeclaration();
 
+				if (rendererRenderable->skinnedVertices != nullptr)
+				{
+					renElement.animType = RenderableAnimType::None;
+					renElement.skinnedVertexBuffer = rendererRenderable->skinnedVertices->output;
+					renElement.skinnedVertexDeclaration = rendererRenderable->skinnedVertices->vertexDeclaration;
+				}
+
 				renElement.material = renderable->getMaterial(i);
 				if (renElement.material == nullptr)
 					renElement.material = renderable->getMaterial(0);
@@ -318,7 +517,7 @@ namespace bs {	namespace ct
 					VAR_LOOKUP[3] = &getVertexInputVariation<true, true>();
 				}
 
-				const ShaderVariation* variation = VAR_LOOKUP[(int)animType];
+				const ShaderVariation* variation = VAR_LOOKUP[(int)renElement.animType];
 
 				FIND_TECHNIQUE_DESC findDesc;
 				findDesc.variation = variation;
@@ -386,6 +585,26 @@ namespace bs {	namespace ct
 
 				// Generate or assign sampler state overrides
 				renElement.samplerOverrides = allocSamplerStateOverrides(renElement);
+
+				// Static renderables using the deferred path can have their meshlets culled on the GPU, or otherwise be
+				// grouped with others and drawn using instancing
+				if(!useForwardRendering && animType == RenderableAnimType::None)
+				{
+					if(mOptions->clusterCulling)
+						renElement.clusters = ClusterCullData::create(mesh, i, technique);
+
+					if(renElement.clusters == nullptr)
+					{
+						renElement.instancing = allocInstancedMaterialParams(renElement.material);
+
+						if(renElement.instancing != nullptr && 
+							!supportsTextureOverrides(*rendererRenderable, *renElement.instancing))
+						{
+							freeInstancedMaterialParams(renElement.material);
+							renElement.instancing = nullptr;
+						}
+					}
+				}
 			}
 		}
 
@@ -427,15 +646,31 @@ namespace bs {	namespace ct
 				element.imageBasedParams.populate(gpuParams, GPT_FRAGMENT_PROGRAM, true, supportsClusteredForward,
 					supportsClusteredForward);
 			}
+
+			if (renderable->hasTextureOverrides())
+				applyTextureOverrides(*renderable, element);
 		}
 	}
 
 	void RendererScene::updateRenderable(Renderable* renderable)
 	{
 		UINT32 renderableId = renderable->getRendererId();
+		RendererRenderable* rendererRenderable = mInfo.renderables[renderableId];
+
+		if(rendererRenderable->isStaticShadowCaster)
+			recordStaticCasterChange(mInfo.renderableCullInfos[renderableId].bounds.getSphere());
 
-		mInfo.renderables[renderableId]->updatePerObjectBuffer();
+		rendererRenderable->updatePerObjectBuffer();
+		mInfo.renderableObjectData.markDirty(renderableId);
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableCullInfosSoA.setBounds(renderableId, mInfo.renderableCullInfos[renderableId].bounds);
+
+		if(rendererRenderable->isStaticShadowCaster)
+			recordStaticCasterChange(mInfo.renderableCullInfos[renderableId].bounds.getSphere());
+
+		// Re-insert so the renderable ends up in the node matching its new bounds
+		mInfo.renderableOctree->removeElement(rendererRenderable->octreeId);
+		mInfo.renderableOctree->addElement(rendererRenderable);
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -450,24 +685,76 @@ namespace bs {	namespace ct
 		{
 			freeSamplerStateOverrides(element);
 			element.samplerOverrides = nullptr;
+
+			if(element.instancing != nullptr)
+			{
+				freeInstancedMaterialParams(element.material);
+				element.instancing = nullptr;
+			}
+
+			element.clusters = nullptr;
 		}
 
+		for (auto& entry : rendererRenderable->textureOverrides)
+		{
+			TextureTable::instance().unregisterTexture(entry);
+			entry = TextureTable::INVALID_INDEX;
+		}
+
+		mInfo.renderableOctree->removeElement(rendererRenderable->octreeId);
+
+		if(rendererRenderable->isStaticShadowCaster)
+			recordStaticCasterChange(mInfo.renderableCullInfos[renderableId].bounds.getSphere());
+
+		if(renderable->hasDrawDistance())
+			mInfo.numDrawDistanceRenderables--;
+
 		if (renderableId != lastRenderableId)
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.renderables[renderableId], mInfo.renderables[lastRenderableId]);
 			std::swap(mInfo.renderableCullInfos[renderableId], mInfo.renderableCullInfos[lastRenderableId]);
+			mInfo.renderableCullInfosSoA.swap(renderableId, lastRenderableId);
 
 			lastRenerable->setRendererId(renderableId);
+			mInfo.renderableObjectData.markDirty(renderableId);
+		}
+
+		// Record the change so systems caching per-renderable data can remap it, instead of discarding it. Only a limited
+		// number of changes is kept, systems that fall further behind need to discard their data.
+		if (mInfo.renderableIdChanges.size() >= MAX_RENDERABLE_ID_CHANGES)
+		{
+			const UINT32 numDiscarded = MAX_RENDERABLE_ID_CHANGES / 2;
+			mInfo.renderableIdChanges.erase(mInfo.renderableIdChanges.begin(),
+				mInfo.renderableIdChanges.begin() + numDiscarded);
+			mInfo.renderableIdChangesVersion += numDiscarded;
 		}
 
+		mInfo.renderableIdChanges.push_back({ renderableId, lastRenderableId });
+		mInfo.renderableIdVersion++;
+
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableCullInfosSoA.removeLast();
 
 		bs_delete(rendererRenderable);
 	}
 
+	void RendererScene::recordStaticCasterChange(const Sphere& bounds)
+	{
+		// Only a limited number of changes is kept, systems that fall further behind need to discard all their data
+		if (mInfo.staticCasterChanges.size() >= MAX_STATIC_CASTER_CHANGES)
+		{
+			const UINT32 numDiscarded = MAX_STATIC_CASTER_CHANGES / 2;
+			mInfo.staticCasterChanges.erase(mInfo.staticCasterChanges.begin(),
+				mInfo.staticCasterChanges.begin() + numDiscarded);
+			mInfo.staticCasterChangesVersion += numDiscarded;
+		}
+
+		mInfo.staticCasterChanges.push_back(bounds);
+	}
+
 	void RendererScene::registerReflectionProbe(ReflectionProbe* probe)
 	{
 		UINT32 probeId = (UINT32)mInfo.reflProbes.size();
@@ -571,6 +858,11 @@ namespace bs {	namespace ct
 		mInfo.lightProbes.updateProbes();
 	}
 
+	void RendererScene::updateSkyAtmosphere()
+	{
+		mInfo.skyAtmosphere.update(mInfo);
+	}
+
 	void RendererScene::registerSkybox(Skybox* skybox)
 	{
 		mInfo.skybox = skybox;
@@ -589,6 +881,7 @@ namespace bs {	namespace ct
 
 		mInfo.particleSystems.push_back(RendererParticles());
 		mInfo.particleSystemCullInfos.push_back(CullInfo(Bounds(), particleSystem->getLayer()));
+		mInfo.particleSystemCullInfosSoA.add(mInfo.particleSystemCullInfos.back());
 
 		RendererParticles& rendererParticles = mInfo.particleSystems.back();
 		rendererParticles.particleSystem = particleSystem;
@@ -766,14 +1059,8 @@ namespace bs {	namespace ct
 				renElement.is3D = false;
 				break;
 			case ParticleRenderMode::Mesh:
-				gpuParams->getTextureParam(GPT_VERTEX_PROGRAM, "gPositionTex",
-					renElement.paramsCPUMesh.positionTexture);
-				gpuParams->getTextureParam(GPT_VERTEX_PROGRAM, "gColorTex",
-					renElement.paramsCPUMesh.colorTexture);
-				gpuParams->getTextureParam(GPT_VERTEX_PROGRAM, "gSizeTex",
-					renElement.paramsCPUMesh.sizeTexture);
-				gpuParams->getTextureParam(GPT_VERTEX_PROGRAM, "gRotationTex",
-					renElement.paramsCPUMesh.rotationTexture);
+				gpuParams->getBufferParam(GPT_VERTEX_PROGRAM, "gMeshInstances",
+					renElement.paramsCPUMesh.instancesBuffer);
 
 				renElement.is3D = true;
 				renElement.mesh = settings.mesh;
@@ -791,7 +1078,9 @@ namespace bs {	namespace ct
 		gpuParams->setParamBlockBuffer("PerObject", rendererParticles.perObjectParamBuffer);
 		gpuParams->setParamBlockBuffer("GpuParticleParams", rendererParticles.gpuParticlesParamBuffer);
 
-		gpuParams->getBufferParam(GPT_VERTEX_PROGRAM, "gIndices", renElement.indicesBuffer);
+		// Mesh particles are stored in draw order in the instance buffer, and don't need an index mapping
+		if (!renElement.is3D)
+			gpuParams->getBufferParam(GPT_VERTEX_PROGRAM, "gIndices", renElement.indicesBuffer);
 
 		gpuParams->getParamInfo()->getBindings(
 			GpuPipelineParamInfoBase::ParamType::ParamBlock,
@@ -916,6 +1205,7 @@ namespace bs {	namespace ct
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.particleSystems[rendererId], mInfo.particleSystems[lastRendererId]);
 			std::swap(mInfo.particleSystemCullInfos[rendererId], mInfo.particleSystemCullInfos[lastRendererId]);
+			mInfo.particleSystemCullInfosSoA.swap(rendererId, lastRendererId);
 
 			lastSystem->setRendererId(rendererId);
 		}
@@ -923,6 +1213,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.particleSystems.erase(mInfo.particleSystems.end() - 1);
 		mInfo.particleSystemCullInfos.erase(mInfo.particleSystemCullInfos.end() - 1);
+		mInfo.particleSystemCullInfosSoA.removeLast();
 	}
 
 	void RendererScene::registerDecal(Decal* decal)
@@ -932,6 +1223,7 @@ namespace bs {	namespace ct
 
 		mInfo.decals.emplace_back();
 		mInfo.decalCullInfos.push_back(CullInfo(decal->getBounds(), decal->getLayer()));
+		mInfo.decalCullInfosSoA.add(mInfo.decalCullInfos.back());
 
 		RendererDecal& rendererDecal = mInfo.decals.back();
 		rendererDecal.decal = decal;
@@ -999,6 +1291,10 @@ namespace bs {	namespace ct
 
 		if (gpuParams->hasTexture(GPT_FRAGMENT_PROGRAM, "gMaskTex"))
 			gpuParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gMaskTex", renElement.maskInputTexture);
+
+		// Clustered rendering relies on the light grid, which is only available with compute shader support
+		if (gRenderBeast()->getFeatureSet() == RenderBeastFeatureSet::Desktop)
+			rendererDecal.clustered = allocClusteredDecalParams(renElement.material);
 	}
 
 	void RendererScene::updateDecal(Decal* decal)
@@ -1007,6 +1303,7 @@ namespace bs {	namespace ct
 
 		mInfo.decals[rendererId].updatePerObjectBuffer();
 		mInfo.decalCullInfos[rendererId].bounds = decal->getBounds();
+		mInfo.decalCullInfosSoA.setBounds(rendererId, mInfo.decalCullInfos[rendererId].bounds);
 	}
 
 	void RendererScene::unregisterDecal(Decal* decal)
@@ -1022,11 +1319,18 @@ namespace bs {	namespace ct
 		freeSamplerStateOverrides(renElement);
 		renElement.samplerOverrides = nullptr;
 
+		if (rendererDecal.clustered != nullptr)
+		{
+			freeClusteredDecalParams(renElement.material);
+			rendererDecal.clustered = nullptr;
+		}
+
 		if (rendererId != lastDecalId)
 		{
 			// Swap current last element with the one we want to erase
 			std::swap(mInfo.decals[rendererId], mInfo.decals[lastDecalId]);
 			std::swap(mInfo.decalCullInfos[rendererId], mInfo.decalCullInfos[lastDecalId]);
+			mInfo.decalCullInfosSoA.swap(rendererId, lastDecalId);
 
 			lastDecal->setRendererId(rendererId);
 		}
@@ -1034,6 +1338,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.decals.erase(mInfo.decals.end() - 1);
 		mInfo.decalCullInfos.erase(mInfo.decalCullInfos.end() - 1);
+		mInfo.decalCullInfosSoA.removeLast();
 	}
 
 	void RendererScene::setOptions(const SPtr<RenderBeastOptions>& options)
@@ -1041,7 +1346,13 @@ namespace bs {	namespace ct
 		mOptions = options;
 
 		for (auto& entry : mInfo.views)
+		{
 			entry->setStateReductionMode(mOptions->stateReductionMode);
+			entry->setOcclusionCulling(mOptions->occlusionCulling);
+			entry->setInstancing(mOptions->instancing);
+			entry->setClusteredDecals(mOptions->clusteredDecals);
+			entry->setClusterCulling(mOptions->clusterCulling);
+		}
 	}
 
 	RENDERER_VIEW_DESC RendererScene::createViewDesc(Camera* camera) const
@@ -1100,6 +1411,10 @@ namespace bs {	namespace ct
 		viewDesc.projType = camera->getProjectionType();
 
 		viewDesc.stateReduction = mOptions->stateReductionMode;
+		viewDesc.occlusionCulling = mOptions->occlusionCulling;
+		viewDesc.instancing = mOptions->instancing;
+		viewDesc.clusteredDecals = mOptions->clusteredDecals;
+		viewDesc.clusterCulling = mOptions->clusterCulling;
 		viewDesc.sceneCamera = camera;
 
 		return viewDesc;
@@ -1181,6 +1496,39 @@ namespace bs {	namespace ct
 		}
 	}
 
+	/** Assigns overriden sampler states to all samplers in the provided parameters. */
+	static void applySamplerOverrides(const SPtr<Material>& material, const SPtr<GpuParamsSet>& paramsSet,
+		const MaterialSamplerOverrides& overrides)
+	{
+		UINT32 numPasses = material->getNumPasses();
+		for(UINT32 i = 0; i < numPasses; i++)
+		{
+			SPtr<GpuParams> params = paramsSet->getGpuParams(i);
+
+			const UINT32 numStages = 6;
+			for (UINT32 j = 0; j < numStages; j++)
+			{
+				GpuProgramType type = (GpuProgramType)j;
+
+				SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
+				if (paramDesc == nullptr)
+					continue;
+
+				for (auto& samplerDesc : paramDesc->samplers)
+				{
+					UINT32 set = samplerDesc.second.set;
+					UINT32 slot = samplerDesc.second.slot;
+
+					UINT32 overrideIndex = overrides.passes[i].stateOverrides[set][slot];
+					if (overrideIndex == (UINT32)-1)
+						continue;
+
+					params->setSamplerState(set, slot, overrides.overrides[overrideIndex].state);
+				}
+			}
+		}
+	}
+
 	void RendererScene::refreshSamplerOverrides(bool force)
 	{
 		bool anyDirty = false;
@@ -1229,36 +1577,22 @@ namespace bs {	namespace ct
 			{
 				MaterialSamplerOverrides* overrides = element.samplerOverrides;
 				if(overrides != nullptr && overrides->isDirty)
-				{
-					UINT32 numPasses = element.material->getNumPasses();
-					for(UINT32 j = 0; j < numPasses; j++)
-					{
-						SPtr<GpuParams> params = element.params->getGpuParams(j);
-
-						const UINT32 numStages = 6;
-						for (UINT32 k = 0; k < numStages; k++)
-						{
-							GpuProgramType type = (GpuProgramType)k;
-
-							SPtr<GpuParamDesc> paramDesc = params->getParamDesc(type);
-							if (paramDesc == nullptr)
-								continue;
-
-							for (auto& samplerDesc : paramDesc->samplers)
-							{
-								UINT32 set = samplerDesc.second.set;
-								UINT32 slot = samplerDesc.second.slot;
+					applySamplerOverrides(element.material, element.params, *overrides);
+			}
+		}
 
-								UINT32 overrideIndex = overrides->passes[j].stateOverrides[set][slot];
-								if (overrideIndex == (UINT32)-1)
-									continue;
+		for (auto& entry : mInstancedMaterials)
+		{
+			MaterialSamplerOverrides* overrides = entry.second->samplerOverrides;
+			if(overrides != nullptr && overrides->isDirty)
+				applySamplerOverrides(entry.first, entry.second->params, *overrides);
+		}
 
-								params->setSamplerState(set, slot, overrides->overrides[overrideIndex].state);
-							}
-						}
-					}
-				}
-			}
+		for (auto& entry : mClusteredDecalMaterials)
+		{
+			MaterialSamplerOverrides* overrides = entry.second->samplerOverrides;
+			if(overrides != nullptr && overrides->isDirty)
+				applySamplerOverrides(entry.first, entry.second->params, *overrides);
 		}
 
 		for (auto& entry : mSamplerOverrides)
@@ -1270,30 +1604,81 @@ namespace bs {	namespace ct
 		gPerFrameParamDef.gTime.set(mPerFrameParamBuffer, time);
 	}
 
-	void RendererScene::prepareRenderable(UINT32 idx, const FrameInfo& frameInfo)
+	void RendererScene::updateRenderableObjectData()
 	{
-		if (mInfo.renderableReady[idx])
+		// Only used for instanced rendering
+		if (!mOptions->instancing)
 			return;
-		
-		// Note: Before uploading bone matrices perhaps check if they has actually been changed since last frame
-		if(frameInfo.perFrameData.animation != nullptr)
-			mInfo.renderables[idx]->renderable->updateAnimationBuffers(*frameInfo.perFrameData.animation);
-		
-		// Note: Could this step be moved in notifyRenderableUpdated, so it only triggers when material actually gets
-		// changed? Although it shouldn't matter much because if the internal versions keeping track of dirty params.
-		for (auto& element : mInfo.renderables[idx]->elements)
-			element.material->updateParamsSet(element.params, element.materialAnimationTime);
-		
-		mInfo.renderables[idx]->perObjectParamBuffer->flushToGPU();
-		mInfo.renderableReady[idx] = true;
+
+		mInfo.renderableObjectData.update(mInfo.renderables);
+	}
+
+	void RendererScene::prepareRenderables(const Vector<bool>& visibility, const FrameInfo& frameInfo)
+	{
+		const auto numRenderables = (UINT32)mInfo.renderables.size();
+
+		// Material parameters are only written to CPU-side buffers, and each renderable has its own set, so they can be
+		// evaluated in parallel. Mip requests for streamed textures are atomic so they can be made here as well.
+		const auto evaluateMaterialParams = [&](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				if (!visibility[i] || mInfo.renderableReady[i])
+					continue;
+
+				const Renderable& renderable = *mInfo.renderables[i]->renderable;
+				const bool hasTextureOverrides = renderable.hasTextureOverrides();
+				for (auto& element : mInfo.renderables[i]->elements)
+				{
+					element.material->updateParamsSet(element.params, element.materialAnimationTime);
+
+					// Material textures might have been written over the overrides
+					if (hasTextureOverrides)
+						applyTextureOverrides(renderable, element);
+				}
+
+				mInfo.renderables[i]->requestStreamedMips();
+			}
+		};
+
+		PROFILE_CALL(TaskScheduler::instance().parallelFor(numRenderables, PREPARE_RENDERABLES_GRAIN_SIZE,
+			evaluateMaterialParams), "Evaluate material params")
+
+		// Buffers are uploaded to the GPU from this thread only
+		for (UINT32 i = 0; i < numRenderables; i++)
+		{
+			if (!visibility[i] || mInfo.renderableReady[i])
+				continue;
+
+			// Note: Before uploading bone matrices perhaps check if they has actually been changed since last frame
+			if(frameInfo.perFrameData.animation != nullptr)
+				updateRenderableAnimation(*mInfo.renderables[i], *frameInfo.perFrameData.animation);
+
+			mInfo.renderables[i]->perObjectParamBuffer->flushToGPU();
+			mInfo.renderableReady[i] = true;
+		}
 	}
 
 	void RendererScene::prepareDecal(UINT32 idx, const FrameInfo& frameInfo)
 	{
+		if (mInfo.decalReady[idx])
+			return;
+
 		DecalRenderElement& renElement = mInfo.decals[idx].renderElement;
 		renElement.material->updateParamsSet(renElement.params, renElement.materialAnimationTime);
 		
 		mInfo.decals[idx].perObjectParamBuffer->flushToGPU();
+		mInfo.decalReady[idx] = true;
+	}
+
+	void RendererScene::prepareDecals(const Vector<bool>& visibility, const FrameInfo& frameInfo)
+	{
+		const auto numDecals = (UINT32)mInfo.decals.size();
+		for (UINT32 i = 0; i < numDecals; i++)
+		{
+			if (visibility[i])
+				prepareDecal(i, frameInfo);
+		}
 	}
 
 	void RendererScene::updateParticleSystemBounds(const ParticlePerFrameData* particleRenderData)
@@ -1317,13 +1702,20 @@ namespace bs {	namespace ct
 				worldAABox.transformAffine(entry.localToWorld);
 
 			const Sphere worldSphere(worldAABox.getCenter(), worldAABox.getRadius());
-			mInfo.particleSystemCullInfos[rendererId] = Bounds(worldAABox, worldSphere);
+			mInfo.particleSystemCullInfos[rendererId].bounds = Bounds(worldAABox, worldSphere);
+			mInfo.particleSystemCullInfosSoA.setBounds(rendererId, mInfo.particleSystemCullInfos[rendererId].bounds);
 		}
 	}
 
 	MaterialSamplerOverrides* RendererScene::allocSamplerStateOverrides(RenderElement& elem)
 	{
-		SamplerOverrideKey samplerKey(elem.material, elem.techniqueIdx);
+		return allocSamplerStateOverrides(elem.material, elem.techniqueIdx, elem.params);
+	}
+
+	MaterialSamplerOverrides* RendererScene::allocSamplerStateOverrides(const SPtr<Material>& material,
+		UINT32 techniqueIdx, const SPtr<GpuParamsSet>& params)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
 		auto iterFind = mSamplerOverrides.find(samplerKey);
 		if (iterFind != mSamplerOverrides.end())
 		{
@@ -1332,9 +1724,9 @@ namespace bs {	namespace ct
 		}
 		else
 		{
-			SPtr<Shader> shader = elem.material->getShader();
+			SPtr<Shader> shader = material->getShader();
 			MaterialSamplerOverrides* samplerOverrides = SamplerOverrideUtility::generateSamplerOverrides(shader,
-				elem.material->_getInternalParams(), elem.params, mOptions);
+				material->_getInternalParams(), params, mOptions);
 
 			mSamplerOverrides[samplerKey] = samplerOverrides;
 
@@ -1345,7 +1737,12 @@ namespace bs {	namespace ct
 
 	void RendererScene::freeSamplerStateOverrides(RenderElement& elem)
 	{
-		SamplerOverrideKey samplerKey(elem.material, elem.techniqueIdx);
+		freeSamplerStateOverrides(elem.material, elem.techniqueIdx);
+	}
+
+	void RendererScene::freeSamplerStateOverrides(const SPtr<Material>& material, UINT32 techniqueIdx)
+	{
+		SamplerOverrideKey samplerKey(material, techniqueIdx);
 
 		auto iterFind = mSamplerOverrides.find(samplerKey);
 		assert(iterFind != mSamplerOverrides.end());
@@ -1358,4 +1755,228 @@ namespace bs {	namespace ct
 			mSamplerOverrides.erase(iterFind);
 		}
 	}
+
+	InstancedMaterialParams* RendererScene::allocInstancedMaterialParams(const SPtr<Material>& material)
+	{
+		auto iterFind = mInstancedMaterials.find(material);
+		if (iterFind != mInstancedMaterials.end())
+		{
+			iterFind->second->refCount++;
+			return iterFind->second;
+		}
+
+		auto instancing = bs_new<InstancedMaterialParams>();
+		for (auto& entry : instancing->textureIndices)
+			entry = TextureTable::INVALID_INDEX;
+
+		// Prefer reading the textures through the texture table, so renderables with different texture overrides can be
+		// drawn together. Fall back to binding them directly if the shader doesn't support the table, or the textures
+		// can't be stored in it.
+		bool initialized = false;
+		if (mOptions->textureTable)
+		{
+			const ShaderVariation& variation = getTextureTableVariation(TextureTable::instance().isIndexed());
+			initialized = initInstancedMaterialParams(material, variation, true, *instancing);
+		}
+
+		if (!initialized)
+			initialized = initInstancedMaterialParams(material, getInstancedVertexInputVariation(), false, *instancing);
+
+		if (!initialized)
+		{
+			bs_delete(instancing);
+			return nullptr;
+		}
+
+		instancing->samplerOverrides = allocSamplerStateOverrides(material, instancing->techniqueIdx, 
+			instancing->params);
+		instancing->refCount++;
+
+		mInstancedMaterials[material] = instancing;
+		return instancing;
+	}
+
+	bool RendererScene::initInstancedMaterialParams(const SPtr<Material>& material, const ShaderVariation& variation,
+		bool textureTable, InstancedMaterialParams& instancing)
+	{
+		FIND_TECHNIQUE_DESC findDesc;
+		findDesc.variation = &variation;
+		findDesc.override = true;
+
+		const UINT32 techniqueIdx = material->findTechnique(findDesc);
+		if (techniqueIdx == (UINT32)-1)
+			return false;
+
+		const SPtr<Technique>& technique = material->getTechnique(techniqueIdx);
+		if (technique)
+			technique->compile();
+
+		SPtr<GpuParamsSet> params = material->createParamsSet(techniqueIdx);
+		SPtr<GpuParams> gpuParams = params->getGpuParams();
+
+		// Custom shaders might provide the variation without reading the instance data
+		if (!gpuParams->hasBuffer(GPT_VERTEX_PROGRAM, "gInstanceData") || 
+			!gpuParams->hasBuffer(GPT_VERTEX_PROGRAM, "gObjectData"))
+			return false;
+
+		if (textureTable)
+		{
+			// Shaders without texture table support ignore the variation parameter
+			if (!gpuParams->hasParamBlock(GPT_FRAGMENT_PROGRAM, "TextureTableParams"))
+				return false;
+
+			instancing.textureTableParamBuffer = gTextureTableParamDef.createBuffer();
+			if (!updateMaterialTextures(*material, instancing))
+			{
+				releaseMaterialTextures(instancing);
+				instancing.textureTableParamBuffer = nullptr;
+				return false;
+			}
+		}
+
+		material->updateParamsSet(params, 0.0f, true);
+		gpuParams->setParamBlockBuffer("PerFrame", mPerFrameParamBuffer);
+
+		if (textureTable)
+		{
+			gpuParams->setParamBlockBuffer("TextureTableParams", instancing.textureTableParamBuffer);
+
+			if (!TextureTable::instance().isIndexed())
+			{
+				for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+				{
+					const String name = "gTextureTablePage" + toString(i);
+					gpuParams->getTextureParam(GPT_FRAGMENT_PROGRAM, name, instancing.texturePageParams[i]);
+				}
+			}
+		}
+
+		instancing.techniqueIdx = techniqueIdx;
+		instancing.params = params;
+		instancing.textureTable = textureTable;
+
+		gpuParams->getParamInfo()->getBindings(
+			GpuPipelineParamInfoBase::ParamType::ParamBlock,
+			"PerCamera",
+			instancing.perCameraBindings
+		);
+
+		gpuParams->getBufferParam(GPT_VERTEX_PROGRAM, "gInstanceData", instancing.instanceDataParam);
+		gpuParams->getBufferParam(GPT_VERTEX_PROGRAM, "gObjectData", instancing.objectDataParam);
+		return true;
+	}
+
+	void RendererScene::updateInstancedMaterialTextures()
+	{
+		if (!mOptions->instancing)
+			return;
+
+		for (auto& entry : mInstancedMaterials)
+		{
+			InstancedMaterialParams& instancing = *entry.second;
+			if (instancing.textureTable)
+				instancing.texturesRegistered = updateMaterialTextures(*entry.first, instancing);
+		}
+	}
+
+	void RendererScene::freeInstancedMaterialParams(const SPtr<Material>& material)
+	{
+		auto iterFind = mInstancedMaterials.find(material);
+		assert(iterFind != mInstancedMaterials.end());
+
+		InstancedMaterialParams* instancing = iterFind->second;
+		instancing->refCount--;
+		if (instancing->refCount == 0)
+		{
+			freeSamplerStateOverrides(material, instancing->techniqueIdx);
+			releaseMaterialTextures(*instancing);
+			bs_delete(instancing);
+			mInstancedMaterials.erase(iterFind);
+		}
+	}
+
+	ClusteredDecalMaterialParams* RendererScene::allocClusteredDecalParams(const SPtr<Material>& material)
+	{
+		auto iterFind = mClusteredDecalMaterials.find(material);
+		if (iterFind != mClusteredDecalMaterials.end())
+		{
+			iterFind->second->refCount++;
+			return iterFind->second;
+		}
+
+		UINT32 techniqueIndices[3];
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			FIND_TECHNIQUE_DESC findDesc;
+			findDesc.variation = CLUSTERED_DECAL_VAR_LOOKUP[i];
+			findDesc.override = true;
+
+			techniqueIndices[i] = material->findTechnique(findDesc);
+			if (techniqueIndices[i] == (UINT32)-1)
+				return nullptr;
+		}
+
+		// Note: Same as with individually rendered decals, all variations are assumed to share the same parameter set
+		SPtr<GpuParamsSet> params = material->createParamsSet(techniqueIndices[0]);
+		SPtr<GpuParams> gpuParams = params->getGpuParams();
+
+		// Custom shaders might not provide the clustered variation, in which case a different one gets found
+		if (!gpuParams->hasBuffer(GPT_FRAGMENT_PROGRAM, "gDecalData") ||
+			!gpuParams->hasBuffer(GPT_FRAGMENT_PROGRAM, "gDecalOffsetsAndSize") ||
+			!gpuParams->hasBuffer(GPT_FRAGMENT_PROGRAM, "gDecalIndices"))
+			return nullptr;
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			const SPtr<Technique>& technique = material->getTechnique(techniqueIndices[i]);
+			if (technique)
+				technique->compile();
+		}
+
+		material->updateParamsSet(params, 0.0f, true);
+		gpuParams->setParamBlockBuffer("PerFrame", mPerFrameParamBuffer);
+
+		auto clustered = bs_new<ClusteredDecalMaterialParams>();
+		for(UINT32 i = 0; i < 3; i++)
+			clustered->techniqueIndices[i] = techniqueIndices[i];
+
+		clustered->params = params;
+
+		gpuParams->getParamInfo()->getBindings(
+			GpuPipelineParamInfoBase::ParamType::ParamBlock,
+			"PerCamera",
+			clustered->perCameraBindings
+		);
+
+		gpuParams->getBufferParam(GPT_FRAGMENT_PROGRAM, "gDecalData", clustered->decalDataParam);
+		gpuParams->getBufferParam(GPT_FRAGMENT_PROGRAM, "gDecalOffsetsAndSize", clustered->decalOffsetsAndSizeParam);
+		gpuParams->getBufferParam(GPT_FRAGMENT_PROGRAM, "gDecalIndices", clustered->decalIndicesParam);
+
+		if (gpuParams->hasTexture(GPT_FRAGMENT_PROGRAM, "gDepthBufferTex"))
+			gpuParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gDepthBufferTex", clustered->depthInputTexture);
+
+		if (gpuParams->hasTexture(GPT_FRAGMENT_PROGRAM, "gMaskTex"))
+			gpuParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gMaskTex", clustered->maskInputTexture);
+
+		clustered->samplerOverrides = allocSamplerStateOverrides(material, techniqueIndices[0], params);
+		clustered->refCount++;
+
+		mClusteredDecalMaterials[material] = clustered;
+		return clustered;
+	}
+
+	void RendererScene::freeClusteredDecalParams(const SPtr<Material>& material)
+	{
+		auto iterFind = mClusteredDecalMaterials.find(material);
+		assert(iterFind != mClusteredDecalMaterials.end());
+
+		ClusteredDecalMaterialParams* clustered = iterFind->second;
+		clustered->refCount--;
+		if (clustered->refCount == 0)
+		{
+			freeSamplerStateOverrides(material, clustered->techniqueIndices[0]);
+			bs_delete(clustered);
+			mClusteredDecalMaterials.erase(iterFind);
+		}
+	}
 }}
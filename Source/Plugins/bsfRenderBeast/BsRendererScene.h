@@ -7,7 +7,10 @@
 #include "BsRendererView.h"
 #include "BsRendererParticles.h"
 #include "Shading/BsLightProbes.h"
+#include "Shading/BsSkyAtmosphere.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Utility/BsObjectDataBuffer.h"
+#include "Utility/BsBitfield.h"
 
 namespace bs 
 { 
@@ -17,6 +20,7 @@ namespace bs
 	namespace ct
 	{
 		struct RendererDecal;
+		struct ClusteredDecalMaterialParams;
 		class Decal;
 		struct FrameInfo;
 
@@ -27,6 +31,22 @@ namespace bs
 	// Limited by max number of array elements in texture for DX11 hardware
 	constexpr UINT32 MaxReflectionCubemaps = 2048 / 6;
 
+	/** 
+	 * Describes how renderable IDs changed when a renderable was removed from the scene. The last renderable is moved
+	 * into the slot of the removed one, so the renderable IDs remain tightly packed.
+	 */
+	struct RenderableIdChange
+	{
+		/** ID of the renderable that was removed. */
+		UINT32 removedId;
+
+		/** 
+		 * Previous ID of the renderable that was moved into the slot of the removed renderable. Equal to @p removedId
+		 * if the removed renderable was the last one.
+		 */
+		UINT32 movedId;
+	};
+
 	/** Contains most scene objects relevant to the renderer. */
 	struct SceneInfo
 	{
@@ -38,6 +58,15 @@ namespace bs
 		// Renderables
 		Vector<RendererRenderable*> renderables;
 		Vector<CullInfo> renderableCullInfos;
+		CullInfoSoA renderableCullInfosSoA;
+		RenderableOctree* renderableOctree = nullptr;
+		UINT32 renderableIdVersion = 0; // Incremented whenever a renderable is removed, potentially changing IDs
+		Vector<RenderableIdChange> renderableIdChanges; // Most recent ID changes, one per version
+		UINT32 renderableIdChangesVersion = 0; // Version at which the first entry in renderableIdChanges was applied
+		ObjectDataBuffer renderableObjectData; // Transforms of all renderables, used for instanced rendering
+		Vector<Sphere> staticCasterChanges; // Bounds of most recently added or removed static shadow casters
+		UINT32 numDrawDistanceRenderables = 0; // Number of renderables only drawn within a range of view distances
+		UINT32 staticCasterChangesVersion = 0; // Version at which the first entry in staticCasterChanges was applied
 
 		// Lights
 		Vector<RendererLight> directionalLights;
@@ -58,17 +87,21 @@ namespace bs
 		// Particles
 		Vector<RendererParticles> particleSystems;
 		Vector<CullInfo> particleSystemCullInfos;
+		CullInfoSoA particleSystemCullInfosSoA;
 
 		// Decals
 		Vector<RendererDecal> decals;
 		Vector<CullInfo> decalCullInfos;
+		CullInfoSoA decalCullInfosSoA;
 
 		// Sky
 		Skybox* skybox = nullptr;
+		SkyAtmosphere skyAtmosphere;
 
 		// Buffers for various transient data that gets rebuilt every frame
 		//// Rebuilt every frame
-		mutable Vector<bool> renderableReady;
+		mutable Bitfield renderableReady;
+		mutable Bitfield decalReady;
 	};
 
 	/** Contains information about the scene (e.g. renderables, lights, cameras) required by the renderer. */
@@ -132,6 +165,12 @@ namespace bs
 		 */
 		void updateLightProbes();
 
+		/** 
+		 * Updates the procedural sky atmosphere of the current skybox, if it has one. Should be called once per frame,
+		 * before rendering.
+		 */
+		void updateSkyAtmosphere();
+
 		/** Registers a new sky texture in the scene. */
 		void registerSkybox(Skybox* skybox);
 
@@ -173,25 +212,47 @@ namespace bs
 		/** Updates global per frame parameter buffers with new values. To be called at the start of every frame. */
 		void setParamFrameParams(float time);
 
+		/** 
+		 * Writes transforms of renderables modified since the last call into the buffer containing per-object data of
+		 * all renderables. To be called at the start of every frame.
+		 */
+		void updateRenderableObjectData();
+
+		/** 
+		 * Registers textures of materials drawn using instancing with the texture table, if they changed since the last
+		 * call. To be called at the start of every frame.
+		 */
+		void updateInstancedMaterialTextures();
+
 		/**
-		 * Performs necessary steps to make a renderable ready for rendering. This must be called at least once every frame
-		 * for every renderable that will be drawn. Multiple calls for the same renderable during a single frame will result
-		 * in a no-op.
-		 * 
-		 * @param[in]	idx			Index of the renderable to prepare.
+		 * Performs necessary steps to make the renderables marked in @p visibility ready for rendering. This must be
+		 * called at least once every frame for every renderable that will be drawn. Renderables already prepared during
+		 * the current frame are skipped. Material parameters are evaluated in parallel, while GPU buffer updates are
+		 * issued from the calling thread.
+		 *
+		 * @param[in]	visibility	One entry per renderable, true if the renderable should be prepared.
 		 * @param[in]	frameInfo	Global information describing the current frame.
 		 */
-		void prepareRenderable(UINT32 idx, const FrameInfo& frameInfo);
+		void prepareRenderables(const Vector<bool>& visibility, const FrameInfo& frameInfo);
 
 		/**
 		 * Performs necessary steps to make a decal ready for rendering. This must be called at least once every frame
-		 * for every decal that will be drawn. 
+		 * for every decal that will be drawn. Multiple calls for the same decal during a single frame will result in a
+		 * no-op.
 		 * 
 		 * @param[in]	idx			Index of the decal to prepare.
 		 * @param[in]	frameInfo	Global information describing the current frame.
 		 */
 		void prepareDecal(UINT32 idx, const FrameInfo& frameInfo);
 
+		/**
+		 * Prepares all decals marked in @p visibility for rendering, same as calling prepareDecal() on each of them.
+		 *
+		 * @param[in]	visibility	One entry per decal, true if the decal should be prepared.
+		 * @param[in]	frameInfo	Global information describing the current frame.
+		 */
+		void prepareDecals(const Vector<bool>& visibility, const FrameInfo& frameInfo);
+
 		/** Updates the bounds for all the particle systems from the provided object. */
 		void updateParticleSystemBounds(const ParticlePerFrameData* particleRenderData);
 
@@ -207,18 +268,69 @@ namespace bs
 		 */
 		void updateCameraRenderTargets(Camera* camera, bool remove = false);
 
+		/** 
+		 * Records that a static shadow caster with the provided bounds was added or removed, so shadow maps caching static
+		 * geometry can be invalidated.
+		 */
+		void recordStaticCasterChange(const Sphere& bounds);
+
 		/** 
 		 * Allocates (or returns existing) set of sampler state overrides that can be used for the provided render 
 		 * element. 
 		 */
 		MaterialSamplerOverrides* allocSamplerStateOverrides(RenderElement& elem);
 
+		/** 
+		 * Allocates (or returns existing) set of sampler state overrides that can be used for the provided material
+		 * technique and its parameters.
+		 */
+		MaterialSamplerOverrides* allocSamplerStateOverrides(const SPtr<Material>& material, UINT32 techniqueIdx,
+			const SPtr<GpuParamsSet>& params);
+
 		/** Frees sampler state overrides previously allocated with allocSamplerStateOverrides(). */
 		void freeSamplerStateOverrides(RenderElement& elem);
 
+		/** Frees sampler state overrides previously allocated with allocSamplerStateOverrides(). */
+		void freeSamplerStateOverrides(const SPtr<Material>& material, UINT32 techniqueIdx);
+
+		/** 
+		 * Allocates (or returns existing) set of parameters used for instanced rendering with the provided material.
+		 * Returns null if the material doesn't support instanced rendering.
+		 */
+		InstancedMaterialParams* allocInstancedMaterialParams(const SPtr<Material>& material);
+
+		/** 
+		 * Initializes parameters used for instanced rendering with the material technique matching the provided
+		 * variation. Returns false if the material doesn't provide such a technique, or it doesn't support instanced
+		 * rendering.
+		 *
+		 * @param[in]	material		Material to render with.
+		 * @param[in]	variation		Shader variation to look for.
+		 * @param[in]	textureTable	True if the technique should read the standard surface textures through the
+		 *								texture table. Fails if the technique doesn't support it, or the material
+		 *								textures cannot be registered with the table.
+		 * @param[out]	instancing		Parameters to initialize.
+		 */
+		bool initInstancedMaterialParams(const SPtr<Material>& material, const ShaderVariation& variation,
+			bool textureTable, InstancedMaterialParams& instancing);
+
+		/** Frees parameters previously allocated with allocInstancedMaterialParams(). */
+		void freeInstancedMaterialParams(const SPtr<Material>& material);
+
+		/** 
+		 * Allocates (or returns existing) set of parameters used for clustered decal rendering with the provided
+		 * material. Returns null if the material doesn't support clustered rendering.
+		 */
+		ClusteredDecalMaterialParams* allocClusteredDecalParams(const SPtr<Material>& material);
+
+		/** Frees parameters previously allocated with allocClusteredDecalParams(). */
+		void freeClusteredDecalParams(const SPtr<Material>& material);
+
 		SceneInfo mInfo;
 		SPtr<GpuParamBlockBuffer> mPerFrameParamBuffer;
 		UnorderedMap<SamplerOverrideKey, MaterialSamplerOverrides*> mSamplerOverrides;
+		UnorderedMap<SPtr<Material>, InstancedMaterialParams*> mInstancedMaterials;
+		UnorderedMap<SPtr<Material>, ClusteredDecalMaterialParams*> mClusteredDecalMaterials;
 
 		SPtr<RenderBeastOptions> mOptions;
 	};
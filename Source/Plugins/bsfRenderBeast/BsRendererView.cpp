@@ -5,11 +5,20 @@
 #include "Renderer/BsRenderable.h"
 #include "Renderer/BsRendererUtility.h"
 #include "Material/BsMaterial.h"
+#include "Mesh/BsMesh.h"
 #include "Material/BsShader.h"
 #include "Material/BsGpuParamsSet.h"
 #include "BsRendererLight.h"
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
+#include "BsRenderBeastOptions.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsCommandBuffer.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "RenderAPI/BsTimerQuery.h"
+#include "Renderer/BsTextureTable.h"
 #include <BsRendererDecal.h>
 
 namespace bs { namespace ct
@@ -17,6 +26,77 @@ namespace bs { namespace ct
 	PerCameraParamDef gPerCameraParamDef;
 	SkyboxParamDef gSkyboxParamDef;
 
+	/** Minimum number of renderables sharing the same sub-mesh and material required to draw them using instancing. */
+	static constexpr UINT32 MIN_INSTANCES_PER_DRAW = 2;
+
+	/** Instance buffers are allocated with capacity rounded up to a multiple of this many instances. */
+	static constexpr UINT32 INSTANCE_BUFFER_INCREMENT = 64;
+
+	/** 
+	 * Minimum number of visible decals sharing the same material required to apply them in a single clustered pass. The
+	 * pass covers the entire view so it only pays off over individual decal volumes once there's enough decals.
+	 */
+	static constexpr UINT32 MIN_DECALS_PER_CLUSTERED_PASS = 4;
+
+	/** Buffers used for clustered decals are allocated with capacity rounded up to a multiple of this many entries. */
+	static constexpr UINT32 CLUSTERED_DECAL_BUFFER_INCREMENT = 256;
+
+	/** Granularity of the render scale used for dynamic resolution, so internal textures aren't resized every frame. */
+	static constexpr float RENDER_SCALE_STEP = 0.05f;
+
+	/** Fraction of the difference between the current and ideal render scale that is applied per GPU time sample. */
+	static constexpr float RENDER_SCALE_RESPONSE = 0.2f;
+
+	/** Number of different sub-pixel positions the projection is offset by, when temporal anti-aliasing is enabled. */
+	static constexpr UINT32 TEMPORAL_AA_NUM_SAMPLES = 8;
+
+	/** 
+	 * Returns the texture table index of the texture the renderable samples in the provided slot, when drawn using the
+	 * instanced material parameters.
+	 */
+	static UINT32 getTextureIndex(const InstancedMaterialParams& instancing, const RendererRenderable& renderable,
+		UINT32 slot)
+	{
+		if (renderable.textureOverrides[slot] != TextureTable::INVALID_INDEX)
+			return renderable.textureOverrides[slot];
+
+		return instancing.textureIndices[slot];
+	}
+
+	/** Returns the texture table pages an instanced element reads its textures from. See InstanceCandidate. */
+	static UINT64 getTexturePages(const InstancedMaterialParams& instancing, const RendererRenderable& renderable)
+	{
+		const TextureTable& textureTable = TextureTable::instance();
+		if (!instancing.textureTable || textureTable.isIndexed())
+			return 0;
+
+		UINT64 pages = 0;
+		for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+		{
+			const UINT32 index = getTextureIndex(instancing, renderable, i);
+			const UINT64 page = index != TextureTable::INVALID_INDEX ? textureTable.getPage(index) : 0;
+
+			pages |= (page & 0xFFFF) << (i * 16);
+		}
+
+		return pages;
+	}
+
+	/** Returns the element at the specified index of the Halton low-discrepancy sequence with the provided base. */
+	static float haltonSequence(UINT32 index, UINT32 base)
+	{
+		float output = 0.0f;
+		float fraction = 1.0f / base;
+		while (index > 0)
+		{
+			output += (index % base) * fraction;
+			index /= base;
+			fraction /= base;
+		}
+
+		return output;
+	}
+
 	SkyboxMat::SkyboxMat()
 	{
 		if(mParams->hasTexture(GPT_FRAGMENT_PROGRAM, "gSkyTex"))
@@ -48,14 +128,109 @@ namespace bs { namespace ct
 		return get(getVariation<false>());
 	}
 
+	void CullInfoSoA::add(const CullInfo& info)
+	{
+		if (mSize % 4 == 0)
+			mBlocks.push_back(Block());
+
+		const UINT32 idx = mSize++;
+		Block& block = mBlocks[idx / 4];
+		block.layers[0][idx % 4] = (UINT32)(info.layer & 0xFFFFFFFF);
+		block.layers[1][idx % 4] = (UINT32)(info.layer >> 32);
+
+		setBounds(idx, info.bounds);
+	}
+
+	void CullInfoSoA::setBounds(UINT32 idx, const Bounds& bounds)
+	{
+		Block& block = mBlocks[idx / 4];
+		const UINT32 lane = idx % 4;
+
+		const Sphere& sphere = bounds.getSphere();
+		const Vector3& sphereCenter = sphere.getCenter();
+		block.bounds[SphereCenterX][lane] = sphereCenter.x;
+		block.bounds[SphereCenterY][lane] = sphereCenter.y;
+		block.bounds[SphereCenterZ][lane] = sphereCenter.z;
+		block.bounds[SphereRadius][lane] = sphere.getRadius();
+
+		const AABox& box = bounds.getBox();
+		const Vector3 boxCenter = box.getCenter();
+		const Vector3 boxExtents = box.getHalfSize();
+		block.bounds[BoxCenterX][lane] = boxCenter.x;
+		block.bounds[BoxCenterY][lane] = boxCenter.y;
+		block.bounds[BoxCenterZ][lane] = boxCenter.z;
+		block.bounds[BoxExtentX][lane] = Math::abs(boxExtents.x);
+		block.bounds[BoxExtentY][lane] = Math::abs(boxExtents.y);
+		block.bounds[BoxExtentZ][lane] = Math::abs(boxExtents.z);
+	}
+
+	void CullInfoSoA::swap(UINT32 a, UINT32 b)
+	{
+		Block& blockA = mBlocks[a / 4];
+		Block& blockB = mBlocks[b / 4];
+
+		for (UINT32 i = 0; i < BoundsComponentCount; i++)
+			std::swap(blockA.bounds[i][a % 4], blockB.bounds[i][b % 4]);
+
+		for (UINT32 i = 0; i < 2; i++)
+			std::swap(blockA.layers[i][a % 4], blockB.layers[i][b % 4]);
+	}
+
+	void CullInfoSoA::removeLast()
+	{
+		assert(mSize > 0);
+
+		const UINT32 idx = --mSize;
+		if (idx % 4 == 0)
+			mBlocks.pop_back();
+		else
+		{
+			// Make sure the unused entry never passes the layer test
+			Block& block = mBlocks[idx / 4];
+			block.layers[0][idx % 4] = 0;
+			block.layers[1][idx % 4] = 0;
+		}
+	}
+
+	Sphere CullInfoSoA::getSphere(UINT32 idx) const
+	{
+		const Block& block = mBlocks[idx / 4];
+		const UINT32 lane = idx % 4;
+
+		return Sphere(
+			Vector3(block.bounds[SphereCenterX][lane], block.bounds[SphereCenterY][lane], block.bounds[SphereCenterZ][lane]),
+			block.bounds[SphereRadius][lane]);
+	}
+
+	AABox CullInfoSoA::getBox(UINT32 idx) const
+	{
+		const Block& block = mBlocks[idx / 4];
+		const UINT32 lane = idx % 4;
+
+		const Vector3 center(block.bounds[BoxCenterX][lane], block.bounds[BoxCenterY][lane], 
+			block.bounds[BoxCenterZ][lane]);
+		const Vector3 extents(block.bounds[BoxExtentX][lane], block.bounds[BoxExtentY][lane], 
+			block.bounds[BoxExtentZ][lane]);
+
+		return AABox(center - extents, center + extents);
+	}
+
+	UINT64 CullInfoSoA::getLayer(UINT32 idx) const
+	{
+		const Block& block = mBlocks[idx / 4];
+		return (UINT64)block.layers[0][idx % 4] | ((UINT64)block.layers[1][idx % 4] << 32);
+	}
+
 	RendererViewData::RendererViewData()
-		:encodeDepth(false), depthEncodeNear(0.0f), depthEncodeFar(0.0f)
+		:encodeDepth(false), occlusionCulling(false), instancing(false), clusteredDecals(false), clusterCulling(false)
+		, depthEncodeNear(0.0f), depthEncodeFar(0.0f)
 	{
 		
 	}
 
 	RendererViewProperties::RendererViewProperties(const RENDERER_VIEW_DESC& src)
-		:RendererViewData(src), frameIdx(0), target(src.target)
+		:RendererViewData(src), frameIdx(0), target(src.target), outputWidth(src.target.viewRect.width)
+		, outputHeight(src.target.viewRect.height)
 	{
 		viewProjTransform = src.projTransform * src.viewTransform;
 	}
@@ -72,6 +247,10 @@ namespace bs { namespace ct
 		mParamBuffer = gPerCameraParamDef.createBuffer();
 		mProperties.prevViewProjTransform = mProperties.viewProjTransform;
 
+		mOutputViewRect = desc.target.viewRect;
+		mOutputTargetWidth = desc.target.targetWidth;
+		mOutputTargetHeight = desc.target.targetHeight;
+
 		setStateReductionMode(desc.stateReduction);
 	}
 
@@ -98,6 +277,10 @@ namespace bs { namespace ct
 
 		mRenderSettingsHash++;
 
+		// Temporal resolve operates on a non-MSAA scene color as a part of post-processing
+		mProperties.temporalAA = mRenderSettings->enableTemporalAA && mProperties.runPostProcessing &&
+			mProperties.target.numSamples <= 1;
+
 		// Update compositor hierarchy (Note: Needs to be called even when viewport size (or other information) changes,
 		// but we're currently calling it here as all such calls are followed by setRenderSettings.
 		mCompositor.build(*this, RCNodeFinalResolve::getNodeId());
@@ -111,7 +294,7 @@ namespace bs { namespace ct
 		mProperties.viewTransform = view;
 		mProperties.projTransform = proj;
 		mProperties.cullFrustum = worldFrustum;
-		mProperties.viewProjTransform = proj * view;
+		mProperties.viewProjTransform = getJitteredProjTransform() * view;
 	}
 
 	void RendererView::setView(const RENDERER_VIEW_DESC& desc)
@@ -122,7 +305,139 @@ namespace bs { namespace ct
 		mProperties.prevViewProjTransform = Matrix4::IDENTITY;
 		mProperties.target = desc.target;
 
+		mOutputViewRect = desc.target.viewRect;
+		mOutputTargetWidth = desc.target.targetWidth;
+		mOutputTargetHeight = desc.target.targetHeight;
+		applyRenderScale();
+
 		setStateReductionMode(desc.stateReduction);
+		mOcclusionCulling.clear();
+	}
+
+	void RendererView::setOcclusionCulling(bool enabled)
+	{
+		if (mProperties.occlusionCulling == enabled)
+			return;
+
+		mProperties.occlusionCulling = enabled;
+		mOcclusionCulling.clear();
+
+		// Occlusion tests are executed as a part of the compositor hierarchy
+		if (mRenderSettings != nullptr)
+			mCompositor.build(*this, RCNodeFinalResolve::getNodeId());
+	}
+
+	void RendererView::updateRenderScale(const RenderBeastOptions& options)
+	{
+		// Upscaling is done during tonemapping (or temporal anti-aliasing, if enabled), so views without post-processing
+		// are always rendered at full resolution. Same goes for views encoding depth into their output, as depth cannot be
+		// upscaled.
+		const bool enabled = options.dynamicResolution && mCamera != nullptr && mProperties.runPostProcessing &&
+			!mProperties.encodeDepth;
+
+		float renderScale = 1.0f;
+		if (enabled)
+		{
+			const float minScale = Math::clamp(options.dynamicResolutionMinScale, RENDER_SCALE_STEP, 1.0f);
+			const float targetTime = std::max(options.dynamicResolutionTargetTime, 0.01f);
+
+			for (UINT32 i = 0; i < NUM_GPU_TIMERS; i++)
+			{
+				if (!mGPUTimerPending[i] || !mGPUTimers[i]->isReady())
+					continue;
+
+				// GPU time is assumed to be proportional to the number of rendered pixels, meaning the square of the scale
+				const float gpuTime = std::max(mGPUTimers[i]->getTimeMs(), 0.01f);
+				const float idealScale = mGPUTimerScales[i] * std::sqrt(targetTime / gpuTime);
+
+				mRenderScaleTarget = Math::lerp(RENDER_SCALE_RESPONSE, mRenderScaleTarget, idealScale);
+				mRenderScaleTarget = Math::clamp(mRenderScaleTarget, minScale, 1.0f);
+
+				mGPUTimerPending[i] = false;
+			}
+
+			renderScale = std::floor(mRenderScaleTarget / RENDER_SCALE_STEP + 0.001f) * RENDER_SCALE_STEP;
+			renderScale = Math::clamp(renderScale, minScale, 1.0f);
+		}
+		else if (mMeasureGPUTime)
+		{
+			for (UINT32 i = 0; i < NUM_GPU_TIMERS; i++)
+			{
+				mGPUTimers[i] = nullptr;
+				mGPUTimerPending[i] = false;
+			}
+
+			mRenderScaleTarget = 1.0f;
+		}
+
+		mMeasureGPUTime = enabled;
+
+		if (renderScale != mRenderScale)
+		{
+			mRenderScale = renderScale;
+			applyRenderScale();
+
+			updatePerViewBuffer();
+		}
+	}
+
+	void RendererView::applyRenderScale()
+	{
+		RendererViewTargetData& target = mProperties.target;
+
+		target.viewRect.x = (INT32)(mOutputViewRect.x * mRenderScale);
+		target.viewRect.y = (INT32)(mOutputViewRect.y * mRenderScale);
+		target.viewRect.width = std::max(1U, (UINT32)(mOutputViewRect.width * mRenderScale));
+		target.viewRect.height = std::max(1U, (UINT32)(mOutputViewRect.height * mRenderScale));
+		target.targetWidth = (UINT32)(mOutputTargetWidth * mRenderScale);
+		target.targetHeight = (UINT32)(mOutputTargetHeight * mRenderScale);
+
+		mProperties.outputWidth = mOutputViewRect.width;
+		mProperties.outputHeight = mOutputViewRect.height;
+	}
+
+	bool RendererView::updateTemporalJitter()
+	{
+		Vector2 jitter = Vector2::ZERO;
+		if (mProperties.temporalAA)
+		{
+			// First element of the sequence is skipped, as it is zero for all bases
+			const UINT32 sampleIdx = (mProperties.frameIdx % TEMPORAL_AA_NUM_SAMPLES) + 1;
+			const Rect2I& viewRect = mProperties.target.viewRect;
+
+			// Offset in range [-0.5, 0.5] pixels, converted to NDC
+			jitter.x = (haltonSequence(sampleIdx, 2) - 0.5f) * 2.0f / viewRect.width;
+			jitter.y = (haltonSequence(sampleIdx, 3) - 0.5f) * 2.0f / viewRect.height;
+		}
+
+		if (jitter == mProperties.temporalJitter)
+			return false;
+
+		mProperties.temporalJitter = jitter;
+		mProperties.viewProjTransform = getJitteredProjTransform() * mProperties.viewTransform;
+
+		return true;
+	}
+
+	Matrix4 RendererView::getJitteredProjTransform() const
+	{
+		// Offsets the clip space position by jitter * w, resulting in a constant offset in NDC
+		Matrix4 jitter = Matrix4::IDENTITY;
+		jitter[0][3] = mProperties.temporalJitter.x;
+		jitter[1][3] = mProperties.temporalJitter.y;
+
+		return jitter * mProperties.projTransform;
+	}
+
+	Matrix4 RendererView::getNDCToPrevNDC() const
+	{
+		// Jitter is removed before reprojecting, as the previous view-projection matrix is stored without it
+		Matrix4 unjitter = Matrix4::translation(Vector3(-mProperties.temporalJitter.x, -mProperties.temporalJitter.y,
+			0.0f));
+
+		// Note: inverse view-projection can be cached, it doesn't change every frame
+		Matrix4 viewProj = mProperties.projTransform * mProperties.viewTransform;
+		return mProperties.prevViewProjTransform * viewProj.inverse() * unjitter;
 	}
 
 	void RendererView::beginFrame()
@@ -144,30 +459,52 @@ namespace bs { namespace ct
 					newTargetHeight = mProperties.target.target->getProperties().height;
 				}
 
-				if(newTargetWidth != mProperties.target.targetWidth ||
-					newTargetHeight != mProperties.target.targetHeight)
+				if(newTargetWidth != mOutputTargetWidth || newTargetHeight != mOutputTargetHeight)
 				{
-					mProperties.target.viewRect = viewport->getPixelArea();
-					mProperties.target.targetWidth = newTargetWidth;
-					mProperties.target.targetHeight = newTargetHeight;
+					mOutputViewRect = viewport->getPixelArea();
+					mOutputTargetWidth = newTargetWidth;
+					mOutputTargetHeight = newTargetHeight;
+					applyRenderScale();
 					
 					updatePerViewBuffer();
 				}
 			}
 		}
 
-		// Note: inverse view-projection can be cached, it doesn't change every frame
-		Matrix4 viewProj = mProperties.projTransform * mProperties.viewTransform;
-		Matrix4 invViewProj = viewProj.inverse();
-		Matrix4 NDCToPrevNDC = mProperties.prevViewProjTransform * invViewProj;
-		
-		gPerCameraParamDef.gNDCToPrevNDC.set(mParamBuffer, NDCToPrevNDC);
+		// Measure GPU time of the view, for use by dynamic resolution. Queries are only re-used once their results have
+		// been read by updateRenderScale(), otherwise this frame doesn't get measured. Queries are created on the
+		// first device, so views rendering on other devices aren't measured.
+		if (mMeasureGPUTime && !mGPUTimerPending[mGPUTimerIdx] && RenderAPI::instance().getActiveDevice() == 0)
+		{
+			SPtr<TimerQuery>& timer = mGPUTimers[mGPUTimerIdx];
+			if (timer == nullptr)
+				timer = TimerQuery::create();
+
+			mGPUTimerScales[mGPUTimerIdx] = mRenderScale;
+			mGPUTimerPending[mGPUTimerIdx] = true;
+			mGPUTimerActive = true;
+
+			timer->begin();
+		}
+
+		if (updateTemporalJitter())
+			updatePerViewBuffer();
+		else
+			gPerCameraParamDef.gNDCToPrevNDC.set(mParamBuffer, getNDCToPrevNDC());
 	}
 
 	void RendererView::endFrame()
 	{
+		if (mGPUTimerActive)
+		{
+			mGPUTimers[mGPUTimerIdx]->end();
+
+			mGPUTimerIdx = (mGPUTimerIdx + 1) % NUM_GPU_TIMERS;
+			mGPUTimerActive = false;
+		}
+
 		// Save view-projection matrix to use for temporal filtering
-		mProperties.prevViewProjTransform = mProperties.viewProjTransform;
+		mProperties.prevViewProjTransform = mProperties.projTransform * mProperties.viewTransform;
 
 		// Advance per-view frame index. This is used primarily by temporal rendering effects, and pausing the frame index
 		// allows you to freeze the current rendering as is, without temporal artifacts.
@@ -179,70 +516,136 @@ namespace bs { namespace ct
 		mDecalQueue->clear();
 	}
 
-	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+	/** Number of objects culled by a single task in RendererViewGroup::determineVisibility(). Must be a multiple of 32. */
+	static constexpr UINT32 OBJECTS_PER_CULL_TASK = 2048;
+
+	/** Marks the objects whose bits are set in the provided bitset as visible. */
+	static void expandVisibilityBits(const Vector<UINT32>& bits, Vector<bool>& visibility)
+	{
+		for (UINT32 i = 0; i < (UINT32)bits.size(); i++)
+		{
+			UINT32 word = bits[i];
+			while (word != 0)
+			{
+				visibility[i * 32 + Bitwise::leastSignificantBit(word)] = true;
+				word &= word - 1;
+			}
+		}
+	}
+
+	/** Sets all the bits that are set in @p bits in @p combinedBits as well. */
+	static void mergeVisibilityBits(const Vector<UINT32>& bits, Vector<UINT32>& combinedBits)
+	{
+		for (UINT32 i = 0; i < (UINT32)bits.size(); i++)
+			combinedBits[i] |= bits[i];
+	}
+
+	/** Resets the visibility flags and bitset for the specified number of objects. */
+	static void resetVisibility(UINT32 numObjects, Vector<bool>& visibility, Vector<UINT32>& bits)
 	{
-		mVisibility.renderables.clear();
-		mVisibility.renderables.resize(renderables.size(), false);
+		visibility.clear();
+		visibility.resize(numObjects, false);
+
+		bits.clear();
+		bits.resize(Math::divideAndRoundUp(numObjects, 32U), 0);
+	}
+
+	void RendererView::beginVisibility(const SceneInfo& sceneInfo)
+	{
+		resetVisibility((UINT32)sceneInfo.renderables.size(), mVisibility.renderables, mVisibilityBits.renderables);
+		resetVisibility((UINT32)sceneInfo.particleSystems.size(), mVisibility.particleSystems, 
+			mVisibilityBits.particleSystems);
+		resetVisibility((UINT32)sceneInfo.decals.size(), mVisibility.decals, mVisibilityBits.decals);
+	}
+
+	void RendererView::cullObjects(const SceneInfo& sceneInfo, CulledObjectType type, UINT32 start, UINT32 end)
+	{
+		assert(start % 32 == 0);
 
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
-
-		if(visibility != nullptr)
+		switch(type)
 		{
-			for (UINT32 i = 0; i < (UINT32)renderables.size(); i++)
-			{
-				bool visible = (*visibility)[i];
-
-				(*visibility)[i] = visible || mVisibility.renderables[i];
-			}
+		case CulledObjectType::Renderable:
+			if(sceneInfo.renderableOctree != nullptr)
+				calculateVisibility(*sceneInfo.renderableOctree, sceneInfo.renderableCullInfosSoA, mVisibilityBits.renderables);
+			else
+				calculateVisibility(sceneInfo.renderableCullInfosSoA, start, end, mVisibilityBits.renderables);
+			break;
+		case CulledObjectType::ParticleSystem:
+			calculateVisibility(sceneInfo.particleSystemCullInfosSoA, start, end, mVisibilityBits.particleSystems);
+			break;
+		case CulledObjectType::Decal:
+			calculateVisibility(sceneInfo.decalCullInfosSoA, start, end, mVisibilityBits.decals);
+			break;
 		}
 	}
 
-	void RendererView::determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<CullInfo>& cullInfos, 
-		Vector<bool>* visibility)
+	void RendererView::copyVisibility(const RendererView& other)
 	{
-		mVisibility.particleSystems.clear();
-		mVisibility.particleSystems.resize(particleSystems.size(), false);
-
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.particleSystems);
+		mVisibilityBits.renderables = other.mVisibilityBits.renderables;
+		mVisibilityBits.particleSystems = other.mVisibilityBits.particleSystems;
+		mVisibilityBits.decals = other.mVisibilityBits.decals;
+	}
 
-		if(visibility != nullptr)
+	void RendererView::cullByDrawDistance(const SceneInfo& sceneInfo)
+	{
+		if (sceneInfo.numDrawDistanceRenderables == 0 || mRenderSettings->overlayOnly)
+			return;
+
+		Vector<UINT32>& bits = mVisibilityBits.renderables;
+		for (UINT32 i = 0; i < (UINT32)bits.size(); i++)
 		{
-			for (UINT32 i = 0; i < (UINT32)particleSystems.size(); i++)
+			UINT32 word = bits[i];
+			while (word != 0)
 			{
-				bool visible = (*visibility)[i];
+				const UINT32 bit = Bitwise::leastSignificantBit(word);
+				word &= word - 1;
 
-				(*visibility)[i] = visible || mVisibility.particleSystems[i];
+				const Renderable* renderable = sceneInfo.renderables[i * 32 + bit]->renderable;
+				if (!renderable->hasDrawDistance())
+					continue;
+
+				const float distance = renderable->getDrawDistanceOrigin().distance(mProperties.viewOrigin);
+				const float maxDistance = renderable->getMaxDrawDistance();
+				if (distance < renderable->getMinDrawDistance() || (maxDistance > 0.0f && distance >= maxDistance))
+					bits[i] &= ~(1U << bit);
 			}
 		}
 	}
 
-	void RendererView::determineVisible(const Vector<RendererDecal>& decals, const Vector<CullInfo>& cullInfos, 
-		Vector<bool>* visibility)
+	void RendererView::setStereoCullVolume(const ConvexVolume* volume)
 	{
-		mVisibility.decals.clear();
-		mVisibility.decals.resize(decals.size(), false);
+		if (volume != nullptr)
+		{
+			mStereoCullVolume = *volume;
+			mHasStereoCullVolume = true;
+		}
+		else
+			mHasStereoCullVolume = false;
+	}
 
-		if (mRenderSettings->overlayOnly)
+	void RendererView::cullOccluded(const SceneInfo& sceneInfo)
+	{
+		if (!mProperties.occlusionCulling || mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.decals);
+		mOcclusionCulling.cull(*this, sceneInfo, mVisibilityBits.renderables);
+	}
 
-		if(visibility != nullptr)
-		{
-			for (UINT32 i = 0; i < (UINT32)decals.size(); i++)
-			{
-				bool visible = (*visibility)[i];
+	void RendererView::endVisibility(VisibilityBits& combinedVisibility)
+	{
+		expandVisibilityBits(mVisibilityBits.renderables, mVisibility.renderables);
+		expandVisibilityBits(mVisibilityBits.particleSystems, mVisibility.particleSystems);
+		expandVisibilityBits(mVisibilityBits.decals, mVisibility.decals);
 
-				(*visibility)[i] = visible || mVisibility.decals[i];
-			}
-		}
+		mergeVisibilityBits(mVisibilityBits.renderables, combinedVisibility.renderables);
+		mergeVisibilityBits(mVisibilityBits.particleSystems, combinedVisibility.particleSystems);
+		mergeVisibilityBits(mVisibilityBits.decals, combinedVisibility.decals);
 	}
 
 	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
@@ -278,6 +681,11 @@ namespace bs { namespace ct
 
 		calculateVisibility(bounds, *perViewVisibility);
 
+		// Lights hidden behind scene geometry don't affect any visible surface. Occlusion results were already refreshed
+		// by cullOccluded().
+		if (mProperties.occlusionCulling)
+			mOcclusionCulling.cullLights(lightType, bounds, *perViewVisibility);
+
 		if(visibility != nullptr)
 		{
 			for (UINT32 i = 0; i < (UINT32)lights.size(); i++)
@@ -289,49 +697,190 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const CullInfoSoA& cullInfos, UINT32 start, UINT32 end, 
+		Vector<UINT32>& visibility) const
+	{
+		using namespace simd;
+
+		assert(start % 32 == 0 && end <= cullInfos.size());
+
+		const UINT64 cameraLayers = mProperties.visibleLayers;
+		const Vector<Plane> planes = getCullVolume().getPlanes();
+
+		const uint32x4 zero = splat<uint32x4>(0);
+		const uint32x4 cameraLayersLow = splat<uint32x4>((UINT32)(cameraLayers & 0xFFFFFFFF));
+		const uint32x4 cameraLayersHigh = splat<uint32x4>((UINT32)(cameraLayers >> 32));
+
+		// Range always starts at a word boundary, and ends either at a word boundary or at the end of the list, so
+		// separate ranges never write to the same words
+		const UINT32 endBlock = Math::divideAndRoundUp(end, 4U);
+		const CullInfoSoA::Block* blocks = cullInfos.getBlocks();
+		for (UINT32 i = start / 4; i < endBlock; i++)
+		{
+			const CullInfoSoA::Block& block = blocks[i];
+
+			// Unused entries have no layer bits set, so they always get culled here
+			uint32x4 layers = bit_or(
+				bit_and(load_u<uint32x4>(block.layers[0]), cameraLayersLow),
+				bit_and(load_u<uint32x4>(block.layers[1]), cameraLayersHigh));
+
+			uint32x4 culled = bit_cast<uint32x4>(cmp_eq(layers, zero));
+
+			const float32x4 sphereX = load_u<float32x4>(block.bounds[CullInfoSoA::SphereCenterX]);
+			const float32x4 sphereY = load_u<float32x4>(block.bounds[CullInfoSoA::SphereCenterY]);
+			const float32x4 sphereZ = load_u<float32x4>(block.bounds[CullInfoSoA::SphereCenterZ]);
+			const float32x4 negRadius = neg(load_u<float32x4>(block.bounds[CullInfoSoA::SphereRadius]));
+
+			const float32x4 boxX = load_u<float32x4>(block.bounds[CullInfoSoA::BoxCenterX]);
+			const float32x4 boxY = load_u<float32x4>(block.bounds[CullInfoSoA::BoxCenterY]);
+			const float32x4 boxZ = load_u<float32x4>(block.bounds[CullInfoSoA::BoxCenterZ]);
+			const float32x4 extentX = load_u<float32x4>(block.bounds[CullInfoSoA::BoxExtentX]);
+			const float32x4 extentY = load_u<float32x4>(block.bounds[CullInfoSoA::BoxExtentY]);
+			const float32x4 extentZ = load_u<float32x4>(block.bounds[CullInfoSoA::BoxExtentZ]);
+
+			// Same tests as ConvexVolume::intersects() for spheres and boxes, for all four objects at once
+			for (auto& plane : planes)
+			{
+				const float32x4 normalX = splat<float32x4>(plane.normal.x);
+				const float32x4 normalY = splat<float32x4>(plane.normal.y);
+				const float32x4 normalZ = splat<float32x4>(plane.normal.z);
+				const float32x4 planeD = splat<float32x4>(plane.d);
+
+				float32x4 sphereDist = add(add(mul(sphereX, normalX), mul(sphereY, normalY)), mul(sphereZ, normalZ));
+				sphereDist = sub(sphereDist, planeD);
+
+				culled = bit_or(culled, bit_cast<uint32x4>(cmp_lt(sphereDist, negRadius)));
+
+				float32x4 boxDist = add(add(mul(boxX, normalX), mul(boxY, normalY)), mul(boxZ, normalZ));
+				boxDist = sub(boxDist, planeD);
+
+				float32x4 effectiveRadius = mul(extentX, abs(normalX));
+				effectiveRadius = add(effectiveRadius, mul(extentY, abs(normalY)));
+				effectiveRadius = add(effectiveRadius, mul(extentZ, abs(normalZ)));
+
+				culled = bit_or(culled, bit_cast<uint32x4>(cmp_lt(boxDist, neg(effectiveRadius))));
+			}
+
+			// Compress the per-lane masks to one bit per object. Every lane contributes four identical bits.
+			const UINT32 laneBits = extract_bits_any(bit_cast<uint8x16>(bit_not(culled)));
+			const UINT32 objectBits = (laneBits & 0x1) | ((laneBits >> 3) & 0x2) | ((laneBits >> 6) & 0x4) |
+				((laneBits >> 9) & 0x8);
+
+			visibility[i / 8] |= objectBits << ((i % 8) * 4);
+		}
+	}
+
+	void RendererView::calculateVisibility(const RenderableOctree& octree, const CullInfoSoA& cullInfos,
+		Vector<UINT32>& visibility) const
 	{
 		UINT64 cameraLayers = mProperties.visibleLayers;
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		const ConvexVolume& worldFrustum = getCullVolume();
+		const ConvexVolumeCuller culler(worldFrustum);
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		const auto markVisible = [&visibility](UINT32 idx)
 		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
+			visibility[idx / 32] |= 1U << (idx % 32);
+		};
 
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
+		// Marks all elements in the node and its children as visible, without performing any frustum checks
+		const auto markSubtreeVisible = [&](const RenderableOctree::HNode& node)
+		{
+			RenderableOctree::NodeIterator subtreeIter(node.getNode(), node.getBounds());
+			while(subtreeIter.moveNext())
 			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
+				const RenderableOctree::HNode& subtreeNode = subtreeIter.getCurrent();
+
+				RenderableOctree::ElementIterator elemIter(subtreeNode.getNode());
+				while(elemIter.moveNext())
+				{
+					const UINT32 idx = elemIter.getCurrentElem()->renderable->getRendererId();
+					if ((cullInfos.getLayer(idx) & cameraLayers) != 0)
+						markVisible(idx);
+				}
 
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
+				for(UINT32 i = 0; i < 8; i++)
+				{
+					if(subtreeNode.getNode()->hasChild(i))
+						subtreeIter.pushChild(i);
+				}
+			}
+		};
+
+		bool isRoot = true;
+		RenderableOctree::NodeIterator nodeIter(octree);
+		while(nodeIter.moveNext())
+		{
+			const RenderableOctree::HNode& node = nodeIter.getCurrent();
+
+			// Elements that don't fit within the root bounds are still stored in the root, so its bounds can't be used
+			// for culling
+			if(!isRoot)
+			{
+				const simd::AABox& nodeBounds = node.getBounds().getBounds();
+				AABox box(
+					Vector3(
+						nodeBounds.center.x - nodeBounds.extents.x,
+						nodeBounds.center.y - nodeBounds.extents.y,
+						nodeBounds.center.z - nodeBounds.extents.z),
+					Vector3(
+						nodeBounds.center.x + nodeBounds.extents.x,
+						nodeBounds.center.y + nodeBounds.extents.y,
+						nodeBounds.center.z + nodeBounds.extents.z));
+
+				if(!culler.intersects(box))
+					continue;
+
+				// Node's loose bounds contain all of the elements in it and its children, so skip per-element checks
+				if(worldFrustum.contains(box))
+				{
+					markSubtreeVisible(node);
+					continue;
+				}
+			}
+
+			isRoot = false;
+
+			RenderableOctree::ElementIterator elemIter(node.getNode());
+			while(elemIter.moveNext())
+			{
+				const UINT32 idx = elemIter.getCurrentElem()->renderable->getRendererId();
+				if ((cullInfos.getLayer(idx) & cameraLayers) == 0)
+					continue;
+
+				if (culler.intersects(cullInfos.getSphere(idx)))
+				{
+					// More precise with the box
+					if (culler.intersects(cullInfos.getBox(idx)))
+						markVisible(idx);
+				}
+			}
+
+			for(UINT32 i = 0; i < 8; i++)
+			{
+				if(node.getNode()->hasChild(i))
+					nodeIter.pushChild(i);
 			}
 		}
 	}
 
 	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
 	{
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		const ConvexVolumeCuller culler(getCullVolume());
 
 		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
 		{
-			if (worldFrustum.intersects(bounds[i]))
+			if (culler.intersects(bounds[i]))
 				visibility[i] = true;
 		}
 	}
 
 	void RendererView::calculateVisibility(const Vector<AABox>& bounds, Vector<bool>& visibility) const
 	{
-		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
+		const ConvexVolumeCuller culler(getCullVolume());
 
 		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
 		{
-			if (worldFrustum.intersects(bounds[i]))
+			if (culler.intersects(bounds[i]))
 				visibility[i] = true;
 		}
 	}
@@ -359,11 +908,22 @@ namespace bs { namespace ct
 					mTransparentQueue->add(&renderElem, distanceToCamera, renderElem.techniqueIdx);
 				else if (shaderFlags.isSet(ShaderFlag::Forward))
 					mForwardOpaqueQueue->add(&renderElem, distanceToCamera, renderElem.techniqueIdx);
+				else if (mProperties.instancing && renderElem.instancing != nullptr &&
+					renderElem.instancing->texturesRegistered)
+				{
+					const RendererRenderable& renderable = *sceneInfo.renderables[i];
+					const UINT64 layer = renderable.renderable->getLayer();
+					const UINT64 texturePages = getTexturePages(*renderElem.instancing, renderable);
+
+					mInstanceCandidates.push_back({ &renderElem, i, layer, texturePages, distanceToCamera });
+				}
 				else
 					mDeferredOpaqueQueue->add(&renderElem, distanceToCamera, renderElem.techniqueIdx);
 			}
 		}
 
+		queueInstancedElements(sceneInfo);
+
 		// Queue particle systems
 		for(UINT32 i = 0; i < (UINT32)sceneInfo.particleSystems.size(); i++)
 		{
@@ -406,29 +966,349 @@ namespace bs { namespace ct
 			const AABox& boundingBox = sceneInfo.decalCullInfos[i].bounds.getBox();
 			const float distanceToCamera = (mProperties.viewOrigin - boundingBox.getCenter()).length();
 
-			// Check if viewer is inside the decal volume
-
-			// Extend the bounds slighty to cover the case when the viewer is outside, but the near plane is intersecting
-			// the decal bounds. We need to be conservative since the material for rendering outside will not properly
-			// render the inside of the decal volume.
-			const bool isInside = boundingBox.contains(mProperties.viewOrigin, mProperties.nearPlane * 3.0f);
-			const UINT32* techniqueIndices = renderElem.techniqueIndices[(INT32)isInside];
-
-			// No MSAA evaluation, or same value for all samples (no divergence between samples)
-			mDecalQueue->add(&renderElem, distanceToCamera, 
-				techniqueIndices[(INT32)(isMSAA ? MSAAMode::Single : MSAAMode::None)]);
-
-			// Evaluates all MSAA samples for pixels that are marked as divergent
-			if(isMSAA)
-				mDecalQueue->add(&renderElem, distanceToCamera, techniqueIndices[(INT32)MSAAMode::Full]);
+			const RendererDecal& rendererDecal = sceneInfo.decals[i];
+			if (mProperties.clusteredDecals && rendererDecal.clustered != nullptr)
+				mClusteredDecalCandidates.push_back({ &rendererDecal, i, distanceToCamera });
+			else
+				queueDecalVolume(renderElem, boundingBox, distanceToCamera);
 		}
 
+		queueClusteredDecals(sceneInfo);
+
 		mForwardOpaqueQueue->sort();
 		mDeferredOpaqueQueue->sort();
 		mTransparentQueue->sort();
 		mDecalQueue->sort();
 	}
 
+	void RendererView::queueDecalVolume(const DecalRenderElement& renderElem, const AABox& bounds, 
+		float distanceToCamera)
+	{
+		const bool isMSAA = mProperties.target.numSamples > 1;
+
+		// Check if viewer is inside the decal volume
+
+		// Extend the bounds slighty to cover the case when the viewer is outside, but the near plane is intersecting
+		// the decal bounds. We need to be conservative since the material for rendering outside will not properly
+		// render the inside of the decal volume.
+		const bool isInside = bounds.contains(mProperties.viewOrigin, mProperties.nearPlane * 3.0f);
+		const UINT32* techniqueIndices = renderElem.techniqueIndices[(INT32)isInside];
+
+		// No MSAA evaluation, or same value for all samples (no divergence between samples)
+		mDecalQueue->add(&renderElem, distanceToCamera, 
+			techniqueIndices[(INT32)(isMSAA ? MSAAMode::Single : MSAAMode::None)]);
+
+		// Evaluates all MSAA samples for pixels that are marked as divergent
+		if(isMSAA)
+			mDecalQueue->add(&renderElem, distanceToCamera, techniqueIndices[(INT32)MSAAMode::Full]);
+	}
+
+	void RendererView::queueClusteredDecals(const SceneInfo& sceneInfo)
+	{
+		// Move decals using the same material next to each other, ordering decals within a material back to front so
+		// they blend in the same order as they would if drawn individually
+		std::sort(mClusteredDecalCandidates.begin(), mClusteredDecalCandidates.end(),
+			[](const ClusteredDecalCandidate& a, const ClusteredDecalCandidate& b)
+		{
+			return std::make_tuple(a.decal->clustered, -a.distanceToCamera, a.decalIdx) <
+				std::make_tuple(b.decal->clustered, -b.distanceToCamera, b.decalIdx);
+		});
+
+		const auto numCandidates = (UINT32)mClusteredDecalCandidates.size();
+
+		// Count the groups first, so the element storage doesn't move after elements get queued
+		UINT32 numGroups = 0;
+		for (UINT32 i = 0; i < numCandidates;)
+		{
+			UINT32 end = i + 1;
+			while (end < numCandidates && 
+				mClusteredDecalCandidates[i].decal->clustered == mClusteredDecalCandidates[end].decal->clustered)
+				end++;
+
+			if (end - i >= MIN_DECALS_PER_CLUSTERED_PASS)
+				numGroups++;
+
+			i = end;
+		}
+
+		if (numGroups > (UINT32)mClusteredDecalElements.size())
+			mClusteredDecalElements.resize(numGroups);
+
+		mNumClusteredDecalElements = 0;
+		mClusteredDecalData.clear();
+		mClusteredDecalBounds.clear();
+
+		const bool isMSAA = mProperties.target.numSamples > 1;
+		for (UINT32 i = 0; i < numCandidates;)
+		{
+			const RendererDecal& leader = *mClusteredDecalCandidates[i].decal;
+
+			UINT32 end = i + 1;
+			while (end < numCandidates && leader.clustered == mClusteredDecalCandidates[end].decal->clustered)
+				end++;
+
+			if (end - i < MIN_DECALS_PER_CLUSTERED_PASS)
+			{
+				for (UINT32 j = i; j < end; j++)
+				{
+					const ClusteredDecalCandidate& candidate = mClusteredDecalCandidates[j];
+					queueDecalVolume(candidate.decal->renderElement, 
+						sceneInfo.decalCullInfos[candidate.decalIdx].bounds.getBox(), candidate.distanceToCamera);
+				}
+
+				i = end;
+				continue;
+			}
+
+			ClusteredDecalMaterialParams* clustered = leader.clustered;
+
+			ClusteredDecalElement& renderElem = mClusteredDecalElements[mNumClusteredDecalElements++];
+			renderElem.type = (UINT32)RenderElementType::ClusteredDecals;
+			renderElem.material = leader.renderElement.material;
+			renderElem.techniqueIdx = clustered->techniqueIndices[0];
+			renderElem.params = clustered->params;
+			renderElem.clustered = clustered;
+			renderElem.decalParamBuffer = leader.decalParamBuffer;
+			renderElem.perCameraParamBuffer = mParamBuffer;
+			renderElem.gridParamBuffer = mLightGrid.getOutputs().gridParams;
+			renderElem.firstDecal = (UINT32)mClusteredDecalData.size();
+			renderElem.numDecals = end - i;
+
+			float minDistance = std::numeric_limits<float>::max();
+			for (UINT32 j = i; j < end; j++)
+			{
+				const ClusteredDecalCandidate& candidate = mClusteredDecalCandidates[j];
+
+				mClusteredDecalData.push_back(candidate.decal->clusteredData);
+				mClusteredDecalBounds.push_back(sceneInfo.decalCullInfos[candidate.decalIdx].bounds.getSphere());
+				minDistance = std::min(minDistance, candidate.distanceToCamera);
+			}
+
+			// Note: Material animation time of the first decal is used for the entire group
+			leader.renderElement.material->updateParamsSet(clustered->params, 
+				leader.renderElement.materialAnimationTime);
+
+			mDecalQueue->add(&renderElem, minDistance, 
+				clustered->techniqueIndices[(INT32)(isMSAA ? MSAAMode::Single : MSAAMode::None)]);
+
+			if(isMSAA)
+				mDecalQueue->add(&renderElem, minDistance, clustered->techniqueIndices[(INT32)MSAAMode::Full]);
+
+			i = end;
+		}
+
+		mClusteredDecalCandidates.clear();
+	}
+
+	void RendererView::updateClusteredDecals(UINT32 maxDecalsPerCell)
+	{
+		if (mNumClusteredDecalElements == 0)
+			return;
+
+		const auto numDecals = (UINT32)mClusteredDecalData.size();
+		const UINT32 numDataEntries = numDecals * 4;
+		if (mClusteredDecalDataBuffer == nullptr || 
+			mClusteredDecalDataBuffer->getProperties().getElementCount() < numDataEntries)
+		{
+			GPU_BUFFER_DESC desc;
+			desc.type = GBT_STANDARD;
+			desc.format = BF_32X4F;
+			desc.elementCount = Math::divideAndRoundUp(numDataEntries, CLUSTERED_DECAL_BUFFER_INCREMENT) * 
+				CLUSTERED_DECAL_BUFFER_INCREMENT;
+			desc.usage = GBU_DYNAMIC;
+
+			mClusteredDecalDataBuffer = GpuBuffer::create(desc);
+		}
+
+		mClusteredDecalDataBuffer->writeData(0, numDecals * sizeof(ClusteredDecalData), mClusteredDecalData.data(),
+			BWT_DISCARD);
+
+		const Vector3I& gridSize = mLightGrid.getGridSize();
+		const UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
+
+		bs_frame_mark();
+		{
+			FrameVector<UINT32> offsetsAndSize(numCells * 2);
+			Vector<UINT32> cellOffsets;
+			Vector<UINT32> indices;
+
+			for (UINT32 i = 0; i < mNumClusteredDecalElements; i++)
+			{
+				ClusteredDecalElement& renderElem = mClusteredDecalElements[i];
+				renderElem.decalDataBuffer = mClusteredDecalDataBuffer;
+
+				mLightGrid.binSpheres(*this, &mClusteredDecalBounds[renderElem.firstDecal], renderElem.numDecals,
+					numCells * maxDecalsPerCell, cellOffsets, indices);
+
+				for (UINT32 j = 0; j < numCells; j++)
+				{
+					offsetsAndSize[j * 2 + 0] = cellOffsets[j];
+					offsetsAndSize[j * 2 + 1] = cellOffsets[j + 1] - cellOffsets[j];
+				}
+
+				// Binned indices are relative to the element's first decal
+				for (auto& index : indices)
+					index += renderElem.firstDecal;
+
+				if (renderElem.decalOffsetsAndSizeBuffer == nullptr ||
+					renderElem.decalOffsetsAndSizeBuffer->getProperties().getElementCount() < numCells)
+				{
+					GPU_BUFFER_DESC desc;
+					desc.type = GBT_STANDARD;
+					desc.format = BF_32X2U;
+					desc.elementCount = numCells;
+					desc.usage = GBU_DYNAMIC;
+
+					renderElem.decalOffsetsAndSizeBuffer = GpuBuffer::create(desc);
+				}
+
+				// Allocate at least one entry even if no indices, to avoid issues with null buffers
+				const auto numIndices = (UINT32)indices.size();
+				if (renderElem.decalIndicesBuffer == nullptr ||
+					renderElem.decalIndicesBuffer->getProperties().getElementCount() < numIndices)
+				{
+					GPU_BUFFER_DESC desc;
+					desc.type = GBT_STANDARD;
+					desc.format = BF_32X1U;
+					desc.elementCount = std::max(1U, Math::divideAndRoundUp(numIndices, 
+						CLUSTERED_DECAL_BUFFER_INCREMENT)) * CLUSTERED_DECAL_BUFFER_INCREMENT;
+					desc.usage = GBU_DYNAMIC;
+
+					renderElem.decalIndicesBuffer = GpuBuffer::create(desc);
+				}
+
+				renderElem.decalOffsetsAndSizeBuffer->writeData(0, numCells * 2 * sizeof(UINT32), 
+					offsetsAndSize.data(), BWT_DISCARD);
+
+				if (numIndices > 0)
+				{
+					renderElem.decalIndicesBuffer->writeData(0, numIndices * sizeof(UINT32), indices.data(),
+						BWT_DISCARD);
+				}
+			}
+		}
+		bs_frame_clear();
+	}
+
+	void RendererView::queueInstancedElements(const SceneInfo& sceneInfo)
+	{
+		const auto isSameGroup = [](const InstanceCandidate& a, const InstanceCandidate& b)
+		{
+			return a.element->instancing == b.element->instancing && a.element->mesh == b.element->mesh &&
+				a.element->subMesh.indexOffset == b.element->subMesh.indexOffset &&
+				a.element->subMesh.indexCount == b.element->subMesh.indexCount && a.layer == b.layer &&
+				a.texturePages == b.texturePages;
+		};
+
+		// Move candidates that can be drawn together next to each other
+		std::sort(mInstanceCandidates.begin(), mInstanceCandidates.end(),
+			[](const InstanceCandidate& a, const InstanceCandidate& b)
+		{
+			return std::make_tuple(a.element->instancing, a.element->mesh.get(), a.element->subMesh.indexOffset,
+				a.element->subMesh.indexCount, a.layer, a.texturePages) <
+				std::make_tuple(b.element->instancing, b.element->mesh.get(), b.element->subMesh.indexOffset,
+				b.element->subMesh.indexCount, b.layer, b.texturePages);
+		});
+
+		const auto numCandidates = (UINT32)mInstanceCandidates.size();
+
+		// Count the groups first, so the element storage doesn't move after elements get queued
+		UINT32 numGroups = 0;
+		for (UINT32 i = 0; i < numCandidates;)
+		{
+			UINT32 end = i + 1;
+			while (end < numCandidates && isSameGroup(mInstanceCandidates[i], mInstanceCandidates[end]))
+				end++;
+
+			if (end - i >= MIN_INSTANCES_PER_DRAW)
+				numGroups++;
+
+			i = end;
+		}
+
+		if (numGroups > (UINT32)mInstancedElements.size())
+			mInstancedElements.resize(numGroups);
+
+		UINT32 groupIdx = 0;
+		for (UINT32 i = 0; i < numCandidates;)
+		{
+			UINT32 end = i + 1;
+			while (end < numCandidates && isSameGroup(mInstanceCandidates[i], mInstanceCandidates[end]))
+				end++;
+
+			const UINT32 numInstances = end - i;
+			if (numInstances < MIN_INSTANCES_PER_DRAW)
+			{
+				for (UINT32 j = i; j < end; j++)
+				{
+					const InstanceCandidate& candidate = mInstanceCandidates[j];
+					mDeferredOpaqueQueue->add(candidate.element, candidate.distanceToCamera, 
+						candidate.element->techniqueIdx);
+				}
+
+				i = end;
+				continue;
+			}
+
+			const RenderableElement& leader = *mInstanceCandidates[i].element;
+			const RendererRenderable* leaderRenderable = sceneInfo.renderables[mInstanceCandidates[i].renderableIdx];
+			InstancedMaterialParams* instancing = leader.instancing;
+
+			InstancedRenderableElement& renderElem = mInstancedElements[groupIdx++];
+			renderElem.type = (UINT32)RenderElementType::InstancedRenderable;
+			renderElem.mesh = leader.mesh;
+			renderElem.subMesh = leader.subMesh;
+			renderElem.material = leader.material;
+			renderElem.techniqueIdx = instancing->techniqueIdx;
+			renderElem.params = instancing->params;
+			renderElem.instancing = instancing;
+			renderElem.perObjectParamBuffer = leaderRenderable->perObjectParamBuffer;
+			renderElem.perCallParamBuffer = leaderRenderable->perCallParamBuffer;
+			renderElem.perCameraParamBuffer = mParamBuffer;
+			renderElem.numInstances = numInstances;
+
+			// All instances share the same pages, so the leader's textures determine which pages get bound
+			for (UINT32 j = 0; j < (UINT32)RenderableTexture::Count; j++)
+				renderElem.textureIndices[j] = getTextureIndex(*instancing, *leaderRenderable, j);
+
+			renderElem.objectDataBuffer = sceneInfo.renderableObjectData.getBuffer();
+
+			if (renderElem.instanceBuffer == nullptr || 
+				renderElem.instanceBuffer->getProperties().getElementCount() < numInstances)
+			{
+				GPU_BUFFER_DESC desc;
+				desc.type = GBT_STANDARD;
+				desc.format = BF_32X1U;
+				desc.elementCount = Math::divideAndRoundUp(numInstances, INSTANCE_BUFFER_INCREMENT) * 
+					INSTANCE_BUFFER_INCREMENT;
+				desc.usage = GBU_DYNAMIC;
+
+				renderElem.instanceBuffer = GpuBuffer::create(desc);
+			}
+
+			float minDistance = std::numeric_limits<float>::max();
+
+			// Transforms are read from the scene-wide object data buffer, so only renderable indices are needed
+			auto data = (UINT32*)renderElem.instanceBuffer->lock(GBL_WRITE_ONLY_DISCARD);
+			for (UINT32 j = i; j < end; j++)
+			{
+				const InstanceCandidate& candidate = mInstanceCandidates[j];
+
+				data[j - i] = candidate.renderableIdx;
+				minDistance = std::min(minDistance, candidate.distanceToCamera);
+			}
+			renderElem.instanceBuffer->unlock();
+
+			// Note: Material animation time of the first instance is used for the entire group
+			leader.material->updateParamsSet(instancing->params, leader.materialAnimationTime);
+
+			mDeferredOpaqueQueue->add(&renderElem, minDistance, renderElem.techniqueIdx);
+			i = end;
+		}
+
+		mInstanceCandidates.clear();
+	}
+
 	Vector2 RendererView::getDeviceZToViewZ(const Matrix4& projMatrix)
 	{
 		// Returns a set of values that will transform depth buffer values (in range [0, 1]) to a distance
@@ -555,12 +1435,13 @@ namespace bs { namespace ct
 
 	void RendererView::updatePerViewBuffer()
 	{
-		Matrix4 viewProj = mProperties.projTransform * mProperties.viewTransform;
-		Matrix4 invProj = invertProjectionMatrix(mProperties.projTransform);
+		Matrix4 projTransform = getJitteredProjTransform();
+		Matrix4 viewProj = projTransform * mProperties.viewTransform;
+		Matrix4 invProj = invertProjectionMatrix(projTransform);
 		Matrix4 invView = mProperties.viewTransform.inverseAffine();
 		Matrix4 invViewProj = invView * invProj;
 
-		gPerCameraParamDef.gMatProj.set(mParamBuffer, mProperties.projTransform);
+		gPerCameraParamDef.gMatProj.set(mParamBuffer, projTransform);
 		gPerCameraParamDef.gMatView.set(mParamBuffer, mProperties.viewTransform);
 		gPerCameraParamDef.gMatViewProj.set(mParamBuffer, viewProj);
 		gPerCameraParamDef.gMatInvViewProj.set(mParamBuffer, invViewProj);
@@ -577,10 +1458,8 @@ namespace bs { namespace ct
 		projZ[3][2] = mProperties.projTransform[3][2];
 		projZ[3][3] = 0.0f;
 
-		Matrix4 NDCToPrevNDC = mProperties.prevViewProjTransform * invViewProj;
-		
 		gPerCameraParamDef.gMatScreenToWorld.set(mParamBuffer, invViewProj * projZ);
-		gPerCameraParamDef.gNDCToPrevNDC.set(mParamBuffer, NDCToPrevNDC);
+		gPerCameraParamDef.gNDCToPrevNDC.set(mParamBuffer, getNDCToPrevNDC());
 		gPerCameraParamDef.gViewDir.set(mParamBuffer, mProperties.viewDirection);
 		gPerCameraParamDef.gViewOrigin.set(mParamBuffer, mProperties.viewOrigin);
 		gPerCameraParamDef.gDeviceZToWorldZ.set(mParamBuffer, getDeviceZToViewZ(mProperties.projTransform));
@@ -641,10 +1520,102 @@ namespace bs { namespace ct
 		return ndcToUV;
 	}
 
-	void RendererView::updateLightGrid(const VisibleLightData& visibleLightData, 
-		const VisibleReflProbeData& visibleReflProbeData)
+	void RendererView::updateLightGrid(const LIGHT_GRID_DESC& desc, const VisibleLightData& visibleLightData, 
+		const VisibleReflProbeData& visibleReflProbeData, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		mLightGrid.updateGrid(*this, desc, visibleLightData, visibleReflProbeData, !mRenderSettings->enableLighting,
+			commandBuffer);
+
+		updateClusteredDecals(std::max(desc.maxLightsPerCell, 1U));
+	}
+
+	/** Maximum distance between origins of two views for them to be considered a stereo pair. */
+	static constexpr float STEREO_MAX_SEPARATION = 0.25f;
+
+	/** Minimum cosine of the angle between view directions of two views for them to be considered a stereo pair. */
+	static constexpr float STEREO_MIN_DIRECTION_COS = 0.985f;
+
+	/** Checks can objects be culled once for both of the provided views, against the volume enclosing their frusta. */
+	static bool isStereoPair(const RendererView& a, const RendererView& b)
+	{
+		const RendererViewProperties& propsA = a.getProperties();
+		const RendererViewProperties& propsB = b.getProperties();
+
+		if (a.getRenderSettings().overlayOnly || b.getRenderSettings().overlayOnly)
+			return false;
+
+		if (propsA.target.target == nullptr || propsA.target.target != propsB.target.target)
+			return false;
+
+		if (propsA.projType != PT_PERSPECTIVE || propsB.projType != PT_PERSPECTIVE)
+			return false;
+
+		if (propsA.visibleLayers != propsB.visibleLayers || propsA.capturingReflections != propsB.capturingReflections)
+			return false;
+
+		if (propsA.cullFrustum.getPlanes().size() != 6 || propsB.cullFrustum.getPlanes().size() != 6)
+			return false;
+
+		if (propsA.viewDirection.dot(propsB.viewDirection) < STEREO_MIN_DIRECTION_COS)
+			return false;
+
+		return propsA.viewOrigin.squaredDistance(propsB.viewOrigin) <= STEREO_MAX_SEPARATION * STEREO_MAX_SEPARATION;
+	}
+
+	/** 
+	 * Calculates the eight corners of a frustum, as intersections of its planes. Returns false if the planes don't
+	 * intersect at a single point.
+	 */
+	static bool calculateFrustumCorners(const ConvexVolume& frustum, Vector3 (&corners)[8])
+	{
+		const FrustumPlane horzPlanes[] = { FRUSTUM_PLANE_LEFT, FRUSTUM_PLANE_RIGHT };
+		const FrustumPlane vertPlanes[] = { FRUSTUM_PLANE_TOP, FRUSTUM_PLANE_BOTTOM };
+		const FrustumPlane depthPlanes[] = { FRUSTUM_PLANE_NEAR, FRUSTUM_PLANE_FAR };
+
+		UINT32 idx = 0;
+		for (auto& horzPlane : horzPlanes)
+		{
+			for (auto& vertPlane : vertPlanes)
+			{
+				for (auto& depthPlane : depthPlanes)
+				{
+					const Plane& p0 = frustum.getPlane(horzPlane);
+					const Plane& p1 = frustum.getPlane(vertPlane);
+					const Plane& p2 = frustum.getPlane(depthPlane);
+
+					const Vector3 cross12 = p1.normal.cross(p2.normal);
+					const float det = p0.normal.dot(cross12);
+					if (Math::abs(det) < 1e-6f)
+						return false;
+
+					corners[idx++] = (cross12 * p0.d + p2.normal.cross(p0.normal) * p1.d +
+						p0.normal.cross(p1.normal) * p2.d) / det;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/** 
+	 * Calculates a volume enclosing both of the provided frusta. Planes of @p a are moved outwards until the corners of
+	 * @p b are on their inner side, which encloses @p b as well, since a frustum is the convex hull of its corners.
+	 */
+	static bool calculateStereoCullVolume(const ConvexVolume& a, const ConvexVolume& b, ConvexVolume& output)
 	{
-		mLightGrid.updateGrid(*this, visibleLightData, visibleReflProbeData, !mRenderSettings->enableLighting);
+		Vector3 corners[8];
+		if (!calculateFrustumCorners(b, corners))
+			return false;
+
+		Vector<Plane> planes = a.getPlanes();
+		for (auto& plane : planes)
+		{
+			for (auto& corner : corners)
+				plane.d = std::min(plane.d, plane.normal.dot(corner));
+		}
+
+		output = ConvexVolume(planes);
+		return true;
 	}
 
 	RendererViewGroup::RendererViewGroup(RendererView** views, UINT32 numViews, bool mainPass, UINT32 shadowMapSize)
@@ -682,49 +1653,125 @@ namespace bs { namespace ct
 		if (allViewsOverlay)
 			return;
 
-		// Calculate renderable visibility per view
-		mVisibility.renderables.resize(sceneInfo.renderables.size(), false);
-		mVisibility.renderables.assign(sceneInfo.renderables.size(), false);
+		// Calculate renderable, particle system and decal visibility per view. Work is split per view and per range of
+		// objects, and executed in parallel.
+		const auto numRenderables = (UINT32)sceneInfo.renderables.size();
+		const auto numParticleSystems = (UINT32)sceneInfo.particleSystems.size();
+		const auto numDecals = (UINT32)sceneInfo.decals.size();
 
-		mVisibility.particleSystems.resize(sceneInfo.particleSystems.size(), false);
-		mVisibility.particleSystems.assign(sceneInfo.particleSystems.size(), false);
+		resetVisibility(numRenderables, mVisibility.renderables, mVisibilityBits.renderables);
+		resetVisibility(numParticleSystems, mVisibility.particleSystems, mVisibilityBits.particleSystems);
+		resetVisibility(numDecals, mVisibility.decals, mVisibilityBits.decals);
 
-		mVisibility.decals.resize(sceneInfo.decals.size(), false);
-		mVisibility.decals.assign(sceneInfo.decals.size(), false);
+		findStereoPairs();
 
+		mCullTasks.clear();
+		mCullViews.clear();
 		for(UINT32 i = 0; i < numViews; i++)
 		{
-			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
-			mViews[i]->determineVisible(sceneInfo.particleSystems, sceneInfo.particleSystemCullInfos, &mVisibility.particleSystems);
-			mViews[i]->determineVisible(sceneInfo.decals, sceneInfo.decalCullInfos, &mVisibility.decals);
+			mViews[i]->beginVisibility(sceneInfo);
+
+			if (mViews[i]->getRenderSettings().overlayOnly)
+				continue;
+
+			mCullViews.push_back(mViews[i]);
+
+			// Second view of a stereo pair uses the results of the first view
+			const auto iterFind = std::find_if(mStereoPairs.begin(), mStereoPairs.end(), 
+				[view = mViews[i]](const std::pair<RendererView*, RendererView*>& entry)
+			{
+				return entry.second == view;
+			});
+
+			if (iterFind != mStereoPairs.end())
+				continue;
+
+			// Octree traversal cannot be split into ranges
+			addCullTasks(mViews[i], CulledObjectType::Renderable, numRenderables, sceneInfo.renderableOctree != nullptr);
+			addCullTasks(mViews[i], CulledObjectType::ParticleSystem, numParticleSystems, false);
+			addCullTasks(mViews[i], CulledObjectType::Decal, numDecals, false);
 		}
+
+		const auto cullObjects = [this, &sceneInfo](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+			{
+				const CullTask& task = mCullTasks[i];
+				task.view->cullObjects(sceneInfo, task.type, task.start, task.end);
+			}
+		};
+
+		PROFILE_CALL(TaskScheduler::instance().parallelFor((UINT32)mCullTasks.size(), 1, cullObjects), "Cull objects")
+
+		for (auto& entry : mStereoPairs)
+			entry.second->copyVisibility(*entry.first);
+
+		for (auto& view : mCullViews)
+			view->cullByDrawDistance(sceneInfo);
+
+		gProfilerCPU().beginSample("Cull occluded");
+		for (auto& view : mCullViews)
+			view->cullOccluded(sceneInfo);
+		gProfilerCPU().endSample("Cull occluded");
+
+		gProfilerCPU().beginSample("Merge visibility");
+		{
+			for (UINT32 i = 0; i < numViews; i++)
+				mViews[i]->endVisibility(mVisibilityBits);
+
+			expandVisibilityBits(mVisibilityBits.renderables, mVisibility.renderables);
+			expandVisibilityBits(mVisibilityBits.particleSystems, mVisibility.particleSystems);
+			expandVisibilityBits(mVisibilityBits.decals, mVisibility.decals);
+		}
+		gProfilerCPU().endSample("Merge visibility");
+
+		// Must happen before the render queues are generated, since they are sorted by sub-mesh
+		PROFILE_CALL(selectLODs(sceneInfo), "Select LODs")
 		
 		// Generate render queues per camera
+		gProfilerCPU().beginSample("Queue render elements");
 		for(UINT32 i = 0; i < numViews; i++)
 			mViews[i]->queueRenderElements(sceneInfo);
+		gProfilerCPU().endSample("Queue render elements");
 
-		// Calculate light visibility for all views
-		const auto numRadialLights = (UINT32)sceneInfo.radialLights.size();
-		mVisibility.radialLights.resize(numRadialLights, false);
-		mVisibility.radialLights.assign(numRadialLights, false);
+		// Calculate light visibility for all views, in parallel
+		gProfilerCPU().beginSample("Cull lights");
+		{
+			const auto cullLights = [this, &sceneInfo](UINT32 start, UINT32 end)
+			{
+				for (UINT32 i = start; i < end; i++)
+				{
+					mCullViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, 
+						LightType::Radial);
+					mCullViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, LightType::Spot);
+				}
+			};
 
-		const auto numSpotLights = (UINT32)sceneInfo.spotLights.size();
-		mVisibility.spotLights.resize(numSpotLights, false);
-		mVisibility.spotLights.assign(numSpotLights, false);
+			TaskScheduler::instance().parallelFor((UINT32)mCullViews.size(), 1, cullLights);
 
-		for (UINT32 i = 0; i < numViews; i++)
-		{
-			if (mViews[i]->getRenderSettings().overlayOnly)
-				continue;
+			const auto numRadialLights = (UINT32)sceneInfo.radialLights.size();
+			mVisibility.radialLights.resize(numRadialLights, false);
+			mVisibility.radialLights.assign(numRadialLights, false);
 
-			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, LightType::Radial,
-				&mVisibility.radialLights);
+			const auto numSpotLights = (UINT32)sceneInfo.spotLights.size();
+			mVisibility.spotLights.resize(numSpotLights, false);
+			mVisibility.spotLights.assign(numSpotLights, false);
 
-			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, LightType::Spot,
-				&mVisibility.spotLights);
+			for (auto& view : mCullViews)
+			{
+				const VisibilityInfo& viewVisibility = view->getVisibilityMasks();
+
+				for (UINT32 i = 0; i < numRadialLights; i++)
+					mVisibility.radialLights[i] = mVisibility.radialLights[i] || viewVisibility.radialLights[i];
+
+				for (UINT32 i = 0; i < numSpotLights; i++)
+					mVisibility.spotLights[i] = mVisibility.spotLights[i] || viewVisibility.spotLights[i];
+			}
 		}
+		gProfilerCPU().endSample("Cull lights");
 
 		// Calculate refl. probe visibility for all views
+		gProfilerCPU().beginSample("Cull reflection probes");
 		const auto numProbes = (UINT32)sceneInfo.reflProbes.size();
 		mVisibility.reflProbes.resize(numProbes, false);
 		mVisibility.reflProbes.assign(numProbes, false);
@@ -740,25 +1787,146 @@ namespace bs { namespace ct
 
 			mViews[i]->calculateVisibility(sceneInfo.reflProbeWorldBounds, mVisibility.reflProbes);
 		}
+		gProfilerCPU().endSample("Cull reflection probes");
 
 		// Organize light and refl. probe visibility infomation in a more GPU friendly manner
 
 		// Note: I'm determining light and refl. probe visibility for the entire group. It might be more performance
 		// efficient to do it per view. Additionally I'm using a single GPU buffer to hold their information, which is
 		// then updated when each view group is rendered. It might be better to keep one buffer reserved per-view.
-		mVisibleLightData.update(sceneInfo, *this);
-		mVisibleReflProbeData.update(sceneInfo, *this);
+		PROFILE_CALL(mVisibleLightData.update(sceneInfo, *this), "Update visible lights")
+		PROFILE_CALL(mVisibleReflProbeData.update(sceneInfo, *this), "Update visible refl. probes")
+
+		mPendingAsyncCompute = false;
 
 		const bool supportsClusteredForward = gRenderBeast()->getFeatureSet() == RenderBeastFeatureSet::Desktop;
 		if(supportsClusteredForward)
 		{
+			// Light grid only depends on data uploaded from the CPU, so it can be built on the compute queue while the
+			// graphics queue is busy rendering shadows
+			SPtr<CommandBuffer> computeCB;
+			if(mAsyncCompute)
+				computeCB = CommandBuffer::create(GQT_COMPUTE);
+
 			for (UINT32 i = 0; i < numViews; i++)
 			{
 				if (mViews[i]->getRenderSettings().overlayOnly)
 					continue;
 
-				mViews[i]->updateLightGrid(mVisibleLightData, mVisibleReflProbeData);
+				PROFILE_CALL(mViews[i]->updateLightGrid(mLightGridDesc, mVisibleLightData, mVisibleReflProbeData, 
+					computeCB), "Update light grid")
+			}
+
+			if(computeCB)
+			{
+				// Wait on the graphics queue, as the grid buffers might still be in use by the previous frame
+				const UINT32 syncMask = CommandSyncMask::getGlobalQueueMask(GQT_GRAPHICS, 0);
+				RenderAPI::instance().submitCommandBuffer(computeCB, syncMask);
+
+				mPendingAsyncCompute = true;
+			}
+		}
+	}
+
+	void RendererViewGroup::selectLODs(const SceneInfo& sceneInfo)
+	{
+		const auto numRenderables = (UINT32)sceneInfo.renderables.size();
+		for (UINT32 i = 0; i < numRenderables; i++)
+		{
+			if (!mVisibility.renderables[i])
+				continue;
+
+			RendererRenderable* rendererRenderable = sceneInfo.renderables[i];
+			const SPtr<Mesh>& mesh = rendererRenderable->renderable->getMesh();
+			if (mesh == nullptr)
+				continue;
+
+			// Screen size is the bounding sphere diameter relative to the viewport height
+			const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
+			float screenSize = 0.0f;
+			float screenPixelSize = 0.0f;
+			for (auto& view : mCullViews)
+			{
+				const RendererViewProperties& viewProps = view->getProperties();
+				const float projScale = viewProps.projTransform[1][1];
+
+				float viewScreenSize;
+				if (viewProps.projType == PT_ORTHOGRAPHIC)
+					viewScreenSize = bounds.getRadius() * projScale;
+				else
+				{
+					const float distance = (bounds.getCenter() - viewProps.viewOrigin).length();
+					viewScreenSize = bounds.getRadius() * projScale / std::max(distance, bounds.getRadius());
+				}
+
+				viewScreenSize = std::abs(viewScreenSize);
+				screenSize = std::max(screenSize, viewScreenSize);
+				screenPixelSize = std::max(screenPixelSize, viewScreenSize * viewProps.target.viewRect.height);
 			}
+
+			// Used for determining which mip levels of streamed textures are needed
+			rendererRenderable->screenPixelSize = screenPixelSize;
+
+			const UINT32 numLODs = mesh->getProperties().getNumLODs();
+			if (numLODs <= 1)
+				continue;
+
+			const UINT32 lod = std::min(rendererRenderable->renderable->getLOD(screenSize), numLODs - 1);
+			rendererRenderable->setLOD(lod);
 		}
 	}
+
+	void RendererViewGroup::findStereoPairs()
+	{
+		for (auto& view : mViews)
+			view->setStereoCullVolume(nullptr);
+
+		mStereoPairs.clear();
+
+		if (!mStereoCulling)
+			return;
+
+		const auto numViews = (UINT32)mViews.size();
+		Vector<bool> paired(numViews, false);
+		for (UINT32 i = 0; i < numViews; i++)
+		{
+			if (paired[i])
+				continue;
+
+			for (UINT32 j = i + 1; j < numViews; j++)
+			{
+				if (paired[j] || !isStereoPair(*mViews[i], *mViews[j]))
+					continue;
+
+				ConvexVolume cullVolume;
+				if (!calculateStereoCullVolume(mViews[i]->getProperties().cullFrustum, 
+					mViews[j]->getProperties().cullFrustum, cullVolume))
+				{
+					continue;
+				}
+
+				mViews[i]->setStereoCullVolume(&cullVolume);
+				mStereoPairs.push_back(std::make_pair(mViews[i], mViews[j]));
+
+				paired[i] = true;
+				paired[j] = true;
+				break;
+			}
+		}
+	}
+
+	void RendererViewGroup::addCullTasks(RendererView* view, CulledObjectType type, UINT32 numObjects, bool singleTask)
+	{
+		if (numObjects == 0)
+			return;
+
+		if (singleTask)
+		{
+			mCullTasks.push_back({ view, type, 0, numObjects });
+			return;
+		}
+
+		for (UINT32 start = 0; start < numObjects; start += OBJECTS_PER_CULL_TASK)
+			mCullTasks.push_back({ view, type, start, std::min(start + OBJECTS_PER_CULL_TASK, numObjects) });
+	}
 }}
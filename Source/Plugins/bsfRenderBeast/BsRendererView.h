@@ -10,6 +10,7 @@
 #include "Math/BsConvexVolume.h"
 #include "Shading/BsLightGrid.h"
 #include "Shading/BsShadowRendering.h"
+#include "Shading/BsOcclusionCulling.h"
 #include "BsRendererView.h"
 #include "BsRendererRenderable.h"
 #include "BsRenderCompositor.h"
@@ -128,6 +129,27 @@ namespace bs { namespace ct
 		 */
 		bool encodeDepth : 1;
 
+		/**
+		 * When enabled, renderables and lights hidden behind other geometry will be culled, using occlusion tests against
+		 * the depth buffer of an earlier frame.
+		 */
+		bool occlusionCulling : 1;
+
+		/**
+		 * When enabled, static renderables sharing the same mesh and material will be drawn together using instanced
+		 * rendering.
+		 */
+		bool instancing : 1;
+
+		/**
+		 * When enabled, decals sharing the same material will be applied together in a single full screen pass, looking
+		 * up the decals affecting each pixel through the light grid.
+		 */
+		bool clusteredDecals : 1;
+
+		/** When enabled, meshlets of renderables that have them will be culled on the GPU before the base pass. */
+		bool clusterCulling : 1;
+
 		/**
 		 * Controls at which position to start encoding depth, in view space. Only relevant with @p encodeDepth is enabled.
 		 * Depth will be linearly interpolated between this value and @p depthEncodeFar.
@@ -185,6 +207,24 @@ namespace bs { namespace ct
 		UINT32 frameIdx;
 
 		RendererViewTargetData target;
+
+		/** 
+		 * Size of the image output by the view, in pixels. Equal to the size of target.viewRect unless the view is
+		 * rendered at a reduced resolution due to dynamic resolution scaling, in which case the rendered image is upscaled
+		 * to this size during tonemapping.
+		 */
+		UINT32 outputWidth = 0;
+		UINT32 outputHeight = 0;
+
+		/** True if the view output is resolved using temporal anti-aliasing. */
+		bool temporalAA = false;
+
+		/** 
+		 * Sub-pixel offset applied to the projection of the view during the current frame, in NDC. Only non-zero when
+		 * temporal anti-aliasing is enabled. Applied on top of projTransform when rendering, while projTransform and
+		 * prevViewProjTransform always remain unjittered.
+		 */
+		Vector2 temporalJitter = Vector2::ZERO;
 	};
 
 	/** Information whether certain scene objects are visible in a view, per object type. */
@@ -198,6 +238,23 @@ namespace bs { namespace ct
 		Vector<bool> decals;
 	};
 
+	/** 
+	 * Visibility of objects culled through CullInfoSoA, stored as bitsets. Bit N of the word at index N / 32 represents
+	 * the object at index N.
+	 */
+	struct VisibilityBits
+	{
+		Vector<UINT32> renderables;
+		Vector<UINT32> particleSystems;
+		Vector<UINT32> decals;
+	};
+
+	/** Types of objects whose visibility is determined through RendererView::cullObjects(). */
+	enum class CulledObjectType
+	{
+		Renderable, ParticleSystem, Decal
+	};
+
 	/** Information used for culling an object against a view. */
 	struct CullInfo
 	{
@@ -209,6 +266,69 @@ namespace bs { namespace ct
 		UINT64 layer;
 	};
 
+	/**
+	 * Culling information for a set of objects, stored in a structure-of-arrays layout suitable for culling multiple
+	 * objects at once using SIMD instructions. Objects are grouped in blocks of four, where each block stores a single
+	 * component of the bounds for all four objects sequentially. Indices match the indices of the CullInfo array the
+	 * object is also stored in, and the two must be kept in sync.
+	 */
+	class CullInfoSoA
+	{
+	public:
+		/** Components of the object bounds, used for indexing Block::bounds. */
+		enum BoundsComponent
+		{
+			SphereCenterX, SphereCenterY, SphereCenterZ, SphereRadius,
+			BoxCenterX, BoxCenterY, BoxCenterZ,
+			BoxExtentX, BoxExtentY, BoxExtentZ,
+			BoundsComponentCount
+		};
+
+		/** Culling information of four objects. */
+		struct Block
+		{
+			/** Bounds of the objects. Box extents are always positive. */
+			float bounds[BoundsComponentCount][4] = {};
+
+			/** Low and high 32 bits of the object layers, respectively. Unused entries have no layer bits set. */
+			UINT32 layers[2][4] = {};
+		};
+
+		/** Appends a new object at the end of the list. */
+		void add(const CullInfo& info);
+
+		/** Updates the bounds of the object at the specified index. */
+		void setBounds(UINT32 idx, const Bounds& bounds);
+
+		/** Swaps the information of the two objects at the specified indices. */
+		void swap(UINT32 a, UINT32 b);
+
+		/** Removes the last object in the list. */
+		void removeLast();
+
+		/** Returns the bounding sphere of the object at the specified index. */
+		Sphere getSphere(UINT32 idx) const;
+
+		/** Returns the bounding box of the object at the specified index. */
+		AABox getBox(UINT32 idx) const;
+
+		/** Returns the layer of the object at the specified index. */
+		UINT64 getLayer(UINT32 idx) const;
+
+		/** Returns the number of objects in the list. */
+		UINT32 size() const { return mSize; }
+
+		/** Returns the number of blocks the objects are stored in. */
+		UINT32 getNumBlocks() const { return (UINT32)mBlocks.size(); }
+
+		/** Returns the blocks containing the object information. */
+		const Block* getBlocks() const { return mBlocks.data(); }
+
+	private:
+		Vector<Block> mBlocks;
+		UINT32 mSize = 0;
+	};
+
 	/**	Renderer information specific to a single render target. */
 	struct RendererRenderTarget
 	{
@@ -226,6 +346,18 @@ namespace bs { namespace ct
 		/** Sets state reduction mode that determines how do render queues group & sort renderables. */
 		void setStateReductionMode(StateReduction reductionMode);
 
+		/** Enables or disables culling of renderables occluded by other geometry. */
+		void setOcclusionCulling(bool enabled);
+
+		/** Enables or disables grouping of renderables into instanced draw calls. */
+		void setInstancing(bool enabled) { mProperties.instancing = enabled; }
+
+		/** Enables or disables rendering of decals sharing the same material in a single clustered pass. */
+		void setClusteredDecals(bool enabled) { mProperties.clusteredDecals = enabled; }
+
+		/** Enables or disables culling of meshlets on the GPU. */
+		void setClusterCulling(bool enabled) { mProperties.clusterCulling = enabled; }
+
 		/** Updates the internal camera render settings. */
 		void setRenderSettings(const SPtr<RenderSettings>& settings);
 
@@ -242,6 +374,12 @@ namespace bs { namespace ct
 		/** Returns the scene camera this object is based of. This can be null for manually constructed renderer cameras. */
 		Camera* getSceneCamera() const { return mCamera; }
 
+		/** 
+		 * Updates the resolution the view is rendered at, according to the dynamic resolution settings and the GPU time
+		 * measured during earlier frames. Should be called before beginFrame().
+		 */
+		void updateRenderScale(const RenderBeastOptions& options);
+
 		/** Prepares render targets for rendering. When done call endFrame(). */
 		void beginFrame();
 
@@ -272,55 +410,45 @@ namespace bs { namespace ct
 		const RenderCompositor& getCompositor() const { return mCompositor; }
 
 		/**
-		 * Populates view render queues by determining visible renderable objects. 
-		 *
-		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
-		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
-		 *									renderable objects. Must be the same size as the @p renderables array.
-		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible renderable
-		 *									object. If the bit for an object is already set to true, the method will never
-		 *									change it to false which allows the same bitfield to be provided to multiple
-		 *									renderer views. Must be the same size as the @p renderables array.
-		 *									
-		 *									As a side-effect, per-view visibility data is also calculated and can be
-		 *									retrieved by calling getVisibilityMask().
+		 * Resets the per-view visibility of renderables, particle systems and decals in preparation for cullObjects(). Must
+		 * be called before any objects are culled for the current frame.
 		 */
-		void determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void beginVisibility(const SceneInfo& sceneInfo);
 
 		/**
-		 * Populates view render queues by determining visible particle systems. 
+		 * Culls objects of the specified type in range [@p start, @p end) against the view. If the scene provides an octree
+		 * for the object type the range is ignored and all of the objects are culled through the octree instead.
 		 *
-		 * @param[in]	particleSystems		A set of particle systems to iterate over and determine visibility for.
-		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
-		 *									renderable objects. Must be the same size as the @p particleSystems array.
-		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible particle system
-		 *									object. If the bit for an object is already set to true, the method will never
-		 *									change it to false which allows the same bitfield to be provided to multiple
-		 *									renderer views. Must be the same size as the @p particleSystems array.
-		 *									
-		 *									As a side-effect, per-view visibility data is also calculated and can be
-		 *									retrieved by calling getVisibilityMask().
+		 * Ranges must start at multiples of 32. Calls with non-overlapping ranges can be executed from multiple threads in
+		 * parallel, as long as beginVisibility() and endVisibility() aren't running at the same time.
 		 */
-		void determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void cullObjects(const SceneInfo& sceneInfo, CulledObjectType type, UINT32 start, UINT32 end);
 
 		/**
-		 * Populates view render queues by determining visible decals. 
-		 *
-		 * @param[in]	decals				A set of decals to iterate over and determine visibility for.
-		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
-		 *									renderable objects. Must be the same size as the @p decals array.
-		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible decal
-		 *									object. If the bit for an object is already set to true, the method will never
-		 *									change it to false which allows the same bitfield to be provided to multiple
-		 *									renderer views. Must be the same size as the @p decals array.
-		 *									
-		 *									As a side-effect, per-view visibility data is also calculated and can be
-		 *									retrieved by calling getVisibilityMask().
+		 * Uses the results of cullObjects() from another view as the results of this view, instead of culling the
+		 * objects again. Used by views sharing a cull volume (see setStereoCullVolume()). Must be called after all
+		 * cullObjects() calls for the other view have finished, and before cullOccluded().
 		 */
-		void determineVisible(const Vector<RendererDecal>& decals, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+		void copyVisibility(const RendererView& other);
+
+		/**
+		 * Removes renderables outside of their draw distance range (see Renderable::setDrawDistance()) from the results
+		 * of previous cullObjects() calls. Must be called after all cullObjects() calls for the frame have finished.
+		 */
+		void cullByDrawDistance(const SceneInfo& sceneInfo);
+
+		/**
+		 * Removes renderables occluded by other geometry from the results of previous cullObjects() calls, if occlusion
+		 * culling is enabled for the view. Must be called after all cullObjects() calls for the frame have finished.
+		 */
+		void cullOccluded(const SceneInfo& sceneInfo);
+
+		/**
+		 * Resolves the results of previous cullObjects() calls into per-view visibility data, retrievable through
+		 * getVisibilityMasks(). Results are also merged into @p combinedVisibility, which allows the same bitsets to be
+		 * provided to multiple renderer views.
+		 */
+		void endVisibility(VisibilityBits& combinedVisibility);
 
 		/**
 		 * Calculates the visibility masks for all the lights of the provided type.
@@ -341,10 +469,20 @@ namespace bs { namespace ct
 			Vector<bool>* visibility = nullptr);
 
 		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * Culls objects in range [@p start, @p end) against the current frustum and outputs a bitset determining which
+		 * object is or isn't visible by this view. Bit N of the word at index N / 32 represents the object at index N.
+		 * Four objects are tested at once using SIMD instructions. @p start must be a multiple of 32, and the bitset must
+		 * be large enough to hold all the objects. Bits for objects outside of the range are not modified.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		void calculateVisibility(const CullInfoSoA& cullInfos, UINT32 start, UINT32 end, 
+			Vector<UINT32>& visibility) const;
+
+		/**
+		 * Culls renderables in the provided octree against the current frustum and sets the bits of visible renderables
+		 * in the provided bitset. Bits are indexed by renderable's renderer ID, same as the @p cullInfos array.
+		 */
+		void calculateVisibility(const RenderableOctree& octree, const CullInfoSoA& cullInfos, 
+			Vector<UINT32>& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -360,8 +498,8 @@ namespace bs { namespace ct
 
 		/**
 		 * Inserts all visible renderable elements into render queues. Assumes visibility has been calculated beforehand
-		 * by calling determineVisible(). After the call render elements can be retrieved from the queues using
-		 * getOpqueQueue or getTransparentQueue() calls.
+		 * by calling beginVisibility(), cullObjects() and endVisibility(). After the call render elements can be retrieved
+		 * from the queues using getOpqueQueue or getTransparentQueue() calls.
 		 */
 		void queueRenderElements(const SceneInfo& sceneInfo);
 
@@ -389,8 +527,16 @@ namespace bs { namespace ct
 		 */
 		const LightGrid& getLightGrid() const { return mLightGrid; }
 
-		/** Updates the light grid used for forward rendering. */
-		void updateLightGrid(const VisibleLightData& visibleLightData, const VisibleReflProbeData& visibleReflProbeData);
+		/** Returns the object used for culling occluded renderables in this view. */
+		OcclusionCulling& getOcclusionCulling() const { return mOcclusionCulling; }
+
+		/** 
+		 * Updates the light grid used for forward rendering, using the provided grid layout. Any GPU work is queued on the
+		 * provided command buffer, or on the main command buffer if none is provided. Clustered decals queued by 
+		 * queueRenderElements() are binned into the cells of the updated grid.
+		 */
+		void updateLightGrid(const LIGHT_GRID_DESC& desc, const VisibleLightData& visibleLightData, 
+			const VisibleReflProbeData& visibleReflProbeData, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/**
 		 * Returns a value that can be used for transforming x, y coordinates from NDC into UV coordinates that can be used
@@ -400,6 +546,21 @@ namespace bs { namespace ct
 		 */
 		Vector4 getNDCToUV() const;
 
+		/**
+		 * Returns the volume objects are culled against. Equal to the view's frustum, unless the view culls objects on
+		 * behalf of both views of a stereo pair, in which case it's a volume enclosing the frusta of both views.
+		 */
+		const ConvexVolume& getCullVolume() const
+		{
+			return mHasStereoCullVolume ? mStereoCullVolume : mProperties.cullFrustum;
+		}
+
+		/**
+		 * Sets a volume that encloses the frusta of this view and the other view of its stereo pair, which will be
+		 * used for culling objects in place of the view's own frustum. Provide null to cull against the view's frustum.
+		 */
+		void setStereoCullVolume(const ConvexVolume* volume);
+
 		/** Returns an index of this view within the parent view group. */
 		UINT32 getViewIdx() const { return mViewIdx; }
 
@@ -432,22 +593,119 @@ namespace bs { namespace ct
 		 */
 		static Vector2 getNDCZToDeviceZ();
 	private:
+		/** Render element that could be drawn together with other elements using instanced rendering. */
+		struct InstanceCandidate
+		{
+			const RenderableElement* element;
+			UINT32 renderableIdx;
+			UINT64 layer;
+
+			/** 
+			 * Texture table page of the element's texture in each RenderableTexture slot, 16 bits per slot. Elements
+			 * can only be drawn together if their textures are in the same pages. Zero if pages aren't used.
+			 */
+			UINT64 texturePages;
+			float distanceToCamera;
+		};
+
+		/** Decal that could be applied together with other decals using the same material in a clustered pass. */
+		struct ClusteredDecalCandidate
+		{
+			const RendererDecal* decal;
+			UINT32 decalIdx;
+			float distanceToCamera;
+		};
+
+		/** 
+		 * Groups instance candidates sharing the same sub-mesh, material and layer into instanced render elements, and 
+		 * inserts them into the deferred opaque queue. Candidates that end up without a group are queued individually.
+		 */
+		void queueInstancedElements(const SceneInfo& sceneInfo);
+
+		/** Inserts a decal rendered individually, by drawing its volume, into the decal queue. */
+		void queueDecalVolume(const DecalRenderElement& renderElem, const AABox& bounds, float distanceToCamera);
+
+		/** 
+		 * Groups clustered decal candidates sharing the same material into clustered decal elements, and inserts them
+		 * into the decal queue. Candidates that end up in groups too small to benefit are queued individually.
+		 */
+		void queueClusteredDecals(const SceneInfo& sceneInfo);
+
+		/** 
+		 * Bins the decals of all clustered decal elements into the cells of the light grid, and uploads the per-decal
+		 * data and per-cell decal lists to the GPU.
+		 */
+		void updateClusteredDecals(UINT32 maxDecalsPerCell);
+
+		/** 
+		 * Updates the render target properties of the view by applying the current render scale to the size of the
+		 * output view rectangle and target.
+		 */
+		void applyRenderScale();
+
+		/** 
+		 * Advances the sub-pixel offset applied to the projection, if temporal anti-aliasing is enabled. Returns true if
+		 * the offset changed.
+		 */
+		bool updateTemporalJitter();
+
+		/** Returns the projection matrix used for rendering the view, including the current temporal jitter. */
+		Matrix4 getJitteredProjTransform() const;
+
+		/** 
+		 * Returns a matrix that transforms a location in NDC of the current frame, into the location of the same world
+		 * position in NDC of the previous frame. Accounts for camera movement and temporal jitter.
+		 */
+		Matrix4 getNDCToPrevNDC() const;
+
+		/** Number of GPU timer queries used for measuring the view's GPU time, in a round-robin fashion. */
+		static constexpr UINT32 NUM_GPU_TIMERS = 4;
+
 		RendererViewProperties mProperties;
 		Camera* mCamera;
 
+		// Dynamic resolution
+		Rect2I mOutputViewRect;
+		UINT32 mOutputTargetWidth = 0;
+		UINT32 mOutputTargetHeight = 0;
+		float mRenderScale = 1.0f;
+		float mRenderScaleTarget = 1.0f;
+
+		SPtr<TimerQuery> mGPUTimers[NUM_GPU_TIMERS];
+		float mGPUTimerScales[NUM_GPU_TIMERS] = { };
+		bool mGPUTimerPending[NUM_GPU_TIMERS] = { };
+		UINT32 mGPUTimerIdx = 0;
+		bool mMeasureGPUTime = false;
+		bool mGPUTimerActive = false;
+
 		SPtr<RenderQueue> mDeferredOpaqueQueue;
 		SPtr<RenderQueue> mForwardOpaqueQueue;
 		SPtr<RenderQueue> mTransparentQueue;
 		SPtr<RenderQueue> mDecalQueue;
 
+		Vector<InstanceCandidate> mInstanceCandidates;
+		Vector<InstancedRenderableElement> mInstancedElements;
+
+		Vector<ClusteredDecalCandidate> mClusteredDecalCandidates;
+		Vector<ClusteredDecalElement> mClusteredDecalElements;
+		UINT32 mNumClusteredDecalElements = 0;
+		Vector<ClusteredDecalData> mClusteredDecalData;
+		Vector<Sphere> mClusteredDecalBounds;
+		SPtr<GpuBuffer> mClusteredDecalDataBuffer;
+
 		RenderCompositor mCompositor;
 		SPtr<RenderSettings> mRenderSettings;
 		UINT32 mRenderSettingsHash;
 
 		SPtr<GpuParamBlockBuffer> mParamBuffer;
 		VisibilityInfo mVisibility;
+		VisibilityBits mVisibilityBits;
 		LightGrid mLightGrid;
+		mutable OcclusionCulling mOcclusionCulling;
 		UINT32 mViewIdx;
+
+		ConvexVolume mStereoCullVolume;
+		bool mHasStereoCullVolume = false;
 	};
 
 	/** Contains one or multiple RendererView%s that are in some way related. */
@@ -496,6 +754,39 @@ namespace bs { namespace ct
 		/** Returns the object responsible for rendering shadows for this view group. */
 		const ShadowRendering& getShadowRenderer() const { return mShadowRenderer; }
 
+		/** Sets the layout of the light grids used for clustered forward rendering by views in this group. */
+		void setLightGridDesc(const LIGHT_GRID_DESC& desc) { mLightGridDesc = desc; }
+
+		/** 
+		 * Determines should compute work that doesn't depend on rendering of the current frame be submitted on the 
+		 * compute queue during determineVisibility(), rather than being queued on the main command buffer. 
+		 */
+		void setAsyncCompute(bool enabled) { mAsyncCompute = enabled; }
+
+		/** 
+		 * Returns true if work was submitted on the compute queue during the last call to determineVisibility(). Any work
+		 * submitted on the main command buffer afterwards will wait for it to finish.
+		 */
+		bool hasPendingAsyncCompute() const { return mPendingAsyncCompute; }
+
+		/**
+		 * Determines on which render device is the group rendered. The renderer makes the device active before
+		 * determining visibility and rendering the group. See RenderAPI::setActiveDevice().
+		 */
+		void setDevice(UINT32 idx) { mDeviceIdx = idx; }
+
+		/** @copydoc setDevice */
+		UINT32 getDevice() const { return mDeviceIdx; }
+
+		/**
+		 * Determines should objects be culled once for both views of a stereo pair (e.g. the two eyes of a VR headset),
+		 * rather than once per view. Views are considered a stereo pair if they render to the same target with the same
+		 * orientation and projection, from origins close to each other. The pair is culled against a volume enclosing
+		 * the frusta of both views, meaning each view may consider a few objects visible that are only visible from the
+		 * other view.
+		 */
+		void setStereoCulling(bool enabled) { mStereoCulling = enabled; }
+
 		/** 
 		 * Updates visibility information for the provided scene objects, from the perspective of all views in this group,
 		 * and updates the render queues of each individual view. Use getVisibilityInfo() to retrieve the calculated
@@ -504,17 +795,54 @@ namespace bs { namespace ct
 		void determineVisibility(const SceneInfo& sceneInfo);
 
 	private:
+		/** Culling of a range of scene objects of a specific type, against a single view. */
+		struct CullTask
+		{
+			RendererView* view;
+			CulledObjectType type;
+			UINT32 start;
+			UINT32 end;
+		};
+
+		/** 
+		 * Splits culling of objects of the specified type, for the provided view, into tasks and appends them to
+		 * mCullTasks. 
+		 */
+		void addCullTasks(RendererView* view, CulledObjectType type, UINT32 numObjects, bool singleTask);
+
+		/** 
+		 * Finds views in the group that form stereo pairs, populates mStereoPairs and assigns the cull volume shared by
+		 * each pair to the first view of the pair.
+		 */
+		void findStereoPairs();
+
+		/** 
+		 * Selects the level of detail for each visible renderable whose mesh has more than one, according to the 
+		 * largest screen size the renderable covers in any of the views in the group.
+		 */
+		void selectLODs(const SceneInfo& sceneInfo);
+
 		Vector<RendererView*> mViews;
 		VisibilityInfo mVisibility;
+		VisibilityBits mVisibilityBits;
+		Vector<CullTask> mCullTasks;
+		Vector<RendererView*> mCullViews;
+		Vector<std::pair<RendererView*, RendererView*>> mStereoPairs;
 		bool mIsMainPass = false;
+		bool mStereoCulling = true;
 
 		VisibleLightData mVisibleLightData;
 		VisibleReflProbeData mVisibleReflProbeData;
-
-		// Note: Ideally we would want to keep this global, so all views share it. This way each view group renders its
-		// own set of shadows, but there might be shadows that are shared, and therefore we could avoid rendering them
-		// multiple times. Since non-primary view groups are used for pre-processing tasks exclusively (at the moment) 
-		// this isn't an issue right now.
+		LIGHT_GRID_DESC mLightGridDesc;
+		bool mAsyncCompute = false;
+		bool mPendingAsyncCompute = false;
+		UINT32 mDeviceIdx = 0;
+
+		// Note: Shadows are shared between views of the same group. Spot and radial light shadows are rendered once for
+		// the entire group, and views with nearly identical frusta (e.g. split-screen views of the same camera, or the
+		// two eyes of a VR headset) share cascaded shadow maps. Shadows are not shared between different view groups,
+		// but since non-primary view groups are used for pre-processing tasks exclusively (at the moment) this isn't
+		// an issue right now.
 		ShadowRendering mShadowRenderer;
 	};
 
@@ -38,6 +38,9 @@ set(BS_RENDERBEAST_INC_SHADING
 	"Shading/BsShadowRendering.h"
 	"Shading/BsPostProcessing.h"
 	"Shading/BsGpuParticleSimulation.h"
+	"Shading/BsOcclusionCulling.h"
+	"Shading/BsSkyAtmosphere.h"
+	"Shading/BsClusterCulling.h"
 )
 
 set(BS_RENDERBEAST_SRC_SHADING
@@ -48,6 +51,9 @@ set(BS_RENDERBEAST_SRC_SHADING
 	"Shading/BsShadowRendering.cpp"
 	"Shading/BsPostProcessing.cpp"
 	"Shading/BsGpuParticleSimulation.cpp"
+	"Shading/BsOcclusionCulling.cpp"
+	"Shading/BsSkyAtmosphere.cpp"
+	"Shading/BsClusterCulling.cpp"
 )
 
 set(BS_RENDERBEAST_INC_UTILITY
@@ -55,12 +61,20 @@ set(BS_RENDERBEAST_INC_UTILITY
 	"Utility/BsSamplerOverrides.h"
 	"Utility/BsRendererTextures.h"
 	"Utility/BsTextureRowAllocator.h"
+	"Utility/BsObjectDataBuffer.h"
+	"Utility/BsGpuTextureCompression.h"
+	"Utility/BsMorphShapeBlend.h"
+	"Utility/BsComputeSkinning.h"
 )
 
 set(BS_RENDERBEAST_SRC_UTILITY
 	"Utility/BsGpuSort.cpp"
 	"Utility/BsSamplerOverrides.cpp"
 	"Utility/BsRendererTextures.cpp"
+	"Utility/BsObjectDataBuffer.cpp"
+	"Utility/BsGpuTextureCompression.cpp"
+	"Utility/BsMorphShapeBlend.cpp"
+	"Utility/BsComputeSkinning.cpp"
 )
 
 if(WIN32)
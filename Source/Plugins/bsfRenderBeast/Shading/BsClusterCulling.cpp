@@ -0,0 +1,170 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Shading/BsClusterCulling.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsGpuPipelineState.h"
+#include "RenderAPI/BsRasterizerState.h"
+#include "Material/BsTechnique.h"
+#include "Material/BsPass.h"
+#include "Mesh/BsMesh.h"
+#include "BsRendererView.h"
+#include "BsRenderBeast.h"
+
+namespace bs { namespace ct
+{
+	/** Number of threads in a single compute group. */
+	static constexpr UINT32 NUM_THREADS = 64;
+
+	/** Layout of a single meshlet in ClusterCullData::clusters. */
+	struct ClusterGpuData
+	{
+		Vector4 bounds; // Center and radius
+		Vector4 cone; // Axis and cutoff
+		UINT32 indexOffset;
+		UINT32 indexCount;
+		UINT32 padding[2];
+	};
+
+	ClusterCullingParamDef gClusterCullingParamDef;
+
+	SPtr<ClusterCullData> ClusterCullData::create(const SPtr<Mesh>& mesh, UINT32 subMeshIdx,
+		const SPtr<Technique>& technique)
+	{
+		if (gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::Desktop)
+			return nullptr;
+
+		// Without multi-draw support every meshlet would be issued as a separate draw call, which costs more than the
+		// culling saves
+		const RenderAPICapabilities& caps = RenderAPI::instance().getCapabilities(0);
+		if (!caps.hasCapability(RSC_DRAW_INDIRECT) || !caps.hasCapability(RSC_MULTI_DRAW_INDIRECT))
+			return nullptr;
+
+		if (mesh == nullptr || technique == nullptr)
+			return nullptr;
+
+		const MeshProperties& meshProps = mesh->getProperties();
+
+		UINT32 firstMeshlet, numMeshlets;
+		if (!meshProps.getMeshletRange(subMeshIdx, firstMeshlet, numMeshlets))
+			return nullptr;
+
+		// Clusters can only be culled by facing if the material never renders their back faces
+		bool cullBackfaces = true;
+		const UINT32 numPasses = technique->getNumPasses();
+		for (UINT32 i = 0; i < numPasses; i++)
+		{
+			SPtr<Pass> pass = technique->getPass(i);
+			SPtr<GraphicsPipelineState> pipeline = pass->getGraphicsPipelineState();
+			if (pipeline == nullptr)
+				continue;
+
+			SPtr<RasterizerState> rasterizerState = pipeline->getRasterizerState();
+			if (rasterizerState != nullptr && rasterizerState->getProperties().getCullMode() == CULL_NONE)
+				cullBackfaces = false;
+		}
+
+		const Vector<Meshlet>& meshlets = meshProps.getMeshlets();
+
+		Vector<ClusterGpuData> clusterData(numMeshlets);
+		for (UINT32 i = 0; i < numMeshlets; i++)
+		{
+			const Meshlet& meshlet = meshlets[firstMeshlet + i];
+
+			ClusterGpuData& entry = clusterData[i];
+			entry.bounds = Vector4(meshlet.boundsCenter.x, meshlet.boundsCenter.y, meshlet.boundsCenter.z,
+				meshlet.boundsRadius);
+			entry.cone = Vector4(meshlet.coneAxis.x, meshlet.coneAxis.y, meshlet.coneAxis.z, meshlet.coneCutoff);
+			entry.indexOffset = meshlet.indexOffset;
+			entry.indexCount = meshlet.indexCount;
+			entry.padding[0] = 0;
+			entry.padding[1] = 0;
+		}
+
+		GPU_BUFFER_DESC clustersDesc;
+		clustersDesc.type = GBT_STRUCTURED;
+		clustersDesc.elementCount = numMeshlets;
+		clustersDesc.elementSize = sizeof(ClusterGpuData);
+		clustersDesc.format = BF_UNKNOWN;
+		clustersDesc.usage = GBU_STATIC;
+
+		GPU_BUFFER_DESC drawArgsDesc;
+		drawArgsDesc.type = GBT_INDIRECTARGUMENT;
+		drawArgsDesc.elementCount = numMeshlets;
+		drawArgsDesc.elementSize = sizeof(DRAW_INDEXED_INDIRECT_ARGS);
+		drawArgsDesc.format = BF_UNKNOWN;
+		drawArgsDesc.usage = GBU_LOADSTORE;
+
+		SPtr<ClusterCullData> output = bs_shared_ptr_new<ClusterCullData>();
+		output->clusters = GpuBuffer::create(clustersDesc);
+		output->clusters->writeData(0, numMeshlets * sizeof(ClusterGpuData), clusterData.data(), BWT_DISCARD);
+		output->drawArgs = GpuBuffer::create(drawArgsDesc);
+		output->drawArgsView = output->drawArgs->getView(GBT_STANDARD, BF_32X1U);
+		output->numClusters = numMeshlets;
+		output->cullBackfaces = cullBackfaces;
+
+		if (output->drawArgsView == nullptr)
+			return nullptr;
+
+		return output;
+	}
+
+	ClusterCullingMat::ClusterCullingMat()
+	{
+		mParamBuffer = gClusterCullingParamDef.createBuffer();
+
+		mParams->setParamBlockBuffer("Params", mParamBuffer);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gClusters", mClustersParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gDrawArgs", mDrawArgsParam);
+	}
+
+	void ClusterCullingMat::execute(const ClusterCullData& data, const SPtr<MeshBase>& mesh, const Matrix4& worldTfrm,
+		const RendererViewProperties& view)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		// Clusters are tested in mesh space. A world space plane n.x = d is transformed by the world matrix M = [A|t]
+		// into (A^T n).y = d - n.t, which is then normalized so distances can be compared with the cluster radius.
+		const Matrix4 transposed = worldTfrm.transpose();
+		const Vector3 translation = worldTfrm.getTranslation();
+
+		const Vector<Plane> planes = view.cullFrustum.getPlanes();
+		const auto numPlanes = (UINT32)std::min((UINT32)planes.size(), CLUSTER_CULLING_MAX_PLANES);
+		for (UINT32 i = 0; i < numPlanes; i++)
+		{
+			Vector3 normal = transposed.multiplyDirection(planes[i].normal);
+			float d = planes[i].d - planes[i].normal.dot(translation);
+
+			const float length = normal.length();
+			if (length > 0.0f)
+			{
+				normal /= length;
+				d /= length;
+			}
+
+			gClusterCullingParamDef.gFrustumPlanes.set(mParamBuffer, Vector4(normal.x, normal.y, normal.z, d), i);
+		}
+
+		// Facing can't be determined from a single point for orthographic views, and mirroring transforms flip the
+		// winding order of the triangles
+		const bool cullBackfaces = data.cullBackfaces && view.projType != PT_ORTHOGRAPHIC &&
+			worldTfrm.determinant3x3() > 0.0f;
+
+		const Vector3 viewOrigin = worldTfrm.inverseAffine().multiplyAffine(view.viewOrigin);
+
+		gClusterCullingParamDef.gViewOrigin.set(mParamBuffer, viewOrigin);
+		gClusterCullingParamDef.gNumPlanes.set(mParamBuffer, numPlanes);
+		gClusterCullingParamDef.gNumClusters.set(mParamBuffer, data.numClusters);
+		gClusterCullingParamDef.gIndexOffset.set(mParamBuffer, mesh->getIndexOffset());
+		gClusterCullingParamDef.gVertexOffset.set(mParamBuffer, mesh->getVertexOffset());
+		gClusterCullingParamDef.gCullBackfaces.set(mParamBuffer, cullBackfaces ? 1 : 0);
+
+		mClustersParam.set(data.clusters);
+		mDrawArgsParam.set(data.drawArgsView);
+
+		bind();
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.dispatchCompute(Math::divideAndRoundUp(data.numClusters, NUM_THREADS));
+	}
+}}
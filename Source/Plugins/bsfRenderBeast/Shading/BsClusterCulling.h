@@ -0,0 +1,92 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Renderer/BsRendererMaterial.h"
+#include "RenderAPI/BsSubMesh.h"
+
+namespace bs { namespace ct
+{
+	struct RendererViewProperties;
+
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/** Maximum number of frustum planes the clusters are tested against. */
+	static constexpr UINT32 CLUSTER_CULLING_MAX_PLANES = 6;
+
+	BS_PARAM_BLOCK_BEGIN(ClusterCullingParamDef)
+		BS_PARAM_BLOCK_ENTRY_ARRAY(Vector4, gFrustumPlanes, CLUSTER_CULLING_MAX_PLANES)
+		BS_PARAM_BLOCK_ENTRY(Vector3, gViewOrigin)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gNumPlanes)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gNumClusters)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gIndexOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gVertexOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gCullBackfaces)
+	BS_PARAM_BLOCK_END
+
+	extern ClusterCullingParamDef gClusterCullingParamDef;
+
+	/**
+	 * Meshlets of a single render element's sub-mesh, uploaded to the GPU, along with the buffer receiving one indirect
+	 * draw per meshlet. Meshlets that fail the culling test are drawn with zero instances.
+	 */
+	struct ClusterCullData
+	{
+		/** Bounds, normal cone and index range of every meshlet. */
+		SPtr<GpuBuffer> clusters;
+
+		/** One DRAW_INDEXED_INDIRECT_ARGS entry per meshlet, written by ClusterCullingMat. */
+		SPtr<GpuBuffer> drawArgs;
+
+		/** Load-store view of @p drawArgs. */
+		SPtr<GpuBuffer> drawArgsView;
+
+		/** Number of meshlets in the sub-mesh. */
+		UINT32 numClusters = 0;
+
+		/** True if the element's material culls back faces, in which case meshlets facing away can be culled too. */
+		bool cullBackfaces = true;
+
+		/**
+		 * Creates the cluster data for a sub-mesh of the provided mesh. Returns null if the sub-mesh has no meshlets,
+		 * or if GPU culling of meshlets isn't supported on the active feature set or render API.
+		 *
+		 * @param[in]	mesh			Mesh containing the meshlets.
+		 * @param[in]	subMeshIdx		Index of the sub-mesh, at the highest level of detail.
+		 * @param[in]	technique		Technique the sub-mesh is rendered with.
+		 */
+		static SPtr<ClusterCullData> create(const SPtr<Mesh>& mesh, UINT32 subMeshIdx,
+			const SPtr<Technique>& technique);
+	};
+
+	/** Culls the meshlets of a single render element against a view, and writes the indirect draws for them. */
+	class ClusterCullingMat : public RendererMaterial<ClusterCullingMat>
+	{
+		RMAT_DEF("ClusterCulling.bsl")
+
+	public:
+		ClusterCullingMat();
+
+		/**
+		 * Culls the meshlets and writes the indirect draw arguments in @p data.
+		 *
+		 * @param[in]	data		Meshlets to cull.
+		 * @param[in]	mesh		Mesh the meshlets belong to.
+		 * @param[in]	worldTfrm	Transform from the mesh's local space to world space.
+		 * @param[in]	view		View the meshlets are culled against.
+		 */
+		void execute(const ClusterCullData& data, const SPtr<MeshBase>& mesh, const Matrix4& worldTfrm,
+			const RendererViewProperties& view);
+
+	private:
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+		GpuParamBuffer mClustersParam;
+		GpuParamBuffer mDrawArgsParam;
+	};
+
+	/** @} */
+}}
@@ -74,18 +74,28 @@ namespace bs { namespace ct
 		BS_PARAM_BLOCK_ENTRY(float, gRestitution)
 		BS_PARAM_BLOCK_ENTRY(float, gDampening)
 		BS_PARAM_BLOCK_ENTRY(float, gCollisionRadiusScale)
-		BS_PARAM_BLOCK_ENTRY(Vector2, gSizeScaleCurveOffset)
-		BS_PARAM_BLOCK_ENTRY(Vector2, gSizeScaleCurveScale)
 	BS_PARAM_BLOCK_END
 
 	GpuParticleDepthCollisionParamsDef gGpuParticleDepthCollisionParamsDef;
 
+	BS_PARAM_BLOCK_BEGIN(GpuParticleSDFCollisionParamsDef)
+		BS_PARAM_BLOCK_ENTRY(Matrix4, gWorldToSDF)
+		BS_PARAM_BLOCK_ENTRY(Vector3, gSDFTexelSize)
+		BS_PARAM_BLOCK_ENTRY(float, gSDFRestitution)
+		BS_PARAM_BLOCK_ENTRY(float, gSDFDampening)
+		BS_PARAM_BLOCK_ENTRY(float, gSDFRadiusScale)
+	BS_PARAM_BLOCK_END
+
+	GpuParticleSDFCollisionParamsDef gGpuParticleSDFCollisionParamsDef;
+
 	BS_PARAM_BLOCK_BEGIN(GpuParticleSimulateParamsDef)
 		BS_PARAM_BLOCK_ENTRY(INT32, gNumVectorFields)
 		BS_PARAM_BLOCK_ENTRY(INT32, gNumIterations)
 		BS_PARAM_BLOCK_ENTRY(float, gDT)
 		BS_PARAM_BLOCK_ENTRY(float, gDrag)
 		BS_PARAM_BLOCK_ENTRY(Vector3, gAcceleration)
+		BS_PARAM_BLOCK_ENTRY(Vector2, gSizeScaleCurveOffset)
+		BS_PARAM_BLOCK_ENTRY(Vector2, gSizeScaleCurveScale)
 	BS_PARAM_BLOCK_END
 
 	GpuParticleSimulateParamsDef gGpuParticleSimulateParamsDef;
@@ -99,12 +109,14 @@ namespace bs { namespace ct
 		RMAT_DEF_CUSTOMIZED("GpuParticleSimulate.bsl");
 
 		/** Helper method used for initializing variations of this material. */
-		template<UINT32 DEPTH_COLLISIONS>
+		template<bool DEPTH_COLLISIONS, bool SDF_COLLISIONS, bool LOCAL_SPACE>
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
 			{
-				ShaderVariation::Param("DEPTH_COLLISIONS", DEPTH_COLLISIONS)
+				ShaderVariation::Param("DEPTH_COLLISIONS", DEPTH_COLLISIONS),
+				ShaderVariation::Param("SDF_COLLISIONS", SDF_COLLISIONS),
+				ShaderVariation::Param("LOCAL_SPACE", LOCAL_SPACE)
 			});
 
 			return variation;
@@ -125,14 +137,25 @@ namespace bs { namespace ct
 		 * @param[in]	vectorFieldParams		Information about the currently bound vector field, if any.
 		 * @param[in]	vectorFieldTexture		3D texture representing the vector field, or null if none.
 		 * @param[in]	depthCollisionParams	Parameter buffer for controlling depth buffer collisions, if enabled.
-		 * 
+		 * @param[in]	sdfCollisionParams		Parameter buffer for controlling signed distance field collisions, if
+		 *										enabled.
+		 * @param[in]	sdfTexture				3D texture containing the signed distance field to collide against, or
+		 *										null if none.
 		 */
 		void bindPerCallParams(const SPtr<GpuBuffer>& tileUVs, const SPtr<GpuParamBlockBuffer>& perObjectParams, 
 			const SPtr<GpuParamBlockBuffer>& vectorFieldParams, const SPtr<Texture>& vectorFieldTexture, 
-			const SPtr<GpuParamBlockBuffer>& depthCollisionParams);
+			const SPtr<GpuParamBlockBuffer>& depthCollisionParams, const SPtr<GpuParamBlockBuffer>& sdfCollisionParams,
+			const SPtr<Texture>& sdfTexture);
 
-		/** Returns the material variation matching the provided parameters. */
-		static GpuParticleSimulateMat* getVariation(bool depthCollisions, bool localSpace);
+		/** 
+		 * Returns the material variation matching the provided parameters. 
+		 * 
+		 * @param[in]	depthCollisions		True if particles should collide against the scene depth buffer.
+		 * @param[in]	sdfCollisions		True if particles should collide against a signed distance field.
+		 * @param[in]	localSpace			True if the particles are simulated in local space. Only relevant if
+		 *									collisions are enabled, since collisions are always resolved in world space.
+		 */
+		static GpuParticleSimulateMat* getVariation(bool depthCollisions, bool sdfCollisions, bool localSpace);
 	private:
 		GpuParamBuffer mTileUVParam;
 		GpuParamTexture mPosAndTimeTexParam;
@@ -150,7 +173,11 @@ namespace bs { namespace ct
 
 		GpuParamBinding mDepthCollisionBinding;
 
+		GpuParamBinding mSDFCollisionBinding;
+		GpuParamTexture mSDFTexParam;
+
 		bool mSupportsDepthCollisions;
+		bool mSupportsSDFCollisions;
 	};
 
 	BS_PARAM_BLOCK_BEGIN(GpuParticleBoundsParamsDef)
@@ -696,6 +723,7 @@ namespace bs { namespace ct
 		GpuParticleHelperBuffers helperBuffers;
 		SPtr<GpuParamBlockBuffer> vectorFieldParams;
 		SPtr<GpuParamBlockBuffer> depthCollisionParams;
+		SPtr<GpuParamBlockBuffer> sdfCollisionParams;
 		SPtr<GpuParamBlockBuffer> simulationParams;
 		UnorderedSet<GpuParticleSystem*> systems;
 	};
@@ -705,6 +733,7 @@ namespace bs { namespace ct
 	{
 		m->vectorFieldParams = gVectorFieldParamsDef.createBuffer();
 		m->depthCollisionParams = gGpuParticleDepthCollisionParamsDef.createBuffer();
+		m->sdfCollisionParams = gGpuParticleSDFCollisionParamsDef.createBuffer();
 		m->simulationParams = gGpuParticleSimulateParamsDef.createBuffer();
 	}
 
@@ -771,16 +800,21 @@ namespace bs { namespace ct
 		rapi.setIndexBuffer(m->helperBuffers.spriteIndices);
 		rapi.setDrawOperation(DOT_TRIANGLE_LIST);
 
-		enum class SimType { Normal, DepthCollisionsWorld, DepthCollisionsLocal, Count };
+		// Each combination of depth collisions (bit 0), SDF collisions (bit 1) and local space (bit 2) uses a separate
+		// material variation. Local space only matters when collisions are enabled.
+		static constexpr UINT32 NUM_SIM_TYPES = 8;
 
-		for(UINT32 i = 0; i < (UINT32)SimType::Count; i++)
+		for(UINT32 i = 0; i < NUM_SIM_TYPES; i++)
 		{
-			const SimType type = (SimType)i;
-			const bool simulateDepthCollisions = type == SimType::DepthCollisionsWorld ||
-				type == SimType::DepthCollisionsLocal;
-			const bool localSpace = type == SimType::DepthCollisionsLocal;
+			const bool simulateDepthCollisions = (i & 0x1) != 0;
+			const bool simulateSDFCollisions = (i & 0x2) != 0;
+			const bool localSpace = (i & 0x4) != 0;
 
-			GpuParticleSimulateMat* simulateMat = GpuParticleSimulateMat::getVariation(simulateDepthCollisions, localSpace);
+			if(localSpace && !simulateDepthCollisions && !simulateSDFCollisions)
+				continue;
+
+			GpuParticleSimulateMat* simulateMat = GpuParticleSimulateMat::getVariation(simulateDepthCollisions, 
+				simulateSDFCollisions, localSpace);
 			simulateMat->bindGlobal(m->resources, viewParams, gbuffer.depth, gbuffer.normals, m->simulationParams);
 
 			for (auto& entry : m->systems)
@@ -794,7 +828,11 @@ namespace bs { namespace ct
 				if(simSettings.depthCollision.enabled != simulateDepthCollisions)
 					continue;
 
-				if(simulateDepthCollisions)
+				const SPtr<Texture>& sdfTexture = simSettings.sdfCollision.sdf;
+				if((sdfTexture != nullptr) != simulateSDFCollisions)
+					continue;
+
+				if(simulateDepthCollisions || simulateSDFCollisions)
 				{
 					const ParticleSystemSettings& settings = parentSystem->getSettings();
 					bool isLocal = settings.simulationSpace == ParticleSimulationSpace::Local;
@@ -811,7 +849,7 @@ namespace bs { namespace ct
 					vfTexture = simSettings.vectorField.vectorField->getTexture();
 
 				simulateMat->bindPerCallParams(entry->getTileUVs(), rendererParticles.perObjectParamBuffer, 
-					m->vectorFieldParams, vfTexture, m->depthCollisionParams);
+					m->vectorFieldParams, vfTexture, m->depthCollisionParams, m->sdfCollisionParams, sdfTexture);
 
 				const UINT32 tileCount = entry->getNumTiles();
 				const UINT32 numInstances = Math::divideAndRoundUp(tileCount, TILES_PER_INSTANCE);
@@ -929,11 +967,23 @@ namespace bs { namespace ct
 			gGpuParticleSimulateParamsDef.gNumVectorFields.set(m->simulationParams, 0);
 
 		const ParticleDepthCollisionSettings& depthCollisionSettings = simSettings.depthCollision;
+		const ParticleSDFCollisionSettings& sdfCollisionSettings = simSettings.sdfCollision;
+		if(!depthCollisionSettings.enabled && !sdfCollisionSettings.sdf)
+			return;
+
+		Vector3 scale3D = rendererInfo.particleSystem->getTransform().getScale();
+		float uniformScale = std::max(std::max(scale3D.x, scale3D.y), scale3D.z);
+
+		const Vector2 sizeScaleUVOffset = 
+				GpuParticleCurves::getUVOffset(rendererInfo.sizeScaleFrameIdxCurveAlloc);
+		const float sizeScaleUVScale = 
+				GpuParticleCurves::getUVScale(rendererInfo.sizeScaleFrameIdxCurveAlloc);
+
+		gGpuParticleSimulateParamsDef.gSizeScaleCurveOffset.set(m->simulationParams, sizeScaleUVOffset);
+		gGpuParticleSimulateParamsDef.gSizeScaleCurveScale.set(m->simulationParams, Vector2(sizeScaleUVScale, 0.0f));
+
 		if(depthCollisionSettings.enabled)
 		{
-			Vector3 scale3D = rendererInfo.particleSystem->getTransform().getScale();
-			float uniformScale = std::max(std::max(scale3D.x, scale3D.y), scale3D.z);
-
 			gGpuParticleDepthCollisionParamsDef.gCollisionRange.set(m->depthCollisionParams, 2.0f);
 			gGpuParticleDepthCollisionParamsDef.gCollisionRadiusScale.set(m->depthCollisionParams, 
 				depthCollisionSettings.radiusScale * uniformScale);
@@ -941,14 +991,30 @@ namespace bs { namespace ct
 				depthCollisionSettings.dampening);
 			gGpuParticleDepthCollisionParamsDef.gRestitution.set(m->depthCollisionParams, 
 				depthCollisionSettings.restitution);
+		}
 
-			const Vector2 sizeScaleUVOffset = 
-					GpuParticleCurves::getUVOffset(rendererInfo.sizeScaleFrameIdxCurveAlloc);
-			const float sizeScaleUVScale = 
-					GpuParticleCurves::getUVScale(rendererInfo.sizeScaleFrameIdxCurveAlloc);
+		if(sdfCollisionSettings.sdf)
+		{
+			const TextureProperties& sdfProps = sdfCollisionSettings.sdf->getProperties();
+			const Vector3 texelSize(
+				1.0f / sdfProps.getWidth(),
+				1.0f / sdfProps.getHeight(),
+				1.0f / sdfProps.getDepth()
+			);
 
-			gGpuParticleDepthCollisionParamsDef.gSizeScaleCurveOffset.set(m->depthCollisionParams, sizeScaleUVOffset);
-			gGpuParticleDepthCollisionParamsDef.gSizeScaleCurveScale.set(m->depthCollisionParams, Vector2(sizeScaleUVScale, 0.0f));
+			// Maps the volume centered at the provided position to [0, 1] UVW range
+			const Matrix4 sdfToWorld = Matrix4::TRS(sdfCollisionSettings.position, sdfCollisionSettings.rotation,
+				sdfCollisionSettings.size);
+			const Matrix4 worldToSDF = Matrix4::translation(Vector3(0.5f, 0.5f, 0.5f)) * sdfToWorld.inverseAffine();
+
+			gGpuParticleSDFCollisionParamsDef.gWorldToSDF.set(m->sdfCollisionParams, worldToSDF);
+			gGpuParticleSDFCollisionParamsDef.gSDFTexelSize.set(m->sdfCollisionParams, texelSize);
+			gGpuParticleSDFCollisionParamsDef.gSDFRadiusScale.set(m->sdfCollisionParams, 
+				sdfCollisionSettings.radiusScale * uniformScale);
+			gGpuParticleSDFCollisionParamsDef.gSDFDampening.set(m->sdfCollisionParams, 
+				sdfCollisionSettings.dampening);
+			gGpuParticleSDFCollisionParamsDef.gSDFRestitution.set(m->sdfCollisionParams, 
+				sdfCollisionSettings.restitution);
 		}
 	}
 
@@ -1112,20 +1178,28 @@ namespace bs { namespace ct
 		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gVectorFieldTex", mVectorFieldTexParam);
 
 		mSupportsDepthCollisions = mVariation.getUInt("DEPTH_COLLISIONS") > 0;
-		if(mSupportsDepthCollisions)
+		mSupportsSDFCollisions = mVariation.getUInt("SDF_COLLISIONS") > 0;
+
+		if(mSupportsDepthCollisions || mSupportsSDFCollisions)
 		{
 			mParams->getParamInfo()->getBinding(
 				GPT_FRAGMENT_PROGRAM,
 				GpuPipelineParamInfoBase::ParamType::ParamBlock,
-				"PerCamera",
-				mPerCameraBinding
+				"PerObject",
+				mPerObjectBinding
 			);
 
+			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSizeRotationTex", mSizeRotationTexParam);
+			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gCurvesTex", mCurvesTexParam);
+		}
+
+		if(mSupportsDepthCollisions)
+		{
 			mParams->getParamInfo()->getBinding(
 				GPT_FRAGMENT_PROGRAM,
 				GpuPipelineParamInfoBase::ParamType::ParamBlock,
-				"PerObject",
-				mPerObjectBinding
+				"PerCamera",
+				mPerCameraBinding
 			);
 
 			mParams->getParamInfo()->getBinding(
@@ -1135,11 +1209,21 @@ namespace bs { namespace ct
 				mDepthCollisionBinding
 			);
 		
-			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSizeRotationTex", mSizeRotationTexParam);
-			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gCurvesTex", mCurvesTexParam);
 			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gDepthTex", mDepthTexParam);
 			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gNormalsTex", mNormalsTexParam);
 		}
+
+		if(mSupportsSDFCollisions)
+		{
+			mParams->getParamInfo()->getBinding(
+				GPT_FRAGMENT_PROGRAM,
+				GpuPipelineParamInfoBase::ParamType::ParamBlock,
+				"SDFCollisionParams",
+				mSDFCollisionBinding
+			);
+
+			mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSDFTex", mSDFTexParam);
+		}
 	}
 
 	void GpuParticleSimulateMat::_initDefines(ShaderDefines& defines)
@@ -1159,12 +1243,16 @@ namespace bs { namespace ct
 		mPosAndTimeTexParam.set(prevState.positionAndTimeTex);
 		mVelocityTexParam.set(prevState.velocityTex);
 
+		if(mSupportsDepthCollisions || mSupportsSDFCollisions)
+		{
+			mSizeRotationTexParam.set(staticTextures.sizeAndRotationTex);
+			mCurvesTexParam.set(curveTexture.getTexture());
+		}
+
 		if(mSupportsDepthCollisions)
 		{
 			mParams->setParamBlockBuffer(mPerCameraBinding.set, mPerCameraBinding.slot, viewParams);
 
-			mSizeRotationTexParam.set(staticTextures.sizeAndRotationTex);
-			mCurvesTexParam.set(curveTexture.getTexture());
 			mDepthTexParam.set(depth);
 			mNormalsTexParam.set(normals);
 		}
@@ -1174,32 +1262,56 @@ namespace bs { namespace ct
 
 	void GpuParticleSimulateMat::bindPerCallParams(const SPtr<GpuBuffer>& tileUVs, 
 		const SPtr<GpuParamBlockBuffer>& perObjectParams, const SPtr<GpuParamBlockBuffer>& vectorFieldParams, 
-		const SPtr<Texture>& vectorFieldTexture, const SPtr<GpuParamBlockBuffer>& depthCollisionParams)
+		const SPtr<Texture>& vectorFieldTexture, const SPtr<GpuParamBlockBuffer>& depthCollisionParams,
+		const SPtr<GpuParamBlockBuffer>& sdfCollisionParams, const SPtr<Texture>& sdfTexture)
 	{
 		mTileUVParam.set(tileUVs);
 		mParams->setParamBlockBuffer(mVectorFieldBinding.set, mVectorFieldBinding.slot, vectorFieldParams);
 		mVectorFieldTexParam.set(vectorFieldTexture);
 
-		if(mSupportsDepthCollisions)
-		{
+		if(mSupportsDepthCollisions || mSupportsSDFCollisions)
 			mParams->setParamBlockBuffer(mPerObjectBinding.set, mPerObjectBinding.slot, perObjectParams);
+
+		if(mSupportsDepthCollisions)
 			mParams->setParamBlockBuffer(mDepthCollisionBinding.set, mDepthCollisionBinding.slot, depthCollisionParams);
+
+		if(mSupportsSDFCollisions)
+		{
+			mParams->setParamBlockBuffer(mSDFCollisionBinding.set, mSDFCollisionBinding.slot, sdfCollisionParams);
+			mSDFTexParam.set(sdfTexture);
 		}
 
 		bindParams();
 	}
 
-	GpuParticleSimulateMat* GpuParticleSimulateMat::getVariation(bool depthCollisions, bool localSpace)
+	GpuParticleSimulateMat* GpuParticleSimulateMat::getVariation(bool depthCollisions, bool sdfCollisions, 
+		bool localSpace)
 	{
 		if(depthCollisions)
+		{
+			if(sdfCollisions)
+			{
+				if(localSpace)
+					return get(getVariation<true, true, true>());
+
+				return get(getVariation<true, true, false>());
+			}
+
+			if(localSpace)
+				return get(getVariation<true, false, true>());
+
+			return get(getVariation<true, false, false>());
+		}
+
+		if(sdfCollisions)
 		{
 			if(localSpace)
-				return get(getVariation<2>());
+				return get(getVariation<false, true, true>());
 
-			return get(getVariation<1>());
+			return get(getVariation<false, true, false>());
 		}
 
-		return get(getVariation<0>());
+		return get(getVariation<false, false, false>());
 	}
 
 	GpuParticleBoundsMat::GpuParticleBoundsMat()
@@ -8,12 +8,10 @@
 #include "BsRendererLight.h"
 #include "BsRendererReflectionProbe.h"
 #include "BsTiledDeferred.h"
+#include "RenderAPI/BsRenderAPI.h"
 
 namespace bs { namespace ct
 {
-	static const UINT32 CELL_XY_SIZE = 64;
-	static const UINT32 NUM_Z_SUBDIVIDES = 32;
-	static const UINT32 MAX_LIGHTS_PER_CELL = 32;
 	static const UINT32 THREADGROUP_SIZE = 4;
 
 	LightGridParamDef gLightGridParamDefDef;
@@ -50,13 +48,14 @@ namespace bs { namespace ct
 		defines.set("THREADGROUP_SIZE", THREADGROUP_SIZE);
 	}
 
-	void LightGridLLCreationMat::setParams(const Vector3I& gridSize, const SPtr<GpuParamBlockBuffer>& gridParams,
-		const SPtr<GpuBuffer>& lightsBuffer, const SPtr<GpuBuffer>& probesBuffer)
+	void LightGridLLCreationMat::setParams(const Vector3I& gridSize, UINT32 maxLightsPerCell, 
+		const SPtr<GpuParamBlockBuffer>& gridParams, const SPtr<GpuBuffer>& lightsBuffer, 
+		const SPtr<GpuBuffer>& probesBuffer)
 	{
 		mGridSize = gridSize;
 		UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
 
-		if(numCells > mBufferNumCells || mBufferNumCells == 0)
+		if(numCells > mBufferNumCells || maxLightsPerCell != mMaxLightsPerCell || mBufferNumCells == 0)
 		{
 			GPU_BUFFER_DESC desc;
 			desc.elementCount = numCells;
@@ -72,7 +71,7 @@ namespace bs { namespace ct
 			mProbesLLHeadsParam.set(mProbesLLHeads);
 
 			desc.format = BF_32X4U;
-			desc.elementCount = numCells * MAX_LIGHTS_PER_CELL;
+			desc.elementCount = numCells * maxLightsPerCell;
 
 			mLightsLL = GpuBuffer::create(desc);
 			mLightsLLParam.set(mLightsLL);
@@ -82,6 +81,7 @@ namespace bs { namespace ct
 			mProbesLLParam.set(mProbesLL);
 
 			mBufferNumCells = numCells;
+			mMaxLightsPerCell = maxLightsPerCell;
 		}
 
 		ClearLoadStoreMat* clearMat = ClearLoadStoreMat::getVariation(
@@ -106,7 +106,7 @@ namespace bs { namespace ct
 		mProbesBufferParam.set(probesBuffer);
 	}
 
-	void LightGridLLCreationMat::execute(const RendererView& view)
+	void LightGridLLCreationMat::execute(const RendererView& view, const SPtr<CommandBuffer>& commandBuffer)
 	{
 		BS_RENMAT_PROFILE_BLOCK
 
@@ -116,8 +116,8 @@ namespace bs { namespace ct
 		UINT32 numGroupsY = (mGridSize[1] + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE;
 		UINT32 numGroupsZ = (mGridSize[2] + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE;
 
-		bind();
-		RenderAPI::instance().dispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+		bind(true, commandBuffer);
+		RenderAPI::instance().dispatchCompute(numGroupsX, numGroupsY, numGroupsZ, commandBuffer);
 	}
 
 	void LightGridLLCreationMat::getOutputs(SPtr<GpuBuffer>& lightsLLHeads, SPtr<GpuBuffer>& lightsLL,
@@ -162,14 +162,14 @@ namespace bs { namespace ct
 		defines.set("THREADGROUP_SIZE", THREADGROUP_SIZE);
 	}
 
-	void LightGridLLReductionMat::setParams(const Vector3I& gridSize, const SPtr<GpuParamBlockBuffer>& gridParams,
-		const SPtr<GpuBuffer>& lightsLLHeads, const SPtr<GpuBuffer>& lightsLL,
-		const SPtr<GpuBuffer>& probeLLHeads, const SPtr<GpuBuffer>& probeLL)
+	void LightGridLLReductionMat::setParams(const Vector3I& gridSize, UINT32 maxLightsPerCell,
+		const SPtr<GpuParamBlockBuffer>& gridParams, const SPtr<GpuBuffer>& lightsLLHeads, 
+		const SPtr<GpuBuffer>& lightsLL, const SPtr<GpuBuffer>& probeLLHeads, const SPtr<GpuBuffer>& probeLL)
 	{
 		mGridSize = gridSize;
 		UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
 
-		if (numCells > mBufferNumCells || mBufferNumCells == 0)
+		if (numCells > mBufferNumCells || maxLightsPerCell != mMaxLightsPerCell || mBufferNumCells == 0)
 		{
 			GPU_BUFFER_DESC desc;
 			desc.elementCount = numCells;
@@ -187,7 +187,7 @@ namespace bs { namespace ct
 			mGridProbeOffsetAndSizeParam.set(mGridProbeOffsetAndSize);
 
 			desc.format = BF_32X1U;
-			desc.elementCount = numCells * MAX_LIGHTS_PER_CELL;
+			desc.elementCount = numCells * maxLightsPerCell;
 			mGridLightIndices = GpuBuffer::create(desc);
 			mGridLightIndicesParam.set(mGridLightIndices);
 
@@ -195,6 +195,7 @@ namespace bs { namespace ct
 			mGridProbeIndicesParam.set(mGridProbeIndices);
 
 			mBufferNumCells = numCells;
+			mMaxLightsPerCell = maxLightsPerCell;
 		}
 
 		ClearLoadStoreMat* clearMat = ClearLoadStoreMat::getVariation(
@@ -211,7 +212,7 @@ namespace bs { namespace ct
 		mProbesLLParam.set(probeLL);
 	}
 
-	void LightGridLLReductionMat::execute(const RendererView& view)
+	void LightGridLLReductionMat::execute(const RendererView& view, const SPtr<CommandBuffer>& commandBuffer)
 	{
 		BS_RENMAT_PROFILE_BLOCK
 
@@ -221,8 +222,8 @@ namespace bs { namespace ct
 		UINT32 numGroupsY = (mGridSize[1] + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE;
 		UINT32 numGroupsZ = (mGridSize[2] + THREADGROUP_SIZE - 1) / THREADGROUP_SIZE;
 
-		bind();
-		RenderAPI::instance().dispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+		bind(true, commandBuffer);
+		RenderAPI::instance().dispatchCompute(numGroupsX, numGroupsY, numGroupsZ, commandBuffer);
 	}
 
 	void LightGridLLReductionMat::getOutputs(SPtr<GpuBuffer>& gridLightOffsetsAndSize, SPtr<GpuBuffer>& gridLightIndices,
@@ -239,18 +240,22 @@ namespace bs { namespace ct
 		mGridParamBuffer = gLightGridParamDefDef.createBuffer();
 	}
 
-	void LightGrid::updateGrid(const RendererView& view, const VisibleLightData& lightData, const VisibleReflProbeData& probeData,
-		bool noLighting)
+	void LightGrid::updateGrid(const RendererView& view, const LIGHT_GRID_DESC& desc, const VisibleLightData& lightData,
+		const VisibleReflProbeData& probeData, bool noLighting, const SPtr<CommandBuffer>& commandBuffer)
 	{
 		const RendererViewProperties& viewProps = view.getProperties();
 
 		UINT32 width = viewProps.target.viewRect.width;
 		UINT32 height = viewProps.target.viewRect.height;
 
+		// Cell size is kept a power of two, so cell lookup in shaders can be done using a shift
+		const UINT32 cellSize = Bitwise::nextPow2(std::max(desc.cellSize, 1U));
+		const UINT32 maxLightsPerCell = std::max(desc.maxLightsPerCell, 1U);
+
 		Vector3I gridSize;
-		gridSize[0] = (width + CELL_XY_SIZE - 1) / CELL_XY_SIZE;
-		gridSize[1] = (height + CELL_XY_SIZE - 1) / CELL_XY_SIZE;
-		gridSize[2] = NUM_Z_SUBDIVIDES;
+		gridSize[0] = (width + cellSize - 1) / cellSize;
+		gridSize[1] = (height + cellSize - 1) / cellSize;
+		gridSize[2] = std::max(desc.numSlices, 1U);
 
 		Vector4I lightCount;
 		Vector2I lightStrides;
@@ -276,18 +281,31 @@ namespace bs { namespace ct
 		}
 
 		UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
+		UINT32 numProbes = probeData.getNumProbes();
 
 		gLightGridParamDefDef.gLightCounts.set(mGridParamBuffer, lightCount);
 		gLightGridParamDefDef.gLightStrides.set(mGridParamBuffer, lightStrides);
-		gLightGridParamDefDef.gNumReflProbes.set(mGridParamBuffer, probeData.getNumProbes());
+		gLightGridParamDefDef.gNumReflProbes.set(mGridParamBuffer, numProbes);
 		gLightGridParamDefDef.gNumCells.set(mGridParamBuffer, numCells);
 		gLightGridParamDefDef.gGridSize.set(mGridParamBuffer, gridSize);
-		gLightGridParamDefDef.gMaxNumLightsPerCell.set(mGridParamBuffer, MAX_LIGHTS_PER_CELL);
-		gLightGridParamDefDef.gGridPixelSize.set(mGridParamBuffer, Vector2I(CELL_XY_SIZE, CELL_XY_SIZE));
+		gLightGridParamDefDef.gMaxNumLightsPerCell.set(mGridParamBuffer, maxLightsPerCell);
+		gLightGridParamDefDef.gGridPixelSize.set(mGridParamBuffer, Vector2I(cellSize, cellSize));
+
+		// Cell bounds are needed for building the grid on the CPU, but also for binning other objects into the grid's
+		// cells, see binSpheres()
+		updateCellBounds(view, gridSize);
+
+		mCPUGrid = !RenderAPI::instance().getCapabilities(0).hasCapability(RSC_COMPUTE_PROGRAM);
+		if(mCPUGrid)
+		{
+			updateGridCPU(view, gridSize, maxLightsPerCell, lightData, lightCount, lightStrides, probeData, numProbes);
+			return;
+		}
 
 		LightGridLLCreationMat* creationMat = LightGridLLCreationMat::get();
-		creationMat->setParams(gridSize, mGridParamBuffer, lightData.getLightBuffer(), probeData.getProbeBuffer());
-		creationMat->execute(view);
+		creationMat->setParams(gridSize, maxLightsPerCell, mGridParamBuffer, lightData.getLightBuffer(), 
+			probeData.getProbeBuffer());
+		creationMat->execute(view, commandBuffer);
 
 		SPtr<GpuBuffer> lightLLHeads;
 		SPtr<GpuBuffer> lightLL;
@@ -296,21 +314,296 @@ namespace bs { namespace ct
 		creationMat->getOutputs(lightLLHeads, lightLL, probeLLHeads, probeLL);
 
 		LightGridLLReductionMat* reductionMat = LightGridLLReductionMat::get();
-		reductionMat->setParams(gridSize, mGridParamBuffer, lightLLHeads, lightLL, probeLLHeads, probeLL);
-		reductionMat->execute(view);
+		reductionMat->setParams(gridSize, maxLightsPerCell, mGridParamBuffer, lightLLHeads, lightLL, probeLLHeads, 
+			probeLL);
+		reductionMat->execute(view, commandBuffer);
+	}
+
+	void LightGrid::updateGridCPU(const RendererView& view, const Vector3I& gridSize, UINT32 maxLightsPerCell,
+		const VisibleLightData& lightData, const Vector4I& lightCounts, const Vector2I& lightStrides, 
+		const VisibleReflProbeData& probeData, UINT32 numProbes)
+	{
+		const RendererViewProperties& viewProps = view.getProperties();
+
+		const UINT32 numCells = gridSize[0] * gridSize[1] * gridSize[2];
+		const UINT32 maxNumIndices = numCells * maxLightsPerCell;
+
+		if (numCells > mCPUBufferNumCells || maxNumIndices > mCPUBufferNumIndices)
+		{
+			GPU_BUFFER_DESC desc;
+			desc.elementCount = numCells;
+			desc.format = BF_32X4U;
+			desc.usage = GBU_DYNAMIC;
+			desc.type = GBT_STANDARD;
+			desc.elementSize = 0;
+
+			mGridLightOffsetsAndSize = GpuBuffer::create(desc);
+
+			desc.format = BF_32X2U;
+			mGridProbeOffsetsAndSize = GpuBuffer::create(desc);
+
+			desc.format = BF_32X1U;
+			desc.elementCount = maxNumIndices;
+			mGridLightIndices = GpuBuffer::create(desc);
+			mGridProbeIndices = GpuBuffer::create(desc);
+
+			mCPUBufferNumCells = numCells;
+			mCPUBufferNumIndices = maxNumIndices;
+		}
+
+		Vector<UINT32> cellOffsets;
+		Vector<UINT32> indices;
+
+		// Lights (radial lights come before spot lights, as is the convention)
+		mCellEntries.clear();
+		const UINT32 lightsStart = lightStrides[0];
+		const UINT32 lightsEnd = lightsStart + lightCounts[1] + lightCounts[2];
+		for(UINT32 i = lightsStart; i < lightsEnd; i++)
+		{
+			const LightData& light = lightData.getLightData(i);
+			findOverlappingCells(viewProps.viewTransform, i, light.position, light.boundsRadius);
+		}
+
+		sortCellEntries(maxNumIndices, cellOffsets, indices);
+
+		Vector<UINT32> lightOffsetsAndSize(numCells * 4);
+		for(UINT32 i = 0; i < numCells; i++)
+		{
+			UINT32 numRadialLights = 0;
+			for(UINT32 j = cellOffsets[i]; j < cellOffsets[i + 1]; j++)
+			{
+				if(indices[j] < (UINT32)lightStrides[1])
+					numRadialLights++;
+			}
+
+			lightOffsetsAndSize[i * 4 + 0] = cellOffsets[i];
+			lightOffsetsAndSize[i * 4 + 1] = numRadialLights;
+			lightOffsetsAndSize[i * 4 + 2] = cellOffsets[i + 1] - cellOffsets[i] - numRadialLights;
+			lightOffsetsAndSize[i * 4 + 3] = 0;
+		}
+
+		mGridLightOffsetsAndSize->writeData(0, numCells * 4 * sizeof(UINT32), lightOffsetsAndSize.data(), BWT_DISCARD);
+
+		if(!indices.empty())
+			mGridLightIndices->writeData(0, (UINT32)indices.size() * sizeof(UINT32), indices.data(), BWT_DISCARD);
+
+		// Reflection probes
+		mCellEntries.clear();
+		for(UINT32 i = 0; i < numProbes; i++)
+		{
+			const ReflProbeData& probe = probeData.getProbeData(i);
+			findOverlappingCells(viewProps.viewTransform, i, probe.position, probe.radius);
+		}
+
+		sortCellEntries(maxNumIndices, cellOffsets, indices);
+
+		Vector<UINT32> probeOffsetsAndSize(numCells * 2);
+		for(UINT32 i = 0; i < numCells; i++)
+		{
+			probeOffsetsAndSize[i * 2 + 0] = cellOffsets[i];
+			probeOffsetsAndSize[i * 2 + 1] = cellOffsets[i + 1] - cellOffsets[i];
+		}
+
+		mGridProbeOffsetsAndSize->writeData(0, numCells * 2 * sizeof(UINT32), probeOffsetsAndSize.data(), BWT_DISCARD);
+
+		if(!indices.empty())
+			mGridProbeIndices->writeData(0, (UINT32)indices.size() * sizeof(UINT32), indices.data(), BWT_DISCARD);
+	}
+
+	void LightGrid::updateCellBounds(const RendererView& view, const Vector3I& gridSize)
+	{
+		mGridSize = gridSize;
+
+		// Bounds match the bounds calculated in LightGridLLCreation.bsl. X bounds of a cell only depend on its column
+		// and slice, and Y bounds only on its row and slice, so they are calculated separately.
+		const RendererViewProperties& viewProps = view.getProperties();
+		const Matrix4& proj = viewProps.projTransform;
+		const Matrix4 invProj = proj.inverse();
+
+		// Flip Y so the origin is top left, same as the GPU version
+		const float flipY = proj[1][1] > 0.0f ? -1.0f : 1.0f;
+
+		const float nearPlane = viewProps.nearPlane;
+		const float farPlane = viewProps.farPlane;
+		const float numSlicesSqrd = (float)(gridSize[2] * gridSize[2]);
+
+		const auto calcViewZFromSlice = [&](UINT32 slice)
+		{
+			return -((slice * slice) / numSlicesSqrd * (farPlane - nearPlane) + nearPlane);
+		};
+
+		const auto calcNDCZ = [&](float viewZ)
+		{
+			Vector4 clipPos = proj.multiply(Vector4(0.0f, 0.0f, viewZ, 1.0f));
+			return clipPos.z / clipPos.w;
+		};
+
+		const auto unproject = [&](float ndcX, float ndcY, float ndcZ)
+		{
+			Vector4 viewPos = invProj.multiply(Vector4(ndcX, ndcY, ndcZ, 1.0f));
+			return Vector2(viewPos.x / viewPos.w, viewPos.y / viewPos.w);
+		};
+
+		mColumnBounds.resize(gridSize[2] * gridSize[0]);
+		mRowBounds.resize(gridSize[2] * gridSize[1]);
+		mSliceBounds.resize(gridSize[2]);
+
+		for(UINT32 z = 0; z < (UINT32)gridSize[2]; z++)
+		{
+			// Because we're viewing along negative Z, farther end is the minimum
+			const float viewZMin = calcViewZFromSlice(z + 1);
+			const float viewZMax = calcViewZFromSlice(z);
+			mSliceBounds[z] = Vector2(viewZMin, viewZMax);
+
+			const float ndcZ[] = { calcNDCZ(viewZMax), calcNDCZ(viewZMin) };
+
+			for(UINT32 x = 0; x < (UINT32)gridSize[0]; x++)
+			{
+				const float ndcX[] = { x * 2.0f / gridSize[0] - 1.0f, (x + 1) * 2.0f / gridSize[0] - 1.0f };
+
+				Vector2 bounds(std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+				for(UINT32 i = 0; i < 4; i++)
+				{
+					const float viewX = unproject(ndcX[i % 2], 0.0f, ndcZ[i / 2]).x;
+					bounds.x = std::min(bounds.x, viewX);
+					bounds.y = std::max(bounds.y, viewX);
+				}
+
+				mColumnBounds[z * gridSize[0] + x] = bounds;
+			}
+
+			for(UINT32 y = 0; y < (UINT32)gridSize[1]; y++)
+			{
+				const float ndcY[] = 
+				{
+					(y * 2.0f / gridSize[1] - 1.0f) * flipY,
+					((y + 1) * 2.0f / gridSize[1] - 1.0f) * flipY
+				};
+
+				Vector2 bounds(std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+				for(UINT32 i = 0; i < 4; i++)
+				{
+					const float viewY = unproject(0.0f, ndcY[i % 2], ndcZ[i / 2]).y;
+					bounds.x = std::min(bounds.x, viewY);
+					bounds.y = std::max(bounds.y, viewY);
+				}
+
+				mRowBounds[z * gridSize[1] + y] = bounds;
+			}
+		}
+	}
+
+	/** Returns the distance of a value from the provided range, or a negative value if it's larger than the radius. */
+	static float calcDistance(float value, const Vector2& range, float radius)
+	{
+		const float extent = (range.y - range.x) * 0.5f;
+		const float distance = std::max(std::abs(value - (range.x + extent)) - extent, 0.0f);
+
+		return distance <= radius ? distance : -1.0f;
+	}
+
+	void LightGrid::findOverlappingCells(const Matrix4& viewTransform, UINT32 idx, const Vector3& worldPosition,
+		float radius)
+	{
+		const Vector3I& gridSize = mGridSize;
+		mColumnDistances.resize(gridSize[0]);
+		mRowDistances.resize(gridSize[1]);
+
+		const Vector3 position = viewTransform.multiplyAffine(worldPosition);
+		const float radiusSqrd = radius * radius;
+
+		for(UINT32 z = 0; z < (UINT32)gridSize[2]; z++)
+		{
+			const float distZ = calcDistance(position.z, mSliceBounds[z], radius);
+			if(distZ < 0.0f)
+				continue;
+
+			bool anyColumns = false;
+			for(UINT32 x = 0; x < (UINT32)gridSize[0]; x++)
+			{
+				mColumnDistances[x] = calcDistance(position.x, mColumnBounds[z * gridSize[0] + x], radius);
+				anyColumns |= mColumnDistances[x] >= 0.0f;
+			}
+
+			if(!anyColumns)
+				continue;
+
+			for(UINT32 y = 0; y < (UINT32)gridSize[1]; y++)
+			{
+				mRowDistances[y] = calcDistance(position.y, mRowBounds[z * gridSize[1] + y], radius);
+				if(mRowDistances[y] < 0.0f)
+					continue;
+
+				const float distYZSqrd = mRowDistances[y] * mRowDistances[y] + distZ * distZ;
+				for(UINT32 x = 0; x < (UINT32)gridSize[0]; x++)
+				{
+					if(mColumnDistances[x] < 0.0f)
+						continue;
+
+					if(mColumnDistances[x] * mColumnDistances[x] + distYZSqrd > radiusSqrd)
+						continue;
+
+					const UINT32 cellIdx = (z * gridSize[1] + y) * gridSize[0] + x;
+					mCellEntries.push_back(std::make_pair(cellIdx, idx));
+				}
+			}
+		}
+	}
+
+	void LightGrid::sortCellEntries(UINT32 maxNumIndices, Vector<UINT32>& cellOffsets, Vector<UINT32>& indices)
+	{
+		const UINT32 numCells = mGridSize[0] * mGridSize[1] * mGridSize[2];
+
+		// Same as the GPU version, entries that don't fit into the index buffer are dropped
+		if(mCellEntries.size() > maxNumIndices)
+			mCellEntries.resize(maxNumIndices);
+
+		cellOffsets.assign(numCells + 1, 0);
+		for(auto& entry : mCellEntries)
+			cellOffsets[entry.first + 1]++;
+
+		for(UINT32 i = 0; i < numCells; i++)
+			cellOffsets[i + 1] += cellOffsets[i];
+
+		mCellCursors.assign(cellOffsets.begin(), cellOffsets.end() - 1);
+		indices.resize(mCellEntries.size());
+		for(auto& entry : mCellEntries)
+			indices[mCellCursors[entry.first]++] = entry.second;
+	}
+
+	void LightGrid::binSpheres(const RendererView& view, const Sphere* spheres, UINT32 numSpheres,
+		UINT32 maxNumIndices, Vector<UINT32>& cellOffsets, Vector<UINT32>& indices)
+	{
+		const Matrix4& viewTransform = view.getProperties().viewTransform;
+
+		mCellEntries.clear();
+		for(UINT32 i = 0; i < numSpheres; i++)
+			findOverlappingCells(viewTransform, i, spheres[i].getCenter(), spheres[i].getRadius());
+
+		sortCellEntries(maxNumIndices, cellOffsets, indices);
 	}
 
 	LightGridOutputs LightGrid::getOutputs() const
 	{
 		LightGridOutputs outputs;
 
-		LightGridLLReductionMat* reductionMat = LightGridLLReductionMat::get();
-		reductionMat->getOutputs(
-			outputs.gridLightOffsetsAndSize,
-			outputs.gridLightIndices,
-			outputs.gridProbeOffsetsAndSize,
-			outputs.gridProbeIndices
-		);
+		if(mCPUGrid)
+		{
+			outputs.gridLightOffsetsAndSize = mGridLightOffsetsAndSize;
+			outputs.gridLightIndices = mGridLightIndices;
+			outputs.gridProbeOffsetsAndSize = mGridProbeOffsetsAndSize;
+			outputs.gridProbeIndices = mGridProbeIndices;
+		}
+		else
+		{
+			LightGridLLReductionMat* reductionMat = LightGridLLReductionMat::get();
+			reductionMat->getOutputs(
+				outputs.gridLightOffsetsAndSize,
+				outputs.gridLightIndices,
+				outputs.gridProbeOffsetsAndSize,
+				outputs.gridProbeIndices
+			);
+		}
 
 		outputs.gridParams = mGridParamBuffer;
 
@@ -27,6 +27,23 @@ namespace bs { namespace ct
 
 	extern LightGridParamDef gLightGridParamDefDef;
 
+	/** Determines how is the view split into cells by LightGrid. */
+	struct LIGHT_GRID_DESC
+	{
+		/** Width and height of a single grid cell, in pixels. Rounded up to a power of two. */
+		UINT32 cellSize = 64;
+
+		/** Number of slices to split the depth range of the view into. */
+		UINT32 numSlices = 32;
+
+		/** 
+		 * Average number of lights that can affect a single cell, and separately the average number of reflection
+		 * probes. Determines the size of the buffers containing light and probe indices, and any entries that don't fit
+		 * are dropped.
+		 */
+		UINT32 maxLightsPerCell = 32;
+	};
+
 	/** A set of buffers containing outputs from LightGrid. */
 	struct LightGridOutputs
 	{
@@ -70,11 +87,14 @@ namespace bs { namespace ct
 		LightGridLLCreationMat();
 
 		/** Binds parameter buffers and prepares any internal buffers. Must be called before execute(). */
-		void setParams(const Vector3I& gridSize, const SPtr<GpuParamBlockBuffer>& gridParams, 
+		void setParams(const Vector3I& gridSize, UINT32 maxLightsPerCell, const SPtr<GpuParamBlockBuffer>& gridParams, 
 					   const SPtr<GpuBuffer>& lightsBuffer, const SPtr<GpuBuffer>& probesBuffer);
 
-		/** Binds the material for rendering, sets up per-camera parameters and executes it. */
-		void execute(const RendererView& view);
+		/** 
+		 * Binds the material for rendering, sets up per-camera parameters and executes it. Work is queued on the main
+		 * command buffer, unless another command buffer is provided.
+		 */
+		void execute(const RendererView& view, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/** Returns the buffers generated by execute(). */
 		void getOutputs(SPtr<GpuBuffer>& lightsLLHeads, SPtr<GpuBuffer>& lightsLL, SPtr<GpuBuffer>& probesLLHeads, 
@@ -99,6 +119,7 @@ namespace bs { namespace ct
 		SPtr<GpuBuffer> mProbesLL;
 
 		UINT32 mBufferNumCells;
+		UINT32 mMaxLightsPerCell = 0;
 		Vector3I mGridSize;
 	};
 
@@ -111,12 +132,15 @@ namespace bs { namespace ct
 		LightGridLLReductionMat();
 
 		/** Binds parameter buffers and prepares any internal buffers. Must be called before execute(). */
-		void setParams(const Vector3I& gridSize, const SPtr<GpuParamBlockBuffer>& gridParams, 
+		void setParams(const Vector3I& gridSize, UINT32 maxLightsPerCell, const SPtr<GpuParamBlockBuffer>& gridParams, 
 			const SPtr<GpuBuffer>& lightLLHeads, const SPtr<GpuBuffer>& lightLL,
 			const SPtr<GpuBuffer>& probeLLHeads, const SPtr<GpuBuffer>& probeLL);
 
-		/** Binds the material for renderingand executes it. */
-		void execute(const RendererView& view);
+		/** 
+		 * Binds the material for rendering and executes it. Work is queued on the main command buffer, unless another 
+		 * command buffer is provided.
+		 */
+		void execute(const RendererView& view, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/** Returns the buffers generated by execute(). */
 		void getOutputs(SPtr<GpuBuffer>& gridLightOffsetsAndSize, SPtr<GpuBuffer>& gridLightIndices,
@@ -145,21 +169,28 @@ namespace bs { namespace ct
 		SPtr<GpuBuffer> mGridProbeIndices;
 
 		UINT32 mBufferNumCells;
+		UINT32 mMaxLightsPerCell = 0;
 		Vector3I mGridSize;
 	};
 
 	/**	
 	 * Helper class that is used for generating a grid in view space, whose cells contain information about lights 
 	 * affecting them. Used for forward rendering. 
+	 *
+	 * The grid is generated on the GPU using compute shaders. If the render API doesn't support compute shaders the
+	 * grid is instead generated on the CPU and uploaded to the GPU, resulting in the same outputs.
 	 */
 	class LightGrid
 	{
 	public:
 		LightGrid();
 
-		/** Updates the light grid from the provided view. */
-		void updateGrid(const RendererView& view, const VisibleLightData& lightData, const VisibleReflProbeData& probeData, 
-			bool noLighting);
+		/** 
+		 * Updates the light grid from the provided view. GPU work required for building the grid is queued on the 
+		 * provided command buffer, or on the main command buffer if none is provided.
+		 */
+		void updateGrid(const RendererView& view, const LIGHT_GRID_DESC& desc, const VisibleLightData& lightData, 
+			const VisibleReflProbeData& probeData, bool noLighting, const SPtr<CommandBuffer>& commandBuffer = nullptr);
 
 		/** 
 		 * Returns the buffers containing light indices per grid cell and global grid parameters. This data gets Updated on
@@ -167,8 +198,75 @@ namespace bs { namespace ct
 		 */
 		LightGridOutputs getOutputs() const;
 
+		/** Returns the number of cells in each dimension of the grid built by the last call to updateGrid(). */
+		const Vector3I& getGridSize() const { return mGridSize; }
+
+		/**
+		 * Finds the grid cells overlapped by each of the provided spheres, allowing objects other than lights and
+		 * reflection probes to be looked up through the grid. Cells match the ones of the grid built by the last call
+		 * to updateGrid().
+		 *
+		 * @param[in]	view			View the grid was last updated with.
+		 * @param[in]	spheres			Bounding spheres of the objects, in world space.
+		 * @param[in]	numSpheres		Number of entries in the @p spheres array.
+		 * @param[in]	maxNumIndices	Maximum number of entries to output in @p indices. Any entries that don't fit
+		 *								are dropped.
+		 * @param[out]	cellOffsets		Offset into @p indices of the first entry of each cell, followed by an extra
+		 *								entry containing the total number of indices.
+		 * @param[out]	indices			Indices of the spheres overlapping each cell. Indices within a cell are sorted
+		 *								in ascending order.
+		 */
+		void binSpheres(const RendererView& view, const Sphere* spheres, UINT32 numSpheres, UINT32 maxNumIndices,
+			Vector<UINT32>& cellOffsets, Vector<UINT32>& indices);
+
 	private:
+		/** Generates the grid outputs on the CPU, as a fallback for render APIs without compute shader support. */
+		void updateGridCPU(const RendererView& view, const Vector3I& gridSize, UINT32 maxLightsPerCell,
+			const VisibleLightData& lightData, const Vector4I& lightCounts, const Vector2I& lightStrides, 
+			const VisibleReflProbeData& probeData, UINT32 numProbes);
+
+		/** Calculates the view space bounds of the cells of a grid of the provided size. */
+		void updateCellBounds(const RendererView& view, const Vector3I& gridSize);
+
+		/** Finds all cells overlapping the provided sphere, and records them in #mCellEntries along with @p idx. */
+		void findOverlappingCells(const Matrix4& viewTransform, UINT32 idx, const Vector3& worldPosition,
+			float radius);
+
+		/** 
+		 * Sorts the entries in #mCellEntries by cell, keeping the order of entries within a cell, and outputs the
+		 * offset to the first entry of each cell and the indices of all entries.
+		 */
+		void sortCellEntries(UINT32 maxNumIndices, Vector<UINT32>& cellOffsets, Vector<UINT32>& indices);
+
 		SPtr<GpuParamBlockBuffer> mGridParamBuffer;
+		Vector3I mGridSize;
+
+		// CPU generated grid
+		bool mCPUGrid = false;
+		UINT32 mCPUBufferNumCells = 0;
+		UINT32 mCPUBufferNumIndices = 0;
+
+		SPtr<GpuBuffer> mGridLightOffsetsAndSize;
+		SPtr<GpuBuffer> mGridLightIndices;
+		SPtr<GpuBuffer> mGridProbeOffsetsAndSize;
+		SPtr<GpuBuffer> mGridProbeIndices;
+
+		/** View space bounds of each cell column, per slice. Each entry contains the minimum and maximum X coordinate. */
+		Vector<Vector2> mColumnBounds;
+
+		/** View space bounds of each cell row, per slice. Each entry contains the minimum and maximum Y coordinate. */
+		Vector<Vector2> mRowBounds;
+
+		/** View space bounds of each slice. Each entry contains the minimum and maximum Z coordinate. */
+		Vector<Vector2> mSliceBounds;
+
+		/** Pairs of cell index and light or probe index, for each light or probe overlapping a cell. */
+		Vector<std::pair<UINT32, UINT32>> mCellEntries;
+
+		// Scratch storage used when finding and sorting cell entries
+		Vector<float> mColumnDistances;
+		Vector<float> mRowDistances;
+		Vector<UINT32> mCellCursors;
 	};
 
 	/** @} */
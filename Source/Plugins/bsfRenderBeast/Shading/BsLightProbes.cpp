@@ -11,6 +11,7 @@
 #include "Renderer/BsRendererUtility.h"
 #include "Renderer/BsSkybox.h"
 #include "Utility/BsRendererTextures.h"
+#include "Math/BsAABox.h"
 
 namespace bs { namespace ct 
 {
@@ -221,10 +222,47 @@ namespace bs { namespace ct
 		float padding[3];
 	};
 
+	/** Inputs and outputs of a single light probe tetrahedron volume rebuild, executed on a worker thread. */
+	struct LightProbes::BuildData
+	{
+		/** Volume groups forming the tetrahedron volume. */
+		Vector<SPtr<VolumeGroupData>> groups;
+
+		/** Determines which of the @p groups need to be tetrahedralized. Others are reused from earlier builds. */
+		Vector<bool> rebuildGroup;
+
+		/** Maps volume identifiers to offsets of their probes in the global coefficient buffer. */
+		UnorderedMap<UINT32, UINT32> bufferOffsets;
+
+		/** Coefficient textures of all volumes, in the order they are stored in the global coefficient texture. */
+		Vector<SPtr<Texture>> coefficientTextures;
+
+		/** Total number of rows required for storing all of the @p coefficientTextures. */
+		UINT32 numCoefficientRows = 0;
+
+		/** Mesh representing the entire tetrahedron volume. Null if there are no probes. */
+		SPtr<MeshData> meshData;
+
+		/** Inner tetrahedra followed by the outer faces, as consumed by the GPU. */
+		Vector<TetrahedronDataGPU> tetrahedra;
+
+		/** Additional information about outer faces, as consumed by the GPU. */
+		Vector<TetrahedronFaceDataGPU> faces;
+
+		/** Number of inner tetrahedra in the @p tetrahedra array. */
+		UINT32 numTetrahedra = 0;
+	};
+
 	LightProbes::LightProbes()
-		:mTetrahedronVolumeDirty(false), mMaxCoefficientRows(0), mMaxTetrahedra(0), mMaxFaces(0), mNumValidTetrahedra(0)
+		:mTetrahedronVolumeDirty(false), mActiveGpuData(0), mNextVolumeId(0)
 	{ }
 
+	LightProbes::~LightProbes()
+	{
+		if (mBuildTask)
+			mBuildTask->wait();
+	}
+
 	void LightProbes::notifyAdded(LightProbeVolume* volume)
 	{
 		UINT32 handle = (UINT32)mVolumes.size();
@@ -232,6 +270,7 @@ namespace bs { namespace ct
 		VolumeInfo info;
 		info.volume = volume;
 		info.isDirty = true;
+		info.id = mNextVolumeId++;
 
 		mVolumes.push_back(info);
 		volume->setRendererId(handle);
@@ -269,84 +308,187 @@ namespace bs { namespace ct
 
 	void LightProbes::updateProbes()
 	{
+		if (mBuildTask)
+		{
+			// Keep using the current data until the worker is done
+			if (!mBuildTask->isComplete())
+				return;
+
+			applyBuild(*mBuild);
+
+			mBuildTask = nullptr;
+			mBuild = nullptr;
+		}
+
 		if (!mTetrahedronVolumeDirty)
 			return;
 
-		// Move all coefficients into the global buffer
-		UINT32 numRows = 0;
-		for(auto& entry : mVolumes)
+		startBuild();
+		mTetrahedronVolumeDirty = false;
+	}
+
+	void LightProbes::startBuild()
+	{
+		mBuild = bs_shared_ptr_new<BuildData>();
+
+		// Gather coefficient textures, and world space probe positions and bounds of all volumes
+		struct VolumeBounds
+		{
+			UINT32 volumeIdx;
+			AABox bounds;
+		};
+
+		Vector<VolumeBounds> activeVolumes;
+		UINT32 bufferOffset = 0;
+		for(UINT32 i = 0; i < (UINT32)mVolumes.size(); i++)
 		{
+			const VolumeInfo& entry = mVolumes[i];
+
 			SPtr<Texture> localTexture = entry.volume->getCoefficientsTexture();
-			numRows += localTexture->getProperties().getHeight();
+			mBuild->coefficientTextures.push_back(localTexture);
+			mBuild->numCoefficientRows += localTexture->getProperties().getHeight();
+
+			UINT32 numProbes = entry.volume->getNumActiveProbes();
+			if (numProbes == 0)
+				continue;
+
+			const Vector<Vector3>& positions = entry.volume->getLightProbePositions();
+			const Transform& tfrm = entry.volume->getTransform();
+
+			AABox bounds(tfrm.getPosition(), tfrm.getPosition());
+			for (UINT32 j = 0; j < numProbes; j++)
+				bounds.merge(tfrm.getRotation().rotate(positions[j]) + tfrm.getPosition());
+
+			activeVolumes.push_back({ i, bounds });
+
+			mBuild->bufferOffsets[entry.id] = bufferOffset;
+			bufferOffset += (UINT32)positions.size();
 		}
 
-		if(numRows > mMaxCoefficientRows)
-			resizeCoefficientTexture(numRows + 4);
+		// Group volumes with overlapping bounds, as their probes need to be tetrahedralized together
+		Vector<UINT32> groupRoots(activeVolumes.size());
+		for (UINT32 i = 0; i < (UINT32)activeVolumes.size(); i++)
+			groupRoots[i] = i;
 
-		UINT32 rowIdx = 0;
-		for(auto& entry : mVolumes)
+		auto findRoot = [&groupRoots](UINT32 idx)
 		{
-			TEXTURE_COPY_DESC copyDesc;
-			copyDesc.dstPosition = Vector3I(0, rowIdx, 0);
+			while (groupRoots[idx] != idx)
+				idx = groupRoots[idx] = groupRoots[groupRoots[idx]];
 
-			SPtr<Texture> localTexture = entry.volume->getCoefficientsTexture();
-			localTexture->copy(mProbeCoefficientsGPU, copyDesc);
-			
-			rowIdx += localTexture->getProperties().getHeight();
+			return idx;
+		};
+
+		for (UINT32 i = 0; i < (UINT32)activeVolumes.size(); i++)
+		{
+			for (UINT32 j = i + 1; j < (UINT32)activeVolumes.size(); j++)
+			{
+				if (activeVolumes[i].bounds.intersects(activeVolumes[j].bounds))
+					groupRoots[findRoot(j)] = findRoot(i);
+			}
 		}
 
-		// Gather all positions
-		UINT32 bufferOffset = 0;
-		rowIdx = 0;
-		for(auto& entry : mVolumes)
+		UnorderedMap<UINT32, Vector<UINT32>> groupVolumes;
+		for (UINT32 i = 0; i < (UINT32)activeVolumes.size(); i++)
+			groupVolumes[findRoot(i)].push_back(activeVolumes[i].volumeIdx);
+
+		// Reuse groups whose volumes haven't changed since they were tetrahedralized, and gather the probes of others
+		Vector<SPtr<VolumeGroupData>> prevGroups = std::move(mGroups);
+		mGroups.clear();
+
+		for (auto& entry : groupVolumes)
 		{
-			const Vector<LightProbeInfo>& infos = entry.volume->getLightProbeInfos();
-			const Vector<Vector3>& positions = entry.volume->getLightProbePositions();
+			Vector<UINT32> volumeIds;
+			bool isDirty = false;
+			for (auto& volumeIdx : entry.second)
+			{
+				volumeIds.push_back(mVolumes[volumeIdx].id);
+				isDirty |= mVolumes[volumeIdx].isDirty;
+			}
 
-			UINT32 numProbes = entry.volume->getNumActiveProbes();
+			std::sort(volumeIds.begin(), volumeIds.end());
 
-			if (numProbes == 0)
-				continue;
+			SPtr<VolumeGroupData> group;
+			if (!isDirty)
+			{
+				auto iterFind = std::find_if(prevGroups.begin(), prevGroups.end(),
+					[&volumeIds](const SPtr<VolumeGroupData>& x) { return x->volumeIds == volumeIds; });
 
-			const Transform& tfrm = entry.volume->getTransform();
-			Vector3 offset = tfrm.getPosition();
-			Quaternion rotation = tfrm.getRotation();
+				if (iterFind != prevGroups.end())
+					group = *iterFind;
+			}
 
-			for (UINT32 i = 0; i < numProbes; i++)
+			bool rebuild = group == nullptr;
+			if (rebuild)
 			{
-				Vector3 localPos = positions[i];
-				Vector3 transformedPos = rotation.rotate(localPos) + offset;
-				mTempTetrahedronPositions.push_back(transformedPos);
+				group = bs_shared_ptr_new<VolumeGroupData>();
+				group->volumeIds = volumeIds;
+
+				for (auto& volumeIdx : entry.second)
+				{
+					LightProbeVolume* volume = mVolumes[volumeIdx].volume;
 
-				mTempTetrahedronBufferIndices.push_back(bufferOffset + infos[i].bufferIdx);
+					const Vector<LightProbeInfo>& infos = volume->getLightProbeInfos();
+					const Vector<Vector3>& positions = volume->getLightProbePositions();
+					const Transform& tfrm = volume->getTransform();
 
-				Vector2I offset = IBLUtility::getSHCoeffXYFromIdx(infos[i].bufferIdx, 3);
-				mTempTetrahedronBufferOffsets.push_back(offset);
+					auto iterId = std::find(volumeIds.begin(), volumeIds.end(), mVolumes[volumeIdx].id);
+					UINT32 groupVolumeIdx = (UINT32)(iterId - volumeIds.begin());
+
+					UINT32 numProbes = volume->getNumActiveProbes();
+					for (UINT32 i = 0; i < numProbes; i++)
+					{
+						group->positions.push_back(tfrm.getRotation().rotate(positions[i]) + tfrm.getPosition());
+						group->probeVolumes.push_back(groupVolumeIdx);
+						group->probeBufferIndices.push_back(infos[i].bufferIdx);
+					}
+				}
 			}
 
-			SPtr<Texture> localTexture = entry.volume->getCoefficientsTexture();
-			rowIdx += localTexture->getProperties().getHeight();
-			bufferOffset += (UINT32)positions.size();
+			mBuild->groups.push_back(group);
+			mBuild->rebuildGroup.push_back(rebuild);
+			mGroups.push_back(group);
 		}
 
-		mTetrahedronInfos.clear();
+		for (auto& entry : mVolumes)
+			entry.isDirty = false;
 
-		Vector<TetrahedronFaceData> outerFaces;
-		generateTetrahedronData(mTempTetrahedronPositions, mTetrahedronInfos, outerFaces, true);
+		// Note: The build data is only accessed through the shared pointer, so the task never touches the manager
+		SPtr<BuildData> build = mBuild;
+		mBuildTask = Task::create("LightProbeTetrahedralize", [build]() { executeBuild(*build); });
+		TaskScheduler::instance().addTask(mBuildTask);
+	}
 
-		// Find valid tetrahedrons
-		UINT32 numTetrahedra = (UINT32)mTetrahedronInfos.size();
+	void LightProbes::executeBuild(BuildData& data)
+	{
+		for (UINT32 i = 0; i < (UINT32)data.groups.size(); i++)
+		{
+			if (data.rebuildGroup[i])
+				generateGroupData(*data.groups[i]);
+		}
 
-		bool* validTets = (bool*)bs_stack_alloc(sizeof(bool) * numTetrahedra);
-		mNumValidTetrahedra = 0;
-		for (UINT32 i = 0; i < (UINT32)mTetrahedronInfos.size(); i++)
+		bs_frame_mark();
 		{
-			const TetrahedronData& entry = mTetrahedronInfos[i];
+			generateVolumeData(data);
+		}
+		bs_frame_clear();
+	}
 
-			const Vector3& P1 = mTempTetrahedronPositions[entry.volume.vertices[0]];
-			const Vector3& P2 = mTempTetrahedronPositions[entry.volume.vertices[1]];
-			const Vector3& P3 = mTempTetrahedronPositions[entry.volume.vertices[2]];
-			const Vector3& P4 = mTempTetrahedronPositions[entry.volume.vertices[3]];
+	void LightProbes::generateGroupData(VolumeGroupData& group)
+	{
+		Vector<TetrahedronData> tetrahedra;
+		Vector<TetrahedronFaceData> faces;
+		generateTetrahedronData(group.positions, tetrahedra, faces, true);
+
+		// Keep only valid tetrahedrons, and the faces belonging to them
+		Vector<UINT32> validIndices(tetrahedra.size(), (UINT32)-1);
+		for (UINT32 i = 0; i < (UINT32)tetrahedra.size(); i++)
+		{
+			const TetrahedronData& entry = tetrahedra[i];
+
+			const Vector3& P1 = group.positions[entry.volume.vertices[0]];
+			const Vector3& P2 = group.positions[entry.volume.vertices[1]];
+			const Vector3& P3 = group.positions[entry.volume.vertices[2]];
+			const Vector3& P4 = group.positions[entry.volume.vertices[3]];
 
 			Vector3 E1 = P1 - P4;
 			Vector3 E2 = P2 - P4;
@@ -355,24 +497,91 @@ namespace bs { namespace ct
 			// If tetrahedron is co-planar just ignore it, shader will use some other nearby one instead. We can't
 			// handle coplanar tetrahedrons because the matrix is not invertible, and for nearly co-planar ones the
 			// math breaks down because of precision issues.
-			validTets[i] = fabs(Vector3::dot(Vector3::normalize(Vector3::cross(E1, E2)), E3)) > 0.0001f;
+			if (fabs(Vector3::dot(Vector3::normalize(Vector3::cross(E1, E2)), E3)) > 0.0001f)
+			{
+				validIndices[i] = (UINT32)group.tetrahedra.size();
+				group.tetrahedra.push_back(entry);
+			}
+		}
 
-			if (validTets[i])
-				mNumValidTetrahedra++;
+		for (auto& entry : faces)
+		{
+			if (validIndices[entry.tetrahedron] == (UINT32)-1)
+				continue;
+
+			entry.tetrahedron = validIndices[entry.tetrahedron];
+			group.faces.push_back(entry);
 		}
+	}
 
-		UINT32 numValidFaces = 0;
-		for(auto& entry : outerFaces)
+	void LightProbes::generateVolumeData(BuildData& data)
+	{
+		// Merge all the groups into a single volume
+		Vector<Vector3> positions;
+		Vector<UINT32> bufferIndices;
+		Vector<Vector2I> bufferOffsets;
+		Vector<TetrahedronData> tetrahedra;
+		Vector<TetrahedronFaceData> faces;
+
+		for (auto& group : data.groups)
 		{
-			if (validTets[entry.tetrahedron])
-				numValidFaces++;
+			UINT32 vertexOffset = (UINT32)positions.size();
+			UINT32 tetrahedronOffset = (UINT32)tetrahedra.size();
+
+			positions.insert(positions.end(), group->positions.begin(), group->positions.end());
+
+			// Map vertices to actual SH coefficient indices. Vertices of the extrapolation volume have no probes.
+			for (UINT32 i = 0; i < (UINT32)group->positions.size(); i++)
+			{
+				if (i < (UINT32)group->probeVolumes.size())
+				{
+					UINT32 volumeId = group->volumeIds[group->probeVolumes[i]];
+					UINT32 bufferIdx = group->probeBufferIndices[i];
+
+					bufferIndices.push_back(data.bufferOffsets[volumeId] + bufferIdx);
+					bufferOffsets.push_back(IBLUtility::getSHCoeffXYFromIdx(bufferIdx, 3));
+				}
+				else
+				{
+					bufferIndices.push_back(0);
+					bufferOffsets.push_back(Vector2I(0, 0));
+				}
+			}
+
+			for (auto& entry : group->tetrahedra)
+			{
+				TetrahedronData tetrahedron = entry;
+				for (UINT32 i = 0; i < 4; i++)
+					tetrahedron.volume.vertices[i] += vertexOffset;
+
+				tetrahedra.push_back(tetrahedron);
+			}
+
+			for (auto& entry : group->faces)
+			{
+				TetrahedronFaceData face = entry;
+				for (UINT32 i = 0; i < 3; i++)
+				{
+					face.innerVertices[i] += vertexOffset;
+					face.outerVertices[i] += vertexOffset;
+				}
+
+				face.tetrahedron += tetrahedronOffset;
+				faces.push_back(face);
+			}
 		}
 
+		UINT32 numTetrahedra = (UINT32)tetrahedra.size();
+		UINT32 numFaces = (UINT32)faces.size();
+
+		data.numTetrahedra = numTetrahedra;
+		if (numTetrahedra == 0)
+			return;
 		// Generate a mesh out of all the tetrahedron triangles
 		// Note: Currently the entire volume is rendered as a single large mesh, which will isn't optimal as we can't
 		// perform frustum culling. A better option would be to split the mesh into multiple smaller volumes, do
 		// frustum culling and possibly even sort by distance from camera.
-		UINT32 numVertices = mNumValidTetrahedra * 4 * 3 + numValidFaces * 9 * 3;
+		UINT32 numVertices = numTetrahedra * 4 * 3 + numFaces * 9 * 3;
 
 		SPtr<VertexDataDesc> vertexDesc = bs_shared_ptr_new<VertexDataDesc>();
 		vertexDesc->addVertElem(VET_FLOAT3, VES_POSITION);
@@ -385,16 +594,14 @@ namespace bs { namespace ct
 
 		// Insert inner tetrahedron triangles
 		UINT32 tetIdx = 0;
-		for (UINT32 i = 0; i < (UINT32)mTetrahedronInfos.size(); i++)
+		for (UINT32 i = 0; i < (UINT32)tetrahedra.size(); i++)
 		{
-			if (!validTets[i])
-				continue;
 
-			const Tetrahedron& volume = mTetrahedronInfos[i].volume;
+			const Tetrahedron& volume = tetrahedra[i].volume;
 
 			Vector3 center(BsZero);
 			for(UINT32 j = 0; j < 4; j++)
-				center += mTempTetrahedronPositions[volume.vertices[j]];
+				center += positions[volume.vertices[j]];
 
 			center /= 4.0f;
 
@@ -408,9 +615,9 @@ namespace bs { namespace ct
 
 			for(UINT32 j = 0; j < 4; j++)
 			{
-				Vector3 A = mTempTetrahedronPositions[volume.vertices[Permutations[j][0]]];
-				Vector3 B = mTempTetrahedronPositions[volume.vertices[Permutations[j][1]]];
-				Vector3 C = mTempTetrahedronPositions[volume.vertices[Permutations[j][2]]];
+				Vector3 A = positions[volume.vertices[Permutations[j][0]]];
+				Vector3 B = positions[volume.vertices[Permutations[j][1]]];
+				Vector3 C = positions[volume.vertices[Permutations[j][2]]];
 
 				// Make sure the triangle is clockwise, facing away from the center
 				Vector3 e0 = A - C;
@@ -447,15 +654,13 @@ namespace bs { namespace ct
 		};
 
 		FrameUnorderedMap<std::pair<INT32, INT32>, Edge, pair_hash> edgeMap;
-		for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+		for(UINT32 i = 0; i < (UINT32)faces.size(); i++)
 		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
 
 			for (UINT32 j = 0; j < 3; ++j)
 			{
-				UINT32 v0 = outerFaces[i].innerVertices[j];
-				UINT32 v1 = outerFaces[i].innerVertices[(j + 1) % 3];
+				UINT32 v0 = faces[i].innerVertices[j];
+				UINT32 v1 = faces[i].innerVertices[(j + 1) % 3];
 
 				// Keep the same ordering so other faces can find the same edge
 				if (v0 > v1)
@@ -469,10 +674,10 @@ namespace bs { namespace ct
 				else
 				{
 					Edge edge;
-					edge.vertInner[0] = outerFaces[i].innerVertices[j];
-					edge.vertInner[1] = outerFaces[i].innerVertices[(j + 1) % 3];
-					edge.vertOuter[0] = outerFaces[i].outerVertices[j];
-					edge.vertOuter[1] = outerFaces[i].outerVertices[(j + 1) % 3];
+					edge.vertInner[0] = faces[i].innerVertices[j];
+					edge.vertInner[1] = faces[i].innerVertices[(j + 1) % 3];
+					edge.vertOuter[0] = faces[i].outerVertices[j];
+					edge.vertOuter[1] = faces[i].outerVertices[(j + 1) % 3];
 					edge.face[0] = i;
 					edge.face[1] = -1;
 
@@ -483,12 +688,10 @@ namespace bs { namespace ct
 
 		// Generate front and back triangles for extruded outer faces
 		UINT32 faceIdx = 0;
-		for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+		for(UINT32 i = 0; i < (UINT32)faces.size(); i++)
 		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+			const TetrahedronFaceData& entry = faces[i];
 
 			static const UINT32 Permutations[2][3] = { {0, 1, 2 }, { 3, 4, 5} };
 
@@ -496,8 +699,8 @@ namespace bs { namespace ct
 			Vector3 center(BsZero);
 			for (UINT32 k = 0; k < 3; k++)
 			{
-				center += mTempTetrahedronPositions[entry.innerVertices[k]];
-				center += mTempTetrahedronPositions[entry.outerVertices[k]];
+				center += positions[entry.innerVertices[k]];
+				center += positions[entry.outerVertices[k]];
 			}
 
 			center /= 6.0f;
@@ -512,9 +715,9 @@ namespace bs { namespace ct
 				idxB = idxB > 2 ? entry.outerVertices[idxB - 3] : entry.innerVertices[idxB];
 				idxC = idxC > 2 ? entry.outerVertices[idxC - 3] : entry.innerVertices[idxC];
 				
-				Vector3 A = mTempTetrahedronPositions[idxA];
-				Vector3 B = mTempTetrahedronPositions[idxB];
-				Vector3 C = mTempTetrahedronPositions[idxC];
+				Vector3 A = positions[idxA];
+				Vector3 B = positions[idxB];
+				Vector3 C = positions[idxC];
 
 				Vector3 e0 = A - C;
 				Vector3 e1 = B - C;
@@ -549,14 +752,14 @@ namespace bs { namespace ct
 
 			for (UINT32 i = 0; i < 2; i++)
 			{
-				const TetrahedronFaceData& face = outerFaces[edge.face[i]];
+				const TetrahedronFaceData& face = faces[edge.face[i]];
 
 				// Make sure the triangle is clockwise, facing away from the center
 				Vector3 center(BsZero);
 				for (UINT32 k = 0; k < 3; k++)
 				{
-					center += mTempTetrahedronPositions[face.innerVertices[k]];
-					center += mTempTetrahedronPositions[face.outerVertices[k]];
+					center += positions[face.innerVertices[k]];
+					center += positions[face.outerVertices[k]];
 				}
 
 				center /= 6.0f;
@@ -572,9 +775,9 @@ namespace bs { namespace ct
 					idxB = idxB > 1 ? edge.vertOuter[idxB - 2] : edge.vertInner[idxB];
 					idxC = idxC > 1 ? edge.vertOuter[idxC - 2] : edge.vertInner[idxC];
 					
-					Vector3 A = mTempTetrahedronPositions[idxA];
-					Vector3 B = mTempTetrahedronPositions[idxB];
-					Vector3 C = mTempTetrahedronPositions[idxC];
+					Vector3 A = positions[idxA];
+					Vector3 B = positions[idxB];
+					Vector3 C = positions[idxC];
 
 					Vector3 e0 = A - C;
 					Vector3 e1 = B - C;
@@ -604,23 +807,21 @@ namespace bs { namespace ct
 
 		// Generate "caps" on the end of the extruded volume
 		UINT32 capIdx = 0;
-		for(UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+		for(UINT32 i = 0; i < (UINT32)faces.size(); i++)
 		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+			const TetrahedronFaceData& entry = faces[i];
 
-			Vector3 A = mTempTetrahedronPositions[entry.outerVertices[0]];
-			Vector3 B = mTempTetrahedronPositions[entry.outerVertices[1]];
-			Vector3 C = mTempTetrahedronPositions[entry.outerVertices[2]];
+			Vector3 A = positions[entry.outerVertices[0]];
+			Vector3 B = positions[entry.outerVertices[1]];
+			Vector3 C = positions[entry.outerVertices[2]];
 
 			// Make sure the triangle is clockwise, facing toward the center
-			const Tetrahedron& tet = mTetrahedronInfos[entry.tetrahedron].volume;
+			const Tetrahedron& tet = tetrahedra[entry.tetrahedron].volume;
 
 			Vector3 center(BsZero);
 			for(UINT32 j = 0; j < 4; j++)
-				center += mTempTetrahedronPositions[tet.vertices[j]];
+				center += positions[tet.vertices[j]];
 
 			center /= 4.0f;
 
@@ -647,128 +848,127 @@ namespace bs { namespace ct
 			capIdx++;
 		}
 
-		mVolumeMesh = Mesh::create(meshData);
-
-		// Map vertices to actual SH coefficient indices, and write GPU buffer with tetrahedron information
-		if ((mNumValidTetrahedra + numValidFaces) > mMaxTetrahedra)
-		{
-			UINT32 newSize = Math::divideAndRoundUp(mNumValidTetrahedra + numValidFaces, 64U) * 64U;
-			resizeTetrahedronBuffer(newSize);
-		}
-
-		TetrahedronDataGPU* dst = (TetrahedronDataGPU*)mTetrahedronInfosGPU->lock(0, mTetrahedronInfosGPU->getSize(), 
-			GBL_WRITE_ONLY_DISCARD);
+		data.meshData = meshData;
 
 		// Write inner tetrahedron data
-		for (UINT32 i = 0; i < (UINT32)mTetrahedronInfos.size(); i++)
+		for (auto& entry : tetrahedra)
 		{
-			if (!validTets[i])
-				continue;
-
-			TetrahedronData& entry = mTetrahedronInfos[i];
-
-			Vector2I offsets[4];
+			TetrahedronDataGPU dst;
 			for(UINT32 j = 0; j < 4; ++j)
 			{
-				entry.volume.vertices[j] = mTempTetrahedronBufferIndices[entry.volume.vertices[j]];
-				offsets[j] = mTempTetrahedronBufferOffsets[entry.volume.vertices[j]];
+				dst.indices[j] = bufferIndices[entry.volume.vertices[j]];
+				dst.offsets[j] = bufferOffsets[entry.volume.vertices[j]];
 			}
 
-			memcpy(dst->indices, entry.volume.vertices, sizeof(UINT32) * 4);
-			memcpy(dst->offsets, &offsets, sizeof(offsets));
-			memcpy(&dst->transform, &entry.transform, sizeof(float) * 12);
-
-			dst++;
+			memcpy(&dst.transform, &entry.transform, sizeof(float) * 12);
+			data.tetrahedra.push_back(dst);
 		}
 
 		// Write extruded face data
-		for (UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+		for (auto& entry : faces)
 		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
-
-			const TetrahedronFaceData& entry = outerFaces[i];
-
-			UINT32 indices[4];
-			Vector2I offsets[4];
+			TetrahedronDataGPU dst;
 			for(UINT32 j = 0; j < 3; j++)
 			{
-				indices[j] = mTempTetrahedronBufferIndices[entry.innerVertices[j]];
-				offsets[j] = mTempTetrahedronBufferOffsets[entry.innerVertices[j]];
+				dst.indices[j] = bufferIndices[entry.innerVertices[j]];
+				dst.offsets[j] = bufferOffsets[entry.innerVertices[j]];
 			}
 
-			indices[3] = -1;
-
-			memcpy(dst->indices, indices, sizeof(UINT32) * 4);
-			memcpy(dst->offsets, offsets, sizeof(offsets));
-			memcpy(&dst->transform, &entry.transform, sizeof(float) * 12);
+			dst.indices[3] = -1;
+			dst.offsets[3] = Vector2I(0, 0);
 
-			dst++;
+			memcpy(&dst.transform, &entry.transform, sizeof(float) * 12);
+			data.tetrahedra.push_back(dst);
 		}
 
-		mTetrahedronInfosGPU->unlock();
-
 		// Write data specific to faces
-		if (numValidFaces > mMaxFaces)
+		for (auto& entry : faces)
 		{
-			UINT32 newSize = Math::divideAndRoundUp(numValidFaces, 64U) * 64U;
-			resizeTetrahedronFaceBuffer(newSize);
+			TetrahedronFaceDataGPU dst;
+			for (UINT32 j = 0; j < 3; j++)
+			{
+				dst.corners[j] = positions[entry.innerVertices[j]];
+				dst.normals[j] = entry.normals[j];
+			}
+
+			dst.isQuadratic = entry.quadratic ? 1 : 0;
+			data.faces.push_back(dst);
 		}
+	}
+
+	void LightProbes::applyBuild(const BuildData& data)
+	{
+		// Write to the buffers not used by the current data, so they remain valid until the swap
+		GpuData& gpuData = mGpuData[(mActiveGpuData + 1) % 2];
 
-		TetrahedronFaceDataGPU* faceDst = (TetrahedronFaceDataGPU*)mTetrahedronFaceInfosGPU->lock(0, 
-			mTetrahedronFaceInfosGPU->getSize(), GBL_WRITE_ONLY_DISCARD);
+		// Move all coefficients into the global buffer
+		if(data.numCoefficientRows > gpuData.maxCoefficientRows)
+			resizeCoefficientTexture(gpuData, data.numCoefficientRows + 4);
 
-		for (UINT32 i = 0; i < (UINT32)outerFaces.size(); i++)
+		UINT32 rowIdx = 0;
+		for(auto& localTexture : data.coefficientTextures)
 		{
-			if (!validTets[outerFaces[i].tetrahedron])
-				continue;
+			TEXTURE_COPY_DESC copyDesc;
+			copyDesc.dstPosition = Vector3I(0, rowIdx, 0);
 
-			const TetrahedronFaceData& entry = outerFaces[i];
+			localTexture->copy(gpuData.coefficients, copyDesc);
+			rowIdx += localTexture->getProperties().getHeight();
+		}
 
-			for (UINT32 j = 0; j < 3; j++)
+		gpuData.numTetrahedra = data.numTetrahedra;
+		if (data.meshData)
+		{
+			gpuData.volumeMesh = Mesh::create(data.meshData);
+
+			if ((UINT32)data.tetrahedra.size() > gpuData.maxTetrahedra)
 			{
-				faceDst->corners[j] = mTempTetrahedronPositions[entry.innerVertices[j]];
-				faceDst->normals[j] = entry.normals[j];
+				UINT32 newSize = Math::divideAndRoundUp((UINT32)data.tetrahedra.size(), 64U) * 64U;
+				resizeTetrahedronBuffer(gpuData, newSize);
 			}
 
-			faceDst->isQuadratic = entry.quadratic ? 1 : 0;
-			faceDst++;
-		}
+			void* dst = gpuData.tetrahedra->lock(0, gpuData.tetrahedra->getSize(), GBL_WRITE_ONLY_DISCARD);
+			memcpy(dst, data.tetrahedra.data(), data.tetrahedra.size() * sizeof(TetrahedronDataGPU));
+			gpuData.tetrahedra->unlock();
 
-		mTetrahedronFaceInfosGPU->unlock();
+			if ((UINT32)data.faces.size() > gpuData.maxFaces)
+			{
+				UINT32 newSize = Math::divideAndRoundUp((UINT32)data.faces.size(), 64U) * 64U;
+				resizeTetrahedronFaceBuffer(gpuData, newSize);
+			}
 
-		bs_stack_free(validTets);
+			if (!data.faces.empty())
+			{
+				void* faceDst = gpuData.faces->lock(0, gpuData.faces->getSize(), GBL_WRITE_ONLY_DISCARD);
+				memcpy(faceDst, data.faces.data(), data.faces.size() * sizeof(TetrahedronFaceDataGPU));
+				gpuData.faces->unlock();
+			}
+		}
+		else
+			gpuData.volumeMesh = nullptr;
 
-		mTempTetrahedronPositions.clear();
-		mTempTetrahedronBufferIndices.clear();
-		mTetrahedronVolumeDirty = false;
+		mActiveGpuData = (mActiveGpuData + 1) % 2;
 	}
 
 	bool LightProbes::hasAnyProbes() const
 	{
-		for(auto& entry : mVolumes)
-		{
-			UINT32 numProbes = entry.volume->getNumActiveProbes();
-			if (numProbes > 0)
-				return true;
-		}
-
-		return false;
+		return mGpuData[mActiveGpuData].volumeMesh != nullptr;
 	}
 
 	LightProbesInfo LightProbes::getInfo() const
 	{
+		const GpuData& gpuData = mGpuData[mActiveGpuData];
+
 		LightProbesInfo info;
-		info.shCoefficients = mProbeCoefficientsGPU;
-		info.tetrahedra = mTetrahedronInfosGPU;
-		info.faces = mTetrahedronFaceInfosGPU;
-		info.tetrahedraVolume = mVolumeMesh;
-		info.numTetrahedra = mNumValidTetrahedra;
+		info.shCoefficients = gpuData.coefficients;
+		info.tetrahedra = gpuData.tetrahedra;
+		info.faces = gpuData.faces;
+		info.tetrahedraVolume = gpuData.volumeMesh;
+		info.numTetrahedra = gpuData.numTetrahedra;
 
 		return info;
 	}
 
-	void LightProbes::resizeTetrahedronBuffer(UINT32 count)
+	void LightProbes::resizeTetrahedronBuffer(GpuData& gpuData, UINT32 count)
 	{
 		static constexpr UINT32 ELEMENT_SIZE = Math::divideAndRoundUp((UINT32)sizeof(TetrahedronDataGPU), 4U);
 
@@ -779,11 +979,11 @@ namespace bs { namespace ct
 		desc.usage = GBU_STATIC;
 		desc.format = BF_32X4U;
 
-		mTetrahedronInfosGPU = GpuBuffer::create(desc);
-		mMaxTetrahedra = count;
+		gpuData.tetrahedra = GpuBuffer::create(desc);
+		gpuData.maxTetrahedra = count;
 	}
 
-	void LightProbes::resizeTetrahedronFaceBuffer(UINT32 count)
+	void LightProbes::resizeTetrahedronFaceBuffer(GpuData& gpuData, UINT32 count)
 	{
 		static constexpr UINT32 ELEMENT_SIZE = Math::divideAndRoundUp((UINT32)sizeof(TetrahedronFaceDataGPU), 4U);
 
@@ -794,11 +994,11 @@ namespace bs { namespace ct
 		desc.usage = GBU_STATIC;
 		desc.format = BF_32X4F;
 
-		mTetrahedronFaceInfosGPU = GpuBuffer::create(desc);
-		mMaxFaces = count;
+		gpuData.faces = GpuBuffer::create(desc);
+		gpuData.maxFaces = count;
 	}
 
-	void LightProbes::resizeCoefficientTexture(UINT32 numRows)
+	void LightProbes::resizeCoefficientTexture(GpuData& gpuData, UINT32 numRows)
 	{
 		TEXTURE_DESC desc;
 		desc.width = 4096;
@@ -806,14 +1006,10 @@ namespace bs { namespace ct
 		desc.usage = TU_LOADSTORE | TU_RENDERTARGET;
 		desc.format = PF_RGBA32F;
 
-		SPtr<Texture> newTexture = Texture::create(desc);
-		if (mProbeCoefficientsGPU)
-			mProbeCoefficientsGPU->copy(newTexture);
-
-		mProbeCoefficientsGPU = newTexture;
-		mMaxCoefficientRows = numRows;
+		// Note: Not copying the old contents, all volumes are copied over on every rebuild
+		gpuData.coefficients = Texture::create(desc);
+		gpuData.maxCoefficientRows = numRows;
 	}
-
 	void LightProbes::generateTetrahedronData(Vector<Vector3>& positions, Vector<TetrahedronData>& tetrahedra,
 		Vector<TetrahedronFaceData>& faces,	bool generateExtrapolationVolume)
 	{
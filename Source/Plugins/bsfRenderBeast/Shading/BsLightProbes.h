@@ -10,6 +10,7 @@
 #include "Renderer/BsGpuResourcePool.h"
 #include "Renderer/BsParamBlocks.h"
 #include "BsRendererLight.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct
 {
@@ -177,7 +178,12 @@ namespace bs { namespace ct
 		UINT32 numTetrahedra;
 	};
 
-	/** Handles any pre-processing for light (irradiance) probe lighting. */
+	/** 
+	 * Handles any pre-processing for light (irradiance) probe lighting. Tetrahedron volume is generated on a worker
+	 * thread, and the rendering data is double buffered so the previous volume remains in use until the new one is
+	 * ready.
+	 * Volumes whose bounds don't overlap are tetrahedralized separately, and only the ones that changed are rebuilt.
+	 */
 	class LightProbes
 	{
 		/** Internal information about a single light probe volume. */
@@ -187,6 +193,8 @@ namespace bs { namespace ct
 			LightProbeVolume* volume;
 			/** Remains true as long as there are dirty probes in the volume. */
 			bool isDirty;
+			/** Identifier unique to the volume, that doesn't change when other volumes are removed. */
+			UINT32 id;
 		};
 
 		/** 
@@ -213,8 +221,42 @@ namespace bs { namespace ct
 			UINT32 tetrahedron;
 			bool quadratic;
 		};
+
+		/** Tetrahedra generated from probes of a set of volumes with overlapping bounds. */
+		struct VolumeGroupData
+		{
+			/** Sorted identifiers of the volumes in the group. */
+			Vector<UINT32> volumeIds;
+			/** World space positions of all the probes in the group, followed by extrapolation volume vertices. */
+			Vector<Vector3> positions;
+			/** Index into @p volumeIds for each probe. */
+			Vector<UINT32> probeVolumes;
+			/** Index of each probe in its volume's coefficient texture. */
+			Vector<UINT32> probeBufferIndices;
+			/** Non co-planar tetrahedra, referencing @p positions. */
+			Vector<TetrahedronData> tetrahedra;
+			/** Outer faces of the tetrahedra, referencing @p positions and @p tetrahedra. */
+			Vector<TetrahedronFaceData> faces;
+		};
+
+		/** GPU data used for light probe rendering. */
+		struct GpuData
+		{
+			SPtr<Texture> coefficients;
+			SPtr<GpuBuffer> tetrahedra;
+			SPtr<GpuBuffer> faces;
+			SPtr<Mesh> volumeMesh;
+			UINT32 numTetrahedra = 0;
+
+			UINT32 maxCoefficientRows = 0;
+			UINT32 maxTetrahedra = 0;
+			UINT32 maxFaces = 0;
+		};
+
+		struct BuildData;
 	public:
 		LightProbes();
+		~LightProbes();
 
 		/** Notifies sthe manager that the provided light probe volume has been added. */
 		void notifyAdded(LightProbeVolume* volume);
@@ -225,20 +267,38 @@ namespace bs { namespace ct
 		/** Notifies the manager that all the probes in the provided volume have been removed. */
 		void notifyRemoved(LightProbeVolume* volume);
 
-		/** Updates light probe tetrahedron data after probes changed (added/removed/moved). */
+		/** 
+		 * Updates light probe tetrahedron data after probes changed (added/removed/moved). Starts the
+		 * tetrahedralization on a worker thread, and makes its results available through getInfo() on a later call,
+		 * once it completes.
+		 */
 		void updateProbes();
 
-		/** Returns true if there are any registered light probes. */
+		/** Returns true if the data returned by getInfo() contains any light probes. */
 		bool hasAnyProbes() const;
 
 		/** 
-		 * Returns a set of buffers that can be used for rendering the light probes. updateProbes() must be called
-		 * at least once before the buffer is populated. If the probes changed since the last call, call updateProbes()
-		 * to refresh the buffer. 
+		 * Returns a set of buffers that can be used for rendering the light probes. The buffers are populated after an
+		 * updateProbes() call following a completed rebuild, and until then contain the data from the previous rebuild.
 		 */
 		LightProbesInfo getInfo() const;
 
 	private:
+		/** Gathers the probes of all volumes and starts a tetrahedron volume rebuild on a worker thread. */
+		void startBuild();
+
+		/** Copies the results of a completed rebuild into the inactive GPU data, and makes it active. */
+		void applyBuild(const BuildData& data);
+
+		/** Tetrahedralizes the volume groups that need it and generates the volume data. Runs on a worker thread. */
+		static void executeBuild(BuildData& data);
+
+		/** Tetrahedralizes the probes in the group, and keeps the valid tetrahedra. */
+		static void generateGroupData(VolumeGroupData& group);
+
+		/** Merges all the volume groups, and generates the mesh and GPU buffer contents of the tetrahedron volume. */
+		static void generateVolumeData(BuildData& data);
+
 		/**
 		 * Perform tetrahedrization of the provided point list, and outputs a list of tetrahedrons and outer faces of the
 		 * volume. Each entry contains connections to nearby tetrahedrons/faces, as well as a matrix that can be used for
@@ -253,40 +313,31 @@ namespace bs { namespace ct
 		 * @param[in]		generateExtrapolationVolume	If true, the tetrahedron volume will be surrounded with points
 		 *												at "infinity" (technically just far away).
 		 */
-		void generateTetrahedronData(Vector<Vector3>& positions, Vector<TetrahedronData>& tetrahedra, 
+		static void generateTetrahedronData(Vector<Vector3>& positions, Vector<TetrahedronData>& tetrahedra, 
 			Vector<TetrahedronFaceData>& faces, bool generateExtrapolationVolume = false);
 
 		/** Resizes the GPU buffer used for holding tetrahedron data, to the specified size (in number of tetraheda). */
-		void resizeTetrahedronBuffer(UINT32 count);
+		static void resizeTetrahedronBuffer(GpuData& gpuData, UINT32 count);
 
 		/** Resizes the GPU buffer used for holding tetrahedron face data, to the specified size (in number of faces). */
-		void resizeTetrahedronFaceBuffer(UINT32 count);
+		static void resizeTetrahedronFaceBuffer(GpuData& gpuData, UINT32 count);
 
 		/** 
 		 * Resized the GPU buffer that stores light probe SH coefficients, to the specified number of rows (each row
 		 * holds 4096 coefficients, and each volume starts in its own row.). 
 		 */
-		void resizeCoefficientTexture(UINT32 numRows);
+		static void resizeCoefficientTexture(GpuData& gpuData, UINT32 numRows);
 
 		Vector<VolumeInfo> mVolumes;
 		bool mTetrahedronVolumeDirty;
 
-		UINT32 mMaxCoefficientRows;
-		UINT32 mMaxTetrahedra;
-		UINT32 mMaxFaces;
-
-		Vector<TetrahedronData> mTetrahedronInfos;
-
-		SPtr<Texture> mProbeCoefficientsGPU;
-		SPtr<GpuBuffer> mTetrahedronInfosGPU;
-		SPtr<GpuBuffer> mTetrahedronFaceInfosGPU;
-		SPtr<Mesh> mVolumeMesh;
-		UINT32 mNumValidTetrahedra;
+		GpuData mGpuData[2];
+		UINT32 mActiveGpuData;
+		UINT32 mNextVolumeId;
 
-		// Temporary buffers
-		Vector<Vector3> mTempTetrahedronPositions;
-		Vector<UINT32> mTempTetrahedronBufferIndices;
-		Vector<Vector2I> mTempTetrahedronBufferOffsets;
+		Vector<SPtr<VolumeGroupData>> mGroups;
+		SPtr<BuildData> mBuild;
+		SPtr<Task> mBuildTask;
 	};
 
 	/** @} */
@@ -0,0 +1,359 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Shading/BsOcclusionCulling.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Renderer/BsRendererMaterial.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "Image/BsTexture.h"
+#include "BsRendererView.h"
+#include "BsRendererScene.h"
+
+namespace bs { namespace ct
+{
+	/** Occlusion tests use buffers with sizes rounded up to a multiple of this value, so they can be reused. */
+	static constexpr UINT32 OCCLUSION_BUFFER_INCREMENT = 1024;
+
+	/**
+	 * Results are ignored if the view direction rotated by more than this since the test was executed. Stored as the
+	 * cosine of the angle.
+	 */
+	static constexpr float OCCLUSION_MAX_VIEW_ROTATION_COS = 0.96f;
+
+	BS_PARAM_BLOCK_BEGIN(OcclusionCullParamDef)
+		BS_PARAM_BLOCK_ENTRY(Vector4, gNDCToHiZUV)
+		BS_PARAM_BLOCK_ENTRY(Vector2I, gHiZSize)
+		BS_PARAM_BLOCK_ENTRY(INT32, gHiZNumMips)
+		BS_PARAM_BLOCK_ENTRY(INT32, gNumObjects)
+	BS_PARAM_BLOCK_END
+
+	OcclusionCullParamDef gOcclusionCullParamDef;
+
+	/** Shader that tests object bounds against a hierarchical Z buffer, outputting 1 for visible and 0 for occluded. */
+	class OcclusionCullMat : public RendererMaterial<OcclusionCullMat>
+	{
+		static constexpr UINT32 NUM_THREADS = 64;
+
+		RMAT_DEF_CUSTOMIZED("OcclusionCullHiZ.bsl");
+
+	public:
+		OcclusionCullMat();
+
+		/**
+		 * Executes the material.
+		 *
+		 * @param[in]	view		View whose depth buffer was used for generating @p hiZ.
+		 * @param[in]	hiZ			Hierarchical Z buffer containing the farthest depth per texel.
+		 * @param[in]	bounds		Buffer containing world space bounds center and extents for each object.
+		 * @param[in]	numObjects	Number of objects in the @p bounds buffer.
+		 * @param[in]	output		Buffer to receive a single value per object.
+		 */
+		void execute(const RendererView& view, const SPtr<Texture>& hiZ, const SPtr<GpuBuffer>& bounds,
+			UINT32 numObjects, const SPtr<GpuBuffer>& output);
+
+	private:
+		GpuParamBuffer mBoundsParam;
+		GpuParamBuffer mOutputParam;
+		GpuParamTexture mHiZParam;
+		SPtr<GpuParamBlockBuffer> mInputBuffer;
+	};
+
+	OcclusionCullMat::OcclusionCullMat()
+	{
+		mInputBuffer = gOcclusionCullParamDef.createBuffer();
+		mParams->setParamBlockBuffer(GPT_COMPUTE_PROGRAM, "Input", mInputBuffer);
+
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gBounds", mBoundsParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gOutput", mOutputParam);
+		mParams->getTextureParam(GPT_COMPUTE_PROGRAM, "gHiZTex", mHiZParam);
+	}
+
+	void OcclusionCullMat::_initDefines(ShaderDefines& defines)
+	{
+		defines.set("NUM_THREADS", NUM_THREADS);
+	}
+
+	void OcclusionCullMat::execute(const RendererView& view, const SPtr<Texture>& hiZ, const SPtr<GpuBuffer>& bounds,
+		UINT32 numObjects, const SPtr<GpuBuffer>& output)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		const RendererViewProperties& viewProps = view.getProperties();
+		const TextureProperties& hiZProps = hiZ->getProperties();
+		const Rect2I& viewRect = viewProps.target.viewRect;
+
+		// Maps from NDC to UV [0, 1]
+		Vector4 ndcToHiZUV(0.5f, -0.5f, 0.5f, 0.5f);
+
+		// Either of these flips the Y axis, but if they're both true they cancel out
+		const RenderAPIInfo& rapiInfo = RenderAPI::instance().getAPIInfo();
+		if (rapiInfo.isFlagSet(RenderAPIFeatureFlag::UVYAxisUp) ^ rapiInfo.isFlagSet(RenderAPIFeatureFlag::NDCYAxisDown))
+			ndcToHiZUV.y = -ndcToHiZUV.y;
+
+		// Maps from [0, 1] to area of HiZ where depth is stored in
+		ndcToHiZUV.x *= (float)viewRect.width / hiZProps.getWidth();
+		ndcToHiZUV.y *= (float)viewRect.height / hiZProps.getHeight();
+		ndcToHiZUV.z *= (float)viewRect.width / hiZProps.getWidth();
+		ndcToHiZUV.w *= (float)viewRect.height / hiZProps.getHeight();
+
+		Vector2I hiZSize(hiZProps.getWidth(), hiZProps.getHeight());
+		gOcclusionCullParamDef.gNDCToHiZUV.set(mInputBuffer, ndcToHiZUV);
+		gOcclusionCullParamDef.gHiZSize.set(mInputBuffer, hiZSize);
+		gOcclusionCullParamDef.gHiZNumMips.set(mInputBuffer, hiZProps.getNumMipmaps());
+		gOcclusionCullParamDef.gNumObjects.set(mInputBuffer, numObjects);
+
+		mParams->setParamBlockBuffer("PerCamera", view.getPerViewBuffer());
+		mBoundsParam.set(bounds);
+		mOutputParam.set(output);
+		mHiZParam.set(hiZ);
+
+		bind();
+		RenderAPI::instance().dispatchCompute(Math::divideAndRoundUp(numObjects, NUM_THREADS));
+	}
+
+	void OcclusionCulling::cull(const RendererView& view, const SceneInfo& sceneInfo, Vector<UINT32>& visibility)
+	{
+		readResults();
+
+		// Keep testing renderables that are currently occluded, so they can become visible again
+		mCandidates.clear();
+		for (UINT32 i = 0; i < (UINT32)visibility.size(); i++)
+		{
+			UINT32 word = visibility[i];
+			while (word != 0)
+			{
+				mCandidates.push_back(i * 32 + Bitwise::leastSignificantBit(word));
+				word &= word - 1;
+			}
+		}
+
+		mResultsUsable = false;
+		if (!mHasResults)
+			return;
+
+		// Results are a few frames old, and therefore only usable if the view didn't change too much since
+		const RendererViewProperties& viewProps = view.getProperties();
+		if (viewProps.projTransform != mProjTransform ||
+			viewProps.viewDirection.dot(mViewDirection) < OCCLUSION_MAX_VIEW_ROTATION_COS)
+			return;
+
+		mResultsUsable = true;
+		if (!remapResults(sceneInfo))
+			return;
+
+		const UINT32 numWords = std::min((UINT32)visibility.size(), (UINT32)mOccluded.size());
+		for (UINT32 i = 0; i < numWords; i++)
+			visibility[i] &= ~mOccluded[i];
+	}
+
+	void OcclusionCulling::cullLights(LightType type, const Vector<Sphere>& bounds, Vector<bool>& visibility)
+	{
+		const UINT32 typeIdx = type == LightType::Radial ? 0 : 1;
+
+		// Keep testing lights that are currently occluded, so they can become visible again
+		Vector<LightEntry>& candidates = mLightCandidates[typeIdx];
+		candidates.clear();
+		for (UINT32 i = 0; i < (UINT32)visibility.size(); i++)
+		{
+			if (visibility[i])
+				candidates.push_back({ i, bounds[i] });
+		}
+
+		if (!mResultsUsable)
+			return;
+
+		for (auto& entry : mOccludedLights[typeIdx])
+		{
+			if (entry.idx >= (UINT32)visibility.size())
+				continue;
+
+			const Sphere& current = bounds[entry.idx];
+			if (current.getCenter() == entry.bounds.getCenter() && current.getRadius() == entry.bounds.getRadius())
+				visibility[entry.idx] = false;
+		}
+	}
+
+	void OcclusionCulling::execute(const RendererView& view, const SceneInfo& sceneInfo, const SPtr<Texture>& hiZ)
+	{
+		Query& query = mQueries[mNumTests % (READBACK_LATENCY + 1)];
+		query.testIdx = mNumTests++;
+		query.pending = false;
+
+		const auto numRenderables = (UINT32)mCandidates.size();
+		UINT32 numObjects = numRenderables;
+		for (auto& entry : mLightCandidates)
+			numObjects += (UINT32)entry.size();
+
+		if (numObjects == 0)
+			return;
+
+		const UINT32 bufferSize = Math::divideAndRoundUp(numObjects, OCCLUSION_BUFFER_INCREMENT) *
+			OCCLUSION_BUFFER_INCREMENT;
+
+		if (query.output == nullptr || query.output->getProperties().getElementCount() < bufferSize)
+		{
+			GPU_BUFFER_DESC boundsDesc;
+			boundsDesc.type = GBT_STANDARD;
+			boundsDesc.format = BF_32X4F;
+			boundsDesc.elementCount = bufferSize * 2;
+			boundsDesc.usage = GBU_DYNAMIC;
+
+			query.bounds = GpuBuffer::create(boundsDesc);
+
+			GPU_BUFFER_DESC outputDesc;
+			outputDesc.type = GBT_STANDARD;
+			outputDesc.format = BF_32X1U;
+			outputDesc.elementCount = bufferSize;
+			outputDesc.usage = GBU_DYNAMIC;
+
+			query.output = GpuBuffer::create(outputDesc);
+		}
+
+		Vector4* boundsData = (Vector4*)query.bounds->lock(GBL_WRITE_ONLY_DISCARD);
+		for (UINT32 i = 0; i < numRenderables; i++)
+		{
+			const AABox& box = sceneInfo.renderableCullInfos[mCandidates[i]].bounds.getBox();
+			const Vector3 center = box.getCenter();
+			const Vector3 extents = box.getHalfSize();
+
+			boundsData[i * 2 + 0] = Vector4(center.x, center.y, center.z, 0.0f);
+			boundsData[i * 2 + 1] = Vector4(extents.x, extents.y, extents.z, 0.0f);
+		}
+
+		// Lights follow the renderables, tested using the box enclosing their bounding sphere
+		UINT32 objectIdx = numRenderables;
+		for (auto& entry : mLightCandidates)
+		{
+			for (auto& light : entry)
+			{
+				const Vector3& center = light.bounds.getCenter();
+				const float radius = light.bounds.getRadius();
+
+				boundsData[objectIdx * 2 + 0] = Vector4(center.x, center.y, center.z, 0.0f);
+				boundsData[objectIdx * 2 + 1] = Vector4(radius, radius, radius, 0.0f);
+				objectIdx++;
+			}
+		}
+		query.bounds->unlock();
+
+		OcclusionCullMat* material = OcclusionCullMat::get();
+		material->execute(view, hiZ, query.bounds, numObjects, query.output);
+
+		const RendererViewProperties& viewProps = view.getProperties();
+		std::swap(query.renderables, mCandidates);
+		for (UINT32 i = 0; i < NUM_LIGHT_TYPES; i++)
+			std::swap(query.lights[i], mLightCandidates[i]);
+		query.renderableIdVersion = sceneInfo.renderableIdVersion;
+		query.viewDirection = viewProps.viewDirection;
+		query.projTransform = viewProps.projTransform;
+		query.pending = true;
+	}
+
+	void OcclusionCulling::clear()
+	{
+		for (auto& query : mQueries)
+			query.pending = false;
+
+		mCandidates.clear();
+		mOccluded.clear();
+		mHasResults = false;
+		mResultsUsable = false;
+
+		for (UINT32 i = 0; i < NUM_LIGHT_TYPES; i++)
+		{
+			mLightCandidates[i].clear();
+			mOccludedLights[i].clear();
+		}
+	}
+
+	void OcclusionCulling::readResults()
+	{
+		// Find the most recent test that had enough time to complete, older ones are superseded by it
+		Query* latest = nullptr;
+		for (auto& query : mQueries)
+		{
+			if (!query.pending || query.testIdx + READBACK_LATENCY > mNumTests)
+				continue;
+
+			if (latest == nullptr || query.testIdx > latest->testIdx)
+				latest = &query;
+		}
+
+		if (latest == nullptr)
+			return;
+
+		for (auto& query : mQueries)
+		{
+			if (query.testIdx <= latest->testIdx)
+				query.pending = false;
+		}
+
+		mOccluded.clear();
+
+		const auto numRenderables = (UINT32)latest->renderables.size();
+		const UINT32* results = (const UINT32*)latest->output->lock(GBL_READ_ONLY);
+		for (UINT32 i = 0; i < numRenderables; i++)
+		{
+			if (results[i] != 0)
+				continue;
+
+			const UINT32 renderableIdx = latest->renderables[i];
+			if (renderableIdx / 32 >= (UINT32)mOccluded.size())
+				mOccluded.resize(renderableIdx / 32 + 1, 0);
+
+			mOccluded[renderableIdx / 32] |= 1u << (renderableIdx % 32);
+		}
+
+		UINT32 objectIdx = numRenderables;
+		for (UINT32 i = 0; i < NUM_LIGHT_TYPES; i++)
+		{
+			mOccludedLights[i].clear();
+			for (auto& entry : latest->lights[i])
+			{
+				if (results[objectIdx++] == 0)
+					mOccludedLights[i].push_back(entry);
+			}
+		}
+		latest->output->unlock();
+
+		mHasResults = true;
+		mRenderableIdVersion = latest->renderableIdVersion;
+		mViewDirection = latest->viewDirection;
+		mProjTransform = latest->projTransform;
+	}
+
+	bool OcclusionCulling::remapResults(const SceneInfo& sceneInfo)
+	{
+		const Vector<RenderableIdChange>& changes = sceneInfo.renderableIdChanges;
+		const UINT32 firstChange = mRenderableIdVersion - sceneInfo.renderableIdChangesVersion;
+		if (firstChange > (UINT32)changes.size())
+			return false;
+
+		const auto numOccludedIds = (UINT32)mOccluded.size() * 32;
+		for (UINT32 i = firstChange; i < (UINT32)changes.size(); i++)
+		{
+			// The renderable that was moved into the removed slot brings its result along
+			const RenderableIdChange& change = changes[i];
+
+			bool occluded = false;
+			if (change.movedId < numOccludedIds)
+			{
+				const UINT32 movedMask = 1u << (change.movedId % 32);
+				occluded = change.movedId != change.removedId && (mOccluded[change.movedId / 32] & movedMask) != 0;
+				mOccluded[change.movedId / 32] &= ~movedMask;
+			}
+
+			if (change.removedId < numOccludedIds)
+			{
+				const UINT32 removedMask = 1u << (change.removedId % 32);
+				if (occluded)
+					mOccluded[change.removedId / 32] |= removedMask;
+				else
+					mOccluded[change.removedId / 32] &= ~removedMask;
+			}
+		}
+
+		mRenderableIdVersion = sceneInfo.renderableIdVersion;
+		return true;
+	}
+}}
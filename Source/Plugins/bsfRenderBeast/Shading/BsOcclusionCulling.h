@@ -0,0 +1,124 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Math/BsMatrix4.h"
+#include "Math/BsSphere.h"
+#include "Renderer/BsLight.h"
+
+namespace bs { namespace ct
+{
+	struct SceneInfo;
+
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/**
+	 * Culls renderables and lights of a single view that are hidden behind other geometry. Bounds of objects that passed
+	 * frustum culling are tested on the GPU against a hierarchical Z buffer containing the farthest depth of the view's
+	 * depth buffer. A light whose bounds are hidden cannot affect any visible surface, meaning its shadows don't need to
+	 * be rendered either. In order to avoid stalls the results are read back a few frames after the test was queued, and are then
+	 * used for culling in the frames that follow.
+	 *
+	 * Culling is conservative: a renderable is only culled if the most recent results marked it as occluded, and it is
+	 * treated as visible whenever no valid results exist for it (e.g. it wasn't tested yet or the view changed
+	 * significantly since the test). Results are remapped when renderable IDs change due to renderables being removed
+	 * from the scene.
+	 */
+	class OcclusionCulling
+	{
+	public:
+		/** Number of frames between queuing an occlusion test and reading back its results. */
+		static constexpr UINT32 READBACK_LATENCY = 2;
+
+		/**
+		 * Clears the bits of renderables that the most recent available results marked as occluded. The provided bits are
+		 * also recorded as the set of renderables to test during the next call to execute().
+		 *
+		 * @param[in]		view		View whose renderables to cull.
+		 * @param[in]		sceneInfo	Information about the scene the view is rendering.
+		 * @param[in, out]	visibility	Bitfield with one bit per renderable, set if the renderable is in the view frustum.
+		 */
+		void cull(const RendererView& view, const SceneInfo& sceneInfo, Vector<UINT32>& visibility);
+
+		/**
+		 * Clears the entries of lights that the most recent available results marked as occluded. The provided entries are
+		 * also recorded as the set of lights to test during the next call to execute(). Must be called after cull() for
+		 * the current frame.
+		 *
+		 * @param[in]		type		Type of the lights, radial or spot.
+		 * @param[in]		bounds		World space bounds of all lights of the provided type, indexed by light ID.
+		 * @param[in, out]	visibility	One entry per light, true if the light is in the view frustum.
+		 */
+		void cullLights(LightType type, const Vector<Sphere>& bounds, Vector<bool>& visibility);
+
+		/**
+		 * Queues an occlusion test for all renderables and lights that were visible during the last calls to cull() and
+		 * cullLights(). Results of the test become available after READBACK_LATENCY more tests have been queued.
+		 *
+		 * @param[in]	view		View whose objects to test.
+		 * @param[in]	sceneInfo	Information about the scene the view is rendering.
+		 * @param[in]	hiZ			Hierarchical Z buffer for the current frame, where each texel contains the farthest
+		 *							depth of the area it covers.
+		 */
+		void execute(const RendererView& view, const SceneInfo& sceneInfo, const SPtr<Texture>& hiZ);
+
+		/** Discards any queued tests and available results. Renderables will be treated as visible until new results arrive. */
+		void clear();
+
+	private:
+		/** Number of light types that can be tested for occlusion (radial and spot). */
+		static constexpr UINT32 NUM_LIGHT_TYPES = 2;
+
+		/** 
+		 * Light tested for occlusion. Light IDs aren't versioned like renderable IDs, so results are only applied if the
+		 * light with the same ID still has the same bounds. This also keeps lights that moved since the test visible.
+		 */
+		struct LightEntry
+		{
+			UINT32 idx;
+			Sphere bounds;
+		};
+
+		/** Occlusion test queued on the GPU. */
+		struct Query
+		{
+			SPtr<GpuBuffer> bounds;
+			SPtr<GpuBuffer> output;
+			Vector<UINT32> renderables;
+			Vector<LightEntry> lights[NUM_LIGHT_TYPES];
+			UINT64 testIdx = 0;
+			UINT32 renderableIdVersion = 0;
+			Vector3 viewDirection;
+			Matrix4 projTransform;
+			bool pending = false;
+		};
+
+		/** Reads back the results of the most recent query whose results are ready, if any. */
+		void readResults();
+
+		/** 
+		 * Updates the results to account for any renderable ID changes since the results were queued. Returns false if
+		 * the results cannot be remapped, because the scene no longer keeps track of the required changes.
+		 */
+		bool remapResults(const SceneInfo& sceneInfo);
+
+		Query mQueries[READBACK_LATENCY + 1];
+		UINT64 mNumTests = 0;
+		Vector<UINT32> mCandidates;
+		Vector<LightEntry> mLightCandidates[NUM_LIGHT_TYPES];
+
+		// Results of the most recent resolved query
+		bool mHasResults = false;
+		bool mResultsUsable = false; // True if the results can be used for culling during the current frame
+		Vector<UINT32> mOccluded;
+		Vector<LightEntry> mOccludedLights[NUM_LIGHT_TYPES];
+		UINT32 mRenderableIdVersion = 0;
+		Vector3 mViewDirection;
+		Matrix4 mProjTransform;
+	};
+
+	/** @} */
+}}
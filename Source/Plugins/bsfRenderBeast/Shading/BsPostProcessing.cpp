@@ -1102,12 +1102,22 @@ namespace bs { namespace ct
 		rapi.setViewport(Rect2(0, 0, 1, 1));
 	}
 
-	BuildHiZMat* BuildHiZMat::getVariation(bool noTextureViews)
+	BuildHiZMat* BuildHiZMat::getVariation(bool noTextureViews, bool farDepth)
 	{
 		if (noTextureViews)
-			return get(getVariation<true>());
-		
-		return get(getVariation<false>());
+		{
+			if (farDepth)
+				return get(getVariation<true, true>());
+			else
+				return get(getVariation<true, false>());
+		}
+		else
+		{
+			if (farDepth)
+				return get(getVariation<false, true>());
+			else
+				return get(getVariation<false, false>());
+		}
 	}
 
 	FXAAParamDef gFXAAParamDef;
@@ -1643,88 +1653,26 @@ namespace bs { namespace ct
 	TemporalResolveParamDef gTemporalResolveParamDef;
 	SSRResolveParamDef gSSRResolveParamDef;
 
-	SSRResolveMat::SSRResolveMat()
+	/**
+	 * Generates weights of the scene color samples used by the TemporalResolve shader include, and writes them to the
+	 * provided buffer.
+	 *
+	 * @param[in]	jitter		Sub-pixel offset that was applied to the projection when rendering the scene color, in
+	 *							pixels.
+	 * @param[in]	useYCoCg	True if the shader performs the resolve in YCoCg color space, requiring only a + pattern
+	 *							of samples.
+	 * @param[in]	buffer		Buffer created from gTemporalResolveParamDef to write the weights to.
+	 */
+	static void populateTemporalResolveParams(const Vector2& jitter, bool useYCoCg, 
+		const SPtr<GpuParamBlockBuffer>& buffer)
 	{
-		mSSRParamBuffer = gSSRResolveParamDef.createBuffer();
-		mTemporalParamBuffer = gTemporalResolveParamDef.createBuffer();
-
-		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSceneDepth", mSceneDepthTexture);
-		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSceneColor", mSceneColorTexture);
-		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gPrevColor", mPrevColorTexture);
-
-		mParams->setParamBlockBuffer(GPT_FRAGMENT_PROGRAM, "Input", mSSRParamBuffer);
-		mParams->setParamBlockBuffer(GPT_FRAGMENT_PROGRAM, "TemporalInput", mTemporalParamBuffer);
-
-		SAMPLER_STATE_DESC pointSampDesc;
-		pointSampDesc.minFilter = FO_POINT;
-		pointSampDesc.magFilter = FO_POINT;
-		pointSampDesc.mipFilter = FO_POINT;
-		pointSampDesc.addressMode.u = TAM_CLAMP;
-		pointSampDesc.addressMode.v = TAM_CLAMP;
-		pointSampDesc.addressMode.w = TAM_CLAMP;
-
-		SPtr<SamplerState> pointSampState = SamplerState::create(pointSampDesc);
-
-		if(mParams->hasSamplerState(GPT_FRAGMENT_PROGRAM, "gPointSampler"))
-			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gPointSampler", pointSampState);
-		else
-			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gSceneDepth", pointSampState);
-
-		SAMPLER_STATE_DESC linearSampDesc;
-		linearSampDesc.minFilter = FO_POINT;
-		linearSampDesc.magFilter = FO_POINT;
-		linearSampDesc.mipFilter = FO_POINT;
-		linearSampDesc.addressMode.u = TAM_CLAMP;
-		linearSampDesc.addressMode.v = TAM_CLAMP;
-		linearSampDesc.addressMode.w = TAM_CLAMP;
-
-		SPtr<SamplerState> linearSampState = SamplerState::create(linearSampDesc);
-		if(mParams->hasSamplerState(GPT_FRAGMENT_PROGRAM, "gLinearSampler"))
-			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gLinearSampler", linearSampState);
-		else
-		{
-			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gSceneColor", linearSampState);
-			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gPrevColor", linearSampState);
-		}
-	}
-
-	void SSRResolveMat::execute(const RendererView& view, const SPtr<Texture>& prevFrame, 
-		const SPtr<Texture>& curFrame, const SPtr<Texture>& sceneDepth, const SPtr<RenderTarget>& destination)
-	{
-		BS_RENMAT_PROFILE_BLOCK
-
-		// Note: This shader should not be called when temporal AA is turned on
-		// Note: This shader doesn't have velocity texture enabled and will only account for camera movement (can be easily
-		//		 enabled when velocity texture is added)
-		//   - WHen added, velocity should use a 16-bit SNORM format
-
-		mPrevColorTexture.set(prevFrame);
-		mSceneColorTexture.set(curFrame);
-		mSceneDepthTexture.set(sceneDepth);
-
-		auto& colorProps = curFrame->getProperties(); // Assuming prev and current frame are the same size
-		auto& depthProps = sceneDepth->getProperties();
-
-		Vector2 colorPixelSize(1.0f / colorProps.getWidth(), 1.0f / colorProps.getHeight());
-		Vector2 depthPixelSize(1.0f / depthProps.getWidth(), 1.0f / depthProps.getHeight());
-
-		gSSRResolveParamDef.gSceneColorTexelSize.set(mSSRParamBuffer, colorPixelSize);
-		gSSRResolveParamDef.gSceneDepthTexelSize.set(mSSRParamBuffer, depthPixelSize);
-		gSSRResolveParamDef.gManualExposure.set(mSSRParamBuffer, 1.0f);
-
-		// Generate samples
-		// Note: Move this code to a more general spot where it can be used by other temporal shaders.
-		
 		float sampleWeights[9];
 		float sampleWeightsLowPass[9];
 
 		float totalWeights = 0.0f;
 		float totalWeightsLowPass = 0.0f;
 
-		Vector2 jitter(BsZero); // Only relevant for general case, not using this type of jitter for SSR
-
 		// Weights are generated using an exponential fit to Blackman-Harris 3.3
-		bool useYCoCg = false; // Only relevant for general case, not using it for SSR
 		float sharpness = 1.0f; // Make this a customizable parameter eventually
 		if(useYCoCg)
 		{
@@ -1786,9 +1734,82 @@ namespace bs { namespace ct
 
 		for (UINT32 i = 0; i < 9; ++i)
 		{
-			gTemporalResolveParamDef.gSampleWeights.set(mTemporalParamBuffer, sampleWeights[i] / totalWeights, i);
-			gTemporalResolveParamDef.gSampleWeightsLowpass.set(mTemporalParamBuffer, sampleWeightsLowPass[i] / totalWeightsLowPass, i);
+			gTemporalResolveParamDef.gSampleWeights.set(buffer, sampleWeights[i] / totalWeights, i);
+			gTemporalResolveParamDef.gSampleWeightsLowpass.set(buffer, sampleWeightsLowPass[i] / totalWeightsLowPass, i);
+		}
+	}
+
+	SSRResolveMat::SSRResolveMat()
+	{
+		mSSRParamBuffer = gSSRResolveParamDef.createBuffer();
+		mTemporalParamBuffer = gTemporalResolveParamDef.createBuffer();
+
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSceneDepth", mSceneDepthTexture);
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSceneColor", mSceneColorTexture);
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gPrevColor", mPrevColorTexture);
+
+		mParams->setParamBlockBuffer(GPT_FRAGMENT_PROGRAM, "Input", mSSRParamBuffer);
+		mParams->setParamBlockBuffer(GPT_FRAGMENT_PROGRAM, "TemporalInput", mTemporalParamBuffer);
+
+		SAMPLER_STATE_DESC pointSampDesc;
+		pointSampDesc.minFilter = FO_POINT;
+		pointSampDesc.magFilter = FO_POINT;
+		pointSampDesc.mipFilter = FO_POINT;
+		pointSampDesc.addressMode.u = TAM_CLAMP;
+		pointSampDesc.addressMode.v = TAM_CLAMP;
+		pointSampDesc.addressMode.w = TAM_CLAMP;
+
+		SPtr<SamplerState> pointSampState = SamplerState::create(pointSampDesc);
+
+		if(mParams->hasSamplerState(GPT_FRAGMENT_PROGRAM, "gPointSampler"))
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gPointSampler", pointSampState);
+		else
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gSceneDepth", pointSampState);
+
+		SAMPLER_STATE_DESC linearSampDesc;
+		linearSampDesc.minFilter = FO_POINT;
+		linearSampDesc.magFilter = FO_POINT;
+		linearSampDesc.mipFilter = FO_POINT;
+		linearSampDesc.addressMode.u = TAM_CLAMP;
+		linearSampDesc.addressMode.v = TAM_CLAMP;
+		linearSampDesc.addressMode.w = TAM_CLAMP;
+
+		SPtr<SamplerState> linearSampState = SamplerState::create(linearSampDesc);
+		if(mParams->hasSamplerState(GPT_FRAGMENT_PROGRAM, "gLinearSampler"))
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gLinearSampler", linearSampState);
+		else
+		{
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gSceneColor", linearSampState);
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gPrevColor", linearSampState);
 		}
+	}
+
+	void SSRResolveMat::execute(const RendererView& view, const SPtr<Texture>& prevFrame, 
+		const SPtr<Texture>& curFrame, const SPtr<Texture>& sceneDepth, const SPtr<RenderTarget>& destination)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		// Note: This shader should not be called when temporal AA is turned on
+		// Note: This shader doesn't have velocity texture enabled and will only account for camera movement (can be easily
+		//		 enabled when velocity texture is added)
+		//   - WHen added, velocity should use a 16-bit SNORM format
+
+		mPrevColorTexture.set(prevFrame);
+		mSceneColorTexture.set(curFrame);
+		mSceneDepthTexture.set(sceneDepth);
+
+		auto& colorProps = curFrame->getProperties(); // Assuming prev and current frame are the same size
+		auto& depthProps = sceneDepth->getProperties();
+
+		Vector2 colorPixelSize(1.0f / colorProps.getWidth(), 1.0f / colorProps.getHeight());
+		Vector2 depthPixelSize(1.0f / depthProps.getWidth(), 1.0f / depthProps.getHeight());
+
+		gSSRResolveParamDef.gSceneColorTexelSize.set(mSSRParamBuffer, colorPixelSize);
+		gSSRResolveParamDef.gSceneDepthTexelSize.set(mSSRParamBuffer, depthPixelSize);
+		gSSRResolveParamDef.gManualExposure.set(mSSRParamBuffer, 1.0f);
+
+		// Projection jitter and YCoCg space are not used for SSR
+		populateTemporalResolveParams(Vector2(BsZero), false, mTemporalParamBuffer);
 		
 		SPtr<GpuParamBlockBuffer> perView = view.getPerViewBuffer();
 		mParams->setParamBlockBuffer("PerCamera", perView);
@@ -1815,6 +1836,103 @@ namespace bs { namespace ct
 			return get(getVariation<false>());
 	}
 
+	TemporalAAParamDef gTemporalAAParamDef;
+
+	TemporalAAMat::TemporalAAMat()
+	{
+		mParamBuffer = gTemporalAAParamDef.createBuffer();
+		mTemporalParamBuffer = gTemporalResolveParamDef.createBuffer();
+
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSceneDepth", mSceneDepthTexture);
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gSceneColor", mSceneColorTexture);
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gPrevColor", mPrevColorTexture);
+
+		mParams->setParamBlockBuffer(GPT_FRAGMENT_PROGRAM, "Input", mParamBuffer);
+		mParams->setParamBlockBuffer(GPT_FRAGMENT_PROGRAM, "TemporalInput", mTemporalParamBuffer);
+
+		SAMPLER_STATE_DESC pointSampDesc;
+		pointSampDesc.minFilter = FO_POINT;
+		pointSampDesc.magFilter = FO_POINT;
+		pointSampDesc.mipFilter = FO_POINT;
+		pointSampDesc.addressMode.u = TAM_CLAMP;
+		pointSampDesc.addressMode.v = TAM_CLAMP;
+		pointSampDesc.addressMode.w = TAM_CLAMP;
+
+		SPtr<SamplerState> pointSampState = SamplerState::create(pointSampDesc);
+
+		SAMPLER_STATE_DESC linearSampDesc;
+		linearSampDesc.minFilter = FO_LINEAR;
+		linearSampDesc.magFilter = FO_LINEAR;
+		linearSampDesc.mipFilter = FO_POINT;
+		linearSampDesc.addressMode.u = TAM_CLAMP;
+		linearSampDesc.addressMode.v = TAM_CLAMP;
+		linearSampDesc.addressMode.w = TAM_CLAMP;
+
+		SPtr<SamplerState> linearSampState = SamplerState::create(linearSampDesc);
+
+		// Current frame samples are weighted per-texel, while history is sampled at an arbitrary reprojected position
+		if(mParams->hasSamplerState(GPT_FRAGMENT_PROGRAM, "gPointSampler"))
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gPointSampler", pointSampState);
+		else
+		{
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gSceneDepth", pointSampState);
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gSceneColor", pointSampState);
+		}
+
+		if(mParams->hasSamplerState(GPT_FRAGMENT_PROGRAM, "gLinearSampler"))
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gLinearSampler", linearSampState);
+		else
+			mParams->setSamplerState(GPT_FRAGMENT_PROGRAM, "gPrevColor", linearSampState);
+	}
+
+	void TemporalAAMat::execute(const RendererView& view, const SPtr<Texture>& sceneColor, 
+		const SPtr<Texture>& prevFrame, const SPtr<Texture>& sceneDepth, const SPtr<RenderTarget>& destination)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		// Note: Only velocity due to camera movement is accounted for, as the base pass doesn't output per-object
+		// velocity. Moving objects rely on neighborhood clipping to avoid ghosting.
+
+		mSceneColorTexture.set(sceneColor);
+		mPrevColorTexture.set(prevFrame);
+		mSceneDepthTexture.set(sceneDepth);
+
+		const TextureProperties& colorProps = sceneColor->getProperties();
+		const TextureProperties& prevColorProps = prevFrame->getProperties();
+		const TextureProperties& depthProps = sceneDepth->getProperties();
+
+		Vector2 colorPixelSize(1.0f / colorProps.getWidth(), 1.0f / colorProps.getHeight());
+		Vector2 prevColorPixelSize(1.0f / prevColorProps.getWidth(), 1.0f / prevColorProps.getHeight());
+		Vector2 depthPixelSize(1.0f / depthProps.getWidth(), 1.0f / depthProps.getHeight());
+
+		const RenderSettings& settings = view.getRenderSettings();
+
+		// Note: Eye adaptation is not accounted for, only the manual exposure
+		gTemporalAAParamDef.gSceneColorTexelSize.set(mParamBuffer, colorPixelSize);
+		gTemporalAAParamDef.gPrevColorTexelSize.set(mParamBuffer, prevColorPixelSize);
+		gTemporalAAParamDef.gSceneDepthTexelSize.set(mParamBuffer, depthPixelSize);
+		gTemporalAAParamDef.gManualExposure.set(mParamBuffer, Math::pow(2.0f, settings.exposureScale));
+
+		// Convert the projection jitter from NDC into scene color pixels
+		const RendererViewProperties& viewProps = view.getProperties();
+		const Vector4 ndcToUV = view.getNDCToUV();
+
+		Vector2 jitter;
+		jitter.x = viewProps.temporalJitter.x * ndcToUV.x * colorProps.getWidth();
+		jitter.y = viewProps.temporalJitter.y * ndcToUV.y * colorProps.getHeight();
+
+		populateTemporalResolveParams(jitter, false, mTemporalParamBuffer);
+
+		SPtr<GpuParamBlockBuffer> perView = view.getPerViewBuffer();
+		mParams->setParamBlockBuffer("PerCamera", perView);
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.setRenderTarget(destination);
+
+		bind();
+		gRendererUtility().drawScreenQuad();
+	}
+
 	EncodeDepthParamDef gEncodeDepthParamDef;
 
 	EncodeDepthMat::EncodeDepthMat()
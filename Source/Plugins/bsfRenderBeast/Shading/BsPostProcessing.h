@@ -618,12 +618,13 @@ namespace bs { namespace ct
 		RMAT_DEF("PPBuildHiZ.bsl");
 
 		/** Helper method used for initializing variations of this material. */
-		template<bool noTextureViews>
+		template<bool noTextureViews, bool farDepth>
 		static const ShaderVariation& getVariation()
 		{
 			static ShaderVariation variation = ShaderVariation(
 			{
 				ShaderVariation::Param("NO_TEXTURE_VIEWS", noTextureViews),
+				ShaderVariation::Param("FAR_DEPTH", farDepth),
 			});
 
 			return variation;
@@ -649,8 +650,10 @@ namespace bs { namespace ct
 		 *
 		 * @param	noTextureViews		Specify as true if the current render backend doesn't support texture views, in
 		 *								which case the implementation falls back on using a simpler version of the shader.
+		 * @param	farDepth			If true each texel will contain the farthest depth of the area it covers, instead
+		 *								of the nearest one. Such a buffer is used for occlusion testing.
 		 */
-		static BuildHiZMat* getVariation(bool noTextureViews);
+		static BuildHiZMat* getVariation(bool noTextureViews, bool farDepth = false);
 	private:
 		GpuParamTexture mInputTexture;
 		SPtr<GpuParamBlockBuffer> mParamBuffer;
@@ -1043,6 +1046,48 @@ namespace bs { namespace ct
 		GpuParamTexture mEyeAdaptationTexture;
 	};
 
+	BS_PARAM_BLOCK_BEGIN(TemporalAAParamDef)
+		BS_PARAM_BLOCK_ENTRY(Vector2, gSceneDepthTexelSize)
+		BS_PARAM_BLOCK_ENTRY(Vector2, gSceneColorTexelSize)
+		BS_PARAM_BLOCK_ENTRY(Vector2, gPrevColorTexelSize)
+		BS_PARAM_BLOCK_ENTRY(float, gManualExposure)
+	BS_PARAM_BLOCK_END
+
+	extern TemporalAAParamDef gTemporalAAParamDef;
+
+	/** 
+	 * Shader that performs temporal anti-aliasing by blending the scene color with the reprojected result of the previous
+	 * frame. The output can be larger than the scene color, in which case the scene is upsampled at the same time.
+	 */
+	class TemporalAAMat : public RendererMaterial<TemporalAAMat>
+	{
+		RMAT_DEF("PPTemporalAA.bsl");
+
+	public:
+		TemporalAAMat();
+
+		/** 
+		 * Renders the effect with the provided parameters. 
+		 * 
+		 * @param[in]	view			Information about the view we're rendering from.
+		 * @param[in]	sceneColor		Non-MSAA scene color rendered this frame.
+		 * @param[in]	prevFrame		Output of the effect from the previous frame. Should be the same size as
+		 *								@p destination.
+		 * @param[in]	sceneDepth		Non-MSAA buffer containing scene depth, the same size as @p sceneColor.
+		 * @param[in]	destination		Render target to which to write the results to.
+		 */
+		void execute(const RendererView& view, const SPtr<Texture>& sceneColor, const SPtr<Texture>& prevFrame, 
+			const SPtr<Texture>& sceneDepth, const SPtr<RenderTarget>& destination);
+
+	private:
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+		SPtr<GpuParamBlockBuffer> mTemporalParamBuffer;
+
+		GpuParamTexture mSceneColorTexture;
+		GpuParamTexture mPrevColorTexture;
+		GpuParamTexture mSceneDepthTexture;
+	};
+
 	BS_PARAM_BLOCK_BEGIN(EncodeDepthParamDef)
 		BS_PARAM_BLOCK_ENTRY(float, gNear)
 		BS_PARAM_BLOCK_ENTRY(float, gFar)
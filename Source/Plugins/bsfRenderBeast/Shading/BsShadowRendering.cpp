@@ -348,38 +348,148 @@ namespace bs { namespace ct
 		normArea.height = area.height / (float)atlasSize;
 	}
 
-	ShadowMapAtlas::ShadowMapAtlas(UINT32 size)
-		: mLayout(0, 0, size, size, true), mLastUsedCounter(0)
+	ShadowMapAtlas::ShadowMapAtlas(UINT32 size, UINT32 minMapSize)
+		: mSize(size), mMinMapSize(minMapSize), mLastUsedCounter(0)
 	{
 		mAtlas = GpuResourcePool::instance().get(
 			POOLED_RENDER_TEXTURE_DESC::create2D(SHADOW_MAP_FORMAT, size, size, TU_DEPTHSTENCIL));
+
+		UINT32 numNodes = 0;
+		for (UINT32 levelSize = size, numLevelNodes = 1; levelSize >= minMapSize; levelSize /= 2, numLevelNodes *= 4)
+			numNodes += numLevelNodes;
+
+		mNodeStates.resize(numNodes, NodeState::Free);
+		mLargestFree.resize(numNodes, 0);
+		mLargestFree[0] = size;
 	}
 
 	bool ShadowMapAtlas::addMap(UINT32 size, Rect2I& area, UINT32 border)
 	{
-		UINT32 sizeWithBorder = size + border * 2;
-
-		UINT32 x, y;
-		if (!mLayout.addElement(sizeWithBorder, sizeWithBorder, x, y))
+		const UINT32 regionSize = getRegionSize(size + border * 2);
+		if (regionSize > mLargestFree[0])
 			return false;
 
+		// Descend towards a node of the region's size. Prefer the child with the smallest free region that still fits,
+		// so larger free regions remain available for larger maps.
+		UINT32 nodeIdx = 0;
+		UINT32 nodeSize = mSize;
+		UINT32 x = 0;
+		UINT32 y = 0;
+		while (nodeSize > regionSize)
+		{
+			const UINT32 childSize = nodeSize / 2;
+			const UINT32 firstChildIdx = nodeIdx * 4 + 1;
+
+			if (mNodeStates[nodeIdx] == NodeState::Free)
+			{
+				mNodeStates[nodeIdx] = NodeState::Split;
+				for (UINT32 i = 0; i < 4; i++)
+				{
+					mNodeStates[firstChildIdx + i] = NodeState::Free;
+					mLargestFree[firstChildIdx + i] = childSize;
+				}
+			}
+
+			UINT32 bestChild = (UINT32)-1;
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				const UINT32 largestFree = mLargestFree[firstChildIdx + i];
+				if (largestFree < regionSize)
+					continue;
+
+				if (bestChild == (UINT32)-1 || largestFree < mLargestFree[firstChildIdx + bestChild])
+					bestChild = i;
+			}
+
+			x += (bestChild % 2) * childSize;
+			y += (bestChild / 2) * childSize;
+			nodeIdx = firstChildIdx + bestChild;
+			nodeSize = childSize;
+		}
+
+		mNodeStates[nodeIdx] = NodeState::Used;
+		mLargestFree[nodeIdx] = 0;
+		updateParents(nodeIdx, nodeSize);
+
 		area.width = area.height = size;
 		area.x = x + border;
 		area.y = y + border;
 
+		mNumMaps++;
 		mLastUsedCounter = 0;
 		return true;
 	}
 
-	void ShadowMapAtlas::clear()
+	void ShadowMapAtlas::removeMap(const Rect2I& area, UINT32 border)
 	{
-		mLayout.clear();
-		mLastUsedCounter++;
+		const UINT32 regionSize = getRegionSize(area.width + border * 2);
+		const UINT32 x = area.x - border;
+		const UINT32 y = area.y - border;
+
+		UINT32 nodeIdx = 0;
+		UINT32 nodeSize = mSize;
+		UINT32 nodeX = 0;
+		UINT32 nodeY = 0;
+		while (nodeSize > regionSize)
+		{
+			const UINT32 childSize = nodeSize / 2;
+			const UINT32 childX = (x - nodeX) >= childSize ? 1 : 0;
+			const UINT32 childY = (y - nodeY) >= childSize ? 1 : 0;
+
+			nodeIdx = nodeIdx * 4 + 1 + childY * 2 + childX;
+			nodeX += childX * childSize;
+			nodeY += childY * childSize;
+			nodeSize = childSize;
+		}
+
+		assert(mNodeStates[nodeIdx] == NodeState::Used);
+
+		mNodeStates[nodeIdx] = NodeState::Free;
+		mLargestFree[nodeIdx] = nodeSize;
+		updateParents(nodeIdx, nodeSize);
+
+		mNumMaps--;
 	}
 
-	bool ShadowMapAtlas::isEmpty() const
+	void ShadowMapAtlas::updateUseCounter()
 	{
-		return mLayout.isEmpty();
+		if (mNumMaps == 0)
+			mLastUsedCounter++;
+		else
+			mLastUsedCounter = 0;
+	}
+
+	UINT32 ShadowMapAtlas::getRegionSize(UINT32 sizeWithBorder) const
+	{
+		return std::max(Bitwise::nextPow2(sizeWithBorder), mMinMapSize);
+	}
+
+	void ShadowMapAtlas::updateParents(UINT32 nodeIdx, UINT32 nodeSize)
+	{
+		while (nodeIdx > 0)
+		{
+			const UINT32 parentIdx = (nodeIdx - 1) / 4;
+			const UINT32 firstChildIdx = parentIdx * 4 + 1;
+
+			bool allFree = true;
+			UINT32 largestFree = 0;
+			for (UINT32 i = 0; i < 4; i++)
+			{
+				allFree &= mNodeStates[firstChildIdx + i] == NodeState::Free;
+				largestFree = std::max(largestFree, mLargestFree[firstChildIdx + i]);
+			}
+
+			nodeSize *= 2;
+			if (allFree)
+			{
+				mNodeStates[parentIdx] = NodeState::Free;
+				mLargestFree[parentIdx] = nodeSize;
+			}
+			else
+				mLargestFree[parentIdx] = largestFree;
+
+			nodeIdx = parentIdx;
+		}
 	}
 
 	SPtr<Texture> ShadowMapAtlas::getTexture() const
@@ -435,6 +545,14 @@ namespace bs { namespace ct
 		return mTargets[cascadeIdx];
 	}
 
+	/** Determines which shadow casters should be rendered by ShadowRenderQueue. */
+	enum class ShadowCasterFilter
+	{
+		All, /**< Render all shadow casters. */
+		Static, /**< Render only shadow casters that can be cached in static shadow maps. */
+		Dynamic /**< Render only shadow casters that cannot be cached in static shadow maps. */
+	};
+
 	/** 
 	 * Provides a common way for all types of shadow depth rendering to render the relevant objects into the depth map. 
 	 * Iterates over all relevant objects in the scene, binds the relevant materials and renders the objects into the depth
@@ -464,7 +582,8 @@ namespace bs { namespace ct
 		};
 
 		template<class Options>
-		static void execute(RendererScene& scene, const FrameInfo& frameInfo, const Options& opt)
+		static void execute(RendererScene& scene, const FrameInfo& frameInfo, const Options& opt,
+			ShadowCasterFilter filter = ShadowCasterFilter::All)
 		{
 			static_assert((UINT32)RenderableAnimType::Count == 4, "RenderableAnimType is expected to have four sequential entries.");
 
@@ -474,19 +593,36 @@ namespace bs { namespace ct
 			{
 				FrameVector<Command> commands[4];
 
-				// Make a list of relevant renderables and prepare them for rendering
-				for (UINT32 i = 0; i < sceneInfo.renderables.size(); i++)
+				// Make a list of relevant renderables and prepare them for rendering all at once, so their material
+				// parameters are evaluated in parallel
+				const auto numRenderables = (UINT32)sceneInfo.renderables.size();
+				Vector<bool> casters(numRenderables, false);
+				for (UINT32 i = 0; i < numRenderables; i++)
 				{
-					const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
-					if (!opt.intersects(bounds))
+					RendererRenderable* renderable = sceneInfo.renderables[i];
+					if (!renderable->renderable->getCastsShadows())
+						continue;
+
+					if (filter != ShadowCasterFilter::All &&
+						renderable->isStaticShadowCaster != (filter == ShadowCasterFilter::Static))
 						continue;
 
-					scene.prepareRenderable(i, frameInfo);
+					casters[i] = opt.intersects(sceneInfo.renderableCullInfos[i].bounds.getSphere());
+				}
+
+				scene.prepareRenderables(casters, frameInfo);
+
+				for (UINT32 i = 0; i < numRenderables; i++)
+				{
+					if (!casters[i])
+						continue;
+
+					RendererRenderable* renderable = sceneInfo.renderables[i];
+					const Sphere& bounds = sceneInfo.renderableCullInfos[i].bounds.getSphere();
 
 					Command renderableCommand;
 					renderableCommand.mask = 0;
 
-					RendererRenderable* renderable = sceneInfo.renderables[i];
 					renderableCommand.isElement = false;
 					renderableCommand.renderable = renderable;
 
@@ -522,15 +658,7 @@ namespace bs { namespace ct
 					for (auto& command : commands[i])
 					{
 						if (command.isElement)
-						{
-							const RenderableElement& element = *command.element;
-
-							if (element.morphVertexDeclaration == nullptr)
-								gRendererUtility().draw(element.mesh, element.subMesh);
-							else
-								gRendererUtility().drawMorph(element.mesh, element.subMesh, element.morphShapeBuffer,
-									element.morphVertexDeclaration);
-						}
+							command.element->draw();
 						else
 							opt.bindRenderable(command);
 					}
@@ -549,9 +677,12 @@ namespace bs { namespace ct
 			const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer, 
 			const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer,
 			const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer)
-			: frustums(frustums), boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
+			: boundingVolume(boundingVolume), shadowParamsBuffer(shadowParamsBuffer)
 			, shadowCubeMatricesBuffer(shadowCubeMatricesBuffer), shadowCubeMasksBuffer(shadowCubeMasksBuffer)
-		{ }
+		{
+			for (UINT32 i = 0; i < 6; i++)
+				this->frustums[i] = ConvexVolumeCuller(frustums[i]);
+		}
 
 		bool intersects(const Sphere& bounds) const
 		{
@@ -580,8 +711,8 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer, shadowCubeMasksBuffer);
 		}
 		
-		const ConvexVolume (&frustums)[6];
-		const ConvexVolume& boundingVolume;
+		ConvexVolumeCuller frustums[6];
+		ConvexVolumeCuller boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer;
 		const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer;
@@ -620,7 +751,7 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 
-		const ConvexVolume& boundingVolume;
+		ConvexVolumeCuller boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthNormalNoPSMat* material = nullptr;
@@ -657,7 +788,7 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 		
-		const ConvexVolume& boundingVolume;
+		ConvexVolumeCuller boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthNormalMat* material = nullptr;
@@ -694,18 +825,37 @@ namespace bs { namespace ct
 			material->setPerObjectBuffer(renderable->perObjectParamBuffer);
 		}
 		
-		const ConvexVolume& boundingVolume;
+		ConvexVolumeCuller boundingVolume;
 		const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer;
 
 		mutable ShadowDepthDirectionalMat* material = nullptr;
 	};
 
+	/** 
+	 * Returns the name of the GPU profiler sample for a single shadow map, including the index of the light (and the
+	 * cascade, if any) so maps of different lights can be told apart. Empty if profiling is disabled.
+	 */
+	ProfilerString getShadowSampleName(const char* type, UINT32 lightIdx, UINT32 cascadeIdx = (UINT32)-1)
+	{
+#if BS_PROFILING_ENABLED
+		ProfilerString name = ProfilerString(type) + " #" + toString(lightIdx).c_str();
+		if(cascadeIdx != (UINT32)-1)
+			name += ProfilerString(", cascade ") + toString(cascadeIdx).c_str();
+
+		return name;
+#else
+		return ProfilerString();
+#endif
+	}
+
 	const UINT32 ShadowRendering::MAX_ATLAS_SIZE = 4096;
 	const UINT32 ShadowRendering::MAX_UNUSED_FRAMES = 60;
 	const UINT32 ShadowRendering::MIN_SHADOW_MAP_SIZE = 32;
 	const UINT32 ShadowRendering::SHADOW_MAP_FADE_SIZE = 64;
 	const UINT32 ShadowRendering::SHADOW_MAP_BORDER = 4;
+	const float ShadowRendering::SHADOW_MAP_SIZE_HYSTERESIS = 0.25f;
 	const float ShadowRendering::CASCADE_FRACTION_FADE = 0.1f;
+	const float ShadowRendering::CASCADE_SHARE_MAX_GROWTH = 0.1f;
 
 	ShadowRendering::ShadowRendering(UINT32 shadowMapSize)
 		: mShadowMapSize(shadowMapSize)
@@ -769,28 +919,267 @@ namespace bs { namespace ct
 
 		mCascadedShadowMaps.clear();
 		mDynamicShadowMaps.clear();
+		mShadowMapAllocations.clear();
 		mShadowCubemaps.clear();
+		mStaticShadowCaches.clear();
+		mShadowHistory.clear();
 
 		mShadowMapSize = size;
 	}
 
+	void ShadowRendering::setShadowUpdateBudget(UINT32 numTexels)
+	{
+		mShadowUpdateBudget = numTexels;
+
+		if (numTexels == 0)
+			mShadowHistory.clear();
+	}
+
+	void ShadowRendering::scheduleShadowUpdates(const SceneInfo& sceneInfo)
+	{
+		struct UpdateCandidate
+		{
+			ShadowMapOptions* options;
+			UINT64 cost;
+			float priority;
+		};
+
+		bs_frame_mark();
+		{
+			FrameVector<UpdateCandidate> candidates;
+			UINT64 remainingBudget = mShadowUpdateBudget;
+
+			const auto addCandidates = [this, &candidates, &remainingBudget](Vector<ShadowMapOptions>& shadowOptions,
+				const Vector<RendererLight>& lights, UINT32 numFaces)
+			{
+				for (auto& entry : shadowOptions)
+				{
+					const Light* light = lights[entry.lightIdx].internal;
+					const UINT64 cost = (UINT64)numFaces * entry.mapSize * entry.mapSize;
+
+					// Shadow map can only be reused if it was present last frame, and the light didn't change since
+					auto iterFind = mShadowHistory.find(light);
+					if (iterFind == mShadowHistory.end() || iterFind->second.frameIdx + 1 != mFrameIdx ||
+						iterFind->second.mapSize != entry.mapSize ||
+						iterFind->second.position != light->getTransform().getPosition() ||
+						iterFind->second.rotation != light->getTransform().getRotation() ||
+						iterFind->second.range != light->getAttenuationRadius() ||
+						iterFind->second.spotAngle != light->getSpotAngle())
+					{
+						remainingBudget -= std::min(cost, remainingBudget);
+						continue;
+					}
+
+					// Larger shadow maps cover more of the screen, and are closer to the viewer
+					const float priority = entry.mapSize * (float)(iterFind->second.framesSinceUpdate + 1);
+					candidates.push_back({ &entry, cost, priority });
+				}
+			};
+
+			addCandidates(mSpotLightShadowOptions, sceneInfo.spotLights, 1);
+			addCandidates(mRadialLightShadowOptions, sceneInfo.radialLights, 6);
+
+			std::sort(candidates.begin(), candidates.end(),
+				[](const UpdateCandidate& a, const UpdateCandidate& b) { return a.priority > b.priority; });
+
+			// Always update at least one shadow map, so every shadow map eventually gets updated
+			for (UINT32 i = 0; i < (UINT32)candidates.size(); i++)
+			{
+				UpdateCandidate& candidate = candidates[i];
+				if (i == 0 || candidate.cost <= remainingBudget)
+					remainingBudget -= std::min(candidate.cost, remainingBudget);
+				else
+					candidate.options->reusePrevious = true;
+			}
+		}
+		bs_frame_clear();
+	}
+
+	void ShadowRendering::updateShadowMapAllocations(const SceneInfo& sceneInfo)
+	{
+		const auto releaseRegion = [this](ShadowMapAllocation& allocation)
+		{
+			if (allocation.atlasIdx == (UINT32)-1)
+				return;
+
+			mDynamicShadowMaps[allocation.atlasIdx].removeMap(allocation.area, SHADOW_MAP_BORDER);
+			allocation.atlasIdx = (UINT32)-1;
+		};
+
+		const auto updateAllocations = [this, &releaseRegion](const Vector<ShadowMapOptions>& shadowOptions,
+			const Vector<RendererLight>& lights)
+		{
+			for (auto& entry : shadowOptions)
+			{
+				ShadowMapAllocation& allocation = mShadowMapAllocations[lights[entry.lightIdx].internal];
+				if (allocation.mapSize != entry.mapSize)
+				{
+					releaseRegion(allocation);
+					allocation.mapSize = entry.mapSize;
+				}
+
+				allocation.frameIdx = mFrameIdx;
+			}
+		};
+
+		updateAllocations(mSpotLightShadowOptions, sceneInfo.spotLights);
+		updateAllocations(mRadialLightShadowOptions, sceneInfo.radialLights);
+
+		// Release the regions of lights that no longer cast shadows (or no longer exist)
+		for (auto iter = mShadowMapAllocations.begin(); iter != mShadowMapAllocations.end();)
+		{
+			if (iter->second.frameIdx != mFrameIdx)
+			{
+				releaseRegion(iter->second);
+				iter = mShadowMapAllocations.erase(iter);
+			}
+			else
+				++iter;
+		}
+
+		for (auto& entry : mDynamicShadowMaps)
+			entry.updateUseCounter();
+
+		// Only release atlases from the back, so the indices of the atlases holding persistent regions don't change
+		while (!mDynamicShadowMaps.empty() && mDynamicShadowMaps.back().isEmpty() &&
+			mDynamicShadowMaps.back().getLastUsedCounter() >= MAX_UNUSED_FRAMES)
+		{
+			mDynamicShadowMaps.pop_back();
+		}
+	}
+
+	void ShadowRendering::recordShadowHistory(const Light& light, const ShadowInfo& info, const SPtr<Texture>& texture,
+		UINT32 mapSize, bool updated)
+	{
+		if (mShadowUpdateBudget == 0)
+			return;
+
+		ShadowHistory& history = mShadowHistory[&light];
+		history.info = info;
+		history.texture = texture;
+		history.position = light.getTransform().getPosition();
+		history.rotation = light.getTransform().getRotation();
+		history.range = light.getAttenuationRadius();
+		history.spotAngle = light.getSpotAngle();
+		history.mapSize = mapSize;
+		history.frameIdx = mFrameIdx;
+		history.framesSinceUpdate = updated ? 0 : history.framesSinceUpdate + 1;
+	}
+
+	void ShadowRendering::setStaticShadowCaching(bool enabled)
+	{
+		mStaticShadowCaching = enabled;
+
+		if (!enabled)
+			mStaticShadowCaches.clear();
+	}
+
+	void ShadowRendering::updateStaticShadowCaches(const SceneInfo& sceneInfo)
+	{
+		const UINT32 numChanges = (UINT32)sceneInfo.staticCasterChanges.size();
+		if (mStaticCasterVersion < sceneInfo.staticCasterChangesVersion)
+		{
+			// Changes we haven't seen yet were discarded, so we can't tell which caches they affect
+			for (auto& entry : mStaticShadowCaches)
+				entry.second.isValid = false;
+		}
+		else
+		{
+			for (UINT32 i = mStaticCasterVersion - sceneInfo.staticCasterChangesVersion; i < numChanges; i++)
+			{
+				const Sphere& casterBounds = sceneInfo.staticCasterChanges[i];
+				for (auto& entry : mStaticShadowCaches)
+				{
+					if (entry.second.isValid && entry.second.bounds.intersects(casterBounds))
+						entry.second.isValid = false;
+				}
+			}
+		}
+
+		mStaticCasterVersion = sceneInfo.staticCasterChangesVersion + numChanges;
+
+		// Release caches of lights that haven't cast shadows in a while (or no longer exist)
+		for (auto iter = mStaticShadowCaches.begin(); iter != mStaticShadowCaches.end();)
+		{
+			if (iter->second.lastUsedCounter >= MAX_UNUSED_FRAMES)
+				iter = mStaticShadowCaches.erase(iter);
+			else
+			{
+				iter->second.lastUsedCounter++;
+				++iter;
+			}
+		}
+	}
+
+	ShadowRendering::StaticShadowCache* ShadowRendering::getStaticShadowCache(const Light& light,
+		const Matrix4& shadowVPTransform, float depthBias, UINT32 mapSize)
+	{
+		if (!mStaticShadowCaching || light.getMobility() == ObjectMobility::Movable)
+			return nullptr;
+
+		StaticShadowCache& cache = mStaticShadowCaches[&light];
+		if (cache.depth == nullptr || cache.mapSize != mapSize)
+		{
+			if (light.getType() == LightType::Radial)
+			{
+				cache.depth = GpuResourcePool::instance().get(
+					POOLED_RENDER_TEXTURE_DESC::createCube(SHADOW_MAP_FORMAT, mapSize, mapSize, TU_DEPTHSTENCIL));
+			}
+			else
+			{
+				cache.depth = GpuResourcePool::instance().get(
+					POOLED_RENDER_TEXTURE_DESC::create2D(SHADOW_MAP_FORMAT, mapSize, mapSize, TU_DEPTHSTENCIL));
+			}
+
+			cache.isValid = false;
+		}
+
+		// Light properties can change even if the light cannot move (e.g. its range)
+		if (cache.shadowVPTransform != shadowVPTransform || cache.depthBias != depthBias)
+			cache.isValid = false;
+
+		cache.shadowVPTransform = shadowVPTransform;
+		cache.depthBias = depthBias;
+		cache.mapSize = mapSize;
+		cache.bounds = light.getBounds();
+		cache.lastUsedCounter = 0;
+
+		return &cache;
+	}
+
 	void ShadowRendering::renderShadowMaps(RendererScene& scene, const RendererViewGroup& viewGroup, 
 		const FrameInfo& frameInfo)
 	{
-		// Note: Currently all shadows are dynamic and are rebuilt every frame. I should later added support for static
-		// shadow maps which can be used for immovable lights. Such a light can then maintain a set of shadow maps,
-		// one of which is static and only effects the static geometry, while the rest are per-object shadow maps used
-		// for dynamic objects. Then only a small subset of geometry needs to be redrawn, instead of everything.
+		// Note: Non-movable spot and radial lights cache the shadows of static geometry (see StaticShadowCache), but
+		// still redraw all dynamic geometry every frame. Directional light shadows are fully rebuilt every frame. Dynamic
+		// geometry could be further split into per-object shadow maps, so only a small subset needs to be redrawn.
 
 		// Note: Add support for per-object shadows and a way to force a renderable to use per-object shadows. This can be
 		// used for adding high quality shadows on specific objects (e.g. important characters during cinematics).
 
+		ProfileGPUBlock profileSample("Shadow maps");
+
 		const SceneInfo& sceneInfo = scene.getSceneInfo();
 		const VisibilityInfo& visibility = viewGroup.getVisibilityInfo();
 		
 		// Clear all transient data from last frame
 		mShadowInfos.clear();
 
+		updateStaticShadowCaches(sceneInfo);
+
+		// Shadow maps of lights that didn't cast a shadow during the previous frame are gone, and cannot be reused
+		mFrameIdx++;
+		if (mShadowUpdateBudget > 0)
+		{
+			for (auto iter = mShadowHistory.begin(); iter != mShadowHistory.end();)
+			{
+				if (iter->second.frameIdx + 1 != mFrameIdx)
+					iter = mShadowHistory.erase(iter);
+				else
+					++iter;
+			}
+		}
+
 		mSpotLightShadows.resize(sceneInfo.spotLights.size());
 		mRadialLightShadows.resize(sceneInfo.radialLights.size());
 		mDirectionalLightShadows.resize(sceneInfo.directionalLights.size());
@@ -802,9 +1191,6 @@ namespace bs { namespace ct
 		for (auto& entry : mCascadedShadowMaps)
 			entry.clear();
 
-		for (auto& entry : mDynamicShadowMaps)
-			entry.clear();
-
 		for (auto& entry : mShadowCubemaps)
 			entry.clear();
 
@@ -824,13 +1210,18 @@ namespace bs { namespace ct
 			ShadowMapOptions options;
 			options.lightIdx = i;
 
+			auto iterFind = mShadowMapAllocations.find(light.internal);
+			const UINT32 prevMapSize = iterFind != mShadowMapAllocations.end() ? iterFind->second.mapSize : 0;
+
 			float maxFadePercent;
-			calcShadowMapProperties(light, viewGroup, SHADOW_MAP_BORDER, options.mapSize, options.fadePercents, maxFadePercent);
+			calcShadowMapProperties(light, viewGroup, SHADOW_MAP_BORDER, prevMapSize, options.mapSize,
+				options.fadePercents, maxFadePercent);
 
 			// Don't render shadow maps that will end up nearly completely faded out
 			if (maxFadePercent < 0.005f)
 				continue;
 
+			options.mapSize = std::min(options.mapSize, MAX_ATLAS_SIZE - 2 * SHADOW_MAP_BORDER);
 			mSpotLightShadowOptions.push_back(options);
 			shadowInfoCount++; // For now, always a single fully dynamic shadow for a single light, but that may change
 		}
@@ -849,8 +1240,12 @@ namespace bs { namespace ct
 			ShadowMapOptions options;
 			options.lightIdx = i;
 
+			auto iterFind = mShadowMapAllocations.find(light.internal);
+			const UINT32 prevMapSize = iterFind != mShadowMapAllocations.end() ? iterFind->second.mapSize : 0;
+
 			float maxFadePercent;
-			calcShadowMapProperties(light, viewGroup, 0, options.mapSize, options.fadePercents, maxFadePercent);
+			calcShadowMapProperties(light, viewGroup, 0, prevMapSize, options.mapSize, options.fadePercents,
+				maxFadePercent);
 
 			// Don't render shadow maps that will end up nearly completely faded out
 			if (maxFadePercent < 0.005f)
@@ -861,7 +1256,18 @@ namespace bs { namespace ct
 			shadowInfoCount++; // For now, always a single fully dynamic shadow for a single light, but that may change
 		}
 
-		// Sort spot lights by size so they fit neatly in the texture atlas
+		updateShadowMapAllocations(sceneInfo);
+
+		if (mShadowUpdateBudget > 0)
+		{
+			scheduleShadowUpdates(sceneInfo);
+
+			// Radial lights reusing their cubemaps need to claim them before they get assigned to other lights
+			std::stable_partition(mRadialLightShadowOptions.begin(), mRadialLightShadowOptions.end(),
+				[](const ShadowMapOptions& entry) { return entry.reusePrevious; });
+		}
+
+		// Sort spot lights by size so the ones that need a new region fit neatly in the texture atlas
 		std::sort(mSpotLightShadowOptions.begin(), mSpotLightShadowOptions.end(),
 			[](const ShadowMapOptions& a, const ShadowMapOptions& b) { return a.mapSize > b.mapSize; } );
 
@@ -869,16 +1275,6 @@ namespace bs { namespace ct
 		mShadowInfos.resize(shadowInfoCount);
 
 		// Deallocate unused textures (must be done before rendering shadows, in order to ensure indices don't change)
-		for(auto iter = mDynamicShadowMaps.begin(); iter != mDynamicShadowMaps.end(); ++iter)
-		{
-			if(iter->getLastUsedCounter() >= MAX_UNUSED_FRAMES)
-			{
-				// These are always populated in order, so we can assume all following atlases are also empty
-				mDynamicShadowMaps.erase(iter, mDynamicShadowMaps.end());
-				break;
-			}
-		}
-
 		for(auto iter = mCascadedShadowMaps.begin(); iter != mCascadedShadowMaps.end();)
 		{
 			if (iter->getLastUsedCounter() >= MAX_UNUSED_FRAMES)
@@ -895,19 +1291,29 @@ namespace bs { namespace ct
 				++iter;
 		}
 
-		// Render shadow maps
+		// Render shadow maps. Views with nearly identical frusta share cascaded shadow maps, while spot and radial
+		// light shadow maps are always shared by all views in the group.
+		if (!sceneInfo.directionalLights.empty())
+			groupViewsForCascades(viewGroup, mCascadeViewGroups);
+
 		for (UINT32 i = 0; i < (UINT32)sceneInfo.directionalLights.size(); ++i)
 		{
 			const RendererLight& light = sceneInfo.directionalLights[i];
 
-			if (!light.internal->getCastsShadow())
-				return;
-
 			UINT32 numViews = viewGroup.getNumViews();
 			mDirectionalLightShadows[i].viewShadows.resize(numViews);
 
-			for (UINT32 j = 0; j < numViews; ++j)
-				renderCascadedShadowMaps(*viewGroup.getView(j), i, scene, frameInfo);
+			for (auto& entry : mDirectionalLightShadows[i].viewShadows)
+			{
+				entry.startIdx = -1;
+				entry.numShadows = 0;
+			}
+
+			if (!light.internal->getCastsShadow())
+				continue;
+
+			for (auto& entry : mCascadeViewGroups)
+				renderCascadedShadowMaps(entry, i, scene, frameInfo);
 		}
 
 		for(auto& entry : mSpotLightShadowOptions)
@@ -1209,18 +1615,81 @@ namespace bs { namespace ct
 		}
 	}
 
-	void ShadowRendering::renderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene, 
-		const FrameInfo& frameInfo)
+	void ShadowRendering::groupViewsForCascades(const RendererViewGroup& viewGroup, Vector<CascadeViewGroup>& output)
 	{
-		UINT32 viewIdx = view.getViewIdx();
-		LightShadows& lightShadows = mDirectionalLightShadows[lightIdx].viewShadows[viewIdx];
+		output.clear();
 
-		if (!view.getRenderSettings().enableShadows)
+		SmallVector<Sphere, 4> viewBounds;
+		for (UINT32 i = 0; i < viewGroup.getNumViews(); ++i)
 		{
-			lightShadows.startIdx = -1;
-			lightShadows.numShadows = 0;
-			return;
+			const RendererView& view = *viewGroup.getView(i);
+			if (!view.getRenderSettings().enableShadows)
+				continue;
+
+			// Bounds of the split frustum don't depend on the light direction
+			UINT32 numCascades = view.getRenderSettings().shadowSettings.numCascades;
+			viewBounds.resize(numCascades);
+			for (UINT32 j = 0; j < numCascades; ++j)
+				getCSMSplitFrustum(view, Vector3::UNIT_Z, j, numCascades, viewBounds[j]);
+
+			// Join an existing group only if sharing doesn't noticeably reduce the shadow resolution of any view
+			CascadeViewGroup* group = nullptr;
+			SmallVector<Sphere, 4> mergedBounds;
+			for (auto& entry : output)
+			{
+				const RendererView& groupView = *entry.views[0];
+				if (groupView.getRenderSettings().shadowSettings.numCascades != numCascades)
+					continue;
+
+				bool canShare = true;
+				mergedBounds = entry.bounds;
+				for (UINT32 j = 0; j < numCascades; ++j)
+				{
+					mergedBounds[j].merge(viewBounds[j]);
+
+					const float minRadius = std::min(entry.minRadius[j], viewBounds[j].getRadius());
+					if (mergedBounds[j].getRadius() > minRadius * (1.0f + CASCADE_SHARE_MAX_GROWTH))
+					{
+						canShare = false;
+						break;
+					}
+				}
+
+				if (canShare)
+				{
+					group = &entry;
+					break;
+				}
+			}
+
+			if (group)
+			{
+				group->views.add(&view);
+				for (UINT32 j = 0; j < numCascades; ++j)
+				{
+					group->bounds[j] = mergedBounds[j];
+					group->minRadius[j] = std::min(group->minRadius[j], viewBounds[j].getRadius());
+				}
+			}
+			else
+			{
+				output.push_back(CascadeViewGroup());
+
+				CascadeViewGroup& newGroup = output.back();
+				newGroup.views.add(&view);
+				newGroup.bounds = viewBounds;
+
+				for (UINT32 j = 0; j < numCascades; ++j)
+					newGroup.minRadius.add(viewBounds[j].getRadius());
+			}
 		}
+	}
+
+	void ShadowRendering::renderCascadedShadowMaps(const CascadeViewGroup& viewGroup, UINT32 lightIdx, 
+		RendererScene& scene, const FrameInfo& frameInfo)
+	{
+		const RendererView& view = *viewGroup.views[0];
+		const bool isShared = viewGroup.views.size() > 1;
 
 		// Note: Currently I'm using spherical bounds for the cascaded frustum which might result in non-optimal usage
 		// of the shadow map. A different approach would be to generate a bounding box and then both adjust the aspect
@@ -1274,12 +1743,21 @@ namespace bs { namespace ct
 		Quaternion lightRotation(BsIdentity);
 		lightRotation.lookRotation(lightDir, Vector3::UNIT_Y);
 
-		ProfileGPUBlock profileSample("Project directional light shadow");
+		ProfileGPUBlock profileSample(getShadowSampleName("Directional light shadow", lightIdx));
 
 		for (UINT32 i = 0; i < numCascades; ++i)
 		{
+			ProfileGPUBlock cascadeSample(getShadowSampleName("Directional light shadow", lightIdx, i));
+
 			Sphere frustumBounds;
-			ConvexVolume cascadeCullVolume = getCSMSplitFrustum(view, lightDir, i, numCascades, frustumBounds);
+			ConvexVolume cascadeCullVolume;
+			if (isShared)
+			{
+				frustumBounds = viewGroup.bounds[i];
+				cascadeCullVolume = getCSMBoundsVolume(frustumBounds, lightDir);
+			}
+			else
+				cascadeCullVolume = getCSMSplitFrustum(view, lightDir, i, numCascades, frustumBounds);
 
 			// Make sure the size of the projected area is in multiples of shadow map pixel size (for stability)
 			float worldUnitsPerTexel = frustumBounds.getRadius() * 2.0f / shadowMap.getSize();
@@ -1350,8 +1828,12 @@ namespace bs { namespace ct
 			shadowMap.setShadowInfo(i, shadowInfo);
 		}
 
-		lightShadows.startIdx = shadowInfo.textureIdx;
-		lightShadows.numShadows = 1;
+		for (auto& entry : viewGroup.views)
+		{
+			LightShadows& lightShadows = mDirectionalLightShadows[lightIdx].viewShadows[entry->getViewIdx()];
+			lightShadows.startIdx = shadowInfo.textureIdx;
+			lightShadows.numShadows = 1;
+		}
 	}
 
 	void ShadowRendering::renderSpotShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options,
@@ -1366,38 +1848,59 @@ namespace bs { namespace ct
 		mapInfo.lightIdx = options.lightIdx;
 		mapInfo.cascadeIdx = -1;
 
-		bool foundSpace = false;
-		for (UINT32 i = 0; i < (UINT32)mDynamicShadowMaps.size(); i++)
+		// Regions persist between frames, a new one is only needed if the light's shadow map changed size, or the light
+		// didn't cast a shadow during the previous frame
+		ShadowMapAllocation& allocation = mShadowMapAllocations[light];
+		if (allocation.atlasIdx == (UINT32)-1)
 		{
-			ShadowMapAtlas& atlas = mDynamicShadowMaps[i];
-
-			if (atlas.addMap(options.mapSize, mapInfo.area, SHADOW_MAP_BORDER))
+			for (UINT32 i = 0; i < (UINT32)mDynamicShadowMaps.size(); i++)
 			{
-				mapInfo.textureIdx = i;
-
-				foundSpace = true;
-				break;
+				if (mDynamicShadowMaps[i].addMap(options.mapSize, allocation.area, SHADOW_MAP_BORDER))
+				{
+					allocation.atlasIdx = i;
+					break;
+				}
 			}
-		}
 
-		if (!foundSpace)
-		{
-			mapInfo.textureIdx = (UINT32)mDynamicShadowMaps.size();
-			mDynamicShadowMaps.push_back(ShadowMapAtlas(MAX_ATLAS_SIZE));
+			if (allocation.atlasIdx == (UINT32)-1)
+			{
+				allocation.atlasIdx = (UINT32)mDynamicShadowMaps.size();
+				mDynamicShadowMaps.push_back(ShadowMapAtlas(MAX_ATLAS_SIZE, MIN_SHADOW_MAP_SIZE));
 
-			ShadowMapAtlas& atlas = mDynamicShadowMaps.back();
-			atlas.addMap(options.mapSize, mapInfo.area, SHADOW_MAP_BORDER);
+				ShadowMapAtlas& atlas = mDynamicShadowMaps.back();
+				atlas.addMap(options.mapSize, allocation.area, SHADOW_MAP_BORDER);
+			}
 		}
 
+		mapInfo.textureIdx = allocation.atlasIdx;
+		mapInfo.area = allocation.area;
 		mapInfo.updateNormArea(MAX_ATLAS_SIZE);
 		ShadowMapAtlas& atlas = mDynamicShadowMaps[mapInfo.textureIdx];
 
-		ProfileGPUBlock profileSample("Project spot light shadows");
+		ProfileGPUBlock profileSample(getShadowSampleName("Spot light shadow", options.lightIdx));
 
 		RenderAPI& rapi = RenderAPI::instance();
-		rapi.setRenderTarget(atlas.getTarget());
-		rapi.setViewport(mapInfo.normArea);
-		rapi.clearViewport(FBT_DEPTH);
+		LightShadows& lightShadows = mSpotLightShadows[options.lightIdx];
+
+		if (options.reusePrevious)
+		{
+			// Shadow maps are only reused if their size didn't change since the previous frame, in which case the light
+			// kept its atlas region, and the previous frame's shadow map is still in place
+			const ShadowHistory& history = mShadowHistory[light];
+
+			ShadowInfo reusedInfo = history.info;
+			reusedInfo.lightIdx = mapInfo.lightIdx;
+			reusedInfo.textureIdx = mapInfo.textureIdx;
+			reusedInfo.area = mapInfo.area;
+			reusedInfo.normArea = mapInfo.normArea;
+			reusedInfo.fadePerView = mapInfo.fadePerView;
+
+			recordShadowHistory(*light, reusedInfo, atlas.getTexture(), options.mapSize, false);
+
+			mShadowInfos[lightShadows.startIdx + lightShadows.numShadows] = reusedInfo;
+			lightShadows.numShadows++;
+			return;
+		}
 
 		mapInfo.depthNear = 0.05f;
 		mapInfo.depthFar = light->getAttenuationRadius();
@@ -1435,17 +1938,47 @@ namespace bs { namespace ct
 
 		ConvexVolume worldFrustum(worldPlanes);
 
-		// Render all renderables into the shadow map
 		ShadowRenderQueueSpotOptions spotOptions(
 			worldFrustum,
 			shadowParamsBuffer);
 
-		ShadowRenderQueue::execute(scene, frameInfo, spotOptions);
+		StaticShadowCache* staticCache = getStaticShadowCache(*light, mapInfo.shadowVPTransform, mapInfo.depthBias,
+			options.mapSize);
+
+		if (staticCache != nullptr)
+		{
+			// Render static renderables into the cache, if they changed since the last time
+			if (!staticCache->isValid)
+			{
+				rapi.setRenderTarget(staticCache->depth->renderTexture);
+				rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+				rapi.clearRenderTarget(FBT_DEPTH);
+
+				ShadowRenderQueue::execute(scene, frameInfo, spotOptions, ShadowCasterFilter::Static);
+				staticCache->isValid = true;
+			}
+
+			// Copy the cached depth, then render dynamic renderables on top
+			rapi.setRenderTarget(atlas.getTarget());
+			rapi.setViewport(mapInfo.normArea);
+			gRendererUtility().blit(staticCache->depth->texture, Rect2I::EMPTY, false, true);
+
+			ShadowRenderQueue::execute(scene, frameInfo, spotOptions, ShadowCasterFilter::Dynamic);
+		}
+		else
+		{
+			rapi.setRenderTarget(atlas.getTarget());
+			rapi.setViewport(mapInfo.normArea);
+			rapi.clearViewport(FBT_DEPTH);
+
+			// Render all renderables into the shadow map
+			ShadowRenderQueue::execute(scene, frameInfo, spotOptions);
+		}
 
 		// Restore viewport
 		rapi.setViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
 
-		LightShadows& lightShadows = mSpotLightShadows[options.lightIdx];
+		recordShadowHistory(*light, mapInfo, atlas.getTexture(), options.mapSize, true);
 
 		mShadowInfos[lightShadows.startIdx + lightShadows.numShadows] = mapInfo;
 		lightShadows.numShadows++;
@@ -1466,6 +1999,33 @@ namespace bs { namespace ct
 		mapInfo.area = Rect2I(0, 0, options.mapSize, options.mapSize);
 		mapInfo.updateNormArea(options.mapSize);
 
+		LightShadows& lightShadows = mRadialLightShadows[options.lightIdx];
+
+		if (options.reusePrevious)
+		{
+			// Keep using the cubemap from the previous frame, as long as it's still around
+			const ShadowHistory& history = mShadowHistory[light];
+			for (UINT32 i = 0; i < (UINT32)mShadowCubemaps.size(); i++)
+			{
+				ShadowCubemap& cubemap = mShadowCubemaps[i];
+				if (cubemap.isUsed() || cubemap.getTexture() != history.texture)
+					continue;
+
+				cubemap.markAsUsed();
+
+				ShadowInfo reusedInfo = history.info;
+				reusedInfo.lightIdx = mapInfo.lightIdx;
+				reusedInfo.textureIdx = i;
+				reusedInfo.fadePerView = mapInfo.fadePerView;
+
+				recordShadowHistory(*light, reusedInfo, cubemap.getTexture(), options.mapSize, false);
+
+				mShadowInfos[lightShadows.startIdx + lightShadows.numShadows] = reusedInfo;
+				lightShadows.numShadows++;
+				return;
+			}
+		}
+
 		for (UINT32 i = 0; i < (UINT32)mShadowCubemaps.size(); i++)
 		{
 			ShadowCubemap& cubemap = mShadowCubemaps[i];
@@ -1502,7 +2062,7 @@ namespace bs { namespace ct
 		Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 1.0f, 0.05f, light->getAttenuationRadius(), true);
 		ConvexVolume localFrustum(proj);
 
-		ProfileGPUBlock profileSample("Project radial light shadows");
+		ProfileGPUBlock profileSample(getShadowSampleName("Radial light shadow", options.lightIdx));
 
 		RenderAPI& rapi = RenderAPI::instance();
 		const RenderAPIInfo& rapiInfo = rapi.getAPIInfo();
@@ -1537,6 +2097,10 @@ namespace bs { namespace ct
 		gShadowParamsDef.gMatViewProj.set(shadowParamsBuffer, Matrix4::IDENTITY);
 		gShadowParamsDef.gNDCZToDeviceZ.set(shadowParamsBuffer, RendererView::getNDCZToDeviceZ());
 
+		// Position and projection of the light uniquely determine the transforms of all the faces
+		const Matrix4 cacheTfrm = proj * Matrix4::translation(-light->getTransform().getPosition());
+		StaticShadowCache* staticCache = getStaticShadowCache(*light, cacheTfrm, mapInfo.depthBias, options.mapSize);
+
 		ConvexVolume frustums[6];
 		Vector<Plane> boundingPlanes;
 		for (UINT32 i = 0; i < 6; i++)
@@ -1614,26 +2178,50 @@ namespace bs { namespace ct
 
 				SPtr<RenderTarget> faceRt = RenderTexture::create(rtDesc);
 
-				rapi.setRenderTarget(faceRt);
-				rapi.clearRenderTarget(FBT_DEPTH);
-
-				// Render all renderables into the shadow map
-				ConvexVolume boundingVolume(boundingPlanes);
 				ShadowRenderQueueCubeSingleOptions cubeOptions(
 						frustum,
 						shadowParamsBuffer
 				);
 
-				ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+				if (staticCache != nullptr)
+				{
+					// Render static renderables into the cache, if they changed since the last time
+					if (!staticCache->isValid)
+					{
+						RENDER_TEXTURE_DESC cacheRtDesc;
+						cacheRtDesc.depthStencilSurface.texture = staticCache->depth->texture;
+						cacheRtDesc.depthStencilSurface.face = i;
+						cacheRtDesc.depthStencilSurface.numFaces = 1;
+
+						rapi.setRenderTarget(RenderTexture::create(cacheRtDesc));
+						rapi.clearRenderTarget(FBT_DEPTH);
+
+						ShadowRenderQueue::execute(scene, frameInfo, cubeOptions, ShadowCasterFilter::Static);
+					}
+
+					// Copy the cached depth, then render dynamic renderables on top
+					TEXTURE_COPY_DESC copyDesc;
+					copyDesc.srcFace = i;
+					copyDesc.dstFace = i;
+
+					staticCache->depth->texture->copy(cubemap.getTexture(), copyDesc);
+
+					rapi.setRenderTarget(faceRt);
+					ShadowRenderQueue::execute(scene, frameInfo, cubeOptions, ShadowCasterFilter::Dynamic);
+				}
+				else
+				{
+					rapi.setRenderTarget(faceRt);
+					rapi.clearRenderTarget(FBT_DEPTH);
+
+					// Render all renderables into the shadow map
+					ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+				}
 			}
 		}
 
 		if(renderAllFacesAtOnce)
 		{
-			rapi.setRenderTarget(cubemap.getTarget());
-			rapi.clearRenderTarget(FBT_DEPTH);
-
-			// Render all renderables into the shadow map
 			ConvexVolume boundingVolume(boundingPlanes);
 			ShadowRenderQueueCubeOptions cubeOptions(
 					frustums,
@@ -1643,17 +2231,51 @@ namespace bs { namespace ct
 					shadowCubeMasksBuffer
 			);
 
-			ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+			if (staticCache != nullptr)
+			{
+				// Render static renderables into the cache, if they changed since the last time
+				if (!staticCache->isValid)
+				{
+					rapi.setRenderTarget(staticCache->depth->renderTexture);
+					rapi.clearRenderTarget(FBT_DEPTH);
+
+					ShadowRenderQueue::execute(scene, frameInfo, cubeOptions, ShadowCasterFilter::Static);
+				}
+
+				// Copy the cached depth, then render dynamic renderables on top
+				for (UINT32 i = 0; i < 6; i++)
+				{
+					TEXTURE_COPY_DESC copyDesc;
+					copyDesc.srcFace = i;
+					copyDesc.dstFace = i;
+
+					staticCache->depth->texture->copy(cubemap.getTexture(), copyDesc);
+				}
+
+				rapi.setRenderTarget(cubemap.getTarget());
+				ShadowRenderQueue::execute(scene, frameInfo, cubeOptions, ShadowCasterFilter::Dynamic);
+			}
+			else
+			{
+				rapi.setRenderTarget(cubemap.getTarget());
+				rapi.clearRenderTarget(FBT_DEPTH);
+
+				// Render all renderables into the shadow map
+				ShadowRenderQueue::execute(scene, frameInfo, cubeOptions);
+			}
 		}
 
-		LightShadows& lightShadows = mRadialLightShadows[options.lightIdx];
+		if (staticCache != nullptr)
+			staticCache->isValid = true;
+
+		recordShadowHistory(*light, mapInfo, cubemap.getTexture(), options.mapSize, true);
 
 		mShadowInfos[lightShadows.startIdx + lightShadows.numShadows] = mapInfo;
 		lightShadows.numShadows++;
 	}
 
 	void ShadowRendering::calcShadowMapProperties(const RendererLight& light, const RendererViewGroup& viewGroup, 
-		UINT32 border, UINT32& size, SmallVector<float, 6>& fadePercents, float& maxFadePercent) const
+		UINT32 border, UINT32 prevSize, UINT32& size, SmallVector<float, 6>& fadePercents, float& maxFadePercent) const
 	{
 		const static float SHADOW_TEXELS_PER_PIXEL = 1.0f;
 
@@ -1704,6 +2326,20 @@ namespace bs { namespace ct
 		// If light fully (or nearly fully) covers the screen, use full shadow map resolution, otherwise
 		// scale it down to smaller power of two, while clamping to minimal allowed resolution
 		UINT32 effectiveMapSize = Bitwise::nextPow2((UINT32)maxMapSize);
+
+		// Keep the previous resolution until the optimal size moves well outside of the range it covers. Otherwise the
+		// resolution keeps switching back and forth while the optimal size is near a power of two, which is visible as
+		// shimmering.
+		if (prevSize > 0)
+		{
+			const UINT32 prevMapSize = prevSize + 2 * border;
+			if (maxMapSize > prevMapSize * 0.5f * (1.0f - SHADOW_MAP_SIZE_HYSTERESIS) &&
+				maxMapSize <= prevMapSize * (1.0f + SHADOW_MAP_SIZE_HYSTERESIS))
+			{
+				effectiveMapSize = prevMapSize;
+			}
+		}
+
 		effectiveMapSize = Math::clamp(effectiveMapSize, MIN_SHADOW_MAP_SIZE, mShadowMapSize);
 
 		// Leave room for border
@@ -1918,6 +2554,30 @@ namespace bs { namespace ct
 		return ConvexVolume(lightVolume);
 	}
 
+	ConvexVolume ShadowRendering::getCSMBoundsVolume(const Sphere& bounds, const Vector3& lightDir)
+	{
+		Quaternion lightRotation(BsIdentity);
+		lightRotation.lookRotation(lightDir, Vector3::UNIT_Y);
+
+		const Vector3 right = lightRotation.xAxis();
+		const Vector3 up = lightRotation.yAxis();
+
+		const Vector3& center = bounds.getCenter();
+		const float radius = bounds.getRadius();
+
+		// Box around the bounds in light space, open towards the light
+		Vector<Plane> lightVolume =
+		{
+			Plane(right, center - right * radius),
+			Plane(-right, center + right * radius),
+			Plane(up, center - up * radius),
+			Plane(-up, center + up * radius),
+			Plane(-lightDir, center + lightDir * radius)
+		};
+
+		return ConvexVolume(lightVolume);
+	}
+
 	float ShadowRendering::getCSMSplitDistance(const RendererView& view, UINT32 index, UINT32 numCascades)
 	{
 		auto& shadowSettings = view.getRenderSettings().shadowSettings;
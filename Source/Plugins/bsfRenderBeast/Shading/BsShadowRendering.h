@@ -9,7 +9,6 @@
 #include "Renderer/BsParamBlocks.h"
 #include "Renderer/BsRendererMaterial.h"
 #include "Renderer/BsLight.h"
-#include "Image/BsTextureAtlasLayout.h"
 #include "BsRendererLight.h"
 
 namespace bs { namespace ct
@@ -17,6 +16,7 @@ namespace bs { namespace ct
 	struct FrameInfo;
 	class RendererLight;
 	class RendererScene;
+	struct SceneInfo;
 	struct ShadowInfo;
 
 	/** @addtogroup RenderBeast
@@ -401,13 +401,21 @@ namespace bs { namespace ct
 	};
 
 	/** 
-	 * Contains a texture that serves as an atlas for one or multiple shadow maps. Provides methods for inserting new maps
-	 * in the atlas. 
+	 * Contains a texture that serves as an atlas for one or multiple shadow maps. Regions of the atlas are managed by a
+	 * quad-tree, where each map occupies a single power of two sized node. This allows maps to be added and removed
+	 * individually, while the remaining maps stay in place.
 	 */
 	class ShadowMapAtlas
 	{
 	public:
-		ShadowMapAtlas(UINT32 size);
+		/**
+		 * Creates a new empty atlas.
+		 * 
+		 * @param[in]	size		Width and height of the atlas, in pixels. Must be a power of two.
+		 * @param[in]	minMapSize	Size of the smallest region that can be allocated in the atlas, including the
+		 *							border, in pixels. Must be a power of two.
+		 */
+		ShadowMapAtlas(UINT32 size, UINT32 minMapSize);
 
 		/** 
 		 * Registers a new map in the shadow map atlas. Returns true if the map fits in the atlas, or false otherwise.
@@ -415,15 +423,21 @@ namespace bs { namespace ct
 		 */
 		bool addMap(UINT32 size, Rect2I& area, UINT32 border = 4);
 
-		/** Clears all shadow maps from the atlas. Increments the last used counter.*/
-		void clear();
+		/** Removes a map registered through addMap(), making its region available to other maps. */
+		void removeMap(const Rect2I& area, UINT32 border = 4);
+
+		/** 
+		 * Increments the last used counter if the atlas contains no maps, or resets it to zero otherwise. Should be
+		 * called once per frame.
+		 */
+		void updateUseCounter();
 
 		/** Checks have any maps been added to the atlas. */
-		bool isEmpty() const;
+		bool isEmpty() const { return mNumMaps == 0; }
 
 		/** 
-		 * Returns the value of the last used counter. See addMap() and clear() for information on how the counter is
-		 * incremented/decremented.
+		 * Returns the value of the last used counter. See addMap() and updateUseCounter() for information on how the
+		 * counter is incremented/decremented.
 		 */
 		UINT32 getLastUsedCounter() const { return mLastUsedCounter; }
 
@@ -434,9 +448,32 @@ namespace bs { namespace ct
 		SPtr<RenderTexture> getTarget() const;
 
 	private:
+		/** State of a single node of the quad-tree. */
+		enum class NodeState : UINT8
+		{
+			Free, /**< Node is not split, and not occupied by a map. */
+			Used, /**< Node is occupied by a map. */
+			Split /**< Node is split into four child nodes. */
+		};
+
+		/** Returns the size of the region required for storing a map of the specified size (including the border). */
+		UINT32 getRegionSize(UINT32 sizeWithBorder) const;
+
+		/** 
+		 * Updates the size of the largest free region of all the parents of the specified node, merging parents whose
+		 * children are all free.
+		 */
+		void updateParents(UINT32 nodeIdx, UINT32 nodeSize);
+
 		SPtr<PooledRenderTexture> mAtlas;
+		UINT32 mSize;
+		UINT32 mMinMapSize;
+
+		// Nodes are stored breadth first, with the children of node i at indices [4i + 1, 4i + 4]
+		Vector<NodeState> mNodeStates;
+		Vector<UINT32> mLargestFree; // Size of the largest free region in the subtree of the node
 
-		TextureAtlasLayout mLayout;
+		UINT32 mNumMaps = 0;
 		UINT32 mLastUsedCounter;
 	};
 
@@ -518,6 +555,7 @@ namespace bs { namespace ct
 			UINT32 lightIdx;
 			UINT32 mapSize;
 			SmallVector<float, 6> fadePercents;
+			bool reusePrevious = false; /**< Reuse the shadow map from the previous frame instead of rendering it. */
 		};
 
 		/** Contains references to all shadows cast by a specific light. */
@@ -532,6 +570,62 @@ namespace bs { namespace ct
 		{
 			SmallVector<LightShadows, 6> viewShadows;
 		};
+
+		/** 
+		 * Set of views whose frusta are close enough that they can share a single cascaded shadow map for a directional
+		 * light (e.g. the two eyes of a VR headset).
+		 */
+		struct CascadeViewGroup
+		{
+			SmallVector<const RendererView*, 2> views; /**< First view determines the cascade splits. */
+			SmallVector<Sphere, 4> bounds; /**< Merged bounds of the split frusta of all views, per cascade. */
+			SmallVector<float, 4> minRadius; /**< Radius of the smallest split frustum bounds, per cascade. */
+		};
+
+		/** 
+		 * Shadow map containing only static shadow casters, as seen from a specific non-movable light. Copied into the
+		 * light's shadow map every frame, after which only the dynamic shadow casters need to be rendered.
+		 */
+		struct StaticShadowCache
+		{
+			SPtr<PooledRenderTexture> depth; /**< 2D texture for spot lights, cubemap for radial lights. */
+			Matrix4 shadowVPTransform; /**< Transform the cached shadow map was rendered with. */
+			float depthBias = 0.0f; /**< Depth bias the cached shadow map was rendered with. */
+			UINT32 mapSize = 0; /**< Size of the cached shadow map, in pixels. */
+			Sphere bounds; /**< Bounds of the light at the time the cached shadow map was rendered. */
+			bool isValid = false; /**< False if the cached shadow map needs to be rendered before use. */
+			UINT32 lastUsedCounter = 0; /**< Number of frames since the cache was last used. */
+		};
+
+		/** 
+		 * Shadow map of a spot or radial light as rendered (or reused) during the previous frame. Allows the light to skip
+		 * rendering its shadow map when the per-frame shadow update budget runs out.
+		 */
+		struct ShadowHistory
+		{
+			ShadowInfo info; /**< Information about the shadow map, as used during the previous frame. */
+			SPtr<Texture> texture; /**< Atlas (spot lights) or cubemap (radial lights) containing the shadow map. */
+			Vector3 position; /**< Position of the light when its shadow map was rendered. */
+			Quaternion rotation; /**< Rotation of the light when its shadow map was rendered. */
+			float range = 0.0f; /**< Attenuation radius of the light when its shadow map was rendered. */
+			Degree spotAngle; /**< Spot angle of the light when its shadow map was rendered. */
+			UINT32 mapSize = 0; /**< Size of the shadow map, in pixels. */
+			UINT32 frameIdx = 0; /**< Index of the frame during which the history was last written to. */
+			UINT32 framesSinceUpdate = 0; /**< Number of frames for which the shadow map was reused. */
+		};
+
+		/** 
+		 * Resolution of the shadow map of a spot or radial light, and the atlas region storing it for spot lights.
+		 * Persists between frames, so the resolution can be kept stable, and regions only need to be reallocated when
+		 * the resolution changes.
+		 */
+		struct ShadowMapAllocation
+		{
+			UINT32 mapSize = 0; /**< Size of the shadow map, in pixels, excluding the border. */
+			UINT32 atlasIdx = (UINT32)-1; /**< Atlas containing the region, or -1 if no region is allocated. */
+			Rect2I area; /**< Region of the atlas containing the shadow map, excluding the border. */
+			UINT32 frameIdx = 0; /**< Index of the frame during which the light last cast a shadow. */
+		};
 	public:
 		ShadowRendering(UINT32 shadowMapSize);
 
@@ -546,11 +640,35 @@ namespace bs { namespace ct
 
 		/** Changes the default shadow map size. Will cause all shadow maps to be rebuilt. */
 		void setShadowMapSize(UINT32 size);
+
+		/** 
+		 * Determines should shadows of static geometry cast by non-movable spot and radial lights be cached, instead of
+		 * being re-rendered every frame. Disabling the caching releases all cached shadow maps.
+		 */
+		void setStaticShadowCaching(bool enabled);
+
+		/** 
+		 * Sets the maximum number of spot and radial light shadow map texels to render per frame (each cubemap face
+		 * counting separately). Lights that don't fit in the budget reuse the shadow map from the previous frame, with
+		 * the budget going to lights with the largest shadow maps that weren't updated for longest. Shadow maps that
+		 * cannot be reused, and the one with the highest priority, are rendered regardless of the budget. Zero means
+		 * there is no limit.
+		 */
+		void setShadowUpdateBudget(UINT32 numTexels);
 	private:
-		/** Renders cascaded shadow maps for the provided directional light viewed from the provided view. */
-		void renderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene, 
+		/** 
+		 * Renders cascaded shadow maps for the provided directional light, viewed from one or multiple views with
+		 * nearly identical frusta. All the views in the group are assigned the same shadow map.
+		 */
+		void renderCascadedShadowMaps(const CascadeViewGroup& viewGroup, UINT32 lightIdx, RendererScene& scene, 
 			const FrameInfo& frameInfo);
 
+		/** 
+		 * Splits the views of the provided view group into groups that can share cascaded shadow maps. Views with
+		 * shadows disabled are not included in any group.
+		 */
+		static void groupViewsForCascades(const RendererViewGroup& viewGroup, Vector<CascadeViewGroup>& output);
+
 		/** Renders shadow maps for the provided spot light. */
 		void renderSpotShadowMap(const RendererLight& light, const ShadowMapOptions& options, RendererScene& scene,
 			const FrameInfo& frameInfo);
@@ -559,6 +677,50 @@ namespace bs { namespace ct
 		void renderRadialShadowMap(const RendererLight& light, const ShadowMapOptions& options, RendererScene& scene, 
 			const FrameInfo& frameInfo);
 
+		/** 
+		 * Invalidates static shadow caches affected by static shadow casters added or removed since the last call, and
+		 * releases caches that haven't been used for a while.
+		 */
+		void updateStaticShadowCaches(const SceneInfo& sceneInfo);
+
+		/** 
+		 * Decides which of the spot and radial light shadow maps should be rendered during this frame, according to the
+		 * shadow update budget, and marks the rest to reuse the shadow maps from the previous frame.
+		 */
+		void scheduleShadowUpdates(const SceneInfo& sceneInfo);
+
+		/** 
+		 * Records the shadow map sizes of the spot and radial lights casting shadows this frame, releasing the atlas
+		 * regions of lights whose size changed, or that no longer cast shadows. Releases atlases that haven't been used
+		 * for a while.
+		 */
+		void updateShadowMapAllocations(const SceneInfo& sceneInfo);
+
+		/** 
+		 * Records the shadow map of a spot or radial light, so it can be reused during the next frame.
+		 * 
+		 * @param[in]	light		Light that cast the shadow.
+		 * @param[in]	info		Information describing the shadow map.
+		 * @param[in]	texture		Texture the shadow map was written to.
+		 * @param[in]	mapSize		Size of the shadow map, in pixels.
+		 * @param[in]	updated		True if the shadow map was rendered, false if it was reused from the previous frame.
+		 */
+		void recordShadowHistory(const Light& light, const ShadowInfo& info, const SPtr<Texture>& texture,
+			UINT32 mapSize, bool updated);
+
+		/** 
+		 * Returns a static shadow cache for the provided light, or null if the light's shadows shouldn't be cached. The
+		 * cache is marked as invalid if it was rendered using different parameters than the ones provided.
+		 * 
+		 * @param[in]	light				Spot or radial light to retrieve the cache for.
+		 * @param[in]	shadowVPTransform	Transform from world space to the shadow map. For radial lights any transform
+		 *									that uniquely identifies the light's position and range.
+		 * @param[in]	depthBias			Depth bias used when rendering the shadow map.
+		 * @param[in]	mapSize				Size of the shadow map, in pixels.
+		 */
+		StaticShadowCache* getStaticShadowCache(const Light& light, const Matrix4& shadowVPTransform, float depthBias,
+			UINT32 mapSize);
+
 		/** 
 		 * Calculates optimal shadow map size, taking into account all views in the scene. Also calculates a fade value
 		 * that can be used for fading out small shadow maps.
@@ -566,13 +728,16 @@ namespace bs { namespace ct
 		 * @param[in]	light			Light for which to calculate the shadow map properties. Cannot be a directional light.
 		 * @param[in]	viewGroup		All the views the shadow will (potentially) be seen through.
 		 * @param[in]	border			Border to reduce the shadow map size by, in pixels.
+		 * @param[in]	prevSize		Size of the light's shadow map during the previous frame, in pixels, or zero if
+		 *								it had none. The previous size is kept until the optimal size moves far enough
+		 *								from it, so the resolution doesn't keep switching back and forth.
 		 * @param[out]	size			Optimal size of the shadow map, in pixels.
 		 * @param[out]	fadePercents	Value in range [0, 1] determining how much should the shadow map be faded out. Each
 		 *								entry corresponds to a single view.
 		 * @param[out]	maxFadePercent	Maximum value in the @p fadePercents array.
 		 */
 		void calcShadowMapProperties(const RendererLight& light, const RendererViewGroup& viewGroup, UINT32 border, 
-			UINT32& size, SmallVector<float, 6>& fadePercents, float& maxFadePercent) const;
+			UINT32 prevSize, UINT32& size, SmallVector<float, 6>& fadePercents, float& maxFadePercent) const;
 
 		/**
 		 * Draws a mesh representing near and far planes at the provided coordinates. The mesh is constructed using
@@ -610,6 +775,13 @@ namespace bs { namespace ct
 		static ConvexVolume getCSMSplitFrustum(const RendererView& view, const Vector3& lightDir, UINT32 cascade, 
 			UINT32 numCascades, Sphere& outBounds);
 
+		/**
+		 * Generates a volume covering all shadow casters that can cast a shadow into the provided spherical area, for
+		 * the provided light direction. Used for cascades shared between multiple views, instead of the tighter volumes
+		 * returned by getCSMSplitFrustum().
+		 */
+		static ConvexVolume getCSMBoundsVolume(const Sphere& bounds, const Vector3& lightDir);
+
 		/**
 		 * Finds the distance (along the view direction) of the frustum split for the specified index. Used for cascaded
 		 * shadow maps.
@@ -660,20 +832,42 @@ namespace bs { namespace ct
 		/** Size of the border of a shadow map in a shadow map atlas, in pixels. */
 		static const UINT32 SHADOW_MAP_BORDER;
 
+		/** 
+		 * Fraction by which the optimal shadow map size needs to move outside of the range covered by the current
+		 * resolution, before the resolution changes.
+		 */
+		static const float SHADOW_MAP_SIZE_HYSTERESIS;
+
 		/** Percent of the length of a single cascade in a CSM, in which to fade out the cascade. */
 		static const float CASCADE_FRACTION_FADE;
 
+		/** 
+		 * Maximum fraction by which the bounds of a cascade can grow, compared to any of the views sharing it, in order
+		 * for multiple views to share a cascaded shadow map.
+		 */
+		static const float CASCADE_SHARE_MAX_GROWTH;
+
 		UINT32 mShadowMapSize;
+		bool mStaticShadowCaching = true;
+		UINT32 mShadowUpdateBudget = 0;
+		UINT32 mFrameIdx = 0;
 
 		Vector<ShadowMapAtlas> mDynamicShadowMaps;
+		UnorderedMap<const Light*, ShadowMapAllocation> mShadowMapAllocations;
 		Vector<ShadowCascadedMap> mCascadedShadowMaps;
 		Vector<ShadowCubemap> mShadowCubemaps;
 
 		Vector<ShadowInfo> mShadowInfos;
 
+		UnorderedMap<const Light*, StaticShadowCache> mStaticShadowCaches;
+		UINT32 mStaticCasterVersion = 0;
+
+		UnorderedMap<const Light*, ShadowHistory> mShadowHistory;
+
 		Vector<LightShadows> mSpotLightShadows;
 		Vector<LightShadows> mRadialLightShadows;
 		Vector<PerViewLightShadows> mDirectionalLightShadows;
+		Vector<CascadeViewGroup> mCascadeViewGroups;
 
 		SPtr<VertexDeclaration> mPositionOnlyVD;
 
@@ -0,0 +1,287 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Shading/BsSkyAtmosphere.h"
+#include "BsRendererScene.h"
+#include "Renderer/BsSkybox.h"
+#include "Renderer/BsLight.h"
+#include "Renderer/BsIBLUtility.h"
+#include "Renderer/BsRendererUtility.h"
+#include "RenderAPI/BsRenderTexture.h"
+#include "Material/BsGpuParamsSet.h"
+#include "Image/BsTexture.h"
+
+namespace bs { namespace ct
+{
+	/** Angular radius of the sun as seen from the earth, in degrees. Used when the light doesn't provide its own. */
+	static constexpr float DEFAULT_SUN_ANGULAR_RADIUS = 0.2675f;
+
+	/** Minimum change in sun direction, in degrees, that triggers a refresh of the image based lighting cubemaps. */
+	static constexpr float REFRESH_ANGLE_THRESHOLD = 0.5f;
+
+	/** Minimum relative change in sun illuminance that triggers a refresh of the image based lighting cubemaps. */
+	static constexpr float REFRESH_ILLUMINANCE_THRESHOLD = 0.02f;
+
+	SkyAtmosphereParamDef gSkyAtmosphereParamDef;
+
+	// Must match the LUT sizes in SkyAtmosphereCommon.bslinc
+	const UINT32 SkyAtmosphereTransmittanceMat::LUT_WIDTH = 256;
+	const UINT32 SkyAtmosphereTransmittanceMat::LUT_HEIGHT = 64;
+	const UINT32 SkyAtmosphereScatteringMat::LUT_WIDTH = 128 * 16;
+	const UINT32 SkyAtmosphereScatteringMat::LUT_HEIGHT = 32;
+
+	void SkyAtmosphereTransmittanceMat::execute(const SPtr<RenderTarget>& target)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.setRenderTarget(target);
+
+		bind();
+		gRendererUtility().drawScreenQuad();
+	}
+
+	SkyAtmosphereScatteringMat::SkyAtmosphereScatteringMat()
+	{
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gTransmittanceLUT", mTransmittanceLUTParam);
+	}
+
+	void SkyAtmosphereScatteringMat::execute(const SPtr<Texture>& transmittanceLUT, const SPtr<RenderTarget>& target)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		mTransmittanceLUTParam.set(transmittanceLUT);
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.setRenderTarget(target);
+
+		bind();
+		gRendererUtility().drawScreenQuad();
+	}
+
+	SkyAtmosphereMat::SkyAtmosphereMat()
+	{
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gTransmittanceLUT", mTransmittanceLUTParam);
+		mParams->getTextureParam(GPT_FRAGMENT_PROGRAM, "gScatteringLUT", mScatteringLUTParam);
+	}
+
+	void SkyAtmosphereMat::setAtmosphere(const SkyAtmosphere& atmosphere)
+	{
+		mTransmittanceLUTParam.set(atmosphere.getTransmittanceLUT());
+		mScatteringLUTParam.set(atmosphere.getScatteringLUT());
+
+		mParams->setParamBlockBuffer("SkyAtmosphereParams", atmosphere.getParamBuffer());
+	}
+
+	void SkyAtmosphereMat::bind(const SPtr<GpuParamBlockBuffer>& perCamera, const SkyAtmosphere& atmosphere)
+	{
+		mParams->setParamBlockBuffer("PerCamera", perCamera);
+		setAtmosphere(atmosphere);
+
+		RendererMaterial::bind();
+	}
+
+	void SkyAtmosphereMat::execute(const SkyAtmosphere& atmosphere, UINT32 face, const SPtr<RenderTarget>& target)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		gSkyAtmosphereParamDef.gCubeFace.set(atmosphere.getParamBuffer(), face);
+		atmosphere.getParamBuffer()->flushToGPU();
+
+		setAtmosphere(atmosphere);
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.setRenderTarget(target);
+
+		RendererMaterial::bind();
+		gRendererUtility().drawScreenQuad();
+	}
+
+	SkyAtmosphereMat* SkyAtmosphereMat::getVariation(bool cubemap)
+	{
+		if (cubemap)
+			return get(getVariation<true>());
+
+		return get(getVariation<false>());
+	}
+
+	SkyAtmosphere::SkyAtmosphere()
+	{
+		mParamBuffer = gSkyAtmosphereParamDef.createBuffer();
+	}
+
+	void SkyAtmosphere::update(const SceneInfo& sceneInfo)
+	{
+		Skybox* skybox = sceneInfo.skybox;
+		mActive = skybox && skybox->getAtmosphere();
+
+		if (!mActive)
+		{
+			mSkybox = nullptr;
+			mRefreshing = false;
+			return;
+		}
+
+		// The first directional light in the scene acts as the sun
+		Radian angularRadius = Degree(DEFAULT_SUN_ANGULAR_RADIUS);
+		if (!sceneInfo.directionalLights.empty())
+		{
+			const Light* light = sceneInfo.directionalLights[0].internal;
+			const Color color = light->getColor();
+
+			mSunDirection = light->getTransform().getRotation().zAxis();
+			mSunIlluminance = Vector3(color.r, color.g, color.b) * light->getLuminance();
+
+			if (light->getSourceRadius() > 0.0f)
+				angularRadius = Degree(light->getSourceRadius());
+		}
+		else
+		{
+			mSunDirection = -Vector3::UNIT_Y;
+			mSunIlluminance = Vector3::ZERO;
+		}
+
+		gSkyAtmosphereParamDef.gSunDirection.set(mParamBuffer, mSunDirection);
+		gSkyAtmosphereParamDef.gSunCosAngularRadius.set(mParamBuffer, Math::cos(angularRadius));
+		gSkyAtmosphereParamDef.gSunIlluminance.set(mParamBuffer, mSunIlluminance);
+		gSkyAtmosphereParamDef.gCubeFace.set(mParamBuffer, 0);
+		mParamBuffer->flushToGPU();
+
+		createLUTs();
+		createCubemaps();
+
+		// If the skybox is new, or its filtered textures were reset, the sky has no valid image based lighting at all.
+		// Generate it immediately instead of spreading it over multiple frames.
+		if (mSkybox != skybox || skybox->getFilteredRadiance() != mRadiance[mReadIdx])
+		{
+			mSkybox = skybox;
+			mRefreshing = false;
+			mRefreshStep = 0;
+
+			mRefreshSunDirection = mSunDirection;
+			mRefreshSunIlluminance = mSunIlluminance;
+
+			while (!refreshStep(skybox))
+				;
+
+			return;
+		}
+
+		// Let any refresh in progress finish before checking for changes, so a continuously moving sun doesn't prevent
+		// the refresh from ever completing
+		if (!mRefreshing && isRefreshRequired())
+		{
+			mRefreshing = true;
+			mRefreshSunDirection = mSunDirection;
+			mRefreshSunIlluminance = mSunIlluminance;
+		}
+
+		if (mRefreshing)
+		{
+			if (refreshStep(skybox))
+				mRefreshing = false;
+		}
+	}
+
+	void SkyAtmosphere::createLUTs()
+	{
+		if (mTransmittanceLUT && mScatteringLUT)
+			return;
+
+		GpuResourcePool& resPool = GpuResourcePool::instance();
+		mTransmittanceLUT = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F,
+			SkyAtmosphereTransmittanceMat::LUT_WIDTH, SkyAtmosphereTransmittanceMat::LUT_HEIGHT, TU_RENDERTARGET));
+		mScatteringLUT = resPool.get(POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA16F,
+			SkyAtmosphereScatteringMat::LUT_WIDTH, SkyAtmosphereScatteringMat::LUT_HEIGHT, TU_RENDERTARGET));
+
+		SkyAtmosphereTransmittanceMat::get()->execute(mTransmittanceLUT->renderTexture);
+		SkyAtmosphereScatteringMat::get()->execute(mTransmittanceLUT->texture, mScatteringLUT->renderTexture);
+	}
+
+	void SkyAtmosphere::createCubemaps()
+	{
+		if (mScratch)
+			return;
+
+		TEXTURE_DESC cubemapDesc;
+		cubemapDesc.type = TEX_TYPE_CUBE_MAP;
+		cubemapDesc.format = PF_RG11B10F;
+		cubemapDesc.width = IBLUtility::REFLECTION_CUBEMAP_SIZE;
+		cubemapDesc.height = IBLUtility::REFLECTION_CUBEMAP_SIZE;
+		cubemapDesc.numMips = PixelUtil::getMaxMipmaps(cubemapDesc.width, cubemapDesc.height, 1, cubemapDesc.format);
+		cubemapDesc.usage = IBLUtility::getSpecularCubemapUsage();
+
+		TEXTURE_DESC irradianceDesc;
+		irradianceDesc.type = TEX_TYPE_CUBE_MAP;
+		irradianceDesc.format = PF_RG11B10F;
+		irradianceDesc.width = IBLUtility::IRRADIANCE_CUBEMAP_SIZE;
+		irradianceDesc.height = IBLUtility::IRRADIANCE_CUBEMAP_SIZE;
+		irradianceDesc.numMips = 0;
+		irradianceDesc.usage = TU_STATIC | TU_RENDERTARGET;
+
+		for (UINT32 i = 0; i < 2; i++)
+		{
+			mRadiance[i] = Texture::create(cubemapDesc);
+			mIrradiance[i] = Texture::create(irradianceDesc);
+		}
+
+		TEXTURE_DESC scratchDesc = cubemapDesc;
+		scratchDesc.usage = TU_STATIC | TU_RENDERTARGET;
+
+		mScratch = Texture::create(scratchDesc);
+	}
+
+	bool SkyAtmosphere::refreshStep(Skybox* skybox)
+	{
+		const UINT32 writeIdx = (mReadIdx + 1) % 2;
+		const SPtr<Texture>& radiance = mRadiance[writeIdx];
+
+		// Step 0 renders the sky into the top mip level of the cubemap
+		if (mRefreshStep == 0)
+		{
+			SkyAtmosphereMat* material = SkyAtmosphereMat::getVariation(true);
+			for (UINT32 face = 0; face < 6; face++)
+			{
+				RENDER_TEXTURE_DESC cubeFaceRTDesc;
+				cubeFaceRTDesc.colorSurfaces[0].texture = radiance;
+				cubeFaceRTDesc.colorSurfaces[0].face = face;
+				cubeFaceRTDesc.colorSurfaces[0].numFaces = 1;
+				cubeFaceRTDesc.colorSurfaces[0].mipLevel = 0;
+
+				SPtr<RenderTarget> target = RenderTexture::create(cubeFaceRTDesc);
+				material->execute(*this, face, target);
+			}
+
+			mSpecularFiltered = false;
+			mRefreshStep++;
+			return false;
+		}
+
+		// Following steps filter one mip level at a time, after which irradiance is generated in a single step
+		if (!mSpecularFiltered)
+		{
+			mSpecularFiltered = gIBLUtility().filterCubemapForSpecular(radiance, mScratch, mRefreshStep - 1);
+			mRefreshStep++;
+			return false;
+		}
+
+		gIBLUtility().filterCubemapForIrradiance(radiance, mIrradiance[writeIdx]);
+
+		mReadIdx = writeIdx;
+		mRefreshStep = 0;
+
+		skybox->_setFilteredTextures(mRadiance[mReadIdx], mIrradiance[mReadIdx]);
+		return true;
+	}
+
+	bool SkyAtmosphere::isRefreshRequired() const
+	{
+		const float cosThreshold = Math::cos(Degree(REFRESH_ANGLE_THRESHOLD));
+		if (mSunDirection.dot(mRefreshSunDirection) < cosThreshold)
+			return true;
+
+		const float prevLength = mRefreshSunIlluminance.length();
+		const float diffLength = (mSunIlluminance - mRefreshSunIlluminance).length();
+
+		return diffLength > prevLength * REFRESH_ILLUMINANCE_THRESHOLD;
+	}
+}}
@@ -0,0 +1,183 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Renderer/BsRendererMaterial.h"
+#include "Renderer/BsGpuResourcePool.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Math/BsVector3.h"
+
+namespace bs { namespace ct
+{
+	struct SceneInfo;
+	class SkyAtmosphere;
+
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(SkyAtmosphereParamDef)
+		BS_PARAM_BLOCK_ENTRY(Vector3, gSunDirection)
+		BS_PARAM_BLOCK_ENTRY(float, gSunCosAngularRadius)
+		BS_PARAM_BLOCK_ENTRY(Vector3, gSunIlluminance)
+		BS_PARAM_BLOCK_ENTRY(INT32, gCubeFace)
+	BS_PARAM_BLOCK_END
+
+	extern SkyAtmosphereParamDef gSkyAtmosphereParamDef;
+
+	/** Computes the atmosphere transmittance LUT, mapping view height and view zenith angle to transmittance. */
+	class SkyAtmosphereTransmittanceMat : public RendererMaterial<SkyAtmosphereTransmittanceMat>
+	{
+		RMAT_DEF("SkyAtmosphereTransmittanceLUT.bsl");
+
+	public:
+		/** Renders the transmittance LUT into the provided target. */
+		void execute(const SPtr<RenderTarget>& target);
+
+		static const UINT32 LUT_WIDTH;
+		static const UINT32 LUT_HEIGHT;
+	};
+
+	/**
+	 * Computes the atmosphere single scattering LUT, mapping view zenith, sun zenith and view-sun angles to
+	 * in-scattered Rayleigh and Mie radiance. The view-sun angle slices are laid out next to each other along the X
+	 * axis.
+	 */
+	class SkyAtmosphereScatteringMat : public RendererMaterial<SkyAtmosphereScatteringMat>
+	{
+		RMAT_DEF("SkyAtmosphereScatteringLUT.bsl");
+
+	public:
+		SkyAtmosphereScatteringMat();
+
+		/** Renders the scattering LUT into the provided target, using the previously computed transmittance LUT. */
+		void execute(const SPtr<Texture>& transmittanceLUT, const SPtr<RenderTarget>& target);
+
+		static const UINT32 LUT_WIDTH;
+		static const UINT32 LUT_HEIGHT;
+	private:
+		GpuParamTexture mTransmittanceLUTParam;
+	};
+
+	/** Evaluates the sky radiance using the precomputed atmosphere LUTs. */
+	class SkyAtmosphereMat : public RendererMaterial<SkyAtmosphereMat>
+	{
+		RMAT_DEF("SkyAtmosphere.bsl");
+
+		/** Helper method used for initializing variations of this material. */
+		template<bool cubemap>
+		static const ShaderVariation& getVariation()
+		{
+			static ShaderVariation variation = ShaderVariation(
+			{
+				ShaderVariation::Param("CUBEMAP", cubemap)
+			});
+
+			return variation;
+		}
+	public:
+		SkyAtmosphereMat();
+
+		/**
+		 * Binds the material for rendering the sky behind the scene, using the skybox mesh. Only valid for the
+		 * non-cubemap variation.
+		 */
+		void bind(const SPtr<GpuParamBlockBuffer>& perCamera, const SkyAtmosphere& atmosphere);
+
+		/**
+		 * Renders the sky radiance, excluding the sun disc, into a single face of a cubemap. Only valid for the cubemap
+		 * variation.
+		 */
+		void execute(const SkyAtmosphere& atmosphere, UINT32 face, const SPtr<RenderTarget>& target);
+
+		/**
+		 * Returns the material variation matching the provided parameters.
+		 *
+		 * @param[in]	cubemap		When true the material will render into cubemap faces using a screen quad, for use
+		 *							as the sky's image based lighting source. When false the material renders the sky
+		 *							behind the scene using the skybox mesh.
+		 */
+		static SkyAtmosphereMat* getVariation(bool cubemap);
+	private:
+		/** Assigns the atmosphere LUTs and parameters to the material. */
+		void setAtmosphere(const SkyAtmosphere& atmosphere);
+
+		GpuParamTexture mTransmittanceLUTParam;
+		GpuParamTexture mScatteringLUTParam;
+	};
+
+	/**
+	 * Procedural sky rendered from an atmosphere scattering model, lit by the scene's primary directional light. The
+	 * transmittance and scattering LUTs of the atmosphere only depend on its (fixed) physical properties and are
+	 * computed once. The filtered radiance and irradiance cubemaps used for the sky's image based lighting depend on
+	 * the sun, and are refreshed whenever the sun changes noticeably. The refresh is spread over multiple frames, and
+	 * the previous cubemaps remain in use until the new ones are fully filtered.
+	 */
+	class SkyAtmosphere
+	{
+	public:
+		SkyAtmosphere();
+
+		/**
+		 * Updates the sun parameters and advances the refresh of the image based lighting cubemaps, if required. Should
+		 * be called once per frame, before rendering.
+		 */
+		void update(const SceneInfo& sceneInfo);
+
+		/** Returns true if the scene's skybox uses the atmosphere, and the atmosphere LUTs are ready for rendering. */
+		bool isActive() const { return mActive; }
+
+		/** Returns the LUT containing transmittance from a point in the atmosphere to its top. */
+		SPtr<Texture> getTransmittanceLUT() const { return mTransmittanceLUT ? mTransmittanceLUT->texture : nullptr; }
+
+		/** Returns the LUT containing single scattered radiance. */
+		SPtr<Texture> getScatteringLUT() const { return mScatteringLUT ? mScatteringLUT->texture : nullptr; }
+
+		/** Returns a buffer containing the current sun parameters, as described by SkyAtmosphereParamDef. */
+		const SPtr<GpuParamBlockBuffer>& getParamBuffer() const { return mParamBuffer; }
+
+	private:
+		/** Renders the transmittance and scattering LUTs, if they aren't already available. */
+		void createLUTs();
+
+		/** Allocates the cubemaps used for image based lighting, if they aren't already available. */
+		void createCubemaps();
+
+		/**
+		 * Executes a single step of the image based lighting refresh. Returns true when the refresh is complete and the
+		 * results have been assigned to the skybox.
+		 */
+		bool refreshStep(Skybox* skybox);
+
+		/** Checks if the cubemaps were generated using sun parameters different enough from the current ones. */
+		bool isRefreshRequired() const;
+
+		bool mActive = false;
+		Skybox* mSkybox = nullptr;
+
+		SPtr<PooledRenderTexture> mTransmittanceLUT;
+		SPtr<PooledRenderTexture> mScatteringLUT;
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+
+		// Current sun parameters
+		Vector3 mSunDirection = -Vector3::UNIT_Y;
+		Vector3 mSunIlluminance = Vector3::ZERO;
+
+		// Sun parameters the most recent (possibly still in progress) cubemap refresh was started with
+		Vector3 mRefreshSunDirection = -Vector3::UNIT_Y;
+		Vector3 mRefreshSunIlluminance = Vector3::ZERO;
+
+		// Cubemaps are double buffered, one is assigned to the skybox while the other one is being refreshed
+		SPtr<Texture> mRadiance[2];
+		SPtr<Texture> mIrradiance[2];
+		SPtr<Texture> mScratch;
+		UINT32 mReadIdx = 0;
+
+		bool mRefreshing = false;
+		bool mSpecularFiltered = false;
+		UINT32 mRefreshStep = 0;
+	};
+
+	/** @} */
+}}
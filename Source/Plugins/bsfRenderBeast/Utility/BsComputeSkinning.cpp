@@ -0,0 +1,151 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsComputeSkinning.h"
+#include "Renderer/BsRenderable.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "RenderAPI/BsVertexBuffer.h"
+#include "RenderAPI/BsVertexData.h"
+#include "RenderAPI/BsVertexDeclaration.h"
+#include "Managers/BsHardwareBufferManager.h"
+#include "Mesh/BsMesh.h"
+#include "BsRenderBeast.h"
+
+namespace bs { namespace ct
+{
+	/** Number of threads in a single compute group. */
+	static constexpr UINT32 NUM_THREADS = 64;
+
+	/** Size of a single skinned vertex: position, packed normal and packed tangent. */
+	static constexpr UINT32 SKINNED_VERTEX_SIZE = sizeof(Vector3) + sizeof(UINT32) * 2;
+
+	ComputeSkinningParamDef gComputeSkinningParamDef;
+
+	/** Checks is the vertex element present in the first stream, of the specified type, and aligned to 32 bits. */
+	static bool isValidElement(const VertexElement* element, VertexElementType type)
+	{
+		return element != nullptr && element->getStreamIdx() == 0 && element->getType() == type &&
+			(element->getOffset() % sizeof(UINT32)) == 0;
+	}
+
+	SPtr<SkinnedVertexCache> SkinnedVertexCache::create(const Renderable& renderable)
+	{
+		if (gRenderBeast()->getFeatureSet() != RenderBeastFeatureSet::Desktop)
+			return nullptr;
+
+		SPtr<Mesh> mesh = renderable.getMesh();
+		if (mesh == nullptr || renderable.getBoneMatrixBuffer() == nullptr)
+			return nullptr;
+
+		// Only single stream meshes are supported, whose normals and tangents are packed the same way the skinned
+		// vertices are
+		SPtr<VertexData> vertexData = mesh->getVertexData();
+		if (vertexData->getBufferCount() != 1 || vertexData->getBuffer(0) == nullptr)
+			return nullptr;
+
+		const VertexDeclarationProperties& declProps = vertexData->vertexDeclaration->getProperties();
+		const VertexElement* position = declProps.findElementBySemantic(VES_POSITION);
+		const VertexElement* normal = declProps.findElementBySemantic(VES_NORMAL);
+		const VertexElement* tangent = declProps.findElementBySemantic(VES_TANGENT);
+		const VertexElement* blendIndices = declProps.findElementBySemantic(VES_BLEND_INDICES);
+		const VertexElement* blendWeights = declProps.findElementBySemantic(VES_BLEND_WEIGHTS);
+
+		if (!isValidElement(position, VET_FLOAT3) ||
+			!isValidElement(normal, VET_UBYTE4_NORM) ||
+			!isValidElement(tangent, VET_UBYTE4_NORM) ||
+			!isValidElement(blendIndices, VET_UBYTE4))
+			return nullptr;
+
+		const bool packedWeights = isValidElement(blendWeights, VET_UBYTE4_NORM);
+		if (!packedWeights && !isValidElement(blendWeights, VET_FLOAT4))
+			return nullptr;
+
+		const UINT32 stride = declProps.getVertexSize(0);
+		if ((stride % sizeof(UINT32)) != 0)
+			return nullptr;
+
+		const UINT32 numVertices = vertexData->vertexCount;
+
+		SPtr<SkinnedVertexCache> cache = bs_shared_ptr_new<SkinnedVertexCache>();
+		cache->numVertices = numVertices;
+		cache->sourceStride = stride / sizeof(UINT32);
+		cache->positionOffset = position->getOffset() / sizeof(UINT32);
+		cache->normalOffset = normal->getOffset() / sizeof(UINT32);
+		cache->tangentOffset = tangent->getOffset() / sizeof(UINT32);
+		cache->blendIndicesOffset = blendIndices->getOffset() / sizeof(UINT32);
+		cache->blendWeightsOffset = blendWeights->getOffset() / sizeof(UINT32);
+		cache->packedWeights = packedWeights;
+
+		// Mesh vertex buffers can't be bound to compute shaders, so the vertices are copied once on the GPU instead
+		VERTEX_BUFFER_DESC sourceDesc;
+		sourceDesc.vertexSize = stride;
+		sourceDesc.numVerts = numVertices;
+		sourceDesc.usage = GBU_LOADSTORE;
+
+		cache->source = VertexBuffer::create(sourceDesc);
+		cache->source->copyData(*vertexData->getBuffer(0), 0, 0, stride * numVertices, true);
+		cache->sourceView = cache->source->getLoadStore(GBT_STANDARD, BF_32X1U);
+
+		VERTEX_BUFFER_DESC outputDesc;
+		outputDesc.vertexSize = SKINNED_VERTEX_SIZE;
+		outputDesc.numVerts = numVertices;
+		outputDesc.usage = GBU_LOADSTORE;
+
+		cache->output = VertexBuffer::create(outputDesc);
+		cache->outputView = cache->output->getLoadStore(GBT_STANDARD, BF_32X1U);
+
+		if (cache->sourceView == nullptr || cache->outputView == nullptr)
+			return nullptr;
+
+		// Position, normal and tangent are read from the skinned vertices, everything else from the mesh
+		Vector<VertexElement> elements;
+		for (auto& element : declProps.getElements())
+		{
+			const VertexElementSemantic semantic = element.getSemantic();
+			if (element.getSemanticIdx() == 0 &&
+				(semantic == VES_POSITION || semantic == VES_NORMAL || semantic == VES_TANGENT))
+				continue;
+
+			elements.push_back(element);
+		}
+
+		elements.push_back(VertexElement(1, 0, VET_FLOAT3, VES_POSITION));
+		elements.push_back(VertexElement(1, sizeof(Vector3), VET_UBYTE4_NORM, VES_NORMAL));
+		elements.push_back(VertexElement(1, sizeof(Vector3) + sizeof(UINT32), VET_UBYTE4_NORM, VES_TANGENT));
+
+		cache->vertexDeclaration = HardwareBufferManager::instance().createVertexDeclaration(elements);
+		return cache;
+	}
+
+	ComputeSkinningMat::ComputeSkinningMat()
+	{
+		mParamBuffer = gComputeSkinningParamDef.createBuffer();
+
+		mParams->setParamBlockBuffer("Params", mParamBuffer);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gBoneMatrices", mBoneMatricesParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gSource", mSourceParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gOutput", mOutputParam);
+	}
+
+	void ComputeSkinningMat::execute(const SkinnedVertexCache& cache, const SPtr<GpuBuffer>& boneMatrices)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		gComputeSkinningParamDef.gNumVertices.set(mParamBuffer, cache.numVertices);
+		gComputeSkinningParamDef.gSourceStride.set(mParamBuffer, cache.sourceStride);
+		gComputeSkinningParamDef.gPositionOffset.set(mParamBuffer, cache.positionOffset);
+		gComputeSkinningParamDef.gNormalOffset.set(mParamBuffer, cache.normalOffset);
+		gComputeSkinningParamDef.gTangentOffset.set(mParamBuffer, cache.tangentOffset);
+		gComputeSkinningParamDef.gBlendIndicesOffset.set(mParamBuffer, cache.blendIndicesOffset);
+		gComputeSkinningParamDef.gBlendWeightsOffset.set(mParamBuffer, cache.blendWeightsOffset);
+		gComputeSkinningParamDef.gPackedWeights.set(mParamBuffer, cache.packedWeights ? 1 : 0);
+
+		mBoneMatricesParam.set(boneMatrices);
+		mSourceParam.set(cache.sourceView);
+		mOutputParam.set(cache.outputView);
+
+		bind();
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.dispatchCompute(Math::divideAndRoundUp(cache.numVertices, NUM_THREADS));
+	}
+}}
@@ -0,0 +1,98 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Renderer/BsRendererMaterial.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(ComputeSkinningParamDef)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gNumVertices)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gSourceStride)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gPositionOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gNormalOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gTangentOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gBlendIndicesOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gBlendWeightsOffset)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gPackedWeights)
+	BS_PARAM_BLOCK_END
+
+	extern ComputeSkinningParamDef gComputeSkinningParamDef;
+
+	/**
+	 * Vertices of a skinned renderable, skinned once per frame by ComputeSkinningMat and then used by all the passes
+	 * drawing the renderable, which render it as a static mesh.
+	 */
+	struct SkinnedVertexCache
+	{
+		/** Copy of the mesh vertices, readable from compute shaders. */
+		SPtr<VertexBuffer> source;
+
+		/** Load-store view of @p source. */
+		SPtr<GpuBuffer> sourceView;
+
+		/** Skinned position, packed normal and packed tangent of every vertex. */
+		SPtr<VertexBuffer> output;
+
+		/** Load-store view of @p output. */
+		SPtr<GpuBuffer> outputView;
+
+		/** Declaration of the mesh vertices, with position, normal and tangent read from @p output in stream 1. */
+		SPtr<VertexDeclaration> vertexDeclaration;
+
+		/** Number of vertices in the mesh. */
+		UINT32 numVertices = 0;
+
+		/** Distance between two vertices in @p source, in 32-bit words. */
+		UINT32 sourceStride = 0;
+
+		/** Offsets of the vertex elements within a vertex in @p source, in 32-bit words. */
+		UINT32 positionOffset = 0;
+		UINT32 normalOffset = 0;
+		UINT32 tangentOffset = 0;
+		UINT32 blendIndicesOffset = 0;
+		UINT32 blendWeightsOffset = 0;
+
+		/** True if blend weights are stored as normalized bytes, false if stored as floats. */
+		bool packedWeights = false;
+
+		/**
+		 * Creates a cache for the provided skinned renderable. Returns null if skinning in a compute shader isn't
+		 * supported on the active feature set, or for the layout of the renderable's mesh, in which case the renderable
+		 * should be skinned in the vertex shader instead.
+		 */
+		static SPtr<SkinnedVertexCache> create(const Renderable& renderable);
+	};
+
+	/** Skins the vertices of a renderable and writes them to its SkinnedVertexCache. */
+	class ComputeSkinningMat : public RendererMaterial<ComputeSkinningMat>
+	{
+		RMAT_DEF("ComputeSkinning.bsl")
+
+	public:
+		ComputeSkinningMat();
+
+		/**
+		 * Skins the vertices in the cache.
+		 *
+		 * @param[in]	cache			Cache containing the source vertices, and the buffer to write the skinned
+		 *								vertices to.
+		 * @param[in]	boneMatrices	Buffer of the renderable, containing three rows of the transform for each bone.
+		 */
+		void execute(const SkinnedVertexCache& cache, const SPtr<GpuBuffer>& boneMatrices);
+
+	private:
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+		GpuParamBuffer mBoneMatricesParam;
+		GpuParamBuffer mSourceParam;
+		GpuParamBuffer mOutputParam;
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,112 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsGpuTextureCompression.h"
+#include "Renderer/BsGpuResourcePool.h"
+#include "RenderAPI/BsRenderAPI.h"
+#include "Image/BsTexture.h"
+#include "BsRenderBeast.h"
+
+namespace bs { namespace ct
+{
+	/** Size of a single compressed block, in texels. */
+	static constexpr UINT32 BLOCK_SIZE = 4;
+
+	/** Number of threads in a single compute group, in each dimension. */
+	static constexpr UINT32 NUM_THREADS = 8;
+
+	TextureCompressParamDef gTextureCompressParamDef;
+
+	TextureCompressMat::TextureCompressMat()
+	{
+		mParamBuffer = gTextureCompressParamDef.createBuffer();
+
+		mParams->setParamBlockBuffer("Params", mParamBuffer);
+		mParams->getTextureParam(GPT_COMPUTE_PROGRAM, "gInputTex", mInputTexture);
+		mParams->getLoadStoreTextureParam(GPT_COMPUTE_PROGRAM, "gOutput", mOutputTexture);
+	}
+
+	void TextureCompressMat::execute(const SPtr<Texture>& source, UINT32 face, UINT32 mip, const SPtr<Texture>& output)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		auto& props = source->getProperties();
+
+		UINT32 width, height, depth;
+		PixelUtil::getSizeForMipLevel(props.getWidth(), props.getHeight(), 1, mip, width, height, depth);
+
+		gTextureCompressParamDef.gSize.set(mParamBuffer, Vector2I((INT32)width, (INT32)height));
+		gTextureCompressParamDef.gCubeFace.set(mParamBuffer, face);
+		gTextureCompressParamDef.gMipLevel.set(mParamBuffer, mip);
+
+		mInputTexture.set(source);
+		mOutputTexture.set(output);
+
+		bind();
+
+		const UINT32 numBlocksX = Math::divideAndRoundUp(width, BLOCK_SIZE);
+		const UINT32 numBlocksY = Math::divideAndRoundUp(height, BLOCK_SIZE);
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.dispatchCompute(Math::divideAndRoundUp(numBlocksX, NUM_THREADS),
+			Math::divideAndRoundUp(numBlocksY, NUM_THREADS));
+	}
+
+	TextureCompressMat* TextureCompressMat::getVariation(PixelFormat format, bool cube)
+	{
+		if(format == PF_BC7)
+		{
+			if (cube)
+				return get(getVariation<1, true>());
+
+			return get(getVariation<1, false>());
+		}
+
+		if (cube)
+			return get(getVariation<0, true>());
+
+		return get(getVariation<0, false>());
+	}
+
+	bool GpuTextureCompression::isSupported(PixelFormat format)
+	{
+		if(format != PF_BC6H && format != PF_BC7)
+			return false;
+
+		return gRenderBeast()->getFeatureSet() == RenderBeastFeatureSet::Desktop;
+	}
+
+	void GpuTextureCompression::compress(const SPtr<Texture>& source, UINT32 srcFace, UINT32 srcMip,
+		const SPtr<Texture>& target, UINT32 dstFace, UINT32 dstMip)
+	{
+		const TextureProperties& srcProps = source->getProperties();
+		const TextureProperties& dstProps = target->getProperties();
+
+		if(!isSupported(dstProps.getFormat()))
+		{
+			LOGERR("GPU texture compression isn't supported for the target texture format.");
+			return;
+		}
+
+		UINT32 width, height, depth;
+		PixelUtil::getSizeForMipLevel(srcProps.getWidth(), srcProps.getHeight(), 1, srcMip, width, height, depth);
+
+		// Blocks are first written to an uncompressed texture with one texel per block, and then copied to the target.
+		// Render APIs support copies between uncompressed and compressed formats if their texel and block sizes match.
+		POOLED_RENDER_TEXTURE_DESC blocksDesc = POOLED_RENDER_TEXTURE_DESC::create2D(PF_RGBA32U,
+			Math::divideAndRoundUp(width, BLOCK_SIZE), Math::divideAndRoundUp(height, BLOCK_SIZE), TU_LOADSTORE);
+
+		SPtr<PooledRenderTexture> blocks = GpuResourcePool::instance().get(blocksDesc);
+
+		const bool cube = srcProps.getTextureType() == TEX_TYPE_CUBE_MAP;
+		TextureCompressMat* material = TextureCompressMat::getVariation(dstProps.getFormat(), cube);
+		material->execute(source, cube ? srcFace : 0, srcMip, blocks->texture);
+
+		TEXTURE_COPY_DESC copyDesc;
+		copyDesc.dstFace = dstFace;
+		copyDesc.dstMip = dstMip;
+
+		blocks->texture->copy(target, copyDesc);
+
+		GpuResourcePool::instance().release(blocks);
+	}
+}}
@@ -0,0 +1,98 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Renderer/BsRendererMaterial.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(TextureCompressParamDef)
+		BS_PARAM_BLOCK_ENTRY(Vector2I, gSize)
+		BS_PARAM_BLOCK_ENTRY(int, gCubeFace)
+		BS_PARAM_BLOCK_ENTRY(int, gMipLevel)
+	BS_PARAM_BLOCK_END
+
+	extern TextureCompressParamDef gTextureCompressParamDef;
+
+	/**
+	 * Compresses a single surface of a texture into BC6H or BC7 blocks. Outputs a 32-bit unsigned integer RGBA texture,
+	 * with each texel containing a single 4x4 block.
+	 */
+	class TextureCompressMat : public RendererMaterial<TextureCompressMat>
+	{
+		RMAT_DEF("TextureCompress.bsl")
+
+		/** Helper method used for initializing variations of this material. */
+		template<int format, bool cube>
+		static const ShaderVariation& getVariation()
+		{
+			static ShaderVariation variation = ShaderVariation(
+			{
+				ShaderVariation::Param("FORMAT", format),
+				ShaderVariation::Param("CUBE", cube)
+			});
+
+			return variation;
+		}
+	public:
+		TextureCompressMat();
+
+		/**
+		 * Compresses a surface of the provided texture.
+		 *
+		 * @param[in]	source	Texture to compress. Must be a 2D texture or a cubemap, matching the variation of the
+		 *						material.
+		 * @param[in]	face	Face of the source texture to compress.
+		 * @param[in]	mip		Mip level of the source texture to compress.
+		 * @param[in]	output	Texture to write the compressed blocks to. Must be a PF_RGBA32U texture with random
+		 *						write support, and at least one texel for each 4x4 block of the source surface.
+		 */
+		void execute(const SPtr<Texture>& source, UINT32 face, UINT32 mip, const SPtr<Texture>& output);
+
+		/**
+		 * Returns the material variation compressing into the specified format.
+		 *
+		 * @param[in]	format	Format to compress to. Must be PF_BC6H or PF_BC7.
+		 * @param[in]	cube	True if the source texture is a cubemap, false if it is a 2D texture.
+		 */
+		static TextureCompressMat* getVariation(PixelFormat format, bool cube);
+
+	private:
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+		GpuParamTexture mInputTexture;
+		GpuParamLoadStoreTexture mOutputTexture;
+	};
+
+	/**
+	 * Compresses textures generated at runtime on the GPU, allowing them to be stored in block compressed formats
+	 * without a round trip through the CPU.
+	 */
+	class GpuTextureCompression
+	{
+	public:
+		/** Checks can textures be compressed into the specified format using the active render API and renderer. */
+		static bool isSupported(PixelFormat format);
+
+		/**
+		 * Compresses a surface of the source texture and writes the result into a surface of the target texture.
+		 *
+		 * @param[in]	source		2D texture or a cubemap to compress. Supports any uncompressed color format.
+		 * @param[in]	srcFace		Face of the source texture to compress.
+		 * @param[in]	srcMip		Mip level of the source texture to compress.
+		 * @param[in]	target		2D texture or a cubemap in PF_BC6H or PF_BC7 format, to write the compressed data to.
+		 *							The surface being written to must be of the same size as the source surface.
+		 * @param[in]	dstFace		Face of the target texture to write to.
+		 * @param[in]	dstMip		Mip level of the target texture to write to.
+		 */
+		static void compress(const SPtr<Texture>& source, UINT32 srcFace, UINT32 srcMip, const SPtr<Texture>& target,
+			UINT32 dstFace, UINT32 dstMip);
+	};
+
+	/** @} */
+}}
@@ -0,0 +1,41 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsMorphShapeBlend.h"
+#include "Renderer/BsRenderable.h"
+#include "RenderAPI/BsRenderAPI.h"
+
+namespace bs { namespace ct
+{
+	/** Number of threads in a single compute group. */
+	static constexpr UINT32 NUM_THREADS = 64;
+
+	MorphShapeBlendParamDef gMorphShapeBlendParamDef;
+
+	MorphShapeBlendMat::MorphShapeBlendMat()
+	{
+		mParamBuffer = gMorphShapeBlendParamDef.createBuffer();
+
+		mParams->setParamBlockBuffer("Params", mParamBuffer);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gVertexRanges", mVertexRangesParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gDeltas", mDeltasParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gWeights", mWeightsParam);
+		mParams->getBufferParam(GPT_COMPUTE_PROGRAM, "gOutput", mOutputParam);
+	}
+
+	void MorphShapeBlendMat::execute(const MorphShapeGpuBuffers& buffers)
+	{
+		BS_RENMAT_PROFILE_BLOCK
+
+		gMorphShapeBlendParamDef.gNumVertices.set(mParamBuffer, buffers.numVertices);
+
+		mVertexRangesParam.set(buffers.vertexRanges);
+		mDeltasParam.set(buffers.deltas);
+		mWeightsParam.set(buffers.weights);
+		mOutputParam.set(buffers.output);
+
+		bind();
+
+		RenderAPI& rapi = RenderAPI::instance();
+		rapi.dispatchCompute(Math::divideAndRoundUp(buffers.numVertices, NUM_THREADS));
+	}
+}}
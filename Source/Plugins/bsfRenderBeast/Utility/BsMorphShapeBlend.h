@@ -0,0 +1,47 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Renderer/BsParamBlocks.h"
+#include "Renderer/BsRendererMaterial.h"
+
+namespace bs { namespace ct
+{
+	struct MorphShapeGpuBuffers;
+
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	BS_PARAM_BLOCK_BEGIN(MorphShapeBlendParamDef)
+		BS_PARAM_BLOCK_ENTRY(UINT32, gNumVertices)
+	BS_PARAM_BLOCK_END
+
+	extern MorphShapeBlendParamDef gMorphShapeBlendParamDef;
+
+	/**
+	 * Blends morph shapes of a renderable on the GPU, using the morph shape deltas uploaded when the renderable was
+	 * created and the current morph shape weights. Outputs the same vertex layout as the CPU blending path, position
+	 * offset followed by a packed normal offset and accumulated weight.
+	 */
+	class MorphShapeBlendMat : public RendererMaterial<MorphShapeBlendMat>
+	{
+		RMAT_DEF("MorphShapeBlend.bsl")
+
+	public:
+		MorphShapeBlendMat();
+
+		/** Blends the morph shapes and writes the result into the morph shape vertex buffer of the renderable. */
+		void execute(const MorphShapeGpuBuffers& buffers);
+
+	private:
+		SPtr<GpuParamBlockBuffer> mParamBuffer;
+		GpuParamBuffer mVertexRangesParam;
+		GpuParamBuffer mDeltasParam;
+		GpuParamBuffer mWeightsParam;
+		GpuParamBuffer mOutputParam;
+	};
+
+	/** @} */
+}}
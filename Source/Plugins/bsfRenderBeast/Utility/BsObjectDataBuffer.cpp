@@ -0,0 +1,115 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsObjectDataBuffer.h"
+#include "RenderAPI/BsGpuBuffer.h"
+#include "BsRendererRenderable.h"
+#include "Renderer/BsTextureTable.h"
+
+namespace bs { namespace ct
+{
+	static constexpr UINT8 ALL_BUFFERS_MASK = (1 << ObjectDataBuffer::NUM_BUFFERS) - 1;
+
+	void ObjectDataBuffer::markDirty(UINT32 idx)
+	{
+		if (idx >= (UINT32)mStaleMasks.size())
+			mStaleMasks.resize(idx + 1, 0);
+
+		if (mStaleMasks[idx] == 0)
+			mDirtyObjects.push_back(idx);
+
+		mStaleMasks[idx] = ALL_BUFFERS_MASK;
+	}
+
+	void ObjectDataBuffer::update(const Vector<RendererRenderable*>& renderables)
+	{
+		const auto numObjects = (UINT32)renderables.size();
+
+		// Contents are lost when the buffers are resized, so all objects need to be written again
+		if (numObjects > mCapacity)
+		{
+			mCapacity = Math::divideAndRoundUp(numObjects, CAPACITY_INCREMENT) * CAPACITY_INCREMENT;
+
+			GPU_BUFFER_DESC desc;
+			desc.type = GBT_STANDARD;
+			desc.format = BF_32X4F;
+			desc.elementCount = mCapacity * ENTRY_SIZE;
+			desc.usage = GBU_DYNAMIC;
+
+			for (auto& buffer : mBuffers)
+				buffer = GpuBuffer::create(desc);
+
+			mStaleMasks.assign(numObjects, ALL_BUFFERS_MASK);
+			mDirtyObjects.resize(numObjects);
+			for (UINT32 i = 0; i < numObjects; i++)
+				mDirtyObjects[i] = i;
+		}
+
+		mActiveIdx = (mActiveIdx + 1) % NUM_BUFFERS;
+		const UINT8 activeMask = 1 << mActiveIdx;
+
+		// Find the range of objects that need to be written to the active buffer
+		UINT32 minIdx = std::numeric_limits<UINT32>::max();
+		UINT32 maxIdx = 0;
+		for (auto& idx : mDirtyObjects)
+		{
+			if (idx >= numObjects || (mStaleMasks[idx] & activeMask) == 0)
+				continue;
+
+			minIdx = std::min(minIdx, idx);
+			maxIdx = std::max(maxIdx, idx);
+		}
+
+		float* data = nullptr;
+		const SPtr<GpuBuffer>& buffer = mBuffers[mActiveIdx];
+		if (minIdx <= maxIdx)
+		{
+			static constexpr UINT32 ENTRY_BYTES = ENTRY_SIZE * 4 * sizeof(float);
+
+			// The buffer was last used by the GPU NUM_BUFFERS - 1 frames ago, meaning it can be written to without
+			// waiting, while keeping the data of objects that didn't change
+			data = (float*)buffer->lock(minIdx * ENTRY_BYTES, (maxIdx - minIdx + 1) * ENTRY_BYTES,
+				GBL_WRITE_ONLY_NO_OVERWRITE);
+		}
+
+		UINT32 numDirty = 0;
+		for (auto& idx : mDirtyObjects)
+		{
+			// Object was removed
+			if (idx >= numObjects)
+			{
+				mStaleMasks[idx] = 0;
+				continue;
+			}
+
+			if ((mStaleMasks[idx] & activeMask) != 0)
+			{
+				const RendererRenderable* rendererRenderable = renderables[idx];
+				const Renderable* renderable = rendererRenderable->renderable;
+				const Matrix4 worldTransform = renderable->getMatrix();
+				const Matrix4 worldNoScaleTransform = renderable->getMatrixNoScale();
+
+				// Top three rows of each transform, assuming row-major format
+				float* dest = data + (idx - minIdx) * ENTRY_SIZE * 4;
+				memcpy(dest, &worldTransform, 12 * sizeof(float));
+				memcpy(dest + 12, &worldNoScaleTransform, 12 * sizeof(float));
+
+				// Indices are stored as floats, which represent them exactly, so they survive any conversion on load
+				for (UINT32 i = 0; i < (UINT32)RenderableTexture::Count; i++)
+				{
+					const UINT32 textureIdx = rendererRenderable->textureOverrides[i];
+					dest[24 + i] = textureIdx != TextureTable::INVALID_INDEX ? (float)textureIdx : -1.0f;
+				}
+
+				mStaleMasks[idx] &= ~activeMask;
+			}
+
+			if (mStaleMasks[idx] != 0)
+				mDirtyObjects[numDirty++] = idx;
+		}
+
+		mDirtyObjects.resize(numDirty);
+
+		if (data != nullptr)
+			buffer->unlock();
+	}
+}}
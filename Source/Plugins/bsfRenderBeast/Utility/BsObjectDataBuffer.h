@@ -0,0 +1,64 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "CoreThread/BsCoreThread.h"
+
+namespace bs { namespace ct
+{
+	struct RendererRenderable;
+
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/**
+	 * Persistent GPU buffer containing per-object data of all renderables in the scene, indexed by renderable ID. Each
+	 * object is represented by three rows of its world transform, followed by three rows of its world transform without
+	 * scale, followed by the texture table indices of its texture overrides (-1 for slots that aren't overridden).
+	 *
+	 * Only data of objects marked as dirty is written, using a single mapped write per frame. The buffer is replicated
+	 * once per frame in flight, so the GPU can keep reading data of earlier frames while data for the current frame is
+	 * being written.
+	 */
+	class ObjectDataBuffer
+	{
+	public:
+		/** Number of copies of the buffer, used in a round-robin fashion. */
+		static constexpr UINT32 NUM_BUFFERS = CoreThread::NUM_SYNC_BUFFERS + 1;
+
+		/** Number of buffer elements used by a single object. */
+		static constexpr UINT32 ENTRY_SIZE = 7;
+
+		/** Notifies the buffer that data of the object with the specified index changed. */
+		void markDirty(UINT32 idx);
+
+		/**
+		 * Moves on to the next copy of the buffer, and writes the latest data of all objects that changed since that copy
+		 * was last written to. Should be called once per frame.
+		 *
+		 * @param[in]	renderables		Renderables whose data to write, indexed by renderable ID.
+		 */
+		void update(const Vector<RendererRenderable*>& renderables);
+
+		/** Returns the copy of the buffer written to by the latest update() call. */
+		const SPtr<GpuBuffer>& getBuffer() const { return mBuffers[mActiveIdx]; }
+
+	private:
+		/** Objects are allocated in multiples of this value, so the buffers don't need to be resized often. */
+		static constexpr UINT32 CAPACITY_INCREMENT = 1024;
+
+		SPtr<GpuBuffer> mBuffers[NUM_BUFFERS];
+		UINT32 mCapacity = 0;
+		UINT32 mActiveIdx = 0;
+
+		/** One entry per object, containing bits corresponding to buffer copies that contain outdated data. */
+		Vector<UINT8> mStaleMasks;
+
+		/** Indices of objects that have at least one bit set in their stale mask. */
+		Vector<UINT32> mDirtyObjects;
+	};
+
+	/** @} */
+}}
@@ -18,6 +18,8 @@
 #include "Renderer/BsRendererManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -550,7 +552,8 @@ namespace bs
 	};
 
 	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, bool optionalEntry,
-		UINT32& startBindingSlot, SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		UINT32& startBindingSlot, Xsc::Reflection::ReflectionData* reflectionOutput = nullptr, 
+		Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -695,8 +698,8 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (reflectionOutput != nullptr)
+			*reflectionOutput = std::move(reflectionData);
 
 		return output.str();
 	}
@@ -707,12 +710,19 @@ namespace bs
 		return crossCompile(hlsl, type, outputType, false, startBindingSlot);
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflectionData, 
+		Vector<GpuProgramType>& entryPoints)
 	{
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &reflectionData, &entryPoints);
 	}
 
+	struct BSLFXCompiler::PassReflectionData
+	{
+		Xsc::Reflection::ReflectionData reflection;
+		Vector<GpuProgramType> types;
+	};
+
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source,
 		const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages)
 	{
@@ -1669,6 +1679,7 @@ namespace bs
 
 		// Build a list of different variations and re-parse the source using the relevant defines
 		UnorderedSet<String> includeSet;
+		Vector<VariationCompileData> variationData;
 		for (auto& entry : shaderMetaData)
 		{
 			const ShaderMetaData& metaData = entry.second;
@@ -1751,7 +1762,8 @@ namespace bs
 				}
 			}
 
-			// For every variation, re-parse the file with relevant defines
+			// For every variation, re-parse the file with relevant defines. Parsing is done sequentially since it can
+			// trigger import of include files.
 			for (auto& variation : variations)
 			{
 				UnorderedMap<String, String> globalDefines = defines;
@@ -1760,6 +1772,8 @@ namespace bs
 				for (auto& define : variationDefines)
 					globalDefines[define.first] = define.second;
 
+				Timer timer;
+
 				ParseState* variationParseState = parseStateCreate();
 				output = parseFX(variationParseState, source.c_str(), globalDefines);
 
@@ -1778,15 +1792,60 @@ namespace bs
 						rawCode = rawCode->next;
 					}
 
-					output = compileTechniques(variationParseState, entry.second.name, codeBlocks, variation, languages,
-						includeSet, shaderDesc);
+					variationData.push_back(VariationCompileData());
+					VariationCompileData& data = variationData.back();
+					data.variation = variation;
+					data.compileTime.shaderName = entry.second.name;
+					data.compileTime.variation = variation;
+
+					output = parseVariationShaders(variationParseState, entry.second.name, codeBlocks, includeSet, data);
 
 					if (!output.errorMessage.empty())
 						return output;
+
+					data.compileTime.parseTime = timer.getMicroseconds();
 				}
 			}
 		}
 
+		// Reflection and cross-compilation dominate compile time, and don't depend on other variations, so distribute
+		// them over worker threads. Each language of each variation is compiled separately, so a shader with only a few 
+		// variations still gets split up.
+		const auto numVariations = (UINT32)variationData.size();
+		TaskScheduler::instance().parallelFor(numVariations, 1, 
+			[&variationData](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				reflectVariation(variationData[i]);
+		});
+
+		OutputLanguage outputLanguages[(UINT32)OutputLanguage::Count];
+		UINT32 numLanguages = 0;
+
+		if (languages.isSet(ShadingLanguageFlag::HLSL))
+			outputLanguages[numLanguages++] = OutputLanguage::HLSL;
+
+		if (languages.isSet(ShadingLanguageFlag::GLSL))
+			outputLanguages[numLanguages++] = OutputLanguage::GLSL;
+
+		if (languages.isSet(ShadingLanguageFlag::VKSL))
+			outputLanguages[numLanguages++] = OutputLanguage::VKSL;
+
+		TaskScheduler::instance().parallelFor(numVariations * numLanguages, 1, 
+			[&variationData, &outputLanguages, numLanguages](UINT32 start, UINT32 end)
+		{
+			for (UINT32 i = start; i < end; i++)
+				compileVariation(variationData[i / numLanguages], outputLanguages[i % numLanguages]);
+		});
+
+		// Techniques and parameters are registered in variation order, so the output doesn't depend on which task
+		// finished first
+		for (auto& entry : variationData)
+		{
+			createTechniques(entry, shaderDesc);
+			output.variationCompileTimes.push_back(entry.compileTime);
+		}
+
 		// Generate a shader from the parsed techniques
 		for (auto& entry : includeSet)
 			includes.push_back(entry);
@@ -1915,7 +1974,7 @@ namespace bs
 				StringStream subShaderSource;
 				const UnorderedMap<String, String> subShaderDefines = extPointShader.defines.getAll();
 				{
-					Lock fileLock = FileScheduler::getLock(path);
+					FileLock fileLock = FileScheduler::getLock(path);
 
 					SPtr<DataStream> stream = FileSystem::openFile(path);
 					if(stream)
@@ -1949,18 +2008,17 @@ namespace bs
 		return output;
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compileTechniques(ParseState* parseState, const String& name,
-		const Vector<String>& codeBlocks, const ShaderVariation& variation, ShadingLanguageFlags languages,
-		UnorderedSet<String>& includes, SHADER_DESC& shaderDesc)
+	BSLFXCompileResult BSLFXCompiler::parseVariationShaders(ParseState* parseState, const String& name,
+		const Vector<String>& codeBlocks, UnorderedSet<String>& includes, VariationCompileData& output)
 	{
-		BSLFXCompileResult output;
+		BSLFXCompileResult result;
 
 		if (parseState->rootNode == nullptr || parseState->rootNode->type != NT_Root)
 		{
 			parseStateDelete(parseState);
 
-			output.errorMessage = "Root is null or not a shader.";
-			return output;
+			result.errorMessage = "Root is null or not a shader.";
+			return result;
 		}
 
 		Vector<pair<ASTFXNode*, ShaderData>> shaderData;
@@ -2037,7 +2095,7 @@ namespace bs
 				}
 				else
 				{
-					output.errorMessage = "Mixin \"" + includes + "\" cannot be found.";
+					result.errorMessage = "Mixin \"" + includes + "\" cannot be found.";
 					return false;
 				}
 			}
@@ -2057,7 +2115,7 @@ namespace bs
 			{
 				parseStateDelete(parseState);
 				bs_stack_free(mixinWasParsed);
-				return output;
+				return result;
 			}
 
 			parseShader(entry.first, codeBlocks, entry.second);
@@ -2079,50 +2137,76 @@ namespace bs
 
 		parseStateDelete(parseState);
 
-		// Parse extended HLSL code and generate per-program code, also convert to GLSL/VKSL
-		const auto end = (UINT32)shaderData.size();
-		Vector<pair<ASTFXNode*, ShaderData>> outputShaderData;
-		for(UINT32 i = 0; i < end; i++)
+		for (auto& entry : shaderData)
 		{
-			const ShaderMetaData& metaData = shaderData[i].second.metaData;
-			if (metaData.isMixin)
+			ShaderData& data = entry.second;
+			if (data.metaData.isMixin)
 				continue;
 
-			ShaderData& shaderDataEntry = shaderData[i].second;
+			output.shaders.push_back(ShaderCompileData());
+			ShaderCompileData& compileData = output.shaders.back();
+			compileData.source = data;
 
-			ShaderData hlslShaderData = shaderData[i].second;
-			ShaderData glslShaderData = shaderData[i].second;
+			for (auto& language : compileData.languages)
+				language = data;
 
 			// When working with OpenGL, lower-end feature sets are supported. For other backends, high-end is always assumed.
-			CrossCompileOutput glslVersion = CrossCompileOutput::GLSL41;
+			ShaderData& glslShaderData = compileData.languages[(UINT32)OutputLanguage::GLSL];
 			if(glslShaderData.metaData.featureSet == "HighEnd")
-			{
 				glslShaderData.metaData.language = "glsl";
-				glslVersion = CrossCompileOutput::GLSL45;
-			}
 			else
 				glslShaderData.metaData.language = "glsl4_1";
 
-			ShaderData vkslShaderData = shaderData[i].second;
-			vkslShaderData.metaData.language = "vksl";
+			compileData.languages[(UINT32)OutputLanguage::VKSL].metaData.language = "vksl";
+		}
 
-			const auto numPasses = (UINT32)shaderDataEntry.passes.size();
-			for(UINT32 j = 0; j < numPasses; j++)
-			{
-				PassData& passData = shaderDataEntry.passes[j];
+		return result;
+	}
+
+	void BSLFXCompiler::reflectVariation(VariationCompileData& data)
+	{
+		Timer timer;
 
+		for (auto& shader : data.shaders)
+		{
+			for (auto& passData : shader.source.passes)
+			{
 				// Find valid entry points and parameters
 				// Note: XShaderCompiler needs to do a full pass when doing reflection, and for each individual program
 				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
 				// somehow save the AST and then re-use it for multiple actions.
-				Vector<GpuProgramType> types;
-				reflectHLSL(passData.code, shaderDesc, types);
+				SPtr<PassReflectionData> reflection = bs_shared_ptr_new<PassReflectionData>();
+				reflectHLSL(passData.code, reflection->reflection, reflection->types);
+
+				shader.reflection.push_back(reflection);
+			}
+		}
+
+		data.compileTime.reflectionTime = timer.getMicroseconds();
+	}
+
+	void BSLFXCompiler::compileVariation(VariationCompileData& data, OutputLanguage language)
+	{
+		Timer timer;
+
+		for (auto& shader : data.shaders)
+		{
+			ShaderData& languageData = shader.languages[(UINT32)language];
+
+			const auto numPasses = (UINT32)languageData.passes.size();
+			for(UINT32 j = 0; j < numPasses; j++)
+			{
+				const Vector<GpuProgramType>& types = shader.reflection[j]->types;
 
-				if(languages.isSet(ShadingLanguageFlag::GLSL))
+				if(language == OutputLanguage::GLSL)
 				{
-					PassData& glslPassData = glslShaderData.passes[j];
+					PassData& glslPassData = languageData.passes[j];
 					UINT32 glslBinding = 0;
 
+					CrossCompileOutput glslVersion = CrossCompileOutput::GLSL41;
+					if(languageData.metaData.language == "glsl")
+						glslVersion = CrossCompileOutput::GLSL45;
+
 					for (auto& type : types)
 					{
 						switch (type)
@@ -2157,9 +2241,9 @@ namespace bs
 					}
 				}
 
-				if(languages.isSet(ShadingLanguageFlag::VKSL))
+				if(language == OutputLanguage::VKSL)
 				{
-					PassData& vkslPassData = vkslShaderData.passes[j];
+					PassData& vkslPassData = languageData.passes[j];
 					UINT32 vkslBinding = 0;
 
 					for (auto& type : types)
@@ -2196,9 +2280,9 @@ namespace bs
 					}
 				}
 
-				if(languages.isSet(ShadingLanguageFlag::HLSL))
+				if(language == OutputLanguage::HLSL)
 				{
-					PassData& hlslPassData = hlslShaderData.passes[j];
+					PassData& hlslPassData = languageData.passes[j];
 
 					// Clean non-standard HLSL
 					// Note: Ideally we add a full HLSL output module to XShaderCompiler, instead of using simple regex. This
@@ -2243,94 +2327,114 @@ namespace bs
 					}
 				}
 			}
+		}
 
-			outputShaderData.push_back(std::make_pair(nullptr, hlslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, glslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, vkslShaderData));
+		switch(language)
+		{
+		case OutputLanguage::HLSL:
+			data.compileTime.hlslTime = timer.getMicroseconds();
+			break;
+		case OutputLanguage::GLSL:
+			data.compileTime.glslTime = timer.getMicroseconds();
+			break;
+		case OutputLanguage::VKSL:
+			data.compileTime.vkslTime = timer.getMicroseconds();
+			break;
+		default:
+			break;
 		}
+	}
 
-		for(auto& entry : outputShaderData)
+	void BSLFXCompiler::createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc)
+	{
+		for (auto& shader : data.shaders)
 		{
-			const ShaderMetaData& metaData = entry.second.metaData;
-			if (metaData.isMixin)
-				continue;
+			for (auto& reflection : shader.reflection)
+				parseParameters(reflection->reflection, shaderDesc);
+		}
 
-			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+		for (auto& shader : data.shaders)
+		{
+			for (auto& entry : shader.languages)
 			{
-				PASS_DESC passDesc;
-				passDesc.blendStateDesc = passData.blendDesc;
-				passDesc.rasterizerStateDesc = passData.rasterizerDesc;
-				passDesc.depthStencilStateDesc = passData.depthStencilDesc;
+				const ShaderMetaData& metaData = entry.metaData;
 
-				auto createProgram =
-					[](const String& language, const String& entry, const String& code, GpuProgramType type) -> GPU_PROGRAM_DESC
+				Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
+				for (auto& passData : entry.passes)
 				{
-					GPU_PROGRAM_DESC desc;
-					desc.language = language;
-					desc.entryPoint = entry;
-					desc.source = code;
-					desc.type = type;
-
-					return desc;
-				};
+					PASS_DESC passDesc;
+					passDesc.blendStateDesc = passData.blendDesc;
+					passDesc.rasterizerStateDesc = passData.rasterizerDesc;
+					passDesc.depthStencilStateDesc = passData.depthStencilDesc;
 
-				bool isHLSL = metaData.language == "hlsl";
-				passDesc.vertexProgramDesc = createProgram(
-					metaData.language,
-					isHLSL ? "vsmain" : "main",
-					passData.vertexCode,
-					GPT_VERTEX_PROGRAM);
-
-				passDesc.fragmentProgramDesc = createProgram(
-					metaData.language,
-					isHLSL ? "fsmain" : "main",
-					passData.fragmentCode,
-					GPT_FRAGMENT_PROGRAM);
-
-				passDesc.geometryProgramDesc = createProgram(
-					metaData.language,
-					isHLSL ? "gsmain" : "main",
-					passData.geometryCode,
-					GPT_GEOMETRY_PROGRAM);
-
-				passDesc.hullProgramDesc = createProgram(
-					metaData.language,
-					isHLSL ? "hsmain" : "main",
-					passData.hullCode,
-					GPT_HULL_PROGRAM);
-
-				passDesc.domainProgramDesc = createProgram(
-					metaData.language,
-					isHLSL ? "dsmain" : "main",
-					passData.domainCode,
-					GPT_DOMAIN_PROGRAM);
-
-				passDesc.computeProgramDesc = createProgram(
-					metaData.language,
-					isHLSL ? "csmain" : "main",
-					passData.computeCode,
-					GPT_COMPUTE_PROGRAM);
-
-				passDesc.stencilRefValue = passData.stencilRefValue;
-
-				SPtr<Pass> pass = Pass::create(passDesc);
-				if (pass != nullptr)
-					passes[passData.seqIdx] = pass;
-			}
+					auto createProgram =
+						[](const String& language, const String& entry, const String& code, GpuProgramType type) -> GPU_PROGRAM_DESC
+					{
+						GPU_PROGRAM_DESC desc;
+						desc.language = language;
+						desc.entryPoint = entry;
+						desc.source = code;
+						desc.type = type;
+
+						return desc;
+					};
+
+					bool isHLSL = metaData.language == "hlsl";
+					passDesc.vertexProgramDesc = createProgram(
+						metaData.language,
+						isHLSL ? "vsmain" : "main",
+						passData.vertexCode,
+						GPT_VERTEX_PROGRAM);
+
+					passDesc.fragmentProgramDesc = createProgram(
+						metaData.language,
+						isHLSL ? "fsmain" : "main",
+						passData.fragmentCode,
+						GPT_FRAGMENT_PROGRAM);
+
+					passDesc.geometryProgramDesc = createProgram(
+						metaData.language,
+						isHLSL ? "gsmain" : "main",
+						passData.geometryCode,
+						GPT_GEOMETRY_PROGRAM);
+
+					passDesc.hullProgramDesc = createProgram(
+						metaData.language,
+						isHLSL ? "hsmain" : "main",
+						passData.hullCode,
+						GPT_HULL_PROGRAM);
+
+					passDesc.domainProgramDesc = createProgram(
+						metaData.language,
+						isHLSL ? "dsmain" : "main",
+						passData.domainCode,
+						GPT_DOMAIN_PROGRAM);
+
+					passDesc.computeProgramDesc = createProgram(
+						metaData.language,
+						isHLSL ? "csmain" : "main",
+						passData.computeCode,
+						GPT_COMPUTE_PROGRAM);
+
+					passDesc.stencilRefValue = passData.stencilRefValue;
+
+					SPtr<Pass> pass = Pass::create(passDesc);
+					if (pass != nullptr)
+						passes[passData.seqIdx] = pass;
+				}
 
-			Vector<SPtr<Pass>> orderedPasses;
-			for (auto& KVP : passes)
-				orderedPasses.push_back(KVP.second);
+				Vector<SPtr<Pass>> orderedPasses;
+				for (auto& KVP : passes)
+					orderedPasses.push_back(KVP.second);
 
-			if (!orderedPasses.empty())
-			{
-				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, variation, orderedPasses);
-				shaderDesc.techniques.push_back(technique);
+				if (!orderedPasses.empty())
+				{
+					SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, data.variation, 
+						orderedPasses);
+					shaderDesc.techniques.push_back(technique);
+				}
 			}
 		}
-
-		return output;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
@@ -4,6 +4,7 @@
 
 #include "BsSLPrerequisites.h"
 #include "Material/BsShader.h"
+#include "Material/BsShaderVariation.h"
 #include "RenderAPI/BsGpuProgram.h"
 #include "RenderAPI/BsRasterizerState.h"
 #include "RenderAPI/BsDepthStencilState.h"
@@ -20,6 +21,18 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Information about how long it took to compile a single shader variation. */
+	struct BSLFXVariationCompileTime
+	{
+		String shaderName; /**< Name of the shader the variation belongs to. */
+		ShaderVariation variation; /**< Variation that was compiled. */
+		UINT64 parseTime = 0; /**< Time spent parsing the BSL source of the variation, in microseconds. */
+		UINT64 reflectionTime = 0; /**< Time spent finding entry points and parameters, in microseconds. */
+		UINT64 hlslTime = 0; /**< Time spent generating HLSL programs, in microseconds. */
+		UINT64 glslTime = 0; /**< Time spent cross-compiling GLSL programs, in microseconds. */
+		UINT64 vkslTime = 0; /**< Time spent cross-compiling VKSL programs, in microseconds. */
+	};
+
 	/**	Contains the results of compilation returned from the BSLFXCompiler. */
 	struct BSLFXCompileResult
 	{
@@ -28,6 +41,9 @@ namespace bs
 		int errorLine = 0; /**< Line of the error if one occurred. */
 		int errorColumn = 0; /**< Column of the error if one occurred. */
 		String errorFile; /**< File in which the error occurred. Empty if root file. */
+
+		/** Compile times of individual variations of the root shader, in the order their techniques were created in. */
+		Vector<BSLFXVariationCompileTime> variationCompileTimes;
 	};
 
 	/**	Transforms a source file written in BSL FX syntax into a Shader object. */
@@ -97,6 +113,34 @@ namespace bs
 			UINT32 codeBlockIndex;
 		};
 
+		/** Entry points and parameters found in the code of a single pass. */
+		struct PassReflectionData;
+
+		/** Shading languages techniques are generated for, in the order their techniques are output in. */
+		enum class OutputLanguage
+		{
+			HLSL, GLSL, VKSL, Count
+		};
+
+		/** Temporary data for a single shader while its variation is being compiled. */
+		struct ShaderCompileData
+		{
+			ShaderData source;
+			ShaderData languages[(UINT32)OutputLanguage::Count];
+			Vector<SPtr<PassReflectionData>> reflection;
+		};
+
+		/** 
+		 * Temporary data for a single variation during compilation. Parsing is done sequentially, after which the 
+		 * reflection and cross-compilation steps of different variations and languages run in parallel.
+		 */
+		struct VariationCompileData
+		{
+			ShaderVariation variation;
+			Vector<ShaderCompileData> shaders;
+			BSLFXVariationCompileTime compileTime;
+		};
+
 	public:
 		/**	Transforms a source file written in BSL FX syntax into a Shader object. */
 		static BSLFXCompileResult compile(const String& name, const String& source, 
@@ -274,24 +318,36 @@ namespace bs
 			SHADER_DESC& shaderDesc, Vector<String>& includes);
 
 		/**
-		 * Generates a set of techniques for a single variation. Uses AST parse state as input, which must be created using
-		 * the defines of the relevant variation.
+		 * Parses the shaders of a single variation from the AST, ready for reflection and cross-compilation. Uses AST
+		 * parse state as input, which must be created using the defines of the relevant variation. Parse state is deleted
+		 * by this method.
 		 *
-		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using 
+		 * @param[in]	parseState		Parser state object that has previously been initialized with the AST using 
 		 *								parseFX().
 		 * @param[in]	name			Name of the shader to generate the variation for.
 		 * @param[in]	codeBlocks		Blocks containing GPU program source code that are referenced by the AST.
-		 * @param[in]	variation		Shader variation the AST was parsed with.
-		 * @param[in]	languages		Shading languages to generate techniques for. Each shader variation will be
-		 *								compiled into a separate technique for each of the provided languages.
 		 * @param[out]	includes		Set to append newly found includes to.
-		 * @param[out]	shaderDesc		Shader descriptor that resulting techniques, and non-internal parameters will be
-		 *								registered with.
+		 * @param[in, out]	output		Variation data to populate with the parsed shaders.
 		 * @return						A result object containing an error message if not successful.
 		 */
-		static BSLFXCompileResult compileTechniques(ParseState* parseState, const String& name, 
-			const Vector<String>& codeBlocks, const ShaderVariation& variation, ShadingLanguageFlags languages, 
-			UnorderedSet<String>& includes, SHADER_DESC& shaderDesc);
+		static BSLFXCompileResult parseVariationShaders(ParseState* parseState, const String& name, 
+			const Vector<String>& codeBlocks, UnorderedSet<String>& includes, VariationCompileData& output);
+
+		/** Finds the entry points and parameters of every pass of a parsed variation. Thread safe. */
+		static void reflectVariation(VariationCompileData& data);
+
+		/** 
+		 * Generates the per-program code of every pass of a reflected variation, for a single language. Different 
+		 * languages of the same variation can be generated in parallel. 
+		 */
+		static void compileVariation(VariationCompileData& data, OutputLanguage language);
+
+		/** 
+		 * Registers parameters found during reflection of a compiled variation, and generates techniques for every
+		 * shading language. Variations must be processed in the same order every time for the output to be
+		 * deterministic.
+		 */
+		static void createTechniques(const VariationCompileData& data, SHADER_DESC& shaderDesc);
 
 		/**
 		 * Converts a null-terminated string into a standard string, and eliminates quotes that are assumed to be at the 
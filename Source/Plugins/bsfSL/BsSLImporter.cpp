@@ -25,7 +25,7 @@ namespace bs
 	{
 		String source;
 		{
-			Lock fileLock = FileScheduler::getLock(filePath);
+			FileLock fileLock = FileScheduler::getLock(filePath);
 
 			SPtr<DataStream> stream = FileSystem::openFile(filePath);
 			source = stream->getAsString();
@@ -49,6 +49,26 @@ namespace bs
 			LOGERR("Compilation error when importing shader \"" + file + "\":\n" + result.errorMessage + ". Location: " +
 				toString(result.errorLine) + " (" + toString(result.errorColumn) + ")");
 		}
+		else
+		{
+			// Report per-variation compile times, to help find the variations that dominate shader build times
+			for (auto& entry : result.variationCompileTimes)
+			{
+				String variationName;
+				for (auto& define : entry.variation.getDefines().getAll())
+					variationName += " " + define.first + "=" + define.second;
+
+				const UINT64 totalTime = entry.parseTime + entry.reflectionTime + entry.hlslTime + entry.glslTime + 
+					entry.vkslTime;
+
+				LOGDBG_VERBOSE("Compiled variation of shader \"" + entry.shaderName + "\" (" + variationName + " ) in " +
+					toString(totalTime / 1000.0f) + " ms. Parse: " + toString(entry.parseTime / 1000.0f) + 
+					" ms, reflection: " + toString(entry.reflectionTime / 1000.0f) + 
+					" ms, HLSL: " + toString(entry.hlslTime / 1000.0f) + 
+					" ms, GLSL: " + toString(entry.glslTime / 1000.0f) + 
+					" ms, VKSL: " + toString(entry.vkslTime / 1000.0f) + " ms.");
+			}
+		}
 
 		return result.shader;
 	}
@@ -17,6 +17,9 @@
 #include "BsVulkanSwapChain.h"
 #include "BsVulkanTimerQuery.h"
 #include "BsVulkanOcclusionQuery.h"
+#include "BsVulkanDescriptorLayout.h"
+#include "BsVulkanDescriptorPool.h"
+#include "Managers/BsVulkanDescriptorManager.h"
 
 #if BS_PLATFORM == BS_PLATFORM_WIN32
 #include "Win32/BsWin32RenderWindow.h"
@@ -195,6 +198,9 @@ namespace bs { namespace ct
 		UINT32 maxBoundDescriptorSets = device.getDeviceProperties().limits.maxBoundDescriptorSets;
 		mDescriptorSetsTemp = (VkDescriptorSet*)bs_alloc(sizeof(VkDescriptorSet) * maxBoundDescriptorSets);
 
+		UINT32 maxDynamicOffsets = device.getDeviceProperties().limits.maxDescriptorSetUniformBuffersDynamic;
+		mDynamicOffsetsTemp = (UINT32*)bs_alloc(sizeof(UINT32) * std::max(maxDynamicOffsets, 1U));
+
 		VkCommandBufferAllocateInfo cmdBufferAllocInfo;
 		cmdBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		cmdBufferAllocInfo.pNext = nullptr;
@@ -269,6 +275,8 @@ namespace bs { namespace ct
 
 				entry.first->notifyUnbound();
 			}
+
+			releaseDescriptorPools();
 		}
 
 		if (mIntraQueueSemaphore != nullptr)
@@ -284,6 +292,7 @@ namespace bs { namespace ct
 		vkFreeCommandBuffers(device, mPool, 1, &mCmdBuffer);
 
 		bs_free(mDescriptorSetsTemp);
+		bs_free(mDynamicOffsetsTemp);
 	}
 
 	UINT32 VulkanCmdBuffer::getDeviceIdx() const
@@ -340,8 +349,7 @@ namespace bs { namespace ct
 				executeClearPass();
 		}
 
-		executeWriteHazardBarrier();
-		executeLayoutTransitions();
+		executeBarriers();
 
 		RenderSurfaceMask readMask = getFBReadMask();
 
@@ -459,7 +467,10 @@ namespace bs { namespace ct
 			UINT32 currentQueueFamily = resource->getQueueFamily();
 			if (currentQueueFamily != (UINT32)-1 && currentQueueFamily != mQueueFamily)
 			{
-				Vector<VkBufferMemoryBarrier>& barriers = mTransitionInfoTemp[currentQueueFamily].bufferBarriers;
+				TransitionInfo& transitionInfo = mTransitionInfoTemp[currentQueueFamily];
+				transitionInfo.useMask |= resource->getUseInfo(VulkanAccessFlag::Read | VulkanAccessFlag::Write);
+
+				Vector<VkBufferMemoryBarrier>& barriers = transitionInfo.bufferBarriers;
 
 				barriers.push_back(VkBufferMemoryBarrier());
 				VkBufferMemoryBarrier& barrier = barriers.back();
@@ -489,7 +500,10 @@ namespace bs { namespace ct
 			ImageSubresourceInfo* subresourceInfos = &mSubresourceInfoStorage[imageInfo.subresourceInfoIdx];
 			if (queueMismatch)
 			{
-				Vector<VkImageMemoryBarrier>& barriers = mTransitionInfoTemp[currentQueueFamily].imageBarriers;
+				TransitionInfo& transitionInfo = mTransitionInfoTemp[currentQueueFamily];
+				transitionInfo.useMask |= resource->getUseInfo(VulkanAccessFlag::Read | VulkanAccessFlag::Write);
+
+				Vector<VkImageMemoryBarrier>& barriers = transitionInfo.imageBarriers;
 
 				for (UINT32 i = 0; i < imageInfo.numSubresourceInfos; i++)
 				{
@@ -593,7 +607,9 @@ namespace bs { namespace ct
 								 numBufferBarriers, barriers.bufferBarriers.data(),
 								 numImgBarriers, barriers.imageBarriers.data());
 
-			// Find an appropriate queue to execute on
+			// Find an appropriate queue to execute on. The release must happen after the resources are done being used
+			// (e.g. written to by an upload), so prefer the queue they were last used on, as queue submissions execute
+			// in order.
 			UINT32 otherQueueIdx = 0;
 			VulkanQueue* otherQueue = nullptr;
 			GpuQueueType otherQueueType = GQT_GRAPHICS;
@@ -606,7 +622,17 @@ namespace bs { namespace ct
 				UINT32 numQueues = device.getNumQueues(otherQueueType);
 				for (UINT32 j = 0; j < numQueues; j++)
 				{
-					// Try to find a queue not currently executing
+					if ((barriers.useMask & CommandSyncMask::getGlobalQueueMask(otherQueueType, j)) != 0)
+					{
+						otherQueue = device.getQueue(otherQueueType, j);
+						otherQueueIdx = j;
+						break;
+					}
+				}
+
+				// Otherwise try to find a queue not currently executing
+				for (UINT32 j = 0; j < numQueues && otherQueue == nullptr; j++)
+				{
 					VulkanQueue* curQueue = device.getQueue(otherQueueType, j);
 					if (!curQueue->isExecuting())
 					{
@@ -740,6 +766,7 @@ namespace bs { namespace ct
 		{
 			entry.second.imageBarriers.clear();
 			entry.second.bufferBarriers.clear();
+			entry.second.useMask = 0;
 		}
 
 		mGraphicsPipeline = nullptr;
@@ -840,6 +867,49 @@ namespace bs { namespace ct
 		mMemoryBarrierSrcAccess = 0;
 		mMemoryBarrierDstStages = 0;
 		mMemoryBarrierSrcStages = 0;
+
+		// Device is done with the command buffer, so the transient descriptor sets can be released
+		releaseDescriptorPools();
+		mResetCount++;
+	}
+
+	VkDescriptorSet VulkanCmdBuffer::allocateTransientSet(VulkanDescriptorLayout* layout)
+	{
+		VkDescriptorSetLayout setLayout = layout->getHandle();
+
+		VkDescriptorSetAllocateInfo allocateInfo;
+		allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocateInfo.pNext = nullptr;
+		allocateInfo.descriptorSetCount = 1;
+		allocateInfo.pSetLayouts = &setLayout;
+
+		VkDescriptorSet set;
+		if (!mDescriptorPools.empty())
+		{
+			allocateInfo.descriptorPool = mDescriptorPools.back()->getHandle();
+
+			VkResult result = vkAllocateDescriptorSets(mDevice.getLogical(), &allocateInfo, &set);
+			if (result == VK_SUCCESS)
+				return set;
+		}
+
+		// Current pool is full (or there isn't one yet), grab a new one
+		mDescriptorPools.push_back(mDevice.getDescriptorManager().acquireLinearPool());
+		allocateInfo.descriptorPool = mDescriptorPools.back()->getHandle();
+
+		VkResult result = vkAllocateDescriptorSets(mDevice.getLogical(), &allocateInfo, &set);
+		assert(result == VK_SUCCESS);
+
+		return set;
+	}
+
+	void VulkanCmdBuffer::releaseDescriptorPools()
+	{
+		VulkanDescriptorManager& descManager = mDevice.getDescriptorManager();
+		for (auto& entry : mDescriptorPools)
+			descManager.releaseLinearPool(entry);
+
+		mDescriptorPools.clear();
 	}
 
 	void VulkanCmdBuffer::setRenderTarget(const SPtr<RenderTarget>& rt, UINT32 readOnlyFlags, RenderSurfaceMask loadMask)
@@ -1174,6 +1244,7 @@ namespace bs { namespace ct
 		else
 		{
 			mNumBoundDescriptorSets = 0;
+			mNumBoundDynamicOffsets = 0;
 			mBoundParamsDirty = false;
 		}
 
@@ -1429,20 +1500,25 @@ namespace bs { namespace ct
 			if (mBoundParams != nullptr)
 			{
 				mNumBoundDescriptorSets = mBoundParams->getNumSets();
-				mBoundParams->prepareForBind(*this, mDescriptorSetsTemp);
+				mNumBoundDynamicOffsets = mBoundParams->getNumDynamicOffsets();
+				mBoundParams->prepareForBind(*this, mDescriptorSetsTemp, mDynamicOffsetsTemp);
 			}
 			else
+			{
 				mNumBoundDescriptorSets = 0;
+				mNumBoundDynamicOffsets = 0;
+			}
 
 			mBoundParamsDirty = false;
 		}
 		else
 		{
 			mNumBoundDescriptorSets = 0;
+			mNumBoundDynamicOffsets = 0;
 		}
 	}
 
-	void VulkanCmdBuffer::executeLayoutTransitions()
+	void VulkanCmdBuffer::prepareLayoutTransitions()
 	{
 		auto createLayoutTransitionBarrier = [&](VulkanImage* image, ImageInfo& imageInfo)
 		{
@@ -1487,6 +1563,13 @@ namespace bs { namespace ct
 			createLayoutTransitionBarrier(entry.first, imageInfo);
 		}
 
+		mQueuedLayoutTransitions.clear();
+	}
+
+	void VulkanCmdBuffer::executeLayoutTransitions()
+	{
+		prepareLayoutTransitions();
+
 		VkPipelineStageFlags srcStage = 0;
 		VkPipelineStageFlags dstStage = 0;
 		getPipelineStageFlags(mLayoutTransitionBarriersTemp, srcStage, dstStage);
@@ -1501,42 +1584,58 @@ namespace bs { namespace ct
 				(UINT32) mLayoutTransitionBarriersTemp.size(), mLayoutTransitionBarriersTemp.data());
 		}
 
-		mQueuedLayoutTransitions.clear();
 		mLayoutTransitionBarriersTemp.clear();
 	}
 
-	void VulkanCmdBuffer::executeWriteHazardBarrier()
+	void VulkanCmdBuffer::executeBarriers()
 	{
-		if(!mNeedsRAWMemoryBarrier && !mNeedsWARMemoryBarrier)
+		prepareLayoutTransitions();
+
+		const bool needsHazardBarrier = mNeedsRAWMemoryBarrier || mNeedsWARMemoryBarrier;
+		if(!needsHazardBarrier && mLayoutTransitionBarriersTemp.empty())
 			return;
 
-		// If read-after-write we need an actual memory barrier, otherwise we just need an execution dependency
-		if(mNeedsRAWMemoryBarrier)
+		VkPipelineStageFlags srcStage = 0;
+		VkPipelineStageFlags dstStage = 0;
+		if(!mLayoutTransitionBarriersTemp.empty())
 		{
-			VkMemoryBarrier barrier;
-			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-			barrier.pNext = nullptr;
-
-			barrier.srcAccessMask = mMemoryBarrierSrcAccess;
-			barrier.dstAccessMask = mMemoryBarrierDstAccess;
+			// Layout transitions are issued in the same barrier as the hazard memory barrier, so make sure they also wait
+			// on any writes the memory barrier is making available
+			if(mNeedsRAWMemoryBarrier)
+			{
+				for(auto& barrier : mLayoutTransitionBarriersTemp)
+					barrier.srcAccessMask = mMemoryBarrierSrcAccess;
+			}
 
-			vkCmdPipelineBarrier(getHandle(),
-				mMemoryBarrierSrcStages,
-				mMemoryBarrierDstStages,
-				0, 1, &barrier,
-				0, nullptr,
-				0, nullptr);
-		}
-		else
-		{
-			vkCmdPipelineBarrier(getHandle(),
-				mMemoryBarrierSrcStages,
-				mMemoryBarrierDstStages,
-				0, 0, nullptr,
-				0, nullptr,
-				0, nullptr);
+			getPipelineStageFlags(mLayoutTransitionBarriersTemp, srcStage, dstStage);
 		}
 
+		srcStage |= mMemoryBarrierSrcStages;
+		dstStage |= mMemoryBarrierDstStages;
+
+		// If read-after-write we need an actual memory barrier, otherwise we just need an execution dependency
+		VkMemoryBarrier memoryBarrier;
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = mMemoryBarrierSrcAccess;
+		memoryBarrier.dstAccessMask = mMemoryBarrierDstAccess;
+
+		const UINT32 numMemoryBarriers = mNeedsRAWMemoryBarrier ? 1 : 0;
+
+		vkCmdPipelineBarrier(getHandle(),
+			srcStage, dstStage,
+			0, numMemoryBarriers, &memoryBarrier,
+			0, nullptr,
+			(UINT32)mLayoutTransitionBarriersTemp.size(), mLayoutTransitionBarriersTemp.data());
+
+		if(needsHazardBarrier)
+			resetWriteHazards();
+
+		mLayoutTransitionBarriersTemp.clear();
+	}
+
+	void VulkanCmdBuffer::resetWriteHazards()
+	{
 		mNeedsRAWMemoryBarrier = false;
 		mNeedsWARMemoryBarrier = false;
 		mMemoryBarrierSrcStages = 0;
@@ -1591,8 +1690,7 @@ namespace bs { namespace ct
 	{
 		assert(mState == State::Recording);
 
-		executeWriteHazardBarrier();
-		executeLayoutTransitions();
+		executeBarriers();
 
 		VkRenderPassBeginInfo renderPassBeginInfo;
 		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1614,10 +1712,10 @@ namespace bs { namespace ct
 		mClearMask = CLEAR_NONE;
 	}
 
-	void VulkanCmdBuffer::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
+	bool VulkanCmdBuffer::prepareDraw()
 	{
 		if (!isReadyForRender())
-			return;
+			return false;
 
 		// Need to bind gpu params before starting render pass, in order to make sure any layout transitions execute
 		bindGpuParams();
@@ -1634,7 +1732,7 @@ namespace bs { namespace ct
 		if (mGfxPipelineRequiresBind)
 		{
 			if (!bindGraphicsPipeline())
-				return;
+				return false;
 		}
 		else
 			bindDynamicStates(false);
@@ -1647,12 +1745,21 @@ namespace bs { namespace ct
 				VkPipelineLayout pipelineLayout = mGraphicsPipeline->getPipelineLayout(deviceIdx);
 
 				vkCmdBindDescriptorSets(mCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
-										mNumBoundDescriptorSets, mDescriptorSetsTemp, 0, nullptr);
+										mNumBoundDescriptorSets, mDescriptorSetsTemp, mNumBoundDynamicOffsets,
+										mDynamicOffsetsTemp);
 			}
 
 			mDescriptorSetsBindState.unset(DescriptorSetBindFlag::Graphics);
 		}
 
+		return true;
+	}
+
+	void VulkanCmdBuffer::draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount)
+	{
+		if (!prepareDraw())
+			return;
+
 		if (instanceCount <= 0)
 			instanceCount = 1;
 
@@ -1661,53 +1768,54 @@ namespace bs { namespace ct
 
 	void VulkanCmdBuffer::drawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 instanceCount)
 	{
-		if (!isReadyForRender())
+		if (!prepareDraw())
 			return;
 
-		// Need to bind gpu params before starting render pass, in order to make sure any layout transitions execute
-		bindGpuParams();
+		if (instanceCount <= 0)
+			instanceCount = 1;
 
-		if (!isInRenderPass())
-			beginRenderPass();
+		vkCmdDrawIndexed(mCmdBuffer, indexCount, instanceCount, startIndex, vertexOffset, 0);
+	}
 
-		if(mVertexInputsDirty)
-		{
-			bindVertexInputs();
-			mVertexInputsDirty = false;
-		}
+	void VulkanCmdBuffer::drawIndirect(VulkanBuffer* argsBuffer, UINT32 offset, UINT32 drawCount, UINT32 stride)
+	{
+		// Must be registered before the render pass starts, so barriers against previous writes can execute
+		registerBuffer(argsBuffer, BufferUseFlagBits::Indirect, VulkanAccessFlag::Read);
 
-		if (mGfxPipelineRequiresBind)
+		if (!prepareDraw())
+			return;
+
+		if (mDevice.getDeviceFeatures().multiDrawIndirect)
+			vkCmdDrawIndirect(mCmdBuffer, argsBuffer->getHandle(), offset, drawCount, stride);
+		else
 		{
-			if (!bindGraphicsPipeline())
-				return;
+			for (UINT32 i = 0; i < drawCount; i++)
+				vkCmdDrawIndirect(mCmdBuffer, argsBuffer->getHandle(), offset + i * stride, 1, stride);
 		}
-		else
-			bindDynamicStates(false);
+	}
 
-		if (mDescriptorSetsBindState.isSet(DescriptorSetBindFlag::Graphics))
-		{
-			if (mNumBoundDescriptorSets > 0)
-			{
-				UINT32 deviceIdx = mDevice.getIndex();
-				VkPipelineLayout pipelineLayout = mGraphicsPipeline->getPipelineLayout(deviceIdx);
+	void VulkanCmdBuffer::drawIndexedIndirect(VulkanBuffer* argsBuffer, UINT32 offset, UINT32 drawCount,
+		UINT32 stride)
+	{
+		// Must be registered before the render pass starts, so barriers against previous writes can execute
+		registerBuffer(argsBuffer, BufferUseFlagBits::Indirect, VulkanAccessFlag::Read);
 
-				vkCmdBindDescriptorSets(mCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
-										mNumBoundDescriptorSets, mDescriptorSetsTemp, 0, nullptr);
-			}
+		if (!prepareDraw())
+			return;
 
-			mDescriptorSetsBindState.unset(DescriptorSetBindFlag::Graphics);
+		if (mDevice.getDeviceFeatures().multiDrawIndirect)
+			vkCmdDrawIndexedIndirect(mCmdBuffer, argsBuffer->getHandle(), offset, drawCount, stride);
+		else
+		{
+			for (UINT32 i = 0; i < drawCount; i++)
+				vkCmdDrawIndexedIndirect(mCmdBuffer, argsBuffer->getHandle(), offset + i * stride, 1, stride);
 		}
-
-		if (instanceCount <= 0)
-			instanceCount = 1;
-
-		vkCmdDrawIndexed(mCmdBuffer, indexCount, instanceCount, startIndex, vertexOffset, 0);
 	}
 
-	void VulkanCmdBuffer::dispatch(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+	bool VulkanCmdBuffer::prepareDispatch()
 	{
 		if (mComputePipeline == nullptr)
-			return;
+			return false;
 
 		if (isInRenderPass())
 			endRenderPass();
@@ -1718,15 +1826,14 @@ namespace bs { namespace ct
 
 		// Need to bind gpu params before starting render pass, in order to make sure any layout transitions execute
 		bindGpuParams();
-		executeWriteHazardBarrier();
-		executeLayoutTransitions();
+		executeBarriers();
 
 		UINT32 deviceIdx = mDevice.getIndex();
 		if(mCmpPipelineRequiresBind)
 		{
 			VulkanPipeline* pipeline = mComputePipeline->getPipeline(deviceIdx);
 			if (pipeline == nullptr)
-				return;
+				return false;
 
 			registerResource(pipeline, VulkanAccessFlag::Read);
 			mComputePipeline->registerPipelineResources(this);
@@ -1741,14 +1848,18 @@ namespace bs { namespace ct
 			{
 				VkPipelineLayout pipelineLayout = mComputePipeline->getPipelineLayout(deviceIdx);
 				vkCmdBindDescriptorSets(mCmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0,
-										mNumBoundDescriptorSets, mDescriptorSetsTemp, 0, nullptr);
+										mNumBoundDescriptorSets, mDescriptorSetsTemp, mNumBoundDynamicOffsets,
+										mDynamicOffsetsTemp);
 			}
 
 			mDescriptorSetsBindState.unset(DescriptorSetBindFlag::Compute);
 		}
 
-		vkCmdDispatch(mCmdBuffer, numGroupsX, numGroupsY, numGroupsZ);
+		return true;
+	}
 
+	void VulkanCmdBuffer::finishDispatch()
+	{
 		// Remove any shader use flags on images. Note this relies on the fact that we re-bind all parameters on every
 		// dispatch call and render pass, so they can reset this flags. Otherwise clearing the flags is wrong if the
 		// images remain to be used in subsequent calls).
@@ -1763,6 +1874,27 @@ namespace bs { namespace ct
 		mShaderBoundSubresourceInfos.clear();
 	}
 
+	void VulkanCmdBuffer::dispatch(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ)
+	{
+		if (!prepareDispatch())
+			return;
+
+		vkCmdDispatch(mCmdBuffer, numGroupsX, numGroupsY, numGroupsZ);
+		finishDispatch();
+	}
+
+	void VulkanCmdBuffer::dispatchIndirect(VulkanBuffer* argsBuffer, UINT32 offset)
+	{
+		// Must be registered before the barriers execute, in case the arguments were written by a previous dispatch
+		registerBuffer(argsBuffer, BufferUseFlagBits::Indirect, VulkanAccessFlag::Read);
+
+		if (!prepareDispatch())
+			return;
+
+		vkCmdDispatchIndirect(mCmdBuffer, argsBuffer->getHandle(), offset);
+		finishDispatch();
+	}
+
 	void VulkanCmdBuffer::setEvent(VulkanEvent* event)
 	{
 		if(isInRenderPass())
@@ -2188,6 +2320,9 @@ namespace bs { namespace ct
 		case BufferUseFlagBits::Vertex: 
 			stages = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
 			break;
+		case BufferUseFlagBits::Indirect:
+			stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+			break;
 		case BufferUseFlagBits::Transfer:
 			stages = 0;
 
@@ -2258,6 +2393,9 @@ namespace bs { namespace ct
 						case BufferUseFlagBits::Parameter:
 							mMemoryBarrierDstAccess |= VK_ACCESS_UNIFORM_READ_BIT;
 							break;
+						case BufferUseFlagBits::Indirect:
+							mMemoryBarrierDstAccess |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+							break;
 						case BufferUseFlagBits::Transfer:
 							if (access.isSet(VulkanAccessFlag::Read))
 								mMemoryBarrierDstAccess |= VK_ACCESS_TRANSFER_READ_BIT;
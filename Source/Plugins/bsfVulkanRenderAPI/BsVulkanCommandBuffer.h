@@ -100,7 +100,8 @@ namespace bs { namespace ct
 		Index = 1 << 1,
 		Vertex = 1 << 2,
 		Parameter = 1 << 3,
-		Transfer = 1 << 4
+		Transfer = 1 << 4,
+		Indirect = 1 << 5
 	};
 
 	typedef Flags<BufferUseFlagBits> BufferUseFlags;
@@ -331,6 +332,24 @@ namespace bs { namespace ct
 		/** Executes a dispatch command using the currently bound compute pipeline. */
 		void dispatch(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ);
 
+		/**
+		 * Executes one or multiple draw commands using the currently bound graphics pipeline, vertex buffer and render
+		 * target, reading the draw arguments from the provided buffer.
+		 */
+		void drawIndirect(VulkanBuffer* argsBuffer, UINT32 offset, UINT32 drawCount, UINT32 stride);
+
+		/**
+		 * Executes one or multiple draw commands using the currently bound graphics pipeline, index & vertex buffer and
+		 * render target, reading the draw arguments from the provided buffer.
+		 */
+		void drawIndexedIndirect(VulkanBuffer* argsBuffer, UINT32 offset, UINT32 drawCount, UINT32 stride);
+
+		/**
+		 * Executes a dispatch command using the currently bound compute pipeline, reading the number of groups from the
+		 * provided buffer.
+		 */
+		void dispatchIndirect(VulkanBuffer* argsBuffer, UINT32 offset);
+
 		/** 
 		 * Registers a command that signals the event when executed. Will be delayed until the end of the current
 		 * render pass, if any.
@@ -371,6 +390,19 @@ namespace bs { namespace ct
 		 */
 		VkImageLayout getCurrentLayout(VulkanImage* image, const VkImageSubresourceRange& range, bool inRenderPass);
 
+		/**
+		 * Allocates a descriptor set that remains valid until the command buffer is reset. Sets are allocated linearly
+		 * from pools owned by the command buffer, and are all released at once when the command buffer is done
+		 * executing.
+		 */
+		VkDescriptorSet allocateTransientSet(VulkanDescriptorLayout* layout);
+
+		/** 
+		 * Returns the number of times the command buffer was reset. Sets allocated through allocateTransientSet() are
+		 * only valid as long as this value doesn't change.
+		 */
+		UINT32 getResetCount() const { return mResetCount; }
+
 	private:
 		friend class VulkanCmdBufferPool;
 		friend class VulkanCommandBuffer;
@@ -500,6 +532,21 @@ namespace bs { namespace ct
 		/** Binds the currently stored GPU parameters object, if dirty. */
 		void bindGpuParams();
 
+		/**
+		 * Starts a render pass if needed and binds all state required for a draw call. Returns false if the draw call
+		 * cannot be executed.
+		 */
+		bool prepareDraw();
+
+		/**
+		 * Ends the current render pass and binds all state required for a dispatch call. Returns false if the dispatch
+		 * call cannot be executed.
+		 */
+		bool prepareDispatch();
+
+		/** Resets the shader use of images bound during a dispatch call. Must be called after the dispatch command. */
+		void finishDispatch();
+
 		/** Clears the specified area of the currently bound render target. */
 		void clearViewport(const Rect2I& area, UINT32 buffers, const Color& color, float depth, UINT16 stencil, 
 			UINT8 targetMask);
@@ -510,8 +557,17 @@ namespace bs { namespace ct
 		/** Executes any queued layout transitions by issuing a pipeline barrier. */
 		void executeLayoutTransitions();
 
-		/** Executes any queued memory barriers. */
-		void executeWriteHazardBarrier();
+		/** Executes any queued memory barriers and layout transitions, batched into a single pipeline barrier. */
+		void executeBarriers();
+
+		/** 
+		 * Creates image memory barriers for all queued layout transitions and places them in 
+		 * mLayoutTransitionBarriersTemp. Clears the queue.
+		 */
+		void prepareLayoutTransitions();
+
+		/** Clears the queued memory barrier, as well as any write hazards it resolved. */
+		void resetWriteHazards();
 
 		/** 
 		 * Updates final layouts for images used by the current framebuffer, reflecting layout changes performed by render
@@ -566,6 +622,9 @@ namespace bs { namespace ct
 		/** Returns the read mask for the current framebuffer. */
 		RenderSurfaceMask getFBReadMask();
 
+		/** Returns the pools used for allocating transient descriptor sets back to the descriptor manager. */
+		void releaseDescriptorPools();
+
 		UINT32 mId;
 		UINT32 mQueueFamily;
 		State mState = State::Ready;
@@ -610,6 +669,7 @@ namespace bs { namespace ct
 		UINT32 mStencilRef = 0;
 		DrawOperationType mDrawOp = DOT_TRIANGLE_LIST;
 		UINT32 mNumBoundDescriptorSets = 0;
+		UINT32 mNumBoundDynamicOffsets = 0;
 		bool mGfxPipelineRequiresBind : 1;
 		bool mCmpPipelineRequiresBind : 1;
 		bool mViewportRequiresBind : 1;
@@ -628,12 +688,16 @@ namespace bs { namespace ct
 		VkBuffer mVertexBuffersTemp[BS_MAX_BOUND_VERTEX_BUFFERS] { };
 		VkDeviceSize mVertexBufferOffsetsTemp[BS_MAX_BOUND_VERTEX_BUFFERS] { };
 		VkDescriptorSet* mDescriptorSetsTemp;
+		UINT32* mDynamicOffsetsTemp;
 		UnorderedMap<UINT32, TransitionInfo> mTransitionInfoTemp;
 		Vector<VkImageMemoryBarrier> mLayoutTransitionBarriersTemp;
 		UnorderedMap<VulkanImage*, UINT32> mQueuedLayoutTransitions;
 		Vector<VulkanEvent*> mQueuedEvents;
 		Vector<VulkanQuery*> mQueuedQueryResets;
 		UnorderedSet<VulkanSwapChain*> mActiveSwapChains;
+
+		Vector<VulkanDescriptorPool*> mDescriptorPools;
+		UINT32 mResetCount = 0;
 	};
 
 	/** CommandBuffer implementation for Vulkan. */
@@ -6,15 +6,15 @@
 namespace bs { namespace ct
 {
 	VulkanDescriptorLayout::VulkanDescriptorLayout(VulkanDevice& device, VkDescriptorSetLayoutBinding* bindings, 
-		UINT32 numBindings)
+		UINT32 numBindings, VkDescriptorSetLayoutCreateFlags flags, const void* next)
 		:mDevice(device)
 	{
 		mHash = calculateHash(bindings, numBindings);
 
 		VkDescriptorSetLayoutCreateInfo layoutCI;
 		layoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		layoutCI.pNext = nullptr;
-		layoutCI.flags = 0;
+		layoutCI.pNext = next;
+		layoutCI.flags = flags;
 		layoutCI.bindingCount = numBindings;
 		layoutCI.pBindings = bindings;
 
@@ -14,7 +14,15 @@ namespace bs { namespace ct
 	class VulkanDescriptorLayout
 	{
 	public:
-		VulkanDescriptorLayout(VulkanDevice& device, VkDescriptorSetLayoutBinding* bindings, UINT32 numBindings);
+		/**
+		 * @param[in]	device		Device to create the layout on.
+		 * @param[in]	bindings	Bindings the layout consists of.
+		 * @param[in]	numBindings	Number of entries in @p bindings.
+		 * @param[in]	flags		Flags to create the layout with.
+		 * @param[in]	next		Optional extension structure chained to the layout create info.
+		 */
+		VulkanDescriptorLayout(VulkanDevice& device, VkDescriptorSetLayoutBinding* bindings, UINT32 numBindings,
+			VkDescriptorSetLayoutCreateFlags flags = 0, const void* next = nullptr);
 		~VulkanDescriptorLayout();
 
 		/** Returns a handle to the Vulkan set layout object. */
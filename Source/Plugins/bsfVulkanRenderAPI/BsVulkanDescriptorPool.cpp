@@ -5,33 +5,38 @@
 
 namespace bs { namespace ct
 {
-	VulkanDescriptorPool::VulkanDescriptorPool(VulkanDevice& device)
+	VulkanDescriptorPool::VulkanDescriptorPool(VulkanDevice& device, bool linear)
 		:mDevice(device)
 	{
-		VkDescriptorPoolSize poolSizes[6];
+		const UINT32 divider = linear ? sLinearPoolDivider : 1;
+
+		VkDescriptorPoolSize poolSizes[7];
 		poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		poolSizes[0].descriptorCount = sMaxSampledImages;
+		poolSizes[0].descriptorCount = sMaxSampledImages / divider;
 
 		poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		poolSizes[1].descriptorCount = sMaxUniformBuffers;
+		poolSizes[1].descriptorCount = sMaxUniformBuffers / divider;
 
 		poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-		poolSizes[2].descriptorCount = sMaxImages;
+		poolSizes[2].descriptorCount = sMaxImages / divider;
 
 		poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
-		poolSizes[3].descriptorCount = sMaxSampledBuffers;
+		poolSizes[3].descriptorCount = sMaxSampledBuffers / divider;
 
 		poolSizes[4].type = VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
-		poolSizes[4].descriptorCount = sMaxBuffers;
+		poolSizes[4].descriptorCount = sMaxBuffers / divider;
 
 		poolSizes[5].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-		poolSizes[5].descriptorCount = sMaxBuffers;
+		poolSizes[5].descriptorCount = sMaxBuffers / divider;
+
+		poolSizes[6].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		poolSizes[6].descriptorCount = sMaxUniformBuffers / divider;
 
 		VkDescriptorPoolCreateInfo poolCI;
 		poolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		poolCI.pNext = nullptr;
-		poolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-		poolCI.maxSets = sMaxSets;
+		poolCI.flags = linear ? 0 : VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		poolCI.maxSets = sMaxSets / divider;
 		poolCI.poolSizeCount = sizeof(poolSizes)/sizeof(poolSizes[0]);
 		poolCI.pPoolSizes = poolSizes;
 
@@ -43,4 +48,10 @@ namespace bs { namespace ct
 	{
 		vkDestroyDescriptorPool(mDevice.getLogical(), mPool, gVulkanAllocator);
 	}
+
+	void VulkanDescriptorPool::reset()
+	{
+		VkResult result = vkResetDescriptorPool(mDevice.getLogical(), mPool, 0);
+		assert(result == VK_SUCCESS);
+	}
 }}
\ No newline at end of file
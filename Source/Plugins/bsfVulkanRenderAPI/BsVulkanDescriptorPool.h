@@ -14,12 +14,21 @@ namespace bs { namespace ct
 	class VulkanDescriptorPool
 	{
 	public:
-		VulkanDescriptorPool(VulkanDevice& device);
+		/**
+		 * @param[in]	device	Device to create the pool on.
+		 * @param[in]	linear	If true the pool is meant for transient sets. Such sets cannot be freed individually,
+		 *						and are instead all released at once by calling reset(). Linear pools are also smaller
+		 *						than the default ones.
+		 */
+		VulkanDescriptorPool(VulkanDevice& device, bool linear = false);
 		~VulkanDescriptorPool();
 
 		/** Returns a handle to the internal Vulkan descriptor pool. */
 		VkDescriptorPool getHandle() const { return mPool; }
 
+		/** Releases all descriptor sets allocated from the pool. Caller must ensure none of the sets are in use. */
+		void reset();
+
 	private:
 		static const UINT32 sMaxSets = 8192;
 		static const UINT32 sMaxSampledImages = 4096;
@@ -28,6 +37,9 @@ namespace bs { namespace ct
 		static const UINT32 sMaxBuffers = 2048;
 		static const UINT32 sMaxUniformBuffers = 2048;
 
+		/** Amount by which are the limits above divided for linear pools. */
+		static const UINT32 sLinearPoolDivider = 8;
+
 		VulkanDevice& mDevice;
 		VkDescriptorPool mPool;
 	};
@@ -2,17 +2,22 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsVulkanDescriptorSet.h"
 #include "BsVulkanDevice.h"
+#include "Profiling/BsRenderStats.h"
 
 namespace bs { namespace ct
 {
 	VulkanDescriptorSet::VulkanDescriptorSet(VulkanResourceManager* owner, VkDescriptorSet set, VkDescriptorPool pool)
 		:VulkanResource(owner, true), mSet(set), mPool(pool)
-	{ }
+	{
+		BS_INC_RENDER_STAT_CAT(ResCreated, RenderStatObject_DescriptorSet);
+	}
 
 	VulkanDescriptorSet::~VulkanDescriptorSet()
 	{
 		VkResult result = vkFreeDescriptorSets(mOwner->getDevice().getLogical(), mPool, 1, &mSet);
 		assert(result == VK_SUCCESS);
+
+		BS_INC_RENDER_STAT_CAT(ResDestroyed, RenderStatObject_DescriptorSet);
 	}
 
 	void VulkanDescriptorSet::write(VkWriteDescriptorSet* entries, UINT32 count)
@@ -21,5 +26,7 @@ namespace bs { namespace ct
 			entries[i].dstSet = mSet;
 
 		vkUpdateDescriptorSets(mOwner->getDevice().getLogical(), count, entries, 0, nullptr);
+
+		BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_DescriptorSet);
 	}
 }}
\ No newline at end of file
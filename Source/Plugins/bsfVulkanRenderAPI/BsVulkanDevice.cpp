@@ -5,6 +5,12 @@
 #include "BsVulkanCommandBuffer.h"
 #include "Managers/BsVulkanDescriptorManager.h"
 #include "Managers/BsVulkanQueryManager.h"
+#include "BsVulkanRingBuffer.h"
+#include "BsVulkanTextureTable.h"
+#include "BsVulkanRenderAPI.h"
+#include "Renderer/BsTextureTable.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 #define VMA_IMPLEMENTATION
 #include "ThirdParty/vk_mem_alloc.h"
@@ -81,7 +87,7 @@ namespace bs { namespace ct
 		}
 
 		// Set up extensions
-		const char* extensions[5];
+		const char* extensions[7];
 		uint32_t numExtensions = 0;
 
 		extensions[numExtensions++] = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
@@ -91,6 +97,8 @@ namespace bs { namespace ct
 		// Enumerate supported extensions
 		bool dedicatedAllocExt = false;
 		bool getMemReqExt = false;
+		bool descriptorIndexingExt = false;
+		bool maintenance3Ext = false;
 
 		uint32_t numAvailableExtensions = 0;
 		vkEnumerateDeviceExtensionProperties(device, nullptr, &numAvailableExtensions, nullptr);
@@ -112,12 +120,75 @@ namespace bs { namespace ct
 						getMemReqExt = true;
 					}
 				}
+
+				for (auto& entry : availableExtensions)
+				{
+					if (strcmp(entry.extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+						descriptorIndexingExt = true;
+					else if (strcmp(entry.extensionName, VK_KHR_MAINTENANCE3_EXTENSION_NAME) == 0)
+						maintenance3Ext = true;
+				}
 			}
 		}
 
+		// Descriptor indexing is only used by the texture table, so it's only enabled if everything the table relies on
+		// is supported
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures = {};
+		descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+		if (descriptorIndexingExt && maintenance3Ext && vkGetPhysicalDeviceFeatures2KHR != nullptr &&
+			vkGetPhysicalDeviceProperties2KHR != nullptr)
+		{
+			VkPhysicalDeviceFeatures2KHR features;
+			features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+			features.pNext = &descriptorIndexingFeatures;
+			vkGetPhysicalDeviceFeatures2KHR(device, &features);
+
+			VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProps = {};
+			descriptorIndexingProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+			VkPhysicalDeviceProperties2KHR props;
+			props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+			props.pNext = &descriptorIndexingProps;
+			vkGetPhysicalDeviceProperties2KHR(device, &props);
+
+			// Pipeline layouts containing the table count all of their descriptors against the update-after-bind
+			// limits, so leave room for the regular descriptors as well
+			const VkPhysicalDeviceLimits& limits = mDeviceProperties.limits;
+			const UINT32 requiredSamplers =
+				TextureTable::MAX_INDEXED_TEXTURES + limits.maxPerStageDescriptorSamplers;
+			const UINT32 requiredImages =
+				TextureTable::MAX_INDEXED_TEXTURES + limits.maxPerStageDescriptorSampledImages;
+
+			mSupportsDescriptorIndexing =
+				descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+				descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+				descriptorIndexingFeatures.descriptorBindingPartiallyBound &&
+				descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+				descriptorIndexingProps.maxPerStageDescriptorUpdateAfterBindSamplers >= requiredSamplers &&
+				descriptorIndexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages >= requiredImages &&
+				descriptorIndexingProps.maxDescriptorSetUpdateAfterBindUniformBuffersDynamic >=
+					limits.maxDescriptorSetUniformBuffersDynamic;
+		}
+
+		// Only enable the features the texture table uses
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT enabledDescriptorIndexingFeatures = {};
+		enabledDescriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+		if (mSupportsDescriptorIndexing)
+		{
+			extensions[numExtensions++] = VK_KHR_MAINTENANCE3_EXTENSION_NAME;
+			extensions[numExtensions++] = VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME;
+
+			enabledDescriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			enabledDescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			enabledDescriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+			enabledDescriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		}
+
 		VkDeviceCreateInfo deviceInfo;
 		deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-		deviceInfo.pNext = nullptr;
+		deviceInfo.pNext = mSupportsDescriptorIndexing ? &enabledDescriptorIndexingFeatures : nullptr;
 		deviceInfo.flags = 0;
 		deviceInfo.queueCreateInfoCount = (uint32_t)queueCreateInfos.size();
 		deviceInfo.pQueueCreateInfos = queueCreateInfos.data();
@@ -159,6 +230,16 @@ namespace bs { namespace ct
 		mQueryPool = bs_new<VulkanQueryPool>(*this);
 		mDescriptorManager = bs_new<VulkanDescriptorManager>(*this);
 		mResourceManager = bs_new<VulkanResourceManager>(*this);
+
+		const UINT32 uniformAlignment = (UINT32)mDeviceProperties.limits.minUniformBufferOffsetAlignment;
+		mUniformRingBuffer = bs_new<VulkanRingBuffer>(*this, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 256 * 1024,
+			uniformAlignment, 16);
+		mStagingRingBuffer = bs_new<VulkanRingBuffer>(*this, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 8 * 1024 * 1024, 4, 4);
+
+		if (mSupportsDescriptorIndexing)
+			mTextureTable = bs_new<VulkanTextureTable>(*this);
+
+		createPipelineCache();
 	}
 
 	VulkanDevice::~VulkanDevice()
@@ -176,17 +257,144 @@ namespace bs { namespace ct
 			}
 		}
 
-		bs_delete(mDescriptorManager);
 		bs_delete(mQueryPool);
 		bs_delete(mCommandBufferPool);
 
+		if (mTextureTable != nullptr)
+			bs_delete(mTextureTable);
+
+		// Needs to happen after command buffer pool shutdown, as command buffers return their descriptor pools to it
+		bs_delete(mDescriptorManager);
+
+		// Needs to happen after command buffer pool shutdown, as command buffers keep the ring buffers bound
+		bs_delete(mUniformRingBuffer);
+		bs_delete(mStagingRingBuffer);
+
 		// Needs to happen after query pool & command buffer pool shutdown, to ensure their resources are destroyed
 		bs_delete(mResourceManager);
 		
+		savePipelineCache();
+		vkDestroyPipelineCache(mLogicalDevice, mPipelineCache, gVulkanAllocator);
+
 		vmaDestroyAllocator(mAllocator);
 		vkDestroyDevice(mLogicalDevice, gVulkanAllocator);
 	}
 
+	void VulkanDevice::createPipelineCache()
+	{
+		// Header written by the driver at the start of the cache data, as per spec 9.6
+		struct PipelineCacheHeader
+		{
+			uint32_t headerSize;
+			uint32_t headerVersion;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+		};
+
+		// Some drivers don't handle data from other devices gracefully, so make sure the saved data is compatible before
+		// providing it to the driver
+		SPtr<MemoryDataStream> cacheData;
+
+		const Path cachePath = getPipelineCachePath();
+		if (FileSystem::isFile(cachePath))
+		{
+			SPtr<DataStream> fileStream = FileSystem::openFile(cachePath);
+			if (fileStream)
+			{
+				cacheData = bs_shared_ptr_new<MemoryDataStream>(*fileStream);
+				fileStream->close();
+
+				PipelineCacheHeader header;
+				bool valid = cacheData->size() >= sizeof(header);
+				if (valid)
+				{
+					memcpy(&header, cacheData->getPtr(), sizeof(header));
+
+					valid = header.headerSize >= sizeof(header) &&
+						header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+						header.vendorID == mDeviceProperties.vendorID &&
+						header.deviceID == mDeviceProperties.deviceID &&
+						memcmp(header.pipelineCacheUUID, mDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+				}
+
+				if (!valid)
+					cacheData = nullptr;
+			}
+		}
+
+		VkPipelineCacheCreateInfo cacheCI;
+		cacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		cacheCI.pNext = nullptr;
+		cacheCI.flags = 0;
+		cacheCI.initialDataSize = cacheData ? cacheData->size() : 0;
+		cacheCI.pInitialData = cacheData ? cacheData->getPtr() : nullptr;
+
+		VkResult result = vkCreatePipelineCache(mLogicalDevice, &cacheCI, gVulkanAllocator, &mPipelineCache);
+		if (result != VK_SUCCESS && cacheData)
+		{
+			// Data might have been rejected, start with an empty cache instead
+			cacheCI.initialDataSize = 0;
+			cacheCI.pInitialData = nullptr;
+
+			result = vkCreatePipelineCache(mLogicalDevice, &cacheCI, gVulkanAllocator, &mPipelineCache);
+		}
+
+		if (result != VK_SUCCESS)
+			mPipelineCache = VK_NULL_HANDLE;
+	}
+
+	void VulkanDevice::savePipelineCache() const
+	{
+		if (mPipelineCache == VK_NULL_HANDLE)
+			return;
+
+		size_t dataSize = 0;
+		VkResult result = vkGetPipelineCacheData(mLogicalDevice, mPipelineCache, &dataSize, nullptr);
+		if (result != VK_SUCCESS || dataSize == 0)
+			return;
+
+		UINT8* data = (UINT8*)bs_alloc(dataSize);
+		result = vkGetPipelineCacheData(mLogicalDevice, mPipelineCache, &dataSize, data);
+
+		if (result == VK_SUCCESS)
+		{
+			const Path cachePath = getPipelineCachePath();
+
+			const Path parentDir = cachePath.getDirectory();
+			if (!FileSystem::exists(parentDir))
+				FileSystem::createDir(parentDir);
+
+			SPtr<DataStream> fileStream = FileSystem::createAndOpenFile(cachePath);
+			if (fileStream)
+			{
+				fileStream->write(data, dataSize);
+				fileStream->close();
+			}
+		}
+
+		bs_free(data);
+	}
+
+	Path VulkanDevice::getPipelineCachePath() const
+	{
+		// Driver updates change the cache UUID, in which case a new file is used
+		String uuid;
+		for (UINT32 i = 0; i < VK_UUID_SIZE; i++)
+		{
+			char hex[3];
+			snprintf(hex, sizeof(hex), "%02x", mDeviceProperties.pipelineCacheUUID[i]);
+			uuid += hex;
+		}
+
+		Path path = FileSystem::getWorkingDirectoryPath();
+		path.append("Cache/");
+		path.setFilename("VulkanPipelines_" + toString(mDeviceProperties.vendorID) + "_" + 
+			toString(mDeviceProperties.deviceID) + "_" + uuid + ".cache");
+
+		return path;
+	}
+
 	void VulkanDevice::waitIdle()
 	{
 		VkResult result = vkDeviceWaitIdle(mLogicalDevice);
@@ -337,11 +545,14 @@ namespace bs { namespace ct
 		return allocation;
 	}
 
-	VmaAllocation VulkanDevice::allocateMemory(VkBuffer buffer, VkMemoryPropertyFlags flags)
+	VmaAllocation VulkanDevice::allocateMemory(VkBuffer buffer, VkMemoryPropertyFlags flags, bool dedicated)
 	{
 		VmaAllocationCreateInfo allocCI = {};
 		allocCI.requiredFlags = flags;
 
+		if (dedicated)
+			allocCI.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
 		VmaAllocationInfo allocInfo;
 		VmaAllocation memory;
 		VkResult result = vmaAllocateMemoryForBuffer(mAllocator, buffer, &allocCI, &memory, &allocInfo);
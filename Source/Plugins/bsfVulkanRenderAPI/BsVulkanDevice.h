@@ -90,6 +90,39 @@ namespace bs { namespace ct
 		/** Returns a manager that can be used for allocating Vulkan objects wrapped as managed resources. */
 		VulkanResourceManager& getResourceManager() const { return *mResourceManager; }
 
+		/** Returns a buffer that frequently updated GPU parameter blocks can be sub-allocated from. */
+		VulkanRingBuffer& getUniformRingBuffer() const { return *mUniformRingBuffer; }
+
+		/** 
+		 * Returns a buffer that staging memory for CPU to GPU transfers can be sub-allocated from. Meant for transfers
+		 * that don't need to read back the current contents of the destination resource.
+		 */
+		VulkanRingBuffer& getStagingRingBuffer() const { return *mStagingRingBuffer; }
+
+		/** 
+		 * Checks if the device supports the descriptor indexing features required by the texture table, in which case
+		 * getTextureTable() is available.
+		 */
+		bool supportsDescriptorIndexing() const { return mSupportsDescriptorIndexing; }
+
+		/** 
+		 * Returns the descriptor set holding the textures of the global TextureTable. Null if the device doesn't
+		 * support descriptor indexing.
+		 */
+		VulkanTextureTable* getTextureTable() const { return mTextureTable; }
+
+		/** 
+		 * Returns the pipeline cache to use when creating pipelines on this device. The cache is loaded from disk on
+		 * device creation, and saved on device destruction. Vulkan pipeline caches are internally synchronized.
+		 */
+		VkPipelineCache getPipelineCache() const { return mPipelineCache; }
+
+		/** 
+		 * Writes the current contents of the pipeline cache to disk, so pipelines compiled so far don't need to be
+		 * compiled again in later sessions.
+		 */
+		void savePipelineCache() const;
+
 		/** 
 		 * Allocates memory for the provided image, and binds it to the image. Returns null if it cannot find memory
 		 * with the specified flags.
@@ -98,9 +131,10 @@ namespace bs { namespace ct
 
 		/** 
 		 * Allocates memory for the provided buffer, and binds it to the buffer. Returns null if it cannot find memory
-		 * with the specified flags.
+		 * with the specified flags. If @p dedicated is true the buffer gets its own memory block, which is required
+		 * if the memory is to be kept mapped.
 		 */
-		VmaAllocation allocateMemory(VkBuffer buffer, VkMemoryPropertyFlags flags);
+		VmaAllocation allocateMemory(VkBuffer buffer, VkMemoryPropertyFlags flags, bool dedicated = false);
 
 		/** Frees a previously allocated block of memory. */
 		void freeMemory(VmaAllocation allocation);
@@ -120,6 +154,15 @@ namespace bs { namespace ct
 		/** Changes the index of the device in the global device list. */
 		void setIndex(UINT32 index) { mDeviceIdx = index; }
 
+		/** 
+		 * Creates the pipeline cache, populating it with data saved from a previous session if it exists and is
+		 * compatible with this device.
+		 */
+		void createPipelineCache();
+
+		/** Returns the path the pipeline cache is saved to. Unique for each physical device and driver version. */
+		Path getPipelineCachePath() const;
+
 		VkPhysicalDevice mPhysicalDevice;
 		VkDevice mLogicalDevice;
 		bool mIsPrimary;
@@ -129,11 +172,16 @@ namespace bs { namespace ct
 		VulkanQueryPool* mQueryPool;
 		VulkanDescriptorManager* mDescriptorManager;
 		VulkanResourceManager* mResourceManager;
+		VulkanRingBuffer* mUniformRingBuffer;
+		VulkanRingBuffer* mStagingRingBuffer;
+		VulkanTextureTable* mTextureTable = nullptr;
 		VmaAllocator mAllocator;
+		VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
 
 		VkPhysicalDeviceProperties mDeviceProperties;
 		VkPhysicalDeviceFeatures mDeviceFeatures;
 		VkPhysicalDeviceMemoryProperties mMemoryProperties;
+		bool mSupportsDescriptorIndexing = false;
 
 		/** Contains data about a set of queues of a specific type. */
 		struct QueueInfo
@@ -52,6 +52,8 @@ namespace bs { namespace ct
 			VulkanHardwareBuffer::BufferType bufferType;
 			if (props.getType() == GBT_STRUCTURED)
 				bufferType = VulkanHardwareBuffer::BT_STRUCTURED;
+			else if (props.getType() == GBT_INDIRECTARGUMENT)
+				bufferType = VulkanHardwareBuffer::BT_INDIRECT;
 			else
 				bufferType = VulkanHardwareBuffer::BT_GENERIC;
 
@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsVulkanGpuParamBlockBuffer.h"
 #include "BsVulkanHardwareBuffer.h"
+#include "BsVulkanRenderAPI.h"
+#include "BsVulkanDevice.h"
 #include "Profiling/BsRenderStats.h"
 
 namespace bs { namespace ct
@@ -12,6 +14,13 @@ namespace bs { namespace ct
 
 	VulkanGpuParamBlockBuffer::~VulkanGpuParamBlockBuffer()
 	{
+		VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
+		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
+		{
+			if (mAllocations[i].buffer != nullptr)
+				rapi._getDevice(i)->getUniformRingBuffer().free(mAllocations[i]);
+		}
+
 		if(mBuffer != nullptr)
 			bs_pool_delete(static_cast<VulkanHardwareBuffer*>(mBuffer));
 	}
@@ -23,8 +32,44 @@ namespace bs { namespace ct
 		GpuParamBlockBuffer::initialize();
 	}
 
+	void VulkanGpuParamBlockBuffer::writeToGPU(const UINT8* data, UINT32 queueIdx)
+	{
+		// Only sub-allocate buffers that were written to before, as they're likely to be updated often. Buffers written
+		// to only once stay in their own buffer and don't prevent the ring buffer memory from being reused.
+		const bool useRingBuffer = (mUsage & GBU_DYNAMIC) != 0 && mNumWrites > 0 &&
+			mSize <= MAX_RING_BUFFER_SIZE;
+
+		mNumWrites++;
+
+		if (!useRingBuffer)
+		{
+			GpuParamBlockBuffer::writeToGPU(data, queueIdx);
+			return;
+		}
+
+		VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
+		VulkanHardwareBuffer* buffer = static_cast<VulkanHardwareBuffer*>(mBuffer);
+		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
+		{
+			if (buffer->getResource(i) == nullptr)
+				continue;
+
+			// Previous allocation stays intact until the GPU is done with it, so no synchronization is needed
+			VulkanRingBuffer& ringBuffer = rapi._getDevice(i)->getUniformRingBuffer();
+			ringBuffer.free(mAllocations[i]);
+
+			mAllocations[i] = ringBuffer.allocate(mSize);
+			memcpy(mAllocations[i].data, data, mSize);
+		}
+
+		BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_GpuParamBuffer, mSize);
+	}
+
 	VulkanBuffer* VulkanGpuParamBlockBuffer::getResource(UINT32 deviceIdx) const
 	{
+		if (mAllocations[deviceIdx].buffer != nullptr)
+			return mAllocations[deviceIdx].buffer;
+
 		return static_cast<VulkanHardwareBuffer*>(mBuffer)->getResource(deviceIdx);
 	}
 }}
\ No newline at end of file
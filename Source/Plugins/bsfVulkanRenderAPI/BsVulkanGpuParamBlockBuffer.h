@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BsVulkanPrerequisites.h"
+#include "BsVulkanRingBuffer.h"
 #include "RenderAPI/BsGpuParamBlockBuffer.h"
 
 namespace bs { namespace ct
@@ -11,24 +12,39 @@ namespace bs { namespace ct
 	 *  @{
 	 */
 
-	/**	Vulkan implementation of a parameter block buffer (uniform buffer in Vulkan lingo). */
+	/**
+	 * Vulkan implementation of a parameter block buffer (uniform buffer in Vulkan lingo). Dynamic buffers that get
+	 * written to more than once are sub-allocated from the device's uniform ring buffer on each write, and are meant
+	 * to be bound using dynamic offsets.
+	 */
 	class VulkanGpuParamBlockBuffer : public GpuParamBlockBuffer
 	{
 	public:
+		/** Maximum size of a buffer that can be sub-allocated from the uniform ring buffer, in bytes. */
+		static constexpr UINT32 MAX_RING_BUFFER_SIZE = 16 * 1024;
+
 		VulkanGpuParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask);
 		~VulkanGpuParamBlockBuffer();
 
+		/** @copydoc GpuParamBlockBuffer::writeToGPU */
+		void writeToGPU(const UINT8* data, UINT32 queueIdx = 0) override;
+
 		/** 
-		 * Gets the resource wrapping the buffer object, on the specified device. If GPU param block buffer's device mask
-		 * doesn't include the provided device, null is returned. 
+		 * Gets the resource wrapping the buffer object containing the latest data, on the specified device. If GPU
+		 * param block buffer's device mask doesn't include the provided device, null is returned. 
 		 */
 		VulkanBuffer* getResource(UINT32 deviceIdx) const;
+
+		/** Returns the offset of the latest data in the buffer returned by getResource(), in bytes. */
+		UINT32 getOffset(UINT32 deviceIdx) const { return mAllocations[deviceIdx].offset; }
 	protected:
 		/** @copydoc GpuParamBlockBuffer::initialize */
 		void initialize() override;
 
 	private:
 		GpuDeviceFlags mDeviceMask;
+		VulkanRingBuffer::Allocation mAllocations[BS_MAX_DEVICES];
+		UINT32 mNumWrites = 0;
 	};
 
 	/** @} */
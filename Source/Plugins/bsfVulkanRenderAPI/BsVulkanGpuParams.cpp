@@ -13,6 +13,7 @@
 #include "BsVulkanSamplerState.h"
 #include "BsVulkanGpuPipelineParamInfo.h"
 #include "BsVulkanCommandBuffer.h"
+#include "BsVulkanTextureTable.h"
 #include "Managers/BsVulkanTextureManager.h"
 #include "Managers/BsVulkanHardwareBufferManager.h"
 #include "RenderAPI/BsGpuParamDesc.h"
@@ -29,18 +30,20 @@ namespace bs { namespace ct
 	{
 		Lock lock(mMutex);
 
+		VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
+
 		UINT32 numSets = mParamInfo->getNumSets();
 		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
 		{
 			if (mPerDeviceData[i].perSetData == nullptr)
 				continue;
 
+			VulkanDescriptorManager& descManager = rapi._getDevice(i)->getDescriptorManager();
 			for (UINT32 j = 0; j < numSets; j++)
 			{
-				for (auto& entry : mPerDeviceData[i].perSetData[j].sets)
-					entry->destroy();
-
-				mPerDeviceData[i].perSetData[j].sets.~Vector<VulkanDescriptorSet*>();
+				VulkanDescriptorSet* set = mPerDeviceData[i].perSetData[j].latestSet;
+				if (set != nullptr)
+					descManager.releaseCachedSet(set);
 			}
 		}
 	}
@@ -78,6 +81,8 @@ namespace bs { namespace ct
 			.reserve<PerSetData>(numSets * numDevices)
 			.reserve<VkWriteDescriptorSet>(numBindings * numDevices)
 			.reserve<WriteInfo>(numBindings * numDevices)
+			.reserve<UINT64>(numBindings * 2 * numDevices)
+			.reserve<UINT32>(numBindings * numDevices)
 			.reserve<VkImage>(numTextures * numDevices)
 			.reserve<VkImage>(numStorageTextures * numDevices)
 			.reserve<VkBuffer>(numParamBlocks * numDevices)
@@ -87,8 +92,10 @@ namespace bs { namespace ct
 
 		Lock lock(mMutex); // Set write operations need to be thread safe
 
+		// Descriptor sets are only acquired once the parameters are first bound
 		mSetsDirty = mAlloc.alloc<bool>(numSets);
-		bs_zero_out(mSetsDirty, numSets);
+		for (UINT32 i = 0; i < numSets; i++)
+			mSetsDirty[i] = true;
 
 		VulkanSamplerState* defaultSampler = static_cast<VulkanSamplerState*>(SamplerState::getDefault().get());
 		VulkanTextureManager& vkTexManager = static_cast<VulkanTextureManager&>(TextureManager::instance());
@@ -117,7 +124,6 @@ namespace bs { namespace ct
 			bs_zero_out(mPerDeviceData[i].buffers, numBuffers);
 			bs_zero_out(mPerDeviceData[i].samplers, numSamplers);
 
-			VulkanDescriptorManager& descManager = devices[i]->getDescriptorManager();
 			VulkanSampler* vkDefaultSampler = defaultSampler->getResource(i);
 
 			for (UINT32 j = 0; j < numSets; j++)
@@ -125,15 +131,21 @@ namespace bs { namespace ct
 				UINT32 numBindingsPerSet = vkParamInfo.getNumBindings(j);
 
 				PerSetData& perSetData = mPerDeviceData[i].perSetData[j];
-				new (&perSetData.sets) Vector<VulkanDescriptorSet*>();
+				perSetData.latestSet = nullptr;
+				perSetData.latestHandle = VK_NULL_HANDLE;
+				perSetData.transientOwnerId = (UINT32)-1;
+				perSetData.transientResetCount = 0;
 
 				perSetData.writeSetInfos = mAlloc.alloc<VkWriteDescriptorSet>(numBindingsPerSet);
 				perSetData.writeInfos = mAlloc.alloc<WriteInfo>(numBindingsPerSet);
-
-				VulkanDescriptorLayout* layout = vkParamInfo.getLayout(i, j);
+				perSetData.resourceIds = mAlloc.alloc<UINT64>(numBindingsPerSet * 2);
+				perSetData.dynamicOffsets = mAlloc.alloc<UINT32>(numBindingsPerSet);
 				perSetData.numElements = numBindingsPerSet;
-				perSetData.latestSet = descManager.createSet(layout);
-				perSetData.sets.push_back(perSetData.latestSet);
+
+				// Write infos are used as descriptor set cache keys, so any padding must be zeroed out
+				bs_zero_out(perSetData.writeInfos, numBindingsPerSet);
+				bs_zero_out(perSetData.resourceIds, numBindingsPerSet * 2);
+				bs_zero_out(perSetData.dynamicOffsets, numBindingsPerSet);
 
 				VkDescriptorSetLayoutBinding* perSetBindings = vkParamInfo.getBindings(j);
 				GpuParamObjectType* types = vkParamInfo.getLayoutTypes(j);
@@ -160,6 +172,7 @@ namespace bs { namespace ct
 
 						VkDescriptorImageInfo& imageInfo = perSetData.writeInfos[k].image;
 						imageInfo.sampler = vkDefaultSampler->getHandle();
+						perSetData.resourceIds[k * 2 + 1] = vkDefaultSampler->getId();
 						
 						if(isLoadStore)
 						{
@@ -178,8 +191,10 @@ namespace bs { namespace ct
 					}
 					else
 					{
-						bool useView = writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && 
-							writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+						bool isUniform = writeSetInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+							writeSetInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+
+						bool useView = !isUniform && writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 
 						if (!useView)
 						{
@@ -187,7 +202,7 @@ namespace bs { namespace ct
 							bufferInfo.offset = 0;
 							bufferInfo.range = VK_WHOLE_SIZE;
 
-							if(writeSetInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+							if(isUniform)
 								bufferInfo.buffer = vkBufManager.getDummyUniformBuffer(i);
 							else
 								bufferInfo.buffer = vkBufManager.getDummyStructuredBuffer(i);
@@ -255,7 +270,13 @@ namespace bs { namespace ct
 			{
 				VkBuffer buffer = bufferRes->getHandle();
 
-				perSetData.writeInfos[bindingIdx].buffer.buffer = buffer;
+				// Range needs to be explicit, since the buffer might be a part of a larger ring buffer
+				VkDescriptorBufferInfo& bufferInfo = perSetData.writeInfos[bindingIdx].buffer;
+				bufferInfo.buffer = buffer;
+				bufferInfo.range = paramBlockBuffer->getSize();
+				setBufferOffset(perSetData, bindingIdx, vulkanParamBlockBuffer->getOffset(i));
+
+				perSetData.resourceIds[bindingIdx * 2] = bufferRes->getId();
 				mPerDeviceData[i].uniformBuffers[sequentialIdx] = buffer;
 			}
 			else
@@ -263,7 +284,12 @@ namespace bs { namespace ct
 				VulkanHardwareBufferManager& vkBufManager = static_cast<VulkanHardwareBufferManager&>(
 					HardwareBufferManager::instance());
 
-				perSetData.writeInfos[bindingIdx].buffer.buffer = vkBufManager.getDummyUniformBuffer(i);
+				VkDescriptorBufferInfo& bufferInfo = perSetData.writeInfos[bindingIdx].buffer;
+				bufferInfo.buffer = vkBufManager.getDummyUniformBuffer(i);
+				bufferInfo.range = VK_WHOLE_SIZE;
+				setBufferOffset(perSetData, bindingIdx, 0);
+
+				perSetData.resourceIds[bindingIdx * 2] = 0;
 				mPerDeviceData[i].uniformBuffers[sequentialIdx] = VK_NULL_HANDLE;
 			}
 		}
@@ -313,6 +339,7 @@ namespace bs { namespace ct
 					actualSurface.numFaces = texProps.getNumFaces();
 
 				perSetData.writeInfos[bindingIdx].image.imageView = imageRes->getView(actualSurface, false);
+				perSetData.resourceIds[bindingIdx * 2] = imageRes->getId();
 				mPerDeviceData[i].sampledImages[sequentialIdx] = imageRes->getHandle();
 			}
 			else
@@ -324,6 +351,7 @@ namespace bs { namespace ct
 				GpuParamObjectType type = types[bindingIdx];
 
 				perSetData.writeInfos[bindingIdx].image.imageView = vkTexManager.getDummyImageView(type, i);
+				perSetData.resourceIds[bindingIdx * 2] = 0;
 				mPerDeviceData[i].sampledImages[sequentialIdx] = VK_NULL_HANDLE;
 			}
 		}
@@ -365,6 +393,7 @@ namespace bs { namespace ct
 			if (imageRes != nullptr)
 			{
 				perSetData.writeInfos[bindingIdx].image.imageView = imageRes->getView(surface, false);
+				perSetData.resourceIds[bindingIdx * 2] = imageRes->getId();
 				mPerDeviceData[i].storageImages[sequentialIdx] = imageRes->getHandle();
 			}
 			else
@@ -376,6 +405,7 @@ namespace bs { namespace ct
 				GpuParamObjectType type = types[bindingIdx];
 
 				perSetData.writeInfos[bindingIdx].image.imageView = vkTexManager.getDummyImageView(type, i);
+				perSetData.resourceIds[bindingIdx * 2] = 0;
 				mPerDeviceData[i].storageImages[sequentialIdx] = VK_NULL_HANDLE;
 			}
 		}
@@ -415,6 +445,7 @@ namespace bs { namespace ct
 
 			PerSetData& perSetData = mPerDeviceData[i].perSetData[set];
 			VkWriteDescriptorSet& writeSetInfo = perSetData.writeSetInfos[bindingIdx];
+			perSetData.resourceIds[bindingIdx * 2] = bufferRes != nullptr ? bufferRes->getId() : 0;
 
 			bool useView = writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 			if (useView)
@@ -503,6 +534,7 @@ namespace bs { namespace ct
 				VkSampler vkSampler = samplerRes->getHandle();
 
 				perSetData.writeInfos[bindingIdx].image.sampler = vkSampler;
+				perSetData.resourceIds[bindingIdx * 2 + 1] = samplerRes->getId();
 				mPerDeviceData[i].samplers[sequentialIdx] = vkSampler;
 			}
 			else
@@ -510,8 +542,10 @@ namespace bs { namespace ct
 				VulkanSamplerState* defaultSampler = 
 					static_cast<VulkanSamplerState*>(SamplerState::getDefault().get());
 
-				VkSampler vkSampler = defaultSampler->getResource(i)->getHandle();;
+				VulkanSampler* defaultSamplerRes = defaultSampler->getResource(i);
+				VkSampler vkSampler = defaultSamplerRes->getHandle();
 				perSetData.writeInfos[bindingIdx].image.sampler = vkSampler;
+				perSetData.resourceIds[bindingIdx * 2 + 1] = defaultSamplerRes->getId();
 
 				mPerDeviceData[i].samplers[sequentialIdx] = 0;
 			}
@@ -525,7 +559,29 @@ namespace bs { namespace ct
 		return mParamInfo->getNumSets();
 	}
 
-	void VulkanGpuParams::prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets)
+	UINT32 VulkanGpuParams::getNumDynamicOffsets() const
+	{
+		return static_cast<VulkanGpuPipelineParamInfo&>(*mParamInfo).getNumDynamicOffsets();
+	}
+
+	bool VulkanGpuParams::setBufferOffset(PerSetData& perSetData, UINT32 bindingIdx, UINT32 offset)
+	{
+		// Dynamic buffers receive their offset when bound, while others need to have it written in the descriptor
+		if (perSetData.writeSetInfos[bindingIdx].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+		{
+			perSetData.dynamicOffsets[bindingIdx] = offset;
+			return false;
+		}
+
+		VkDescriptorBufferInfo& bufferInfo = perSetData.writeInfos[bindingIdx].buffer;
+		if (bufferInfo.offset == offset)
+			return false;
+
+		bufferInfo.offset = offset;
+		return true;
+	}
+
+	void VulkanGpuParams::prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets, UINT32* dynamicOffsets)
 	{
 		UINT32 deviceIdx = buffer.getDeviceIdx();
 
@@ -572,14 +628,24 @@ namespace bs { namespace ct
 			// Check if internal resource changed from what was previously bound in the descriptor set
 			assert(perDeviceData.uniformBuffers[i] != VK_NULL_HANDLE);
 
+			// Note: Handles are compared along with resource identifiers, since handles can be reused after destruction
+			PerSetData& perSetData = perDeviceData.perSetData[set];
+			UINT64& resourceId = perSetData.resourceIds[bindingIdx * 2];
+
 			VkBuffer vkBuffer = resource->getHandle();
-			if(perDeviceData.uniformBuffers[i] != vkBuffer)
+			if(perDeviceData.uniformBuffers[i] != vkBuffer || resourceId != resource->getId())
 			{
 				perDeviceData.uniformBuffers[i] = vkBuffer;
-				perDeviceData.perSetData[set].writeInfos[bindingIdx].buffer.buffer = vkBuffer;
+				perSetData.writeInfos[bindingIdx].buffer.buffer = vkBuffer;
+				resourceId = resource->getId();
 
 				mSetsDirty[set] = true;
 			}
+
+			// Updates of blocks sub-allocated from a ring buffer only change the offset, which doesn't require a new
+			// set if the binding is dynamic
+			if (setBufferOffset(perSetData, bindingIdx, element->getOffset(deviceIdx)))
+				mSetsDirty[set] = true;
 		}
 
 		for (UINT32 i = 0; i < numBuffers; i++)
@@ -610,12 +676,15 @@ namespace bs { namespace ct
 			// Check if internal resource changed from what was previously bound in the descriptor set
 			assert(perDeviceData.buffers[i] != VK_NULL_HANDLE);
 
+			PerSetData& perSetData = perDeviceData.perSetData[set];
+			UINT64& resourceId = perSetData.resourceIds[bindingIdx * 2];
+
 			VkBuffer vkBuffer = resource->getHandle();
-			if (perDeviceData.buffers[i] != vkBuffer)
+			if (perDeviceData.buffers[i] != vkBuffer || resourceId != resource->getId())
 			{
 				perDeviceData.buffers[i] = vkBuffer;
+				resourceId = resource->getId();
 
-				PerSetData& perSetData = perDeviceData.perSetData[set];
 				VkWriteDescriptorSet& writeSetInfo = perSetData.writeSetInfos[bindingIdx];
 
 				bool useView = writeSetInfo.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
@@ -650,16 +719,19 @@ namespace bs { namespace ct
 			// Check if internal resource changed from what was previously bound in the descriptor set
 			assert(perDeviceData.samplers[i] != VK_NULL_HANDLE);
 
+			UINT32 set, slot;
+			mParamInfo->getBinding(GpuPipelineParamInfo::ParamType::SamplerState, i, set, slot);
+
+			UINT32 bindingIdx = vkParamInfo.getBindingIdx(set, slot);
+			PerSetData& perSetData = perDeviceData.perSetData[set];
+			UINT64& resourceId = perSetData.resourceIds[bindingIdx * 2 + 1];
+
 			VkSampler vkSampler = resource->getHandle();
-			if (perDeviceData.samplers[i] != vkSampler)
+			if (perDeviceData.samplers[i] != vkSampler || resourceId != resource->getId())
 			{
 				perDeviceData.samplers[i] = vkSampler;
-
-				UINT32 set, slot;
-				mParamInfo->getBinding(GpuPipelineParamInfo::ParamType::SamplerState, i, set, slot);
-
-				UINT32 bindingIdx = vkParamInfo.getBindingIdx(set, slot);
-				perDeviceData.perSetData[set].writeInfos[bindingIdx].image.sampler = vkSampler;
+				perSetData.writeInfos[bindingIdx].image.sampler = vkSampler;
+				resourceId = resource->getId();
 
 				mSetsDirty[set] = true;
 			}
@@ -692,12 +764,15 @@ namespace bs { namespace ct
 			// Check if internal resource changed from what was previously bound in the descriptor set
 			assert(perDeviceData.storageImages[i] != VK_NULL_HANDLE);
 
+			PerSetData& perSetData = perDeviceData.perSetData[set];
+			UINT64& resourceId = perSetData.resourceIds[bindingIdx * 2];
+
 			VkImage vkImage = resource->getHandle();
-			if (perDeviceData.storageImages[i] != vkImage)
+			if (perDeviceData.storageImages[i] != vkImage || resourceId != resource->getId())
 			{
 				perDeviceData.storageImages[i] = vkImage;
-
-				perDeviceData.perSetData[set].writeInfos[bindingIdx].image.imageView = resource->getView(surface, false);;
+				perSetData.writeInfos[bindingIdx].image.imageView = resource->getView(surface, false);
+				resourceId = resource->getId();
 
 				mSetsDirty[set] = true;
 			}
@@ -741,13 +816,16 @@ namespace bs { namespace ct
 			// Check if internal resource changed from what was previously bound in the descriptor set
 			assert(perDeviceData.sampledImages[i] != VK_NULL_HANDLE);
 
-			VkDescriptorImageInfo& imgInfo = perDeviceData.perSetData[set].writeInfos[bindingIdx].image;
+			PerSetData& perSetData = perDeviceData.perSetData[set];
+			VkDescriptorImageInfo& imgInfo = perSetData.writeInfos[bindingIdx].image;
+			UINT64& resourceId = perSetData.resourceIds[bindingIdx * 2];
 
 			VkImage vkImage = resource->getHandle();
-			if (perDeviceData.sampledImages[i] != vkImage)
+			if (perDeviceData.sampledImages[i] != vkImage || resourceId != resource->getId())
 			{
 				perDeviceData.sampledImages[i] = vkImage;
 				imgInfo.imageView = resource->getView(surface, false);
+				resourceId = resource->getId();
 
 				mSetsDirty[set] = true;
 			}
@@ -759,55 +837,102 @@ namespace bs { namespace ct
 			}
 		}
 
-		// Acquire sets as needed, and updated their contents if dirty
+		// Acquire sets as needed, either from the cache of immutable sets, or as transient sets allocated on the
+		// command buffer
 		VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
 		VulkanDevice& device = *rapi._getDevice(deviceIdx);
 		VulkanDescriptorManager& descManager = device.getDescriptorManager();
+		const UINT32 textureTableSet = vkParamInfo.getTextureTableSet();
 
 		for (UINT32 i = 0; i < numSets; i++)
 		{
+			// Shared by all parameter objects, see below
+			if (i == textureTableSet)
+				continue;
+
 			PerSetData& perSetData = perDeviceData.perSetData[i];
 
-			if (!mSetsDirty[i]) // Set not dirty, just use the last one we wrote (this is fine even across multiple command buffers)
+			// If not dirty, just use the last set. Cached sets are never written to so this is fine even across
+			// multiple command buffers, but transient sets are only valid on the command buffer that allocated them.
+			bool isValid = !mSetsDirty[i];
+			if (isValid && perSetData.latestSet == nullptr)
+			{
+				isValid = perSetData.transientOwnerId == buffer.getId() &&
+					perSetData.transientResetCount == buffer.getResetCount();
+			}
+
+			if (isValid)
 				continue;
 
-			// Set is dirty, we need to update
-			//// Use latest unless already used, otherwise try to find an unused one
-			if(perSetData.latestSet->isBound()) // Checking this is okay, because it's only modified below when we call registerResource, which is under the same lock as this
+			if (perSetData.latestSet != nullptr)
 			{
+				descManager.releaseCachedSet(perSetData.latestSet);
 				perSetData.latestSet = nullptr;
+			}
 
-				for(auto& entry : perSetData.sets)
-				{
-					if(!entry->isBound())
-					{
-						perSetData.latestSet = entry;
-						break;
-					}
-				}
+			VulkanDescriptorLayout* layout = vkParamInfo.getLayout(deviceIdx, i);
 
-				// Cannot find an empty set, allocate a new one
-				if (perSetData.latestSet == nullptr)
-				{
-					VulkanDescriptorLayout* layout = vkParamInfo.getLayout(deviceIdx, i);
-					perSetData.latestSet = descManager.createSet(layout);
-					perSetData.sets.push_back(perSetData.latestSet);
-				}
+			// Key the cache with the descriptor contents, along with identifiers of the resources they reference, since
+			// handles of destroyed resources can be reused by new ones
+			UINT32 numContents = perSetData.numElements * KEY_ENTRIES_PER_BINDING;
+			UINT64* contents = bs_stack_alloc<UINT64>(numContents);
+			for (UINT32 j = 0; j < perSetData.numElements; j++)
+			{
+				UINT64* bindingContents = &contents[j * KEY_ENTRIES_PER_BINDING];
+				memcpy(bindingContents, &perSetData.writeInfos[j], sizeof(WriteInfo));
+
+				bindingContents[KEY_ENTRIES_PER_BINDING - 2] = perSetData.resourceIds[j * 2 + 0];
+				bindingContents[KEY_ENTRIES_PER_BINDING - 1] = perSetData.resourceIds[j * 2 + 1];
 			}
 
-			// Note: Currently I write to the entire set at once, but it might be beneficial to remember only the exact
-			// entries that were updated, and only write to them individually.
-			perSetData.latestSet->write(perSetData.writeSetInfos, perSetData.numElements);
+			VulkanDescriptorSetKey key(layout, contents, numContents);
+			perSetData.latestSet = descManager.getCachedSet(key, perSetData.writeSetInfos, perSetData.numElements);
+
+			bs_stack_free(contents);
+
+			if (perSetData.latestSet != nullptr)
+				perSetData.latestHandle = perSetData.latestSet->getHandle();
+			else
+			{
+				// Contents not used often enough to be cached, write them to a set that lives only as long as the
+				// command buffer
+				perSetData.latestHandle = buffer.allocateTransientSet(layout);
+				perSetData.transientOwnerId = buffer.getId();
+				perSetData.transientResetCount = buffer.getResetCount();
+
+				for (UINT32 j = 0; j < perSetData.numElements; j++)
+					perSetData.writeSetInfos[j].dstSet = perSetData.latestHandle;
+
+				vkUpdateDescriptorSets(device.getLogical(), perSetData.numElements, perSetData.writeSetInfos, 0,
+					nullptr);
+			}
 
 			mSetsDirty[i] = false;
 		}
 
+		UINT32 numDynamicOffsets = 0;
 		for (UINT32 i = 0; i < numSets; i++)
 		{
-			VulkanDescriptorSet* set = perDeviceData.perSetData[i].latestSet;
+			if (i == textureTableSet)
+			{
+				sets[i] = device.getTextureTable()->prepareForBind(buffer);
+				continue;
+			}
+
+			PerSetData& perSetData = perDeviceData.perSetData[i];
+
+			if (perSetData.latestSet != nullptr)
+				buffer.registerResource(perSetData.latestSet, VulkanAccessFlag::Read);
 
-			buffer.registerResource(set, VulkanAccessFlag::Read);
-			sets[i] = set->getHandle();
+			sets[i] = perSetData.latestHandle;
+
+			for (UINT32 j = 0; j < perSetData.numElements; j++)
+			{
+				if (perSetData.writeSetInfos[j].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+					dynamicOffsets[numDynamicOffsets++] = perSetData.dynamicOffsets[j];
+			}
 		}
+
+		assert(numDynamicOffsets == vkParamInfo.getNumDynamicOffsets());
 	}
 }}
\ No newline at end of file
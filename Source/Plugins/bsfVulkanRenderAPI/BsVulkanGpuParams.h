@@ -38,6 +38,9 @@ namespace bs { namespace ct
 		/** Returns the total number of descriptor sets used by this object. */
 		UINT32 getNumSets() const;
 
+		/** Returns the total number of dynamic offsets that need to be provided when binding the descriptor sets. */
+		UINT32 getNumDynamicOffsets() const;
+
 		/** 
 		 * Prepares the internal descriptor sets for a bind operation on the provided command buffer. It generates and/or
 		 * updates and descriptor sets, and registers the relevant resources with the command buffer.
@@ -45,13 +48,16 @@ namespace bs { namespace ct
 		 * Caller must perform external locking if some other thread could write to this object while it is being bound. 
 		 * The same applies to any resources held by this object.
 		 * 
-		 * @param[in]	buffer	Buffer on which the parameters will be bound to.
-		 * @param[out]	sets	Pre-allocated buffer in which the descriptor set handled will be written. Must be of
-		 *						getNumSets() size.
+		 * @param[in]	buffer			Buffer on which the parameters will be bound to.
+		 * @param[out]	sets			Pre-allocated buffer in which the descriptor set handled will be written. Must
+		 *								be of getNumSets() size.
+		 * @param[out]	dynamicOffsets	Pre-allocated buffer in which the offsets of dynamic uniform buffers will be
+		 *								written, in the order expected when binding the sets. Must be of
+		 *								getNumDynamicOffsets() size.
 		 * 
 		 * @note	Thread safe.
 		 */
-		void prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets);
+		void prepareForBind(VulkanCmdBuffer& buffer, VkDescriptorSet* sets, UINT32* dynamicOffsets);
 
 	protected:
 		/** Contains data about writing to either buffer or a texture descriptor. */
@@ -65,12 +71,26 @@ namespace bs { namespace ct
 		/** All GPU param data related to a single descriptor set. */
 		struct PerSetData
 		{
+			/** Set from the descriptor manager's cache, or null if the latest set is transient. */
 			VulkanDescriptorSet* latestSet;
-			Vector<VulkanDescriptorSet*> sets;
+			VkDescriptorSet latestHandle;
+
+			/** Command buffer the latest transient set was allocated from, and its reset count at that time. */
+			UINT32 transientOwnerId;
+			UINT32 transientResetCount;
 
 			VkWriteDescriptorSet* writeSetInfos;
 			WriteInfo* writeInfos;
 
+			/** 
+			 * Unique identifiers of the resources referenced by each binding. Contains two entries per binding, one for
+			 * the image or buffer, and one for the sampler. Zero if the binding references a dummy resource.
+			 */
+			UINT64* resourceIds;
+
+			/** Offsets to bind dynamic uniform buffers with, one per binding. Unused for other binding types. */
+			UINT32* dynamicOffsets;
+
 			UINT32 numElements;
 		};
 
@@ -93,6 +113,16 @@ namespace bs { namespace ct
 		/** @copydoc GpuParams::initialize */
 		void initialize() override;
 
+		/** 
+		 * Assigns the offset of the buffer bound at the specified binding. Returns true if the descriptor contents
+		 * changed as a result, in which case the set needs to be updated.
+		 */
+		bool setBufferOffset(PerSetData& perSetData, UINT32 bindingIdx, UINT32 offset);
+
+		/** Number of 64-bit values describing the contents of a single binding, in a descriptor set cache key. */
+		static constexpr UINT32 KEY_ENTRIES_PER_BINDING = sizeof(WriteInfo) / sizeof(UINT64) + 2;
+		static_assert(sizeof(WriteInfo) % sizeof(UINT64) == 0, "Write info must be representable as 64-bit values.");
+
 		PerDeviceData mPerDeviceData[BS_MAX_DEVICES];
 		GpuDeviceFlags mDeviceMask;
 		bool* mSetsDirty;
@@ -4,6 +4,8 @@
 #include "BsVulkanUtility.h"
 #include "BsVulkanRenderAPI.h"
 #include "BsVulkanDevice.h"
+#include "BsVulkanTextureTable.h"
+#include "Renderer/BsTextureTable.h"
 #include "RenderAPI/BsGpuParamDesc.h"
 
 namespace bs { namespace ct
@@ -149,6 +151,16 @@ namespace bs { namespace ct
 			setUpBindings(paramDesc->loadStoreTextures, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
 			//setUpBindings(paramDesc->samplers, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
 
+			auto iterFind = paramDesc->textures.find(VulkanTextureTable::PARAM_NAME);
+			if (iterFind != paramDesc->textures.end())
+			{
+				const GpuParamObjectDesc& tableDesc = iterFind->second;
+				mTextureTableSet = tableDesc.set;
+
+				UINT32 bindingIdx = getBindingIdx(tableDesc.set, tableDesc.slot);
+				mLayoutInfos[tableDesc.set].bindings[bindingIdx].descriptorCount = TextureTable::MAX_INDEXED_TEXTURES;
+			}
+
 			// Set up buffer bindings
 			for (auto& entry : paramDesc->buffers)
 			{
@@ -179,6 +191,36 @@ namespace bs { namespace ct
 			}
 		}
 
+		// Param blocks are bound with dynamic offsets, so they can be sub-allocated from shared buffers and updated by
+		// only changing the offset. Devices limit the number of dynamic buffers per pipeline layout, so any param
+		// blocks over the limit use regular uniform buffers.
+		UINT32 maxDynamicBuffers = std::numeric_limits<UINT32>::max();
+		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
+		{
+			if (devices[i] == nullptr)
+				continue;
+
+			const VkPhysicalDeviceLimits& limits = devices[i]->getDeviceProperties().limits;
+			maxDynamicBuffers = std::min(maxDynamicBuffers, limits.maxDescriptorSetUniformBuffersDynamic);
+		}
+
+		// Note: Dynamic offsets are provided in set and binding order, so they must be assigned in the same order
+		for (UINT32 i = 0; i < mNumSets; i++)
+		{
+			for (UINT32 j = 0; j < mLayoutInfos[i].numBindings; j++)
+			{
+				VkDescriptorSetLayoutBinding& binding = mLayoutInfos[i].bindings[j];
+				if (binding.descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+					continue;
+
+				if (mNumDynamicOffsets >= maxDynamicBuffers)
+					break;
+
+				binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+				mNumDynamicOffsets++;
+			}
+		}
+
 		// Allocate layouts per-device
 		for (UINT32 i = 0; i < BS_MAX_DEVICES; i++)
 		{
@@ -187,7 +229,19 @@ namespace bs { namespace ct
 
 			VulkanDescriptorManager& descManager = devices[i]->getDescriptorManager();
 			for (UINT32 j = 0; j < mNumSets; j++)
-				mLayouts[i][j] = descManager.getLayout(mLayoutInfos[j].bindings, mLayoutInfos[j].numBindings);
+			{
+				// Programs sampling the table are only used if the device supports it, see
+				// RSC_TEXTURE_DESCRIPTOR_INDEXING
+				if (j == mTextureTableSet)
+				{
+					VulkanTextureTable* textureTable = devices[i]->getTextureTable();
+					assert(textureTable != nullptr);
+
+					mLayouts[i][j] = textureTable->getLayout();
+				}
+				else
+					mLayouts[i][j] = descManager.getLayout(mLayoutInfos[j].bindings, mLayoutInfos[j].numBindings);
+			}
 		}
 	}
 
@@ -28,6 +28,12 @@ namespace bs { namespace ct
 		/** Returns a pointer to any array of types expected by layout bindings. */
 		GpuParamObjectType* getLayoutTypes(UINT32 layoutIdx) const { return mLayoutInfos[layoutIdx].types; }
 
+		/** 
+		 * Returns the total number of bindings using dynamic uniform buffers, across all layouts. This is the number of
+		 * dynamic offsets that need to be provided when binding the descriptor sets.
+		 */
+		UINT32 getNumDynamicOffsets() const { return mNumDynamicOffsets; }
+
 		/** Returns the sequential index of the binding at the specificn set/slot. Returns -1 if slot is not used. */
 		UINT32 getBindingIdx(UINT32 set, UINT32 slot) const { return mSetExtraInfos[set].slotIndices[slot]; }
 
@@ -37,6 +43,12 @@ namespace bs { namespace ct
 		 */
 		VulkanDescriptorLayout* getLayout(UINT32 deviceIdx, UINT32 layoutIdx) const;
 
+		/** 
+		 * Returns the index of the set containing the global texture table, or -1 if the GPU programs don't sample the
+		 * table. The set is provided by VulkanTextureTable rather than being allocated per parameter object.
+		 */
+		UINT32 getTextureTableSet() const { return mTextureTableSet; }
+
 	private:
 		/**	@copydoc GpuPipelineParamInfo::initialize */
 		void initialize() override;
@@ -56,6 +68,8 @@ namespace bs { namespace ct
 		};
 
 		GpuDeviceFlags mDeviceMask;
+		UINT32 mNumDynamicOffsets = 0;
+		UINT32 mTextureTableSet = (UINT32)-1;
 
 		SetExtraInfo* mSetExtraInfos;
 		VulkanDescriptorLayout** mLayouts[BS_MAX_DEVICES];
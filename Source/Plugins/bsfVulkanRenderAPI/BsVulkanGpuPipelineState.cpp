@@ -13,6 +13,7 @@
 #include "RenderAPI/BsDepthStencilState.h"
 #include "RenderAPI/BsBlendState.h"
 #include "Profiling/BsRenderStats.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct
 {
@@ -340,6 +341,27 @@ namespace bs { namespace ct
 		return newPipeline;
 	}
 
+	SPtr<Task> VulkanGraphicsPipelineState::prewarmPipeline(UINT32 deviceIdx, VulkanFramebuffer* framebuffer, 
+		UINT32 readOnlyFlags, DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput)
+	{
+		if (mPerDeviceData[deviceIdx].device == nullptr)
+			return nullptr;
+
+		// Keep the framebuffer (and its render pass) alive until the task completes
+		framebuffer->notifyBound();
+
+		SPtr<VulkanGraphicsPipelineState> thisPtr = std::static_pointer_cast<VulkanGraphicsPipelineState>(getThisPtr());
+		SPtr<Task> task = Task::create("VulkanPipelinePrewarm", 
+			[thisPtr, deviceIdx, framebuffer, readOnlyFlags, drawOp, vertexInput]()
+		{
+			thisPtr->getPipeline(deviceIdx, framebuffer, readOnlyFlags, drawOp, vertexInput);
+			framebuffer->notifyUnbound();
+		});
+
+		TaskScheduler::instance().addTask(task);
+		return task;
+	}
+
 	VkPipelineLayout VulkanGraphicsPipelineState::getPipelineLayout(UINT32 deviceIdx) const
 	{
 		return mPerDeviceData[deviceIdx].pipelineLayout;
@@ -478,7 +500,8 @@ namespace bs { namespace ct
 		VkDevice vkDevice = mPerDeviceData[deviceIdx].device->getLogical();
 
 		VkPipeline pipeline;
-		VkResult result = vkCreateGraphicsPipelines(vkDevice, VK_NULL_HANDLE, 1, &mPipelineInfo, gVulkanAllocator, &pipeline);
+		VkResult result = vkCreateGraphicsPipelines(vkDevice, device->getPipelineCache(), 1, &mPipelineInfo,
+			gVulkanAllocator, &pipeline);
 		assert(result == VK_SUCCESS);
 
 		// Restore previous stencil op states
@@ -571,7 +594,7 @@ namespace bs { namespace ct
 			pipelineCI.layout = descManager.getPipelineLayout(layouts, numLayouts);
 
 			VkPipeline pipeline;
-			VkResult result = vkCreateComputePipelines(devices[i]->getLogical(), VK_NULL_HANDLE, 1, &pipelineCI,
+			VkResult result = vkCreateComputePipelines(devices[i]->getLogical(), devices[i]->getPipelineCache(), 1, &pipelineCI,
 														gVulkanAllocator, &pipeline);
 			assert(result == VK_SUCCESS);
 
@@ -65,6 +65,18 @@ namespace bs { namespace ct
 		VulkanPipeline* getPipeline(UINT32 deviceIdx, VulkanFramebuffer* framebuffer, UINT32 readOnlyFlags, 
 			DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput);
 
+		/** 
+		 * Queues creation of the pipeline matching the provided parameters on a worker thread, so that a later call to
+		 * getPipeline() with the same parameters doesn't need to wait for the pipeline to compile. Parameters are the
+		 * same as for getPipeline().
+		 *
+		 * @return		Task that creates the pipeline, or null if the pipeline state wasn't created for the device.
+		 *
+		 * @note	Thread safe.
+		 */
+		SPtr<Task> prewarmPipeline(UINT32 deviceIdx, VulkanFramebuffer* framebuffer, UINT32 readOnlyFlags, 
+			DrawOperationType drawOp, const SPtr<VulkanVertexInput>& vertexInput);
+
 		/** 
 		 * Returns a pipeline layout object for the specified device index. If the device index doesn't match a bit in the
 		 * device mask provided on pipeline creation, null is returned.
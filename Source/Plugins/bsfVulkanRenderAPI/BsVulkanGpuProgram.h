@@ -61,7 +61,7 @@ namespace bs { namespace ct
 	 * Version of the compiler used for compiling Vulkan GPU programs. Tick this whenever the compiler updates in order
 	 * to force bytecode to rebuild. 
 	 */
-	static constexpr UINT32 VULKAN_COMPILER_VERSION = 1;
+	static constexpr UINT32 VULKAN_COMPILER_VERSION = 2;
 
 	/** @} */
 }}
\ No newline at end of file
@@ -7,12 +7,13 @@
 #include "Managers/BsVulkanCommandBufferManager.h"
 #include "BsVulkanCommandBuffer.h"
 #include "BsVulkanTexture.h"
+#include "BsVulkanRingBuffer.h"
 
 namespace bs { namespace ct
 {
 	VulkanBuffer::VulkanBuffer(VulkanResourceManager* owner, VkBuffer buffer, VmaAllocation allocation, UINT32 rowPitch
-		, UINT32 slicePitch)
-		: VulkanResource(owner, false), mBuffer(buffer), mAllocation(allocation), mRowPitch(rowPitch)
+		, UINT32 slicePitch, bool concurrency)
+		: VulkanResource(owner, concurrency), mBuffer(buffer), mAllocation(allocation), mRowPitch(rowPitch)
 	{
 		if (rowPitch != 0)
 			mSliceHeight = slicePitch / rowPitch;
@@ -70,11 +71,17 @@ namespace bs { namespace ct
 
 	void VulkanBuffer::copy(VulkanCmdBuffer* cb, VulkanImage* destination, const VkExtent3D& extent, 
 		const VkImageSubresourceLayers& range, VkImageLayout layout)
+	{
+		copy(cb, destination, 0, mRowPitch, mSliceHeight, extent, range, layout);
+	}
+
+	void VulkanBuffer::copy(VulkanCmdBuffer* cb, VulkanImage* destination, VkDeviceSize srcOffset, UINT32 rowPitch,
+		UINT32 sliceHeight, const VkExtent3D& extent, const VkImageSubresourceLayers& range, VkImageLayout layout)
 	{
 		VkBufferImageCopy region;
-		region.bufferRowLength = mRowPitch;
-		region.bufferImageHeight = mSliceHeight;
-		region.bufferOffset = 0;
+		region.bufferRowLength = rowPitch;
+		region.bufferImageHeight = sliceHeight;
+		region.bufferOffset = srcOffset;
 		region.imageOffset.x = 0;
 		region.imageOffset.y = 0;
 		region.imageOffset.z = 0;
@@ -179,7 +186,7 @@ namespace bs { namespace ct
 
 	VulkanHardwareBuffer::VulkanHardwareBuffer(BufferType type, GpuBufferFormat format, GpuBufferUsage usage, 
 		UINT32 size, GpuDeviceFlags deviceMask)
-		: HardwareBuffer(size, usage, deviceMask), mBuffers(), mStagingBuffer(nullptr), mStagingMemory(nullptr)
+		: HardwareBuffer(size, usage, deviceMask), mBuffers(), mStagingBuffer(nullptr)
 		, mMappedDeviceIdx(-1), mMappedGlobalQueueIdx(-1), mMappedOffset(0), mMappedSize(0)
 		, mMappedLockOptions(GBL_WRITE_ONLY), mDirectlyMappable((usage & GBU_DYNAMIC) != 0)
 		, mSupportsGPUWrites(type == BT_STRUCTURED || ((usage & GBU_LOADSTORE) == GBU_LOADSTORE)), mIsMapped(false)
@@ -212,6 +219,14 @@ namespace bs { namespace ct
 		case BT_STRUCTURED:
 			usageFlags = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 			break;
+		case BT_INDIRECT:
+			usageFlags = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+				VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
+
+			if((usage & GBU_LOADSTORE) == GBU_LOADSTORE)
+				usageFlags |= VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+
+			break;
 		}
 
 		mBufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -446,11 +461,13 @@ namespace bs { namespace ct
 		// contents.
 		bool needRead = options != GBL_WRITE_ONLY_DISCARD_RANGE && options != GBL_WRITE_ONLY_DISCARD;
 		
-		// See if we can use the cheaper staging memory, rather than a staging buffer
-		if(!needRead && offset % 4 == 0 && length % 4 == 0 && length <= 65536)
+		// If only writing, sub-allocate the staging memory from the shared ring buffer, rather than creating a new
+		// staging buffer
+		if(!needRead)
 		{
-			mStagingMemory = (UINT8*)bs_alloc(length);
-			return mStagingMemory;
+			mStagingAllocation = device.getStagingRingBuffer().allocate(length);
+			if (mStagingAllocation.buffer != nullptr)
+				return mStagingAllocation.data;
 		}
 
 		// Create a staging buffer
@@ -497,7 +514,7 @@ namespace bs { namespace ct
 		// Note: If we did any writes they need to be made visible to the GPU. However there is no need to execute 
 		// a pipeline barrier because (as per spec) host writes are implicitly visible to the device.
 
-		if(mStagingMemory == nullptr && mStagingBuffer == nullptr) // We directly mapped the buffer
+		if(mStagingAllocation.buffer == nullptr && mStagingBuffer == nullptr) // We directly mapped the buffer
 		{
 			mBuffers[mMappedDeviceIdx]->unmap();
 		} 
@@ -585,9 +602,13 @@ namespace bs { namespace ct
 					mStagingBuffer->copy(transferCB->getCB(), buffer, 0, mMappedOffset, mMappedSize);
 					transferCB->getCB()->registerBuffer(mStagingBuffer, BufferUseFlagBits::Transfer, VulkanAccessFlag::Read);
 				}
-				else // Staging memory
+				else // Staging ring buffer
 				{
-					buffer->update(transferCB->getCB(), mStagingMemory, mMappedOffset, mMappedSize);
+					VulkanBuffer* stagingBuffer = mStagingAllocation.buffer;
+					stagingBuffer->copy(transferCB->getCB(), buffer, mStagingAllocation.offset, mMappedOffset,
+						mMappedSize);
+
+					transferCB->getCB()->registerBuffer(stagingBuffer, BufferUseFlagBits::Transfer, VulkanAccessFlag::Read);
 				}
 
 				transferCB->getCB()->registerBuffer(buffer, BufferUseFlagBits::Transfer, VulkanAccessFlag::Write);
@@ -602,10 +623,13 @@ namespace bs { namespace ct
 				mStagingBuffer = nullptr;
 			}
 
-			if(mStagingMemory != nullptr)
+			if(mStagingAllocation.buffer != nullptr)
 			{
-				bs_free(mStagingMemory);
-				mStagingMemory = nullptr;
+				// Region stays intact until the transfer command buffer is done with it
+				VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
+				rapi._getDevice(mMappedDeviceIdx)->getStagingRingBuffer().free(mStagingAllocation);
+
+				mStagingAllocation = VulkanRingBuffer::Allocation();
 			}
 		}
 
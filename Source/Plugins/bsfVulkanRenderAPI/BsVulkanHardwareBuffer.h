@@ -4,6 +4,7 @@
 
 #include "BsVulkanPrerequisites.h"
 #include "BsVulkanResource.h"
+#include "BsVulkanRingBuffer.h"
 #include "RenderAPI/BsHardwareBuffer.h"
 #include "Allocators/BsPoolAlloc.h"
 
@@ -23,9 +24,11 @@ namespace bs { namespace ct
 		 * @param[in]	allocation	Information about memory mapped to the buffer.
 		 * @param[in]	rowPitch	If buffer maps to an image sub-resource, length of a single row (in elements).
 		 * @param[in]	slicePitch	If buffer maps to an image sub-resource, size of a single 2D surface (in elements).
+		 * @param[in]	concurrency	True if the buffer was created with concurrent sharing, allowing it to be used on
+		 *							multiple queue families without ownership transfers.
 		 */
 		VulkanBuffer(VulkanResourceManager* owner, VkBuffer buffer, VmaAllocation allocation, 
-			UINT32 rowPitch = 0, UINT32 slicePitch = 0);
+			UINT32 rowPitch = 0, UINT32 slicePitch = 0, bool concurrency = false);
 		~VulkanBuffer();
 
 		/** Returns the internal handle to the Vulkan object. */
@@ -67,6 +70,14 @@ namespace bs { namespace ct
 		void copy(VulkanCmdBuffer* cb, VulkanImage* destination, const VkExtent3D& extent,
 			const VkImageSubresourceLayers& range, VkImageLayout layout);
 
+		/** 
+		 * Queues a command on the provided command buffer. The command copies the contents of the current buffer,
+		 * starting at the specified offset, to the destination image subresource. Pitch of the data in the buffer is
+		 * provided explicitly, instead of using the pitch the buffer was created with.
+		 */
+		void copy(VulkanCmdBuffer* cb, VulkanImage* destination, VkDeviceSize srcOffset, UINT32 rowPitch,
+			UINT32 sliceHeight, const VkExtent3D& extent, const VkImageSubresourceLayers& range, VkImageLayout layout);
+
 		/** 
 		 * Queues a command on the provided command buffer. The command copies the contents of the provided memory location
 		 * the destination buffer. Caller must ensure the provided offset and length are within valid bounds of
@@ -133,7 +144,9 @@ namespace bs { namespace ct
 			/** Generic GPU buffer containing non-formatted data. */
 			BT_GENERIC,
 			/** Generic GPU buffer containing structured data. */
-			BT_STRUCTURED
+			BT_STRUCTURED,
+			/** Generic GPU buffer containing arguments for indirect draw and dispatch calls. */
+			BT_INDIRECT
 		};
 
 		VulkanHardwareBuffer(BufferType type, GpuBufferFormat format, GpuBufferUsage usage, UINT32 size,
@@ -170,7 +183,7 @@ namespace bs { namespace ct
 		VulkanBuffer* mBuffers[BS_MAX_DEVICES];
 
 		VulkanBuffer* mStagingBuffer;
-		UINT8* mStagingMemory;
+		VulkanRingBuffer::Allocation mStagingAllocation;
 		UINT32 mMappedDeviceIdx;
 		UINT32 mMappedGlobalQueueIdx;
 		UINT32 mMappedOffset;
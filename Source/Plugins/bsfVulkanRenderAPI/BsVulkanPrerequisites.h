@@ -66,13 +66,16 @@ namespace bs { namespace ct
 	class VulkanQueryPool;
 	class VulkanVertexInput;
 	class VulkanSemaphore;
+	class VulkanRingBuffer;
+	class VulkanTextureTable;
 
 	extern VkAllocationCallbacks* gVulkanAllocator;
 
 	/**	Vulkan specific types to track resource statistics for. */
 	enum VulkanRenderStatResourceType
 	{
-		RenderStatObject_PipelineState = 100
+		RenderStatObject_PipelineState = 100,
+		RenderStatObject_DescriptorSet
 	};
 
 	/** Contains lists of images and buffers that require pipeline barrier transitions. */
@@ -80,6 +83,9 @@ namespace bs { namespace ct
 	{
 		Vector<VkImageMemoryBarrier> imageBarriers;
 		Vector<VkBufferMemoryBarrier> bufferBarriers;
+
+		/** Mask of queues (in CommandSyncMask format) the transitioned resources were last used on. */
+		UINT32 useMask = 0;
 	};
 
 	/** Bits that map to a specific part of a render target and signify whether it should be cleared or not. */
@@ -17,6 +17,8 @@
 #include "BsVulkanGpuParams.h"
 #include "Managers/BsVulkanVertexInputManager.h"
 #include "BsVulkanGpuParamBlockBuffer.h"
+#include "BsVulkanGpuBuffer.h"
+#include "BsVulkanTextureTable.h"
 
 #include <vulkan/vulkan.h>
 #include "BsVulkanUtility.h"
@@ -38,6 +40,9 @@ namespace bs { namespace ct
 	PFN_vkCreateDebugReportCallbackEXT vkCreateDebugReportCallbackEXT = nullptr;
 	PFN_vkDestroyDebugReportCallbackEXT vkDestroyDebugReportCallbackEXT = nullptr;
 
+	PFN_vkGetPhysicalDeviceFeatures2KHR vkGetPhysicalDeviceFeatures2KHR = nullptr;
+	PFN_vkGetPhysicalDeviceProperties2KHR vkGetPhysicalDeviceProperties2KHR = nullptr;
+
 	PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR = nullptr;
 	PFN_vkGetPhysicalDeviceSurfaceFormatsKHR vkGetPhysicalDeviceSurfaceFormatsKHR = nullptr;
 	PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR vkGetPhysicalDeviceSurfaceCapabilitiesKHR = nullptr;
@@ -121,36 +126,51 @@ namespace bs { namespace ct
 			"VK_LAYER_LUNARG_standard_validation"
 		};
 
-		const char* extensions[] =
-		{
-			nullptr, /** Surface extension */
-			nullptr, /** OS specific surface extension */
-			VK_EXT_DEBUG_REPORT_EXTENSION_NAME
-		};
-
 		uint32_t numLayers = sizeof(layers) / sizeof(layers[0]);
 #else
 		const char** layers = nullptr;
-		const char* extensions[] =
-		{
-			nullptr, /** Surface extension */
-			nullptr, /** OS specific surface extension */
-		};
-
 		uint32_t numLayers = 0;
 #endif
 
-		extensions[0] = VK_KHR_SURFACE_EXTENSION_NAME;
+		const char* extensions[4];
+		uint32_t numExtensions = 0;
+
+		extensions[numExtensions++] = VK_KHR_SURFACE_EXTENSION_NAME;
 
 #if BS_PLATFORM == BS_PLATFORM_WIN32
-		extensions[1] = VK_KHR_WIN32_SURFACE_EXTENSION_NAME;
+		extensions[numExtensions++] = VK_KHR_WIN32_SURFACE_EXTENSION_NAME;
 #elif BS_PLATFORM == BS_PLATFORM_ANDROID
-		extensions[1] = VK_KHR_ANDROID_SURFACE_EXTENSION_NAME;
+		extensions[numExtensions++] = VK_KHR_ANDROID_SURFACE_EXTENSION_NAME;
 #else
-		extensions[1] = VK_KHR_XLIB_SURFACE_EXTENSION_NAME;
+		extensions[numExtensions++] = VK_KHR_XLIB_SURFACE_EXTENSION_NAME;
+#endif
+
+#if BS_DEBUG_MODE && USE_VALIDATION_LAYERS
+		extensions[numExtensions++] = VK_EXT_DEBUG_REPORT_EXTENSION_NAME;
 #endif
 
-		uint32_t numExtensions = sizeof(extensions) / sizeof(extensions[0]);
+		// Optional, required for querying support for descriptor indexing
+		bool physicalDeviceProps2Ext = false;
+
+		uint32_t numAvailableExtensions = 0;
+		vkEnumerateInstanceExtensionProperties(nullptr, &numAvailableExtensions, nullptr);
+		if (numAvailableExtensions > 0)
+		{
+			Vector<VkExtensionProperties> availableExtensions(numAvailableExtensions);
+			if (vkEnumerateInstanceExtensionProperties(nullptr, &numAvailableExtensions, availableExtensions.data()) ==
+				VK_SUCCESS)
+			{
+				for (auto& entry : availableExtensions)
+				{
+					if (strcmp(entry.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0)
+					{
+						extensions[numExtensions++] = VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME;
+						physicalDeviceProps2Ext = true;
+						break;
+					}
+				}
+			}
+		}
 
 		VkInstanceCreateInfo instanceInfo;
 		instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -184,6 +204,13 @@ namespace bs { namespace ct
 		assert(result == VK_SUCCESS);
 #endif
 
+		// Needed by the devices on creation
+		if (physicalDeviceProps2Ext)
+		{
+			GET_INSTANCE_PROC_ADDR(mInstance, GetPhysicalDeviceFeatures2KHR);
+			GET_INSTANCE_PROC_ADDR(mInstance, GetPhysicalDeviceProperties2KHR);
+		}
+
 		// Enumerate all devices
 		result = vkEnumeratePhysicalDevices(mInstance, &mNumDevices, nullptr);
 		assert(result == VK_SUCCESS);
@@ -197,7 +224,6 @@ namespace bs { namespace ct
 			mDevices[i] = bs_shared_ptr_new<VulkanDevice>(physicalDevices[i], i);
 
 		// Find primary device
-		// Note: MULTIGPU - Detect multiple similar devices here if supporting multi-GPU
 		for (uint32_t i = 0; i < mNumDevices; i++)
 		{
 			bool isPrimary = mDevices[i]->getDeviceProperties().deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
@@ -225,6 +251,21 @@ namespace bs { namespace ct
 			mDevices[0]->setIsPrimary();
 			mPrimaryDevices.push_back(mDevices[0]);
 		}
+		else
+		{
+			// Other GPUs of the same model can render in parallel with the primary one, with resources replicated over
+			// all of them
+			const VkPhysicalDeviceProperties& primaryProps = mDevices[0]->getDeviceProperties();
+			for (uint32_t i = 1; i < mNumDevices; i++)
+			{
+				const VkPhysicalDeviceProperties& props = mDevices[i]->getDeviceProperties();
+				if (props.vendorID == primaryProps.vendorID && props.deviceID == primaryProps.deviceID)
+				{
+					mDevices[i]->setIsPrimary();
+					mPrimaryDevices.push_back(mDevices[i]);
+				}
+			}
+		}
 
 #if BS_PLATFORM == BS_PLATFORM_WIN32
 		mVideoModeInfo = bs_shared_ptr_new<Win32VideoModeInfo>();
@@ -258,8 +299,14 @@ namespace bs { namespace ct
 		// Create command buffer manager
 		CommandBufferManager::startUp<VulkanCommandBufferManager>(*this);
 
-		// Create main command buffer
-		mMainCommandBuffer = std::static_pointer_cast<VulkanCommandBuffer>(CommandBuffer::create(GQT_GRAPHICS));
+		// Create main command buffers, one for each device we can render on
+		for (auto& device : mPrimaryDevices)
+		{
+			SPtr<CommandBuffer> cb = CommandBuffer::create(GQT_GRAPHICS, device->getIndex());
+			mMainCommandBuffers.push_back(std::static_pointer_cast<VulkanCommandBuffer>(cb));
+		}
+
+		mMainCommandBuffer = mMainCommandBuffers[0];
 
 		// Create the texture manager for use by others		
 		bs::TextureManager::startUp<bs::VulkanTextureManager>();
@@ -287,6 +334,10 @@ namespace bs { namespace ct
 		GpuProgramManager::instance().addFactory("vksl", mGLSLFactory);
 
 		initCapabilites();
+
+		RenderStats& renderStats = RenderStats::instance();
+		renderStats.setResourceCategory(RenderStatObject_PipelineState, RenderStatResourceCategory::PipelineState);
+		renderStats.setResourceCategory(RenderStatObject_DescriptorSet, RenderStatResourceCategory::DescriptorSet);
 		
 		RenderAPI::initialize();
 	}
@@ -312,6 +363,7 @@ namespace bs { namespace ct
 		bs::TextureManager::shutDown();
 
 		mMainCommandBuffer = nullptr;
+		mMainCommandBuffers.clear();
 
 		// Make sure everything finishes and all resources get freed
 		for (UINT32 i = 0; i < (UINT32)mDevices.size(); i++)
@@ -469,6 +521,60 @@ namespace bs { namespace ct
 		BS_INC_RENDER_STAT(NumComputeCalls);
 	}
 
+	void VulkanRenderAPI::drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount,
+		UINT32 stride, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		VulkanCommandBuffer* cb = getCB(commandBuffer);
+		VulkanCmdBuffer* vkCB = cb->getInternal();
+
+		VulkanGpuBuffer* vkArgsBuffer = static_cast<VulkanGpuBuffer*>(argsBuffer.get());
+		VulkanBuffer* argsResource = vkArgsBuffer->getResource(cb->getDeviceIdx());
+		if (argsResource == nullptr)
+			return;
+
+		if (stride == 0)
+			stride = sizeof(DRAW_INDIRECT_ARGS);
+
+		vkCB->drawIndirect(argsResource, offset, drawCount, stride);
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
+
+	void VulkanRenderAPI::drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset, UINT32 drawCount,
+		UINT32 stride, const SPtr<CommandBuffer>& commandBuffer)
+	{
+		VulkanCommandBuffer* cb = getCB(commandBuffer);
+		VulkanCmdBuffer* vkCB = cb->getInternal();
+
+		VulkanGpuBuffer* vkArgsBuffer = static_cast<VulkanGpuBuffer*>(argsBuffer.get());
+		VulkanBuffer* argsResource = vkArgsBuffer->getResource(cb->getDeviceIdx());
+		if (argsResource == nullptr)
+			return;
+
+		if (stride == 0)
+			stride = sizeof(DRAW_INDEXED_INDIRECT_ARGS);
+
+		vkCB->drawIndexedIndirect(argsResource, offset, drawCount, stride);
+
+		BS_INC_RENDER_STAT(NumDrawCalls);
+	}
+
+	void VulkanRenderAPI::dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset,
+		const SPtr<CommandBuffer>& commandBuffer)
+	{
+		VulkanCommandBuffer* cb = getCB(commandBuffer);
+		VulkanCmdBuffer* vkCB = cb->getInternal();
+
+		VulkanGpuBuffer* vkArgsBuffer = static_cast<VulkanGpuBuffer*>(argsBuffer.get());
+		VulkanBuffer* argsResource = vkArgsBuffer->getResource(cb->getDeviceIdx());
+		if (argsResource == nullptr)
+			return;
+
+		vkCB->dispatchIndirect(argsResource, offset);
+
+		BS_INC_RENDER_STAT(NumComputeCalls);
+	}
+
 	void VulkanRenderAPI::setScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom,
 		const SPtr<CommandBuffer>& commandBuffer)
 	{
@@ -524,7 +630,11 @@ namespace bs { namespace ct
 	{
 		THROW_IF_NOT_CORE_THREAD;
 
-		submitCommandBuffer(mMainCommandBuffer, syncMask);
+		// Secondary devices don't present, but their work is submitted once per frame as well
+		for (UINT32 i = 1; i < (UINT32)mMainCommandBuffers.size(); i++)
+			submitCommandBuffer(mMainCommandBuffers[i], syncMask);
+
+		submitCommandBuffer(mMainCommandBuffers[0], syncMask);
 		target->swapBuffers(syncMask);
 
 		// See if any command buffers finished executing
@@ -639,6 +749,12 @@ namespace bs { namespace ct
 		mNumDevices = (UINT32)mDevices.size();
 		mCurrentCapabilities = bs_newN<RenderAPICapabilities>(mNumDevices);
 
+		// Resources are replicated over all primary devices, so the texture table can only be used if they all
+		// support it
+		bool textureTableSupported = true;
+		for (auto& device : mPrimaryDevices)
+			textureTableSupported &= device->supportsDescriptorIndexing();
+
 		UINT32 deviceIdx = 0;
 		for (auto& device : mDevices)
 		{
@@ -690,6 +806,13 @@ namespace bs { namespace ct
 			caps.setNumMultiRenderTargets(deviceLimits.maxColorAttachments);
 
 			caps.setCapability(RSC_COMPUTE_PROGRAM);
+			caps.setCapability(RSC_DRAW_INDIRECT);
+
+			if (deviceFeatures.multiDrawIndirect)
+				caps.setCapability(RSC_MULTI_DRAW_INDIRECT);
+
+			if (textureTableSupported && device->supportsDescriptorIndexing())
+				caps.setCapability(RSC_TEXTURE_DESCRIPTOR_INDEXING);
 
 			caps.setNumTextureUnits(GPT_FRAGMENT_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);
 			caps.setNumTextureUnits(GPT_VERTEX_PROGRAM, deviceLimits.maxPerStageDescriptorSampledImages);
@@ -741,6 +864,33 @@ namespace bs { namespace ct
 		}
 	}
 
+	void VulkanRenderAPI::setActiveDevice(UINT32 idx)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		if (idx >= (UINT32)mMainCommandBuffers.size())
+		{
+			LOGWRN("Invalid render device index provided: " + toString(idx) + ". Valid range is: [0, " +
+				toString((UINT32)mMainCommandBuffers.size()) + ").");
+			return;
+		}
+
+		mActiveDevice = idx;
+		mMainCommandBuffer = mMainCommandBuffers[idx];
+	}
+
+	void VulkanRenderAPI::setTextureTableEntry(UINT32 index, const SPtr<Texture>& texture)
+	{
+		THROW_IF_NOT_CORE_THREAD;
+
+		for (auto& device : mDevices)
+		{
+			VulkanTextureTable* textureTable = device->getTextureTable();
+			if (textureTable != nullptr)
+				textureTable->setEntry(index, texture);
+		}
+	}
+
 	VulkanCommandBuffer* VulkanRenderAPI::getCB(const SPtr<CommandBuffer>& buffer)
 	{
 		if (buffer != nullptr)
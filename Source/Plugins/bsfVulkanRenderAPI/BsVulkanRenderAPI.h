@@ -83,6 +83,18 @@ namespace bs { namespace ct
 		void dispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY = 1, UINT32 numGroupsZ = 1,
 			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
 
+		/** @copydoc RenderAPI::drawIndirect */
+		void drawIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::drawIndexedIndirect */
+		void drawIndexedIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0, UINT32 drawCount = 1,
+			UINT32 stride = 0, const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
+		/** @copydoc RenderAPI::dispatchComputeIndirect */
+		void dispatchComputeIndirect(const SPtr<GpuBuffer>& argsBuffer, UINT32 offset = 0,
+			const SPtr<CommandBuffer>& commandBuffer = nullptr) override;
+
 		/** @copydoc RenderAPI::swapBuffers() */
 		void swapBuffers(const SPtr<RenderTarget>& target, UINT32 syncMask = 0xFFFFFFFF) override;
 
@@ -101,6 +113,18 @@ namespace bs { namespace ct
 		/** @copydoc RenderAPI::generateParamBlockDesc() */
 		GpuParamBlockDesc generateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params) override;
 
+		/** @copydoc RenderAPI::getNumRenderDevices() */
+		UINT32 getNumRenderDevices() const override { return (UINT32)mPrimaryDevices.size(); }
+
+		/** @copydoc RenderAPI::setActiveDevice() */
+		void setActiveDevice(UINT32 idx) override;
+
+		/** @copydoc RenderAPI::getActiveDevice() */
+		UINT32 getActiveDevice() const override { return mActiveDevice; }
+
+		/** @copydoc RenderAPI::setTextureTableEntry() */
+		void setTextureTableEntry(UINT32 index, const SPtr<Texture>& texture) override;
+
 		/**
 		 * @name Internal
 		 * @{
@@ -124,7 +148,7 @@ namespace bs { namespace ct
 		 */
 		const Vector<SPtr<VulkanDevice>> _getPrimaryDevices() const { return mPrimaryDevices; }
 
-		/** Returns the main command buffer, executing on the graphics queue. */
+		/** Returns the main command buffer of the active render device, executing on the graphics queue. */
 		VulkanCommandBuffer* _getMainCommandBuffer() const { return mMainCommandBuffer.get(); }
 
 		/** @} */
@@ -152,6 +176,8 @@ namespace bs { namespace ct
 		Vector<SPtr<VulkanDevice>> mDevices;
 		Vector<SPtr<VulkanDevice>> mPrimaryDevices;
 		SPtr<VulkanCommandBuffer> mMainCommandBuffer;
+		Vector<SPtr<VulkanCommandBuffer>> mMainCommandBuffers;
+		UINT32 mActiveDevice = 0;
 
 		VulkanGLSLProgramFactory* mGLSLFactory;
 
@@ -163,6 +189,9 @@ namespace bs { namespace ct
 	/**	Provides easy access to the VulkanRenderAPI. */
 	VulkanRenderAPI& gVulkanRenderAPI();
 
+	extern PFN_vkGetPhysicalDeviceFeatures2KHR vkGetPhysicalDeviceFeatures2KHR;
+	extern PFN_vkGetPhysicalDeviceProperties2KHR vkGetPhysicalDeviceProperties2KHR;
+
 	extern PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR;
 	extern PFN_vkGetPhysicalDeviceSurfaceFormatsKHR vkGetPhysicalDeviceSurfaceFormatsKHR;
 	extern PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR vkGetPhysicalDeviceSurfaceCapabilitiesKHR;
@@ -6,11 +6,15 @@
 
 namespace bs { namespace ct
 {
+	/** Identifier to assign to the next created resource. Zero is reserved for descriptors not bound to a resource. */
+	static std::atomic<UINT64> sNextResourceId { 1 };
+
 	VulkanResource::VulkanResource(VulkanResourceManager* owner, bool concurrency)
 	{
 		Lock lock(mMutex);
 
 		mOwner = owner;
+		mId = sNextResourceId.fetch_add(1, std::memory_order_relaxed);
 		mQueueFamily = -1;
 		mState = concurrency ? State::Shared : State::Normal;
 		mNumUsedHandles = 0;
@@ -41,13 +45,9 @@ namespace bs { namespace ct
 		Lock lock(mMutex);
 		assert(useFlags != VulkanAccessFlag::None);
 
-		bool isUsed = mNumUsedHandles > 0;
-		if(isUsed && mState == State::Normal) // Used without support for concurrency
-		{
-			assert(mQueueFamily == queueFamily &&
-				"Vulkan resource without concurrency support can only be used by one queue family at once.");
-		}
-
+		// Note: Resources without concurrency support are allowed to still be in use by another queue family (e.g.
+		// while an upload finishes on the transfer queue). The command buffer releases ownership on the queue the
+		// resource was last used on, and waits on it before acquiring it, so the uses don't overlap.
 		mNumUsedHandles++;
 		mQueueFamily = queueFamily;
 
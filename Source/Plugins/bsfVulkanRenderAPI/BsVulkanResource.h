@@ -125,6 +125,12 @@ namespace bs { namespace ct
 		/** Returns the device this resource is created on. */
 		VulkanDevice& getDevice() const;
 
+		/** 
+		 * Returns an identifier unique to this resource. Unlike the handles of the internal Vulkan objects, identifiers
+		 * are never reused after the resource is destroyed.
+		 */
+		UINT64 getId() const { return mId; }
+
 		/** 
 		 * Destroys the resource and frees its memory. If the resource is currently being used on a device, the
 		 * destruction is delayed until the device is done with it.
@@ -143,6 +149,7 @@ namespace bs { namespace ct
 		static const UINT32 MAX_UNIQUE_QUEUES = BS_MAX_QUEUES_PER_TYPE * GQT_COUNT;
 
 		VulkanResourceManager* mOwner;
+		UINT64 mId;
 		UINT32 mQueueFamily;
 		State mState;
 
@@ -0,0 +1,180 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsVulkanRingBuffer.h"
+#include "BsVulkanDevice.h"
+#include "BsVulkanHardwareBuffer.h"
+
+namespace bs { namespace ct
+{
+	VulkanRingBuffer::VulkanRingBuffer(VulkanDevice& device, VkBufferUsageFlags usage, UINT32 bufferSize,
+		UINT32 alignment, UINT32 maxIdle)
+		: mDevice(device), mUsage(usage), mBufferSize(bufferSize), mAlignment(std::max(alignment, 1U))
+		, mMaxIdle(maxIdle)
+	{ }
+
+	VulkanRingBuffer::~VulkanRingBuffer()
+	{
+		for (auto& entry : mBuffers)
+		{
+			assert(entry.numAllocations == 0 && "Ring buffer destroyed while its allocations are still live.");
+			destroyBuffer(entry);
+		}
+	}
+
+	VulkanRingBuffer::Allocation VulkanRingBuffer::allocate(UINT32 size, UINT32 alignment)
+	{
+		if (size > mBufferSize)
+			return Allocation();
+
+		// Offset needs to satisfy both alignments, which might not be powers of two
+		UINT32 offsetAlignment = mAlignment;
+		if (alignment > 1 && alignment % mAlignment != 0)
+			offsetAlignment = mAlignment * alignment;
+		else if (alignment > mAlignment)
+			offsetAlignment = alignment;
+
+		const UINT32 offset = Math::divideAndRoundUp(mCurrentOffset, offsetAlignment) * offsetAlignment;
+		if (mCurrentBuffer == (UINT32)-1 || (UINT64)offset + size > mBufferSize)
+		{
+			// Move to the next buffer in the ring that isn't referenced by a live allocation or by the GPU
+			const UINT32 numBuffers = (UINT32)mBuffers.size();
+
+			UINT32 nextBuffer = (UINT32)-1;
+			for (UINT32 i = 1; i <= numBuffers; i++)
+			{
+				const UINT32 idx = (mCurrentBuffer + i) % numBuffers;
+				if (isIdle(mBuffers[idx]))
+				{
+					nextBuffer = idx;
+					break;
+				}
+			}
+
+			if (nextBuffer == (UINT32)-1)
+			{
+				nextBuffer = numBuffers;
+				mBuffers.push_back(createBuffer());
+			}
+
+			mCurrentBuffer = nextBuffer;
+			mCurrentOffset = 0;
+
+			trimIdleBuffers();
+		}
+		else
+			mCurrentOffset = offset;
+
+		BufferInfo& entry = mBuffers[mCurrentBuffer];
+		entry.numAllocations++;
+
+		Allocation allocation;
+		allocation.buffer = entry.buffer;
+		allocation.data = entry.data + mCurrentOffset;
+		allocation.offset = mCurrentOffset;
+
+		mCurrentOffset += size;
+		return allocation;
+	}
+
+	void VulkanRingBuffer::free(const Allocation& allocation)
+	{
+		if (allocation.buffer == nullptr)
+			return;
+
+		for (auto& entry : mBuffers)
+		{
+			if (entry.buffer != allocation.buffer)
+				continue;
+
+			assert(entry.numAllocations > 0);
+			entry.numAllocations--;
+			return;
+		}
+
+		assert(false && "Freeing an allocation that doesn't belong to this ring buffer.");
+	}
+
+	bool VulkanRingBuffer::isIdle(const BufferInfo& entry)
+	{
+		return entry.numAllocations == 0 && !entry.buffer->isBound();
+	}
+
+	VulkanRingBuffer::BufferInfo VulkanRingBuffer::createBuffer()
+	{
+		// Allocations are only ever written by the host, so the buffer is shared between all the queue families instead
+		// of requiring an ownership transfer (and a sync point) whenever different queues use their allocations
+		UINT32 queueFamilies[GQT_COUNT];
+		UINT32 numQueueFamilies = 0;
+		for (UINT32 i = 0; i < GQT_COUNT; i++)
+		{
+			if (mDevice.getNumQueues((GpuQueueType)i) == 0)
+				continue;
+
+			const UINT32 familyIdx = mDevice.getQueueFamily((GpuQueueType)i);
+			UINT32* familiesEnd = queueFamilies + numQueueFamilies;
+			if (std::find(queueFamilies, familiesEnd, familyIdx) == familiesEnd)
+				queueFamilies[numQueueFamilies++] = familyIdx;
+		}
+
+		const bool concurrent = numQueueFamilies > 1;
+
+		VkBufferCreateInfo bufferCI;
+		bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferCI.pNext = nullptr;
+		bufferCI.flags = 0;
+		bufferCI.size = mBufferSize;
+		bufferCI.usage = mUsage;
+		bufferCI.sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+		bufferCI.queueFamilyIndexCount = concurrent ? numQueueFamilies : 0;
+		bufferCI.pQueueFamilyIndices = concurrent ? queueFamilies : nullptr;
+
+		VkBuffer buffer;
+		VkResult result = vkCreateBuffer(mDevice.getLogical(), &bufferCI, gVulkanAllocator, &buffer);
+		assert(result == VK_SUCCESS);
+
+		// Memory stays mapped for the lifetime of the buffer, so it must not share a memory block with other buffers
+		// that get mapped and unmapped on their own
+		VmaAllocation allocation = mDevice.allocateMemory(buffer,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, true);
+
+		BufferInfo entry;
+		entry.buffer = mDevice.getResourceManager().create<VulkanBuffer>(buffer, allocation, 0, 0, concurrent);
+		entry.data = entry.buffer->map(0, mBufferSize);
+		entry.numAllocations = 0;
+
+		return entry;
+	}
+
+	void VulkanRingBuffer::destroyBuffer(BufferInfo& entry)
+	{
+		entry.buffer->unmap();
+		entry.buffer->destroy();
+	}
+
+	void VulkanRingBuffer::trimIdleBuffers()
+	{
+		UINT32 numIdle = 0;
+		for (UINT32 i = 0; i < (UINT32)mBuffers.size(); i++)
+		{
+			if (i != mCurrentBuffer && isIdle(mBuffers[i]))
+				numIdle++;
+		}
+
+		for (UINT32 i = 0; i < (UINT32)mBuffers.size() && numIdle > mMaxIdle;)
+		{
+			if (i == mCurrentBuffer || !isIdle(mBuffers[i]))
+			{
+				i++;
+				continue;
+			}
+
+			destroyBuffer(mBuffers[i]);
+			mBuffers.erase(mBuffers.begin() + i);
+
+			if (mCurrentBuffer > i)
+				mCurrentBuffer--;
+
+			numIdle--;
+		}
+	}
+}}
\ No newline at end of file
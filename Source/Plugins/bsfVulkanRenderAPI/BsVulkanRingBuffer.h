@@ -0,0 +1,97 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsVulkanPrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Vulkan
+	 *  @{
+	 */
+
+	/**
+	 * Sub-allocates memory from a set of large, persistently mapped host visible buffers. Buffers are used as a ring:
+	 * allocations are made linearly from the current buffer, and once it runs out of space the next buffer is used, as
+	 * long as none of its allocations are still live and the GPU is done with it. If no such buffer exists a new one is
+	 * created. Each buffer is tracked as a normal resource, so the GPU use of the allocated regions is tracked by
+	 * registering their buffer with the command buffer they're used on.
+	 *
+	 * Used for frequently updated GPU parameter blocks, and as a staging area for CPU to GPU transfers.
+	 *
+	 * @note	Core thread only.
+	 */
+	class VulkanRingBuffer
+	{
+	public:
+		/** Region of a buffer assigned to a single allocation. */
+		struct Allocation
+		{
+			VulkanBuffer* buffer = nullptr;
+			UINT8* data = nullptr;
+			UINT32 offset = 0;
+		};
+
+		/**
+		 * @param[in]	device		Device to create the buffers on.
+		 * @param[in]	usage		Usage flags of the buffers the allocations are made from.
+		 * @param[in]	bufferSize	Size of a single buffer, in bytes. This is also the largest possible allocation.
+		 * @param[in]	alignment	Minimum alignment of all allocations, in bytes.
+		 * @param[in]	maxIdle		Maximum number of buffers to keep around while they're unused. Any buffers over
+		 *							this number are destroyed once they are no longer used.
+		 */
+		VulkanRingBuffer(VulkanDevice& device, VkBufferUsageFlags usage, UINT32 bufferSize, UINT32 alignment,
+			UINT32 maxIdle);
+		~VulkanRingBuffer();
+
+		/**
+		 * Allocates a new region of the specified size. The region's memory is mapped and can be written to directly,
+		 * until the region is used on a command buffer. Returns an empty allocation if the size is larger than the size
+		 * of a single buffer.
+		 *
+		 * @param[in]	size		Size of the region, in bytes.
+		 * @param[in]	alignment	Alignment of the region's offset, in bytes, in case the region requires a larger
+		 *							alignment than the one provided on construction. Doesn't need to be a power of two.
+		 */
+		Allocation allocate(UINT32 size, UINT32 alignment = 1);
+
+		/**
+		 * Releases a region previously returned by allocate(). Its memory will only be reused once the GPU is done with
+		 * all command buffers the region's buffer was registered with.
+		 */
+		void free(const Allocation& allocation);
+
+	private:
+		/** A single buffer the allocations are made from. */
+		struct BufferInfo
+		{
+			VulkanBuffer* buffer;
+			UINT8* data;
+			UINT32 numAllocations;
+		};
+
+		/** Checks if the buffer is not referenced by any live allocation or a command buffer. */
+		static bool isIdle(const BufferInfo& entry);
+
+		/** Creates a new buffer and maps its memory. */
+		BufferInfo createBuffer();
+
+		/** Unmaps and destroys the provided buffer. */
+		static void destroyBuffer(BufferInfo& entry);
+
+		/** Destroys idle buffers other than the current one, until there are no more than the allowed maximum. */
+		void trimIdleBuffers();
+
+		VulkanDevice& mDevice;
+		VkBufferUsageFlags mUsage;
+		UINT32 mBufferSize;
+		UINT32 mAlignment;
+		UINT32 mMaxIdle;
+
+		Vector<BufferInfo> mBuffers;
+		UINT32 mCurrentBuffer = (UINT32)-1;
+		UINT32 mCurrentOffset = 0;
+	};
+
+	/** @} */
+}}
\ No newline at end of file
@@ -660,7 +660,9 @@ namespace bs { namespace ct
 
 		VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
 		VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
-		if ((usage & TU_DYNAMIC) != 0) // Attempt to use linear tiling for dynamic textures, so we can directly map and modify them
+		// Attempt to use linear tiling for dynamic textures, so we can directly map and modify them. Same for CPU
+		// readable textures, so data copied into them by the GPU can be read without another copy and waiting on it.
+		if ((usage & (TU_DYNAMIC | TU_CPUREADABLE)) != 0)
 		{
 			// Only support 2D textures, with one sample and one mip level, only used for shader reads
 			// (Optionally check vkGetPhysicalDeviceFormatProperties & vkGetPhysicalDeviceImageFormatProperties for
@@ -759,6 +761,15 @@ namespace bs { namespace ct
 			pixelData.getRowPitch(), pixelData.getSlicePitch());
 	}
 
+	UINT32 VulkanTexture::getStagingAlignment(PixelFormat format)
+	{
+		// Buffer to image copies require the offset to be a multiple of both 4 and the texel (or block) size
+		if (PixelUtil::isCompressed(format))
+			return 16;
+
+		return PixelUtil::getNumElemBytes(format) * 4;
+	}
+
 	void VulkanTexture::copyImage(VulkanTransferBuffer* cb, VulkanImage* srcImage, VulkanImage* dstImage, 
 									  VkImageLayout srcFinalLayout, VkImageLayout dstFinalLayout)
 	{
@@ -989,24 +1000,24 @@ namespace bs { namespace ct
 			return PixelData();
 		}
 
+		UINT32 mipWidth = std::max(1u, props.getWidth() >> mipLevel);
+		UINT32 mipHeight = std::max(1u, props.getHeight() >> mipLevel);
+		UINT32 mipDepth = std::max(1u, props.getDepth() >> mipLevel);
+
+		PixelData lockedArea(mipWidth, mipHeight, mipDepth, mInternalFormats[deviceIdx]);
+
 #if BS_PROFILING_ENABLED
 		if (options == GBL_READ_ONLY || options == GBL_READ_WRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResRead, RenderStatObject_Texture);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResRead, RenderStatObject_Texture, lockedArea.getConsecutiveSize());
 		}
 
 		if (options == GBL_READ_WRITE || options == GBL_WRITE_ONLY || options == GBL_WRITE_ONLY_DISCARD || options == GBL_WRITE_ONLY_NO_OVERWRITE)
 		{
-			BS_INC_RENDER_STAT_CAT(ResWrite, RenderStatObject_Texture);
+			BS_INC_RENDER_STAT_CAT_BYTES(ResWrite, RenderStatObject_Texture, lockedArea.getConsecutiveSize());
 		}
 #endif
 
-		UINT32 mipWidth = std::max(1u, props.getWidth() >> mipLevel);
-		UINT32 mipHeight = std::max(1u, props.getHeight() >> mipLevel);
-		UINT32 mipDepth = std::max(1u, props.getDepth() >> mipLevel);
-
-		PixelData lockedArea(mipWidth, mipHeight, mipDepth, mInternalFormats[deviceIdx]);
-
 		VulkanImage* image = mImages[deviceIdx];
 
 		if (image == nullptr)
@@ -1037,19 +1048,25 @@ namespace bs { namespace ct
 				   subresource->getLayout() == VK_IMAGE_LAYOUT_GENERAL);
 
 			// GPU should never be allowed to write to a directly mappable texture, since only linear tiling is supported
-			// for direct mapping, and we don't support using it with either storage textures or render targets.
+			// for direct mapping, and we don't support using it with either storage textures or render targets. The
+			// only exception are copies into CPU readable textures.
 			assert(!mSupportsGPUWrites);
 
-			// Check is the GPU currently reading from the image
-			UINT32 useMask = subresource->getUseInfo(VulkanAccessFlag::Read);
+			// Check is the GPU currently using the image in a way that conflicts with the lock
+			UINT32 useMask;
+			if (options == GBL_READ_ONLY)
+				useMask = subresource->getUseInfo(VulkanAccessFlag::Write);
+			else
+				useMask = subresource->getUseInfo(VulkanAccessFlag::Read | VulkanAccessFlag::Write);
+
 			bool isUsedOnGPU = useMask != 0;
 
 			// We're safe to map directly since GPU isn't using the subresource
 			if (!isUsedOnGPU)
 			{
 				// If some CB has an operation queued that will be using the current contents of the image, create a new 
-				// image so we don't modify the previous use of the image
-				if (subresource->isBound())
+				// image so we don't modify the previous use of the image. Not needed when only reading.
+				if (subresource->isBound() && options != GBL_READ_ONLY)
 				{
 					VulkanImage* newImage = createImage(device, mInternalFormats[deviceIdx]);
 
@@ -1155,6 +1172,23 @@ namespace bs { namespace ct
 		// contents.
 		bool needRead = options != GBL_WRITE_ONLY_DISCARD_RANGE && options != GBL_WRITE_ONLY_DISCARD;
 
+		// If only writing, sub-allocate the staging memory from the shared ring buffer, rather than creating a new
+		// staging buffer
+		if (!needRead)
+		{
+			VulkanRingBuffer& ringBuffer = device.getStagingRingBuffer();
+			mStagingAllocation = ringBuffer.allocate(lockedArea.getSize(), getStagingAlignment(lockedArea.getFormat()));
+
+			if (mStagingAllocation.buffer != nullptr)
+			{
+				mMappedRowPitch = lockedArea.getRowPitch();
+				mMappedSlicePitch = lockedArea.getSlicePitch();
+
+				lockedArea.setExternalBuffer(mStagingAllocation.data);
+				return lockedArea;
+			}
+		}
+
 		// Allocate a staging buffer
 		mStagingBuffer = createStaging(device, lockedArea, needRead);
 
@@ -1241,11 +1275,12 @@ namespace bs { namespace ct
 		// Note: If we did any writes they need to be made visible to the GPU. However there is no need to execute 
 		// a pipeline barrier because (as per spec) host writes are implicitly visible to the device.
 
-		if (mStagingBuffer == nullptr)
+		if (mStagingBuffer == nullptr && mStagingAllocation.buffer == nullptr)
 			mImages[mMappedDeviceIdx]->unmap();
 		else
 		{
-			mStagingBuffer->unmap();
+			if (mStagingBuffer != nullptr)
+				mStagingBuffer->unmap();
 
 			bool isWrite = mMappedLockOptions != GBL_READ_ONLY;
 
@@ -1358,7 +1393,20 @@ namespace bs { namespace ct
 									  curLayout, transferLayout, range);
 
 				// Queue copy command
-				mStagingBuffer->copy(transferCB->getCB(), image, extent, rangeLayers, transferLayout);
+				VulkanBuffer* stagingBuffer;
+				if (mStagingBuffer != nullptr)
+				{
+					stagingBuffer = mStagingBuffer;
+					stagingBuffer->copy(transferCB->getCB(), image, extent, rangeLayers, transferLayout);
+				}
+				else // Staging ring buffer
+				{
+					stagingBuffer = mStagingAllocation.buffer;
+
+					UINT32 sliceHeight = mMappedRowPitch != 0 ? mMappedSlicePitch / mMappedRowPitch : 0;
+					stagingBuffer->copy(transferCB->getCB(), image, mStagingAllocation.offset, mMappedRowPitch,
+						sliceHeight, extent, rangeLayers, transferLayout);
+				}
 
 				// Transfer back to original  (or optimal if initial layout was undefined/preinitialized)
 				VkImageLayout dstLayout = image->getOptimalLayout();
@@ -1368,15 +1416,27 @@ namespace bs { namespace ct
 									  transferLayout, dstLayout, range);
 
 				// Notify the command buffer that these resources are being used on it
-				transferCB->getCB()->registerBuffer(mStagingBuffer, BufferUseFlagBits::Transfer, VulkanAccessFlag::Read);
+				transferCB->getCB()->registerBuffer(stagingBuffer, BufferUseFlagBits::Transfer, VulkanAccessFlag::Read);
 				transferCB->getCB()->registerImageTransfer(image, range, dstLayout, VulkanAccessFlag::Write);
 
 				// We don't actually flush the transfer buffer here since it's an expensive operation, but it's instead
 				// done automatically before next "normal" command buffer submission.
 			}
 
-			mStagingBuffer->destroy();
-			mStagingBuffer = nullptr;
+			if (mStagingBuffer != nullptr)
+			{
+				mStagingBuffer->destroy();
+				mStagingBuffer = nullptr;
+			}
+
+			if (mStagingAllocation.buffer != nullptr)
+			{
+				// Region stays intact until the transfer command buffer is done with it
+				VulkanRenderAPI& rapi = static_cast<VulkanRenderAPI&>(RenderAPI::instance());
+				rapi._getDevice(mMappedDeviceIdx)->getStagingRingBuffer().free(mStagingAllocation);
+
+				mStagingAllocation = VulkanRingBuffer::Allocation();
+			}
 		}
 
 		mIsMapped = false;
@@ -4,6 +4,7 @@
 
 #include "BsVulkanPrerequisites.h"
 #include "BsVulkanResource.h"
+#include "BsVulkanRingBuffer.h"
 #include "Image/BsTexture.h"
 
 namespace bs { namespace ct
@@ -235,6 +236,9 @@ namespace bs { namespace ct
 		 */
 		VulkanBuffer* createStaging(VulkanDevice& device, const PixelData& pixelData, bool needsRead);
 
+		/** Returns the alignment staging memory for the provided format must be allocated with, in bytes. */
+		static UINT32 getStagingAlignment(PixelFormat format);
+
 		/** 
 		 * Copies all sub-resources from the source image to the destination image. Caller must ensure the images
 		 * are of the same size. The operation will be queued on the provided command buffer. The system assumes the 
@@ -248,6 +252,7 @@ namespace bs { namespace ct
 		GpuDeviceFlags mDeviceMask;
 
 		VulkanBuffer* mStagingBuffer;
+		VulkanRingBuffer::Allocation mStagingAllocation;
 		UINT32 mMappedDeviceIdx;
 		UINT32 mMappedGlobalQueueIdx;
 		UINT32 mMappedMip;
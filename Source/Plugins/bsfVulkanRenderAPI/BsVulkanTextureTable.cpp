@@ -0,0 +1,174 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsVulkanTextureTable.h"
+#include "BsVulkanDevice.h"
+#include "BsVulkanDescriptorLayout.h"
+#include "BsVulkanCommandBuffer.h"
+#include "BsVulkanTexture.h"
+#include "BsVulkanSamplerState.h"
+#include "Managers/BsVulkanTextureManager.h"
+#include "Renderer/BsTextureTable.h"
+
+namespace bs { namespace ct
+{
+	/** Shader stages the table can be sampled from. */
+	static constexpr VkShaderStageFlags TABLE_STAGES = VK_SHADER_STAGE_ALL;
+
+	const char* VulkanTextureTable::PARAM_NAME = "gTextureTable";
+
+	VulkanTextureTable::VulkanTextureTable(VulkanDevice& device)
+		:mDevice(device)
+	{
+		VkDescriptorSetLayoutBinding binding;
+		binding.binding = 0;
+		binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		binding.descriptorCount = TextureTable::MAX_INDEXED_TEXTURES;
+		binding.stageFlags = TABLE_STAGES;
+		binding.pImmutableSamplers = nullptr;
+
+		// Unused indices are left unwritten, and indices not referenced by in-flight draws can be re-assigned while the
+		// set is bound
+		const VkDescriptorBindingFlagsEXT bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCI;
+		bindingFlagsCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+		bindingFlagsCI.pNext = nullptr;
+		bindingFlagsCI.bindingCount = 1;
+		bindingFlagsCI.pBindingFlags = &bindingFlags;
+
+		mLayout = bs_new<VulkanDescriptorLayout>(device, &binding, 1,
+			VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT, &bindingFlagsCI);
+
+		VkDescriptorPoolSize poolSize;
+		poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		poolSize.descriptorCount = TextureTable::MAX_INDEXED_TEXTURES;
+
+		VkDescriptorPoolCreateInfo poolCI;
+		poolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolCI.pNext = nullptr;
+		poolCI.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+		poolCI.maxSets = 1;
+		poolCI.poolSizeCount = 1;
+		poolCI.pPoolSizes = &poolSize;
+
+		VkResult result = vkCreateDescriptorPool(device.getLogical(), &poolCI, gVulkanAllocator, &mPool);
+		assert(result == VK_SUCCESS);
+
+		VkDescriptorSetLayout layoutHandle = mLayout->getHandle();
+
+		VkDescriptorSetAllocateInfo allocateInfo;
+		allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocateInfo.pNext = nullptr;
+		allocateInfo.descriptorPool = mPool;
+		allocateInfo.descriptorSetCount = 1;
+		allocateInfo.pSetLayouts = &layoutHandle;
+
+		result = vkAllocateDescriptorSets(device.getLogical(), &allocateInfo, &mSet);
+		assert(result == VK_SUCCESS);
+	}
+
+	VulkanTextureTable::~VulkanTextureTable()
+	{
+		// Destroying the pool releases the set as well
+		vkDestroyDescriptorPool(mDevice.getLogical(), mPool, gVulkanAllocator);
+		bs_delete(mLayout);
+	}
+
+	void VulkanTextureTable::setEntry(UINT32 index, const SPtr<Texture>& texture)
+	{
+		assert(index < TextureTable::MAX_INDEXED_TEXTURES);
+
+		if (index >= (UINT32)mEntries.size())
+			mEntries.resize(index + 1);
+
+		Entry& entry = mEntries[index];
+		entry.texture = texture;
+
+		VulkanImage* image = nullptr;
+		if (texture != nullptr)
+			image = static_cast<VulkanTexture*>(texture.get())->getResource(mDevice.getIndex());
+
+		writeDescriptor(index, image);
+		mDirty = true;
+	}
+
+	VkDescriptorSet VulkanTextureTable::prepareForBind(VulkanCmdBuffer& buffer)
+	{
+		if (!mDirty && mBoundOwnerId == buffer.getId() && mBoundResetCount == buffer.getResetCount())
+			return mSet;
+
+		const UINT32 deviceIdx = mDevice.getIndex();
+		for (UINT32 i = 0; i < (UINT32)mEntries.size(); i++)
+		{
+			Entry& entry = mEntries[i];
+			if (entry.texture == nullptr)
+				continue;
+
+			VulkanImage* image = static_cast<VulkanTexture*>(entry.texture.get())->getResource(deviceIdx);
+			if (image == nullptr)
+				continue;
+
+			// Textures in the table are never render targets or dynamic, so they're always sampled in read-only layout
+			buffer.registerImageShader(image, image->getRange(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+				VulkanAccessFlag::Read, TABLE_STAGES);
+
+			// Images get re-created if a texture is written to while the GPU is still using it. Such writes are rare
+			// for static textures, so the new image is only picked up by the next command buffer.
+			if (entry.image != image->getHandle() || entry.imageId != image->getId())
+				writeDescriptor(i, image);
+		}
+
+		VulkanSamplerState* sampler = static_cast<VulkanSamplerState*>(SamplerState::getDefault().get());
+		buffer.registerResource(sampler->getResource(deviceIdx), VulkanAccessFlag::Read);
+
+		mBoundOwnerId = buffer.getId();
+		mBoundResetCount = buffer.getResetCount();
+		mDirty = false;
+
+		return mSet;
+	}
+
+	void VulkanTextureTable::writeDescriptor(UINT32 index, VulkanImage* image)
+	{
+		const UINT32 deviceIdx = mDevice.getIndex();
+
+		// Table textures are sampled with the default sampler, since there's no per-texture sampler state
+		VulkanSamplerState* sampler = static_cast<VulkanSamplerState*>(SamplerState::getDefault().get());
+
+		VkDescriptorImageInfo imageInfo;
+		imageInfo.sampler = sampler->getResource(deviceIdx)->getHandle();
+		imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		Entry& entry = mEntries[index];
+		if (image != nullptr)
+		{
+			imageInfo.imageView = image->getView(false);
+
+			entry.image = image->getHandle();
+			entry.imageId = image->getId();
+		}
+		else
+		{
+			VulkanTextureManager& vkTexManager = static_cast<VulkanTextureManager&>(TextureManager::instance());
+			imageInfo.imageView = vkTexManager.getDummyImageView(GPOT_TEXTURE2D, deviceIdx);
+
+			entry.image = VK_NULL_HANDLE;
+			entry.imageId = 0;
+		}
+
+		VkWriteDescriptorSet writeSetInfo;
+		writeSetInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeSetInfo.pNext = nullptr;
+		writeSetInfo.dstSet = mSet;
+		writeSetInfo.dstBinding = 0;
+		writeSetInfo.dstArrayElement = index;
+		writeSetInfo.descriptorCount = 1;
+		writeSetInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeSetInfo.pImageInfo = &imageInfo;
+		writeSetInfo.pBufferInfo = nullptr;
+		writeSetInfo.pTexelBufferView = nullptr;
+
+		vkUpdateDescriptorSets(mDevice.getLogical(), 1, &writeSetInfo, 0, nullptr);
+	}
+}}
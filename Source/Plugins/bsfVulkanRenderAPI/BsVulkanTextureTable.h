@@ -0,0 +1,73 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsVulkanPrerequisites.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup Vulkan
+	 *  @{
+	 */
+
+	/**
+	 * Descriptor set holding every texture registered with the global TextureTable, at the index the table assigned
+	 * to it. The set is shared by all GPU programs that sample the table, and is bound in place of the set the
+	 * programs declare the table in. Relies on descriptor indexing, so the set can be updated while it is bound and
+	 * not every descriptor needs to be valid.
+	 *
+	 * @note	Core thread only.
+	 */
+	class VulkanTextureTable
+	{
+	public:
+		/** Descriptor set GPU programs are expected to declare the table in. */
+		static constexpr UINT32 SET_IDX = 1;
+
+		/** Name the table is declared with in GPU programs. */
+		static const char* PARAM_NAME;
+
+		VulkanTextureTable(VulkanDevice& device);
+		~VulkanTextureTable();
+
+		/** Assigns the texture to the provided table index, or clears the index if the texture is null. */
+		void setEntry(UINT32 index, const SPtr<Texture>& texture);
+
+		/** Returns the layout of the table's descriptor set. */
+		VulkanDescriptorLayout* getLayout() const { return mLayout; }
+
+		/**
+		 * Registers the textures in the table with the provided command buffer, and returns the descriptor set to bind.
+		 * Textures are only registered once per command buffer, unless the table changes in the meantime.
+		 */
+		VkDescriptorSet prepareForBind(VulkanCmdBuffer& buffer);
+
+	private:
+		/** Texture assigned to a single index of the table. */
+		struct Entry
+		{
+			SPtr<Texture> texture;
+
+			/** Image the descriptor was last written with, and its identifier. */
+			VkImage image = VK_NULL_HANDLE;
+			UINT64 imageId = 0;
+		};
+
+		/** Writes the descriptor at the provided index. Writes a dummy texture if the image is null. */
+		void writeDescriptor(UINT32 index, VulkanImage* image);
+
+		VulkanDevice& mDevice;
+		VulkanDescriptorLayout* mLayout = nullptr;
+		VkDescriptorPool mPool = VK_NULL_HANDLE;
+		VkDescriptorSet mSet = VK_NULL_HANDLE;
+
+		Vector<Entry> mEntries;
+		bool mDirty = true;
+
+		/** Command buffer the textures were last registered with, and its reset count at that time. */
+		UINT32 mBoundOwnerId = (UINT32)-1;
+		UINT32 mBoundResetCount = 0;
+	};
+
+	/** @} */
+}}
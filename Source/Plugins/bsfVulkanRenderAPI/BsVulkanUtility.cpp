@@ -302,6 +302,8 @@ namespace bs { namespace ct
 			lookup[VET_INT3] = VK_FORMAT_R32G32B32_SINT;
 			lookup[VET_INT4] = VK_FORMAT_R32G32B32A32_SINT;
 			lookup[VET_UBYTE4] = VK_FORMAT_R8G8B8A8_UINT;
+			lookup[VET_HALF2] = VK_FORMAT_R16G16_SFLOAT;
+			lookup[VET_HALF4] = VK_FORMAT_R16G16B16A16_SFLOAT;
 
 			lookupInitialized = true;
 		}
@@ -26,6 +26,8 @@ set(BS_VULKANRENDERAPI_INC_NOFILTER
 	"BsVulkanDescriptorSet.h"
 	"BsVulkanSamplerState.h"
 	"BsVulkanGpuPipelineParamInfo.h"
+	"BsVulkanRingBuffer.h"
+	"BsVulkanTextureTable.h"
 )
 
 set(BS_VULKANRENDERAPI_INC_MANAGERS
@@ -69,6 +71,8 @@ set(BS_VULKANRENDERAPI_SRC_NOFILTER
 	"BsVulkanDescriptorSet.cpp"
 	"BsVulkanSamplerState.cpp"
 	"BsVulkanGpuPipelineParamInfo.cpp"
+	"BsVulkanRingBuffer.cpp"
+	"BsVulkanTextureTable.cpp"
 )
 
 set(BS_VULKANRENDERAPI_SRC_MANAGERS
@@ -69,6 +69,27 @@ namespace bs { namespace ct
 		return hash;
 	}
 
+	VulkanDescriptorSetKey::VulkanDescriptorSetKey(VulkanDescriptorLayout* layout, UINT64* contents, UINT32 numContents)
+		:layout(layout), numContents(numContents), contents(contents)
+	{ }
+
+	bool VulkanDescriptorSetKey::operator==(const VulkanDescriptorSetKey& rhs) const
+	{
+		if (layout != rhs.layout || numContents != rhs.numContents)
+			return false;
+
+		return memcmp(contents, rhs.contents, numContents * sizeof(UINT64)) == 0;
+	}
+
+	size_t VulkanDescriptorSetKey::calculateHash() const
+	{
+		size_t hash = layout->getHash();
+		for (UINT32 i = 0; i < numContents; i++)
+			hash_combine(hash, contents[i]);
+
+		return hash;
+	}
+
 	VulkanDescriptorManager::VulkanDescriptorManager(VulkanDevice& device)
 		:mDevice(device)
 	{
@@ -77,6 +98,16 @@ namespace bs { namespace ct
 
 	VulkanDescriptorManager::~VulkanDescriptorManager()
 	{
+		// Sets must be freed before the pools they were allocated from
+		for (auto& entry : mCachedSets)
+		{
+			entry.second.set->destroy();
+			bs_free(entry.first.contents);
+		}
+
+		for (auto& entry : mLinearPools)
+			bs_delete(entry);
+
 		for (auto& entry : mLayouts)
 		{
 			bs_delete(entry.layout);
@@ -112,6 +143,13 @@ namespace bs { namespace ct
 	}
 
 	VulkanDescriptorSet* VulkanDescriptorManager::createSet(VulkanDescriptorLayout* layout)
+	{
+		Lock lock(mMutex);
+
+		return allocateSet(layout);
+	}
+
+	VulkanDescriptorSet* VulkanDescriptorManager::allocateSet(VulkanDescriptorLayout* layout)
 	{
 		// Note: We always retrieve the last created pool, even though there could be free room in earlier pools. However
 		// that requires additional tracking. Since the assumption is that the first pool will be large enough for all
@@ -174,4 +212,127 @@ namespace bs { namespace ct
 		mPipelineLayouts.insert(std::make_pair(key, pipelineLayout));
 		return pipelineLayout;
 	}
+
+	VulkanDescriptorSet* VulkanDescriptorManager::getCachedSet(const VulkanDescriptorSetKey& key,
+		VkWriteDescriptorSet* entries, UINT32 numEntries)
+	{
+		Lock lock(mMutex);
+
+		auto iterFind = mCachedSets.find(key);
+		if (iterFind != mCachedSets.end())
+		{
+			CachedSet& cachedSet = iterFind->second;
+			cachedSet.numUsers++;
+			cachedSet.lastUsed = mNextUseIdx++;
+
+			return cachedSet.set;
+		}
+
+		// Only cache contents that were requested at least once before. Hash collisions here can only cause contents
+		// to be cached sooner, so storing just the hash is enough.
+		const size_t hash = key.calculateHash();
+		if (mRequestedSets.find(hash) == mRequestedSets.end())
+		{
+			if (mRequestedSets.size() >= MAX_REQUESTED_SETS)
+				mRequestedSets.clear();
+
+			mRequestedSets.insert(hash);
+			return nullptr;
+		}
+
+		mRequestedSets.erase(hash);
+
+		if (mCachedSets.size() >= MAX_CACHED_SETS)
+			evictCachedSets();
+
+		VulkanDescriptorSet* set = allocateSet(key.layout);
+		set->write(entries, numEntries);
+
+		VulkanDescriptorSetKey ownedKey = key;
+		ownedKey.contents = bs_allocN<UINT64>(key.numContents);
+		memcpy(ownedKey.contents, key.contents, key.numContents * sizeof(UINT64));
+
+		CachedSet cachedSet;
+		cachedSet.set = set;
+		cachedSet.numUsers = 1;
+		cachedSet.lastUsed = mNextUseIdx++;
+
+		mCachedSets.insert(std::make_pair(ownedKey, cachedSet));
+		mCachedSetKeys.insert(std::make_pair(set, ownedKey));
+
+		return set;
+	}
+
+	void VulkanDescriptorManager::releaseCachedSet(VulkanDescriptorSet* set)
+	{
+		Lock lock(mMutex);
+
+		auto iterFind = mCachedSetKeys.find(set);
+		if (iterFind == mCachedSetKeys.end())
+			return;
+
+		CachedSet& cachedSet = mCachedSets.find(iterFind->second)->second;
+		assert(cachedSet.numUsers > 0);
+
+		cachedSet.numUsers--;
+	}
+
+	void VulkanDescriptorManager::evictCachedSets()
+	{
+		Vector<std::pair<UINT64, VulkanDescriptorSetKey>> unusedSets;
+		for (auto& entry : mCachedSets)
+		{
+			if (entry.second.numUsers == 0)
+				unusedSets.push_back(std::make_pair(entry.second.lastUsed, entry.first));
+		}
+
+		std::sort(unusedSets.begin(), unusedSets.end(),
+			[](const std::pair<UINT64, VulkanDescriptorSetKey>& a, const std::pair<UINT64, VulkanDescriptorSetKey>& b)
+		{
+			return a.first < b.first;
+		});
+
+		// Evict a quarter of the cache at once, so eviction doesn't need to run on every new set
+		UINT32 numToEvict = std::min((UINT32)unusedSets.size(), MAX_CACHED_SETS / 4);
+		for (UINT32 i = 0; i < numToEvict; i++)
+		{
+			const VulkanDescriptorSetKey& key = unusedSets[i].second;
+
+			auto iterFind = mCachedSets.find(key);
+			VulkanDescriptorSet* set = iterFind->second.set;
+
+			// Destruction is delayed if the set is still used by a command buffer
+			set->destroy();
+
+			mCachedSetKeys.erase(set);
+			mCachedSets.erase(iterFind);
+			bs_free(key.contents);
+		}
+	}
+
+	VulkanDescriptorPool* VulkanDescriptorManager::acquireLinearPool()
+	{
+		Lock lock(mMutex);
+
+		if (!mFreeLinearPools.empty())
+		{
+			VulkanDescriptorPool* pool = mFreeLinearPools.back();
+			mFreeLinearPools.pop_back();
+
+			return pool;
+		}
+
+		VulkanDescriptorPool* pool = bs_new<VulkanDescriptorPool>(mDevice, true);
+		mLinearPools.push_back(pool);
+
+		return pool;
+	}
+
+	void VulkanDescriptorManager::releaseLinearPool(VulkanDescriptorPool* pool)
+	{
+		pool->reset();
+
+		Lock lock(mMutex);
+		mFreeLinearPools.push_back(pool);
+	}
 }}
\ No newline at end of file
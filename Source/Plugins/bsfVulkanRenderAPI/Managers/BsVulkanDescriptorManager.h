@@ -35,6 +35,22 @@ namespace bs { namespace ct
 		UINT32 numLayouts;
 		VulkanDescriptorLayout** layouts;
 	};
+
+	/** Used as a key in a hash map containing cached descriptor sets. */
+	struct VulkanDescriptorSetKey
+	{
+		VulkanDescriptorSetKey(VulkanDescriptorLayout* layout, UINT64* contents, UINT32 numContents);
+
+		/** Compares two descriptor set keys. */
+		bool operator==(const VulkanDescriptorSetKey& rhs) const;
+
+		/** Calculates a hash value for the layout and the descriptor contents. */
+		size_t calculateHash() const;
+
+		VulkanDescriptorLayout* layout;
+		UINT32 numContents;
+		UINT64* contents;
+	};
 }}
 
 /** @cond STDLIB */
@@ -66,6 +82,16 @@ namespace std
 			return value.calculateHash();
 		}
 	};
+
+	/**	Hash value generator for VulkanDescriptorSetKey. */
+	template<>
+	struct hash<bs::ct::VulkanDescriptorSetKey>
+	{
+		size_t operator()(const bs::ct::VulkanDescriptorSetKey& value) const
+		{
+			return value.calculateHash();
+		}
+	};
 }
 
 /** @} */
@@ -93,12 +119,80 @@ namespace bs { namespace ct
 		/** Attempts to find an existing one, or allocates a new pipeline layout based on the provided descriptor layouts. */
 		VkPipelineLayout getPipelineLayout(VulkanDescriptorLayout** layouts, UINT32 numLayouts);
 
+		/**
+		 * Returns a descriptor set with the provided layout and contents, from a cache of immutable descriptor sets
+		 * shared by all GPU parameter objects. If the cache doesn't contain the set, a new one is created and written
+		 * to using @p entries, but only if the same contents were already requested before. Otherwise null is returned
+		 * and the caller is expected to use a transient set instead. This way contents that are used only once don't
+		 * end up filling the cache.
+		 *
+		 * Sets returned by this method must not be written to, and must be released with releaseCachedSet() once the
+		 * caller no longer needs them.
+		 *
+		 * @note	Thread safe.
+		 */
+		VulkanDescriptorSet* getCachedSet(const VulkanDescriptorSetKey& key, VkWriteDescriptorSet* entries, 
+			UINT32 numEntries);
+
+		/** 
+		 * Releases a set returned by getCachedSet(). Sets no longer used by anyone stay in the cache until it grows too
+		 * large, at which point the least recently used ones are destroyed.
+		 *
+		 * @note	Thread safe.
+		 */
+		void releaseCachedSet(VulkanDescriptorSet* set);
+
+		/** 
+		 * Returns a pool that can be used for allocating transient descriptor sets. The pool must be returned by
+		 * calling releaseLinearPool() once all the sets allocated from it are no longer in use.
+		 *
+		 * @note	Thread safe.
+		 */
+		VulkanDescriptorPool* acquireLinearPool();
+
+		/** 
+		 * Resets a pool returned by acquireLinearPool() and makes it available for re-use.
+		 *
+		 * @note	Thread safe.
+		 */
+		void releaseLinearPool(VulkanDescriptorPool* pool);
+
 	protected:
+		/** Information about a descriptor set in the cache. */
+		struct CachedSet
+		{
+			VulkanDescriptorSet* set;
+			UINT32 numUsers;
+			UINT64 lastUsed;
+		};
+
+		/** Maximum number of sets in the cache, before the unused ones start getting evicted. */
+		static constexpr UINT32 MAX_CACHED_SETS = 4096;
+
+		/** Maximum number of contents remembered as requested before, but not yet present in the cache. */
+		static constexpr UINT32 MAX_REQUESTED_SETS = 16384;
+
+		/** Allocates a new empty descriptor set matching the provided layout. Caller must hold the mutex. */
+		VulkanDescriptorSet* allocateSet(VulkanDescriptorLayout* layout);
+
+		/** Destroys the least recently used sets that aren't used by anyone. Caller must hold the mutex. */
+		void evictCachedSets();
+
 		VulkanDevice& mDevice;
 
 		UnorderedSet<VulkanLayoutKey> mLayouts; 
 		UnorderedMap<VulkanPipelineLayoutKey, VkPipelineLayout> mPipelineLayouts;
 		Vector<VulkanDescriptorPool*> mPools;
+
+		UnorderedMap<VulkanDescriptorSetKey, CachedSet> mCachedSets;
+		UnorderedMap<VulkanDescriptorSet*, VulkanDescriptorSetKey> mCachedSetKeys;
+		UnorderedSet<size_t> mRequestedSets;
+		UINT64 mNextUseIdx = 0;
+
+		Vector<VulkanDescriptorPool*> mLinearPools;
+		Vector<VulkanDescriptorPool*> mFreeLinearPools;
+
+		Mutex mMutex;
 	};
 
 	/** @} */
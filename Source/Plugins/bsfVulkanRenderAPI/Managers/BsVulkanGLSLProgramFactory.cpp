@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Managers/BsVulkanGLSLProgramFactory.h"
 #include "BsVulkanGpuProgram.h"
+#include "BsVulkanTextureTable.h"
 
 #define AMD_EXTENSIONS
 #define NV_EXTENSIONS
@@ -410,10 +411,14 @@ namespace bs { namespace ct
 		{
 			const glslang::TType* ttype = program->getUniformTType(i);
 			const glslang::TQualifier& qualifier = ttype->getQualifier();
-			const char* name = program->getUniformName(i);
+			String name = program->getUniformName(i);
 
 			if (ttype->getBasicType() == glslang::EbtSampler) // Object type
 			{
+				// Arrays of objects (only used by the texture table) are reported by the name of their first element
+				if (ttype->isArray())
+					name = name.substr(0, name.find('['));
+
 				// Note: Even though the type is named EbtSampler, all object types are categorized under it (including non
 				// sampled images and buffers)
 
@@ -498,7 +503,7 @@ namespace bs { namespace ct
 				}
 
 				if(param.type == GPOT_UNKNOWN)
-					LOGERR("Cannot determine type for uniform: " + String(name));
+					LOGERR("Cannot determine type for uniform: " + name);
 			}
 			else
 			{
@@ -508,7 +513,7 @@ namespace bs { namespace ct
 					info.arraySize = program->getUniformArraySize(i);
 					info.bufferOffset = program->getUniformBufferOffset(i);
 
-					uniforms[String(name)] = info;
+					uniforms[name] = info;
 				}
 			}
 		}
@@ -626,6 +631,81 @@ namespace bs { namespace ct
 		return true;
 	}
 
+	/**
+	 * Moves the declaration of the texture table (if the program samples it) into the set provided by
+	 * VulkanTextureTable, and marks the indices used for accessing it as non-uniform, since they can differ between
+	 * invocations of the same draw.
+	 */
+	String patchTextureTable(const String& source)
+	{
+		const String tableName = String(VulkanTextureTable::PARAM_NAME) + "[";
+
+		size_t declPos = String::npos;
+		for (size_t pos = source.find(tableName); pos != String::npos; pos = source.find(tableName, pos + 1))
+		{
+			const size_t lineStart = source.rfind('\n', pos) + 1;
+			if (source.find("uniform", lineStart) < pos)
+			{
+				declPos = lineStart;
+				break;
+			}
+		}
+
+		if (declPos == String::npos)
+			return source;
+
+		const size_t versionPos = source.find("#version");
+		if (versionPos == String::npos || versionPos > declPos)
+			return source;
+
+		StringStream output;
+
+		// Extension must follow the version directive
+		const size_t versionEnd = source.find('\n', versionPos) + 1;
+		output << source.substr(0, versionEnd);
+		output << "#extension GL_EXT_nonuniform_qualifier : require\n";
+
+		// Replace the automatically assigned binding of the declaration
+		const size_t declEnd = std::min(source.find('\n', declPos), source.size());
+		const String declaration = source.substr(declPos, declEnd - declPos);
+		const size_t qualifierEnd = declaration.find(')');
+		if (declaration.find("layout(") != 0 || qualifierEnd == String::npos)
+		{
+			LOGERR("Unable to assign the texture table descriptor set, declaration is missing a layout qualifier.");
+			return source;
+		}
+
+		output << source.substr(versionEnd, declPos - versionEnd);
+		output << "layout(set = " << VulkanTextureTable::SET_IDX << ", binding = 0" << declaration.substr(qualifierEnd);
+
+		// Wrap the index of every access in nonuniformEXT()
+		size_t readPos = declEnd;
+		for (size_t pos = source.find(tableName, readPos); pos != String::npos; pos = source.find(tableName, readPos))
+		{
+			const size_t indexStart = pos + tableName.size();
+
+			UINT32 depth = 1;
+			size_t indexEnd = indexStart;
+			for (; indexEnd < source.size() && depth > 0; indexEnd++)
+			{
+				if (source[indexEnd] == '[')
+					depth++;
+				else if (source[indexEnd] == ']')
+					depth--;
+			}
+
+			// Points to the closing bracket
+			indexEnd--;
+
+			output << source.substr(readPos, indexStart - readPos);
+			output << "nonuniformEXT(" << source.substr(indexStart, indexEnd - indexStart) << ")";
+			readPos = indexEnd;
+		}
+
+		output << source.substr(readPos);
+		return output.str();
+	}
+
 	VulkanGLSLProgramFactory::VulkanGLSLProgramFactory()
 	{
 		glslang::InitializeProcess();
@@ -657,6 +737,11 @@ namespace bs { namespace ct
 		return gpuProg;
 	}
 
+	String VulkanGLSLProgramFactory::getCompilerSignature() const
+	{
+		return String(VULKAN_COMPILER_ID) + "_" + toString(VULKAN_COMPILER_VERSION);
+	}
+
 	SPtr<GpuProgramBytecode> VulkanGLSLProgramFactory::compileBytecode(const GPU_PROGRAM_DESC& desc)
 	{
 		TBuiltInResource resources = DefaultTBuiltInResource;
@@ -691,7 +776,7 @@ namespace bs { namespace ct
 		spv::SpvBuildLogger logger;
 		std::string compileLog;
 
-		const String& source = desc.source;
+		const String source = patchTextureTable(desc.source);
 		const char* sourceBytes = source.c_str();
 
 		glslang::TShader* shader = bs_new<glslang::TShader>(glslType);